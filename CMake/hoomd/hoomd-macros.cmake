@@ -74,3 +74,68 @@ function(hoomd_add_module target_name)
     set_target_properties(${target_name} PROPERTIES CUDA_VISIBILITY_PRESET "hidden")
     pybind11_extension(${target_name})
 endfunction()
+
+# select a subset of the components to build
+#
+# @param output: name of the variable to set to the selected components
+# @param all: list of all available components
+# @param selected: list of the components to build, empty to build all
+# @param description: kind of component, used in error messages
+#
+# The selected components are returned in the order of ${all}.
+function(hoomd_select_components output all selected description)
+    if ("${selected}" STREQUAL "")
+        set(${output} ${all} PARENT_SCOPE)
+        return()
+    endif()
+
+    foreach(_item ${selected})
+        if (NOT _item IN_LIST all)
+            message(FATAL_ERROR "Unknown ${description} ${_item}. Choose from: ${all}")
+        endif()
+    endforeach()
+
+    set(_result "")
+    foreach(_item ${all})
+        if (_item IN_LIST selected)
+            list(APPEND _result ${_item})
+        endif()
+    endforeach()
+    set(${output} ${_result} PARENT_SCOPE)
+endfunction()
+
+# generate the sources that instantiate and export PotentialPair for an evaluator
+#
+# @param sources: name of the list variable to append the generated sources to
+# @param name: the python class is PotentialPair${name} (and PotentialPair${name}GPU)
+# @param evaluator: evaluator class, relative to the hoomd::md namespace
+# @param header: header file that defines the evaluator class
+#
+# The generated sources define export_PotentialPair${name}(pybind11::module& m) and, when HIP is
+# enabled, export_PotentialPair${name}GPU(pybind11::module& m) in the hoomd::md::detail namespace.
+# Components call these functions from their PYBIND11_MODULE.
+function(hoomd_add_pair_evaluator sources name evaluator header)
+    set(_evaluator ${name})
+    set(_evaluator_class ${evaluator})
+    set(_evaluator_header ${header})
+
+    configure_file(${HOOMD_MD_TEMPLATE_DIR}/export_PotentialPair.cc.inc
+                   ${CMAKE_CURRENT_BINARY_DIR}/export_PotentialPair${name}.cc
+                   @ONLY)
+    set(_sources ${${sources}} ${CMAKE_CURRENT_BINARY_DIR}/export_PotentialPair${name}.cc)
+
+    if (ENABLE_HIP)
+        configure_file(${HOOMD_MD_TEMPLATE_DIR}/export_PotentialPairGPU.cc.inc
+                       ${CMAKE_CURRENT_BINARY_DIR}/export_PotentialPair${name}GPU.cc
+                       @ONLY)
+        configure_file(${HOOMD_MD_TEMPLATE_DIR}/PotentialPairGPUKernel.cu.inc
+                       ${CMAKE_CURRENT_BINARY_DIR}/PotentialPair${name}GPUKernel.cu
+                       @ONLY)
+        set_source_files_properties(${CMAKE_CURRENT_BINARY_DIR}/PotentialPair${name}GPUKernel.cu
+                                    PROPERTIES LANGUAGE ${HOOMD_DEVICE_LANGUAGE})
+        list(APPEND _sources ${CMAKE_CURRENT_BINARY_DIR}/export_PotentialPair${name}GPU.cc
+                             ${CMAKE_CURRENT_BINARY_DIR}/PotentialPair${name}GPUKernel.cu)
+    endif()
+
+    set(${sources} ${_sources} PARENT_SCOPE)
+endfunction()
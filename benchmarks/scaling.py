@@ -0,0 +1,378 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+"""Measure the strong and weak MPI scaling of standard workloads.
+
+Run one measurement per rank count, appending the results to a file::
+
+    for n in 1 2 4 8 16; do
+        mpirun -n $n python3 scaling.py run lj --weak 32000 -o lj.jsonl
+    done
+
+Then print the scaling table::
+
+    python3 scaling.py report lj.jsonl
+
+``--weak N`` places *N* particles on every rank (for HPMC: *N* shapes, for
+rigid bodies: *N* bodies). ``--strong N`` fixes the total size to *N*.
+
+The driver profiles the runs with `hoomd.Simulation.profiling` and groups the
+profiled regions in phases:
+
+* ``force`` - Force computes, excluding the neighbor list build.
+* ``nlist`` - Neighbor list builds.
+* ``comm`` - Ghost particle communication.
+* ``migrate`` - Particle migration.
+* ``balance`` - Load balancing.
+* ``io`` - Writers.
+* ``other`` - The remaining time in the time step loop.
+
+The table lists the time per step in each phase on the slowest rank.
+mpi4py is required to reduce the phases over the ranks, without it the table
+lists the times of rank 0.
+"""
+
+import argparse
+import collections
+import json
+import math
+
+import numpy
+
+import hoomd
+from hoomd import hpmc, md
+
+WORKLOADS = collections.OrderedDict()
+
+
+def workload(name):
+    """Register a workload."""
+
+    def register(function):
+        WORKLOADS[name] = function
+        return function
+
+    return register
+
+
+def lattice(n, a):
+    """Place n sites on a cubic lattice with spacing a.
+
+    Returns:
+        tuple[numpy.ndarray, float, int]: The positions, the box length, and
+        the number of sites along each edge.
+    """
+    n_side = math.ceil(n**(1 / 3))
+    box_length = n_side * a
+    x = (numpy.arange(n_side) + 0.5) * a - box_length / 2
+    grid = numpy.stack(numpy.meshgrid(x, x, x, indexing='ij'), axis=-1)
+    # site i = x + n_side * (y + n_side * z)
+    positions = grid.transpose(2, 1, 0, 3).reshape(-1, 3)[:n]
+    return positions, box_length, n_side
+
+
+def make_snapshot(device, n, a, types):
+    """Make a snapshot with n particles on a cubic lattice."""
+    snapshot = hoomd.Snapshot(device.communicator)
+    positions, box_length, n_side = lattice(n, a)
+    if snapshot.communicator.rank == 0:
+        snapshot.configuration.box = [box_length] * 3 + [0, 0, 0]
+        snapshot.particles.N = n
+        snapshot.particles.types = types
+        snapshot.particles.position[:] = positions
+    return snapshot, n_side
+
+
+def make_simulation(device, snapshot):
+    """Make a simulation from the snapshot."""
+    simulation = hoomd.Simulation(device=device, seed=1)
+    simulation.create_state_from_snapshot(snapshot)
+    return simulation
+
+
+def lj_force(nlist):
+    """Make a WCA or LJ pair force between A particles."""
+    lj = md.pair.LJ(nlist=nlist, mode='shift')
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    lj.r_cut[('A', 'A')] = 2.5
+    return lj
+
+
+def md_integrator(simulation, forces, kT=1.5, filter=hoomd.filter.All()):
+    """Integrate with a Bussi thermostat."""
+    simulation.state.thermalize_particle_momenta(filter, kT)
+    method = md.methods.ConstantVolume(
+        filter=filter, thermostat=md.methods.thermostats.Bussi(kT=kT))
+    return md.Integrator(dt=0.005, methods=[method], forces=forces)
+
+
+@workload('lj')
+def make_lj(device, n):
+    """Lennard-Jones liquid."""
+    snapshot, _ = make_snapshot(device, n, 0.85**(-1 / 3), ['A'])
+    simulation = make_simulation(device, snapshot)
+    simulation.operations.integrator = md_integrator(
+        simulation, [lj_force(md.nlist.Cell(buffer=0.4))])
+    return simulation
+
+
+@workload('polymer')
+def make_polymer(device, n, chain_length=10):
+    """Kremer-Grest polymer melt."""
+    snapshot, n_side = make_snapshot(device, n, 0.85**(-1 / 3), ['A'])
+    if snapshot.communicator.rank == 0:
+        # connect the consecutive sites along x in chains of chain_length
+        site = numpy.arange(n - 1)
+        x = site % n_side
+        connect = (x < n_side - 1) & (x % chain_length != chain_length - 1)
+        first = site[connect]
+        snapshot.bonds.N = len(first)
+        snapshot.bonds.types = ['A-A']
+        snapshot.bonds.group[:] = numpy.stack([first, first + 1], axis=-1)
+    simulation = make_simulation(device, snapshot)
+
+    nlist = md.nlist.Cell(buffer=0.4, exclusions=['bond'])
+    wca = md.pair.LJ(nlist=nlist, mode='shift')
+    wca.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    wca.r_cut[('A', 'A')] = 2**(1 / 6)
+    fene = md.bond.FENEWCA()
+    fene.params['A-A'] = dict(k=30, r0=1.5, epsilon=1, sigma=1, delta=0)
+
+    simulation.operations.integrator = md_integrator(simulation, [wca, fene],
+                                                     kT=1.0)
+    return simulation
+
+
+@workload('pppm')
+def make_pppm(device, n):
+    """Charged Lennard-Jones liquid with PPPM electrostatics."""
+    # an even number of alternating charges keeps the system neutral
+    n = n + n % 2
+    snapshot, _ = make_snapshot(device, n, 0.85**(-1 / 3), ['A'])
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.charge[:] = numpy.where(numpy.arange(n) % 2, -1, 1)
+    simulation = make_simulation(device, snapshot)
+
+    nlist = md.nlist.Cell(buffer=0.4)
+    box_length = simulation.state.box.Lx
+    resolution = 2**math.ceil(math.log2(box_length))
+    real, reciprocal = md.long_range.pppm.make_pppm_coulomb_forces(
+        nlist=nlist, resolution=[resolution] * 3, order=5, r_cut=2.5)
+
+    simulation.operations.integrator = md_integrator(
+        simulation, [lj_force(nlist), real, reciprocal])
+    return simulation
+
+
+@workload('rigid')
+def make_rigid(device, n):
+    """Rigid dimers."""
+    snapshot, _ = make_snapshot(device, n, 2.0, ['R', 'A'])
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.moment_inertia[:] = [0.5, 0.5, 0]
+    simulation = make_simulation(device, snapshot)
+
+    rigid = md.constrain.Rigid()
+    rigid.body['R'] = dict(constituent_types=['A', 'A'],
+                           positions=[(0, 0, 0.5), (0, 0, -0.5)],
+                           orientations=[(1, 0, 0, 0), (1, 0, 0, 0)])
+    rigid.create_bodies(simulation.state)
+
+    nlist = md.nlist.Cell(buffer=0.4, exclusions=['body'])
+    lj = lj_force(nlist)
+    lj.params[(['R'], ['R', 'A'])] = dict(epsilon=0, sigma=1)
+    lj.r_cut[(['R'], ['R', 'A'])] = 0
+
+    integrator = md_integrator(simulation, [lj],
+                               filter=hoomd.filter.Rigid(('center', 'free')))
+    integrator.integrate_rotational_dof = True
+    integrator.rigid = rigid
+    simulation.operations.integrator = integrator
+    return simulation
+
+
+@workload('hpmc')
+def make_hpmc(device, n):
+    """Hard cubes."""
+    snapshot, _ = make_snapshot(device, n, 1.2, ['A'])
+    simulation = make_simulation(device, snapshot)
+
+    mc = hpmc.integrate.ConvexPolyhedron(default_d=0.1, default_a=0.1)
+    mc.shape['A'] = dict(vertices=[(x, y, z) for x in (-0.5, 0.5)
+                                   for y in (-0.5, 0.5)
+                                   for z in (-0.5, 0.5)])
+    simulation.operations.integrator = mc
+    return simulation
+
+
+def phase(name):
+    """Get the phase of a profiled region."""
+    if name.startswith('hoomd::Communicator::') or name.startswith(
+            'Communicator::'):
+        if 'migrate' in name:
+            return 'migrate'
+        return 'comm'
+    if 'NeighborList' in name:
+        return 'nlist'
+    if 'LoadBalancer' in name:
+        return 'balance'
+    if 'Writer' in name or name.startswith('hoomd::write'):
+        return 'io'
+    if 'Integrator' in name:
+        return 'integrate'
+    return 'force'
+
+
+PHASES = ('force', 'nlist', 'comm', 'migrate', 'balance', 'io', 'other')
+
+
+def phase_times(profile, steps):
+    """Group the profiled regions in phases.
+
+    Returns:
+        dict: The time per step [s] in each phase.
+    """
+    times = collections.defaultdict(float)
+    for name, region in profile.items():
+        times[phase(name)] += region['total_time'] / steps
+
+    # neighbor lists build inside the force computes, and all but the writers
+    # and the tuners execute inside the integrator
+    times['force'] -= times['nlist']
+    nested = sum(times[p] for p in ('force', 'nlist', 'comm', 'migrate'))
+    times['other'] = max(times.pop('integrate', 0) - nested, 0)
+    return {p: times[p] for p in PHASES}
+
+
+def reduce_max(values):
+    """Reduce a dictionary of values over the ranks with the maximum."""
+    try:
+        from mpi4py import MPI
+    except ImportError:
+        return values
+    all_values = MPI.COMM_WORLD.allgather(values)
+    return {key: max(v[key] for v in all_values) for key in values}
+
+
+def run(args):
+    """Run one measurement and append it to the output file."""
+    if args.device == 'GPU':
+        device = hoomd.device.GPU()
+    else:
+        device = hoomd.device.CPU()
+    ranks = device.communicator.num_ranks
+
+    if args.weak is not None:
+        scaling, n = 'weak', args.weak * ranks
+    else:
+        scaling, n = 'strong', args.strong
+
+    simulation = WORKLOADS[args.workload](device, n)
+    if args.balance is not None:
+        simulation.operations.tuners.append(
+            hoomd.tune.LoadBalancer(hoomd.trigger.Periodic(args.balance)))
+    if args.write is not None:
+        simulation.operations.writers.append(
+            hoomd.write.GSD(trigger=hoomd.trigger.Periodic(args.write),
+                            filename=f'scaling_{args.workload}.gsd',
+                            mode='wb'))
+
+    simulation.run(args.warmup)
+    simulation.profiling = True
+    simulation.run(args.steps)
+
+    result = dict(workload=args.workload,
+                  scaling=scaling,
+                  device=args.device,
+                  ranks=ranks,
+                  N=simulation.state.N_particles,
+                  tps=simulation.tps,
+                  phases=reduce_max(phase_times(simulation.profile,
+                                                args.steps)))
+
+    if device.communicator.rank == 0:
+        with open(args.output, 'a') as f:
+            f.write(json.dumps(result) + '\n')
+        print(f"{args.workload} {scaling} {ranks} ranks: "
+              f"{result['tps']:.6g} TPS")
+
+
+def report(args):
+    """Print the scaling table of the measurements in the files."""
+    series = collections.defaultdict(list)
+    for filename in args.files:
+        with open(filename) as f:
+            for line in f:
+                result = json.loads(line)
+                key = (result['workload'], result['scaling'], result['device'])
+                series[key].append(result)
+
+    for (workload, scaling, device), results in sorted(series.items()):
+        results.sort(key=lambda r: r['ranks'])
+        print(f"\n{workload}, {scaling} scaling on {device}")
+        header = f"{'ranks':>6} {'N':>10} {'TPS':>10} {'eff':>6}"
+        for p in PHASES:
+            header += f" {p + ' [ms]':>12}"
+        print(header)
+
+        reference = results[0]
+        for result in results:
+            # ideal strong scaling divides the time by the number of ranks,
+            # ideal weak scaling keeps the TPS constant
+            ideal = reference['tps']
+            if scaling == 'strong':
+                ideal *= result['ranks'] / reference['ranks']
+            line = (f"{result['ranks']:>6} {result['N']:>10} "
+                    f"{result['tps']:>10.4g} {result['tps'] / ideal:>6.2f}")
+            for p in PHASES:
+                line += f" {result['phases'][p] * 1e3:>12.4g}"
+            print(line)
+
+
+def main():
+    """Parse the command line."""
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    subparsers = parser.add_subparsers(dest='command', required=True)
+
+    run_parser = subparsers.add_parser('run', help='Run one measurement.')
+    run_parser.add_argument('workload', choices=list(WORKLOADS))
+    size = run_parser.add_mutually_exclusive_group(required=True)
+    size.add_argument('--weak',
+                      type=int,
+                      metavar='N',
+                      help='Number of particles per rank.')
+    size.add_argument('--strong',
+                      type=int,
+                      metavar='N',
+                      help='Total number of particles.')
+    run_parser.add_argument('--device', choices=['CPU', 'GPU'], default='CPU')
+    run_parser.add_argument('--steps', type=int, default=2000)
+    run_parser.add_argument('--warmup',
+                            type=int,
+                            default=1000,
+                            help='Steps to run before measuring.')
+    run_parser.add_argument('--balance',
+                            type=int,
+                            metavar='PERIOD',
+                            help='Balance the domains every PERIOD steps.')
+    run_parser.add_argument('--write',
+                            type=int,
+                            metavar='PERIOD',
+                            help='Write a GSD frame every PERIOD steps.')
+    run_parser.add_argument('-o',
+                            '--output',
+                            default='scaling.jsonl',
+                            help='File to append the results to.')
+    run_parser.set_defaults(function=run)
+
+    report_parser = subparsers.add_parser('report',
+                                          help='Print the scaling table.')
+    report_parser.add_argument('files', nargs='+')
+    report_parser.set_defaults(function=report)
+
+    args = parser.parse_args()
+    args.function(args)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,49 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "ScaleVelocities.h"
+
+/*! \file ScaleVelocities.cc
+    \brief Definition of ScaleVelocities
+*/
+
+namespace hoomd
+    {
+/*! \param sysdef System to scale the velocities of
+    \param trigger Steps on which to scale the velocities
+    \param parameters Parameters given in python, must contain the key factor
+*/
+ScaleVelocities::ScaleVelocities(std::shared_ptr<SystemDefinition> sysdef,
+                                 std::shared_ptr<Trigger> trigger,
+                                 pybind11::dict parameters)
+    : Updater(sysdef, trigger)
+    {
+    if (!parameters.contains("factor"))
+        {
+        throw std::invalid_argument("ScaleVelocities requires the parameter factor.");
+        }
+    m_factor = parameters["factor"].cast<Scalar>();
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    update() runs in the HOOMD run loop with no calls into python.
+*/
+void ScaleVelocities::update(uint64_t timestep)
+    {
+    Updater::update(timestep);
+
+    // access the particle data for writing on the CPU
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                               access_location::host,
+                               access_mode::readwrite);
+
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        {
+        h_vel.data[i].x *= m_factor;
+        h_vel.data[i].y *= m_factor;
+        h_vel.data[i].z *= m_factor;
+        }
+    }
+
+    } // end namespace hoomd
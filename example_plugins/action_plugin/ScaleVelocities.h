@@ -0,0 +1,44 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+// **********************
+// This is a simple example code written for no function purpose other then to demonstrate the steps
+// needed to write an action plugin for HOOMD-Blue. An action plugin is a shared library that HOOMD
+// loads at run time. It needs no python module of its own: hoomd.update.Plugin creates the updater
+// by name and passes it the parameters given by the user.
+
+#pragma once
+
+/*! \file ScaleVelocities.h
+    \brief Declaration of ScaleVelocities
+*/
+
+#include <hoomd/Updater.h>
+
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+//! A particle updater written to demonstrate how to write an action plugin
+/*! This updater multiplies the velocities of all particles by a constant factor when update() is
+    called.
+*/
+class ScaleVelocities : public Updater
+    {
+    public:
+    //! Constructor
+    /*! Action plugins construct each action from the system definition, the trigger, and the
+        parameters given in python.
+    */
+    ScaleVelocities(std::shared_ptr<SystemDefinition> sysdef,
+                    std::shared_ptr<Trigger> trigger,
+                    pybind11::dict parameters);
+
+    //! Scale the velocities
+    virtual void update(uint64_t timestep);
+
+    private:
+    Scalar m_factor; //!< Factor to multiply the velocities by
+    };
+
+    } // end namespace hoomd
@@ -0,0 +1,9 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+"""Example action plugin."""
+
+import pathlib
+
+# Path to the plugin library, pass it to hoomd.update.Plugin.
+library = str(pathlib.Path(__file__).parent / 'libactions.so')
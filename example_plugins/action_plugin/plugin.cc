@@ -0,0 +1,14 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+// Include the defined classes that are to be loaded by the plugin
+#include "ScaleVelocities.h"
+
+#include <hoomd/ActionPlugin.h>
+
+// Define the entry points of the plugin and register each action by name. Use addAnalyzer and
+// addTuner to register writers and tuners.
+HOOMD_ACTION_PLUGIN(registry)
+    {
+    registry.addUpdater<hoomd::ScaleVelocities>("ScaleVelocities");
+    }
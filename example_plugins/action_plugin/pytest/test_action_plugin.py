@@ -0,0 +1,64 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+# Import the plugin module.
+from hoomd import action_plugin
+
+# Import the hoomd Python package.
+import hoomd
+
+import pytest
+import numpy as np
+
+
+def test_updater(simulation_factory, one_particle_snapshot_factory):
+    snap = one_particle_snapshot_factory()
+    if snap.communicator.rank == 0:
+        snap.particles.velocity[0] = [1.0, -2.0, 4.0]
+    sim = simulation_factory(snap)
+
+    # Load the updater from the plugin library.
+    updater = hoomd.update.Plugin(trigger=hoomd.trigger.Periodic(1),
+                                  library=action_plugin.library,
+                                  name='ScaleVelocities',
+                                  parameters=dict(factor=0.5))
+    sim.operations.updaters.append(updater)
+    assert updater.parameters == dict(factor=0.5)
+
+    # Test that the velocity is scaled on every step.
+    sim.run(2)
+    snap = sim.state.get_snapshot()
+    if snap.communicator.rank == 0:
+        np.testing.assert_allclose(snap.particles.velocity[0],
+                                   [0.25, -0.5, 1.0])
+
+    # The trigger is a regular operation parameter.
+    updater.trigger = hoomd.trigger.Periodic(2)
+    sim.run(2)
+    snap = sim.state.get_snapshot()
+    if snap.communicator.rank == 0:
+        np.testing.assert_allclose(snap.particles.velocity[0],
+                                   [0.125, -0.25, 0.5])
+
+
+@pytest.mark.parametrize("operation, name, parameters", [
+    (hoomd.update.Plugin, 'NotAnUpdater', dict(factor=0.5)),
+    (hoomd.write.Plugin, 'ScaleVelocities', dict(factor=0.5)),
+    (hoomd.update.Plugin, 'ScaleVelocities', dict()),
+])
+def test_errors(simulation_factory, one_particle_snapshot_factory, operation,
+                name, parameters):
+    sim = simulation_factory(one_particle_snapshot_factory())
+
+    # Unknown actions and missing parameters raise errors when attaching.
+    plugin = operation(trigger=1,
+                       library=action_plugin.library,
+                       name=name,
+                       parameters=parameters)
+    if operation is hoomd.write.Plugin:
+        sim.operations.writers.append(plugin)
+    else:
+        sim.operations.updaters.append(plugin)
+
+    with pytest.raises(ValueError):
+        sim.run(0)
@@ -8,6 +8,11 @@
 
 #include "AABB.h"
 
+#ifdef ENABLE_TBB
+#include <memory>
+#include <tbb/parallel_invoke.h>
+#endif
+
 #ifndef __AABB_TREE_H__
 #define __AABB_TREE_H__
 
@@ -28,8 +33,9 @@ namespace hoomd
     {
 namespace detail
     {
-const unsigned int NODE_CAPACITY = 16;        //!< Maximum number of particles in a node
-const unsigned int INVALID_NODE = 0xffffffff; //!< Invalid node index sentinel
+const unsigned int NODE_CAPACITY = 16;          //!< Maximum number of particles in a node
+const unsigned int INVALID_NODE = 0xffffffff;   //!< Invalid node index sentinel
+const unsigned int PARALLEL_BUILD_GRAIN = 4096; //!< Largest range built by one parallel build task
 
 #ifndef __HIPCC__
 
@@ -73,6 +79,10 @@ struct PYBIND11_EXPORT AABBNode
    periodically instead of continually updated.
     - buildTree : build an efficiently arranged tree given a complete set of AABBs, one for each
    particle.
+    - Refit : recompute the AABBs of all nodes from a new set of particle AABBs, keeping the tree
+   topology. Runs in O(N) time. Unlike update(), refit() also shrinks the nodes. The quality of the
+   tree degrades as the particles move away from the positions it was built for, which
+   getRelativeSurfaceArea() measures.
 
     **Implementation details**
 
@@ -86,6 +96,19 @@ struct PYBIND11_EXPORT AABBNode
     For performance, no recursive calls are used. Instead, each function is either turned into a
    loop if it uses tail recursion, or it uses a local stack to traverse the tree. The stack is
    cached between calls to limit the amount of dynamic memory allocation.
+
+    **Thread safety**
+
+    query() and the node accessors do not modify the tree. The traversal is stackless, so it keeps
+   no state in the tree and any number of threads may query the same tree at the same time without
+   locks. buildTree(), update(), and refit() modify the nodes and must not run concurrently with
+   any other method.
+
+    With TBB, buildTree(aabbs, N, true) builds the tree in parallel tasks in the current task arena.
+   Each task partitions its range and builds the two halves in child tasks until the ranges have at
+   most PARALLEL_BUILD_GRAIN AABBs. A single task builds the nodes of such a range into a local
+   list. These lists are then copied into the node array in the same order that the serial build
+   allocates the nodes, so the parallel build produces exactly the same tree.
 */
 class PYBIND11_EXPORT AABBTree
     {
@@ -153,7 +176,7 @@ class PYBIND11_EXPORT AABBTree
         }
 
     //! Build a tree smartly from a list of AABBs
-    inline void buildTree(AABB* aabbs, unsigned int N);
+    inline void buildTree(AABB* aabbs, unsigned int N, bool parallel = false);
 
     //! Find all particles that overlap with the query AABB
     inline unsigned int query(std::vector<unsigned int>& hits, const AABB& aabb) const;
@@ -161,6 +184,18 @@ class PYBIND11_EXPORT AABBTree
     //! Update the AABB of a particle
     inline void update(unsigned int idx, const AABB& aabb);
 
+    //! Refit the tree to new AABBs for all particles
+    inline void refit(const AABB* aabbs, unsigned int N);
+
+    //! Get the total surface area of all nodes relative to that of the root node
+    inline Scalar getRelativeSurfaceArea() const;
+
+    //! Get the number of particles in the tree
+    inline unsigned int getNumParticles() const
+        {
+        return (unsigned int)m_mapping.size();
+        }
+
     //! Get the height of a given particle's leaf node
     inline unsigned int height(unsigned int idx);
 
@@ -261,6 +296,55 @@ class PYBIND11_EXPORT AABBTree
                                   unsigned int len,
                                   unsigned int parent);
 
+    //! Merge the AABBs in a range
+    static inline AABB mergeRange(const AABB* aabbs, unsigned int start, unsigned int len);
+
+    //! Assign the particles in a range to a leaf node
+    static inline void fillLeaf(AABBNode& node,
+                                const AABB* aabbs,
+                                const std::vector<unsigned int>& idx,
+                                unsigned int start,
+                                unsigned int len);
+
+    //! Split a range of AABBs into a left and a right side
+    static inline unsigned int partition(AABB* aabbs,
+                                         std::vector<unsigned int>& idx,
+                                         unsigned int start,
+                                         unsigned int len,
+                                         const AABB& my_aabb,
+                                         std::vector<AABB>& aabb_right,
+                                         std::vector<unsigned int>& idx_right);
+
+#ifdef ENABLE_TBB
+    //! Part of the tree built by the parallel build
+    struct Subtree
+        {
+        AABB aabb;                      //!< Bounding box of a split range
+        std::unique_ptr<Subtree> left;  //!< Subtree of the left side of a split range
+        std::unique_ptr<Subtree> right; //!< Subtree of the right side of a split range
+        std::vector<AABBNode> nodes;    //!< Nodes of a range built by one task
+        };
+
+    //! Build the subtree of a range of AABBs in parallel tasks
+    inline std::unique_ptr<Subtree> buildSubtree(AABB* aabbs,
+                                                 std::vector<unsigned int>& idx,
+                                                 unsigned int start,
+                                                 unsigned int len);
+
+    //! Build a node of a subtree recursively into a local list of nodes
+    static inline unsigned int buildLocalNode(AABB* aabbs,
+                                              std::vector<unsigned int>& idx,
+                                              unsigned int start,
+                                              unsigned int len,
+                                              unsigned int parent,
+                                              std::vector<AABBNode>& nodes,
+                                              std::vector<AABB>& aabb_right,
+                                              std::vector<unsigned int>& idx_right);
+
+    //! Copy the nodes of a subtree into the node array
+    inline unsigned int placeSubtree(const Subtree& subtree, unsigned int parent);
+#endif
+
     //! Allocate a new node
     inline unsigned int allocateNode();
 
@@ -357,6 +441,58 @@ inline void AABBTree::update(unsigned int idx, const AABB& aabb)
         }
     }
 
+/*! \param aabbs New AABB of each particle, indexed by particle
+    \param N Number of AABBs in the list, must match the number of particles in the tree
+
+    Set the AABB of every leaf node to the union of its particle AABBs and every internal node to
+    the union of its children. buildNode() allocates the children after their parent, so a reverse
+    sweep over the nodes visits the children first.
+*/
+inline void AABBTree::refit(const AABB* aabbs, unsigned int N)
+    {
+    assert(N == m_mapping.size());
+
+    for (unsigned int node_idx = m_num_nodes; node_idx-- > 0;)
+        {
+        AABBNode& node = m_nodes[node_idx];
+        if (node.left == INVALID_NODE)
+            {
+            AABB aabb = aabbs[node.particles[0]];
+            for (unsigned int i = 1; i < node.num_particles; i++)
+                aabb = merge(aabb, aabbs[node.particles[i]]);
+            node.aabb = aabb;
+            }
+        else
+            {
+            node.aabb = merge(m_nodes[node.left].aabb, m_nodes[node.right].aabb);
+            }
+        }
+    }
+
+/*! \returns The sum of the surface areas of all nodes divided by the surface area of the root
+
+    The expected cost of a query grows with the surface area of the nodes it has to test. The ratio
+   is independent of the overall scale, so it can be compared before and after a change of the box.
+*/
+inline Scalar AABBTree::getRelativeSurfaceArea() const
+    {
+    if (m_num_nodes == 0)
+        return Scalar(0.0);
+
+    auto surface_area = [](const AABB& aabb)
+    {
+        vec3<Scalar> L = aabb.getUpper() - aabb.getLower();
+        return Scalar(2.0) * (L.x * L.y + L.y * L.z + L.z * L.x);
+    };
+
+    Scalar total = Scalar(0.0);
+    for (unsigned int node_idx = 0; node_idx < m_num_nodes; node_idx++)
+        total += surface_area(m_nodes[node_idx].aabb);
+
+    Scalar root = surface_area(m_nodes[m_root].aabb);
+    return root > Scalar(0.0) ? total / root : Scalar(0.0);
+    }
+
 /*! \param idx Particle to get height for
     \returns Height of the node
 */
@@ -386,11 +522,16 @@ inline unsigned int AABBTree::height(unsigned int idx)
 
 /*! \param aabbs List of AABBs for each particle (must be 32-byte aligned)
     \param N Number of AABBs in the list
+    \param parallel Set to true to build the tree in parallel tasks (requires TBB)
 
     Builds a balanced tree from a given list of AABBs for each particle. Data in \a aabbs will be
    modified during the construction process.
+
+    The parallel build runs in the task arena of the caller. Call it in the arena of the
+   ExecutionConfiguration to limit the build to the threads given by the user. Without TBB, or with
+   at most PARALLEL_BUILD_GRAIN AABBs, \a parallel has no effect.
 */
-inline void AABBTree::buildTree(AABB* aabbs, unsigned int N)
+inline void AABBTree::buildTree(AABB* aabbs, unsigned int N, bool parallel)
     {
     init(N);
 
@@ -399,6 +540,16 @@ inline void AABBTree::buildTree(AABB* aabbs, unsigned int N)
     for (unsigned int i = 0; i < N; i++)
         m_idx.push_back(i);
 
+#ifdef ENABLE_TBB
+    if (parallel && N > PARALLEL_BUILD_GRAIN)
+        {
+        std::unique_ptr<Subtree> subtree = buildSubtree(aabbs, m_idx, 0, N);
+        m_root = placeSubtree(*subtree, INVALID_NODE);
+        updateSkip(m_root);
+        return;
+        }
+#endif
+
     m_root = buildNode(aabbs, m_idx, 0, N, INVALID_NODE);
     updateSkip(m_root);
     }
@@ -424,13 +575,7 @@ inline unsigned int AABBTree::buildNode(AABB* aabbs,
                                         unsigned int len,
                                         unsigned int parent)
     {
-    // merge all the AABBs into one
-    AABB my_aabb = aabbs[start];
-    for (unsigned int i = 1; i < len; i++)
-        {
-        my_aabb = merge(my_aabb, aabbs[start + i]);
-        }
-    vec3<Scalar> my_radius = my_aabb.getUpper() - my_aabb.getLower();
+    AABB my_aabb = mergeRange(aabbs, start, len);
 
     // handle the case of a leaf node creation
     if (len <= NODE_CAPACITY)
@@ -438,17 +583,11 @@ inline unsigned int AABBTree::buildNode(AABB* aabbs,
         unsigned int new_node = allocateNode();
         m_nodes[new_node].aabb = my_aabb;
         m_nodes[new_node].parent = parent;
-        m_nodes[new_node].num_particles = len;
+        fillLeaf(m_nodes[new_node], aabbs, idx, start, len);
 
+        // assign the reverse mapping from particle indices to leaf node indices
         for (unsigned int i = 0; i < len; i++)
-            {
-            // assign the particle indices into the leaf node
-            m_nodes[new_node].particles[i] = idx[start + i];
-            m_nodes[new_node].particle_tags[i] = aabbs[start + i].tag;
-
-            // assign the reverse mapping from particle indices to leaf node indices
             m_mapping[idx[start + i]] = new_node;
-            }
 
         return new_node;
         }
@@ -457,9 +596,86 @@ inline unsigned int AABBTree::buildNode(AABB* aabbs,
     unsigned int my_idx = allocateNode();
 
     // need to split the list of aabbs into two sets for left and right
+    unsigned int start_right
+        = partition(aabbs, idx, start, len, my_aabb, m_aabb_right, m_idx_right);
+
+    // note: calling buildNode has side effects, the m_nodes array may be reallocated. So we need to
+    // determine the left and right children, then build our node (can't say m_nodes[my_idx].left =
+    // buildNode(...))
+    unsigned int new_left = buildNode(aabbs, idx, start, start_right, my_idx);
+    unsigned int new_right = buildNode(aabbs, idx, start + start_right, len - start_right, my_idx);
+
+    // now, create the children and connect them up
+    m_nodes[my_idx].aabb = my_aabb;
+    m_nodes[my_idx].parent = parent;
+    m_nodes[my_idx].left = new_left;
+    m_nodes[my_idx].right = new_right;
+
+    return my_idx;
+    }
+
+/*! \param aabbs List of AABBs
+    \param start Start point in aabbs to examine
+    \param len Number of aabbs to examine (at least 1)
+    \returns The union of the AABBs
+*/
+inline AABB AABBTree::mergeRange(const AABB* aabbs, unsigned int start, unsigned int len)
+    {
+    AABB my_aabb = aabbs[start];
+    for (unsigned int i = 1; i < len; i++)
+        {
+        my_aabb = merge(my_aabb, aabbs[start + i]);
+        }
+    return my_aabb;
+    }
+
+/*! \param node Leaf node
+    \param aabbs List of AABBs
+    \param idx List of indices
+    \param start Start point in aabbs and idx to examine
+    \param len Number of aabbs to assign (at most NODE_CAPACITY)
+*/
+inline void AABBTree::fillLeaf(AABBNode& node,
+                               const AABB* aabbs,
+                               const std::vector<unsigned int>& idx,
+                               unsigned int start,
+                               unsigned int len)
+    {
+    node.num_particles = len;
+
+    for (unsigned int i = 0; i < len; i++)
+        {
+        // assign the particle indices into the leaf node
+        node.particles[i] = idx[start + i];
+        node.particle_tags[i] = aabbs[start + i].tag;
+        }
+    }
+
+/*! \param aabbs List of AABBs
+    \param idx List of indices
+    \param start Start point in aabbs and idx to examine
+    \param len Number of aabbs to examine
+    \param my_aabb Union of the AABBs in the range
+    \param aabb_right Temporary list for the AABBs on the right side
+    \param idx_right Temporary list for the indices on the right side
+    \returns The number of AABBs on the left side
+
+    Split the longest dimension of \a my_aabb in half. Use a stable partition to keep particles in
+   index order. Neither side is left empty.
+*/
+inline unsigned int AABBTree::partition(AABB* aabbs,
+                                        std::vector<unsigned int>& idx,
+                                        unsigned int start,
+                                        unsigned int len,
+                                        const AABB& my_aabb,
+                                        std::vector<AABB>& aabb_right,
+                                        std::vector<unsigned int>& idx_right)
+    {
+    vec3<Scalar> my_radius = my_aabb.getUpper() - my_aabb.getLower();
+
     unsigned int left_insert_point = 0;
-    m_idx_right.clear();
-    m_aabb_right.clear();
+    aabb_right.clear();
+    idx_right.clear();
 
     // if there are only 2 aabbs, put one on each side
     if (len == 2)
@@ -468,9 +684,6 @@ inline unsigned int AABBTree::buildNode(AABB* aabbs,
         }
     else
         {
-        // Otherwise, we need to split them based on a heuristic. Split the longest dimension in
-        // half. Use a stable partition to keep particles in index order.
-
         for (unsigned int i = 0; i < len; i++)
             {
             bool on_left = false;
@@ -503,17 +716,17 @@ inline unsigned int AABBTree::buildNode(AABB* aabbs,
             else
                 {
                 // Add the right side AABBs to a temporary list.
-                m_aabb_right.push_back(aabbs[start + i]);
-                m_idx_right.push_back(idx[start + i]);
+                aabb_right.push_back(aabbs[start + i]);
+                idx_right.push_back(idx[start + i]);
                 }
             }
 
-        assert(m_aabb_right.size() == m_idx_right.size());
-        assert(left_insert_point + m_aabb_right.size() == len);
+        assert(aabb_right.size() == idx_right.size());
+        assert(left_insert_point + aabb_right.size() == len);
 
         // Copy the right AABBs back into the list.
-        std::copy(m_aabb_right.begin(), m_aabb_right.end(), aabbs + start + left_insert_point);
-        std::copy(m_idx_right.begin(), m_idx_right.end(), idx.begin() + start + left_insert_point);
+        std::copy(aabb_right.begin(), aabb_right.end(), aabbs + start + left_insert_point);
+        std::copy(idx_right.begin(), idx_right.end(), idx.begin() + start + left_insert_point);
         }
 
     // sanity check. The left or right tree may have ended up empty. If so, just borrow one particle
@@ -524,20 +737,163 @@ inline unsigned int AABBTree::buildNode(AABB* aabbs,
     if (start_right == 0)
         start_right = 1;
 
-    // note: calling buildNode has side effects, the m_nodes array may be reallocated. So we need to
-    // determine the left and right children, then build our node (can't say m_nodes[my_idx].left =
-    // buildNode(...))
-    unsigned int new_left = buildNode(aabbs, idx, start, start_right, my_idx);
-    unsigned int new_right = buildNode(aabbs, idx, start + start_right, len - start_right, my_idx);
+    return start_right;
+    }
 
-    // now, create the children and connect them up
-    m_nodes[my_idx].aabb = my_aabb;
+#ifdef ENABLE_TBB
+/*! \param aabbs List of AABBs
+    \param idx List of indices
+    \param start Start point in aabbs and idx to examine
+    \param len Number of aabbs to examine
+    \returns The subtree of the range
+
+    Ranges with more than PARALLEL_BUILD_GRAIN AABBs are split like in buildNode() and the two
+   sides are built in parallel tasks. The tasks write to disjoint parts of \a aabbs and \a idx.
+*/
+inline std::unique_ptr<AABBTree::Subtree> AABBTree::buildSubtree(AABB* aabbs,
+                                                                 std::vector<unsigned int>& idx,
+                                                                 unsigned int start,
+                                                                 unsigned int len)
+    {
+    std::unique_ptr<Subtree> subtree(new Subtree());
+
+    if (len <= PARALLEL_BUILD_GRAIN)
+        {
+        std::vector<AABB> aabb_right;
+        std::vector<unsigned int> idx_right;
+        buildLocalNode(aabbs,
+                       idx,
+                       start,
+                       len,
+                       INVALID_NODE,
+                       subtree->nodes,
+                       aabb_right,
+                       idx_right);
+        return subtree;
+        }
+
+    subtree->aabb = mergeRange(aabbs, start, len);
+
+    unsigned int start_right;
+        {
+        // free the temporary lists before building the children
+        std::vector<AABB> aabb_right;
+        std::vector<unsigned int> idx_right;
+        start_right = partition(aabbs, idx, start, len, subtree->aabb, aabb_right, idx_right);
+        }
+
+    tbb::parallel_invoke([&] { subtree->left = buildSubtree(aabbs, idx, start, start_right); },
+                         [&]
+                         {
+                             subtree->right
+                                 = buildSubtree(aabbs, idx, start + start_right, len - start_right);
+                         });
+
+    return subtree;
+    }
+
+/*! \param aabbs List of AABBs
+    \param idx List of indices
+    \param start Start point in aabbs and idx to examine
+    \param len Number of aabbs to examine
+    \param parent Index of the parent node in \a nodes
+    \param nodes List of nodes to add to
+    \param aabb_right Temporary list for the AABBs on the right side
+    \param idx_right Temporary list for the indices on the right side
+    \returns The index of the new node in \a nodes
+
+    buildLocalNode() builds the same nodes as buildNode(), in the same order, but indexes them in
+   \a nodes. It does not modify the tree, so the tasks of the parallel build may call it
+   concurrently on disjoint ranges.
+*/
+inline unsigned int AABBTree::buildLocalNode(AABB* aabbs,
+                                             std::vector<unsigned int>& idx,
+                                             unsigned int start,
+                                             unsigned int len,
+                                             unsigned int parent,
+                                             std::vector<AABBNode>& nodes,
+                                             std::vector<AABB>& aabb_right,
+                                             std::vector<unsigned int>& idx_right)
+    {
+    AABB my_aabb = mergeRange(aabbs, start, len);
+
+    unsigned int my_idx = (unsigned int)nodes.size();
+    nodes.push_back(AABBNode());
+    nodes[my_idx].aabb = my_aabb;
+    nodes[my_idx].parent = parent;
+
+    if (len <= NODE_CAPACITY)
+        {
+        fillLeaf(nodes[my_idx], aabbs, idx, start, len);
+        return my_idx;
+        }
+
+    unsigned int start_right = partition(aabbs, idx, start, len, my_aabb, aabb_right, idx_right);
+
+    // push_back may reallocate nodes, so set the children after building them
+    unsigned int new_left
+        = buildLocalNode(aabbs, idx, start, start_right, my_idx, nodes, aabb_right, idx_right);
+    unsigned int new_right = buildLocalNode(aabbs,
+                                            idx,
+                                            start + start_right,
+                                            len - start_right,
+                                            my_idx,
+                                            nodes,
+                                            aabb_right,
+                                            idx_right);
+    nodes[my_idx].left = new_left;
+    nodes[my_idx].right = new_right;
+
+    return my_idx;
+    }
+
+/*! \param subtree Subtree to copy
+    \param parent Index of the parent node in the tree
+    \returns The index of the root of the subtree in the tree
+
+    placeSubtree() allocates the nodes in the same order as buildNode(): a node first, then the
+   nodes of its left child, then those of its right child.
+*/
+inline unsigned int AABBTree::placeSubtree(const Subtree& subtree, unsigned int parent)
+    {
+    if (!subtree.left)
+        {
+        // the nodes of a subtree built by one task are already in order
+        unsigned int offset = m_num_nodes;
+        for (unsigned int i = 0; i < subtree.nodes.size(); i++)
+            {
+            unsigned int node_idx = allocateNode();
+            AABBNode& node = m_nodes[node_idx];
+            node = subtree.nodes[i];
+
+            node.parent = (i == 0) ? parent : node.parent + offset;
+            if (node.left == INVALID_NODE)
+                {
+                // assign the reverse mapping from particle indices to leaf node indices
+                for (unsigned int j = 0; j < node.num_particles; j++)
+                    m_mapping[node.particles[j]] = node_idx;
+                }
+            else
+                {
+                node.left += offset;
+                node.right += offset;
+                }
+            }
+        return offset;
+        }
+
+    unsigned int my_idx = allocateNode();
+    unsigned int new_left = placeSubtree(*subtree.left, my_idx);
+    unsigned int new_right = placeSubtree(*subtree.right, my_idx);
+
+    m_nodes[my_idx].aabb = subtree.aabb;
     m_nodes[my_idx].parent = parent;
     m_nodes[my_idx].left = new_left;
     m_nodes[my_idx].right = new_right;
 
     return my_idx;
     }
+#endif
 
 /*! \param idx Index of the node to update
 
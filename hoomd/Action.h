@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <pybind11/pybind11.h>
+#include <string>
 #include <vector>
 
 #include "Autotuned.h"
@@ -34,6 +35,16 @@ class Action : public Autotuned
         {
         }
 
+    /// Get the name that identifies this action in the profiler
+    const std::string& getProfileName()
+        {
+        if (m_profile_name.empty())
+            {
+            m_profile_name = detail::getProfileName(typeid(*this));
+            }
+        return m_profile_name;
+        }
+
     protected:
     /// The system definition this action is associated with.
     const std::shared_ptr<SystemDefinition> m_sysdef;
@@ -47,6 +58,9 @@ class Action : public Autotuned
     /// Stored shared ptr to the system signals
     std::vector<std::shared_ptr<hoomd::detail::SignalSlot>> m_slots;
 
+    /// Name of this action in the profiler (determined on first use)
+    std::string m_profile_name;
+
     void addSlot(std::shared_ptr<hoomd::detail::SignalSlot> slot)
         {
         m_slots.push_back(slot);
@@ -0,0 +1,194 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "ActionPlugin.h"
+
+#include <dlfcn.h>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string.h>
+
+/*! \file ActionPlugin.cc
+    \brief Defines ActionPlugin
+*/
+
+namespace hoomd
+    {
+namespace
+    {
+//! Signature of hoomd_action_plugin_build()
+typedef const char* (*ActionPluginBuildFunction)();
+
+//! Signature of hoomd_register_action_plugin()
+typedef void (*ActionPluginRegisterFunction)(ActionPluginRegistry&);
+
+//! Open a plugin library and register its actions
+std::shared_ptr<const ActionPluginRegistry> loadActionPlugin(const std::string& filename)
+    {
+    // register each library once, the registrations are shared by all ActionPlugin instances
+    static std::mutex mutex;
+    static std::map<std::string, std::shared_ptr<const ActionPluginRegistry>> loaded;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = loaded.find(filename);
+    if (it != loaded.end())
+        {
+        return it->second;
+        }
+
+    // the library is never closed: the actions it creates run code in the library
+    void* handle = dlopen(filename.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle)
+        {
+        throw std::runtime_error("Error loading action plugin " + filename + ": " + dlerror());
+        }
+
+    auto build = reinterpret_cast<ActionPluginBuildFunction>(
+        dlsym(handle, "hoomd_action_plugin_build"));
+    auto register_actions = reinterpret_cast<ActionPluginRegisterFunction>(
+        dlsym(handle, "hoomd_register_action_plugin"));
+    if (!build || !register_actions)
+        {
+        throw std::runtime_error(filename
+                                 + " is not an action plugin. Define its entry points with "
+                                   "HOOMD_ACTION_PLUGIN.");
+        }
+
+    if (strcmp(build(), HOOMD_ACTION_PLUGIN_BUILD) != 0)
+        {
+        std::ostringstream s;
+        s << "Action plugin " << filename << " was compiled for a different HOOMD build ("
+          << build() << "), expected (" << HOOMD_ACTION_PLUGIN_BUILD << "). Recompile the plugin "
+          << "against this installation of HOOMD.";
+        throw std::runtime_error(s.str());
+        }
+
+    auto registry = std::make_shared<ActionPluginRegistry>();
+    register_actions(*registry);
+    loaded[filename] = registry;
+    return registry;
+    }
+
+//! Find an action by name
+template<class Factory>
+const Factory& findAction(const std::map<std::string, Factory>& actions,
+                          const std::string& name,
+                          const std::string& kind,
+                          const std::string& filename)
+    {
+    auto it = actions.find(name);
+    if (it == actions.end())
+        {
+        std::ostringstream s;
+        s << "Action plugin " << filename << " has no " << kind << " named " << name
+          << ". Available: ";
+        for (auto action = actions.begin(); action != actions.end(); ++action)
+            {
+            if (action != actions.begin())
+                s << ", ";
+            s << action->first;
+            }
+        s << ".";
+        throw std::invalid_argument(s.str());
+        }
+    return it->second;
+    }
+
+//! List the names of actions
+template<class Factory> pybind11::list getNames(const std::map<std::string, Factory>& actions)
+    {
+    pybind11::list result;
+    for (const auto& action : actions)
+        {
+        result.append(action.first);
+        }
+    return result;
+    }
+
+    } // end anonymous namespace
+
+/*! \param filename Path to the plugin library, passed to dlopen()
+ */
+ActionPlugin::ActionPlugin(const std::string& filename)
+    : m_filename(filename), m_registry(loadActionPlugin(filename))
+    {
+    }
+
+/*! \param name Name of the updater in the plugin
+    \param sysdef System definition
+    \param trigger Steps on which to run the updater
+    \param parameters Parameters passed to the constructor of the updater
+*/
+std::shared_ptr<Updater> ActionPlugin::createUpdater(const std::string& name,
+                                                     std::shared_ptr<SystemDefinition> sysdef,
+                                                     std::shared_ptr<Trigger> trigger,
+                                                     pybind11::dict parameters) const
+    {
+    return findAction(m_registry->getUpdaters(), name, "updater", m_filename)(sysdef,
+                                                                              trigger,
+                                                                              parameters);
+    }
+
+/*! \param name Name of the analyzer in the plugin
+    \param sysdef System definition
+    \param trigger Steps on which to run the analyzer
+    \param parameters Parameters passed to the constructor of the analyzer
+*/
+std::shared_ptr<Analyzer> ActionPlugin::createAnalyzer(const std::string& name,
+                                                       std::shared_ptr<SystemDefinition> sysdef,
+                                                       std::shared_ptr<Trigger> trigger,
+                                                       pybind11::dict parameters) const
+    {
+    return findAction(m_registry->getAnalyzers(), name, "analyzer", m_filename)(sysdef,
+                                                                                trigger,
+                                                                                parameters);
+    }
+
+/*! \param name Name of the tuner in the plugin
+    \param sysdef System definition
+    \param trigger Steps on which to run the tuner
+    \param parameters Parameters passed to the constructor of the tuner
+*/
+std::shared_ptr<Tuner> ActionPlugin::createTuner(const std::string& name,
+                                                 std::shared_ptr<SystemDefinition> sysdef,
+                                                 std::shared_ptr<Trigger> trigger,
+                                                 pybind11::dict parameters) const
+    {
+    return findAction(m_registry->getTuners(), name, "tuner", m_filename)(sysdef,
+                                                                          trigger,
+                                                                          parameters);
+    }
+
+pybind11::list ActionPlugin::getUpdaterNames() const
+    {
+    return getNames(m_registry->getUpdaters());
+    }
+
+pybind11::list ActionPlugin::getAnalyzerNames() const
+    {
+    return getNames(m_registry->getAnalyzers());
+    }
+
+pybind11::list ActionPlugin::getTunerNames() const
+    {
+    return getNames(m_registry->getTuners());
+    }
+
+namespace detail
+    {
+void export_ActionPlugin(pybind11::module& m)
+    {
+    pybind11::class_<ActionPlugin, std::shared_ptr<ActionPlugin>>(m, "ActionPlugin")
+        .def(pybind11::init<const std::string&>())
+        .def("createUpdater", &ActionPlugin::createUpdater)
+        .def("createAnalyzer", &ActionPlugin::createAnalyzer)
+        .def("createTuner", &ActionPlugin::createTuner)
+        .def_property_readonly("updaters", &ActionPlugin::getUpdaterNames)
+        .def_property_readonly("analyzers", &ActionPlugin::getAnalyzerNames)
+        .def_property_readonly("tuners", &ActionPlugin::getTunerNames);
+    }
+
+    } // end namespace detail
+
+    } // end namespace hoomd
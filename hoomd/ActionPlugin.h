@@ -0,0 +1,209 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#pragma once
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "Analyzer.h"
+#include "HOOMDVersion.h"
+#include "Tuner.h"
+#include "Updater.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <pybind11/pybind11.h>
+#include <string>
+
+/*! \file ActionPlugin.h
+    \brief Declares the interface to load updaters, analyzers, and tuners from shared libraries
+*/
+
+//! Version of the action plugin interface
+/*! Increment when the entry points or ActionPluginRegistry change.
+ */
+#define HOOMD_ACTION_PLUGIN_ABI_VERSION 1
+
+#define HOOMD_ACTION_PLUGIN_STRINGIFY_(x) #x
+#define HOOMD_ACTION_PLUGIN_STRINGIFY(x) HOOMD_ACTION_PLUGIN_STRINGIFY_(x)
+
+#ifdef ENABLE_MPI
+#define HOOMD_ACTION_PLUGIN_MPI " mpi"
+#else
+#define HOOMD_ACTION_PLUGIN_MPI ""
+#endif
+
+#ifdef ENABLE_HIP
+#define HOOMD_ACTION_PLUGIN_HIP " hip"
+#else
+#define HOOMD_ACTION_PLUGIN_HIP ""
+#endif
+
+#ifdef ENABLE_TBB
+#define HOOMD_ACTION_PLUGIN_TBB " tbb"
+#else
+#define HOOMD_ACTION_PLUGIN_TBB ""
+#endif
+
+//! Build configuration that a plugin must share with HOOMD to be loaded
+/*! The layout of the HOOMD classes depends on the version and on the build options. A plugin
+    compiled against a different configuration could not safely use them.
+*/
+#define HOOMD_ACTION_PLUGIN_BUILD                                                                  \
+    "abi " HOOMD_ACTION_PLUGIN_STRINGIFY(HOOMD_ACTION_PLUGIN_ABI_VERSION)                          \
+    " hoomd " HOOMD_VERSION HOOMD_ACTION_PLUGIN_MPI HOOMD_ACTION_PLUGIN_HIP                        \
+    HOOMD_ACTION_PLUGIN_TBB " long " HOOMD_ACTION_PLUGIN_STRINGIFY(HOOMD_LONGREAL_SIZE)            \
+    " short " HOOMD_ACTION_PLUGIN_STRINGIFY(HOOMD_SHORTREAL_SIZE)
+
+//! Define the entry points of an action plugin
+/*! Use HOOMD_ACTION_PLUGIN once in a plugin library, followed by the body of the function that
+    registers the actions:
+
+    \code
+    HOOMD_ACTION_PLUGIN(registry)
+        {
+        registry.addUpdater<MyUpdater>("MyUpdater");
+        }
+    \endcode
+*/
+#define HOOMD_ACTION_PLUGIN(registry)                                                              \
+    extern "C" PYBIND11_EXPORT const char* hoomd_action_plugin_build()                             \
+        {                                                                                          \
+        return HOOMD_ACTION_PLUGIN_BUILD;                                                          \
+        }                                                                                          \
+    extern "C" PYBIND11_EXPORT void hoomd_register_action_plugin(                                  \
+        hoomd::ActionPluginRegistry& registry)
+
+namespace hoomd
+    {
+//! Collects the actions that an action plugin library provides
+/*! A plugin library registers each of its actions by name and kind in the function defined by
+    HOOMD_ACTION_PLUGIN. Each action class T must provide the constructor
+
+    \code
+    T(std::shared_ptr<SystemDefinition> sysdef,
+      std::shared_ptr<Trigger> trigger,
+      pybind11::dict parameters);
+    \endcode
+
+    where \a parameters holds the parameters given by the user in Python. The constructor runs with
+    the GIL held. The actions execute in the run loop like any other C++ operation, so they may
+    use ArrayHandle to access the particle data and they make no calls into Python.
+*/
+class PYBIND11_EXPORT ActionPluginRegistry
+    {
+    public:
+    //! Function that constructs an action
+    template<class Base>
+    using Factory = std::function<std::shared_ptr<Base>(std::shared_ptr<SystemDefinition>,
+                                                        std::shared_ptr<Trigger>,
+                                                        pybind11::dict)>;
+
+    //! Register an Updater
+    template<class T> void addUpdater(const std::string& name)
+        {
+        m_updaters[name] = makeFactory<Updater, T>();
+        }
+
+    //! Register an Analyzer
+    template<class T> void addAnalyzer(const std::string& name)
+        {
+        m_analyzers[name] = makeFactory<Analyzer, T>();
+        }
+
+    //! Register a Tuner
+    template<class T> void addTuner(const std::string& name)
+        {
+        m_tuners[name] = makeFactory<Tuner, T>();
+        }
+
+    //! Get the registered updaters
+    const std::map<std::string, Factory<Updater>>& getUpdaters() const
+        {
+        return m_updaters;
+        }
+
+    //! Get the registered analyzers
+    const std::map<std::string, Factory<Analyzer>>& getAnalyzers() const
+        {
+        return m_analyzers;
+        }
+
+    //! Get the registered tuners
+    const std::map<std::string, Factory<Tuner>>& getTuners() const
+        {
+        return m_tuners;
+        }
+
+    private:
+    std::map<std::string, Factory<Updater>> m_updaters;   //!< Updaters by name
+    std::map<std::string, Factory<Analyzer>> m_analyzers; //!< Analyzers by name
+    std::map<std::string, Factory<Tuner>> m_tuners;       //!< Tuners by name
+
+    //! Make a factory for the action class T
+    template<class Base, class T> static Factory<Base> makeFactory()
+        {
+        return [](std::shared_ptr<SystemDefinition> sysdef,
+                  std::shared_ptr<Trigger> trigger,
+                  pybind11::dict parameters) -> std::shared_ptr<Base>
+        {
+            return std::make_shared<T>(sysdef, trigger, parameters);
+        };
+        }
+    };
+
+//! Action plugin library loaded at run time
+/*! ActionPlugin opens a shared library with dlopen(), checks that the library was compiled against
+    the same HOOMD build configuration, and calls its registration function. Each library is loaded
+    and registered once per process and is never closed, so the actions it creates remain valid for
+    the lifetime of the process.
+*/
+class PYBIND11_EXPORT ActionPlugin
+    {
+    public:
+    //! Load a plugin library
+    ActionPlugin(const std::string& filename);
+
+    //! Create an updater
+    std::shared_ptr<Updater> createUpdater(const std::string& name,
+                                           std::shared_ptr<SystemDefinition> sysdef,
+                                           std::shared_ptr<Trigger> trigger,
+                                           pybind11::dict parameters) const;
+
+    //! Create an analyzer
+    std::shared_ptr<Analyzer> createAnalyzer(const std::string& name,
+                                             std::shared_ptr<SystemDefinition> sysdef,
+                                             std::shared_ptr<Trigger> trigger,
+                                             pybind11::dict parameters) const;
+
+    //! Create a tuner
+    std::shared_ptr<Tuner> createTuner(const std::string& name,
+                                       std::shared_ptr<SystemDefinition> sysdef,
+                                       std::shared_ptr<Trigger> trigger,
+                                       pybind11::dict parameters) const;
+
+    //! Get the names of the registered updaters
+    pybind11::list getUpdaterNames() const;
+
+    //! Get the names of the registered analyzers
+    pybind11::list getAnalyzerNames() const;
+
+    //! Get the names of the registered tuners
+    pybind11::list getTunerNames() const;
+
+    private:
+    std::string m_filename;                                 //!< Name of the plugin library
+    std::shared_ptr<const ActionPluginRegistry> m_registry; //!< Actions of the plugin library
+    };
+
+namespace detail
+    {
+//! Export ActionPlugin to python
+void export_ActionPlugin(pybind11::module& m);
+
+    } // end namespace detail
+
+    } // end namespace hoomd
@@ -42,6 +42,18 @@ class PYBIND11_EXPORT Autotuned
         return params;
         }
 
+    /// Get the telemetry of the autotuned kernels.
+    pybind11::dict getAutotunerTelemetry()
+        {
+        pybind11::dict telemetry;
+
+        for (const auto& tuner : m_autotuners)
+            {
+            telemetry[tuner->getName().c_str()] = tuner->getTelemetryPython();
+            }
+        return telemetry;
+        }
+
     /// Set autotuner parameters.
     void setAutotunerParameters(pybind11::dict params)
         {
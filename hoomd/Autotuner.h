@@ -10,6 +10,7 @@
 */
 
 #include "ExecutionConfiguration.h"
+#include "Profiler.h"
 
 #ifdef ENABLE_MPI
 #include "HOOMDMPI.h"
@@ -18,6 +19,7 @@
 #include <algorithm>
 #include <array>
 #include <cfloat>
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <sstream>
@@ -77,9 +79,23 @@ class PYBIND11_EXPORT AutotunerBase
 
     /// Set autother parameters from a Python tuple.
     virtual void setParameterPython(pybind11::tuple parameter) {};
+
+    /// Get the telemetry of the tuned kernel as a Python dict.
+    virtual pybind11::dict getTelemetryPython()
+        {
+        return pybind11::dict();
+        }
 #endif
 
 #ifdef ENABLE_HIP
+    /// Get the theoretical peak memory bandwidth of the active device in GB/s.
+    static double getPeakBandwidth(const std::shared_ptr<const ExecutionConfiguration> exec_conf)
+        {
+        // memoryClockRate is in kHz and memoryBusWidth is in bits, memory transfers on both edges
+        return 2.0 * double(exec_conf->dev_prop.memoryClockRate) * 1e3
+               * double(exec_conf->dev_prop.memoryBusWidth) / 8.0 / 1e9;
+        }
+
     /// Build a block size range that steps on the warp size.
     static std::vector<unsigned int>
     makeBlockSizeRange(const std::shared_ptr<const ExecutionConfiguration> exec_conf)
@@ -165,6 +181,25 @@ class PYBIND11_EXPORT AutotunerBase
     scanning. This prevents the optional autotuners from flagging the whole class as not complete
     indefinitely. This is implemented with an INACTIVE state that goes to SCANNING on the first
     call to begin().
+
+    When the execution configuration has an AutotunerCache, the first call to begin() looks up the
+    parameter stored for this autotuner's name and, when there is a valid one, uses it and skips
+    the scan. Completed scans store their optimal parameter in the cache. Later calls to
+    startScan() always scan.
+
+    After the scan, Autotuner keeps timing the launches with the optimal parameter without
+    synchronizing. begin() collects the previous timing when its events have completed and skips
+    the timing of launches while one is still in flight. Callers may report the estimated number
+    of bytes that the kernel reads and writes with setBytes() between begin() and end().
+    getTelemetryPython() reports the mean time per launch and the achieved memory bandwidth.
+
+    When the execution configuration enables successive halving, a scan proceeds in rounds
+    instead. Each round takes one sample of every remaining parameter and then keeps the faster
+    half, judged by all samples taken so far. The scan ends when one parameter remains or when the
+    spread between the slowest and the fastest remaining parameters falls below the execution
+    configuration's stop threshold. Such a scan takes about twice as many samples as there are
+    parameters, where the full scan takes n_samples per parameter. All autotuners already sample
+    their kernels on every step, so this shortens the tuning phase of the whole simulation.
 */
 template<size_t n_dimensions> class PYBIND11_EXPORT Autotuner : public AutotunerBase
     {
@@ -197,6 +232,27 @@ template<size_t n_dimensions> class PYBIND11_EXPORT Autotuner : public Autotuner
         m_current_sample = 0;
         m_current_param = m_parameters[m_current_element];
 
+        resetTelemetry();
+
+        m_successive_halving = m_exec_conf->getAutotunerSuccessiveHalving();
+        m_stop_threshold = m_exec_conf->getAutotunerStopThreshold();
+        if (m_successive_halving)
+            {
+            m_candidates.resize(m_parameters.size());
+            for (unsigned int i = 0; i < m_parameters.size(); i++)
+                {
+                m_candidates[i] = i;
+                m_samples[i].clear();
+                }
+            }
+        else
+            {
+            for (unsigned int i = 0; i < m_parameters.size(); i++)
+                {
+                m_samples[i].resize(m_n_samples);
+                }
+            }
+
         if (m_optional)
             {
             m_state = INACTIVE;
@@ -215,15 +271,48 @@ template<size_t n_dimensions> class PYBIND11_EXPORT Autotuner : public Autotuner
             m_state = SCANNING;
             }
 
+        if (m_state == SCANNING && !m_cache_checked)
+            {
+            m_cache_checked = true;
+            applyCachedParameter();
+            }
+
+        m_bytes = 0;
+
 #ifdef ENABLE_HIP
-        // if we are scanning, record a cuda event - otherwise do nothing
+        // if we are scanning, record a cuda event
         if (m_state == SCANNING)
             {
             hipEventRecord(m_start, 0);
             if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
                 CHECK_CUDA_ERROR();
             }
+        // otherwise, time the launch when the previous timing has completed
+        else if (m_state == IDLE)
+            {
+            collectTelemetry();
+            if (!m_telemetry_pending)
+                {
+                hipEventRecord(m_start, 0);
+                m_telemetry_recording = true;
+                }
+            }
 #endif
+
+        // trace the kernel launch while a profiler records a trace
+        m_trace = Profiler::getTracing();
+        if (m_trace)
+            {
+            m_trace->beginTrace(m_name, m_state == SCANNING ? "autotuner scan" : "kernel");
+            }
+        }
+
+    /// Set the estimated number of bytes that the kernel launch reads and writes.
+    /*! \param bytes Number of bytes, call between begin() and end().
+     */
+    void setBytes(uint64_t bytes)
+        {
+        m_bytes = bytes;
         }
 
     /// Call after kernel launch.
@@ -283,11 +372,52 @@ template<size_t n_dimensions> class PYBIND11_EXPORT Autotuner : public Autotuner
         m_current_param = cpp_param;
         m_state = IDLE;
         m_current_sample = 0;
+        resetTelemetry();
 
         m_exec_conf->msg->notice(4) << "Autotuner " << m_name << " setting user-defined parameter "
                                     << formatParam(cpp_param) << std::endl;
         }
 
+    /// Get the telemetry of the tuned kernel as a Python dict.
+    /*! The dict reports the current parameter, the number of timed launches with it, the mean
+        time per launch in milliseconds, and, when the caller reports bytes, the mean bytes per
+        launch, the achieved bandwidth in GB/s, and its fraction of the device's peak bandwidth.
+        Unknown values are None.
+    */
+    virtual pybind11::dict getTelemetryPython()
+        {
+        collectTelemetry();
+
+        pybind11::dict telemetry;
+        telemetry["parameter"] = getParameterPython();
+        telemetry["calls"] = m_telemetry_calls;
+        telemetry["mean_time"] = pybind11::none();
+        telemetry["bytes_per_call"] = pybind11::none();
+        telemetry["bandwidth"] = pybind11::none();
+        telemetry["peak_fraction"] = pybind11::none();
+
+        if (m_telemetry_calls > 0)
+            {
+            telemetry["mean_time"] = m_telemetry_time / double(m_telemetry_calls);
+            }
+
+        if (m_telemetry_bytes_calls > 0 && m_telemetry_bytes_time > 0)
+            {
+            double bandwidth = double(m_telemetry_bytes) / (m_telemetry_bytes_time * 1e-3) / 1e9;
+            telemetry["bytes_per_call"] = m_telemetry_bytes / m_telemetry_bytes_calls;
+            telemetry["bandwidth"] = bandwidth;
+#ifdef ENABLE_HIP
+            double peak = getPeakBandwidth(m_exec_conf);
+            if (peak > 0)
+                {
+                telemetry["peak_fraction"] = bandwidth / peak;
+                }
+#endif
+            }
+
+        return telemetry;
+        }
+
     static std::string formatParam(const std::array<unsigned int, n_dimensions>& p)
         {
         std::ostringstream s;
@@ -309,8 +439,10 @@ template<size_t n_dimensions> class PYBIND11_EXPORT Autotuner : public Autotuner
             return true;
         else
             {
-            m_exec_conf->msg->notice(5)
-                << "Autotuner " << m_name << " is not complete" << std::endl;
+            m_exec_conf->msg->notice(
+                5,
+                [this](std::ostream& out)
+                { out << "Autotuner " << m_name << " is not complete" << std::endl; });
             return false;
             }
         }
@@ -342,6 +474,12 @@ template<size_t n_dimensions> class PYBIND11_EXPORT Autotuner : public Autotuner
     protected:
     size_t computeOptimalParameterIndex();
 
+    /// Compute the sample summary of the given elements.
+    bool computeSampleCenters(const std::vector<unsigned int>& elements);
+
+    /// Keep the faster half of the successive halving candidates.
+    bool pruneCandidates();
+
     /// State names
     enum State
         {
@@ -391,6 +529,122 @@ template<size_t n_dimensions> class PYBIND11_EXPORT Autotuner : public Autotuner
     /// True when this is an optional tuner.
     bool m_optional;
 
+    /// True after the autotuner cache has been checked for a stored parameter.
+    bool m_cache_checked = false;
+
+    /// True when the current scan prunes parameters by successive halving.
+    bool m_successive_halving = false;
+
+    /// Spread of the remaining parameters below which successive halving stops.
+    float m_stop_threshold = 0;
+
+    /// Indices of the parameters that remain in the successive halving scan.
+    std::vector<unsigned int> m_candidates;
+
+    /// Estimated number of bytes that the current kernel launch reads and writes.
+    uint64_t m_bytes = 0;
+
+    /// True between begin() and end() of a launch that records telemetry.
+    bool m_telemetry_recording = false;
+
+    /// True while the events of a telemetry timing have not been collected.
+    bool m_telemetry_pending = false;
+
+    /// Bytes reported for the launch of the pending telemetry timing.
+    uint64_t m_telemetry_pending_bytes = 0;
+
+    /// Number of timed launches with the current parameter.
+    uint64_t m_telemetry_calls = 0;
+
+    /// Total time of the timed launches in milliseconds.
+    double m_telemetry_time = 0;
+
+    /// Number of timed launches that reported bytes.
+    uint64_t m_telemetry_bytes_calls = 0;
+
+    /// Total bytes of the timed launches that reported bytes.
+    uint64_t m_telemetry_bytes = 0;
+
+    /// Total time of the timed launches that reported bytes in milliseconds.
+    double m_telemetry_bytes_time = 0;
+
+    /// The profiler that traces the current kernel launch.
+    Profiler* m_trace = nullptr;
+
+    /// Discard the telemetry of the previous parameter.
+    void resetTelemetry()
+        {
+        m_telemetry_recording = false;
+        m_telemetry_pending = false;
+        m_telemetry_calls = 0;
+        m_telemetry_time = 0;
+        m_telemetry_bytes_calls = 0;
+        m_telemetry_bytes = 0;
+        m_telemetry_bytes_time = 0;
+        }
+
+    /// Add the pending telemetry timing when its events have completed.
+    void collectTelemetry()
+        {
+#ifdef ENABLE_HIP
+        if (m_telemetry_pending && hipEventQuery(m_stop) == hipSuccess)
+            {
+            float elapsed = 0.0f;
+            hipEventElapsedTime(&elapsed, m_start, m_stop);
+            m_telemetry_pending = false;
+            m_telemetry_calls++;
+            m_telemetry_time += elapsed;
+            if (m_telemetry_pending_bytes > 0)
+                {
+                m_telemetry_bytes_calls++;
+                m_telemetry_bytes += m_telemetry_pending_bytes;
+                m_telemetry_bytes_time += elapsed;
+                }
+            }
+#endif
+        }
+
+    /// Use the parameter stored in the autotuner cache, when there is a valid one.
+    void applyCachedParameter()
+        {
+        std::shared_ptr<AutotunerCache> cache = m_exec_conf->getAutotunerCache();
+        std::vector<unsigned int> stored;
+        if (!cache || !cache->lookup(m_name, stored) || stored.size() != n_dimensions)
+            {
+            return;
+            }
+
+        std::array<unsigned int, n_dimensions> cached_param;
+        std::copy(stored.begin(), stored.end(), cached_param.begin());
+        if (std::find(m_parameters.begin(), m_parameters.end(), cached_param)
+            == m_parameters.end())
+            {
+            m_exec_conf->msg->notice(4)
+                << "Autotuner " << m_name << " ignoring invalid cached parameter "
+                << formatParam(cached_param) << std::endl;
+            return;
+            }
+
+        m_current_param = cached_param;
+        m_state = IDLE;
+        m_current_sample = 0;
+        resetTelemetry();
+
+        m_exec_conf->msg->notice(4) << "Autotuner " << m_name << " using cached parameter "
+                                    << formatParam(cached_param) << std::endl;
+        }
+
+    /// Store the optimal parameter in the autotuner cache.
+    void storeCachedParameter()
+        {
+        std::shared_ptr<AutotunerCache> cache = m_exec_conf->getAutotunerCache();
+        if (cache)
+            {
+            cache->store(m_name,
+                         std::vector<unsigned int>(m_current_param.begin(), m_current_param.end()));
+            }
+        }
+
     /// Helper method to initialize multi-dimensional arrays recursively.
     void initializeParameters(
         const std::vector<std::vector<unsigned int>>& dimension_ranges,
@@ -482,15 +736,10 @@ Autotuner<n_dimensions>::Autotuner(
     if ((m_n_samples & 1) == 0)
         m_n_samples += 1;
 
-    // Initialize memory.
+    // Initialize memory. startScan() sizes the sample arrays.
     m_samples.resize(m_parameters.size());
     m_sample_center.resize(m_parameters.size());
 
-    for (unsigned int i = 0; i < m_parameters.size(); i++)
-        {
-        m_samples[i].resize(m_n_samples);
-        }
-
 // create CUDA events
 #ifdef ENABLE_HIP
     hipEventCreate(&m_start);
@@ -503,27 +752,71 @@ Autotuner<n_dimensions>::Autotuner(
 
 template<size_t n_dimensions> void Autotuner<n_dimensions>::end()
     {
+    if (m_trace)
+        {
+        m_trace->end();
+        m_trace = nullptr;
+        }
+
+    float elapsed = 0.0f;
 #ifdef ENABLE_HIP
     // handle timing updates if scanning
     if (m_state == SCANNING)
         {
         hipEventRecord(m_stop, 0);
         hipEventSynchronize(m_stop);
-        hipEventElapsedTime(&m_samples[m_current_element][m_current_sample], m_start, m_stop);
+        hipEventElapsedTime(&elapsed, m_start, m_stop);
 
-        m_exec_conf->msg->notice(9)
-            << "Autotuner " << m_name << ": t[" << formatParam(m_current_param) << ","
-            << m_current_sample << "] = " << m_samples[m_current_element][m_current_sample]
-            << std::endl;
+        m_exec_conf->msg->notice(9,
+                                 [&](std::ostream& out)
+                                 {
+                                     out << "Autotuner " << m_name << ": t["
+                                         << formatParam(m_current_param) << "," << m_current_sample
+                                         << "] = " << elapsed << std::endl;
+                                 });
 
         if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
         }
+    else if (m_telemetry_recording)
+        {
+        hipEventRecord(m_stop, 0);
+        m_telemetry_recording = false;
+        m_telemetry_pending = true;
+        m_telemetry_pending_bytes = m_bytes;
+        }
 #endif
 
     // Handle state data updates and transitions.
-    if (m_state == SCANNING)
+    if (m_state == SCANNING && m_successive_halving)
+        {
+        m_samples[m_candidates[m_current_element]].push_back(elapsed);
+
+        // move on to the next candidate
+        m_current_element++;
+
+        // At the end of each round, prune the candidates and go to the idle state when done.
+        if (m_current_element >= m_candidates.size())
+            {
+            m_current_sample++;
+            m_current_element = 0;
+
+            if (pruneCandidates())
+                {
+                m_state = IDLE;
+                m_current_sample = 0;
+                m_current_param = m_parameters[m_candidates[0]];
+                storeCachedParameter();
+                return;
+                }
+            }
+
+        m_current_param = m_parameters[m_candidates[m_current_element]];
+        }
+    else if (m_state == SCANNING)
         {
+        m_samples[m_current_element][m_current_sample] = elapsed;
+
         // move on to the next element
         m_current_element++;
 
@@ -540,6 +833,7 @@ template<size_t n_dimensions> void Autotuner<n_dimensions>::end()
                 m_state = IDLE;
                 m_current_sample = 0;
                 m_current_param = m_parameters[computeOptimalParameterIndex()];
+                storeCachedParameter();
                 }
             else
                 {
@@ -553,13 +847,15 @@ template<size_t n_dimensions> void Autotuner<n_dimensions>::end()
         }
     }
 
-/*! \returns The index of the optimal parameter given the current data in m_samples.
+/*! \param elements Indices of the parameters to summarize.
+    \returns true on the rank that holds the summaries.
 
-    computeOptimalParameter computes the median, average, or maximum time among all samples for all
-    elements. It then chooses the fastest time (with the lowest index breaking a tie) and returns
-    the index of the parameter that resulted in that time.
+    computeSampleCenters computes the median, average, or maximum time among all samples of each
+    given element and stores it in m_sample_center. When synchronizing over MPI, the summaries
+    combine the samples from all ranks and are valid only on rank zero.
 */
-template<size_t n_dimensions> size_t Autotuner<n_dimensions>::computeOptimalParameterIndex()
+template<size_t n_dimensions>
+bool Autotuner<n_dimensions>::computeSampleCenters(const std::vector<unsigned int>& elements)
     {
     bool is_root = true;
 
@@ -572,9 +868,8 @@ template<size_t n_dimensions> size_t Autotuner<n_dimensions>::computeOptimalPara
         }
 #endif
 
-    // Start by computing the summary for each element.
     std::vector<float> v;
-    for (unsigned int i = 0; i < m_parameters.size(); i++)
+    for (unsigned int i : elements)
         {
         v = m_samples[i];
 #ifdef ENABLE_MPI
@@ -625,6 +920,25 @@ template<size_t n_dimensions> size_t Autotuner<n_dimensions>::computeOptimalPara
             }
         }
 
+    return is_root;
+    }
+
+/*! \returns The index of the optimal parameter given the current data in m_samples.
+
+    computeOptimalParameter computes the median, average, or maximum time among all samples for all
+    elements. It then chooses the fastest time (with the lowest index breaking a tie) and returns
+    the index of the parameter that resulted in that time.
+*/
+template<size_t n_dimensions> size_t Autotuner<n_dimensions>::computeOptimalParameterIndex()
+    {
+    // Start by computing the summary for each element.
+    std::vector<unsigned int> elements(m_parameters.size());
+    for (unsigned int i = 0; i < m_parameters.size(); i++)
+        {
+        elements[i] = i;
+        }
+    bool is_root = computeSampleCenters(elements);
+
     size_t min_idx = 0;
 
     // Report performance characteristics of Autotuning
@@ -651,19 +965,73 @@ template<size_t n_dimensions> size_t Autotuner<n_dimensions>::computeOptimalPara
         unsigned int percent = int(max_value / min_value * 100.0f) - 100;
 
         // Notify user ot optimal parameter selection.
-        m_exec_conf->msg->notice(4)
-            << "Autotuner " << m_name << " found optimal parameter "
-            << formatParam(m_parameters[min_idx]) << " with a performance spread of " << percent
-            << "%." << std::endl;
+        m_exec_conf->msg->notice(4,
+                                 [&](std::ostream& out)
+                                 {
+                                     out << "Autotuner " << m_name << " found optimal parameter "
+                                         << formatParam(m_parameters[min_idx])
+                                         << " with a performance spread of " << percent << "%."
+                                         << std::endl;
+                                 });
         }
 
 #ifdef ENABLE_MPI
-    if (m_sync && nranks)
+    if (m_sync && m_exec_conf->getNRanks())
         bcast(min_idx, 0, m_exec_conf->getMPICommunicator());
 #endif
     return min_idx;
     }
 
+/*! \returns true when the successive halving scan is complete.
+
+    pruneCandidates orders the remaining candidates from the fastest to the slowest (with the
+    lowest index breaking a tie) and keeps the faster half. The scan is complete when one
+    candidate remains or when the spread of this round's candidates is below m_stop_threshold.
+    Either way, m_candidates[0] is the fastest parameter.
+*/
+template<size_t n_dimensions> bool Autotuner<n_dimensions>::pruneCandidates()
+    {
+    bool is_root = computeSampleCenters(m_candidates);
+    bool complete = false;
+
+    if (is_root)
+        {
+        std::stable_sort(m_candidates.begin(),
+                         m_candidates.end(),
+                         [this](unsigned int a, unsigned int b)
+                         { return m_sample_center[a] < m_sample_center[b]; });
+
+        float min_value = m_sample_center[m_candidates.front()];
+        float max_value = m_sample_center[m_candidates.back()];
+        float spread = min_value > 0 ? max_value / min_value - 1.0f : 0.0f;
+
+        m_candidates.resize((m_candidates.size() + 1) / 2);
+        complete = m_candidates.size() == 1 || spread < m_stop_threshold;
+
+        m_exec_conf->msg->notice(5)
+            << "Autotuner " << m_name << " round " << m_current_sample << " kept "
+            << m_candidates.size() << " parameters with a performance spread of "
+            << int(spread * 100.0f) << "%." << std::endl;
+
+        if (complete)
+            {
+            m_exec_conf->msg->notice(4)
+                << "Autotuner " << m_name << " found optimal parameter "
+                << formatParam(m_parameters[m_candidates[0]]) << " after " << m_current_sample
+                << " rounds of successive halving." << std::endl;
+            }
+        }
+
+#ifdef ENABLE_MPI
+    if (m_sync && m_exec_conf->getNRanks())
+        {
+        bcast(m_candidates, 0, m_exec_conf->getMPICommunicator());
+        bcast(complete, 0, m_exec_conf->getMPICommunicator());
+        }
+#endif
+    return complete;
+    }
+
     } // end namespace hoomd
 
 #endif // _AUTOTUNER_H_
@@ -0,0 +1,192 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "AutotunerCache.h"
+#include "ExecutionConfiguration.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+using namespace std;
+
+/*! \file AutotunerCache.cc
+    \brief Defines the AutotunerCache class
+*/
+
+namespace hoomd
+    {
+/*! \param exec_conf Execution configuration
+    \param filename Name of the cache file
+    \param build Identifier of the HOOMD-blue build
+
+    The cache file need not exist.
+*/
+AutotunerCache::AutotunerCache(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                               const std::string& filename,
+                               const std::string& build)
+    : m_msg(exec_conf->msg), m_is_root(exec_conf->isRoot()), m_filename(filename),
+      m_build(build), m_device("CPU")
+    {
+    if (m_build.find_first_of("\t\n") != string::npos)
+        {
+        throw invalid_argument("The build identifier must not contain tabs or newlines.");
+        }
+
+#ifdef ENABLE_HIP
+    if (exec_conf->isCUDAEnabled())
+        {
+        ostringstream s;
+        s << exec_conf->dev_prop.name << " SM_" << exec_conf->dev_prop.major << "."
+          << exec_conf->dev_prop.minor;
+        if (exec_conf->getNumActiveGPUs() > 1)
+            {
+            s << " x" << exec_conf->getNumActiveGPUs();
+            }
+        m_device = s.str();
+        }
+#endif
+
+    read();
+    m_msg->notice(3) << "Autotuner cache: read " << m_entries.size() << " entries from "
+                     << m_filename << endl;
+    }
+
+/*! \param N Global number of particles in the system
+
+    Systems with up to twice as many particles share entries.
+*/
+void AutotunerCache::setSystemSize(unsigned int N)
+    {
+    unsigned int bucket = 1;
+    while (bucket < N && bucket < (1u << 31))
+        {
+        bucket *= 2;
+        }
+    m_size_bucket = bucket;
+    }
+
+/*! \param name Name of the autotuner
+    \param parameter Set to the stored parameter
+    \returns true when the cache holds a parameter for the autotuner
+*/
+bool AutotunerCache::lookup(const std::string& name, std::vector<unsigned int>& parameter) const
+    {
+    auto entry = m_entries.find(makeKey(name));
+    if (entry == m_entries.end())
+        {
+        return false;
+        }
+    parameter = entry->second;
+    return true;
+    }
+
+/*! \param name Name of the autotuner
+    \param parameter Optimal parameter found by the scan
+*/
+void AutotunerCache::store(const std::string& name, const std::vector<unsigned int>& parameter)
+    {
+    std::string key = makeKey(name);
+    if (m_is_root)
+        {
+        // merge the entries that other jobs wrote since this cache last read the file
+        read();
+        }
+    m_entries[key] = parameter;
+
+    if (m_is_root)
+        {
+        write();
+        }
+    }
+
+std::string AutotunerCache::makeKey(const std::string& name) const
+    {
+    ostringstream s;
+    s << m_build << "\t" << m_device << "\t" << m_size_bucket << "\t" << name;
+    return s.str();
+    }
+
+void AutotunerCache::read()
+    {
+    ifstream file(m_filename);
+    if (!file.good())
+        {
+        return;
+        }
+
+    std::string line;
+    while (getline(file, line))
+        {
+        // the key is everything before the last tab, the parameter follows it
+        size_t split = line.rfind('\t');
+        if (split == string::npos || split == 0)
+            {
+            continue;
+            }
+
+        std::vector<unsigned int> parameter;
+        istringstream values(line.substr(split + 1));
+        unsigned int v;
+        while (values >> v)
+            {
+            parameter.push_back(v);
+            }
+
+        if (!parameter.empty())
+            {
+            m_entries[line.substr(0, split)] = parameter;
+            }
+        }
+    }
+
+void AutotunerCache::write() const
+    {
+    // write a temporary file and rename it so that other jobs never read a partial file
+    ostringstream tmp_name;
+    tmp_name << m_filename << ".tmp" << getpid();
+
+        {
+        ofstream file(tmp_name.str());
+        for (const auto& entry : m_entries)
+            {
+            file << entry.first << "\t";
+            for (size_t i = 0; i < entry.second.size(); i++)
+                {
+                file << (i > 0 ? " " : "") << entry.second[i];
+                }
+            file << "\n";
+            }
+
+        if (!file.good())
+            {
+            m_msg->warning() << "Autotuner cache: unable to write " << tmp_name.str() << endl;
+            return;
+            }
+        }
+
+    if (std::rename(tmp_name.str().c_str(), m_filename.c_str()) != 0)
+        {
+        m_msg->warning() << "Autotuner cache: unable to replace " << m_filename << endl;
+        std::remove(tmp_name.str().c_str());
+        }
+    }
+
+namespace detail
+    {
+void export_AutotunerCache(pybind11::module& m)
+    {
+    pybind11::class_<AutotunerCache, std::shared_ptr<AutotunerCache>>(m, "AutotunerCache")
+        .def(pybind11::init<std::shared_ptr<const ExecutionConfiguration>,
+                            const std::string&,
+                            const std::string&>())
+        .def_property_readonly("filename", &AutotunerCache::getFilename)
+        .def_property_readonly("build", &AutotunerCache::getBuild)
+        .def_property_readonly("device", &AutotunerCache::getDevice)
+        .def_property_readonly("size_bucket", &AutotunerCache::getSizeBucket)
+        .def_property_readonly("num_entries", &AutotunerCache::getNumEntries);
+    }
+    } // end namespace detail
+
+    } // end namespace hoomd
@@ -0,0 +1,126 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#pragma once
+
+/*! \file AutotunerCache.h
+    \brief Declaration of AutotunerCache
+*/
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifndef __HIPCC__
+#include <pybind11/pybind11.h>
+#endif
+
+namespace hoomd
+    {
+class ExecutionConfiguration;
+class Messenger;
+
+/// Store the results of autotuner scans in a file to reuse them in later runs
+/*! AutotunerCache maps a key to the optimal parameter found by an Autotuner scan. The key combines
+    the autotuner's name, the model of the active device, a bucket of the global number of
+    particles in the system, and an identifier of the HOOMD-blue build. The Autotuner looks up its
+    key before it begins the first scan and uses the stored parameter when there is one. When a
+    scan completes, the Autotuner stores the resulting parameter.
+
+    The cache file holds one entry per line: the key fields and the parameter separated by tabs.
+    The file may hold entries for other devices, system sizes, and builds. store() reads the
+    file again before it writes so that concurrent jobs that share a cache file do not discard
+    each other's entries. Only the root rank writes the file. It writes a temporary file and
+    renames it so that readers always find a complete file.
+
+    System sets the size bucket at the start of every run.
+*/
+class PYBIND11_EXPORT AutotunerCache
+    {
+    public:
+    /// Construct the cache and read the stored parameters
+    AutotunerCache(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                   const std::string& filename,
+                   const std::string& build);
+
+    /// Set the global number of particles in the system
+    void setSystemSize(unsigned int N);
+
+    /// Get the stored parameter for the named autotuner
+    bool lookup(const std::string& name, std::vector<unsigned int>& parameter) const;
+
+    /// Store the parameter for the named autotuner
+    void store(const std::string& name, const std::vector<unsigned int>& parameter);
+
+    /// Get the file name
+    std::string getFilename() const
+        {
+        return m_filename;
+        }
+
+    /// Get the build identifier
+    std::string getBuild() const
+        {
+        return m_build;
+        }
+
+    /// Get the device model
+    std::string getDevice() const
+        {
+        return m_device;
+        }
+
+    /// Get the current system size bucket
+    unsigned int getSizeBucket() const
+        {
+        return m_size_bucket;
+        }
+
+    /// Get the number of stored entries
+    size_t getNumEntries() const
+        {
+        return m_entries.size();
+        }
+
+    private:
+    /// Messenger for notices and warnings.
+    std::shared_ptr<Messenger> m_msg;
+
+    /// True on the rank that writes the file.
+    bool m_is_root;
+
+    /// Name of the cache file.
+    std::string m_filename;
+
+    /// Identifier of the HOOMD-blue build.
+    std::string m_build;
+
+    /// Model of the active device.
+    std::string m_device;
+
+    /// Bucket of the global number of particles.
+    unsigned int m_size_bucket = 0;
+
+    /// Stored parameters by key.
+    std::map<std::string, std::vector<unsigned int>> m_entries;
+
+    /// Build the key for the named autotuner
+    std::string makeKey(const std::string& name) const;
+
+    /// Read the entries in the cache file
+    void read();
+
+    /// Write all entries to the cache file
+    void write() const;
+    };
+
+namespace detail
+    {
+#ifndef __HIPCC__
+/// Exports AutotunerCache to python
+void export_AutotunerCache(pybind11::module& m);
+#endif
+    } // end namespace detail
+
+    } // end namespace hoomd
@@ -6,11 +6,15 @@
  */
 
 #include "BondedGroupData.h"
+#include "CheckpointBuffer.h"
 #include "Index1D.h"
 #include "ParticleData.h"
 
 #include <pybind11/numpy.h>
 
+#include <algorithm>
+#include <numeric>
+
 #ifdef ENABLE_HIP
 #include "BondedGroupData.cuh"
 #include "CachedAllocator.h"
@@ -42,7 +46,7 @@ template<unsigned int group_size, typename Group, const char* name, bool has_typ
 BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     std::shared_ptr<ParticleData> pdata)
     : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0),
-      m_groups_dirty(true)
+      m_groups_dirty(true), m_gpu_table_permuted(false), m_member_idx_dirty(true)
     {
     }
 
@@ -55,7 +59,7 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     std::shared_ptr<ParticleData> pdata,
     unsigned int n_group_types)
     : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0),
-      m_groups_dirty(true)
+      m_groups_dirty(true), m_gpu_table_permuted(false), m_member_idx_dirty(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondedGroupData (" << name << "s, n=" << group_size
                                 << ") " << endl;
@@ -98,7 +102,7 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     std::shared_ptr<ParticleData> pdata,
     const Snapshot& snapshot)
     : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_n_groups(0), m_n_ghost(0), m_nglobal(0),
-      m_groups_dirty(true)
+      m_groups_dirty(true), m_gpu_table_permuted(false), m_member_idx_dirty(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondedGroupData (" << name << ") " << endl;
 
@@ -179,6 +183,13 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::initialize()
     GPUVector<unsigned int> gpu_pos_table(m_exec_conf);
     m_gpu_pos_table.swap(gpu_pos_table);
 
+    GPUVector<unsigned int> gpu_tag_table(m_exec_conf);
+    m_gpu_tag_table.swap(gpu_tag_table);
+
+    GPUVector<members_t> member_idx(m_exec_conf);
+    m_member_idx.swap(member_idx);
+    m_member_idx_dirty = true;
+
     GPUVector<unsigned int> n_groups(m_exec_conf);
     m_gpu_n_groups.swap(n_groups);
 
@@ -318,6 +329,290 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromS
         }
     }
 
+/*! \param unit_cell Groups in the unit cell, present on all ranks
+    \param n_images Number of replicas of the unit cell
+    \param n_unit_particles Number of particles in the unit cell
+
+    Initialize the groups with the same tags and members as Snapshot::replicate() without building
+    the replicated snapshot. Replica j of particle i has the tag j * n_unit_particles + i. Each
+    rank adds the groups with at least one local member, found from the groups of the unit cell
+    particle of each local particle. The particle data must already hold the replicated particles.
+
+    \note This method must be called collectively on all ranks.
+*/
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeReplicated(
+    const Snapshot& unit_cell,
+    unsigned int n_images,
+    unsigned int n_unit_particles)
+    {
+    unit_cell.validate();
+
+    const unsigned int n_unit = (unsigned int)unit_cell.groups.size();
+    if (uint64_t(n_unit) * n_images > uint64_t(GROUP_NOT_LOCAL - 1))
+        {
+        throw std::runtime_error(std::string("Too many ") + name + "s.");
+        }
+    const unsigned int nglobal = n_unit * n_images;
+
+    // the groups of each unit cell particle
+    std::vector<std::vector<unsigned int>> particle_groups(n_unit_particles);
+    for (unsigned int group_idx = 0; group_idx < n_unit; group_idx++)
+        {
+        const members_t& g = unit_cell.groups[group_idx];
+        for (unsigned int i = 0; i < group_size; ++i)
+            {
+            for (unsigned int j = 0; j < i; ++j)
+                {
+                if (g.tag[i] == g.tag[j])
+                    {
+                    throw std::runtime_error(std::string("The same particle can only occur once "
+                                                         "in a ")
+                                             + name + ".");
+                    }
+                }
+
+            if (g.tag[i] >= n_unit_particles)
+                {
+                throw runtime_error(std::string("Particle tag out of bounds in ") + name + ".");
+                }
+            particle_groups[g.tag[i]].push_back(group_idx);
+            }
+
+        if (has_type_mapping && unit_cell.type_id[group_idx] >= unit_cell.type_mapping.size())
+            {
+            std::ostringstream s;
+            s << "Invalid " << name << " typeid " << unit_cell.type_id[group_idx]
+              << ". The number of types is " << unit_cell.type_mapping.size() << ".";
+            throw std::runtime_error(s.str());
+            }
+        }
+
+    initialize();
+    m_type_mapping = unit_cell.type_mapping;
+
+    std::vector<members_t> groups;
+    std::vector<typeval_t> typevals;
+    std::vector<unsigned int> group_tags;
+        {
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        const unsigned int N = m_pdata->getN();
+
+        for (unsigned int idx = 0; idx < N; idx++)
+            {
+            const unsigned int tag = h_tag.data[idx];
+            const unsigned int image = tag / n_unit_particles;
+            const unsigned int offset = image * n_unit_particles;
+
+            for (unsigned int group_idx : particle_groups[tag - offset])
+                {
+                members_t g = unit_cell.groups[group_idx];
+                unsigned int first_local = NOT_LOCAL;
+                for (unsigned int i = 0; i < group_size; ++i)
+                    {
+                    g.tag[i] += offset;
+                    if (first_local == NOT_LOCAL && h_rtag.data[g.tag[i]] < N)
+                        first_local = g.tag[i];
+                    }
+
+                // add each group once, from its first local member
+                if (first_local != tag)
+                    continue;
+
+                typeval_t t;
+                if (has_type_mapping)
+                    t.type = unit_cell.type_id[group_idx];
+                else
+                    t.val = unit_cell.val[group_idx];
+
+                groups.push_back(g);
+                typevals.push_back(t);
+                group_tags.push_back(image * n_unit + group_idx);
+                }
+            }
+        }
+
+    m_n_groups = (unsigned int)groups.size();
+    m_groups.resize(m_n_groups);
+    m_group_typeval.resize(m_n_groups);
+    m_group_tag.resize(m_n_groups);
+    m_group_rtag.resize(nglobal);
+        {
+        ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::overwrite);
+        ArrayHandle<typeval_t> h_typeval(m_group_typeval,
+                                         access_location::host,
+                                         access_mode::overwrite);
+        ArrayHandle<unsigned int> h_group_tag(m_group_tag,
+                                              access_location::host,
+                                              access_mode::overwrite);
+        ArrayHandle<unsigned int> h_group_rtag(m_group_rtag,
+                                               access_location::host,
+                                               access_mode::overwrite);
+
+        std::fill(h_group_rtag.data, h_group_rtag.data + nglobal, GROUP_NOT_LOCAL);
+        for (unsigned int group_idx = 0; group_idx < m_n_groups; group_idx++)
+            {
+            h_groups.data[group_idx] = groups[group_idx];
+            h_typeval.data[group_idx] = typevals[group_idx];
+            h_group_tag.data[group_idx] = group_tags[group_idx];
+            h_group_rtag.data[group_tags[group_idx]] = group_idx;
+            }
+        }
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        m_group_ranks.resize(m_n_groups);
+        ArrayHandle<ranks_t> h_group_ranks(m_group_ranks,
+                                           access_location::host,
+                                           access_mode::overwrite);
+        memset(h_group_ranks.data, 0, sizeof(ranks_t) * m_n_groups);
+        }
+#endif
+
+    for (unsigned int group_tag = 0; group_tag < nglobal; group_tag++)
+        {
+        m_tag_set.insert(m_tag_set.end(), group_tag);
+        }
+    m_invalid_cached_tags = true;
+    m_nglobal = nglobal;
+
+    // notify observers
+    m_group_num_change_signal.emit();
+    notifyGroupReorder();
+    }
+
+/*! \param buffer Buffer to append to
+
+    Append the local groups (without ghosts) in their current order, followed by the global tag
+    bookkeeping. With domain decomposition, the ranks of the members are appended as well.
+*/
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::writeCheckpoint(
+    detail::CheckpointBuffer& buffer)
+    {
+    ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_group_typeval, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_group_tag(m_group_tag, access_location::host, access_mode::read);
+
+    buffer.write(m_n_groups);
+    buffer.write(h_groups.data, m_n_groups);
+    buffer.write(h_typeval.data, m_n_groups);
+    buffer.write(h_group_tag.data, m_n_groups);
+
+    bool has_ranks = false;
+#ifdef ENABLE_MPI
+    has_ranks = bool(m_pdata->getDomainDecomposition());
+#endif
+    buffer.write(has_ranks);
+#ifdef ENABLE_MPI
+    if (has_ranks)
+        {
+        ArrayHandle<ranks_t> h_group_ranks(m_group_ranks, access_location::host, access_mode::read);
+        buffer.write(h_group_ranks.data, m_n_groups);
+        }
+#endif
+
+    buffer.write(m_nglobal);
+    buffer.writeTags(m_tag_set, m_recycled_tags, m_group_rtag.size());
+    }
+
+/*! \param buffer Buffer to read from, positioned at the data appended by writeCheckpoint()
+
+    Replace the local groups by the groups in the checkpoint. The particle data must already hold
+    the particles of the same checkpoint.
+
+    \note This method must be called collectively on all ranks.
+*/
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::readCheckpoint(
+    detail::CheckpointBuffer& buffer)
+    {
+    initialize();
+
+    m_n_groups = buffer.read<unsigned int>();
+    m_groups.resize(m_n_groups);
+    m_group_typeval.resize(m_n_groups);
+    m_group_tag.resize(m_n_groups);
+        {
+        ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::overwrite);
+        ArrayHandle<typeval_t> h_typeval(m_group_typeval,
+                                         access_location::host,
+                                         access_mode::overwrite);
+        ArrayHandle<unsigned int> h_group_tag(m_group_tag,
+                                              access_location::host,
+                                              access_mode::overwrite);
+        buffer.read(h_groups.data, m_n_groups);
+        buffer.read(h_typeval.data, m_n_groups);
+        buffer.read(h_group_tag.data, m_n_groups);
+
+        if (has_type_mapping)
+            {
+            for (unsigned int group_idx = 0; group_idx < m_n_groups; group_idx++)
+                {
+                if (h_typeval.data[group_idx].type >= m_type_mapping.size())
+                    {
+                    throw std::runtime_error(std::string("Invalid ") + name
+                                             + " typeid in checkpoint.");
+                    }
+                }
+            }
+        }
+
+    const bool has_ranks = buffer.read<bool>();
+    bool decomposed = false;
+#ifdef ENABLE_MPI
+    decomposed = bool(m_pdata->getDomainDecomposition());
+#endif
+    if (has_ranks != decomposed)
+        {
+        throw std::runtime_error("The checkpoint was written with a different domain "
+                                 "decomposition.");
+        }
+#ifdef ENABLE_MPI
+    if (has_ranks)
+        {
+        m_group_ranks.resize(m_n_groups);
+        ArrayHandle<ranks_t> h_group_ranks(m_group_ranks,
+                                           access_location::host,
+                                           access_mode::overwrite);
+        buffer.read(h_group_ranks.data, m_n_groups);
+        }
+#endif
+
+    m_nglobal = buffer.read<unsigned int>();
+    const size_t n_tags = buffer.readTags(m_tag_set, m_recycled_tags);
+
+    m_group_rtag.resize(n_tags);
+        {
+        ArrayHandle<unsigned int> h_group_tag(m_group_tag,
+                                              access_location::host,
+                                              access_mode::read);
+        ArrayHandle<unsigned int> h_group_rtag(m_group_rtag,
+                                               access_location::host,
+                                               access_mode::overwrite);
+        std::fill(h_group_rtag.data, h_group_rtag.data + n_tags, GROUP_NOT_LOCAL);
+        for (unsigned int group_idx = 0; group_idx < m_n_groups; group_idx++)
+            {
+            if (h_group_tag.data[group_idx] >= n_tags)
+                {
+                throw std::runtime_error(std::string("Invalid ") + name + " tag in checkpoint.");
+                }
+            h_group_rtag.data[h_group_tag.data[group_idx]] = group_idx;
+            }
+        }
+    m_invalid_cached_tags = true;
+
+    // notify observers
+    m_group_num_change_signal.emit();
+    notifyGroupReorder();
+    }
+
 template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
 unsigned int BondedGroupData<group_size, Group, name, has_type_mapping>::addBondedGroup(Group g)
     {
@@ -753,6 +1048,115 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::maybe_rebuild_t
     m_invalid_cached_tags = false;
     }
 
+/*! The local groups are stably sorted by the lowest local particle index among their members, so
+    that the groups follow the order of the particles in memory. Call this after the particles are
+    sorted to keep the member accesses of the bonded force computes local. Ghost groups keep their
+    place at the end of the table.
+ */
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::sortByParticleIndex()
+    {
+    const unsigned int n_groups = getN();
+    if (n_groups == 0)
+        return;
+
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        sortByParticleIndexGPU();
+        return;
+        }
+#endif
+
+    // the sort key of each group is the lowest local index of its members
+    std::vector<unsigned int> keys(n_groups);
+        {
+        ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        const size_t n_rtag = m_pdata->getRTags().size();
+        for (unsigned int group_idx = 0; group_idx < n_groups; group_idx++)
+            {
+            unsigned int key = NOT_LOCAL;
+            for (unsigned int j = 0; j < group_size; j++)
+                {
+                unsigned int tag = h_groups.data[group_idx].tag[j];
+                if (tag < n_rtag)
+                    key = std::min(key, h_rtag.data[tag]);
+                }
+            keys[group_idx] = key;
+            }
+        }
+
+    if (std::is_sorted(keys.begin(), keys.end()))
+        return;
+
+    std::vector<unsigned int> order(n_groups);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [&keys](unsigned int a, unsigned int b) { return keys[a] < keys[b]; });
+
+    const unsigned int n_total = n_groups + m_n_ghost;
+#ifdef ENABLE_MPI
+    const bool sort_ranks = m_pdata->getDomainDecomposition() != nullptr;
+#endif
+        {
+        ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::read);
+        ArrayHandle<typeval_t> h_typeval(m_group_typeval, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_group_tag, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_group_rtag(m_group_rtag,
+                                               access_location::host,
+                                               access_mode::readwrite);
+
+        ArrayHandle<members_t> h_groups_alt(getAltMembersArray(),
+                                            access_location::host,
+                                            access_mode::overwrite);
+        ArrayHandle<typeval_t> h_typeval_alt(getAltTypeValArray(),
+                                             access_location::host,
+                                             access_mode::overwrite);
+        ArrayHandle<unsigned int> h_tag_alt(getAltTags(),
+                                            access_location::host,
+                                            access_mode::overwrite);
+
+        for (unsigned int group_idx = 0; group_idx < n_total; group_idx++)
+            {
+            unsigned int old_idx = group_idx < n_groups ? order[group_idx] : group_idx;
+            h_groups_alt.data[group_idx] = h_groups.data[old_idx];
+            h_typeval_alt.data[group_idx] = h_typeval.data[old_idx];
+            h_tag_alt.data[group_idx] = h_tag.data[old_idx];
+            if (group_idx < n_groups)
+                h_group_rtag.data[h_tag.data[old_idx]] = group_idx;
+            }
+
+#ifdef ENABLE_MPI
+        if (sort_ranks)
+            {
+            ArrayHandle<ranks_t> h_ranks(m_group_ranks, access_location::host, access_mode::read);
+            ArrayHandle<ranks_t> h_ranks_alt(getAltRanksArray(),
+                                             access_location::host,
+                                             access_mode::overwrite);
+            for (unsigned int group_idx = 0; group_idx < n_total; group_idx++)
+                {
+                unsigned int old_idx = group_idx < n_groups ? order[group_idx] : group_idx;
+                h_ranks_alt.data[group_idx] = h_ranks.data[old_idx];
+                }
+            }
+#endif
+        }
+
+    swapMemberArrays();
+    swapTypeArrays();
+    swapTagArrays();
+#ifdef ENABLE_MPI
+    if (sort_ranks)
+        swapRankArrays();
+#endif
+
+    notifyGroupPermutation();
+    }
+
 template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
 void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTable()
     {
@@ -815,6 +1219,7 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTable
         m_gpu_table_indexer = Index2D(m_pdata->getN() + m_pdata->getNGhosts(), num_groups_max);
         m_gpu_table.resize(m_gpu_table_indexer.getNumElements());
         m_gpu_pos_table.resize(m_gpu_table_indexer.getNumElements());
+        m_gpu_tag_table.resize(m_gpu_table_indexer.getNumElements());
 
             {
             ArrayHandle<unsigned int> h_n_groups(m_gpu_n_groups,
@@ -826,6 +1231,9 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTable
             ArrayHandle<unsigned int> h_gpu_pos_table(m_gpu_pos_table,
                                                       access_location::host,
                                                       access_mode::overwrite);
+            ArrayHandle<unsigned int> h_gpu_tag_table(m_gpu_tag_table,
+                                                      access_location::host,
+                                                      access_mode::overwrite);
 
             // now, update the actual table
             // zero the number of bonded groups counter (again)
@@ -874,12 +1282,148 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTable
 
                     h_gpu_table.data[m_gpu_table_indexer(idx1, num)] = h;
                     h_gpu_pos_table.data[m_gpu_table_indexer(idx1, num)] = gpos;
+                    h_gpu_tag_table.data[m_gpu_table_indexer(idx1, num)]
+                        = m_group_tag[cur_group];
                     }
                 }
             }
         }
     }
 
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildMemberIndexTable()
+    {
+    unsigned int ngroups_tot = m_n_groups + m_n_ghost;
+    m_member_idx.resize(ngroups_tot);
+
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::read);
+    ArrayHandle<members_t> h_member_idx(m_member_idx,
+                                        access_location::host,
+                                        access_mode::overwrite);
+
+    // mesh groups also store bond or triangle tags, which need not be valid particle tags
+    const size_t n_rtag = m_pdata->getRTags().getNumElements();
+
+    for (unsigned int cur_group = 0; cur_group < ngroups_tot; cur_group++)
+        {
+        const members_t& g = h_groups.data[cur_group];
+        members_t h;
+        for (unsigned int i = 0; i < group_size; ++i)
+            {
+            h.idx[i] = g.tag[i] < n_rtag ? h_rtag.data[g.tag[i]] : NOT_LOCAL;
+            }
+        h_member_idx.data[cur_group] = h;
+        }
+    }
+
+/*! The entries of the lookup by index table identify their group by tag, so that a sort that only
+    permutes the local particles or groups may move the entries to the new particle indices instead
+    of rebuilding the table. With domain decomposition, the ghost particles are exchanged again
+    after every sort and the table is always rebuilt.
+ */
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+bool BondedGroupData<group_size, Group, name, has_type_mapping>::canPermuteGPUTable() const
+    {
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        return false;
+#endif
+    return m_gpu_table_indexer.getW() == m_pdata->getN() + m_pdata->getNGhosts()
+           && m_gpu_tag_table.size() == m_gpu_table_indexer.getNumElements();
+    }
+
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::notifyGroupPermutation()
+    {
+    if (canPermuteGPUTable())
+        m_gpu_table_permuted = true;
+    else
+        m_groups_dirty = true;
+    m_member_idx_dirty = true;
+
+    m_group_reorder_signal.emit();
+    }
+
+/*! Every entry of the table moves to the row of the new local index of its particle. The entry is
+    rebuilt from the group members, so the table also follows a reordering of the groups. The number
+    of entries per particle and the size of the table do not change.
+ */
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::permuteGPUTable()
+    {
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        permuteGPUTableGPU();
+        return;
+        }
+#endif
+
+    const unsigned int n_rows = m_gpu_table_indexer.getW();
+    const unsigned int n_entries = m_gpu_table_indexer.getNumElements();
+
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_group_typeval, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_group_rtag(m_group_rtag, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_groups(m_gpu_n_groups,
+                                         access_location::host,
+                                         access_mode::readwrite);
+    ArrayHandle<members_t> h_gpu_table(m_gpu_table, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_gpu_pos_table(m_gpu_pos_table,
+                                              access_location::host,
+                                              access_mode::readwrite);
+    ArrayHandle<unsigned int> h_gpu_tag_table(m_gpu_tag_table,
+                                              access_location::host,
+                                              access_mode::readwrite);
+
+    std::vector<unsigned int> n_groups_old(h_n_groups.data, h_n_groups.data + n_rows);
+    std::vector<unsigned int> pos_table_old(h_gpu_pos_table.data, h_gpu_pos_table.data + n_entries);
+    std::vector<unsigned int> tag_table_old(h_gpu_tag_table.data, h_gpu_tag_table.data + n_entries);
+    memset(h_n_groups.data, 0, sizeof(unsigned int) * n_rows);
+
+    for (unsigned int row = 0; row < n_rows; row++)
+        {
+        for (unsigned int num = 0; num < n_groups_old[row]; num++)
+            {
+            unsigned int old_entry = m_gpu_table_indexer(row, num);
+            unsigned int group_tag = tag_table_old[old_entry];
+            unsigned int gpos = pos_table_old[old_entry];
+            unsigned int cur_group = h_group_rtag.data[group_tag];
+            const members_t& g = h_groups.data[cur_group];
+            unsigned int idx1 = h_rtag.data[g.tag[gpos]];
+
+            members_t h;
+            if (has_type_mapping)
+                {
+                // last element = type
+                h.idx[group_size - 1] = h_typeval.data[cur_group].type;
+                }
+            else
+                {
+                // last element = local group idx
+                h.idx[group_size - 1] = cur_group;
+                }
+
+            // list all group members j!=gpos in p.idx
+            unsigned int n = 0;
+            for (unsigned int j = 0; j < group_size; ++j)
+                {
+                if (j != gpos)
+                    h.idx[n++] = h_rtag.data[g.tag[j]];
+                }
+
+            unsigned int new_entry = m_gpu_table_indexer(idx1, num);
+            h_gpu_table.data[new_entry] = h;
+            h_gpu_pos_table.data[new_entry] = gpos;
+            h_gpu_tag_table.data[new_entry] = group_tag;
+            if (num == 0)
+                h_n_groups.data[idx1] = n_groups_old[row];
+            }
+        }
+    }
+
 #ifdef ENABLE_HIP
 template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
 void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTableGPU()
@@ -892,6 +1436,7 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTable
         = Index2D(m_pdata->getN() + m_pdata->getNGhosts(), m_gpu_table_indexer.getH());
     m_gpu_table.resize(m_gpu_table_indexer.getNumElements());
     m_gpu_pos_table.resize(m_gpu_table_indexer.getNumElements());
+    m_gpu_tag_table.resize(m_gpu_table_indexer.getNumElements());
 
     bool done = false;
     while (!done)
@@ -915,6 +1460,12 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTable
             ArrayHandle<unsigned int> d_gpu_pos_table(m_gpu_pos_table,
                                                       access_location::device,
                                                       access_mode::overwrite);
+            ArrayHandle<unsigned int> d_gpu_tag_table(m_gpu_tag_table,
+                                                      access_location::device,
+                                                      access_mode::overwrite);
+            ArrayHandle<unsigned int> d_group_tag(m_group_tag,
+                                                  access_location::device,
+                                                  access_mode::read);
             ArrayHandle<unsigned int> d_condition(m_condition,
                                                   access_location::device,
                                                   access_mode::readwrite);
@@ -932,6 +1483,7 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTable
                                                           nptl,
                                                           d_groups.data,
                                                           d_group_typeval.data,
+                                                          d_group_tag.data,
                                                           d_rtag.data,
                                                           d_n_groups.data,
                                                           m_gpu_table_indexer.getH(),
@@ -940,6 +1492,7 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTable
                                                           flag,
                                                           d_gpu_table.data,
                                                           d_gpu_pos_table.data,
+                                                          d_gpu_tag_table.data,
                                                           m_gpu_table_indexer.getW(),
                                                           d_scratch_g.data,
                                                           d_scratch_idx.data,
@@ -971,12 +1524,139 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTable
                 = Index2D(m_pdata->getN() + m_pdata->getNGhosts(), m_gpu_table_indexer.getH() + 1);
             m_gpu_table.resize(m_gpu_table_indexer.getNumElements());
             m_gpu_pos_table.resize(m_gpu_table_indexer.getNumElements());
+            m_gpu_tag_table.resize(m_gpu_table_indexer.getNumElements());
             m_next_flag++;
             }
         else
             done = true;
         }
     }
+
+/*! The device implementation of sortByParticleIndex(). The sort keeps the groups in device memory
+    and the host only reads back whether the groups were already in order.
+ */
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::sortByParticleIndexGPU()
+    {
+    bool reordered = false;
+#ifdef ENABLE_MPI
+    const bool sort_ranks = m_pdata->getDomainDecomposition() != nullptr;
+#endif
+        {
+        ArrayHandle<members_t> d_groups(m_groups, access_location::device, access_mode::read);
+        ArrayHandle<typeval_t> d_typeval(m_group_typeval,
+                                         access_location::device,
+                                         access_mode::read);
+        ArrayHandle<unsigned int> d_tag(m_group_tag, access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_group_rtag(m_group_rtag,
+                                               access_location::device,
+                                               access_mode::readwrite);
+        ArrayHandle<unsigned int> d_rtag(m_pdata->getRTags(),
+                                         access_location::device,
+                                         access_mode::read);
+
+        ArrayHandle<members_t> d_groups_alt(getAltMembersArray(),
+                                            access_location::device,
+                                            access_mode::overwrite);
+        ArrayHandle<typeval_t> d_typeval_alt(getAltTypeValArray(),
+                                             access_location::device,
+                                             access_mode::overwrite);
+        ArrayHandle<unsigned int> d_tag_alt(getAltTags(),
+                                            access_location::device,
+                                            access_mode::overwrite);
+
+        const members_t* d_ranks_data = nullptr;
+        members_t* d_ranks_alt_data = nullptr;
+#ifdef ENABLE_MPI
+        std::unique_ptr<ArrayHandle<ranks_t>> d_ranks;
+        std::unique_ptr<ArrayHandle<ranks_t>> d_ranks_alt;
+        if (sort_ranks)
+            {
+            d_ranks.reset(new ArrayHandle<ranks_t>(m_group_ranks,
+                                                   access_location::device,
+                                                   access_mode::read));
+            d_ranks_alt.reset(new ArrayHandle<ranks_t>(getAltRanksArray(),
+                                                       access_location::device,
+                                                       access_mode::overwrite));
+            d_ranks_data = d_ranks->data;
+            d_ranks_alt_data = d_ranks_alt->data;
+            }
+#endif
+
+        reordered = gpu_sort_groups_by_particle_index<group_size, members_t>(
+            getN(),
+            m_n_ghost,
+            d_groups.data,
+            d_typeval.data,
+            d_tag.data,
+            d_ranks_data,
+            d_rtag.data,
+            (unsigned int)m_pdata->getRTags().size(),
+            d_groups_alt.data,
+            d_typeval_alt.data,
+            d_tag_alt.data,
+            d_ranks_alt_data,
+            d_group_rtag.data,
+            m_exec_conf->getCachedAllocator());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+    if (!reordered)
+        return;
+
+    swapMemberArrays();
+    swapTypeArrays();
+    swapTagArrays();
+#ifdef ENABLE_MPI
+    if (sort_ranks)
+        swapRankArrays();
+#endif
+
+    notifyGroupPermutation();
+    }
+
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::permuteGPUTableGPU()
+    {
+    ArrayHandle<members_t> d_groups(m_groups, access_location::device, access_mode::read);
+    ArrayHandle<typeval_t> d_group_typeval(m_group_typeval,
+                                           access_location::device,
+                                           access_mode::read);
+    ArrayHandle<unsigned int> d_group_rtag(m_group_rtag,
+                                           access_location::device,
+                                           access_mode::read);
+    ArrayHandle<unsigned int> d_rtag(m_pdata->getRTags(),
+                                     access_location::device,
+                                     access_mode::read);
+    ArrayHandle<unsigned int> d_n_groups(m_gpu_n_groups,
+                                         access_location::device,
+                                         access_mode::readwrite);
+    ArrayHandle<members_t> d_gpu_table(m_gpu_table,
+                                       access_location::device,
+                                       access_mode::overwrite);
+    ArrayHandle<unsigned int> d_gpu_pos_table(m_gpu_pos_table,
+                                              access_location::device,
+                                              access_mode::readwrite);
+    ArrayHandle<unsigned int> d_gpu_tag_table(m_gpu_tag_table,
+                                              access_location::device,
+                                              access_mode::readwrite);
+
+    gpu_permute_group_table<group_size, members_t>(m_gpu_table_indexer.getW(),
+                                                   m_gpu_table_indexer.getH(),
+                                                   d_groups.data,
+                                                   d_group_typeval.data,
+                                                   d_group_rtag.data,
+                                                   d_rtag.data,
+                                                   d_n_groups.data,
+                                                   d_gpu_table.data,
+                                                   d_gpu_pos_table.data,
+                                                   d_gpu_tag_table.data,
+                                                   has_type_mapping,
+                                                   m_exec_conf->getCachedAllocator());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
 #endif
 
 /*! \param snapshot Snapshot that will contain the group data
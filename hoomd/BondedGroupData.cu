@@ -7,6 +7,7 @@
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
 #include <hip/hip_runtime.h>
+#include <hipcub/hipcub.hpp>
 #include <thrust/device_ptr.h>
 #include <thrust/execution_policy.h>
 #include <thrust/iterator/constant_iterator.h>
@@ -68,9 +69,11 @@ __global__ void gpu_group_scatter_kernel(unsigned int n_scratch,
                                          const unsigned int* d_offset,
                                          const group_t* d_members,
                                          const typeval_union* d_group_typeval,
+                                         const unsigned int* d_group_tag,
                                          const unsigned int* d_rtag,
                                          group_t* d_pidx_group_table,
                                          unsigned int* d_pidx_gpos_table,
+                                         unsigned int* d_pidx_group_tag_table,
                                          unsigned int pidx_group_table_pitch,
                                          bool has_type_mapping)
     {
@@ -120,6 +123,138 @@ __global__ void gpu_group_scatter_kernel(unsigned int n_scratch,
 
     d_pidx_group_table[offset] = p;
     d_pidx_gpos_table[offset] = gpos;
+    d_pidx_group_tag_table[offset] = d_group_tag[group_idx];
+    }
+
+//! Kernel to move the entries of the group table to the rows of the new particle indices
+/*! One thread processes each entry of the old table. The entry identifies its group by tag and
+    its particle by the position in the group, so the kernel rebuilds it from the current group
+    members and particle indices.
+*/
+template<unsigned int group_size, typename group_t>
+__global__ void gpu_group_permute_kernel(const unsigned int n_entries,
+                                         const unsigned int pidx_group_table_pitch,
+                                         const unsigned int* d_n_groups_old,
+                                         const unsigned int* d_pidx_gpos_table_old,
+                                         const unsigned int* d_pidx_group_tag_table_old,
+                                         const group_t* d_members,
+                                         const typeval_union* d_group_typeval,
+                                         const unsigned int* d_group_rtag,
+                                         const unsigned int* d_rtag,
+                                         unsigned int* d_n_groups,
+                                         group_t* d_pidx_group_table,
+                                         unsigned int* d_pidx_gpos_table,
+                                         unsigned int* d_pidx_group_tag_table,
+                                         bool has_type_mapping)
+    {
+    unsigned int i = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (i >= n_entries)
+        return;
+
+    unsigned int old_pidx = i % pidx_group_table_pitch;
+    unsigned int num = i / pidx_group_table_pitch;
+    unsigned int n_groups = d_n_groups_old[old_pidx];
+    if (num >= n_groups)
+        return;
+
+    unsigned int group_tag = d_pidx_group_tag_table_old[i];
+    unsigned int gpos = d_pidx_gpos_table_old[i];
+    unsigned int group_idx = d_group_rtag[group_tag];
+    group_t g = d_members[group_idx];
+    unsigned int pidx = d_rtag[g.tag[gpos]];
+
+    // construct compact group representation, excluding particle pidx
+    group_t p;
+
+    if (has_type_mapping)
+        {
+        // last element = group type
+        p.idx[group_size - 1] = d_group_typeval[group_idx].type;
+        }
+    else
+        {
+        // last element = group index
+        p.idx[group_size - 1] = group_idx;
+        }
+
+    unsigned int j = 0;
+    for (unsigned int k = 0; k < group_size; ++k)
+        {
+        if (k == gpos)
+            continue;
+
+        p.idx[j++] = d_rtag[g.tag[k]];
+        }
+
+    unsigned int offset = num * pidx_group_table_pitch + pidx;
+    d_pidx_group_table[offset] = p;
+    d_pidx_gpos_table[offset] = gpos;
+    d_pidx_group_tag_table[offset] = group_tag;
+    if (num == 0)
+        d_n_groups[pidx] = n_groups;
+    }
+
+//! Kernel to compute the sort key of each group, the lowest local index of its members
+template<unsigned int group_size, typename group_t>
+__global__ void gpu_group_sort_key_kernel(const unsigned int n_groups,
+                                          const group_t* d_groups,
+                                          const unsigned int* d_rtag,
+                                          const unsigned int n_rtag,
+                                          unsigned int* d_keys,
+                                          unsigned int* d_order)
+    {
+    unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (group_idx >= n_groups)
+        return;
+
+    group_t g = d_groups[group_idx];
+    unsigned int key = GROUP_NOT_LOCAL;
+    for (unsigned int j = 0; j < group_size; ++j)
+        {
+        unsigned int tag = g.tag[j];
+        if (tag < n_rtag)
+            key = min(key, d_rtag[tag]);
+        }
+
+    d_keys[group_idx] = key;
+    d_order[group_idx] = group_idx;
+    }
+
+//! Kernel to gather the groups in sorted order into the alternate arrays
+/*! Ghost groups keep their place after the local groups. d_ranks and d_ranks_alt may be null.
+ */
+template<typename group_t>
+__global__ void gpu_group_gather_kernel(const unsigned int n_groups,
+                                        const unsigned int n_total,
+                                        const unsigned int* d_order,
+                                        const group_t* d_groups,
+                                        const typeval_union* d_typeval,
+                                        const unsigned int* d_group_tag,
+                                        const group_t* d_ranks,
+                                        group_t* d_groups_alt,
+                                        typeval_union* d_typeval_alt,
+                                        unsigned int* d_group_tag_alt,
+                                        group_t* d_ranks_alt,
+                                        unsigned int* d_group_rtag)
+    {
+    unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (group_idx >= n_total)
+        return;
+
+    unsigned int old_idx = group_idx < n_groups ? d_order[group_idx] : group_idx;
+    unsigned int group_tag = d_group_tag[old_idx];
+
+    d_groups_alt[group_idx] = d_groups[old_idx];
+    d_typeval_alt[group_idx] = d_typeval[old_idx];
+    d_group_tag_alt[group_idx] = group_tag;
+    if (d_ranks)
+        d_ranks_alt[group_idx] = d_ranks[old_idx];
+
+    if (group_idx < n_groups)
+        d_group_rtag[group_tag] = group_idx;
     }
 
 template<unsigned int group_size, typename group_t>
@@ -127,6 +262,7 @@ void gpu_update_group_table(const unsigned int n_groups,
                             const unsigned int N,
                             const group_t* d_group_table,
                             const typeval_union* d_group_typeval,
+                            const unsigned int* d_group_tag,
                             const unsigned int* d_rtag,
                             unsigned int* d_n_groups,
                             unsigned int max_n_groups,
@@ -135,6 +271,7 @@ void gpu_update_group_table(const unsigned int n_groups,
                             unsigned int& flag,
                             group_t* d_pidx_group_table,
                             unsigned int* d_pidx_gpos_table,
+                            unsigned int* d_pidx_group_tag_table,
                             const unsigned int pidx_group_table_pitch,
                             unsigned int* d_scratch_g,
                             unsigned int* d_scratch_idx,
@@ -210,14 +347,209 @@ void gpu_update_group_table(const unsigned int n_groups,
                            d_offsets,
                            d_group_table,
                            d_group_typeval,
+                           d_group_tag,
                            d_rtag,
                            d_pidx_group_table,
                            d_pidx_gpos_table,
+                           d_pidx_group_tag_table,
                            pidx_group_table_pitch,
                            has_type_mapping);
         }
     }
 
+/*! \param pidx_group_table_pitch Number of rows of the group table (local and ghost particles)
+    \param max_n_groups Number of columns of the group table
+    \param d_members Group members
+    \param d_group_typeval Group types or values
+    \param d_group_rtag Group reverse-lookup tags
+    \param d_rtag Particle reverse-lookup tags
+    \param d_n_groups Number of groups per particle, permuted in place
+    \param d_pidx_group_table Group table, permuted in place
+    \param d_pidx_gpos_table Position of the particle in each group, permuted in place
+    \param d_pidx_group_tag_table Tag of each group in the table, permuted in place
+    \param has_type_mapping True if the last element of the table entries holds the group type
+    \param alloc Caching allocator for temporary storage
+
+    The particles and groups must be the same as when the table was built, up to a permutation.
+*/
+template<unsigned int group_size, typename group_t>
+void gpu_permute_group_table(const unsigned int pidx_group_table_pitch,
+                             const unsigned int max_n_groups,
+                             const group_t* d_members,
+                             const typeval_union* d_group_typeval,
+                             const unsigned int* d_group_rtag,
+                             const unsigned int* d_rtag,
+                             unsigned int* d_n_groups,
+                             group_t* d_pidx_group_table,
+                             unsigned int* d_pidx_gpos_table,
+                             unsigned int* d_pidx_group_tag_table,
+                             bool has_type_mapping,
+                             CachedAllocator& alloc)
+    {
+    const unsigned int n_entries = pidx_group_table_pitch * max_n_groups;
+    if (n_entries == 0)
+        return;
+
+    // keep the old counts and entries, the table itself is overwritten
+    unsigned int* d_n_groups_old = alloc.getTemporaryBuffer<unsigned int>(pidx_group_table_pitch);
+    unsigned int* d_gpos_old = alloc.getTemporaryBuffer<unsigned int>(n_entries);
+    unsigned int* d_group_tag_old = alloc.getTemporaryBuffer<unsigned int>(n_entries);
+
+    hipMemcpyAsync(d_n_groups_old,
+                   d_n_groups,
+                   sizeof(unsigned int) * pidx_group_table_pitch,
+                   hipMemcpyDeviceToDevice);
+    hipMemcpyAsync(d_gpos_old,
+                   d_pidx_gpos_table,
+                   sizeof(unsigned int) * n_entries,
+                   hipMemcpyDeviceToDevice);
+    hipMemcpyAsync(d_group_tag_old,
+                   d_pidx_group_tag_table,
+                   sizeof(unsigned int) * n_entries,
+                   hipMemcpyDeviceToDevice);
+    hipMemsetAsync(d_n_groups, 0, sizeof(unsigned int) * pidx_group_table_pitch);
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = n_entries / block_size + 1;
+
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_group_permute_kernel<group_size>),
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       n_entries,
+                       pidx_group_table_pitch,
+                       d_n_groups_old,
+                       d_gpos_old,
+                       d_group_tag_old,
+                       d_members,
+                       d_group_typeval,
+                       d_group_rtag,
+                       d_rtag,
+                       d_n_groups,
+                       d_pidx_group_table,
+                       d_pidx_gpos_table,
+                       d_pidx_group_tag_table,
+                       has_type_mapping);
+
+    alloc.deallocate((char*)d_group_tag_old);
+    alloc.deallocate((char*)d_gpos_old);
+    alloc.deallocate((char*)d_n_groups_old);
+    }
+
+/*! \param n_groups Number of local groups
+    \param n_ghost Number of ghost groups, which follow the local groups
+    \param d_groups Group members
+    \param d_typeval Group types or values
+    \param d_group_tag Group tags
+    \param d_ranks Member ranks (may be null)
+    \param d_rtag Particle reverse-lookup tags
+    \param n_rtag Number of elements in \a d_rtag
+    \param d_groups_alt Group members in sorted order (output)
+    \param d_typeval_alt Group types or values in sorted order (output)
+    \param d_group_tag_alt Group tags in sorted order (output)
+    \param d_ranks_alt Member ranks in sorted order (output, may be null)
+    \param d_group_rtag Group reverse-lookup tags, updated to the sorted order
+    \param alloc Caching allocator for temporary storage
+    \returns true when the groups were not already in order and the outputs have been written
+
+    The stable radix sort keeps the relative order of groups with the same key, which matches the
+    host implementation.
+*/
+template<unsigned int group_size, typename group_t>
+bool gpu_sort_groups_by_particle_index(const unsigned int n_groups,
+                                       const unsigned int n_ghost,
+                                       const group_t* d_groups,
+                                       const typeval_union* d_typeval,
+                                       const unsigned int* d_group_tag,
+                                       const group_t* d_ranks,
+                                       const unsigned int* d_rtag,
+                                       const unsigned int n_rtag,
+                                       group_t* d_groups_alt,
+                                       typeval_union* d_typeval_alt,
+                                       unsigned int* d_group_tag_alt,
+                                       group_t* d_ranks_alt,
+                                       unsigned int* d_group_rtag,
+                                       CachedAllocator& alloc)
+    {
+    unsigned int* d_keys = alloc.getTemporaryBuffer<unsigned int>(n_groups);
+    unsigned int* d_keys_sorted = alloc.getTemporaryBuffer<unsigned int>(n_groups);
+    unsigned int* d_order = alloc.getTemporaryBuffer<unsigned int>(n_groups);
+    unsigned int* d_order_sorted = alloc.getTemporaryBuffer<unsigned int>(n_groups);
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = n_groups / block_size + 1;
+
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_group_sort_key_kernel<group_size>),
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       n_groups,
+                       d_groups,
+                       d_rtag,
+                       n_rtag,
+                       d_keys,
+                       d_order);
+
+    // this is the only value read back by the host, most sorts of a settled system are no-ops
+    thrust::device_ptr<unsigned int> keys(d_keys);
+#ifdef __HIP_PLATFORM_HCC__
+    bool sorted = thrust::is_sorted(thrust::hip::par(alloc), keys, keys + n_groups);
+#else
+    bool sorted = thrust::is_sorted(thrust::cuda::par(alloc), keys, keys + n_groups);
+#endif
+
+    if (!sorted)
+        {
+        void* d_temp_storage = NULL;
+        size_t temp_storage_bytes = 0;
+        hipcub::DeviceRadixSort::SortPairs(d_temp_storage,
+                                           temp_storage_bytes,
+                                           d_keys,
+                                           d_keys_sorted,
+                                           d_order,
+                                           d_order_sorted,
+                                           n_groups);
+        d_temp_storage = alloc.getTemporaryBuffer<char>(temp_storage_bytes);
+        hipcub::DeviceRadixSort::SortPairs(d_temp_storage,
+                                           temp_storage_bytes,
+                                           d_keys,
+                                           d_keys_sorted,
+                                           d_order,
+                                           d_order_sorted,
+                                           n_groups);
+        alloc.deallocate((char*)d_temp_storage);
+
+        const unsigned int n_total = n_groups + n_ghost;
+        n_blocks = n_total / block_size + 1;
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_group_gather_kernel<group_t>),
+                           dim3(n_blocks),
+                           dim3(block_size),
+                           0,
+                           0,
+                           n_groups,
+                           n_total,
+                           d_order_sorted,
+                           d_groups,
+                           d_typeval,
+                           d_group_tag,
+                           d_ranks,
+                           d_groups_alt,
+                           d_typeval_alt,
+                           d_group_tag_alt,
+                           d_ranks_alt,
+                           d_group_rtag);
+        }
+
+    alloc.deallocate(d_order_sorted);
+    alloc.deallocate(d_order);
+    alloc.deallocate(d_keys_sorted);
+    alloc.deallocate(d_keys);
+
+    return !sorted;
+    }
+
 /*
  * Explicit template instantiations
  */
@@ -227,6 +559,7 @@ template void gpu_update_group_table<2>(const unsigned int n_groups,
                                         const unsigned int N,
                                         const union group_storage<2>* d_group_table,
                                         const typeval_union* d_group_typeval,
+                                        const unsigned int* d_group_tag,
                                         const unsigned int* d_rtag,
                                         unsigned int* d_n_groups,
                                         unsigned int max_n_groups,
@@ -235,6 +568,7 @@ template void gpu_update_group_table<2>(const unsigned int n_groups,
                                         unsigned int& flag,
                                         group_storage<2>* d_pidx_group_table,
                                         unsigned int* d_pidx_gpos_table,
+                                        unsigned int* d_pidx_group_tag_table,
                                         const unsigned int pidx_group_table_pitch,
                                         unsigned int* d_scratch_g,
                                         unsigned int* d_scratch_idx,
@@ -247,6 +581,7 @@ template void gpu_update_group_table<3>(const unsigned int n_groups,
                                         const unsigned int N,
                                         const union group_storage<3>* d_group_table,
                                         const typeval_union* d_group_typeval,
+                                        const unsigned int* d_group_tag,
                                         const unsigned int* d_rtag,
                                         unsigned int* d_n_groups,
                                         unsigned int max_n_groups,
@@ -255,6 +590,7 @@ template void gpu_update_group_table<3>(const unsigned int n_groups,
                                         unsigned int& flag,
                                         group_storage<3>* d_pidx_group_table,
                                         unsigned int* d_pidx_gpos_table,
+                                        unsigned int* d_pidx_group_tag_table,
                                         const unsigned int pidx_group_table_pitch,
                                         unsigned int* d_scratch_g,
                                         unsigned int* d_scratch_idx,
@@ -267,6 +603,7 @@ template void gpu_update_group_table<4>(const unsigned int n_groups,
                                         const unsigned int N,
                                         const union group_storage<4>* d_group_table,
                                         const typeval_union* d_group_typeval,
+                                        const unsigned int* d_group_tag,
                                         const unsigned int* d_rtag,
                                         unsigned int* d_n_groups,
                                         unsigned int max_n_groups,
@@ -275,6 +612,7 @@ template void gpu_update_group_table<4>(const unsigned int n_groups,
                                         unsigned int& flag,
                                         group_storage<4>* d_pidx_group_table,
                                         unsigned int* d_pidx_gpos_table,
+                                        unsigned int* d_pidx_group_tag_table,
                                         const unsigned int pidx_group_table_pitch,
                                         unsigned int* d_scratch_g,
                                         unsigned int* d_scratch_idx,
@@ -287,6 +625,7 @@ template void gpu_update_group_table<6>(const unsigned int n_groups,
                                         const unsigned int N,
                                         const union group_storage<6>* d_group_table,
                                         const typeval_union* d_group_typeval,
+                                        const unsigned int* d_group_tag,
                                         const unsigned int* d_rtag,
                                         unsigned int* d_n_groups,
                                         unsigned int max_n_groups,
@@ -295,10 +634,130 @@ template void gpu_update_group_table<6>(const unsigned int n_groups,
                                         unsigned int& flag,
                                         group_storage<6>* d_pidx_group_table,
                                         unsigned int* d_pidx_gpos_table,
+                                        unsigned int* d_pidx_group_tag_table,
                                         const unsigned int pidx_group_table_pitch,
                                         unsigned int* d_scratch_g,
                                         unsigned int* d_scratch_idx,
                                         unsigned int* d_offsets,
                                         bool has_type_mapping,
                                         CachedAllocator& alloc);
+//! BondData
+template bool gpu_sort_groups_by_particle_index<2>(const unsigned int n_groups,
+                                                   const unsigned int n_ghost,
+                                                   const group_storage<2>* d_groups,
+                                                   const typeval_union* d_typeval,
+                                                   const unsigned int* d_group_tag,
+                                                   const group_storage<2>* d_ranks,
+                                                   const unsigned int* d_rtag,
+                                                   const unsigned int n_rtag,
+                                                   group_storage<2>* d_groups_alt,
+                                                   typeval_union* d_typeval_alt,
+                                                   unsigned int* d_group_tag_alt,
+                                                   group_storage<2>* d_ranks_alt,
+                                                   unsigned int* d_group_rtag,
+                                                   CachedAllocator& alloc);
+
+//! AngleData
+template bool gpu_sort_groups_by_particle_index<3>(const unsigned int n_groups,
+                                                   const unsigned int n_ghost,
+                                                   const group_storage<3>* d_groups,
+                                                   const typeval_union* d_typeval,
+                                                   const unsigned int* d_group_tag,
+                                                   const group_storage<3>* d_ranks,
+                                                   const unsigned int* d_rtag,
+                                                   const unsigned int n_rtag,
+                                                   group_storage<3>* d_groups_alt,
+                                                   typeval_union* d_typeval_alt,
+                                                   unsigned int* d_group_tag_alt,
+                                                   group_storage<3>* d_ranks_alt,
+                                                   unsigned int* d_group_rtag,
+                                                   CachedAllocator& alloc);
+
+//! DihedralData and ImproperData
+template bool gpu_sort_groups_by_particle_index<4>(const unsigned int n_groups,
+                                                   const unsigned int n_ghost,
+                                                   const group_storage<4>* d_groups,
+                                                   const typeval_union* d_typeval,
+                                                   const unsigned int* d_group_tag,
+                                                   const group_storage<4>* d_ranks,
+                                                   const unsigned int* d_rtag,
+                                                   const unsigned int n_rtag,
+                                                   group_storage<4>* d_groups_alt,
+                                                   typeval_union* d_typeval_alt,
+                                                   unsigned int* d_group_tag_alt,
+                                                   group_storage<4>* d_ranks_alt,
+                                                   unsigned int* d_group_rtag,
+                                                   CachedAllocator& alloc);
+
+//! MeshTriangleData
+template bool gpu_sort_groups_by_particle_index<6>(const unsigned int n_groups,
+                                                   const unsigned int n_ghost,
+                                                   const group_storage<6>* d_groups,
+                                                   const typeval_union* d_typeval,
+                                                   const unsigned int* d_group_tag,
+                                                   const group_storage<6>* d_ranks,
+                                                   const unsigned int* d_rtag,
+                                                   const unsigned int n_rtag,
+                                                   group_storage<6>* d_groups_alt,
+                                                   typeval_union* d_typeval_alt,
+                                                   unsigned int* d_group_tag_alt,
+                                                   group_storage<6>* d_ranks_alt,
+                                                   unsigned int* d_group_rtag,
+                                                   CachedAllocator& alloc);
+
+//! BondData
+template void gpu_permute_group_table<2>(const unsigned int pidx_group_table_pitch,
+                                         const unsigned int max_n_groups,
+                                         const group_storage<2>* d_members,
+                                         const typeval_union* d_group_typeval,
+                                         const unsigned int* d_group_rtag,
+                                         const unsigned int* d_rtag,
+                                         unsigned int* d_n_groups,
+                                         group_storage<2>* d_pidx_group_table,
+                                         unsigned int* d_pidx_gpos_table,
+                                         unsigned int* d_pidx_group_tag_table,
+                                         bool has_type_mapping,
+                                         CachedAllocator& alloc);
+
+//! AngleData
+template void gpu_permute_group_table<3>(const unsigned int pidx_group_table_pitch,
+                                         const unsigned int max_n_groups,
+                                         const group_storage<3>* d_members,
+                                         const typeval_union* d_group_typeval,
+                                         const unsigned int* d_group_rtag,
+                                         const unsigned int* d_rtag,
+                                         unsigned int* d_n_groups,
+                                         group_storage<3>* d_pidx_group_table,
+                                         unsigned int* d_pidx_gpos_table,
+                                         unsigned int* d_pidx_group_tag_table,
+                                         bool has_type_mapping,
+                                         CachedAllocator& alloc);
+
+//! DihedralData and ImproperData
+template void gpu_permute_group_table<4>(const unsigned int pidx_group_table_pitch,
+                                         const unsigned int max_n_groups,
+                                         const group_storage<4>* d_members,
+                                         const typeval_union* d_group_typeval,
+                                         const unsigned int* d_group_rtag,
+                                         const unsigned int* d_rtag,
+                                         unsigned int* d_n_groups,
+                                         group_storage<4>* d_pidx_group_table,
+                                         unsigned int* d_pidx_gpos_table,
+                                         unsigned int* d_pidx_group_tag_table,
+                                         bool has_type_mapping,
+                                         CachedAllocator& alloc);
+
+//! MeshTriangleData
+template void gpu_permute_group_table<6>(const unsigned int pidx_group_table_pitch,
+                                         const unsigned int max_n_groups,
+                                         const group_storage<6>* d_members,
+                                         const typeval_union* d_group_typeval,
+                                         const unsigned int* d_group_rtag,
+                                         const unsigned int* d_rtag,
+                                         unsigned int* d_n_groups,
+                                         group_storage<6>* d_pidx_group_table,
+                                         unsigned int* d_pidx_gpos_table,
+                                         unsigned int* d_pidx_group_tag_table,
+                                         bool has_type_mapping,
+                                         CachedAllocator& alloc);
     } // end namespace hoomd
@@ -54,6 +54,7 @@ void gpu_update_group_table(const unsigned int n_groups,
                             const unsigned int N,
                             const group_t* d_group_table,
                             const typeval_union* d_group_typeval,
+                            const unsigned int* d_group_tag,
                             const unsigned int* d_rtag,
                             unsigned int* d_n_groups,
                             unsigned int max_n_groups,
@@ -62,6 +63,7 @@ void gpu_update_group_table(const unsigned int n_groups,
                             unsigned int& flag,
                             group_t* d_pidx_group_table,
                             unsigned int* d_pidx_gpos_table,
+                            unsigned int* d_pidx_group_tag_table,
                             const unsigned int pidx_group_table_pitch,
                             unsigned int* d_scratch_g,
                             unsigned int* d_scratch_idx,
@@ -69,5 +71,37 @@ void gpu_update_group_table(const unsigned int n_groups,
                             bool has_type_mapping,
                             CachedAllocator& alloc);
 
+//! Move the entries of the group table to the rows of the new particle indices
+template<unsigned int group_size, typename group_t>
+void gpu_permute_group_table(const unsigned int pidx_group_table_pitch,
+                             const unsigned int max_n_groups,
+                             const group_t* d_members,
+                             const typeval_union* d_group_typeval,
+                             const unsigned int* d_group_rtag,
+                             const unsigned int* d_rtag,
+                             unsigned int* d_n_groups,
+                             group_t* d_pidx_group_table,
+                             unsigned int* d_pidx_gpos_table,
+                             unsigned int* d_pidx_group_tag_table,
+                             bool has_type_mapping,
+                             CachedAllocator& alloc);
+
+//! Sort the local groups by the lowest local index of their members
+template<unsigned int group_size, typename group_t>
+bool gpu_sort_groups_by_particle_index(const unsigned int n_groups,
+                                       const unsigned int n_ghost,
+                                       const group_t* d_groups,
+                                       const typeval_union* d_typeval,
+                                       const unsigned int* d_group_tag,
+                                       const group_t* d_ranks,
+                                       const unsigned int* d_rtag,
+                                       const unsigned int n_rtag,
+                                       group_t* d_groups_alt,
+                                       typeval_union* d_typeval_alt,
+                                       unsigned int* d_group_tag_alt,
+                                       group_t* d_ranks_alt,
+                                       unsigned int* d_group_rtag,
+                                       CachedAllocator& alloc);
+
     }  // end namespace hoomd
 #endif // __BONDED_GROUP_DATA_CUH__
@@ -271,6 +271,17 @@ class BondedGroupData
     //! Initialize from a snapshot
     virtual void initializeFromSnapshot(const Snapshot& snapshot);
 
+    /// Initialize the local groups of a unit cell replicated n_images times
+    void initializeReplicated(const Snapshot& unit_cell,
+                              unsigned int n_images,
+                              unsigned int n_unit_particles);
+
+    /// Append the local groups and the tag bookkeeping to a checkpoint
+    void writeCheckpoint(detail::CheckpointBuffer& buffer);
+
+    /// Restore the local groups from a checkpoint written by this rank
+    void readCheckpoint(detail::CheckpointBuffer& buffer);
+
     //! Take a snapshot
     std::map<unsigned int, unsigned int> takeSnapshot(Snapshot& snapshot) const;
 
@@ -401,6 +412,26 @@ class BondedGroupData
         m_n_groups -= nremove;
         }
 
+    //! Release allocated memory that the local and ghost groups do not use
+    /*! \param shrink_fraction Fraction of the allocated size below which the arrays shrink
+     */
+    void shrink(Scalar shrink_fraction)
+        {
+        m_groups.shrink(shrink_fraction);
+        m_group_typeval.shrink(shrink_fraction);
+        m_group_tag.shrink(shrink_fraction);
+        m_groups_alt.shrink(shrink_fraction);
+        m_group_typeval_alt.shrink(shrink_fraction);
+        m_group_tag_alt.shrink(shrink_fraction);
+#ifdef ENABLE_MPI
+        if (m_pdata->getDomainDecomposition())
+            {
+            m_group_ranks.shrink(shrink_fraction);
+            m_group_ranks_alt.shrink(shrink_fraction);
+            }
+#endif
+        }
+
     //! Return group table (const)
     const GPUVector<members_t>& getMembersArray() const
         {
@@ -543,39 +574,21 @@ class BondedGroupData
     //! Return GPU bonded groups list
     const GPUVector<members_t>& getGPUTable()
         {
-        // rebuild lookup table if necessary
-        if (m_groups_dirty)
-            {
-            rebuildGPUTable();
-            m_groups_dirty = false;
-            }
-
+        updateGPUTable();
         return m_gpu_table;
         }
 
     //! Return GPU list of particle in group position
     const GPUArray<unsigned>& getGPUPosTable()
         {
-        // rebuild lookup table if necessary
-        if (m_groups_dirty)
-            {
-            rebuildGPUTable();
-            m_groups_dirty = false;
-            }
-
+        updateGPUTable();
         return m_gpu_pos_table;
         }
 
     //! Return two-dimensional group-by-ptl-index lookup table
     const Index2D& getGPUTableIndexer()
         {
-        // rebuild lookup table if necessary
-        if (m_groups_dirty)
-            {
-            rebuildGPUTable();
-            m_groups_dirty = false;
-            }
-
+        updateGPUTable();
         return m_gpu_table_indexer;
         }
 
@@ -585,6 +598,27 @@ class BondedGroupData
         return m_gpu_n_groups;
         }
 
+    /*
+     * Member index table
+     */
+
+    //! Return the local particle indices of the members of every local and ghost group
+    /*! The table is parallel to getMembersArray() and holds the members resolved through the
+        particle reverse-lookup tags in idx. It is rebuilt on the host only after the particles are
+        sorted or the groups are reordered, so that the CPU force computes need not look up the
+        tags on every step. Members that are not local have the index NOT_LOCAL.
+    */
+    const GPUVector<members_t>& getMemberIndexTable()
+        {
+        if (m_member_idx_dirty)
+            {
+            rebuildMemberIndexTable();
+            m_member_idx_dirty = false;
+            }
+
+        return m_member_idx;
+        }
+
     /*
      * add/remove groups globally
      */
@@ -616,17 +650,28 @@ class BondedGroupData
         {
         // set flag to trigger rebuild of GPU table
         m_groups_dirty = true;
+        m_member_idx_dirty = true;
 
         // notify subscribers
         m_group_reorder_signal.emit();
         }
 
     //! Indicate that GPU table needs to be rebuilt
+    /*! When the particle sort only permuted the local particles, the entries of the GPU table
+        remain valid and updateGPUTable() moves them to the rows of the new particle indices.
+    */
     void setDirty()
         {
-        m_groups_dirty = true;
+        if (m_pdata->isSortPermutation() && canPermuteGPUTable())
+            m_gpu_table_permuted = true;
+        else
+            m_groups_dirty = true;
+        m_member_idx_dirty = true;
         }
 
+    //! Sort the local groups by the local index of their members
+    void sortByParticleIndex();
+
 #ifdef ENABLE_MPI
     //! Helper function to transfer bonded groups connected to a single particle
     /*! \param tag Tag of particle that moves between domains
@@ -648,8 +693,10 @@ class BondedGroupData
     GPUVector<members_t>
         m_gpu_table; //!< Storage for groups by particle index for access on the GPU
     GPUVector<unsigned int> m_gpu_pos_table; //!< Position of particle idx in group table
+    GPUVector<unsigned int> m_gpu_tag_table; //!< Group tag of each entry in the group table
     Index2D m_gpu_table_indexer;             //!< Indexer for GPU table
     GPUVector<unsigned int> m_gpu_n_groups;  //!< Number of entries in lookup table per particle
+    GPUVector<members_t> m_member_idx;       //!< Local particle indices of the group members
     std::vector<std::string> m_type_mapping; //!< Mapping of types of bonded groups
 
     unsigned int m_n_groups; //!< Number of local groups
@@ -682,7 +729,9 @@ class BondedGroupData
     unsigned int m_next_flag;           //!< Next flag value for GPU table rebuild
 #endif
     private:
-    bool m_groups_dirty; //!< Check if it is necessary to rebuild the lookup-by-index table
+    bool m_groups_dirty;       //!< Check if it is necessary to rebuild the lookup-by-index table
+    bool m_gpu_table_permuted; //!< Check if it is sufficient to permute the lookup-by-index table
+    bool m_member_idx_dirty;   //!< Check if it is necessary to rebuild the member index table
 
     Nano::Signal<void()> m_group_reorder_signal; //!< Signal that is triggered when groups are added
                                                  //!< or deleted locally
@@ -693,6 +742,34 @@ class BondedGroupData
     //! Helper function to rebuild lookup by index table
     virtual void rebuildGPUTable();
 
+    //! Helper function to rebuild or permute the lookup by index table if necessary
+    void updateGPUTable()
+        {
+        if (m_groups_dirty)
+            {
+            rebuildGPUTable();
+            m_groups_dirty = false;
+            m_gpu_table_permuted = false;
+            }
+        else if (m_gpu_table_permuted)
+            {
+            permuteGPUTable();
+            m_gpu_table_permuted = false;
+            }
+        }
+
+    //! Check whether the lookup by index table may be permuted instead of rebuilt
+    bool canPermuteGPUTable() const;
+
+    //! Helper function to move the entries of the lookup by index table to the new particle indices
+    void permuteGPUTable();
+
+    //! Notify subscribers that the local groups have been permuted
+    void notifyGroupPermutation();
+
+    //! Helper function to rebuild the member index table
+    void rebuildMemberIndexTable();
+
     //! Resize internal tables
     /*! \param new_size New size of local group tables, new_size = n_local + n_ghost
      */
@@ -712,6 +789,12 @@ class BondedGroupData
 #ifdef ENABLE_HIP
     //! Helper function to rebuild lookup by index table on the GPU
     virtual void rebuildGPUTableGPU();
+
+    //! Helper function to sort the local groups by the local index of their members on the GPU
+    void sortByParticleIndexGPU();
+
+    //! Helper function to permute the lookup by index table on the GPU
+    void permuteGPUTableGPU();
 #endif
     };
 
@@ -56,8 +56,8 @@ void BoxResizeUpdater::update(uint64_t timestep)
     // only change the box if there is a change in the box dimensions
     if (new_box != cur_box)
         {
-        // set the new box
-        m_pdata->setGlobalBox(new_box);
+        // set the new box, subscribers may reuse their data structures after small deformations
+        m_pdata->setGlobalBox(new_box, m_small_deformation);
 
         // scale the particle positions (if we have been asked to)
         // move the particles to be inside the new box
@@ -120,6 +120,9 @@ void export_BoxResizeUpdater(pybind11::module& m)
                             std::shared_ptr<VectorVariantBox>,
                             std::shared_ptr<ParticleGroup>>())
         .def_property("box", &BoxResizeUpdater::getBox, &BoxResizeUpdater::setBox)
+        .def_property("small_deformation",
+                      &BoxResizeUpdater::getSmallDeformation,
+                      &BoxResizeUpdater::setSmallDeformation)
         .def_property_readonly("filter",
                                [](const std::shared_ptr<BoxResizeUpdater> method)
                                { return method->getGroup()->getFilter(); })
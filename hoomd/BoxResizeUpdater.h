@@ -55,6 +55,18 @@ class PYBIND11_EXPORT BoxResizeUpdater : public Updater
         return m_box;
         }
 
+    /// Set whether box changes are notified as small deformations
+    void setSmallDeformation(bool small_deformation)
+        {
+        m_small_deformation = small_deformation;
+        }
+
+    /// Get whether box changes are notified as small deformations
+    bool getSmallDeformation()
+        {
+        return m_small_deformation;
+        }
+
     /// Gets particle scaling filter
     std::shared_ptr<ParticleGroup> getGroup()
         {
@@ -76,6 +88,9 @@ class PYBIND11_EXPORT BoxResizeUpdater : public Updater
 
     /// Selected particles to scale when resizing the box.
     std::shared_ptr<ParticleGroup> m_group;
+
+    /// Notify box changes as small affine deformations.
+    bool m_small_deformation = false;
     };
 
 namespace detail
@@ -9,6 +9,8 @@
 #include "Communicator.h"
 
 #include <algorithm>
+#include <limits>
+#include <vector>
 
 using namespace std;
 
@@ -29,6 +31,7 @@ CellList::CellList(std::shared_ptr<SystemDefinition> sysdef)
     m_params_changed = true;
     m_particles_sorted = false;
     m_box_changed = false;
+    m_box_change_minor = false;
     m_multiple = 1;
 
     GlobalArray<uint3> conditions(1, m_exec_conf);
@@ -162,6 +165,11 @@ void CellList::compute(uint64_t timestep)
             // number of bins has not changed, only need to update width
             initializeWidth();
             }
+        else if (m_box_change_minor && canKeepDimensions(new_dim))
+            {
+            // the current bins remain wide enough after a small deformation, reuse the memory
+            initializeWidth(true);
+            }
         else
             {
             // number of bins has changed, need to fully reinitialize memory
@@ -169,6 +177,7 @@ void CellList::compute(uint64_t timestep)
             }
 
         m_box_changed = false;
+        m_box_change_minor = false;
         force = true;
         }
 
@@ -205,7 +214,9 @@ void CellList::initializeAll()
     initializeMemory();
     }
 
-void CellList::initializeWidth()
+/*! \param keep_dimensions Set to true to keep the current dimensions, see canKeepDimensions()
+ */
+void CellList::initializeWidth(bool keep_dimensions)
     {
     m_exec_conf->msg->notice(10) << "Cell list initialize width" << endl;
 
@@ -213,7 +224,15 @@ void CellList::initializeWidth()
     const BoxDim& box = m_pdata->getBox();
 
     // initialize dimensions and width
-    m_dim = computeDimensions();
+    if (keep_dimensions)
+        {
+        // computeDimensions() also sizes the ghost layer
+        computeDimensions();
+        }
+    else
+        {
+        m_dim = computeDimensions();
+        }
 
     // stash the current actual cell width
     const Scalar3 L = box.getNearestPlaneDistance();
@@ -225,6 +244,29 @@ void CellList::initializeWidth()
     m_width_change.emit();
     }
 
+/*! \param new_dim Dimensions that computeDimensions() returns for the new box
+
+    \returns True when the cells of the current dimensions are at least as wide as the nominal
+    width in the new box, and at most minor_width_tolerance wider where the new box would fit more
+    cells. Small deformations then resize the cells without reallocating the cell list.
+*/
+bool CellList::canKeepDimensions(const uint3& new_dim) const
+    {
+    // fewer cells fit in the new box when the current cells become too narrow
+    if (new_dim.x < m_dim.x || new_dim.y < m_dim.y || new_dim.z < m_dim.z)
+        return false;
+
+    const Scalar3 L = m_pdata->getBox().getNearestPlaneDistance();
+    const Scalar max_width = m_nominal_width * (Scalar(1.0) + minor_width_tolerance);
+    if (new_dim.x > m_dim.x && (L.x + Scalar(2.0) * m_ghost_width.x) / Scalar(m_dim.x) > max_width)
+        return false;
+    if (new_dim.y > m_dim.y && (L.y + Scalar(2.0) * m_ghost_width.y) / Scalar(m_dim.y) > max_width)
+        return false;
+    if (new_dim.z > m_dim.z && (L.z + Scalar(2.0) * m_ghost_width.z) / Scalar(m_dim.z) > max_width)
+        return false;
+    return true;
+    }
+
 void CellList::initializeMemory()
     {
     m_exec_conf->msg->notice(10) << "Cell list initialize memory" << endl;
@@ -240,6 +282,10 @@ void CellList::initializeMemory()
             m_Nmax = 1;
         }
 
+    // cells sorted by type are padded for vector loops
+    if (m_sort_by_type && m_Nmax % cell_padding != 0)
+        m_Nmax += cell_padding - m_Nmax % cell_padding;
+
     m_exec_conf->msg->notice(6) << "cell list: allocating " << m_dim.x << " x " << m_dim.y << " x "
                                 << m_dim.z << " x " << m_Nmax << endl;
 
@@ -325,7 +371,7 @@ void CellList::initializeMemory()
         m_orientation.swap(orientation);
         }
 
-    if (m_compute_idx || m_sort_cell_list)
+    if (m_compute_idx || m_sort_cell_list || m_sort_by_type)
         {
         GlobalArray<unsigned int> idx(m_cell_list_indexer.getNumElements(), m_exec_conf);
         m_idx.swap(idx);
@@ -338,6 +384,36 @@ void CellList::initializeMemory()
         m_idx.swap(idx);
         }
 
+    if (m_sort_by_type)
+        {
+        m_type_offset_indexer
+            = Index2D(m_pdata->getNTypes() + 1, m_cell_indexer.getNumElements());
+        GlobalArray<unsigned int> type_offsets(m_type_offset_indexer.getNumElements(),
+                                               m_exec_conf);
+        m_type_offsets.swap(type_offsets);
+        TAG_ALLOCATION(m_type_offsets);
+        }
+    else
+        {
+        // array is no longer needed, discard it
+        m_type_offset_indexer = Index2D();
+        GlobalArray<unsigned int> type_offsets;
+        m_type_offsets.swap(type_offsets);
+        }
+
+    if (m_sort_by_type && m_group_bodies)
+        {
+        GlobalArray<unsigned int> body_run_end(m_cell_list_indexer.getNumElements(), m_exec_conf);
+        m_body_run_end.swap(body_run_end);
+        TAG_ALLOCATION(m_body_run_end);
+        }
+    else
+        {
+        // array is no longer needed, discard it
+        GlobalArray<unsigned int> body_run_end;
+        m_body_run_end.swap(body_run_end);
+        }
+
     // only initialize the adjacency list if requested
     if (m_compute_adj_list)
         initializeCellAdj();
@@ -450,6 +526,10 @@ void CellList::computeCellList()
             continue;
             }
 
+        // skip the particles of the types that are not binned
+        if (!m_type_filter.empty() && !m_type_filter[__scalar_as_int(h_pos.data[n].w)])
+            continue;
+
         // find the bin each particle belongs in
         Scalar3 f = box.makeFraction(p, ghost_width);
         int ib = (int)(f.x * m_dim.x);
@@ -523,7 +603,7 @@ void CellList::computeCellList()
                 h_cell_orientation.data[cli(offset, bin)] = h_orientation.data[n];
                 }
 
-            if (m_compute_idx)
+            if (m_compute_idx || m_sort_by_type)
                 {
                 h_cell_idx.data[cli(offset, bin)] = n;
                 }
@@ -544,6 +624,126 @@ void CellList::computeCellList()
                                         access_mode::overwrite);
         *h_conditions.data = conditions;
         }
+
+    // overflowed cell lists are recomputed, sort only complete ones
+    if (m_sort_by_type && conditions.x == 0)
+        sortCellsByType();
+    }
+
+/*! The members of each cell are reordered by a stable counting sort on the type, so that members
+    of the same type remain in the order in which they were inserted. All per member arrays are
+    permuted together.
+
+    When grouping bodies, the members of each type are further sorted by body, and the end of the
+    run of each body is recorded in m_body_run_end.
+*/
+void CellList::sortCellsByType()
+    {
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_size(m_cell_size, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_xyzf(m_xyzf, access_location::host, access_mode::readwrite);
+    ArrayHandle<uint2> h_type_body(m_type_body, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_cell_orientation(m_orientation,
+                                            access_location::host,
+                                            access_mode::readwrite);
+    ArrayHandle<unsigned int> h_cell_idx(m_idx, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_type_offsets(m_type_offsets,
+                                             access_location::host,
+                                             access_mode::overwrite);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<unsigned int> h_body_run_end(m_body_run_end,
+                                             access_location::host,
+                                             access_mode::overwrite);
+    const bool group_bodies = m_group_bodies;
+
+    const unsigned int n_types = m_pdata->getNTypes();
+    const Scalar nan = std::numeric_limits<Scalar>::quiet_NaN();
+
+    // scratch space reused by all cells
+    std::vector<unsigned int> types;
+    std::vector<unsigned int> order;
+    std::vector<unsigned int> next(n_types);
+    std::vector<Scalar4> scratch_scalar4;
+    std::vector<uint2> scratch_uint2;
+    std::vector<unsigned int> scratch_uint;
+
+    // reorder the members [0, size) of a cell row by order
+    auto permute = [&order](auto* row, unsigned int size, auto& scratch)
+    {
+        scratch.assign(row, row + size);
+        for (unsigned int k = 0; k < size; k++)
+            row[k] = scratch[order[k]];
+    };
+
+    for (unsigned int cell = 0; cell < m_cell_indexer.getNumElements(); cell++)
+        {
+        const unsigned int size = h_cell_size.data[cell];
+        const size_t row = m_cell_list_indexer(0, cell);
+        unsigned int* offsets = h_type_offsets.data + m_type_offset_indexer(0, cell);
+
+        // count the members of each type and find where each type starts
+        types.resize(size);
+        std::fill(offsets, offsets + n_types + 1, 0);
+        for (unsigned int k = 0; k < size; k++)
+            {
+            types[k] = __scalar_as_int(h_pos.data[h_cell_idx.data[row + k]].w);
+            offsets[types[k] + 1]++;
+            }
+        for (unsigned int t = 0; t < n_types; t++)
+            {
+            offsets[t + 1] += offsets[t];
+            next[t] = offsets[t];
+            }
+
+        order.resize(size);
+        for (unsigned int k = 0; k < size; k++)
+            order[next[types[k]]++] = k;
+
+        // within each type, keep the members of a body together and in insertion order
+        auto body_of = [&](unsigned int k) { return h_body.data[h_cell_idx.data[row + k]]; };
+        if (group_bodies)
+            {
+            for (unsigned int t = 0; t < n_types; t++)
+                {
+                std::stable_sort(order.begin() + offsets[t],
+                                 order.begin() + offsets[t + 1],
+                                 [&](unsigned int a, unsigned int b)
+                                 { return body_of(a) < body_of(b); });
+                }
+            }
+
+        permute(h_cell_idx.data + row, size, scratch_uint);
+
+        if (group_bodies)
+            {
+            unsigned int* run_end = h_body_run_end.data + row;
+            for (unsigned int t = 0; t < n_types; t++)
+                {
+                for (unsigned int k = offsets[t + 1]; k > offsets[t]; k--)
+                    {
+                    const unsigned int m = k - 1;
+                    run_end[m] = (k < offsets[t + 1] && body_of(k) == body_of(m)) ? run_end[k] : k;
+                    }
+                }
+            }
+
+        if (m_compute_xyzf)
+            {
+            permute(h_xyzf.data + row, size, scratch_scalar4);
+
+            // pad to the next multiple of cell_padding
+            const unsigned int padded_size
+                = (size + cell_padding - 1) / cell_padding * cell_padding;
+            for (unsigned int k = size; k < padded_size; k++)
+                h_xyzf.data[row + k] = make_scalar4(nan, nan, nan, __int_as_scalar(0xffffffff));
+            }
+        if (m_compute_type_body)
+            permute(h_type_body.data + row, size, scratch_uint2);
+        if (m_compute_orientation)
+            permute(h_cell_orientation.data + row, size, scratch_scalar4);
+        }
     }
 
 bool CellList::checkConditions()
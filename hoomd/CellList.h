@@ -9,6 +9,7 @@
 
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
+#include <vector>
 
 /*! \file CellList.h
     \brief Declares the CellList class
@@ -57,6 +58,11 @@ namespace hoomd
    time when it is not needed.
      - The cell_adj array lists indices of adjacent cells. A specified radius (3,5,7,...) of cells
    is included in the list.
+     - The \c type_offsets array lists where each type starts in each cell. It is only computed when
+   the members are sorted by type (CPU only, see setSortByType()).
+     - The \c body_run_end array lists, for each member, the offset just past the last consecutive
+   member of the same type and body. It is only computed when the members are sorted by type and
+   grouped by body (CPU only, see setGroupBodies()).
 
     A given cell cuboid with x,y,z indices of i,j,k has a unique cell index. This index can be
    obtained from the Index3D object returned by getCellIndexer() \code Index3D cell_indexer =
@@ -74,6 +80,16 @@ namespace hoomd
      - \c tbd, idx, and orientation is structured identically to \c xyzf
      - <code>cell_adj[cell_adj_indexer(offset,cidx)]</code> is the cell index for neighboring cell
    \c offset to \c cidx. \c offset can vary from 0 to (radius*2+1)^3-1 (typically 26 with radius 1)
+     - When sorted by type, the members of type \c t in cell \c cidx are at the offsets
+   <code>type_offsets[type_offset_indexer(t,cidx)]</code> through
+   <code>type_offsets[type_offset_indexer(t+1,cidx)]-1</code>. Nmax is a multiple of
+   \c cell_padding and the \c xyzf entries after the last member up to the next multiple of
+   \c cell_padding hold NaN coordinates, so that vector loops over the padded cells need no
+   remainder handling. Distance checks against NaN coordinates always fail.
+     - When also grouped by body, the members of the same body are consecutive within each type,
+   and a loop over the members of a cell can skip all members of a body at once by continuing at
+   <code>body_run_end[cell_list_indexer(offset,cidx)]</code>.
+     - When a type filter is set, only the particles of the selected types are binned (CPU only).
 
     <b>Parameters:</b>
      - \c width - minimum width of a cell in any x,y,z direction
@@ -180,9 +196,20 @@ class PYBIND11_EXPORT CellList : public Compute
         m_particles_sorted = true;
         }
 
+    //! Notification that particles moved since the last compute
+    /*! The next call to compute() rebuilds the cell list, even on the same timestep. Operations
+        that share a cell list call this after they move particles.
+    */
+    void notifyParticlesMoved()
+        {
+        m_particles_sorted = true;
+        }
+
     //! Notification of a box size change
     void slotBoxChanged()
         {
+        // a pending change is minor only when all changes since the last compute are minor
+        m_box_change_minor = m_pdata->isMinorBoxChange() && (m_box_change_minor || !m_box_changed);
         m_box_changed = true;
         }
 
@@ -208,6 +235,56 @@ class PYBIND11_EXPORT CellList : public Compute
         return m_sort_cell_list;
         }
 
+    //! Set whether the members of each cell are sorted by type on the CPU
+    void setSortByType(bool sort_by_type)
+        {
+        m_sort_by_type = sort_by_type;
+        m_params_changed = true;
+        }
+
+    /// Get whether the members of each cell are sorted by type
+    bool getSortByType() const
+        {
+        return m_sort_by_type;
+        }
+
+    //! Set whether the members of the same body are grouped within each type (CPU)
+    /*! Only takes effect when the members are sorted by type.
+     */
+    void setGroupBodies(bool group_bodies)
+        {
+        if (group_bodies != m_group_bodies)
+            {
+            m_group_bodies = group_bodies;
+            m_params_changed = true;
+            }
+        }
+
+    /// Get whether the members of the same body are grouped
+    bool getGroupBodies() const
+        {
+        return m_group_bodies;
+        }
+
+    //! Set the types of the particles that are binned (CPU)
+    /*! \param types Flag per type, true to bin the particles of the type. An empty vector bins the
+        particles of all types.
+     */
+    void setTypeFilter(const std::vector<bool>& types)
+        {
+        if (types != m_type_filter)
+            {
+            m_type_filter = types;
+            m_params_changed = true;
+            }
+        }
+
+    /// Get the types of the particles that are binned
+    const std::vector<bool>& getTypeFilter() const
+        {
+        return m_type_filter;
+        }
+
     //! Set the flag to compute the cell adjacency list
     void setComputeAdjList(bool compute_adj_list)
         {
@@ -306,6 +383,32 @@ class PYBIND11_EXPORT CellList : public Compute
         return m_cell_adj;
         }
 
+    //! Get the start offset of each type in each cell
+    const GlobalArray<unsigned int>& getTypeOffsetArray() const
+        {
+        if (!m_sort_by_type)
+            {
+            throw std::runtime_error("Cell type offsets not available");
+            }
+        return m_type_offsets;
+        }
+
+    //! Get an indexer to index into the type offsets
+    const Index2D& getTypeOffsetIndexer() const
+        {
+        return m_type_offset_indexer;
+        }
+
+    //! Get the end offset of the run of members in the same body as each member
+    const GlobalArray<unsigned int>& getBodyRunEndArray() const
+        {
+        if (!m_sort_by_type || !m_group_bodies)
+            {
+            throw std::runtime_error("Cell body runs not available");
+            }
+        return m_body_run_end;
+        }
+
     //! Get the cell list containing x,y,z,flag
     const GlobalArray<Scalar4>& getXYZFArray() const
         {
@@ -342,6 +445,12 @@ class PYBIND11_EXPORT CellList : public Compute
 
     // @}
 
+    //! Cells sorted by type are padded to a multiple of this number of entries
+    static constexpr unsigned int cell_padding = 8;
+
+    //! After a minor box change, cells may grow this fraction wider than the nominal width
+    static constexpr Scalar minor_width_tolerance = Scalar(0.1);
+
     /*! \param func Function to call when the cell width changes
         \return Connection to manage the signal/slot connection
         Calls are performed by using nano_signal_slot. The function passed in
@@ -366,8 +475,9 @@ class PYBIND11_EXPORT CellList : public Compute
                              //!< type) otherwise
     bool m_flag_type;        //!< true if the flag should be set to type, it will be index otherwise
     bool m_params_changed;   //!< Set to true when parameters are changed
-    bool m_particles_sorted; //!< Set to true when the particles have been sorted
+    bool m_particles_sorted; //!< Set to true when the particles have been sorted or moved
     bool m_box_changed;      //!< Set to true when the box size has changed
+    bool m_box_change_minor; //!< Set to true when the box change is a small affine deformation
     unsigned int m_multiple; //!< Round cell dimensions down to a multiple of this value
 
     // parameters determined by initialize
@@ -391,6 +501,13 @@ class PYBIND11_EXPORT CellList : public Compute
     bool m_sort_cell_list;   //!< If true, sort cell list
     bool m_compute_adj_list; //!< If true, compute the cell adjacency lists
 
+    bool m_sort_by_type = false;              //!< If true, group the cell members by type (CPU)
+    Index2D m_type_offset_indexer;            //!< Indexes elements in the type offsets
+    GlobalArray<unsigned int> m_type_offsets; //!< Start offset of each type in each cell
+    bool m_group_bodies = false;              //!< If true, group the members of each body (CPU)
+    GlobalArray<unsigned int> m_body_run_end; //!< End offset of the run of each member's body
+    std::vector<bool> m_type_filter;          //!< Types to bin, empty for all types (CPU)
+
 #ifdef ENABLE_MPI
     /// The system's communicator.
     std::shared_ptr<Communicator> m_comm;
@@ -399,11 +516,17 @@ class PYBIND11_EXPORT CellList : public Compute
     //! Computes what the dimensions should me
     uint3 computeDimensions();
 
+    //! Group the members of each cell by type and pad the cells
+    void sortCellsByType();
+
     //! Initialize width and indexers, allocates memory
     void initializeAll();
 
     //! Initialize width
-    void initializeWidth();
+    void initializeWidth(bool keep_dimensions = false);
+
+    //! Test if the current dimensions can be kept after a minor box change
+    bool canKeepDimensions(const uint3& new_dim) const;
 
     //! Initialize indexers and allocate memory
     virtual void initializeMemory();
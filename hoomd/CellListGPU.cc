@@ -54,6 +54,13 @@ void CellListGPU::computeCellList()
     BoxDim box = m_pdata->getBox();
     unsigned int ngpu = m_exec_conf->getNumActiveGPUs();
 
+    // With a single cell list, record the cell and the position in the cell of every particle so
+    // that an overflowing cell list can be filled after growing it, without counting again.
+    const bool single_list = ngpu == 1 && !m_per_device;
+    const unsigned int n_tot = m_pdata->getN() + m_pdata->getNGhosts();
+    ScopedAllocation<uint2> d_bin_slot(m_exec_conf->getCachedAllocator(),
+                                       single_list ? max(n_tot, 1u) : 1);
+
         {
         // access the cell list data arrays
         ArrayHandle<unsigned int> d_cell_size(m_cell_size,
@@ -125,6 +132,7 @@ void CellListGPU::computeCellList()
                                          : d_cell_orientation_scratch.data,
             (ngpu == 1 && !m_per_device) ? d_cell_idx.data : d_cell_idx_scratch.data,
             d_conditions.data,
+            single_list ? d_bin_slot.data : NULL,
             d_pos.data,
             d_orientation.data,
             d_charge.data,
@@ -148,6 +156,51 @@ void CellListGPU::computeCellList()
         m_exec_conf->endMultiGPU();
         }
 
+    if (single_list)
+        {
+        const uint3 conditions = readConditions();
+        if (conditions.x > m_Nmax)
+            {
+            m_exec_conf->msg->notice(10) << "Cell list overflow, growing to " << conditions.x
+                                         << " members per cell" << endl;
+
+            // keep the cell sizes, which do not depend on Nmax
+            m_Nmax = conditions.x;
+            GlobalArray<unsigned int> cell_size;
+            m_cell_size.swap(cell_size);
+            initializeMemory();
+            m_cell_size.swap(cell_size);
+
+            ArrayHandle<Scalar4> d_xyzf(m_xyzf, access_location::device, access_mode::overwrite);
+            ArrayHandle<uint2> d_type_body(m_type_body,
+                                           access_location::device,
+                                           access_mode::overwrite);
+            ArrayHandle<Scalar4> d_cell_orientation(m_orientation,
+                                                    access_location::device,
+                                                    access_mode::overwrite);
+            ArrayHandle<unsigned int> d_cell_idx(m_idx,
+                                                 access_location::device,
+                                                 access_mode::overwrite);
+
+            gpu_scatter_cell_list(d_xyzf.data,
+                                  d_type_body.data,
+                                  d_cell_orientation.data,
+                                  d_cell_idx.data,
+                                  d_bin_slot.data,
+                                  d_pos.data,
+                                  d_orientation.data,
+                                  d_charge.data,
+                                  d_body.data,
+                                  n_tot,
+                                  m_flag_charge,
+                                  m_flag_type,
+                                  m_cell_list_indexer,
+                                  m_tuner->getParam()[0]);
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+        }
+
     if (m_sort_cell_list)
         {
         ArrayHandle<unsigned int> d_cell_size(m_cell_size,
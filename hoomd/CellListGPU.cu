@@ -2,6 +2,7 @@
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
 #include "CellListGPU.cuh"
+#include "WarpTools.cuh"
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
@@ -15,6 +16,21 @@
 
 namespace hoomd
     {
+//! Logical warp size for the aggregation of the cell size increments
+const unsigned int cell_list_warp_size = 32;
+
+//! Marks particles that are not placed in any cell
+const unsigned int cell_list_no_bin = 0xffffffff;
+
+//! Takes the larger of two values
+struct cell_list_max
+    {
+    __device__ unsigned int operator()(unsigned int a, unsigned int b) const
+        {
+        return a > b ? a : b;
+        }
+    };
+
 //! Kernel that computes the cell list on the GPU
 /*! \param d_cell_size Number of particles in each cell
     \param d_xyzf Cell XYZF data array
@@ -22,6 +38,7 @@ namespace hoomd
     \param d_cell_orientation Particle orientation in cell list
     \param d_cell_idx Particle index in cell list
     \param d_conditions Conditions flags for detecting overflow and other error conditions
+    \param d_bin_slot Cell and position in the cell of each particle (may be NULL)
     \param d_pos Particle position array
     \param d_orientation Particle orientation array
     \param d_charge Particle charge array
@@ -37,7 +54,15 @@ namespace hoomd
     \param cli Indexer to index into \a d_xyzf and \a d_type_body
     \param ghost_width Width of ghost layer
 
-    \note Optimized for Fermi
+    Consecutive threads frequently place their particles in the same cell after the particles are
+    sorted. The threads of a warp that find the same cell as their neighbors form a run, and the
+    last thread of each run increments the cell size once for the whole run. The block size must be
+    a multiple of cell_list_warp_size, and the kernel requires 2*blockDim.x unsigned ints of shared
+    memory.
+
+    Members that overflow \a Nmax are not written. Their cell and position in the cell are still
+    recorded in \a d_bin_slot, so that gpu_scatter_cell_list() can fill a reallocated cell list
+    without recounting.
 */
 __global__ void gpu_compute_cell_list_kernel(unsigned int* d_cell_size,
                                              Scalar4* d_xyzf,
@@ -45,6 +70,7 @@ __global__ void gpu_compute_cell_list_kernel(unsigned int* d_cell_size,
                                              Scalar4* d_cell_orientation,
                                              unsigned int* d_cell_idx,
                                              uint3* d_conditions,
+                                             uint2* d_bin_slot,
                                              const Scalar4* d_pos,
                                              const Scalar4* d_orientation,
                                              const Scalar* d_charge,
@@ -62,100 +88,119 @@ __global__ void gpu_compute_cell_list_kernel(unsigned int* d_cell_size,
                                              const unsigned int nwork,
                                              const unsigned int offset)
     {
-    // read in the particle that belongs to this thread
-    unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
-    if (idx >= nwork)
-        return;
+    extern __shared__ unsigned int s_cell_list_data[];
+    unsigned int* s_bin = s_cell_list_data;
+    unsigned int* s_base = s_cell_list_data + blockDim.x;
 
+    // read in the particle that belongs to this thread, all threads take part in the aggregation
+    unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+    const bool active = idx < nwork;
     idx += offset;
 
-    Scalar4 postype = d_pos[idx];
-    Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
-
-    Scalar flag = 0;
-    unsigned int body = 0;
-    Scalar type = postype.w;
-    Scalar4 orientation = make_scalar4(0, 0, 0, 0);
-    if (d_type_body != NULL)
-        {
-        body = d_body[idx];
-        }
-    if (d_cell_orientation != NULL)
-        {
-        orientation = d_orientation[idx];
-        }
-
-    if (flag_charge)
-        flag = d_charge[idx];
-    else if (flag_type)
-        flag = type;
-    else
-        flag = __int_as_scalar(idx);
-
-    // check for nan pos
-    if (isnan(pos.x) || isnan(pos.y) || isnan(pos.z))
+    Scalar4 postype = make_scalar4(0, 0, 0, 0);
+    Scalar3 pos = make_scalar3(0, 0, 0);
+    unsigned int bin = cell_list_no_bin;
+    if (active)
         {
-        (*d_conditions).y = idx + 1;
-        return;
-        }
-
-    uchar3 periodic = box.getPeriodic();
-    Scalar3 f = box.makeFraction(pos, ghost_width);
-
-    // check if the particle is inside the unit cell + ghost layer in all dimensions
-    if ((f.x < Scalar(-0.00001) || f.x >= Scalar(1.00001))
-        || (f.y < Scalar(-0.00001) || f.y >= Scalar(1.00001))
-        || (f.z < Scalar(-0.00001) || f.z >= Scalar(1.00001)))
-        {
-        // if a ghost particle is out of bounds, silently ignore it
-        if (idx < N)
-            (*d_conditions).z = idx + 1;
-        return;
-        }
-
-    // find the bin each particle belongs in
-    int ib = (int)(f.x * ci.getW());
-    int jb = (int)(f.y * ci.getH());
-    int kb = (int)(f.z * ci.getD());
-
-    // need to handle the case where the particle is exactly at the box hi
-    if (ib == ci.getW() && periodic.x)
-        ib = 0;
-    if (jb == ci.getH() && periodic.y)
-        jb = 0;
-    if (kb == ci.getD() && periodic.z)
-        kb = 0;
-
-    unsigned int bin = ci(ib, jb, kb);
-
-    // all particles should be in a valid cell
-    // all particles should be in a valid cell
-    if (ib < 0 || ib >= (int)ci.getW() || jb < 0 || jb >= (int)ci.getH() || kb < 0
-        || kb >= (int)ci.getD())
-        {
-        // but ghost particles that are out of range should not produce an error
-        if (idx < N)
+        postype = d_pos[idx];
+        pos = make_scalar3(postype.x, postype.y, postype.z);
+
+        uchar3 periodic = box.getPeriodic();
+        Scalar3 f = box.makeFraction(pos, ghost_width);
+
+        // find the bin each particle belongs in
+        int ib = (int)(f.x * ci.getW());
+        int jb = (int)(f.y * ci.getH());
+        int kb = (int)(f.z * ci.getD());
+
+        // need to handle the case where the particle is exactly at the box hi
+        if (ib == ci.getW() && periodic.x)
+            ib = 0;
+        if (jb == ci.getH() && periodic.y)
+            jb = 0;
+        if (kb == ci.getD() && periodic.z)
+            kb = 0;
+
+        if (isnan(pos.x) || isnan(pos.y) || isnan(pos.z))
+            {
+            // check for nan pos
+            (*d_conditions).y = idx + 1;
+            }
+        else if ((f.x < Scalar(-0.00001) || f.x >= Scalar(1.00001))
+                 || (f.y < Scalar(-0.00001) || f.y >= Scalar(1.00001))
+                 || (f.z < Scalar(-0.00001) || f.z >= Scalar(1.00001)))
+            {
+            // the particle is outside the unit cell + ghost layer, if a ghost particle is out of
+            // bounds, silently ignore it
+            if (idx < N)
+                (*d_conditions).z = idx + 1;
+            }
+        else if (ib < 0 || ib >= (int)ci.getW() || jb < 0 || jb >= (int)ci.getH() || kb < 0
+                 || kb >= (int)ci.getD())
             {
+            // all particles should be in a valid cell, but ghost particles that are out of range
+            // should not produce an error
+            if (idx < N)
+                {
 #if (__CUDA_ARCH__ >= 600)
-            atomicMax_system(&(*d_conditions).z, idx + 1);
+                atomicMax_system(&(*d_conditions).z, idx + 1);
 #else
-            atomicMax(&(*d_conditions).z, idx + 1);
+                atomicMax(&(*d_conditions).z, idx + 1);
 #endif
+                }
+            }
+        else
+            {
+            bin = ci(ib, jb, kb);
             }
-        return;
         }
 
-    unsigned int size = atomicInc(&d_cell_size[bin], 0xffffffff);
+    // find the first thread of the run of equal cells that this thread belongs to
+    s_bin[threadIdx.x] = bin;
+    __syncthreads();
+
+    const unsigned int lane = threadIdx.x % cell_list_warp_size;
+    const unsigned int warp_begin = threadIdx.x - lane;
+    const bool head = lane == 0 || s_bin[threadIdx.x - 1] != bin;
+    const bool tail = lane == cell_list_warp_size - 1 || s_bin[threadIdx.x + 1] != bin;
+    unsigned int run_begin;
+    detail::WarpScan<unsigned int, cell_list_warp_size>().InclusiveScan(head ? lane : 0,
+                                                                        run_begin,
+                                                                        cell_list_max());
+
+    // the last thread of the run reserves the slots of the whole run
+    if (tail && bin != cell_list_no_bin)
+        s_base[warp_begin + run_begin] = atomicAdd(&d_cell_size[bin], lane - run_begin + 1);
+    __syncthreads();
+
+    if (!active)
+        return;
+
+    unsigned int size = 0;
+    if (bin != cell_list_no_bin)
+        size = s_base[warp_begin + run_begin] + lane - run_begin;
+    if (d_bin_slot != NULL)
+        d_bin_slot[idx] = make_uint2(bin, size);
+    if (bin == cell_list_no_bin)
+        return;
 
     if (size < Nmax)
         {
+        Scalar flag = 0;
+        if (flag_charge)
+            flag = d_charge[idx];
+        else if (flag_type)
+            flag = postype.w;
+        else
+            flag = __int_as_scalar(idx);
+
         unsigned int write_pos = cli(size, bin);
         if (d_xyzf != NULL)
             d_xyzf[write_pos] = make_scalar4(pos.x, pos.y, pos.z, flag);
         if (d_type_body != NULL)
-            d_type_body[write_pos] = make_uint2(__scalar_as_int(type), body);
+            d_type_body[write_pos] = make_uint2(__scalar_as_int(postype.w), d_body[idx]);
         if (d_cell_orientation != NULL)
-            d_cell_orientation[write_pos] = orientation;
+            d_cell_orientation[write_pos] = d_orientation[idx];
         if (d_cell_idx != NULL)
             d_cell_idx[write_pos] = idx;
         }
@@ -176,6 +221,7 @@ void gpu_compute_cell_list(unsigned int* d_cell_size,
                            Scalar4* d_cell_orientation,
                            unsigned int* d_cell_idx,
                            uint3* d_conditions,
+                           uint2* d_bin_slot,
                            const Scalar4* d_pos,
                            const Scalar4* d_orientation,
                            const Scalar* d_charge,
@@ -209,13 +255,16 @@ void gpu_compute_cell_list(unsigned int* d_cell_size,
         if (idev == (int)gpu_partition.getNumActiveGPUs() - 1)
             nwork += n_ghost;
 
+        // the aggregation works on whole warps
         unsigned int run_block_size = min(block_size, max_block_size);
+        run_block_size -= run_block_size % cell_list_warp_size;
         int n_blocks = nwork / run_block_size + 1;
+        const size_t shared_bytes = 2 * run_block_size * sizeof(unsigned int);
 
         hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_compute_cell_list_kernel),
                            dim3(n_blocks),
                            dim3(run_block_size),
-                           0,
+                           shared_bytes,
                            0,
                            d_cell_size + idev * ci.getNumElements(),
                            d_xyzf ? d_xyzf + idev * cli.getNumElements() : 0,
@@ -224,6 +273,7 @@ void gpu_compute_cell_list(unsigned int* d_cell_size,
                                               : 0,
                            d_cell_idx ? d_cell_idx + idev * cli.getNumElements() : 0,
                            d_conditions,
+                           d_bin_slot,
                            d_pos,
                            d_orientation,
                            d_charge,
@@ -243,6 +293,115 @@ void gpu_compute_cell_list(unsigned int* d_cell_size,
         }
     }
 
+//! Kernel that fills the cell list from the cells and positions found by
+//! gpu_compute_cell_list_kernel()
+__global__ void gpu_scatter_cell_list_kernel(Scalar4* d_xyzf,
+                                             uint2* d_type_body,
+                                             Scalar4* d_cell_orientation,
+                                             unsigned int* d_cell_idx,
+                                             const uint2* d_bin_slot,
+                                             const Scalar4* d_pos,
+                                             const Scalar4* d_orientation,
+                                             const Scalar* d_charge,
+                                             const unsigned int* d_body,
+                                             const unsigned int n_tot,
+                                             const bool flag_charge,
+                                             const bool flag_type,
+                                             const Index2D cli)
+    {
+    const unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+    if (idx >= n_tot)
+        return;
+
+    const uint2 bin_slot = d_bin_slot[idx];
+    if (bin_slot.x == cell_list_no_bin)
+        return;
+
+    const Scalar4 postype = d_pos[idx];
+    Scalar flag = 0;
+    if (flag_charge)
+        flag = d_charge[idx];
+    else if (flag_type)
+        flag = postype.w;
+    else
+        flag = __int_as_scalar(idx);
+
+    const unsigned int write_pos = cli(bin_slot.y, bin_slot.x);
+    if (d_xyzf != NULL)
+        d_xyzf[write_pos] = make_scalar4(postype.x, postype.y, postype.z, flag);
+    if (d_type_body != NULL)
+        d_type_body[write_pos] = make_uint2(__scalar_as_int(postype.w), d_body[idx]);
+    if (d_cell_orientation != NULL)
+        d_cell_orientation[write_pos] = d_orientation[idx];
+    if (d_cell_idx != NULL)
+        d_cell_idx[write_pos] = idx;
+    }
+
+/*! \param d_xyzf Cell XYZF data array
+    \param d_type_body Cell TypeBody data array
+    \param d_cell_orientation Particle orientation in cell list
+    \param d_cell_idx Particle index in cell list
+    \param d_bin_slot Cell and position in the cell of each particle from gpu_compute_cell_list()
+    \param d_pos Particle position array
+    \param d_orientation Particle orientation array
+    \param d_charge Particle charge array
+    \param d_body Particle body array
+    \param n_tot Number of local and ghost particles
+    \param flag_charge Set to true to store charge in the flag position in \a d_xyzf
+    \param flag_type Set to true to store type in the flag position in \a d_xyzf
+    \param cli Indexer to index into \a d_xyzf and \a d_type_body
+    \param block_size GPU block size
+
+    The cell list must be large enough to hold the largest cell.
+*/
+hipError_t gpu_scatter_cell_list(Scalar4* d_xyzf,
+                                 uint2* d_type_body,
+                                 Scalar4* d_cell_orientation,
+                                 unsigned int* d_cell_idx,
+                                 const uint2* d_bin_slot,
+                                 const Scalar4* d_pos,
+                                 const Scalar4* d_orientation,
+                                 const Scalar* d_charge,
+                                 const unsigned int* d_body,
+                                 const unsigned int n_tot,
+                                 const bool flag_charge,
+                                 const bool flag_type,
+                                 const Index2D& cli,
+                                 const unsigned int block_size)
+    {
+    if (n_tot == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(&gpu_scatter_cell_list_kernel));
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    int n_blocks = n_tot / run_block_size + 1;
+
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_scatter_cell_list_kernel),
+                       dim3(n_blocks),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_xyzf,
+                       d_type_body,
+                       d_cell_orientation,
+                       d_cell_idx,
+                       d_bin_slot,
+                       d_pos,
+                       d_orientation,
+                       d_charge,
+                       d_body,
+                       n_tot,
+                       flag_charge,
+                       flag_type,
+                       cli);
+
+    return hipSuccess;
+    }
+
 __global__ void gpu_fill_indices_kernel(unsigned int cl_size,
                                         uint2* d_idx,
                                         unsigned int* d_sort_permutation,
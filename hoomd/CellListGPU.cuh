@@ -26,6 +26,7 @@ void gpu_compute_cell_list(unsigned int* d_cell_size,
                            Scalar4* d_cell_orientation,
                            unsigned int* d_cell_idx,
                            uint3* d_conditions,
+                           uint2* d_bin_slot,
                            const Scalar4* d_pos,
                            const Scalar4* d_orientation,
                            const Scalar* d_charge,
@@ -43,6 +44,22 @@ void gpu_compute_cell_list(unsigned int* d_cell_size,
                            const unsigned int block_size,
                            const GPUPartition& gpu_partition);
 
+//! Kernel driver for gpu_scatter_cell_list_kernel()
+hipError_t gpu_scatter_cell_list(Scalar4* d_xyzf,
+                                 uint2* d_type_body,
+                                 Scalar4* d_cell_orientation,
+                                 unsigned int* d_cell_idx,
+                                 const uint2* d_bin_slot,
+                                 const Scalar4* d_pos,
+                                 const Scalar4* d_orientation,
+                                 const Scalar* d_charge,
+                                 const unsigned int* d_body,
+                                 const unsigned int n_tot,
+                                 const bool flag_charge,
+                                 const bool flag_type,
+                                 const Index2D& cli,
+                                 const unsigned int block_size);
+
 //! Driver function to combine the cell lists from different GPUs into one
 hipError_t gpu_combine_cell_lists(const unsigned int* d_cell_size_scratch,
                                   unsigned int* d_cell_size,
@@ -21,6 +21,12 @@ namespace hoomd
     {
 //! Computes a cell list from the particles in the system on the GPU
 /*! Calls GPU functions in CellListGPU.cuh and CellListGPU.cu
+
+    The threads of each warp that place consecutive particles in the same cell increment the cell
+    size with a single atomic operation. With a single cell list, the build also records the cell
+    and the position in the cell of every particle. When a cell overflows, the cell list grows and
+    is filled from the recorded positions instead of repeating the whole build.
+
     \sa CellList
     \ingroup computes
 */
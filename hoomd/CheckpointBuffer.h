@@ -0,0 +1,243 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file CheckpointBuffer.h
+    \brief Declares the CheckpointBuffer class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <stack>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef __CHECKPOINT_BUFFER_H__
+#define __CHECKPOINT_BUFFER_H__
+
+namespace hoomd
+    {
+namespace detail
+    {
+//! Header at the start of a checkpoint file
+/*! The header is followed by n_ranks + 1 uint64_t offsets. Rank r reads the bytes from offset r up
+    to offset r + 1, which hold the CheckpointBuffer written by rank r.
+*/
+struct CheckpointHeader
+    {
+    char magic[8];        //!< Identifies checkpoint files
+    uint32_t version;     //!< Version of the layout
+    uint32_t scalar_size; //!< sizeof(Scalar) of the build that wrote the file
+    uint32_t n_ranks;     //!< Number of ranks that wrote the file
+    uint32_t reserved;    //!< Padding, always 0
+    };
+
+//! Identifies checkpoint files
+const char checkpoint_magic[8] = {'H', 'O', 'O', 'M', 'D', 'C', 'K', 'P'};
+
+//! Version of the checkpoint layout
+const uint32_t checkpoint_version = 1;
+
+//! Binary buffer of one rank's segment of a checkpoint
+/*! CheckpointBuffer stores values and arrays of trivially copyable types as their raw bytes, so
+    that reading them back restores the values bit for bit. Arrays and strings are prefixed by the
+    number of elements. The checkpoint files are only meant to be read by the same build on the
+    same architecture; CheckpointWriter records the size of Scalar to detect mismatched builds.
+
+    Reads advance a position and throw when the buffer ends early.
+*/
+class CheckpointBuffer
+    {
+    public:
+    //! Construct an empty buffer
+    CheckpointBuffer() : m_position(0) { }
+
+    //! Construct a buffer to read from
+    explicit CheckpointBuffer(std::vector<char>&& data) : m_data(std::move(data)), m_position(0) { }
+
+    //! Append a value
+    template<class T> void write(const T& value)
+        {
+        write(&value, 1);
+        }
+
+    //! Append n values
+    template<class T> void write(const T* data, size_t n)
+        {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "Checkpoint values must be trivially copyable");
+        const size_t bytes = sizeof(T) * n;
+        const size_t offset = m_data.size();
+        m_data.resize(offset + bytes);
+        if (bytes > 0)
+            memcpy(m_data.data() + offset, data, bytes);
+        }
+
+    //! Append the number of elements and the elements of an array
+    template<class T> void writeArray(const T* data, size_t n)
+        {
+        write(uint64_t(n));
+        write(data, n);
+        }
+
+    //! Append a vector
+    template<class T> void writeVector(const std::vector<T>& v)
+        {
+        writeArray(v.data(), v.size());
+        }
+
+    //! Append a string
+    void writeString(const std::string& s)
+        {
+        writeArray(s.data(), s.size());
+        }
+
+    //! Append a list of strings
+    void writeStrings(const std::vector<std::string>& strings)
+        {
+        write(uint64_t(strings.size()));
+        for (const std::string& s : strings)
+            writeString(s);
+        }
+
+    //! Append the bookkeeping of a global tag set
+    /*! \param tag_set Tags in use
+        \param recycled_tags Tags of removed particles or groups, waiting for reuse
+        \param n_tags Size of the reverse-lookup table
+
+        Tags in use are usually contiguous, so only the unused tags below \a n_tags are stored.
+    */
+    void writeTags(const std::set<unsigned int>& tag_set,
+                   std::stack<unsigned int> recycled_tags,
+                   size_t n_tags)
+        {
+        std::vector<unsigned int> unused;
+        unsigned int next = 0;
+        for (unsigned int tag : tag_set)
+            {
+            for (; next < tag; next++)
+                unused.push_back(next);
+            next = tag + 1;
+            }
+        for (; next < n_tags; next++)
+            unused.push_back(next);
+
+        std::vector<unsigned int> recycled;
+        while (!recycled_tags.empty())
+            {
+            recycled.push_back(recycled_tags.top());
+            recycled_tags.pop();
+            }
+
+        write(uint64_t(n_tags));
+        writeVector(unused);
+        writeVector(recycled);
+        }
+
+    //! Read a value
+    template<class T> T read()
+        {
+        T value;
+        read(&value, 1);
+        return value;
+        }
+
+    //! Read n values
+    template<class T> void read(T* data, size_t n)
+        {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "Checkpoint values must be trivially copyable");
+        const size_t bytes = sizeof(T) * n;
+        if (bytes > m_data.size() - m_position)
+            {
+            throw std::runtime_error("Checkpoint data ends unexpectedly.");
+            }
+        if (bytes > 0)
+            memcpy(data, m_data.data() + m_position, bytes);
+        m_position += bytes;
+        }
+
+    //! Read a vector
+    template<class T> std::vector<T> readVector()
+        {
+        const uint64_t n = read<uint64_t>();
+        if (n > (m_data.size() - m_position) / sizeof(T))
+            {
+            throw std::runtime_error("Checkpoint data ends unexpectedly.");
+            }
+        std::vector<T> v(n);
+        read(v.data(), n);
+        return v;
+        }
+
+    //! Read a string
+    std::string readString()
+        {
+        std::vector<char> s = readVector<char>();
+        return std::string(s.begin(), s.end());
+        }
+
+    //! Read a list of strings
+    std::vector<std::string> readStrings()
+        {
+        std::vector<std::string> strings(read<uint64_t>());
+        for (std::string& s : strings)
+            s = readString();
+        return strings;
+        }
+
+    //! Read the bookkeeping of a global tag set written by writeTags()
+    /*! \returns The size of the reverse-lookup table
+     */
+    size_t readTags(std::set<unsigned int>& tag_set, std::stack<unsigned int>& recycled_tags)
+        {
+        const size_t n_tags = read<uint64_t>();
+        const std::vector<unsigned int> unused = readVector<unsigned int>();
+        const std::vector<unsigned int> recycled = readVector<unsigned int>();
+
+        tag_set.clear();
+        size_t next_unused = 0;
+        for (unsigned int tag = 0; tag < n_tags; tag++)
+            {
+            if (next_unused < unused.size() && unused[next_unused] == tag)
+                next_unused++;
+            else
+                tag_set.insert(tag_set.end(), tag);
+            }
+
+        while (!recycled_tags.empty())
+            recycled_tags.pop();
+        for (auto it = recycled.rbegin(); it != recycled.rend(); ++it)
+            recycled_tags.push(*it);
+
+        return n_tags;
+        }
+
+    //! Get the contents of the buffer
+    const std::vector<char>& getData() const
+        {
+        return m_data;
+        }
+
+    //! Get the contents of the buffer
+    std::vector<char>& getData()
+        {
+        return m_data;
+        }
+
+    private:
+    std::vector<char> m_data; //!< Contents of the buffer
+    size_t m_position;        //!< Position of the next read
+    };
+
+    } // end namespace detail
+    } // end namespace hoomd
+
+#endif
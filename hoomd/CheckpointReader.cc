@@ -0,0 +1,244 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file CheckpointReader.cc
+    \brief Defines the CheckpointReader class
+*/
+
+#include "CheckpointReader.h"
+#include "SnapshotSystemData.h"
+#include "SystemDefinition.h"
+
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+/*! \param exec_conf The execution configuration
+    \param filename Name of the checkpoint file
+
+    Each rank opens the file and reads its own segment.
+*/
+CheckpointReader::CheckpointReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                                   const std::string& filename)
+    : m_exec_conf(exec_conf), m_filename(filename), m_restored(false)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CheckpointReader: " << filename << endl;
+
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.good())
+        {
+        throw std::runtime_error("Unable to open " + filename);
+        }
+
+    detail::CheckpointHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file.good() || memcmp(header.magic, detail::checkpoint_magic, sizeof(header.magic)) != 0)
+        {
+        throw std::runtime_error(filename + " is not a checkpoint file.");
+        }
+    if (header.version != detail::checkpoint_version)
+        {
+        std::ostringstream s;
+        s << "Unsupported checkpoint version " << header.version << " in " << filename << ".";
+        throw std::runtime_error(s.str());
+        }
+    if (header.scalar_size != sizeof(Scalar))
+        {
+        throw std::runtime_error(filename
+                                 + " was written by a build with a different floating point "
+                                   "precision.");
+        }
+    if (header.n_ranks != m_exec_conf->getNRanks())
+        {
+        std::ostringstream s;
+        s << filename << " was written by " << header.n_ranks << " ranks, it cannot be read by "
+          << m_exec_conf->getNRanks() << " ranks.";
+        throw std::runtime_error(s.str());
+        }
+
+    uint64_t offsets[2];
+    file.seekg(sizeof(header) + sizeof(uint64_t) * m_exec_conf->getRank());
+    file.read(reinterpret_cast<char*>(offsets), sizeof(offsets));
+    if (!file.good() || offsets[1] < offsets[0])
+        {
+        throw std::runtime_error("Invalid checkpoint file " + filename);
+        }
+
+    std::vector<char> data(offsets[1] - offsets[0]);
+    file.seekg(offsets[0]);
+    file.read(data.data(), data.size());
+    if (!file.good())
+        {
+        throw std::runtime_error("Checkpoint file " + filename + " is truncated.");
+        }
+    m_buffer = detail::CheckpointBuffer(std::move(data));
+
+    // the global part of the segment, in the order written by CheckpointWriter::fillBuffers()
+    m_timestep = m_buffer.read<uint64_t>();
+    m_seed = m_buffer.read<uint16_t>();
+    m_dimensions = m_buffer.read<unsigned int>();
+    m_global_box = m_buffer.read<BoxDim>();
+
+    m_decomposed = m_buffer.read<bool>();
+    m_grid = make_uint3(1, 1, 1);
+    m_grid_pos = make_uint3(0, 0, 0);
+    m_staggered = false;
+    if (m_decomposed)
+        {
+        m_grid = m_buffer.read<uint3>();
+        m_grid_pos = m_buffer.read<uint3>();
+        for (unsigned int dir = 0; dir < 3; dir++)
+            {
+            m_cumulative_frac[dir] = m_buffer.readVector<Scalar>();
+            }
+
+        m_staggered = m_buffer.read<bool>();
+        if (m_staggered)
+            {
+            for (unsigned int i = 0; i < m_grid.x; i++)
+                {
+                m_staggered_y.push_back(m_buffer.readVector<Scalar>());
+                }
+            for (unsigned int i = 0; i < m_grid.x * m_grid.y; i++)
+                {
+                m_staggered_z.push_back(m_buffer.readVector<Scalar>());
+                }
+            }
+        }
+
+    m_particle_types = m_buffer.readStrings();
+    m_bond_types = m_buffer.readStrings();
+    m_angle_types = m_buffer.readStrings();
+    m_dihedral_types = m_buffer.readStrings();
+    m_improper_types = m_buffer.readStrings();
+    m_pair_types = m_buffer.readStrings();
+
+    m_operation_state = m_buffer.readString();
+    }
+
+/*! \returns A snapshot with no particles, the box, and the types of the checkpoint
+ */
+std::shared_ptr<SnapshotSystemData<float>> CheckpointReader::getSnapshot() const
+    {
+    auto snapshot = std::make_shared<SnapshotSystemData<float>>();
+    snapshot->dimensions = m_dimensions;
+    snapshot->global_box = std::make_shared<BoxDim>(m_global_box);
+    snapshot->particle_data.type_mapping = m_particle_types;
+    snapshot->bond_data.type_mapping = m_bond_types;
+    snapshot->angle_data.type_mapping = m_angle_types;
+    snapshot->dihedral_data.type_mapping = m_dihedral_types;
+    snapshot->improper_data.type_mapping = m_improper_types;
+    snapshot->pair_data.type_mapping = m_pair_types;
+    return snapshot;
+    }
+
+/*! \returns The number of domains along x, y, and z
+ */
+pybind11::tuple CheckpointReader::getDomainDecomposition() const
+    {
+    return pybind11::make_tuple(m_grid.x, m_grid.y, m_grid.z);
+    }
+
+/*! \param sysdef System definition initialized from getSnapshot()
+
+    Set the cut planes of the domain decomposition and restore the local particles and bonded
+    groups that this rank wrote.
+
+    \note This method must be called collectively on all ranks.
+*/
+void CheckpointReader::restore(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    if (m_restored)
+        {
+        throw std::runtime_error("The checkpoint has already been restored.");
+        }
+    m_restored = true;
+
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+#ifdef ENABLE_MPI
+    std::shared_ptr<DomainDecomposition> decomposition = pdata->getDomainDecomposition();
+    if (bool(decomposition) != m_decomposed)
+        {
+        throw std::runtime_error("The checkpoint was written with a different domain "
+                                 "decomposition.");
+        }
+
+    if (decomposition)
+        {
+        const uint3 grid = decomposition->getGridSize();
+        if (grid.x != m_grid.x || grid.y != m_grid.y || grid.z != m_grid.z)
+            {
+            throw std::runtime_error("The checkpoint was written with a different domain "
+                                     "decomposition.");
+            }
+
+        for (unsigned int dir = 0; dir < 3; dir++)
+            {
+            decomposition->setCumulativeFractions(dir, m_cumulative_frac[dir], 0);
+            }
+        if (m_staggered)
+            {
+            decomposition->setStaggeredFractions(m_staggered_y, m_staggered_z, 0);
+            }
+
+        // the segment of this rank holds the particles of the domain at m_grid_pos
+        const uint3 grid_pos = decomposition->getGridPos();
+        bool same_position = grid_pos.x == m_grid_pos.x && grid_pos.y == m_grid_pos.y
+                             && grid_pos.z == m_grid_pos.z;
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &same_position,
+                      1,
+                      MPI_CXX_BOOL,
+                      MPI_LAND,
+                      m_exec_conf->getMPICommunicator());
+        if (!same_position)
+            {
+            throw std::runtime_error("The ranks are placed in the domain grid differently than "
+                                     "when the checkpoint was written.");
+            }
+
+        // recompute the local box from the restored cut planes
+        pdata->setGlobalBox(m_global_box);
+        }
+#else
+    if (m_decomposed)
+        {
+        throw std::runtime_error("The checkpoint was written with domain decomposition.");
+        }
+#endif
+
+    pdata->readCheckpoint(m_buffer);
+    sysdef->getBondData()->readCheckpoint(m_buffer);
+    sysdef->getAngleData()->readCheckpoint(m_buffer);
+    sysdef->getDihedralData()->readCheckpoint(m_buffer);
+    sysdef->getImproperData()->readCheckpoint(m_buffer);
+    sysdef->getConstraintData()->readCheckpoint(m_buffer);
+    sysdef->getPairData()->readCheckpoint(m_buffer);
+    }
+
+namespace detail
+    {
+void export_CheckpointReader(pybind11::module& m)
+    {
+    pybind11::class_<CheckpointReader, std::shared_ptr<CheckpointReader>>(m, "CheckpointReader")
+        .def(pybind11::init<std::shared_ptr<const ExecutionConfiguration>, const std::string&>())
+        .def("getTimeStep", &CheckpointReader::getTimeStep)
+        .def("getSeed", &CheckpointReader::getSeed)
+        .def("getSnapshot", &CheckpointReader::getSnapshot)
+        .def("getDomainDecomposition", &CheckpointReader::getDomainDecomposition)
+        .def("getOperationState", &CheckpointReader::getOperationState)
+        .def("restore", &CheckpointReader::restore);
+    }
+
+    } // end namespace detail
+
+    } // end namespace hoomd
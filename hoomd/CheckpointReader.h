@@ -0,0 +1,115 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "CheckpointBuffer.h"
+#include "ParticleData.h"
+
+#include <string>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+
+#ifndef __CHECKPOINT_READER_H__
+#define __CHECKPOINT_READER_H__
+
+/*! \file CheckpointReader.h
+    \brief Declares the CheckpointReader class
+*/
+
+namespace hoomd
+    {
+//! Forward declarations
+template<class Real> struct SnapshotSystemData;
+class SystemDefinition;
+
+//! Reads a checkpoint file written by CheckpointWriter
+/*! Every rank reads only its own segment of the file. The constructor parses the global part of
+    the segment: the time step, the seed, the box, the domain decomposition, the type names, and
+    the state of the operations. getSnapshot() provides an empty snapshot with the box and the
+    types to initialize the SystemDefinition with the grid given by getDomainDecomposition(). The
+    caller then calls restore(), which sets the cut planes and restores the local particles and
+    bonded groups of each rank. No data is communicated between the ranks.
+
+    A checkpoint can only be read by the same number of ranks, and each rank must have the same
+    position in the domain grid as the rank that wrote the segment.
+
+    \ingroup data_structs
+*/
+class PYBIND11_EXPORT CheckpointReader
+    {
+    public:
+    //! Read the segment of this rank
+    CheckpointReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                     const std::string& filename);
+
+    //! Get the time step of the checkpoint
+    uint64_t getTimeStep() const
+        {
+        return m_timestep;
+        }
+
+    //! Get the seed of the checkpoint
+    uint16_t getSeed() const
+        {
+        return m_seed;
+        }
+
+    //! Get an empty snapshot with the box and the types of the checkpoint
+    std::shared_ptr<SnapshotSystemData<float>> getSnapshot() const;
+
+    //! Get the number of domains along each direction
+    pybind11::tuple getDomainDecomposition() const;
+
+    //! Get the state of the operations that this rank wrote
+    pybind11::bytes getOperationState() const
+        {
+        return pybind11::bytes(m_operation_state);
+        }
+
+    //! Restore the particles and the bonded groups
+    void restore(std::shared_ptr<SystemDefinition> sysdef);
+
+    private:
+    std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< The execution configuration
+    std::string m_filename;                                    //!< Name of the checkpoint file
+    detail::CheckpointBuffer m_buffer;                         //!< The segment of this rank
+
+    uint64_t m_timestep;       //!< Time step of the checkpoint
+    uint16_t m_seed;           //!< Seed of the checkpoint
+    unsigned int m_dimensions; //!< Dimensionality of the system
+    BoxDim m_global_box;       //!< Global box of the checkpoint
+
+    bool m_decomposed;                              //!< True when written with domain decomposition
+    uint3 m_grid;                                   //!< Number of domains along each direction
+    uint3 m_grid_pos;                               //!< Position of the writing rank in the grid
+    std::vector<Scalar> m_cumulative_frac[3];       //!< Cumulative fractions along each direction
+    bool m_staggered;                               //!< True when the cuts differ between columns
+    std::vector<std::vector<Scalar>> m_staggered_y; //!< Cumulative fractions in y of every slab
+    std::vector<std::vector<Scalar>> m_staggered_z; //!< Cumulative fractions in z of every column
+
+    std::vector<std::string> m_particle_types; //!< Names of the particle types
+    std::vector<std::string> m_bond_types;     //!< Names of the bond types
+    std::vector<std::string> m_angle_types;    //!< Names of the angle types
+    std::vector<std::string> m_dihedral_types; //!< Names of the dihedral types
+    std::vector<std::string> m_improper_types; //!< Names of the improper types
+    std::vector<std::string> m_pair_types;     //!< Names of the special pair types
+
+    std::string m_operation_state; //!< State of the operations
+
+    bool m_restored; //!< True after restore()
+    };
+
+namespace detail
+    {
+//! Exports the CheckpointReader class to python
+void export_CheckpointReader(pybind11::module& m);
+
+    } // end namespace detail
+
+    } // end namespace hoomd
+
+#endif
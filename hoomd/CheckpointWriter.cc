@@ -0,0 +1,343 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file CheckpointWriter.cc
+    \brief Defines the CheckpointWriter class
+*/
+
+#include "CheckpointWriter.h"
+
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace
+    {
+//! Get the names of the types of a bonded group data
+template<class GroupData> std::vector<std::string> getGroupTypes(const GroupData& data)
+    {
+    std::vector<std::string> types;
+    for (unsigned int i = 0; i < data.getNTypes(); i++)
+        {
+        types.push_back(data.getNameByType(i));
+        }
+    return types;
+    }
+    } // end anonymous namespace
+
+/*! \param sysdef System definition
+    \param trigger Steps on which to write
+    \param filename Name of the checkpoint file
+    \param asynchronous True to write the buffers in a background thread
+*/
+CheckpointWriter::CheckpointWriter(std::shared_ptr<SystemDefinition> sysdef,
+                                   std::shared_ptr<Trigger> trigger,
+                                   const std::string& filename,
+                                   bool asynchronous)
+    : Analyzer(sysdef, trigger), m_filename(filename), m_asynchronous(asynchronous), m_offset(0),
+      m_pending(false)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CheckpointWriter: " << filename << endl;
+
+#ifdef BUILD_MPCD
+    if (m_sysdef->getMPCDParticleData()->getNGlobal() != 0)
+        {
+        throw std::runtime_error("Checkpoints do not support MPCD particles.");
+        }
+#endif
+    }
+
+CheckpointWriter::~CheckpointWriter()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying CheckpointWriter" << endl;
+
+    if (m_io_thread.joinable())
+        {
+        m_io_thread.join();
+        }
+
+    // Without other ranks, the pending file is complete and can replace the checkpoint. With
+    // multiple ranks, the other ranks may still be writing, so keep the previous checkpoint.
+    if (m_pending && !m_io_error && m_exec_conf->getNRanks() == 1)
+        {
+        std::rename(getTemporaryFilename().c_str(), m_filename.c_str());
+        }
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void CheckpointWriter::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+    m_exec_conf->msg->notice(10) << "Checkpoint: writing " << m_filename << " at timestep "
+                                 << timestep << endl;
+
+    // the buffers of the previous checkpoint are in use until its write completes
+    flush();
+    fillBuffers(timestep);
+
+    // the root rank creates the file before the other ranks open it
+    bool created = true;
+    if (m_exec_conf->isRoot())
+        {
+        std::ofstream file(getTemporaryFilename(), std::ios::binary | std::ios::trunc);
+        created = file.good();
+        }
+#ifdef ENABLE_MPI
+    bcast(created, 0, m_exec_conf->getMPICommunicator());
+#endif
+    if (!created)
+        {
+        throw std::runtime_error("Unable to create " + getTemporaryFilename());
+        }
+
+    m_pending = true;
+    auto write = [this]()
+    {
+        try
+            {
+            writeBuffers();
+            }
+        catch (...)
+            {
+            m_io_error = std::current_exception();
+            }
+    };
+
+    if (m_asynchronous)
+        {
+        m_io_thread = std::thread(write);
+        }
+    else
+        {
+        write();
+        flush();
+        }
+    }
+
+/*! Wait for the background thread to write the buffers. When all ranks successfully wrote their
+    part, the root rank replaces the checkpoint with the temporary file.
+
+    \note This method must be called collectively on all ranks.
+*/
+void CheckpointWriter::flush()
+    {
+    if (m_io_thread.joinable())
+        {
+        m_io_thread.join();
+        }
+
+    if (!m_pending)
+        {
+        return;
+        }
+    m_pending = false;
+
+    bool failed = bool(m_io_error);
+#ifdef ENABLE_MPI
+    if (m_exec_conf->getNRanks() > 1)
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &failed,
+                      1,
+                      MPI_CXX_BOOL,
+                      MPI_LOR,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    if (m_io_error)
+        {
+        std::exception_ptr error = m_io_error;
+        m_io_error = nullptr;
+        std::rethrow_exception(error);
+        }
+    if (failed)
+        {
+        throw std::runtime_error("Error writing " + m_filename + " on another rank.");
+        }
+
+    bool renamed = true;
+    if (m_exec_conf->isRoot())
+        {
+        renamed = std::rename(getTemporaryFilename().c_str(), m_filename.c_str()) == 0;
+        }
+#ifdef ENABLE_MPI
+    bcast(renamed, 0, m_exec_conf->getMPICommunicator());
+#endif
+    if (!renamed)
+        {
+        throw std::runtime_error("Unable to replace " + m_filename);
+        }
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    The layout of the buffer must match CheckpointReader.
+*/
+void CheckpointWriter::fillBuffers(uint64_t timestep)
+    {
+    m_buffer = detail::CheckpointBuffer();
+    m_buffer.write(timestep);
+    m_buffer.write(m_sysdef->getSeed());
+    m_buffer.write(m_sysdef->getNDimensions());
+    m_buffer.write(m_pdata->getGlobalBox());
+
+    // the domain decomposition and its cut planes
+    bool decomposed = false;
+#ifdef ENABLE_MPI
+    std::shared_ptr<DomainDecomposition> decomposition = m_pdata->getDomainDecomposition();
+    decomposed = bool(decomposition);
+#endif
+    m_buffer.write(decomposed);
+#ifdef ENABLE_MPI
+    if (decomposed)
+        {
+        const uint3 grid = decomposition->getGridSize();
+        m_buffer.write(grid);
+        m_buffer.write(decomposition->getGridPos());
+        for (unsigned int dir = 0; dir < 3; dir++)
+            {
+            m_buffer.writeVector(decomposition->getCumulativeFractions(dir));
+            }
+
+        const bool staggered = decomposition->isStaggered();
+        m_buffer.write(staggered);
+        if (staggered)
+            {
+            for (unsigned int i = 0; i < grid.x; i++)
+                {
+                m_buffer.writeVector(
+                    decomposition->getColumnCumulativeFractions(1, make_uint3(i, 0, 0)));
+                }
+            for (unsigned int j = 0; j < grid.y; j++)
+                {
+                for (unsigned int i = 0; i < grid.x; i++)
+                    {
+                    m_buffer.writeVector(
+                        decomposition->getColumnCumulativeFractions(2, make_uint3(i, j, 0)));
+                    }
+                }
+            }
+        }
+#endif
+
+    m_buffer.writeStrings(m_pdata->getTypeMapping());
+    m_buffer.writeStrings(getGroupTypes(*m_sysdef->getBondData()));
+    m_buffer.writeStrings(getGroupTypes(*m_sysdef->getAngleData()));
+    m_buffer.writeStrings(getGroupTypes(*m_sysdef->getDihedralData()));
+    m_buffer.writeStrings(getGroupTypes(*m_sysdef->getImproperData()));
+    m_buffer.writeStrings(getGroupTypes(*m_sysdef->getPairData()));
+
+    std::string operation_state;
+    if (m_operation_state)
+        {
+        operation_state = pybind11::cast<std::string>(m_operation_state());
+        }
+    m_buffer.writeString(operation_state);
+
+    m_pdata->writeCheckpoint(m_buffer);
+    m_sysdef->getBondData()->writeCheckpoint(m_buffer);
+    m_sysdef->getAngleData()->writeCheckpoint(m_buffer);
+    m_sysdef->getDihedralData()->writeCheckpoint(m_buffer);
+    m_sysdef->getImproperData()->writeCheckpoint(m_buffer);
+    m_sysdef->getConstraintData()->writeCheckpoint(m_buffer);
+    m_sysdef->getPairData()->writeCheckpoint(m_buffer);
+
+    // place the segments of the ranks one after the other, in rank order
+    const unsigned int n_ranks = m_exec_conf->getNRanks();
+    uint64_t size = m_buffer.getData().size();
+    std::vector<uint64_t> sizes(n_ranks, size);
+#ifdef ENABLE_MPI
+    if (n_ranks > 1)
+        {
+        MPI_Allgather(&size,
+                      1,
+                      MPI_UINT64_T,
+                      sizes.data(),
+                      1,
+                      MPI_UINT64_T,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    std::vector<uint64_t> offsets(n_ranks + 1);
+    offsets[0] = sizeof(detail::CheckpointHeader) + sizeof(uint64_t) * (n_ranks + 1);
+    for (unsigned int rank = 0; rank < n_ranks; rank++)
+        {
+        offsets[rank + 1] = offsets[rank] + sizes[rank];
+        }
+    m_offset = offsets[m_exec_conf->getRank()];
+
+    m_header = detail::CheckpointBuffer();
+    if (m_exec_conf->isRoot())
+        {
+        detail::CheckpointHeader header;
+        memcpy(header.magic, detail::checkpoint_magic, sizeof(header.magic));
+        header.version = detail::checkpoint_version;
+        header.scalar_size = sizeof(Scalar);
+        header.n_ranks = n_ranks;
+        header.reserved = 0;
+        m_header.write(header);
+        m_header.write(offsets.data(), offsets.size());
+        }
+    }
+
+/*! Called on the background thread when asynchronous. Do not access the system here.
+ */
+void CheckpointWriter::writeBuffers()
+    {
+    const std::string filename = getTemporaryFilename();
+    std::fstream file(filename, std::ios::in | std::ios::out | std::ios::binary);
+    if (!file.good())
+        {
+        throw std::runtime_error("Unable to open " + filename);
+        }
+
+    const std::vector<char>& header = m_header.getData();
+    if (!header.empty())
+        {
+        file.write(header.data(), header.size());
+        }
+
+    const std::vector<char>& data = m_buffer.getData();
+    file.seekp(m_offset);
+    file.write(data.data(), data.size());
+    file.close();
+
+    if (file.fail())
+        {
+        throw std::runtime_error("Error writing " + filename);
+        }
+    }
+
+namespace detail
+    {
+void export_CheckpointWriter(pybind11::module& m)
+    {
+    pybind11::class_<CheckpointWriter, Analyzer, std::shared_ptr<CheckpointWriter>>(
+        m,
+        "CheckpointWriter")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            const std::string&,
+                            bool>())
+        .def("flush", &CheckpointWriter::flush)
+        .def("setOperationStateCallback", &CheckpointWriter::setOperationStateCallback)
+        .def_property_readonly("filename", &CheckpointWriter::getFilename)
+        .def_property("asynchronous",
+                      &CheckpointWriter::getAsynchronous,
+                      &CheckpointWriter::setAsynchronous);
+    }
+
+    } // end namespace detail
+
+    } // end namespace hoomd
@@ -0,0 +1,121 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "Analyzer.h"
+#include "CheckpointBuffer.h"
+
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*! \file CheckpointWriter.h
+    \brief Declares the CheckpointWriter class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+//! Analyzer for writing checkpoint files
+/*! CheckpointWriter writes the complete local state of every rank to a single binary file each
+    time analyze() is called. Every rank serializes its own part of the system into a
+    CheckpointBuffer: the time step, the seed, the box, the domain decomposition with its current
+    cut planes, the local particles and bonded groups with their tag bookkeeping, and the rank local
+    state of the operations provided by a Python callback. The ranks then write their buffers at
+    disjoint offsets of the file. No data is gathered, and CheckpointReader restores the state bit
+    for bit onto the same rank grid.
+
+    The buffers are written to a temporary file next to the checkpoint. After all ranks complete
+    their part, the temporary file replaces the checkpoint, so that a failed write never destroys
+    the previous checkpoint.
+
+    When asynchronous, analyze() returns after the buffers are filled and a background thread
+    writes them. The next call to analyze() or flush() waits for the write to complete and then
+    replaces the checkpoint.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT CheckpointWriter : public Analyzer
+    {
+    public:
+    //! Construct the writer
+    CheckpointWriter(std::shared_ptr<SystemDefinition> sysdef,
+                     std::shared_ptr<Trigger> trigger,
+                     const std::string& filename,
+                     bool asynchronous);
+
+    //! Destructor
+    virtual ~CheckpointWriter();
+
+    //! Write a checkpoint
+    virtual void analyze(uint64_t timestep);
+
+    //! Wait for a pending write to complete and replace the checkpoint
+    void flush();
+
+    //! Get the name of the checkpoint file
+    const std::string& getFilename() const
+        {
+        return m_filename;
+        }
+
+    //! Determine whether the writes are asynchronous
+    bool getAsynchronous() const
+        {
+        return m_asynchronous;
+        }
+
+    //! Set whether the writes are asynchronous
+    void setAsynchronous(bool asynchronous)
+        {
+        m_asynchronous = asynchronous;
+        }
+
+    //! Set the callback that returns the rank local state of the operations as bytes
+    void setOperationStateCallback(pybind11::object callback)
+        {
+        m_operation_state = callback;
+        }
+
+    protected:
+    std::string m_filename;             //!< Name of the checkpoint file
+    bool m_asynchronous;                //!< True when a background thread writes the buffers
+    pybind11::object m_operation_state; //!< Returns the state of the operations
+
+    detail::CheckpointBuffer m_header; //!< The file header (root rank only)
+    detail::CheckpointBuffer m_buffer; //!< The segment of this rank
+    uint64_t m_offset;                 //!< Offset of the segment of this rank in the file
+    bool m_pending;                    //!< True when a written file awaits replacing the checkpoint
+
+    std::thread m_io_thread;       //!< Thread that writes the buffers
+    std::exception_ptr m_io_error; //!< Exception raised while writing
+
+    //! Get the name of the temporary file
+    std::string getTemporaryFilename() const
+        {
+        return m_filename + ".tmp";
+        }
+
+    //! Fill the header and the buffer of this rank
+    void fillBuffers(uint64_t timestep);
+
+    //! Write the header and the buffer of this rank to the temporary file
+    void writeBuffers();
+    };
+
+namespace detail
+    {
+//! Exports the CheckpointWriter class to python
+void export_CheckpointWriter(pybind11::module& m);
+
+    } // end namespace detail
+
+    } // end namespace hoomd
@@ -8,10 +8,13 @@
 #ifdef ENABLE_MPI
 #include "Communicator.h"
 #include "HOOMDMPI.h"
+#include "ParallelLoop.h"
 #include "System.h"
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <new>
 #include <pybind11/stl.h>
 
 using namespace std;
@@ -44,10 +47,20 @@ void Communicator::GroupCommunicator<group_data>::setGroupData(std::shared_ptr<g
     assert(sizeof(unsigned int) * 8 >= group_data::size);
     }
 
+/*! \param incomplete If true, mark all groups that have non-local members and update local
+           member rank information. Otherwise, mark only groups flagged for communication
+           in particle data
+
+    Removes the ghost groups and stores the rank updates for the neighbors in the send buffer of
+    phase 0.
+ */
 template<class group_data>
-void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
-                                                                bool local_multiple)
+void Communicator::GroupCommunicator<group_data>::packRanks(bool incomplete)
     {
+    m_ranks_sendbuf.clear();
+    m_send_begin[0].assign(m_comm.m_n_unique_neigh, 0);
+    m_send_end[0].assign(m_comm.m_n_unique_neigh, 0);
+
     if (m_gdata->getNGlobal())
         {
         unsigned int group_size = group_data::size;
@@ -221,9 +234,6 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
                 } // end loop over groups
             }     // end ArrayHandle scope
 
-        // clear send buffer
-        m_ranks_sendbuf.clear();
-
             {
             // output send data sorted by rank
             for (typename map_t::iterator it = send_map.begin(); it != send_map.end(); ++it)
@@ -234,135 +244,26 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
             ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors,
                                                          access_location::host,
                                                          access_mode::read);
-            ArrayHandle<unsigned int> h_begin(m_comm.m_begin,
-                                              access_location::host,
-                                              access_mode::overwrite);
-            ArrayHandle<unsigned int> h_end(m_comm.m_end,
-                                            access_location::host,
-                                            access_mode::overwrite);
 
             // Find start and end indices
             for (unsigned int i = 0; i < m_comm.m_n_unique_neigh; ++i)
                 {
                 typename map_t::iterator lower = send_map.lower_bound(h_unique_neighbors.data[i]);
                 typename map_t::iterator upper = send_map.upper_bound(h_unique_neighbors.data[i]);
-                h_begin.data[i] = (unsigned int)std::distance(send_map.begin(), lower);
-                h_end.data[i] = (unsigned int)std::distance(send_map.begin(), upper);
-                }
-            }
-
-        /*
-         * communicate rank information (phase 1)
-         */
-        unsigned int n_send_groups[m_comm.m_n_unique_neigh];
-        unsigned int n_recv_groups[m_comm.m_n_unique_neigh];
-        unsigned int offs[m_comm.m_n_unique_neigh];
-        unsigned int n_recv_tot = 0;
-
-            {
-            ArrayHandle<unsigned int> h_begin(m_comm.m_begin,
-                                              access_location::host,
-                                              access_mode::read);
-            ArrayHandle<unsigned int> h_end(m_comm.m_end, access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
-
-            // compute send counts
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                n_send_groups[ineigh] = h_end.data[ineigh] - h_begin.data[ineigh];
-
-            MPI_Request req[2 * m_comm.m_n_unique_neigh];
-            MPI_Status stat[2 * m_comm.m_n_unique_neigh];
-
-            unsigned int nreq = 0;
-
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                {
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
-                MPI_Isend(&n_send_groups[ineigh],
-                          1,
-                          MPI_UNSIGNED,
-                          neighbor,
-                          0,
-                          m_comm.m_mpi_comm,
-                          &req[nreq++]);
-                MPI_Irecv(&n_recv_groups[ineigh],
-                          1,
-                          MPI_UNSIGNED,
-                          neighbor,
-                          0,
-                          m_comm.m_mpi_comm,
-                          &req[nreq++]);
-                } // end neighbor loop
-
-            MPI_Waitall(nreq, req, stat);
-
-            // sum up receive counts
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                {
-                if (ineigh == 0)
-                    offs[ineigh] = 0;
-                else
-                    offs[ineigh] = offs[ineigh - 1] + n_recv_groups[ineigh - 1];
-
-                n_recv_tot += n_recv_groups[ineigh];
+                m_send_begin[0][i] = (unsigned int)std::distance(send_map.begin(), lower);
+                m_send_end[0][i] = (unsigned int)std::distance(send_map.begin(), upper);
                 }
             }
+        }
+    }
 
-        // Resize receive buffer
-        m_ranks_recvbuf.resize(n_recv_tot);
-
-            {
-            ArrayHandle<unsigned int> h_begin(m_comm.m_begin,
-                                              access_location::host,
-                                              access_mode::read);
-            ArrayHandle<unsigned int> h_end(m_comm.m_end, access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
-
-            std::vector<MPI_Request> reqs;
-            MPI_Request req;
-
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                {
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
-                // exchange particle data
-                if (n_send_groups[ineigh])
-                    {
-                    MPI_Isend(&m_ranks_sendbuf.front() + h_begin.data[ineigh],
-                              int(n_send_groups[ineigh] * sizeof(rank_element_t)),
-                              MPI_BYTE,
-                              neighbor,
-                              1,
-                              m_comm.m_mpi_comm,
-                              &req);
-                    reqs.push_back(req);
-                    }
-
-                if (n_recv_groups[ineigh])
-                    {
-                    MPI_Irecv(&m_ranks_recvbuf.front() + offs[ineigh],
-                              int(n_recv_groups[ineigh] * sizeof(rank_element_t)),
-                              MPI_BYTE,
-                              neighbor,
-                              1,
-                              m_comm.m_mpi_comm,
-                              &req);
-                    reqs.push_back(req);
-                    }
-                }
-
-            std::vector<MPI_Status> stats(reqs.size());
-            MPI_Waitall((unsigned int)reqs.size(), &reqs.front(), &stats.front());
-            }
+//! Apply the received rank updates
+template<class group_data>
+void Communicator::GroupCommunicator<group_data>::unpackRanks()
+    {
+    if (m_gdata->getNGlobal())
+        {
+        unsigned int group_size = group_data::size;
 
             {
             // access receive buffers
@@ -373,7 +274,7 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
                                                    access_location::host,
                                                    access_mode::read);
 
-            for (unsigned int recv_idx = 0; recv_idx < n_recv_tot; ++recv_idx)
+            for (unsigned int recv_idx = 0; recv_idx < m_ranks_recvbuf.size(); ++recv_idx)
                 {
                 rank_element_t el = m_ranks_recvbuf[recv_idx];
                 unsigned int tag = el.tag;
@@ -394,6 +295,24 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
                     }
                 }
             }
+        }
+    }
+
+/*! \param local_multiple If true, a group may be split across several ranks
+
+    Removes the groups that no longer have local members and stores the groups that are sent to
+    the neighbors in the send buffer of phase 1.
+ */
+template<class group_data>
+void Communicator::GroupCommunicator<group_data>::packGroups(bool local_multiple)
+    {
+    m_groups_sendbuf.clear();
+    m_send_begin[1].assign(m_comm.m_n_unique_neigh, 0);
+    m_send_end[1].assign(m_comm.m_n_unique_neigh, 0);
+
+    if (m_gdata->getNGlobal())
+        {
+        unsigned int group_size = group_data::size;
 
         // send map for groups
         typedef std::multimap<unsigned int, group_element_t> group_map_t;
@@ -550,9 +469,6 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
 
         assert(m_gdata->getN() == new_ngroups);
 
-        // reset send buf
-        m_groups_sendbuf.clear();
-
         // output groups to send buffer in rank-sorted order
         for (typename group_map_t::iterator it = group_send_map.begin(); it != group_send_map.end();
              ++it)
@@ -564,12 +480,6 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
             ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors,
                                                          access_location::host,
                                                          access_mode::read);
-            ArrayHandle<unsigned int> h_begin(m_comm.m_begin,
-                                              access_location::host,
-                                              access_mode::overwrite);
-            ArrayHandle<unsigned int> h_end(m_comm.m_end,
-                                            access_location::host,
-                                            access_mode::overwrite);
 
             // Find start and end indices
             for (unsigned int i = 0; i < m_comm.m_n_unique_neigh; ++i)
@@ -578,126 +488,27 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
                     = group_send_map.lower_bound(h_unique_neighbors.data[i]);
                 typename group_map_t::iterator upper
                     = group_send_map.upper_bound(h_unique_neighbors.data[i]);
-                h_begin.data[i] = (unsigned int)std::distance(group_send_map.begin(), lower);
-                h_end.data[i] = (unsigned int)std::distance(group_send_map.begin(), upper);
-                }
-            }
-
-        /*
-         * communicate groups (phase 2)
-         */
-
-        n_recv_tot = 0;
-            {
-            ArrayHandle<unsigned int> h_begin(m_comm.m_begin,
-                                              access_location::host,
-                                              access_mode::read);
-            ArrayHandle<unsigned int> h_end(m_comm.m_end, access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
-
-            // compute send counts
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                n_send_groups[ineigh] = h_end.data[ineigh] - h_begin.data[ineigh];
-
-            MPI_Request req[2 * m_comm.m_n_unique_neigh];
-            MPI_Status stat[2 * m_comm.m_n_unique_neigh];
-
-            unsigned int nreq = 0;
-
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                {
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
-                MPI_Isend(&n_send_groups[ineigh],
-                          1,
-                          MPI_UNSIGNED,
-                          neighbor,
-                          0,
-                          m_comm.m_mpi_comm,
-                          &req[nreq++]);
-                MPI_Irecv(&n_recv_groups[ineigh],
-                          1,
-                          MPI_UNSIGNED,
-                          neighbor,
-                          0,
-                          m_comm.m_mpi_comm,
-                          &req[nreq++]);
-                } // end neighbor loop
-
-            MPI_Waitall(nreq, req, stat);
-
-            // sum up receive counts
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                {
-                if (ineigh == 0)
-                    offs[ineigh] = 0;
-                else
-                    offs[ineigh] = offs[ineigh - 1] + n_recv_groups[ineigh - 1];
-
-                n_recv_tot += n_recv_groups[ineigh];
+                m_send_begin[1][i] = (unsigned int)std::distance(group_send_map.begin(), lower);
+                m_send_end[1][i] = (unsigned int)std::distance(group_send_map.begin(), upper);
                 }
             }
+        }
+    }
 
-        // Resize receive buffer
-        m_groups_recvbuf.resize(n_recv_tot);
-
-            {
-            ArrayHandle<unsigned int> h_begin(m_comm.m_begin,
-                                              access_location::host,
-                                              access_mode::read);
-            ArrayHandle<unsigned int> h_end(m_comm.m_end, access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
-
-            std::vector<MPI_Request> reqs;
-            MPI_Request req;
-
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                {
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
-                // exchange particle data
-                if (n_send_groups[ineigh])
-                    {
-                    MPI_Isend(&m_groups_sendbuf.front() + h_begin.data[ineigh],
-                              int(n_send_groups[ineigh] * sizeof(group_element_t)),
-                              MPI_BYTE,
-                              neighbor,
-                              1,
-                              m_comm.m_mpi_comm,
-                              &req);
-                    reqs.push_back(req);
-                    }
-
-                if (n_recv_groups[ineigh])
-                    {
-                    MPI_Irecv(&m_groups_recvbuf.front() + offs[ineigh],
-                              int(n_recv_groups[ineigh] * sizeof(group_element_t)),
-                              MPI_BYTE,
-                              neighbor,
-                              1,
-                              m_comm.m_mpi_comm,
-                              &req);
-                    reqs.push_back(req);
-                    }
-                }
-
-            std::vector<MPI_Status> stats(reqs.size());
-            MPI_Waitall((unsigned int)reqs.size(), &reqs.front(), &stats.front());
-            }
+/*! \param local_multiple If true, a group may be split across several ranks
+ */
+template<class group_data>
+void Communicator::GroupCommunicator<group_data>::unpackGroups(bool local_multiple)
+    {
+    if (m_gdata->getNGlobal())
+        {
+        unsigned int group_size = group_data::size;
 
         // use a std::map, i.e. single-key, to filter out duplicate groups in input buffer
         typedef std::map<unsigned int, group_element_t> recv_map_t;
         recv_map_t recv_map;
 
-        for (unsigned int recv_idx = 0; recv_idx < n_recv_tot; recv_idx++)
+        for (unsigned int recv_idx = 0; recv_idx < m_groups_recvbuf.size(); recv_idx++)
             {
             group_element_t el = m_groups_recvbuf[recv_idx];
             unsigned int tag = el.group_tag;
@@ -1189,7 +1000,13 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
       m_tag_reverse(m_exec_conf), m_netforce_reverse_copybuf(m_exec_conf),
       m_netforce_reverse_recvbuf(m_exec_conf), m_r_ghost_max(Scalar(0.0)), m_ghosts_added(0),
       m_has_ghost_particles(false), m_last_flags(0), m_comm_pending(false),
-      m_bond_comm(*this, m_sysdef->getBondData()), m_angle_comm(*this, m_sysdef->getAngleData()),
+      m_persistent_ghost_updates(false), m_persistent_reqs_valid(false), m_persistent_flags(0),
+      m_shm_ghost_updates(false), m_node_comm(MPI_COMM_NULL), m_shm_win(MPI_WIN_NULL),
+      m_shm_header(nullptr), m_shm_seq(0), m_ghost_position_bits(0), m_ghost_ref_valid(false),
+      m_skip_unchanged_ghost_fields(false), m_overlap_ghost_updates(true), m_update_flags(0),
+      m_ghost_write_count {0, 0}, m_ghost_field_valid {false, false},
+      m_migration_margin(Scalar(0.0)), m_bond_comm(*this, m_sysdef->getBondData()),
+      m_angle_comm(*this, m_sysdef->getAngleData()),
       m_dihedral_comm(*this, m_sysdef->getDihedralData()),
       m_improper_comm(*this, m_sysdef->getImproperData()),
       m_constraint_comm(*this, m_sysdef->getConstraintData()),
@@ -1213,6 +1030,15 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
         m_copy_ghosts[dir].swap(copy_ghosts);
         m_num_copy_ghosts[dir] = 0;
         m_num_recv_ghosts[dir] = 0;
+        m_num_copy_ghosts_local[dir] = 0;
+        m_num_recv_ghosts_local[dir] = 0;
+        m_persistent_send_offset[dir] = 0;
+        m_persistent_recv_offset[dir] = 0;
+        m_shm_send_header[dir] = nullptr;
+        m_shm_recv_header[dir] = nullptr;
+        m_persistent_req_offset[dir][0] = 0;
+        m_persistent_req_offset[dir][1] = 0;
+        m_persistent_req_offset[dir][2] = 0;
         }
 
     // All buffers corresponding to sending ghosts in reverse
@@ -1344,6 +1170,12 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
 Communicator::~Communicator()
     {
     m_exec_conf->msg->notice(5) << "Destroying Communicator" << std::endl;
+    finishUpdateGhostsOverlapped();
+    freePersistentGhostUpdate();
+    freeSharedGhostWindow();
+    if (m_node_comm != MPI_COMM_NULL)
+        MPI_Comm_free(&m_node_comm);
+
     m_pdata->getParticleSortSignal().disconnect<Communicator, &Communicator::forceMigrate>(this);
     m_pdata->getGhostParticlesRemovedSignal()
         .disconnect<Communicator, &Communicator::slotGhostParticlesRemoved>(this);
@@ -1506,9 +1338,25 @@ void Communicator::initializeNeighborArrays()
         }
     }
 
-//! Interface to the communication methods.
-void Communicator::communicate(uint64_t timestep)
+/*! \param timestep The time step
+    \param defer_ghost_update Set to true to allow the ghost update to complete later
+
+    When \a defer_ghost_update is true and the ghost positions are updated without a migration,
+    communicate() may return with the ghost update pending. The caller must then ensure that
+    finishUpdateGhosts() is called before ghost particle data is read.
+*/
+void Communicator::communicate(uint64_t timestep, bool defer_ghost_update)
     {
+    // the staged exchanges send to a single face neighbor in every direction
+    if (m_decomposition->isStaggered())
+        {
+        throw std::runtime_error(
+            "The communicator does not yet support staggered domain decompositions.");
+        }
+
+    // complete a ghost update left pending by a previous call
+    finishUpdateGhosts(timestep);
+
     // Guard to prevent recursive triggering of migration
     m_is_communicating = true;
 
@@ -1516,11 +1364,16 @@ void Communicator::communicate(uint64_t timestep)
     m_flags = CommFlags(0);
     m_requested_flags.emit_accumulate([&](CommFlags f) { m_flags |= f; }, timestep);
 
+    std::shared_ptr<Profiler> profiler = m_sysdef->getProfiler();
+
     if (!m_force_migrate && !m_compute_callbacks.empty() && m_has_ghost_particles)
         {
         // do an obligatory update before determining whether to migrate
-        beginUpdateGhosts(timestep);
-        finishUpdateGhosts(timestep);
+            {
+            ScopedProfile profile(profiler, "Communicator::updateGhosts", "communication");
+            beginUpdateGhosts(timestep);
+            finishUpdateGhosts(timestep);
+            }
 
         // call subscribers after ghost update, but before distance check
         m_compute_callbacks.emit(timestep);
@@ -1538,14 +1391,30 @@ void Communicator::communicate(uint64_t timestep)
                                            timestep);
         }
 
+    if (migrate_request && !m_force_migrate && m_has_ghost_particles && canDeferMigration())
+        {
+        // the extended ghost layer still covers all particles within the requested widths
+        m_exec_conf->msg->notice(7) << "Communicator: defer migration" << std::endl;
+        migrate_request = false;
+        }
+
     bool migrate = migrate_request || m_force_migrate || !m_has_ghost_particles;
 
     // Update ghosts if we are not migrating
     if (!migrate && m_compute_callbacks.empty())
         {
-        beginUpdateGhosts(timestep);
+        ScopedProfile profile(profiler, "Communicator::updateGhosts", "communication");
+        if (defer_ghost_update && m_overlap_ghost_updates && !m_exec_conf->isCUDAEnabled())
+            {
+            // overlap the messages with the computation of the caller
+            beginUpdateGhostsOverlapped(timestep);
+            }
+        else
+            {
+            beginUpdateGhosts(timestep);
 
-        finishUpdateGhosts(timestep);
+            finishUpdateGhosts(timestep);
+            }
         }
 
     // Check if migration of particles is requested
@@ -1554,15 +1423,36 @@ void Communicator::communicate(uint64_t timestep)
         m_force_migrate = false;
 
         // If so, migrate atoms
-        migrateParticles();
+            {
+            ScopedProfile profile(profiler, "Communicator::migrateParticles", "communication");
+            migrateParticles();
+            }
 
         // Construct ghost send lists, exchange ghost atom data
-        exchangeGhosts();
+            {
+            ScopedProfile profile(profiler, "Communicator::exchangeGhosts", "communication");
+            exchangeGhosts();
+            }
+
+        // release the memory left over from a larger number of local or ghost particles
+        const Scalar shrink_fraction = m_pdata->getShrinkFraction();
+        if (shrink_fraction > Scalar(0.0))
+            {
+            m_pdata->shrink();
+            m_sysdef->getBondData()->shrink(shrink_fraction);
+            m_sysdef->getAngleData()->shrink(shrink_fraction);
+            m_sysdef->getDihedralData()->shrink(shrink_fraction);
+            m_sysdef->getImproperData()->shrink(shrink_fraction);
+            m_sysdef->getConstraintData()->shrink(shrink_fraction);
+            m_sysdef->getPairData()->shrink(shrink_fraction);
+            shrinkBuffers(shrink_fraction);
+            }
 
         // update particle data now that ghosts are available
         m_compute_callbacks.emit(timestep);
 
         m_has_ghost_particles = true;
+        setMigrationReference();
         }
 
     m_is_communicating = false;
@@ -1573,6 +1463,9 @@ void Communicator::migrateParticles()
     {
     m_exec_conf->msg->notice(7) << "Communicator: migrate particles" << std::endl;
 
+    // the pending messages write to the ghost particles that are about to be removed
+    finishUpdateGhostsOverlapped();
+
     updateGhostWidth();
 
     // check if simulation box is sufficiently large for domain decomposition
@@ -1631,40 +1524,7 @@ void Communicator::migrateParticles()
         /*
          * Bonded group communication, determine groups to be sent
          */
-        // Bonds
-        m_bond_comm.migrateGroups(m_bonds_changed, true);
-        m_bonds_changed = false;
-
-        // Special pairs
-        m_pair_comm.migrateGroups(m_pairs_changed, true);
-        m_pairs_changed = false;
-
-        // Angles
-        m_angle_comm.migrateGroups(m_angles_changed, true);
-        m_angles_changed = false;
-
-        // Dihedrals
-        m_dihedral_comm.migrateGroups(m_dihedrals_changed, true);
-        m_dihedrals_changed = false;
-
-        // Dihedrals
-        m_improper_comm.migrateGroups(m_impropers_changed, true);
-        m_impropers_changed = false;
-
-        // Constraints
-        m_constraint_comm.migrateGroups(m_constraints_changed, true);
-        m_constraints_changed = false;
-
-        if (m_meshdef)
-            {
-            // Meshbonds
-            m_meshbond_comm.migrateGroups(m_meshbonds_changed, true);
-            m_meshbonds_changed = false;
-
-            // Meshtriangles
-            m_meshtriangle_comm.migrateGroups(m_meshtriangles_changed, true);
-            m_meshtriangles_changed = false;
-            }
+        migrateGroups();
 
         // fill send buffer
         std::vector<unsigned int> comm_flag_out; // not currently used
@@ -1729,90 +1589,356 @@ void Communicator::migrateParticles()
         } // end dir loop
     }
 
-void Communicator::updateGhostWidth()
+/*! The groups of all types migrate in two phases, first the member rank updates and then the
+    groups themselves. Every phase sends a single message per neighbor that aggregates the elements
+    of all group types.
+ */
+void Communicator::migrateGroups()
     {
+    std::vector<GroupMigrationBuffers*> buffers = {&m_bond_comm,
+                                                   &m_pair_comm,
+                                                   &m_angle_comm,
+                                                   &m_dihedral_comm,
+                                                   &m_improper_comm,
+                                                   &m_constraint_comm};
+    if (m_meshdef)
         {
-        // reset values (this may not be needed in most cases, but it doesn't harm to be safe
-        ArrayHandle<Scalar> h_r_ghost(m_r_ghost, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar> h_r_ghost_body(m_r_ghost_body,
-                                           access_location::host,
-                                           access_mode::overwrite);
-        for (unsigned int cur_type = 0; cur_type < m_pdata->getNTypes(); ++cur_type)
-            {
-            h_r_ghost.data[cur_type] = Scalar(0.0);
-            h_r_ghost_body.data[cur_type] = Scalar(0.0);
-            }
+        buffers.push_back(&m_meshbond_comm);
+        buffers.push_back(&m_meshtriangle_comm);
         }
 
-    ArrayHandle<Scalar> h_r_ghost(m_r_ghost, access_location::host, access_mode::readwrite);
-    if (!m_ghost_layer_width_requests.empty())
+    // phase 0: member rank updates
+    m_bond_comm.packRanks(m_bonds_changed);
+    m_pair_comm.packRanks(m_pairs_changed);
+    m_angle_comm.packRanks(m_angles_changed);
+    m_dihedral_comm.packRanks(m_dihedrals_changed);
+    m_improper_comm.packRanks(m_impropers_changed);
+    m_constraint_comm.packRanks(m_constraints_changed);
+    if (m_meshdef)
         {
-        // update the ghost layer width only if subscribers are available
+        m_meshbond_comm.packRanks(m_meshbonds_changed);
+        m_meshtriangle_comm.packRanks(m_meshtriangles_changed);
+        }
 
-        // reduce per type using the signals, and then overall
-        Scalar r_ghost_max = 0.0;
-        for (unsigned int cur_type = 0; cur_type < m_pdata->getNTypes(); ++cur_type)
-            {
-            Scalar r_ghost_i = 0.0;
-            m_ghost_layer_width_requests.emit_accumulate(
-                [&](Scalar r)
-                {
-                    if (r > r_ghost_i)
-                        r_ghost_i = r;
-                },
-                cur_type);
-            h_r_ghost.data[cur_type] = r_ghost_i;
-            if (r_ghost_i > r_ghost_max)
-                r_ghost_max = r_ghost_i;
-            }
-        m_r_ghost_max = r_ghost_max;
+    exchangeGroupMessages(buffers, 0);
+
+    m_bond_comm.unpackRanks();
+    m_pair_comm.unpackRanks();
+    m_angle_comm.unpackRanks();
+    m_dihedral_comm.unpackRanks();
+    m_improper_comm.unpackRanks();
+    m_constraint_comm.unpackRanks();
+    if (m_meshdef)
+        {
+        m_meshbond_comm.unpackRanks();
+        m_meshtriangle_comm.unpackRanks();
         }
-    if (!m_body_ghost_layer_width_requests.empty())
+
+    // phase 1: groups
+    m_bond_comm.packGroups(true);
+    m_pair_comm.packGroups(true);
+    m_angle_comm.packGroups(true);
+    m_dihedral_comm.packGroups(true);
+    m_improper_comm.packGroups(true);
+    m_constraint_comm.packGroups(true);
+    if (m_meshdef)
         {
-        // update the ghost layer width only if subscribers are available
-        ArrayHandle<Scalar> h_r_ghost_body(m_r_ghost_body,
-                                           access_location::host,
-                                           access_mode::readwrite);
+        m_meshbond_comm.packGroups(true);
+        m_meshtriangle_comm.packGroups(true);
+        }
 
-        for (unsigned int cur_type = 0; cur_type < m_pdata->getNTypes(); ++cur_type)
-            {
-            Scalar r_body_ghost_i = 0.0;
-            m_body_ghost_layer_width_requests.emit_accumulate(
-                [&](Scalar r)
-                {
-                    if (r > r_body_ghost_i)
-                        r_body_ghost_i = r;
-                },
-                cur_type,
-                h_r_ghost.data);
+    exchangeGroupMessages(buffers, 1);
 
-            h_r_ghost_body.data[cur_type] = r_body_ghost_i;
-            }
+    m_bond_comm.unpackGroups(true);
+    m_pair_comm.unpackGroups(true);
+    m_angle_comm.unpackGroups(true);
+    m_dihedral_comm.unpackGroups(true);
+    m_improper_comm.unpackGroups(true);
+    m_constraint_comm.unpackGroups(true);
+    if (m_meshdef)
+        {
+        m_meshbond_comm.unpackGroups(true);
+        m_meshtriangle_comm.unpackGroups(true);
+        }
+
+    m_bonds_changed = false;
+    m_pairs_changed = false;
+    m_angles_changed = false;
+    m_dihedrals_changed = false;
+    m_impropers_changed = false;
+    m_constraints_changed = false;
+    if (m_meshdef)
+        {
+        m_meshbonds_changed = false;
+        m_meshtriangles_changed = false;
         }
     }
 
-//! Build ghost particle list, exchange ghost particle data
-void Communicator::exchangeGhosts()
-    {
-    // check if simulation box is sufficiently large for domain decomposition
-    checkBoxSize();
+/*! \param buffers The group communicators of the group types to exchange
+    \param phase 0 to exchange the member rank updates, 1 to exchange the groups
 
-    m_exec_conf->msg->notice(7) << "Communicator: exchange ghosts" << std::endl;
+    The message to every neighbor holds the elements of each group type in the order of \a
+    buffers, preceded by a message with the number of elements of every type. The elements that
+    each group type receives are ordered by neighbor, as if every type had exchanged its own
+    messages.
+ */
+void Communicator::exchangeGroupMessages(const std::vector<GroupMigrationBuffers*>& buffers,
+                                         unsigned int phase)
+    {
+    const unsigned int n_types = (unsigned int)buffers.size();
+    const unsigned int n_neigh = m_n_unique_neigh;
 
-    const BoxDim& box = m_pdata->getBox();
+    std::vector<size_t> element_size(n_types);
+    for (unsigned int t = 0; t < n_types; t++)
+        element_size[t] = buffers[t]->getElementSize(phase);
 
-    // Sending ghosts proceeds in two stages:
-    // Stage 1: mark ghost atoms for sending (for covalently bonded particles, and non-bonded
-    // interactions)
-    //          construct plans (= itineraries for ghost particles)
-    // Stage 2: fill send buffers, exchange ghosts according to plans (sending the plan along with
-    // the particle)
+    std::vector<unsigned int> n_send(n_neigh * n_types);
+    std::vector<unsigned int> n_recv(n_neigh * n_types);
+    for (unsigned int ineigh = 0; ineigh < n_neigh; ineigh++)
+        for (unsigned int t = 0; t < n_types; t++)
+            n_send[ineigh * n_types + t] = buffers[t]->getNumSend(phase, ineigh);
 
-    // resize and reset plans
-    m_plan.resize(m_pdata->getN());
+    ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
+                                                 access_location::host,
+                                                 access_mode::read);
 
+    // communicate the number of elements of all group types in one message per neighbor
+    std::vector<MPI_Request> reqs;
+    MPI_Request req;
+    for (unsigned int ineigh = 0; ineigh < n_neigh; ineigh++)
         {
-        ArrayHandle<unsigned int> h_plan(m_plan, access_location::host, access_mode::readwrite);
+        unsigned int neighbor = h_unique_neighbors.data[ineigh];
+        MPI_Isend(&n_send[ineigh * n_types],
+                  n_types,
+                  MPI_UNSIGNED,
+                  neighbor,
+                  0,
+                  m_mpi_comm,
+                  &req);
+        reqs.push_back(req);
+        MPI_Irecv(&n_recv[ineigh * n_types],
+                  n_types,
+                  MPI_UNSIGNED,
+                  neighbor,
+                  0,
+                  m_mpi_comm,
+                  &req);
+        reqs.push_back(req);
+        }
+    if (reqs.size())
+        MPI_Waitall((unsigned int)reqs.size(), &reqs.front(), MPI_STATUSES_IGNORE);
+
+    // byte offsets of the messages of every neighbor
+    std::vector<size_t> send_offset(n_neigh + 1, 0);
+    std::vector<size_t> recv_offset(n_neigh + 1, 0);
+    for (unsigned int ineigh = 0; ineigh < n_neigh; ineigh++)
+        {
+        send_offset[ineigh + 1] = send_offset[ineigh];
+        recv_offset[ineigh + 1] = recv_offset[ineigh];
+        for (unsigned int t = 0; t < n_types; t++)
+            {
+            send_offset[ineigh + 1] += n_send[ineigh * n_types + t] * element_size[t];
+            recv_offset[ineigh + 1] += n_recv[ineigh * n_types + t] * element_size[t];
+            }
+        }
+
+    // pack the elements of all group types
+    m_group_msg_sendbuf.resize(send_offset[n_neigh]);
+    m_group_msg_recvbuf.resize(recv_offset[n_neigh]);
+    for (unsigned int ineigh = 0; ineigh < n_neigh; ineigh++)
+        {
+        size_t offset = send_offset[ineigh];
+        for (unsigned int t = 0; t < n_types; t++)
+            {
+            size_t n_bytes = n_send[ineigh * n_types + t] * element_size[t];
+            if (n_bytes)
+                {
+                const char* src = buffers[t]->getSendBuffer(phase)
+                                  + buffers[t]->getSendBegin(phase, ineigh) * element_size[t];
+                memcpy(&m_group_msg_sendbuf[offset], src, n_bytes);
+                }
+            offset += n_bytes;
+            }
+        }
+
+    // exchange the aggregated messages
+    reqs.clear();
+    for (unsigned int ineigh = 0; ineigh < n_neigh; ineigh++)
+        {
+        unsigned int neighbor = h_unique_neighbors.data[ineigh];
+        size_t n_send_bytes = send_offset[ineigh + 1] - send_offset[ineigh];
+        size_t n_recv_bytes = recv_offset[ineigh + 1] - recv_offset[ineigh];
+
+        if (n_send_bytes)
+            {
+            MPI_Isend(&m_group_msg_sendbuf[send_offset[ineigh]],
+                      int(n_send_bytes),
+                      MPI_BYTE,
+                      neighbor,
+                      1,
+                      m_mpi_comm,
+                      &req);
+            reqs.push_back(req);
+            }
+
+        if (n_recv_bytes)
+            {
+            MPI_Irecv(&m_group_msg_recvbuf[recv_offset[ineigh]],
+                      int(n_recv_bytes),
+                      MPI_BYTE,
+                      neighbor,
+                      1,
+                      m_mpi_comm,
+                      &req);
+            reqs.push_back(req);
+            }
+        }
+    if (reqs.size())
+        MPI_Waitall((unsigned int)reqs.size(), &reqs.front(), MPI_STATUSES_IGNORE);
+
+    // unpack the received elements into the receive buffers of the group types
+    for (unsigned int t = 0; t < n_types; t++)
+        {
+        size_t n_recv_tot = 0;
+        for (unsigned int ineigh = 0; ineigh < n_neigh; ineigh++)
+            n_recv_tot += n_recv[ineigh * n_types + t];
+
+        char* dst = buffers[t]->resizeRecvBuffer(phase, n_recv_tot);
+
+        for (unsigned int ineigh = 0; ineigh < n_neigh; ineigh++)
+            {
+            size_t offset = recv_offset[ineigh];
+            for (unsigned int u = 0; u < t; u++)
+                offset += n_recv[ineigh * n_types + u] * element_size[u];
+
+            size_t n_bytes = n_recv[ineigh * n_types + t] * element_size[t];
+            if (n_bytes)
+                {
+                memcpy(dst, &m_group_msg_recvbuf[offset], n_bytes);
+                dst += n_bytes;
+                }
+            }
+        }
+    }
+
+/*! \param shrink_fraction Fraction of the allocated size below which the buffers shrink
+
+    The buffers keep their contents, so that ghost updates can use them until the next ghost
+    exchange.
+*/
+void Communicator::shrinkBuffers(Scalar shrink_fraction)
+    {
+    m_pos_copybuf.shrink(shrink_fraction);
+    m_charge_copybuf.shrink(shrink_fraction);
+    m_diameter_copybuf.shrink(shrink_fraction);
+    m_body_copybuf.shrink(shrink_fraction);
+    m_image_copybuf.shrink(shrink_fraction);
+    m_velocity_copybuf.shrink(shrink_fraction);
+    m_orientation_copybuf.shrink(shrink_fraction);
+    m_plan_copybuf.shrink(shrink_fraction);
+    m_tag_copybuf.shrink(shrink_fraction);
+    m_netforce_copybuf.shrink(shrink_fraction);
+    m_nettorque_copybuf.shrink(shrink_fraction);
+    m_netvirial_copybuf.shrink(shrink_fraction);
+    m_netvirial_recvbuf.shrink(shrink_fraction);
+    m_plan.shrink(shrink_fraction);
+
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        m_copy_ghosts[dir].shrink(shrink_fraction);
+        }
+    }
+
+void Communicator::updateGhostWidth()
+    {
+        {
+        // reset values (this may not be needed in most cases, but it doesn't harm to be safe
+        ArrayHandle<Scalar> h_r_ghost(m_r_ghost, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_r_ghost_body(m_r_ghost_body,
+                                           access_location::host,
+                                           access_mode::overwrite);
+        for (unsigned int cur_type = 0; cur_type < m_pdata->getNTypes(); ++cur_type)
+            {
+            h_r_ghost.data[cur_type] = Scalar(0.0);
+            h_r_ghost_body.data[cur_type] = Scalar(0.0);
+            }
+        }
+
+    ArrayHandle<Scalar> h_r_ghost(m_r_ghost, access_location::host, access_mode::readwrite);
+    if (!m_ghost_layer_width_requests.empty())
+        {
+        // update the ghost layer width only if subscribers are available
+
+        // reduce per type using the signals, and then overall
+        Scalar r_ghost_max = 0.0;
+        for (unsigned int cur_type = 0; cur_type < m_pdata->getNTypes(); ++cur_type)
+            {
+            Scalar r_ghost_i = 0.0;
+            m_ghost_layer_width_requests.emit_accumulate(
+                [&](Scalar r)
+                {
+                    if (r > r_ghost_i)
+                        r_ghost_i = r;
+                },
+                cur_type);
+            // extend the ghost layer so that the particles may move before they migrate
+            if (r_ghost_i > Scalar(0.0))
+                r_ghost_i += m_migration_margin;
+            h_r_ghost.data[cur_type] = r_ghost_i;
+            if (r_ghost_i > r_ghost_max)
+                r_ghost_max = r_ghost_i;
+            }
+        m_r_ghost_max = r_ghost_max;
+        }
+    if (!m_body_ghost_layer_width_requests.empty())
+        {
+        // update the ghost layer width only if subscribers are available
+        ArrayHandle<Scalar> h_r_ghost_body(m_r_ghost_body,
+                                           access_location::host,
+                                           access_mode::readwrite);
+
+        for (unsigned int cur_type = 0; cur_type < m_pdata->getNTypes(); ++cur_type)
+            {
+            Scalar r_body_ghost_i = 0.0;
+            m_body_ghost_layer_width_requests.emit_accumulate(
+                [&](Scalar r)
+                {
+                    if (r > r_body_ghost_i)
+                        r_body_ghost_i = r;
+                },
+                cur_type,
+                h_r_ghost.data);
+
+            h_r_ghost_body.data[cur_type] = r_body_ghost_i;
+            }
+        }
+    }
+
+//! Build ghost particle list, exchange ghost particle data
+void Communicator::exchangeGhosts()
+    {
+    // check if simulation box is sufficiently large for domain decomposition
+    checkBoxSize();
+
+    m_exec_conf->msg->notice(7) << "Communicator: exchange ghosts" << std::endl;
+
+    // the number of ghosts changes, the persistent requests are recreated on the next update
+    m_persistent_reqs_valid = false;
+
+    const BoxDim& box = m_pdata->getBox();
+
+    // Sending ghosts proceeds in two stages:
+    // Stage 1: mark ghost atoms for sending (for covalently bonded particles, and non-bonded
+    // interactions)
+    //          construct plans (= itineraries for ghost particles)
+    // Stage 2: fill send buffers, exchange ghosts according to plans (sending the plan along with
+    // the particle)
+
+    // resize and reset plans
+    m_plan.resize(m_pdata->getN());
+
+        {
+        ArrayHandle<unsigned int> h_plan(m_plan, access_location::host, access_mode::readwrite);
 
         for (unsigned int i = 0; i < m_pdata->getN(); ++i)
             h_plan.data[i] = 0;
@@ -1922,6 +2048,7 @@ void Communicator::exchangeGhosts()
             continue;
 
         m_num_copy_ghosts[dir] = 0;
+        m_num_copy_ghosts_local[dir] = 0;
 
         // resize array of ghost particle tags
         unsigned int max_copy_ghosts = m_pdata->getN() + m_pdata->getNGhosts();
@@ -2033,6 +2160,10 @@ void Communicator::exchangeGhosts()
 
                     h_copy_ghosts.data[m_num_copy_ghosts[dir]] = h_tag.data[idx];
                     m_num_copy_ghosts[dir]++;
+
+                    // local particles precede the forwarded ghosts in the copy list
+                    if (idx < m_pdata->getN())
+                        m_num_copy_ghosts_local[dir]++;
                     }
                 }
             }
@@ -2065,8 +2196,24 @@ void Communicator::exchangeGhosts()
                   m_mpi_comm,
                   &req);
         m_reqs.push_back(req);
+        MPI_Isend(&m_num_copy_ghosts_local[dir],
+                  sizeof(unsigned int),
+                  MPI_BYTE,
+                  send_neighbor,
+                  10,
+                  m_mpi_comm,
+                  &req);
+        m_reqs.push_back(req);
+        MPI_Irecv(&m_num_recv_ghosts_local[dir],
+                  sizeof(unsigned int),
+                  MPI_BYTE,
+                  recv_neighbor,
+                  10,
+                  m_mpi_comm,
+                  &req);
+        m_reqs.push_back(req);
 
-        m_stats.resize(2);
+        m_stats.resize(4);
         MPI_Waitall((unsigned int)m_reqs.size(), &m_reqs.front(), &m_stats.front());
 
         // append ghosts at the end of particle data array
@@ -2363,6 +2510,10 @@ void Communicator::exchangeGhosts()
 
     m_last_flags = flags;
 
+    setGhostReference();
+    m_ghost_field_valid[0] = m_ghost_field_valid[1] = false;
+    recordGhostFields(flags);
+
     /***********************************************************************************************************************************************************
      * For multi-body force fields we must allow particles to send information back through their
      *ghosts. For this purpose, we implement a system for ghosts to be sent back to their original
@@ -2633,7 +2784,14 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
     // to send to neighboring processors
     m_exec_conf->msg->notice(7) << "Communicator: update ghosts" << std::endl;
 
+    if (m_persistent_ghost_updates && !m_exec_conf->isCUDAEnabled())
+        {
+        updateGhostsPersistent();
+        return;
+        }
+
     // update data in these arrays
+    selectGhostUpdateFields();
 
     unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
 
@@ -2642,9 +2800,10 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
         if (!isCommunicating(dir))
             continue;
 
-        CommFlags flags = getFlags();
+        CommFlags flags = m_update_flags;
+        const bool compress_positions = useCompressedGhostPositions();
 
-        if (flags[comm_flag::position])
+        if (flags[comm_flag::position] && !compress_positions)
             {
             ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
                                        access_location::host,
@@ -2742,7 +2901,21 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
 
         // only non-permanent fields (position, velocity, orientation) need to be considered here
         // charge, body, image and diameter are not updated between neighbor list builds
-        if (flags[comm_flag::position])
+        if (flags[comm_flag::position] && compress_positions)
+            {
+            m_reqs.clear();
+            postCompressedGhostPositions(dir,
+                                         0,
+                                         0,
+                                         m_num_copy_ghosts[dir],
+                                         m_num_recv_ghosts[dir],
+                                         1,
+                                         m_reqs);
+            m_stats.resize(m_reqs.size());
+            MPI_Waitall((unsigned int)m_reqs.size(), &m_reqs.front(), &m_stats.front());
+            unpackCompressedGhostPositions(dir, 0, start_idx);
+            }
+        else if (flags[comm_flag::position])
             {
             m_reqs.resize(2);
             m_stats.resize(2);
@@ -2851,6 +3024,1229 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
             }
 
         } // end dir loop
+
+    recordGhostFields(m_update_flags);
+    }
+
+/*! \param dir Direction to send to
+    \param part 0 for the local particles, 1 for the forwarded ghosts
+    \param first First entry of the copy list to send
+    \param last One past the last entry of the copy list to send
+    \param buf_offset Offset of the entries in the send buffers
+    \param recv_idx Particle index of the first received ghost
+    \param n_recv Number of ghosts to receive
+    \param tag_offset Offset added to the message tags
+    \param reqs Vector to append the requests to
+
+    Copy the position, velocity, and orientation (as requested by the communication flags) of the
+    entries [first, last) of the copy list into the send buffers and post the non-blocking messages.
+    The received values are written directly to the particle data arrays, which must not be
+    resized or read until the requests complete.
+*/
+void Communicator::postGhostUpdate(unsigned int dir,
+                                   unsigned int part,
+                                   unsigned int first,
+                                   unsigned int last,
+                                   unsigned int buf_offset,
+                                   unsigned int recv_idx,
+                                   unsigned int n_recv,
+                                   int tag_offset,
+                                   std::vector<MPI_Request>& reqs)
+    {
+    CommFlags flags = m_update_flags;
+    const bool compress_positions = useCompressedGhostPositions();
+
+    unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
+
+    // we receive from the direction opposite to the one we send to
+    unsigned int recv_neighbor;
+    if (dir % 2 == 0)
+        recv_neighbor = m_decomposition->getNeighborRank(dir + 1);
+    else
+        recv_neighbor = m_decomposition->getNeighborRank(dir - 1);
+
+    unsigned int n_send = last - first;
+
+        {
+        ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir],
+                                                access_location::host,
+                                                access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::read);
+        ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf,
+                                           access_location::host,
+                                           access_mode::readwrite);
+        ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf,
+                                                access_location::host,
+                                                access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf,
+                                                   access_location::host,
+                                                   access_mode::readwrite);
+
+        auto pack = [&](unsigned int pack_first, unsigned int pack_last)
+        {
+            for (unsigned int ghost_idx = first + pack_first; ghost_idx < first + pack_last;
+                 ghost_idx++)
+                {
+                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+
+                unsigned int buf_idx = buf_offset + ghost_idx - first;
+                if (flags[comm_flag::position] && !compress_positions)
+                    h_pos_copybuf.data[buf_idx] = h_pos.data[idx];
+                if (flags[comm_flag::velocity])
+                    h_velocity_copybuf.data[buf_idx] = h_vel.data[idx];
+                if (flags[comm_flag::orientation])
+                    h_orientation_copybuf.data[buf_idx] = h_orientation.data[idx];
+                }
+        };
+        detail::parallel_loop(*m_exec_conf, n_send, pack);
+        }
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                               access_location::host,
+                               access_mode::readwrite);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                               access_location::host,
+                               access_mode::readwrite);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+    ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf,
+                                            access_location::host,
+                                            access_mode::read);
+    ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf,
+                                               access_location::host,
+                                               access_mode::read);
+
+    MPI_Request req;
+    if (flags[comm_flag::position] && compress_positions)
+        {
+        postCompressedGhostPositions(dir, part, first, last, n_recv, tag_offset + 1, reqs);
+        }
+    else if (flags[comm_flag::position])
+        {
+        MPI_Isend(h_pos_copybuf.data + buf_offset,
+                  (unsigned int)(n_send * sizeof(Scalar4)),
+                  MPI_BYTE,
+                  send_neighbor,
+                  tag_offset + 1,
+                  m_mpi_comm,
+                  &req);
+        reqs.push_back(req);
+        MPI_Irecv(h_pos.data + recv_idx,
+                  (unsigned int)(n_recv * sizeof(Scalar4)),
+                  MPI_BYTE,
+                  recv_neighbor,
+                  tag_offset + 1,
+                  m_mpi_comm,
+                  &req);
+        reqs.push_back(req);
+        }
+
+    if (flags[comm_flag::velocity])
+        {
+        MPI_Isend(h_velocity_copybuf.data + buf_offset,
+                  (unsigned int)(n_send * sizeof(Scalar4)),
+                  MPI_BYTE,
+                  send_neighbor,
+                  tag_offset + 2,
+                  m_mpi_comm,
+                  &req);
+        reqs.push_back(req);
+        MPI_Irecv(h_vel.data + recv_idx,
+                  (unsigned int)(n_recv * sizeof(Scalar4)),
+                  MPI_BYTE,
+                  recv_neighbor,
+                  tag_offset + 2,
+                  m_mpi_comm,
+                  &req);
+        reqs.push_back(req);
+        }
+
+    if (flags[comm_flag::orientation])
+        {
+        MPI_Isend(h_orientation_copybuf.data + buf_offset,
+                  (unsigned int)(n_send * sizeof(Scalar4)),
+                  MPI_BYTE,
+                  send_neighbor,
+                  tag_offset + 3,
+                  m_mpi_comm,
+                  &req);
+        reqs.push_back(req);
+        MPI_Irecv(h_orientation.data + recv_idx,
+                  (unsigned int)(n_recv * sizeof(Scalar4)),
+                  MPI_BYTE,
+                  recv_neighbor,
+                  tag_offset + 3,
+                  m_mpi_comm,
+                  &req);
+        reqs.push_back(req);
+        }
+    }
+
+/*! \param first Particle index of the first ghost to wrap
+    \param n Number of ghosts to wrap
+*/
+void Communicator::wrapGhostPositions(unsigned int first, unsigned int n)
+    {
+    if (!getFlags()[comm_flag::position])
+        return;
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                               access_location::host,
+                               access_mode::readwrite);
+
+    // wrap particles received across a global boundary
+    const BoxDim shifted_box = getShiftedBox();
+    for (unsigned int idx = first; idx < first + n; idx++)
+        {
+        int3 img = make_int3(0, 0, 0);
+        shifted_box.wrap(h_pos.data[idx], img);
+        }
+    }
+
+/*! \param timestep The time step
+
+    Post the messages for the local particles in all directions at once. The ghosts forwarded
+    across edges and corners depend on the contents of the earlier messages, finishUpdateGhosts()
+    sends them after the first messages complete.
+*/
+void Communicator::beginUpdateGhostsOverlapped(uint64_t timestep)
+    {
+    m_exec_conf->msg->notice(7) << "Communicator: begin overlapped ghost update" << std::endl;
+
+    if (m_persistent_ghost_updates)
+        {
+        initPersistentGhostUpdate();
+        m_shm_seq++;
+
+        for (unsigned int dir = 0; dir < 6; dir++)
+            {
+            if (!isCommunicating(dir))
+                continue;
+
+            packPersistentGhostUpdate(dir, 0, m_num_copy_ghosts_local[dir]);
+            startPersistentGhostUpdate(m_persistent_req_offset[dir][0],
+                                       m_persistent_req_offset[dir][1]);
+            }
+
+        m_comm_pending = true;
+        return;
+        }
+
+    // local particles may appear in the copy lists of several directions
+    unsigned int n_send_local = 0;
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        if (isCommunicating(dir))
+            n_send_local += m_num_copy_ghosts_local[dir];
+        }
+
+    selectGhostUpdateFields();
+    CommFlags flags = m_update_flags;
+    if (flags[comm_flag::position] && m_pos_copybuf.size() < n_send_local)
+        m_pos_copybuf.resize(n_send_local);
+    if (flags[comm_flag::velocity] && m_velocity_copybuf.size() < n_send_local)
+        m_velocity_copybuf.resize(n_send_local);
+    if (flags[comm_flag::orientation] && m_orientation_copybuf.size() < n_send_local)
+        m_orientation_copybuf.resize(n_send_local);
+
+    m_ghost_update_reqs.clear();
+    unsigned int buf_offset = 0;
+    unsigned int recv_idx = m_pdata->getN();
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        if (!isCommunicating(dir))
+            continue;
+
+        postGhostUpdate(dir,
+                        0,
+                        0,
+                        m_num_copy_ghosts_local[dir],
+                        buf_offset,
+                        recv_idx,
+                        m_num_recv_ghosts_local[dir],
+                        16 + 3 * dir,
+                        m_ghost_update_reqs);
+
+        buf_offset += m_num_copy_ghosts_local[dir];
+        recv_idx += m_num_recv_ghosts[dir];
+        }
+
+    m_comm_pending = true;
+    }
+
+/*! \param timestep The time step
+ */
+void Communicator::finishUpdateGhosts(uint64_t timestep)
+    {
+    finishUpdateGhostsOverlapped();
+    }
+
+/*! Complete an update started by beginUpdateGhostsOverlapped(): wait for the messages of the local
+    particles, then send the forwarded ghosts one direction at a time.
+*/
+void Communicator::finishUpdateGhostsOverlapped()
+    {
+    if (!m_comm_pending)
+        return;
+
+    m_comm_pending = false;
+
+    ScopedProfile profile(m_sysdef->getProfiler(),
+                          "Communicator::finishUpdateGhosts",
+                          "communication");
+
+    if (m_persistent_ghost_updates)
+        {
+        for (unsigned int dir = 0; dir < 6; dir++)
+            {
+            if (!isCommunicating(dir))
+                continue;
+
+            waitPersistentGhostUpdate(m_persistent_req_offset[dir][0],
+                                      m_persistent_req_offset[dir][1]);
+            unpackPersistentGhostUpdate(dir, 0, m_num_recv_ghosts_local[dir]);
+
+            // forward the ghosts received from the previous directions
+            packPersistentGhostUpdate(dir, m_num_copy_ghosts_local[dir], m_num_copy_ghosts[dir]);
+            startPersistentGhostUpdate(m_persistent_req_offset[dir][1],
+                                       m_persistent_req_offset[dir][2]);
+            waitPersistentGhostUpdate(m_persistent_req_offset[dir][1],
+                                      m_persistent_req_offset[dir][2]);
+            unpackPersistentGhostUpdate(dir, m_num_recv_ghosts_local[dir], m_num_recv_ghosts[dir]);
+            }
+        return;
+        }
+
+    m_stats.resize(m_ghost_update_reqs.size());
+    if (!m_ghost_update_reqs.empty())
+        MPI_Waitall((unsigned int)m_ghost_update_reqs.size(),
+                    &m_ghost_update_reqs.front(),
+                    &m_stats.front());
+
+    unsigned int recv_idx = m_pdata->getN();
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        if (!isCommunicating(dir))
+            continue;
+
+        if (useCompressedGhostPositions() && getFlags()[comm_flag::position])
+            unpackCompressedGhostPositions(dir, 0, recv_idx);
+        wrapGhostPositions(recv_idx, m_num_recv_ghosts_local[dir]);
+
+        // forward the ghosts received from the previous directions
+        m_ghost_update_reqs.clear();
+        postGhostUpdate(dir,
+                        1,
+                        m_num_copy_ghosts_local[dir],
+                        m_num_copy_ghosts[dir],
+                        0,
+                        recv_idx + m_num_recv_ghosts_local[dir],
+                        m_num_recv_ghosts[dir] - m_num_recv_ghosts_local[dir],
+                        0,
+                        m_ghost_update_reqs);
+
+        m_stats.resize(m_ghost_update_reqs.size());
+        if (!m_ghost_update_reqs.empty())
+            MPI_Waitall((unsigned int)m_ghost_update_reqs.size(),
+                        &m_ghost_update_reqs.front(),
+                        &m_stats.front());
+
+        if (useCompressedGhostPositions() && getFlags()[comm_flag::position])
+            unpackCompressedGhostPositions(dir, 1, recv_idx + m_num_recv_ghosts_local[dir]);
+        wrapGhostPositions(recv_idx + m_num_recv_ghosts_local[dir],
+                           m_num_recv_ghosts[dir] - m_num_recv_ghosts_local[dir]);
+
+        recv_idx += m_num_recv_ghosts[dir];
+        }
+
+    recordGhostFields(m_update_flags);
+    }
+
+/*! \param enable Set to true to use persistent requests
+ */
+void Communicator::setPersistentGhostUpdates(bool enable)
+    {
+    if (enable == m_persistent_ghost_updates)
+        return;
+
+    // the pending messages use the previous mode
+    finishUpdateGhostsOverlapped();
+    freePersistentGhostUpdate();
+    m_persistent_ghost_updates = enable;
+    }
+
+/*! \param enable Set to true to update the ghosts of co-located neighbors in shared memory
+ */
+void Communicator::setSharedMemoryGhostUpdates(bool enable)
+    {
+    if (enable == m_shm_ghost_updates)
+        return;
+
+    // the persistent requests depend on which neighbors use the window
+    finishUpdateGhostsOverlapped();
+    freePersistentGhostUpdate();
+    if (!enable)
+        freeSharedGhostWindow();
+    m_shm_ghost_updates = enable;
+    }
+
+/*! \param bits Bits per coordinate of the ghost position updates: 0 (full positions), 16, or 32
+ */
+void Communicator::setGhostPositionBits(unsigned int bits)
+    {
+    if (bits != 0 && bits != 16 && bits != 32)
+        {
+        throw std::invalid_argument("The ghost position bits must be 0, 16, or 32.");
+        }
+
+    if (bits == m_ghost_position_bits)
+        return;
+
+    // the pending messages use the previous format
+    finishUpdateGhostsOverlapped();
+    m_ghost_position_bits = bits;
+
+    // send full positions until the next ghost exchange stores the reference positions
+    m_ghost_ref_valid = false;
+    }
+
+/*! \param enable Set to true to skip the fields that no rank changed
+ */
+void Communicator::setSkipUnchangedGhostFields(bool enable)
+    {
+    // the pending messages use the previous fields
+    finishUpdateGhostsOverlapped();
+    m_skip_unchanged_ghost_fields = enable;
+    }
+
+/*! \param enable Set to true to overlap the ghost updates with the force computation
+ */
+void Communicator::setOverlapGhostUpdates(bool enable)
+    {
+    finishUpdateGhostsOverlapped();
+    m_overlap_ghost_updates = enable;
+    }
+
+/*! A field needs to be sent when the ghosts never received it since the last ghost exchange or
+    when the array was acquired for writing since. Every rank must post the same messages, so the
+    ranks agree on the fields with a single reduction.
+*/
+void Communicator::selectGhostUpdateFields()
+    {
+    m_update_flags = getFlags();
+    if (!m_skip_unchanged_ghost_fields
+        || !(m_update_flags[comm_flag::velocity] || m_update_flags[comm_flag::orientation]))
+        return;
+
+    const uint64_t write_count[2] = {m_pdata->getVelocities().getWriteCount(),
+                                     m_pdata->getOrientationArray().getWriteCount()};
+    const unsigned int field_flag[2] = {comm_flag::velocity, comm_flag::orientation};
+
+    unsigned int changed = 0;
+    for (unsigned int i = 0; i < 2; i++)
+        {
+        if (m_update_flags[field_flag[i]]
+            && (!m_ghost_field_valid[i] || write_count[i] != m_ghost_write_count[i]))
+            changed |= 1 << i;
+        }
+
+    MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_UNSIGNED, MPI_BOR, m_mpi_comm);
+
+    for (unsigned int i = 0; i < 2; i++)
+        {
+        if (!(changed & (1 << i)))
+            m_update_flags[field_flag[i]] = false;
+        }
+    }
+
+/*! \param sent Fields that the ghost exchange or update sent
+
+    Call after the last write to the particle data arrays of the communication, so that the
+    counts include the writes of the received ghosts.
+*/
+void Communicator::recordGhostFields(CommFlags sent)
+    {
+    if (sent[comm_flag::velocity])
+        {
+        m_ghost_write_count[0] = m_pdata->getVelocities().getWriteCount();
+        m_ghost_field_valid[0] = true;
+        }
+    if (sent[comm_flag::orientation])
+        {
+        m_ghost_write_count[1] = m_pdata->getOrientationArray().getWriteCount();
+        m_ghost_field_valid[1] = true;
+        }
+    }
+
+/*! The compressed ghost updates send the offsets from the positions that the last ghost exchange
+    sent. The sender stores the positions of its copy lists, the receiver the positions of the
+    received ghosts after wrapping them into the shifted box.
+*/
+void Communicator::setGhostReference()
+    {
+    m_ghost_ref_valid = false;
+    if (m_ghost_position_bits == 0 || !getFlags()[comm_flag::position])
+        return;
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        m_ghost_send_ref[dir].resize(m_num_copy_ghosts[dir]);
+        if (!isCommunicating(dir))
+            continue;
+
+        ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir],
+                                                access_location::host,
+                                                access_mode::read);
+        for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+            {
+            Scalar4 postype = h_pos.data[h_rtag.data[h_copy_ghosts.data[ghost_idx]]];
+            m_ghost_send_ref[dir][ghost_idx] = make_scalar3(postype.x, postype.y, postype.z);
+            }
+        }
+
+    const unsigned int N = m_pdata->getN();
+    m_ghost_recv_ref.resize(m_pdata->getNGhosts());
+    for (unsigned int i = 0; i < m_pdata->getNGhosts(); i++)
+        {
+        Scalar4 postype = h_pos.data[N + i];
+        m_ghost_recv_ref[i] = make_scalar3(postype.x, postype.y, postype.z);
+        }
+
+    m_ghost_ref_valid = true;
+    }
+
+/*! \param dir Direction to send to
+    \param part 0 for the local particles, 1 for the forwarded ghosts
+    \param first First entry of the copy list to send
+    \param last One past the last entry of the copy list to send
+    \param n_recv Number of ghosts to receive
+    \param tag Message tag
+    \param reqs Vector to append the requests to
+
+    The message holds the scale (the largest offset component) followed by the three fixed point
+    coordinates of every offset. The offsets use the minimum image convention in the global box,
+    so that particles wrapped across a periodic boundary since the last exchange do not overflow.
+*/
+void Communicator::postCompressedGhostPositions(unsigned int dir,
+                                                unsigned int part,
+                                                unsigned int first,
+                                                unsigned int last,
+                                                unsigned int n_recv,
+                                                int tag,
+                                                std::vector<MPI_Request>& reqs)
+    {
+    const size_t element_size = m_ghost_position_bits == 16 ? sizeof(int16_t) : sizeof(int32_t);
+    const Scalar q_max = m_ghost_position_bits == 16 ? Scalar(INT16_MAX) : Scalar(INT32_MAX);
+    const unsigned int n_send = last - first;
+    const unsigned int slot = 2 * dir + part;
+
+    std::vector<char>& sendbuf = m_ghost_pos_sendbuf[slot];
+    std::vector<char>& recvbuf = m_ghost_pos_recvbuf[slot];
+    sendbuf.resize(sizeof(Scalar) + 3 * size_t(n_send) * element_size);
+    recvbuf.resize(sizeof(Scalar) + 3 * size_t(n_recv) * element_size);
+
+        {
+        ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir],
+                                                access_location::host,
+                                                access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+
+        const BoxDim global_box = m_pdata->getGlobalBox();
+        auto offset = [&](unsigned int ghost_idx)
+        {
+            Scalar4 postype = h_pos.data[h_rtag.data[h_copy_ghosts.data[ghost_idx]]];
+            Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+            return global_box.minImage(pos - m_ghost_send_ref[dir][ghost_idx]);
+        };
+
+        Scalar scale(0.0);
+        for (unsigned int ghost_idx = first; ghost_idx < last; ghost_idx++)
+            {
+            Scalar3 d = offset(ghost_idx);
+            scale = std::max(scale, std::max(fabs(d.x), std::max(fabs(d.y), fabs(d.z))));
+            }
+        if (scale == Scalar(0.0))
+            scale = Scalar(1.0);
+        memcpy(sendbuf.data(), &scale, sizeof(Scalar));
+
+        char* data = sendbuf.data() + sizeof(Scalar);
+        for (unsigned int ghost_idx = first; ghost_idx < last; ghost_idx++)
+            {
+            Scalar3 d = offset(ghost_idx);
+            Scalar c[3] = {d.x, d.y, d.z};
+            for (unsigned int k = 0; k < 3; k++)
+                {
+                int32_t q = int32_t(lround(c[k] / scale * q_max));
+                if (m_ghost_position_bits == 16)
+                    {
+                    int16_t q_short = int16_t(q);
+                    memcpy(data, &q_short, sizeof(int16_t));
+                    }
+                else
+                    {
+                    memcpy(data, &q, sizeof(int32_t));
+                    }
+                data += element_size;
+                }
+            }
+        }
+
+    unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
+
+    // we receive from the direction opposite to the one we send to
+    unsigned int recv_neighbor;
+    if (dir % 2 == 0)
+        recv_neighbor = m_decomposition->getNeighborRank(dir + 1);
+    else
+        recv_neighbor = m_decomposition->getNeighborRank(dir - 1);
+
+    MPI_Request req;
+    MPI_Isend(sendbuf.data(),
+              (unsigned int)sendbuf.size(),
+              MPI_BYTE,
+              send_neighbor,
+              tag,
+              m_mpi_comm,
+              &req);
+    reqs.push_back(req);
+    MPI_Irecv(recvbuf.data(),
+              (unsigned int)recvbuf.size(),
+              MPI_BYTE,
+              recv_neighbor,
+              tag,
+              m_mpi_comm,
+              &req);
+    reqs.push_back(req);
+    }
+
+/*! \param dir Direction the ghosts were sent to
+    \param part 0 for the local particles of the neighbor, 1 for the forwarded ghosts
+    \param recv_idx Particle index of the first received ghost
+
+    The type in the w component of the positions does not change between ghost exchanges.
+*/
+void Communicator::unpackCompressedGhostPositions(unsigned int dir,
+                                                  unsigned int part,
+                                                  unsigned int recv_idx)
+    {
+    const size_t element_size = m_ghost_position_bits == 16 ? sizeof(int16_t) : sizeof(int32_t);
+    const Scalar q_max = m_ghost_position_bits == 16 ? Scalar(INT16_MAX) : Scalar(INT32_MAX);
+    const std::vector<char>& recvbuf = m_ghost_pos_recvbuf[2 * dir + part];
+    const size_t n_recv = (recvbuf.size() - sizeof(Scalar)) / (3 * element_size);
+
+    Scalar scale;
+    memcpy(&scale, recvbuf.data(), sizeof(Scalar));
+    const Scalar inv_q = scale / q_max;
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                               access_location::host,
+                               access_mode::readwrite);
+
+    const char* data = recvbuf.data() + sizeof(Scalar);
+    const unsigned int ref_offset = recv_idx - m_pdata->getN();
+    for (unsigned int i = 0; i < n_recv; i++)
+        {
+        Scalar c[3];
+        for (unsigned int k = 0; k < 3; k++)
+            {
+            if (m_ghost_position_bits == 16)
+                {
+                int16_t q;
+                memcpy(&q, data, sizeof(int16_t));
+                c[k] = Scalar(q) * inv_q;
+                }
+            else
+                {
+                int32_t q;
+                memcpy(&q, data, sizeof(int32_t));
+                c[k] = Scalar(q) * inv_q;
+                }
+            data += element_size;
+            }
+
+        const Scalar3& ref = m_ghost_recv_ref[ref_offset + i];
+        Scalar4& pos = h_pos.data[recv_idx + i];
+        pos.x = ref.x + c[0];
+        pos.y = ref.y + c[1];
+        pos.z = ref.z + c[2];
+        }
+    }
+
+/*! \param margin Extra ghost layer width, zero to migrate on every request
+ */
+void Communicator::setMigrationMargin(Scalar margin)
+    {
+    if (margin < Scalar(0.0))
+        {
+        throw std::invalid_argument("The migration margin must not be negative.");
+        }
+
+    if (margin == m_migration_margin)
+        return;
+
+    // rebuild the ghost layer with the new width
+    m_migration_margin = margin;
+    m_migration_ref_pos.clear();
+    forceMigrate();
+    }
+
+void Communicator::setMigrationReference()
+    {
+    if (m_migration_margin == Scalar(0.0))
+        {
+        m_migration_ref_pos.clear();
+        return;
+        }
+
+    const unsigned int N = m_pdata->getN();
+    m_migration_ref_pos.resize(N);
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        m_migration_ref_pos[i] = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        }
+    }
+
+/*! A particle that is not within the ghost layer of a domain after a migration is farther than the
+    requested width plus the margin from the domain. When no particle moved more than half the
+    margin, the ghosts still include every particle within the requested width of a local
+    particle. The displacements are not wrapped, so particles that cross a periodic boundary of
+    the global box always trigger the migration.
+
+    The local particles keep their indices until the next migration, because sorting the particles
+    forces a migration.
+*/
+bool Communicator::canDeferMigration()
+    {
+    if (m_migration_margin == Scalar(0.0))
+        return false;
+
+    const unsigned int N = m_pdata->getN();
+    int defer = N == m_migration_ref_pos.size() ? 1 : 0;
+    if (defer)
+        {
+        const Scalar max_displacement_sq = m_migration_margin * m_migration_margin / Scalar(4.0);
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            Scalar3 dx = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z)
+                         - m_migration_ref_pos[i];
+            if (dot(dx, dx) > max_displacement_sq)
+                {
+                defer = 0;
+                break;
+                }
+            }
+        }
+
+    MPI_Allreduce(MPI_IN_PLACE, &defer, 1, MPI_INT, MPI_MIN, m_exec_conf->getMPICommunicator());
+    return defer != 0;
+    }
+
+/*! The persistent requests send each direction in two parts: the local particles and the ghosts
+    forwarded across edges and corners. The requests for the local particles of all directions
+    can be active at the same time, the forwarded ghosts are sent after the previous directions
+    complete. The message sizes change only in exchangeGhosts(), so the requests are recreated
+    after each ghost exchange and reused for all ghost updates until the next one.
+
+    The buffers grow geometrically and are never shrunk so that the requests rarely need to
+    target new memory.
+*/
+void Communicator::initPersistentGhostUpdate()
+    {
+    CommFlags flags = getFlags();
+    CommFlags fields(0);
+    fields[comm_flag::position] = flags[comm_flag::position];
+    fields[comm_flag::velocity] = flags[comm_flag::velocity];
+    fields[comm_flag::orientation] = flags[comm_flag::orientation];
+
+    if (m_persistent_reqs_valid && fields == m_persistent_flags)
+        return;
+
+    m_exec_conf->msg->notice(7) << "Communicator: create persistent ghost update requests"
+                                << std::endl;
+
+    freePersistentGhostUpdate();
+
+    unsigned int n_send_tot = 0;
+    unsigned int n_recv_tot = 0;
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        m_persistent_send_offset[dir] = n_send_tot;
+        m_persistent_recv_offset[dir] = n_recv_tot;
+        if (!isCommunicating(dir))
+            continue;
+
+        n_send_tot += m_num_copy_ghosts[dir];
+        n_recv_tot += m_num_recv_ghosts[dir];
+        }
+
+    if (m_shm_ghost_updates)
+        initSharedGhostWindow(n_send_tot);
+
+    const comm_flag::Enum field_flags[3]
+        = {comm_flag::position, comm_flag::velocity, comm_flag::orientation};
+
+    for (unsigned int field = 0; field < 3; field++)
+        {
+        if (!fields[field_flags[field]])
+            continue;
+
+        // leave room to grow, keep at least one element so that the buffers have an address
+        if (m_persistent_sendbuf[field].size() < n_send_tot || m_persistent_sendbuf[field].empty())
+            m_persistent_sendbuf[field].resize(n_send_tot + n_send_tot / 2 + 1);
+        if (m_persistent_recvbuf[field].size() < n_recv_tot || m_persistent_recvbuf[field].empty())
+            m_persistent_recvbuf[field].resize(n_recv_tot + n_recv_tot / 2 + 1);
+        }
+
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
+
+        // we receive from the direction opposite to the one we send to
+        unsigned int recv_neighbor;
+        if (dir % 2 == 0)
+            recv_neighbor = m_decomposition->getNeighborRank(dir + 1);
+        else
+            recv_neighbor = m_decomposition->getNeighborRank(dir - 1);
+
+        for (unsigned int part = 0; part < 2; part++)
+            {
+            m_persistent_req_offset[dir][part] = (unsigned int)m_persistent_reqs.size();
+            if (!isCommunicating(dir))
+                continue;
+
+            unsigned int send_first = part == 0 ? 0 : m_num_copy_ghosts_local[dir];
+            unsigned int n_send
+                = part == 0 ? m_num_copy_ghosts_local[dir]
+                            : m_num_copy_ghosts[dir] - m_num_copy_ghosts_local[dir];
+            unsigned int recv_first = part == 0 ? 0 : m_num_recv_ghosts_local[dir];
+            unsigned int n_recv
+                = part == 0 ? m_num_recv_ghosts_local[dir]
+                            : m_num_recv_ghosts[dir] - m_num_recv_ghosts_local[dir];
+
+            for (unsigned int field = 0; field < 3; field++)
+                {
+                if (!fields[field_flags[field]])
+                    continue;
+
+                int tag = 64 + 6 * dir + 3 * part + field;
+
+                // co-located neighbors exchange the ghosts in the shared memory window
+                MPI_Request req;
+                if (!m_shm_send_header[dir])
+                    {
+                    MPI_Send_init(&m_persistent_sendbuf[field].front()
+                                      + m_persistent_send_offset[dir] + send_first,
+                                  (unsigned int)(n_send * sizeof(Scalar4)),
+                                  MPI_BYTE,
+                                  send_neighbor,
+                                  tag,
+                                  m_mpi_comm,
+                                  &req);
+                    m_persistent_reqs.push_back(req);
+                    }
+                if (!m_shm_recv_header[dir])
+                    {
+                    MPI_Recv_init(&m_persistent_recvbuf[field].front()
+                                      + m_persistent_recv_offset[dir] + recv_first,
+                                  (unsigned int)(n_recv * sizeof(Scalar4)),
+                                  MPI_BYTE,
+                                  recv_neighbor,
+                                  tag,
+                                  m_mpi_comm,
+                                  &req);
+                    m_persistent_reqs.push_back(req);
+                    }
+                }
+            }
+        m_persistent_req_offset[dir][2] = (unsigned int)m_persistent_reqs.size();
+        }
+
+    m_persistent_flags = fields;
+    m_persistent_reqs_valid = true;
+    }
+
+void Communicator::freePersistentGhostUpdate()
+    {
+    for (auto& req : m_persistent_reqs)
+        {
+        MPI_Request_free(&req);
+        }
+    m_persistent_reqs.clear();
+    m_persistent_reqs_valid = false;
+    }
+
+/*! \param dir Direction to send to
+    \param first First entry of the copy list to pack
+    \param last One past the last entry of the copy list to pack
+*/
+void Communicator::packPersistentGhostUpdate(unsigned int dir,
+                                             unsigned int first,
+                                             unsigned int last)
+    {
+    if (m_shm_send_header[dir])
+        {
+        packSharedGhostUpdate(dir, first, last);
+        return;
+        }
+
+    ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir],
+                                            access_location::host,
+                                            access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::read);
+
+    const unsigned int offset = m_persistent_send_offset[dir];
+
+    for (unsigned int ghost_idx = first; ghost_idx < last; ghost_idx++)
+        {
+        unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+        assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+
+        if (m_persistent_flags[comm_flag::position])
+            m_persistent_sendbuf[0][offset + ghost_idx] = h_pos.data[idx];
+        if (m_persistent_flags[comm_flag::velocity])
+            m_persistent_sendbuf[1][offset + ghost_idx] = h_vel.data[idx];
+        if (m_persistent_flags[comm_flag::orientation])
+            m_persistent_sendbuf[2][offset + ghost_idx] = h_orientation.data[idx];
+        }
+    }
+
+/*! \param dir Direction the ghosts were sent to
+    \param first First received ghost of the direction to unpack
+    \param last One past the last received ghost of the direction to unpack
+*/
+void Communicator::unpackPersistentGhostUpdate(unsigned int dir,
+                                               unsigned int first,
+                                               unsigned int last)
+    {
+    if (m_shm_recv_header[dir])
+        {
+        unpackSharedGhostUpdate(dir, first, last);
+        return;
+        }
+
+    unsigned int start_idx = m_pdata->getN() + m_persistent_recv_offset[dir];
+
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::readwrite);
+
+        const unsigned int offset = m_persistent_recv_offset[dir];
+
+        for (unsigned int i = first; i < last; i++)
+            {
+            if (m_persistent_flags[comm_flag::position])
+                h_pos.data[start_idx + i] = m_persistent_recvbuf[0][offset + i];
+            if (m_persistent_flags[comm_flag::velocity])
+                h_vel.data[start_idx + i] = m_persistent_recvbuf[1][offset + i];
+            if (m_persistent_flags[comm_flag::orientation])
+                h_orientation.data[start_idx + i] = m_persistent_recvbuf[2][offset + i];
+            }
+        }
+
+    wrapGhostPositions(start_idx + first, last - first);
+    }
+
+/*! \param first Index of the first request to start
+    \param last One past the index of the last request to start
+*/
+void Communicator::startPersistentGhostUpdate(unsigned int first, unsigned int last)
+    {
+    if (last > first)
+        MPI_Startall(last - first, &m_persistent_reqs[first]);
+    }
+
+/*! \param first Index of the first request to wait for
+    \param last One past the index of the last request to wait for
+*/
+void Communicator::waitPersistentGhostUpdate(unsigned int first, unsigned int last)
+    {
+    if (last > first)
+        {
+        m_stats.resize(last - first);
+        MPI_Waitall(last - first, &m_persistent_reqs[first], &m_stats.front());
+        }
+    }
+
+void Communicator::updateGhostsPersistent()
+    {
+    initPersistentGhostUpdate();
+    m_shm_seq++;
+
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        if (!isCommunicating(dir))
+            continue;
+
+        // the copy list may contain ghosts received in the previous directions
+        packPersistentGhostUpdate(dir, 0, m_num_copy_ghosts[dir]);
+        startPersistentGhostUpdate(m_persistent_req_offset[dir][0],
+                                   m_persistent_req_offset[dir][2]);
+        waitPersistentGhostUpdate(m_persistent_req_offset[dir][0],
+                                  m_persistent_req_offset[dir][2]);
+        unpackPersistentGhostUpdate(dir, 0, m_num_recv_ghosts[dir]);
+        }
+    }
+
+/*! \param n_send_tot Number of ghosts this rank sends in all directions
+
+    Allocating the window is collective over the ranks on this node. The window grows when any rank
+    on the node needs more room. The sequence numbers restart after every ghost exchange.
+*/
+void Communicator::initSharedGhostWindow(unsigned int n_send_tot)
+    {
+    if (m_node_comm == MPI_COMM_NULL)
+        MPI_Comm_split_type(m_mpi_comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &m_node_comm);
+
+    int grow = (!m_shm_header || m_shm_header->capacity < n_send_tot) ? 1 : 0;
+    MPI_Allreduce(MPI_IN_PLACE, &grow, 1, MPI_INT, MPI_LOR, m_node_comm);
+
+    if (grow)
+        {
+        unsigned int capacity = n_send_tot + n_send_tot / 2 + 1;
+        if (m_shm_header)
+            capacity = std::max(capacity, m_shm_header->capacity);
+
+        freeSharedGhostWindow();
+
+        size_t header_size = (sizeof(SharedGhostHeader) + sizeof(Scalar4) - 1) / sizeof(Scalar4)
+                             * sizeof(Scalar4);
+        MPI_Aint size = MPI_Aint(header_size + 3 * size_t(capacity) * sizeof(Scalar4));
+        void* base;
+        MPI_Win_allocate_shared(size, 1, MPI_INFO_NULL, m_node_comm, &base, &m_shm_win);
+        m_shm_header = new (base) SharedGhostHeader;
+        m_shm_header->capacity = capacity;
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, m_shm_win);
+        }
+
+    // wait until the neighbors have completed the previous updates before resetting the counters
+    MPI_Barrier(m_node_comm);
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        for (unsigned int part = 0; part < 2; part++)
+            {
+            m_shm_header->published[dir][part].store(0, std::memory_order_relaxed);
+            m_shm_header->consumed[dir][part].store(0, std::memory_order_relaxed);
+            }
+        m_shm_header->offset[dir] = m_persistent_send_offset[dir];
+        }
+    m_shm_seq = 0;
+    MPI_Win_sync(m_shm_win);
+    MPI_Barrier(m_node_comm);
+    MPI_Win_sync(m_shm_win);
+
+    // find the neighbors on this node
+    MPI_Group comm_group, node_group;
+    MPI_Comm_group(m_mpi_comm, &comm_group);
+    MPI_Comm_group(m_node_comm, &node_group);
+
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        m_shm_send_header[dir] = nullptr;
+        m_shm_recv_header[dir] = nullptr;
+        if (!isCommunicating(dir))
+            continue;
+
+        int ranks[2];
+        ranks[0] = m_decomposition->getNeighborRank(dir);
+        ranks[1] = m_decomposition->getNeighborRank(dir % 2 == 0 ? dir + 1 : dir - 1);
+        int node_ranks[2];
+        MPI_Group_translate_ranks(comm_group, 2, ranks, node_group, node_ranks);
+
+        for (unsigned int i = 0; i < 2; i++)
+            {
+            if (node_ranks[i] == MPI_UNDEFINED)
+                continue;
+
+            MPI_Aint size;
+            int disp_unit;
+            void* ptr;
+            MPI_Win_shared_query(m_shm_win, node_ranks[i], &size, &disp_unit, &ptr);
+            if (i == 0)
+                m_shm_send_header[dir] = static_cast<SharedGhostHeader*>(ptr);
+            else
+                m_shm_recv_header[dir] = static_cast<SharedGhostHeader*>(ptr);
+            }
+        }
+
+    MPI_Group_free(&comm_group);
+    MPI_Group_free(&node_group);
+    }
+
+void Communicator::freeSharedGhostWindow()
+    {
+    if (m_shm_win != MPI_WIN_NULL)
+        {
+        MPI_Win_unlock_all(m_shm_win);
+        MPI_Win_free(&m_shm_win);
+        }
+    m_shm_header = nullptr;
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        m_shm_send_header[dir] = nullptr;
+        m_shm_recv_header[dir] = nullptr;
+        }
+    }
+
+/*! \param dir Direction to send to
+    \param first First entry of the copy list to pack
+    \param last One past the last entry of the copy list to pack
+
+    A range that begins the copy list publishes part 0, a range that ends it publishes part 1.
+*/
+void Communicator::packSharedGhostUpdate(unsigned int dir, unsigned int first, unsigned int last)
+    {
+    SharedGhostHeader* neighbor = m_shm_send_header[dir];
+
+    // the neighbor must have read the previous update before this one overwrites it
+    if (first == 0)
+        {
+        for (unsigned int part = 0; part < 2; part++)
+            {
+            while (neighbor->consumed[dir][part].load(std::memory_order_acquire) + 1 < m_shm_seq)
+                {
+                }
+            }
+        }
+
+        {
+        ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir],
+                                                access_location::host,
+                                                access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::read);
+
+        const unsigned int offset = m_shm_header->offset[dir];
+        Scalar4* pos = getSharedGhostData(m_shm_header, 0) + offset;
+        Scalar4* vel = getSharedGhostData(m_shm_header, 1) + offset;
+        Scalar4* orientation = getSharedGhostData(m_shm_header, 2) + offset;
+
+        for (unsigned int ghost_idx = first; ghost_idx < last; ghost_idx++)
+            {
+            unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+            assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+
+            if (m_persistent_flags[comm_flag::position])
+                pos[ghost_idx] = h_pos.data[idx];
+            if (m_persistent_flags[comm_flag::velocity])
+                vel[ghost_idx] = h_vel.data[idx];
+            if (m_persistent_flags[comm_flag::orientation])
+                orientation[ghost_idx] = h_orientation.data[idx];
+            }
+        }
+
+    MPI_Win_sync(m_shm_win);
+    if (first == 0)
+        m_shm_header->published[dir][0].store(m_shm_seq, std::memory_order_release);
+    if (last == m_num_copy_ghosts[dir])
+        m_shm_header->published[dir][1].store(m_shm_seq, std::memory_order_release);
+    }
+
+/*! \param dir Direction the ghosts were sent to
+    \param first First received ghost of the direction to unpack
+    \param last One past the last received ghost of the direction to unpack
+*/
+void Communicator::unpackSharedGhostUpdate(unsigned int dir, unsigned int first, unsigned int last)
+    {
+    SharedGhostHeader* neighbor = m_shm_recv_header[dir];
+    bool part[2] = {first == 0, last == m_num_recv_ghosts[dir]};
+
+    // wait for the neighbor to publish the ghosts of this update
+    for (unsigned int i = 0; i < 2; i++)
+        {
+        if (!part[i])
+            continue;
+        while (neighbor->published[dir][i].load(std::memory_order_acquire) < m_shm_seq)
+            {
+            }
+        }
+    MPI_Win_sync(m_shm_win);
+
+    unsigned int start_idx = m_pdata->getN() + m_persistent_recv_offset[dir];
+
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::readwrite);
+
+        const unsigned int offset = neighbor->offset[dir];
+        const Scalar4* pos = getSharedGhostData(neighbor, 0) + offset;
+        const Scalar4* vel = getSharedGhostData(neighbor, 1) + offset;
+        const Scalar4* orientation = getSharedGhostData(neighbor, 2) + offset;
+
+        for (unsigned int i = first; i < last; i++)
+            {
+            if (m_persistent_flags[comm_flag::position])
+                h_pos.data[start_idx + i] = pos[i];
+            if (m_persistent_flags[comm_flag::velocity])
+                h_vel.data[start_idx + i] = vel[i];
+            if (m_persistent_flags[comm_flag::orientation])
+                h_orientation.data[start_idx + i] = orientation[i];
+            }
+        }
+
+    // let the neighbor overwrite the window in the next update
+    for (unsigned int i = 0; i < 2; i++)
+        {
+        if (part[i])
+            m_shm_header->consumed[dir][i].store(m_shm_seq, std::memory_order_release);
+        }
+
+    wrapGhostPositions(start_idx + first, last - first);
     }
 
 void Communicator::updateNetForce(uint64_t timestep)
@@ -3409,6 +4805,18 @@ void export_Communicator(pybind11::module& m)
         .def(pybind11::init<std::shared_ptr<SystemDefinition>,
                             std::shared_ptr<DomainDecomposition>>())
         .def("addMeshDefinition", &Communicator::addMeshDefinition)
+        .def("setPersistentGhostUpdates", &Communicator::setPersistentGhostUpdates)
+        .def("getPersistentGhostUpdates", &Communicator::getPersistentGhostUpdates)
+        .def("setSharedMemoryGhostUpdates", &Communicator::setSharedMemoryGhostUpdates)
+        .def("getSharedMemoryGhostUpdates", &Communicator::getSharedMemoryGhostUpdates)
+        .def("setGhostPositionBits", &Communicator::setGhostPositionBits)
+        .def("getGhostPositionBits", &Communicator::getGhostPositionBits)
+        .def("setSkipUnchangedGhostFields", &Communicator::setSkipUnchangedGhostFields)
+        .def("getSkipUnchangedGhostFields", &Communicator::getSkipUnchangedGhostFields)
+        .def("setOverlapGhostUpdates", &Communicator::setOverlapGhostUpdates)
+        .def("getOverlapGhostUpdates", &Communicator::getOverlapGhostUpdates)
+        .def("setMigrationMargin", &Communicator::setMigrationMargin)
+        .def("getMigrationMargin", &Communicator::getMigrationMargin)
         .def_property_readonly("domain_decomposition", &Communicator::getDomainDecomposition);
     }
     } // end namespace detail
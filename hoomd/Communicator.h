@@ -20,6 +20,7 @@
 #include "ParticleData.h"
 
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
+#include <atomic>
 #include <memory>
 
 #ifndef __HIPCC__
@@ -291,7 +292,7 @@ class PYBIND11_EXPORT Communicator
      * This method is supposed to be called every time step and automatically performs all necessary
      * communication steps.
      */
-    void communicate(uint64_t timestep);
+    void communicate(uint64_t timestep, bool defer_ghost_update = false);
 
     //@}
 
@@ -321,11 +322,105 @@ class PYBIND11_EXPORT Communicator
     /*! Finish ghost update
      *
      * \param timestep The time step
+     *
+     * Does nothing when no ghost update is pending.
+     */
+    virtual void finishUpdateGhosts(uint64_t timestep);
+
+    //! Test if a ghost update is in progress
+    /*! When communicate() leaves the ghost update pending, the ghost particle data is out of
+     * date until finishUpdateGhosts() completes. The local particle data is current.
+     */
+    bool isGhostUpdatePending() const
+        {
+        return m_comm_pending;
+        }
+
+    //! Enable or disable persistent requests for the ghost updates
+    /*! When enabled, the ghost updates between migrations reuse persistent MPI requests
+     * (MPI_Send_init/MPI_Recv_init) and send buffers. The requests are created after each ghost
+     * exchange. Only the CPU code path supports persistent requests.
+     */
+    void setPersistentGhostUpdates(bool enable);
+
+    //! Test if the ghost updates use persistent requests
+    bool getPersistentGhostUpdates() const
+        {
+        return m_persistent_ghost_updates;
+        }
+
+    //! Enable or disable shared memory ghost updates between ranks on the same node
+    /*! When enabled together with persistent ghost updates, every rank packs the ghosts for its
+     * neighbors on the same node into an MPI-3 shared memory window. The neighbors copy the ghosts
+     * from the window directly into their particle data, without MPI messages. A sequence number
+     * per direction publishes the ghosts of each update, and a second one tells the sender that
+     * the neighbor has consumed them. Ghosts for ranks on other nodes still use the persistent
+     * requests.
+     */
+    void setSharedMemoryGhostUpdates(bool enable);
+
+    //! Test if the ghost updates use shared memory between ranks on the same node
+    bool getSharedMemoryGhostUpdates() const
+        {
+        return m_shm_ghost_updates;
+        }
+
+    //! Set the extra ghost layer width that lets particles move before they migrate
+    /*! With a positive margin, the ghost layer extends \a margin beyond the widths requested by
+     * the subscribers. A migration requested by the subscribers is deferred while no local particle
+     * on any rank has moved farther than half the margin since the last migration. The ghosts then
+     * still include every particle within the requested widths. Forced migrations are never
+     * deferred.
+     */
+    void setMigrationMargin(Scalar margin);
+
+    //! Get the extra ghost layer width that lets particles move before they migrate
+    Scalar getMigrationMargin() const
+        {
+        return m_migration_margin;
+        }
+
+    //! Set the number of bits per coordinate of the ghost position updates
+    /*! With 16 or 32 bits, the ghost updates between ghost exchanges send each position as fixed
+     * point offsets from the position sent in the last ghost exchange, scaled by the largest offset
+     * in the message. The ghost positions are then accurate to the largest offset divided by
+     * 2^(bits-1). 0 sends the full positions. The persistent ghost updates and the GPU code path
+     * always send the full positions.
      */
-    virtual void finishUpdateGhosts(uint64_t timestep)
+    void setGhostPositionBits(unsigned int bits);
+
+    //! Get the number of bits per coordinate of the ghost position updates
+    unsigned int getGhostPositionBits() const
         {
-        // the base class implementation is currently empty
-        m_comm_pending = false;
+        return m_ghost_position_bits;
+        }
+
+    //! Enable or disable skipping the unchanged fields in the ghost updates
+    /*! When enabled, the ghost updates between ghost exchanges send the velocities and
+     * orientations only when a rank wrote to the array since the ghosts last received them. The
+     * write counts of the particle data arrays mark the changed fields, and one reduction over all
+     * ranks per ghost update agrees on the fields to send. The positions are always sent. The
+     * persistent ghost updates and the GPU code path always send all requested fields.
+     */
+    void setSkipUnchangedGhostFields(bool enable);
+
+    //! Test if the ghost updates skip the unchanged fields
+    bool getSkipUnchangedGhostFields() const
+        {
+        return m_skip_unchanged_ghost_fields;
+        }
+
+    //! Enable or disable overlapping the ghost updates with the force computation
+    /*! When enabled, communicate() leaves the ghost update pending when the caller allows it. The
+     * force computes that support it then compute the particles without ghost neighbors while the
+     * messages are in flight. Only the CPU code path overlaps the ghost updates.
+     */
+    void setOverlapGhostUpdates(bool enable);
+
+    //! Test if the ghost updates overlap with the force computation
+    bool getOverlapGhostUpdates() const
+        {
+        return m_overlap_ghost_updates;
         }
 
     /*! Communicate the net particle force
@@ -355,6 +450,11 @@ class PYBIND11_EXPORT Communicator
      */
     virtual void exchangeGhosts();
 
+    //! Release allocated memory that the communication buffers do not use
+    /*! \param shrink_fraction Fraction of the allocated size below which the buffers shrink
+     */
+    virtual void shrinkBuffers(Scalar shrink_fraction);
+
     //! \name Enumerations
     //@{
 
@@ -390,7 +490,46 @@ class PYBIND11_EXPORT Communicator
 
     protected:
     //! Helper class to perform the communication tasks related to bonded groups
-    template<class group_data> class GroupCommunicator
+    //! Interface of the group communicators to the aggregated group migration messages
+    /*! The migration of a group type sends two kinds of elements: the updated ranks of the group
+     * members (phase 0) and the groups that move to a neighbor (phase 1). The group communicators
+     * store the elements of each phase sorted by destination neighbor, so that
+     * exchangeGroupMessages() sends the elements of all group types in a single message per
+     * neighbor and phase.
+     */
+    class GroupMigrationBuffers
+        {
+        public:
+        //! Destructor
+        virtual ~GroupMigrationBuffers() { }
+
+        //! Get the size of the elements of a phase in bytes
+        virtual size_t getElementSize(unsigned int phase) const = 0;
+
+        //! Get the elements of a phase, sorted by destination neighbor
+        virtual const char* getSendBuffer(unsigned int phase) const = 0;
+
+        //! Resize the receive buffer of a phase to \a n elements and return it
+        virtual char* resizeRecvBuffer(unsigned int phase, size_t n) = 0;
+
+        //! Get the index of the first element of a phase that is sent to a neighbor
+        unsigned int getSendBegin(unsigned int phase, unsigned int ineigh) const
+            {
+            return m_send_begin[phase][ineigh];
+            }
+
+        //! Get the number of elements of a phase that are sent to a neighbor
+        unsigned int getNumSend(unsigned int phase, unsigned int ineigh) const
+            {
+            return m_send_end[phase][ineigh] - m_send_begin[phase][ineigh];
+            }
+
+        protected:
+        std::vector<unsigned int> m_send_begin[2]; //!< First element for every neighbor per phase
+        std::vector<unsigned int> m_send_end[2];   //!< End of the elements for every neighbor
+        };
+
+    template<class group_data> class GroupCommunicator : public GroupMigrationBuffers
         {
         public:
         typedef struct rank_element<typename group_data::ranks_t> rank_element_t;
@@ -403,15 +542,50 @@ class PYBIND11_EXPORT Communicator
 
         void setGroupData(std::shared_ptr<group_data> gdata);
 
-        //! Migrate groups
-        /*! \param incomplete If true, mark all groups that have non-local members and update local
-         *         member rank information. Otherwise, mark only groups flagged for communication
-         *         in particle data
-         *  \param local_multiple If true, a group may be split across several ranks
-         * A group is marked for sending by setting its rtag to GROUP_NOT_LOCAL, and by updating
-         * the rank information with the destination ranks (or the local ranks if incomplete=true)
+        /* Migrate groups
+         *
+         * Communicator::migrateGroups() calls the four methods below for all group types in order,
+         * exchanging the send buffers after packRanks() and packGroups(). A group is marked for
+         * sending by setting its rtag to GROUP_NOT_LOCAL, and by updating the rank information
+         * with the destination ranks (or the local ranks if incomplete=true).
          */
-        void migrateGroups(bool incomplete, bool local_multiple);
+
+        //! Store the member rank updates for the neighbors (migration phase 0)
+        void packRanks(bool incomplete);
+
+        //! Apply the received member rank updates
+        void unpackRanks();
+
+        //! Remove the groups that leave the domain and store them for the neighbors (phase 1)
+        void packGroups(bool local_multiple);
+
+        //! Add the received groups
+        void unpackGroups(bool local_multiple);
+
+        //! Get the size of the elements of a phase in bytes
+        size_t getElementSize(unsigned int phase) const override
+            {
+            return phase == 0 ? sizeof(rank_element_t) : sizeof(group_element_t);
+            }
+
+        //! Get the elements of a phase, sorted by destination neighbor
+        const char* getSendBuffer(unsigned int phase) const override
+            {
+            return phase == 0 ? reinterpret_cast<const char*>(m_ranks_sendbuf.data())
+                              : reinterpret_cast<const char*>(m_groups_sendbuf.data());
+            }
+
+        //! Resize the receive buffer of a phase to \a n elements and return it
+        char* resizeRecvBuffer(unsigned int phase, size_t n) override
+            {
+            if (phase == 0)
+                {
+                m_ranks_recvbuf.resize(n);
+                return reinterpret_cast<char*>(m_ranks_recvbuf.data());
+                }
+            m_groups_recvbuf.resize(n);
+            return reinterpret_cast<char*>(m_groups_recvbuf.data());
+            }
 
         //! Mark ghost particles
         /* All particles that need to be sent as ghosts because they are members
@@ -508,6 +682,12 @@ class PYBIND11_EXPORT Communicator
         m_num_copy_ghosts[6]; //!< Number of local particles that are sent to neighboring processors
     unsigned int m_num_recv_ghosts[6]; //!< Number of ghosts received per direction
 
+    /// Number of sent ghosts per direction that are local particles
+    unsigned int m_num_copy_ghosts_local[6];
+
+    /// Number of received ghosts per direction that are local particles of the neighbor
+    unsigned int m_num_recv_ghosts_local[6];
+
     GlobalVector<unsigned int>
         m_plan; //!< Array of per-direction flags that determine the sending route
 
@@ -592,6 +772,169 @@ class PYBIND11_EXPORT Communicator
     std::vector<MPI_Request> m_reqs; //!< Container for all MPI communication requests
     std::vector<MPI_Status> m_stats; //!< Container for all MPI communication statuses
 
+    //! Requests of the pending overlapped ghost update
+    std::vector<MPI_Request> m_ghost_update_reqs;
+
+    //! Post the ghost update messages of the local particles in all directions
+    void beginUpdateGhostsOverlapped(uint64_t timestep);
+
+    //! Complete the ghost update started by beginUpdateGhostsOverlapped()
+    void finishUpdateGhostsOverlapped();
+
+    //! Post the ghost update messages for a range of the copy list in one direction
+    void postGhostUpdate(unsigned int dir,
+                         unsigned int part,
+                         unsigned int first,
+                         unsigned int last,
+                         unsigned int buf_offset,
+                         unsigned int recv_idx,
+                         unsigned int n_recv,
+                         int tag_offset,
+                         std::vector<MPI_Request>& reqs);
+
+    //! Wrap received ghost positions into the shifted box
+    void wrapGhostPositions(unsigned int first, unsigned int n);
+
+    /* Persistent ghost updates */
+    bool m_persistent_ghost_updates; //!< True to use persistent requests for the ghost updates
+    bool m_persistent_reqs_valid;    //!< True when the persistent requests match the copy lists
+    CommFlags m_persistent_flags;    //!< Fields sent by the persistent requests
+
+    //! Send and receive buffers of the persistent requests (position, velocity, orientation)
+    std::vector<Scalar4> m_persistent_sendbuf[3];
+    std::vector<Scalar4> m_persistent_recvbuf[3];
+
+    std::vector<MPI_Request> m_persistent_reqs; //!< The persistent requests
+
+    //! Range of the persistent requests for each direction
+    /*! The requests [offset[dir][0], offset[dir][1]) send the local particles and the requests
+     * [offset[dir][1], offset[dir][2]) send the ghosts forwarded across edges and corners.
+     */
+    unsigned int m_persistent_req_offset[6][3];
+
+    unsigned int m_persistent_send_offset[6]; //!< Offset of each direction in the send buffers
+    unsigned int m_persistent_recv_offset[6]; //!< Offset of each direction in the recv buffers
+
+    //! Create the persistent requests for the current copy lists and flags
+    void initPersistentGhostUpdate();
+
+    //! Free the persistent requests
+    void freePersistentGhostUpdate();
+
+    //! Copy a range of the copy list of one direction into the persistent send buffers
+    void packPersistentGhostUpdate(unsigned int dir, unsigned int first, unsigned int last);
+
+    //! Copy a range of the received ghosts of one direction into the particle data
+    void unpackPersistentGhostUpdate(unsigned int dir, unsigned int first, unsigned int last);
+
+    //! Start and complete a range of the persistent requests
+    void startPersistentGhostUpdate(unsigned int first, unsigned int last);
+    void waitPersistentGhostUpdate(unsigned int first, unsigned int last);
+
+    //! Update the ghosts with the persistent requests
+    void updateGhostsPersistent();
+
+    /* Shared memory ghost updates */
+
+    //! Header of the shared memory window of a rank
+    /*! The header is followed by the position, velocity and orientation arrays, each with \a
+     * capacity elements. Part 0 of a direction holds the local particles, part 1 the forwarded
+     * ghosts.
+     */
+    struct SharedGhostHeader
+        {
+        std::atomic<uint64_t> published[6][2]; //!< Last update written for each direction
+        std::atomic<uint64_t> consumed[6][2];  //!< Last update read from the neighbor
+        unsigned int offset[6];                //!< Offset of each direction in the arrays
+        unsigned int capacity;                 //!< Number of elements of each array
+        };
+
+    bool m_shm_ghost_updates; //!< True to update the ghosts of co-located ranks in shared memory
+    MPI_Comm m_node_comm;     //!< Communicator of the ranks on this node
+    MPI_Win m_shm_win;        //!< Shared memory window of the ranks on this node
+    SharedGhostHeader* m_shm_header; //!< Header of the window of this rank
+    uint64_t m_shm_seq;              //!< Sequence number of the current ghost update
+
+    //! Window header of the neighbor in each direction (nullptr if on another node)
+    SharedGhostHeader* m_shm_send_header[6];
+    SharedGhostHeader* m_shm_recv_header[6]; //!< Window header of the rank we receive from
+
+    //! Get the field arrays that follow a window header
+    static Scalar4* getSharedGhostData(SharedGhostHeader* header, unsigned int field)
+        {
+        size_t header_size = (sizeof(SharedGhostHeader) + sizeof(Scalar4) - 1) / sizeof(Scalar4);
+        return reinterpret_cast<Scalar4*>(header) + header_size + size_t(field) * header->capacity;
+        }
+
+    //! Allocate the window and find the co-located neighbors
+    void initSharedGhostWindow(unsigned int n_send_tot);
+
+    //! Free the shared memory window
+    void freeSharedGhostWindow();
+
+    //! Write a range of the copy list of one direction into the shared memory window
+    void packSharedGhostUpdate(unsigned int dir, unsigned int first, unsigned int last);
+
+    //! Copy a range of the ghosts of one direction from the neighbor's window
+    void unpackSharedGhostUpdate(unsigned int dir, unsigned int first, unsigned int last);
+
+    /* Compressed ghost position updates */
+    unsigned int m_ghost_position_bits; //!< Bits per coordinate of the ghost positions (0 == full)
+    bool m_ghost_ref_valid;             //!< True when the reference positions match the ghosts
+    std::vector<Scalar3> m_ghost_send_ref[6]; //!< Positions of the copy lists in the last exchange
+    std::vector<Scalar3> m_ghost_recv_ref;    //!< Positions of the ghosts in the last exchange
+
+    //! Compressed positions sent and received for each direction and part (index 2 * dir + part)
+    std::vector<char> m_ghost_pos_sendbuf[12];
+    std::vector<char> m_ghost_pos_recvbuf[12];
+
+    //! Test if the ghost updates send compressed positions
+    bool useCompressedGhostPositions() const
+        {
+        return m_ghost_position_bits != 0 && m_ghost_ref_valid;
+        }
+
+    //! Store the reference positions of the compressed ghost updates after a ghost exchange
+    void setGhostReference();
+
+    /* Skipping unchanged ghost fields */
+    bool m_skip_unchanged_ghost_fields; //!< True to skip fields that no rank changed
+    bool m_overlap_ghost_updates;       //!< True to overlap ghost updates with the force compute
+    CommFlags m_update_flags;           //!< Fields sent by the current ghost update
+
+    //! Write counts of the velocity and orientation arrays when the ghosts last received them
+    uint64_t m_ghost_write_count[2];
+    bool m_ghost_field_valid[2]; //!< True when the ghost velocities / orientations are current
+
+    //! Select the fields of the next ghost update
+    void selectGhostUpdateFields();
+
+    //! Record the write counts of the fields that a ghost communication sent
+    void recordGhostFields(CommFlags sent);
+
+    //! Post the messages of the compressed positions of a range of the copy list
+    void postCompressedGhostPositions(unsigned int dir,
+                                      unsigned int part,
+                                      unsigned int first,
+                                      unsigned int last,
+                                      unsigned int n_recv,
+                                      int tag,
+                                      std::vector<MPI_Request>& reqs);
+
+    //! Write the received compressed positions to the particle data
+    void
+    unpackCompressedGhostPositions(unsigned int dir, unsigned int part, unsigned int recv_idx);
+
+    /* Deferred migration */
+    Scalar m_migration_margin;                //!< Extra ghost layer width that defers migration
+    std::vector<Scalar3> m_migration_ref_pos; //!< Local particle positions after the last migration
+
+    //! Store the positions of the local particles after a migration
+    void setMigrationReference();
+
+    //! Collectively test whether all particles stayed within half the margin since the migration
+    bool canDeferMigration();
+
     /* Bonds communication */
     bool m_bonds_changed; //!< True if bond information needs to be refreshed
     void setBondsChanged()
@@ -714,6 +1057,16 @@ class PYBIND11_EXPORT Communicator
         m_meshtriangle_comm; //!< Communication helper for mesh triangles
     friend class GroupCommunicator<TriangleData>;
 
+    std::vector<char> m_group_msg_sendbuf; //!< Aggregated send buffer of the group migration
+    std::vector<char> m_group_msg_recvbuf; //!< Aggregated receive buffer of the group migration
+
+    //! Migrate the groups of all group types
+    void migrateGroups();
+
+    //! Exchange one phase of the group migration of several group types with the neighbors
+    void exchangeGroupMessages(const std::vector<GroupMigrationBuffers*>& buffers,
+                               unsigned int phase);
+
     //! Helper function to initialize adjacency arrays
     void initializeNeighborArrays();
 
@@ -12,9 +12,26 @@
 #include "System.h"
 
 #include <algorithm>
+#include <stdexcept>
 
 namespace hoomd
     {
+#ifdef ENABLE_NCCL
+namespace
+    {
+//! Throw an exception when a NCCL call fails
+void checkNCCLError(ncclResult_t result, const char* file, unsigned int line)
+    {
+    if (result != ncclSuccess)
+        {
+        std::ostringstream s;
+        s << "NCCL error: " << ncclGetErrorString(result) << " before " << file << ":" << line;
+        throw std::runtime_error(s.str());
+        }
+    }
+    } // end anonymous namespace
+#endif
+
 //! Constructor
 CommunicatorGPU::CommunicatorGPU(std::shared_ptr<SystemDefinition> sysdef,
                                  std::shared_ptr<DomainDecomposition> decomposition)
@@ -42,6 +59,27 @@ CommunicatorGPU::CommunicatorGPU(std::shared_ptr<SystemDefinition> sysdef,
 
     // create cuda event
     hipEventCreateWithFlags(&m_event, hipEventDisableTiming);
+
+#ifdef ENABLE_NCCL
+    // NCCL communicators drive one device per rank
+    if (m_exec_conf->getNumActiveGPUs() == 1)
+        {
+        int rank, n_ranks;
+        MPI_Comm_rank(m_mpi_comm, &rank);
+        MPI_Comm_size(m_mpi_comm, &n_ranks);
+
+        ncclUniqueId nccl_id;
+        if (rank == 0)
+            {
+            checkNCCLError(ncclGetUniqueId(&nccl_id), __FILE__, __LINE__);
+            }
+        MPI_Bcast(&nccl_id, sizeof(nccl_id), MPI_BYTE, 0, m_mpi_comm);
+        checkNCCLError(ncclCommInitRank(&m_nccl_comm, n_ranks, nccl_id, rank),
+                       __FILE__,
+                       __LINE__);
+        m_exec_conf->msg->notice(3) << "CommunicatorGPU: using NCCL for ghost updates" << std::endl;
+        }
+#endif
     }
 
 //! Destructor
@@ -49,6 +87,13 @@ CommunicatorGPU::~CommunicatorGPU()
     {
     m_exec_conf->msg->notice(5) << "Destroying CommunicatorGPU";
     hipEventDestroy(m_event);
+
+#ifdef ENABLE_NCCL
+    if (m_nccl_comm)
+        {
+        ncclCommDestroy(m_nccl_comm);
+        }
+#endif
     }
 
 void CommunicatorGPU::updateMeshDefinition()
@@ -2054,6 +2099,45 @@ void CommunicatorGPU::removeGhostParticleTags()
     m_ghosts_added = 0;
     }
 
+/*! \param shrink_fraction Fraction of the allocated size below which the buffers shrink
+ */
+void CommunicatorGPU::shrinkBuffers(Scalar shrink_fraction)
+    {
+    Communicator::shrinkBuffers(shrink_fraction);
+
+    m_gpu_sendbuf.shrink(shrink_fraction);
+    m_gpu_recvbuf.shrink(shrink_fraction);
+    m_comm_flags.shrink(shrink_fraction);
+    m_send_keys.shrink(shrink_fraction);
+
+    m_tag_ghost_sendbuf.shrink(shrink_fraction);
+    m_tag_ghost_recvbuf.shrink(shrink_fraction);
+    m_pos_ghost_sendbuf.shrink(shrink_fraction);
+    m_pos_ghost_recvbuf.shrink(shrink_fraction);
+    m_vel_ghost_sendbuf.shrink(shrink_fraction);
+    m_vel_ghost_recvbuf.shrink(shrink_fraction);
+    m_charge_ghost_sendbuf.shrink(shrink_fraction);
+    m_charge_ghost_recvbuf.shrink(shrink_fraction);
+    m_diameter_ghost_sendbuf.shrink(shrink_fraction);
+    m_diameter_ghost_recvbuf.shrink(shrink_fraction);
+    m_body_ghost_sendbuf.shrink(shrink_fraction);
+    m_body_ghost_recvbuf.shrink(shrink_fraction);
+    m_image_ghost_sendbuf.shrink(shrink_fraction);
+    m_image_ghost_recvbuf.shrink(shrink_fraction);
+    m_orientation_ghost_sendbuf.shrink(shrink_fraction);
+    m_orientation_ghost_recvbuf.shrink(shrink_fraction);
+    m_netforce_ghost_sendbuf.shrink(shrink_fraction);
+    m_netforce_ghost_recvbuf.shrink(shrink_fraction);
+    m_nettorque_ghost_sendbuf.shrink(shrink_fraction);
+    m_nettorque_ghost_recvbuf.shrink(shrink_fraction);
+    m_netvirial_ghost_sendbuf.shrink(shrink_fraction);
+    m_netvirial_ghost_recvbuf.shrink(shrink_fraction);
+
+    m_ghost_idx_adj.shrink(shrink_fraction);
+    m_ghost_neigh.shrink(shrink_fraction);
+    m_ghost_plan.shrink(shrink_fraction);
+    }
+
 //! Build a ghost particle list, exchange ghost particle data with neighboring processors
 void CommunicatorGPU::exchangeGhosts()
     {
@@ -3016,6 +3100,14 @@ void CommunicatorGPU::beginUpdateGhosts(uint64_t timestep)
             first_idx += m_n_recv_ghosts_tot[istage];
             }
 
+#ifdef ENABLE_NCCL
+        if (m_nccl_comm)
+            {
+            // the transfers complete in stream order before the buffers are unpacked below
+            exchangeGhostUpdatesNCCL(stage, flags);
+            }
+        else
+#endif
             {
             unsigned int offs = 0;
             // access particle data
@@ -3231,6 +3323,98 @@ void CommunicatorGPU::beginUpdateGhosts(uint64_t timestep)
         } // end main communication loop
     }
 
+#ifdef ENABLE_NCCL
+/*! \param stage Communication stage
+    \param flags Fields to update
+
+    Enqueue one send and one receive per neighbor and field on the default stream, in the same
+    order on all ranks so that the NCCL operations between each pair of ranks match.
+*/
+void CommunicatorGPU::exchangeGhostUpdatesNCCL(unsigned int stage, const CommFlags& flags)
+    {
+    ArrayHandle<Scalar4> d_pos_ghost_sendbuf(m_pos_ghost_sendbuf,
+                                             access_location::device,
+                                             access_mode::read);
+    ArrayHandle<Scalar4> d_vel_ghost_sendbuf(m_vel_ghost_sendbuf,
+                                             access_location::device,
+                                             access_mode::read);
+    ArrayHandle<Scalar4> d_orientation_ghost_sendbuf(m_orientation_ghost_sendbuf,
+                                                     access_location::device,
+                                                     access_mode::read);
+    ArrayHandle<Scalar4> d_pos_ghost_recvbuf(m_pos_ghost_recvbuf,
+                                             access_location::device,
+                                             access_mode::overwrite);
+    ArrayHandle<Scalar4> d_vel_ghost_recvbuf(m_vel_ghost_recvbuf,
+                                             access_location::device,
+                                             access_mode::overwrite);
+    ArrayHandle<Scalar4> d_orientation_ghost_recvbuf(m_orientation_ghost_recvbuf,
+                                                     access_location::device,
+                                                     access_mode::overwrite);
+
+    ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
+                                                 access_location::host,
+                                                 access_mode::read);
+    ArrayHandle<unsigned int> h_ghost_begin(m_ghost_begin,
+                                            access_location::host,
+                                            access_mode::read);
+
+    std::vector<const Scalar4*> send_bufs;
+    std::vector<Scalar4*> recv_bufs;
+    if (flags[comm_flag::position])
+        {
+        send_bufs.push_back(d_pos_ghost_sendbuf.data);
+        recv_bufs.push_back(d_pos_ghost_recvbuf.data);
+        }
+    if (flags[comm_flag::velocity])
+        {
+        send_bufs.push_back(d_vel_ghost_sendbuf.data);
+        recv_bufs.push_back(d_vel_ghost_recvbuf.data);
+        }
+    if (flags[comm_flag::orientation])
+        {
+        send_bufs.push_back(d_orientation_ghost_sendbuf.data);
+        recv_bufs.push_back(d_orientation_ghost_recvbuf.data);
+        }
+
+    checkNCCLError(ncclGroupStart(), __FILE__, __LINE__);
+    for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
+        {
+        int neighbor = h_unique_neighbors.data[ineigh];
+        size_t n_send = m_n_send_ghosts[stage][ineigh];
+        size_t n_recv = m_n_recv_ghosts[stage][ineigh];
+        size_t send_offset = h_ghost_begin.data[ineigh + stage * m_n_unique_neigh];
+        size_t recv_offset = m_ghost_offs[stage][ineigh];
+
+        for (size_t i = 0; i < send_bufs.size(); i++)
+            {
+            if (n_send)
+                {
+                checkNCCLError(ncclSend(send_bufs[i] + send_offset,
+                                        n_send * sizeof(Scalar4),
+                                        ncclChar,
+                                        neighbor,
+                                        m_nccl_comm,
+                                        0),
+                               __FILE__,
+                               __LINE__);
+                }
+            if (n_recv)
+                {
+                checkNCCLError(ncclRecv(recv_bufs[i] + recv_offset,
+                                        n_recv * sizeof(Scalar4),
+                                        ncclChar,
+                                        neighbor,
+                                        m_nccl_comm,
+                                        0),
+                               __FILE__,
+                               __LINE__);
+                }
+            }
+        }
+    checkNCCLError(ncclGroupEnd(), __FILE__, __LINE__);
+    }
+#endif
+
 /*! Finish ghost update
  *
  * \param timestep The time step
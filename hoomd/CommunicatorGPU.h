@@ -22,6 +22,14 @@
 #include <pybind11/pybind11.h>
 #endif
 
+#ifdef ENABLE_NCCL
+#if defined(__HIP_PLATFORM_NVCC__)
+#include <nccl.h>
+#else
+#include <rccl/rccl.h>
+#endif
+#endif
+
 /*! \ingroup communication
  */
 
@@ -29,6 +37,11 @@ namespace hoomd
     {
 //! Class that handles MPI communication (GPU version)
 /*! CommunicatorGPU is the GPU implementation of the base communication class.
+
+    In builds with ENABLE_NCCL, the per-step ghost updates send the packed buffers directly from
+    device memory with NCCL (RCCL on AMD GPUs) on the default stream. The host does not wait for
+    the transfers, so the update overlaps with other work on the host and may be captured in a
+    graph. Ghost exchange, particle migration, and the reverse force communication use MPI.
  */
 class PYBIND11_EXPORT CommunicatorGPU : public Communicator
     {
@@ -62,6 +75,9 @@ class PYBIND11_EXPORT CommunicatorGPU : public Communicator
     //! Build a ghost particle list, exchange ghost particle data with neighboring processors
     virtual void exchangeGhosts();
 
+    //! Release allocated memory that the communication buffers do not use
+    virtual void shrinkBuffers(Scalar shrink_fraction);
+
     /*! Communicate the net particle force
      * \parm timestep The time step
      */
@@ -264,6 +280,14 @@ class PYBIND11_EXPORT CommunicatorGPU : public Communicator
 
     hipEvent_t m_event; //!< CUDA event for synchronization
 
+#ifdef ENABLE_NCCL
+    //! NCCL communicator for ghost updates (null when not in use)
+    ncclComm_t m_nccl_comm = nullptr;
+
+    //! Send and receive the packed ghost updates of one stage in stream order with NCCL
+    void exchangeGhostUpdatesNCCL(unsigned int stage, const CommFlags& flags);
+#endif
+
     //! Helper function to allocate various buffers
     void allocateBuffers();
 
@@ -13,6 +13,7 @@
 #include "Communicator.h"
 #endif
 
+#include <algorithm>
 #include <limits>
 #include <stdexcept>
 
@@ -75,12 +76,19 @@ DCDDumpWriter::DCDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
     {
     m_exec_conf->msg->notice(5) << "Constructing DCDDumpWriter: " << fname << " " << period << " "
                                 << overwrite << endl;
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        m_gather_tag_order = GatherTagOrder(m_exec_conf->getMPICommunicator());
+        }
+#endif
     }
 
 //! Initializes the output file for writing
 void DCDDumpWriter::initFileIO(uint64_t timestep)
     {
-    m_staging_buffer = new float[m_pdata->getNGlobal()];
+    m_staging_buffer.resize(m_group->getNumMembersGlobal());
     m_is_initialized = true;
 
     m_nglobal = m_pdata->getNGlobal();
@@ -137,7 +145,6 @@ DCDDumpWriter::~DCDDumpWriter()
     if (m_is_initialized)
         {
         m_file.close();
-        delete[] m_staging_buffer;
         }
     }
 
@@ -149,16 +156,21 @@ DCDDumpWriter::~DCDDumpWriter()
 void DCDDumpWriter::analyze(uint64_t timestep)
     {
     Analyzer::analyze(timestep);
-    // take particle data snapshot
-    SnapshotParticleData<Scalar> snapshot;
-
-    m_pdata->takeSnapshot(snapshot);
+    fill_local_positions();
+    const vec3<float>* pos = m_local_pos.data();
 
 #ifdef ENABLE_MPI
-    // if we are not the root processor, do not perform file I/O
-    if (m_sysdef->isDomainDecomposed() && !m_exec_conf->isRoot())
+    if (m_sysdef->isDomainDecomposed())
         {
-        return;
+        m_gather_tag_order.setLocalTagsSorted(m_local_tag);
+        m_gather_tag_order.gatherArray(m_global_pos, m_local_pos);
+
+        // if we are not the root processor, do not perform file I/O
+        if (!m_exec_conf->isRoot())
+            {
+            return;
+            }
+        pos = m_global_pos.data();
         }
 #endif
 
@@ -192,7 +204,7 @@ void DCDDumpWriter::analyze(uint64_t timestep)
     // write the data for the current time step
     m_file.seekp(0, std::ios_base::end);
     write_frame_header(m_file);
-    write_frame_data(m_file, snapshot);
+    write_frame_data(m_file, pos);
 
     // update the header with the number of frames written
     m_num_frames_written++;
@@ -308,87 +320,123 @@ void DCDDumpWriter::write_frame_header(std::fstream& file)
         }
     }
 
-/*! \param file File to write to
-    \param snapshot Snapshot to write
-    Writes the actual particle positions for all particles at the current time step
+/*! Read the positions of the local group members directly from the ParticleData, apply the unwrap
+    options, and store the output coordinates in m_local_pos in ascending tag order.
 */
-void DCDDumpWriter::write_frame_data(std::fstream& file,
-                                     const SnapshotParticleData<Scalar>& snapshot)
+void DCDDumpWriter::fill_local_positions()
     {
-    // we need to unsort the positions and write in tag order
-    assert(m_staging_buffer);
+    // rebuild the group index before accessing the tag array
+    unsigned int n_local = m_group->getNumMembers();
 
-    BoxDim box = m_pdata->getGlobalBox();
-
-    unsigned int nparticles = m_group->getNumMembersGlobal();
+    ArrayHandle<unsigned int> h_index(m_group->getIndexArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
 
-    // Create a tmp copy of the particle data and unwrap particles
-    std::vector<vec3<Scalar>> tmp_pos(snapshot.pos);
-    for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
+    m_local_order.resize(n_local);
+    for (unsigned int group_idx = 0; group_idx < n_local; group_idx++)
+        {
+        unsigned int idx = h_index.data[group_idx];
+        m_local_order[group_idx] = std::make_pair(h_tag.data[idx], idx);
+        }
+    std::sort(m_local_order.begin(), m_local_order.end());
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::read);
+
+    const BoxDim box = m_pdata->getGlobalBox();
+    const unsigned int n_local_and_ghosts = m_pdata->getN() + m_pdata->getNGhosts();
+
+    m_local_tag.resize(n_local);
+    m_local_pos.resize(n_local);
+    for (unsigned int i = 0; i < n_local; i++)
         {
-        unsigned int i = m_group->getMemberTag(group_idx);
+        unsigned int idx = m_local_order[i].second;
+        m_local_tag[i] = m_local_order[i].first;
 
+        Scalar3 pos = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z);
         if (m_unwrap_full)
             {
-            tmp_pos[i] = box.shift(tmp_pos[i], snapshot.image[i]);
+            pos = box.shift(pos, h_image.data[idx]);
+            }
+        else if (m_unwrap_rigid && h_body.data[idx] < MIN_FLOPPY)
+            {
+            // the central particle is either local or a ghost of a body with local constituents
+            unsigned int central_idx = h_rtag.data[h_body.data[idx]];
+            if (central_idx >= n_local_and_ghosts)
+                {
+                throw runtime_error("DCD: The central particle of a rigid body is not available.");
+                }
+            int3 body_img = h_image.data[central_idx];
+            int3 particle_img = h_image.data[idx];
+            int3 img_diff = make_int3(particle_img.x - body_img.x,
+                                      particle_img.y - body_img.y,
+                                      particle_img.z - body_img.z);
+
+            pos = box.shift(pos, img_diff);
             }
-        else if (m_unwrap_rigid && snapshot.body[i] < MIN_FLOPPY)
+
+        m_local_pos[i].x = float(pos.x);
+        m_local_pos[i].y = float(pos.y);
+        m_local_pos[i].z = float(pos.z);
+
+        // m_angle set to True turns on a hack where the particle orientation angle is written out
+        // to the z component this only works in 2D simulations, obviously
+        if (m_angle)
             {
-            unsigned int central_ptl_tag = snapshot.body[i];
-            int body_ix = snapshot.image[central_ptl_tag].x;
-            int body_iy = snapshot.image[central_ptl_tag].y;
-            int body_iz = snapshot.image[central_ptl_tag].z;
-            int3 particle_img = snapshot.image[i];
-            int3 img_diff = make_int3(particle_img.x - body_ix,
-                                      particle_img.y - body_iy,
-                                      particle_img.z - body_iz);
-
-            tmp_pos[i] = box.shift(tmp_pos[i], img_diff);
+            m_local_pos[i].z
+                = float(atan2(h_orientation.data[idx].w, h_orientation.data[idx].x) * 2);
             }
         }
+    }
 
-    // prepare x coords for writing, looping in tag order
+/*! \param file File to write to
+    \param pos Output coordinates of all group members in ascending tag order
+    Writes the actual particle positions for all particles at the current time step
+*/
+void DCDDumpWriter::write_frame_data(std::fstream& file, const vec3<float>* pos)
+    {
+    unsigned int nparticles = m_group->getNumMembersGlobal();
+    m_staging_buffer.resize(nparticles);
+
+    // prepare x coords for writing
     for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
         {
-        unsigned int i = m_group->getMemberTag(group_idx);
-        m_staging_buffer[group_idx] = float(tmp_pos[i].x);
+        m_staging_buffer[group_idx] = pos[group_idx].x;
         }
 
     // write x coords
     detail::write_int(file, (unsigned int)(nparticles * sizeof(float)));
-    file.write((char*)m_staging_buffer, nparticles * sizeof(float));
+    file.write((char*)m_staging_buffer.data(), nparticles * sizeof(float));
     detail::write_int(file, (unsigned int)(nparticles * sizeof(float)));
 
     // prepare y coords for writing
     for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
         {
-        unsigned int i = m_group->getMemberTag(group_idx);
-        m_staging_buffer[group_idx] = float(tmp_pos[i].y);
+        m_staging_buffer[group_idx] = pos[group_idx].y;
         }
 
     // write y coords
     detail::write_int(file, (unsigned int)(nparticles * sizeof(float)));
-    file.write((char*)m_staging_buffer, nparticles * sizeof(float));
+    file.write((char*)m_staging_buffer.data(), nparticles * sizeof(float));
     detail::write_int(file, (unsigned int)(nparticles * sizeof(float)));
 
     // prepare z coords for writing
     for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
         {
-        unsigned int i = m_group->getMemberTag(group_idx);
-        m_staging_buffer[group_idx] = float(tmp_pos[i].z);
-
-        // m_angle set to True turns on a hack where the particle orientation angle is written out
-        // to the z component this only works in 2D simulations, obviously
-        if (m_angle)
-            {
-            m_staging_buffer[group_idx]
-                = float(atan2(snapshot.orientation[i].v.z, snapshot.orientation[i].s) * 2);
-            }
+        m_staging_buffer[group_idx] = pos[group_idx].z;
         }
 
     // write z coords
     detail::write_int(file, (unsigned int)(nparticles * sizeof(float)));
-    file.write((char*)m_staging_buffer, nparticles * sizeof(float));
+    file.write((char*)m_staging_buffer.data(), nparticles * sizeof(float));
     detail::write_int(file, (unsigned int)(nparticles * sizeof(float)));
 
     // check for errors
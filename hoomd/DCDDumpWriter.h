@@ -10,6 +10,8 @@
 #include <fstream>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 /*! \file DCDDumpWriter.h
     \brief Declares the DCDDumpWriter class
@@ -45,6 +47,11 @@ namespace hoomd
     Due to a limitation in the DCD format, the time step period between calls to
     analyze() \b must be specified up front. If analyze() detects that this period is
     not being maintained, it will print a warning but continue.
+
+    analyze() reads the positions of the local group members directly from the ParticleData,
+    applies the unwrap options, and converts them to single precision in buffers that are reused
+    between frames. With domain decomposition, only these single precision coordinates are
+    gathered on the root rank.
     \ingroup analyzers
 */
 class PYBIND11_EXPORT DCDDumpWriter : public Analyzer
@@ -118,8 +125,18 @@ class PYBIND11_EXPORT DCDDumpWriter : public Analyzer
     bool m_is_initialized;  //!< True if file IO has been initialized
     unsigned int m_nglobal; //!< Initial number of particles
 
-    float* m_staging_buffer; //!< Buffer for staging particle positions in tag order
-    std::fstream m_file;     //!< The file object
+    std::vector<float> m_staging_buffer; //!< Buffer for staging particle positions in tag order
+    std::fstream m_file;                 //!< The file object
+
+    //! Tags and indices of the local group members
+    std::vector<std::pair<unsigned int, unsigned int>> m_local_order;
+    std::vector<unsigned int> m_local_tag; //!< Tags of the local group members in tag order
+    std::vector<vec3<float>> m_local_pos;  //!< Local output coordinates in tag order
+
+#ifdef ENABLE_MPI
+    std::vector<vec3<float>> m_global_pos; //!< Output coordinates of all group members in tag order
+    GatherTagOrder m_gather_tag_order;     //!< Gathers the output coordinates on the root rank
+#endif
 
     // helper functions
 
@@ -127,8 +144,10 @@ class PYBIND11_EXPORT DCDDumpWriter : public Analyzer
     void write_file_header(std::fstream& file);
     //! Writes the frame header
     void write_frame_header(std::fstream& file);
+    //! Computes the output coordinates of the local group members
+    void fill_local_positions();
     //! Writes the particle positions for a frame
-    void write_frame_data(std::fstream& file, const SnapshotParticleData<Scalar>& snapshot);
+    void write_frame_data(std::fstream& file, const vec3<float>* pos);
     //! Updates the file header
     void write_updated_header(std::fstream& file, uint64_t timestep);
     //! Initializes the output file for writing
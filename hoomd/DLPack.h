@@ -0,0 +1,99 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file DLPack.h
+    \brief Declares the DLPack tensor structures and helpers to export HOOMD buffers
+*/
+
+#ifndef __HOOMD_DLPACK_H__
+#define __HOOMD_DLPACK_H__
+
+#include <cstdint>
+#include <type_traits>
+
+namespace hoomd
+    {
+namespace detail
+    {
+/// Structures of the DLPack (https://dmlc.github.io/dlpack) v0.8 ABI
+/*! Frameworks such as PyTorch and JAX exchange tensors without copies through capsules that hold
+    a DLManagedTensor. These definitions follow the memory layout of dlpack.h, so that HOOMD can
+    export its buffers without depending on the header.
+*/
+namespace dlpack
+    {
+/// Kinds of devices that hold the tensor data
+enum DeviceType : int32_t
+    {
+    kDLCPU = 1,
+    kDLCUDA = 2,
+    kDLROCM = 10,
+    };
+
+/// Kinds of tensor elements
+enum DataTypeCode : uint8_t
+    {
+    kDLInt = 0,
+    kDLUInt = 1,
+    kDLFloat = 2,
+    };
+
+/// Device that holds the tensor data
+struct DLDevice
+    {
+    int32_t device_type; //!< DeviceType of the device
+    int32_t device_id;   //!< Index of the device
+    };
+
+/// Type of the tensor elements
+struct DLDataType
+    {
+    uint8_t code;   //!< DataTypeCode of the elements
+    uint8_t bits;   //!< Number of bits per element
+    uint16_t lanes; //!< Number of lanes per element (1 for scalars)
+    };
+
+/// Description of a strided tensor
+struct DLTensor
+    {
+    void* data;           //!< Pointer to the data
+    DLDevice device;      //!< Device that holds the data
+    int32_t ndim;         //!< Number of dimensions
+    DLDataType dtype;     //!< Type of the elements
+    int64_t* shape;       //!< Shape of the tensor
+    int64_t* strides;     //!< Strides of the tensor, in elements
+    uint64_t byte_offset; //!< Offset of the first element from data, in bytes
+    };
+
+/// Tensor with the context that owns its description
+struct DLManagedTensor
+    {
+    DLTensor dl_tensor;                     //!< The tensor
+    void* manager_ctx;                      //!< Context of the producer
+    void (*deleter)(DLManagedTensor* self); //!< Releases the context when the consumer is done
+    };
+
+/// Get the DLPack data type of an arithmetic type
+template<class T> DLDataType getDataType()
+    {
+    static_assert(std::is_arithmetic<T>::value, "DLPack tensors must hold arithmetic types.");
+
+    DLDataType dtype;
+    if (std::is_floating_point<T>::value)
+        dtype.code = kDLFloat;
+    else if (std::is_signed<T>::value)
+        dtype.code = kDLInt;
+    else
+        dtype.code = kDLUInt;
+    dtype.bits = uint8_t(8 * sizeof(T));
+    dtype.lanes = 1;
+    return dtype;
+    }
+
+    } // end namespace dlpack
+
+    } // end namespace detail
+
+    } // end namespace hoomd
+
+#endif // __HOOMD_DLPACK_H__
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <numeric>
 
 using namespace std;
@@ -32,7 +33,7 @@ DomainDecomposition::DomainDecomposition(std::shared_ptr<ExecutionConfiguration>
                                          unsigned int ny,
                                          unsigned int nz,
                                          bool twolevel)
-    : m_exec_conf(exec_conf), m_mpi_comm(m_exec_conf->getMPICommunicator())
+    : m_exec_conf(exec_conf), m_mpi_comm(m_exec_conf->getMPICommunicator()), m_staggered(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing DomainDecomposition" << endl;
 
@@ -61,7 +62,7 @@ DomainDecomposition::DomainDecomposition(std::shared_ptr<ExecutionConfiguration>
                                          const std::vector<Scalar>& fxs,
                                          const std::vector<Scalar>& fys,
                                          const std::vector<Scalar>& fzs)
-    : m_exec_conf(exec_conf), m_mpi_comm(m_exec_conf->getMPICommunicator())
+    : m_exec_conf(exec_conf), m_mpi_comm(m_exec_conf->getMPICommunicator()), m_staggered(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing DomainDecomposition" << endl;
 
@@ -145,11 +146,19 @@ void DomainDecomposition::initializeDomainGrid(Scalar3 L,
             findDecomposition(nranks, L, nx, ny, nz);
 
             // subdivide the local grid
-            subdivide(nranks / n_nodes, L, nx, ny, nz, nx_intra, ny_intra, nz_intra);
-
-            nx_node = nx / nx_intra;
-            ny_node = ny / ny_intra;
-            nz_node = nz / nz_intra;
+            if (subdivide(nranks / n_nodes, L, nx, ny, nz, nx_intra, ny_intra, nz_intra))
+                {
+                nx_node = nx / nx_intra;
+                ny_node = ny / ny_intra;
+                nz_node = nz / nz_intra;
+                }
+            else
+                {
+                m_exec_conf->msg->notice(2)
+                    << "No node-level subdivision of the " << nx << " x " << ny << " x " << nz
+                    << " domain grid, mapping ranks in sequential order." << std::endl;
+                m_twolevel = false;
+                }
             }
         else
             {
@@ -166,6 +175,7 @@ void DomainDecomposition::initializeDomainGrid(Scalar3 L,
         }
 
     // broadcast grid dimensions
+    bcast(m_twolevel, 0, m_mpi_comm);
     bcast(m_nx, 0, m_mpi_comm);
     bcast(m_ny, 0, m_mpi_comm);
     bcast(m_nz, 0, m_mpi_comm);
@@ -408,7 +418,9 @@ bool DomainDecomposition::findDecomposition(unsigned int nranks,
     }
 
 //! Find a two-level decomposition of the global grid
-void DomainDecomposition::subdivide(unsigned int n_node_ranks,
+/*! \returns true if the grid of every node divides the global grid evenly
+ */
+bool DomainDecomposition::subdivide(unsigned int n_node_ranks,
                                     Scalar3 L,
                                     unsigned int nx,
                                     unsigned int ny,
@@ -425,6 +437,7 @@ void DomainDecomposition::subdivide(unsigned int n_node_ranks,
     nx_intra = 1;
     ny_intra = 1;
     nz_intra = n_node_ranks;
+    bool found_subdivision = false;
 
     for (unsigned int nx_intra_try = 1; nx_intra_try <= n_node_ranks; nx_intra_try++)
         for (unsigned int ny_intra_try = 1; nx_intra_try * ny_intra_try <= n_node_ranks;
@@ -441,7 +454,10 @@ void DomainDecomposition::subdivide(unsigned int n_node_ranks,
                 nx_intra = nx_intra_try;
                 ny_intra = ny_intra_try;
                 nz_intra = nz_intra_try;
+                found_subdivision = true;
                 }
+
+    return found_subdivision;
     }
 
 /*! \param dir Spatial direction to find neighbor in
@@ -504,6 +520,12 @@ void DomainDecomposition::setCumulativeFractions(unsigned int dir,
         throw std::invalid_argument("Requested direction does not exist.");
         }
 
+    if (m_staggered && dir > 0)
+        {
+        throw std::invalid_argument(
+            "Set the cuts of a staggered domain decomposition with setStaggeredFractions.");
+        }
+
     bool changed = false;
     if (m_exec_conf->getRank() == root)
         {
@@ -570,6 +592,172 @@ void DomainDecomposition::setCumulativeFractions(unsigned int dir,
  * \param global_box The global simulation box
  * \returns The local simulation box for the current rank
  */
+/*!
+ * \param cum_frac_y Cumulative fractions along y of every x slab, each beginning with 0 and ending
+ *        with 1
+ * \param cum_frac_z Cumulative fractions along z of every (x, y) column, indexed by x + nx * y
+ * \param root Rank to broadcast the set fractions from
+ *
+ * The cut planes along x remain global and are set with setCumulativeFractions().
+ *
+ * \note Setting the staggered fractions is a collective call requiring all ranks to participate in
+ * order to keep the decomposition properly synchronized between ranks.
+ */
+void DomainDecomposition::setStaggeredFractions(const std::vector<std::vector<Scalar>>& cum_frac_y,
+                                                const std::vector<std::vector<Scalar>>& cum_frac_z,
+                                                unsigned int root)
+    {
+    bool valid = false;
+    std::vector<Scalar> flat_y;
+    std::vector<Scalar> flat_z;
+    if (m_exec_conf->getRank() == root)
+        {
+        valid = cum_frac_y.size() == m_nx && cum_frac_z.size() == m_nx * m_ny;
+        for (size_t i = 0; valid && i < cum_frac_y.size(); i++)
+            {
+            valid = cum_frac_y[i].size() == m_ny + 1;
+            flat_y.insert(flat_y.end(), cum_frac_y[i].begin(), cum_frac_y[i].end());
+            }
+        for (size_t i = 0; valid && i < cum_frac_z.size(); i++)
+            {
+            valid = cum_frac_z[i].size() == m_nz + 1;
+            flat_z.insert(flat_z.end(), cum_frac_z[i].begin(), cum_frac_z[i].end());
+            }
+        }
+
+    // sync the update from the root to all ranks
+    bcast(valid, root, m_mpi_comm);
+    if (!valid)
+        {
+        throw std::invalid_argument(
+            "Domain decomposition cannot change topology after construction.");
+        }
+
+    flat_y.resize(m_nx * (m_ny + 1));
+    flat_z.resize(m_nx * m_ny * (m_nz + 1));
+    MPI_Bcast(&flat_y[0], (int)flat_y.size(), MPI_HOOMD_SCALAR, root, m_mpi_comm);
+    MPI_Bcast(&flat_z[0], (int)flat_z.size(), MPI_HOOMD_SCALAR, root, m_mpi_comm);
+
+    std::vector<std::vector<Scalar>> staggered_frac_y(m_nx);
+    for (unsigned int i = 0; i < m_nx; i++)
+        {
+        staggered_frac_y[i].assign(flat_y.begin() + i * (m_ny + 1),
+                                   flat_y.begin() + (i + 1) * (m_ny + 1));
+        }
+    std::vector<std::vector<Scalar>> staggered_frac_z(m_nx * m_ny);
+    for (unsigned int i = 0; i < m_nx * m_ny; i++)
+        {
+        staggered_frac_z[i].assign(flat_z.begin() + i * (m_nz + 1),
+                                   flat_z.begin() + (i + 1) * (m_nz + 1));
+        }
+
+    auto is_valid = [](const std::vector<Scalar>& cum_frac)
+    {
+        return cum_frac.front() == Scalar(0.0) && cum_frac.back() == Scalar(1.0)
+               && std::adjacent_find(cum_frac.begin(), cum_frac.end(), std::greater_equal<Scalar>())
+                      == cum_frac.end();
+    };
+    if (!std::all_of(staggered_frac_y.begin(), staggered_frac_y.end(), is_valid)
+        || !std::all_of(staggered_frac_z.begin(), staggered_frac_z.end(), is_valid))
+        {
+        throw std::invalid_argument("Specified fractions are invalid.");
+        }
+
+    m_staggered_frac_y.swap(staggered_frac_y);
+    m_staggered_frac_z.swap(staggered_frac_z);
+    m_staggered = true;
+    }
+
+/*!
+ * \param dir Direction (0=x, 1=y, 2=z) to get fractions
+ * \param grid_pos Position in the grid that selects the slab (y) or column (z)
+ * \returns Array of cumulative fractions of global box length below the cut planes
+ */
+std::vector<Scalar> DomainDecomposition::getColumnCumulativeFractions(unsigned int dir,
+                                                                      uint3 grid_pos) const
+    {
+    if (!m_staggered || dir == 0)
+        return getCumulativeFractions(dir);
+    else if (dir == 1)
+        return m_staggered_frac_y[grid_pos.x];
+    else if (dir == 2)
+        return m_staggered_frac_z[grid_pos.x + m_nx * grid_pos.y];
+    else
+        {
+        throw std::runtime_error("comm: requested direction does not exist");
+        }
+    }
+
+void DomainDecomposition::getDomainFractions(uint3 grid_pos, Scalar3& lo, Scalar3& hi) const
+    {
+    lo.x = m_cumulative_frac_x[grid_pos.x];
+    hi.x = m_cumulative_frac_x[grid_pos.x + 1];
+    if (m_staggered)
+        {
+        const std::vector<Scalar>& frac_y = m_staggered_frac_y[grid_pos.x];
+        const std::vector<Scalar>& frac_z = m_staggered_frac_z[grid_pos.x + m_nx * grid_pos.y];
+        lo.y = frac_y[grid_pos.y];
+        hi.y = frac_y[grid_pos.y + 1];
+        lo.z = frac_z[grid_pos.z];
+        hi.z = frac_z[grid_pos.z + 1];
+        }
+    else
+        {
+        lo.y = m_cumulative_frac_y[grid_pos.y];
+        hi.y = m_cumulative_frac_y[grid_pos.y + 1];
+        lo.z = m_cumulative_frac_z[grid_pos.z];
+        hi.z = m_cumulative_frac_z[grid_pos.z + 1];
+        }
+    }
+
+/*! Two domains are adjacent when their extents overlap or touch in every direction, including
+ *  across the periodic boundaries. In a regular grid, these are the up to 26 domains around the
+ *  local domain. In a staggered grid, a domain may share a face with several domains.
+ *
+ * \returns Sorted ranks of the adjacent domains, excluding this rank
+ */
+std::vector<unsigned int> DomainDecomposition::getAdjacentRanks() const
+    {
+    Scalar3 lo, hi;
+    getDomainFractions(m_grid_pos, lo, hi);
+
+    // intervals in fractional coordinates touch when they overlap, possibly after a periodic shift
+    const Scalar tol(1e-6);
+    auto touches = [tol](Scalar a_lo, Scalar a_hi, Scalar b_lo, Scalar b_hi)
+    {
+        for (int shift = -1; shift <= 1; shift++)
+            {
+            if (b_lo + Scalar(shift) <= a_hi + tol && a_lo <= b_hi + Scalar(shift) + tol)
+                return true;
+            }
+        return false;
+    };
+
+    ArrayHandle<unsigned int> h_cart_ranks(m_cart_ranks, access_location::host, access_mode::read);
+
+    std::vector<unsigned int> ranks;
+    for (unsigned int k = 0; k < m_nz; k++)
+        for (unsigned int j = 0; j < m_ny; j++)
+            for (unsigned int i = 0; i < m_nx; i++)
+                {
+                uint3 pos = make_uint3(i, j, k);
+                Scalar3 other_lo, other_hi;
+                getDomainFractions(pos, other_lo, other_hi);
+
+                if (touches(lo.x, hi.x, other_lo.x, other_hi.x)
+                    && touches(lo.y, hi.y, other_lo.y, other_hi.y)
+                    && touches(lo.z, hi.z, other_lo.z, other_hi.z))
+                    {
+                    ranks.push_back(h_cart_ranks.data[m_index(i, j, k)]);
+                    }
+                }
+
+    std::sort(ranks.begin(), ranks.end());
+    ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+    ranks.erase(std::remove(ranks.begin(), ranks.end(), m_exec_conf->getRank()), ranks.end());
+    return ranks;
+    }
+
 const BoxDim DomainDecomposition::calculateLocalBox(const BoxDim& global_box)
     {
     // initialize local box with all properties of global box
@@ -577,14 +765,9 @@ const BoxDim DomainDecomposition::calculateLocalBox(const BoxDim& global_box)
     Scalar3 L = global_box.getL();
 
     // position of this domain in the grid
-    Scalar3 lo_cumulative_frac = make_scalar3(m_cumulative_frac_x[m_grid_pos.x],
-                                              m_cumulative_frac_y[m_grid_pos.y],
-                                              m_cumulative_frac_z[m_grid_pos.z]);
+    Scalar3 lo_cumulative_frac, hi_cumulative_frac;
+    getDomainFractions(m_grid_pos, lo_cumulative_frac, hi_cumulative_frac);
     Scalar3 lo = global_box.getLo() + lo_cumulative_frac * L;
-
-    Scalar3 hi_cumulative_frac = make_scalar3(m_cumulative_frac_x[m_grid_pos.x + 1],
-                                              m_cumulative_frac_y[m_grid_pos.y + 1],
-                                              m_cumulative_frac_z[m_grid_pos.z + 1]);
     Scalar3 hi = global_box.getLo() + hi_cumulative_frac * L;
 
     // set periodic flags
@@ -643,15 +826,19 @@ unsigned int DomainDecomposition::placeParticle(const BoxDim& global_box,
     else if (ix >= (int)m_nx)
         ix--;
 
-    it = std::lower_bound(m_cumulative_frac_y.begin(), m_cumulative_frac_y.end(), f.y);
-    int iy = int(it - 1 - m_cumulative_frac_y.begin());
+    // the cuts along y and z depend on the slab and column in a staggered decomposition
+    const std::vector<Scalar>& frac_y = m_staggered ? m_staggered_frac_y[ix] : m_cumulative_frac_y;
+    std::vector<Scalar>::const_iterator cit = std::lower_bound(frac_y.begin(), frac_y.end(), f.y);
+    int iy = int(cit - 1 - frac_y.begin());
     if (iy < 0)
         iy++;
     else if (iy >= (int)m_ny)
         iy--;
 
-    it = std::lower_bound(m_cumulative_frac_z.begin(), m_cumulative_frac_z.end(), f.z);
-    int iz = int(it - 1 - m_cumulative_frac_z.begin());
+    const std::vector<Scalar>& frac_z
+        = m_staggered ? m_staggered_frac_z[ix + m_nx * iy] : m_cumulative_frac_z;
+    cit = std::lower_bound(frac_z.begin(), frac_z.end(), f.z);
+    int iz = int(cit - 1 - frac_z.begin());
     if (iz < 0)
         iz++;
     else if (iz >= (int)m_nz)
@@ -662,13 +849,28 @@ unsigned int DomainDecomposition::placeParticle(const BoxDim& global_box,
     return rank;
     }
 
+/*! Ranks that share memory belong to the same node. The node of a rank is identified by its
+    processor name and the lowest rank on the node, so that ranks on distinct nodes with the same
+    processor name (e.g. in containers) are not grouped together.
+ */
 void DomainDecomposition::findCommonNodes()
     {
     // get MPI node name
     char procname[MPI_MAX_PROCESSOR_NAME];
     int len;
     MPI_Get_processor_name(procname, &len);
-    std::string s(procname, len);
+
+    // find the ranks that share memory with this rank
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(m_mpi_comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+    unsigned int rank = m_exec_conf->getRank();
+    unsigned int node_leader;
+    MPI_Allreduce(&rank, &node_leader, 1, MPI_UNSIGNED, MPI_MIN, node_comm);
+    MPI_Comm_free(&node_comm);
+
+    std::ostringstream oss;
+    oss << std::string(procname, len) << ":" << node_leader;
+    std::string s = oss.str();
 
     // collect node names from all ranks on rank zero
     std::vector<std::string> nodes;
@@ -731,7 +933,8 @@ void export_DomainDecomposition(pybind11::module& m)
                             const std::vector<Scalar>&,
                             const std::vector<Scalar>&,
                             const std::vector<Scalar>&>())
-        .def("getCumulativeFractions", &DomainDecomposition::getCumulativeFractions);
+        .def("getCumulativeFractions", &DomainDecomposition::getCumulativeFractions)
+        .def("getAdjacentRanks", &DomainDecomposition::getAdjacentRanks);
     }
     } // end namespace detail
 
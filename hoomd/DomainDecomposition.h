@@ -44,6 +44,13 @@ namespace hoomd
  * box is covered. If the specified number of ranks does not match the number that is available,
  * behavior is reverted to the normal default with uniform cuts along each dimension.
  *
+ *  A staggered decomposition keeps the cut planes along x, but every x slab has its own cuts
+ * along y, and every (x, y) column has its own cuts along z. The cuts follow dense regions that are
+ * not aligned with the global planes, such as droplets or thin films. setStaggeredFractions()
+ * enables the staggered decomposition and getAdjacentRanks() lists the neighbors of the now
+ * irregular grid. The Communicator does not support staggered decompositions yet, so
+ * setStaggeredFractions() is not exported to Python.
+ *
  *  The initialization of the domain decomposition scheme is performed in the constructor.
  */
 class PYBIND11_EXPORT DomainDecomposition
@@ -155,6 +162,23 @@ class PYBIND11_EXPORT DomainDecomposition
                                 const std::vector<Scalar>& cum_frac,
                                 unsigned int root);
 
+    //! Collectively set independent cut positions in every slab and column from a given rank
+    void setStaggeredFractions(const std::vector<std::vector<Scalar>>& cum_frac_y,
+                               const std::vector<std::vector<Scalar>>& cum_frac_z,
+                               unsigned int root);
+
+    //! Determine whether the cut positions differ between slabs or columns of the grid
+    bool isStaggered() const
+        {
+        return m_staggered;
+        }
+
+    //! Get the cumulative box fractions along a dimension in the column of a grid position
+    std::vector<Scalar> getColumnCumulativeFractions(unsigned int dir, uint3 grid_pos) const;
+
+    //! Get the ranks of all domains that share a face, edge, or corner with the local domain
+    std::vector<unsigned int> getAdjacentRanks() const;
+
     //! Get the dimensions of the local simulation box
     const BoxDim calculateLocalBox(const BoxDim& global_box);
 
@@ -195,7 +219,7 @@ class PYBIND11_EXPORT DomainDecomposition
                            unsigned int& nz);
 
     //! Find a two-level decomposition of the global grid
-    void subdivide(unsigned int n_node_ranks,
+    bool subdivide(unsigned int n_node_ranks,
                    Scalar3 L,
                    unsigned int nx,
                    unsigned int ny,
@@ -228,7 +252,16 @@ class PYBIND11_EXPORT DomainDecomposition
     std::vector<Scalar> m_cumulative_frac_x; //!< Cumulative fractions in x below cut plane index
     std::vector<Scalar> m_cumulative_frac_y; //!< Cumulative fractions in y below cut plane index
     std::vector<Scalar> m_cumulative_frac_z; //!< Cumulative fractions in z below cut plane index
-#endif                                       // ENABLE_MPI
+
+    bool m_staggered; //!< True when every slab and column has its own cut positions
+    std::vector<std::vector<Scalar>>
+        m_staggered_frac_y; //!< Cumulative fractions in y of every x slab
+    std::vector<std::vector<Scalar>>
+        m_staggered_frac_z; //!< Cumulative fractions in z of every (x, y) column
+
+    //! Get the fractional coordinates of the corners of a domain
+    void getDomainFractions(uint3 grid_pos, Scalar3& lo, Scalar3& hi) const;
+#endif // ENABLE_MPI
     };
 
 namespace detail
@@ -3,6 +3,7 @@
 
 #include "ExecutionConfiguration.h"
 #include "HOOMDVersion.h"
+#include "MemoryTracker.h"
 
 #ifdef ENABLE_HIP
 #include <hip/hip_runtime.h>
@@ -23,10 +24,15 @@
 #include <stdexcept>
 #include <thread>
 
+#if defined(ENABLE_TBB) && defined(__linux__)
+#include <sched.h>
+#endif
+
 using namespace std;
 
 #if defined(ENABLE_HIP)
 #include "CachedAllocator.h"
+#include "MemoryPool.h"
 #endif
 
 /*! \file ExecutionConfiguration.cc
@@ -195,6 +201,8 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
                                    << endl;
                     }
                 }
+
+            enablePeerAccess();
             }
 
         // select first device by default
@@ -208,6 +216,8 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
             new CachedAllocator(false, (unsigned int)(0.5f * (float)dev_prop.totalGlobalMem)));
         m_cached_alloc_managed.reset(
             new CachedAllocator(true, (unsigned int)(0.5f * (float)dev_prop.totalGlobalMem)));
+
+        initializeMemoryPools();
         }
 #endif
 
@@ -272,11 +282,256 @@ ExecutionConfiguration::~ExecutionConfiguration()
     // the destructors of these objects can issue hip calls, so free them before the device reset
     m_cached_alloc.reset();
     m_cached_alloc_managed.reset();
+    m_device_pools.clear();
+    m_host_pool.reset();
+    m_managed_pool.reset();
 #endif
     }
 
+#ifdef ENABLE_TBB
+namespace
+    {
+#ifdef __linux__
+/// Pin the threads that enter a task arena to the CPUs of the process
+/*! The CPUs are those in the affinity mask of the process when the observer is created, so MPI
+    launchers that bind each rank to a set of cores keep the threads of each rank on its cores.
+    Arena slot i runs on the i-th CPU of the mask (modulo the number of CPUs). parallel_loop()
+    assigns the same part of a loop to the same slot every time, so each CPU touches the same pages
+    of the arrays in every step.
+
+    The main thread enters the arena for each parallel loop. It is pinned while in the arena and
+    its original affinity is restored when it leaves.
+*/
+class ThreadPinningObserver : public tbb::task_scheduler_observer
+    {
+    public:
+    ThreadPinningObserver(tbb::task_arena& arena) : tbb::task_scheduler_observer(arena)
+        {
+        CPU_ZERO(&m_process_mask);
+        sched_getaffinity(0, sizeof(cpu_set_t), &m_process_mask);
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+            {
+            if (CPU_ISSET(cpu, &m_process_mask))
+                m_cpus.push_back(cpu);
+            }
+        observe(true);
+        }
+
+    ~ThreadPinningObserver()
+        {
+        observe(false);
+        }
+
+    void on_scheduler_entry(bool is_worker) override
+        {
+        int slot = tbb::this_task_arena::current_thread_index();
+        if (slot < 0 || m_cpus.empty())
+            return;
+
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        CPU_SET(m_cpus[slot % m_cpus.size()], &mask);
+        sched_setaffinity(0, sizeof(cpu_set_t), &mask);
+        }
+
+    void on_scheduler_exit(bool is_worker) override
+        {
+        if (!is_worker)
+            sched_setaffinity(0, sizeof(cpu_set_t), &m_process_mask);
+        }
+
+    private:
+    cpu_set_t m_process_mask;
+    std::vector<int> m_cpus;
+    };
+#endif
+    } // end anonymous namespace
+
+void ExecutionConfiguration::updateThreadPinning()
+    {
+    m_thread_pinning.reset();
+    if (!m_thread_affinity || !m_task_arena)
+        return;
+
+#ifdef __linux__
+    m_thread_pinning = std::unique_ptr<tbb::task_scheduler_observer>(
+        new ThreadPinningObserver(*m_task_arena));
+    msg->notice(3) << "Pinning " << m_num_threads << " TBB threads to CPUs" << endl;
+#else
+    msg->warning() << "Thread affinity is not supported on this platform, ignoring." << endl;
+#endif
+    }
+#endif
+
 #if defined(ENABLE_HIP)
 
+/*! The pools start disabled. Each pool frees the blocks it holds with the same calls that the
+    arrays use without a pool.
+*/
+void ExecutionConfiguration::initializeMemoryPools()
+    {
+    for (unsigned int idev = 0; idev < m_gpu_id.size(); ++idev)
+        {
+        m_device_pools.emplace_back(new detail::MemoryPool(
+            [](size_t num_bytes)
+            {
+                void* ptr = nullptr;
+                hipError_t error = hipMalloc(&ptr, num_bytes);
+                if (error == hipErrorMemoryAllocation)
+                    {
+                    // clear the error so that the pool can retry
+                    hipGetLastError();
+                    throw std::bad_alloc();
+                    }
+                else if (error != hipSuccess)
+                    {
+                    throw std::runtime_error(hipGetErrorString(error));
+                    }
+                return ptr;
+            },
+            [](void* ptr) { hipFree(ptr); }));
+        }
+
+    m_host_pool.reset(new detail::MemoryPool(
+        [](size_t num_bytes)
+        {
+            // at minimum, alignment needs to be 32 bytes for AVX
+            void* ptr = nullptr;
+            if (posix_memalign(&ptr, 32, num_bytes) != 0)
+                throw std::bad_alloc();
+            hipError_t error = hipHostRegister(ptr, num_bytes, hipHostRegisterDefault);
+            if (error != hipSuccess)
+                {
+                free(ptr);
+                throw std::runtime_error(hipGetErrorString(error));
+                }
+            return ptr;
+        },
+        [](void* ptr)
+        {
+            hipHostUnregister(ptr);
+            free(ptr);
+        }));
+
+    m_managed_pool.reset(new detail::MemoryPool(
+        [](size_t num_bytes)
+        {
+            void* ptr = nullptr;
+            hipError_t error = hipMallocManaged(&ptr, num_bytes, hipMemAttachGlobal);
+            if (error == hipErrorMemoryAllocation)
+                {
+                hipGetLastError();
+                throw std::bad_alloc();
+                }
+            else if (error != hipSuccess)
+                {
+                throw std::runtime_error(hipGetErrorString(error));
+                }
+            return ptr;
+        },
+        [](void* ptr) { hipFree(ptr); }));
+
+    for (auto& pool : m_device_pools)
+        pool->setEnabled(false);
+    m_host_pool->setEnabled(false);
+    m_managed_pool->setEnabled(false);
+    }
+
+/*! \param enable True to draw array allocations from the memory pools
+
+    Disabling the pools frees the cached blocks. Blocks that are still in use by arrays are freed
+    when the arrays release them.
+*/
+void ExecutionConfiguration::setMemoryPoolEnabled(bool enable)
+    {
+    if (exec_mode != GPU)
+        return;
+
+    m_memory_pool_enabled = enable;
+    for (auto& pool : m_device_pools)
+        pool->setEnabled(enable);
+    m_host_pool->setEnabled(enable);
+    m_managed_pool->setEnabled(enable);
+    }
+
+/*! \returns The pool of device memory on the current device, or nullptr when the memory pools are
+    disabled
+*/
+detail::MemoryPool* ExecutionConfiguration::getDeviceMemoryPool() const
+    {
+    if (!m_memory_pool_enabled)
+        return nullptr;
+
+    int device;
+    hipGetDevice(&device);
+    for (unsigned int idev = 0; idev < m_gpu_id.size(); ++idev)
+        {
+        if ((int)m_gpu_id[idev] == device)
+            return m_device_pools[idev].get();
+        }
+    return nullptr;
+    }
+
+/*! \returns The pool of page-locked (registered) host memory, or nullptr when the memory pools
+    are disabled
+*/
+detail::MemoryPool* ExecutionConfiguration::getHostMemoryPool() const
+    {
+    return m_memory_pool_enabled ? m_host_pool.get() : nullptr;
+    }
+
+/*! \returns The pool of managed memory, or nullptr when the memory pools are disabled
+ */
+detail::MemoryPool* ExecutionConfiguration::getManagedMemoryPool() const
+    {
+    return m_memory_pool_enabled ? m_managed_pool.get() : nullptr;
+    }
+
+void ExecutionConfiguration::releaseMemoryPools() const
+    {
+    for (auto& pool : m_device_pools)
+        pool->release();
+    if (m_host_pool)
+        m_host_pool->release();
+    if (m_managed_pool)
+        m_managed_pool->release();
+    }
+
+namespace
+    {
+/// Convert the statistics of a memory pool to a dictionary
+pybind11::dict memoryPoolStatsToDict(const detail::MemoryPool& pool)
+    {
+    const detail::MemoryPool::Stats stats = pool.getStats();
+    pybind11::dict result;
+    result["allocations"] = stats.n_allocations;
+    result["hits"] = stats.n_hits;
+    result["system_allocations"] = stats.n_system_allocations;
+    result["bytes_in_use"] = stats.bytes_in_use;
+    result["bytes_cached"] = stats.bytes_cached;
+    result["peak_bytes_in_use"] = stats.peak_bytes_in_use;
+    return result;
+    }
+    } // end anonymous namespace
+
+/*! \returns A dictionary with the statistics of the host and managed memory pools, and a list with
+    the statistics of the device memory pool of each active GPU
+*/
+pybind11::dict ExecutionConfiguration::getMemoryPoolStats() const
+    {
+    pybind11::dict result;
+    if (exec_mode != GPU)
+        return result;
+
+    pybind11::list device;
+    for (auto& pool : m_device_pools)
+        device.append(memoryPoolStatsToDict(*pool));
+    result["device"] = device;
+    result["host"] = memoryPoolStatsToDict(*m_host_pool);
+    result["managed"] = memoryPoolStatsToDict(*m_managed_pool);
+    return result;
+    }
+
 std::pair<unsigned int, unsigned int>
 ExecutionConfiguration::getComputeCapability(unsigned int idev) const
     {
@@ -488,6 +743,57 @@ void ExecutionConfiguration::scanGPUs()
         }
     }
 
+/*! Managed memory that one GPU accesses while it resides on another is read over the peer
+    interconnect (e.g. NVLink) when the devices have peer access. Without peer access, the driver
+    migrates the pages between the devices on every access.
+*/
+void ExecutionConfiguration::enablePeerAccess()
+    {
+    m_peer_access = true;
+    for (unsigned int idev = 0; idev < m_gpu_id.size(); ++idev)
+        {
+        hipSetDevice(m_gpu_id[idev]);
+        for (unsigned int jdev = 0; jdev < m_gpu_id.size(); ++jdev)
+            {
+            if (idev == jdev)
+                {
+                continue;
+                }
+
+            int can_access = 0;
+            hipDeviceCanAccessPeer(&can_access, m_gpu_id[idev], m_gpu_id[jdev]);
+            if (!can_access)
+                {
+                m_peer_access = false;
+                continue;
+                }
+
+            hipError_t error = hipDeviceEnablePeerAccess(m_gpu_id[jdev], 0);
+            if (error == hipErrorPeerAccessAlreadyEnabled)
+                {
+                // clear the error state
+                hipGetLastError();
+                }
+            else if (error != hipSuccess)
+                {
+                handleHIPError(error, __FILE__, __LINE__);
+                }
+            }
+        }
+
+    if (m_peer_access)
+        {
+        msg->notice(3) << "Enabled peer access between all active GPUs." << endl;
+        }
+    else
+        {
+        msg->warning() << "Not all active GPUs have peer access to each other. Multi-GPU "
+                          "execution will migrate memory pages between the devices."
+                       << endl;
+        msg->warning() << "Run one MPI rank per GPU for better performance." << endl;
+        }
+    }
+
 #endif
 
 /*! Print out GPU stats if running on the GPU, otherwise determine and print out the CPU stats
@@ -660,6 +966,50 @@ int ExecutionConfiguration::guessLocalRank()
 #endif
     }
 
+/*! \returns A list with one dictionary per group of allocations with the same tag, owner, and
+    element type. Each dictionary gives the ``tag``, ``owner``, ``type``, the number of
+    ``allocations``, and the ``host_bytes``, ``device_bytes``, and ``managed_bytes`` they hold.
+
+    The accounting includes all arrays in the process.
+*/
+pybind11::list ExecutionConfiguration::getMemoryUsage() const
+    {
+    pybind11::list result;
+    for (const auto& usage : detail::MemoryTracker::getUsage())
+        {
+        pybind11::dict entry;
+        entry["tag"] = usage.tag;
+        entry["owner"] = usage.owner;
+        entry["type"] = usage.type;
+        entry["allocations"] = usage.n_allocations;
+        entry["host_bytes"] = usage.bytes[detail::MemoryTracker::host];
+        entry["device_bytes"] = usage.bytes[detail::MemoryTracker::device];
+        entry["managed_bytes"] = usage.bytes[detail::MemoryTracker::managed];
+        result.append(entry);
+        }
+    return result;
+    }
+
+pybind11::tuple ExecutionConfiguration::getMemoryBytes() const
+    {
+    return pybind11::make_tuple(detail::MemoryTracker::getBytes(detail::MemoryTracker::host),
+                                detail::MemoryTracker::getBytes(detail::MemoryTracker::device),
+                                detail::MemoryTracker::getBytes(detail::MemoryTracker::managed));
+    }
+
+pybind11::tuple ExecutionConfiguration::getPeakMemoryBytes() const
+    {
+    return pybind11::make_tuple(
+        detail::MemoryTracker::getPeakBytes(detail::MemoryTracker::host),
+        detail::MemoryTracker::getPeakBytes(detail::MemoryTracker::device),
+        detail::MemoryTracker::getPeakBytes(detail::MemoryTracker::managed));
+    }
+
+void ExecutionConfiguration::resetPeakMemoryBytes() const
+    {
+    detail::MemoryTracker::resetPeakBytes();
+    }
+
 namespace detail
     {
 void export_ExecutionConfiguration(pybind11::module& m)
@@ -681,19 +1031,37 @@ void export_ExecutionConfiguration(pybind11::module& m)
         .def("getComputeCapability", &ExecutionConfiguration::getComputeCapability)
         .def("hipProfileStart", &ExecutionConfiguration::hipProfileStart)
         .def("hipProfileStop", &ExecutionConfiguration::hipProfileStop)
+        .def("setMemoryPoolEnabled", &ExecutionConfiguration::setMemoryPoolEnabled)
+        .def("memoryPoolEnabled", &ExecutionConfiguration::memoryPoolEnabled)
+        .def("releaseMemoryPools", &ExecutionConfiguration::releaseMemoryPools)
+        .def("getMemoryPoolStats", &ExecutionConfiguration::getMemoryPoolStats)
 #endif
         .def("getPartition", &ExecutionConfiguration::getPartition)
         .def("getNRanks", &ExecutionConfiguration::getNRanks)
         .def("getRank", &ExecutionConfiguration::getRank)
 #ifdef ENABLE_TBB
         .def("setNumThreads", &ExecutionConfiguration::setNumThreads)
+        .def("setThreadAffinity", &ExecutionConfiguration::setThreadAffinity)
+        .def("getThreadAffinity", &ExecutionConfiguration::getThreadAffinity)
 #endif
         .def("getNumThreads", &ExecutionConfiguration::getNumThreads)
         .def("setMemoryTracing", &ExecutionConfiguration::setMemoryTracing)
         .def("memoryTracingEnabled", &ExecutionConfiguration::memoryTracingEnabled)
+        .def("getMemoryUsage", &ExecutionConfiguration::getMemoryUsage)
+        .def("getMemoryBytes", &ExecutionConfiguration::getMemoryBytes)
+        .def("getPeakMemoryBytes", &ExecutionConfiguration::getPeakMemoryBytes)
+        .def("resetPeakMemoryBytes", &ExecutionConfiguration::resetPeakMemoryBytes)
         .def_static("getCapableDevices", &ExecutionConfiguration::getCapableDevices)
         .def_static("getScanMessages", &ExecutionConfiguration::getScanMessages)
-        .def("getActiveDevices", &ExecutionConfiguration::getActiveDevices);
+        .def("getActiveDevices", &ExecutionConfiguration::getActiveDevices)
+        .def("setAutotunerCache", &ExecutionConfiguration::setAutotunerCache)
+        .def("getAutotunerCache", &ExecutionConfiguration::getAutotunerCache)
+        .def("setAutotunerSuccessiveHalving",
+             &ExecutionConfiguration::setAutotunerSuccessiveHalving)
+        .def("getAutotunerSuccessiveHalving",
+             &ExecutionConfiguration::getAutotunerSuccessiveHalving)
+        .def("setAutotunerStopThreshold", &ExecutionConfiguration::setAutotunerStopThreshold)
+        .def("getAutotunerStopThreshold", &ExecutionConfiguration::getAutotunerStopThreshold);
 
     pybind11::enum_<ExecutionConfiguration::executionMode>(executionconfiguration, "executionMode")
         .value("GPU", ExecutionConfiguration::executionMode::GPU)
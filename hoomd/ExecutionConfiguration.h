@@ -14,6 +14,7 @@
 #include "MPIConfiguration.h"
 
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -28,8 +29,10 @@
 
 #ifdef ENABLE_TBB
 #include <tbb/task_arena.h>
+#include <tbb/task_scheduler_observer.h>
 #endif
 
+#include "AutotunerCache.h"
 #include "Messenger.h"
 
 /*! \file ExecutionConfiguration.h
@@ -48,6 +51,11 @@ namespace hoomd
 #if defined(ENABLE_HIP)
 //! Forward declaration
 class CachedAllocator;
+
+namespace detail
+    {
+class MemoryPool;
+    } // end namespace detail
 #endif
 
 //! Defines the execution configuration for the simulation
@@ -258,8 +266,24 @@ class PYBIND11_EXPORT ExecutionConfiguration
     //! set number of TBB threads
     void setNumThreads(unsigned int num_threads)
         {
+        // the observer must not outlive the arena it observes
+        m_thread_pinning.reset();
         m_task_arena = std::make_shared<tbb::task_arena>(num_threads);
         m_num_threads = num_threads;
+        updateThreadPinning();
+        }
+
+    //! Set whether each TBB thread is pinned to one CPU
+    void setThreadAffinity(bool enable)
+        {
+        m_thread_affinity = enable;
+        updateThreadPinning();
+        }
+
+    //! Get whether each TBB thread is pinned to one CPU
+    bool getThreadAffinity() const
+        {
+        return m_thread_affinity;
         }
 
     std::shared_ptr<tbb::task_arena> getTaskArena() const
@@ -292,6 +316,36 @@ class PYBIND11_EXPORT ExecutionConfiguration
         {
         return *m_cached_alloc_managed;
         }
+
+    //! Set whether GPUArray and GlobalArray allocations are drawn from the memory pools
+    void setMemoryPoolEnabled(bool enable);
+
+    //! Get whether GPUArray and GlobalArray allocations are drawn from the memory pools
+    bool memoryPoolEnabled() const
+        {
+        return m_memory_pool_enabled;
+        }
+
+    //! Get the pool of device memory on the current device
+    detail::MemoryPool* getDeviceMemoryPool() const;
+
+    //! Get the pool of page-locked host memory
+    detail::MemoryPool* getHostMemoryPool() const;
+
+    //! Get the pool of managed memory
+    detail::MemoryPool* getManagedMemoryPool() const;
+
+    //! Free the cached blocks of all memory pools
+    void releaseMemoryPools() const;
+
+    //! Get whether all active GPUs have peer access to each other
+    bool peerAccessEnabled() const
+        {
+        return m_peer_access;
+        }
+
+    //! Get the allocation statistics of the memory pools
+    pybind11::dict getMemoryPoolStats() const;
 #endif
 
     //! Set up memory tracing
@@ -305,6 +359,62 @@ class PYBIND11_EXPORT ExecutionConfiguration
         return m_memory_tracing;
         }
 
+    //! Get the memory held by the live GPUArray and GlobalArray allocations
+    pybind11::list getMemoryUsage() const;
+
+    //! Get the number of bytes held by the arrays in host, device, and managed memory
+    pybind11::tuple getMemoryBytes() const;
+
+    //! Get the peak number of bytes held by the arrays in host, device, and managed memory
+    pybind11::tuple getPeakMemoryBytes() const;
+
+    //! Restart the peak memory accounting
+    void resetPeakMemoryBytes() const;
+
+    //! Set the cache of autotuner results
+    /*! \param cache Cache to look up and store autotuner parameters in, may be null
+     */
+    void setAutotunerCache(std::shared_ptr<AutotunerCache> cache)
+        {
+        m_autotuner_cache = cache;
+        }
+
+    //! Get the cache of autotuner results (null when there is none)
+    std::shared_ptr<AutotunerCache> getAutotunerCache() const
+        {
+        return m_autotuner_cache;
+        }
+
+    //! Set whether autotuner scans prune parameters by successive halving
+    void setAutotunerSuccessiveHalving(bool successive_halving)
+        {
+        m_autotuner_successive_halving = successive_halving;
+        }
+
+    //! Get whether autotuner scans prune parameters by successive halving
+    bool getAutotunerSuccessiveHalving() const
+        {
+        return m_autotuner_successive_halving;
+        }
+
+    //! Set the performance spread below which successive halving scans stop early
+    /*! \param threshold Fractional spread between the slowest and fastest remaining parameters
+     */
+    void setAutotunerStopThreshold(float threshold)
+        {
+        if (threshold < 0)
+            {
+            throw std::invalid_argument("The autotuner stop threshold must not be negative.");
+            }
+        m_autotuner_stop_threshold = threshold;
+        }
+
+    //! Get the performance spread below which successive halving scans stop early
+    float getAutotunerStopThreshold() const
+        {
+        return m_autotuner_stop_threshold;
+        }
+
     //! Returns true if we are in a multi-GPU block
     bool inMultiGPUBlock() const
         {
@@ -399,17 +509,54 @@ class PYBIND11_EXPORT ExecutionConfiguration
     std::unique_ptr<CachedAllocator> m_cached_alloc; //!< Cached allocator for temporary allocations
     std::unique_ptr<CachedAllocator>
         m_cached_alloc_managed; //!< Cached allocator for temporary allocations in managed memory
+
+    //! Pools of device memory, one per active GPU
+    std::vector<std::unique_ptr<detail::MemoryPool>> m_device_pools;
+
+    //! Pool of page-locked host memory
+    std::unique_ptr<detail::MemoryPool> m_host_pool;
+
+    //! Pool of managed memory
+    std::unique_ptr<detail::MemoryPool> m_managed_pool;
+
+    //! True when array allocations are drawn from the memory pools
+    bool m_memory_pool_enabled = false;
+
+    //! Create the memory pools for the active GPUs
+    void initializeMemoryPools();
+
+    //! True when all active GPUs have peer access to each other
+    bool m_peer_access = false;
+
+    //! Enable peer access between all pairs of active GPUs that support it
+    void enablePeerAccess();
 #endif
 
 #ifdef ENABLE_TBB
     std::shared_ptr<tbb::task_arena> m_task_arena; //!< The TBB task arena
     unsigned int m_num_threads;                    //!<  The number of TBB threads used
+    bool m_thread_affinity = false;                //!< True when TBB threads are pinned to CPUs
+
+    //! Pins the threads of m_task_arena to CPUs, declared after the arena to be destroyed first
+    std::unique_ptr<tbb::task_scheduler_observer> m_thread_pinning;
+
+    //! Create or remove the observer that pins the TBB threads
+    void updateThreadPinning();
 #endif
 
     //! Setup and print out stats on the chosen CPUs/GPUs
     void setupStats();
 
     bool m_memory_tracing = false;
+
+    //! Cache of autotuner results
+    std::shared_ptr<AutotunerCache> m_autotuner_cache;
+
+    //! True when autotuner scans prune parameters by successive halving
+    bool m_autotuner_successive_halving = false;
+
+    //! Performance spread below which successive halving scans stop early
+    float m_autotuner_stop_threshold = 0;
     };
 
 #if defined(ENABLE_HIP)
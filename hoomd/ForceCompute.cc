@@ -26,7 +26,8 @@ namespace hoomd
     \post All forces are initialized to 0
 */
 ForceCompute::ForceCompute(std::shared_ptr<SystemDefinition> sysdef)
-    : Compute(sysdef), m_particles_sorted(false), m_buffers_writeable(false)
+    : Compute(sysdef), m_particles_sorted(false), m_defer_virial_allocation(false),
+      m_energy_sum(0.0), m_energy_sum_valid(false), m_buffers_writeable(false), m_ghost_wait_time(0)
     {
     assert(m_pdata);
     assert(m_pdata->getMaxN() > 0);
@@ -77,6 +78,14 @@ ForceCompute::ForceCompute(std::shared_ptr<SystemDefinition> sysdef)
         }
 #endif
 
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        GPUFlags<double> energy_sum_flag(m_exec_conf);
+        m_energy_sum_flag.swap(energy_sum_flag);
+        }
+#endif
+
     m_virial_pitch = m_virial.getPitch();
 
     // connect to the ParticleData to receive notifications when particles change order in memory
@@ -112,15 +121,20 @@ ForceCompute::ForceCompute(std::shared_ptr<SystemDefinition> sysdef)
 void ForceCompute::reallocate()
     {
     m_force.resize(m_pdata->getMaxN());
-    m_virial.resize(m_pdata->getMaxN(), 6);
     m_torque.resize(m_pdata->getMaxN());
 
         {
         ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
         ArrayHandle<Scalar4> h_torque(m_torque, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
         memset(h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
         memset(h_torque.data, 0, sizeof(Scalar4) * m_torque.getNumElements());
+        }
+
+    // a deferred virial array is allocated with the current size when it is needed
+    if (!m_virial.isNull())
+        {
+        m_virial.resize(m_pdata->getMaxN(), 6);
+        ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
         memset(h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
         }
 
@@ -131,6 +145,43 @@ void ForceCompute::reallocate()
     updateGPUAdvice();
     }
 
+/*! \post m_virial holds getMaxN() x 6 zeros if it was not allocated
+ */
+void ForceCompute::allocateVirial()
+    {
+    if (!m_virial.isNull())
+        return;
+
+    GlobalArray<Scalar> virial(m_pdata->getMaxN(), 6, m_exec_conf);
+    m_virial.swap(virial);
+    TAG_ALLOCATION(m_virial);
+
+        {
+        ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+        memset(h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+        }
+
+    m_virial_pitch = m_virial.getPitch();
+    updateGPUAdvice();
+    }
+
+/*! \param defer When true, release the virial array until a computation needs the pressure tensor
+ */
+void ForceCompute::setDeferVirialAllocation(bool defer)
+    {
+    m_defer_virial_allocation = defer;
+    if (defer)
+        {
+        GlobalArray<Scalar> virial;
+        m_virial.swap(virial);
+        m_virial_pitch = 0;
+        }
+    else
+        {
+        allocateVirial();
+        }
+    }
+
 void ForceCompute::updateGPUAdvice()
     {
 #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
@@ -154,7 +205,7 @@ void ForceCompute::updateGPUAdvice()
                           sizeof(Scalar4) * nelem,
                           cudaMemAdviseSetPreferredLocation,
                           gpu_map[idev]);
-            for (unsigned int i = 0; i < 6; ++i)
+            for (unsigned int i = 0; i < 6 && !m_virial.isNull(); ++i)
                 cudaMemAdvise(m_virial.get() + i * m_virial.getPitch() + range.first,
                               sizeof(Scalar) * nelem,
                               cudaMemAdviseSetPreferredLocation,
@@ -167,7 +218,7 @@ void ForceCompute::updateGPUAdvice()
             cudaMemPrefetchAsync(m_force.get() + range.first,
                                  sizeof(Scalar4) * nelem,
                                  gpu_map[idev]);
-            for (unsigned int i = 0; i < 6; ++i)
+            for (unsigned int i = 0; i < 6 && !m_virial.isNull(); ++i)
                 cudaMemPrefetchAsync(m_virial.get() + i * m_virial.getPitch() + range.first,
                                      sizeof(Scalar) * nelem,
                                      gpu_map[idev]);
@@ -184,10 +235,11 @@ void ForceCompute::updateGPUAdvice()
                           sizeof(Scalar4) * m_force.getNumElements(),
                           cudaMemAdviseSetAccessedBy,
                           gpu_map[idev]);
-            cudaMemAdvise(m_virial.get(),
-                          sizeof(Scalar) * m_virial.getNumElements(),
-                          cudaMemAdviseSetAccessedBy,
-                          gpu_map[idev]);
+            if (!m_virial.isNull())
+                cudaMemAdvise(m_virial.get(),
+                              sizeof(Scalar) * m_virial.getNumElements(),
+                              cudaMemAdviseSetAccessedBy,
+                              gpu_map[idev]);
             cudaMemAdvise(m_torque.get(),
                           sizeof(Scalar4) * m_torque.getNumElements(),
                           cudaMemAdviseSetAccessedBy,
@@ -209,14 +261,39 @@ ForceCompute::~ForceCompute()
     }
 
 /*! Sums the total potential energy calculated by the last call to compute() and returns it.
- */
+
+    On the GPU, the energies are reduced on the device and only the sum is copied to the host. The
+    sum is cached until the forces are computed again, so that the loggers and writers that read the
+    energy on the same step do not repeat the reduction.
+*/
 Scalar ForceCompute::calcEnergySum()
     {
-    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::read);
+    if (m_energy_sum_valid)
+        {
+        return Scalar(m_energy_sum);
+        }
+
     double pe_total = m_external_energy;
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        ArrayHandle<Scalar4> d_force(m_force, access_location::device, access_mode::read);
+        kernel::gpu_compute_energy_sum(m_energy_sum_flag.getDeviceFlags(),
+                                       d_force.data,
+                                       m_pdata->getN(),
+                                       m_exec_conf->getCachedAllocator());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        pe_total += m_energy_sum_flag.readFlags();
+        }
+    else
+#endif
         {
-        pe_total += (double)h_force.data[i].w;
+        ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            {
+            pe_total += (double)h_force.data[i].w;
+            }
         }
 #ifdef ENABLE_MPI
     if (m_sysdef->isDomainDecomposed())
@@ -230,6 +307,8 @@ Scalar ForceCompute::calcEnergySum()
                       m_exec_conf->getMPICommunicator());
         }
 #endif
+    m_energy_sum = pe_total;
+    m_energy_sum_valid = true;
     return Scalar(pe_total);
     }
 
@@ -304,7 +383,8 @@ std::vector<Scalar> ForceCompute::calcVirialGroup(std::shared_ptr<ParticleGroup>
 
     std::vector<Scalar> total_virial(6, 0.);
 
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    // a deferred virial array that was never allocated holds no contributions
+    for (unsigned int group_idx = 0; group_idx < group_size && h_virial.data; group_idx++)
         {
         const unsigned int j = group->getMemberIndex(group_idx);
 
@@ -562,17 +642,58 @@ pybind11::object ForceCompute::getVirialsPython()
 void ForceCompute::compute(uint64_t timestep)
     {
     Compute::compute(timestep);
+    if (m_defer_virial_allocation && m_pdata->getFlags()[pdata_flag::pressure_tensor])
+        {
+        allocateVirial();
+        }
+
     // recompute forces if the particles were sorted, this is a new timestep, or the particle data
     // flags do not match
     if (m_particles_sorted || shouldCompute(timestep) || m_pdata->getFlags() != m_computed_flags)
         {
+#ifdef ENABLE_MPI
+        // complete a pending ghost update unless computeForces overlaps with it
+        if (!overlapsGhostUpdate())
+            {
+            auto comm = m_sysdef->getCommunicator().lock();
+            if (comm)
+                comm->finishUpdateGhosts(timestep);
+            }
+#endif
+
+        ScopedProfile profile(m_sysdef->getProfiler(), getProfileName());
+        int64_t start_time = m_clock.getTime();
+        m_ghost_wait_time = 0;
+        m_energy_sum_valid = false;
         computeForces(timestep);
+        m_energy_sum_valid = false;
+
+        // record the time for load balancing, communication is not part of the load
+        m_sysdef->addForceComputeTime(m_clock.getTime() - start_time - m_ghost_wait_time);
         }
 
     m_particles_sorted = false;
     m_computed_flags = m_pdata->getFlags();
     }
 
+#ifdef ENABLE_MPI
+/*! \param timestep Current time step
+
+    Sub-classes that return true from overlapsGhostUpdate() call finishGhostUpdate() before reading
+    ghost particles. The time spent waiting is excluded from the recorded force compute time.
+*/
+void ForceCompute::finishGhostUpdate(uint64_t timestep)
+    {
+    auto comm = m_sysdef->getCommunicator().lock();
+    if (!comm)
+        return;
+
+    int64_t start_time = m_clock.getTime();
+    comm->finishUpdateGhosts(timestep);
+    m_ghost_wait_time += m_clock.getTime() - start_time;
+    }
+#endif
+
 /*! \param tag Global particle tag
     \returns Torque of particle referenced by tag
  */
@@ -636,7 +757,7 @@ Scalar ForceCompute::getVirial(unsigned int tag, unsigned int component)
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar result = Scalar(0.0);
-    if (found)
+    if (found && !m_virial.isNull())
         {
         ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::read);
         result = h_virial.data[m_virial_pitch * component + i];
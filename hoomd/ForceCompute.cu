@@ -0,0 +1,62 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "ForceCompute.cuh"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#include <hipcub/hipcub.hpp>
+#pragma GCC diagnostic pop
+
+/*! \file ForceCompute.cu
+    \brief Defines GPU kernel code used by ForceCompute
+*/
+
+namespace hoomd
+    {
+namespace kernel
+    {
+//! Extracts the potential energy of a particle in double precision
+struct energy_of_force
+    {
+    __host__ __device__ double operator()(const Scalar4& f) const
+        {
+        return double(f.w);
+        }
+    };
+
+/*! \param d_sum Device memory to write the sum to
+    \param d_force Per-particle forces, the energies are in the w components
+    \param N Number of particles
+    \param alloc Allocator for the temporary storage of the reduction
+
+    The sum is written asynchronously, the caller must synchronize before reading it on the host.
+*/
+hipError_t gpu_compute_energy_sum(double* d_sum,
+                                  const Scalar4* d_force,
+                                  unsigned int N,
+                                  CachedAllocator& alloc)
+    {
+    if (N == 0)
+        {
+        return hipMemsetAsync(d_sum, 0, sizeof(double));
+        }
+
+    hipcub::TransformInputIterator<double, energy_of_force, const Scalar4*> energies(
+        d_force,
+        energy_of_force());
+
+    // determine the temporary storage size
+    void* d_temp_storage = NULL;
+    size_t temp_storage_bytes = 0;
+    hipcub::DeviceReduce::Sum(d_temp_storage, temp_storage_bytes, energies, d_sum, N);
+
+    d_temp_storage = alloc.getTemporaryBuffer<char>(temp_storage_bytes);
+    hipcub::DeviceReduce::Sum(d_temp_storage, temp_storage_bytes, energies, d_sum, N);
+    alloc.deallocate((char*)d_temp_storage);
+
+    return hipSuccess;
+    }
+
+    } // end namespace kernel
+    } // end namespace hoomd
@@ -0,0 +1,26 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "CachedAllocator.h"
+#include "HOOMDMath.h"
+
+/*! \file ForceCompute.cuh
+    \brief Declares GPU kernel code used by ForceCompute
+*/
+#ifndef __FORCE_COMPUTE_CUH__
+#define __FORCE_COMPUTE_CUH__
+
+namespace hoomd
+    {
+namespace kernel
+    {
+//! Sum the per-particle potential energies on the device
+hipError_t gpu_compute_energy_sum(double* d_sum,
+                                  const Scalar4* d_force,
+                                  unsigned int N,
+                                  CachedAllocator& alloc);
+
+    } // end namespace kernel
+    } // end namespace hoomd
+
+#endif // __FORCE_COMPUTE_CUH__
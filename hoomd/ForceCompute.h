@@ -1,6 +1,7 @@
 // Copyright (c) 2009-2024 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+#include "ClockSource.h"
 #include "Compute.h"
 #include "GlobalArray.h"
 #include "HOOMDMath.h"
@@ -9,6 +10,8 @@
 #include "PythonLocalDataAccess.h"
 
 #ifdef ENABLE_HIP
+#include "ForceCompute.cuh"
+#include "GPUFlags.h"
 #include "ParticleData.cuh"
 #endif
 
@@ -131,11 +134,17 @@ class PYBIND11_EXPORT ForceCompute : public Compute
         }
 
     //! Get the array of computed virials
+    /*! The array is empty when the force defers the virial allocation and no computation has
+        requested the pressure tensor.
+    */
     const GlobalArray<Scalar>& getVirialArray() const
         {
         return m_virial;
         }
 
+    //! Allocate the per-particle virial array if it is not allocated
+    void allocateVirial();
+
     //! Get the array of computed torques
     const GlobalArray<Scalar4>& getTorqueArray() const
         {
@@ -165,6 +174,38 @@ class PYBIND11_EXPORT ForceCompute : public Compute
         flags[comm_flag::net_force] = 1; // only used if constraints are present
         return flags;
         }
+
+    //! Returns true if computeForces() completes a pending ghost update itself
+    /*! Sub-classes that return true may compute forces on local particles while the ghost update
+        is in progress, and must call finishGhostUpdate() before reading ghosts.
+    */
+    virtual bool overlapsGhostUpdate()
+        {
+        return false;
+        }
+#endif
+
+#ifdef ENABLE_HIP
+    //! Returns true if computeForces() launches its kernels on the stream set by setStream()
+    /*! Sub-classes that return true must write only to their own force, torque, and virial arrays
+        on the stream, so that the Integrator may run them concurrently with other force computes.
+    */
+    virtual bool supportsConcurrentStream()
+        {
+        return false;
+        }
+
+    //! Set the stream to launch the force kernels on
+    void setStream(hipStream_t stream)
+        {
+        m_stream = stream;
+        }
+
+    //! Get the stream to launch the force kernels on
+    hipStream_t getStream()
+        {
+        return m_stream;
+        }
 #endif
 
     //! Returns true if this ForceCompute requires anisotropic integration
@@ -193,12 +234,23 @@ class PYBIND11_EXPORT ForceCompute : public Compute
         m_particles_sorted = true;
         }
 
+#ifdef ENABLE_MPI
+    //! Complete a pending ghost update from within computeForces()
+    void finishGhostUpdate(uint64_t timestep);
+#endif
+
     //! Reallocate internal arrays
     void reallocate();
 
     //! Update GPU memory hints
     void updateGPUAdvice();
 
+    //! Allocate the per-particle virial only when a computation needs the pressure tensor
+    /*! Subclasses that write m_virial only when the pressure_tensor flag is set may enable this to
+        save 6 values per particle in simulations that never compute the pressure.
+    */
+    void setDeferVirialAllocation(bool defer);
+
     //! Sort local tags
     void sortLocalTags()
         {
@@ -228,15 +280,40 @@ class PYBIND11_EXPORT ForceCompute : public Compute
     size_t m_virial_pitch;         //!< The pitch of the 2D virial array
     GlobalArray<Scalar4> m_torque; //!< per-particle torque
 
+    /// True when m_virial is allocated on the first computation with the pressure tensor flag
+    bool m_defer_virial_allocation;
+
     Scalar m_external_virial[6]; //!< Stores external contribution to virial
     Scalar m_external_energy;    //!< Stores external contribution to potential energy
 
+    /// Total potential energy of the last computed forces, valid when m_energy_sum_valid is set
+    double m_energy_sum;
+
+    /// True when m_energy_sum holds the sum of the current per-particle energies
+    bool m_energy_sum_valid;
+
+#ifdef ENABLE_HIP
+    /// Device written sum of the local per-particle energies
+    GPUFlags<double> m_energy_sum_flag;
+#endif
+
     /// Store the particle data flags used during the last computation
     PDataFlags m_computed_flags;
 
     // whether the local force buffers exposed by this class should be read-only
     bool m_buffers_writeable;
 
+#ifdef ENABLE_HIP
+    /// Stream to launch the force kernels on, when supportsConcurrentStream() is true
+    hipStream_t m_stream = 0;
+#endif
+
+    /// Clock that measures the time spent in computeForces()
+    ClockSource m_clock;
+
+    /// Time computeForces() spent waiting for the ghost update [ns]
+    int64_t m_ghost_wait_time;
+
 #ifdef ENABLE_MPI
     /// Helper class to gather particle forces, energies, and virials
     GatherTagOrder m_gather_tag_order;
@@ -266,9 +343,11 @@ class PYBIND11_EXPORT LocalForceComputeData : public GhostLocalDataAccess<Output
                                                      pdata.getNGhosts(),
                                                      pdata.getNGlobal()),
           m_force_handle(), m_torque_handle(), m_virial_handle(),
-          m_virial_pitch(data.getVirialArray().getPitch()),
-          m_buffers_writeable(data.getLocalBuffersWriteable())
+          m_virial_pitch(0), m_buffers_writeable(data.getLocalBuffersWriteable())
         {
+        // the local virial buffer must exist even when the force deferred its allocation
+        data.allocateVirial();
+        m_virial_pitch = data.getVirialArray().getPitch();
         }
 
     virtual ~LocalForceComputeData() = default;
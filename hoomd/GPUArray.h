@@ -20,12 +20,17 @@
 #endif
 
 #include "ExecutionConfiguration.h"
+#include "MemoryPool.h"
+#include "MemoryTracker.h"
+#include "ParallelLoop.h"
 #include <algorithm>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
 #include <stdlib.h>
 #include <string.h>
+#include <string>
+#include <typeinfo>
 
 #include <cxxabi.h>
 #include <sstream>
@@ -79,17 +84,19 @@ template<class T> class device_deleter
     {
     public:
     //! Default constructor
-    device_deleter() : m_use_device(false), m_N(0), m_mapped(false) { }
+    device_deleter() : m_use_device(false), m_N(0), m_mapped(false), m_pool(nullptr) { }
 
     //! Ctor
     /*! \param exec_conf Execution configuration
         \param use_device whether the array is managed or on the host
+        \param pool Memory pool that the allocation was drawn from, or nullptr
      */
     device_deleter(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                    bool use_device,
                    const size_t N,
-                   bool mapped)
-        : m_exec_conf(exec_conf), m_use_device(use_device), m_N(N), m_mapped(mapped)
+                   bool mapped,
+                   MemoryPool* pool = nullptr)
+        : m_exec_conf(exec_conf), m_use_device(use_device), m_N(N), m_mapped(mapped), m_pool(pool)
         {
         }
 
@@ -104,11 +111,22 @@ template<class T> class device_deleter
         if (m_use_device && !m_mapped)
             {
             assert(m_exec_conf);
+            MemoryTracker::unregisterAllocation(ptr);
             this->m_exec_conf->msg->notice(10)
                 << "Freeing " << m_N * sizeof(T) << " bytes of CUDA memory." << std::endl;
 
 #ifdef ENABLE_HIP
-            hipFree(ptr);
+            if (m_pool)
+                {
+                // hipFree would wait for the kernels that use the memory, so wait for them before
+                // the block can be handed out again
+                hipDeviceSynchronize();
+                m_pool->deallocate(ptr);
+                }
+            else
+                {
+                hipFree(ptr);
+                }
 #endif
             }
         }
@@ -117,23 +135,26 @@ template<class T> class device_deleter
     std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< The execution configuration
     bool m_use_device;                                         //!< Whether to use cudaMallocManaged
     size_t m_N;                                                //!< Number of elements in array
-    bool m_mapped; //!< True if this is host-mapped memory
+    bool m_mapped;      //!< True if this is host-mapped memory
+    MemoryPool* m_pool; //!< Pool the memory was drawn from, if any
     };
 
 template<class T> class host_deleter
     {
     public:
     //! Default constructor
-    host_deleter() : m_use_device(false), m_N(0) { }
+    host_deleter() : m_use_device(false), m_N(0), m_pool(nullptr) { }
 
     //! Ctor
     /*! \param exec_conf Execution configuration
         \param use_device whether the array is managed or on the host
+        \param pool Memory pool that the allocation was drawn from, or nullptr
      */
     host_deleter(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                  bool use_device,
-                 const size_t N)
-        : m_exec_conf(exec_conf), m_use_device(use_device), m_N(N)
+                 const size_t N,
+                 MemoryPool* pool = nullptr)
+        : m_exec_conf(exec_conf), m_use_device(use_device), m_N(N), m_pool(pool)
         {
         }
 
@@ -149,6 +170,18 @@ template<class T> class host_deleter
             m_exec_conf->msg->notice(10)
                 << "Freeing " << m_N * sizeof(T) << " bytes of host memory." << std::endl;
 
+        MemoryTracker::unregisterAllocation(ptr);
+
+        if (m_pool)
+            {
+#ifdef ENABLE_HIP
+            // asynchronous copies may still use the memory
+            hipDeviceSynchronize();
+#endif
+            m_pool->deallocate(ptr);
+            return;
+            }
+
         if (m_use_device)
             {
             assert(m_exec_conf);
@@ -167,6 +200,7 @@ template<class T> class host_deleter
     std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< The execution configuration
     bool m_use_device;                                         //!< Whether to use hostMallocManaged
     size_t m_N;                                                //!< Number of elements in array
+    MemoryPool* m_pool; //!< Pool the memory was drawn from, if any
     };
     } // end namespace detail
 
@@ -525,6 +559,9 @@ template<class T> class GPUArray : public GPUArrayBase<T, GPUArray<T>>
     //! Resize a 2D GPUArray
     void resize(size_t width, size_t height);
 
+    //! Set an optional tag for memory accounting
+    void setTag(const std::string& tag, const std::string& owner = std::string());
+
     //! Return a string representation of this array
     std::string getRepresentation() const
         {
@@ -621,9 +658,24 @@ template<class T> class GPUArray : public GPUArrayBase<T, GPUArray<T>>
         m_exec_conf; //!< execution configuration for working with CUDA
 
     private:
+    std::string m_tag;   //!< Name tag of this array (optional)
+    std::string m_owner; //!< Class that holds this array (optional)
+
     //! Helper function to allocate memory
     inline void allocate();
 
+    //! Helper function to allocate host memory
+    inline std::unique_ptr<T, hoomd::detail::host_deleter<T>> allocateHost(size_t num_elements);
+
+    //! Helper function to zero host memory
+    inline void clearHost(T* ptr, size_t num_elements);
+
+#ifdef ENABLE_HIP
+    //! Helper function to allocate device memory
+    inline std::unique_ptr<T, hoomd::detail::device_deleter<T>>
+    allocateDevice(size_t num_elements);
+#endif
+
 #ifdef ENABLE_HIP
     //! Helper function to copy memory from the device to host
     inline void memcpyDeviceToHost(bool async) const;
@@ -813,7 +865,7 @@ GPUArray<T>::GPUArray(const GPUArray& from) noexcept
 #ifdef ENABLE_HIP
       m_mapped(from.m_mapped),
 #endif
-      m_exec_conf(from.m_exec_conf)
+      m_exec_conf(from.m_exec_conf), m_tag(from.m_tag), m_owner(from.m_owner)
     {
     // allocate and clear new memory the same size as the data in from
     allocate();
@@ -842,6 +894,9 @@ template<class T> GPUArray<T>& GPUArray<T>::operator=(const GPUArray& rhs) noexc
 #ifdef ENABLE_HIP
         m_mapped = rhs.m_mapped;
 #endif
+        m_tag = rhs.m_tag;
+        m_owner = rhs.m_owner;
+
         // initialize state variables
         m_data_location = data_location::host;
 
@@ -877,7 +932,8 @@ GPUArray<T>::GPUArray(GPUArray&& from) noexcept
 #ifdef ENABLE_HIP
       m_mapped(std::move(from.m_mapped)), d_data(std::move(from.d_data)),
 #endif
-      h_data(std::move(from.h_data)), m_exec_conf(std::move(from.m_exec_conf))
+      h_data(std::move(from.h_data)), m_exec_conf(std::move(from.m_exec_conf)),
+      m_tag(std::move(from.m_tag)), m_owner(std::move(from.m_owner))
     {
     }
 
@@ -897,6 +953,8 @@ template<class T> GPUArray<T>& GPUArray<T>::operator=(GPUArray&& rhs) noexcept
         h_data = std::move(rhs.h_data);
         m_data_location = std::move(rhs.m_data_location);
         m_acquired = std::move(rhs.m_acquired);
+        m_tag = std::move(rhs.m_tag);
+        m_owner = std::move(rhs.m_owner);
         }
 
     return *this;
@@ -932,6 +990,26 @@ template<class T> void GPUArray<T>::swap(GPUArray& from)
     std::swap(m_mapped, from.m_mapped);
 #endif
     std::swap(h_data, from.h_data);
+    std::swap(m_tag, from.m_tag);
+    std::swap(m_owner, from.m_owner);
+    }
+
+/*! \param tag The name of this allocation
+    \param owner The class that holds this array
+
+    The tag and owner follow the data: they are kept when the array is resized, copied with the
+    array, and exchanged by swap().
+*/
+template<class T> void GPUArray<T>::setTag(const std::string& tag, const std::string& owner)
+    {
+    m_tag = tag;
+    m_owner = owner;
+
+    hoomd::detail::MemoryTracker::setTag(h_data.get(), tag, owner);
+#ifdef ENABLE_HIP
+    if (!m_mapped)
+        hoomd::detail::MemoryTracker::setTag(d_data.get(), tag, owner);
+#endif
     }
 
 /*! \pre m_num_elements is set
@@ -968,36 +1046,8 @@ template<class T> void GPUArray<T>::allocate()
             << "GPUArray: Allocating " << float(m_num_elements * sizeof(T)) / 1024.0f / 1024.0f
             << " MB" << std::endl;
 
-    void* host_ptr = nullptr;
-
     // allocate host memory
-    // at minimum, alignment needs to be 32 bytes for AVX
-    int retval = posix_memalign(&host_ptr, 32, m_num_elements * sizeof(T));
-    if (retval != 0)
-        {
-        throw std::bad_alloc();
-        }
-
-    bool use_device = m_exec_conf && m_exec_conf->isCUDAEnabled();
-
-#ifdef ENABLE_HIP
-    void* device_ptr = nullptr;
-    if (use_device)
-        {
-// register pointer for DMA
-#ifdef ENABLE_HIP
-        hipHostRegister(host_ptr,
-                        m_num_elements * sizeof(T),
-                        m_mapped ? hipHostRegisterMapped : hipHostRegisterDefault);
-#endif
-        CHECK_CUDA_ERROR();
-        }
-#endif
-
-    // store in smart ptr with custom deleter
-    hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, m_num_elements);
-    h_data = std::unique_ptr<T, hoomd::detail::host_deleter<T>>(reinterpret_cast<T*>(host_ptr),
-                                                                host_deleter);
+    h_data = allocateHost(m_num_elements);
 
 #if defined(ENABLE_HIP)
     if (m_exec_conf && m_exec_conf->isCUDAEnabled())
@@ -1008,6 +1058,7 @@ template<class T> void GPUArray<T>::allocate()
         // allocate and/or map host memory
         if (m_mapped)
             {
+            void* device_ptr = nullptr;
 #ifdef ENABLE_HIP
             hipError_t error = hipHostGetDevicePointer(&device_ptr, h_data.get(), 0);
             if (error == hipErrorMemoryAllocation)
@@ -1019,34 +1070,129 @@ template<class T> void GPUArray<T>::allocate()
                 throw std::runtime_error(hipGetErrorString(error));
                 }
 #endif
+
+            // store in smart pointer with custom deleter
+            hoomd::detail::device_deleter<T> device_deleter(m_exec_conf,
+                                                            true,
+                                                            m_num_elements,
+                                                            m_mapped);
+            d_data = std::unique_ptr<T, hoomd::detail::device_deleter<T>>(
+                reinterpret_cast<T*>(device_ptr),
+                device_deleter);
             }
         else
             {
+            d_data = allocateDevice(m_num_elements);
+            }
+        }
+#endif
+    }
+
+/*! \param num_elements Number of elements to allocate
+    \returns The host memory, in a smart pointer that frees it
+
+    When the array is used with a GPU, the host memory is page-locked. Unless it is mapped, it is
+    drawn from the host memory pool of the execution configuration when pools are enabled.
+*/
+template<class T>
+std::unique_ptr<T, hoomd::detail::host_deleter<T>> GPUArray<T>::allocateHost(size_t num_elements)
+    {
+    bool use_device = m_exec_conf && m_exec_conf->isCUDAEnabled();
+    hoomd::detail::MemoryPool* pool = nullptr;
 #ifdef ENABLE_HIP
-            hipError_t error = hipMalloc(&device_ptr, m_num_elements * sizeof(T));
-            if (error == hipErrorMemoryAllocation)
-                {
-                throw std::bad_alloc();
-                }
-            else if (error != hipSuccess)
-                {
-                throw std::runtime_error(hipGetErrorString(error));
-                }
+    // mapped memory is registered with different flags, so it is never drawn from the pool
+    if (use_device && !m_mapped)
+        pool = m_exec_conf->getHostMemoryPool();
 #endif
-            }
 
-        // store in smart pointer with custom deleter
-        hoomd::detail::device_deleter<T> device_deleter(m_exec_conf,
-                                                        use_device,
-                                                        m_num_elements,
-                                                        m_mapped);
-        d_data
-            = std::unique_ptr<T, hoomd::detail::device_deleter<T>>(reinterpret_cast<T*>(device_ptr),
-                                                                   device_deleter);
+    void* host_ptr = nullptr;
+    if (pool)
+        {
+        host_ptr = pool->allocate(num_elements * sizeof(T));
         }
+    else
+        {
+        // at minimum, alignment needs to be 32 bytes for AVX
+        int retval = posix_memalign(&host_ptr, 32, num_elements * sizeof(T));
+        if (retval != 0)
+            {
+            throw std::bad_alloc();
+            }
+
+#ifdef ENABLE_HIP
+        if (use_device)
+            {
+            // register pointer for DMA
+            hipHostRegister(host_ptr,
+                            num_elements * sizeof(T),
+                            m_mapped ? hipHostRegisterMapped : hipHostRegisterDefault);
+            CHECK_CUDA_ERROR();
+            }
 #endif
+        }
+
+    hoomd::detail::MemoryTracker::registerAllocation(host_ptr,
+                                                     hoomd::detail::MemoryTracker::host,
+                                                     num_elements * sizeof(T),
+                                                     typeid(T),
+                                                     m_tag,
+                                                     m_owner);
+
+    // store in smart ptr with custom deleter
+    hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, num_elements, pool);
+    return std::unique_ptr<T, hoomd::detail::host_deleter<T>>(reinterpret_cast<T*>(host_ptr),
+                                                              host_deleter);
     }
 
+#ifdef ENABLE_HIP
+/*! \param num_elements Number of elements to allocate
+    \returns The device memory, in a smart pointer that frees it
+
+    The device memory is drawn from the device memory pool of the execution configuration when
+    pools are enabled.
+*/
+template<class T>
+std::unique_ptr<T, hoomd::detail::device_deleter<T>>
+GPUArray<T>::allocateDevice(size_t num_elements)
+    {
+    hoomd::detail::MemoryPool* pool = m_exec_conf->getDeviceMemoryPool();
+
+    void* device_ptr = nullptr;
+    if (pool)
+        {
+        device_ptr = pool->allocate(num_elements * sizeof(T));
+        }
+    else
+        {
+        hipError_t error = hipMalloc(&device_ptr, num_elements * sizeof(T));
+        if (error == hipErrorMemoryAllocation)
+            {
+            throw std::bad_alloc();
+            }
+        else if (error != hipSuccess)
+            {
+            throw std::runtime_error(hipGetErrorString(error));
+            }
+        }
+
+    hoomd::detail::MemoryTracker::registerAllocation(device_ptr,
+                                                     hoomd::detail::MemoryTracker::device,
+                                                     num_elements * sizeof(T),
+                                                     typeid(T),
+                                                     m_tag,
+                                                     m_owner);
+
+    // store in smart pointer with custom deleter
+    hoomd::detail::device_deleter<T> device_deleter(m_exec_conf,
+                                                    m_exec_conf->isCUDAEnabled(),
+                                                    num_elements,
+                                                    false,
+                                                    pool);
+    return std::unique_ptr<T, hoomd::detail::device_deleter<T>>(reinterpret_cast<T*>(device_ptr),
+                                                                device_deleter);
+    }
+#endif
+
 /*! \pre allocate() has been called
     \post All allocated memory is set to 0
 */
@@ -1060,7 +1206,7 @@ template<class T> void GPUArray<T>::memclear(size_t first)
     assert(first < m_num_elements);
 
     // clear memory
-    memset((void*)(h_data.get() + first), 0, sizeof(T) * (m_num_elements - first));
+    clearHost(h_data.get() + first, m_num_elements - first);
 
 #if defined(ENABLE_HIP)
     if (m_exec_conf && m_exec_conf->isCUDAEnabled())
@@ -1325,6 +1471,21 @@ ArrayHandleDispatch<T> GPUArray<T>::acquire(const access_location::Enum location
         }
     }
 
+/*! \param ptr Host memory of this array
+    \param num_elements Number of elements to zero
+
+    The memory of arrays that are not used with a GPU is zeroed on the TBB threads, so that each
+    page of a new allocation is placed on the NUMA node of the thread that processes it. GPU
+    arrays are page-locked when they are allocated, so they are zeroed on the calling thread.
+*/
+template<class T> void GPUArray<T>::clearHost(T* ptr, size_t num_elements)
+    {
+    if (m_exec_conf && !m_exec_conf->isCUDAEnabled())
+        hoomd::detail::parallel_first_touch(*m_exec_conf, (void*)ptr, sizeof(T) * num_elements);
+    else
+        memset((void*)ptr, 0, sizeof(T) * num_elements);
+    }
+
 /*! \post Memory on the host is resized, the newly allocated part of the array
  *        is reset to zero
  *! \returns a pointer to the newly allocated memory area
@@ -1336,38 +1497,17 @@ template<class T> T* GPUArray<T>::resizeHostArray(size_t num_elements)
         return NULL;
 
     // allocate resized array
-    T* h_tmp = NULL;
+    std::unique_ptr<T, hoomd::detail::host_deleter<T>> h_tmp = allocateHost(num_elements);
 
-    // allocate host memory
-    // at minimum, alignment needs to be 32 bytes for AVX
-    int retval = posix_memalign((void**)&h_tmp, 32, num_elements * sizeof(T));
-    if (retval != 0)
-        {
-        throw std::bad_alloc();
-        }
-
-#ifdef ENABLE_HIP
-    if (m_exec_conf && m_exec_conf->isCUDAEnabled())
-        {
-#ifdef ENABLE_HIP
-        hipHostRegister(h_tmp,
-                        num_elements * sizeof(T),
-                        m_mapped ? hipHostRegisterMapped : hipHostRegisterDefault);
-#endif
-        CHECK_CUDA_ERROR();
-        }
-#endif
     // clear memory
-    memset((void*)h_tmp, 0, sizeof(T) * num_elements);
+    clearHost(h_tmp.get(), num_elements);
 
     // copy over data
     size_t num_copy_elements = m_num_elements > num_elements ? num_elements : m_num_elements;
-    memcpy((void*)h_tmp, (void*)h_data.get(), sizeof(T) * num_copy_elements);
+    memcpy((void*)h_tmp.get(), (void*)h_data.get(), sizeof(T) * num_copy_elements);
 
     // update smart pointer
-    bool use_device = m_exec_conf && m_exec_conf->isCUDAEnabled();
-    hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, num_elements);
-    h_data = std::unique_ptr<T, hoomd::detail::host_deleter<T>>(h_tmp, host_deleter);
+    h_data = std::move(h_tmp);
 
 #ifdef ENABLE_HIP
     // update device pointer
@@ -1379,6 +1519,7 @@ template<class T> T* GPUArray<T>::resizeHostArray(size_t num_elements)
 #endif
 
         // no-op deleter
+        bool use_device = m_exec_conf && m_exec_conf->isCUDAEnabled();
         hoomd::detail::device_deleter<T> device_deleter(m_exec_conf,
                                                         use_device,
                                                         num_elements,
@@ -1399,43 +1540,23 @@ template<class T>
 T* GPUArray<T>::resize2DHostArray(size_t pitch, size_t new_pitch, size_t height, size_t new_height)
     {
     // allocate resized array
-    T* h_tmp = NULL;
-
-    // allocate host memory
-    // at minimum, alignment needs to be 32 bytes for AVX
-    size_t size = new_pitch * new_height * sizeof(T);
-    int retval = posix_memalign((void**)&h_tmp, 32, size);
-    if (retval != 0)
-        {
-        throw std::bad_alloc();
-        }
-
-#ifdef ENABLE_HIP
-    if (m_exec_conf && m_exec_conf->isCUDAEnabled())
-        {
-#ifdef ENABLE_HIP
-        hipHostRegister(h_tmp, size, m_mapped ? hipHostRegisterMapped : hipHostRegisterDefault);
-#endif
-        CHECK_CUDA_ERROR();
-        }
-#endif
+    std::unique_ptr<T, hoomd::detail::host_deleter<T>> h_tmp
+        = allocateHost(new_pitch * new_height);
 
     // clear memory
-    memset((void*)h_tmp, 0, sizeof(T) * new_pitch * new_height);
+    clearHost(h_tmp.get(), new_pitch * new_height);
 
     // copy over data
     // every column is copied separately such as to align with the new pitch
     size_t num_copy_rows = height > new_height ? new_height : height;
     size_t num_copy_columns = pitch > new_pitch ? new_pitch : pitch;
     for (size_t i = 0; i < num_copy_rows; i++)
-        memcpy((void*)(h_tmp + i * new_pitch),
+        memcpy((void*)(h_tmp.get() + i * new_pitch),
                (void*)(h_data.get() + i * pitch),
                sizeof(T) * num_copy_columns);
 
     // update smart pointer
-    bool use_device = m_exec_conf && m_exec_conf->isCUDAEnabled();
-    hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, new_pitch * new_height);
-    h_data = std::unique_ptr<T, hoomd::detail::host_deleter<T>>(h_tmp, host_deleter);
+    h_data = std::move(h_tmp);
 
 #ifdef ENABLE_HIP
     // update device pointer
@@ -1447,6 +1568,7 @@ T* GPUArray<T>::resize2DHostArray(size_t pitch, size_t new_pitch, size_t height,
 #endif
 
         // no-op deleter
+        bool use_device = m_exec_conf && m_exec_conf->isCUDAEnabled();
         hoomd::detail::device_deleter<T> device_deleter(m_exec_conf,
                                                         use_device,
                                                         new_pitch * new_height,
@@ -1474,40 +1596,24 @@ template<class T> T* GPUArray<T>::resizeDeviceArray(size_t num_elements)
         return NULL;
 
     // allocate resized array
-    T* d_tmp;
-#ifdef ENABLE_HIP
-    hipError_t error = hipMalloc(&d_tmp, num_elements * sizeof(T));
-    if (error == hipErrorMemoryAllocation)
-        {
-        throw std::bad_alloc();
-        }
-    else if (error != hipSuccess)
-        {
-        throw std::runtime_error(hipGetErrorString(error));
-        }
-#endif
-
+    std::unique_ptr<T, hoomd::detail::device_deleter<T>> d_tmp = allocateDevice(num_elements);
     assert(d_tmp);
 
 // clear memory
 #ifdef ENABLE_HIP
-    hipMemset(d_tmp, 0, num_elements * sizeof(T));
+    hipMemset(d_tmp.get(), 0, num_elements * sizeof(T));
 #endif
     CHECK_CUDA_ERROR();
 
     // copy over data
     size_t num_copy_elements = m_num_elements > num_elements ? num_elements : m_num_elements;
 #ifdef ENABLE_HIP
-    hipMemcpy(d_tmp, d_data.get(), sizeof(T) * num_copy_elements, hipMemcpyDeviceToDevice);
+    hipMemcpy(d_tmp.get(), d_data.get(), sizeof(T) * num_copy_elements, hipMemcpyDeviceToDevice);
 #endif
     CHECK_CUDA_ERROR();
 
     // update smart ptr
-    hoomd::detail::device_deleter<T> device_deleter(m_exec_conf,
-                                                    m_exec_conf->isCUDAEnabled(),
-                                                    num_elements,
-                                                    m_mapped);
-    d_data = std::unique_ptr<T, hoomd::detail::device_deleter<T>>(d_tmp, device_deleter);
+    d_data = std::move(d_tmp);
 
     return d_data.get();
 #else
@@ -1533,23 +1639,13 @@ T* GPUArray<T>::resize2DDeviceArray(size_t pitch,
         return NULL;
 
     // allocate resized array
-    T* d_tmp;
-#ifdef ENABLE_HIP
-    hipError_t error = hipMalloc(&d_tmp, new_pitch * new_height * sizeof(T));
-    if (error == hipErrorMemoryAllocation)
-        {
-        throw std::bad_alloc();
-        }
-    else if (error != hipSuccess)
-        {
-        throw std::runtime_error(hipGetErrorString(error));
-        }
-#endif
+    std::unique_ptr<T, hoomd::detail::device_deleter<T>> d_tmp
+        = allocateDevice(new_pitch * new_height);
     assert(d_tmp);
 
 // clear memory
 #ifdef ENABLE_HIP
-    hipMemset(d_tmp, 0, new_pitch * new_height * sizeof(T));
+    hipMemset(d_tmp.get(), 0, new_pitch * new_height * sizeof(T));
 #endif
     CHECK_CUDA_ERROR();
 
@@ -1561,7 +1657,7 @@ T* GPUArray<T>::resize2DDeviceArray(size_t pitch,
     for (size_t i = 0; i < num_copy_rows; i++)
         {
 #ifdef ENABLE_HIP
-        hipMemcpy(d_tmp + i * new_pitch,
+        hipMemcpy(d_tmp.get() + i * new_pitch,
                   d_data.get() + i * pitch,
                   sizeof(T) * num_copy_columns,
                   hipMemcpyDeviceToDevice);
@@ -1570,11 +1666,7 @@ T* GPUArray<T>::resize2DDeviceArray(size_t pitch,
         }
 
     // update smart ptr
-    hoomd::detail::device_deleter<T> device_deleter(m_exec_conf,
-                                                    m_exec_conf->isCUDAEnabled(),
-                                                    new_pitch * new_height,
-                                                    m_mapped);
-    d_data = std::unique_ptr<T, hoomd::detail::device_deleter<T>>(d_tmp, device_deleter);
+    d_data = std::move(d_tmp);
 
     return d_data.get();
 #else
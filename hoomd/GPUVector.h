@@ -73,6 +73,11 @@ template<class T, class Array> class GPUVectorBase : public Array
      */
     virtual void resize(size_t new_size, const T& value);
 
+    //! Release allocated memory that the vector does not use
+    /*! \param shrink_fraction Fraction of the allocated elements below which the vector shrinks
+     */
+    void shrink(double shrink_fraction);
+
     //! Insert an element at the end of the vector
     /*! \param val The new element
      */
@@ -311,6 +316,18 @@ template<class T, class Array> void GPUVectorBase<T, Array>::resize(size_t new_s
         data[i] = value;
     }
 
+/*! When the size of the vector is below \a shrink_fraction of the allocated elements, the memory is
+    reallocated to the size grown by the amortized resize factor, keeping the elements of the
+    vector. Otherwise, nothing is done. With a \a shrink_fraction below 1 / RESIZE_FACTOR, a vector
+    that was just shrunk must change its size substantially before it is reallocated again.
+*/
+template<class T, class Array> void GPUVectorBase<T, Array>::shrink(double shrink_fraction)
+    {
+    const size_t size = m_size ? m_size : 1;
+    if ((double)size < shrink_fraction * (double)Array::getNumElements())
+        Array::resize(((size_t)(((double)size) * RESIZE_FACTOR)) + 1);
+    }
+
 //! Insert an element at the end of the vector
 template<class T, class Array> void GPUVectorBase<T, Array>::push_back(const T& val)
     {
@@ -433,9 +450,9 @@ template<class T> class GlobalVector : public GPUVectorBase<T, GlobalArray<T>>
         }
 
     //! Set the tag
-    void setTag(const std::string& tag)
+    void setTag(const std::string& tag, const std::string& owner = std::string())
         {
-        static_cast<GlobalArray<T>&>(*this).setTag(tag);
+        static_cast<GlobalArray<T>&>(*this).setTag(tag, owner);
         }
 
     //! Get the underlying raw pointer
@@ -16,6 +16,15 @@ namespace detail
 class GSDUtils
     {
     public:
+    /// Chunk that stores the quantized positions in a keyframe
+    static constexpr const char* quantized_position_key = "hoomd/quantized_position/key";
+
+    /// Chunk that stores the change in the quantized positions since the previous frame
+    static constexpr const char* quantized_position_delta = "hoomd/quantized_position/delta";
+
+    /// Chunk that stores the number of quantization steps along each box vector in a keyframe
+    static constexpr const char* quantized_position_steps = "hoomd/quantized_position/steps";
+
     /// Check and raise an exception if an error occurs
     static void checkError(int retval, const std::string& fname)
         {
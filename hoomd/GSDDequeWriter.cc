@@ -4,8 +4,23 @@
 #include "GSDDequeWriter.h"
 #include "hoomd/GSDDumpWriter.h"
 
+#include <algorithm>
+#include <string.h>
+
 namespace hoomd
     {
+namespace
+    {
+/// Alignment of the arrays stored in the ring buffer
+const size_t ring_alignment = 256;
+
+/// Round up to a multiple of ring_alignment
+size_t alignRing(size_t bytes)
+    {
+    return (bytes + ring_alignment - 1) / ring_alignment * ring_alignment;
+    }
+    } // end anonymous namespace
+
 GSDDequeWriter::GSDDequeWriter(std::shared_ptr<SystemDefinition> sysdef,
                                std::shared_ptr<Trigger> trigger,
                                const std::string& fname,
@@ -14,10 +29,25 @@ GSDDequeWriter::GSDDequeWriter(std::shared_ptr<SystemDefinition> sysdef,
                                int queue_size,
                                std::string mode,
                                bool write_at_init,
-                               uint64_t timestep)
-    : GSDDumpWriter(sysdef, trigger, fname, group, mode), m_queue_size(queue_size)
+                               uint64_t timestep,
+                               size_t max_burst_bytes)
+    : GSDDumpWriter(sysdef, trigger, fname, group, mode), m_queue_size(queue_size),
+      m_max_burst_bytes(max_burst_bytes)
     {
     setLogWriter(logger);
+
+    if (m_max_burst_bytes > 0)
+        {
+        GPUArray<char> ring(m_max_burst_bytes, m_exec_conf);
+        m_ring.swap(ring);
+#ifdef ENABLE_HIP
+        if (m_exec_conf->isCUDAEnabled())
+            {
+            hipStreamCreate(&m_copy_stream);
+            }
+#endif
+        }
+
     bool file_empty = true;
 #ifdef ENABLE_MPI
     if (m_sysdef->isDomainDecomposed())
@@ -41,14 +71,32 @@ GSDDequeWriter::GSDDequeWriter(std::shared_ptr<SystemDefinition> sysdef,
             }
         else
             {
-            analyze(timestep);
-            dump();
+            // the first frame writes all fields, write it directly
+            GSDDumpWriter::GSDFrame frame;
+            populateLocalFrame(frame, timestep);
+            write(frame, getLogData());
             }
         }
     }
 
+GSDDequeWriter::~GSDDequeWriter()
+    {
+#ifdef ENABLE_HIP
+    if (m_copy_stream != nullptr)
+        {
+        hipStreamDestroy(m_copy_stream);
+        }
+#endif
+    }
+
 void GSDDequeWriter::analyze(uint64_t timestep)
     {
+    if (m_max_burst_bytes > 0)
+        {
+        analyzeRing(timestep);
+        return;
+        }
+
     m_frame_queue.emplace_front();
     populateLocalFrame(m_frame_queue.front(), timestep);
     m_log_queue.push_front(getLogData());
@@ -61,6 +109,12 @@ void GSDDequeWriter::analyze(uint64_t timestep)
 
 void GSDDequeWriter::dump()
     {
+    if (m_max_burst_bytes > 0)
+        {
+        dumpRing();
+        return;
+        }
+
     for (auto i {static_cast<long int>(m_frame_queue.size()) - 1}; i >= 0; --i)
         {
         write(m_frame_queue[i], m_log_queue[i]);
@@ -69,6 +123,288 @@ void GSDDequeWriter::dump()
     m_log_queue.clear();
     }
 
+/*! \param timestep Current time step of the simulation
+
+    Place the frame after the newest frame in the ring buffer, or at the start of the buffer when
+    it does not fit before the end. Remove the oldest frames until no frame overlaps the new one.
+    With domain decomposition, all ranks remove the same number of frames so that every rank stores
+    the same frames.
+*/
+void GSDDequeWriter::analyzeRing(uint64_t timestep)
+    {
+    if (m_queue_size == 0)
+        {
+        return;
+        }
+
+    const unsigned int N = m_pdata->getN();
+
+    RingFrame ring_frame;
+    ring_frame.frame.clear();
+    ring_frame.frame.timestep = timestep;
+    ring_frame.frame.global_box = m_pdata->getGlobalBox();
+    ring_frame.frame.particle_data.type_mapping = m_pdata->getTypeMapping();
+    populateTopology(ring_frame.frame);
+    ring_frame.log_data = getLogData();
+    ring_frame.origin = m_pdata->getOrigin();
+    ring_frame.N = N;
+    ring_frame.stored = getNeededParticleArrays();
+
+    // lay out the stored arrays in the frame
+    const std::array<size_t, n_particle_arrays> element_size = {sizeof(Scalar4),
+                                                                sizeof(int3),
+                                                                sizeof(Scalar4),
+                                                                sizeof(Scalar4),
+                                                                sizeof(Scalar),
+                                                                sizeof(Scalar),
+                                                                sizeof(unsigned int),
+                                                                sizeof(Scalar3),
+                                                                sizeof(Scalar4)};
+    size_t bytes = 0;
+    for (unsigned int i = 0; i < n_particle_arrays; i++)
+        {
+        ring_frame.array_offset[i] = bytes;
+        if (ring_frame.stored[i])
+            {
+            bytes += alignRing(element_size[i] * N);
+            }
+        }
+    ring_frame.tag_offset = bytes;
+    bytes += alignRing(sizeof(unsigned int) * N);
+    ring_frame.bytes = bytes;
+
+    // place the frame and find the oldest frames to remove
+    int fits = bytes <= m_max_burst_bytes;
+    ring_frame.offset = m_ring_head;
+    if (ring_frame.offset + bytes > m_max_burst_bytes)
+        {
+        ring_frame.offset = 0;
+        }
+
+    unsigned long n_remove = 0;
+    for (size_t i = 0; i < m_ring_frames.size(); i++)
+        {
+        const RingFrame& stored_frame = m_ring_frames[i];
+        if (stored_frame.offset < ring_frame.offset + bytes
+            && ring_frame.offset < stored_frame.offset + stored_frame.bytes)
+            {
+            n_remove = i + 1;
+            }
+        }
+    if (m_queue_size != -1 && m_ring_frames.size() - n_remove >= static_cast<size_t>(m_queue_size))
+        {
+        n_remove = m_ring_frames.size() + 1 - m_queue_size;
+        }
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &fits, 1, MPI_INT, MPI_MIN, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &n_remove,
+                      1,
+                      MPI_UNSIGNED_LONG,
+                      MPI_MAX,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    if (!fits)
+        {
+        throw std::runtime_error("A frame needs more memory than max_burst_bytes.");
+        }
+
+    popOldest(n_remove);
+
+    // copy the arrays into the ring buffer
+    size_t offset = ring_frame.offset;
+    if (ring_frame.stored[particle_array::postype])
+        {
+        copyToRing(m_pdata->getPositions(),
+                   offset + ring_frame.array_offset[particle_array::postype],
+                   N);
+        }
+    if (ring_frame.stored[particle_array::image])
+        {
+        copyToRing(m_pdata->getImages(),
+                   offset + ring_frame.array_offset[particle_array::image],
+                   N);
+        }
+    if (ring_frame.stored[particle_array::orientation])
+        {
+        copyToRing(m_pdata->getOrientationArray(),
+                   offset + ring_frame.array_offset[particle_array::orientation],
+                   N);
+        }
+    if (ring_frame.stored[particle_array::velocity])
+        {
+        copyToRing(m_pdata->getVelocities(),
+                   offset + ring_frame.array_offset[particle_array::velocity],
+                   N);
+        }
+    if (ring_frame.stored[particle_array::charge])
+        {
+        copyToRing(m_pdata->getCharges(),
+                   offset + ring_frame.array_offset[particle_array::charge],
+                   N);
+        }
+    if (ring_frame.stored[particle_array::diameter])
+        {
+        copyToRing(m_pdata->getDiameters(),
+                   offset + ring_frame.array_offset[particle_array::diameter],
+                   N);
+        }
+    if (ring_frame.stored[particle_array::body])
+        {
+        copyToRing(m_pdata->getBodies(), offset + ring_frame.array_offset[particle_array::body], N);
+        }
+    if (ring_frame.stored[particle_array::inertia])
+        {
+        copyToRing(m_pdata->getMomentsOfInertiaArray(),
+                   offset + ring_frame.array_offset[particle_array::inertia],
+                   N);
+        }
+    if (ring_frame.stored[particle_array::angmom])
+        {
+        copyToRing(m_pdata->getAngularMomentumArray(),
+                   offset + ring_frame.array_offset[particle_array::angmom],
+                   N);
+        }
+    copyToRing(m_pdata->getTags(), offset + ring_frame.tag_offset, N);
+
+    m_ring_head = ring_frame.offset + bytes;
+    m_ring_frames.push_back(std::move(ring_frame));
+    }
+
+/*! Copy the ring buffer to the host, then write the stored frames from oldest to newest.
+ */
+void GSDDequeWriter::dumpRing()
+    {
+    if (m_ring_frames.empty())
+        {
+        return;
+        }
+
+    // waits for the pending copies
+    ArrayHandle<char> h_ring(m_ring, access_location::host, access_mode::read);
+    std::shared_ptr<ParticleGroup> group = getGroup();
+    const unsigned int n_group = group->getNumMembersGlobal();
+
+    for (RingFrame& ring_frame : m_ring_frames)
+        {
+        const char* data = h_ring.data + ring_frame.offset;
+        GSDDumpWriter::GSDFrame& frame = ring_frame.frame;
+
+        // select the group members in ascending tag order
+        const unsigned int* tags
+            = reinterpret_cast<const unsigned int*>(data + ring_frame.tag_offset);
+        m_ring_order.resize(ring_frame.N);
+        for (unsigned int i = 0; i < ring_frame.N; i++)
+            {
+            m_ring_order[i] = std::make_pair(tags[i], i);
+            }
+        std::sort(m_ring_order.begin(), m_ring_order.end());
+
+        m_ring_index.resize(0);
+        size_t j = 0;
+        for (unsigned int group_tag_index = 0;
+             group_tag_index < n_group && j < m_ring_order.size();
+             group_tag_index++)
+            {
+            unsigned int tag = group->getMemberTag(group_tag_index);
+            while (j < m_ring_order.size() && m_ring_order[j].first < tag)
+                {
+                j++;
+                }
+            if (j < m_ring_order.size() && m_ring_order[j].first == tag)
+                {
+                frame.particle_tags.push_back(tag);
+                frame.particle_index.push_back(group_tag_index);
+                m_ring_index.push_back(m_ring_order[j].second);
+                j++;
+                }
+            }
+
+        ParticleArrays arrays;
+        arrays.origin = ring_frame.origin;
+        auto stored_array = [&](particle_array::Enum array) -> const char*
+        {
+            if (!ring_frame.stored[array] || ring_frame.N == 0)
+                {
+                return nullptr;
+                }
+            return data + ring_frame.array_offset[array];
+        };
+        arrays.postype = reinterpret_cast<const Scalar4*>(stored_array(particle_array::postype));
+        arrays.image = reinterpret_cast<const int3*>(stored_array(particle_array::image));
+        arrays.orientation
+            = reinterpret_cast<const Scalar4*>(stored_array(particle_array::orientation));
+        arrays.velocity = reinterpret_cast<const Scalar4*>(stored_array(particle_array::velocity));
+        arrays.charge = reinterpret_cast<const Scalar*>(stored_array(particle_array::charge));
+        arrays.diameter = reinterpret_cast<const Scalar*>(stored_array(particle_array::diameter));
+        arrays.body = reinterpret_cast<const unsigned int*>(stored_array(particle_array::body));
+        arrays.inertia = reinterpret_cast<const Scalar3*>(stored_array(particle_array::inertia));
+        arrays.angmom = reinterpret_cast<const Scalar4*>(stored_array(particle_array::angmom));
+
+        populateParticleData(frame, arrays, m_ring_index);
+        write(frame, ring_frame.log_data);
+        }
+
+    m_ring_frames.clear();
+    m_ring_head = 0;
+    }
+
+/*! \param n_frames Number of frames to remove
+ */
+void GSDDequeWriter::popOldest(size_t n_frames)
+    {
+    for (size_t i = 0; i < n_frames && !m_ring_frames.empty(); i++)
+        {
+        m_ring_frames.pop_front();
+        }
+    if (m_ring_frames.empty())
+        {
+        m_ring_head = 0;
+        }
+    }
+
+/*! \param array Particle data array to copy
+    \param offset Destination in the ring buffer
+    \param N Number of elements to copy
+
+    On the GPU, the copy is asynchronous with respect to the host. m_copy_stream is a blocking
+    stream, so kernels that later modify the particle data on the default stream wait for the copy
+    to complete.
+*/
+template<class T>
+void GSDDequeWriter::copyToRing(const GlobalArray<T>& array, size_t offset, unsigned int N)
+    {
+    if (N == 0)
+        {
+        return;
+        }
+
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        ArrayHandle<T> d_array(array, access_location::device, access_mode::read);
+        ArrayHandle<char> d_ring(m_ring, access_location::device, access_mode::readwrite);
+        hipMemcpyAsync(d_ring.data + offset,
+                       d_array.data,
+                       sizeof(T) * N,
+                       hipMemcpyDeviceToDevice,
+                       m_copy_stream);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        return;
+        }
+#endif
+
+    ArrayHandle<T> h_array(array, access_location::host, access_mode::read);
+    ArrayHandle<char> h_ring(m_ring, access_location::host, access_mode::readwrite);
+    memcpy(h_ring.data + offset, h_array.data, sizeof(T) * N);
+    }
+
 int GSDDequeWriter::getMaxQueueSize() const
     {
     return m_queue_size;
@@ -76,6 +412,10 @@ int GSDDequeWriter::getMaxQueueSize() const
 
 size_t GSDDequeWriter::getCurrentQueueSize() const
     {
+    if (m_max_burst_bytes > 0)
+        {
+        return m_ring_frames.size();
+        }
     return m_frame_queue.size();
     }
 
@@ -86,6 +426,10 @@ void GSDDequeWriter::setMaxQueueSize(int new_max_size)
         {
         return;
         }
+    if (m_ring_frames.size() > static_cast<size_t>(m_queue_size))
+        {
+        popOldest(m_ring_frames.size() - m_queue_size);
+        }
     while (static_cast<size_t>(m_queue_size) < m_frame_queue.size())
         {
         m_frame_queue.pop_back();
@@ -108,10 +452,12 @@ void export_GSDDequeWriter(pybind11::module& m)
                             int,
                             std::string,
                             bool,
-                            uint64_t>())
+                            uint64_t,
+                            size_t>())
         .def_property("max_burst_size",
                       &GSDDequeWriter::getMaxQueueSize,
                       &GSDDequeWriter::setMaxQueueSize)
+        .def_property_readonly("max_burst_bytes", &GSDDequeWriter::getMaxBurstBytes)
         .def("__len__", &GSDDequeWriter::getCurrentQueueSize)
         .def("dump", &GSDDequeWriter::dump);
     }
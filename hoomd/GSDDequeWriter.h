@@ -7,14 +7,27 @@
 #error This header cannot be compiled by nvcc
 #endif
 
+#include <array>
 #include <deque>
 
 #include <pybind11/pybind11.h>
 
+#include "GPUArray.h"
 #include "GSDDumpWriter.h"
 
 namespace hoomd
     {
+/// Store frames in memory and write them to a GSD file on request
+/*! By default, GSDDequeWriter stores full GSDFrame objects in a deque in host memory.
+
+    When max_burst_bytes is positive, GSDDequeWriter instead stores the local per-particle arrays
+    that the frames write (as selected by the dynamic fields) in a ring buffer of max_burst_bytes
+    bytes that is allocated once. On the GPU, the ring buffer resides in device memory and
+    analyze() copies the arrays into it asynchronously on a separate stream, so analyze() does not
+    copy particle data to the host. dump() copies the ring buffer to the host once and converts the
+    stored arrays to frames. When a new frame does not fit in the buffer, the oldest frames are
+    removed.
+*/
 class PYBIND11_EXPORT GSDDequeWriter : public GSDDumpWriter
     {
     public:
@@ -26,8 +39,9 @@ class PYBIND11_EXPORT GSDDequeWriter : public GSDDumpWriter
                    int queue_size,
                    std::string mode,
                    bool write_on_init,
-                   uint64_t timestep);
-    ~GSDDequeWriter() = default;
+                   uint64_t timestep,
+                   size_t max_burst_bytes = 0);
+    ~GSDDequeWriter();
 
     void analyze(uint64_t timestep) override;
 
@@ -38,10 +52,82 @@ class PYBIND11_EXPORT GSDDequeWriter : public GSDDumpWriter
 
     size_t getCurrentQueueSize() const;
 
+    /// Get the size of the ring buffer in bytes (0 stores full frames in host memory)
+    size_t getMaxBurstBytes() const
+        {
+        return m_max_burst_bytes;
+        }
+
     protected:
     int m_queue_size;
     std::deque<GSDDumpWriter::GSDFrame> m_frame_queue;
     std::deque<pybind11::dict> m_log_queue;
+
+    /// A frame stored in the ring buffer
+    struct RingFrame
+        {
+        /// Timestep, box, type names, and topology of the frame
+        GSDDumpWriter::GSDFrame frame;
+
+        /// Origin of the particle positions
+        Scalar3 origin;
+
+        /// Number of local particles in the frame
+        unsigned int N = 0;
+
+        /// Location of the frame in the ring buffer
+        size_t offset = 0;
+
+        /// Size of the frame in the ring buffer
+        size_t bytes = 0;
+
+        /// Offset of each stored array from the start of the frame
+        std::array<size_t, n_particle_arrays> array_offset;
+
+        /// Offset of the particle tags from the start of the frame
+        size_t tag_offset = 0;
+
+        /// Flags that indicate the stored arrays
+        std::bitset<n_particle_arrays> stored;
+
+        /// Logged quantities of the frame
+        pybind11::dict log_data;
+        };
+
+    /// Size of the ring buffer in bytes (0 stores full frames in host memory)
+    size_t m_max_burst_bytes;
+
+    /// The ring buffer (device memory on the GPU)
+    GPUArray<char> m_ring;
+
+    /// Frames stored in the ring buffer, oldest first
+    std::deque<RingFrame> m_ring_frames;
+
+    /// Offset in the ring buffer where the next frame begins
+    size_t m_ring_head = 0;
+
+    /// Working array to sort the stored particles by tag
+    std::vector<std::pair<unsigned int, unsigned int>> m_ring_order;
+
+    /// Working array of local indices in ascending tag order
+    std::vector<unsigned int> m_ring_index;
+
+#ifdef ENABLE_HIP
+    /// Stream that copies particle data into the ring buffer
+    hipStream_t m_copy_stream = nullptr;
+#endif
+
+    /// Store the current frame in the ring buffer
+    void analyzeRing(uint64_t timestep);
+
+    /// Write the frames stored in the ring buffer
+    void dumpRing();
+
+    /// Remove the given number of the oldest frames
+    void popOldest(size_t n_frames);
+
+    /// Copy the first N elements of a particle data array into the ring buffer
+    template<class T> void copyToRing(const GlobalArray<T>& array, size_t offset, unsigned int N);
     };
 
 namespace detail
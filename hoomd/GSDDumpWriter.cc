@@ -15,6 +15,7 @@
 
 #include <limits>
 #include <list>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string.h>
@@ -222,6 +223,8 @@ void GSDDumpWriter::flush()
     {
     if (m_exec_conf->isRoot())
         {
+        waitForPendingFrames();
+
         m_exec_conf->msg->notice(5) << "GSD: flush gsd file " << m_fname << endl;
         int retval = gsd_flush(&m_handle);
         GSDUtils::checkError(retval, m_fname);
@@ -232,6 +235,8 @@ void GSDDumpWriter::setMaximumWriteBufferSize(uint64_t size)
     {
     if (m_exec_conf->isRoot())
         {
+        waitForPendingFrames();
+
         int retval = gsd_set_maximum_write_buffer_size(&m_handle, size);
         GSDUtils::checkError(retval, m_fname);
 
@@ -245,6 +250,7 @@ uint64_t GSDDumpWriter::getMaximumWriteBufferSize()
     {
     if (m_exec_conf->isRoot())
         {
+        waitForPendingFrames();
         return gsd_get_maximum_write_buffer_size(&m_handle);
         }
     else
@@ -253,6 +259,414 @@ uint64_t GSDDumpWriter::getMaximumWriteBufferSize()
         }
     }
 
+/*! \param frames Maximum number of frames the I/O thread may have pending.
+
+    Set \a frames to 0 to write frames synchronously in analyze(). Otherwise, start a background
+    I/O thread when one is not already running.
+*/
+void GSDDumpWriter::setMaximumFramesInFlight(unsigned int frames)
+    {
+    // beginFrame() reads the limit under the lock
+        {
+        std::lock_guard<std::mutex> lock(m_io_mutex);
+        m_max_frames_in_flight = frames;
+        }
+    // allow a waiting analyze() to proceed when the limit increases
+    m_io_done.notify_all();
+
+    if (!m_exec_conf->isRoot())
+        {
+        return;
+        }
+
+    if (frames == 0)
+        {
+        stopIOThread();
+        }
+    else if (!m_io_thread.joinable())
+        {
+        m_io_stop = false;
+        m_io_thread = std::thread(&GSDDumpWriter::ioThreadLoop, this);
+        }
+    }
+
+/*! Write the chunk to the file immediately when writing synchronously. Otherwise, copy the chunk
+    into the pending frame buffer.
+
+    The arguments match gsd_write_chunk.
+*/
+int GSDDumpWriter::writeChunk(const char* name,
+                              gsd_type type,
+                              uint64_t N,
+                              uint32_t M,
+                              uint8_t flags,
+                              const void* data)
+    {
+    if (!m_pending_frame)
+        {
+        return gsd_write_chunk(&m_handle, name, type, N, M, flags, data);
+        }
+
+    PendingFrame& frame = *m_pending_frame;
+    if (frame.n_chunks == frame.chunks.size())
+        {
+        frame.chunks.emplace_back();
+        }
+
+    PendingChunk& chunk = frame.chunks[frame.n_chunks];
+    frame.n_chunks++;
+
+    chunk.name = name;
+    chunk.type = type;
+    chunk.N = N;
+    chunk.M = M;
+    chunk.flags = flags;
+    chunk.quantize = false;
+    chunk.keyframe = false;
+    size_t size = N * M * gsd_sizeof_type(type);
+    chunk.data.resize(size);
+    if (size > 0)
+        {
+        memcpy(chunk.data.data(), data, size);
+        }
+
+    return GSD_SUCCESS;
+    }
+
+/*! When writing asynchronously, wait until fewer than the maximum number of frames are in flight
+    and then take a frame buffer to fill.
+*/
+void GSDDumpWriter::beginFrame()
+    {
+    if (!m_io_thread.joinable())
+        {
+        return;
+        }
+
+    std::unique_lock<std::mutex> lock(m_io_mutex);
+    m_io_done.wait(lock,
+                   [this] { return m_frames_in_flight < m_max_frames_in_flight || m_io_error; });
+    checkIOError();
+
+    if (m_io_free.empty())
+        {
+        m_pending_frame = std::make_unique<PendingFrame>();
+        }
+    else
+        {
+        m_pending_frame = std::move(m_io_free.back());
+        m_io_free.pop_back();
+        }
+    m_pending_frame->n_chunks = 0;
+    }
+
+/*! Write the end of the frame synchronously, or hand the pending frame off to the I/O thread.
+ */
+void GSDDumpWriter::endFrame()
+    {
+    if (!m_pending_frame)
+        {
+        m_exec_conf->msg->notice(10) << "GSD: ending frame" << endl;
+        int retval = gsd_end_frame(&m_handle);
+        GSDUtils::checkError(retval, m_fname);
+        return;
+        }
+
+    m_exec_conf->msg->notice(10) << "GSD: queueing frame" << endl;
+        {
+        std::lock_guard<std::mutex> lock(m_io_mutex);
+        m_io_queue.push_back(std::move(m_pending_frame));
+        m_frames_in_flight++;
+        }
+    m_io_ready.notify_one();
+    }
+
+void GSDDumpWriter::waitForPendingFrames()
+    {
+    if (!m_io_thread.joinable())
+        {
+        return;
+        }
+
+    std::unique_lock<std::mutex> lock(m_io_mutex);
+    m_io_done.wait(lock, [this] { return m_frames_in_flight == 0; });
+    checkIOError();
+    }
+
+void GSDDumpWriter::stopIOThread()
+    {
+    if (!m_io_thread.joinable())
+        {
+        return;
+        }
+
+        {
+        std::lock_guard<std::mutex> lock(m_io_mutex);
+        m_io_stop = true;
+        }
+    m_io_ready.notify_one();
+    m_io_thread.join();
+    m_io_free.clear();
+    m_pending_frame.reset();
+
+    std::lock_guard<std::mutex> lock(m_io_mutex);
+    checkIOError();
+    }
+
+/*! \pre The caller holds m_io_mutex.
+ */
+void GSDDumpWriter::checkIOError()
+    {
+    if (m_io_error)
+        {
+        std::exception_ptr error = m_io_error;
+        m_io_error = nullptr;
+        std::rethrow_exception(error);
+        }
+    }
+
+/*! \param error Exception raised on the root rank, or null
+
+    Throw on all ranks when the root rank failed, so that the other ranks do not wait for the root
+    rank in a following collective call.
+
+    \note This method must be called collectively on all ranks.
+*/
+void GSDDumpWriter::shareIOError(std::exception_ptr error)
+    {
+    bool failed = bool(error);
+#ifdef ENABLE_MPI
+    if (m_exec_conf->getNRanks() > 1)
+        {
+        bcast(failed, 0, m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    if (error)
+        {
+        std::rethrow_exception(error);
+        }
+    if (failed)
+        {
+        throw std::runtime_error("Error writing " + m_fname + " on the root rank.");
+        }
+    }
+
+/*! Write frames from the queue in order until asked to stop. The I/O thread discards the frames
+    that follow an error until the simulation thread handles the error.
+*/
+void GSDDumpWriter::ioThreadLoop()
+    {
+    std::unique_lock<std::mutex> lock(m_io_mutex);
+    while (true)
+        {
+        m_io_ready.wait(lock, [this] { return m_io_stop || !m_io_queue.empty(); });
+        if (m_io_queue.empty())
+            {
+            // m_io_stop is set and all frames are written
+            return;
+            }
+
+        std::unique_ptr<PendingFrame> frame = std::move(m_io_queue.front());
+        m_io_queue.pop_front();
+        bool write = !m_io_error;
+        lock.unlock();
+
+        std::exception_ptr error;
+        if (write)
+            {
+            try
+                {
+                for (size_t i = 0; i < frame->n_chunks; i++)
+                    {
+                    const PendingChunk& chunk = frame->chunks[i];
+                    int retval;
+                    if (chunk.quantize)
+                        {
+                        retval = writeQuantizedPositions(frame->box,
+                                                         chunk.keyframe,
+                                                         chunk.N,
+                                                         (const float*)chunk.data.data());
+                        }
+                    else
+                        {
+                        retval = gsd_write_chunk(&m_handle,
+                                                 chunk.name.c_str(),
+                                                 chunk.type,
+                                                 chunk.N,
+                                                 chunk.M,
+                                                 chunk.flags,
+                                                 chunk.data.data());
+                        }
+                    GSDUtils::checkError(retval, m_fname);
+                    }
+
+                int retval = gsd_end_frame(&m_handle);
+                GSDUtils::checkError(retval, m_fname);
+                }
+            catch (...)
+                {
+                error = std::current_exception();
+                }
+            }
+
+        lock.lock();
+        if (error && !m_io_error)
+            {
+            m_io_error = error;
+            }
+        m_io_free.push_back(std::move(frame));
+        m_frames_in_flight--;
+        m_io_done.notify_all();
+        }
+    }
+
+/*! \param position_precision Quantization step as a fraction of the box length
+
+    Wait for the pending frames, so that the I/O thread quantizes each frame with the precision
+    set when the frame was written. The next frame with positions is a keyframe.
+*/
+void GSDDumpWriter::setPositionPrecision(double position_precision)
+    {
+    if (position_precision < 0 || position_precision > 0.5
+        || (position_precision > 0
+            && position_precision * std::numeric_limits<int32_t>::max() < 1.0))
+        {
+        throw std::invalid_argument("position_precision must be 0 or in the range [4.7e-10, 0.5].");
+        }
+
+    if (m_exec_conf->isRoot())
+        {
+        waitForPendingFrames();
+        }
+    m_position_precision = position_precision;
+    m_position_last_N = 0;
+    }
+
+/*! \param interval Number of frames between keyframes of the quantized positions
+ */
+void GSDDumpWriter::setPositionKeyframeInterval(unsigned int interval)
+    {
+    if (interval == 0)
+        {
+        throw std::invalid_argument("position_keyframe_interval must be positive.");
+        }
+    m_position_keyframe_interval = interval;
+    }
+
+/*! \param box Box of the frame
+    \param keyframe True to write a keyframe
+    \param N Number of particles
+    \param pos Positions (N x 3 floats)
+
+    Each coordinate is quantized to the index q of the bin that holds its fractional coordinate
+    along the box vector, with m_position_precision as the bin width. The reader places the
+    particle in the center of the bin, so the error is at most half a bin width.
+
+    Keyframes store q as int32. Other frames store the change in q since the previous frame, wrapped
+    into the periodic box, in the narrowest integer type that holds all of the changes. Particles
+    that move only a few bins per frame need 1 or 2 bytes per coordinate instead of 4.
+
+    \returns The result of gsd_write_chunk.
+*/
+int GSDDumpWriter::writeQuantizedPositions(const BoxDim& box,
+                                           bool keyframe,
+                                           uint64_t N,
+                                           const float* pos)
+    {
+    const int64_t steps = int64_t(1.0 / m_position_precision + 0.5);
+    std::vector<int32_t> q(N * 3);
+    for (uint64_t i = 0; i < N; i++)
+        {
+        Scalar3 f = box.makeFraction(make_scalar3(pos[i * 3], pos[i * 3 + 1], pos[i * 3 + 2]));
+        Scalar fractions[3] = {f.x, f.y, f.z};
+        for (unsigned int d = 0; d < 3; d++)
+            {
+            int64_t bin = int64_t(floor(double(fractions[d]) * double(steps)));
+            q[i * 3 + d] = int32_t(std::min(std::max(bin, int64_t(0)), steps - 1));
+            }
+        }
+
+    int retval;
+    if (keyframe || m_quantized_position.size() != q.size())
+        {
+        uint32_t steps_value = uint32_t(steps);
+        retval = gsd_write_chunk(&m_handle,
+                                 GSDUtils::quantized_position_steps,
+                                 GSD_TYPE_UINT32,
+                                 1,
+                                 1,
+                                 0,
+                                 &steps_value);
+        if (retval == GSD_SUCCESS)
+            {
+            retval = gsd_write_chunk(&m_handle,
+                                     GSDUtils::quantized_position_key,
+                                     GSD_TYPE_INT32,
+                                     N,
+                                     3,
+                                     0,
+                                     q.data());
+            }
+        }
+    else
+        {
+        // change in the bin index, wrapped into [-steps/2, steps/2)
+        std::vector<int32_t> delta(q.size());
+        int32_t max_delta = 0;
+        for (size_t i = 0; i < q.size(); i++)
+            {
+            int64_t d = int64_t(q[i]) - int64_t(m_quantized_position[i]);
+            if (d >= steps - steps / 2)
+                {
+                d -= steps;
+                }
+            else if (d < -(steps / 2))
+                {
+                d += steps;
+                }
+            delta[i] = int32_t(d);
+            max_delta = std::max(max_delta, std::abs(delta[i]));
+            }
+
+        if (max_delta <= std::numeric_limits<int8_t>::max())
+            {
+            std::vector<int8_t> narrow(delta.begin(), delta.end());
+            retval = gsd_write_chunk(&m_handle,
+                                     GSDUtils::quantized_position_delta,
+                                     GSD_TYPE_INT8,
+                                     N,
+                                     3,
+                                     0,
+                                     narrow.data());
+            }
+        else if (max_delta <= std::numeric_limits<int16_t>::max())
+            {
+            std::vector<int16_t> narrow(delta.begin(), delta.end());
+            retval = gsd_write_chunk(&m_handle,
+                                     GSDUtils::quantized_position_delta,
+                                     GSD_TYPE_INT16,
+                                     N,
+                                     3,
+                                     0,
+                                     narrow.data());
+            }
+        else
+            {
+            retval = gsd_write_chunk(&m_handle,
+                                     GSDUtils::quantized_position_delta,
+                                     GSD_TYPE_INT32,
+                                     N,
+                                     3,
+                                     0,
+                                     delta.data());
+            }
+        }
+
+    m_quantized_position.swap(q);
+    return retval;
+    }
+
 //! Initializes the output file for writing
 void GSDDumpWriter::initFileIO()
     {
@@ -329,6 +743,15 @@ GSDDumpWriter::~GSDDumpWriter()
 
     if (m_exec_conf->isRoot())
         {
+        try
+            {
+            stopIOThread();
+            }
+        catch (const std::exception& e)
+            {
+            m_exec_conf->msg->error() << e.what() << endl;
+            }
+
         m_exec_conf->msg->notice(5) << "GSD: close gsd file " << m_fname << endl;
         gsd_close(&m_handle);
         }
@@ -358,12 +781,22 @@ void GSDDumpWriter::analyze(uint64_t timestep)
     // truncate the file if requested
     if (m_truncate)
         {
+        std::exception_ptr error;
         if (m_exec_conf->isRoot())
             {
-            m_exec_conf->msg->notice(10) << "GSD: truncating file" << endl;
-            retval = gsd_truncate(&m_handle);
-            GSDUtils::checkError(retval, m_fname);
+            try
+                {
+                m_exec_conf->msg->notice(10) << "GSD: truncating file" << endl;
+                waitForPendingFrames();
+                retval = gsd_truncate(&m_handle);
+                GSDUtils::checkError(retval, m_fname);
+                }
+            catch (...)
+                {
+                error = std::current_exception();
+                }
             }
+        shareIOError(error);
 
         m_nframes = 0;
         }
@@ -375,8 +808,48 @@ void GSDDumpWriter::analyze(uint64_t timestep)
 
 void GSDDumpWriter::write(GSDDumpWriter::GSDFrame& frame, pybind11::dict log_data)
     {
+    bool collective = false;
 #ifdef ENABLE_MPI
-    if (m_sysdef->isDomainDecomposed())
+    // quantized positions depend on the previous frame, gather them on the root rank
+    collective
+        = m_collective_write && m_sysdef->isDomainDecomposed() && m_position_precision == 0;
+#endif
+
+    // raise errors on all ranks before the collective gather or write
+    std::exception_ptr error;
+    if (m_exec_conf->isRoot())
+        {
+        try
+            {
+            // collective writes access the file directly
+            if (collective)
+                {
+                waitForPendingFrames();
+                writeFrameHeader(frame);
+                }
+            else
+                {
+                beginFrame();
+                }
+            }
+        catch (...)
+            {
+            error = std::current_exception();
+            }
+        }
+    shareIOError(error);
+
+#ifdef ENABLE_MPI
+    if (collective)
+        {
+        writeParticlesCollective(frame);
+
+        if (m_exec_conf->isRoot())
+            {
+            writeLogQuantities(log_data);
+            }
+        }
+    else if (m_sysdef->isDomainDecomposed())
         {
         gatherGlobalFrame(frame);
 
@@ -415,9 +888,7 @@ void GSDDumpWriter::write(GSDDumpWriter::GSDFrame& frame, pybind11::dict log_dat
 
     if (m_exec_conf->isRoot())
         {
-        m_exec_conf->msg->notice(10) << "GSD: ending frame" << endl;
-        int retval = gsd_end_frame(&m_handle);
-        GSDUtils::checkError(retval, m_fname);
+        endFrame();
         }
 
     m_nframes++;
@@ -437,13 +908,12 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector<std::string>
         std::vector<char> types(max_len * type_mapping.size());
         for (unsigned int i = 0; i < type_mapping.size(); i++)
             strncpy(&types[max_len * i], type_mapping[i].c_str(), max_len);
-        int retval = gsd_write_chunk(&m_handle,
-                                     chunk.c_str(),
-                                     GSD_TYPE_UINT8,
-                                     type_mapping.size(),
-                                     max_len,
-                                     0,
-                                     (void*)&types[0]);
+        int retval = writeChunk(chunk.c_str(),
+                                GSD_TYPE_UINT8,
+                                type_mapping.size(),
+                                max_len,
+                                0,
+                                (void*)&types[0]);
         GSDUtils::checkError(retval, m_fname);
         }
     }
@@ -455,26 +925,19 @@ void GSDDumpWriter::writeFrameHeader(const GSDDumpWriter::GSDFrame& frame)
     {
     int retval;
     m_exec_conf->msg->notice(10) << "GSD: writing configuration/step" << endl;
-    retval = gsd_write_chunk(&m_handle,
-                             "configuration/step",
-                             GSD_TYPE_UINT64,
-                             1,
-                             1,
-                             0,
-                             (void*)&frame.timestep);
+    retval = writeChunk("configuration/step", GSD_TYPE_UINT64, 1, 1, 0, (void*)&frame.timestep);
     GSDUtils::checkError(retval, m_fname);
 
     if (m_nframes == 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing configuration/dimensions" << endl;
         uint8_t dimensions = (uint8_t)m_sysdef->getNDimensions();
-        retval = gsd_write_chunk(&m_handle,
-                                 "configuration/dimensions",
-                                 GSD_TYPE_UINT8,
-                                 1,
-                                 1,
-                                 0,
-                                 (void*)&dimensions);
+        retval = writeChunk("configuration/dimensions",
+                            GSD_TYPE_UINT8,
+                            1,
+                            1,
+                            0,
+                            (void*)&dimensions);
         GSDUtils::checkError(retval, m_fname);
         }
 
@@ -488,13 +951,7 @@ void GSDDumpWriter::writeFrameHeader(const GSDDumpWriter::GSDFrame& frame)
         box_a[3] = (float)frame.global_box.getTiltFactorXY();
         box_a[4] = (float)frame.global_box.getTiltFactorXZ();
         box_a[5] = (float)frame.global_box.getTiltFactorYZ();
-        retval = gsd_write_chunk(&m_handle,
-                                 "configuration/box",
-                                 GSD_TYPE_FLOAT,
-                                 6,
-                                 1,
-                                 0,
-                                 (void*)box_a);
+        retval = writeChunk("configuration/box", GSD_TYPE_FLOAT, 6, 1, 0, (void*)box_a);
         GSDUtils::checkError(retval, m_fname);
         }
 
@@ -502,7 +959,7 @@ void GSDDumpWriter::writeFrameHeader(const GSDDumpWriter::GSDFrame& frame)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing particles/N" << endl;
         uint32_t N = m_group->getNumMembersGlobal();
-        retval = gsd_write_chunk(&m_handle, "particles/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
+        retval = writeChunk("particles/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
         GSDUtils::checkError(retval, m_fname);
         }
     }
@@ -525,13 +982,12 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
         assert(frame.particle_data.type.size() == N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)frame.particle_data.type.data());
+        retval = writeChunk("particles/typeid",
+                            GSD_TYPE_UINT32,
+                            N,
+                            1,
+                            0,
+                            (void*)frame.particle_data.type.data());
         GSDUtils::checkError(retval, m_fname);
         if (m_nframes == 0)
             m_nondefault["particles/typeid"] = true;
@@ -542,13 +998,12 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
         assert(frame.particle_data.mass.size() == N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/mass" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/mass",
-                                 GSD_TYPE_FLOAT,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)frame.particle_data.mass.data());
+        retval = writeChunk("particles/mass",
+                            GSD_TYPE_FLOAT,
+                            N,
+                            1,
+                            0,
+                            (void*)frame.particle_data.mass.data());
         GSDUtils::checkError(retval, m_fname);
         if (m_nframes == 0)
             m_nondefault["particles/mass"] = true;
@@ -559,13 +1014,12 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
         assert(frame.particle_data.charge.size() == N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/charge" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/charge",
-                                 GSD_TYPE_FLOAT,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)frame.particle_data.charge.data());
+        retval = writeChunk("particles/charge",
+                            GSD_TYPE_FLOAT,
+                            N,
+                            1,
+                            0,
+                            (void*)frame.particle_data.charge.data());
         GSDUtils::checkError(retval, m_fname);
         if (m_nframes == 0)
             m_nondefault["particles/charge"] = true;
@@ -578,13 +1032,12 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
             assert(frame.particle_data.diameter.size() == N);
 
             m_exec_conf->msg->notice(10) << "GSD: writing particles/diameter" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/diameter",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)frame.particle_data.diameter.data());
+            retval = writeChunk("particles/diameter",
+                                GSD_TYPE_FLOAT,
+                                N,
+                                1,
+                                0,
+                                (void*)frame.particle_data.diameter.data());
             GSDUtils::checkError(retval, m_fname);
             if (m_nframes == 0)
                 m_nondefault["particles/diameter"] = true;
@@ -596,13 +1049,12 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
         assert(frame.particle_data.body.size() == N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/body" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/body",
-                                 GSD_TYPE_INT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)frame.particle_data.body.data());
+        retval = writeChunk("particles/body",
+                            GSD_TYPE_INT32,
+                            N,
+                            1,
+                            0,
+                            (void*)frame.particle_data.body.data());
         GSDUtils::checkError(retval, m_fname);
         if (m_nframes == 0)
             m_nondefault["particles/body"] = true;
@@ -613,13 +1065,12 @@ void GSDDumpWriter::writeAttributes(const GSDDumpWriter::GSDFrame& frame)
         assert(frame.particle_data.inertia.size() == N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/moment_inertia" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/moment_inertia",
-                                 GSD_TYPE_FLOAT,
-                                 N,
-                                 3,
-                                 0,
-                                 (void*)frame.particle_data.inertia.data());
+        retval = writeChunk("particles/moment_inertia",
+                            GSD_TYPE_FLOAT,
+                            N,
+                            3,
+                            0,
+                            (void*)frame.particle_data.inertia.data());
         GSDUtils::checkError(retval, m_fname);
         if (m_nframes == 0)
             m_nondefault["particles/moment_inertia"] = true;
@@ -637,14 +1088,46 @@ void GSDDumpWriter::writeProperties(const GSDDumpWriter::GSDFrame& frame)
         {
         assert(frame.particle_data.pos.size() == N);
 
-        m_exec_conf->msg->notice(10) << "GSD: writing particles/position" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/position",
-                                 GSD_TYPE_FLOAT,
-                                 N,
-                                 3,
-                                 0,
-                                 (void*)frame.particle_data.pos.data());
+        if (m_position_precision > 0)
+            {
+            bool keyframe = m_nframes == 0 || m_position_last_N != N
+                            || m_position_frames_since_keyframe >= m_position_keyframe_interval;
+            m_position_frames_since_keyframe = keyframe ? 1 : m_position_frames_since_keyframe + 1;
+            m_position_last_N = N;
+
+            m_exec_conf->msg->notice(10) << "GSD: writing quantized particles/position" << endl;
+            if (m_pending_frame)
+                {
+                // quantize the positions on the I/O thread
+                retval = writeChunk("particles/position",
+                                    GSD_TYPE_FLOAT,
+                                    N,
+                                    3,
+                                    0,
+                                    (void*)frame.particle_data.pos.data());
+                PendingChunk& chunk = m_pending_frame->chunks[m_pending_frame->n_chunks - 1];
+                chunk.quantize = true;
+                chunk.keyframe = keyframe;
+                m_pending_frame->box = frame.global_box;
+                }
+            else
+                {
+                retval = writeQuantizedPositions(frame.global_box,
+                                                 keyframe,
+                                                 N,
+                                                 (const float*)frame.particle_data.pos.data());
+                }
+            }
+        else
+            {
+            m_exec_conf->msg->notice(10) << "GSD: writing particles/position" << endl;
+            retval = writeChunk("particles/position",
+                                GSD_TYPE_FLOAT,
+                                N,
+                                3,
+                                0,
+                                (void*)frame.particle_data.pos.data());
+            }
         GSDUtils::checkError(retval, m_fname);
         if (m_nframes == 0)
             m_nondefault["particles/position"] = true;
@@ -655,13 +1138,12 @@ void GSDDumpWriter::writeProperties(const GSDDumpWriter::GSDFrame& frame)
         assert(frame.particle_data.orientation.size() == N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/orientation" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/orientation",
-                                 GSD_TYPE_FLOAT,
-                                 N,
-                                 4,
-                                 0,
-                                 (void*)frame.particle_data.orientation.data());
+        retval = writeChunk("particles/orientation",
+                            GSD_TYPE_FLOAT,
+                            N,
+                            4,
+                            0,
+                            (void*)frame.particle_data.orientation.data());
         GSDUtils::checkError(retval, m_fname);
         if (m_nframes == 0)
             m_nondefault["particles/orientation"] = true;
@@ -680,13 +1162,12 @@ void GSDDumpWriter::writeMomenta(const GSDDumpWriter::GSDFrame& frame)
         assert(frame.particle_data.vel.size() == N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/velocity" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/velocity",
-                                 GSD_TYPE_FLOAT,
-                                 N,
-                                 3,
-                                 0,
-                                 (void*)frame.particle_data.vel.data());
+        retval = writeChunk("particles/velocity",
+                            GSD_TYPE_FLOAT,
+                            N,
+                            3,
+                            0,
+                            (void*)frame.particle_data.vel.data());
         GSDUtils::checkError(retval, m_fname);
         if (m_nframes == 0)
             m_nondefault["particles/velocity"] = true;
@@ -697,13 +1178,12 @@ void GSDDumpWriter::writeMomenta(const GSDDumpWriter::GSDFrame& frame)
         assert(frame.particle_data.angmom.size() == N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/angmom" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/angmom",
-                                 GSD_TYPE_FLOAT,
-                                 N,
-                                 4,
-                                 0,
-                                 (void*)frame.particle_data.angmom.data());
+        retval = writeChunk("particles/angmom",
+                            GSD_TYPE_FLOAT,
+                            N,
+                            4,
+                            0,
+                            (void*)frame.particle_data.angmom.data());
         GSDUtils::checkError(retval, m_fname);
         if (m_nframes == 0)
             m_nondefault["particles/angmom"] = true;
@@ -714,13 +1194,12 @@ void GSDDumpWriter::writeMomenta(const GSDDumpWriter::GSDFrame& frame)
         assert(frame.particle_data.image.size() == N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/image" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/image",
-                                 GSD_TYPE_INT32,
-                                 N,
-                                 3,
-                                 0,
-                                 (void*)frame.particle_data.image.data());
+        retval = writeChunk("particles/image",
+                            GSD_TYPE_INT32,
+                            N,
+                            3,
+                            0,
+                            (void*)frame.particle_data.image.data());
         GSDUtils::checkError(retval, m_fname);
         if (m_nframes == 0)
             m_nondefault["particles/image"] = true;
@@ -747,116 +1226,88 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "GSD: writing bonds/N" << endl;
         uint32_t N = bond.size;
-        int retval = gsd_write_chunk(&m_handle, "bonds/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
+        int retval = writeChunk("bonds/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
         GSDUtils::checkError(retval, m_fname);
 
         writeTypeMapping("bonds/types", bond.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing bonds/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "bonds/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&bond.type_id[0]);
+        retval = writeChunk("bonds/typeid", GSD_TYPE_UINT32, N, 1, 0, (void*)&bond.type_id[0]);
         GSDUtils::checkError(retval, m_fname);
 
         m_exec_conf->msg->notice(10) << "GSD: writing bonds/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "bonds/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 2,
-                                 0,
-                                 (void*)&bond.groups[0]);
+        retval = writeChunk("bonds/group", GSD_TYPE_UINT32, N, 2, 0, (void*)&bond.groups[0]);
         GSDUtils::checkError(retval, m_fname);
         }
     if (angle.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing angles/N" << endl;
         uint32_t N = angle.size;
-        int retval = gsd_write_chunk(&m_handle, "angles/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
+        int retval = writeChunk("angles/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
         GSDUtils::checkError(retval, m_fname);
 
         writeTypeMapping("angles/types", angle.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing angles/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "angles/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&angle.type_id[0]);
+        retval = writeChunk("angles/typeid", GSD_TYPE_UINT32, N, 1, 0, (void*)&angle.type_id[0]);
         GSDUtils::checkError(retval, m_fname);
 
         m_exec_conf->msg->notice(10) << "GSD: writing angles/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "angles/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 3,
-                                 0,
-                                 (void*)&angle.groups[0]);
+        retval = writeChunk("angles/group", GSD_TYPE_UINT32, N, 3, 0, (void*)&angle.groups[0]);
         GSDUtils::checkError(retval, m_fname);
         }
     if (dihedral.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/N" << endl;
         uint32_t N = dihedral.size;
-        int retval = gsd_write_chunk(&m_handle, "dihedrals/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
+        int retval = writeChunk("dihedrals/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
         GSDUtils::checkError(retval, m_fname);
 
         writeTypeMapping("dihedrals/types", dihedral.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "dihedrals/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&dihedral.type_id[0]);
+        retval = writeChunk("dihedrals/typeid",
+                            GSD_TYPE_UINT32,
+                            N,
+                            1,
+                            0,
+                            (void*)&dihedral.type_id[0]);
         GSDUtils::checkError(retval, m_fname);
 
         m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "dihedrals/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 4,
-                                 0,
-                                 (void*)&dihedral.groups[0]);
+        retval = writeChunk("dihedrals/group",
+                            GSD_TYPE_UINT32,
+                            N,
+                            4,
+                            0,
+                            (void*)&dihedral.groups[0]);
         GSDUtils::checkError(retval, m_fname);
         }
     if (improper.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing impropers/N" << endl;
         uint32_t N = improper.size;
-        int retval = gsd_write_chunk(&m_handle, "impropers/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
+        int retval = writeChunk("impropers/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
         GSDUtils::checkError(retval, m_fname);
 
         writeTypeMapping("impropers/types", improper.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing impropers/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "impropers/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&improper.type_id[0]);
+        retval = writeChunk("impropers/typeid",
+                            GSD_TYPE_UINT32,
+                            N,
+                            1,
+                            0,
+                            (void*)&improper.type_id[0]);
         GSDUtils::checkError(retval, m_fname);
 
         m_exec_conf->msg->notice(10) << "GSD: writing impropers/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "impropers/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 4,
-                                 0,
-                                 (void*)&improper.groups[0]);
+        retval = writeChunk("impropers/group",
+                            GSD_TYPE_UINT32,
+                            N,
+                            4,
+                            0,
+                            (void*)&improper.groups[0]);
         GSDUtils::checkError(retval, m_fname);
         }
 
@@ -864,8 +1315,7 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "GSD: writing constraints/N" << endl;
         uint32_t N = constraint.size;
-        int retval
-            = gsd_write_chunk(&m_handle, "constraints/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
+        int retval = writeChunk("constraints/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
         GSDUtils::checkError(retval, m_fname);
 
         m_exec_conf->msg->notice(10) << "GSD: writing constraints/value" << endl;
@@ -875,24 +1325,17 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
             for (unsigned int i = 0; i < N; i++)
                 data[i] = float(constraint.val[i]);
 
-            retval = gsd_write_chunk(&m_handle,
-                                     "constraints/value",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)&data[0]);
+            retval = writeChunk("constraints/value", GSD_TYPE_FLOAT, N, 1, 0, (void*)&data[0]);
             GSDUtils::checkError(retval, m_fname);
             }
 
         m_exec_conf->msg->notice(10) << "GSD: writing constraints/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "constraints/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 2,
-                                 0,
-                                 (void*)&constraint.groups[0]);
+        retval = writeChunk("constraints/group",
+                            GSD_TYPE_UINT32,
+                            N,
+                            2,
+                            0,
+                            (void*)&constraint.groups[0]);
         GSDUtils::checkError(retval, m_fname);
         }
 
@@ -900,33 +1343,119 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "GSD: writing pairs/N" << endl;
         uint32_t N = pair.size;
-        int retval = gsd_write_chunk(&m_handle, "pairs/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
+        int retval = writeChunk("pairs/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
         GSDUtils::checkError(retval, m_fname);
 
         writeTypeMapping("pairs/types", pair.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing pairs/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "pairs/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&pair.type_id[0]);
+        retval = writeChunk("pairs/typeid", GSD_TYPE_UINT32, N, 1, 0, (void*)&pair.type_id[0]);
         GSDUtils::checkError(retval, m_fname);
 
         m_exec_conf->msg->notice(10) << "GSD: writing pairs/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "pairs/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 2,
-                                 0,
-                                 (void*)&pair.groups[0]);
+        retval = writeChunk("pairs/group", GSD_TYPE_UINT32, N, 2, 0, (void*)&pair.groups[0]);
         GSDUtils::checkError(retval, m_fname);
         }
     }
 
+/*! \param name Name of the logged quantity
+    \param value Logged value
+    \param type Set to the GSD type of the chunk
+    \param N Set to the number of rows in the chunk
+    \param M Set to the number of columns in the chunk
+    \returns The value as a C-contiguous array
+
+    Scalars are stored as 1x1 chunks, 1D arrays as Nx1, and 2D arrays as NxM.
+*/
+pybind11::array GSDDumpWriter::getLogChunk(const std::string& name,
+                                           pybind11::handle value,
+                                           gsd_type& type,
+                                           uint64_t& N,
+                                           uint32_t& M)
+    {
+    pybind11::array arr = pybind11::array::ensure(value, pybind11::array::c_style);
+    type = GSD_TYPE_UINT8;
+    auto dtype = arr.dtype();
+    if (dtype.kind() == 'u' && dtype.itemsize() == 1)
+        {
+        type = GSD_TYPE_UINT8;
+        }
+    else if (dtype.kind() == 'u' && dtype.itemsize() == 2)
+        {
+        type = GSD_TYPE_UINT16;
+        }
+    else if (dtype.kind() == 'u' && dtype.itemsize() == 4)
+        {
+        type = GSD_TYPE_UINT32;
+        }
+    else if (dtype.kind() == 'u' && dtype.itemsize() == 8)
+        {
+        type = GSD_TYPE_UINT64;
+        }
+    else if (dtype.kind() == 'i' && dtype.itemsize() == 1)
+        {
+        type = GSD_TYPE_INT8;
+        }
+    else if (dtype.kind() == 'i' && dtype.itemsize() == 2)
+        {
+        type = GSD_TYPE_INT16;
+        }
+    else if (dtype.kind() == 'i' && dtype.itemsize() == 4)
+        {
+        type = GSD_TYPE_INT32;
+        }
+    else if (dtype.kind() == 'i' && dtype.itemsize() == 8)
+        {
+        type = GSD_TYPE_INT64;
+        }
+    else if (dtype.kind() == 'f' && dtype.itemsize() == 4)
+        {
+        type = GSD_TYPE_FLOAT;
+        }
+    else if (dtype.kind() == 'f' && dtype.itemsize() == 8)
+        {
+        type = GSD_TYPE_DOUBLE;
+        }
+    else if (dtype.kind() == 'b' && dtype.itemsize() == 1)
+        {
+        type = GSD_TYPE_UINT8;
+        }
+    else
+        {
+        throw range_error("Invalid numpy array format in gsd log data [" + name
+                          + "]: " + string(pybind11::str(arr.dtype())));
+        }
+
+    M = 1;
+    N = 1;
+    auto ndim = arr.ndim();
+    if (ndim == 0)
+        {
+        // numpy converts scalars to arrays with zero dimensions
+        // gsd treats them as 1x1 arrays.
+        M = 1;
+        N = 1;
+        }
+    if (ndim == 1)
+        {
+        N = arr.shape(0);
+        M = 1;
+        }
+    if (ndim == 2)
+        {
+        if (arr.shape(1) > std::numeric_limits<uint32_t>::max())
+            throw runtime_error("Array dimension too large in gsd log data [" + name + "]");
+        N = arr.shape(0);
+        M = (uint32_t)arr.shape(1);
+        }
+    if (ndim > 2)
+        {
+        throw invalid_argument("Invalid numpy dimension in gsd log data [" + name + "]");
+        }
+
+    return arr;
+    }
+
 void GSDDumpWriter::writeLogQuantities(pybind11::dict dict)
     {
     for (auto key_iter = dict.begin(); key_iter != dict.end(); ++key_iter)
@@ -934,88 +1463,12 @@ void GSDDumpWriter::writeLogQuantities(pybind11::dict dict)
         std::string name = pybind11::cast<std::string>(key_iter->first);
         m_exec_conf->msg->notice(10) << "GSD: writing " << name << endl;
 
-        pybind11::array arr = pybind11::array::ensure(key_iter->second, pybind11::array::c_style);
-        gsd_type type = GSD_TYPE_UINT8;
-        auto dtype = arr.dtype();
-        if (dtype.kind() == 'u' && dtype.itemsize() == 1)
-            {
-            type = GSD_TYPE_UINT8;
-            }
-        else if (dtype.kind() == 'u' && dtype.itemsize() == 2)
-            {
-            type = GSD_TYPE_UINT16;
-            }
-        else if (dtype.kind() == 'u' && dtype.itemsize() == 4)
-            {
-            type = GSD_TYPE_UINT32;
-            }
-        else if (dtype.kind() == 'u' && dtype.itemsize() == 8)
-            {
-            type = GSD_TYPE_UINT64;
-            }
-        else if (dtype.kind() == 'i' && dtype.itemsize() == 1)
-            {
-            type = GSD_TYPE_INT8;
-            }
-        else if (dtype.kind() == 'i' && dtype.itemsize() == 2)
-            {
-            type = GSD_TYPE_INT16;
-            }
-        else if (dtype.kind() == 'i' && dtype.itemsize() == 4)
-            {
-            type = GSD_TYPE_INT32;
-            }
-        else if (dtype.kind() == 'i' && dtype.itemsize() == 8)
-            {
-            type = GSD_TYPE_INT64;
-            }
-        else if (dtype.kind() == 'f' && dtype.itemsize() == 4)
-            {
-            type = GSD_TYPE_FLOAT;
-            }
-        else if (dtype.kind() == 'f' && dtype.itemsize() == 8)
-            {
-            type = GSD_TYPE_DOUBLE;
-            }
-        else if (dtype.kind() == 'b' && dtype.itemsize() == 1)
-            {
-            type = GSD_TYPE_UINT8;
-            }
-        else
-            {
-            throw range_error("Invalid numpy array format in gsd log data [" + name
-                              + "]: " + string(pybind11::str(arr.dtype())));
-            }
+        gsd_type type;
+        uint64_t N;
+        uint32_t M;
+        pybind11::array arr = getLogChunk(name, key_iter->second, type, N, M);
 
-        size_t M = 1;
-        size_t N = 1;
-        auto ndim = arr.ndim();
-        if (ndim == 0)
-            {
-            // numpy converts scalars to arrays with zero dimensions
-            // gsd treats them as 1x1 arrays.
-            M = 1;
-            N = 1;
-            }
-        if (ndim == 1)
-            {
-            N = arr.shape(0);
-            M = 1;
-            }
-        if (ndim == 2)
-            {
-            N = arr.shape(0);
-            M = arr.shape(1);
-            if (M > std::numeric_limits<uint32_t>::max())
-                throw runtime_error("Array dimension too large in gsd log data [" + name + "]");
-            }
-        if (ndim > 2)
-            {
-            throw invalid_argument("Invalid numpy dimension in gsd log data [" + name + "]");
-            }
-
-        int retval
-            = gsd_write_chunk(&m_handle, name.c_str(), type, N, (uint32_t)M, 0, (void*)arr.data());
+        int retval = writeChunk(name.c_str(), type, N, M, 0, (void*)arr.data());
         GSDUtils::checkError(retval, m_fname);
         }
     }
@@ -1053,6 +1506,10 @@ void GSDDumpWriter::populateNonDefault()
         const gsd_index_entry* entry = gsd_find_chunk(&m_handle, 0, chunk.c_str());
         m_nondefault[chunk] = (entry != nullptr);
         }
+    if (gsd_find_chunk(&m_handle, 0, GSDUtils::quantized_position_key) != nullptr)
+        {
+        m_nondefault["particles/position"] = true;
+        }
 
     // close the file
     gsd_close(&m_handle);
@@ -1067,9 +1524,6 @@ void GSDDumpWriter::populateLocalFrame(GSDDumpWriter::GSDFrame& frame, uint64_t
 
     uint32_t N = m_group->getNumMembersGlobal();
 
-    // Assume values are all default to start, set flags to false when we find a non-default.
-    std::bitset<n_gsd_flags> all_default;
-    all_default.set();
     frame.clear();
 
     ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
@@ -1092,19 +1546,122 @@ void GSDDumpWriter::populateLocalFrame(GSDDumpWriter::GSDFrame& frame, uint64_t
                 }
 
             frame.particle_tags.push_back(h_tag.data[index]);
+            frame.particle_index.push_back(group_tag_index);
             m_index.push_back(index);
             }
         }
 
+    std::bitset<n_particle_arrays> needed = getNeededParticleArrays();
+    ParticleArrays arrays;
+    arrays.origin = m_pdata->getOrigin();
+
+    // access only the arrays that the frame needs
+    std::optional<ArrayHandle<Scalar4>> h_postype;
+    std::optional<ArrayHandle<int3>> h_image;
+    std::optional<ArrayHandle<Scalar4>> h_orientation;
+    std::optional<ArrayHandle<Scalar4>> h_velocity_mass;
+    std::optional<ArrayHandle<Scalar>> h_charge;
+    std::optional<ArrayHandle<Scalar>> h_diameter;
+    std::optional<ArrayHandle<unsigned int>> h_body;
+    std::optional<ArrayHandle<Scalar3>> h_inertia;
+    std::optional<ArrayHandle<Scalar4>> h_angmom;
+
+    if (N > 0 && needed[particle_array::postype])
+        {
+        h_postype.emplace(m_pdata->getPositions(), access_location::host, access_mode::read);
+        arrays.postype = h_postype->data;
+        }
+    if (N > 0 && needed[particle_array::image])
+        {
+        h_image.emplace(m_pdata->getImages(), access_location::host, access_mode::read);
+        arrays.image = h_image->data;
+        }
+    if (N > 0 && needed[particle_array::orientation])
+        {
+        h_orientation.emplace(m_pdata->getOrientationArray(),
+                              access_location::host,
+                              access_mode::read);
+        arrays.orientation = h_orientation->data;
+        }
+    if (N > 0 && needed[particle_array::velocity])
+        {
+        h_velocity_mass.emplace(m_pdata->getVelocities(), access_location::host, access_mode::read);
+        arrays.velocity = h_velocity_mass->data;
+        }
+    if (N > 0 && needed[particle_array::charge])
+        {
+        h_charge.emplace(m_pdata->getCharges(), access_location::host, access_mode::read);
+        arrays.charge = h_charge->data;
+        }
+    if (N > 0 && needed[particle_array::diameter])
+        {
+        h_diameter.emplace(m_pdata->getDiameters(), access_location::host, access_mode::read);
+        arrays.diameter = h_diameter->data;
+        }
+    if (N > 0 && needed[particle_array::body])
+        {
+        h_body.emplace(m_pdata->getBodies(), access_location::host, access_mode::read);
+        arrays.body = h_body->data;
+        }
+    if (N > 0 && needed[particle_array::inertia])
+        {
+        h_inertia.emplace(m_pdata->getMomentsOfInertiaArray(),
+                          access_location::host,
+                          access_mode::read);
+        arrays.inertia = h_inertia->data;
+        }
+    if (N > 0 && needed[particle_array::angmom])
+        {
+        h_angmom.emplace(m_pdata->getAngularMomentumArray(),
+                         access_location::host,
+                         access_mode::read);
+        arrays.angmom = h_angmom->data;
+        }
+
+    populateParticleData(frame, arrays, m_index);
+    populateTopology(frame);
+    }
+
+/*! The next frame reads an array when it writes one of the fields stored in the array. The first
+    frame in the file writes all fields.
+*/
+std::bitset<GSDDumpWriter::n_particle_arrays> GSDDumpWriter::getNeededParticleArrays()
+    {
+    bool all = m_nframes == 0;
+    std::bitset<n_particle_arrays> needed;
+    needed[particle_array::postype] = all || m_dynamic[gsd_flag::particles_position]
+                                      || m_dynamic[gsd_flag::particles_type]
+                                      || m_dynamic[gsd_flag::particles_image];
+    needed[particle_array::image] = all || m_dynamic[gsd_flag::particles_image];
+    needed[particle_array::orientation] = all || m_dynamic[gsd_flag::particles_orientation];
+    needed[particle_array::velocity]
+        = all || m_dynamic[gsd_flag::particles_velocity] || m_dynamic[gsd_flag::particles_mass];
+    needed[particle_array::charge] = all || m_dynamic[gsd_flag::particles_charge];
+    needed[particle_array::diameter] = all || m_dynamic[gsd_flag::particles_diameter];
+    needed[particle_array::body] = all || m_dynamic[gsd_flag::particles_body];
+    needed[particle_array::inertia] = all || m_dynamic[gsd_flag::particles_inertia];
+    needed[particle_array::angmom] = all || m_dynamic[gsd_flag::particles_angmom];
+    return needed;
+    }
+
+/*! \param frame Frame to populate. The caller sets particle_tags and particle_index.
+    \param arrays Per-particle arrays in local index order
+    \param indices Local indices of the particles in the frame, in ascending tag order
+*/
+void GSDDumpWriter::populateParticleData(GSDFrame& frame,
+                                         const ParticleArrays& arrays,
+                                         const std::vector<unsigned int>& indices)
+    {
+    uint32_t N = m_group->getNumMembersGlobal();
+
+    // Assume values are all default to start, set flags to false when we find a non-default.
+    std::bitset<n_gsd_flags> all_default;
+    all_default.set();
+
     if (N > 0
         && (m_dynamic[gsd_flag::particles_position] || m_dynamic[gsd_flag::particles_type]
             || m_dynamic[gsd_flag::particles_image] || m_nframes == 0))
         {
-        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
-                                       access_location::host,
-                                       access_mode::read);
-        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
-
         if (m_dynamic[gsd_flag::particles_position] || m_nframes == 0)
             {
             frame.particle_data_present[gsd_flag::particles_position] = true;
@@ -1118,16 +1675,16 @@ void GSDDumpWriter::populateLocalFrame(GSDDumpWriter::GSDFrame& frame, uint64_t
             frame.particle_data_present[gsd_flag::particles_type] = true;
             }
 
-        for (unsigned int index : m_index)
+        for (unsigned int index : indices)
             {
             vec3<Scalar> position
-                = vec3<Scalar>(h_postype.data[index]) - vec3<Scalar>(m_pdata->getOrigin());
-            unsigned int type = __scalar_as_int(h_postype.data[index].w);
+                = vec3<Scalar>(arrays.postype[index]) - vec3<Scalar>(arrays.origin);
+            unsigned int type = __scalar_as_int(arrays.postype[index].w);
             int3 image = make_int3(0, 0, 0);
 
             if (m_dynamic[gsd_flag::particles_image] || m_nframes == 0)
                 {
-                image = h_image.data[index];
+                image = arrays.image[index];
                 }
 
             frame.global_box.wrap(position, image);
@@ -1166,14 +1723,11 @@ void GSDDumpWriter::populateLocalFrame(GSDDumpWriter::GSDFrame& frame, uint64_t
 
     if (N > 0 && (m_dynamic[gsd_flag::particles_orientation] || m_nframes == 0))
         {
-        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
-                                           access_location::host,
-                                           access_mode::read);
         frame.particle_data_present[gsd_flag::particles_orientation] = true;
 
-        for (unsigned int index : m_index)
+        for (unsigned int index : indices)
             {
-            quat<Scalar> orientation(h_orientation.data[index]);
+            quat<Scalar> orientation(arrays.orientation[index]);
             if (orientation.s != Scalar(1.0) || orientation.v.x != Scalar(0.0)
                 || orientation.v.y != Scalar(0.0) || orientation.v.z != Scalar(0.0))
                 {
@@ -1188,10 +1742,6 @@ void GSDDumpWriter::populateLocalFrame(GSDDumpWriter::GSDFrame& frame, uint64_t
         && (m_dynamic[gsd_flag::particles_velocity] || m_dynamic[gsd_flag::particles_mass]
             || m_nframes == 0))
         {
-        ArrayHandle<Scalar4> h_velocity_mass(m_pdata->getVelocities(),
-                                             access_location::host,
-                                             access_mode::read);
-
         if (m_dynamic[gsd_flag::particles_mass] || m_nframes == 0)
             {
             frame.particle_data_present[gsd_flag::particles_mass] = true;
@@ -1201,12 +1751,12 @@ void GSDDumpWriter::populateLocalFrame(GSDDumpWriter::GSDFrame& frame, uint64_t
             frame.particle_data_present[gsd_flag::particles_velocity] = true;
             }
 
-        for (unsigned int index : m_index)
+        for (unsigned int index : indices)
             {
-            vec3<float> velocity = vec3<float>(static_cast<float>(h_velocity_mass.data[index].x),
-                                               static_cast<float>(h_velocity_mass.data[index].y),
-                                               static_cast<float>(h_velocity_mass.data[index].z));
-            float mass = static_cast<float>(h_velocity_mass.data[index].w);
+            vec3<float> velocity = vec3<float>(static_cast<float>(arrays.velocity[index].x),
+                                               static_cast<float>(arrays.velocity[index].y),
+                                               static_cast<float>(arrays.velocity[index].z));
+            float mass = static_cast<float>(arrays.velocity[index].w);
 
             if (m_dynamic[gsd_flag::particles_mass] || m_nframes == 0)
                 {
@@ -1232,15 +1782,11 @@ void GSDDumpWriter::populateLocalFrame(GSDDumpWriter::GSDFrame& frame, uint64_t
 
     if (N > 0 && (m_dynamic[gsd_flag::particles_charge] || m_nframes == 0))
         {
-        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
-                                     access_location::host,
-                                     access_mode::read);
-
         frame.particle_data_present[gsd_flag::particles_charge] = true;
 
-        for (unsigned int index : m_index)
+        for (unsigned int index : indices)
             {
-            float charge = static_cast<float>(h_charge.data[index]);
+            float charge = static_cast<float>(arrays.charge[index]);
             if (charge != 0.0f)
                 {
                 all_default[gsd_flag::particles_charge] = false;
@@ -1252,15 +1798,11 @@ void GSDDumpWriter::populateLocalFrame(GSDDumpWriter::GSDFrame& frame, uint64_t
 
     if (N > 0 && (m_dynamic[gsd_flag::particles_diameter] || m_nframes == 0))
         {
-        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
-                                       access_location::host,
-                                       access_mode::read);
-
         frame.particle_data_present[gsd_flag::particles_diameter] = true;
 
-        for (unsigned int index : m_index)
+        for (unsigned int index : indices)
             {
-            float diameter = static_cast<float>(h_diameter.data[index]);
+            float diameter = static_cast<float>(arrays.diameter[index]);
 
             if (diameter != 1.0f)
                 {
@@ -1273,15 +1815,11 @@ void GSDDumpWriter::populateLocalFrame(GSDDumpWriter::GSDFrame& frame, uint64_t
 
     if (N > 0 && (m_dynamic[gsd_flag::particles_body] || m_nframes == 0))
         {
-        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
-                                         access_location::host,
-                                         access_mode::read);
-
         frame.particle_data_present[gsd_flag::particles_body] = true;
 
-        for (unsigned int index : m_index)
+        for (unsigned int index : indices)
             {
-            unsigned int body = h_body.data[index];
+            unsigned int body = arrays.body[index];
 
             if (body != NO_BODY)
                 {
@@ -1294,15 +1832,11 @@ void GSDDumpWriter::populateLocalFrame(GSDDumpWriter::GSDFrame& frame, uint64_t
 
     if (N > 0 && (m_dynamic[gsd_flag::particles_inertia] || m_nframes == 0))
         {
-        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
-                                       access_location::host,
-                                       access_mode::read);
-
         frame.particle_data_present[gsd_flag::particles_inertia] = true;
 
-        for (unsigned int index : m_index)
+        for (unsigned int index : indices)
             {
-            vec3<float> inertia = vec3<float>(h_inertia.data[index]);
+            vec3<float> inertia = vec3<float>(arrays.inertia[index]);
 
             if (inertia != vec3<float>(0, 0, 0))
                 {
@@ -1315,15 +1849,11 @@ void GSDDumpWriter::populateLocalFrame(GSDDumpWriter::GSDFrame& frame, uint64_t
 
     if (N > 0 && (m_dynamic[gsd_flag::particles_angmom] || m_nframes == 0))
         {
-        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
-                                      access_location::host,
-                                      access_mode::read);
-
         frame.particle_data_present[gsd_flag::particles_angmom] = true;
 
-        for (unsigned int index : m_index)
+        for (unsigned int index : indices)
             {
-            quat<float> angmom = quat<float>(h_angmom.data[index]);
+            quat<float> angmom = quat<float>(arrays.angmom[index]);
 
             if (angmom.s != 0.0f || angmom.v.x != 0.0f || angmom.v.y != 0.0f || angmom.v.z != 0.0f)
                 {
@@ -1433,7 +1963,12 @@ void GSDDumpWriter::populateLocalFrame(GSDDumpWriter::GSDFrame& frame, uint64_t
         frame.particle_data.image.resize(0);
         frame.particle_data_present[gsd_flag::particles_image] = false;
         }
+    }
 
+/*! \param frame Frame to populate
+ */
+void GSDDumpWriter::populateTopology(GSDFrame& frame)
+    {
     // capture topology data
     if (m_group->getNumMembersGlobal() != m_pdata->getNGlobal() && m_write_topology)
         {
@@ -1526,6 +2061,186 @@ void GSDDumpWriter::gatherGlobalFrame(const GSDFrame& local_frame)
         }
     }
 
+/*! Write the per-particle chunks without gathering the frame on the root rank. The root rank
+    reserves space for each chunk at the end of the file and broadcasts the locations. Each rank
+    then writes its particles at the offsets given by their index in the group with a collective
+    MPI-IO write.
+*/
+void GSDDumpWriter::writeParticlesCollective(const GSDFrame& local_frame)
+    {
+    uint32_t N = m_group->getNumMembersGlobal();
+    const SnapshotParticleData<float>& data = local_frame.particle_data;
+
+    std::exception_ptr error;
+    if (m_exec_conf->isRoot() && (m_dynamic[gsd_flag::particles_types] || m_nframes == 0))
+        {
+        try
+            {
+            writeTypeMapping("particles/types", data.type_mapping);
+            }
+        catch (...)
+            {
+            error = std::current_exception();
+            }
+        }
+    shareIOError(error);
+
+    // list the chunks present in this frame, the particle_data_present flags are the same on
+    // all ranks
+    struct CollectiveChunk
+        {
+        const char* name;
+        gsd_type type;
+        uint32_t M;
+        const void* data;
+        };
+    std::vector<CollectiveChunk> chunks;
+
+    auto add_chunk
+        = [&](gsd_flag::Enum flag, const char* name, gsd_type type, uint32_t M, const void* ptr)
+    {
+        if (local_frame.particle_data_present[flag])
+            {
+            chunks.push_back(CollectiveChunk {name, type, M, ptr});
+            }
+    };
+
+    add_chunk(gsd_flag::particles_type,
+              "particles/typeid",
+              GSD_TYPE_UINT32,
+              1,
+              data.type.data());
+    add_chunk(gsd_flag::particles_mass, "particles/mass", GSD_TYPE_FLOAT, 1, data.mass.data());
+    add_chunk(gsd_flag::particles_charge,
+              "particles/charge",
+              GSD_TYPE_FLOAT,
+              1,
+              data.charge.data());
+    if (m_write_diameter)
+        {
+        add_chunk(gsd_flag::particles_diameter,
+                  "particles/diameter",
+                  GSD_TYPE_FLOAT,
+                  1,
+                  data.diameter.data());
+        }
+    add_chunk(gsd_flag::particles_body, "particles/body", GSD_TYPE_INT32, 1, data.body.data());
+    add_chunk(gsd_flag::particles_inertia,
+              "particles/moment_inertia",
+              GSD_TYPE_FLOAT,
+              3,
+              data.inertia.data());
+    add_chunk(gsd_flag::particles_position,
+              "particles/position",
+              GSD_TYPE_FLOAT,
+              3,
+              data.pos.data());
+    add_chunk(gsd_flag::particles_orientation,
+              "particles/orientation",
+              GSD_TYPE_FLOAT,
+              4,
+              data.orientation.data());
+    add_chunk(gsd_flag::particles_velocity,
+              "particles/velocity",
+              GSD_TYPE_FLOAT,
+              3,
+              data.vel.data());
+    add_chunk(gsd_flag::particles_angmom,
+              "particles/angmom",
+              GSD_TYPE_FLOAT,
+              4,
+              data.angmom.data());
+    add_chunk(gsd_flag::particles_image,
+              "particles/image",
+              GSD_TYPE_INT32,
+              3,
+              data.image.data());
+
+    if (N == 0 || chunks.size() == 0)
+        {
+        return;
+        }
+
+    // reserve space for the chunks on the root rank, locations[0] holds the error code
+    MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    std::vector<int64_t> locations(chunks.size() + 1, 0);
+    if (m_exec_conf->isRoot())
+        {
+        for (size_t i = 0; i < chunks.size() && locations[0] == GSD_SUCCESS; i++)
+            {
+            m_exec_conf->msg->notice(10) << "GSD: reserving " << chunks[i].name << endl;
+            locations[0] = gsd_reserve_chunk(&m_handle,
+                                             chunks[i].name,
+                                             chunks[i].type,
+                                             N,
+                                             chunks[i].M,
+                                             0,
+                                             &locations[i + 1]);
+            }
+        }
+    MPI_Bcast(locations.data(), int(locations.size()), MPI_INT64_T, 0, mpi_comm);
+    GSDUtils::checkError(int(locations[0]), m_fname);
+
+    MPI_File fh;
+    int retval = MPI_File_open(mpi_comm,
+                               (char*)m_fname.c_str(),
+                               MPI_MODE_WRONLY,
+                               MPI_INFO_NULL,
+                               &fh);
+    if (retval != MPI_SUCCESS)
+        {
+        throw std::runtime_error("GSD: Error opening " + m_fname + " with MPI-IO");
+        }
+
+    size_t n_local = local_frame.particle_index.size();
+    std::vector<MPI_Aint> displacements(n_local);
+
+    for (size_t i = 0; i < chunks.size(); i++)
+        {
+        const CollectiveChunk& chunk = chunks[i];
+        m_exec_conf->msg->notice(10) << "GSD: writing " << chunk.name << endl;
+
+        // select this rank's elements in the chunk
+        int element_size = int(chunk.M * gsd_sizeof_type(chunk.type));
+        for (size_t j = 0; j < n_local; j++)
+            {
+            displacements[j] = MPI_Aint(local_frame.particle_index[j]) * element_size;
+            }
+
+        MPI_Datatype file_type;
+        MPI_Type_create_hindexed_block(int(n_local),
+                                       element_size,
+                                       displacements.data(),
+                                       MPI_BYTE,
+                                       &file_type);
+        MPI_Type_commit(&file_type);
+
+        MPI_File_set_view(fh, locations[i + 1], MPI_BYTE, file_type, "native", MPI_INFO_NULL);
+
+        MPI_Status status;
+        retval = MPI_File_write_all(fh,
+                                    chunk.data,
+                                    int(n_local) * element_size,
+                                    MPI_BYTE,
+                                    &status);
+        MPI_Type_free(&file_type);
+
+        if (retval != MPI_SUCCESS)
+            {
+            MPI_File_close(&fh);
+            throw std::runtime_error("GSD: Error writing " + std::string(chunk.name) + " to "
+                                     + m_fname + " with MPI-IO");
+            }
+
+        if (m_nframes == 0)
+            {
+            m_nondefault[chunk.name] = true;
+            }
+        }
+
+    MPI_File_close(&fh);
+    }
+
 #endif
 
 namespace detail
@@ -1555,7 +2270,19 @@ void export_GSDDumpWriter(pybind11::module& m)
         .def("flush", &GSDDumpWriter::flush)
         .def_property("maximum_write_buffer_size",
                       &GSDDumpWriter::getMaximumWriteBufferSize,
-                      &GSDDumpWriter::setMaximumWriteBufferSize);
+                      &GSDDumpWriter::setMaximumWriteBufferSize)
+        .def_property("maximum_frames_in_flight",
+                      &GSDDumpWriter::getMaximumFramesInFlight,
+                      &GSDDumpWriter::setMaximumFramesInFlight)
+        .def_property("collective_write",
+                      &GSDDumpWriter::getCollectiveWrite,
+                      &GSDDumpWriter::setCollectiveWrite)
+        .def_property("position_precision",
+                      &GSDDumpWriter::getPositionPrecision,
+                      &GSDDumpWriter::setPositionPrecision)
+        .def_property("position_keyframe_interval",
+                      &GSDDumpWriter::getPositionKeyframeInterval,
+                      &GSDDumpWriter::setPositionKeyframeInterval);
     }
 
     } // end namespace detail
@@ -8,8 +8,14 @@
 #include "SharedSignal.h"
 
 #include "hoomd/extern/gsd.h"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 
 /*! \file GSDDumpWriter.h
     \brief Declares the GSDDumpWriter class
@@ -19,6 +25,7 @@
 #error This header cannot be compiled by nvcc
 #endif
 
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 
 namespace hoomd
@@ -30,6 +37,12 @@ namespace hoomd
 
     The file is not opened until the first call to analyze().
 
+    When the maximum number of frames in flight is non-zero, GSDDumpWriter writes asynchronously.
+    analyze() still gathers the frame on the calling thread, but copies the chunks into a frame
+    buffer and hands it off to a background I/O thread that writes the chunks to the file. When
+    the given number of frames are waiting to be written, analyze() blocks until the I/O thread
+    completes one. flush() and the write buffer size methods first wait for all pending frames.
+
     \ingroup analyzers
 */
 class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
@@ -82,6 +95,13 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
     /// Write a logged quantities
     void writeLogQuantities(pybind11::dict dict);
 
+    /// Convert a logged value to an array and determine its chunk type and shape
+    static pybind11::array getLogChunk(const std::string& name,
+                                       pybind11::handle value,
+                                       gsd_type& type,
+                                       uint64_t& N,
+                                       uint32_t& M);
+
     /// Set the log writer
     void setLogWriter(pybind11::object log_writer)
         {
@@ -128,6 +148,45 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
     /// Get the maximum write buffer size (in bytes)
     uint64_t getMaximumWriteBufferSize();
 
+    /// Set the maximum number of frames the I/O thread may have pending (0 writes synchronously)
+    void setMaximumFramesInFlight(unsigned int frames);
+
+    /// Get the maximum number of frames the I/O thread may have pending
+    unsigned int getMaximumFramesInFlight()
+        {
+        return m_max_frames_in_flight;
+        }
+
+    /// Set to true to write particle data from all ranks with collective MPI-IO
+    void setCollectiveWrite(bool collective_write)
+        {
+        m_collective_write = collective_write;
+        }
+
+    /// Test if particle data is written from all ranks with collective MPI-IO
+    bool getCollectiveWrite()
+        {
+        return m_collective_write;
+        }
+
+    /// Set the quantization step of the positions as a fraction of the box (0 writes floats)
+    void setPositionPrecision(double position_precision);
+
+    /// Get the quantization step of the positions as a fraction of the box
+    double getPositionPrecision()
+        {
+        return m_position_precision;
+        }
+
+    /// Set the number of frames between keyframes of the quantized positions
+    void setPositionKeyframeInterval(unsigned int interval);
+
+    /// Get the number of frames between keyframes of the quantized positions
+    unsigned int getPositionKeyframeInterval()
+        {
+        return m_position_keyframe_interval;
+        }
+
     protected:
     gsd_handle m_handle; //!< Handle to the file
 
@@ -156,6 +215,43 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
     /// Number of entires in the gsd_flag enum.
     static const unsigned int n_gsd_flags = 14;
 
+    /// Per-particle arrays read to populate the particle data of a frame.
+    struct particle_array
+        {
+        enum Enum
+            {
+            postype,
+            image,
+            orientation,
+            velocity,
+            charge,
+            diameter,
+            body,
+            inertia,
+            angmom,
+            };
+        };
+
+    /// Number of entries in the particle_array enum.
+    static const unsigned int n_particle_arrays = 9;
+
+    /// Pointers to the per-particle arrays, in local index order.
+    /** Arrays that the frame does not need may be null.
+     */
+    struct ParticleArrays
+        {
+        Scalar3 origin = make_scalar3(0, 0, 0);
+        const Scalar4* postype = nullptr;
+        const int3* image = nullptr;
+        const Scalar4* orientation = nullptr;
+        const Scalar4* velocity = nullptr;
+        const Scalar* charge = nullptr;
+        const Scalar* diameter = nullptr;
+        const unsigned int* body = nullptr;
+        const Scalar3* inertia = nullptr;
+        const Scalar4* angmom = nullptr;
+        };
+
     /// Store a GSD frame for writing.
     /** Local frames store particles local to the rank, sorted in ascending tag order.
         Global frames store the entire system, sorted in ascending tag order.
@@ -174,6 +270,9 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
 
         std::vector<unsigned int> particle_tags;
 
+        /// Index of each particle in the group (in the same order as particle_tags)
+        std::vector<unsigned int> particle_index;
+
         SnapshotParticleData<float> particle_data;
         BondData::Snapshot bond_data;
         AngleData::Snapshot angle_data;
@@ -188,6 +287,7 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         void clear()
             {
             particle_tags.resize(0);
+            particle_index.resize(0);
             particle_data.resize(0);
             bond_data.resize(0);
             angle_data.resize(0);
@@ -212,18 +312,40 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
     //! Check and raise an exception if an error occurs
     void checkError(int retval);
 
+    /// Write a chunk to the file or the pending frame buffer
+    int writeChunk(const char* name,
+                   gsd_type type,
+                   uint64_t N,
+                   uint32_t M,
+                   uint8_t flags,
+                   const void* data);
+
     //! Populate the non-default map
     void populateNonDefault();
 
     /// Populate local frame with data.
     void populateLocalFrame(GSDFrame& frame, uint64_t timestep);
 
+    /// Get the per-particle arrays that populateParticleData reads for the next frame.
+    std::bitset<n_particle_arrays> getNeededParticleArrays();
+
+    /// Populate the particle data of a local frame from the given arrays.
+    void populateParticleData(GSDFrame& frame,
+                              const ParticleArrays& arrays,
+                              const std::vector<unsigned int>& indices);
+
+    /// Populate the topology of a local frame.
+    void populateTopology(GSDFrame& frame);
+
 #ifdef ENABLE_MPI
     /// Copy of the state properties on all ranks, in ascending tag order globally.
     GSDFrame m_global_frame;
     GatherTagOrder m_gather_tag_order;
 
     void gatherGlobalFrame(const GSDFrame& local_frame);
+
+    /// Write the per-particle chunks from all ranks with collective MPI-IO
+    void writeParticlesCollective(const GSDFrame& local_frame);
 #endif
 
     private:
@@ -232,10 +354,26 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
     bool m_truncate = false;       //!< True if we should truncate the file on every analyze()
     bool m_write_topology = false; //!< True if topology should be written
     bool m_write_diameter = false; //!< True if the diameter attribute should be written
+    bool m_collective_write = false; //!< True if particles should be written with MPI-IO
 
     /// Flags indicating which particle fields are dynamic.
     std::bitset<n_gsd_flags> m_dynamic;
 
+    /// Quantization step of the positions as a fraction of the box length (0 writes floats)
+    double m_position_precision = 0;
+
+    /// Number of frames between keyframes of the quantized positions
+    unsigned int m_position_keyframe_interval = 100;
+
+    /// Number of frames with quantized positions written since the last keyframe
+    unsigned int m_position_frames_since_keyframe = 0;
+
+    /// Number of particles in the last frame with quantized positions
+    uint64_t m_position_last_N = 0;
+
+    /// Quantized positions in the last frame (accessed only by the thread that writes chunks)
+    std::vector<int32_t> m_quantized_position;
+
     /// Number of frames written to the file.
     uint64_t m_nframes = 0;
 
@@ -254,6 +392,95 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
     /// Working array to sort local particles by tag
     std::vector<unsigned int> m_index;
 
+    /// A chunk copied for the I/O thread
+    struct PendingChunk
+        {
+        std::string name;
+        gsd_type type;
+        uint64_t N;
+        uint32_t M;
+        uint8_t flags;
+        std::vector<char> data;
+
+        /// True when data holds positions to quantize before writing
+        bool quantize = false;
+
+        /// True when the quantized positions are a keyframe
+        bool keyframe = false;
+        };
+
+    /// A frame copied for the I/O thread
+    /*! Frame buffers are recycled, so chunks beyond n_chunks hold allocated but unused memory.
+     */
+    struct PendingFrame
+        {
+        /// Number of chunks in the frame
+        size_t n_chunks = 0;
+
+        /// The chunks
+        std::vector<PendingChunk> chunks;
+
+        /// Box of the frame (used to quantize the positions)
+        BoxDim box;
+        };
+
+    /// Maximum number of frames pending in the I/O thread (0 writes synchronously)
+    unsigned int m_max_frames_in_flight = 0;
+
+    /// The frame that analyze() is currently filling (null when writing synchronously)
+    std::unique_ptr<PendingFrame> m_pending_frame;
+
+    /// The I/O thread
+    std::thread m_io_thread;
+
+    /// Mutex that protects the members shared with the I/O thread
+    std::mutex m_io_mutex;
+
+    /// Notifies the I/O thread that a frame is ready (or that it should stop)
+    std::condition_variable m_io_ready;
+
+    /// Notifies the simulation thread that a frame has been written
+    std::condition_variable m_io_done;
+
+    /// Frames waiting for the I/O thread, in order
+    std::deque<std::unique_ptr<PendingFrame>> m_io_queue;
+
+    /// Frame buffers available for reuse
+    std::vector<std::unique_ptr<PendingFrame>> m_io_free;
+
+    /// Number of frames handed to the I/O thread that are not yet written
+    unsigned int m_frames_in_flight = 0;
+
+    /// Set to true to stop the I/O thread
+    bool m_io_stop = false;
+
+    /// First error raised in the I/O thread
+    std::exception_ptr m_io_error;
+
+    /// Begin a frame (blocks while the maximum number of frames are in flight)
+    void beginFrame();
+
+    /// Complete the current frame
+    void endFrame();
+
+    /// Wait for the I/O thread to write all pending frames
+    void waitForPendingFrames();
+
+    /// Stop the I/O thread after it writes all pending frames
+    void stopIOThread();
+
+    /// Rethrow an error raised in the I/O thread
+    void checkIOError();
+
+    /// Raise an error from the root rank on all ranks
+    void shareIOError(std::exception_ptr error);
+
+    /// Write pending frames to the file (runs on the I/O thread)
+    void ioThreadLoop();
+
+    /// Quantize the positions and write them as a keyframe or as a change from the last frame
+    int writeQuantizedPositions(const BoxDim& box, bool keyframe, uint64_t N, const float* pos);
+
     //! Write a type mapping out to the file
     void writeTypeMapping(std::string chunk, std::vector<std::string> type_mapping);
 
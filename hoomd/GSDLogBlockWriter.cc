@@ -0,0 +1,406 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "GSDLogBlockWriter.h"
+#include "Filesystem.h"
+#include "GSD.h"
+#include "GSDDumpWriter.h"
+#include "HOOMDVersion.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <string.h>
+
+using namespace std;
+using namespace hoomd::detail;
+
+namespace hoomd
+    {
+namespace
+    {
+/// Maximum number of blocks the I/O thread may have pending
+const unsigned int max_blocks_in_flight = 2;
+    } // end anonymous namespace
+
+/*! \param sysdef SystemDefinition containing the ParticleData
+    \param trigger Trigger that selects the timesteps to log
+    \param fname File name to write data to
+    \param mode File open mode ("wb", "xb", or "ab")
+    \param block_size Number of frames in each block
+*/
+GSDLogBlockWriter::GSDLogBlockWriter(std::shared_ptr<SystemDefinition> sysdef,
+                                     std::shared_ptr<Trigger> trigger,
+                                     const std::string& fname,
+                                     std::string mode,
+                                     unsigned int block_size)
+    : Analyzer(sysdef, trigger), m_fname(fname), m_mode(mode), m_block_size(block_size)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing GSDLogBlockWriter: " << m_fname << " " << mode
+                                << " " << block_size << endl;
+    if (mode != "wb" && mode != "xb" && mode != "ab")
+        {
+        throw std::invalid_argument("Invalid GSD file mode: " + mode);
+        }
+    if (block_size == 0)
+        {
+        throw std::invalid_argument("block_size must be positive.");
+        }
+    m_log_writer = pybind11::none();
+
+    initFileIO();
+
+    if (m_exec_conf->isRoot())
+        {
+        m_block = std::make_unique<Block>();
+        m_io_thread = std::thread(&GSDLogBlockWriter::ioThreadLoop, this);
+        }
+    }
+
+GSDLogBlockWriter::~GSDLogBlockWriter()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying GSDLogBlockWriter" << endl;
+
+    if (m_exec_conf->isRoot())
+        {
+        try
+            {
+            if (m_block->n_frames > 0)
+                {
+                queueBlock();
+                }
+            waitForPendingBlocks();
+            }
+        catch (const std::exception& e)
+            {
+            m_exec_conf->msg->error() << e.what() << endl;
+            }
+
+            {
+            std::lock_guard<std::mutex> lock(m_io_mutex);
+            m_io_stop = true;
+            }
+        m_io_ready.notify_one();
+        m_io_thread.join();
+
+        m_exec_conf->msg->notice(5) << "GSD: close gsd file " << m_fname << endl;
+        gsd_close(&m_handle);
+        }
+    }
+
+void GSDLogBlockWriter::initFileIO()
+    {
+    if (!m_exec_conf->isRoot())
+        {
+        return;
+        }
+
+    if (m_mode == "wb" || m_mode == "xb" || (m_mode == "ab" && !filesystem::exists(m_fname)))
+        {
+        ostringstream o;
+        o << "HOOMD-blue " << HOOMD_VERSION;
+
+        m_exec_conf->msg->notice(3) << "GSD: create or overwrite gsd file " << m_fname << endl;
+        int retval = gsd_create_and_open(&m_handle,
+                                         m_fname.c_str(),
+                                         o.str().c_str(),
+                                         "hoomd",
+                                         gsd_make_version(1, 4),
+                                         GSD_OPEN_APPEND,
+                                         m_mode == "xb");
+        GSDUtils::checkError(retval, m_fname);
+        }
+    else
+        {
+        m_exec_conf->msg->notice(3) << "GSD: open gsd file " << m_fname << endl;
+        int retval = gsd_open(&m_handle, m_fname.c_str(), GSD_OPEN_APPEND);
+        GSDUtils::checkError(retval, m_fname);
+
+        if (string(m_handle.header.schema) != string("hoomd")
+            || m_handle.header.schema_version >= gsd_make_version(2, 0))
+            {
+            gsd_close(&m_handle);
+            throw runtime_error("GSD: Invalid schema in " + m_fname);
+            }
+        }
+    }
+
+/*! \param block_size Number of frames in each block
+
+    Hand the current block off to the I/O thread when it already holds \a block_size frames.
+*/
+void GSDLogBlockWriter::setBlockSize(unsigned int block_size)
+    {
+    if (block_size == 0)
+        {
+        throw std::invalid_argument("block_size must be positive.");
+        }
+    m_block_size = block_size;
+
+    if (m_exec_conf->isRoot() && m_block->n_frames >= m_block_size)
+        {
+        queueBlock();
+        }
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void GSDLogBlockWriter::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    if (m_log_writer.is_none())
+        {
+        return;
+        }
+
+    pybind11::dict log_data = m_log_writer.attr("log")().cast<pybind11::dict>();
+    if (!m_exec_conf->isRoot())
+        {
+        return;
+        }
+
+    appendFrame(timestep, log_data);
+    if (m_block->n_frames >= m_block_size)
+        {
+        queueBlock();
+        }
+    }
+
+void GSDLogBlockWriter::flush()
+    {
+    if (!m_exec_conf->isRoot())
+        {
+        return;
+        }
+
+    if (m_block->n_frames > 0)
+        {
+        queueBlock();
+        }
+    waitForPendingBlocks();
+
+    m_exec_conf->msg->notice(5) << "GSD: flush gsd file " << m_fname << endl;
+    int retval = gsd_flush(&m_handle);
+    GSDUtils::checkError(retval, m_fname);
+    }
+
+/*! \param timestep Timestep of the frame
+    \param log_data Logged quantities of the frame, keyed by chunk name
+
+    Start a new block when the quantities do not match the columns of the current block.
+*/
+void GSDLogBlockWriter::appendFrame(uint64_t timestep, pybind11::dict log_data)
+    {
+    std::vector<pybind11::array> arrays;
+    std::vector<Column> layout;
+    arrays.reserve(log_data.size());
+    layout.reserve(log_data.size());
+    for (auto item : log_data)
+        {
+        Column column;
+        column.name = pybind11::cast<std::string>(item.first);
+        arrays.push_back(
+            GSDDumpWriter::getLogChunk(column.name, item.second, column.type, column.N, column.M));
+        column.frame_bytes = column.N * column.M * gsd_sizeof_type(column.type);
+        layout.push_back(std::move(column));
+        }
+
+    bool same_layout = layout.size() == m_block->columns.size();
+    for (size_t i = 0; same_layout && i < layout.size(); i++)
+        {
+        const Column& column = m_block->columns[i];
+        same_layout = column.name == layout[i].name && column.type == layout[i].type
+                      && column.N == layout[i].N && column.M == layout[i].M;
+        }
+
+    if (!same_layout && m_block->n_frames > 0)
+        {
+        queueBlock();
+        }
+
+    if (m_block->n_frames == 0)
+        {
+        m_block->steps.clear();
+        m_block->columns.resize(layout.size());
+        for (size_t i = 0; i < layout.size(); i++)
+            {
+            Column& column = m_block->columns[i];
+            column.name = layout[i].name;
+            column.type = layout[i].type;
+            column.N = layout[i].N;
+            column.M = layout[i].M;
+            column.frame_bytes = layout[i].frame_bytes;
+            column.data.clear();
+            column.data.reserve(column.frame_bytes * m_block_size);
+            }
+        }
+
+    for (size_t i = 0; i < arrays.size(); i++)
+        {
+        Column& column = m_block->columns[i];
+        size_t offset = column.data.size();
+        column.data.resize(offset + column.frame_bytes);
+        if (column.frame_bytes > 0)
+            {
+            memcpy(column.data.data() + offset, arrays[i].data(), column.frame_bytes);
+            }
+        }
+
+    m_block->steps.push_back(timestep);
+    m_block->n_frames++;
+    }
+
+/*! Block until fewer than the maximum number of blocks are in flight, then queue the current
+    block and take an empty one to fill.
+*/
+void GSDLogBlockWriter::queueBlock()
+    {
+    m_exec_conf->msg->notice(10) << "GSD: queueing " << m_block->n_frames << " log frames"
+                                 << endl;
+
+    std::unique_lock<std::mutex> lock(m_io_mutex);
+    m_io_done.wait(lock,
+                   [this] { return m_blocks_in_flight < max_blocks_in_flight || m_io_error; });
+    checkIOError();
+
+    m_io_queue.push_back(std::move(m_block));
+    m_blocks_in_flight++;
+
+    if (m_io_free.empty())
+        {
+        m_block = std::make_unique<Block>();
+        }
+    else
+        {
+        m_block = std::move(m_io_free.back());
+        m_io_free.pop_back();
+        }
+    m_block->n_frames = 0;
+
+    lock.unlock();
+    m_io_ready.notify_one();
+    }
+
+void GSDLogBlockWriter::waitForPendingBlocks()
+    {
+    std::unique_lock<std::mutex> lock(m_io_mutex);
+    m_io_done.wait(lock, [this] { return m_blocks_in_flight == 0; });
+    checkIOError();
+    }
+
+/*! \pre The caller holds m_io_mutex.
+ */
+void GSDLogBlockWriter::checkIOError()
+    {
+    if (m_io_error)
+        {
+        std::exception_ptr error = m_io_error;
+        m_io_error = nullptr;
+        std::rethrow_exception(error);
+        }
+    }
+
+/*! \param block Block to write
+
+    Write one GSD frame per frame in the block.
+*/
+void GSDLogBlockWriter::writeBlock(const Block& block)
+    {
+    for (size_t frame = 0; frame < block.n_frames; frame++)
+        {
+        int retval = gsd_write_chunk(&m_handle,
+                                     "configuration/step",
+                                     GSD_TYPE_UINT64,
+                                     1,
+                                     1,
+                                     0,
+                                     &block.steps[frame]);
+        GSDUtils::checkError(retval, m_fname);
+
+        for (const Column& column : block.columns)
+            {
+            retval = gsd_write_chunk(&m_handle,
+                                     column.name.c_str(),
+                                     column.type,
+                                     column.N,
+                                     column.M,
+                                     0,
+                                     column.data.data() + frame * column.frame_bytes);
+            GSDUtils::checkError(retval, m_fname);
+            }
+
+        retval = gsd_end_frame(&m_handle);
+        GSDUtils::checkError(retval, m_fname);
+        }
+    }
+
+/*! Write blocks from the queue in order until asked to stop. The I/O thread discards the blocks
+    that follow an error until the simulation thread handles the error.
+*/
+void GSDLogBlockWriter::ioThreadLoop()
+    {
+    std::unique_lock<std::mutex> lock(m_io_mutex);
+    while (true)
+        {
+        m_io_ready.wait(lock, [this] { return m_io_stop || !m_io_queue.empty(); });
+        if (m_io_queue.empty())
+            {
+            // m_io_stop is set and all blocks are written
+            return;
+            }
+
+        std::unique_ptr<Block> block = std::move(m_io_queue.front());
+        m_io_queue.pop_front();
+        bool write = !m_io_error;
+        lock.unlock();
+
+        std::exception_ptr error;
+        if (write)
+            {
+            try
+                {
+                writeBlock(*block);
+                }
+            catch (...)
+                {
+                error = std::current_exception();
+                }
+            }
+
+        lock.lock();
+        if (error && !m_io_error)
+            {
+            m_io_error = error;
+            }
+        m_io_free.push_back(std::move(block));
+        m_blocks_in_flight--;
+        m_io_done.notify_all();
+        }
+    }
+
+namespace detail
+    {
+void export_GSDLogBlockWriter(pybind11::module& m)
+    {
+    pybind11::class_<GSDLogBlockWriter, Analyzer, std::shared_ptr<GSDLogBlockWriter>>(
+        m,
+        "GSDLogBlockWriter")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            std::string,
+                            std::string,
+                            unsigned int>())
+        .def_property("log_writer",
+                      &GSDLogBlockWriter::getLogWriter,
+                      &GSDLogBlockWriter::setLogWriter)
+        .def_property_readonly("filename", &GSDLogBlockWriter::getFilename)
+        .def_property_readonly("mode", &GSDLogBlockWriter::getMode)
+        .def_property("block_size",
+                      &GSDLogBlockWriter::getBlockSize,
+                      &GSDLogBlockWriter::setBlockSize)
+        .def("flush", &GSDLogBlockWriter::flush);
+    }
+
+    } // end namespace detail
+
+    } // end namespace hoomd
@@ -0,0 +1,196 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "Analyzer.h"
+
+#include "hoomd/extern/gsd.h"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*! \file GSDLogBlockWriter.h
+    \brief Declares the GSDLogBlockWriter class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+/// Analyzer for writing logged quantities to GSD files in blocks
+/*! GSDLogBlockWriter collects the logged quantities every time analyze() is called and stores
+    them in columnar blocks: one contiguous buffer per quantity that holds the values of many
+    consecutive frames. When a block holds the given number of frames, a background I/O thread
+    writes all of them to the file while the simulation continues to fill the next block.
+
+    Each frame in the file holds the configuration/step chunk and one chunk per logged quantity,
+    as written by GSDDumpWriter with an empty filter, so that the file can be read with
+    gsd.hoomd.read_log.
+
+    A block ends early when the set of quantities or the shape of a quantity changes. flush() and
+    the destructor write the frames in the current block.
+
+    Only the root rank writes to the file. All ranks call the log writer, so that log quantities
+    may use collective communication.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT GSDLogBlockWriter : public Analyzer
+    {
+    public:
+    /// Construct the writer
+    GSDLogBlockWriter(std::shared_ptr<SystemDefinition> sysdef,
+                      std::shared_ptr<Trigger> trigger,
+                      const std::string& fname,
+                      std::string mode = "ab",
+                      unsigned int block_size = 100);
+
+    /// Destructor
+    ~GSDLogBlockWriter();
+
+    /// Collect the logged quantities
+    virtual void analyze(uint64_t timestep);
+
+    /// Write all collected frames to the file and flush it
+    void flush();
+
+    /// Set the log writer
+    void setLogWriter(pybind11::object log_writer)
+        {
+        m_log_writer = log_writer;
+        }
+
+    /// Get the log writer
+    pybind11::object getLogWriter()
+        {
+        return m_log_writer;
+        }
+
+    /// Get the file name
+    std::string getFilename()
+        {
+        return m_fname;
+        }
+
+    /// Get the file open mode
+    std::string getMode()
+        {
+        return m_mode;
+        }
+
+    /// Set the number of frames in each block
+    void setBlockSize(unsigned int block_size);
+
+    /// Get the number of frames in each block
+    unsigned int getBlockSize()
+        {
+        return m_block_size;
+        }
+
+    private:
+    /// Values of one logged quantity in consecutive frames
+    struct Column
+        {
+        std::string name;       //!< Name of the chunk
+        gsd_type type;          //!< Type of the chunk
+        uint64_t N;             //!< Number of rows in the chunk
+        uint32_t M;             //!< Number of columns in the chunk
+        size_t frame_bytes;     //!< Size of the chunk in one frame
+        std::vector<char> data; //!< Chunk data of all frames in the block
+        };
+
+    /// Consecutive frames of logged quantities
+    struct Block
+        {
+        /// Number of frames in the block
+        size_t n_frames = 0;
+
+        /// Timestep of each frame
+        std::vector<uint64_t> steps;
+
+        /// Values of each logged quantity
+        std::vector<Column> columns;
+        };
+
+    std::string m_fname; //!< File name
+    std::string m_mode;  //!< File open mode
+
+    /// Number of frames in each block
+    unsigned int m_block_size;
+
+    /// Callback that provides the log quantities
+    pybind11::object m_log_writer;
+
+    /// Handle to the file
+    gsd_handle m_handle;
+
+    /// The block that analyze() is currently filling
+    std::unique_ptr<Block> m_block;
+
+    /// The I/O thread
+    std::thread m_io_thread;
+
+    /// Mutex that protects the members shared with the I/O thread
+    std::mutex m_io_mutex;
+
+    /// Notifies the I/O thread that a block is ready (or that it should stop)
+    std::condition_variable m_io_ready;
+
+    /// Notifies the simulation thread that a block has been written
+    std::condition_variable m_io_done;
+
+    /// Blocks waiting for the I/O thread, in order
+    std::deque<std::unique_ptr<Block>> m_io_queue;
+
+    /// Block buffers available for reuse
+    std::vector<std::unique_ptr<Block>> m_io_free;
+
+    /// Number of blocks handed to the I/O thread that are not yet written
+    unsigned int m_blocks_in_flight = 0;
+
+    /// Set to true to stop the I/O thread
+    bool m_io_stop = false;
+
+    /// First error raised in the I/O thread
+    std::exception_ptr m_io_error;
+
+    /// Open or create the file
+    void initFileIO();
+
+    /// Append the logged quantities of one frame to the current block
+    void appendFrame(uint64_t timestep, pybind11::dict log_data);
+
+    /// Hand the current block off to the I/O thread
+    void queueBlock();
+
+    /// Wait for the I/O thread to write all pending blocks
+    void waitForPendingBlocks();
+
+    /// Rethrow an error raised in the I/O thread
+    void checkIOError();
+
+    /// Write a block to the file (runs on the I/O thread)
+    void writeBlock(const Block& block);
+
+    /// Write pending blocks to the file (runs on the I/O thread)
+    void ioThreadLoop();
+    };
+
+namespace detail
+    {
+/// Exports the GSDLogBlockWriter class to python
+void export_GSDLogBlockWriter(pybind11::module& m);
+
+    } // end namespace detail
+
+    } // end namespace hoomd
@@ -5,7 +5,9 @@
 #include "ExecutionConfiguration.h"
 #include "GSD.h"
 #include "SnapshotSystemData.h"
+#include "SystemDefinition.h"
 #include "hoomd/extern/gsd.h"
+#include <pybind11/stl.h>
 #include <sstream>
 #include <string.h>
 
@@ -19,6 +21,8 @@ namespace hoomd
     \param name File name to read
     \param frame Frame index to read from the file
     \param from_end Count frames back from the end of the file
+    \param distributed Defer reading the particles and topology to readParticlesDistributed()
+    \param fields Particle chunks and topology sections to read, empty to read all
 
     The GSDReader constructor opens the GSD file, initializes an empty snapshot, and reads the file
    into memory (on the root rank).
@@ -26,9 +30,39 @@ namespace hoomd
 GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                      const std::string& name,
                      const uint64_t frame,
-                     bool from_end)
-    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame)
+                     bool from_end,
+                     bool distributed,
+                     const std::vector<std::string>& fields)
+    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame),
+      m_distributed(distributed), m_distributed_n(0)
     {
+    static const std::set<std::string> valid_fields = {"particles",
+                                                       "particles/typeid",
+                                                       "particles/mass",
+                                                       "particles/charge",
+                                                       "particles/diameter",
+                                                       "particles/body",
+                                                       "particles/moment_inertia",
+                                                       "particles/position",
+                                                       "particles/orientation",
+                                                       "particles/velocity",
+                                                       "particles/angmom",
+                                                       "particles/image",
+                                                       "bonds",
+                                                       "angles",
+                                                       "dihedrals",
+                                                       "impropers",
+                                                       "constraints",
+                                                       "pairs"};
+    for (const std::string& field : fields)
+        {
+        if (valid_fields.count(field) == 0)
+            {
+            throw runtime_error("Cannot select the GSD field " + field + ".");
+            }
+        m_fields.insert(field);
+        }
+
     m_snapshot = std::shared_ptr<SnapshotSystemData<float>>(new SnapshotSystemData<float>);
 
 #ifdef ENABLE_MPI
@@ -73,6 +107,16 @@ GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
         }
 
     readHeader();
+
+    if (m_distributed)
+        {
+        // keep only the types, readParticlesDistributed() reads the rest
+        m_distributed_n = m_snapshot->particle_data.size;
+        m_snapshot->particle_data.resize(0);
+        m_snapshot->particle_data.type_mapping = readTypes(m_frame, "particles/types");
+        return;
+        }
+
     readParticles();
     readTopology();
     }
@@ -90,6 +134,73 @@ GSDReader::~GSDReader()
     gsd_close(&m_handle);
     }
 
+uint64_t GSDReader::getNFrames() const
+    {
+    uint64_t nframes = 0;
+#ifdef ENABLE_MPI
+    if (m_exec_conf->isRoot())
+        {
+        nframes = gsd_get_nframes(const_cast<gsd_handle*>(&m_handle));
+        }
+    bcast(nframes, 0, m_exec_conf->getMPICommunicator());
+#else
+    nframes = gsd_get_nframes(const_cast<gsd_handle*>(&m_handle));
+#endif
+    return nframes;
+    }
+
+/*! \param frame Frame index to read from the file
+
+    Replace the snapshot with a new one that holds the selected fields of \a frame. The file stays
+    open, so reading many frames does not reread the file index.
+*/
+void GSDReader::readFrame(uint64_t frame)
+    {
+    if (m_distributed)
+        {
+        throw runtime_error("Cannot read another frame in distributed mode.");
+        }
+
+    m_snapshot = std::shared_ptr<SnapshotSystemData<float>>(new SnapshotSystemData<float>);
+    m_frame = frame;
+    m_timestep = 0;
+
+#ifdef ENABLE_MPI
+    // if we are not the root processor, do not perform file I/O
+    if (!m_exec_conf->isRoot())
+        {
+        return;
+        }
+#endif
+
+    uint64_t nframes = gsd_get_nframes(&m_handle);
+    if (m_frame >= nframes)
+        {
+        std::ostringstream s;
+        s << "Cannot read frame " << m_frame << " " << m_name << " only has " << nframes
+          << " frames.";
+        throw runtime_error(s.str());
+        }
+
+    readHeader();
+    readParticles();
+    readTopology();
+    }
+
+/*! \param name Name of the particle data chunk
+ */
+bool GSDReader::isSelected(const std::string& name) const
+    {
+    return m_fields.empty() || m_fields.count("particles") > 0 || m_fields.count(name) > 0;
+    }
+
+/*! \param section Name of the topology section
+ */
+bool GSDReader::isSectionSelected(const std::string& section) const
+    {
+    return m_fields.empty() || m_fields.count(section) > 0;
+    }
+
 /*! \param data Pointer to data to read into
     \param frame Frame index to read from
     \param name Name of the data chunk
@@ -137,6 +248,190 @@ bool GSDReader::readChunk(void* data,
         }
     }
 
+/*! \param handle Handle to the open file
+    \param data Pointer to data to read into
+    \param frame Frame index to read from
+    \param name Name of the data chunk
+    \param row_size Expected size of one row of the data chunk in bytes.
+    \param cur_n N in the current frame.
+    \param first_row First row to read.
+    \param n_rows Number of rows to read.
+
+    Same as readChunk(), but read only the rows [first_row, first_row + n_rows) of the chunk.
+*/
+bool GSDReader::readChunkRows(gsd_handle* handle,
+                              void* data,
+                              uint64_t frame,
+                              const char* name,
+                              size_t row_size,
+                              unsigned int cur_n,
+                              uint64_t first_row,
+                              uint64_t n_rows)
+    {
+    const struct gsd_index_entry* entry = gsd_find_chunk(handle, frame, name);
+    if (entry == NULL && frame != 0)
+        entry = gsd_find_chunk(handle, 0, name);
+
+    if (entry == NULL || entry->N != cur_n)
+        {
+        m_exec_conf->msg->notice(10) << "data.gsd_snapshot: chunk not found " << name << endl;
+        return false;
+        }
+
+    m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading chunk rows " << name << endl;
+    size_t actual_size = entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+    if (actual_size != row_size)
+        {
+        std::ostringstream s;
+        s << "Expecting " << row_size << " bytes per row in " << name << " but found "
+          << actual_size << ".";
+        throw runtime_error(s.str());
+        }
+
+    if (n_rows == 0)
+        return true;
+
+    int retval = gsd_read_chunk_rows(handle, data, entry, first_row, n_rows);
+    GSDUtils::checkError(retval, m_name);
+
+    return true;
+    }
+
+/*! \param handle Handle to the open file
+    \param data Pointer to the positions to read into (n_rows x 3 floats)
+    \param frame Frame index to read from
+    \param cur_n N in the current frame.
+    \param first_row First row to read.
+    \param n_rows Number of rows to read.
+
+    GSDDumpWriter writes quantized positions in place of particles/position: a keyframe with the
+    bin index of each coordinate, followed by frames that store the change in the bin index since
+    the previous frame with quantized positions. Read the keyframe at or before \a frame, apply the
+    changes in the later frames, and place each particle at the center of its bin in the box of
+    \a frame.
+
+    Return true when the positions are read.
+*/
+bool GSDReader::readQuantizedPositions(gsd_handle* handle,
+                                       float* data,
+                                       uint64_t frame,
+                                       unsigned int cur_n,
+                                       uint64_t first_row,
+                                       uint64_t n_rows)
+    {
+    if (gsd_find_chunk(handle, frame, GSDUtils::quantized_position_key) == NULL
+        && gsd_find_chunk(handle, frame, GSDUtils::quantized_position_delta) == NULL)
+        {
+        return false;
+        }
+
+    uint64_t key_frame = frame;
+    while (gsd_find_chunk(handle, key_frame, GSDUtils::quantized_position_key) == NULL)
+        {
+        if (key_frame == 0)
+            {
+            throw runtime_error("GSD: Quantized positions without a keyframe in " + m_name);
+            }
+        key_frame--;
+        }
+
+    const struct gsd_index_entry* entry
+        = gsd_find_chunk(handle, key_frame, GSDUtils::quantized_position_key);
+    const struct gsd_index_entry* steps_entry
+        = gsd_find_chunk(handle, key_frame, GSDUtils::quantized_position_steps);
+    if (entry->M != 3 || entry->type != GSD_TYPE_INT32 || steps_entry == NULL
+        || steps_entry->type != GSD_TYPE_UINT32)
+        {
+        throw runtime_error("GSD: Invalid quantized positions in " + m_name);
+        }
+    if (entry->N != cur_n)
+        {
+        // per the GSD spec, keep the default when N does not match
+        return false;
+        }
+
+    m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading quantized positions from frame "
+                                << key_frame << endl;
+    uint32_t steps = 0;
+    int retval = gsd_read_chunk(handle, &steps, steps_entry);
+    GSDUtils::checkError(retval, m_name);
+
+    std::vector<int32_t> q(n_rows * 3);
+    if (n_rows > 0)
+        {
+        retval = gsd_read_chunk_rows(handle, q.data(), entry, first_row, n_rows);
+        GSDUtils::checkError(retval, m_name);
+        }
+
+    std::vector<char> buffer;
+    for (uint64_t i = key_frame + 1; i <= frame; i++)
+        {
+        entry = gsd_find_chunk(handle, i, GSDUtils::quantized_position_delta);
+        if (entry == NULL)
+            {
+            continue;
+            }
+
+        size_t size = gsd_sizeof_type((enum gsd_type)entry->type);
+        if (entry->N != cur_n || entry->M != 3 || size == 0 || size > 4)
+            {
+            throw runtime_error("GSD: Invalid quantized positions in " + m_name);
+            }
+        if (n_rows == 0)
+            {
+            continue;
+            }
+
+        buffer.resize(n_rows * 3 * size);
+        retval = gsd_read_chunk_rows(handle, buffer.data(), entry, first_row, n_rows);
+        GSDUtils::checkError(retval, m_name);
+
+        for (size_t j = 0; j < q.size(); j++)
+            {
+            int64_t delta;
+            if (entry->type == GSD_TYPE_INT8)
+                delta = ((const int8_t*)buffer.data())[j];
+            else if (entry->type == GSD_TYPE_INT16)
+                delta = ((const int16_t*)buffer.data())[j];
+            else
+                delta = ((const int32_t*)buffer.data())[j];
+
+            int64_t value = int64_t(q[j]) + delta;
+            if (value < 0)
+                value += steps;
+            else if (value >= int64_t(steps))
+                value -= steps;
+            q[j] = int32_t(value);
+            }
+        }
+
+    // read the box of the frame with the same rules as readHeader()
+    float box[6] = {1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f};
+    entry = gsd_find_chunk(handle, frame, "configuration/box");
+    if (entry == NULL)
+        entry = gsd_find_chunk(handle, 0, "configuration/box");
+    if (entry != NULL)
+        {
+        retval = gsd_read_chunk(handle, box, entry);
+        GSDUtils::checkError(retval, m_name);
+        }
+    BoxDim global_box(box[0], box[1], box[2]);
+    global_box.setTiltFactors(box[3], box[4], box[5]);
+
+    for (uint64_t i = 0; i < n_rows; i++)
+        {
+        Scalar3 f = make_scalar3((Scalar(q[i * 3]) + Scalar(0.5)) / Scalar(steps),
+                                 (Scalar(q[i * 3 + 1]) + Scalar(0.5)) / Scalar(steps),
+                                 (Scalar(q[i * 3 + 2]) + Scalar(0.5)) / Scalar(steps));
+        Scalar3 x = global_box.makeCoordinates(f);
+        data[i * 3] = float(x.x);
+        data[i * 3 + 1] = float(x.y);
+        data[i * 3 + 2] = float(x.z);
+        }
+
+    return true;
+    }
+
 /*! \param frame Frame index to read from
     \param name Name of the data chunk
 
@@ -222,25 +517,34 @@ void GSDReader::readParticles()
 
     // the snapshot already has default values, if a chunk is not found, the value
     // is already at the default, and the failed read is not a problem
-    readChunk(&m_snapshot->particle_data.type[0], m_frame, "particles/typeid", N * 4, N);
-    readChunk(&m_snapshot->particle_data.mass[0], m_frame, "particles/mass", N * 4, N);
-    readChunk(&m_snapshot->particle_data.charge[0], m_frame, "particles/charge", N * 4, N);
-    readChunk(&m_snapshot->particle_data.diameter[0], m_frame, "particles/diameter", N * 4, N);
-    readChunk(&m_snapshot->particle_data.body[0], m_frame, "particles/body", N * 4, N);
-    readChunk(&m_snapshot->particle_data.inertia[0],
-              m_frame,
-              "particles/moment_inertia",
-              N * 12,
-              N);
-    readChunk(&m_snapshot->particle_data.pos[0], m_frame, "particles/position", N * 12, N);
-    readChunk(&m_snapshot->particle_data.orientation[0],
-              m_frame,
-              "particles/orientation",
-              N * 16,
-              N);
-    readChunk(&m_snapshot->particle_data.vel[0], m_frame, "particles/velocity", N * 12, N);
-    readChunk(&m_snapshot->particle_data.angmom[0], m_frame, "particles/angmom", N * 16, N);
-    readChunk(&m_snapshot->particle_data.image[0], m_frame, "particles/image", N * 12, N);
+    SnapshotParticleData<float>& p = m_snapshot->particle_data;
+    if (isSelected("particles/typeid"))
+        readChunk(&p.type[0], m_frame, "particles/typeid", N * 4, N);
+    if (isSelected("particles/mass"))
+        readChunk(&p.mass[0], m_frame, "particles/mass", N * 4, N);
+    if (isSelected("particles/charge"))
+        readChunk(&p.charge[0], m_frame, "particles/charge", N * 4, N);
+    if (isSelected("particles/diameter"))
+        readChunk(&p.diameter[0], m_frame, "particles/diameter", N * 4, N);
+    if (isSelected("particles/body"))
+        readChunk(&p.body[0], m_frame, "particles/body", N * 4, N);
+    if (isSelected("particles/moment_inertia"))
+        readChunk(&p.inertia[0], m_frame, "particles/moment_inertia", N * 12, N);
+    float* pos = (float*)p.pos.data();
+    if (isSelected("particles/position")
+        && !readQuantizedPositions(&m_handle, pos, m_frame, N, 0, N)
+        && !readChunk(pos, m_frame, "particles/position", N * 12, N) && m_frame != 0)
+        {
+        readQuantizedPositions(&m_handle, pos, 0, N, 0, N);
+        }
+    if (isSelected("particles/orientation"))
+        readChunk(&p.orientation[0], m_frame, "particles/orientation", N * 16, N);
+    if (isSelected("particles/velocity"))
+        readChunk(&p.vel[0], m_frame, "particles/velocity", N * 12, N);
+    if (isSelected("particles/angmom"))
+        readChunk(&p.angmom[0], m_frame, "particles/angmom", N * 16, N);
+    if (isSelected("particles/image"))
+        readChunk(&p.image[0], m_frame, "particles/image", N * 12, N);
     }
 
 /*! Read the same data chunks for topology
@@ -248,59 +552,94 @@ void GSDReader::readParticles()
 void GSDReader::readTopology()
     {
     unsigned int N = 0;
-    m_snapshot->bond_data.type_mapping = readTypes(m_frame, "bonds/types");
-    readChunk(&N, m_frame, "bonds/N", 4);
-    if (N > 0)
+    if (isSectionSelected("bonds"))
         {
-        m_snapshot->bond_data.resize(N);
-        readChunk(&m_snapshot->bond_data.type_id[0], m_frame, "bonds/typeid", N * 4, N);
-        readChunk(&m_snapshot->bond_data.groups[0], m_frame, "bonds/group", N * 8, N);
+        m_snapshot->bond_data.type_mapping = readTypes(m_frame, "bonds/types");
+        readChunk(&N, m_frame, "bonds/N", 4);
+        if (N > 0)
+            {
+            m_snapshot->bond_data.resize(N);
+            readChunk(&m_snapshot->bond_data.type_id[0], m_frame, "bonds/typeid", N * 4, N);
+            readChunk(&m_snapshot->bond_data.groups[0], m_frame, "bonds/group", N * 8, N);
+            }
         }
 
     N = 0;
-    m_snapshot->angle_data.type_mapping = readTypes(m_frame, "angles/types");
-    readChunk(&N, m_frame, "angles/N", 4);
-    if (N > 0)
+    if (isSectionSelected("angles"))
         {
-        m_snapshot->angle_data.resize(N);
-        readChunk(&m_snapshot->angle_data.type_id[0], m_frame, "angles/typeid", N * 4, N);
-        readChunk(&m_snapshot->angle_data.groups[0], m_frame, "angles/group", N * 12, N);
+        m_snapshot->angle_data.type_mapping = readTypes(m_frame, "angles/types");
+        readChunk(&N, m_frame, "angles/N", 4);
+        if (N > 0)
+            {
+            m_snapshot->angle_data.resize(N);
+            readChunk(&m_snapshot->angle_data.type_id[0], m_frame, "angles/typeid", N * 4, N);
+            readChunk(&m_snapshot->angle_data.groups[0], m_frame, "angles/group", N * 12, N);
+            }
         }
 
     N = 0;
-    m_snapshot->dihedral_data.type_mapping = readTypes(m_frame, "dihedrals/types");
-    readChunk(&N, m_frame, "dihedrals/N", 4);
-    if (N > 0)
+    if (isSectionSelected("dihedrals"))
         {
-        m_snapshot->dihedral_data.resize(N);
-        readChunk(&m_snapshot->dihedral_data.type_id[0], m_frame, "dihedrals/typeid", N * 4, N);
-        readChunk(&m_snapshot->dihedral_data.groups[0], m_frame, "dihedrals/group", N * 16, N);
+        m_snapshot->dihedral_data.type_mapping = readTypes(m_frame, "dihedrals/types");
+        readChunk(&N, m_frame, "dihedrals/N", 4);
+        if (N > 0)
+            {
+            m_snapshot->dihedral_data.resize(N);
+            readChunk(&m_snapshot->dihedral_data.type_id[0],
+                      m_frame,
+                      "dihedrals/typeid",
+                      N * 4,
+                      N);
+            readChunk(&m_snapshot->dihedral_data.groups[0],
+                      m_frame,
+                      "dihedrals/group",
+                      N * 16,
+                      N);
+            }
         }
 
     N = 0;
-    m_snapshot->improper_data.type_mapping = readTypes(m_frame, "impropers/types");
-    readChunk(&N, m_frame, "impropers/N", 4);
-    if (N > 0)
+    if (isSectionSelected("impropers"))
         {
-        m_snapshot->improper_data.resize(N);
-        readChunk(&m_snapshot->improper_data.type_id[0], m_frame, "impropers/typeid", N * 4, N);
-        readChunk(&m_snapshot->improper_data.groups[0], m_frame, "impropers/group", N * 16, N);
+        m_snapshot->improper_data.type_mapping = readTypes(m_frame, "impropers/types");
+        readChunk(&N, m_frame, "impropers/N", 4);
+        if (N > 0)
+            {
+            m_snapshot->improper_data.resize(N);
+            readChunk(&m_snapshot->improper_data.type_id[0],
+                      m_frame,
+                      "impropers/typeid",
+                      N * 4,
+                      N);
+            readChunk(&m_snapshot->improper_data.groups[0],
+                      m_frame,
+                      "impropers/group",
+                      N * 16,
+                      N);
+            }
         }
 
     N = 0;
-    readChunk(&N, m_frame, "constraints/N", 4);
-    if (N > 0)
+    if (isSectionSelected("constraints"))
         {
-        m_snapshot->constraint_data.resize(N);
-        std::vector<float> data(N);
-        readChunk(&data[0], m_frame, "constraints/value", N * 4, N);
-        for (unsigned int i = 0; i < N; i++)
-            m_snapshot->constraint_data.val[i] = Scalar(data[i]);
-
-        readChunk(&m_snapshot->constraint_data.groups[0], m_frame, "constraints/group", N * 8, N);
+        readChunk(&N, m_frame, "constraints/N", 4);
+        if (N > 0)
+            {
+            m_snapshot->constraint_data.resize(N);
+            std::vector<float> data(N);
+            readChunk(&data[0], m_frame, "constraints/value", N * 4, N);
+            for (unsigned int i = 0; i < N; i++)
+                m_snapshot->constraint_data.val[i] = Scalar(data[i]);
+
+            readChunk(&m_snapshot->constraint_data.groups[0],
+                      m_frame,
+                      "constraints/group",
+                      N * 8,
+                      N);
+            }
         }
 
-    if (m_handle.header.schema_version >= gsd_make_version(1, 1))
+    if (m_handle.header.schema_version >= gsd_make_version(1, 1) && isSectionSelected("pairs"))
         {
         N = 0;
         m_snapshot->pair_data.type_mapping = readTypes(m_frame, "pairs/types");
@@ -314,6 +653,123 @@ void GSDReader::readTopology()
         }
     }
 
+#ifdef ENABLE_MPI
+/*! \param sysdef System definition initialized from getSnapshot()
+
+    Each rank opens the file and reads an equal, contiguous range of rows from every particle
+    chunk. ParticleData::initializeFromDistributedSnapshot() then sends each particle to the rank
+    that owns it. The root rank reads the topology and distributes it the same way as
+    SystemDefinition::initializeFromSnapshot().
+
+    \note This method must be called collectively on all ranks.
+*/
+void GSDReader::readParticlesDistributed(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    if (!m_distributed)
+        {
+        throw runtime_error("GSDReader was not opened in distributed mode.");
+        }
+
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    unsigned int n_ranks = m_exec_conf->getNRanks();
+    unsigned int rank = m_exec_conf->getRank();
+
+    unsigned int N = m_distributed_n;
+    uint64_t frame = m_frame;
+    std::vector<std::string> type_mapping = m_snapshot->particle_data.type_mapping;
+    bcast(N, 0, mpi_comm);
+    bcast(frame, 0, mpi_comm);
+    bcast(type_mapping, 0, mpi_comm);
+
+    // the root rank already has the file open
+    gsd_handle local_handle;
+    gsd_handle* handle = &m_handle;
+    int retval = GSD_SUCCESS;
+    if (!m_exec_conf->isRoot())
+        {
+        retval = gsd_open(&local_handle, m_name.c_str(), GSD_OPEN_READONLY);
+        handle = &local_handle;
+        }
+
+    // fail on all ranks together
+    int error = retval != GSD_SUCCESS;
+    MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_INT, MPI_MAX, mpi_comm);
+    if (error)
+        {
+        GSDUtils::checkError(retval, m_name);
+        if (!m_exec_conf->isRoot())
+            gsd_close(&local_handle);
+        throw runtime_error("Error opening " + m_name + " on another rank.");
+        }
+
+    uint64_t first_row = uint64_t(N) * rank / n_ranks;
+    uint64_t n_rows = uint64_t(N) * (rank + 1) / n_ranks - first_row;
+
+    SnapshotParticleData<float> local((unsigned int)n_rows);
+    local.type_mapping = type_mapping;
+
+    // the snapshot already has default values, if a chunk is not found, the value
+    // is already at the default, and the failed read is not a problem
+    struct RowChunk
+        {
+        void* data;
+        const char* name;
+        size_t row_size;
+        };
+    const RowChunk chunks[] = {{local.type.data(), "particles/typeid", 4},
+                               {local.mass.data(), "particles/mass", 4},
+                               {local.charge.data(), "particles/charge", 4},
+                               {local.diameter.data(), "particles/diameter", 4},
+                               {local.body.data(), "particles/body", 4},
+                               {local.inertia.data(), "particles/moment_inertia", 12},
+                               {local.orientation.data(), "particles/orientation", 16},
+                               {local.vel.data(), "particles/velocity", 12},
+                               {local.angmom.data(), "particles/angmom", 16},
+                               {local.image.data(), "particles/image", 12}};
+    for (const RowChunk& chunk : chunks)
+        {
+        if (isSelected(chunk.name))
+            {
+            readChunkRows(handle,
+                          chunk.data,
+                          frame,
+                          chunk.name,
+                          chunk.row_size,
+                          N,
+                          first_row,
+                          n_rows);
+            }
+        }
+
+    float* pos = (float*)local.pos.data();
+    if (isSelected("particles/position")
+        && !readQuantizedPositions(handle, pos, frame, N, first_row, n_rows)
+        && !readChunkRows(handle, pos, frame, "particles/position", 12, N, first_row, n_rows)
+        && frame != 0)
+        {
+        readQuantizedPositions(handle, pos, 0, N, first_row, n_rows);
+        }
+
+    if (!m_exec_conf->isRoot())
+        gsd_close(&local_handle);
+
+    sysdef->getParticleData()->initializeFromDistributedSnapshot(local,
+                                                                  (unsigned int)first_row,
+                                                                  N);
+
+    // topology is small compared to the particle data, read it on the root rank
+    if (m_exec_conf->isRoot())
+        readTopology();
+
+    sysdef->getBondData()->initializeFromSnapshot(m_snapshot->bond_data);
+    sysdef->getAngleData()->initializeFromSnapshot(m_snapshot->angle_data);
+    sysdef->getDihedralData()->initializeFromSnapshot(m_snapshot->dihedral_data);
+    sysdef->getImproperData()->initializeFromSnapshot(m_snapshot->improper_data);
+    sysdef->getConstraintData()->initializeFromSnapshot(m_snapshot->constraint_data);
+    sysdef->getPairData()->initializeFromSnapshot(m_snapshot->pair_data);
+    }
+#endif
+
 pybind11::list GSDReader::readTypeShapesPy(uint64_t frame)
     {
     std::vector<std::string> type_mapping = this->readTypes(frame, "particles/type_shapes");
@@ -331,10 +787,17 @@ void export_GSDReader(pybind11::module& m)
         .def(pybind11::init<std::shared_ptr<const ExecutionConfiguration>,
                             const string&,
                             const uint64_t,
-                            bool>())
+                            bool,
+                            bool,
+                            const std::vector<std::string>&>())
         .def("getTimeStep", &GSDReader::getTimeStep)
+        .def("getNFrames", &GSDReader::getNFrames)
+        .def("readFrame", &GSDReader::readFrame)
         .def("getSnapshot", &GSDReader::getSnapshot)
         .def("clearSnapshot", &GSDReader::clearSnapshot)
+#ifdef ENABLE_MPI
+        .def("readParticlesDistributed", &GSDReader::readParticlesDistributed)
+#endif
         .def("readTypeShapesPy", &GSDReader::readTypeShapesPy);
     }
 
@@ -7,7 +7,9 @@
 
 #include "ParticleData.h"
 #include "hoomd/extern/gsd.h"
+#include <set>
 #include <string>
+#include <vector>
 
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
@@ -19,11 +21,25 @@ namespace hoomd
     {
 //! Forward declarations
 template<class Real> struct SnapshotSystemData;
+class SystemDefinition;
 
 //! Reads a GSD input file
 /*! Read an input GSD file and generate a system snapshot. GSDReader can read any frame from a GSD
     file into the snapshot. For information on the GSD specification, see http://gsd.readthedocs.io/
 
+    In distributed mode, GSDReader reads only the header and the particle types into the snapshot.
+    After the caller initializes the SystemDefinition from that snapshot, readParticlesDistributed()
+    reads the particle data in parallel: each rank reads a contiguous range of rows of every
+    particle chunk and sends the particles to the ranks that own them. Use this mode to restart
+    very large systems that would not fit into the memory of the root rank.
+
+    When \a fields is not empty, GSDReader reads only the listed particle chunks (e.g.
+    "particles/position") and topology sections (e.g. "bonds"). The other quantities keep their
+    default values. "particles" selects all particle chunks. The header (step, dimensions, box, N,
+    and particle types) is always read. readFrame() reads another frame of the open file into a new
+    snapshot, so analysis workflows can read a subset of the fields from every k-th frame without
+    reopening the file.
+
     \ingroup data_structs
 */
 class PYBIND11_EXPORT GSDReader
@@ -33,7 +49,9 @@ class PYBIND11_EXPORT GSDReader
     GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
               const std::string& name,
               const uint64_t frame,
-              bool from_end);
+              bool from_end,
+              bool distributed = false,
+              const std::vector<std::string>& fields = std::vector<std::string>());
 
     //! Destructor
     ~GSDReader();
@@ -64,6 +82,12 @@ class PYBIND11_EXPORT GSDReader
         return m_frame;
         }
 
+    //! Returns the number of frames in the file
+    uint64_t getNFrames() const;
+
+    //! Read another frame of the file into a new snapshot
+    void readFrame(uint64_t frame);
+
     //! Helper function to read a quantity from the file
     bool readChunk(void* data,
                    uint64_t frame,
@@ -85,6 +109,11 @@ class PYBIND11_EXPORT GSDReader
 
     pybind11::list readTypeShapesPy(uint64_t frame);
 
+#ifdef ENABLE_MPI
+    //! Read the particles and topology in parallel into the system definition
+    void readParticlesDistributed(std::shared_ptr<SystemDefinition> sysdef);
+#endif
+
     private:
     std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< The execution configuration
     uint64_t m_timestep;                                       //!< Timestep at the selected frame
@@ -93,9 +122,37 @@ class PYBIND11_EXPORT GSDReader
     std::shared_ptr<SnapshotSystemData<float>> m_snapshot;     //!< The snapshot to read
     gsd_handle m_handle;                                       //!< Handle to the file
 
+    bool m_distributed;             //!< True when the particles are read in parallel
+    unsigned int m_distributed_n;   //!< Number of particles in the frame (distributed mode)
+    std::set<std::string> m_fields; //!< Chunks and sections to read, empty to read all
+
+    //! Test if a particle chunk is selected
+    bool isSelected(const std::string& name) const;
+
+    //! Test if a topology section is selected
+    bool isSectionSelected(const std::string& section) const;
+
     //! Helper function to read a type list from the file
     std::vector<std::string> readTypes(uint64_t frame, const char* name);
 
+    //! Helper function to read a range of rows of a quantity from the file
+    bool readChunkRows(gsd_handle* handle,
+                       void* data,
+                       uint64_t frame,
+                       const char* name,
+                       size_t row_size,
+                       unsigned int cur_n,
+                       uint64_t first_row,
+                       uint64_t n_rows);
+
+    //! Helper function to decode the quantized positions written by GSDDumpWriter
+    bool readQuantizedPositions(gsd_handle* handle,
+                                float* data,
+                                uint64_t frame,
+                                unsigned int cur_n,
+                                uint64_t first_row,
+                                uint64_t n_rows);
+
     // helper functions to read sections of the file
     void readHeader();
     void readParticles();
@@ -34,6 +34,7 @@
 
 #include "GPUArray.h"
 
+#include <cstdint>
 #include <cxxabi.h>
 #include <utility>
 
@@ -43,9 +44,10 @@
 #include <unistd.h>
 #include <vector>
 
-#define TAG_ALLOCATION(array)              \
-        {                                  \
-        array.setTag(std::string(#array)); \
+#define TAG_ALLOCATION(array)                                                   \
+        {                                                                       \
+        array.setTag(std::string(#array),                                       \
+                     hoomd::detail::MemoryTracker::getTypeName(typeid(*this))); \
         }
 
 namespace hoomd
@@ -79,7 +81,8 @@ template<class T> class managed_deleter
     public:
     //! Default constructor
     managed_deleter()
-        : m_use_device(false), m_N(0), m_allocation_ptr(nullptr), m_allocation_bytes(0)
+        : m_use_device(false), m_N(0), m_allocation_ptr(nullptr), m_allocation_bytes(0),
+          m_pool(nullptr)
         {
         }
 
@@ -89,14 +92,16 @@ template<class T> class managed_deleter
         \param N number of elements
         \param allocation_ptr true start of allocation, before alignment
         \param allocation_bytes Size of allocation
+        \param pool Memory pool that the allocation was drawn from, or nullptr
      */
     managed_deleter(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                     bool use_device,
                     std::size_t N,
                     void* allocation_ptr,
-                    size_t allocation_bytes)
+                    size_t allocation_bytes,
+                    MemoryPool* pool = nullptr)
         : m_exec_conf(exec_conf), m_use_device(use_device), m_N(N),
-          m_allocation_ptr(allocation_ptr), m_allocation_bytes(allocation_bytes)
+          m_allocation_ptr(allocation_ptr), m_allocation_bytes(allocation_bytes), m_pool(pool)
         {
         }
 
@@ -141,11 +146,17 @@ template<class T> class managed_deleter
             oss << std::endl;
             this->m_exec_conf->msg->notice(10) << oss.str();
 
-            hipFree(m_allocation_ptr);
+            MemoryTracker::unregisterAllocation(m_allocation_ptr);
+
+            if (m_pool)
+                m_pool->deallocate(m_allocation_ptr);
+            else
+                hipFree(m_allocation_ptr);
             }
         else
 #endif
             {
+            MemoryTracker::unregisterAllocation(m_allocation_ptr);
             free(m_allocation_ptr);
             }
         }
@@ -164,6 +175,7 @@ template<class T> class managed_deleter
     void* m_allocation_ptr;                                    //!< Start of unaligned allocation
     size_t m_allocation_bytes;                                 //!< Size of actual allocation
     std::string m_tag;                                         //!< Name of the array
+    MemoryPool* m_pool; //!< Pool the memory was drawn from, if any
     };
 
 #ifdef ENABLE_HIP
@@ -237,7 +249,11 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         {
 #ifndef ALWAYS_USE_MANAGED_MEMORY
         if (!(m_is_managed))
+            {
+            if (m_tag != "")
+                m_fallback.setTag(m_tag);
             return;
+            }
 #endif
 
         assert(this->m_exec_conf);
@@ -263,8 +279,8 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
           m_fallback(from.m_fallback),
 #endif
           m_num_elements(from.m_num_elements), m_pitch(from.m_pitch), m_height(from.m_height),
-          m_acquired(false), m_tag(from.m_tag), m_align_bytes(from.m_align_bytes),
-          m_is_managed(false)
+          m_acquired(false), m_tag(from.m_tag), m_owner(from.m_owner),
+          m_align_bytes(from.m_align_bytes), m_is_managed(false)
         {
         if (from.m_data.get())
             {
@@ -303,6 +319,7 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
             m_acquired = false;
             m_align_bytes = rhs.m_align_bytes;
             m_tag = rhs.m_tag;
+            m_owner = rhs.m_owner;
 
             if (rhs.m_data.get())
                 {
@@ -341,7 +358,8 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
           m_data(std::move(other.m_data)), m_num_elements(std::move(other.m_num_elements)),
           m_pitch(std::move(other.m_pitch)), m_height(std::move(other.m_height)),
           m_acquired(std::move(other.m_acquired)), m_tag(std::move(other.m_tag)),
-          m_align_bytes(std::move(other.m_align_bytes)), m_is_managed(std::move(other.m_is_managed))
+          m_owner(std::move(other.m_owner)), m_align_bytes(std::move(other.m_align_bytes)),
+          m_is_managed(std::move(other.m_is_managed))
 #ifdef ENABLE_HIP
           ,
           m_event(std::move(other.m_event))
@@ -365,6 +383,7 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
             m_height = std::move(other.m_height);
             m_acquired = std::move(other.m_acquired);
             m_tag = std::move(other.m_tag);
+            m_owner = std::move(other.m_owner);
             m_align_bytes = std::move(other.m_align_bytes);
             m_is_managed = std::move(other.m_is_managed);
 #ifdef ENABLE_HIP
@@ -433,8 +452,10 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         std::swap(m_pitch, from.m_pitch);
         std::swap(m_height, from.m_height);
         std::swap(m_tag, from.m_tag);
+        std::swap(m_owner, from.m_owner);
         std::swap(m_align_bytes, from.m_align_bytes);
         std::swap(m_is_managed, from.m_is_managed);
+        std::swap(m_write_count, from.m_write_count);
 #ifdef ENABLE_HIP
         std::swap(m_event, from.m_event);
 #endif
@@ -516,6 +537,16 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         return m_height;
         }
 
+    //! Get the number of times the array has been acquired with write access
+    /*! Every acquire with access_mode::readwrite or access_mode::overwrite increments the count.
+        Classes that cache data derived from the array compare the count to detect stale caches.
+        The count is swapped with the contents in swap() and it restarts at 0 in copies.
+    */
+    inline uint64_t getWriteCount() const
+        {
+        return m_write_count;
+        }
+
     //! Resize the GlobalArray
     /*! This method resizes the array by allocating a new array and copying over the elements
         from the old array. Resizing is a slow operation.
@@ -630,15 +661,26 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
 
     //! Set an optional tag for memory profiling
     /*! tag The name of this allocation
+        owner The class that holds this array
      */
-    inline void setTag(const std::string& tag)
+    inline void setTag(const std::string& tag, const std::string& owner = std::string())
         {
         // update the tag
         m_tag = tag;
+        m_owner = owner;
+
+#ifndef ALWAYS_USE_MANAGED_MEMORY
+        m_fallback.setTag(tag, owner);
+#endif
 
         // set tag on deleter so it can be displayed upon free
         if (!isNull() && m_data)
+            {
             m_data.get_deleter().setTag(tag);
+            hoomd::detail::MemoryTracker::setTag(m_data.get_deleter().getAllocationRange().first,
+                                                 tag,
+                                                 owner);
+            }
 
         // for debugging
         this->outputRepresentation();
@@ -740,7 +782,10 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
 
     mutable bool m_acquired; //!< Tracks if the array is already acquired
 
-    std::string m_tag; //!< Name tag of this buffer (optional)
+    mutable uint64_t m_write_count = 0; //!< Number of acquires with write access
+
+    std::string m_tag;   //!< Name tag of this buffer (optional)
+    std::string m_owner; //!< Class that holds this buffer (optional)
 
     size_t m_align_bytes; //!< Size of alignment in bytes
     bool m_is_managed;    //!< Whether or not this array is stored using managed memory.
@@ -759,6 +804,7 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         void* allocation_ptr = nullptr;
         bool use_device = this->m_exec_conf && this->m_exec_conf->isCUDAEnabled();
         size_t allocation_bytes;
+        hoomd::detail::MemoryPool* pool = nullptr;
 
 #ifdef ENABLE_HIP
         if (use_device)
@@ -775,17 +821,31 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
             this->m_exec_conf->msg->notice(10)
                 << "Allocating " << allocation_bytes << " bytes of managed memory." << std::endl;
 
-            hipError_t error = hipMallocManaged(&ptr, allocation_bytes, hipMemAttachGlobal);
-            if (error == hipErrorMemoryAllocation)
+            pool = this->m_exec_conf->getManagedMemoryPool();
+            if (pool)
                 {
-                throw std::bad_alloc();
+                ptr = pool->allocate(allocation_bytes);
                 }
-            else if (error != hipSuccess)
+            else
                 {
-                throw std::runtime_error(hipGetErrorString(error));
+                hipError_t error = hipMallocManaged(&ptr, allocation_bytes, hipMemAttachGlobal);
+                if (error == hipErrorMemoryAllocation)
+                    {
+                    throw std::bad_alloc();
+                    }
+                else if (error != hipSuccess)
+                    {
+                    throw std::runtime_error(hipGetErrorString(error));
+                    }
                 }
 
             allocation_ptr = ptr;
+            hoomd::detail::MemoryTracker::registerAllocation(allocation_ptr,
+                                                             hoomd::detail::MemoryTracker::managed,
+                                                             allocation_bytes,
+                                                             typeid(T),
+                                                             m_tag,
+                                                             m_owner);
 
             if (m_align_bytes)
                 {
@@ -813,6 +873,12 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
                 }
             allocation_bytes = m_num_elements * sizeof(T);
             allocation_ptr = ptr;
+            hoomd::detail::MemoryTracker::registerAllocation(allocation_ptr,
+                                                             hoomd::detail::MemoryTracker::host,
+                                                             allocation_bytes,
+                                                             typeid(T),
+                                                             m_tag,
+                                                             m_owner);
             }
 
 #ifdef ENABLE_HIP
@@ -838,10 +904,17 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
                                                   use_device,
                                                   m_num_elements,
                                                   allocation_ptr,
-                                                  allocation_bytes);
+                                                  allocation_bytes,
+                                                  pool);
         deleter.setTag(m_tag);
         m_data = std::unique_ptr<T, decltype(deleter)>(reinterpret_cast<T*>(ptr), deleter);
 
+        // place the pages of host memory near the threads that will use them
+        if (!use_device && this->m_exec_conf)
+            hoomd::detail::parallel_first_touch(*this->m_exec_conf,
+                                                ptr,
+                                                m_num_elements * sizeof(T));
+
         // construct objects explicitly using placement new
         for (std::size_t i = 0; i < m_num_elements; ++i)
             ::new ((void**)&((T*)ptr)[i]) T;
@@ -888,6 +961,9 @@ inline ArrayHandleDispatch<T> GlobalArray<T>::acquire(const access_location::Enu
 ) const
 
     {
+    if (mode != access_mode::read)
+        m_write_count++;
+
 #ifndef ALWAYS_USE_MANAGED_MEMORY
     if (!this->m_exec_conf || !m_is_managed)
         return m_fallback.acquire(location,
@@ -0,0 +1,601 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#ifdef ENABLE_HDF5
+
+#include "HDF5LogWriter.h"
+#include "Filesystem.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string.h>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace
+    {
+/// Identifier of the zstd filter registered with The HDF Group
+const H5Z_filter_t zstd_filter_id = 32015;
+
+/// Number of frames in each chunk of a scalar dataset
+const hsize_t scalar_chunk_frames = 512;
+
+/// Maximum size (in bytes) of each chunk of an array dataset
+const size_t array_chunk_bytes = 4096;
+
+/*! \param result Return value of an HDF5 function
+    \param what Description of the operation
+    \param fname File name
+
+    \returns \a result when it is not negative
+*/
+template<class T> T checkHDF5(T result, const std::string& what, const std::string& fname)
+    {
+    if (result < 0)
+        {
+        throw runtime_error("HDF5: Error " + what + " in " + fname);
+        }
+    return result;
+    }
+
+/*! \param loc File or group to search
+    \param path Path of the link relative to \a loc
+
+    \returns true when \a loc has a link at \a path (H5Lexists requires that the intermediate
+    groups exist).
+*/
+bool linkExists(hid_t loc, const std::string& path)
+    {
+    size_t end = 0;
+    while (end != std::string::npos)
+        {
+        end = path.find('/', end + 1);
+        if (H5Lexists(loc, path.substr(0, end).c_str(), H5P_DEFAULT) <= 0)
+            {
+            return false;
+            }
+        }
+    return true;
+    }
+    } // end anonymous namespace
+
+/*! \param sysdef SystemDefinition containing the ParticleData
+    \param trigger Trigger that selects the timesteps to log
+    \param fname File name to write data to
+    \param mode File open mode ("w", "x", "w-", "a", or "r+")
+    \param block_size Number of frames to buffer before writing
+    \param compression Compression filter ("none", "gzip", or "zstd")
+    \param compression_level Compression level passed to the filter
+*/
+HDF5LogWriter::HDF5LogWriter(std::shared_ptr<SystemDefinition> sysdef,
+                             std::shared_ptr<Trigger> trigger,
+                             const std::string& fname,
+                             std::string mode,
+                             unsigned int block_size,
+                             std::string compression,
+                             unsigned int compression_level)
+    : Analyzer(sysdef, trigger), m_fname(fname), m_mode(mode), m_compression(compression),
+      m_compression_level(compression_level), m_block_size(block_size)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing HDF5LogWriter: " << m_fname << " " << mode << " "
+                                << block_size << " " << compression << endl;
+    if (mode != "w" && mode != "x" && mode != "w-" && mode != "a" && mode != "r+")
+        {
+        throw std::invalid_argument("Invalid HDF5 file mode: " + mode);
+        }
+    if (compression != "none" && compression != "gzip" && compression != "zstd")
+        {
+        throw std::invalid_argument("Invalid HDF5 compression: " + compression);
+        }
+    if (compression == "gzip" && compression_level > 9)
+        {
+        throw std::invalid_argument("gzip compression_level must be in the range [0, 9].");
+        }
+    if (block_size == 0)
+        {
+        throw std::invalid_argument("block_size must be positive.");
+        }
+    m_log_writer = pybind11::none();
+
+    initFileIO();
+    }
+
+HDF5LogWriter::~HDF5LogWriter()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying HDF5LogWriter" << endl;
+
+    if (m_exec_conf->isRoot())
+        {
+        try
+            {
+            writeBuffered();
+            }
+        catch (const std::exception& e)
+            {
+            m_exec_conf->msg->error() << e.what() << endl;
+            }
+        close();
+        }
+    }
+
+void HDF5LogWriter::initFileIO()
+    {
+    if (!m_exec_conf->isRoot())
+        {
+        return;
+        }
+
+    if (m_compression != "none")
+        {
+        H5Z_filter_t filter = m_compression == "gzip" ? H5Z_FILTER_DEFLATE : zstd_filter_id;
+        if (H5Zfilter_avail(filter) <= 0)
+            {
+            throw runtime_error("HDF5: The " + m_compression
+                                + " filter is not available. Set HDF5_PLUGIN_PATH to the"
+                                  " directory that holds the HDF5 filter plugins.");
+            }
+        }
+
+    bool exists = filesystem::exists(m_fname);
+    if (m_mode == "w" || m_mode == "x" || m_mode == "w-" || (m_mode == "a" && !exists))
+        {
+        m_exec_conf->msg->notice(3) << "HDF5: create or overwrite file " << m_fname << endl;
+        unsigned int flags = m_mode == "w" || m_mode == "a" ? H5F_ACC_TRUNC : H5F_ACC_EXCL;
+        m_file = checkHDF5(H5Fcreate(m_fname.c_str(), flags, H5P_DEFAULT, H5P_DEFAULT),
+                           "creating the file",
+                           m_fname);
+        }
+    else
+        {
+        m_exec_conf->msg->notice(3) << "HDF5: open file " << m_fname << endl;
+        m_file = checkHDF5(H5Fopen(m_fname.c_str(), H5F_ACC_RDWR, H5P_DEFAULT),
+                           "opening the file",
+                           m_fname);
+        }
+
+    if (linkExists(m_file, "hoomd-data"))
+        {
+        m_group = checkHDF5(H5Gopen2(m_file, "hoomd-data", H5P_DEFAULT),
+                            "opening hoomd-data",
+                            m_fname);
+        if (H5Aexists(m_group, "hoomd-schema") <= 0 || H5Aexists(m_group, "frames") <= 0)
+            {
+            close();
+            throw runtime_error("HDF5: Validation of existing HDF5 file failed: " + m_fname);
+            }
+
+        int64_t frames;
+        hid_t attr = checkHDF5(H5Aopen(m_group, "frames", H5P_DEFAULT), "opening frames", m_fname);
+        herr_t status = H5Aread(attr, H5T_NATIVE_INT64, &frames);
+        H5Aclose(attr);
+        checkHDF5(status, "reading frames", m_fname);
+        m_frames = frames;
+        }
+    else
+        {
+        m_group = checkHDF5(H5Gcreate2(m_file, "hoomd-data", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT),
+                            "creating hoomd-data",
+                            m_fname);
+
+        const int64_t schema[] = {0, 1};
+        hsize_t schema_dims[] = {2};
+        hid_t space = H5Screate_simple(1, schema_dims, nullptr);
+        hid_t attr = checkHDF5(
+            H5Acreate2(m_group, "hoomd-schema", H5T_STD_I64LE, space, H5P_DEFAULT, H5P_DEFAULT),
+            "creating hoomd-schema",
+            m_fname);
+        herr_t status = H5Awrite(attr, H5T_NATIVE_INT64, schema);
+        H5Aclose(attr);
+        H5Sclose(space);
+        checkHDF5(status, "writing hoomd-schema", m_fname);
+
+        m_frames = 0;
+        writeFrames();
+        }
+    }
+
+/*! \param block_size Number of frames to buffer before writing
+
+    Write the buffered frames when there are already \a block_size of them.
+*/
+void HDF5LogWriter::setBlockSize(unsigned int block_size)
+    {
+    if (block_size == 0)
+        {
+        throw std::invalid_argument("block_size must be positive.");
+        }
+    m_block_size = block_size;
+
+    if (m_exec_conf->isRoot() && m_n_buffered >= m_block_size)
+        {
+        writeBuffered();
+        }
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void HDF5LogWriter::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    if (m_log_writer.is_none())
+        {
+        return;
+        }
+
+    pybind11::dict log_data = m_log_writer.attr("log")().cast<pybind11::dict>();
+    if (!m_exec_conf->isRoot())
+        {
+        return;
+        }
+
+    std::vector<std::pair<std::string, pybind11::array>> values;
+    values.reserve(log_data.size());
+    for (auto item : log_data)
+        {
+        std::string name = pybind11::cast<std::string>(item.first);
+        auto value = pybind11::array::ensure(item.second, pybind11::array::c_style);
+        if (!value)
+            {
+            throw runtime_error("HDF5: " + name + " is not an array.");
+            }
+        values.emplace_back(name, value);
+        }
+
+    if (m_datasets.empty())
+        {
+        initDatasets(values);
+        }
+
+    if (values.size() != m_datasets.size())
+        {
+        throw runtime_error("The logged quantities cannot change within a file.");
+        }
+
+    for (size_t i = 0; i < values.size(); i++)
+        {
+        Dataset& dataset = m_datasets[i];
+        pybind11::array value = values[i].second;
+        if (values[i].first != dataset.name
+            || !std::equal(dataset.frame_shape.begin(),
+                           dataset.frame_shape.end(),
+                           value.shape(),
+                           value.shape() + value.ndim()))
+            {
+            throw runtime_error("The logged quantities cannot change within a file.");
+            }
+
+        if (!value.dtype().equal(dataset.dtype))
+            {
+            value = pybind11::array::ensure(value.attr("astype")(dataset.dtype),
+                                            pybind11::array::c_style);
+            }
+
+        size_t offset = dataset.buffer.size();
+        dataset.buffer.resize(offset + dataset.frame_bytes);
+        if (dataset.frame_bytes > 0)
+            {
+            memcpy(dataset.buffer.data() + offset, value.data(), dataset.frame_bytes);
+            }
+        }
+    m_n_buffered++;
+
+    if (m_n_buffered >= m_block_size)
+        {
+        writeBuffered();
+        }
+    }
+
+void HDF5LogWriter::flush()
+    {
+    if (!m_exec_conf->isRoot())
+        {
+        return;
+        }
+
+    writeBuffered();
+
+    m_exec_conf->msg->notice(5) << "HDF5: flush file " << m_fname << endl;
+    checkHDF5(H5Fflush(m_file, H5F_SCOPE_LOCAL), "flushing the file", m_fname);
+    }
+
+/*! \param values Logged quantities of the first frame, keyed by dataset path
+
+    Open the existing datasets when appending to a file, or create them in a new file.
+*/
+void HDF5LogWriter::initDatasets(
+    const std::vector<std::pair<std::string, pybind11::array>>& values)
+    {
+    for (const auto& [name, value] : values)
+        {
+        Dataset dataset;
+        dataset.name = name;
+        dataset.frame_shape.assign(value.shape(), value.shape() + value.ndim());
+        dataset.frame_bytes = value.nbytes();
+        dataset.dtype = value.dtype();
+        dataset.mem_type = getMemoryType(dataset.dtype);
+        dataset.buffer.reserve(dataset.frame_bytes * m_block_size);
+
+        std::vector<hsize_t> dims(1, m_frames);
+        dims.insert(dims.end(), dataset.frame_shape.begin(), dataset.frame_shape.end());
+
+        if (linkExists(m_file, name))
+            {
+            dataset.id = checkHDF5(H5Dopen2(m_file, name.c_str(), H5P_DEFAULT),
+                                   "opening " + name,
+                                   m_fname);
+
+            hid_t space = H5Dget_space(dataset.id);
+            std::vector<hsize_t> file_dims(std::max(H5Sget_simple_extent_ndims(space), 0));
+            H5Sget_simple_extent_dims(space, file_dims.data(), nullptr);
+            H5Sclose(space);
+
+            bool same_shape = file_dims.size() == dims.size()
+                              && std::equal(dims.begin() + 1, dims.end(), file_dims.begin() + 1);
+            if (!same_shape)
+                {
+                H5Dclose(dataset.id);
+                throw runtime_error("The logged quantities cannot change within a file.");
+                }
+            }
+        else if (m_frames > 0)
+            {
+            throw runtime_error("The logged quantities cannot change within a file.");
+            }
+        else
+            {
+            std::vector<hsize_t> max_dims(dims);
+            max_dims[0] = H5S_UNLIMITED;
+            hid_t space = H5Screate_simple(int(dims.size()), dims.data(), max_dims.data());
+            hid_t link_properties = H5Pcreate(H5P_LINK_CREATE);
+            H5Pset_create_intermediate_group(link_properties, 1);
+            hid_t properties = makeDatasetProperties(dataset);
+
+            dataset.id = H5Dcreate2(m_file,
+                                    name.c_str(),
+                                    dataset.mem_type,
+                                    space,
+                                    link_properties,
+                                    properties,
+                                    H5P_DEFAULT);
+            H5Pclose(properties);
+            H5Pclose(link_properties);
+            H5Sclose(space);
+            checkHDF5(dataset.id, "creating " + name, m_fname);
+            }
+
+        m_datasets.push_back(std::move(dataset));
+        }
+    }
+
+/*! \param dataset Dataset to configure
+
+    \returns A dataset creation property list. The caller must close it.
+
+    Scalar datasets store 512 frames in each chunk. Array datasets store as many frames as fit in
+    4 KiB (and at least one). These match the chunks that hoomd.write.HDF5Log creates.
+*/
+hid_t HDF5LogWriter::makeDatasetProperties(const Dataset& dataset)
+    {
+    std::vector<hsize_t> chunk(1, scalar_chunk_frames);
+    if (!dataset.frame_shape.empty())
+        {
+        chunk[0] = std::max(array_chunk_bytes / std::max(dataset.frame_bytes, size_t(1)),
+                            size_t(1));
+        chunk.insert(chunk.end(), dataset.frame_shape.begin(), dataset.frame_shape.end());
+        }
+
+    hid_t properties = H5Pcreate(H5P_DATASET_CREATE);
+    checkHDF5(H5Pset_chunk(properties, int(chunk.size()), chunk.data()),
+              "setting the chunk size of " + dataset.name,
+              m_fname);
+
+    if (m_compression == "gzip")
+        {
+        H5Pset_shuffle(properties);
+        checkHDF5(H5Pset_deflate(properties, m_compression_level),
+                  "setting the gzip filter of " + dataset.name,
+                  m_fname);
+        }
+    else if (m_compression == "zstd")
+        {
+        H5Pset_shuffle(properties);
+        checkHDF5(H5Pset_filter(properties,
+                                zstd_filter_id,
+                                H5Z_FLAG_MANDATORY,
+                                1,
+                                &m_compression_level),
+                  "setting the zstd filter of " + dataset.name,
+                  m_fname);
+        }
+
+    return properties;
+    }
+
+/*! \param dtype NumPy data type of the logged values
+
+    \returns The native HDF5 type of \a dtype. Store bools in the enumerated type that h5py uses,
+    so that h5py reads them as bools.
+*/
+hid_t HDF5LogWriter::getMemoryType(const pybind11::dtype& dtype)
+    {
+    char kind = dtype.kind();
+    size_t size = dtype.itemsize();
+
+    if (kind == 'b')
+        {
+        if (m_bool_type == H5I_INVALID_HID)
+            {
+            int8_t false_value = 0, true_value = 1;
+            m_bool_type = H5Tenum_create(H5T_NATIVE_INT8);
+            H5Tenum_insert(m_bool_type, "FALSE", &false_value);
+            H5Tenum_insert(m_bool_type, "TRUE", &true_value);
+            }
+        return m_bool_type;
+        }
+    if (kind == 'i')
+        {
+        switch (size)
+            {
+        case 1:
+            return H5T_NATIVE_INT8;
+        case 2:
+            return H5T_NATIVE_INT16;
+        case 4:
+            return H5T_NATIVE_INT32;
+        case 8:
+            return H5T_NATIVE_INT64;
+            }
+        }
+    if (kind == 'u')
+        {
+        switch (size)
+            {
+        case 1:
+            return H5T_NATIVE_UINT8;
+        case 2:
+            return H5T_NATIVE_UINT16;
+        case 4:
+            return H5T_NATIVE_UINT32;
+        case 8:
+            return H5T_NATIVE_UINT64;
+            }
+        }
+    if (kind == 'f')
+        {
+        if (size == 4)
+            {
+            return H5T_NATIVE_FLOAT;
+            }
+        if (size == 8)
+            {
+            return H5T_NATIVE_DOUBLE;
+            }
+        }
+
+    throw runtime_error("HDF5: Unsupported type " + std::string(1, kind) + std::to_string(size)
+                        + " in a logged quantity.");
+    }
+
+/*! Extend every dataset once and write all buffered frames with a single hyperslab selection.
+ */
+void HDF5LogWriter::writeBuffered()
+    {
+    if (m_n_buffered == 0)
+        {
+        return;
+        }
+
+    m_exec_conf->msg->notice(10) << "HDF5: writing " << m_n_buffered << " log frames" << endl;
+
+    for (Dataset& dataset : m_datasets)
+        {
+        std::vector<hsize_t> start(dataset.frame_shape.size() + 1, 0);
+        start[0] = m_frames;
+        std::vector<hsize_t> count(1, m_n_buffered);
+        count.insert(count.end(), dataset.frame_shape.begin(), dataset.frame_shape.end());
+        std::vector<hsize_t> dims(count);
+        dims[0] = m_frames + m_n_buffered;
+
+        checkHDF5(H5Dset_extent(dataset.id, dims.data()), "extending " + dataset.name, m_fname);
+
+        hid_t file_space = H5Dget_space(dataset.id);
+        H5Sselect_hyperslab(file_space,
+                            H5S_SELECT_SET,
+                            start.data(),
+                            nullptr,
+                            count.data(),
+                            nullptr);
+        hid_t mem_space = H5Screate_simple(int(count.size()), count.data(), nullptr);
+        herr_t status = H5Dwrite(dataset.id,
+                                 dataset.mem_type,
+                                 mem_space,
+                                 file_space,
+                                 H5P_DEFAULT,
+                                 dataset.buffer.data());
+        H5Sclose(mem_space);
+        H5Sclose(file_space);
+        checkHDF5(status, "writing " + dataset.name, m_fname);
+
+        dataset.buffer.clear();
+        }
+
+    m_frames += m_n_buffered;
+    m_n_buffered = 0;
+    writeFrames();
+    }
+
+void HDF5LogWriter::writeFrames()
+    {
+    hid_t attr;
+    if (H5Aexists(m_group, "frames") > 0)
+        {
+        attr = H5Aopen(m_group, "frames", H5P_DEFAULT);
+        }
+    else
+        {
+        hid_t space = H5Screate(H5S_SCALAR);
+        attr = H5Acreate2(m_group, "frames", H5T_STD_I64LE, space, H5P_DEFAULT, H5P_DEFAULT);
+        H5Sclose(space);
+        }
+    checkHDF5(attr, "opening frames", m_fname);
+
+    int64_t frames = m_frames;
+    herr_t status = H5Awrite(attr, H5T_NATIVE_INT64, &frames);
+    H5Aclose(attr);
+    checkHDF5(status, "writing frames", m_fname);
+    }
+
+void HDF5LogWriter::close()
+    {
+    for (Dataset& dataset : m_datasets)
+        {
+        H5Dclose(dataset.id);
+        }
+    m_datasets.clear();
+    m_n_buffered = 0;
+
+    if (m_bool_type != H5I_INVALID_HID)
+        {
+        H5Tclose(m_bool_type);
+        m_bool_type = H5I_INVALID_HID;
+        }
+    if (m_group != H5I_INVALID_HID)
+        {
+        H5Gclose(m_group);
+        m_group = H5I_INVALID_HID;
+        }
+    if (m_file != H5I_INVALID_HID)
+        {
+        m_exec_conf->msg->notice(5) << "HDF5: close file " << m_fname << endl;
+        H5Fclose(m_file);
+        m_file = H5I_INVALID_HID;
+        }
+    }
+
+namespace detail
+    {
+void export_HDF5LogWriter(pybind11::module& m)
+    {
+    pybind11::class_<HDF5LogWriter, Analyzer, std::shared_ptr<HDF5LogWriter>>(m, "HDF5LogWriter")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            std::string,
+                            std::string,
+                            unsigned int,
+                            std::string,
+                            unsigned int>())
+        .def_property("log_writer", &HDF5LogWriter::getLogWriter, &HDF5LogWriter::setLogWriter)
+        .def_property_readonly("filename", &HDF5LogWriter::getFilename)
+        .def_property_readonly("mode", &HDF5LogWriter::getMode)
+        .def_property("block_size", &HDF5LogWriter::getBlockSize, &HDF5LogWriter::setBlockSize)
+        .def("flush", &HDF5LogWriter::flush);
+    }
+
+    } // end namespace detail
+
+    } // end namespace hoomd
+
+#endif // ENABLE_HDF5
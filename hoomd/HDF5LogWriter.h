@@ -0,0 +1,160 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#pragma once
+
+#ifdef ENABLE_HDF5
+
+#include "Analyzer.h"
+
+#include <hdf5.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*! \file HDF5LogWriter.h
+    \brief Declares the HDF5LogWriter class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+/// Analyzer for writing logged quantities to HDF5 files with the HDF5 C library
+/*! HDF5LogWriter writes the same file layout as hoomd.write.HDF5Log: the group "hoomd-data" holds
+    one resizable dataset per logged quantity, named by the quantity's namespace, with the frame
+    index as the first dimension. The group attribute "frames" counts the frames in the file and
+    "hoomd-schema" identifies the layout.
+
+    Every time analyze() is called, HDF5LogWriter copies the logged values into one contiguous
+    buffer per dataset that holds the given number of frames. When the buffers are full,
+    HDF5LogWriter extends each dataset once and writes all the buffered frames with a single
+    hyperslab selection. The datasets are chunked along the frame dimension and may be compressed
+    with the deflate (gzip) filter, or with the zstd filter when the HDF5 zstd filter plugin is
+    available at run time.
+
+    The logged quantities and their shapes cannot change within a file. flush() and the
+    destructor write the buffered frames.
+
+    Only the root rank writes to the file. All ranks call the log writer, so that log quantities
+    may use collective communication.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT HDF5LogWriter : public Analyzer
+    {
+    public:
+    /// Construct the writer
+    HDF5LogWriter(std::shared_ptr<SystemDefinition> sysdef,
+                  std::shared_ptr<Trigger> trigger,
+                  const std::string& fname,
+                  std::string mode = "a",
+                  unsigned int block_size = 100,
+                  std::string compression = "none",
+                  unsigned int compression_level = 4);
+
+    /// Destructor
+    ~HDF5LogWriter();
+
+    /// Collect the logged quantities
+    virtual void analyze(uint64_t timestep);
+
+    /// Write all buffered frames to the file and flush it
+    void flush();
+
+    /// Set the log writer
+    void setLogWriter(pybind11::object log_writer)
+        {
+        m_log_writer = log_writer;
+        }
+
+    /// Get the log writer
+    pybind11::object getLogWriter()
+        {
+        return m_log_writer;
+        }
+
+    /// Get the file name
+    std::string getFilename()
+        {
+        return m_fname;
+        }
+
+    /// Get the file open mode
+    std::string getMode()
+        {
+        return m_mode;
+        }
+
+    /// Set the number of frames to buffer before writing
+    void setBlockSize(unsigned int block_size);
+
+    /// Get the number of frames to buffer before writing
+    unsigned int getBlockSize()
+        {
+        return m_block_size;
+        }
+
+    private:
+    /// A dataset and the frames buffered for it
+    struct Dataset
+        {
+        std::string name;                 //!< Path of the dataset in the file
+        hid_t id = H5I_INVALID_HID;       //!< Open dataset
+        pybind11::dtype dtype;            //!< Type of the logged values
+        hid_t mem_type = H5I_INVALID_HID; //!< Type of the values in memory
+        std::vector<hsize_t> frame_shape; //!< Shape of the value in one frame
+        size_t frame_bytes = 0;           //!< Size of the value in one frame
+        std::vector<char> buffer;         //!< Values of the buffered frames
+        };
+
+    std::string m_fname;                 //!< File name
+    std::string m_mode;                  //!< File open mode
+    std::string m_compression;           //!< Compression filter
+    unsigned int m_compression_level;    //!< Compression level
+    unsigned int m_block_size;           //!< Number of frames to buffer before writing
+    pybind11::object m_log_writer;       //!< Callback that provides the log quantities
+    hid_t m_file = H5I_INVALID_HID;      //!< Open file
+    hid_t m_group = H5I_INVALID_HID;     //!< The hoomd-data group
+    hid_t m_bool_type = H5I_INVALID_HID; //!< Enumerated type that stores bools as h5py does
+    uint64_t m_frames = 0;               //!< Number of frames in the file
+    size_t m_n_buffered = 0;             //!< Number of frames in the buffers
+    std::vector<Dataset> m_datasets;     //!< Datasets in the order of the logged quantities
+
+    /// Open or create the file
+    void initFileIO();
+
+    /// Open or create the datasets that store the given quantities
+    void initDatasets(const std::vector<std::pair<std::string, pybind11::array>>& values);
+
+    /// Create the property list that configures chunking and compression of a dataset
+    hid_t makeDatasetProperties(const Dataset& dataset);
+
+    /// Get the HDF5 type that stores values with the given dtype
+    hid_t getMemoryType(const pybind11::dtype& dtype);
+
+    /// Write the buffered frames to the file
+    void writeBuffered();
+
+    /// Write the number of frames to the group attributes
+    void writeFrames();
+
+    /// Close the file and everything opened in it
+    void close();
+    };
+
+namespace detail
+    {
+/// Exports the HDF5LogWriter class to python
+void export_HDF5LogWriter(pybind11::module& m);
+
+    } // end namespace detail
+
+    } // end namespace hoomd
+
+#endif // ENABLE_HDF5
@@ -416,6 +416,18 @@ inline HOSTDEVICE double erfc(double x)
     return ::erfc(x);
     }
 
+//! Compute the erf of x
+inline HOSTDEVICE float erf(float x)
+    {
+    return ::erff(x);
+    }
+
+//! Compute the erf of x
+inline HOSTDEVICE double erf(double x)
+    {
+    return ::erf(x);
+    }
+
 //! Compute the acos of x
 inline HOSTDEVICE float acos(float x)
     {
@@ -575,6 +587,18 @@ inline HOSTDEVICE double erfc(double x)
     return ::erfc(x);
     }
 
+//! Compute the erf of x
+inline HOSTDEVICE float erf(float x)
+    {
+    return ::erff(x);
+    }
+
+//! Compute the erf of x
+inline HOSTDEVICE double erf(double x)
+    {
+    return ::erf(x);
+    }
+
 //! Compute the acos of x
 inline HOSTDEVICE float acos(float x)
     {
@@ -49,6 +49,10 @@ std::string BuildInfo::getCompileFlags()
     o << "TBB ";
 #endif
 
+#ifdef ENABLE_NCCL
+    o << "NCCL ";
+#endif
+
 #ifdef __SSE__
     o << "SSE ";
 #endif
@@ -162,6 +166,15 @@ bool BuildInfo::getEnableMPI()
 #endif
     }
 
+bool BuildInfo::getEnableHDF5()
+    {
+#ifdef ENABLE_HDF5
+    return true;
+#else
+    return false;
+#endif
+    }
+
 std::string BuildInfo::getSourceDir()
     {
     return std::string(HOOMD_SOURCE_DIR);
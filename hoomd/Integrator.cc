@@ -11,6 +11,7 @@
 #include "Communicator.h"
 #endif
 
+#include <pybind11/stl.h>
 #include <pybind11/stl_bind.h>
 PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<hoomd::ForceConstraint>>);
 PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<hoomd::ForceCompute>>);
@@ -56,6 +57,17 @@ Integrator::~Integrator()
             this);
         }
 #endif
+
+#ifdef ENABLE_HIP
+    for (auto stream : m_force_streams)
+        {
+        hipStreamDestroy(stream);
+        }
+    for (auto event : m_force_events)
+        {
+        hipEventDestroy(event);
+        }
+#endif
     }
 
 /** @param deltaT New time step to set
@@ -70,6 +82,11 @@ void Integrator::setDeltaT(Scalar deltaT)
         force->setDeltaT(deltaT);
         }
 
+    for (auto& force : m_slow_forces)
+        {
+        force->setDeltaT(deltaT);
+        }
+
     for (auto& constraint_force : m_constraint_forces)
         {
         constraint_force->setDeltaT(deltaT);
@@ -170,6 +187,23 @@ void Integrator::computeNetForce(uint64_t timestep)
         force->compute(timestep);
         }
 
+    bool slow_force_step = isSlowForceStep(timestep);
+    if (slow_force_step)
+        {
+        for (auto& force : m_slow_forces)
+            {
+            force->compute(timestep);
+            }
+        }
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        // complete the ghost update when none of the forces did
+        m_comm->finishUpdateGhosts(timestep);
+        }
+#endif
+
     Scalar external_virial[6];
     Scalar external_energy;
         {
@@ -197,19 +231,21 @@ void Integrator::computeNetForce(uint64_t timestep)
         // also sum up forces for ghosts, in case they are needed by the communicator
         unsigned int nparticles = m_pdata->getN() + m_pdata->getNGhosts();
         size_t net_virial_pitch = net_virial.getPitch();
+        bool compute_virial = m_pdata->getFlags()[pdata_flag::pressure_tensor];
 
         assert(nparticles <= net_force.getNumElements());
         assert(6 * nparticles <= net_virial.getNumElements());
         assert(nparticles <= net_torque.getNumElements());
 
-        for (const auto& force : m_forces)
-            {
+        // forces and torques are multiplied by force_scale, energies and virials are not
+        auto add_force = [&](const std::shared_ptr<ForceCompute>& force, Scalar force_scale)
+        {
             const GlobalArray<Scalar4>& h_force_array = force->getForceArray();
             const GlobalArray<Scalar>& h_virial_array = force->getVirialArray();
             const GlobalArray<Scalar4>& h_torque_array = force->getTorqueArray();
 
             assert(nparticles <= h_force_array.getNumElements());
-            assert(6 * nparticles <= h_virial_array.getNumElements());
+            assert(!compute_virial || 6 * nparticles <= h_virial_array.getNumElements());
             assert(nparticles <= h_torque_array.getNumElements());
 
             ArrayHandle<Scalar4> h_force(h_force_array, access_location::host, access_mode::read);
@@ -219,20 +255,27 @@ void Integrator::computeNetForce(uint64_t timestep)
             size_t virial_pitch = h_virial_array.getPitch();
             for (unsigned int j = 0; j < nparticles; j++)
                 {
-                h_net_force.data[j].x += h_force.data[j].x;
-                h_net_force.data[j].y += h_force.data[j].y;
-                h_net_force.data[j].z += h_force.data[j].z;
+                h_net_force.data[j].x += force_scale * h_force.data[j].x;
+                h_net_force.data[j].y += force_scale * h_force.data[j].y;
+                h_net_force.data[j].z += force_scale * h_force.data[j].z;
                 h_net_force.data[j].w += h_force.data[j].w;
 
-                h_net_torque.data[j].x += h_torque.data[j].x;
-                h_net_torque.data[j].y += h_torque.data[j].y;
-                h_net_torque.data[j].z += h_torque.data[j].z;
+                h_net_torque.data[j].x += force_scale * h_torque.data[j].x;
+                h_net_torque.data[j].y += force_scale * h_torque.data[j].y;
+                h_net_torque.data[j].z += force_scale * h_torque.data[j].z;
                 h_net_torque.data[j].w += h_torque.data[j].w;
+                }
 
+            // forces may skip the per-particle virial when the pressure is not needed
+            if (compute_virial)
+                {
                 for (unsigned int k = 0; k < 6; k++)
                     {
-                    h_net_virial.data[k * net_virial_pitch + j]
-                        += h_virial.data[k * virial_pitch + j];
+                    for (unsigned int j = 0; j < nparticles; j++)
+                        {
+                        h_net_virial.data[k * net_virial_pitch + j]
+                            += h_virial.data[k * virial_pitch + j];
+                        }
                     }
                 }
 
@@ -242,6 +285,20 @@ void Integrator::computeNetForce(uint64_t timestep)
                 }
 
             external_energy += force->getExternalEnergy();
+        };
+
+        for (const auto& force : m_forces)
+            {
+            add_force(force, Scalar(1.0));
+            }
+
+        if (slow_force_step)
+            {
+            // impulse multiple time step scheme, see the class documentation
+            for (const auto& force : m_slow_forces)
+                {
+                add_force(force, Scalar(m_slow_force_interval));
+                }
             }
         }
 
@@ -282,6 +339,7 @@ void Integrator::computeNetForce(uint64_t timestep)
                                           access_location::host,
                                           access_mode::readwrite);
         size_t net_virial_pitch = net_virial.getPitch();
+        bool compute_virial = m_pdata->getFlags()[pdata_flag::pressure_tensor];
 
         // now, add up the net forces
         unsigned int nparticles = m_pdata->getN();
@@ -298,7 +356,7 @@ void Integrator::computeNetForce(uint64_t timestep)
             size_t virial_pitch = h_virial_array.getPitch();
 
             assert(nparticles <= h_force_array.getNumElements());
-            assert(6 * nparticles <= h_virial_array.getNumElements());
+            assert(!compute_virial || 6 * nparticles <= h_virial_array.getNumElements());
             assert(nparticles <= h_torque_array.getNumElements());
 
             for (unsigned int j = 0; j < nparticles; j++)
@@ -312,11 +370,18 @@ void Integrator::computeNetForce(uint64_t timestep)
                 h_net_torque.data[j].y += h_torque.data[j].y;
                 h_net_torque.data[j].z += h_torque.data[j].z;
                 h_net_torque.data[j].w += h_torque.data[j].w;
+                }
 
+            // forces may skip the per-particle virial when the pressure is not needed
+            if (compute_virial)
+                {
                 for (unsigned int k = 0; k < 6; k++)
                     {
-                    h_net_virial.data[k * net_virial_pitch + j]
-                        += h_virial.data[k * virial_pitch + j];
+                    for (unsigned int j = 0; j < nparticles; j++)
+                        {
+                        h_net_virial.data[k * net_virial_pitch + j]
+                            += h_virial.data[k * virial_pitch + j];
+                        }
                     }
                 }
             for (unsigned int k = 0; k < 6; k++)
@@ -348,6 +413,8 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
         throw runtime_error("Cannot compute net force on the GPU if CUDA is disabled.");
         }
 
+    unsigned int n_streams = assignForceStreams();
+
     // compute all the normal forces first
 
     for (auto& force : m_forces)
@@ -355,6 +422,17 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
         force->compute(timestep);
         }
 
+    bool slow_force_step = isSlowForceStep(timestep);
+    if (slow_force_step)
+        {
+        for (auto& force : m_slow_forces)
+            {
+            force->compute(timestep);
+            }
+        }
+
+    joinForceStreams(n_streams);
+
     Scalar external_virial[6];
     Scalar external_energy;
 
@@ -559,6 +637,50 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
 
             m_exec_conf->endMultiGPU();
             }
+
+        if (slow_force_step)
+            {
+            // impulse multiple time step scheme, see the class documentation
+            // there are few slow forces, sum them one at a time
+            PDataFlags flags = this->m_pdata->getFlags();
+            for (const auto& force : m_slow_forces)
+                {
+                kernel::gpu_force_list force_list;
+                force_list.force_scale = Scalar(m_slow_force_interval);
+
+                ArrayHandle<Scalar4> d_force(force->getForceArray(),
+                                             access_location::device,
+                                             access_mode::read);
+                ArrayHandle<Scalar> d_virial(force->getVirialArray(),
+                                             access_location::device,
+                                             access_mode::read);
+                ArrayHandle<Scalar4> d_torque(force->getTorqueArray(),
+                                              access_location::device,
+                                              access_mode::read);
+                force_list.f0 = d_force.data;
+                force_list.v0 = d_virial.data;
+                force_list.vpitch0 = force->getVirialArray().getPitch();
+                force_list.t0 = d_torque.data;
+
+                m_exec_conf->beginMultiGPU();
+
+                // the net force arrays are already initialized
+                gpu_integrator_sum_net_force(d_net_force.data,
+                                             d_net_virial.data,
+                                             net_virial_pitch,
+                                             d_net_torque.data,
+                                             force_list,
+                                             nparticles,
+                                             false,
+                                             flags[pdata_flag::pressure_tensor],
+                                             m_pdata->getGPUPartition());
+
+                if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                    CHECK_CUDA_ERROR();
+
+                m_exec_conf->endMultiGPU();
+                }
+            }
         }
 
     // add up external virials and energies
@@ -569,6 +691,16 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
         external_energy += force->getExternalEnergy();
         }
 
+    if (slow_force_step)
+        {
+        for (const auto& force : m_slow_forces)
+            {
+            for (unsigned int k = 0; k < 6; k++)
+                external_virial[k] += force->getExternalVirial(k);
+            external_energy += force->getExternalEnergy();
+            }
+        }
+
     for (unsigned int k = 0; k < 6; k++)
         m_pdata->setExternalVirial(k, external_virial[k]);
 
@@ -751,7 +883,7 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
                 }
 
             // clear only on the first iteration AND if there are zero forces
-            bool clear = (cur_force == 0) && (m_forces.size() == 0);
+            bool clear = (cur_force == 0) && (m_forces.size() == 0) && !slow_force_step;
 
             // access flags
             PDataFlags flags = this->m_pdata->getFlags();
@@ -805,6 +937,11 @@ void Integrator::update(uint64_t timestep)
         force->setDeltaT(m_deltaT);
         }
 
+    for (auto& force : m_slow_forces)
+        {
+        force->setDeltaT(m_deltaT);
+        }
+
     for (auto& constraint_force : m_constraint_forces)
         {
         constraint_force->setDeltaT(m_deltaT);
@@ -829,12 +966,82 @@ void Integrator::prepRun(uint64_t timestep)
         force->setDeltaT(m_deltaT);
         }
 
+    for (auto& force : m_slow_forces)
+        {
+        force->setDeltaT(m_deltaT);
+        }
+
     for (auto& constraint_force : m_constraint_forces)
         {
         constraint_force->setDeltaT(m_deltaT);
         }
     }
 
+#ifdef ENABLE_HIP
+/** \returns The number of streams in m_force_streams that the force computes use
+
+    Each force compute that supports it gets its own stream when concurrent forces are enabled.
+    The streams are created on first use and reused in later steps. They synchronize with the
+    default stream, so the kernels of these force computes overlap only with each other.
+*/
+unsigned int Integrator::assignForceStreams()
+    {
+    unsigned int n_streams = 0;
+    m_force_stream_index.clear();
+
+    auto assign = [this, &n_streams](std::shared_ptr<ForceCompute>& force)
+    {
+        if (m_concurrent_forces && force->supportsConcurrentStream())
+            {
+            if (n_streams == m_force_streams.size())
+                {
+                hipStream_t stream;
+                hipEvent_t event;
+                hipStreamCreate(&stream);
+                hipEventCreateWithFlags(&event, hipEventDisableTiming);
+                m_force_streams.push_back(stream);
+                m_force_events.push_back(event);
+                if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                    CHECK_CUDA_ERROR();
+                }
+            force->setStream(m_force_streams[n_streams]);
+            n_streams++;
+            m_force_stream_index.push_back(n_streams);
+            }
+        else
+            {
+            force->setStream(0);
+            m_force_stream_index.push_back(0);
+            }
+    };
+
+    for (auto& force : m_forces)
+        {
+        assign(force);
+        }
+    for (auto& force : m_slow_forces)
+        {
+        assign(force);
+        }
+
+    return n_streams;
+    }
+
+/** @param n_streams Number of streams in m_force_streams to join
+ */
+void Integrator::joinForceStreams(unsigned int n_streams)
+    {
+    for (unsigned int i = 0; i < n_streams; i++)
+        {
+        hipEventRecord(m_force_events[i], m_force_streams[i]);
+        hipStreamWaitEvent(0, m_force_events[i], 0);
+        }
+
+    if (n_streams > 0 && m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+#endif
+
 #ifdef ENABLE_MPI
 /** @param tstep Time step for which to determine the flags
 
@@ -851,6 +1058,15 @@ CommFlags Integrator::determineFlags(uint64_t timestep)
         flags |= force->getRequestedCommFlags(timestep);
         }
 
+    // the slow forces only need ghost fields on the steps they are evaluated
+    if (isSlowForceStep(timestep))
+        {
+        for (const auto& force : m_slow_forces)
+            {
+            flags |= force->getRequestedCommFlags(timestep);
+            }
+        }
+
     // query all constraints
     for (const auto& constraint_force : m_constraint_forces)
         {
@@ -867,6 +1083,14 @@ void Integrator::computeCallback(uint64_t timestep)
         {
         force->preCompute(timestep);
         }
+
+    if (isSlowForceStep(timestep))
+        {
+        for (auto& force : m_slow_forces)
+            {
+            force->preCompute(timestep);
+            }
+        }
     }
 #endif
 
@@ -879,6 +1103,11 @@ bool Integrator::areForcesAnisotropic()
         aniso |= force->isAnisotropic();
         }
 
+    for (const auto& force : m_slow_forces)
+        {
+        aniso |= force->isAnisotropic();
+        }
+
     for (const auto& constraint_force : m_constraint_forces)
         {
         aniso |= constraint_force->isAnisotropic();
@@ -898,6 +1127,14 @@ void export_Integrator(pybind11::module& m)
         .def("updateGroupDOF", &Integrator::updateGroupDOF)
         .def_property("dt", &Integrator::getDeltaT, &Integrator::setDeltaT)
         .def_property_readonly("forces", &Integrator::getForces)
+        .def_property_readonly("slow_forces", &Integrator::getSlowForces)
+        .def_property("slow_force_interval",
+                      &Integrator::getSlowForceInterval,
+                      &Integrator::setSlowForceInterval)
+        .def_property("concurrent_forces",
+                      &Integrator::getConcurrentForces,
+                      &Integrator::setConcurrentForces)
+        .def_property_readonly("force_streams", &Integrator::getForceStreams)
         .def_property_readonly("constraints", &Integrator::getConstraintForces)
         .def("computeLinearMomentum", &Integrator::computeLinearMomentum);
     }
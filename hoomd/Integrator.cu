@@ -23,6 +23,7 @@ __device__ void add_force_total(Scalar4& net_force,
                                 Scalar* d_v,
                                 const size_t virial_pitch,
                                 Scalar4* d_t,
+                                Scalar force_scale,
                                 int idx)
     {
     if (d_f != NULL && d_v != NULL && d_t != NULL)
@@ -30,9 +31,9 @@ __device__ void add_force_total(Scalar4& net_force,
         Scalar4 f = d_f[idx];
         Scalar4 t = d_t[idx];
 
-        net_force.x += f.x;
-        net_force.y += f.y;
-        net_force.z += f.z;
+        net_force.x += force_scale * f.x;
+        net_force.y += force_scale * f.y;
+        net_force.z += force_scale * f.z;
         net_force.w += f.w;
 
         if (compute_virial)
@@ -41,9 +42,9 @@ __device__ void add_force_total(Scalar4& net_force,
                 net_virial[i] += d_v[i * virial_pitch + idx];
             }
 
-        net_torque.x += t.x;
-        net_torque.y += t.y;
-        net_torque.z += t.z;
+        net_torque.x += force_scale * t.x;
+        net_torque.y += force_scale * t.y;
+        net_torque.z += force_scale * t.z;
         net_torque.w += t.w;
         }
     }
@@ -115,6 +116,7 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v0,
                                         force_list.vpitch0,
                                         force_list.t0,
+                                        force_list.force_scale,
                                         idx);
         add_force_total<compute_virial>(net_force,
                                         net_virial,
@@ -123,6 +125,7 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v1,
                                         force_list.vpitch1,
                                         force_list.t1,
+                                        force_list.force_scale,
                                         idx);
         add_force_total<compute_virial>(net_force,
                                         net_virial,
@@ -131,6 +134,7 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v2,
                                         force_list.vpitch2,
                                         force_list.t2,
+                                        force_list.force_scale,
                                         idx);
         add_force_total<compute_virial>(net_force,
                                         net_virial,
@@ -139,6 +143,7 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v3,
                                         force_list.vpitch3,
                                         force_list.t3,
+                                        force_list.force_scale,
                                         idx);
         add_force_total<compute_virial>(net_force,
                                         net_virial,
@@ -147,6 +152,7 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v4,
                                         force_list.vpitch4,
                                         force_list.t4,
+                                        force_list.force_scale,
                                         idx);
         add_force_total<compute_virial>(net_force,
                                         net_virial,
@@ -155,6 +161,7 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v5,
                                         force_list.vpitch5,
                                         force_list.t5,
+                                        force_list.force_scale,
                                         idx);
 
         // write out the final result
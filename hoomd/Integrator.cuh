@@ -20,7 +20,8 @@ namespace kernel
 /*! To keep the argument count down to gpu_integrator_sum_accel, up to 6 force/virial array pairs
    are packed up in this struct for addition to the net force/virial in a single kernel call. If
    there is not a multiple of 5 forces to sum, set some of the pointers to NULL and they will be
-   ignored.
+   ignored. The forces and torques (but not the energies and virials) are multiplied by
+   force_scale.
 */
 struct gpu_force_list
     {
@@ -28,7 +29,8 @@ struct gpu_force_list
     gpu_force_list()
         : f0(NULL), f1(NULL), f2(NULL), f3(NULL), f4(NULL), f5(NULL), t0(NULL), t1(NULL), t2(NULL),
           t3(NULL), t4(NULL), t5(NULL), v0(NULL), v1(NULL), v2(NULL), v3(NULL), v4(NULL), v5(NULL),
-          vpitch0(0), vpitch1(0), vpitch2(0), vpitch3(0), vpitch4(0), vpitch5(0)
+          vpitch0(0), vpitch1(0), vpitch2(0), vpitch3(0), vpitch4(0), vpitch5(0),
+          force_scale(1.0)
         {
         }
 
@@ -59,6 +61,8 @@ struct gpu_force_list
     size_t vpitch3; //!< Pitch of virial array 3
     size_t vpitch4; //!< Pitch of virial array 4
     size_t vpitch5; //!< Pitch of virial array 5
+
+    Scalar force_scale; //!< Factor applied to the forces and torques
     };
 
 //! Driver for gpu_integrator_sum_net_force_kernel()
@@ -13,6 +13,7 @@
 #include "ParticleGroup.h"
 #include "Updater.h"
 #include <pybind11/pybind11.h>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -45,6 +46,20 @@ namespace hoomd
     convenience in derived classes implementing correct counting in getTranslationalDOF() and
     getRotationalDOF().
 
+    Forces added to m_slow_forces through getSlowForces are evaluated only on time steps that are
+    multiples of the slow force interval. On those steps, their forces and torques are multiplied by
+    the interval before they are added to the net force. For integration methods that apply the net
+    force in two half step kicks, this is the impulse (Verlet-I / r-RESPA) multiple time step
+    scheme: the slow forces give a kick of half the outer time step at both ends of each outer step.
+    Their energies and virials are added unscaled, and only on the steps where they are evaluated.
+
+    On the GPU, the force computes that support it (ForceCompute::supportsConcurrentStream()) may
+    run on separate streams when concurrent forces are enabled. Such force computes write only
+    their own force, torque, and virial arrays, so their kernels may overlap with each other. The
+    Integrator records an event on each stream after the force computes and makes the default
+    stream wait on all events before the net force summation. getForceStreams() reports the
+    stream assigned to each force compute.
+
     Integrators take "ownership" of the particle's accelerations. Any other updater that modifies
     the particles accelerations will produce undefined results. If accelerations are to be modified,
     they must be done through forces, and added to an Integrator via the m_forces std::vector.
@@ -75,6 +90,49 @@ class PYBIND11_EXPORT Integrator : public Updater
         return m_forces;
         }
 
+    /// Get the list of force computes evaluated every slow force interval
+    std::vector<std::shared_ptr<ForceCompute>>& getSlowForces()
+        {
+        return m_slow_forces;
+        }
+
+    /// Set the number of time steps between evaluations of the slow forces
+    void setSlowForceInterval(unsigned int interval)
+        {
+        if (interval == 0)
+            {
+            throw std::domain_error("slow_force_interval must be positive");
+            }
+        m_slow_force_interval = interval;
+        }
+
+    /// Get the number of time steps between evaluations of the slow forces
+    unsigned int getSlowForceInterval()
+        {
+        return m_slow_force_interval;
+        }
+
+    /// Set whether independent force computes may run on separate GPU streams
+    void setConcurrentForces(bool concurrent_forces)
+        {
+        m_concurrent_forces = concurrent_forces;
+        }
+
+    /// Get whether independent force computes may run on separate GPU streams
+    bool getConcurrentForces()
+        {
+        return m_concurrent_forces;
+        }
+
+    /// Get the stream index of each force compute in m_forces followed by m_slow_forces
+    /** Index 0 is the default stream. Force computes on streams 1 and up may run concurrently
+        with each other. All streams join before the net force summation.
+    */
+    std::vector<unsigned int> getForceStreams()
+        {
+        return m_force_stream_index;
+        }
+
     /// Get the list of force computes
     std::vector<std::shared_ptr<ForceConstraint>>& getConstraintForces()
         {
@@ -149,6 +207,11 @@ class PYBIND11_EXPORT Integrator : public Updater
             force->resetStats();
             }
 
+        for (auto& force : m_slow_forces)
+            {
+            force->resetStats();
+            }
+
         for (auto& constraint_force : m_constraint_forces)
             {
             constraint_force->resetStats();
@@ -163,6 +226,10 @@ class PYBIND11_EXPORT Integrator : public Updater
             {
             force->startAutotuning();
             }
+        for (auto& force : m_slow_forces)
+            {
+            force->startAutotuning();
+            }
         }
 
     /// Check if autotuning is complete.
@@ -173,6 +240,10 @@ class PYBIND11_EXPORT Integrator : public Updater
             {
             result = result && force->isAutotuningComplete();
             }
+        for (auto& force : m_slow_forces)
+            {
+            result = result && force->isAutotuningComplete();
+            }
         return result;
         }
 
@@ -183,12 +254,44 @@ class PYBIND11_EXPORT Integrator : public Updater
     /// List of all the force computes
     std::vector<std::shared_ptr<ForceCompute>> m_forces;
 
+    /// List of the force computes evaluated every m_slow_force_interval steps
+    std::vector<std::shared_ptr<ForceCompute>> m_slow_forces;
+
+    /// Number of time steps between evaluations of the slow forces
+    unsigned int m_slow_force_interval = 1;
+
     /// List of all the constraints
     std::vector<std::shared_ptr<ForceConstraint>> m_constraint_forces;
 
     /// The HalfStepHook, if active
     std::shared_ptr<HalfStepHook> m_half_step_hook;
 
+    /// True when independent force computes may run on separate GPU streams
+    bool m_concurrent_forces = false;
+
+    /// Stream index assigned to each force compute in the last net force computation
+    std::vector<unsigned int> m_force_stream_index;
+
+#ifdef ENABLE_HIP
+    /// Streams for the force computes that run concurrently
+    std::vector<hipStream_t> m_force_streams;
+
+    /// Events that mark the completion of the work on each stream in m_force_streams
+    std::vector<hipEvent_t> m_force_events;
+
+    /// Assign streams to the force computes
+    unsigned int assignForceStreams();
+
+    /// Make the default stream wait on the work in the given number of force streams
+    void joinForceStreams(unsigned int n_streams);
+#endif
+
+    /// Test if the slow forces contribute to the net force at the given time step
+    bool isSlowForceStep(uint64_t timestep)
+        {
+        return !m_slow_forces.empty() && timestep % m_slow_force_interval == 0;
+        }
+
     /// helper function to compute initial accelerations
     void computeAccelerations(uint64_t timestep);
 
@@ -11,6 +11,7 @@
 #include "hoomd/extern/BVLSSolver.h"
 #include <Eigen/Dense>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <limits>
@@ -33,9 +34,12 @@ LoadBalancer::LoadBalancer(std::shared_ptr<SystemDefinition> sysdef,
       m_mpi_comm(m_exec_conf->getMPICommunicator()),
 #endif
       m_max_imbalance(Scalar(1.0)), m_recompute_max_imbalance(true), m_needs_migrate(false),
-      m_needs_recount(false), m_tolerance(Scalar(1.05)), m_maxiter(1), m_max_scale(Scalar(0.05)),
-      m_N_own(m_pdata->getN()), m_max_max_imbalance(1.0), m_total_max_imbalance(0.0), m_n_calls(0),
-      m_n_iterations(0), m_n_rebalances(0)
+      m_needs_recount(false), m_tolerance(Scalar(1.05)), m_maxiter(1), m_hysteresis(Scalar(0.0)),
+      m_weight_time(false), m_balancing(false), m_max_scale(Scalar(0.05)),
+      m_N_own(m_pdata->getN()), m_load_own(Scalar(m_pdata->getN())),
+      m_total_load(Scalar(m_pdata->getNGlobal())), m_cost_per_particle(Scalar(1.0)),
+      m_last_force_time(sysdef->getForceComputeTime()), m_max_max_imbalance(1.0),
+      m_total_max_imbalance(0.0), m_n_calls(0), m_n_iterations(0), m_n_rebalances(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing LoadBalancer" << endl;
 
@@ -81,7 +85,9 @@ void LoadBalancer::update(uint64_t timestep)
     if (!m_sysdef->isDomainDecomposed())
         return;
 
-    // no adjustment has been made yet, so set m_N_own to the number of particles on the rank
+    // measure the load and set m_N_own to the number of particles on the rank (no adjustment has
+    // been made yet)
+    updateCost();
     resetNOwn(m_pdata->getN());
 
     // figure out which rank is the reduction root for broadcasting
@@ -104,8 +110,15 @@ void LoadBalancer::update(uint64_t timestep)
     m_total_max_imbalance += getMaxImbalance();
     ++m_n_calls;
 
+    // begin balancing only when the imbalance exceeds the tolerance by the hysteresis
+    if (getMaxImbalance() > m_tolerance + m_hysteresis)
+        {
+        m_balancing = true;
+        }
+
     // attempt load balancing
-    for (unsigned int cur_iter = 0; cur_iter < m_maxiter && getMaxImbalance() > m_tolerance;
+    for (unsigned int cur_iter = 0;
+         m_balancing && cur_iter < m_maxiter && getMaxImbalance() > m_tolerance;
          ++cur_iter)
         {
         // increment the number of attempted balances
@@ -139,10 +152,10 @@ void LoadBalancer::update(uint64_t timestep)
                 min_frac_i = min_domain_frac.z;
                 }
 
-            vector<unsigned int> N_i;
+            vector<Scalar> N_i;
             bool adjusted = false;
 
-            // reduce the number of particles in the slice along dim
+            // reduce the load in the slice along dim
             bool active = reduce(N_i, dim, reduce_root);
 
             // attempt an adjustment
@@ -167,8 +180,14 @@ void LoadBalancer::update(uint64_t timestep)
         // force a particle migration if one is needed
         if (m_needs_migrate)
             {
+            // the migrated particles carry the average cost of the rank they come from
+            const Scalar load_own = getLoadOwn();
+
             m_comm->forceMigrate();
             m_comm->communicate(timestep);
+
+            m_cost_per_particle
+                = m_pdata->getN() > 0 ? load_own / Scalar(m_pdata->getN()) : Scalar(0.0);
             resetNOwn(m_pdata->getN());
             m_needs_migrate = false;
 
@@ -176,21 +195,58 @@ void LoadBalancer::update(uint64_t timestep)
             ++m_n_rebalances;
             }
         }
+
+    // stop balancing once the tolerance is met
+    if (getMaxImbalance() <= m_tolerance)
+        {
+        m_balancing = false;
+        }
 #endif // ENABLE_MPI
     }
 
 #ifdef ENABLE_MPI
 
 /*!
- * Computes the imbalance factor I = N / <N> for each rank, and computes the maximum among all
- * ranks.
+ * When weighting by particles, the cost of every particle is 1. When weighting by time, the cost
+ * per particle is the time this rank spent computing forces since the previous update divided by
+ * the number of particles it owns. Fall back to weighting by particles when no time was recorded
+ * on any rank (for example, when there are no force computes).
+ *
+ * \note All ranks must participate in this call since it involves a collective reduction.
+ */
+void LoadBalancer::updateCost()
+    {
+    m_cost_per_particle = Scalar(1.0);
+    m_total_load = Scalar(m_pdata->getNGlobal());
+
+    int64_t force_time = m_sysdef->getForceComputeTime();
+    Scalar elapsed = Scalar(std::max(force_time - m_last_force_time, int64_t(0)));
+    m_last_force_time = force_time;
+
+    if (!m_weight_time)
+        return;
+
+    Scalar cost = m_pdata->getN() > 0 ? elapsed / Scalar(m_pdata->getN()) : Scalar(0.0);
+    Scalar load = cost * Scalar(m_pdata->getN());
+    Scalar total_load(0.0);
+    MPI_Allreduce(&load, &total_load, 1, MPI_HOOMD_SCALAR, MPI_SUM, m_mpi_comm);
+
+    if (total_load > Scalar(0.0))
+        {
+        m_cost_per_particle = cost;
+        m_total_load = total_load;
+        }
+    }
+
+/*!
+ * Computes the imbalance factor I = W / <W> for each rank, where W is the load of the rank, and
+ * computes the maximum among all ranks.
  */
 Scalar LoadBalancer::getMaxImbalance()
     {
     if (m_recompute_max_imbalance)
         {
-        Scalar cur_imb = Scalar(getNOwn())
-                         / (Scalar(m_pdata->getNGlobal()) / Scalar(m_exec_conf->getNRanks()));
+        Scalar cur_imb = getLoadOwn() / (m_total_load / Scalar(m_exec_conf->getNRanks()));
         Scalar max_imb(0.0);
         MPI_Allreduce(&cur_imb, &max_imb, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_mpi_comm);
 
@@ -205,12 +261,12 @@ Scalar LoadBalancer::getMaxImbalance()
     }
 
 /*!
- * \param N_i Vector holding the total number of particles in each slice (will be allocated on call)
+ * \param N_i Vector holding the total load in each slice (will be allocated on call)
  * \param dim The dimension of the slices (x=0, y=1, z=2)
  * \param reduce_root The rank to perform the reduction on
  * \returns true if the current rank holds the active \a N_i
  *
- * \post \a N_i holds the number of particles in each slice along \a dim
+ * \post \a N_i holds the load in each slice along \a dim
  *
  * \note reduce() relies on collective MPI calls, and so all ranks must call it. However, for
  * efficiency the data will be active only on Cartesian rank \a reduce_root, as indicated by the
@@ -221,21 +277,26 @@ Scalar LoadBalancer::getMaxImbalance()
  * replaced by cascading send operations down dimensions. Generally, load balancing should not be
  * performed too frequently, and so we do not pursue this optimization right now.
  */
-bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
-                          unsigned int dim,
-                          unsigned int reduce_root)
+bool LoadBalancer::reduce(std::vector<Scalar>& N_i, unsigned int dim, unsigned int reduce_root)
     {
     // do nothing if there is only one rank
     if (N_i.size() == 1)
         return false;
 
     const Index3D& di = m_decomposition->getDomainIndexer();
-    std::vector<unsigned int> N_per_rank(di.getNumElements());
+    std::vector<Scalar> N_per_rank(di.getNumElements());
 
-    // get the number of particles the current rank owns (the quantity to be reduced)
-    unsigned int N_own = getNOwn();
+    // get the load of the current rank (the quantity to be reduced)
+    Scalar N_own = getLoadOwn();
 
-    MPI_Gather(&N_own, 1, MPI_UNSIGNED, &N_per_rank[0], 1, MPI_UNSIGNED, reduce_root, m_mpi_comm);
+    MPI_Gather(&N_own,
+               1,
+               MPI_HOOMD_SCALAR,
+               &N_per_rank[0],
+               1,
+               MPI_HOOMD_SCALAR,
+               reduce_root,
+               m_mpi_comm);
 
     // only the root rank performs the reduction
     if (m_exec_conf->getRank() != reduce_root)
@@ -245,7 +306,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
     ArrayHandle<unsigned int> h_cart_ranks_inv(m_decomposition->getInverseCartRanks(),
                                                access_location::host,
                                                access_mode::read);
-    std::vector<unsigned int> N_per_cart_rank(di.getNumElements());
+    std::vector<Scalar> N_per_cart_rank(di.getNumElements());
     for (unsigned int cur_rank = 0; cur_rank < di.getNumElements(); ++cur_rank)
         {
         N_per_cart_rank[h_cart_ranks_inv.data[cur_rank]] = N_per_rank[cur_rank];
@@ -310,7 +371,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
 
 /*!
  * \param cum_frac_i The cumulative fraction array to write output into
- * \param N_i The reduced number of particles along the dimension
+ * \param N_i The reduced load along the dimension
  * \param L_i The global box length along the dimension
  * \param min_frac_i The minimum fractional width of a domain
  *
@@ -329,15 +390,15 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
  * minimization was successful, apply the adjustment to \a cum_frac_i.
  */
 bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
-                          const vector<unsigned int>& N_i,
+                          const vector<Scalar>& N_i,
                           Scalar L_i,
                           Scalar min_frac_i)
     {
     if (N_i.size() == 1)
         return false;
 
-    // target particles per rank is uniform distribution
-    const Scalar target = Scalar(m_pdata->getNGlobal()) / Scalar(N_i.size());
+    // target load per rank is uniform distribution
+    const Scalar target = m_total_load / Scalar(N_i.size());
 
     // make the minimum domain slightly bigger so that the optimization won't fail at equality
     const Scalar min_domain_size = Scalar(1.00001) * min_frac_i * L_i;
@@ -351,9 +412,9 @@ bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
     vector<Scalar> new_widths(N_i.size());
     for (unsigned int i = 0; i < N_i.size(); ++i)
         {
-        const Scalar imb_factor = Scalar(N_i[i]) / target;
+        const Scalar imb_factor = N_i[i] / target;
         Scalar scale_factor
-            = (N_i[i] > 0)
+            = (N_i[i] > Scalar(0.0))
                   ? Scalar(1.0) / imb_factor
                   : (Scalar(1.0)
                      + m_max_scale); // as in gromacs, use half the imbalance factor to scale
@@ -564,17 +625,34 @@ void LoadBalancer::computeOwnedParticles()
         }
     countParticlesOffRank(cnts);
 
-    MPI_Request req[2 * m_comm->getNUniqueNeighbors()];
-    MPI_Status stat[2 * m_comm->getNUniqueNeighbors()];
+    MPI_Request req[4 * m_comm->getNUniqueNeighbors()];
+    MPI_Status stat[4 * m_comm->getNUniqueNeighbors()];
     unsigned int nreq = 0;
 
     unsigned int n_send_ptls[m_comm->getNUniqueNeighbors()];
     unsigned int n_recv_ptls[m_comm->getNUniqueNeighbors()];
+    Scalar recv_cost[m_comm->getNUniqueNeighbors()];
     for (unsigned int cur_neigh = 0; cur_neigh < m_comm->getNUniqueNeighbors(); ++cur_neigh)
         {
         unsigned int neigh_rank = h_unique_neigh.data[cur_neigh];
         n_send_ptls[cur_neigh] = cnts[neigh_rank];
 
+        // the particles carry the cost of the sending rank
+        MPI_Isend(&m_cost_per_particle,
+                  1,
+                  MPI_HOOMD_SCALAR,
+                  neigh_rank,
+                  1,
+                  m_mpi_comm,
+                  &req[nreq++]);
+        MPI_Irecv(&recv_cost[cur_neigh],
+                  1,
+                  MPI_HOOMD_SCALAR,
+                  neigh_rank,
+                  1,
+                  m_mpi_comm,
+                  &req[nreq++]);
+
         MPI_Isend(&n_send_ptls[cur_neigh],
                   1,
                   MPI_UNSIGNED,
@@ -594,14 +672,18 @@ void LoadBalancer::computeOwnedParticles()
 
     // reduce the particles sent to me
     int N_own = m_pdata->getN();
+    Scalar load_own = Scalar(m_pdata->getN()) * m_cost_per_particle;
     for (unsigned int cur_neigh = 0; cur_neigh < m_comm->getNUniqueNeighbors(); ++cur_neigh)
         {
         N_own += n_recv_ptls[cur_neigh];
         N_own -= n_send_ptls[cur_neigh];
+        load_own += Scalar(n_recv_ptls[cur_neigh]) * recv_cost[cur_neigh];
+        load_own -= Scalar(n_send_ptls[cur_neigh]) * m_cost_per_particle;
         }
 
     // set the count
     resetNOwn(N_own);
+    m_load_own = load_own;
     }
 
 #endif // ENABLE_MPI
@@ -626,6 +708,8 @@ void export_LoadBalancer(pybind11::module& m)
         .def_property("max_iterations",
                       &LoadBalancer::getMaxIterations,
                       &LoadBalancer::setMaxIterations)
+        .def_property("hysteresis", &LoadBalancer::getHysteresis, &LoadBalancer::setHysteresis)
+        .def_property("weight", &LoadBalancer::getWeight, &LoadBalancer::setWeight)
         .def_property("x", &LoadBalancer::getEnableX, &LoadBalancer::setEnableX)
         .def_property("y", &LoadBalancer::getEnableY, &LoadBalancer::setEnableY)
         .def_property("z", &LoadBalancer::getEnableZ, &LoadBalancer::setEnableZ);
@@ -24,8 +24,14 @@ namespace hoomd
 //! Updates domain decompositions to balance the load
 /*!
  * Adjusts the boundaries of the processor domains to distribute the load close to evenly between
- * them. The load imbalance is defined as the number of particles owned by a rank divided by the
- * average number of particles per rank if the particles had a uniform distribution.
+ * them. The load imbalance is defined as the load of a rank divided by the average load per rank.
+ * By default, the load is the number of particles the rank owns. When weighting by time, the load
+ * is the time the rank spent computing forces since the previous update. Particles that move to a
+ * different rank during balancing carry the average cost per particle of the rank they come from.
+ *
+ * To prevent the domain boundaries from oscillating, balancing begins only when the imbalance
+ * exceeds the tolerance plus the hysteresis, and then continues on subsequent updates until the
+ * imbalance falls below the tolerance.
  *
  * At each load balancing step, we attempt to rescale the domain size by the inverse of the load
  * balance, subject to the following constraints that are imposed to both maintain a stable
@@ -81,6 +87,57 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
         m_maxiter = maxiter;
         }
 
+    //! Get the hysteresis for load balancing
+    Scalar getHysteresis() const
+        {
+        return m_hysteresis;
+        }
+
+    //! Set the hysteresis for load balancing
+    /*!
+     * \param hysteresis Additional imbalance above the tolerance required to begin balancing
+     */
+    void setHysteresis(Scalar hysteresis)
+        {
+        if (hysteresis < Scalar(0.0))
+            {
+            throw std::domain_error("LoadBalancer: hysteresis must be non-negative");
+            }
+        m_hysteresis = hysteresis;
+        }
+
+    //! Set the quantity that determines the load of a rank
+    /*!
+     * \param weight "particles" to balance the number of particles, "time" to balance the time
+     * spent computing forces
+     */
+    void setWeight(const std::string& weight)
+        {
+        if (weight == "particles")
+            {
+            m_weight_time = false;
+            }
+        else if (weight == "time")
+            {
+            // kernel launches are asynchronous, the host does not measure the time of the forces
+            if (m_exec_conf->isCUDAEnabled())
+                {
+                throw std::domain_error("LoadBalancer: time weighting is not supported on the GPU");
+                }
+            m_weight_time = true;
+            }
+        else
+            {
+            throw std::domain_error("LoadBalancer: invalid weight " + weight);
+            }
+        }
+
+    //! Get the quantity that determines the load of a rank
+    std::string getWeight() const
+        {
+        return m_weight_time ? "time" : "particles";
+        }
+
     //! Enable / disable load balancing along a dimension
     /*!
      * \param dim Dimension along which to balance
@@ -155,8 +212,11 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
     //! Computes the maximum imbalance factor
     Scalar getMaxImbalance();
 
-    //! Reduce the particle numbers per rank down to one dimension
-    bool reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsigned int reduce_root);
+    //! Reduce the loads per rank down to one dimension
+    bool reduce(std::vector<Scalar>& N_i, unsigned int dim, unsigned int reduce_root);
+
+    //! Measure the cost per particle on this rank and the total load
+    void updateCost();
 
     //! Set flags within the class that a resize has been performed
     void signalResize()
@@ -168,7 +228,7 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
 
     //! Adjust the partitioning along a single dimension
     bool adjust(std::vector<Scalar>& cum_frac_i,
-                const std::vector<unsigned int>& N_i,
+                const std::vector<Scalar>& N_i,
                 Scalar L_i,
                 Scalar min_domain_frac);
 
@@ -185,6 +245,13 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
         return m_N_own;
         }
 
+    //! Gets the load of the rank, updating if necessary
+    Scalar getLoadOwn()
+        {
+        computeOwnedParticles();
+        return m_load_own;
+        }
+
     //! Force a reset of the number of owned particles without counting
     /*!
      * \param N number of particles owned by the rank
@@ -192,6 +259,7 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
     void resetNOwn(unsigned int N)
         {
         m_N_own = N;
+        m_load_own = Scalar(N) * m_cost_per_particle;
         m_recompute_max_imbalance = true;
         m_needs_recount = false;
         }
@@ -205,6 +273,9 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
 
     Scalar m_tolerance;     //!< Load imbalance to tolerate
     unsigned int m_maxiter; //!< Maximum number of iterations to attempt
+    Scalar m_hysteresis;    //!< Imbalance above the tolerance required to begin balancing
+    bool m_weight_time;     //!< Flag to weight the load by the force compute time
+    bool m_balancing;       //!< Flag set while balancing toward the tolerance
     bool m_enable_x;        //!< Flag to enable balancing in x
     bool m_enable_y;        //!< Flag to enable balancing in y
     bool m_enable_z;        //!< Flag to enable balancing z
@@ -214,6 +285,11 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
     private:
     unsigned int m_N_own; //!< Number of particles owned by this rank
 
+    Scalar m_load_own;          //!< Load of this rank
+    Scalar m_total_load;        //!< Total load of all ranks
+    Scalar m_cost_per_particle; //!< Average load of a particle owned by this rank
+    int64_t m_last_force_time;  //!< Force compute time at the previous update [ns]
+
     Scalar m_max_max_imbalance;   //!< The maximum imbalance of any check
     double m_total_max_imbalance; //!< The average imbalance over checks
     uint64_t m_n_calls;           //!< The number of times the updater was called
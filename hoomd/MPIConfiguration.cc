@@ -7,6 +7,8 @@
 #include "HOOMDMPI.h"
 #endif
 
+#include <pybind11/numpy.h>
+
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
@@ -82,6 +84,43 @@ unsigned int MPIConfiguration::getNRanks() const
 #endif
     }
 
+/*! \param values Array of values on this rank, converted to double
+    \param op Reduction operation: "sum", "min", or "max"
+    \returns Array of the same shape with the reduced values, on all ranks
+
+    \note This method must be called collectively on all ranks in the partition, with arrays of
+    the same shape.
+*/
+pybind11::object MPIConfiguration::allReducePy(pybind11::object values, const std::string& op) const
+    {
+    pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast> in(values);
+    std::vector<ssize_t> shape(in.shape(), in.shape() + in.ndim());
+    pybind11::array_t<double> out(shape);
+    std::copy(in.data(), in.data() + in.size(), out.mutable_data());
+
+    if (op != "sum" && op != "min" && op != "max")
+        {
+        throw std::runtime_error("Invalid reduction operation: " + op);
+        }
+
+#ifdef ENABLE_MPI
+    MPI_Op mpi_op = MPI_SUM;
+    if (op == "min")
+        mpi_op = MPI_MIN;
+    else if (op == "max")
+        mpi_op = MPI_MAX;
+
+    MPI_Allreduce(MPI_IN_PLACE,
+                  out.mutable_data(),
+                  int(out.size()),
+                  MPI_DOUBLE,
+                  mpi_op,
+                  m_mpi_comm);
+#endif
+
+    return out;
+    }
+
 namespace detail
     {
 void export_MPIConfiguration(pybind11::module& m)
@@ -99,6 +138,7 @@ void export_MPIConfiguration(pybind11::module& m)
         .def("getNRanksGlobal", &MPIConfiguration::getNRanksGlobal)
         .def("getRankGlobal", &MPIConfiguration::getRankGlobal)
         .def("getWalltime", &MPIConfiguration::getWalltime)
+        .def("allReduce", &MPIConfiguration::allReducePy)
 #ifdef ENABLE_MPI
         .def_static("_make_mpi_conf_mpi_comm",
                     [](pybind11::object mpi_comm) -> std::shared_ptr<MPIConfiguration>
@@ -21,6 +21,7 @@
 #endif
 
 #include <pybind11/pybind11.h>
+#include <string>
 
 namespace hoomd
     {
@@ -122,6 +123,9 @@ class PYBIND11_EXPORT MPIConfiguration
         return getRank() == 0;
         }
 
+    //! Reduce an array element-wise over all ranks in the partition
+    pybind11::object allReducePy(pybind11::object values, const std::string& op) const;
+
     //! Perform a job-wide MPI barrier
     void barrier()
         {
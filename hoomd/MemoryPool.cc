@@ -0,0 +1,134 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file MemoryPool.cc
+    \brief Defines the MemoryPool class
+*/
+
+#include "MemoryPool.h"
+
+#include <new>
+#include <stdexcept>
+
+namespace hoomd
+    {
+namespace detail
+    {
+/*! \param num_bytes Number of bytes requested
+    \returns Number of bytes in the size class of \a num_bytes
+*/
+size_t MemoryPool::getBlockSize(size_t num_bytes)
+    {
+    if (num_bytes <= min_block_bytes)
+        return min_block_bytes;
+
+    // find the largest power of two below num_bytes, and round up to a quarter of it
+    size_t power = min_block_bytes;
+    while (power < (num_bytes - 1) / 2 + 1)
+        power *= 2;
+    const size_t step = power / 4;
+    return ((num_bytes + step - 1) / step) * step;
+    }
+
+/*! \param num_bytes Number of bytes requested
+    \returns Pointer to a block of at least \a num_bytes bytes
+
+    A cached block of the same size class is reused when there is one. Otherwise, a new block is
+    allocated from the system.
+*/
+void* MemoryPool::allocate(size_t num_bytes)
+    {
+    const size_t block_bytes = getBlockSize(num_bytes);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.n_allocations++;
+
+    void* ptr = nullptr;
+    auto cached = m_cached.find(block_bytes);
+    if (cached != m_cached.end() && !cached->second.empty())
+        {
+        ptr = cached->second.back();
+        cached->second.pop_back();
+        m_stats.bytes_cached -= block_bytes;
+        m_stats.n_hits++;
+        }
+    else
+        {
+        try
+            {
+            ptr = m_system_allocate(block_bytes);
+            }
+        catch (const std::bad_alloc&)
+            {
+            // the cached blocks may be holding the memory that is needed
+            releaseLocked();
+            ptr = m_system_allocate(block_bytes);
+            }
+        m_stats.n_system_allocations++;
+        }
+
+    m_in_use[ptr] = block_bytes;
+    m_stats.bytes_in_use += block_bytes;
+    if (m_stats.bytes_in_use > m_stats.peak_bytes_in_use)
+        m_stats.peak_bytes_in_use = m_stats.bytes_in_use;
+
+    return ptr;
+    }
+
+/*! \param ptr Block previously returned by allocate()
+
+    The block is cached for reuse, and only freed by release(), unless the pool is disabled.
+*/
+void MemoryPool::deallocate(void* ptr)
+    {
+    if (ptr == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto block = m_in_use.find(ptr);
+    if (block == m_in_use.end())
+        {
+        throw std::runtime_error("Block returned to MemoryPool was not allocated by it.");
+        }
+
+    const size_t block_bytes = block->second;
+    m_in_use.erase(block);
+    m_stats.bytes_in_use -= block_bytes;
+
+    if (!m_enabled)
+        {
+        m_system_free(ptr);
+        return;
+        }
+
+    m_cached[block_bytes].push_back(ptr);
+    m_stats.bytes_cached += block_bytes;
+    }
+
+void MemoryPool::release()
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    releaseLocked();
+    }
+
+void MemoryPool::releaseLocked()
+    {
+    for (auto& size_class : m_cached)
+        {
+        for (void* ptr : size_class.second)
+            {
+            m_system_free(ptr);
+            }
+        }
+    m_cached.clear();
+    m_stats.bytes_cached = 0;
+    }
+
+MemoryPool::Stats MemoryPool::getStats() const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+    }
+
+    } // end namespace detail
+    } // end namespace hoomd
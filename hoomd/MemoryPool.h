@@ -0,0 +1,153 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file MemoryPool.h
+    \brief Declares the MemoryPool class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __MEMORY_POOL_H__
+#define __MEMORY_POOL_H__
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace hoomd
+    {
+namespace detail
+    {
+/// Pool of memory blocks grouped into size classes
+/*! MemoryPool caches the blocks that are returned to it and hands them out again for later
+    requests in the same size class, so that arrays that grow, shrink, or are recreated do not go
+    back to the system allocator each time. The pool does not know what kind of memory it holds:
+    the functions that allocate and free a block from the system (e.g., hipMalloc and hipFree) are
+    given to the constructor.
+
+    Requests are rounded up to a size class. Size classes are spaced by a quarter of the power of
+    two below them, so that at most 25% of a block is unused, and the smallest class is
+    min_block_bytes. Cached blocks are only freed by release() or the destructor. When the system
+    allocator fails, the cached blocks are released and the allocation is tried once more. A
+    disabled pool does not cache: blocks returned to it are freed immediately.
+
+    All methods are thread safe.
+*/
+class MemoryPool
+    {
+    public:
+    /// Smallest block handed out by the pool [bytes]
+    static const size_t min_block_bytes = 256;
+
+    /// Allocation statistics of the pool
+    struct Stats
+        {
+        /// Number of blocks requested from the pool
+        size_t n_allocations = 0;
+
+        /// Number of requests served by a cached block
+        size_t n_hits = 0;
+
+        /// Number of blocks allocated from the system
+        size_t n_system_allocations = 0;
+
+        /// Number of bytes in blocks that are in use
+        size_t bytes_in_use = 0;
+
+        /// Number of bytes in cached blocks
+        size_t bytes_cached = 0;
+
+        /// Largest value of bytes_in_use
+        size_t peak_bytes_in_use = 0;
+        };
+
+    /// Construct an empty pool
+    /*! \param system_allocate Allocates a block of the given number of bytes from the system, and
+            throws std::bad_alloc when it fails
+        \param system_free Frees a block allocated by system_allocate
+    */
+    MemoryPool(std::function<void*(size_t)> system_allocate,
+               std::function<void(void*)> system_free)
+        : m_system_allocate(system_allocate), m_system_free(system_free)
+        {
+        }
+
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+
+    /// Free all cached blocks
+    /*! Blocks that are still in use are not freed.
+     */
+    ~MemoryPool()
+        {
+        release();
+        }
+
+    /// Get a block of at least the given size
+    void* allocate(size_t num_bytes);
+
+    /// Return a block to the pool
+    void deallocate(void* ptr);
+
+    /// Free all cached blocks
+    void release();
+
+    /// Get the allocation statistics
+    Stats getStats() const;
+
+    /// Get whether returned blocks are cached
+    bool getEnabled() const
+        {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_enabled;
+        }
+
+    /// Set whether returned blocks are cached
+    /*! Disabling the pool frees all cached blocks.
+     */
+    void setEnabled(bool enabled)
+        {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_enabled = enabled;
+        if (!m_enabled)
+            releaseLocked();
+        }
+
+    /// Get the size of the block that serves a request
+    static size_t getBlockSize(size_t num_bytes);
+
+    private:
+    /// Allocates a block from the system
+    std::function<void*(size_t)> m_system_allocate;
+
+    /// Frees a block from the system
+    std::function<void(void*)> m_system_free;
+
+    /// Cached blocks, by block size
+    std::map<size_t, std::vector<void*>> m_cached;
+
+    /// Blocks in use, and their sizes
+    std::unordered_map<void*, size_t> m_in_use;
+
+    /// Allocation statistics
+    Stats m_stats;
+
+    /// True when returned blocks are cached
+    bool m_enabled = true;
+
+    /// Protects the cache and statistics
+    mutable std::mutex m_mutex;
+
+    /// Free all cached blocks, with m_mutex held
+    void releaseLocked();
+    };
+
+    } // end namespace detail
+    } // end namespace hoomd
+
+#endif // __MEMORY_POOL_H__
@@ -0,0 +1,200 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file MemoryTracker.cc
+    \brief Defines the MemoryTracker class
+*/
+
+#include "MemoryTracker.h"
+
+#include <cxxabi.h>
+#include <map>
+#include <mutex>
+#include <stdlib.h>
+#include <tuple>
+#include <typeindex>
+#include <unordered_map>
+
+namespace hoomd
+    {
+namespace detail
+    {
+namespace
+    {
+/// Record of one live allocation
+struct Allocation
+    {
+    MemoryTracker::Location location;
+    size_t num_bytes;
+    const std::type_info* type;
+    std::string tag;
+    std::string owner;
+    };
+
+/// State shared by all users of the tracker
+struct TrackerState
+    {
+    std::mutex mutex;
+    std::unordered_map<const void*, Allocation> allocations;
+    std::array<size_t, MemoryTracker::num_locations> bytes = {};
+    std::array<size_t, MemoryTracker::num_locations> peak_bytes = {};
+    };
+
+/// Get the tracker state
+/*! The state is never destroyed, so that arrays with static storage duration may still unregister
+    their allocations at exit.
+*/
+TrackerState& getState()
+    {
+    static TrackerState* state = new TrackerState;
+    return *state;
+    }
+
+/// Demangle a type name
+/*! \param name Mangled name
+    \returns The demangled name, or \a name if it cannot be demangled
+*/
+std::string demangle(const char* name)
+    {
+    int status;
+    char* realname = abi::__cxa_demangle(name, 0, 0, &status);
+    if (status)
+        return std::string(name);
+
+    std::string result(realname);
+    free(realname);
+    return result;
+    }
+    } // end anonymous namespace
+
+/*! \param ptr Start of the allocation
+    \param location Kind of memory allocated
+    \param num_bytes Size of the allocation
+    \param type Element type of the array
+    \param tag Tag of the array
+    \param owner Class that holds the array
+*/
+void MemoryTracker::registerAllocation(const void* ptr,
+                                       Location location,
+                                       size_t num_bytes,
+                                       const std::type_info& type,
+                                       const std::string& tag,
+                                       const std::string& owner)
+    {
+    if (ptr == nullptr)
+        return;
+
+    TrackerState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.allocations[ptr] = Allocation {location, num_bytes, &type, tag, owner};
+    state.bytes[location] += num_bytes;
+    if (state.bytes[location] > state.peak_bytes[location])
+        state.peak_bytes[location] = state.bytes[location];
+    }
+
+/*! \param ptr Start of the allocation
+
+    Allocations that were never registered are ignored.
+*/
+void MemoryTracker::unregisterAllocation(const void* ptr)
+    {
+    if (ptr == nullptr)
+        return;
+
+    TrackerState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto allocation = state.allocations.find(ptr);
+    if (allocation == state.allocations.end())
+        return;
+
+    state.bytes[allocation->second.location] -= allocation->second.num_bytes;
+    state.allocations.erase(allocation);
+    }
+
+/*! \param ptr Start of the allocation
+    \param tag New tag of the array
+    \param owner New owner of the array
+*/
+void MemoryTracker::setTag(const void* ptr, const std::string& tag, const std::string& owner)
+    {
+    if (ptr == nullptr)
+        return;
+
+    TrackerState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto allocation = state.allocations.find(ptr);
+    if (allocation != state.allocations.end())
+        {
+        allocation->second.tag = tag;
+        allocation->second.owner = owner;
+        }
+    }
+
+/*! \returns The memory held by the live allocations, sorted by owner, tag, and type
+
+    Allocations without a tag are reported under an empty tag and owner.
+*/
+std::vector<MemoryTracker::Usage> MemoryTracker::getUsage()
+    {
+    typedef std::tuple<std::string, std::string, std::type_index> Key;
+    std::map<Key, Usage> groups;
+
+        {
+        TrackerState& state = getState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        for (const auto& allocation : state.allocations)
+            {
+            const Allocation& a = allocation.second;
+            Usage& usage = groups[Key(a.owner, a.tag, std::type_index(*a.type))];
+            if (usage.n_allocations == 0)
+                {
+                usage.tag = a.tag;
+                usage.owner = a.owner;
+                usage.type = a.type->name();
+                }
+            usage.n_allocations++;
+            usage.bytes[a.location] += a.num_bytes;
+            }
+        }
+
+    std::vector<Usage> result;
+    result.reserve(groups.size());
+    for (auto& group : groups)
+        {
+        group.second.type = demangle(group.second.type.c_str());
+        result.push_back(group.second);
+        }
+    return result;
+    }
+
+size_t MemoryTracker::getBytes(Location location)
+    {
+    TrackerState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.bytes[location];
+    }
+
+size_t MemoryTracker::getPeakBytes(Location location)
+    {
+    TrackerState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.peak_bytes[location];
+    }
+
+void MemoryTracker::resetPeakBytes()
+    {
+    TrackerState& state = getState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.peak_bytes = state.bytes;
+    }
+
+/*! \param type Type to name
+    \returns The demangled name of \a type, or its mangled name if it cannot be demangled
+*/
+std::string MemoryTracker::getTypeName(const std::type_info& type)
+    {
+    return demangle(type.name());
+    }
+
+    } // end namespace detail
+    } // end namespace hoomd
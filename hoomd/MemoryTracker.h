@@ -0,0 +1,103 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file MemoryTracker.h
+    \brief Declares the MemoryTracker class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __MEMORY_TRACKER_H__
+#define __MEMORY_TRACKER_H__
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+namespace detail
+    {
+/// Accounts for the memory held by GPUArray and GlobalArray allocations
+/*! The arrays register every host, device, and managed memory allocation with the tracker when
+    they make it, and unregister it when they free it. Each allocation carries the tag (usually the
+    name of the member variable) and the owner (the class that holds the array) set with
+    GlobalArray::setTag() or GPUArray::setTag(), so that the memory can be reported per array.
+
+    The tracker also keeps the total number of bytes allocated in each kind of memory and its peak.
+    The accounting is process wide: it includes the arrays of all execution configurations in the
+    process.
+
+    All methods are thread safe.
+*/
+class PYBIND11_EXPORT MemoryTracker
+    {
+    public:
+    /// Kinds of memory
+    enum Location
+        {
+        host = 0,
+        device,
+        managed,
+        num_locations
+        };
+
+    /// Memory held by the allocations with the same tag, owner, and element type
+    struct Usage
+        {
+        /// Tag of the arrays
+        std::string tag;
+
+        /// Class that holds the arrays
+        std::string owner;
+
+        /// Element type of the arrays
+        std::string type;
+
+        /// Number of allocations in the group
+        size_t n_allocations = 0;
+
+        /// Number of bytes held in each kind of memory
+        std::array<size_t, num_locations> bytes = {};
+        };
+
+    /// Record a new allocation
+    static void registerAllocation(const void* ptr,
+                                   Location location,
+                                   size_t num_bytes,
+                                   const std::type_info& type,
+                                   const std::string& tag,
+                                   const std::string& owner);
+
+    /// Remove the record of a freed allocation
+    static void unregisterAllocation(const void* ptr);
+
+    /// Change the tag and owner of an allocation
+    static void setTag(const void* ptr, const std::string& tag, const std::string& owner);
+
+    /// Get the memory held by the live allocations, grouped by tag, owner, and type
+    static std::vector<Usage> getUsage();
+
+    /// Get the number of bytes currently allocated
+    static size_t getBytes(Location location);
+
+    /// Get the largest number of bytes allocated at one time
+    static size_t getPeakBytes(Location location);
+
+    /// Restart the peak from the number of bytes currently allocated
+    static void resetPeakBytes();
+
+    /// Get the demangled name of a type
+    static std::string getTypeName(const std::type_info& type);
+    };
+
+    } // end namespace detail
+    } // end namespace hoomd
+
+#endif // __MEMORY_TRACKER_H__
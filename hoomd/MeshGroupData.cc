@@ -12,6 +12,8 @@
 
 #include <pybind11/numpy.h>
 
+#include <unordered_map>
+
 #ifdef ENABLE_HIP
 #include "CachedAllocator.h"
 // #include "MeshGroupData.cuh"
@@ -125,6 +127,10 @@ void MeshGroupData<group_size, Group, name, snap>::initializeFromTriangleSnapsho
 
     if (group_size == 4)
         {
+        // index of each edge in all_helper, keyed by its sorted vertex tags
+        std::unordered_map<uint64_t, unsigned int> edge_index;
+        edge_index.reserve(snapshot.groups.size() * 2);
+
         for (unsigned group_idx = 0; group_idx < snapshot.groups.size(); group_idx++)
             {
             std::vector<unsigned int> triag_tag(3);
@@ -161,25 +167,22 @@ void MeshGroupData<group_size, Group, name, snap>::initializeFromTriangleSnapsho
                     }
                 }
 
-            // Remove any duplicate bonds.
-            for (unsigned int i = 0; i < all_helper.size(); ++i)
+            // The second triangle of an edge completes the existing bond with its opposite vertex.
+            for (unsigned int j = 0; j < bonds.size(); ++j)
                 {
-                for (unsigned int j = 0; j < bonds.size(); ++j)
+                const uint64_t edge
+                    = (uint64_t(bonds[j].tag[0]) << 32) | uint64_t(bonds[j].tag[1]);
+                auto inserted
+                    = edge_index.insert(std::make_pair(edge, (unsigned int)all_helper.size()));
+                if (inserted.second)
                     {
-                    if (bonds[j].tag[0] == all_helper[i].tag[0]
-                        && bonds[j].tag[1] == all_helper[i].tag[1])
-                        {
-                        // all_helper[i].tag[3] = group_idx;
-                        all_helper[i].tag[3] = bonds[j].tag[2];
-                        bonds.erase(bonds.begin() + j);
-                        break;
-                        }
+                    all_helper.push_back(bonds[j]);
+                    all_types.push_back(snapshot.type_id[group_idx]);
+                    }
+                else
+                    {
+                    all_helper[inserted.first->second].tag[3] = bonds[j].tag[2];
                     }
-                }
-            for (unsigned int i = 0; i < bonds.size(); ++i)
-                {
-                all_helper.push_back(bonds[i]);
-                all_types.push_back(snapshot.type_id[group_idx]);
                 }
             }
         all_groups = all_helper;
@@ -63,7 +63,8 @@ class mpi_io : public std::streambuf
     \post The notice level is set to 2
     \post prefixes are "error!!!!" , "warning!!" and "notice"
 */
-Messenger::Messenger(std::shared_ptr<MPIConfiguration> mpi_config) : m_mpi_config(mpi_config)
+Messenger::Messenger(std::shared_ptr<MPIConfiguration> mpi_config)
+    : m_mpi_config(mpi_config), m_thread_id(std::this_thread::get_id())
     {
     m_err_stream = &cerr;
     m_warning_stream = &cerr;
@@ -87,7 +88,7 @@ Messenger::Messenger(std::shared_ptr<MPIConfiguration> mpi_config) : m_mpi_confi
         m_notice_level = 0;
     }
 
-Messenger::Messenger(const Messenger& msg)
+Messenger::Messenger(const Messenger& msg) : m_thread_id(std::this_thread::get_id())
     {
     m_err_stream = msg.m_err_stream;
     m_warning_stream = msg.m_warning_stream;
@@ -100,7 +101,7 @@ Messenger::Messenger(const Messenger& msg)
     m_err_prefix = msg.m_err_prefix;
     m_warning_prefix = msg.m_warning_prefix;
     m_notice_prefix = msg.m_notice_prefix;
-    m_notice_level = msg.m_notice_level;
+    m_notice_level = msg.m_notice_level.load();
 
     m_mpi_config = msg.m_mpi_config;
     }
@@ -118,7 +119,7 @@ Messenger& Messenger::operator=(Messenger& msg)
     m_err_prefix = msg.m_err_prefix;
     m_warning_prefix = msg.m_warning_prefix;
     m_notice_prefix = msg.m_notice_prefix;
-    m_notice_level = msg.m_notice_level;
+    m_notice_level = msg.m_notice_level.load();
 
     m_mpi_config = msg.m_mpi_config;
 
@@ -195,6 +196,12 @@ void Messenger::errorStr(const std::string& msg)
     "${warning_prefix}: ".
 */
 std::ostream& Messenger::warning()
+    {
+    flushDeferred();
+    return warningStream();
+    }
+
+std::ostream& Messenger::warningStream()
     {
     if (m_mpi_config->getRank() != 0)
         return *m_nullstream;
@@ -224,9 +231,16 @@ void Messenger::warningStr(const std::string& msg)
    printed.
 */
 std::ostream& Messenger::notice(unsigned int level)
+    {
+    if (isNoticeEnabled(level))
+        flushDeferred();
+    return noticeStream(level);
+    }
+
+std::ostream& Messenger::noticeStream(unsigned int level)
     {
     assert(m_notice_stream);
-    if (level <= m_notice_level)
+    if (isNoticeEnabled(level))
         {
         reopenPythonIfNeeded();
         if (m_notice_prefix != string("") && level > 1)
@@ -239,6 +253,43 @@ std::ostream& Messenger::notice(unsigned int level)
         }
     }
 
+/*! \param warning True for a warning, false for a notice
+    \param level Notice level
+    \param text Formatted message
+*/
+void Messenger::deferMessage(bool warning, unsigned int level, std::string text)
+    {
+#ifdef ENABLE_TBB
+    m_deferred.push(DeferredMessage {warning, level, std::move(text)});
+#else
+    // without TBB, there are no worker threads to defer messages from
+    if (warning)
+        warningStream() << text << std::flush;
+    else
+        noticeStream(level) << text << std::flush;
+#endif
+    }
+
+/*! Must be called from the thread that created the Messenger. The messages are printed in the
+    order the threads queued them.
+*/
+void Messenger::flushDeferred()
+    {
+#ifdef ENABLE_TBB
+    if (m_deferred.empty() || !isCreatingThread())
+        return;
+
+    DeferredMessage message;
+    while (m_deferred.try_pop(message))
+        {
+        if (message.warning)
+            warningStream() << message.text << std::flush;
+        else
+            noticeStream(message.level) << message.text << std::flush;
+        }
+#endif
+    }
+
 /*! Outputs the the collective notice string on the processor with rank zero, in rank order.
 
  \param level The notice level
@@ -5,10 +5,13 @@
     \brief Declares the Messenger class
 */
 
+#include <atomic>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <thread>
 
 #include "HOOMDMPI.h"
 #include "MPIConfiguration.h"
@@ -19,6 +22,10 @@
 
 #include <pybind11/pybind11.h>
 
+#ifdef ENABLE_TBB
+#include <tbb/concurrent_queue.h>
+#endif
+
 #ifndef __MESSENGER_H__
 #define __MESSENGER_H__
 
@@ -98,6 +105,17 @@ struct PYBIND11_EXPORT nullstream : std::ostream
         - 6 memory allocation/reallocation notices from every major class
         - 7 memory allocation/reallocation notices from GPUArray
     - 10: Trace messages that may print many times per time step.
+
+    \b Lazy messages
+
+    The streams format every argument even when the notice level discards the message. In code that
+    runs every time step, pass a callable that writes the message to a stream instead:
+    \code msg.notice(10, [&](std::ostream& out) { out << "step " << timestep << std::endl; });
+    \endcode The callable is only invoked when the message is printed. The lazy notice() and
+    warning() may also be called from TBB worker threads. They queue the messages of threads other
+    than the one that created the Messenger without locking, and the creating thread prints them
+    on its next message or flushDeferred() call. The stream methods must only be called from the
+    creating thread.
 */
 class PYBIND11_EXPORT Messenger
     {
@@ -129,9 +147,65 @@ class PYBIND11_EXPORT Messenger
     //! Alternate method to print warning strings
     void warningStr(const std::string& msg);
 
+    //! Print a warning formatted by a callable
+    /*! \param format Callable that writes the message to the std::ostream& it is given
+
+        \a format is only called on the rank that prints warnings.
+    */
+    template<class Format> void warning(Format&& format)
+        {
+        if (m_mpi_config->getRank() != 0)
+            return;
+
+        if (isCreatingThread())
+            {
+            format(warning());
+            }
+        else
+            {
+            std::ostringstream out;
+            format(out);
+            deferMessage(true, 0, out.str());
+            }
+        }
+
     //! Get a notice stream
     std::ostream& notice(unsigned int level);
 
+    //! Print a notice formatted by a callable
+    /*! \param level Notice level
+        \param format Callable that writes the message to the std::ostream& it is given
+
+        \a format is only called when the notice level prints the message.
+    */
+    template<class Format> void notice(unsigned int level, Format&& format)
+        {
+        if (!isNoticeEnabled(level))
+            return;
+
+        if (isCreatingThread())
+            {
+            format(notice(level));
+            }
+        else
+            {
+            std::ostringstream out;
+            format(out);
+            deferMessage(false, level, out.str());
+            }
+        }
+
+    //! Test if messages of a notice level are printed
+    /*! Unlike getNoticeLevel(), this is not collective. It is false on all ranks but the root.
+     */
+    bool isNoticeEnabled(unsigned int level) const
+        {
+        return level <= m_notice_level.load(std::memory_order_relaxed);
+        }
+
+    //! Print the messages queued by other threads
+    void flushDeferred();
+
     //! Print a notice message in rank-order
     void collectiveNoticeStr(unsigned int level, const std::string& msg);
 
@@ -157,7 +231,8 @@ class PYBIND11_EXPORT Messenger
      */
     void setNoticeLevel(unsigned int level)
         {
-        m_notice_level = (m_mpi_config->getRank() == 0) ? level : 0;
+        m_notice_level.store((m_mpi_config->getRank() == 0) ? level : 0,
+                             std::memory_order_relaxed);
         }
 
     //! Set the error stream
@@ -275,12 +350,41 @@ class PYBIND11_EXPORT Messenger
     std::string m_warning_prefix; //!< Prefix for warning messages
     std::string m_notice_prefix;  //!< Prefix for notice messages
 
-    unsigned int m_notice_level; //!< Notice level
+    std::atomic<unsigned int> m_notice_level; //!< Notice level
 
     bool m_python_open = false;  //!< True when the python output stream is open
     pybind11::module m_sys;      //!< sys module
     pybind11::object m_pystdout; //!< Currently bound python sys.stdout
     pybind11::object m_pystderr; //!< Currently bound python sys.stderr
+
+    std::thread::id m_thread_id; //!< Thread that created the Messenger
+
+    //! A message queued by another thread
+    struct DeferredMessage
+        {
+        bool warning;       //!< True for a warning, false for a notice
+        unsigned int level; //!< Notice level
+        std::string text;   //!< Formatted message
+        };
+
+#ifdef ENABLE_TBB
+    tbb::concurrent_queue<DeferredMessage> m_deferred; //!< Messages queued by other threads
+#endif
+
+    //! Test if the calling thread created the Messenger
+    bool isCreatingThread() const
+        {
+        return std::this_thread::get_id() == m_thread_id;
+        }
+
+    //! Queue a message of another thread
+    void deferMessage(bool warning, unsigned int level, std::string text);
+
+    //! Get the warning stream without printing the queued messages
+    std::ostream& warningStream();
+
+    //! Get a notice stream without printing the queued messages
+    std::ostream& noticeStream(unsigned int level);
     };
 
 namespace detail
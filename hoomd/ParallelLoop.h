@@ -0,0 +1,175 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#ifndef __PARALLEL_LOOP_H__
+#define __PARALLEL_LOOP_H__
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "ExecutionConfiguration.h"
+
+#include <algorithm>
+#include <string.h>
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <vector>
+#endif
+
+/*! \file ParallelLoop.h
+    \brief Declares helpers that distribute loops over the particles on the TBB threads
+*/
+
+namespace hoomd
+    {
+namespace detail
+    {
+//! Run a loop over [0, n), in parallel when TBB threads are available
+/*! \param exec_conf Execution configuration that provides the threads
+    \param n Number of iterations
+    \param range Callable range(first, last) that performs the iterations [first, last)
+
+    Iterations of \a range must not write to the same elements. Without TBB, or with a single
+    thread, range(0, n) is called on the calling thread.
+
+    The loop is split with tbb::static_partitioner, so every loop over the same number of
+    iterations assigns the same part of [0, n) to the same arena slot. parallel_first_touch()
+    splits allocations the same way.
+*/
+template<class Range>
+void parallel_loop(const ExecutionConfiguration& exec_conf, unsigned int n, Range range)
+    {
+#ifdef ENABLE_TBB
+    if (exec_conf.getNumThreads() > 1)
+        {
+        exec_conf.getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(
+                    tbb::blocked_range<unsigned int>(0, n),
+                    [&](const tbb::blocked_range<unsigned int>& r) { range(r.begin(), r.end()); },
+                    tbb::static_partitioner());
+            });
+        return;
+        }
+#endif
+
+    range(0, n);
+    }
+
+//! Run a loop over the local members of a group, in parallel when TBB threads are available
+/*! \param exec_conf Execution configuration that provides the threads
+    \param group ParticleGroup to loop over
+    \param range Callable range(first, last, index) that performs the iterations [first, last),
+        where index(group_idx) returns the particle index of member group_idx
+
+    \a range is a generic lambda. It is compiled once with the index list of the group and once
+    for groups with contiguous members, such as all particles, where index() is an offset. The
+    second version needs no index list and the compiler can vectorize it.
+*/
+template<class Group, class Range>
+void parallel_group_loop(const ExecutionConfiguration& exec_conf, Group& group, Range range)
+    {
+    const unsigned int n = group.getNumMembers();
+    group.withIndexMap(
+        [&](auto index)
+        {
+            parallel_loop(exec_conf,
+                          n,
+                          [&](unsigned int first, unsigned int last)
+                          { range(first, last, index); });
+        });
+    }
+
+//! Accumulate a sum over [0, n), in parallel when TBB threads are available
+/*! \param exec_conf Execution configuration that provides the threads
+    \param n Number of iterations
+    \param sum Sum to add the result to
+    \param range Callable range(first, last, sum) that adds the iterations [first, last) to sum
+
+    With several threads, the iterations are split into chunks of a fixed size. Each chunk
+    accumulates into a value initialized T, and the chunk sums are added to \a sum in order. The
+    result is therefore independent of the number of threads and of the scheduling. T must provide
+    operator+=. Without TBB, or with a single thread, range(0, n, sum) is called on the calling
+    thread.
+*/
+template<class T, class Range>
+void parallel_accumulate(const ExecutionConfiguration& exec_conf,
+                         unsigned int n,
+                         T& sum,
+                         Range range)
+    {
+#ifdef ENABLE_TBB
+    if (exec_conf.getNumThreads() > 1)
+        {
+        const unsigned int chunk_size = 4096;
+        const unsigned int n_chunks = (n + chunk_size - 1) / chunk_size;
+        std::vector<T> chunk_sum(n_chunks, T());
+
+        exec_conf.getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_chunks),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  {
+                                      for (unsigned int chunk = r.begin(); chunk != r.end();
+                                           ++chunk)
+                                          {
+                                          range(chunk * chunk_size,
+                                                std::min(n, (chunk + 1) * chunk_size),
+                                                chunk_sum[chunk]);
+                                          }
+                                  },
+                                  tbb::static_partitioner());
+            });
+
+        for (const T& s : chunk_sum)
+            {
+            sum += s;
+            }
+        return;
+        }
+#endif
+
+    range(0, n, sum);
+    }
+
+//! Zero memory on the TBB threads that will use it
+/*! \param exec_conf Execution configuration that provides the threads
+    \param ptr Memory to zero
+    \param bytes Number of bytes to zero
+
+    Linux places a page on the NUMA node of the thread that first writes to it. Zeroing a new
+    allocation with parallel_loop() over its pages places each part of the array near the thread
+    that processes the same part of a loop over the array's elements. Without TBB, with a single
+    thread, or for small allocations, the memory is zeroed on the calling thread.
+*/
+inline void parallel_first_touch(const ExecutionConfiguration& exec_conf, void* ptr, size_t bytes)
+    {
+    const size_t page_size = 4096;
+    const size_t n_pages = (bytes + page_size - 1) / page_size;
+
+    if (exec_conf.getNumThreads() <= 1 || n_pages < 2 * size_t(exec_conf.getNumThreads()))
+        {
+        memset(ptr, 0, bytes);
+        return;
+        }
+
+    parallel_loop(exec_conf,
+                  (unsigned int)n_pages,
+                  [&](unsigned int first, unsigned int last)
+                  {
+                      size_t begin = first * page_size;
+                      size_t end = std::min(bytes, last * page_size);
+                      memset((char*)ptr + begin, 0, end - begin);
+                  });
+    }
+
+    } // end namespace detail
+    } // end namespace hoomd
+
+#endif // __PARALLEL_LOOP_H__
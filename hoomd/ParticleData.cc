@@ -6,6 +6,7 @@
  */
 
 #include "ParticleData.h"
+#include "CheckpointBuffer.h"
 
 #ifdef ENABLE_MPI
 #include "HOOMDMPI.h"
@@ -77,7 +78,8 @@ ParticleData::ParticleData(unsigned int N,
                            std::shared_ptr<ExecutionConfiguration> exec_conf,
                            std::shared_ptr<DomainDecomposition> decomposition)
     : m_exec_conf(exec_conf), m_nparticles(0), m_nghosts(0), m_max_nparticles(0), m_nglobal(0),
-      m_accel_set(false), m_resize_factor(9. / 8.), m_arrays_allocated(false)
+      m_accel_set(false), m_resize_factor(9. / 8.), m_shrink_fraction(0),
+      m_arrays_allocated(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing ParticleData" << endl;
 
@@ -139,7 +141,8 @@ ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
                            std::shared_ptr<ExecutionConfiguration> exec_conf,
                            std::shared_ptr<DomainDecomposition> decomposition)
     : m_exec_conf(exec_conf), m_nparticles(0), m_nghosts(0), m_max_nparticles(0), m_nglobal(0),
-      m_accel_set(false), m_resize_factor(9. / 8.), m_arrays_allocated(false)
+      m_accel_set(false), m_resize_factor(9. / 8.), m_shrink_fraction(0),
+      m_arrays_allocated(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing ParticleData" << endl;
 
@@ -232,11 +235,13 @@ void ParticleData::setGlobalBox(const std::shared_ptr<const BoxDim> box)
     }
 
 /*! \param box New box dimensions to set
+    \param minor_change True when the caller deforms the box slightly and affinely, so that
+        subscribers may reuse their data structures (see isMinorBoxChange())
     \note ParticleData does NOT enforce any boundary conditions. When a new box is set,
         it is the responsibility of the caller to ensure that all particles lie within
         the new box.
 */
-void ParticleData::setGlobalBox(const BoxDim& box)
+void ParticleData::setGlobalBox(const BoxDim& box, bool minor_change)
     {
     assert(box.getPeriodic().x);
     assert(box.getPeriodic().y);
@@ -257,7 +262,9 @@ void ParticleData::setGlobalBox(const BoxDim& box)
         m_box = m_global_box;
         }
 
+    m_box_change_is_minor = minor_change;
     m_boxchange_signal.emit();
+    m_box_change_is_minor = false;
     }
 
 /*! \return Global simulation box dimensions
@@ -273,8 +280,10 @@ const BoxDim ParticleData::getGlobalBox() const
 
 /*! \b ANY time particles are rearranged in memory, this function must be called.
     \note The call must be made after calling release()
+    \param permutation True when the sort only reordered the local particles, so that the set of
+    local particles and their number are unchanged
 */
-void ParticleData::notifyParticleSort()
+void ParticleData::notifyParticleSort(bool permutation)
     {
 #ifdef ENABLE_HIP
     if (m_exec_conf->isCUDAEnabled())
@@ -287,7 +296,12 @@ void ParticleData::notifyParticleSort()
         }
 #endif
 
+    m_pos_soa.valid = false;
+    m_vel_soa.valid = false;
+
+    m_sort_is_permutation = permutation;
     m_sort_signal.emit();
+    m_sort_is_permutation = false;
     }
 
 /*! This function is called any time the ghost particles are removed
@@ -718,6 +732,46 @@ void ParticleData::resize(unsigned int new_nparticles)
     m_nparticles = new_nparticles;
     }
 
+/*! \param source Array to mirror
+    \param mirror Mirror to refill
+
+    The x, y, and z components of the local and ghost particles are copied into separate rows. The
+    write count of the source array detects changes made through an ArrayHandle, and sorts and
+    swaps reset the valid flag. The mirror grows with the source array.
+*/
+void ParticleData::updateSoAMirror(const GlobalArray<Scalar4>& source, SoAMirror& mirror)
+    {
+    const unsigned int n = getN() + getNGhosts();
+    if (mirror.valid && mirror.write_count == source.getWriteCount() && mirror.n == n)
+        return;
+
+    if (mirror.data.getHeight() != 3 || mirror.data.getPitch() < source.getNumElements())
+        {
+        GlobalArray<Scalar> data(source.getNumElements(), 3, m_exec_conf);
+        mirror.data.swap(data);
+        }
+
+        {
+        ArrayHandle<Scalar4> h_source(source, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_data(mirror.data, access_location::host, access_mode::overwrite);
+        const size_t pitch = mirror.data.getPitch();
+        Scalar* x = h_data.data;
+        Scalar* y = h_data.data + pitch;
+        Scalar* z = h_data.data + 2 * pitch;
+        for (unsigned int i = 0; i < n; i++)
+            {
+            const Scalar4 v = h_source.data[i];
+            x[i] = v.x;
+            y[i] = v.y;
+            z[i] = v.z;
+            }
+        }
+
+    mirror.write_count = source.getWriteCount();
+    mirror.n = n;
+    mirror.valid = true;
+    }
+
 /*! \param max_n new maximum size of particle data arrays (can be greater or smaller than the
  * current maximum size) To inform classes that allocate arrays for per-particle information of the
  * change of the particle data size, this method issues a m_max_particle_num_signal.emit().
@@ -1059,11 +1113,8 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
                                                    access_location::host,
                                                    access_mode::read);
 
-            const Index3D& di = m_decomposition->getDomainIndexer();
             unsigned int n_ranks = m_exec_conf->getNRanks();
 
-            BoxDim global_box = *m_global_box;
-
             // loop over particles in snapshot, place them into domains
             for (typename std::vector<vec3<Real>>::const_iterator it = snapshot.pos.begin();
                  it != snapshot.pos.end();
@@ -1080,60 +1131,12 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
 
                 // determine domain the particle is placed into
                 Scalar3 pos = vec_to_scalar3(*it);
-                Scalar3 f = m_global_box->makeFraction(pos);
-                int i = int(f.x * ((Scalar)di.getW()));
-                int j = int(f.y * ((Scalar)di.getH()));
-                int k = int(f.z * ((Scalar)di.getD()));
-
-                // wrap particles that are exactly on a boundary
-                // we only need to wrap in the negative direction, since
-                // processor ids are rounded toward zero
-                char3 flags = make_char3(0, 0, 0);
-                if (i == (int)di.getW())
-                    {
-                    i = 0;
-                    flags.x = 1;
-                    }
-
-                if (j == (int)di.getH())
-                    {
-                    j = 0;
-                    flags.y = 1;
-                    }
-
-                if (k == (int)di.getD())
-                    {
-                    k = 0;
-                    flags.z = 1;
-                    }
-
                 int3 img = snapshot.image[snap_idx];
-
-                // only wrap if the particles is on one of the boundaries
-                uchar3 periodic = make_uchar3(flags.x, flags.y, flags.z);
-                global_box.setPeriodic(periodic);
-                global_box.wrap(pos, img, flags);
-
-                // place particle using actual domain fractions, not global box fraction
-                unsigned int rank
-                    = m_decomposition->placeParticle(global_box, pos, h_cart_ranks.data);
+                unsigned int rank = placeParticleInDomain(pos, img, h_cart_ranks.data);
 
                 if (rank >= n_ranks)
                     {
-                    ostringstream s;
-                    s << "init.*: Particle " << snap_idx << " out of bounds." << std::endl;
-                    s << "Cartesian coordinates: " << std::endl;
-                    s << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
-                    s << "Fractional coordinates: " << std::endl;
-                    s << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
-                    Scalar3 lo = m_global_box->getLo();
-                    Scalar3 hi = m_global_box->getHi();
-                    s << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z << ")"
-                      << std::endl;
-                    s << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z << ")"
-                      << std::endl;
-
-                    throw std::runtime_error(s.str());
+                    throwParticleOutOfBounds(snap_idx, vec_to_scalar3(*it));
                     }
 
                 // fill up per-processor data structures
@@ -1351,31 +1354,666 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
     // notify listeners about resorting of local particles
     notifyParticleSort();
 
-    // zero the origin
-    m_origin = make_scalar3(0, 0, 0);
-    m_o_image = make_int3(0, 0, 0);
+    // zero the origin
+    m_origin = make_scalar3(0, 0, 0);
+    m_o_image = make_int3(0, 0, 0);
+
+    unsigned int snapshot_size = snapshot.size;
+
+// Raise an exception if there are any invalid type ids. This is done here (instead of in the
+// loops above) to avoid MPI communication deadlocks when only some ranks have invalid types.
+// As a convenience, broadcast the values needed to evaluate the condition the same on all
+// ranks.
+#ifdef ENABLE_MPI
+    if (m_decomposition)
+        {
+        bcast(max_typeid, 0, m_exec_conf->getMPICommunicator());
+        bcast(snapshot_size, 0, m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    if (snapshot_size != 0 && max_typeid >= m_type_mapping.size())
+        {
+        std::ostringstream s;
+        s << "Particle typeid " << max_typeid << " is invalid in a system with "
+          << m_type_mapping.size() << " types.";
+        throw std::runtime_error(s.str());
+        }
+    }
+
+#ifdef ENABLE_MPI
+/*! \param pos Position of the particle
+    \param img Image of the particle
+    \param h_cart_ranks Map from cartesian domain index to rank
+
+    \returns The rank that owns the particle, or a value greater than or equal to the number of
+    ranks when the particle is outside the box.
+
+    Particles that are exactly on the upper boundary of the box are wrapped to the lower boundary
+    and \a pos and \a img are updated accordingly.
+*/
+unsigned int ParticleData::placeParticleInDomain(Scalar3& pos,
+                                                 int3& img,
+                                                 const unsigned int* h_cart_ranks) const
+    {
+    const Index3D& di = m_decomposition->getDomainIndexer();
+    BoxDim global_box = *m_global_box;
+
+    Scalar3 f = m_global_box->makeFraction(pos);
+    int i = int(f.x * ((Scalar)di.getW()));
+    int j = int(f.y * ((Scalar)di.getH()));
+    int k = int(f.z * ((Scalar)di.getD()));
+
+    // wrap particles that are exactly on a boundary
+    // we only need to wrap in the negative direction, since
+    // processor ids are rounded toward zero
+    char3 flags = make_char3(0, 0, 0);
+    if (i == (int)di.getW())
+        {
+        flags.x = 1;
+        }
+
+    if (j == (int)di.getH())
+        {
+        flags.y = 1;
+        }
+
+    if (k == (int)di.getD())
+        {
+        flags.z = 1;
+        }
+
+    // only wrap if the particles is on one of the boundaries
+    uchar3 periodic = make_uchar3(flags.x, flags.y, flags.z);
+    global_box.setPeriodic(periodic);
+    global_box.wrap(pos, img, flags);
+
+    // place particle using actual domain fractions, not global box fraction
+    return m_decomposition->placeParticle(global_box, pos, h_cart_ranks);
+    }
+
+/*! \param tag Tag of the particle
+    \param pos Position of the particle
+*/
+void ParticleData::throwParticleOutOfBounds(unsigned int tag, Scalar3 pos) const
+    {
+    Scalar3 f = m_global_box->makeFraction(pos);
+    ostringstream s;
+    s << "init.*: Particle " << tag << " out of bounds." << std::endl;
+    s << "Cartesian coordinates: " << std::endl;
+    s << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
+    s << "Fractional coordinates: " << std::endl;
+    s << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
+    Scalar3 lo = m_global_box->getLo();
+    Scalar3 hi = m_global_box->getHi();
+    s << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z << ")" << std::endl;
+    s << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z << ")" << std::endl;
+
+    throw std::runtime_error(s.str());
+    }
+
+/*! \param snapshot The particles read by this rank
+    \param first_tag Tag of the first particle in \a snapshot
+    \param nglobal Total number of particles on all ranks
+
+    Initialize the particle data when each rank holds a contiguous range of the particles in tag
+    order. Unlike initializeFromSnapshot(), no rank holds the whole system. Each rank determines
+    the domain of each of its particles and sends them directly to the owning rank with an
+    all-to-all exchange.
+
+    \pre The local box size must be set and \a snapshot.type_mapping must be valid on all ranks.
+    \note This method must be called collectively on all ranks.
+*/
+template<class Real>
+void ParticleData::initializeFromDistributedSnapshot(const SnapshotParticleData<Real>& snapshot,
+                                                     unsigned int first_tag,
+                                                     unsigned int nglobal)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: initializing from distributed snapshot"
+                                << std::endl;
+
+    if (!m_decomposition)
+        {
+        throw std::runtime_error("Distributed initialization requires a domain decomposition.");
+        }
+
+    snapshot.validate();
+
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    unsigned int n_ranks = m_exec_conf->getNRanks();
+
+    // sort the local particles by destination rank
+    std::vector<std::vector<detail::pdata_element>> send_proc(n_ranks);
+    unsigned int max_typeid = 0;
+        {
+        ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(),
+                                               access_location::host,
+                                               access_mode::read);
+
+        for (unsigned int snap_idx = 0; snap_idx < snapshot.size; snap_idx++)
+            {
+            Scalar3 pos = vec_to_scalar3(snapshot.pos[snap_idx]);
+            int3 img = snapshot.image[snap_idx];
+            unsigned int rank = placeParticleInDomain(pos, img, h_cart_ranks.data);
+
+            if (rank >= n_ranks)
+                {
+                throwParticleOutOfBounds(first_tag + snap_idx,
+                                         vec_to_scalar3(snapshot.pos[snap_idx]));
+                }
+
+            detail::pdata_element p;
+            memset(&p, 0, sizeof(detail::pdata_element));
+            p.pos = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(snapshot.type[snap_idx]));
+            p.vel = make_scalar4(snapshot.vel[snap_idx].x,
+                                 snapshot.vel[snap_idx].y,
+                                 snapshot.vel[snap_idx].z,
+                                 snapshot.mass[snap_idx]);
+            p.accel = vec_to_scalar3(snapshot.accel[snap_idx]);
+            p.charge = snapshot.charge[snap_idx];
+            p.diameter = snapshot.diameter[snap_idx];
+            p.image = img;
+            p.body = snapshot.body[snap_idx];
+            p.orientation = quat_to_scalar4(snapshot.orientation[snap_idx]);
+            p.angmom = quat_to_scalar4(snapshot.angmom[snap_idx]);
+            p.inertia = vec_to_scalar3(snapshot.inertia[snap_idx]);
+            p.tag = first_tag + snap_idx;
+            send_proc[rank].push_back(p);
+
+            max_typeid = std::max(max_typeid, snapshot.type[snap_idx]);
+            }
+        }
+
+    // exchange the particles, counts and displacements are in elements
+    std::vector<int> send_counts(n_ranks), send_displs(n_ranks);
+    std::vector<int> recv_counts(n_ranks), recv_displs(n_ranks);
+    std::vector<detail::pdata_element> send_buf;
+    for (unsigned int rank = 0; rank < n_ranks; rank++)
+        {
+        send_displs[rank] = int(send_buf.size());
+        send_counts[rank] = int(send_proc[rank].size());
+        send_buf.insert(send_buf.end(), send_proc[rank].begin(), send_proc[rank].end());
+        std::vector<detail::pdata_element>().swap(send_proc[rank]);
+        }
+
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, mpi_comm);
+
+    size_t n_recv = 0;
+    for (unsigned int rank = 0; rank < n_ranks; rank++)
+        {
+        recv_displs[rank] = int(n_recv);
+        n_recv += recv_counts[rank];
+        }
+
+    MPI_Datatype mpi_pdata_element;
+    MPI_Type_contiguous(int(sizeof(detail::pdata_element)), MPI_BYTE, &mpi_pdata_element);
+    MPI_Type_commit(&mpi_pdata_element);
+
+    std::vector<detail::pdata_element> recv_buf(n_recv);
+    MPI_Alltoallv(send_buf.data(),
+                  send_counts.data(),
+                  send_displs.data(),
+                  mpi_pdata_element,
+                  recv_buf.data(),
+                  recv_counts.data(),
+                  recv_displs.data(),
+                  mpi_pdata_element,
+                  mpi_comm);
+    MPI_Type_free(&mpi_pdata_element);
+    std::vector<detail::pdata_element>().swap(send_buf);
+
+    // remove all existing particles
+    removeAllGhostParticles();
+    m_tag_set.clear();
+    while (!m_recycled_tags.empty())
+        m_recycled_tags.pop();
+    m_nparticles = 0;
+
+    m_type_mapping = snapshot.type_mapping;
+
+    m_rtag.resize(nglobal);
+        {
+        ArrayHandle<unsigned int> h_rtag(getRTags(),
+                                         access_location::host,
+                                         access_mode::overwrite);
+        for (unsigned int tag = 0; tag < nglobal; tag++)
+            h_rtag.data[tag] = NOT_LOCAL;
+        }
+
+    for (unsigned int tag = 0; tag < nglobal; tag++)
+        {
+        m_tag_set.insert(tag);
+        }
+    m_invalid_cached_tags = true;
+
+    // add the received particles, this also sets the reverse lookup tags
+    addParticles(recv_buf);
+
+    unsigned int accel_set = snapshot.is_accel_set;
+    MPI_Allreduce(MPI_IN_PLACE, &accel_set, 1, MPI_UNSIGNED, MPI_MAX, mpi_comm);
+    m_accel_set = accel_set != 0;
+
+    setNGlobal(nglobal);
+
+    // zero the origin
+    m_origin = make_scalar3(0, 0, 0);
+    m_o_image = make_int3(0, 0, 0);
+
+    MPI_Allreduce(MPI_IN_PLACE, &max_typeid, 1, MPI_UNSIGNED, MPI_MAX, mpi_comm);
+    if (nglobal != 0 && max_typeid >= m_type_mapping.size())
+        {
+        std::ostringstream s;
+        s << "Particle typeid " << max_typeid << " is invalid in a system with "
+          << m_type_mapping.size() << " types.";
+        throw std::runtime_error(s.str());
+        }
+    }
+#endif
+
+/*! \param snapshot This rank's slice of the particles, in tag order
+
+    Initialize the particle data from a snapshot taken by takeDistributedSnapshot(), or any
+    snapshot where each rank holds a contiguous range of the particles in tag order and the ranges
+    are in rank order. The first tag and the global number of particles follow from the sizes of
+    the slices. Without a domain decomposition, the snapshot must hold all particles.
+
+    \note This method must be called collectively on all ranks.
+*/
+template<class Real>
+void ParticleData::initializeFromDistributedSnapshot(const SnapshotParticleData<Real>& snapshot)
+    {
+#ifdef ENABLE_MPI
+    if (m_decomposition)
+        {
+        const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        unsigned int n_local = snapshot.size;
+        unsigned int first_tag = 0;
+        MPI_Exscan(&n_local, &first_tag, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+        if (m_exec_conf->getRank() == 0)
+            first_tag = 0;
+
+        unsigned int nglobal = 0;
+        MPI_Allreduce(&n_local, &nglobal, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+
+        initializeFromDistributedSnapshot(snapshot, first_tag, nglobal);
+        return;
+        }
+#endif
+
+    initializeFromSnapshot(snapshot);
+    }
+
+/*! \param unit_cell Particles in the unit cell, present on all ranks
+    \param unit_box Box of the unit cell
+    \param nx Number of unit cells along the first box vector
+    \param ny Number of unit cells along the second box vector
+    \param nz Number of unit cells along the third box vector
+
+    Initialize the particle data with the same particles, tags, and positions as
+    SnapshotParticleData::replicate() without building the replicated snapshot. Each rank places
+    only the replicas in its own domain. Along each direction, the replicas of a unit cell particle
+    that can fall in the domain follow from the fractional bounds of the domain, so the work on
+    each rank is proportional to its number of particles. No particles are communicated.
+
+    \pre The global box must be the unit box replicated nx, ny, and nz times.
+    \note This method must be called collectively on all ranks.
+*/
+template<class Real>
+void ParticleData::initializeReplicated(const SnapshotParticleData<Real>& unit_cell,
+                                        const BoxDim& unit_box,
+                                        unsigned int nx,
+                                        unsigned int ny,
+                                        unsigned int nz)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: initializing replicated unit cell" << std::endl;
+
+    unit_cell.validate();
+
+    const unsigned int n_unit = unit_cell.size;
+    const uint64_t n_images = uint64_t(nx) * ny * nz;
+    if (n_images == 0 || uint64_t(n_unit) * n_images > uint64_t(NOT_LOCAL - 1))
+        {
+        throw std::runtime_error("Invalid number of replicas.");
+        }
+    const unsigned int nglobal = (unsigned int)(n_unit * n_images);
+
+    for (unsigned int i = 0; i < n_unit; i++)
+        {
+        if (unit_cell.body[i] != NO_BODY && unit_cell.body[i] < MIN_FLOPPY
+            && uint64_t(n_unit) * (n_images - 1) + unit_cell.body[i] >= MIN_FLOPPY)
+            {
+            throw std::runtime_error("Replication would create more distinct rigid "
+                                     "bodies than HOOMD supports!");
+            }
+        }
+
+    const BoxDim global_box = *m_global_box;
+    Scalar3 frac_lo = make_scalar3(0, 0, 0);
+    Scalar3 frac_hi = make_scalar3(1, 1, 1);
+#ifdef ENABLE_MPI
+    unsigned int my_rank = m_exec_conf->getRank();
+    if (m_decomposition)
+        {
+        uint3 grid_pos = m_decomposition->getGridPos();
+        frac_lo = make_scalar3(m_decomposition->getCumulativeFraction(0, grid_pos.x),
+                               m_decomposition->getCumulativeFraction(1, grid_pos.y),
+                               m_decomposition->getCumulativeFraction(2, grid_pos.z));
+        frac_hi = make_scalar3(m_decomposition->getCumulativeFraction(0, grid_pos.x + 1),
+                               m_decomposition->getCumulativeFraction(1, grid_pos.y + 1),
+                               m_decomposition->getCumulativeFraction(2, grid_pos.z + 1));
+        }
+#endif
+
+    // Replica indices l along a direction with n replicas such that the fraction (f + l) / n of a
+    // particle at the unit cell fraction f, wrapped into [0, 1), may be in [lo, hi). The range
+    // is widened by one replica on each side so that rounding never drops a particle.
+    auto candidates = [](Scalar f, Scalar lo, Scalar hi, unsigned int n)
+    {
+        std::vector<unsigned int> result;
+        long first = long(std::floor(lo * Scalar(n) - f)) - 1;
+        long last = long(std::ceil(hi * Scalar(n) - f)) + 1;
+        if (last - first + 1 >= long(n))
+            {
+            first = 0;
+            last = long(n) - 1;
+            }
+        for (long l = first; l <= last; l++)
+            {
+            result.push_back((unsigned int)(((l % long(n)) + long(n)) % long(n)));
+            }
+        return result;
+    };
+
+    struct replica
+        {
+        unsigned int unit_idx; //!< Index of the particle in the unit cell
+        unsigned int tag;      //!< Tag of the replica
+        Scalar3 pos;           //!< Wrapped position in the global box
+        int3 image;            //!< Image in the global box
+        };
+    std::vector<replica> local;
+    unsigned int max_typeid = 0;
+
+        {
+#ifdef ENABLE_MPI
+        std::unique_ptr<ArrayHandle<unsigned int>> h_cart_ranks;
+        if (m_decomposition)
+            {
+            h_cart_ranks.reset(new ArrayHandle<unsigned int>(m_decomposition->getCartRanks(),
+                                                             access_location::host,
+                                                             access_mode::read));
+            }
+#endif
+
+        for (unsigned int i = 0; i < n_unit; i++)
+            {
+            max_typeid = std::max(max_typeid, unit_cell.type[i]);
+
+            // unwrap the position of particle i in the unit box using its image
+            Scalar3 p = unit_box.shift(vec_to_scalar3(unit_cell.pos[i]), unit_cell.image[i]);
+            Scalar3 f = unit_box.makeFraction(p);
+
+            const std::vector<unsigned int> ls = candidates(f.x, frac_lo.x, frac_hi.x, nx);
+            const std::vector<unsigned int> ms = candidates(f.y, frac_lo.y, frac_hi.y, ny);
+            const std::vector<unsigned int> ns = candidates(f.z, frac_lo.z, frac_hi.z, nz);
+            for (unsigned int l : ls)
+                for (unsigned int m : ms)
+                    for (unsigned int n : ns)
+                        {
+                        // place the replica as SnapshotParticleData::replicate does
+                        Scalar3 f_new;
+                        f_new.x = f.x / Scalar(nx) + Scalar(l) / Scalar(nx);
+                        f_new.y = f.y / Scalar(ny) + Scalar(m) / Scalar(ny);
+                        f_new.z = f.z / Scalar(nz) + Scalar(n) / Scalar(nz);
+
+                        Scalar3 q = global_box.makeCoordinates(f_new);
+                        int3 img = global_box.getImage(q);
+                        q = global_box.shift(q, make_int3(-img.x, -img.y, -img.z));
+                        global_box.wrap(q, img);
+
+#ifdef ENABLE_MPI
+                        if (m_decomposition
+                            && placeParticleInDomain(q, img, h_cart_ranks->data) != my_rank)
+                            {
+                            continue;
+                            }
+#endif
+
+                        unsigned int j = (l * ny + m) * nz + n;
+                        local.push_back(replica {i, j * n_unit + i, q, img});
+                        }
+            }
+        }
+
+    // remove all existing particles
+    removeAllGhostParticles();
+    m_tag_set.clear();
+    while (!m_recycled_tags.empty())
+        m_recycled_tags.pop();
+
+    m_type_mapping = unit_cell.type_mapping;
+    m_nparticles = (unsigned int)local.size();
+    resize(m_nparticles);
+
+    m_rtag.resize(nglobal);
+        {
+        ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_accel(m_accel, access_location::host, access_mode::overwrite);
+        ArrayHandle<int3> h_image(m_image, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_charge(m_charge, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_diameter(m_diameter, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_body(m_body, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_orientation(m_orientation,
+                                           access_location::host,
+                                           access_mode::overwrite);
+        ArrayHandle<Scalar4> h_angmom(m_angmom, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_inertia(m_inertia, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_comm_flag(m_comm_flags,
+                                              access_location::host,
+                                              access_mode::overwrite);
+        ArrayHandle<unsigned int> h_rtag(m_rtag, access_location::host, access_mode::overwrite);
+
+        for (unsigned int tag = 0; tag < nglobal; tag++)
+            h_rtag.data[tag] = NOT_LOCAL;
+
+        for (unsigned int idx = 0; idx < m_nparticles; idx++)
+            {
+            const replica& r = local[idx];
+            const unsigned int i = r.unit_idx;
+            h_pos.data[idx]
+                = make_scalar4(r.pos.x, r.pos.y, r.pos.z, __int_as_scalar(unit_cell.type[i]));
+            h_vel.data[idx] = make_scalar4(unit_cell.vel[i].x,
+                                           unit_cell.vel[i].y,
+                                           unit_cell.vel[i].z,
+                                           unit_cell.mass[i]);
+            h_accel.data[idx] = vec_to_scalar3(unit_cell.accel[i]);
+            h_charge.data[idx] = unit_cell.charge[i];
+            h_diameter.data[idx] = unit_cell.diameter[i];
+            h_image.data[idx] = r.image;
+            h_body.data[idx]
+                = unit_cell.body[i] != NO_BODY ? r.tag - i + unit_cell.body[i] : NO_BODY;
+            h_orientation.data[idx] = quat_to_scalar4(unit_cell.orientation[i]);
+            h_angmom.data[idx] = quat_to_scalar4(unit_cell.angmom[i]);
+            h_inertia.data[idx] = vec_to_scalar3(unit_cell.inertia[i]);
+            h_tag.data[idx] = r.tag;
+            h_rtag.data[r.tag] = idx;
+            h_comm_flag.data[idx] = 0;
+            }
+        }
+
+    for (unsigned int tag = 0; tag < nglobal; tag++)
+        {
+        m_tag_set.insert(m_tag_set.end(), tag);
+        }
+    m_invalid_cached_tags = true;
+
+    m_accel_set = unit_cell.is_accel_set;
+    setNGlobal(nglobal);
+    notifyParticleSort();
+
+    // zero the origin
+    m_origin = make_scalar3(0, 0, 0);
+    m_o_image = make_int3(0, 0, 0);
+
+    // every replica must be placed on exactly one rank
+    unsigned int n_placed = m_nparticles;
+#ifdef ENABLE_MPI
+    if (m_decomposition)
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &n_placed,
+                      1,
+                      MPI_UNSIGNED,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+    if (n_placed != nglobal)
+        {
+        throw std::runtime_error("Replicated particles are outside the box.");
+        }
+
+    if (n_unit != 0 && max_typeid >= m_type_mapping.size())
+        {
+        std::ostringstream s;
+        s << "Particle typeid " << max_typeid << " is invalid in a system with "
+          << m_type_mapping.size() << " types.";
+        throw std::runtime_error(s.str());
+        }
+    }
+
+/*! \param buffer Buffer to append to
+
+    Append the local particles (without ghosts) in their current order, with all of the per-particle
+    quantities that are not recomputed on the next step, followed by the global tag bookkeeping.
+    readCheckpoint() restores exactly this state on the same rank.
+*/
+void ParticleData::writeCheckpoint(detail::CheckpointBuffer& buffer)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: writing checkpoint" << std::endl;
+
+    ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_accel(m_accel, access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_image, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_charge, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_diameter, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_body, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_orientation, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_angmom(m_angmom, access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_inertia(m_inertia, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::read);
+
+    const unsigned int N = m_nparticles;
+    buffer.write(N);
+    buffer.write(h_pos.data, N);
+    buffer.write(h_vel.data, N);
+    buffer.write(h_accel.data, N);
+    buffer.write(h_image.data, N);
+    buffer.write(h_charge.data, N);
+    buffer.write(h_diameter.data, N);
+    buffer.write(h_body.data, N);
+    buffer.write(h_orientation.data, N);
+    buffer.write(h_angmom.data, N);
+    buffer.write(h_inertia.data, N);
+    buffer.write(h_tag.data, N);
+
+    buffer.write(m_accel_set);
+    buffer.write(m_origin);
+    buffer.write(m_o_image);
+    buffer.write(getNGlobal());
+    buffer.writeTags(m_tag_set, m_recycled_tags, m_rtag.size());
+    }
+
+/*! \param buffer Buffer to read from, positioned at the data appended by writeCheckpoint()
+
+    Replace the local particles by the particles in the checkpoint. The global box, the domain
+    decomposition, and the particle types must already match those of the checkpointed system.
+
+    \note This method must be called collectively on all ranks.
+*/
+void ParticleData::readCheckpoint(detail::CheckpointBuffer& buffer)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: reading checkpoint" << std::endl;
+
+    removeAllGhostParticles();
+
+    m_nparticles = buffer.read<unsigned int>();
+    resize(m_nparticles);
+
+    const unsigned int N = m_nparticles;
+    unsigned int max_typeid = 0;
+        {
+        ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_accel(m_accel, access_location::host, access_mode::overwrite);
+        ArrayHandle<int3> h_image(m_image, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_charge(m_charge, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_diameter(m_diameter, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_body(m_body, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_orientation(m_orientation,
+                                           access_location::host,
+                                           access_mode::overwrite);
+        ArrayHandle<Scalar4> h_angmom(m_angmom, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_inertia(m_inertia, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_comm_flag(m_comm_flags,
+                                              access_location::host,
+                                              access_mode::overwrite);
+
+        buffer.read(h_pos.data, N);
+        buffer.read(h_vel.data, N);
+        buffer.read(h_accel.data, N);
+        buffer.read(h_image.data, N);
+        buffer.read(h_charge.data, N);
+        buffer.read(h_diameter.data, N);
+        buffer.read(h_body.data, N);
+        buffer.read(h_orientation.data, N);
+        buffer.read(h_angmom.data, N);
+        buffer.read(h_inertia.data, N);
+        buffer.read(h_tag.data, N);
+
+        for (unsigned int idx = 0; idx < N; idx++)
+            {
+            max_typeid = std::max(max_typeid, (unsigned int)__scalar_as_int(h_pos.data[idx].w));
+            h_comm_flag.data[idx] = 0;
+            }
+        }
 
-    unsigned int snapshot_size = snapshot.size;
+    m_accel_set = buffer.read<bool>();
+    m_origin = buffer.read<Scalar3>();
+    m_o_image = buffer.read<int3>();
+    const unsigned int nglobal = buffer.read<unsigned int>();
+    const size_t n_tags = buffer.readTags(m_tag_set, m_recycled_tags);
 
-// Raise an exception if there are any invalid type ids. This is done here (instead of in the
-// loops above) to avoid MPI communication deadlocks when only some ranks have invalid types.
-// As a convenience, broadcast the values needed to evaluate the condition the same on all
-// ranks.
-#ifdef ENABLE_MPI
-    if (m_decomposition)
+    m_rtag.resize(n_tags);
         {
-        bcast(max_typeid, 0, m_exec_conf->getMPICommunicator());
-        bcast(snapshot_size, 0, m_exec_conf->getMPICommunicator());
+        ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(m_rtag, access_location::host, access_mode::overwrite);
+        std::fill(h_rtag.data, h_rtag.data + n_tags, NOT_LOCAL);
+        for (unsigned int idx = 0; idx < N; idx++)
+            {
+            if (h_tag.data[idx] >= n_tags)
+                {
+                throw std::runtime_error("Invalid particle tag in checkpoint.");
+                }
+            h_rtag.data[h_tag.data[idx]] = idx;
+            }
         }
-#endif
+    m_invalid_cached_tags = true;
 
-    if (snapshot_size != 0 && max_typeid >= m_type_mapping.size())
+    if (N != 0 && max_typeid >= m_type_mapping.size())
         {
         std::ostringstream s;
         s << "Particle typeid " << max_typeid << " is invalid in a system with "
           << m_type_mapping.size() << " types.";
         throw std::runtime_error(s.str());
         }
+
+    setNGlobal(nglobal);
+    notifyParticleSort();
     }
 
 //! take a particle data snapshot
@@ -1616,6 +2254,163 @@ template<class Real> void ParticleData::takeSnapshot(SnapshotParticleData<Real>&
     snapshot.is_accel_set = m_accel_set;
     }
 
+/*! \param snapshot The snapshot to write this rank's slice of the particles to
+    \returns Index of the first particle of \a snapshot in the tag order of all particles
+
+    Take a snapshot where each rank holds a contiguous range of the particles in tag order. Unlike
+    takeSnapshot(), no rank holds the whole system. The tags are split into equal, contiguous
+    ranges, one per rank, and each rank sends its particles directly to the rank that holds their
+    tag with an all-to-all exchange. Within a rank, the particles are sorted by tag. The returned
+    offsets are suitable for initializeFromDistributedSnapshot() and for writing each slice to its
+    rows of a shared file.
+
+    Without a domain decomposition, the snapshot holds all particles, as in takeSnapshot().
+
+    \note This method must be called collectively on all ranks.
+*/
+template<class Real>
+unsigned int ParticleData::takeDistributedSnapshot(SnapshotParticleData<Real>& snapshot)
+    {
+#ifdef ENABLE_MPI
+    if (!m_decomposition)
+#endif
+        {
+        takeSnapshot(snapshot);
+        return 0;
+        }
+
+#ifdef ENABLE_MPI
+    m_exec_conf->msg->notice(4) << "ParticleData: taking distributed snapshot" << std::endl;
+
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    const unsigned int n_ranks = m_exec_conf->getNRanks();
+    const uint64_t n_tags = getNGlobal() ? uint64_t(getMaximumTag()) + 1 : 0;
+
+    // sort the local particles by the rank that holds their tag
+    std::vector<std::vector<detail::pdata_element>> send_proc(n_ranks);
+        {
+        ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_accel(m_accel, access_location::host, access_mode::read);
+        ArrayHandle<int3> h_image(m_image, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_charge(m_charge, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_diameter(m_diameter, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_body, access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_orientation,
+                                           access_location::host,
+                                           access_mode::read);
+        ArrayHandle<Scalar4> h_angmom(m_angmom, access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_inertia(m_inertia, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::read);
+
+        for (unsigned int idx = 0; idx < m_nparticles; idx++)
+            {
+            detail::pdata_element p;
+            memset(&p, 0, sizeof(detail::pdata_element));
+            const Scalar3 pos
+                = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - m_origin;
+            p.pos = make_scalar4(pos.x, pos.y, pos.z, h_pos.data[idx].w);
+            p.vel = h_vel.data[idx];
+            p.accel = h_accel.data[idx];
+            p.charge = h_charge.data[idx];
+            p.diameter = h_diameter.data[idx];
+            p.image = make_int3(h_image.data[idx].x - m_o_image.x,
+                                h_image.data[idx].y - m_o_image.y,
+                                h_image.data[idx].z - m_o_image.z);
+            p.body = h_body.data[idx];
+            p.orientation = h_orientation.data[idx];
+            p.angmom = h_angmom.data[idx];
+            p.inertia = h_inertia.data[idx];
+            p.tag = h_tag.data[idx];
+
+            // rank r holds the tags [n_tags * r / n_ranks, n_tags * (r + 1) / n_ranks)
+            const unsigned int rank
+                = (unsigned int)(((uint64_t(p.tag) + 1) * n_ranks - 1) / n_tags);
+            send_proc[rank].push_back(p);
+            }
+        }
+
+    // exchange the particles, counts and displacements are in elements
+    std::vector<int> send_counts(n_ranks), send_displs(n_ranks);
+    std::vector<int> recv_counts(n_ranks), recv_displs(n_ranks);
+    std::vector<detail::pdata_element> send_buf;
+    for (unsigned int rank = 0; rank < n_ranks; rank++)
+        {
+        send_displs[rank] = int(send_buf.size());
+        send_counts[rank] = int(send_proc[rank].size());
+        send_buf.insert(send_buf.end(), send_proc[rank].begin(), send_proc[rank].end());
+        std::vector<detail::pdata_element>().swap(send_proc[rank]);
+        }
+
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, mpi_comm);
+
+    size_t n_recv = 0;
+    for (unsigned int rank = 0; rank < n_ranks; rank++)
+        {
+        recv_displs[rank] = int(n_recv);
+        n_recv += recv_counts[rank];
+        }
+
+    MPI_Datatype mpi_pdata_element;
+    MPI_Type_contiguous(int(sizeof(detail::pdata_element)), MPI_BYTE, &mpi_pdata_element);
+    MPI_Type_commit(&mpi_pdata_element);
+
+    std::vector<detail::pdata_element> recv_buf(n_recv);
+    MPI_Alltoallv(send_buf.data(),
+                  send_counts.data(),
+                  send_displs.data(),
+                  mpi_pdata_element,
+                  recv_buf.data(),
+                  recv_counts.data(),
+                  recv_displs.data(),
+                  mpi_pdata_element,
+                  mpi_comm);
+    MPI_Type_free(&mpi_pdata_element);
+    std::vector<detail::pdata_element>().swap(send_buf);
+
+    std::sort(recv_buf.begin(),
+              recv_buf.end(),
+              [](const detail::pdata_element& a, const detail::pdata_element& b)
+              { return a.tag < b.tag; });
+
+    snapshot.resize((unsigned int)n_recv);
+    for (unsigned int snap_id = 0; snap_id < n_recv; snap_id++)
+        {
+        const detail::pdata_element& p = recv_buf[snap_id];
+
+        // make sure the position stored in the snapshot is within the boundaries
+        Scalar3 pos = make_scalar3(p.pos.x, p.pos.y, p.pos.z);
+        int3 image = p.image;
+        m_global_box->wrap(pos, image);
+
+        snapshot.pos[snap_id] = vec3<Real>(pos);
+        snapshot.vel[snap_id] = vec3<Real>(make_scalar3(p.vel.x, p.vel.y, p.vel.z));
+        snapshot.accel[snap_id] = vec3<Real>(p.accel);
+        snapshot.type[snap_id] = __scalar_as_int(p.pos.w);
+        snapshot.mass[snap_id] = Real(p.vel.w);
+        snapshot.charge[snap_id] = Real(p.charge);
+        snapshot.diameter[snap_id] = Real(p.diameter);
+        snapshot.image[snap_id] = image;
+        snapshot.body[snap_id] = p.body;
+        snapshot.orientation[snap_id] = quat<Real>(p.orientation);
+        snapshot.angmom[snap_id] = quat<Real>(p.angmom);
+        snapshot.inertia[snap_id] = vec3<Real>(p.inertia);
+        }
+
+    snapshot.type_mapping = m_type_mapping;
+    snapshot.is_accel_set = m_accel_set;
+
+    // the slices are in rank order
+    unsigned int n_local = (unsigned int)n_recv;
+    unsigned int offset = 0;
+    MPI_Exscan(&n_local, &offset, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+    if (m_exec_conf->getRank() == 0)
+        offset = 0;
+
+    return offset;
+#endif
+    }
+
 //! Add ghost particles at the end of the local particle data
 /*! Ghost ptls are appended at the end of the particle data.
   Ghost particles have only incomplete particle information (position, charge, diameter) and
@@ -1643,6 +2438,42 @@ void ParticleData::addGhostParticles(const unsigned int nghosts)
         }
     }
 
+/*! \param shrink_fraction Fraction of the allocated size below which the arrays shrink
+
+    A fraction of 0 disables shrinking. The fraction must be smaller than the inverse of the resize
+    factor, so that the arrays do not shrink again right after they grow.
+*/
+void ParticleData::setShrinkFraction(Scalar shrink_fraction)
+    {
+    if (shrink_fraction < Scalar(0.0) || shrink_fraction * m_resize_factor >= Scalar(1.0))
+        {
+        std::ostringstream s;
+        s << "Shrink fraction must be in the range [0, " << 1.0 / m_resize_factor << ").";
+        throw std::runtime_error(s.str());
+        }
+    m_shrink_fraction = shrink_fraction;
+    }
+
+/*! When the local and ghost particles fill less than the shrink fraction of the allocated
+    arrays, the arrays are reallocated to the resize factor times the number of particles. The gap
+    between the two sizes is the hysteresis that keeps the arrays from growing and shrinking on
+    every step.
+
+    Call shrink() after the ghost particles have been added, so that they do not immediately grow
+    the arrays again.
+*/
+void ParticleData::shrink()
+    {
+    if (m_shrink_fraction == Scalar(0.0) || !m_arrays_allocated)
+        return;
+
+    const unsigned int n = std::max(m_nparticles + m_nghosts, 1u);
+    if (Scalar(n) < m_shrink_fraction * Scalar(m_max_nparticles))
+        {
+        reallocate(((unsigned int)(((float)n) * m_resize_factor)) + 1);
+        }
+    }
+
 #ifdef ENABLE_MPI
 //! Find the processor that owns a particle
 /*! \param tag Tag of the particle to search
@@ -2354,6 +3185,8 @@ void ParticleData::setType(unsigned int tag, unsigned int typ)
         // signal that the types have changed
         notifyParticleSort();
         }
+
+    m_particle_change_signal.emit(tag);
     }
 
 //! Set the orientation of a particle with a given tag
@@ -2412,6 +3245,177 @@ void ParticleData::setMomentsOfInertia(unsigned int tag, const Scalar3& inertia)
         }
     }
 
+/*! \param quantity Name of the property: typeid, charge, mass, diameter, velocity, orientation,
+        angmom, or moment_inertia
+    \param tags Tags of the particles to change
+    \param values New values, one value (or row of components) per tag
+
+    All ranks must pass the same tags and values. Each rank looks up the tags in its reverse tag
+    index and changes only the particles it owns, so no communication is needed. Unlike
+    initializeFromSnapshot(), the arrays are not reallocated and the particles are not
+    redistributed.
+
+    Changes of the type, charge, or diameter force a new ghost exchange and neighbor list build
+    through the particle sort signal, as the ghost particles receive these only in the exchange.
+    Groups that select particles by type update the membership of the retyped particles only. The
+    velocity, mass, and orientation of the ghosts are refreshed by the next ghost update.
+*/
+void ParticleData::updateParticles(
+    const std::string& quantity,
+    pybind11::array_t<unsigned int, pybind11::array::c_style | pybind11::array::forcecast> tags,
+    pybind11::object values)
+    {
+    unsigned int n_components;
+    if (quantity == "typeid" || quantity == "charge" || quantity == "mass"
+        || quantity == "diameter")
+        {
+        n_components = 1;
+        }
+    else if (quantity == "velocity" || quantity == "moment_inertia")
+        {
+        n_components = 3;
+        }
+    else if (quantity == "orientation" || quantity == "angmom")
+        {
+        n_components = 4;
+        }
+    else
+        {
+        throw std::invalid_argument("Cannot update the particle property " + quantity + ".");
+        }
+
+    pybind11::array_t<Scalar, pybind11::array::c_style | pybind11::array::forcecast> scalar_values(
+        values);
+
+    if (tags.ndim() != 1)
+        {
+        throw std::invalid_argument("tags must be a 1D array.");
+        }
+    const size_t n = tags.shape(0);
+    const bool shape_ok = n_components == 1
+                              ? (scalar_values.ndim() == 1 && size_t(scalar_values.shape(0)) == n)
+                              : (scalar_values.ndim() == 2 && size_t(scalar_values.shape(0)) == n
+                                 && size_t(scalar_values.shape(1)) == n_components);
+    if (!shape_ok)
+        {
+        std::ostringstream s;
+        s << quantity << " must have " << n << " rows";
+        if (n_components > 1)
+            s << " of " << n_components << " components";
+        s << ".";
+        throw std::invalid_argument(s.str());
+        }
+
+    const unsigned int* tag_data = tags.data();
+    const Scalar* value_data = scalar_values.data();
+
+    for (size_t i = 0; i < n; i++)
+        {
+        if (tag_data[i] >= m_rtag.size() || !isTagActive(tag_data[i]))
+            {
+            throw std::invalid_argument("Particle tag " + std::to_string(tag_data[i])
+                                        + " does not exist.");
+            }
+        if (quantity == "typeid"
+            && !(value_data[i] >= 0 && value_data[i] < Scalar(getNTypes())
+                 && value_data[i] == Scalar((unsigned int)value_data[i])))
+            {
+            throw std::invalid_argument("Invalid type id for particle tag "
+                                        + std::to_string(tag_data[i]) + ".");
+            }
+        }
+
+    ArrayHandle<unsigned int> h_rtag(m_rtag, access_location::host, access_mode::read);
+    const unsigned int N = getN();
+
+    if (quantity == "typeid")
+        {
+        ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::readwrite);
+        for (size_t i = 0; i < n; i++)
+            {
+            unsigned int idx = h_rtag.data[tag_data[i]];
+            if (idx < N)
+                h_pos.data[idx].w = __int_as_scalar((unsigned int)value_data[i]);
+            }
+        }
+    else if (quantity == "charge" || quantity == "diameter")
+        {
+        ArrayHandle<Scalar> h_values(quantity == "charge" ? m_charge : m_diameter,
+                                     access_location::host,
+                                     access_mode::readwrite);
+        for (size_t i = 0; i < n; i++)
+            {
+            unsigned int idx = h_rtag.data[tag_data[i]];
+            if (idx < N)
+                h_values.data[idx] = value_data[i];
+            }
+        }
+    else if (quantity == "mass" || quantity == "velocity")
+        {
+        ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::readwrite);
+        for (size_t i = 0; i < n; i++)
+            {
+            unsigned int idx = h_rtag.data[tag_data[i]];
+            if (idx >= N)
+                continue;
+
+            const Scalar* v = value_data + i * n_components;
+            if (quantity == "mass")
+                {
+                h_vel.data[idx].w = v[0];
+                }
+            else
+                {
+                h_vel.data[idx].x = v[0];
+                h_vel.data[idx].y = v[1];
+                h_vel.data[idx].z = v[2];
+                }
+            }
+        }
+    else if (quantity == "moment_inertia")
+        {
+        ArrayHandle<Scalar3> h_inertia(m_inertia, access_location::host, access_mode::readwrite);
+        for (size_t i = 0; i < n; i++)
+            {
+            unsigned int idx = h_rtag.data[tag_data[i]];
+            if (idx < N)
+                {
+                const Scalar* v = value_data + i * n_components;
+                h_inertia.data[idx] = make_scalar3(v[0], v[1], v[2]);
+                }
+            }
+        }
+    else
+        {
+        ArrayHandle<Scalar4> h_values(quantity == "orientation" ? m_orientation : m_angmom,
+                                      access_location::host,
+                                      access_mode::readwrite);
+        for (size_t i = 0; i < n; i++)
+            {
+            unsigned int idx = h_rtag.data[tag_data[i]];
+            if (idx < N)
+                {
+                const Scalar* v = value_data + i * n_components;
+                h_values.data[idx] = make_scalar4(v[0], v[1], v[2], v[3]);
+                }
+            }
+        }
+
+    if (n > 0 && (quantity == "typeid" || quantity == "charge" || quantity == "diameter"))
+        {
+        // the set of local particles is unchanged
+        notifyParticleSort(true);
+        }
+
+    if (quantity == "typeid")
+        {
+        for (size_t i = 0; i < n; i++)
+            {
+            m_particle_change_signal.emit(tag_data[i]);
+            }
+        }
+    }
+
 /*!
  * Initialize the particle data with a new particle of given type.
  *
@@ -2530,9 +3534,12 @@ unsigned int ParticleData::addParticle(unsigned int type)
         }
 
     // update global number of particles
+    m_single_particle_change = true;
     setNGlobal(getNGlobal() + 1);
+    m_single_particle_change = false;
 
     // we have added a particle, notify listeners
+    m_particle_change_signal.emit(tag);
     notifyParticleSort();
 
     return tag;
@@ -2659,9 +3666,12 @@ void ParticleData::removeParticle(unsigned int tag)
     m_invalid_cached_tags = true;
 
     // update global particle number
+    m_single_particle_change = true;
     setNGlobal(getNGlobal() - 1);
+    m_single_particle_change = false;
 
     // local particle number may have changed
+    m_particle_change_signal.emit(tag);
     notifyParticleSort();
     }
 
@@ -2746,6 +3756,22 @@ template void
 ParticleData::initializeFromSnapshot<double>(const SnapshotParticleData<double>& snapshot,
                                              bool ignore_bodies);
 template void ParticleData::takeSnapshot<double>(SnapshotParticleData<double>& snapshot);
+template unsigned int
+ParticleData::takeDistributedSnapshot<double>(SnapshotParticleData<double>& snapshot);
+template void ParticleData::initializeFromDistributedSnapshot<double>(
+    const SnapshotParticleData<double>& snapshot);
+template void
+ParticleData::initializeReplicated<double>(const SnapshotParticleData<double>& unit_cell,
+                                     const BoxDim& unit_box,
+                                     unsigned int nx,
+                                     unsigned int ny,
+                                     unsigned int nz);
+#ifdef ENABLE_MPI
+template void ParticleData::initializeFromDistributedSnapshot<double>(
+    const SnapshotParticleData<double>& snapshot,
+    unsigned int first_tag,
+    unsigned int nglobal);
+#endif
 
 template ParticleData::ParticleData(const SnapshotParticleData<float>& snapshot,
                                     const std::shared_ptr<const BoxDim> global_box,
@@ -2755,6 +3781,22 @@ template void
 ParticleData::initializeFromSnapshot<float>(const SnapshotParticleData<float>& snapshot,
                                             bool ignore_bodies);
 template void ParticleData::takeSnapshot<float>(SnapshotParticleData<float>& snapshot);
+template unsigned int
+ParticleData::takeDistributedSnapshot<float>(SnapshotParticleData<float>& snapshot);
+template void ParticleData::initializeFromDistributedSnapshot<float>(
+    const SnapshotParticleData<float>& snapshot);
+template void
+ParticleData::initializeReplicated<float>(const SnapshotParticleData<float>& unit_cell,
+                                     const BoxDim& unit_box,
+                                     unsigned int nx,
+                                     unsigned int ny,
+                                     unsigned int nz);
+#ifdef ENABLE_MPI
+template void ParticleData::initializeFromDistributedSnapshot<float>(
+    const SnapshotParticleData<float>& snapshot,
+    unsigned int first_tag,
+    unsigned int nglobal);
+#endif
 
 namespace detail
     {
@@ -2809,11 +3851,24 @@ void export_ParticleData(pybind11::module& m)
         .def("setOrientation", &ParticleData::setOrientation)
         .def("setAngularMomentum", &ParticleData::setAngularMomentum)
         .def("setMomentsOfInertia", &ParticleData::setMomentsOfInertia)
+        .def("updateParticles", &ParticleData::updateParticles)
         .def("setPressureFlag", &ParticleData::setPressureFlag)
         .def("getMaximumTag", &ParticleData::getMaximumTag)
         .def("addParticle", &ParticleData::addParticle)
         .def("removeParticle", &ParticleData::removeParticle)
         .def("getNthTag", &ParticleData::getNthTag)
+        .def("takeDistributedSnapshot_double",
+             [](ParticleData& pdata)
+             {
+                 auto snapshot = std::make_shared<SnapshotParticleData<double>>();
+                 unsigned int offset = pdata.takeDistributedSnapshot(*snapshot);
+                 return pybind11::make_tuple(snapshot, offset);
+             })
+        .def("initializeFromDistributedSnapshot",
+             static_cast<void (ParticleData::*)(const SnapshotParticleData<double>&)>(
+                 &ParticleData::initializeFromDistributedSnapshot<double>))
+        .def("setShrinkFraction", &ParticleData::setShrinkFraction)
+        .def("getShrinkFraction", &ParticleData::getShrinkFraction)
 #ifdef ENABLE_MPI
         .def("setDomainDecomposition", &ParticleData::setDomainDecomposition)
         .def("getDomainDecomposition", &ParticleData::getDomainDecomposition)
@@ -3202,6 +4257,120 @@ void ParticleData::addParticles(const std::vector<detail::pdata_element>& in)
     notifyParticleSort();
     }
 
+/*! \param remove_tags Tags of local particles to remove
+ *  \param add Particles to add to the local domain, their tags are assigned on output
+ *
+ *  All ranks gather the number of added particles and the removed tags of every rank, and then
+ *  update the global tag bookkeeping in the same order, first all removals and then all additions
+ *  by rank. Tags are therefore recycled identically on every rank, as in removeParticle() and
+ *  addParticle().
+ */
+void ParticleData::removeAndAddParticles(const std::vector<unsigned int>& remove_tags,
+                                         std::vector<detail::pdata_element>& add)
+    {
+    // we are changing the local number of particles, so remove ghosts
+    removeAllGhostParticles();
+
+    // the number of added particles, followed by the removed tags
+    std::vector<unsigned int> local_batch;
+    local_batch.reserve(remove_tags.size() + 1);
+    local_batch.push_back((unsigned int)add.size());
+    local_batch.insert(local_batch.end(), remove_tags.begin(), remove_tags.end());
+
+    std::vector<std::vector<unsigned int>> batches;
+    if (getDomainDecomposition())
+        {
+        all_gather_v(local_batch, batches, m_exec_conf->getMPICommunicator());
+        }
+    else
+        {
+        batches.push_back(local_batch);
+        }
+
+        {
+        // flag the local particles to remove
+        ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_comm_flags(getCommFlags(),
+                                               access_location::host,
+                                               access_mode::readwrite);
+        std::fill(h_comm_flags.data, h_comm_flags.data + getN(), 0);
+        for (unsigned int tag : remove_tags)
+            {
+            unsigned int idx = tag < m_rtag.size() ? h_rtag.data[tag] : NOT_LOCAL;
+            if (idx >= getN())
+                {
+                std::ostringstream s;
+                s << "Trying to remove particle " << tag << " which is not local.";
+                throw runtime_error(s.str());
+                }
+            h_comm_flags.data[idx] = 1;
+            }
+        }
+
+    std::vector<detail::pdata_element> removed;
+    std::vector<unsigned int> removed_comm_flags;
+    removeParticles(removed, removed_comm_flags);
+
+    unsigned int nglobal = getNGlobal();
+    for (const auto& batch : batches)
+        {
+        for (unsigned int k = 1; k < batch.size(); ++k)
+            {
+            // maintain a stack of deleted tags for future recycling
+            m_tag_set.erase(batch[k]);
+            m_recycled_tags.push(batch[k]);
+            nglobal--;
+            }
+        }
+
+    std::vector<unsigned int> new_tags;
+    for (unsigned int rank = 0; rank < batches.size(); ++rank)
+        {
+        for (unsigned int k = 0; k < batches[rank][0]; ++k)
+            {
+            unsigned int tag;
+            if (m_recycled_tags.size())
+                {
+                tag = m_recycled_tags.top();
+                m_recycled_tags.pop();
+                }
+            else
+                {
+                // all tags below the particle number are in use
+                tag = nglobal;
+                }
+            m_tag_set.insert(tag);
+            new_tags.push_back(tag);
+            nglobal++;
+
+            if (rank == m_exec_conf->getRank())
+                {
+                add[k].tag = tag;
+                }
+            }
+        }
+
+    // invalidate the active tag cache
+    m_invalid_cached_tags = true;
+
+    // resize array of global reverse lookup tags
+    m_rtag.resize(getMaximumTag() + 1);
+
+        {
+        // the added particles are not local until addParticles() finds them
+        ArrayHandle<unsigned int> h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+        for (unsigned int tag : new_tags)
+            {
+            h_rtag.data[tag] = NOT_LOCAL;
+            }
+        }
+
+    setNGlobal(nglobal);
+
+    // appends the particles and notifies subscribers of the new order
+    addParticles(add);
+    }
+
 #ifdef ENABLE_HIP
 //! Pack particle data into a buffer (GPU version)
 /*! \note This method may only be used during communication or when
@@ -114,6 +114,8 @@ namespace detail
 /// Get a default type name given a type id
 std::string getDefaultTypeName(unsigned int id);
 
+class CheckpointBuffer;
+
     } // end namespace detail
 
 //! Handy structure for passing around per-particle data
@@ -441,7 +443,13 @@ class PYBIND11_EXPORT ParticleData
     const BoxDim getBox() const;
 
     //! Set the global simulation box
-    void setGlobalBox(const BoxDim& box);
+    void setGlobalBox(const BoxDim& box)
+        {
+        setGlobalBox(box, false);
+        }
+
+    //! Set the global simulation box, optionally notifying a small affine deformation
+    void setGlobalBox(const BoxDim& box, bool minor_change);
 
     //! Set the global simulation box
     void setGlobalBox(const std::shared_ptr<const BoxDim> box);
@@ -645,6 +653,30 @@ class PYBIND11_EXPORT ParticleData
         return m_body;
         }
 
+    //! Return positions in structure-of-arrays layout
+    /*! The returned 2D array holds the x, y, and z components of the positions of the local and
+        ghost particles in rows 0, 1, and 2 of width getPitch(). The types remain in getPositions().
+
+        The array mirrors getPositions() on the host. It is refilled when positions have been
+        acquired for writing, swapped, or sorted since the last call, so callers must get the array
+        again after any such change. Callers must only read from the array.
+    */
+    const GlobalArray<Scalar>& getPositionsSoA()
+        {
+        updateSoAMirror(m_pos, m_pos_soa);
+        return m_pos_soa.data;
+        }
+
+    //! Return velocities in structure-of-arrays layout
+    /*! The layout and synchronization are the same as in getPositionsSoA(). The masses remain in
+        getVelocities().
+    */
+    const GlobalArray<Scalar>& getVelocitiesSoA()
+        {
+        updateSoAMirror(m_vel, m_vel_soa);
+        return m_vel_soa.data;
+        }
+
     /*!
      * Access methods to stand-by arrays for fast swapping in of reordered particle data
      *
@@ -676,6 +708,7 @@ class PYBIND11_EXPORT ParticleData
     inline void swapPositions()
         {
         m_pos.swap(m_pos_alt);
+        m_pos_soa.valid = false;
         }
 
     //! Return velocities and masses (alternate array)
@@ -688,6 +721,7 @@ class PYBIND11_EXPORT ParticleData
     inline void swapVelocities()
         {
         m_vel.swap(m_vel_alt);
+        m_vel_soa.valid = false;
         }
 
     //! Return accelerations (alternate array)
@@ -841,7 +875,26 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Notify listeners that the particles have been rearranged in memory
-    void notifyParticleSort();
+    void notifyParticleSort(bool permutation = false);
+
+    //! Test whether the sort being notified only permuted the local particles
+    /*! Subscribers of the particle sort signal may call this to skip work that depends only on
+        the set of local particles. It returns false outside of notifyParticleSort().
+    */
+    bool isSortPermutation() const
+        {
+        return m_sort_is_permutation;
+        }
+
+    //! Test whether the box change being notified is a small affine deformation
+    /*! Subscribers of the box change signal may call this to reuse data structures that remain
+        valid when the box changes only slightly, such as the cell grid. It returns false outside
+        of the box change signal.
+    */
+    bool isMinorBoxChange() const
+        {
+        return m_box_change_is_minor;
+        }
 
     //! Connects a function to be called every time the box size is changed
     Nano::Signal<void()>& getBoxChangeSignal()
@@ -855,6 +908,24 @@ class PYBIND11_EXPORT ParticleData
         return m_global_particle_num_signal;
         }
 
+    //! Connects a function to be called every time a single particle is added, removed, or retyped
+    /*! The argument is the tag of the particle. The signal is emitted on all ranks.
+     */
+    Nano::Signal<void(unsigned int)>& getParticleChangeSignal()
+        {
+        return m_particle_change_signal;
+        }
+
+    //! Test whether the global particle number change being notified adds or removes one particle
+    /*! Subscribers of the global particle number change signal that also subscribe to the particle
+        change signal may call this to skip work that the particle change signal covers. It
+        returns false outside of addParticle() and removeParticle().
+    */
+    bool isSingleParticleChange() const
+        {
+        return m_single_particle_change;
+        }
+
     //! Connects a function to be called every time the local maximum particle number changes
     Nano::Signal<void()>& getMaxParticleNumberChangeSignal()
         {
@@ -1070,6 +1141,12 @@ class PYBIND11_EXPORT ParticleData
     //! Set the orientation of a particle with a given tag
     void setMomentsOfInertia(unsigned int tag, const Scalar3& mom_inertia);
 
+    //! Set one property of the particles with the given tags
+    void updateParticles(
+        const std::string& quantity,
+        pybind11::array_t<unsigned int, pybind11::array::c_style | pybind11::array::forcecast> tags,
+        pybind11::object values);
+
     //! Get the particle data flags
     PDataFlags getFlags()
         {
@@ -1130,9 +1207,38 @@ class PYBIND11_EXPORT ParticleData
     void initializeFromSnapshot(const SnapshotParticleData<Real>& snapshot,
                                 bool ignore_bodies = false);
 
+#ifdef ENABLE_MPI
+    /// Initialize from a snapshot where each rank holds a contiguous range of tags
+    template<class Real>
+    void initializeFromDistributedSnapshot(const SnapshotParticleData<Real>& snapshot,
+                                           unsigned int first_tag,
+                                           unsigned int nglobal);
+#endif
+
+    /// Initialize from a snapshot where each rank holds a contiguous range of tags, in rank order
+    template<class Real>
+    void initializeFromDistributedSnapshot(const SnapshotParticleData<Real>& snapshot);
+
+    /// Initialize the local particles of a unit cell replicated nx * ny * nz times
+    template<class Real>
+    void initializeReplicated(const SnapshotParticleData<Real>& unit_cell,
+                              const BoxDim& unit_box,
+                              unsigned int nx,
+                              unsigned int ny,
+                              unsigned int nz);
+
+    /// Append the local particles and the tag bookkeeping to a checkpoint
+    void writeCheckpoint(detail::CheckpointBuffer& buffer);
+
+    /// Restore the local particles from a checkpoint written by this rank
+    void readCheckpoint(detail::CheckpointBuffer& buffer);
+
     //! Take a snapshot
     template<class Real> void takeSnapshot(SnapshotParticleData<Real>& snapshot);
 
+    /// Take a snapshot where each rank holds a contiguous range of tags
+    template<class Real> unsigned int takeDistributedSnapshot(SnapshotParticleData<Real>& snapshot);
+
     //! Add ghost particles at the end of the local particle data
     void addGhostParticles(const unsigned int nghosts);
 
@@ -1145,6 +1251,18 @@ class PYBIND11_EXPORT ParticleData
         notifyGhostParticlesRemoved();
         }
 
+    //! Set the fraction of the allocated size below which the particle data arrays shrink
+    void setShrinkFraction(Scalar shrink_fraction);
+
+    //! Get the fraction of the allocated size below which the particle data arrays shrink
+    Scalar getShrinkFraction() const
+        {
+        return m_shrink_fraction;
+        }
+
+    //! Release allocated memory that the local and ghost particles do not use
+    void shrink();
+
 #ifdef ENABLE_MPI
     //! Set domain decomposition information
     void setDomainDecomposition(std::shared_ptr<DomainDecomposition> decomposition)
@@ -1182,6 +1300,18 @@ class PYBIND11_EXPORT ParticleData
      */
     void addParticles(const std::vector<detail::pdata_element>& in);
 
+    //! Remove and add local particles on all ranks with a single collective call
+    /*! \param remove_tags Tags of local particles to remove
+     *  \param add Particles to add to the local domain, their tags are assigned on output
+     *
+     *  Unlike removeParticle() and addParticle(), the global tag bookkeeping of the whole
+     *  batch takes a single collective call. Added particles must lie in the local domain.
+     *
+     *  \post Any ghost particles are removed.
+     */
+    void removeAndAddParticles(const std::vector<unsigned int>& remove_tags,
+                               std::vector<detail::pdata_element>& add);
+
 #ifdef ENABLE_HIP
     //! Pack particle data into a buffer (GPU version)
     /*! \param out Buffer into which particle data is packed
@@ -1262,6 +1392,8 @@ class PYBIND11_EXPORT ParticleData
 
     Nano::Signal<void()>
         m_sort_signal; //!< Signal that is triggered when particles are sorted in memory
+    bool m_sort_is_permutation = false; //!< True while notifying a sort that kept the local set
+    bool m_box_change_is_minor = false; //!< True while notifying a small affine box deformation
     Nano::Signal<void()> m_boxchange_signal; //!< Signal that is triggered when the box size changes
     Nano::Signal<void()> m_max_particle_num_signal; //!< Signal that is triggered when the maximum
                                                     //!< particle number changes
@@ -1269,6 +1401,10 @@ class PYBIND11_EXPORT ParticleData
                                                            //!< particles are removed
     Nano::Signal<void()> m_global_particle_num_signal; //!< Signal that is triggered when the global
                                                        //!< number of particles changes
+    Nano::Signal<void(unsigned int)>
+        m_particle_change_signal;         //!< Signal that is triggered when a particle is added,
+                                          //!< removed, or retyped
+    bool m_single_particle_change = false; //!< True while adding or removing a single particle
 
 #ifdef ENABLE_MPI
     Nano::Signal<void(unsigned int, unsigned int, unsigned int)>
@@ -1333,11 +1469,24 @@ class PYBIND11_EXPORT ParticleData
                                        //!< dimensions 6*number of particles)
     GlobalArray<Scalar4> m_net_torque; //!< Net torque calculated for each particle
 
+    //! Structure-of-arrays mirror of a Scalar4 particle data array
+    struct SoAMirror
+        {
+        GlobalArray<Scalar> data; //!< x, y, and z components in rows 0, 1, and 2
+        uint64_t write_count = 0; //!< Write count of the source array when data was filled
+        unsigned int n = 0;       //!< Number of particles in data
+        bool valid = false;       //!< True when data has been filled since the last sort or swap
+        };
+
+    SoAMirror m_pos_soa; //!< Positions in structure-of-arrays layout (filled on demand)
+    SoAMirror m_vel_soa; //!< Velocities in structure-of-arrays layout (filled on demand)
+
     Scalar m_external_virial[6]; //!< External potential contribution to the virial
     Scalar m_external_energy;    //!< External potential energy
     const float
         m_resize_factor; //!< The numerical factor with which the particle data arrays are resized
-    PDataFlags m_flags;  //!< Flags identifying which optional fields are valid
+    Scalar m_shrink_fraction; //!< Fraction of the allocated size below which the arrays shrink
+    PDataFlags m_flags;       //!< Flags identifying which optional fields are valid
 
     Scalar3 m_origin; //!< Tracks the position of the origin of the coordinate system
     int3 m_o_image;   //!< Tracks the origin image
@@ -1361,6 +1510,9 @@ class PYBIND11_EXPORT ParticleData
     //! Helper function to reallocate particle data
     void reallocate(unsigned int max_n);
 
+    //! Helper function to refill a structure-of-arrays mirror when it is stale
+    void updateSoAMirror(const GlobalArray<Scalar4>& source, SoAMirror& mirror);
+
     //! Helper function to rebuild the active tag cache if necessary
     void maybe_rebuild_tag_cache();
 
@@ -1372,6 +1524,15 @@ class PYBIND11_EXPORT ParticleData
 
     //! Update the CUDA memory hints
     void setGPUAdvice();
+
+#ifdef ENABLE_MPI
+    //! Find the rank of the domain that a particle is placed in
+    unsigned int
+    placeParticleInDomain(Scalar3& pos, int3& img, const unsigned int* h_cart_ranks) const;
+
+    //! Throw an error for a particle that is outside the global box
+    void throwParticleOutOfBounds(unsigned int tag, Scalar3 pos) const;
+#endif
     };
 
 /// Allow the usage of Particle Data arrays in Python.
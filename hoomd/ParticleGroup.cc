@@ -32,9 +32,9 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef,
                              std::shared_ptr<ParticleFilter> selector,
                              bool update_tags)
     : m_sysdef(sysdef), m_pdata(sysdef->getParticleData()), m_exec_conf(m_pdata->getExecConf()),
-      m_num_local_members(0), m_particles_sorted(true), m_reallocated(false),
-      m_global_ptl_num_change(false), m_selector(selector), m_update_tags(update_tags),
-      m_warning_printed(false)
+      m_num_local_members(0), m_particles_sorted(true), m_only_permuted(false),
+      m_reallocated(false), m_global_ptl_num_change(false), m_selector(selector),
+      m_update_tags(update_tags), m_warning_printed(false)
     {
 #ifdef ENABLE_HIP
     if (m_pdata->getExecConf()->isCUDAEnabled())
@@ -54,6 +54,8 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef,
     // connect updateMemberTags() method to maximum particle number change signal
     m_pdata->getGlobalParticleNumberChangeSignal()
         .connect<ParticleGroup, &ParticleGroup::slotGlobalParticleNumChange>(this);
+    m_pdata->getParticleChangeSignal()
+        .connect<ParticleGroup, &ParticleGroup::slotParticleChange>(this);
 
     // update GPU memory hints
     updateGPUAdvice();
@@ -67,8 +69,9 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef,
 ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef,
                              const std::vector<unsigned int>& member_tags)
     : m_sysdef(sysdef), m_pdata(sysdef->getParticleData()), m_exec_conf(m_pdata->getExecConf()),
-      m_num_local_members(0), m_particles_sorted(true), m_reallocated(false),
-      m_global_ptl_num_change(false), m_update_tags(false), m_warning_printed(false)
+      m_num_local_members(0), m_particles_sorted(true), m_only_permuted(false),
+      m_reallocated(false), m_global_ptl_num_change(false), m_update_tags(false),
+      m_warning_printed(false)
     {
     // check input
     unsigned int max_tag = m_pdata->getMaximumTag();
@@ -152,6 +155,8 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef,
     // connect updateMemberTags() method to maximum particle number change signal
     m_pdata->getGlobalParticleNumberChangeSignal()
         .connect<ParticleGroup, &ParticleGroup::slotGlobalParticleNumChange>(this);
+    m_pdata->getParticleChangeSignal()
+        .connect<ParticleGroup, &ParticleGroup::slotParticleChange>(this);
 
     // update GPU memory hints
     updateGPUAdvice();
@@ -169,6 +174,8 @@ ParticleGroup::~ParticleGroup()
             .disconnect<ParticleGroup, &ParticleGroup::slotReallocate>(this);
         m_pdata->getGlobalParticleNumberChangeSignal()
             .disconnect<ParticleGroup, &ParticleGroup::slotGlobalParticleNumChange>(this);
+        m_pdata->getParticleChangeSignal()
+            .disconnect<ParticleGroup, &ParticleGroup::slotParticleChange>(this);
         }
     }
 
@@ -191,6 +198,9 @@ void ParticleGroup::updateMemberTags(bool force_update)
         // notice message
         m_pdata->getExecConf()->msg->notice(7) << "ParticleGroup: rebuilding tags" << std::endl;
 
+        // the full rebuild includes all pending particle changes
+        m_changed_tags.clear();
+
         // assign all of the particles that belong to the group
         // for each particle in the (global) data
         vector<unsigned int> member_tags = m_selector->getSelectedTags(m_sysdef);
@@ -238,6 +248,117 @@ void ParticleGroup::updateMemberTags(bool force_update)
         TAG_ALLOCATION(m_member_idx);
         }
 
+    updateMemberLookups();
+    countCentralAndFree();
+    }
+
+/*! Evaluates the filter only for the particles that were added, removed, or retyped since the last
+    update, and merges the result into the sorted member tags. In MPI simulations, the ranks
+    combine their results for the changed tags instead of gathering all member tags.
+*/
+void ParticleGroup::updateChangedMemberTags()
+    {
+    m_pdata->getExecConf()->msg->notice(7)
+        << "ParticleGroup: updating " << m_changed_tags.size() << " tags" << std::endl;
+
+    std::sort(m_changed_tags.begin(), m_changed_tags.end());
+    m_changed_tags.erase(std::unique(m_changed_tags.begin(), m_changed_tags.end()),
+                         m_changed_tags.end());
+
+    std::vector<unsigned int> selected(m_changed_tags.size());
+    for (size_t i = 0; i < m_changed_tags.size(); i++)
+        {
+        selected[i] = m_selector->isSelected(m_sysdef, m_changed_tags[i]) ? 1 : 0;
+        }
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      selected.data(),
+                      (int)selected.size(),
+                      MPI_UNSIGNED,
+                      MPI_MAX,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    std::vector<unsigned int> added_tags;
+    for (size_t i = 0; i < m_changed_tags.size(); i++)
+        {
+        if (selected[i])
+            added_tags.push_back(m_changed_tags[i]);
+        }
+
+    // replace the changed tags in the member list with the selected ones
+    std::vector<unsigned int> member_tags;
+        {
+        ArrayHandle<unsigned int> h_member_tags(m_member_tags,
+                                                access_location::host,
+                                                access_mode::read);
+        std::vector<unsigned int> kept_tags;
+        kept_tags.reserve(m_member_tags.getNumElements());
+        std::set_difference(h_member_tags.data,
+                            h_member_tags.data + m_member_tags.getNumElements(),
+                            m_changed_tags.begin(),
+                            m_changed_tags.end(),
+                            std::back_inserter(kept_tags));
+
+        member_tags.reserve(kept_tags.size() + added_tags.size());
+        std::merge(kept_tags.begin(),
+                   kept_tags.end(),
+                   added_tags.begin(),
+                   added_tags.end(),
+                   std::back_inserter(member_tags));
+        }
+
+    if (member_tags.size() != m_member_tags.getNumElements())
+        {
+        GlobalArray<unsigned int> member_tags_array(member_tags.size(), m_pdata->getExecConf());
+        m_member_tags.swap(member_tags_array);
+        TAG_ALLOCATION(m_member_tags);
+
+        GlobalArray<unsigned int> member_idx(member_tags.size(), m_pdata->getExecConf());
+        m_member_idx.swap(member_idx);
+        TAG_ALLOCATION(m_member_idx);
+        }
+
+        {
+        ArrayHandle<unsigned int> h_member_tags(m_member_tags,
+                                                access_location::host,
+                                                access_mode::overwrite);
+        std::copy(member_tags.begin(), member_tags.end(), h_member_tags.data);
+        }
+
+    if (m_is_member_tag.getNumElements() == m_pdata->getRTags().size()
+        && m_is_member.getNumElements() == m_pdata->getMaxN())
+        {
+            // only the flags of the changed tags differ
+            {
+            ArrayHandle<unsigned int> h_is_member_tag(m_is_member_tag,
+                                                      access_location::host,
+                                                      access_mode::readwrite);
+            for (size_t i = 0; i < m_changed_tags.size(); i++)
+                {
+                h_is_member_tag.data[m_changed_tags[i]] = selected[i];
+                }
+            }
+
+        m_only_permuted = false;
+        rebuildIndexList();
+        }
+    else
+        {
+        updateMemberLookups();
+        }
+
+    m_changed_tags.clear();
+    countCentralAndFree();
+    }
+
+//! Allocate and fill the membership lookups for the current member tags
+void ParticleGroup::updateMemberLookups()
+    {
     // one byte per particle to indicate membership in the group, initialize with current number of
     // local particles
     GlobalArray<unsigned int> is_member(m_pdata->getMaxN(), m_pdata->getExecConf());
@@ -252,10 +373,16 @@ void ParticleGroup::updateMemberTags(bool force_update)
     buildTagHash();
 
     // now that the tag list is completely set up and all memory is allocated, rebuild the index
-    // list
+    // list and count the local members
+    m_only_permuted = false;
     rebuildIndexList();
+    }
 
-    // count the number of central and free particles in the group
+/*! \post m_n_central_and_free_global is the global number of central and free particles in the
+    group
+*/
+void ParticleGroup::countCentralAndFree()
+    {
     // updateMemberTags cannot call any member function that would result in a checkRebuild() call
     m_n_central_and_free_global = 0;
 
@@ -575,10 +702,17 @@ void ParticleGroup::rebuildIndexList()
 
         m_num_local_members = cur_member;
         assert(m_num_local_members <= m_member_tags.getNumElements());
+
+        // the index list is sorted, so the members are contiguous when the first and the last
+        // member are cur_member - 1 indices apart
+        m_first_index = cur_member > 0 ? h_member_idx.data[0] : 0;
+        m_contiguous = cur_member == 0
+                       || h_member_idx.data[cur_member - 1] - m_first_index == cur_member - 1;
         }
 
     // index has been rebuilt
     m_particles_sorted = false;
+    m_only_permuted = true;
 
 #ifdef ENABLE_HIP
     if (m_pdata->getExecConf()->isCUDAEnabled())
@@ -655,10 +789,13 @@ void ParticleGroup::rebuildIndexListGPU()
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
 
+        // a permutation of the local particles keeps the number of local members, so there is
+        // no need to wait for the device to count them
         kernel::gpu_compact_index_list(m_pdata->getN(),
                                        d_is_member.data,
                                        d_member_idx.data,
                                        m_num_local_members,
+                                       !m_only_permuted,
                                        d_tmp.data,
                                        m_pdata->getExecConf()->getCachedAllocator());
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
@@ -666,6 +803,10 @@ void ParticleGroup::rebuildIndexListGPU()
         }
     else
         m_num_local_members = 0;
+
+    // only detect groups of all local particles, which needs no access to the index list
+    m_first_index = 0;
+    m_contiguous = m_num_local_members == 0 || m_num_local_members == m_pdata->getN();
     }
 #endif
 
@@ -717,18 +858,34 @@ void ParticleGroup::thermalizeParticleMomenta(Scalar kT, uint64_t timestep)
     // Total the system's linear momentum
     vec3<Scalar> tot_momentum(0, 0, 0);
 
+    // each particle draws up to three normal values for the velocity and three for the angular
+    // momentum
+    constexpr unsigned int batch_size = 16;
+    hoomd::RandomBatchDraws<batch_size, 6> draws;
+
     // Loop over all particles in the group
     for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
 
         {
         unsigned int j = this->getMemberIndex(group_idx);
-        unsigned int ptag = h_tag.data[j];
+
+        // Draw the random numbers of the next batch of particles together
+        if (group_idx % batch_size == 0)
+            {
+            hoomd::RandomGeneratorBatch<batch_size> rng_batch(
+                hoomd::Seed(hoomd::RNGIdentifier::ParticleGroupThermalize,
+                            timestep,
+                            m_sysdef->getSeed()));
+            for (unsigned int k = 0; k < batch_size && group_idx + k < group_size; k++)
+                {
+                unsigned int ptag = h_tag.data[this->getMemberIndex(group_idx + k)];
+                rng_batch.setCounter(k, hoomd::Counter(ptag));
+                }
+            draws.generate(rng_batch, 6);
+            }
 
         // Seed the RNG
-        hoomd::RandomGenerator rng(hoomd::Seed(hoomd::RNGIdentifier::ParticleGroupThermalize,
-                                               timestep,
-                                               m_sysdef->getSeed()),
-                                   hoomd::Counter(ptag));
+        auto rng = draws.getStream(group_idx % batch_size);
 
         // Generate a random velocity, excluding constituent particles
         Scalar mass = h_vel.data[j].w;
@@ -89,11 +89,14 @@ hipError_t gpu_rebuild_index_list(unsigned int N,
     \param d_member_idx Array of member indices
     \param d_tag Array of tags
     \param num_local_members Number of members on the local processor (return value)
+    \param count When false, \a num_local_members is left unchanged and the host does not wait
+   for the device
 */
 hipError_t gpu_compact_index_list(unsigned int N,
                                   unsigned int* d_is_member,
                                   unsigned int* d_member_idx,
                                   unsigned int& num_local_members,
+                                  bool count,
                                   unsigned int* d_tmp,
                                   CachedAllocator& alloc)
     {
@@ -111,14 +114,17 @@ hipError_t gpu_compact_index_list(unsigned int N,
     hipcub::DeviceScan::ExclusiveSum(d_temp_storage, temp_storage_bytes, d_is_member, d_tmp, N);
     alloc.deallocate((char*)d_temp_storage);
 
-    thrust::device_ptr<unsigned int> is_member(d_is_member);
+    if (count)
+        {
+        thrust::device_ptr<unsigned int> is_member(d_is_member);
 #ifdef __HIP_PLATFORM_HCC__
-    num_local_members = thrust::reduce(thrust::hip::par(alloc),
+        num_local_members = thrust::reduce(thrust::hip::par(alloc),
 #else
-    num_local_members = thrust::reduce(thrust::cuda::par(alloc),
+        num_local_members = thrust::reduce(thrust::cuda::par(alloc),
 #endif
-                                       is_member,
-                                       is_member + N);
+                                           is_member,
+                                           is_member + N);
+        }
 
     // fill member_idx array
     unsigned int block_size = 256;
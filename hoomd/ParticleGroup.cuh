@@ -26,11 +26,14 @@ hipError_t gpu_rebuild_index_list(unsigned int N,
     \param d_member_idx Array of member indices
     \param d_tag Array of tags
     \param num_local_members Number of members on the local processor (return value)
+    \param count When false, \a num_local_members is left unchanged and the host does not wait
+   for the device
 */
 hipError_t gpu_compact_index_list(unsigned int N,
                                   unsigned int* d_is_member,
                                   unsigned int* d_member_idx,
                                   unsigned int& num_local_members,
+                                  bool count,
                                   unsigned int* d_tmp,
                                   CachedAllocator& alloc);
 
@@ -31,6 +31,32 @@
 
 namespace hoomd
     {
+namespace detail
+    {
+//! Maps a position in a group to the particle index through the group's index list
+struct GroupIndexList
+    {
+    const unsigned int* data; //!< The index list of the group
+
+    unsigned int operator()(unsigned int group_idx) const
+        {
+        return data[group_idx];
+        }
+    };
+
+//! Maps a position in a group with contiguous members to the particle index
+struct GroupIndexRange
+    {
+    unsigned int first; //!< Index of the first member
+
+    unsigned int operator()(unsigned int group_idx) const
+        {
+        return first + group_idx;
+        }
+    };
+
+    } // end namespace detail
+
 //! Describes a group of particles
 /*! \b Overview
 
@@ -189,6 +215,51 @@ class PYBIND11_EXPORT ParticleGroup
         return m_member_idx;
         }
 
+    //! Test if the local members are the contiguous indices starting at getFirstIndex()
+    /*! This is the case for groups of all particles, and the integrators use it to skip the index
+        list.
+
+        \note This method CAN access the particle data tag array if the index is rebuilt.
+    */
+    bool isContiguous()
+        {
+        checkRebuild();
+
+        return m_contiguous;
+        }
+
+    //! Get the index of the first local member of a contiguous group
+    unsigned int getFirstIndex()
+        {
+        checkRebuild();
+
+        return m_first_index;
+        }
+
+    //! Call a function with the mapping from positions in the group to particle indices
+    /*! \param f Callable f(index) where index(group_idx) returns the index of member group_idx
+
+        \a f is called with a detail::GroupIndexRange when the members are contiguous and with a
+        detail::GroupIndexList otherwise. With a generic lambda, both loops are compiled and the
+        loop over contiguous members needs no index list.
+
+        \note This method CAN access the particle data tag array if the index is rebuilt.
+    */
+    template<class F> void withIndexMap(F f)
+        {
+        if (isContiguous())
+            {
+            f(detail::GroupIndexRange {m_first_index});
+            }
+        else
+            {
+            ArrayHandle<unsigned int> h_member_idx(m_member_idx,
+                                                   access_location::host,
+                                                   access_mode::read);
+            f(detail::GroupIndexList {h_member_idx.data});
+            }
+        }
+
 #ifdef ENABLE_HIP
     //! Return the load balancing GPU partition
     const GPUPartition& getGPUPartition()
@@ -296,8 +367,13 @@ class PYBIND11_EXPORT ParticleGroup
     mutable GlobalArray<unsigned int> m_member_tags; //!< Lists the tags of the particle members
     mutable unsigned int m_num_local_members;        //!< Number of members on the local processor
     mutable bool m_particles_sorted;      //!< True if particle have been sorted since last rebuild
+    mutable bool m_only_permuted; //!< True if all sorts since the last rebuild were permutations
     mutable bool m_reallocated;           //!< True if particle data arrays have been reallocated
     mutable bool m_global_ptl_num_change; //!< True if the global particle number changed
+    mutable std::vector<unsigned int>
+        m_changed_tags; //!< Particles added, removed, or retyped since the last member update
+    mutable bool m_contiguous = false;      //!< True if the local members are contiguous indices
+    mutable unsigned int m_first_index = 0; //!< Index of the first member when contiguous
 
     mutable GlobalArray<unsigned int>
         m_is_member_tag; //!< One byte per particle, == 1 if tag is a member of the group
@@ -336,8 +412,13 @@ class PYBIND11_EXPORT ParticleGroup
             updateMemberTags(false);
             m_global_ptl_num_change = false;
             }
+        else if (!m_changed_tags.empty())
+            {
+            updateChangedMemberTags();
+            }
         if (m_reallocated)
             {
+            m_only_permuted = false;
             reallocate();
             m_reallocated = false;
             update_gpu_advice = true;
@@ -362,6 +443,7 @@ class PYBIND11_EXPORT ParticleGroup
     //! Helper function to be called when the particles are resorted
     void slotParticleSort()
         {
+        m_only_permuted = m_only_permuted && m_pdata->isSortPermutation();
         m_particles_sorted = true;
         }
 
@@ -371,9 +453,33 @@ class PYBIND11_EXPORT ParticleGroup
     //! Helper function to be called when particles are added/removed
     void slotGlobalParticleNumChange()
         {
-        m_global_ptl_num_change = true;
+        // slotParticleChange() records single particle changes for incremental updates
+        if (!(m_pdata->isSingleParticleChange() && isIncremental()))
+            m_global_ptl_num_change = true;
+        }
+
+    //! Helper function to be called when a single particle is added, removed, or retyped
+    void slotParticleChange(unsigned int tag)
+        {
+        if (isIncremental())
+            m_changed_tags.push_back(tag);
         }
 
+    //! Test whether the group updates its members incrementally
+    bool isIncremental() const
+        {
+        return m_selector && m_update_tags && m_selector->isIncremental();
+        }
+
+    //! Helper function to update the member tags of only the changed particles
+    void updateChangedMemberTags();
+
+    //! Helper function to rebuild the membership lookups after the member tags change
+    void updateMemberLookups();
+
+    //! Helper function to count the central and free particles in the group
+    void countCentralAndFree();
+
     //! Helper function to build the 1:1 hash for tag membership
     void buildTagHash();
 
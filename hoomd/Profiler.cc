@@ -0,0 +1,303 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file Profiler.cc
+    \brief Defines the Profiler class
+*/
+
+#include "Profiler.h"
+
+#include <cstdlib>
+#include <cxxabi.h>
+#include <stdexcept>
+
+namespace hoomd
+    {
+/*! \param time Time spent in the call [ns]
+ */
+void Profiler::Entry::add(int64_t time)
+    {
+    total_time += time;
+    count++;
+
+    // bin k holds calls that take [2^(k-1), 2^k) microseconds
+    uint64_t microseconds = time > 0 ? uint64_t(time) / 1000 : 0;
+    unsigned int bin = 0;
+    while (microseconds > 0 && bin < n_histogram_bins - 1)
+        {
+        microseconds >>= 1;
+        bin++;
+        }
+    histogram[bin]++;
+    }
+
+Profiler* Profiler::s_tracing = nullptr;
+
+Profiler::Profiler(std::shared_ptr<const ExecutionConfiguration> exec_conf)
+    : m_exec_conf(exec_conf)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing Profiler" << std::endl;
+    }
+
+Profiler::~Profiler()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying Profiler" << std::endl;
+
+    if (s_tracing == this)
+        {
+        s_tracing = nullptr;
+        }
+
+#ifdef ENABLE_HIP
+    resolve(true);
+    for (auto event : m_free_events)
+        {
+        hipEventDestroy(event);
+        }
+    if (m_trace_event)
+        {
+        hipEventDestroy(m_trace_event);
+        }
+#endif
+    }
+
+/*! \param name Name of the region
+    \param category Category of the region in the trace
+*/
+void Profiler::begin(const std::string& name, const char* category)
+    {
+    Entry* entry = m_enabled ? &m_entries[name] : nullptr;
+    const std::string* trace_name = m_tracing ? &*m_trace_names.insert(name).first : nullptr;
+    open(entry, trace_name, category);
+    }
+
+/*! \param name Name of the region
+    \param category Category of the region in the trace
+
+    Call only while tracing. The region is not included in the accumulated statistics.
+*/
+void Profiler::beginTrace(const std::string& name, const char* category)
+    {
+    open(nullptr, &*m_trace_names.insert(name).first, category);
+    }
+
+void Profiler::open(Entry* entry, const std::string* name, const char* category)
+    {
+    OpenRegion region;
+    region.entry = entry;
+    region.name = name;
+    region.category = category;
+    region.start_time = 0;
+
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        region.start_event = getEvent();
+        hipEventRecord(region.start_event, 0);
+        m_open.push_back(region);
+        return;
+        }
+#endif
+
+    region.start_time = m_clock.getTime();
+    m_open.push_back(region);
+    }
+
+void Profiler::end()
+    {
+    if (m_open.empty())
+        {
+        throw std::runtime_error("Profiler::end called without a matching begin.");
+        }
+
+    OpenRegion region = m_open.back();
+    m_open.pop_back();
+
+    // regions that end after stopTrace() are not part of the trace
+    if (!m_tracing)
+        {
+        region.name = nullptr;
+        }
+
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        RecordedRegion recorded;
+        recorded.entry = region.entry;
+        recorded.name = region.name;
+        recorded.category = region.category;
+        recorded.timestep = m_timestep;
+        recorded.start_event = region.start_event;
+        recorded.end_event = getEvent();
+        hipEventRecord(recorded.end_event, 0);
+        m_recorded.push_back(recorded);
+
+        // accumulate regions that the device has already completed
+        resolve(false);
+        return;
+        }
+#endif
+
+    const int64_t end_time = m_clock.getTime();
+    if (region.entry)
+        {
+        region.entry->add(end_time - region.start_time);
+        }
+    // skip regions that began before the trace started
+    if (region.name && region.start_time >= m_trace_origin)
+        {
+        m_trace.push_back(TraceEvent {region.name,
+                                      region.category,
+                                      region.start_time - m_trace_origin,
+                                      end_time - region.start_time,
+                                      m_timestep});
+        }
+    }
+
+void Profiler::reset()
+    {
+    resolve(true);
+
+    // keep the entries of open regions alive, they are referenced by pointer
+    for (auto& item : m_entries)
+        {
+        item.second = Entry();
+        }
+    }
+
+const std::map<std::string, Profiler::Entry>& Profiler::getEntries()
+    {
+    resolve(true);
+    return m_entries;
+    }
+
+/*! Only one profiler in the process may record a trace at a time.
+ */
+void Profiler::startTrace()
+    {
+    if (s_tracing && s_tracing != this)
+        {
+        throw std::runtime_error("Another simulation is recording a trace.");
+        }
+
+    // complete the regions of the previous trace before discarding it
+    resolve(true);
+    m_trace.clear();
+    m_trace_steps.clear();
+    m_tracing = true;
+    s_tracing = this;
+
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        // synchronize once so that the device and host times share the origin
+        if (!m_trace_event)
+            {
+            hipEventCreate(&m_trace_event);
+            }
+        hipEventRecord(m_trace_event, 0);
+        hipEventSynchronize(m_trace_event);
+        }
+#endif
+
+    m_trace_origin = m_clock.getTime();
+    }
+
+void Profiler::stopTrace()
+    {
+    m_tracing = false;
+    if (s_tracing == this)
+        {
+        s_tracing = nullptr;
+        }
+    }
+
+const std::vector<Profiler::TraceEvent>& Profiler::getTrace()
+    {
+    resolve(true);
+    return m_trace;
+    }
+
+#ifdef ENABLE_HIP
+hipEvent_t Profiler::getEvent()
+    {
+    if (m_free_events.empty())
+        {
+        hipEvent_t event;
+        hipEventCreate(&event);
+        return event;
+        }
+
+    hipEvent_t event = m_free_events.back();
+    m_free_events.pop_back();
+    return event;
+    }
+#endif
+
+void Profiler::resolve(bool wait)
+    {
+#ifdef ENABLE_HIP
+    while (!m_recorded.empty())
+        {
+        RecordedRegion& region = m_recorded.front();
+
+        if (wait)
+            {
+            hipEventSynchronize(region.end_event);
+            }
+        else if (hipEventQuery(region.end_event) != hipSuccess)
+            {
+            // regions complete in the order they were recorded
+            break;
+            }
+
+        float milliseconds = 0;
+        hipEventElapsedTime(&milliseconds, region.start_event, region.end_event);
+        const int64_t duration = int64_t(double(milliseconds) * 1e6);
+        if (region.entry)
+            {
+            region.entry->add(duration);
+            }
+        if (region.name)
+            {
+            float start = 0;
+            hipEventElapsedTime(&start, m_trace_event, region.start_event);
+            if (start >= 0)
+                {
+                m_trace.push_back(TraceEvent {region.name,
+                                              region.category,
+                                              int64_t(double(start) * 1e6),
+                                              duration,
+                                              region.timestep});
+                }
+            }
+
+        m_free_events.push_back(region.start_event);
+        m_free_events.push_back(region.end_event);
+        m_recorded.pop_front();
+        }
+#endif
+    }
+
+namespace detail
+    {
+/*! \param type Type to name
+    \returns The demangled type name
+*/
+std::string getProfileName(const std::type_info& type)
+    {
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+    if (status != 0 || !demangled)
+        {
+        return type.name();
+        }
+
+    std::string result(demangled);
+    free(demangled);
+    return result;
+    }
+
+    } // end namespace detail
+
+    } // end namespace hoomd
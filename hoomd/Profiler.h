@@ -0,0 +1,335 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file Profiler.h
+    \brief Declares the Profiler class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include "ClockSource.h"
+#include "ExecutionConfiguration.h"
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#ifdef ENABLE_HIP
+#include <hip/hip_runtime.h>
+#endif
+
+namespace hoomd
+    {
+/// Accumulate the time spent in named regions of the time step loop.
+/*! Profiler records the total time, number of calls, and a histogram of the per-call time for each
+    named region. The histogram bins are powers of two in microseconds: bin k counts the calls that
+    take [2^(k-1), 2^k) microseconds, with bin 0 counting calls that take less than one microsecond.
+
+    Profiling is disabled by default. When disabled, ScopedProfile objects do nothing more than
+    check a flag, so the instrumentation may remain in the time step loop.
+
+    On the CPU, Profiler measures wall clock time with ClockSource. When the execution configuration
+    uses a GPU, Profiler records hipEvents at the start and end of each region and resolves their
+    elapsed times lazily. Recently recorded events are resolved with hipEventQuery in the order
+    they were recorded, so timing never synchronizes the host with the device inside the time step
+    loop. The remaining events are resolved (with a synchronization) when the results are read.
+
+    Regions must nest. The time of each region includes the time of the regions it contains.
+
+    Independently of the accumulated statistics, Profiler records a trace of a window of time steps
+    between startTrace() and stopTrace(). The trace holds the start time and the duration of every
+    region, relative to the start of the trace, and the start time of every step (markStep()). Trace
+    regions (beginTrace()) appear in the trace but not in the accumulated statistics. Autotuner uses
+    them to trace the kernel launches while a profiler is tracing, see getTracing().
+*/
+class PYBIND11_EXPORT Profiler
+    {
+    public:
+    /// Number of bins in the per-call histogram
+    static const unsigned int n_histogram_bins = 32;
+
+    /// Accumulated statistics for one named region
+    struct Entry
+        {
+        /// Total time spent in the region [ns]
+        int64_t total_time = 0;
+
+        /// Number of times the region was entered
+        uint64_t count = 0;
+
+        /// Histogram of the per-call time
+        std::vector<uint64_t> histogram = std::vector<uint64_t>(n_histogram_bins, 0);
+
+        /// Add one call that took the given time [ns]
+        void add(int64_t time);
+        };
+
+    /// One region in the trace
+    struct TraceEvent
+        {
+        /// Name of the region
+        const std::string* name;
+
+        /// Category of the region
+        const char* category;
+
+        /// Start time relative to the start of the trace [ns]
+        int64_t start;
+
+        /// Duration of the region [ns]
+        int64_t duration;
+
+        /// Time step that the region is part of
+        uint64_t timestep;
+        };
+
+    /// The start of one step in the trace
+    struct TraceStep
+        {
+        /// The time step
+        uint64_t timestep;
+
+        /// Start time relative to the start of the trace [ns]
+        int64_t start;
+        };
+
+    /// Construct a Profiler
+    Profiler(std::shared_ptr<const ExecutionConfiguration> exec_conf);
+
+    /// Destructor
+    ~Profiler();
+
+    /// Enable or disable profiling
+    void setEnabled(bool enabled)
+        {
+        m_enabled = enabled;
+        }
+
+    /// Test if profiling is enabled
+    bool isEnabled() const
+        {
+        return m_enabled;
+        }
+
+    /// Test if regions are profiled or traced
+    bool isActive() const
+        {
+        return m_enabled || m_tracing;
+        }
+
+    /// Begin a region
+    void begin(const std::string& name, const char* category = "operation");
+
+    /// Begin a region that is only traced
+    void beginTrace(const std::string& name, const char* category);
+
+    /// End the innermost region
+    void end();
+
+    /// Start recording a trace, discarding the previous one
+    void startTrace();
+
+    /// Stop recording the trace
+    void stopTrace();
+
+    /// Test if the trace is being recorded
+    bool isTracing() const
+        {
+        return m_tracing;
+        }
+
+    /// Mark the start of a time step in the trace
+    void markStep(uint64_t timestep)
+        {
+        if (m_tracing)
+            {
+            m_timestep = timestep;
+            m_trace_steps.push_back(TraceStep {timestep, m_clock.getTime() - m_trace_origin});
+            }
+        }
+
+    /// Get the regions of the recorded trace
+    const std::vector<TraceEvent>& getTrace();
+
+    /// Get the steps of the recorded trace
+    const std::vector<TraceStep>& getTraceSteps() const
+        {
+        return m_trace_steps;
+        }
+
+    /// Get the profiler that is recording a trace
+    /*! \returns The profiler that is recording a trace, or null when none is.
+
+        Code that has no access to the SystemDefinition, such as Autotuner, uses this to place
+        trace regions.
+    */
+    static Profiler* getTracing()
+        {
+        return s_tracing;
+        }
+
+    /// Discard all accumulated statistics
+    void reset();
+
+    /// Get the accumulated statistics of all regions
+    const std::map<std::string, Entry>& getEntries();
+
+    private:
+    /// Execution configuration
+    std::shared_ptr<const ExecutionConfiguration> m_exec_conf;
+
+    /// Set to true to record times
+    bool m_enabled = false;
+
+    /// Clock that times the regions on the CPU
+    ClockSource m_clock;
+
+    /// Accumulated statistics by region name
+    std::map<std::string, Entry> m_entries;
+
+    /// Set to true to record the trace
+    bool m_tracing = false;
+
+    /// Host time at the start of the trace [ns]
+    int64_t m_trace_origin = 0;
+
+    /// Time step of the regions being traced
+    uint64_t m_timestep = 0;
+
+    /// Names of the traced regions
+    std::set<std::string> m_trace_names;
+
+    /// Regions in the trace
+    std::vector<TraceEvent> m_trace;
+
+    /// Steps in the trace
+    std::vector<TraceStep> m_trace_steps;
+
+    /// The profiler that is recording a trace
+    static Profiler* s_tracing;
+
+    /// A region that has begun but not yet ended
+    struct OpenRegion
+        {
+        /// The entry to accumulate into (null when not profiled)
+        Entry* entry;
+
+        /// Name of the region in the trace (null when not traced)
+        const std::string* name;
+
+        /// Category of the region in the trace
+        const char* category;
+
+        /// Start time of the region [ns]
+        int64_t start_time;
+
+#ifdef ENABLE_HIP
+        /// Event recorded at the start of the region
+        hipEvent_t start_event;
+#endif
+        };
+
+    /// Regions that have begun and not yet ended, innermost last
+    std::vector<OpenRegion> m_open;
+
+    /// Push a region onto m_open
+    void open(Entry* entry, const std::string* name, const char* category);
+
+#ifdef ENABLE_HIP
+    /// A region that has ended on the host, but may not yet have completed on the device
+    struct RecordedRegion
+        {
+        /// The entry to accumulate into (null when not profiled)
+        Entry* entry;
+
+        /// Name of the region in the trace (null when not traced)
+        const std::string* name;
+
+        /// Category of the region in the trace
+        const char* category;
+
+        /// Time step that the region is part of
+        uint64_t timestep;
+
+        /// Events recorded at the start and end of the region
+        hipEvent_t start_event;
+        hipEvent_t end_event;
+        };
+
+    /// Ended regions in the order they ended
+    std::deque<RecordedRegion> m_recorded;
+
+    /// Events available for reuse
+    std::vector<hipEvent_t> m_free_events;
+
+    /// Event recorded at the start of the trace
+    hipEvent_t m_trace_event = nullptr;
+
+    /// Get an event from the pool
+    hipEvent_t getEvent();
+#endif
+
+    /// Accumulate the elapsed times of the recorded regions
+    /*! \param wait Set to true to wait for the device to complete all recorded regions
+     */
+    void resolve(bool wait);
+    };
+
+/// Time a region of code with RAII
+/*! ScopedProfile begins a region on construction and ends it on destruction when profiling or
+    tracing is enabled. Use it to wrap calls in the time step loop:
+
+    \code
+    {
+    ScopedProfile profile(m_sysdef->getProfiler(), "name");
+    ...
+    }
+    \endcode
+*/
+class ScopedProfile
+    {
+    public:
+    /// Begin the region
+    ScopedProfile(const std::shared_ptr<Profiler>& profiler,
+                  const std::string& name,
+                  const char* category = "operation")
+        : m_profiler(profiler->isActive() ? profiler.get() : nullptr)
+        {
+        if (m_profiler)
+            m_profiler->begin(name, category);
+        }
+
+    /// End the region
+    ~ScopedProfile()
+        {
+        if (m_profiler)
+            m_profiler->end();
+        }
+
+    ScopedProfile(const ScopedProfile&) = delete;
+    ScopedProfile& operator=(const ScopedProfile&) = delete;
+
+    private:
+    /// The profiler (null when disabled)
+    Profiler* m_profiler;
+    };
+
+namespace detail
+    {
+/// Get a human readable name for the dynamic type of an object
+std::string getProfileName(const std::type_info& type);
+
+    } // end namespace detail
+
+    } // end namespace hoomd
+
+#endif
@@ -3,8 +3,131 @@
 
 #include "PythonLocalDataAccess.h"
 
+#ifdef ENABLE_HIP
+#include <hip/hip_runtime.h>
+#endif
+
 namespace hoomd
     {
+namespace
+    {
+/// DLManagedTensor with the storage for its shape and strides
+struct DLPackContext
+    {
+    detail::dlpack::DLManagedTensor tensor;
+    std::vector<int64_t> shape;
+    std::vector<int64_t> strides;
+    };
+
+/// Free the context of a tensor when the consumer is done with it
+void deleteDLPackContext(detail::dlpack::DLManagedTensor* self)
+    {
+    delete static_cast<DLPackContext*>(self->manager_ctx);
+    }
+
+/// Free the tensor of a capsule that no consumer took
+void deleteDLPackCapsule(PyObject* capsule)
+    {
+    // consumers rename the capsule to "used_dltensor" when they take ownership of the tensor
+    if (PyCapsule_IsValid(capsule, "dltensor"))
+        {
+        auto tensor = static_cast<detail::dlpack::DLManagedTensor*>(
+            PyCapsule_GetPointer(capsule, "dltensor"));
+        tensor->deleter(tensor);
+        }
+    }
+    } // end anonymous namespace
+
+/*! \param device Device that holds the buffer's memory
+    \returns A capsule named "dltensor" that holds a DLManagedTensor
+*/
+pybind11::capsule HOOMDBuffer::getDLPack(detail::dlpack::DLDevice device) const
+    {
+    const size_t itemsize = m_dtype.bits / 8;
+
+    auto context = new DLPackContext;
+    context->shape.assign(m_shape.begin(), m_shape.end());
+    for (size_t stride : m_strides)
+        {
+        // DLPack strides count elements
+        if (stride % itemsize != 0)
+            {
+            delete context;
+            throw std::runtime_error("Buffer strides are not a multiple of the element size.");
+            }
+        context->strides.push_back(int64_t(stride / itemsize));
+        }
+
+    detail::dlpack::DLTensor& tensor = context->tensor.dl_tensor;
+    tensor.data = m_data;
+    tensor.device = device;
+    tensor.ndim = int32_t(context->shape.size());
+    tensor.dtype = m_dtype;
+    tensor.shape = context->shape.data();
+    tensor.strides = context->strides.data();
+    tensor.byte_offset = 0;
+    context->tensor.manager_ctx = context;
+    context->tensor.deleter = &deleteDLPackContext;
+
+    PyObject* capsule = PyCapsule_New(&context->tensor, "dltensor", &deleteDLPackCapsule);
+    if (!capsule)
+        {
+        delete context;
+        throw pybind11::error_already_set();
+        }
+    return pybind11::reinterpret_steal<pybind11::capsule>(capsule);
+    }
+
+/*! \param stream Stream on which the consumer uses the tensor
+ */
+pybind11::capsule HOOMDHostBuffer::getDLPackPy(pybind11::object stream) const
+    {
+    if (!stream.is_none())
+        {
+        throw std::runtime_error("The stream must be None for host buffers.");
+        }
+    return getDLPack({detail::dlpack::kDLCPU, 0});
+    }
+
+#ifdef ENABLE_HIP
+/*! \param stream Stream on which the consumer uses the tensor
+ */
+pybind11::capsule HOOMDDeviceBuffer::getDLPackPy(pybind11::object stream) const
+    {
+    intptr_t stream_value = stream.is_none() ? 1 : stream.cast<intptr_t>();
+    if (stream_value != -1 && stream_value != 0 && stream_value != 1)
+        {
+        hipStream_t consumer_stream
+            = stream_value == 2 ? hipStreamPerThread : reinterpret_cast<hipStream_t>(stream_value);
+
+        hipEvent_t event;
+        hipEventCreateWithFlags(&event, hipEventDisableTiming);
+        hipEventRecord(event, 0);
+        hipStreamWaitEvent(consumer_stream, event, 0);
+        hipEventDestroy(event);
+        }
+
+    return getDLPack(getDLPackDevice());
+    }
+
+pybind11::tuple HOOMDDeviceBuffer::getDLPackDevicePy() const
+    {
+    detail::dlpack::DLDevice device = getDLPackDevice();
+    return pybind11::make_tuple(int(device.device_type), int(device.device_id));
+    }
+
+detail::dlpack::DLDevice HOOMDDeviceBuffer::getDLPackDevice()
+    {
+    int device_id = 0;
+    hipGetDevice(&device_id);
+#ifdef __HIP_PLATFORM_NVCC__
+    return {detail::dlpack::kDLCUDA, device_id};
+#else
+    return {detail::dlpack::kDLROCM, device_id};
+#endif
+    }
+#endif
+
 namespace detail
     {
 void export_GhostDataFlag(pybind11::module& m)
@@ -19,6 +142,10 @@ void export_HOOMDHostBuffer(pybind11::module& m)
     {
     pybind11::class_<HOOMDHostBuffer>(m, "HOOMDHostBuffer", pybind11::buffer_protocol())
         .def_buffer([](HOOMDHostBuffer& b) -> pybind11::buffer_info { return b.new_buffer(); })
+        .def("__dlpack__",
+             &HOOMDHostBuffer::getDLPackPy,
+             pybind11::arg("stream") = pybind11::none())
+        .def("__dlpack_device__", &HOOMDHostBuffer::getDLPackDevicePy)
         .def_property_readonly("read_only", &HOOMDHostBuffer::getReadOnly);
     ;
     }
@@ -30,6 +157,10 @@ void export_HOOMDDeviceBuffer(pybind11::module& m)
     pybind11::class_<HOOMDDeviceBuffer>(m, "HOOMDDeviceBuffer")
         .def_property_readonly("__cuda_array_interface__",
                                &HOOMDDeviceBuffer::getCudaArrayInterface)
+        .def("__dlpack__",
+             &HOOMDDeviceBuffer::getDLPackPy,
+             pybind11::arg("stream") = pybind11::none())
+        .def("__dlpack_device__", &HOOMDDeviceBuffer::getDLPackDevicePy)
         .def_property_readonly("read_only", &HOOMDDeviceBuffer::getReadOnly);
     ;
     }
@@ -4,6 +4,7 @@
 #ifndef __PYTHON_LOCAL_DATA_ACCESS_H__
 #define __PYTHON_LOCAL_DATA_ACCESS_H__
 
+#include "DLPack.h"
 #include "GlobalArray.h"
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
@@ -22,22 +23,26 @@ namespace hoomd
  *  shape: shape of the array
  *  stride: the strides to move one index in each dimension of shape
  *  read_only: whether the buffer is meant to be read_only
+ *
+ *  All buffers can also be exported as DLPack tensors with getDLPack().
  */
-struct HOOMDBuffer
+struct PYBIND11_EXPORT HOOMDBuffer
     {
     void* m_data;
     std::string m_typestr;
     std::vector<size_t> m_shape;
     std::vector<size_t> m_strides;
     bool m_read_only;
+    detail::dlpack::DLDataType m_dtype;
 
     HOOMDBuffer(void* data,
                 std::string typestr,
                 std::vector<size_t> shape,
                 std::vector<size_t> strides,
-                bool read_only)
+                bool read_only,
+                detail::dlpack::DLDataType dtype)
         : m_data(data), m_typestr(typestr), m_shape(shape), m_strides(strides),
-          m_read_only(read_only)
+          m_read_only(read_only), m_dtype(dtype)
         {
         if (m_shape.size() != m_strides.size())
             {
@@ -49,6 +54,13 @@ struct HOOMDBuffer
         {
         return m_read_only;
         }
+
+    /// Export the buffer as a DLPack capsule that refers to the buffer's memory
+    /** The capsule holds no reference to the array, so the consumer must not use the tensor after
+     *  the buffer becomes invalid, i.e. outside of the context manager. DLPack has no read only
+     *  flag: consumers must not write to tensors exported from read only buffers.
+     */
+    pybind11::capsule getDLPack(detail::dlpack::DLDevice device) const;
     };
 
 /// Represents the data required to specify a CPU buffer object in Python.
@@ -67,8 +79,9 @@ struct HOOMDHostBuffer : public HOOMDBuffer
                     std::vector<size_t> strides,
                     bool read_only,
                     size_t itemsize,
-                    size_t dimensions)
-        : HOOMDBuffer(data, typestr, shape, strides, read_only), m_itemsize(itemsize),
+                    size_t dimensions,
+                    detail::dlpack::DLDataType dtype)
+        : HOOMDBuffer(data, typestr, shape, strides, read_only, dtype), m_itemsize(itemsize),
           m_dimensions(dimensions)
         {
         }
@@ -83,7 +96,8 @@ struct HOOMDHostBuffer : public HOOMDBuffer
                                strides,
                                read_only,
                                sizeof(T),
-                               shape.size());
+                               shape.size(),
+                               detail::dlpack::getDataType<T>());
         }
 
     pybind11::buffer_info new_buffer()
@@ -95,6 +109,17 @@ struct HOOMDHostBuffer : public HOOMDBuffer
                                      std::vector<size_t>(m_shape),
                                      std::vector<size_t>(m_strides));
         }
+
+    /// Export the buffer as a DLPack capsule for the __dlpack__ protocol
+    /** Host memory needs no synchronization, so the stream must be None.
+     */
+    pybind11::capsule getDLPackPy(pybind11::object stream) const;
+
+    /// Get the DLPack device type and id for the __dlpack_device__ protocol
+    pybind11::tuple getDLPackDevicePy() const
+        {
+        return pybind11::make_tuple(int(detail::dlpack::kDLCPU), 0);
+        }
     };
 
 #if ENABLE_HIP
@@ -110,8 +135,9 @@ struct HOOMDDeviceBuffer : public HOOMDBuffer
                       std::string typestr,
                       std::vector<size_t> shape,
                       std::vector<size_t> strides,
-                      bool read_only)
-        : HOOMDBuffer(data, typestr, shape, strides, read_only)
+                      bool read_only,
+                      detail::dlpack::DLDataType dtype)
+        : HOOMDBuffer(data, typestr, shape, strides, read_only, dtype)
         {
         }
 
@@ -123,7 +149,8 @@ struct HOOMDDeviceBuffer : public HOOMDBuffer
                                  pybind11::format_descriptor<T>::format(),
                                  shape,
                                  strides,
-                                 read_only);
+                                 read_only,
+                                 detail::dlpack::getDataType<T>());
         }
 
     /// Convert object to a __cuda_array_interface__ v2 compliant Python dict.
@@ -162,6 +189,22 @@ struct HOOMDDeviceBuffer : public HOOMDBuffer
         interface["strides"] = pybind11::tuple(strides);
         return interface;
         }
+
+    /// Export the buffer as a DLPack capsule for the __dlpack__ protocol
+    /** HOOMD launches its kernels on the default stream. When the consumer will use the tensor
+     *  on another stream, the consumer's stream waits for the work queued on the default stream.
+     *  The stream follows the __dlpack__ convention: None or 1 is the legacy default stream, 2 is
+     *  the per-thread default stream, -1 requests no synchronization, and any other value is a
+     *  stream handle.
+     */
+    pybind11::capsule getDLPackPy(pybind11::object stream) const;
+
+    /// Get the DLPack device type and id for the __dlpack_device__ protocol
+    pybind11::tuple getDLPackDevicePy() const;
+
+    private:
+    /// Get the DLPack device for the current HIP device
+    static detail::dlpack::DLDevice getDLPackDevice();
     };
 #endif
 
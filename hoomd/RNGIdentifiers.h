@@ -70,6 +70,11 @@ struct RNGIdentifier
     static const uint8_t HPMCShapeMoveUpdateOrder = 44;
     static const uint8_t BussiThermostat = 45;
     static const uint8_t ConstantPressure = 46;
+    static const uint8_t HPMCMonoCheckerboard = 47;
+    static const uint8_t UpdaterMuVTLocal = 48;
+    static const uint8_t HPMCMonoChainCheckerboard = 49;
+    static const uint8_t ComputeFreeVolumeShift = 50;
+    static const uint8_t ReplicaExchange = 51;
     };
 
     } // namespace hoomd
@@ -269,6 +269,174 @@ DEVICE inline r123::Philox4x32::ctr_type RandomGenerator::operator()()
     return u;
     }
 
+//! Philox random number generator for a batch of streams that share a Seed
+/*! RandomGeneratorBatch advances batch_size independent streams in lockstep. Stream k produces
+    the same values as RandomGenerator(seed, counter_k). The state is stored as structure of arrays
+    and the Philox rounds loop over the streams, so the compiler can vectorize them. Use it where
+    many short streams start together, such as one stream for each particle pair.
+*/
+template<unsigned int batch_size> class RandomGeneratorBatch
+    {
+    public:
+    /** Construct a batch of random generators
+
+        @param seed RNG seed shared by all streams.
+
+        All counters start at 0. Call setCounter() to select the stream in each slot.
+    */
+    RandomGeneratorBatch(const Seed& seed) : m_key(seed.getKey())
+        {
+        for (unsigned int w = 0; w < 4; w++)
+            for (unsigned int k = 0; k < batch_size; k++)
+                m_ctr[w][k] = 0;
+        }
+
+    /// Set the counter of the stream in slot k
+    void setCounter(unsigned int k, const Counter& counter)
+        {
+        for (unsigned int w = 0; w < 4; w++)
+            m_ctr[w][k] = counter.getCounter().v[w];
+        }
+
+    /// Get the key
+    const r123::Philox4x32::key_type& getKey() const
+        {
+        return m_key;
+        }
+
+    /// Get the counter of the stream in slot k
+    r123::Philox4x32::ctr_type getCounter(unsigned int k) const
+        {
+        return {{m_ctr[0][k], m_ctr[1][k], m_ctr[2][k], m_ctr[3][k]}};
+        }
+
+    /// Generate uniformly distributed 128-bit values, word w of stream k in out[w][k]
+    inline void operator()(uint32_t (&out)[4][batch_size])
+        {
+        r123::Philox4x32::key_type key = m_key;
+        for (unsigned int w = 0; w < 4; w++)
+            for (unsigned int k = 0; k < batch_size; k++)
+                out[w][k] = m_ctr[w][k];
+
+        // Philox4x32-10, see random123/philox.h
+        for (unsigned int round = 0; round < 10; round++)
+            {
+            if (round > 0)
+                {
+                key.v[0] += 0x9E3779B9;
+                key.v[1] += 0xBB67AE85;
+                }
+
+            for (unsigned int k = 0; k < batch_size; k++)
+                {
+                uint64_t product0 = uint64_t(0xD2511F53) * out[0][k];
+                uint64_t product1 = uint64_t(0xCD9E8D57) * out[2][k];
+                uint32_t c1 = out[1][k];
+                uint32_t c3 = out[3][k];
+                out[0][k] = uint32_t(product1 >> 32) ^ c1 ^ key.v[0];
+                out[1][k] = uint32_t(product1);
+                out[2][k] = uint32_t(product0 >> 32) ^ c3 ^ key.v[1];
+                out[3][k] = uint32_t(product0);
+                }
+            }
+
+        for (unsigned int k = 0; k < batch_size; k++)
+            m_ctr[0][k] += 1;
+        }
+
+    private:
+    r123::Philox4x32::key_type m_key; //!< RNG key shared by all streams
+    uint32_t m_ctr[4][batch_size];    //!< RNG counters, word w of stream k in m_ctr[w][k]
+    };
+
+//! Philox outputs drawn in bulk from a batch of streams
+/*! generate() draws the first n values of every stream of a RandomGeneratorBatch at once. The
+    Stream returned by getStream(k) is an RNG that can be passed to any distribution in this file.
+    It replays the values of stream k in order and produces exactly the values of RandomGenerator
+    for that stream. A stream that needs more than n values computes the rest one at a time.
+
+    Use this to vectorize loops that create one RandomGenerator per particle:
+
+    \code
+    RandomBatchDraws<16, 6> draws;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        if (i % 16 == 0)
+            {
+            RandomGeneratorBatch<16> rng_batch(seed);
+            for (unsigned int k = 0; k < 16 && i + k < N; k++)
+                rng_batch.setCounter(k, Counter(tag[i + k]));
+            draws.generate(rng_batch, 6);
+            }
+
+        auto rng = draws.getStream(i % 16);
+        Scalar x = NormalDistribution<Scalar>(sigma)(rng);
+        }
+    \endcode
+*/
+template<unsigned int batch_size, unsigned int max_draws> class RandomBatchDraws
+    {
+    public:
+    /// RNG that replays the values of one stream
+    class Stream
+        {
+        public:
+        Stream(const RandomBatchDraws& draws, unsigned int k) : m_draws(draws), m_k(k), m_n(0) { }
+
+        /// Generate uniformly distributed 128-bit values
+        inline r123::Philox4x32::ctr_type operator()()
+            {
+            r123::Philox4x32::ctr_type u;
+            if (m_n < m_draws.m_n_draws)
+                {
+                for (unsigned int w = 0; w < 4; w++)
+                    u.v[w] = m_draws.m_u[m_n][w][m_k];
+                }
+            else
+                {
+                r123::Philox4x32::ctr_type ctr = m_draws.m_ctr[m_k];
+                ctr.v[0] += m_n;
+                u = r123::Philox4x32()(ctr, m_draws.m_key);
+                }
+            m_n++;
+            return u;
+            }
+
+        private:
+        const RandomBatchDraws& m_draws; //!< Draws of the batch
+        unsigned int m_k;                //!< Slot of this stream in the batch
+        unsigned int m_n;                //!< Number of values generated so far
+        };
+
+    /** Draw values from a batch of streams
+
+        @param rng Random number generators, advanced by n values.
+        @param n Number of values to draw from each stream, must not exceed max_draws.
+    */
+    void generate(RandomGeneratorBatch<batch_size>& rng, unsigned int n)
+        {
+        m_key = rng.getKey();
+        for (unsigned int k = 0; k < batch_size; k++)
+            m_ctr[k] = rng.getCounter(k);
+
+        m_n_draws = n;
+        for (unsigned int i = 0; i < n; i++)
+            rng(m_u[i]);
+        }
+
+    /// Get the RNG that replays the values of stream k
+    Stream getStream(unsigned int k) const
+        {
+        return Stream(*this, k);
+        }
+
+    private:
+    uint32_t m_u[max_draws][4][batch_size];       //!< Value i of stream k in m_u[i][:][k]
+    unsigned int m_n_draws = 0;                   //!< Number of values in m_u
+    r123::Philox4x32::key_type m_key;             //!< RNG key of the batch
+    r123::Philox4x32::ctr_type m_ctr[batch_size]; //!< Initial RNG counter of each stream
+    };
+
 namespace detail
     {
 //! Generate a uniform random uint32_t
@@ -335,6 +503,19 @@ template<typename Real> class UniformDistribution
         return a + width * detail::generate_canonical<Real>(rng);
         }
 
+    //! Draw one value from each stream of a batch
+    /*! \param rng Random number generators
+        \param out [out] Uniform random values in [a,b], out[k] is drawn from stream k
+    */
+    template<unsigned int batch_size>
+    inline void operator()(RandomGeneratorBatch<batch_size>& rng, Real (&out)[batch_size])
+        {
+        uint32_t u[4][batch_size];
+        rng(u);
+        for (unsigned int k = 0; k < batch_size; k++)
+            out[k] = a + width * r123::u01<Real>(uint64_t(u[0][k]) << 32 | u[1][k]);
+        }
+
     private:
     const Real a;     //!< Left end point of the interval
     const Real width; //!< Width of the interval
@@ -396,6 +577,28 @@ template<typename Real> class NormalDistribution
         out2 = y + mu;
         }
 
+    //! Draw one value from each stream of a batch
+    /*! \param rng Random number generators
+        \param out [out] Normally distributed random values, out[k] is drawn from stream k
+    */
+    template<unsigned int batch_size>
+    inline void operator()(RandomGeneratorBatch<batch_size>& rng, Real (&out)[batch_size])
+        {
+        uint32_t u[4][batch_size];
+        rng(u);
+        for (unsigned int k = 0; k < batch_size; k++)
+            {
+            uint64_t u0 = uint64_t(u[0][k]) << 32 | u[1][k];
+            uint64_t u1 = uint64_t(u[2][k]) << 32 | u[3][k];
+
+            Real x, y;
+            fast::sincospi(r123::uneg11<Real>(u0), x, y);
+            Real r = fast::sqrt(Real(-2.0) * fast::log(r123::u01<Real>(u1)));
+            x *= r;
+            out[k] = x * sigma + mu;
+            }
+        }
+
     private:
     const Real sigma; //!< Standard deviation
     const Real mu;    //!< Mean
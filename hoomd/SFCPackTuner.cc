@@ -104,8 +104,17 @@ void SFCPackTuner::update(uint64_t timestep)
     // apply that sort order to the particles
     applySortOrder();
 
-    // trigger sort signal (this also forces particle migration)
-    m_pdata->notifyParticleSort();
+    // follow the new particle order in the bonded group tables
+    m_sysdef->getBondData()->sortByParticleIndex();
+    m_sysdef->getAngleData()->sortByParticleIndex();
+    m_sysdef->getDihedralData()->sortByParticleIndex();
+    m_sysdef->getImproperData()->sortByParticleIndex();
+    m_sysdef->getConstraintData()->sortByParticleIndex();
+    m_sysdef->getPairData()->sortByParticleIndex();
+
+    // trigger sort signal (this also forces particle migration), the sort only permutes the local
+    // particles
+    m_pdata->notifyParticleSort(true);
 
 #ifdef ENABLE_MPI
     if (m_sysdef->isDomainDecomposed())
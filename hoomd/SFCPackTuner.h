@@ -43,6 +43,11 @@ namespace hoomd
    based on the order in which those bins appear along a hilbert curve. It is very efficient, even
    when the box size changes often as the grid dimension is kept constant.
 
+    After the particles, the local bonds, angles, dihedrals, impropers, constraints and special
+   pairs are sorted by the lowest index of their members so that the bonded force computes also
+   access the particle data in order. With MPI, the ghost particles are exchanged again after the
+   sort and arrive in the SFC order of the neighboring ranks.
+
     \ingroup updaters
 */
 class PYBIND11_EXPORT SFCPackTuner : public Tuner
@@ -11,8 +11,10 @@
 #include "Communicator.h"
 #endif
 
+#include <algorithm>
 #include <pybind11/cast.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 #include <pybind11/stl_bind.h>
 #include <stdexcept>
 #include <time.h>
@@ -89,6 +91,13 @@ void System::run(uint64_t nsteps, bool write_at_start)
 
     resetStats();
 
+    // autotuners look up and store parameters for the current system size
+    std::shared_ptr<AutotunerCache> autotuner_cache = m_exec_conf->getAutotunerCache();
+    if (autotuner_cache)
+        {
+        autotuner_cache->setSystemSize(m_sysdef->getParticleData()->getNGlobal());
+        }
+
 #ifdef ENABLE_MPI
     if (m_sysdef->isDomainDecomposed())
         {
@@ -117,23 +126,59 @@ void System::run(uint64_t nsteps, bool write_at_start)
     // cannot generate on the first step
     m_sysdef->getParticleData()->setFlags(determineFlags(m_cur_tstep));
 
+    std::shared_ptr<Profiler> profiler = m_sysdef->getProfiler();
+
     // execute analyzers on initial step if requested
     if (write_at_start)
         {
         for (auto& analyzer : m_analyzers)
             {
             if ((*analyzer->getTrigger())(m_cur_tstep))
+                {
+                ScopedProfile profile(profiler, analyzer->getProfileName());
                 analyzer->analyze(m_cur_tstep);
+                }
             }
         }
 
     // run the steps
-    for (uint64_t count = 0; count < nsteps; count++)
+    // Steps on which no operation is active run in blocks of idle steps, which skip the operation
+    // loops and check for interrupts once per block. The block length adapts to the TPS so that
+    // the checks happen every idle_check_period seconds.
+    uint64_t idle_block_size = 1;
+    for (uint64_t count = 0; count < nsteps;)
         {
+        // step t is idle when no operation is active on t (tuners and updaters) or on t + 1
+        // (analyzers and the flags of the next step)
+        const uint64_t next_operation_step = findNextOperationStep(m_cur_tstep);
+        if (next_operation_step > m_cur_tstep + 1)
+            {
+            const uint64_t n_idle = std::min({next_operation_step - 1 - m_cur_tstep,
+                                              nsteps - count,
+                                              idle_block_size});
+            runIdleSteps(n_idle);
+            count += n_idle;
+
+            updateTPS();
+            idle_block_size = std::max(uint64_t(1), uint64_t(m_last_TPS * idle_check_period));
+
+            // propagate Python exceptions related to signals
+            if (PyErr_CheckSignals() != 0)
+                {
+                throw pybind11::error_already_set();
+                }
+            continue;
+            }
+
+        profiler->markStep(m_cur_tstep);
+
         for (auto& tuner : m_tuners)
             {
             if ((*tuner->getTrigger())(m_cur_tstep))
+                {
+                ScopedProfile profile(profiler, tuner->getProfileName());
                 tuner->update(m_cur_tstep);
+                }
             }
 
         // execute updaters
@@ -141,6 +186,7 @@ void System::run(uint64_t nsteps, bool write_at_start)
             {
             if ((*updater->getTrigger())(m_cur_tstep))
                 {
+                ScopedProfile profile(profiler, updater->getProfileName());
                 updater->update(m_cur_tstep);
                 m_update_group_dof_next_step |= updater->mayChangeDegreesOfFreedom(m_cur_tstep);
                 }
@@ -159,7 +205,10 @@ void System::run(uint64_t nsteps, bool write_at_start)
 
         // execute the integrator
         if (m_integrator)
+            {
+            ScopedProfile profile(profiler, m_integrator->getProfileName());
             m_integrator->update(m_cur_tstep);
+            }
 
         m_cur_tstep++;
 
@@ -167,10 +216,17 @@ void System::run(uint64_t nsteps, bool write_at_start)
         for (auto& analyzer : m_analyzers)
             {
             if ((*analyzer->getTrigger())(m_cur_tstep))
+                {
+                ScopedProfile profile(profiler, analyzer->getProfileName());
                 analyzer->analyze(m_cur_tstep);
+                }
             }
 
         updateTPS();
+        count++;
+
+        // print the messages that worker threads queued during the step
+        m_exec_conf->msg->flushDeferred();
 
         // propagate Python exceptions related to signals
         if (PyErr_CheckSignals() != 0)
@@ -180,6 +236,67 @@ void System::run(uint64_t nsteps, bool write_at_start)
         }
     }
 
+/*! \param tstep First time step to consider
+    \returns The earliest step on or after \a tstep on which the trigger of any analyzer, updater,
+    or tuner may be active
+
+    Evaluates the triggers on \a tstep and uses their cached inactive ranges, so the triggers of
+    idle operations are not computed again.
+*/
+uint64_t System::findNextOperationStep(uint64_t tstep)
+    {
+    uint64_t next = Trigger::NEVER;
+    auto find_next = [&next, tstep](const std::shared_ptr<Trigger>& trigger)
+    {
+        next = std::min(next, trigger->findNextActive(tstep));
+        return next == tstep;
+    };
+
+    for (auto& analyzer : m_analyzers)
+        {
+        if (find_next(analyzer->getTrigger()))
+            return next;
+        }
+
+    for (auto& updater : m_updaters)
+        {
+        if (find_next(updater->getTrigger()))
+            return next;
+        }
+
+    for (auto& tuner : m_tuners)
+        {
+        if (find_next(tuner->getTrigger()))
+            return next;
+        }
+
+    return next;
+    }
+
+/*! \param nsteps Number of steps to run
+
+    The caller must ensure that no operation is active on the steps and on the step after the last
+    one. The flags of the idle steps are the same, so they are set once.
+*/
+void System::runIdleSteps(uint64_t nsteps)
+    {
+    m_sysdef->getParticleData()->setFlags(determineFlags(m_cur_tstep + 1));
+
+    std::shared_ptr<Profiler> profiler = m_sysdef->getProfiler();
+    for (uint64_t i = 0; i < nsteps; i++)
+        {
+        profiler->markStep(m_cur_tstep);
+
+        if (m_integrator)
+            {
+            ScopedProfile profile(profiler, m_integrator->getProfileName());
+            m_integrator->update(m_cur_tstep);
+            }
+
+        m_cur_tstep++;
+        }
+    }
+
 void System::updateTPS()
     {
     m_last_walltime = double(m_clk.getTime() - m_initial_time) / double(1e9);
@@ -206,6 +323,29 @@ void System::resetStats()
     // computes
     for (auto compute : m_computes)
         compute->resetStats();
+
+    m_sysdef->getProfiler()->reset();
+    }
+
+/*! \returns A dictionary that maps each profiled region name to a dictionary with the total time
+    (in seconds), the number of calls, and the per-call histogram.
+*/
+pybind11::dict System::getProfile()
+    {
+    pybind11::dict result;
+    for (const auto& item : m_sysdef->getProfiler()->getEntries())
+        {
+        const Profiler::Entry& entry = item.second;
+        if (entry.count == 0)
+            continue;
+
+        pybind11::dict region;
+        region["total_time"] = double(entry.total_time) / 1e9;
+        region["count"] = entry.count;
+        region["histogram"] = pybind11::cast(entry.histogram);
+        result[pybind11::str(item.first)] = region;
+        }
+    return result;
     }
 
 /*! \param tstep Time step for which to determine the flags
@@ -280,6 +420,9 @@ void export_System(pybind11::module& m)
         .def("setPressureFlag", &System::setPressureFlag)
         .def("getPressureFlag", &System::getPressureFlag)
         .def_property_readonly("walltime", &System::getCurrentWalltime)
+        .def("setProfilingEnabled", &System::setProfilingEnabled)
+        .def("getProfilingEnabled", &System::getProfilingEnabled)
+        .def("getProfile", &System::getProfile)
         .def_property_readonly("final_timestep", &System::getEndStep)
         .def_property_readonly("initial_timestep", &System::getStartStep)
         .def_property_readonly("analyzers", &System::getAnalyzers)
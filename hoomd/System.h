@@ -176,6 +176,21 @@ class PYBIND11_EXPORT System
         return m_default_flags[pdata_flag::pressure_tensor];
         }
 
+    /// Enable or disable per-operation timing
+    void setProfilingEnabled(bool enabled)
+        {
+        m_sysdef->getProfiler()->setEnabled(enabled);
+        }
+
+    /// Test if per-operation timing is enabled
+    bool getProfilingEnabled()
+        {
+        return m_sysdef->getProfiler()->isEnabled();
+        }
+
+    /// Get the per-operation timing since the start of the last run
+    pybind11::dict getProfile();
+
     /// Get the particle group cache.
     std::vector<std::shared_ptr<ParticleGroup>>& getGroupCache()
         {
@@ -225,6 +240,15 @@ class PYBIND11_EXPORT System
     //! Get the flags needed for a particular step
     PDataFlags determineFlags(uint64_t tstep);
 
+    /// Find the earliest step on or after tstep on which any operation may be active
+    uint64_t findNextOperationStep(uint64_t tstep);
+
+    /// Advance the integrator by the given number of steps without running any operation
+    void runIdleSteps(uint64_t nsteps);
+
+    /// Target wall clock time between interrupt checks in blocks of idle steps, in seconds
+    static constexpr double idle_check_period = 0.01;
+
     /// Record the initial time of the last run
     int64_t m_initial_time = 0;
 
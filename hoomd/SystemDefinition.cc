@@ -235,6 +235,82 @@ void SystemDefinition::initializeFromSnapshot(std::shared_ptr<SnapshotSystemData
 #endif
     }
 
+/*! \param unit_cell Unit cell to replicate, read from the root rank
+    \param nx Number of unit cells along the first box vector
+    \param ny Number of unit cells along the second box vector
+    \param nz Number of unit cells along the third box vector
+
+    Produce the same system as initializeFromSnapshot() with the unit cell snapshot after
+    SnapshotSystemData::replicate(). Only the unit cell is broadcast. Each rank then places the
+    replicated particles in its own domain and the bonded groups with local members, so the
+    replicated system is never materialized on a single rank.
+
+    The domain decomposition keeps its fractions of the box.
+
+    \note This method must be called collectively on all ranks.
+*/
+template<class Real>
+void SystemDefinition::initializeReplicated(std::shared_ptr<SnapshotSystemData<Real>> unit_cell,
+                                            unsigned int nx,
+                                            unsigned int ny,
+                                            unsigned int nz)
+    {
+    std::shared_ptr<const ExecutionConfiguration> exec_conf = m_particle_data->getExecConf();
+
+    // the unit cell is small, give every rank a copy
+    auto unit = std::make_shared<SnapshotSystemData<Real>>(*unit_cell);
+#ifdef ENABLE_MPI
+    if (m_particle_data->getDomainDecomposition())
+        {
+        MPI_Comm communicator = exec_conf->getMPICommunicator();
+        unit->broadcast_box(exec_conf->getMPIConfig());
+        unit->particle_data.bcast(0, communicator);
+        unit->bond_data.bcast(0, communicator);
+        unit->angle_data.bcast(0, communicator);
+        unit->dihedral_data.bcast(0, communicator);
+        unit->improper_data.bcast(0, communicator);
+        unit->constraint_data.bcast(0, communicator);
+        unit->pair_data.bcast(0, communicator);
+#ifdef BUILD_MPCD
+        unit->mpcd_data.bcast(0, communicator);
+#endif
+        }
+#endif
+
+    if (nx == 0 || ny == 0 || nz == 0)
+        {
+        throw std::runtime_error("The number of replicas must be positive.");
+        }
+    if (unit->dimensions == 2 && nz != 1)
+        {
+        throw std::runtime_error("Two dimensional systems must have nz = 1.");
+        }
+#ifdef BUILD_MPCD
+    if (unit->mpcd_data.size != 0)
+        {
+        throw std::runtime_error("Replicated initialization does not support MPCD particles.");
+        }
+#endif
+
+    m_n_dimensions = unit->dimensions;
+
+    BoxDim unit_box = *unit->global_box;
+    auto global_box = std::make_shared<BoxDim>(unit_box);
+    Scalar3 L = unit_box.getL();
+    global_box->setL(make_scalar3(L.x * Scalar(nx), L.y * Scalar(ny), L.z * Scalar(nz)));
+    m_particle_data->setGlobalBox(global_box);
+
+    const unsigned int n_images = nx * ny * nz;
+    const unsigned int n_unit_particles = unit->particle_data.size;
+    m_particle_data->initializeReplicated(unit->particle_data, unit_box, nx, ny, nz);
+    m_bond_data->initializeReplicated(unit->bond_data, n_images, n_unit_particles);
+    m_angle_data->initializeReplicated(unit->angle_data, n_images, n_unit_particles);
+    m_dihedral_data->initializeReplicated(unit->dihedral_data, n_images, n_unit_particles);
+    m_improper_data->initializeReplicated(unit->improper_data, n_images, n_unit_particles);
+    m_constraint_data->initializeReplicated(unit->constraint_data, n_images, n_unit_particles);
+    m_pair_data->initializeReplicated(unit->pair_data, n_images, n_unit_particles);
+    }
+
 // instantiate both float and double methods
 template SystemDefinition::SystemDefinition(std::shared_ptr<SnapshotSystemData<float>> snapshot,
                                             std::shared_ptr<ExecutionConfiguration> exec_conf,
@@ -242,6 +318,11 @@ template SystemDefinition::SystemDefinition(std::shared_ptr<SnapshotSystemData<f
 template std::shared_ptr<SnapshotSystemData<float>> SystemDefinition::takeSnapshot<float>();
 template void SystemDefinition::initializeFromSnapshot<float>(
     std::shared_ptr<SnapshotSystemData<float>> snapshot);
+template void SystemDefinition::initializeReplicated<float>(
+    std::shared_ptr<SnapshotSystemData<float>> unit_cell,
+    unsigned int nx,
+    unsigned int ny,
+    unsigned int nz);
 
 template SystemDefinition::SystemDefinition(std::shared_ptr<SnapshotSystemData<double>> snapshot,
                                             std::shared_ptr<ExecutionConfiguration> exec_conf,
@@ -249,6 +330,11 @@ template SystemDefinition::SystemDefinition(std::shared_ptr<SnapshotSystemData<d
 template std::shared_ptr<SnapshotSystemData<double>> SystemDefinition::takeSnapshot<double>();
 template void SystemDefinition::initializeFromSnapshot<double>(
     std::shared_ptr<SnapshotSystemData<double>> snapshot);
+template void SystemDefinition::initializeReplicated<double>(
+    std::shared_ptr<SnapshotSystemData<double>> unit_cell,
+    unsigned int nx,
+    unsigned int ny,
+    unsigned int nz);
 
 namespace detail
     {
@@ -299,6 +385,8 @@ void export_SystemDefinition(pybind11::module& m)
         .def("takeSnapshot_double", &SystemDefinition::takeSnapshot<double>)
         .def("initializeFromSnapshot", &SystemDefinition::initializeFromSnapshot<float>)
         .def("initializeFromSnapshot", &SystemDefinition::initializeFromSnapshot<double>)
+        .def("initializeReplicated", &SystemDefinition::initializeReplicated<float>)
+        .def("initializeReplicated", &SystemDefinition::initializeReplicated<double>)
         .def("getSeed", &SystemDefinition::getSeed)
         .def("setSeed", &SystemDefinition::setSeed)
 #ifdef ENABLE_MPI
@@ -11,6 +11,7 @@
 
 #include "BondedGroupData.h"
 #include "ParticleData.h"
+#include "Profiler.h"
 #ifdef BUILD_MPCD
 #include "hoomd/mpcd/ParticleData.h"
 #endif
@@ -216,6 +217,30 @@ class PYBIND11_EXPORT SystemDefinition
         }
 #endif
 
+    /// Get the profiler that times the operations acting on this system
+    std::shared_ptr<Profiler> getProfiler()
+        {
+        if (!m_profiler)
+            {
+            m_profiler = std::make_shared<Profiler>(m_particle_data->getExecConf());
+            }
+        return m_profiler;
+        }
+
+    /// Get the total time spent computing forces on this rank [ns]
+    int64_t getForceComputeTime() const
+        {
+        return m_force_compute_time;
+        }
+
+    /// Add to the time spent computing forces on this rank
+    /*! \param time Time spent in a force computation [ns]
+     */
+    void addForceComputeTime(int64_t time)
+        {
+        m_force_compute_time += time;
+        }
+
     //! Return a snapshot of the current system data
     template<class Real> std::shared_ptr<SnapshotSystemData<Real>> takeSnapshot();
 
@@ -223,6 +248,13 @@ class PYBIND11_EXPORT SystemDefinition
     template<class Real>
     void initializeFromSnapshot(std::shared_ptr<SnapshotSystemData<Real>> snapshot);
 
+    /// Initialize the system with a unit cell replicated on each rank's domain
+    template<class Real>
+    void initializeReplicated(std::shared_ptr<SnapshotSystemData<Real>> unit_cell,
+                              unsigned int nx,
+                              unsigned int ny,
+                              unsigned int nz);
+
     private:
     unsigned int m_n_dimensions;                       //!< Dimensionality of the system
     uint16_t m_seed = 0;                               //!< Random number seed
@@ -241,6 +273,12 @@ class PYBIND11_EXPORT SystemDefinition
     /// The system communicator
     std::weak_ptr<Communicator> m_communicator;
 #endif
+
+    /// Profiler (created on first use)
+    std::shared_ptr<Profiler> m_profiler;
+
+    /// Total time spent computing forces on this rank [ns]
+    int64_t m_force_compute_time = 0;
     };
 
 namespace detail
@@ -0,0 +1,261 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file TraceWriter.cc
+    \brief Defines the TraceWriter class
+*/
+
+#include "TraceWriter.h"
+#include "Profiler.h"
+
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace
+    {
+//! Write a string as a JSON string literal
+void writeJSONString(std::ostream& out, const std::string& value)
+    {
+    out << '"';
+    for (char c : value)
+        {
+        if (c == '"' || c == '\\')
+            {
+            out << '\\' << c;
+            }
+        else if (static_cast<unsigned char>(c) < 0x20)
+            {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec
+                << std::setfill(' ');
+            }
+        else
+            {
+            out << c;
+            }
+        }
+    out << '"';
+    }
+    } // end anonymous namespace
+
+namespace detail
+    {
+/*! \param timestep Time step to query
+ */
+bool TraceWindowTrigger::compute(uint64_t timestep)
+    {
+    return m_writer->isRecording() || (*m_writer->getWindowTrigger())(timestep);
+    }
+
+/*! \param timestep First time step to consider
+ */
+uint64_t TraceWindowTrigger::nextActive(uint64_t timestep)
+    {
+    // a window starts only on a step where the user trigger is active
+    if (m_writer->isRecording())
+        {
+        return timestep;
+        }
+    return m_writer->getWindowTrigger()->findNextActive(timestep);
+    }
+
+    } // end namespace detail
+
+/*! \param sysdef System definition
+    \param trigger Steps on which to start a window
+    \param filename Name of the trace file
+    \param steps Number of steps in each window
+*/
+TraceWriter::TraceWriter(std::shared_ptr<SystemDefinition> sysdef,
+                         std::shared_ptr<Trigger> trigger,
+                         const std::string& filename,
+                         uint64_t steps)
+    : Analyzer(sysdef, std::make_shared<detail::TraceWindowTrigger>(this)),
+      m_window_trigger(trigger), m_filename(filename), m_recording(false), m_window_start(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing TraceWriter: " << filename << endl;
+    setSteps(steps);
+    }
+
+TraceWriter::~TraceWriter()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying TraceWriter" << endl;
+
+    if (m_recording)
+        {
+        m_sysdef->getProfiler()->stopTrace();
+        }
+    }
+
+/*! \param steps Number of steps in each window
+ */
+void TraceWriter::setSteps(uint64_t steps)
+    {
+    if (steps == 0)
+        {
+        throw std::runtime_error("The trace window must have at least one step.");
+        }
+    m_steps = steps;
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    Analyzers are called after the step counter increments, so the window that starts in the call
+    on step \a timestep records the steps \a timestep to \a timestep + steps - 1.
+*/
+void TraceWriter::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+    std::shared_ptr<Profiler> profiler = m_sysdef->getProfiler();
+
+    if (m_recording)
+        {
+        if (timestep < m_window_start + m_steps)
+            {
+            return;
+            }
+
+        profiler->stopTrace();
+        m_recording = false;
+        write();
+        }
+
+    if (!(*m_window_trigger)(timestep))
+        {
+        return;
+        }
+
+    if (profiler->isTracing())
+        {
+        m_exec_conf->msg->warning() << "Another writer is recording a trace, skipping the trace at "
+                                    << "step " << timestep << "." << endl;
+        return;
+        }
+
+    m_exec_conf->msg->notice(6) << "TraceWriter: recording " << m_steps << " steps from step "
+                                << timestep << endl;
+
+#ifdef ENABLE_MPI
+    // start the window together so that the traces of the ranks share the origin
+    if (m_exec_conf->getNRanks() > 1)
+        {
+        MPI_Barrier(m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    profiler->startTrace();
+    m_recording = true;
+    m_window_start = timestep;
+    }
+
+void TraceWriter::notifyDetach()
+    {
+    if (m_recording)
+        {
+        m_sysdef->getProfiler()->stopTrace();
+        m_recording = false;
+        }
+    }
+
+/*! Gather the traces of all ranks on the root rank and write them in the Chrome trace JSON format.
+    The times in the file are in microseconds.
+
+    \note This method must be called collectively on all ranks.
+*/
+void TraceWriter::write()
+    {
+    std::shared_ptr<Profiler> profiler = m_sysdef->getProfiler();
+    const unsigned int rank = m_exec_conf->getRank();
+
+    std::ostringstream events;
+    events << std::fixed << std::setprecision(3);
+    events << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank
+           << ",\"tid\":0,\"args\":{\"name\":\"Rank " << rank << "\"}}";
+    events << ",\n{\"name\":\"process_sort_index\",\"ph\":\"M\",\"pid\":" << rank
+           << ",\"tid\":0,\"args\":{\"sort_index\":" << rank << "}}";
+
+    for (const Profiler::TraceStep& step : profiler->getTraceSteps())
+        {
+        events << ",\n{\"name\":\"Step " << step.timestep
+               << "\",\"cat\":\"step\",\"ph\":\"i\",\"s\":\"p\",\"ts\":" << double(step.start) / 1e3
+               << ",\"pid\":" << rank << ",\"tid\":0}";
+        }
+
+    for (const Profiler::TraceEvent& event : profiler->getTrace())
+        {
+        events << ",\n{\"name\":";
+        writeJSONString(events, *event.name);
+        events << ",\"cat\":\"" << event.category << "\",\"ph\":\"X\",\"ts\":"
+               << double(event.start) / 1e3 << ",\"dur\":" << double(event.duration) / 1e3
+               << ",\"pid\":" << rank << ",\"tid\":0,\"args\":{\"timestep\":" << event.timestep
+               << "}}";
+        }
+
+    std::vector<std::string> rank_events(1, events.str());
+#ifdef ENABLE_MPI
+    if (m_exec_conf->getNRanks() > 1)
+        {
+        gather_v(rank_events[0], rank_events, 0, m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    std::string filename = m_filename;
+    const std::string placeholder = "{timestep}";
+    size_t position = filename.find(placeholder);
+    if (position != std::string::npos)
+        {
+        filename.replace(position, placeholder.size(), std::to_string(m_window_start));
+        }
+
+    bool written = true;
+    if (m_exec_conf->isRoot())
+        {
+        std::ofstream file(filename);
+        file << "{\"displayTimeUnit\":\"ms\",\n\"otherData\":{\"timestep\":" << m_window_start
+             << ",\"steps\":" << m_steps << ",\"ranks\":" << m_exec_conf->getNRanks()
+             << "},\n\"traceEvents\":[\n";
+        for (unsigned int i = 0; i < rank_events.size(); i++)
+            {
+            file << (i > 0 ? ",\n" : "") << rank_events[i];
+            }
+        file << "\n]}\n";
+        file.close();
+        written = !file.fail();
+        }
+#ifdef ENABLE_MPI
+    bcast(written, 0, m_exec_conf->getMPICommunicator());
+#endif
+    if (!written)
+        {
+        throw std::runtime_error("Error writing " + filename);
+        }
+    }
+
+namespace detail
+    {
+void export_TraceWriter(pybind11::module& m)
+    {
+    pybind11::class_<TraceWriter, Analyzer, std::shared_ptr<TraceWriter>>(m, "TraceWriter")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            const std::string&,
+                            uint64_t>())
+        .def_property("trigger", &TraceWriter::getWindowTrigger, &TraceWriter::setWindowTrigger)
+        .def_property_readonly("filename", &TraceWriter::getFilename)
+        .def_property("steps", &TraceWriter::getSteps, &TraceWriter::setSteps)
+        .def_property_readonly("recording", &TraceWriter::isRecording);
+    }
+
+    } // end namespace detail
+
+    } // end namespace hoomd
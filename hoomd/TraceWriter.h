@@ -0,0 +1,143 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "Analyzer.h"
+
+#include <memory>
+#include <string>
+
+/*! \file TraceWriter.h
+    \brief Declares the TraceWriter class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+class TraceWriter;
+
+namespace detail
+    {
+//! Trigger that keeps a TraceWriter active while it records a window
+/*! TraceWindowTrigger is active on the steps where the user trigger is active and on every step
+    of a window that is being recorded, so that TraceWriter::analyze() is called at the end of the
+    window.
+*/
+class TraceWindowTrigger : public Trigger
+    {
+    public:
+    //! Construct the trigger
+    TraceWindowTrigger(const TraceWriter* writer) : m_writer(writer) { }
+
+    //! Test if the writer should be called
+    virtual bool compute(uint64_t timestep);
+
+    //! Find the next step on which the writer may be called
+    virtual uint64_t nextActive(uint64_t timestep);
+
+    //! Discard the cached inactive range
+    void reset()
+        {
+        resetCache();
+        }
+
+    private:
+    const TraceWriter* m_writer; //!< The writer that owns this trigger
+    };
+
+    } // end namespace detail
+
+//! Analyzer for writing event traces of the time step loop
+/*! When the user trigger is active, TraceWriter starts recording a trace with the Profiler of the
+    system. The trace covers the next \a steps steps: every region that ScopedProfile wraps (the
+    operations, the force and neighbor list computations, and the communication phases) and, on
+    the GPU, every autotuned kernel launch. At the end of the window, the root rank gathers the
+    traces of all ranks and writes them to a Chrome trace JSON file, which Perfetto and
+    chrome://tracing display. Each rank is a separate process in the trace.
+
+    The ranks synchronize when the window starts, and the times in the trace are relative to that
+    point. On the GPU, the profiler times the regions with hipEvents, so the regions show the
+    execution on the device while the step markers show the time that the host started the step.
+
+    The name of the file may contain "{timestep}", which is replaced by the first step of the
+    window.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT TraceWriter : public Analyzer
+    {
+    public:
+    //! Construct the writer
+    TraceWriter(std::shared_ptr<SystemDefinition> sysdef,
+                std::shared_ptr<Trigger> trigger,
+                const std::string& filename,
+                uint64_t steps);
+
+    //! Destructor
+    virtual ~TraceWriter();
+
+    //! Start or finish a trace window
+    virtual void analyze(uint64_t timestep);
+
+    //! Stop recording when detached
+    virtual void notifyDetach();
+
+    //! Get the trigger that starts the windows
+    std::shared_ptr<Trigger> getWindowTrigger() const
+        {
+        return m_window_trigger;
+        }
+
+    //! Set the trigger that starts the windows
+    void setWindowTrigger(std::shared_ptr<Trigger> trigger)
+        {
+        m_window_trigger = trigger;
+        std::static_pointer_cast<detail::TraceWindowTrigger>(m_trigger)->reset();
+        }
+
+    //! Get the name of the trace file
+    const std::string& getFilename() const
+        {
+        return m_filename;
+        }
+
+    //! Get the number of steps in each window
+    uint64_t getSteps() const
+        {
+        return m_steps;
+        }
+
+    //! Set the number of steps in each window
+    void setSteps(uint64_t steps);
+
+    //! Test if a window is being recorded
+    bool isRecording() const
+        {
+        return m_recording;
+        }
+
+    protected:
+    std::shared_ptr<Trigger> m_window_trigger; //!< Trigger that starts the windows
+    std::string m_filename;                    //!< Name of the trace file
+    uint64_t m_steps;                          //!< Number of steps in each window
+    bool m_recording;                          //!< True while a window is being recorded
+    uint64_t m_window_start;                   //!< First step of the current window
+
+    //! Write the recorded trace
+    void write();
+    };
+
+namespace detail
+    {
+//! Exports the TraceWriter class to python
+void export_TraceWriter(pybind11::module& m);
+
+    } // end namespace detail
+
+    } // end namespace hoomd
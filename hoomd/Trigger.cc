@@ -23,6 +23,17 @@ class TriggerPy : public Trigger
                                timestep // Argument(s)
         );
         }
+
+    // trampoline method
+    uint64_t nextActive(uint64_t timestep) override
+        {
+        PYBIND11_OVERLOAD_NAME(uint64_t,      // Return type
+                               Trigger,       // Parent class
+                               "next_active", // name of function in python
+                               nextActive,    // Name of function in C++
+                               timestep       // Argument(s)
+        );
+        }
     };
 
 namespace detail
@@ -38,7 +49,8 @@ void export_Trigger(pybind11::module& m)
     pybind11::class_<Trigger, TriggerPy, std::shared_ptr<Trigger>>(m, "Trigger")
         .def(pybind11::init<>())
         .def("__call__", &Trigger::operator())
-        .def("compute", &Trigger::compute);
+        .def("compute", &Trigger::compute)
+        .def("next_active", &Trigger::nextActive);
 
     pybind11::class_<PeriodicTrigger, Trigger, std::shared_ptr<PeriodicTrigger>>(m,
                                                                                  "PeriodicTrigger")
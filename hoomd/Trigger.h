@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <pybind11/iostream.h>
 #include <pybind11/pybind11.h>
@@ -20,12 +21,23 @@ namespace hoomd
  *  (in python) to implement custom behavior.
  *
  *  A Trigger may store internal staten and perform complex calculations to determine when it
+ *
+ *  Subclasses that can predict their next active time step implement nextActive(). When compute()
+ *  returns `false`, operator() caches the range of steps up to nextActive() and answers the queries
+ *  in that range without calling compute(). System evaluates the triggers of all operations on
+ *  every step, so the cache saves the virtual calls, and the Python calls of triggers implemented
+ *  in Python, on the steps where the operations are idle.
  */
 class PYBIND11_EXPORT Trigger
     {
     public:
+    /// Value of nextActive() for triggers that are never active again
+    static constexpr uint64_t NEVER = std::numeric_limits<uint64_t>::max();
+
     /// Construct a Trigger
-    Trigger() : m_last_timestep(-1), m_last_trigger(false) { }
+    Trigger() : m_last_timestep(-1), m_last_trigger(false), m_inactive_begin(0), m_inactive_end(0)
+        {
+        }
 
     virtual ~Trigger() { }
 
@@ -40,21 +52,73 @@ class PYBIND11_EXPORT Trigger
             {
             return m_last_trigger;
             }
-        else
+
+        m_last_timestep = timestep;
+        if (timestep >= m_inactive_begin && timestep < m_inactive_end)
             {
-            m_last_timestep = timestep;
-            m_last_trigger = compute(timestep);
+            m_last_trigger = false;
             return m_last_trigger;
             }
+
+        m_last_trigger = compute(timestep);
+        if (!m_last_trigger)
+            {
+            m_inactive_begin = timestep;
+            m_inactive_end = nextActive(timestep);
+            }
+        return m_last_trigger;
         }
 
     virtual bool compute(uint64_t timestep) = 0;
 
+    /** Find the earliest time step on which the trigger may be active, using the cache
+     *
+     *  @param timestep First time step to consider
+     *  @returns `timestep` when the trigger is active on `timestep`, otherwise the end of the
+     *    cached inactive range that contains `timestep`
+     *
+     *  Evaluates the trigger on `timestep` like operator() and calls nextActive() at most once.
+     */
+    uint64_t findNextActive(uint64_t timestep)
+        {
+        if ((*this)(timestep))
+            {
+            return timestep;
+            }
+        return std::max(m_inactive_end, timestep);
+        }
+
+    /** Find the earliest time step on which the trigger may be active
+     *
+     *  @param timestep First time step to consider
+     *  @returns A time step `next >= timestep` such that compute() is `false` on all steps in
+     *    [timestep, next), or NEVER when compute() is false on all later steps
+     *
+     *  The default implementation has no knowledge of the future and returns `timestep`.
+     */
+    virtual uint64_t nextActive(uint64_t timestep)
+        {
+        return timestep;
+        }
+
+    protected:
+    /// Discard the cached results, subclasses must call this when their parameters change
+    void resetCache()
+        {
+        m_last_timestep = -1;
+        m_inactive_begin = 0;
+        m_inactive_end = 0;
+        }
+
     private:
     /// Caches the last time step at which the trigger was computed
     uint64_t m_last_timestep;
     /// Caches whether the trigger was activated on m_last_timestep
     bool m_last_trigger;
+    /// First step of the range in which the trigger is known to be inactive
+    uint64_t m_inactive_begin;
+    /// End of the range in which the trigger is known to be inactive
+    uint64_t m_inactive_end;
     };
 
 /** Periodic trigger
@@ -83,10 +147,28 @@ class PYBIND11_EXPORT PeriodicTrigger : public Trigger
         return (timestep - m_phase) % m_period == 0;
         }
 
+    uint64_t nextActive(uint64_t timestep)
+        {
+        const uint64_t remainder = (timestep - m_phase) % m_period;
+        if (remainder == 0)
+            {
+            return timestep;
+            }
+
+        // before the phase, (timestep - m_phase) wraps around and is zero again at m_phase
+        uint64_t next = timestep + (m_period - remainder);
+        if (timestep < m_phase && m_phase < next)
+            {
+            next = m_phase;
+            }
+        return next < timestep ? NEVER : next;
+        }
+
     /// Set the period
     void setPeriod(uint64_t period)
         {
         m_period = period;
+        resetCache();
         }
 
     /// Get the period
@@ -99,6 +181,7 @@ class PYBIND11_EXPORT PeriodicTrigger : public Trigger
     void setPhase(uint64_t phase)
         {
         m_phase = phase;
+        resetCache();
         }
 
     /// Get the phase
@@ -128,6 +211,11 @@ class PYBIND11_EXPORT BeforeTrigger : public Trigger
         return timestep < m_timestep;
         }
 
+    uint64_t nextActive(uint64_t timestep)
+        {
+        return timestep < m_timestep ? timestep : NEVER;
+        }
+
     /// Get the timestep before which the trigger is active.
     uint64_t getTimestep() const
         {
@@ -140,6 +228,7 @@ class PYBIND11_EXPORT BeforeTrigger : public Trigger
         setTimestep(uint64_t timestep)
         {
         m_timestep = timestep;
+        resetCache();
         }
 
     protected:
@@ -160,6 +249,11 @@ class PYBIND11_EXPORT OnTrigger : public Trigger
         return timestep == m_timestep;
         }
 
+    uint64_t nextActive(uint64_t timestep)
+        {
+        return timestep <= m_timestep ? m_timestep : NEVER;
+        }
+
     /// Get the timestep when the trigger is active.
     uint64_t getTimestep() const
         {
@@ -172,6 +266,7 @@ class PYBIND11_EXPORT OnTrigger : public Trigger
         setTimestep(uint64_t timestep)
         {
         m_timestep = timestep;
+        resetCache();
         }
 
     protected:
@@ -192,6 +287,15 @@ class PYBIND11_EXPORT AfterTrigger : public Trigger
         return timestep > m_timestep;
         }
 
+    uint64_t nextActive(uint64_t timestep)
+        {
+        if (timestep > m_timestep)
+            {
+            return timestep;
+            }
+        return m_timestep == NEVER ? NEVER : m_timestep + 1;
+        }
+
     /// Get the timestep after which the trigger is active.
     uint64_t getTimestep() const
         {
@@ -204,6 +308,7 @@ class PYBIND11_EXPORT AfterTrigger : public Trigger
         setTimestep(uint64_t timestep)
         {
         m_timestep = timestep;
+        resetCache();
         }
 
     protected:
@@ -234,6 +339,7 @@ class PYBIND11_EXPORT NotTrigger : public Trigger
     void setTrigger(std::shared_ptr<Trigger> trigger)
         {
         m_trigger = trigger;
+        resetCache();
         }
 
     protected:
@@ -266,6 +372,17 @@ class PYBIND11_EXPORT AndTrigger : public Trigger
                            { return t->operator()(timestep); });
         }
 
+    /// The AND is inactive until all triggers may be active
+    uint64_t nextActive(uint64_t timestep)
+        {
+        uint64_t next = timestep;
+        for (auto& trigger : m_triggers)
+            {
+            next = std::max(next, trigger->nextActive(timestep));
+            }
+        return next;
+        }
+
     const std::vector<std::shared_ptr<Trigger>>& getTriggers() const
         {
         return m_triggers;
@@ -302,6 +419,17 @@ class PYBIND11_EXPORT OrTrigger : public Trigger
                            { return t->operator()(timestep); });
         }
 
+    /// The OR is inactive until any trigger may be active
+    uint64_t nextActive(uint64_t timestep)
+        {
+        uint64_t next = NEVER;
+        for (auto& trigger : m_triggers)
+            {
+            next = std::min(next, trigger->nextActive(timestep));
+            }
+        return next;
+        }
+
     const std::vector<std::shared_ptr<Trigger>>& getTriggers() const
         {
         return m_triggers;
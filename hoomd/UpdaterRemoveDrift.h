@@ -64,6 +64,7 @@ class UpdaterRemoveDrift : public Updater
             bcast(m_ref_positions, 0, m_exec_conf->getMPICommunicator());
             }
 #endif
+        m_ref_positions_changed = true;
         }
 
     //! Get reference positions as a (N_particles, 3) numpy array
@@ -142,6 +143,7 @@ class UpdaterRemoveDrift : public Updater
 
     protected:
     std::vector<vec3<Scalar>> m_ref_positions;
+    bool m_ref_positions_changed = true; //!< True when the reference positions were set
     };
 
 namespace detail
@@ -0,0 +1,166 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "UpdaterRemoveDriftGPU.cuh"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#include <hipcub/hipcub.hpp>
+#pragma GCC diagnostic pop
+
+/*! \file UpdaterRemoveDriftGPU.cu
+    \brief Defines GPU kernel code used by UpdaterRemoveDriftGPU
+*/
+
+namespace hoomd
+    {
+namespace kernel
+    {
+//! Gets the minimum image displacement of a particle from its reference position
+struct remove_drift_displacement
+    {
+    const Scalar4* d_pos;
+    const unsigned int* d_tag;
+    const Scalar3* d_ref_positions;
+    BoxDim box;
+    Scalar3 origin;
+
+    __device__ Scalar3 operator()(unsigned int i) const
+        {
+        const Scalar4 postype = d_pos[i];
+        Scalar3 r = make_scalar3(postype.x, postype.y, postype.z) - origin;
+        int3 image = make_int3(0, 0, 0);
+        box.wrap(r, image);
+        return box.minImage(r - d_ref_positions[d_tag[i]]);
+        }
+    };
+
+//! Adds two displacements
+struct remove_drift_add
+    {
+    __device__ Scalar3 operator()(const Scalar3& a, const Scalar3& b) const
+        {
+        return a + b;
+        }
+    };
+
+/*! \param d_sum Device memory to write the sum to
+    \param d_pos Particle positions
+    \param d_tag Particle tags
+    \param d_ref_positions Reference positions, indexed by tag
+    \param N Number of local particles
+    \param box Global simulation box
+    \param origin Origin of the box
+    \param alloc Allocator for the temporary storage of the reduction
+
+    The sum is written asynchronously, the caller must synchronize before reading it on the host.
+*/
+hipError_t gpu_remove_drift_sum(Scalar3* d_sum,
+                                const Scalar4* d_pos,
+                                const unsigned int* d_tag,
+                                const Scalar3* d_ref_positions,
+                                unsigned int N,
+                                const BoxDim& box,
+                                Scalar3 origin,
+                                CachedAllocator& alloc)
+    {
+    if (N == 0)
+        {
+        return hipMemsetAsync(d_sum, 0, sizeof(Scalar3));
+        }
+
+    hipcub::CountingInputIterator<unsigned int> indices(0);
+    hipcub::TransformInputIterator<Scalar3,
+                                   remove_drift_displacement,
+                                   hipcub::CountingInputIterator<unsigned int>>
+        displacements(indices,
+                      remove_drift_displacement {d_pos, d_tag, d_ref_positions, box, origin});
+    const Scalar3 zero = make_scalar3(0, 0, 0);
+
+    // determine the temporary storage size
+    void* d_temp_storage = NULL;
+    size_t temp_storage_bytes = 0;
+    hipcub::DeviceReduce::Reduce(d_temp_storage,
+                                 temp_storage_bytes,
+                                 displacements,
+                                 d_sum,
+                                 N,
+                                 remove_drift_add(),
+                                 zero);
+
+    d_temp_storage = alloc.getTemporaryBuffer<char>(temp_storage_bytes);
+    hipcub::DeviceReduce::Reduce(d_temp_storage,
+                                 temp_storage_bytes,
+                                 displacements,
+                                 d_sum,
+                                 N,
+                                 remove_drift_add(),
+                                 zero);
+    alloc.deallocate((char*)d_temp_storage);
+
+    return hipSuccess;
+    }
+
+//! Shifts the particles by the negative drift and wraps them back into the box
+__global__ void gpu_remove_drift_shift_kernel(Scalar4* d_pos,
+                                              int3* d_image,
+                                              unsigned int N,
+                                              BoxDim box,
+                                              Scalar3 drift)
+    {
+    const unsigned int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= N)
+        return;
+
+    Scalar4 postype = d_pos[i];
+    postype.x -= drift.x;
+    postype.y -= drift.y;
+    postype.z -= drift.z;
+    int3 image = d_image[i];
+    box.wrap(postype, image);
+    d_pos[i] = postype;
+    d_image[i] = image;
+    }
+
+/*! \param d_pos Particle positions
+    \param d_image Particle images
+    \param N Number of local particles
+    \param box Global simulation box
+    \param drift Average drift to remove
+    \param block_size Block size to execute
+*/
+hipError_t gpu_remove_drift_shift(Scalar4* d_pos,
+                                  int3* d_image,
+                                  unsigned int N,
+                                  const BoxDim& box,
+                                  Scalar3 drift,
+                                  unsigned int block_size)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_remove_drift_shift_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    const unsigned int run_block_size = min(block_size, max_block_size);
+    dim3 grid(N / run_block_size + 1, 1, 1);
+    dim3 threads(run_block_size, 1, 1);
+
+    hipLaunchKernelGGL((gpu_remove_drift_shift_kernel),
+                       dim3(grid),
+                       dim3(threads),
+                       0,
+                       0,
+                       d_pos,
+                       d_image,
+                       N,
+                       box,
+                       drift);
+
+    return hipSuccess;
+    }
+
+    } // end namespace kernel
+    } // end namespace hoomd
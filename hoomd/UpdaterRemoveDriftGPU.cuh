@@ -0,0 +1,40 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file UpdaterRemoveDriftGPU.cuh
+    \brief Declares GPU kernel code used by UpdaterRemoveDriftGPU
+*/
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/CachedAllocator.h"
+#include "hoomd/HOOMDMath.h"
+
+#ifndef __UPDATER_REMOVE_DRIFT_GPU_CUH__
+#define __UPDATER_REMOVE_DRIFT_GPU_CUH__
+
+namespace hoomd
+    {
+namespace kernel
+    {
+//! Sum the minimum image displacements of the particles from their reference positions
+hipError_t gpu_remove_drift_sum(Scalar3* d_sum,
+                                const Scalar4* d_pos,
+                                const unsigned int* d_tag,
+                                const Scalar3* d_ref_positions,
+                                unsigned int N,
+                                const BoxDim& box,
+                                Scalar3 origin,
+                                CachedAllocator& alloc);
+
+//! Shift the particles by the negative drift and wrap them back into the box
+hipError_t gpu_remove_drift_shift(Scalar4* d_pos,
+                                  int3* d_image,
+                                  unsigned int N,
+                                  const BoxDim& box,
+                                  Scalar3 drift,
+                                  unsigned int block_size);
+
+    } // end namespace kernel
+    } // end namespace hoomd
+
+#endif // __UPDATER_REMOVE_DRIFT_GPU_CUH__
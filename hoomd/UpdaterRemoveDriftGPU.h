@@ -0,0 +1,156 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file UpdaterRemoveDriftGPU.h
+    \brief Declares an updater that removes the average drift from the particles on the GPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+// inclusion guard
+#ifndef _REMOVE_DRIFT_UPDATER_GPU_H_
+#define _REMOVE_DRIFT_UPDATER_GPU_H_
+
+#include "hoomd/Autotuner.h"
+#include "hoomd/GPUFlags.h"
+#include "hoomd/GlobalArray.h"
+#include "hoomd/UpdaterRemoveDrift.h"
+#include "hoomd/UpdaterRemoveDriftGPU.cuh"
+
+namespace hoomd
+    {
+/** Removes the average particle drift on the GPU. The drift is summed and removed on the device,
+ * only the sum is copied to the host where it is reduced over the ranks. The device keeps a copy
+ * of the reference positions that is refreshed when they are set.
+ */
+class UpdaterRemoveDriftGPU : public UpdaterRemoveDrift
+    {
+    public:
+    //! Constructor
+    UpdaterRemoveDriftGPU(std::shared_ptr<SystemDefinition> sysdef,
+                          std::shared_ptr<Trigger> trigger,
+                          pybind11::array_t<double> ref_positions)
+        : UpdaterRemoveDrift(sysdef, trigger, ref_positions), m_sum(m_exec_conf)
+        {
+        if (!m_exec_conf->isCUDAEnabled())
+            {
+            throw std::runtime_error("Cannot initialize UpdaterRemoveDriftGPU on a CPU device.");
+            }
+
+        m_tuner.reset(new Autotuner<1>({AutotunerBase::makeBlockSizeRange(m_exec_conf)},
+                                       m_exec_conf,
+                                       "remove_drift"));
+        m_autotuners.push_back(m_tuner);
+        }
+
+    //! Take one timestep forward
+    virtual void update(uint64_t timestep)
+        {
+        Updater::update(timestep);
+
+        if (m_ref_positions_changed)
+            {
+            uploadReferencePositions();
+            }
+
+        ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(),
+                                       access_location::device,
+                                       access_mode::readwrite);
+        ArrayHandle<unsigned int> d_tag(this->m_pdata->getTags(),
+                                        access_location::device,
+                                        access_mode::read);
+        ArrayHandle<int3> d_image(this->m_pdata->getImages(),
+                                  access_location::device,
+                                  access_mode::readwrite);
+        ArrayHandle<Scalar3> d_ref_positions(m_device_ref_positions,
+                                             access_location::device,
+                                             access_mode::read);
+        const BoxDim box = this->m_pdata->getGlobalBox();
+
+        kernel::gpu_remove_drift_sum(m_sum.getDeviceFlags(),
+                                     d_postype.data,
+                                     d_tag.data,
+                                     d_ref_positions.data,
+                                     this->m_pdata->getN(),
+                                     box,
+                                     this->m_pdata->getOrigin(),
+                                     m_exec_conf->getCachedAllocator());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+
+        const Scalar3 sum = m_sum.readFlags();
+        Scalar r[3] = {sum.x, sum.y, sum.z};
+
+#ifdef ENABLE_MPI
+        if (this->m_pdata->getDomainDecomposition())
+            {
+            MPI_Allreduce(MPI_IN_PLACE,
+                          &r[0],
+                          3,
+                          MPI_HOOMD_SCALAR,
+                          MPI_SUM,
+                          m_exec_conf->getMPICommunicator());
+            }
+#endif
+
+        const Scalar3 rshift
+            = make_scalar3(r[0], r[1], r[2]) / Scalar(this->m_pdata->getNGlobal());
+
+        m_tuner->begin();
+        kernel::gpu_remove_drift_shift(d_postype.data,
+                                       d_image.data,
+                                       this->m_pdata->getN(),
+                                       box,
+                                       rshift,
+                                       m_tuner->getParam()[0]);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner->end();
+        }
+
+    protected:
+    GlobalArray<Scalar3> m_device_ref_positions; //!< Reference positions indexed by tag
+    GPUFlags<Scalar3> m_sum;                     //!< Displacement summed on the device
+    std::shared_ptr<Autotuner<1>> m_tuner;       //!< Autotuner for the block size
+
+    //! Copy the reference positions to the device array
+    void uploadReferencePositions()
+        {
+        if (m_device_ref_positions.getNumElements() != m_ref_positions.size())
+            {
+            GlobalArray<Scalar3> ref_positions(m_ref_positions.size(), m_exec_conf);
+            m_device_ref_positions.swap(ref_positions);
+            TAG_ALLOCATION(m_device_ref_positions);
+            }
+
+        ArrayHandle<Scalar3> h_ref_positions(m_device_ref_positions,
+                                             access_location::host,
+                                             access_mode::overwrite);
+        for (size_t i = 0; i < m_ref_positions.size(); i++)
+            {
+            h_ref_positions.data[i] = vec_to_scalar3(m_ref_positions[i]);
+            }
+        m_ref_positions_changed = false;
+        }
+    };
+
+namespace detail
+    {
+/// Export the UpdaterRemoveDriftGPU to python
+void export_UpdaterRemoveDriftGPU(pybind11::module& m)
+    {
+    pybind11::class_<UpdaterRemoveDriftGPU,
+                     UpdaterRemoveDrift,
+                     std::shared_ptr<UpdaterRemoveDriftGPU>>(m, "UpdaterRemoveDriftGPU")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            pybind11::array_t<double>>());
+    }
+
+    } // end namespace detail
+
+    } // end namespace hoomd
+
+#endif // _REMOVE_DRIFT_UPDATER_GPU_H_
@@ -6,6 +6,10 @@
 namespace hoomd
     {
 //* Trampoline for classes inherited in python
+/*! Several operations may share one variant and each evaluates it on every step. The trampoline
+    caches the value of the last time step so that a variant implemented in python is called once
+    per step.
+*/
 class VariantPy : public Variant
     {
     public:
@@ -15,12 +19,14 @@ class VariantPy : public Variant
     // trampoline method
     Scalar operator()(uint64_t timestep) override
         {
-        PYBIND11_OVERLOAD_NAME(Scalar,     // Return type
-                               Variant,    // Parent class
-                               "__call__", // name of function in python
-                               operator(), // Name of function in C++
-                               timestep    // Argument(s)
-        );
+        if (timestep == m_last_timestep)
+            {
+            return m_last_value;
+            }
+
+        m_last_value = evaluate(timestep);
+        m_last_timestep = timestep;
+        return m_last_value;
         }
 
     Scalar min() override
@@ -40,6 +46,24 @@ class VariantPy : public Variant
                                     max      // name of function
         );
         }
+
+    private:
+    /// Time step of the cached value
+    uint64_t m_last_timestep = UINT64_MAX;
+
+    /// Value at m_last_timestep
+    Scalar m_last_value = 0;
+
+    /// Call the python implementation
+    Scalar evaluate(uint64_t timestep)
+        {
+        PYBIND11_OVERLOAD_NAME(Scalar,     // Return type
+                               Variant,    // Parent class
+                               "__call__", // name of function in python
+                               operator(), // Name of function in C++
+                               timestep    // Argument(s)
+        );
+        }
     };
 
 namespace detail
@@ -7,6 +7,9 @@
 namespace hoomd
     {
 //* Trampoline for classes inherited in python
+/*! Caches the value of the last time step so that a box variant implemented in python is called
+    once per step by all operations that share it.
+*/
 class VectorVariantBoxPy : public VectorVariantBox
     {
     public:
@@ -15,6 +18,26 @@ class VectorVariantBoxPy : public VectorVariantBox
 
     // trampoline method
     array_type operator()(uint64_t timestep) override
+        {
+        if (timestep == m_last_timestep)
+            {
+            return m_last_value;
+            }
+
+        m_last_value = evaluate(timestep);
+        m_last_timestep = timestep;
+        return m_last_value;
+        }
+
+    private:
+    /// Time step of the cached value
+    uint64_t m_last_timestep = UINT64_MAX;
+
+    /// Value at m_last_timestep
+    array_type m_last_value {};
+
+    /// Call the python implementation
+    array_type evaluate(uint64_t timestep)
         {
         PYBIND11_OVERLOAD_NAME(array_type,       // Return type
                                VectorVariantBox, // Parent class
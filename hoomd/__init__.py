@@ -87,7 +87,7 @@ if version.hpmc_built:
 from hoomd.simulation import Simulation
 from hoomd.state import State
 from hoomd.operations import Operations
-from hoomd.snapshot import Snapshot
+from hoomd.snapshot import Snapshot, DistributedSnapshot
 
 _default_excepthook = sys.excepthook
 
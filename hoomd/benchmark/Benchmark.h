@@ -0,0 +1,387 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file Benchmark.h
+    \brief Declares the microbenchmark harness and synthetic system generators
+    \note This file should be included only by benchmark executables
+*/
+
+#pragma once
+
+#include "hoomd/ClockSource.h"
+#include "hoomd/ExecutionConfiguration.h"
+#include "hoomd/HOOMDVersion.h"
+#include "hoomd/SnapshotSystemData.h"
+#include "hoomd/SystemDefinition.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace hoomd
+    {
+namespace benchmark
+    {
+/// Run microbenchmarks and report the results as JSON
+/*! Each benchmark executable defines main() with HOOMD_BENCHMARK_MAIN, which constructs a
+    BenchmarkSuite from the command line, passes it to a function that calls run() once for each
+    benchmark, and returns the value of finish(). The command line options are:
+
+    - `--repeat N`: number of timed calls of each benchmark (default 20)
+    - `--warmup N`: number of untimed calls before the timed calls (default 3)
+    - `--scale X`: multiply the number of particles in the synthetic systems by X (default 1)
+    - `--filter S`: run only benchmarks whose names contain S
+    - `--output FILE`: write the JSON report to FILE instead of standard output
+    - `--gpu`: execute on the GPU (when built with ENABLE_HIP)
+
+    The report lists, for each benchmark, the number of particles and the minimum, median, mean,
+    and standard deviation of the time per call in seconds. The systems are generated from fixed
+    seeds, so repeated runs time the same configurations.
+*/
+class BenchmarkSuite
+    {
+    public:
+    /// Parse the command line
+    BenchmarkSuite(const std::string& name, int argc, char** argv) : m_name(name)
+        {
+        for (int i = 1; i < argc; i++)
+            {
+            std::string arg(argv[i]);
+            if (arg == "--gpu")
+                {
+                m_gpu = true;
+                continue;
+                }
+
+            if (i + 1 >= argc)
+                {
+                throw std::runtime_error("Missing value for benchmark option " + arg);
+                }
+
+            std::string value(argv[++i]);
+            if (arg == "--repeat")
+                m_repeat = (unsigned int)std::stoul(value);
+            else if (arg == "--warmup")
+                m_warmup = (unsigned int)std::stoul(value);
+            else if (arg == "--scale")
+                m_scale = std::stod(value);
+            else if (arg == "--filter")
+                m_filter = value;
+            else if (arg == "--output")
+                m_output = value;
+            else
+                throw std::runtime_error("Unknown benchmark option " + arg);
+            }
+
+        if (m_repeat == 0)
+            {
+            throw std::runtime_error("--repeat must be positive");
+            }
+
+        ExecutionConfiguration::executionMode mode
+            = m_gpu ? ExecutionConfiguration::GPU : ExecutionConfiguration::CPU;
+        m_exec_conf = std::make_shared<ExecutionConfiguration>(mode);
+        m_exec_conf->msg->setNoticeLevel(0);
+        }
+
+    /// Get the execution configuration to construct the systems with
+    std::shared_ptr<ExecutionConfiguration> getExecConf() const
+        {
+        return m_exec_conf;
+        }
+
+    /// Scale a nominal number of particles by the --scale option
+    unsigned int scaleN(unsigned int N) const
+        {
+        return std::max(1u, (unsigned int)std::lround(double(N) * m_scale));
+        }
+
+    /// Test if a benchmark is selected by the --filter option
+    bool isSelected(const std::string& name) const
+        {
+        return name.find(m_filter) != std::string::npos;
+        }
+
+    /// Time a benchmark
+    /*! \param name Name of the benchmark
+        \param N Number of particles in the benchmarked system
+        \param body Function to time, called with a distinct time step on each call
+
+        Set up the system before calling run(). Use isSelected() to skip expensive setup for
+        benchmarks that will not run.
+    */
+    void run(const std::string& name, unsigned int N, const std::function<void(uint64_t)>& body)
+        {
+        if (!isSelected(name))
+            return;
+
+        uint64_t timestep = 0;
+        for (unsigned int i = 0; i < m_warmup; i++)
+            {
+            body(timestep++);
+            }
+
+        std::vector<double> times(m_repeat);
+        for (unsigned int i = 0; i < m_repeat; i++)
+            {
+            synchronize();
+            int64_t start = m_clock.getTime();
+            body(timestep++);
+            synchronize();
+            times[i] = double(m_clock.getTime() - start) * 1e-9;
+            }
+
+        Result result;
+        result.name = name;
+        result.N = N;
+
+        std::sort(times.begin(), times.end());
+        result.min = times.front();
+        result.median = (times[(m_repeat - 1) / 2] + times[m_repeat / 2]) / 2.0;
+
+        double sum = 0.0;
+        for (double t : times)
+            sum += t;
+        result.mean = sum / double(m_repeat);
+
+        double sum_sq = 0.0;
+        for (double t : times)
+            sum_sq += (t - result.mean) * (t - result.mean);
+        result.stddev = std::sqrt(sum_sq / double(m_repeat));
+
+        m_results.push_back(result);
+        std::cerr << name << ": " << result.median << " s" << std::endl;
+        }
+
+    /// Write the report
+    /*! \returns The exit code for main()
+     */
+    int finish()
+        {
+        std::ostringstream s;
+        s.precision(9);
+        s << "{\n";
+        s << "  \"suite\": \"" << m_name << "\",\n";
+        s << "  \"hoomd_version\": \"" << BuildInfo::getVersion() << "\",\n";
+        s << "  \"compiler\": \"" << BuildInfo::getCXXCompiler() << "\",\n";
+        s << "  \"device\": \"" << (m_gpu ? "GPU" : "CPU") << "\",\n";
+        s << "  \"repeat\": " << m_repeat << ",\n";
+        s << "  \"warmup\": " << m_warmup << ",\n";
+        s << "  \"scale\": " << m_scale << ",\n";
+        s << "  \"benchmarks\": [";
+        for (size_t i = 0; i < m_results.size(); i++)
+            {
+            const Result& r = m_results[i];
+            s << (i == 0 ? "\n" : ",\n");
+            s << "    {\"name\": \"" << r.name << "\", \"N\": " << r.N << ", \"min\": " << r.min
+              << ", \"median\": " << r.median << ", \"mean\": " << r.mean
+              << ", \"stddev\": " << r.stddev << "}";
+            }
+        s << "\n  ]\n}\n";
+
+        if (m_output.empty())
+            {
+            std::cout << s.str();
+            }
+        else
+            {
+            std::ofstream f(m_output);
+            f << s.str();
+            if (!f)
+                {
+                std::cerr << "Unable to write " << m_output << std::endl;
+                return 1;
+                }
+            }
+        return 0;
+        }
+
+    private:
+    /// Timing statistics of one benchmark [s]
+    struct Result
+        {
+        std::string name;
+        unsigned int N;
+        double min;
+        double median;
+        double mean;
+        double stddev;
+        };
+
+    /// Wait for the device to complete all work
+    void synchronize()
+        {
+#ifdef ENABLE_HIP
+        if (m_exec_conf->isCUDAEnabled())
+            hipDeviceSynchronize();
+#endif
+        }
+
+    std::string m_name;
+    unsigned int m_repeat = 20;
+    unsigned int m_warmup = 3;
+    double m_scale = 1.0;
+    std::string m_filter;
+    std::string m_output;
+    bool m_gpu = false;
+
+    std::shared_ptr<ExecutionConfiguration> m_exec_conf;
+    ClockSource m_clock;
+    std::vector<Result> m_results;
+    };
+
+/// Generate a Lennard-Jones liquid
+/*! \param N Number of particles
+    \param density Number density
+    \param exec_conf Execution configuration
+    \param seed Random number seed
+
+    Place the particles on a simple cubic lattice in a cubic box and displace them randomly by up to
+    10% of the lattice spacing. All particles have type A.
+*/
+inline std::shared_ptr<SystemDefinition>
+makeLJLiquid(unsigned int N,
+             Scalar density,
+             std::shared_ptr<ExecutionConfiguration> exec_conf,
+             unsigned int seed = 1)
+    {
+    auto snapshot = std::make_shared<SnapshotSystemData<Scalar>>();
+    const Scalar L = std::cbrt(Scalar(N) / density);
+    snapshot->global_box = std::make_shared<BoxDim>(L);
+    snapshot->particle_data.resize(N);
+    snapshot->particle_data.type_mapping.push_back("A");
+
+    const unsigned int n = (unsigned int)std::ceil(std::cbrt(double(N)));
+    const Scalar a = L / Scalar(n);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(-0.1, 0.1);
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        unsigned int ix = i % n;
+        unsigned int iy = (i / n) % n;
+        unsigned int iz = i / (n * n);
+        snapshot->particle_data.pos[i]
+            = vec3<Scalar>((Scalar(ix) + Scalar(0.5) + Scalar(uniform(rng))) * a - L / Scalar(2.0),
+                           (Scalar(iy) + Scalar(0.5) + Scalar(uniform(rng))) * a - L / Scalar(2.0),
+                           (Scalar(iz) + Scalar(0.5) + Scalar(uniform(rng))) * a - L / Scalar(2.0));
+        }
+
+    return std::make_shared<SystemDefinition>(snapshot, exec_conf);
+    }
+
+/// Generate a melt of linear bead-spring polymers
+/*! \param n_chains Number of chains
+    \param chain_length Number of monomers in each chain
+    \param density Monomer number density
+    \param exec_conf Execution configuration
+    \param seed Random number seed
+
+    Grow each chain as a random walk with unit bond length from a random position in the box.
+    Monomers have type A and bonds type backbone.
+*/
+inline std::shared_ptr<SystemDefinition>
+makePolymerMelt(unsigned int n_chains,
+                unsigned int chain_length,
+                Scalar density,
+                std::shared_ptr<ExecutionConfiguration> exec_conf,
+                unsigned int seed = 1)
+    {
+    const unsigned int N = n_chains * chain_length;
+    auto snapshot = std::make_shared<SnapshotSystemData<Scalar>>();
+    const Scalar L = std::cbrt(Scalar(N) / density);
+    const BoxDim box(L);
+    snapshot->global_box = std::make_shared<BoxDim>(box);
+    snapshot->particle_data.resize(N);
+    snapshot->particle_data.type_mapping.push_back("A");
+    snapshot->bond_data.resize(n_chains * (chain_length - 1));
+    snapshot->bond_data.type_mapping.push_back("backbone");
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(-0.5, 0.5);
+    std::normal_distribution<double> normal;
+
+    unsigned int bond = 0;
+    for (unsigned int chain = 0; chain < n_chains; chain++)
+        {
+        Scalar3 pos = make_scalar3(Scalar(uniform(rng)) * L,
+                                   Scalar(uniform(rng)) * L,
+                                   Scalar(uniform(rng)) * L);
+        for (unsigned int monomer = 0; monomer < chain_length; monomer++)
+            {
+            unsigned int tag = chain * chain_length + monomer;
+            if (monomer > 0)
+                {
+                Scalar3 step
+                    = make_scalar3(Scalar(normal(rng)), Scalar(normal(rng)), Scalar(normal(rng)));
+                pos += step / std::sqrt(dot(step, step));
+
+                snapshot->bond_data.groups[bond].tag[0] = tag - 1;
+                snapshot->bond_data.groups[bond].tag[1] = tag;
+                bond++;
+                }
+
+            int3 img = make_int3(0, 0, 0);
+            Scalar3 wrapped = pos;
+            box.wrap(wrapped, img);
+            snapshot->particle_data.pos[tag] = vec3<Scalar>(wrapped);
+            snapshot->particle_data.image[tag] = img;
+            }
+        }
+
+    return std::make_shared<SystemDefinition>(snapshot, exec_conf);
+    }
+
+    } // end namespace benchmark
+    } // end namespace hoomd
+
+//! Define main() for a benchmark executable
+/*! \param name Name of the suite in the report
+    \param register_benchmarks Function that takes a BenchmarkSuite& and runs the benchmarks
+*/
+#ifdef ENABLE_MPI
+#define HOOMD_BENCHMARK_MAIN(name, register_benchmarks)                          \
+    int main(int argc, char** argv)                                              \
+        {                                                                        \
+        MPI_Init(&argc, &argv);                                                  \
+        int result = 1;                                                          \
+        try                                                                      \
+            {                                                                    \
+            hoomd::benchmark::BenchmarkSuite suite(name, argc, argv);            \
+            register_benchmarks(suite);                                          \
+            result = suite.finish();                                             \
+            }                                                                    \
+        catch (std::exception & e)                                               \
+            {                                                                    \
+            std::cerr << "**ERROR** " << e.what() << std::endl;                  \
+            }                                                                    \
+        MPI_Finalize();                                                          \
+        return result;                                                           \
+        }
+#else
+#define HOOMD_BENCHMARK_MAIN(name, register_benchmarks)                          \
+    int main(int argc, char** argv)                                              \
+        {                                                                        \
+        int result = 1;                                                          \
+        try                                                                      \
+            {                                                                    \
+            hoomd::benchmark::BenchmarkSuite suite(name, argc, argv);            \
+            register_benchmarks(suite);                                          \
+            result = suite.finish();                                             \
+            }                                                                    \
+        catch (std::exception & e)                                               \
+            {                                                                    \
+            std::cerr << "**ERROR** " << e.what() << std::endl;                  \
+            }                                                                    \
+        return result;                                                           \
+        }
+#endif
@@ -0,0 +1,111 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/CellList.h"
+#include "hoomd/GSDDumpWriter.h"
+#include "hoomd/ParticleGroup.h"
+#include "hoomd/SFCPackTuner.h"
+#include "hoomd/filter/ParticleFilterAll.h"
+
+#ifdef ENABLE_HIP
+#include "hoomd/CellListGPU.h"
+#include "hoomd/SFCPackTunerGPU.h"
+#endif
+
+#include "hoomd/benchmark/Benchmark.h"
+
+#include <cstdio>
+
+using namespace hoomd;
+using namespace hoomd::benchmark;
+
+//! Benchmark the core data structures and I/O
+void benchmark_core(BenchmarkSuite& suite)
+    {
+    auto exec_conf = suite.getExecConf();
+    const unsigned int N = suite.scaleN(64000);
+
+    if (suite.isSelected("CellList/lj_liquid"))
+        {
+        auto sysdef = makeLJLiquid(N, Scalar(0.8), exec_conf);
+
+        std::shared_ptr<CellList> cl;
+#ifdef ENABLE_HIP
+        if (exec_conf->isCUDAEnabled())
+            cl = std::make_shared<CellListGPU>(sysdef);
+        else
+#endif
+            cl = std::make_shared<CellList>(sysdef);
+        cl->setNominalWidth(Scalar(2.9));
+
+        suite.run("CellList/lj_liquid", N, [&](uint64_t timestep) { cl->compute(timestep); });
+        }
+
+    if (suite.isSelected("SFCPackTuner/lj_liquid"))
+        {
+        auto sysdef = makeLJLiquid(N, Scalar(0.8), exec_conf);
+        auto trigger = std::make_shared<PeriodicTrigger>(1);
+
+        std::shared_ptr<SFCPackTuner> sorter;
+#ifdef ENABLE_HIP
+        if (exec_conf->isCUDAEnabled())
+            sorter = std::make_shared<SFCPackTunerGPU>(sysdef, trigger);
+        else
+#endif
+            sorter = std::make_shared<SFCPackTuner>(sysdef, trigger);
+
+        suite.run("SFCPackTuner/lj_liquid",
+                  N,
+                  [&](uint64_t timestep) { sorter->update(timestep); });
+        }
+
+    if (suite.isSelected("SFCPackTuner/polymer_melt"))
+        {
+        auto sysdef = makePolymerMelt(N / 100, 100, Scalar(0.85), exec_conf);
+        auto trigger = std::make_shared<PeriodicTrigger>(1);
+
+        std::shared_ptr<SFCPackTuner> sorter;
+#ifdef ENABLE_HIP
+        if (exec_conf->isCUDAEnabled())
+            sorter = std::make_shared<SFCPackTunerGPU>(sysdef, trigger);
+        else
+#endif
+            sorter = std::make_shared<SFCPackTuner>(sysdef, trigger);
+
+        suite.run("SFCPackTuner/polymer_melt",
+                  sysdef->getParticleData()->getNGlobal(),
+                  [&](uint64_t timestep) { sorter->update(timestep); });
+        }
+
+    if (suite.isSelected("GSDDumpWriter/polymer_melt"))
+        {
+        auto sysdef = makePolymerMelt(N / 100, 100, Scalar(0.85), exec_conf);
+        auto group = std::make_shared<ParticleGroup>(sysdef, std::make_shared<ParticleFilterAll>());
+        const std::string fname = "benchmark_core.gsd";
+
+            {
+            // truncate to keep the file at one frame
+            auto writer = std::make_shared<GSDDumpWriter>(sysdef,
+                                                          std::make_shared<PeriodicTrigger>(1),
+                                                          fname,
+                                                          group,
+                                                          "wb",
+                                                          true);
+
+            suite.run("GSDDumpWriter/polymer_melt",
+                      sysdef->getParticleData()->getNGlobal(),
+                      [&](uint64_t timestep)
+                      {
+                          writer->analyze(timestep);
+                          writer->flush();
+                      });
+            }
+
+        std::remove(fname.c_str());
+        }
+    }
+
+HOOMD_BENCHMARK_MAIN("core", benchmark_core)
@@ -26,7 +26,8 @@ from hoomd import Simulation
 
 logger = logging.getLogger()
 
-pytest_plugins = ("hoomd.pytest_plugin_validate",)
+pytest_plugins = ("hoomd.pytest_plugin_validate",
+                  "hoomd.pytest_plugin_performance")
 
 devices = [hoomd.device.CPU]
 _n_available_gpu = len(hoomd.device.GPU.get_available_devices())
@@ -564,6 +565,7 @@ def autotuned_kernel_parameter_check(instance, activate, all_optional=False):
         # CPU instances have no parameters and are always complete.
         assert initial_kernel_parameters == {}
         assert instance.is_tuning_complete
+        assert instance.kernel_telemetry == {}
     else:
         # GPU instances have parameters and start incomplete.
         assert initial_kernel_parameters != {}
@@ -587,6 +589,13 @@ def autotuned_kernel_parameter_check(instance, activate, all_optional=False):
         activate()
         assert instance.kernel_parameters == initial_kernel_parameters
 
+        # The telemetry reports the current parameters of the same kernels.
+        telemetry = instance.kernel_telemetry
+        assert telemetry.keys() == initial_kernel_parameters.keys()
+        for name, kernel_telemetry in telemetry.items():
+            assert kernel_telemetry['parameter'] == initial_kernel_parameters[
+                name]
+
 
 class ListWriter(hoomd.custom.Action):
     """Log a single quantity to a list.
@@ -8,6 +8,9 @@ via an `Action` subclass that executes during the simulation's run loop.
 Use this to prototype new simulation methods in Python, analyze the system state
 while the simulation progresses, or write output to custom file formats.
 
+`PluginOperation` runs actions implemented in C++ and loaded from a shared
+library at run time. Use these when a custom action is too slow in Python.
+
 See Also:
     `hoomd.tune.CustomTuner`
 
@@ -21,3 +24,4 @@ See Also:
 from hoomd.custom.custom_action import Action, _InternalAction
 from hoomd.custom.custom_operation import (CustomOperation,
                                            _InternalCustomOperation)
+from hoomd.custom.plugin_operation import PluginOperation
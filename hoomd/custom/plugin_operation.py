@@ -0,0 +1,78 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+"""Implement PluginOperation."""
+
+from hoomd.operation import TriggeredOperation
+from hoomd import _hoomd
+
+
+class PluginOperation(TriggeredOperation):
+    """Operation implemented in a C++ action plugin library.
+
+    This is the parent class for `hoomd.tune.Plugin`, `hoomd.update.Plugin`,
+    and `hoomd.write.Plugin`. These classes load an action from a shared
+    library at run time and add it to the simulation operations.
+
+    An action plugin is a shared library compiled against an installed
+    **HOOMD-blue**. It defines its entry points with the
+    ``HOOMD_ACTION_PLUGIN`` macro from ``hoomd/ActionPlugin.h`` and registers
+    each action class by name:
+
+    .. code-block:: c++
+
+        #include <hoomd/ActionPlugin.h>
+
+        HOOMD_ACTION_PLUGIN(registry)
+            {
+            registry.addUpdater<ScaleVelocities>("ScaleVelocities");
+            }
+
+    Each action class derives from the C++ ``Updater``, ``Analyzer``, or
+    ``Tuner`` class and provides a constructor that takes the system
+    definition, the trigger, and a ``pybind11::dict`` of parameters.
+    **HOOMD-blue** calls the action directly in the run loop, without a call
+    into Python. The action may access the particle data with ``ArrayHandle``
+    like any other C++ operation.
+
+    **HOOMD-blue** refuses to load a plugin compiled against a different
+    version or build configuration. See ``example_plugins/action_plugin`` for
+    a complete example.
+
+    Note:
+        This object should not be instantiated or subclassed by an user.
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to call the
+            action.
+    """
+
+    _cpp_create_method = None
+
+    def __init__(self, trigger, library, name, parameters=None):
+        super().__init__(trigger)
+        self._library = str(library)
+        self._name = str(name)
+        self._parameters = dict(parameters) if parameters is not None else {}
+
+    def _attach_hook(self):
+        """Load the plugin library and create the C++ action."""
+        plugin = _hoomd.ActionPlugin(self._library)
+        create = getattr(plugin, self._cpp_create_method)
+        self._cpp_obj = create(self._name, self._simulation.state._cpp_sys_def,
+                               self.trigger, self._parameters)
+
+    @property
+    def library(self):
+        """str: Path to the plugin library."""
+        return self._library
+
+    @property
+    def name(self):
+        """str: Name of the action in the plugin library."""
+        return self._name
+
+    @property
+    def parameters(self):
+        """dict: Parameters passed to the constructor of the action."""
+        return dict(self._parameters)
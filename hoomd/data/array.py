@@ -17,6 +17,23 @@ class HOOMDArrayError(RuntimeError):
     pass
 
 
+def _export_dlpack(array, stream, dl_device, copy):
+    """Export the buffer of a HOOMD array through the ``__dlpack__`` protocol.
+
+    The tensor refers to HOOMD's memory, so it is only valid inside the context
+    manager that created the array.
+    """
+    name = array.__class__.__name__
+    if not array._callback():
+        raise HOOMDArrayError(f"Cannot access {name} outside context manager.")
+    if copy:
+        raise BufferError(f"{name} only exports its buffer without a copy.")
+    if dl_device is not None and tuple(dl_device) != tuple(
+            array.__dlpack_device__()):
+        raise BufferError(f"{name} cannot export its buffer to another device.")
+    return array._buffer.__dlpack__(stream=stream)
+
+
 def _wrap_class_factory(methods_wrap_func_list,
                         *args,
                         allow_exceptions=False,
@@ -440,6 +457,21 @@ class HOOMDArray(metaclass=_wrap_class_factory(_wrap_list)):
         arr = self._coerce_to_ndarray()
         return getattr(arr, item)
 
+    def __dlpack__(self, *, stream=None, max_version=None, dl_device=None,
+                   copy=None):
+        """Export the underlying data buffer as a DLPack tensor without a copy.
+
+        Frameworks such as PyTorch and JAX import the buffer with their
+        ``from_dlpack`` functions. The tensor refers to HOOMD's memory, so use
+        it only in the context manager where the array was created. DLPack has
+        no read only flag: do not write to tensors of read only arrays.
+        """
+        return _export_dlpack(self, stream, dl_device, copy)
+
+    def __dlpack_device__(self):
+        """Get the DLPack device type and id of the buffer."""
+        return self._buffer.__dlpack_device__()
+
     @property
     def __array_interface__(self):
         """Returns the information for a copy of the underlying data buffer.
@@ -542,6 +574,23 @@ if hoomd.version.gpu_enabled:
         def __cuda_array_interface__(self):
             return deepcopy(self._buffer.__cuda_array_interface__)
 
+        def __dlpack__(self,
+                       *,
+                       stream=None,
+                       max_version=None,
+                       dl_device=None,
+                       copy=None):
+            """Export the GPU buffer as a DLPack tensor without a copy.
+
+            HOOMD-blue queues its work on the default stream. When the
+            consumer passes another ``stream``, that stream waits for the work
+            queued so far.
+            """
+            return _export_dlpack(self, stream, dl_device, copy)
+
+        def __dlpack_device__(self):
+            return self._buffer.__dlpack_device__()
+
         @property
         def read_only(self):
             return self._buffer.read_only
@@ -751,6 +800,15 @@ for a list of methods.
 Tip:
     Use, ``cupy.add``, ``cupy.multiply``, etc. for binary operations on the GPU.
 
+Note:
+    `HOOMDGPUArray` also implements the `DLPack
+    <https://dmlc.github.io/dlpack/latest/>`_ protocol (``__dlpack__`` and
+    ``__dlpack_device__``). PyTorch, JAX, and other frameworks can import the
+    buffer without a copy, e.g. ``torch.from_dlpack(data.particles.position)``.
+    The consumer's stream waits for the work that HOOMD-blue queued on the
+    default stream. When the consumer writes to the buffer (e.g. forces) on
+    another stream, synchronize that stream before the context manager exits.
+
 Note:
     Packages like Numba and PyTorch can use `HOOMDGPUArray` without CuPy
     installed. Any package that supports version 2 of the
@@ -38,11 +38,20 @@ See Also:
 """
 
 import contextlib
+import hashlib
 import hoomd
 from hoomd import _hoomd
 import warnings
 
 
+def _build_identifier():
+    """Get a string that identifies the HOOMD-blue build."""
+    build = (hoomd.version.version, hoomd.version.git_sha1,
+             hoomd.version.compile_flags, hoomd.version.gpu_api_version,
+             hoomd.version.gpu_platform, hoomd.version.floating_point_precision)
+    return hashlib.sha1(repr(build).encode()).hexdigest()
+
+
 class NoticeFile:
     """A file-like object that writes to a `Device` notice stream.
 
@@ -115,9 +124,12 @@ class Device:
     HOOMD will use this value. You can also set `num_cpu_threads` explicitly.
 
     Note:
-        At this time **very few** features use TBB for threading. Most users
-        should employ MPI for parallel simulations. See `features` for more
-        information.
+        On the CPU, the pair and bond forces, the neighbor list, the
+        `hoomd.md.methods.ConstantVolume` integration method, the thermodynamic
+        quantities, and the packing of the ghost particle updates use TBB
+        threads. Combine MPI ranks with TBB threads to reduce the number of
+        ghost particles when running many ranks per node. See `features` for
+        more information.
     """
 
     def __init__(self, communicator, notice_level, message_filename):
@@ -249,6 +261,33 @@ class Device:
         else:
             self._cpp_exec_conf.setNumThreads(int(num_cpu_threads))
 
+    @property
+    def pin_cpu_threads(self):
+        """bool: Pin each TBB thread to one CPU.
+
+        When `True`, each TBB thread runs on one of the CPUs in the affinity
+        mask of the process. Threads then keep processing the same parts of the
+        particle, neighbor list, and force arrays, which HOOMD places in memory
+        near the threads that use them on NUMA systems. When running several
+        MPI ranks per node, bind each rank to a separate set of cores with the
+        MPI launcher. Defaults to `False`.
+
+        Only available on Linux.
+        """
+        if not hoomd.version.tbb_enabled:
+            return False
+        else:
+            return self._cpp_exec_conf.getThreadAffinity()
+
+    @pin_cpu_threads.setter
+    def pin_cpu_threads(self, value):
+        if not hoomd.version.tbb_enabled:
+            self._cpp_msg.warning(
+                "HOOMD was compiled without thread support, ignoring request "
+                "to pin threads.\n")
+        else:
+            self._cpp_exec_conf.setThreadAffinity(bool(value))
+
     def notice(self, message, level=1):
         """Write a notice message.
 
@@ -420,6 +459,148 @@ class GPU(Device):
     def gpu_error_checking(self, new_bool):
         self._cpp_exec_conf.setCUDAErrorChecking(new_bool)
 
+    @property
+    def memory_pool(self):
+        """bool: Whether to draw array allocations from memory pools.
+
+        When `True`, memory that HOOMD-blue frees on the GPU and the page-locked
+        host memory used to transfer data to it are kept in a pool and reused
+        by later allocations of a similar size. This avoids costly calls to the
+        GPU runtime when arrays grow, shrink, or are recreated during a run, at
+        the cost of holding on to memory that is not in use. Set to `False`
+        (the default) to free the pooled memory and allocate memory directly.
+
+        .. rubric:: Example:
+
+        .. skip: next if(gpu_not_available)
+
+        .. code-block:: python
+
+            gpu.memory_pool = True
+        """
+        return self._cpp_exec_conf.memoryPoolEnabled()
+
+    @memory_pool.setter
+    def memory_pool(self, new_bool):
+        self._cpp_exec_conf.setMemoryPoolEnabled(new_bool)
+
+    @property
+    def memory_pool_stats(self):
+        """dict: Allocation statistics of the memory pools.
+
+        The ``'host'`` and ``'managed'`` keys give the statistics of the
+        page-locked host and managed memory pools, and ``'device'`` gives a list
+        with the statistics of the device memory pool of each active GPU. Each
+        entry is a `dict` with the number of ``'allocations'`` requested, the
+        number of ``'hits'`` served from the pool, the number of
+        ``'system_allocations'`` made by the GPU runtime, and the
+        ``'bytes_in_use'``, ``'bytes_cached'``, and ``'peak_bytes_in_use'``.
+
+        .. rubric:: Example:
+
+        .. skip: next if(gpu_not_available)
+
+        .. code-block:: python
+
+            stats = gpu.memory_pool_stats
+        """
+        return self._cpp_exec_conf.getMemoryPoolStats()
+
+    @property
+    def autotuner_cache(self):
+        """str: Name of the file that caches autotuner results.
+
+        When set, autotuned operations (see `hoomd.operation.AutotunedObject`)
+        look up the kernel parameters in this file before they start tuning and
+        skip tuning the kernels that have stored values. When tuning a kernel
+        completes, the operation stores the optimal parameters in the file.
+        Later runs and jobs that set the same file start with the tuned values.
+
+        The cache stores separate values for each GPU model, HOOMD-blue build,
+        and range of system sizes (the global number of particles rounded up to
+        a power of two). Set the cache before the first call to
+        `hoomd.Simulation.run`. `hoomd.Operations.tune_kernel_parameters` always
+        tunes and stores the new optimal values.
+
+        Set to `None` (the default) to tune every kernel in every run.
+
+        .. rubric:: Example:
+
+        .. skip: next if(gpu_not_available)
+
+        .. code-block:: python
+
+            gpu.autotuner_cache = path / 'autotuner_cache.txt'
+        """
+        cache = self._cpp_exec_conf.getAutotunerCache()
+        if cache is None:
+            return None
+        return cache.filename
+
+    @autotuner_cache.setter
+    def autotuner_cache(self, filename):
+        if filename is None:
+            self._cpp_exec_conf.setAutotunerCache(None)
+        else:
+            self._cpp_exec_conf.setAutotunerCache(
+                _hoomd.AutotunerCache(self._cpp_exec_conf, str(filename),
+                                      _build_identifier()))
+
+    @property
+    def autotuner_successive_halving(self):
+        """bool: Prune the autotuner parameter space by successive halving.
+
+        Autotuners normally time every kernel parameter several times (see
+        `hoomd.operation.AutotunedObject`). When `True`, each scan instead
+        proceeds in rounds that time every remaining parameter once and keep
+        the faster half. This takes about two timed launches per parameter,
+        which shortens the tuning phase at the cost of more noise in the
+        timings of the slow parameters.
+
+        Set before the operations attach or call
+        `hoomd.Operations.tune_kernel_parameters` after setting to apply it to
+        the next scan.
+
+        .. rubric:: Example:
+
+        .. skip: next if(gpu_not_available)
+
+        .. code-block:: python
+
+            gpu.autotuner_successive_halving = True
+        """
+        return self._cpp_exec_conf.getAutotunerSuccessiveHalving()
+
+    @autotuner_successive_halving.setter
+    def autotuner_successive_halving(self, successive_halving):
+        self._cpp_exec_conf.setAutotunerSuccessiveHalving(
+            bool(successive_halving))
+
+    @property
+    def autotuner_stop_threshold(self):
+        """float: Spread below which successive halving scans stop early.
+
+        After each round of successive halving (see
+        `autotuner_successive_halving`), the scan stops and selects the fastest
+        parameter when the slowest remaining parameter is less than
+        `autotuner_stop_threshold` times slower than the fastest (as a fraction,
+        e.g. 0.05 for 5%). The default of 0 continues until one parameter
+        remains.
+
+        .. rubric:: Example:
+
+        .. skip: next if(gpu_not_available)
+
+        .. code-block:: python
+
+            gpu.autotuner_stop_threshold = 0.05
+        """
+        return self._cpp_exec_conf.getAutotunerStopThreshold()
+
+    @autotuner_stop_threshold.setter
+    def autotuner_stop_threshold(self, threshold):
+        self._cpp_exec_conf.setAutotunerStopThreshold(float(threshold))
+
     @property
     def compute_capability(self):
         """tuple(int, int): Compute capability of the device.
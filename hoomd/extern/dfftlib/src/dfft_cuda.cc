@@ -52,6 +52,48 @@
  * Implementation of the distributed FFT
  *****************************************************************************/
 
+/*
+ * Exchange device buffers between all ranks
+ *
+ * With a GPU-aware MPI library, MPI reads and writes the device buffers directly.
+ * Otherwise, the data is staged through the pinned host buffers.
+ */
+static void dfft_cuda_alltoallv(cuda_cpx_t *d_send,
+                                int send_size,
+                                cuda_cpx_t *d_recv,
+                                int recv_size,
+                                cuda_cpx_t *h_stage_in,
+                                cuda_cpx_t *h_stage_out,
+                                int *nsend,
+                                int *offset_send,
+                                int *nrecv,
+                                int *offset_recv,
+                                MPI_Comm comm,
+                                int check_err)
+    {
+#ifdef ENABLE_GPU_AWARE_MPI
+    // MPI does not order its device accesses with the kernels that produced the data
+    hipDeviceSynchronize();
+    if (check_err) CHECK_CUDA();
+
+    MPI_Alltoallv(d_send, nsend, offset_send, MPI_BYTE,
+                  d_recv, nrecv, offset_recv, MPI_BYTE,
+                  comm);
+#else
+    // stage into host buf
+    hipMemcpy(h_stage_in, d_send, sizeof(cuda_cpx_t)*send_size,hipMemcpyDefault);
+    if (check_err) CHECK_CUDA();
+
+    MPI_Alltoallv(h_stage_in, nsend, offset_send, MPI_BYTE,
+                  h_stage_out, nrecv, offset_recv, MPI_BYTE,
+                  comm);
+
+    // copy back received data
+    hipMemcpy(d_recv,h_stage_out, sizeof(cuda_cpx_t)*recv_size,hipMemcpyDefault);
+    if (check_err) CHECK_CUDA();
+#endif
+    }
+
 /*
  * n-dimensional redistribute from group-cyclic with cycle c0 to cycle c1
  * 1 <=c0,c1 <= pdim[i]
@@ -275,17 +317,9 @@ void dfft_cuda_redistribute_nd( dfft_plan *plan,int stage, int size_in, int *emb
     MPI_Barrier(plan->comm);
 
     /* communicate */
-    // stage into host buf
-    hipMemcpy(plan->h_stage_in, plan->d_scratch, sizeof(cuda_cpx_t)*size_in,hipMemcpyDefault);
-    if (plan->check_cuda_errors) CHECK_CUDA();
-
-    MPI_Alltoallv(plan->h_stage_in,plan->nsend, plan->offset_send, MPI_BYTE,
-                  plan->h_stage_out,plan->nrecv, plan->offset_recv, MPI_BYTE,
-                  plan->comm);
-
-    // copy back received data
-    hipMemcpy(plan->d_scratch_2,plan->h_stage_out, sizeof(cuda_cpx_t)*size_in,hipMemcpyDefault);
-    if (plan->check_cuda_errors) CHECK_CUDA();
+    dfft_cuda_alltoallv(plan->d_scratch, size_in, plan->d_scratch_2, size_in,
+        plan->h_stage_in, plan->h_stage_out, plan->nsend, plan->offset_send,
+        plan->nrecv, plan->offset_recv, plan->comm, plan->check_cuda_errors);
 
     /* unpack data */
     if (dir)
@@ -435,17 +469,8 @@ void dfft_cuda_redistribute_block_to_cyclic_1d(
     MPI_Barrier(comm);
 
     /* communicate */
-    // stage into host buf
-    hipMemcpy(h_stage_in, d_scratch, sizeof(cuda_cpx_t)*npackets*size,hipMemcpyDefault);
-    if (check_err) CHECK_CUDA();
-
-    MPI_Alltoallv(h_stage_in,dfft_nsend, dfft_offset_send, MPI_BYTE,
-                  h_stage_out, dfft_nrecv, dfft_offset_recv, MPI_BYTE,
-                  comm);
-
-    // copy back received data
-    hipMemcpy(d_work,h_stage_out, sizeof(cuda_cpx_t)*size_in,hipMemcpyDefault);
-    if (check_err) CHECK_CUDA();
+    dfft_cuda_alltoallv(d_scratch, npackets*size, d_work, size_in, h_stage_in, h_stage_out,
+        dfft_nsend, dfft_offset_send, dfft_nrecv, dfft_offset_recv, comm, check_err);
     }
 
 /* Redistribute from group-cyclic with cycle c0 to cycle c0>=c1
@@ -649,33 +674,16 @@ void dfft_cuda_redistribute_cyclic_to_block_1d(int *dim,
 
         /* perform communication */
         MPI_Barrier(comm);
-        // stage into host buf
-        hipMemcpy(h_stage_in, d_scratch, sizeof(cuda_cpx_t)*length*stride,hipMemcpyDefault);
-        if (check_err) CHECK_CUDA();
-
-        MPI_Alltoallv(h_stage_in,dfft_nsend, dfft_offset_send, MPI_BYTE,
-                      h_stage_out, dfft_nrecv, dfft_offset_recv, MPI_BYTE,
-                      comm);
-
-        // copy back received data
-        hipMemcpy(d_work,h_stage_out, sizeof(cuda_cpx_t)*npackets*size,hipMemcpyDefault);
-        if (check_err) CHECK_CUDA();
+        dfft_cuda_alltoallv(d_scratch, length*stride, d_work, npackets*size, h_stage_in,
+            h_stage_out, dfft_nsend, dfft_offset_send, dfft_nrecv, dfft_offset_recv, comm,
+            check_err);
         }
     else
         {
         /* perform communication */
         MPI_Barrier(comm);
-        // stage into host buf
-        hipMemcpy(h_stage_in, d_work, sizeof(cuda_cpx_t)*size_in,hipMemcpyDefault);
-        if (check_err) CHECK_CUDA();
-
-        MPI_Alltoallv(h_stage_in,dfft_nsend, dfft_offset_send, MPI_BYTE,
-                      h_stage_out, dfft_nrecv, dfft_offset_recv, MPI_BYTE,
-                      comm);
-
-        // copy back received data
-        hipMemcpy(d_scratch,h_stage_out, sizeof(cuda_cpx_t)*npackets*size,hipMemcpyDefault);
-        if (check_err) CHECK_CUDA();
+        dfft_cuda_alltoallv(d_work, size_in, d_scratch, npackets*size, h_stage_in, h_stage_out,
+            dfft_nsend, dfft_offset_send, dfft_nrecv, dfft_offset_recv, comm, check_err);
 
         /* unpack */
         gpu_c2b_unpack(npackets*size, length, c0, c1, size, j0_new_local, stride, rev, d_work, d_scratch);
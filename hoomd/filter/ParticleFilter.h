@@ -4,6 +4,8 @@
 #pragma once
 
 #include "../SystemDefinition.h"
+#include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <pybind11/pybind11.h>
 #include <vector>
@@ -31,6 +33,20 @@ namespace hoomd
     rank.
 
     The base class getSelectedTags() method returns an empty vector.
+
+    <b>Incremental selection</b> Filters that can test a single particle
+    return true from isIncremental() and implement isSelected(). Groups then
+    update their members when particles are added, removed, or retyped by
+    testing only those particles instead of calling getSelectedTags().
+    isSelected() is called on every rank and the results are combined with a
+    logical or, so it must give the same result as a search for the tag in
+    the output of getSelectedTags() on the same rank.
+
+    <b>Selection masks</b> getSelectedMask() sets one bit per rank local particle index in a mask
+    of 64-bit words. Composite filters combine the masks of their children word by word, which
+    avoids sorting and merging tag lists at every level of the filter tree. The base class builds
+    the mask from getSelectedTags(). Leaf filters that can test the local particles directly
+    override getSelectedMask() to skip the tag list.
 */
 class PYBIND11_EXPORT ParticleFilter
     {
@@ -47,6 +63,94 @@ class PYBIND11_EXPORT ParticleFilter
         {
         return std::vector<unsigned int>();
         }
+
+    /** Test if the filter implements isSelected().
+     *  The base case returns false.
+     */
+    virtual bool isIncremental() const
+        {
+        return false;
+        }
+
+    /** Test if a single particle meets the selection criteria.
+     *  sysdef: system definition to find the particle in
+     *  tag: tag of the particle, which need not be local or in the system
+     *
+     *  The base case returns false.
+     */
+    virtual bool isSelected(std::shared_ptr<SystemDefinition> sysdef, unsigned int tag) const
+        {
+        return false;
+        }
+
+    /** Select the rank local particles.
+     *  sysdef: system definition to find the particles in
+     *  mask: set to a mask with bit idx % 64 of word idx / 64 set for each selected particle
+     *      index idx. The bits past the local particles are 0.
+     *
+     *  The base case sets the bits of the local particles in the output of getSelectedTags().
+     */
+    virtual void getSelectedMask(std::shared_ptr<SystemDefinition> sysdef,
+                                 std::vector<uint64_t>& mask) const
+        {
+        const auto pdata = sysdef->getParticleData();
+        const std::vector<unsigned int> tags = getSelectedTags(sysdef);
+        mask.assign(getMaskSize(pdata->getN()), 0);
+
+        const unsigned int n_rtag = (unsigned int)pdata->getRTags().size();
+        ArrayHandle<unsigned int> h_rtag(pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        for (unsigned int tag : tags)
+            {
+            unsigned int idx = tag < n_rtag ? h_rtag.data[tag] : NOT_LOCAL;
+            if (idx < pdata->getN())
+                {
+                mask[idx / 64] |= uint64_t(1) << (idx % 64);
+                }
+            }
+        }
+
+    protected:
+    /// Get the number of words in a mask of N particles
+    static size_t getMaskSize(unsigned int N)
+        {
+        return (size_t(N) + 63) / 64;
+        }
+
+    /// Get the tags of the particles selected by a mask in increasing order
+    static std::vector<unsigned int> getMaskedTags(const ParticleData& pdata,
+                                                   const std::vector<uint64_t>& mask)
+        {
+        ArrayHandle<unsigned int> h_tag(pdata.getTags(), access_location::host, access_mode::read);
+
+        std::vector<unsigned int> tags;
+        for (size_t word = 0; word < mask.size(); word++)
+            {
+            // visit only the set bits
+            for (uint64_t bits = mask[word]; bits != 0; bits &= bits - 1)
+                {
+                tags.push_back(h_tag.data[word * 64 + __builtin_ctzll(bits)]);
+                }
+            }
+        std::sort(tags.begin(), tags.end());
+        return tags;
+        }
+
+    /// Get the index of a particle that is local to this rank, or NOT_LOCAL
+    static unsigned int getLocalIndex(const ParticleData& pdata, unsigned int tag)
+        {
+        if (tag >= pdata.getRTags().size())
+            {
+            return NOT_LOCAL;
+            }
+
+        ArrayHandle<unsigned int> h_rtag(pdata.getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        unsigned int idx = h_rtag.data[tag];
+        return idx < pdata.getN() ? idx : NOT_LOCAL;
+        }
     };
 
     } // end namespace hoomd
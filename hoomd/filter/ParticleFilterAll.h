@@ -38,6 +38,27 @@ class PYBIND11_EXPORT ParticleFilterAll : public ParticleFilter
         std::copy_n(h_tag.data, N, member_tags.begin());
         return member_tags;
         }
+
+    virtual void getSelectedMask(std::shared_ptr<SystemDefinition> sysdef,
+                                 std::vector<uint64_t>& mask) const
+        {
+        const auto N = sysdef->getParticleData()->getN();
+        mask.assign(getMaskSize(N), ~uint64_t(0));
+        if (N % 64 != 0)
+            {
+            mask.back() = (uint64_t(1) << (N % 64)) - 1;
+            }
+        }
+
+    virtual bool isIncremental() const
+        {
+        return true;
+        }
+
+    virtual bool isSelected(std::shared_ptr<SystemDefinition> sysdef, unsigned int tag) const
+        {
+        return getLocalIndex(*sysdef->getParticleData(), tag) != NOT_LOCAL;
+        }
     };
 
     } // end namespace hoomd
@@ -27,6 +27,17 @@ class PYBIND11_EXPORT ParticleFilterNull : public ParticleFilter
         std::vector<unsigned int> member_tags;
         return member_tags;
         }
+
+    virtual void getSelectedMask(std::shared_ptr<SystemDefinition> sysdef,
+                                 std::vector<uint64_t>& mask) const
+        {
+        mask.assign(getMaskSize(sysdef->getParticleData()->getN()), 0);
+        }
+
+    virtual bool isIncremental() const
+        {
+        return true;
+        }
     };
 
     } // end namespace hoomd
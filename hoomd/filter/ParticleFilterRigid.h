@@ -91,25 +91,10 @@ class PYBIND11_EXPORT ParticleFilterRigid : public ParticleFilter
             {
             unsigned int tag = h_tag.data[idx];
 
-            // get position of particle
             unsigned int body = h_body.data[idx];
 
             // see if it matches the criteria
-            bool include_particle = false;
-            if (toBool(m_current_selection & RigidBodySelection::CENTERS))
-                {
-                include_particle = include_particle || (tag == body);
-                }
-            if (toBool(m_current_selection & RigidBodySelection::CONSTITUENT))
-                {
-                include_particle = include_particle || (body < MIN_FLOPPY && body != tag);
-                }
-            if (toBool(m_current_selection & RigidBodySelection::FREE))
-                {
-                include_particle = include_particle || (body == NO_BODY);
-                }
-
-            if (include_particle)
+            if (isIncluded(tag, body))
                 {
                 member_tags.push_back(tag);
                 }
@@ -117,10 +102,49 @@ class PYBIND11_EXPORT ParticleFilterRigid : public ParticleFilter
         return member_tags;
         }
 
+    virtual bool isIncremental() const
+        {
+        return true;
+        }
+
+    virtual bool isSelected(std::shared_ptr<SystemDefinition> sysdef, unsigned int tag) const
+        {
+        auto pdata = sysdef->getParticleData();
+        unsigned int idx = getLocalIndex(*pdata, tag);
+        if (idx == NOT_LOCAL)
+            {
+            return false;
+            }
+
+        ArrayHandle<unsigned int> h_body(pdata->getBodies(),
+                                         access_location::host,
+                                         access_mode::read);
+        return isIncluded(tag, h_body.data[idx]);
+        }
+
     private:
     /// Current selection of particles to chose from rigid body center, constituent particles,
     /// and free bodies.
     RigidBodySelection m_current_selection;
+
+    /// Test if a particle with the given tag and body meets the selection criteria
+    bool isIncluded(unsigned int tag, unsigned int body) const
+        {
+        bool include_particle = false;
+        if (toBool(m_current_selection & RigidBodySelection::CENTERS))
+            {
+            include_particle = include_particle || (tag == body);
+            }
+        if (toBool(m_current_selection & RigidBodySelection::CONSTITUENT))
+            {
+            include_particle = include_particle || (body < MIN_FLOPPY && body != tag);
+            }
+        if (toBool(m_current_selection & RigidBodySelection::FREE))
+            {
+            include_particle = include_particle || (body == NO_BODY);
+            }
+        return include_particle;
+        }
     };
 
     } // end namespace hoomd
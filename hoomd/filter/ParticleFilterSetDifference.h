@@ -5,7 +5,6 @@
 #define __PARTICLE_FILTER_SET_DIFFERENCE_H__
 
 #include "ParticleFilter.h"
-#include <algorithm>
 
 namespace hoomd
     {
@@ -37,23 +36,39 @@ class PYBIND11_EXPORT ParticleFilterSetDifference : public ParticleFilter
     virtual std::vector<unsigned int>
     getSelectedTags(std::shared_ptr<SystemDefinition> sysdef) const
         {
-        // Get tags for f() and g()
-        auto X = m_f->getSelectedTags(sysdef);
-        std::sort(X.begin(), X.end());
-
-        auto Y = m_g->getSelectedTags(sysdef);
-        std::sort(Y.begin(), Y.end());
-
-        // Create vector and get set difference
-        auto tags = std::vector<unsigned int>(X.size());
-        auto it = std::set_difference(X.begin(), X.end(), Y.begin(), Y.end(), tags.begin());
-        tags.resize(it - tags.begin());
-        return tags;
+        std::vector<uint64_t> mask;
+        getSelectedMask(sysdef, mask);
+        return getMaskedTags(*sysdef->getParticleData(), mask);
+        }
+
+    virtual void getSelectedMask(std::shared_ptr<SystemDefinition> sysdef,
+                                 std::vector<uint64_t>& mask) const
+        {
+        m_f->getSelectedMask(sysdef, mask);
+        m_g->getSelectedMask(sysdef, m_g_mask);
+
+        // combine the masks of both filters word by word
+        for (size_t word = 0; word < mask.size(); word++)
+            {
+            mask[word] &= ~ m_g_mask[word];
+            }
+        }
+
+    virtual bool isIncremental() const
+        {
+        return m_f->isIncremental() && m_g->isIncremental();
+        }
+
+    virtual bool isSelected(std::shared_ptr<SystemDefinition> sysdef, unsigned int tag) const
+        {
+        return m_f->isSelected(sysdef, tag) && !m_g->isSelected(sysdef, tag);
         }
 
     protected:
     std::shared_ptr<ParticleFilter> m_f;
     std::shared_ptr<ParticleFilter> m_g;
+
+    mutable std::vector<uint64_t> m_g_mask; ///< Scratch space for the mask of m_g
     };
 
     } // end namespace hoomd
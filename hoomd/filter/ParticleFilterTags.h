@@ -5,6 +5,7 @@
 #define __PARTICLE_FILTER_TAGS_H__
 
 #include "ParticleFilter.h"
+#include <algorithm>
 #include <pybind11/numpy.h>
 
 namespace hoomd
@@ -16,7 +17,10 @@ class PYBIND11_EXPORT ParticleFilterTags : public ParticleFilter
     /** Args:
      *  tags: std::vector of tags to select
      */
-    ParticleFilterTags(std::vector<unsigned int> tags) : ParticleFilter(), m_tags(tags) { }
+    ParticleFilterTags(std::vector<unsigned int> tags) : ParticleFilter(), m_tags(tags)
+        {
+        sortTags();
+        }
 
     /** Args:
      *  tags: pybind11::array of tags to select
@@ -27,6 +31,7 @@ class PYBIND11_EXPORT ParticleFilterTags : public ParticleFilter
         {
         unsigned int* tags_ptr = (unsigned int*)tags.data();
         m_tags.assign(tags_ptr, tags_ptr + tags.size());
+        sortTags();
         }
 
     virtual ~ParticleFilterTags() { }
@@ -43,8 +48,26 @@ class PYBIND11_EXPORT ParticleFilterTags : public ParticleFilter
         return m_tags;
         }
 
+    virtual bool isIncremental() const
+        {
+        return true;
+        }
+
+    virtual bool isSelected(std::shared_ptr<SystemDefinition> sysdef, unsigned int tag) const
+        {
+        return std::binary_search(m_sorted_tags.begin(), m_sorted_tags.end(), tag);
+        }
+
     protected:
-    std::vector<unsigned int> m_tags; //< Tags to use for filter
+    std::vector<unsigned int> m_tags;        //< Tags to use for filter
+    std::vector<unsigned int> m_sorted_tags; //< Tags to use for filter in sorted order
+
+    /// Fill m_sorted_tags
+    void sortTags()
+        {
+        m_sorted_tags = m_tags;
+        std::sort(m_sorted_tags.begin(), m_sorted_tags.end());
+        }
     };
 
     } // end namespace hoomd
@@ -69,6 +69,58 @@ class PYBIND11_EXPORT ParticleFilterType : public ParticleFilter
         return member_tags;
         }
 
+    virtual void getSelectedMask(std::shared_ptr<SystemDefinition> sysdef,
+                                 std::vector<uint64_t>& mask) const
+        {
+        const auto pdata = sysdef->getParticleData();
+        const ArrayHandle<Scalar4> h_postype(pdata->getPositions(),
+                                             access_location::host,
+                                             access_mode::read);
+
+        // flag the selected types
+        std::vector<char> selected(pdata->getNTypes(), 0);
+        for (auto type_str : m_types)
+            {
+            selected[pdata->getTypeByName(type_str)] = 1;
+            }
+
+        const auto N = pdata->getN();
+        mask.assign(getMaskSize(N), 0);
+        for (unsigned int idx = 0; idx < N; ++idx)
+            {
+            unsigned int typ = __scalar_as_int(h_postype.data[idx].w);
+            mask[idx / 64] |= uint64_t(selected[typ]) << (idx % 64);
+            }
+        }
+
+    virtual bool isIncremental() const
+        {
+        return true;
+        }
+
+    virtual bool isSelected(std::shared_ptr<SystemDefinition> sysdef, unsigned int tag) const
+        {
+        const auto pdata = sysdef->getParticleData();
+        unsigned int idx = getLocalIndex(*pdata, tag);
+        if (idx == NOT_LOCAL)
+            {
+            return false;
+            }
+
+        const ArrayHandle<Scalar4> h_postype(pdata->getPositions(),
+                                             access_location::host,
+                                             access_mode::read);
+        unsigned int typ = __scalar_as_int(h_postype.data[idx].w);
+        for (auto type_str : m_types)
+            {
+            if (pdata->getTypeByName(type_str) == typ)
+                {
+                return true;
+                }
+            }
+        return false;
+        }
+
     protected:
     std::unordered_set<std::string> m_types; ///< Set of types to select
     };
@@ -2,6 +2,7 @@
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
 #include "ClangCompiler.h"
+#include "hoomd/HOOMDVersion.h"
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
@@ -17,20 +18,30 @@
 #include <clang/Lex/HeaderSearch.h>
 #include <clang/Lex/PreprocessorOptions.h>
 #include <clang/Tooling/Tooling.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Config/llvm-config.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 #include <llvm/InitializePasses.h>
 #include <llvm/PassRegistry.h>
+#include <llvm/Support/FileSystem.h>
 #include <llvm/Support/Host.h>
 #include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/SHA1.h>
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/raw_os_ostream.h>
 
 #pragma GCC diagnostic pop
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <sstream>
 #include <sys/stat.h>
+#include <unistd.h>
 
 namespace hoomd
     {
@@ -71,6 +82,114 @@ ClangCompiler::ClangCompiler()
     llvm::initializeInstrumentation(Registry);
 #endif
     llvm::initializeTarget(Registry);
+
+    const char* cache_directory = std::getenv("HOOMD_JIT_CACHE_DIR");
+    if (cache_directory)
+        {
+        m_cache_directory = cache_directory;
+        }
+    }
+
+/** @param code The C++ code to compile.
+    @param args The arguments passed to the compiler.
+    @param cpu The target CPU.
+    @param features The target features.
+
+    @returns The path of the cache file, or an empty string when caching is disabled.
+*/
+std::string ClangCompiler::getCachePath(const std::string& code,
+                                        const std::vector<std::string>& args,
+                                        const std::string& cpu,
+                                        const std::vector<std::string>& features)
+    {
+    if (m_cache_directory.empty())
+        {
+        return std::string();
+        }
+
+    // separate the fields with a null character so that different inputs give different keys
+    llvm::SHA1 hasher;
+    auto add = [&hasher](const std::string& field)
+    {
+        hasher.update(llvm::StringRef(field.c_str(), field.size() + 1));
+    };
+
+    add(code);
+    for (auto& arg : args)
+        {
+        add(arg);
+        }
+    add(HOOMD_VERSION);
+    add(LLVM_VERSION_STRING);
+    add(cpu);
+    for (auto& feature : features)
+        {
+        add(feature);
+        }
+
+    return m_cache_directory + "/" + llvm::toHex(hasher.final(), true) + ".bc";
+    }
+
+/** @param path The path of the cache file.
+    @param context The LLVM context that owns the module.
+
+    @returns The module, or nullptr when the file does not exist or cannot be read.
+*/
+std::unique_ptr<llvm::Module> ClangCompiler::loadCachedModule(const std::string& path,
+                                                              llvm::LLVMContext& context)
+    {
+    auto buffer = llvm::MemoryBuffer::getFile(path);
+    if (!buffer)
+        {
+        return nullptr;
+        }
+
+    auto module = llvm::parseBitcodeFile(buffer.get()->getMemBufferRef(), context);
+    if (!module)
+        {
+        // a damaged file is recompiled and replaced
+        llvm::consumeError(module.takeError());
+        return nullptr;
+        }
+
+    return std::move(module.get());
+    }
+
+/** @param path The path of the cache file.
+    @param module The module to store.
+
+    Concurrent jobs may compile the same code at the same time. Each writes a temporary file and
+    renames it, so that readers never observe a partial file.
+*/
+void ClangCompiler::storeCachedModule(const std::string& path, const llvm::Module& module)
+    {
+    if (llvm::sys::fs::create_directories(m_cache_directory))
+        {
+        return;
+        }
+
+    std::string temporary_path = path + "." + std::to_string(getpid()) + ".tmp";
+        {
+        std::error_code error;
+        llvm::raw_fd_ostream stream(temporary_path, error, llvm::sys::fs::OF_None);
+        if (error)
+            {
+            return;
+            }
+        llvm::WriteBitcodeToFile(module, stream);
+        stream.close();
+        if (stream.has_error())
+            {
+            stream.clear_error();
+            std::remove(temporary_path.c_str());
+            return;
+            }
+        }
+
+    if (std::rename(temporary_path.c_str(), path.c_str()) != 0)
+        {
+        std::remove(temporary_path.c_str());
+        }
     }
 
 /** @param code The C++ code to compile.
@@ -133,6 +252,34 @@ std::unique_ptr<llvm::Module> ClangCompiler::compileCode(const std::string& code
     clang_args.insert(clang_args.end(), user_args.begin(), user_args.end());
     clang_args.push_back("_hoomd_llvm_code.cc");
 
+    // Generate code for the host CPU so that the loop vectorizer can use all of its vector
+    // instructions. The JIT also targets the host.
+    std::string host_cpu = std::string(llvm::sys::getHostCPUName());
+#if LLVM_VERSION_MAJOR >= 19
+    llvm::StringMap<bool> host_feature_map = llvm::sys::getHostCPUFeatures();
+#else
+    llvm::StringMap<bool> host_feature_map;
+    llvm::sys::getHostCPUFeatures(host_feature_map);
+#endif
+    std::vector<std::string> host_features;
+    for (auto& feature : host_feature_map)
+        {
+        host_features.push_back((feature.getValue() ? "+" : "-") + feature.getKey().str());
+        }
+    // StringMap iterates in an unspecified order
+    std::sort(host_features.begin(), host_features.end());
+
+    std::string cache_path = getCachePath(code, clang_args, host_cpu, host_features);
+    if (!cache_path.empty())
+        {
+        auto module = loadCachedModule(cache_path, context);
+        if (module)
+            {
+            out << "Loaded cached module " << cache_path << std::endl;
+            return module;
+            }
+        }
+
     // convert arguments to a char** array.
     std::vector<const char*> clang_arg_c_strings;
     clang_arg_c_strings.push_back("clang");
@@ -189,6 +336,12 @@ std::unique_ptr<llvm::Module> ClangCompiler::compileCode(const std::string& code
         return nullptr;
         }
 
+    auto& target_options = compiler_invocation.getTargetOpts();
+    target_options.CPU = host_cpu;
+    target_options.FeaturesAsWritten.insert(target_options.FeaturesAsWritten.end(),
+                                            host_features.begin(),
+                                            host_features.end());
+
     // replace the input file argument with the in memory code
     auto& frontend_options = compiler_invocation.getFrontendOpts();
     frontend_options.Inputs.clear();
@@ -224,6 +377,11 @@ std::unique_ptr<llvm::Module> ClangCompiler::compileCode(const std::string& code
         return nullptr;
         }
 
+    if (!cache_path.empty())
+        {
+        storeCachedModule(cache_path, *module);
+        }
+
     return module;
     }
 
@@ -24,6 +24,11 @@ namespace hpmc
 
     There are several one time LLVM initialization functions. This class uses the singleton pattern
     to call these only once.
+
+    When the environment variable HOOMD_JIT_CACHE_DIR names a directory, compiled modules are
+    stored there as LLVM bitcode. The file name is a hash of the code, the compiler arguments, the
+    HOOMD and LLVM versions, and the host CPU and its features. Later compilations of the same code
+    load the bitcode instead of running clang.
 */
 class ClangCompiler
     {
@@ -46,7 +51,23 @@ class ClangCompiler
     protected:
     ClangCompiler();
 
+    /// Get the path of the cache file for the given compilation, empty when caching is disabled
+    std::string getCachePath(const std::string& code,
+                             const std::vector<std::string>& args,
+                             const std::string& cpu,
+                             const std::vector<std::string>& features);
+
+    /// Load a module from the cache, returns nullptr when there is no valid cache file
+    std::unique_ptr<llvm::Module> loadCachedModule(const std::string& path,
+                                                   llvm::LLVMContext& context);
+
+    /// Store a module in the cache
+    void storeCachedModule(const std::string& path, const llvm::Module& module);
+
     static std::shared_ptr<ClangCompiler> m_clang_compiler;
+
+    /// Directory that holds the cached modules, empty when caching is disabled
+    std::string m_cache_directory;
     };
 
     } // end namespace hpmc
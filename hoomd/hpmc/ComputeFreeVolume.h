@@ -11,6 +11,14 @@
 #include "IntegratorHPMCMono.h"
 #include "hoomd/RNGIdentifiers.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
+#include <limits>
+
 /*! \file ComputeFreeVolume.h
     \brief Defines the template class for an approximate free volume integration
     \note This header cannot be compiled by nvcc
@@ -27,7 +35,14 @@ namespace hoomd
 namespace hpmc
     {
 //! Template class for a free volume integration analyzer
-/*!
+/*! The compute places test particles in batches of m_n_sample. With a target error, it adds
+    batches until the relative standard error of the free volume falls below the target or the
+    total number of samples would exceed m_max_n_sample. The error estimate assumes independent
+    samples, so it overestimates the error of the quasi-random (Halton) positions.
+
+    Sample i of batch b always uses the same random numbers, so the result does not depend on the
+    number of threads.
+
     \ingroup hpmc_integrators
 */
 template<class Shape> class ComputeFreeVolume : public Compute
@@ -68,23 +83,92 @@ template<class Shape> class ComputeFreeVolume : public Compute
         m_type = type_int;
         }
 
+    //! Get the sequence of test particle positions
+    std::string getSequence()
+        {
+        return m_quasi_random ? "halton" : "random";
+        }
+
+    //! Set the sequence of test particle positions
+    //! \param sequence "random" or "halton"
+    void setSequence(std::string sequence)
+        {
+        if (sequence == "random")
+            m_quasi_random = false;
+        else if (sequence == "halton")
+            m_quasi_random = true;
+        else
+            throw std::domain_error("sequence must be random or halton.");
+        }
+
+    //! Get the target relative error of the free volume
+    Scalar getTargetError()
+        {
+        return m_target_error;
+        }
+
+    //! Set the target relative error of the free volume
+    //! \param target_error Target error, 0 performs a single batch
+    void setTargetError(Scalar target_error)
+        {
+        if (target_error < Scalar(0.0))
+            throw std::domain_error("target_error must be non-negative.");
+        m_target_error = target_error;
+        }
+
+    //! Get the maximum total number of samples
+    unsigned long long getMaxNumSamples()
+        {
+        return m_max_n_sample;
+        }
+
+    //! Set the maximum total number of samples
+    void setMaxNumSamples(unsigned long long max_n_sample)
+        {
+        m_max_n_sample = max_n_sample;
+        }
+
     //! Analyze the current configuration
     virtual void compute(uint64_t timestep);
 
     //! Return an estimate of the overlap volume
     virtual Scalar getFreeVolume();
 
+    //! Get the total number of samples in the last computation
+    unsigned long long getNumSamplesTaken()
+        {
+        return m_n_sample_total;
+        }
+
+    //! Get the estimated relative standard error of the free volume
+    Scalar getRelativeError();
+
     protected:
     std::shared_ptr<IntegratorHPMCMono<Shape>> m_mc; //!< The parent integrator
     std::shared_ptr<CellList> m_cl;                  //!< The cell list
 
-    unsigned int m_type;     //!< Type of depletant particle to generate
-    unsigned int m_n_sample; //!< Number of sampling depletants to generate
+    unsigned int m_type;         //!< Type of depletant particle to generate
+    unsigned int m_n_sample;     //!< Number of sampling depletants per batch
+    bool m_quasi_random = false; //!< True to place the samples on a Halton sequence
+    Scalar m_target_error = 0;   //!< Target relative error, 0 for a single batch
+
+    unsigned long long m_max_n_sample = 10000000; //!< Maximum total number of samples
+
+    unsigned long long m_n_sample_total = 0;  //!< Total number of samples in the last computation
+    unsigned long long m_n_overlap_total = 0; //!< Total number of overlapping samples
 
     GPUArray<unsigned int> m_n_overlap_all; //!< Number of overlap volume particles in box
 
     //! Return an estimate of the overlap volume
     virtual void computeFreeVolume(uint64_t timestep);
+
+    //! Count the overlapping samples of one batch on this rank
+    virtual unsigned int countOverlappingSamples(uint64_t timestep,
+                                                 unsigned int batch,
+                                                 unsigned int n_sample);
+
+    //! Get the random shift of the Halton sequence on this rank
+    Scalar3 getSequenceShift(uint64_t timestep);
     };
 
 template<class Shape>
@@ -117,16 +201,88 @@ template<class Shape> void ComputeFreeVolume<Shape>::compute(uint64_t timestep)
     this->computeFreeVolume(timestep);
     }
 
-/*! \return the current free volume estimate by MC integration
+/*! Sample batches until the error estimate reaches the target.
  */
 template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t timestep)
     {
+    this->m_exec_conf->msg->notice(5) << "HPMC computing free volume " << timestep << std::endl;
+
+    // generate n_sample random test depletants in the global box per batch
+    unsigned int n_sample = m_n_sample;
+    unsigned long long n_sample_batch = n_sample;
+
+#ifdef ENABLE_MPI
+    // in MPI, for small n_sample we can encounter round-off issues
+    n_sample /= this->m_exec_conf->getNRanks();
+    n_sample_batch = (unsigned long long)n_sample * this->m_exec_conf->getNRanks();
+#endif
+
+    m_n_sample_total = 0;
+    m_n_overlap_total = 0;
+
+    for (unsigned int batch = 0;; batch++)
+        {
+        unsigned int overlap_count = this->countOverlappingSamples(timestep, batch, n_sample);
+
+#ifdef ENABLE_MPI
+        if (m_sysdef->isDomainDecomposed())
+            {
+            MPI_Allreduce(MPI_IN_PLACE,
+                          &overlap_count,
+                          1,
+                          MPI_UNSIGNED,
+                          MPI_SUM,
+                          m_exec_conf->getMPICommunicator());
+            }
+#endif
+
+        m_n_overlap_total += overlap_count;
+        m_n_sample_total += n_sample_batch;
+
+        if (m_target_error <= Scalar(0.0) || n_sample_batch == 0
+            || m_n_sample_total + n_sample_batch > m_max_n_sample
+            || getRelativeError() <= m_target_error)
+            {
+            break;
+            }
+        }
+
+    ArrayHandle<unsigned int> h_n_overlap_all(m_n_overlap_all,
+                                              access_location::host,
+                                              access_mode::overwrite);
+    *h_n_overlap_all.data = (unsigned int)std::min(
+        m_n_overlap_total,
+        (unsigned long long)std::numeric_limits<unsigned int>::max());
+    }
+
+/*! \param timestep Current time step
+    \returns The shift that all ranks apply to the Halton points in their local box
+*/
+template<class Shape> Scalar3 ComputeFreeVolume<Shape>::getSequenceShift(uint64_t timestep)
+    {
+    hoomd::RandomGenerator rng(
+        hoomd::Seed(hoomd::RNGIdentifier::ComputeFreeVolumeShift, timestep, m_sysdef->getSeed()),
+        hoomd::Counter(m_exec_conf->getRank()));
+    Scalar3 shift;
+    shift.x = hoomd::detail::generate_canonical<Scalar>(rng);
+    shift.y = hoomd::detail::generate_canonical<Scalar>(rng);
+    shift.z = hoomd::detail::generate_canonical<Scalar>(rng);
+    return shift;
+    }
+
+/*! \param timestep Current time step
+    \param batch Index of the batch
+    \param n_sample Number of samples on this rank
+    \returns The number of samples on this rank that overlap a particle
+*/
+template<class Shape>
+unsigned int ComputeFreeVolume<Shape>::countOverlappingSamples(uint64_t timestep,
+                                                               unsigned int batch,
+                                                               unsigned int n_sample)
+    {
     unsigned int overlap_count = 0;
-    unsigned int err_count = 0;
     unsigned int ndim = this->m_sysdef->getNDimensions();
 
-    this->m_exec_conf->msg->notice(5) << "HPMC computing free volume " << timestep << std::endl;
-
     // update AABB tree
     const hoomd::detail::AABBTree& aabb_tree = this->m_mc->buildAABBTree();
 
@@ -134,6 +290,7 @@ template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t
     std::vector<vec3<Scalar>> image_list = this->m_mc->updateImageList();
 
     uint16_t seed = m_sysdef->getSeed();
+    Scalar3 shift = getSequenceShift(timestep);
 
     // only check if AABB tree is populated
     if (m_pdata->getN() + m_pdata->getNGhosts())
@@ -157,28 +314,29 @@ template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t
                                              access_mode::read);
         const Index2D& overlap_idx = m_mc->getOverlapIndexer();
 
-        // generate n_sample random test depletants in the global box
-        unsigned int n_sample = m_n_sample;
-
-#ifdef ENABLE_MPI
-        n_sample /= this->m_exec_conf->getNRanks();
-#endif
-
-        for (unsigned int i = 0; i < n_sample; i++)
-            {
-            // select a random particle coordinate in the box
+        // test whether sample i overlaps a particle in the system state
+        auto test_sample = [&](unsigned int i, unsigned int& err_count) -> bool
+        {
             hoomd::RandomGenerator rng_i(
                 hoomd::Seed(hoomd::RNGIdentifier::ComputeFreeVolume, timestep, seed),
-                hoomd::Counter(m_exec_conf->getRank(), i));
+                hoomd::Counter(m_exec_conf->getRank(), i, batch));
 
-            Scalar xrand = hoomd::detail::generate_canonical<Scalar>(rng_i);
-            Scalar yrand = hoomd::detail::generate_canonical<Scalar>(rng_i);
-            Scalar zrand = hoomd::detail::generate_canonical<Scalar>(rng_i);
-            if (this->m_sysdef->getNDimensions() == 2)
+            // select a random particle coordinate in the box
+            Scalar3 f;
+            if (m_quasi_random)
                 {
-                zrand = 0;
+                f = generateHaltonPoint((uint64_t)batch * n_sample + i, shift, ndim);
+                }
+            else
+                {
+                f.x = hoomd::detail::generate_canonical<Scalar>(rng_i);
+                f.y = hoomd::detail::generate_canonical<Scalar>(rng_i);
+                f.z = hoomd::detail::generate_canonical<Scalar>(rng_i);
+                if (ndim == 2)
+                    {
+                    f.z = 0;
+                    }
                 }
-            Scalar3 f = make_scalar3(xrand, yrand, zrand);
             vec3<Scalar> pos_i = vec3<Scalar>(box.makeCoordinates(f));
 
             Shape shape_i(quat<Scalar>(), params[m_type]);
@@ -188,7 +346,6 @@ template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t
                 }
 
             // check for overlaps with particles in the system state
-            bool overlap = false;
             hoomd::detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0, 0, 0));
 
             // All image boxes (including the primary)
@@ -214,12 +371,9 @@ template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t
                                 // read in its position and orientation
                                 unsigned int j = aabb_tree.getNodeParticle(cur_node_idx, cur_p);
 
-                                Scalar4 postype_j;
-                                Scalar4 orientation_j;
-
                                 // load the position and orientation of the j particle
-                                postype_j = h_postype.data[j];
-                                orientation_j = h_orientation.data[j];
+                                Scalar4 postype_j = h_postype.data[j];
+                                Scalar4 orientation_j = h_orientation.data[j];
 
                                 // put particles in coordinate system of particle i
                                 vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
@@ -231,8 +385,7 @@ template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t
                                     && check_circumsphere_overlap(r_ij, shape_i, shape_j)
                                     && test_overlap(r_ij, shape_i, shape_j, err_count))
                                     {
-                                    overlap = true;
-                                    break;
+                                    return true;
                                     }
                                 }
                             }
@@ -242,66 +395,82 @@ template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t
                         // skip ahead
                         cur_node_idx += aabb_tree.getNodeSkip(cur_node_idx);
                         }
-
-                    if (overlap)
-                        break;
                     } // end loop over AABB nodes
+                }     // end loop over images
 
-                if (overlap)
-                    break;
-                } // end loop over images
+            return false;
+        };
 
-            if (overlap)
+#ifdef ENABLE_TBB
+        tbb::enumerable_thread_specific<unsigned int> thread_overlap_count(0);
+        tbb::enumerable_thread_specific<unsigned int> thread_err_count(0);
+
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_sample),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  {
+                                      unsigned int& count = thread_overlap_count.local();
+                                      unsigned int& err_count = thread_err_count.local();
+                                      for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                          {
+                                          if (test_sample(i, err_count))
+                                              count++;
+                                          }
+                                  });
+            });
+
+        for (auto count : thread_overlap_count)
+            {
+            overlap_count += count;
+            }
+#else
+        unsigned int err_count = 0;
+        for (unsigned int i = 0; i < n_sample; i++)
+            {
+            if (test_sample(i, err_count))
                 {
                 overlap_count++;
                 }
             } // end loop through all particles
-
-        } // end lexical scope
-
-#ifdef ENABLE_MPI
-    if (m_sysdef->isDomainDecomposed())
-        {
-        MPI_Allreduce(MPI_IN_PLACE,
-                      &overlap_count,
-                      1,
-                      MPI_UNSIGNED,
-                      MPI_SUM,
-                      m_exec_conf->getMPICommunicator());
-        }
 #endif
+        } // end lexical scope
 
-    ArrayHandle<unsigned int> h_n_overlap_all(m_n_overlap_all,
-                                              access_location::host,
-                                              access_mode::overwrite);
-    *h_n_overlap_all.data = overlap_count;
+    return overlap_count;
     }
 
 // \return the free volume.
 template<class Shape> Scalar ComputeFreeVolume<Shape>::getFreeVolume()
     {
-    // access counters
-    ArrayHandle<unsigned int> h_n_overlap_all(m_n_overlap_all,
-                                              access_location::host,
-                                              access_mode::read);
-
-    // generate n_sample random test depletants in the global box
-    unsigned int n_sample = m_n_sample;
-
-#ifdef ENABLE_MPI
-    // in MPI, for small n_sample we can encounter round-off issues
-    unsigned int n_ranks = this->m_exec_conf->getNRanks();
-    n_sample = (n_sample / n_ranks) * n_ranks;
-#endif
+    if (m_n_sample_total == 0)
+        {
+        return Scalar(0.0);
+        }
 
     // total free volume
     const BoxDim global_box = this->m_pdata->getGlobalBox();
-    Scalar V_free = (Scalar)(n_sample - *h_n_overlap_all.data) / (Scalar)n_sample
+    Scalar V_free = (Scalar)(m_n_sample_total - m_n_overlap_total) / (Scalar)m_n_sample_total
                     * global_box.getVolume(this->m_sysdef->getNDimensions() == 2);
 
     return V_free;
     }
 
+/*! \returns The binomial standard error of the free volume fraction relative to the fraction,
+    infinity when no sample is free.
+*/
+template<class Shape> Scalar ComputeFreeVolume<Shape>::getRelativeError()
+    {
+    unsigned long long n_free = m_n_sample_total - m_n_overlap_total;
+    if (n_free == 0)
+        {
+        return std::numeric_limits<Scalar>::infinity();
+        }
+
+    Scalar overlap_fraction = Scalar(m_n_overlap_total) / Scalar(m_n_sample_total);
+    return sqrt(overlap_fraction / Scalar(n_free));
+    }
+
 namespace detail
     {
 //! Export this hpmc analyzer to python
@@ -322,7 +491,18 @@ template<class Shape> void export_ComputeFreeVolume(pybind11::module& m, const s
         .def_property("test_particle_type",
                       &ComputeFreeVolume<Shape>::getTestParticleType,
                       &ComputeFreeVolume<Shape>::setTestParticleType)
-        .def_property_readonly("free_volume", &ComputeFreeVolume<Shape>::getFreeVolume);
+        .def_property("sequence",
+                      &ComputeFreeVolume<Shape>::getSequence,
+                      &ComputeFreeVolume<Shape>::setSequence)
+        .def_property("target_error",
+                      &ComputeFreeVolume<Shape>::getTargetError,
+                      &ComputeFreeVolume<Shape>::setTargetError)
+        .def_property("max_num_samples",
+                      &ComputeFreeVolume<Shape>::getMaxNumSamples,
+                      &ComputeFreeVolume<Shape>::setMaxNumSamples)
+        .def_property_readonly("free_volume", &ComputeFreeVolume<Shape>::getFreeVolume)
+        .def_property_readonly("num_samples_taken", &ComputeFreeVolume<Shape>::getNumSamplesTaken)
+        .def_property_readonly("relative_error", &ComputeFreeVolume<Shape>::getRelativeError);
     }
 
     } // end namespace detail
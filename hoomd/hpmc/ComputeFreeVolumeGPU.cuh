@@ -61,6 +61,8 @@ struct hpmc_free_volume_args_t
                             const Scalar3 _ghost_width,
                             const unsigned int* _d_check_overlaps,
                             Index2D _overlap_idx,
+                            const bool _quasi_random,
+                            const Scalar3 _shift,
                             const hipDeviceProp_t& _devprop)
         : n_sample(_n_sample), type(_type), d_postype(_d_postype), d_orientation(_d_orientation),
           d_cell_idx(_d_cell_idx), d_cell_size(_d_cell_size), ci(_ci), cli(_cli),
@@ -69,7 +71,8 @@ struct hpmc_free_volume_args_t
           select(_select), timestep(_timestep), dim(_dim), box(_box), block_size(_block_size),
           stride(_stride), group_size(_group_size), max_n(_max_n),
           d_n_overlap_all(_d_n_overlap_all), ghost_width(_ghost_width),
-          d_check_overlaps(_d_check_overlaps), overlap_idx(_overlap_idx), devprop(_devprop) {};
+          d_check_overlaps(_d_check_overlaps), overlap_idx(_overlap_idx),
+          quasi_random(_quasi_random), shift(_shift), devprop(_devprop) {};
 
     unsigned int n_sample;                //!< Number of depletants particles to generate
     unsigned int type;                    //!< Type of depletant particle
@@ -87,7 +90,7 @@ struct hpmc_free_volume_args_t
     const unsigned int num_types;         //!< Number of particle types
     const uint16_t seed;                  //!< RNG seed
     const unsigned int rank;              //!< MPI rank
-    unsigned int select;                  //!< RNG select value
+    unsigned int select;                  //!< RNG select value (index of the batch)
     const uint64_t timestep;              //!< Current time step
     const unsigned int dim;               //!< Number of dimensions
     const BoxDim box;                     //!< Current simulation box
@@ -99,6 +102,8 @@ struct hpmc_free_volume_args_t
     const Scalar3 ghost_width;            //!< Width of ghost layer
     const unsigned int* d_check_overlaps; //!< Interaction matrix
     Index2D overlap_idx;                  //!< Interaction matrix indexer
+    const bool quasi_random;              //!< True to place the samples on a Halton sequence
+    const Scalar3 shift;                  //!< Random shift of the Halton sequence
     const hipDeviceProp_t& devprop;       //!< CUDA device properties
     };
 
@@ -148,10 +153,13 @@ __device__ inline unsigned int compute_cell_idx(const Scalar3 p,
     \param N number of particles
     \param num_types Number of particle types
     \param seed User chosen random number seed
-    \param a Size of rotation move (per type)
+    \param rank MPI rank
+    \param select Index of the batch
     \param timestep Current timestep of the simulation
     \param dim Dimension of the simulation box
     \param box Simulation box
+    \param quasi_random True to place the samples on a Halton sequence
+    \param shift Random shift of the Halton sequence
     \param d_n_overlap_all Total overlap counter (output value)
     \param ghost_width Width of ghost layer
     \param d_params Per-type shape parameters
@@ -177,6 +185,8 @@ __global__ void gpu_hpmc_free_volume_kernel(unsigned int n_sample,
                                             const uint64_t timestep,
                                             const unsigned int dim,
                                             const BoxDim box,
+                                            const bool quasi_random,
+                                            const Scalar3 shift,
                                             unsigned int* d_n_overlap_all,
                                             Scalar3 ghost_width,
                                             const unsigned int* d_check_overlaps,
@@ -257,7 +267,7 @@ __global__ void gpu_hpmc_free_volume_kernel(unsigned int n_sample,
 
     // one RNG per particle
     hoomd::RandomGenerator rng(hoomd::Seed(hoomd::RNGIdentifier::ComputeFreeVolume, timestep, seed),
-                               hoomd::Counter(rank, i));
+                               hoomd::Counter(rank, i, select));
 
     unsigned int my_cell;
 
@@ -269,16 +279,23 @@ __global__ void gpu_hpmc_free_volume_kernel(unsigned int n_sample,
     if (active)
         {
         // select a random particle coordinate in the box
-        Scalar xrand = hoomd::detail::generate_canonical<Scalar>(rng);
-        Scalar yrand = hoomd::detail::generate_canonical<Scalar>(rng);
-        Scalar zrand = hoomd::detail::generate_canonical<Scalar>(rng);
-
-        if (dim == 2)
+        Scalar3 f;
+        if (quasi_random)
+            {
+            f = generateHaltonPoint((uint64_t)select * n_sample + i, shift, dim);
+            }
+        else
             {
-            zrand = 0;
+            f.x = hoomd::detail::generate_canonical<Scalar>(rng);
+            f.y = hoomd::detail::generate_canonical<Scalar>(rng);
+            f.z = hoomd::detail::generate_canonical<Scalar>(rng);
+
+            if (dim == 2)
+                {
+                f.z = 0;
+                }
             }
 
-        Scalar3 f = make_scalar3(xrand, yrand, zrand);
         pos_i = vec3<Scalar>(box.makeCoordinates(f));
 
         if (shape_i.hasOrientation())
@@ -442,6 +459,8 @@ hipError_t gpu_hpmc_free_volume(const hpmc_free_volume_args_t& args,
                        args.timestep,
                        args.dim,
                        args.box,
+                       args.quasi_random,
+                       args.shift,
                        args.d_n_overlap_all,
                        args.ghost_width,
                        args.d_check_overlaps,
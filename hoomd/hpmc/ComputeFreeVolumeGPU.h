@@ -44,9 +44,6 @@ template<class Shape> class ComputeFreeVolumeGPU : public ComputeFreeVolume<Shap
     //! Destructor
     virtual ~ComputeFreeVolumeGPU();
 
-    //! Return an estimate of the overlap volume
-    virtual void computeFreeVolume(uint64_t timestep);
-
     protected:
     uint3 m_last_dim;         //!< Dimensions of the cell list on the last call to update
     unsigned int m_last_nmax; //!< Last cell list NMax value allocated in excell
@@ -62,6 +59,11 @@ template<class Shape> class ComputeFreeVolumeGPU : public ComputeFreeVolume<Shap
     std::shared_ptr<Autotuner<1>> m_tuner_excell_block_size;
 
     void initializeExcellMem();
+
+    //! Count the overlapping samples of one batch on this rank
+    virtual unsigned int countOverlappingSamples(uint64_t timestep,
+                                                 unsigned int batch,
+                                                 unsigned int n_sample);
     };
 
 template<class Shape>
@@ -117,12 +119,16 @@ ComputeFreeVolumeGPU<Shape>::ComputeFreeVolumeGPU(std::shared_ptr<SystemDefiniti
 
 template<class Shape> ComputeFreeVolumeGPU<Shape>::~ComputeFreeVolumeGPU() { }
 
-/*! \return the current free volume (by MC integration)
- */
-template<class Shape> void ComputeFreeVolumeGPU<Shape>::computeFreeVolume(uint64_t timestep)
+/*! \param timestep Current time step
+    \param batch Index of the batch
+    \param n_sample Number of samples on this rank
+    \returns The number of samples on this rank that overlap a particle
+*/
+template<class Shape>
+unsigned int ComputeFreeVolumeGPU<Shape>::countOverlappingSamples(uint64_t timestep,
+                                                                  unsigned int batch,
+                                                                  unsigned int n_sample)
     {
-    this->m_exec_conf->msg->notice(5) << "HPMC computing free volume " << timestep << std::endl;
-
     // set nominal width
     Scalar nominal_width = this->m_mc->getMaxCoreDiameter();
 
@@ -240,12 +246,6 @@ template<class Shape> void ComputeFreeVolumeGPU<Shape>::computeFreeVolume(uint64
         unsigned int stride = param[1];
         unsigned int group_size = param[2];
 
-        unsigned int n_sample = this->m_n_sample;
-
-#ifdef ENABLE_MPI
-        n_sample /= this->m_exec_conf->getNRanks();
-#endif
-
         detail::hpmc_free_volume_args_t free_volume_args(n_sample,
                                                          this->m_type,
                                                          d_postype.data,
@@ -262,7 +262,7 @@ template<class Shape> void ComputeFreeVolumeGPU<Shape>::computeFreeVolume(uint64
                                                          this->m_pdata->getNTypes(),
                                                          this->m_sysdef->getSeed(),
                                                          this->m_exec_conf->getRank(),
-                                                         0,
+                                                         batch,
                                                          timestep,
                                                          this->m_sysdef->getNDimensions(),
                                                          box,
@@ -274,6 +274,8 @@ template<class Shape> void ComputeFreeVolumeGPU<Shape>::computeFreeVolume(uint64
                                                          this->m_cl->getGhostWidth(),
                                                          d_overlaps.data,
                                                          overlap_idx,
+                                                         this->m_quasi_random,
+                                                         this->getSequenceShift(timestep),
                                                          this->m_exec_conf->dev_prop);
 
         // invoke kernel for counting total overlap volume
@@ -285,20 +287,10 @@ template<class Shape> void ComputeFreeVolumeGPU<Shape>::computeFreeVolume(uint64
         m_tuner_free_volume->end();
         }
 
-#ifdef ENABLE_MPI
-    if (this->m_sysdef->isDomainDecomposed())
-        {
-        ArrayHandle<unsigned int> h_n_overlap_all(this->m_n_overlap_all,
-                                                  access_location::host,
-                                                  access_mode::readwrite);
-        MPI_Allreduce(MPI_IN_PLACE,
-                      h_n_overlap_all.data,
-                      1,
-                      MPI_UNSIGNED,
-                      MPI_SUM,
-                      this->m_exec_conf->getMPICommunicator());
-        }
-#endif
+    ArrayHandle<unsigned int> h_n_overlap_all(this->m_n_overlap_all,
+                                              access_location::host,
+                                              access_mode::read);
+    return *h_n_overlap_all.data;
     }
 
 template<class Shape> void ComputeFreeVolumeGPU<Shape>::initializeExcellMem()
@@ -33,6 +33,7 @@ EvalFactory::EvalFactory(const std::string& cpp_code,
     {
     std::ostringstream sstream;
     m_eval = nullptr;
+    m_eval_batch = nullptr;
     m_alpha = nullptr;
     m_alpha_union = nullptr;
 
@@ -122,6 +123,17 @@ EvalFactory::EvalFactory(const std::string& cpp_code,
     /// this cast is like this because 1) it works correctly like this and
     /// 2) trying to use static_cast or reinterpret_cast gives compilation errors
     m_eval = (EvalFnPtr)(long unsigned int)(eval->getAddress());
+
+    // The batched evaluator is optional.
+    auto eval_batch = m_jit->findSymbol("eval_batch");
+    if (eval_batch)
+        {
+        m_eval_batch = (EvalBatchFnPtr)(long unsigned int)(eval_batch->getAddress());
+        }
+    else
+        {
+        llvm::consumeError(eval_batch.takeError());
+        }
     }
 
     } // end namespace hpmc
@@ -9,6 +9,7 @@
 #include "hoomd/VectorMath.h"
 
 #include "KaleidoscopeJIT.h"
+#include "PatchEnergyBatch.h"
 
 namespace hoomd
     {
@@ -27,6 +28,12 @@ class EvalFactory
                                float d_j,
                                float charge_j);
 
+    typedef void (*EvalBatchFnPtr)(detail::PatchEnergyBatch& batch,
+                                   unsigned int type_i,
+                                   const quat<float>& q_i,
+                                   float d_i,
+                                   float charge_i);
+
     //! Constructor
     EvalFactory(const std::string& cpp_code,
                 const std::vector<std::string>& compiler_args,
@@ -38,6 +45,12 @@ class EvalFactory
         return m_eval;
         }
 
+    //! Return the batched evaluator, nullptr when the module does not define one
+    EvalBatchFnPtr getEvalBatch()
+        {
+        return m_eval_batch;
+        }
+
     //! Get the error message from initialization
     const std::string& getError()
         {
@@ -71,6 +84,7 @@ class EvalFactory
     private:
     std::unique_ptr<llvm::orc::KaleidoscopeJIT> m_jit; //!< The persistent JIT engine
     EvalFnPtr m_eval;                                  //!< Function pointer to evaluator
+    EvalBatchFnPtr m_eval_batch;                       //!< Function pointer to batched evaluator
     float** m_alpha;                                   // Pointer to alpha array
     float** m_alpha_union;                             // Pointer to alpha array for union
     std::string m_error_msg; //!< The error message if initialization fails
@@ -7,13 +7,16 @@
 /*! \file ExternalField.h
     \brief Declaration of ExternalField base class
 */
+#include "hoomd/AABBTree.h"
 #include "hoomd/Compute.h"
 #include "hoomd/VectorMath.h"
 
 #include "ExternalField.h"
 #include "IntegratorHPMCMono.h"
 
+#include <atomic>
 #include <limits>
+#include <mutex>
 #include <tuple>
 
 #ifndef __HIPCC__
@@ -579,6 +582,17 @@ DEVICE inline bool test_confined(const PlaneWall& wall,
     return accept;
     }
 
+//! Hard particle-wall interactions
+/*! A particle must be confined by every wall. Sphere walls with inside == false (spherical
+    obstacles) can only reject a particle whose circumsphere overlaps the obstacle, so
+    ExternalFieldWall places the obstacles in an AABB tree and tests only those near the particle.
+    All other walls can reject distant particles and are tested one by one.
+
+    compute() rebuilds the tree at most once per timestep when the sphere walls, the box, or the
+    origin have changed. energydiff() calls it first, so that the trial moves of a step, which may
+    run in parallel, share one tree. The other methods fall back to testing every wall when the
+    tree does not match the current box.
+*/
 template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
     {
     using Compute::m_pdata;
@@ -586,11 +600,26 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
     public:
     ExternalFieldWall(std::shared_ptr<SystemDefinition> sysdef,
                       std::shared_ptr<IntegratorHPMCMono<Shape>> mc)
-        : ExternalFieldMono<Shape>(sysdef), m_mc(mc)
+        : ExternalFieldMono<Shape>(sysdef), m_mc(mc),
+          m_index_timestep(std::numeric_limits<uint64_t>::max())
         {
         }
     ~ExternalFieldWall() { }
 
+    //! Rebuild the obstacle tree when the walls or the box have changed
+    virtual void compute(uint64_t timestep)
+        {
+        if (m_index_timestep.load(std::memory_order_acquire) == timestep)
+            return;
+
+        std::lock_guard<std::mutex> lock(m_index_mutex);
+        if (m_index_timestep.load(std::memory_order_relaxed) == timestep)
+            return;
+
+        updateObstacleTree();
+        m_index_timestep.store(timestep, std::memory_order_release);
+        }
+
     double energydiff(uint64_t timestep,
                       const unsigned int& index,
                       const vec3<Scalar>& position_old,
@@ -598,32 +627,14 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
                       const vec3<Scalar>& position_new,
                       const Shape& shape_new)
         {
+        compute(timestep);
+
         const BoxDim box = this->m_pdata->getGlobalBox();
         vec3<Scalar> origin(m_pdata->getOrigin());
 
-        for (size_t i = 0; i < m_Spheres.size(); i++)
+        if (!isConfined(shape_new, position_new, origin, box, true))
             {
-            if (!test_confined(m_Spheres[i], shape_new, position_new, origin, box))
-                {
-                return INFINITY;
-                }
-            }
-
-        for (size_t i = 0; i < m_Cylinders.size(); i++)
-            {
-            set_cylinder_wall_verts(m_Cylinders[i], shape_new);
-            if (!test_confined(m_Cylinders[i], shape_new, position_new, origin, box))
-                {
-                return INFINITY;
-                }
-            }
-
-        for (size_t i = 0; i < m_Planes.size(); i++)
-            {
-            if (!test_confined(m_Planes[i], shape_new, position_new, origin, box))
-                {
-                return INFINITY;
-                }
+            return INFINITY;
             }
 
         return double(0.0);
@@ -651,29 +662,10 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
         Shape shape(q_i, params[type]);
         vec3<Scalar> origin(m_pdata->getOrigin());
 
-        for (size_t i = 0; i < m_Spheres.size(); i++)
-            {
-            if (!test_confined(m_Spheres[i], shape, r_i, origin, box))
-                {
-                return INFINITY;
-                }
-            }
-
-        for (size_t i = 0; i < m_Cylinders.size(); i++)
-            {
-            set_cylinder_wall_verts(m_Cylinders[i], shape);
-            if (!test_confined(m_Cylinders[i], shape, r_i, origin, box))
-                {
-                return INFINITY;
-                }
-            }
-
-        for (size_t i = 0; i < m_Planes.size(); i++)
+        // the walls may have changed since the last tree build
+        if (!isConfined(shape, r_i, origin, box, false))
             {
-            if (!test_confined(m_Planes[i], shape, r_i, origin, box))
-                {
-                return INFINITY;
-                }
+            return INFINITY;
             }
 
         return double(0.0);
@@ -725,6 +717,9 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
 
     unsigned int countOverlaps(uint64_t timestep, bool early_exit = false)
         {
+        // the walls may have changed since the last call at this timestep
+        m_index_timestep.store(std::numeric_limits<uint64_t>::max());
+
         unsigned int numOverlaps = 0;
         // access particle data and system box
         ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
@@ -791,12 +786,186 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
             = ShortReal(2.0 * (shape.getCircumsphereDiameter() + wall.verts->sweep_radius));
         }
 
+    //! Test whether the particle is confined by all walls
+    /*! \param shape Particle shape
+        \param position Particle position
+        \param origin Box origin
+        \param box Global simulation box
+        \param use_tree Set to true to test only the obstacles found in the tree
+    */
+    bool isConfined(const Shape& shape,
+                    const vec3<Scalar>& position,
+                    const vec3<Scalar>& origin,
+                    const BoxDim& box,
+                    bool use_tree)
+        {
+        use_tree = use_tree && m_index_box == box && m_index_origin == origin
+                   && m_index_n_spheres == m_Spheres.size();
+
+        if (use_tree)
+            {
+            for (unsigned int i : m_unindexed_spheres)
+                {
+                if (!test_confined(m_Spheres[i], shape, position, origin, box))
+                    {
+                    return false;
+                    }
+                }
+
+            if (m_obstacles.size() > 0)
+                {
+                Scalar radius = Scalar(shape.getCircumsphereDiameter()) / Scalar(2.0);
+                vec3<Scalar> p(box.minImage(vec_to_scalar3(position)));
+
+                for (const vec3<Scalar>& image : m_index_images)
+                    {
+                    hoomd::detail::AABB aabb(p + image, radius);
+
+                    // stackless search
+                    for (unsigned int node = 0; node < m_obstacle_tree.getNumNodes(); node++)
+                        {
+                        if (aabb.overlaps(m_obstacle_tree.getNodeAABB(node)))
+                            {
+                            if (m_obstacle_tree.isNodeLeaf(node))
+                                {
+                                for (unsigned int k = 0;
+                                     k < m_obstacle_tree.getNodeNumParticles(node);
+                                     k++)
+                                    {
+                                    unsigned int i
+                                        = m_obstacles[m_obstacle_tree.getNodeParticle(node, k)];
+                                    if (!test_confined(m_Spheres[i], shape, position, origin, box))
+                                        {
+                                        return false;
+                                        }
+                                    }
+                                }
+                            }
+                        else
+                            {
+                            // skip ahead
+                            node += m_obstacle_tree.getNodeSkip(node);
+                            }
+                        }
+                    }
+                }
+            }
+        else
+            {
+            for (size_t i = 0; i < m_Spheres.size(); i++)
+                {
+                if (!test_confined(m_Spheres[i], shape, position, origin, box))
+                    {
+                    return false;
+                    }
+                }
+            }
+
+        for (size_t i = 0; i < m_Cylinders.size(); i++)
+            {
+            set_cylinder_wall_verts(m_Cylinders[i], shape);
+            if (!test_confined(m_Cylinders[i], shape, position, origin, box))
+                {
+                return false;
+                }
+            }
+
+        for (size_t i = 0; i < m_Planes.size(); i++)
+            {
+            if (!test_confined(m_Planes[i], shape, position, origin, box))
+                {
+                return false;
+                }
+            }
+
+        return true;
+        }
+
+    //! Build the tree of spherical obstacles when the sphere walls, box, or origin have changed
+    void updateObstacleTree()
+        {
+        const BoxDim box = this->m_pdata->getGlobalBox();
+        vec3<Scalar> origin(m_pdata->getOrigin());
+
+        // the state of each sphere wall, the sign of w records inside
+        std::vector<Scalar4> state(m_Spheres.size());
+        for (size_t i = 0; i < m_Spheres.size(); i++)
+            {
+            const SphereWall& wall = m_Spheres[i];
+            state[i] = make_scalar4(wall.origin.x,
+                                    wall.origin.y,
+                                    wall.origin.z,
+                                    wall.inside ? wall.rsq : -wall.rsq);
+            }
+
+        bool changed = !(m_index_box == box) || !(m_index_origin == origin)
+                       || state.size() != m_index_state.size();
+        for (size_t i = 0; i < state.size() && !changed; i++)
+            {
+            changed = state[i].x != m_index_state[i].x || state[i].y != m_index_state[i].y
+                      || state[i].z != m_index_state[i].z || state[i].w != m_index_state[i].w;
+            }
+
+        if (!changed)
+            return;
+
+        m_index_state.swap(state);
+        m_index_box = box;
+        m_index_origin = origin;
+        m_index_n_spheres = m_Spheres.size();
+
+        m_obstacles.clear();
+        m_unindexed_spheres.clear();
+        std::vector<hoomd::detail::AABB> aabbs;
+        for (unsigned int i = 0; i < m_Spheres.size(); i++)
+            {
+            const SphereWall& wall = m_Spheres[i];
+            if (wall.inside)
+                {
+                m_unindexed_spheres.push_back(i);
+                }
+            else
+                {
+                // the obstacle center in the frame of the particle positions
+                vec3<Scalar> center(box.minImage(vec_to_scalar3(wall.origin + origin)));
+                aabbs.push_back(hoomd::detail::AABB(center, Scalar(sqrt(wall.rsq))));
+                m_obstacles.push_back(i);
+                }
+            }
+
+        m_obstacle_tree.buildTree(aabbs.data(), (unsigned int)aabbs.size());
+
+        // both the particle and the obstacle are in the primary image, so their minimum image
+        // separation is within one lattice vector in each direction
+        m_index_images.clear();
+        int nz = this->m_sysdef->getNDimensions() == 3 ? 1 : 0;
+        for (int i = -1; i <= 1; i++)
+            for (int j = -1; j <= 1; j++)
+                for (int k = -nz; k <= nz; k++)
+                    {
+                    m_index_images.push_back(Scalar(i) * vec3<Scalar>(box.getLatticeVector(0))
+                                             + Scalar(j) * vec3<Scalar>(box.getLatticeVector(1))
+                                             + Scalar(k) * vec3<Scalar>(box.getLatticeVector(2)));
+                    }
+        }
+
     protected:
     std::vector<SphereWall> m_Spheres;
     std::vector<CylinderWall> m_Cylinders;
     std::vector<PlaneWall> m_Planes;
     Scalar m_Volume;
 
+    hoomd::detail::AABBTree m_obstacle_tree;       //!< Tree of the spherical obstacles
+    std::vector<unsigned int> m_obstacles;         //!< Sphere wall of each leaf particle of the tree
+    std::vector<unsigned int> m_unindexed_spheres; //!< Sphere walls that are tested one by one
+    std::vector<vec3<Scalar>> m_index_images;      //!< Lattice translations to query in the tree
+    std::vector<Scalar4> m_index_state;            //!< Sphere walls at the last tree build
+    size_t m_index_n_spheres = 0;                  //!< Number of sphere walls at the last build
+    BoxDim m_index_box;                            //!< Global box at the last tree build
+    vec3<Scalar> m_index_origin;                   //!< Box origin at the last tree build
+    std::atomic<uint64_t> m_index_timestep;        //!< Timestep of the last tree check
+    std::mutex m_index_mutex;                      //!< Serializes the tree check
+
     private:
     std::shared_ptr<IntegratorHPMCMono<Shape>> m_mc; //!< integrator
     };
@@ -100,6 +100,43 @@ DEVICE inline hpmc_counters_t operator+(const hpmc_counters_t& a, const hpmc_cou
     return result;
     }
 
+//! Storage for the detailed counters of the overlap search
+/*! IntegratorHPMCMono records these counters in the serial CPU sweep when detailed counters are
+    enabled. The candidates are the particles found in the AABB tree traversal, counted in
+    hpmc_counters_t::overlap_checks. A candidate is either rejected by the circumsphere test (this
+    includes type pairs that do not interact) or passed to the exact overlap test.
+
+    \ingroup hpmc_data_structs
+*/
+struct hpmc_sweep_counters_t
+    {
+    unsigned long long int aabb_node_visits;        //!< AABB tree nodes tested in the traversals
+    unsigned long long int circumsphere_rejections; //!< Candidates rejected before test_overlap
+    unsigned long long int narrow_phase_checks;     //!< Calls to test_overlap
+    unsigned long long int search_time;             //!< Time spent in the overlap search [ns]
+
+    //! Construct a zero set of counters
+    DEVICE hpmc_sweep_counters_t()
+        {
+        aabb_node_visits = 0;
+        circumsphere_rejections = 0;
+        narrow_phase_checks = 0;
+        search_time = 0;
+        }
+    };
+
+//! Sum of two sets of sweep counters
+DEVICE inline hpmc_sweep_counters_t operator+(const hpmc_sweep_counters_t& a,
+                                              const hpmc_sweep_counters_t& b)
+    {
+    hpmc_sweep_counters_t result;
+    result.aabb_node_visits = a.aabb_node_visits + b.aabb_node_visits;
+    result.circumsphere_rejections = a.circumsphere_rejections + b.circumsphere_rejections;
+    result.narrow_phase_checks = a.narrow_phase_checks + b.narrow_phase_checks;
+    result.search_time = a.search_time + b.search_time;
+    return result;
+    }
+
 //! Storage for NPT acceptance counters
 /*! \ingroup hpmc_data_structs */
 struct hpmc_boxmc_counters_t
@@ -5,6 +5,7 @@
 
 #include "hoomd/VectorMath.h"
 #include <sstream>
+#include <string.h>
 
 #include <pybind11/stl_bind.h>
 PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<hoomd::hpmc::PairPotential>>);
@@ -236,6 +237,127 @@ hpmc_counters_t IntegratorHPMC::getCounters(unsigned int mode)
     return result;
     }
 
+/*! \returns The detailed counters of the overlap search since the start of the run, summed over
+    all ranks
+*/
+hpmc_sweep_counters_t IntegratorHPMC::getSweepCounters()
+    {
+    hpmc_sweep_counters_t result = m_sweep_count;
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        // all members are unsigned long long int
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &result,
+                      sizeof(hpmc_sweep_counters_t) / sizeof(unsigned long long int),
+                      MPI_UNSIGNED_LONG_LONG,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+    return result;
+    }
+
+/*! \returns The number of calls to test_overlap since the start of the run by the type of the
+    moved particle, summed over all ranks
+*/
+std::vector<unsigned long long int> IntegratorHPMC::getNarrowPhaseChecksByType()
+    {
+    std::vector<unsigned long long int> result(m_pdata->getNTypes(), 0);
+    std::copy(m_narrow_phase_checks_by_type.begin(),
+              m_narrow_phase_checks_by_type.begin()
+                  + std::min(result.size(), m_narrow_phase_checks_by_type.size()),
+              result.begin());
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      result.data(),
+                      (int)result.size(),
+                      MPI_UNSIGNED_LONG_LONG,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+    return result;
+    }
+
+/*! \returns The accept/reject counts of this rank since instantiation, as the bytes of
+    hpmc_counters_t
+
+    Checkpoints store the counts of each rank and restore them with setLocalCounters().
+*/
+pybind11::bytes IntegratorHPMC::getLocalCounters()
+    {
+    ArrayHandle<hpmc_counters_t> h_counters(m_count_total,
+                                            access_location::host,
+                                            access_mode::read);
+    return pybind11::bytes(reinterpret_cast<const char*>(h_counters.data),
+                           sizeof(hpmc_counters_t));
+    }
+
+/*! \param counters Bytes returned by getLocalCounters()
+
+    The counts relative to the start of the run and of the last step restart from zero.
+*/
+void IntegratorHPMC::setLocalCounters(pybind11::bytes counters)
+    {
+    const std::string data = pybind11::cast<std::string>(counters);
+    if (data.size() != sizeof(hpmc_counters_t))
+        {
+        throw std::runtime_error("Invalid HPMC counters.");
+        }
+
+    ArrayHandle<hpmc_counters_t> h_counters(m_count_total,
+                                            access_location::host,
+                                            access_mode::overwrite);
+    memcpy(h_counters.data, data.data(), sizeof(hpmc_counters_t));
+    m_count_run_start = h_counters.data[0];
+    m_count_step_start = h_counters.data[0];
+    }
+
+/*! \param counters Counts of the moves in the last step, summed over all ranks
+
+    Every rank computes the same factors from the reduced counts, so the move sizes stay
+    consistent across ranks. All types share one acceptance ratio. Types with a move size of 0
+    keep it, so the tuning never enables moves that the user disabled.
+*/
+void IntegratorHPMC::tuneMoveSizes(const hpmc_counters_t& counters)
+    {
+    Scalar translate_scale = m_translate_controller.update(counters.translate_accept_count,
+                                                           counters.translate_reject_count,
+                                                           m_move_size_target,
+                                                           m_move_size_gain);
+    Scalar rotate_scale = m_rotate_controller.update(counters.rotate_accept_count,
+                                                     counters.rotate_reject_count,
+                                                     m_move_size_target,
+                                                     m_move_size_gain);
+
+    if (translate_scale != Scalar(1.0))
+        {
+            {
+            ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::readwrite);
+            for (unsigned int typ = 0; typ < m_pdata->getNTypes(); typ++)
+                {
+                h_d.data[typ] = std::min(h_d.data[typ] * translate_scale, m_max_translation_move);
+                }
+            }
+
+        updateCellWidth();
+        }
+
+    if (rotate_scale != Scalar(1.0))
+        {
+        ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::readwrite);
+        for (unsigned int typ = 0; typ < m_pdata->getNTypes(); typ++)
+            {
+            h_a.data[typ] = std::min(h_a.data[typ] * rotate_scale, m_max_rotation_move);
+            }
+        }
+    }
+
 namespace detail
     {
 void export_IntegratorHPMC(pybind11::module& m)
@@ -261,9 +383,37 @@ void export_IntegratorHPMC(pybind11::module& m)
         .def("checkParticleOrientations", &IntegratorHPMC::checkParticleOrientations)
         .def("getMPS", &IntegratorHPMC::getMPS)
         .def("getCounters", &IntegratorHPMC::getCounters)
+        .def("getLocalCounters", &IntegratorHPMC::getLocalCounters)
+        .def("setLocalCounters", &IntegratorHPMC::setLocalCounters)
         .def("communicate", &IntegratorHPMC::communicate)
         .def("computeTotalPairEnergy", &IntegratorHPMC::computeTotalPairEnergy)
         .def_property("nselect", &IntegratorHPMC::getNSelect, &IntegratorHPMC::setNSelect)
+        .def_property("checkerboard",
+                      &IntegratorHPMC::getCheckerboard,
+                      &IntegratorHPMC::setCheckerboard)
+        .def_property("trials_per_move",
+                      &IntegratorHPMC::getTrialsPerMove,
+                      &IntegratorHPMC::setTrialsPerMove)
+        .def_property("detailed_counters",
+                      &IntegratorHPMC::getDetailedCounters,
+                      &IntegratorHPMC::setDetailedCounters)
+        .def("getSweepCounters", &IntegratorHPMC::getSweepCounters)
+        .def("getNarrowPhaseChecksByType", &IntegratorHPMC::getNarrowPhaseChecksByType)
+        .def_property("aabb_tree_refit_tolerance",
+                      &IntegratorHPMC::getAABBTreeRefitTolerance,
+                      &IntegratorHPMC::setAABBTreeRefitTolerance)
+        .def_property("move_size_target",
+                      &IntegratorHPMC::getMoveSizeTarget,
+                      &IntegratorHPMC::setMoveSizeTarget)
+        .def_property("move_size_gain",
+                      &IntegratorHPMC::getMoveSizeGain,
+                      &IntegratorHPMC::setMoveSizeGain)
+        .def_property("max_translation_move",
+                      &IntegratorHPMC::getMaxTranslationMove,
+                      &IntegratorHPMC::setMaxTranslationMove)
+        .def_property("max_rotation_move",
+                      &IntegratorHPMC::getMaxRotationMove,
+                      &IntegratorHPMC::setMaxRotationMove)
         .def_property("translation_move_probability",
                       &IntegratorHPMC::getTranslationMoveProbability,
                       &IntegratorHPMC::setTranslationMoveProbability)
@@ -274,6 +424,12 @@ void export_IntegratorHPMC(pybind11::module& m)
         .def_readonly("overlap_errors", &hpmc_counters_t::overlap_err_count)
         .def_property_readonly("translate", &hpmc_counters_t::getTranslateCounts)
         .def_property_readonly("rotate", &hpmc_counters_t::getRotateCounts);
+
+    pybind11::class_<hpmc_sweep_counters_t>(m, "hpmc_sweep_counters_t")
+        .def_readonly("aabb_node_visits", &hpmc_sweep_counters_t::aabb_node_visits)
+        .def_readonly("circumsphere_rejections", &hpmc_sweep_counters_t::circumsphere_rejections)
+        .def_readonly("narrow_phase_checks", &hpmc_sweep_counters_t::narrow_phase_checks)
+        .def_readonly("search_time", &hpmc_sweep_counters_t::search_time);
     }
 
     } // end namespace detail
@@ -18,13 +18,17 @@
 
 #include "ExternalField.h"
 #include "HPMCCounters.h"
+#include "MoveSizeController.h"
 #include "PairPotential.h"
+#include "PatchEnergyBatch.h"
 
 #ifndef __HIPCC__
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #endif
 
+#include <limits>
+
 #ifdef ENABLE_HIP
 #include "hoomd/Autotuner.h"
 #include "hoomd/GPUPartition.cuh"
@@ -170,6 +174,37 @@ class PatchEnergy : public Autotuned
         return 0;
         }
 
+    //! Evaluate the energies of a batch of patch interactions with particle i
+    /*! \param batch Particles j, the energy of each pair is written to batch.energy
+        \param type_i Integer type index of particle i
+        \param q_i Orientation quaternion of particle i
+        \param d_i Diameter of particle i
+        \param charge_i Charge of particle i
+
+        The base class evaluates each pair with energy().
+    */
+    virtual void energyBatch(detail::PatchEnergyBatch& batch,
+                             unsigned int type_i,
+                             const quat<float>& q_i,
+                             float d_i,
+                             float charge_i)
+        {
+        for (unsigned int k = 0; k < batch.n; k++)
+            {
+            vec3<float> r_ij(batch.r_x[k], batch.r_y[k], batch.r_z[k]);
+            quat<float> q_j(batch.q_s[k], vec3<float>(batch.q_x[k], batch.q_y[k], batch.q_z[k]));
+            batch.energy[k] = energy(r_ij,
+                                     type_i,
+                                     q_i,
+                                     d_i,
+                                     charge_i,
+                                     batch.type[k],
+                                     q_j,
+                                     batch.diameter[k],
+                                     batch.charge[k]);
+            }
+        }
+
 #ifdef ENABLE_HIP
     //! Asynchronously launch the JIT kernel
     /*! \param args Kernel arguments
@@ -207,6 +242,11 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
     //! Take one timestep forward
     virtual void update(uint64_t timestep)
         {
+        if (m_move_size_target > Scalar(0.0))
+            {
+            tuneMoveSizes(getCounters(2));
+            }
+
         ArrayHandle<hpmc_counters_t> h_counters(m_count_total,
                                                 access_location::host,
                                                 access_mode::read);
@@ -331,6 +371,141 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
         return m_nselect;
         }
 
+    //! Set whether the CPU sweeps run in parallel on a checkerboard of cells
+    void setCheckerboard(bool checkerboard)
+        {
+        m_checkerboard = checkerboard;
+        }
+
+    //! Get whether the CPU sweeps run in parallel on a checkerboard of cells
+    bool getCheckerboard()
+        {
+        return m_checkerboard;
+        }
+
+    //! Set the number of trial configurations of each particle move
+    /*! \param trials Number of trials, 1 for single trial Metropolis moves
+     */
+    void setTrialsPerMove(unsigned int trials)
+        {
+        if (trials == 0)
+            {
+            throw std::domain_error("trials_per_move must be positive.");
+            }
+        m_trials_per_move = trials;
+        updateCellWidth();
+        }
+
+    //! Get the number of trial configurations of each particle move
+    unsigned int getTrialsPerMove()
+        {
+        return m_trials_per_move;
+        }
+
+    //! Set the relative growth of the AABB tree surface area that triggers a rebuild
+    /*! \param tolerance Tolerance, 0 rebuilds the tree every time it is invalidated
+     */
+    void setAABBTreeRefitTolerance(Scalar tolerance)
+        {
+        if (tolerance < Scalar(0.0))
+            {
+            throw std::domain_error("aabb_tree_refit_tolerance must be non-negative.");
+            }
+        m_aabb_tree_refit_tolerance = tolerance;
+        }
+
+    //! Get the relative growth of the AABB tree surface area that triggers a rebuild
+    Scalar getAABBTreeRefitTolerance()
+        {
+        return m_aabb_tree_refit_tolerance;
+        }
+
+    //! Enable or disable the detailed counters of the overlap search
+    void setDetailedCounters(bool enable)
+        {
+        m_detailed_counters = enable;
+        }
+
+    //! Test if the detailed counters of the overlap search are enabled
+    bool getDetailedCounters()
+        {
+        return m_detailed_counters;
+        }
+
+    //! Get the detailed counters of the overlap search since the start of the run
+    hpmc_sweep_counters_t getSweepCounters();
+
+    //! Get the number of calls to test_overlap by the type of the moved particle
+    std::vector<unsigned long long int> getNarrowPhaseChecksByType();
+
+    //! Set the target acceptance ratio of the move size tuning
+    /*! \param target Target acceptance ratio, 0 disables the tuning
+     */
+    void setMoveSizeTarget(Scalar target)
+        {
+        if (target < Scalar(0.0) || target >= Scalar(1.0))
+            {
+            throw std::domain_error("move_size_target must be in the range [0, 1).");
+            }
+        m_move_size_target = target;
+        m_translate_controller.reset();
+        m_rotate_controller.reset();
+        }
+
+    //! Get the target acceptance ratio of the move size tuning
+    Scalar getMoveSizeTarget()
+        {
+        return m_move_size_target;
+        }
+
+    //! Set the gain of the move size tuning
+    void setMoveSizeGain(Scalar gain)
+        {
+        if (gain <= Scalar(0.0))
+            {
+            throw std::domain_error("move_size_gain must be positive.");
+            }
+        m_move_size_gain = gain;
+        }
+
+    //! Get the gain of the move size tuning
+    Scalar getMoveSizeGain()
+        {
+        return m_move_size_gain;
+        }
+
+    //! Set the largest translation move size that the tuning sets
+    void setMaxTranslationMove(Scalar max_move)
+        {
+        if (max_move <= Scalar(0.0))
+            {
+            throw std::domain_error("max_translation_move must be positive.");
+            }
+        m_max_translation_move = max_move;
+        }
+
+    //! Get the largest translation move size that the tuning sets
+    Scalar getMaxTranslationMove()
+        {
+        return m_max_translation_move;
+        }
+
+    //! Set the largest rotation move size that the tuning sets
+    void setMaxRotationMove(Scalar max_move)
+        {
+        if (max_move <= Scalar(0.0))
+            {
+            throw std::domain_error("max_rotation_move must be positive.");
+            }
+        m_max_rotation_move = max_move;
+        }
+
+    //! Get the largest rotation move size that the tuning sets
+    Scalar getMaxRotationMove()
+        {
+        return m_max_rotation_move;
+        }
+
     //! Get performance in moves per second
     virtual double getMPS()
         {
@@ -345,6 +520,8 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
                                                 access_mode::read);
         m_count_run_start = h_counters.data[0];
         m_clock = ClockSource();
+        m_sweep_count = hpmc_sweep_counters_t();
+        m_narrow_phase_checks_by_type.clear();
         }
 
     //! Get the diameter of the largest circumscribing sphere for objects handled by this integrator
@@ -363,6 +540,15 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
         return 0;
         }
 
+    //! Test if any particle of the given type overlaps another particle
+    /*! \param type Particle type
+        \returns true when a particle of type \a type overlaps any other particle
+    */
+    virtual bool checkTypeOverlaps(unsigned int type)
+        {
+        return countOverlaps(true) > 0;
+        }
+
     //! Get the number of degrees of freedom granted to a given group
     /*! \param group Group over which to count degrees of freedom.
         \return a non-zero dummy value to suppress warnings.
@@ -380,6 +566,12 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
     //! Get the current counter values
     hpmc_counters_t getCounters(unsigned int mode = 0);
 
+    //! Get the total counts of this rank as raw bytes
+    pybind11::bytes getLocalCounters();
+
+    //! Set the total counts of this rank from the bytes returned by getLocalCounters()
+    void setLocalCounters(pybind11::bytes counters);
+
     //! Communicate particles
     /*! \param migrate Set to true to both migrate and exchange, set to false to only exchange
 
@@ -401,6 +593,13 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
         m_extra_ghost_width = extra;
         updateCellWidth();
         }
+
+    //! Get the width of the inactive region at the upper faces of a domain
+    Scalar getNominalWidth()
+        {
+        return m_nominal_width;
+        }
+
     //! Method to scale the box
     virtual bool attemptBoxResize(uint64_t timestep, const BoxDim& new_box);
 
@@ -507,6 +706,30 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
                                           float(charge_j));
                 }
             }
+        energy += computeOnePairPotentialEnergy(r_squared,
+                                                r_ij,
+                                                type_i,
+                                                q_i,
+                                                charge_i,
+                                                type_j,
+                                                q_j,
+                                                charge_j);
+
+        return energy;
+        }
+
+    /// Compute the energy between two particles from the pair potentials, excluding the patch.
+    __attribute__((always_inline)) inline LongReal
+    computeOnePairPotentialEnergy(const LongReal r_squared,
+                                  const vec3<LongReal>& r_ij,
+                                  unsigned int type_i,
+                                  const quat<LongReal>& q_i,
+                                  LongReal charge_i,
+                                  unsigned int type_j,
+                                  const quat<LongReal>& q_j,
+                                  LongReal charge_j)
+        {
+        LongReal energy = 0;
         for (const auto& pair : m_pair_potentials)
             {
             if (r_squared < pair->getRCutSquaredTotal(type_i, type_j))
@@ -519,6 +742,25 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
         return energy;
         }
 
+    /// Get the lower bound of the total pair energy between two particles.
+    /*! The bound is -infinity with a patch energy, which provides no bound.
+     */
+    LongReal getPairEnergyLowerBound(unsigned int type_i, unsigned int type_j) const
+        {
+        if (m_patch)
+            {
+            return -std::numeric_limits<LongReal>::infinity();
+            }
+
+        LongReal energy_lower_bound = 0;
+        for (const auto& pair : m_pair_potentials)
+            {
+            energy_lower_bound += std::min(LongReal(0), pair->getEnergyLowerBound(type_i, type_j));
+            }
+
+        return energy_lower_bound;
+        }
+
     /// Get the list of pair potentials.
     std::vector<std::shared_ptr<PairPotential>>& getPairPotentials()
         {
@@ -545,6 +787,32 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
     protected:
     unsigned int m_translation_move_probability; //!< Fraction of moves that are translation moves.
     unsigned int m_nselect;                      //!< Number of particles to select for trial moves
+    bool m_checkerboard = false; //!< True to sweep on a checkerboard of cells on the CPU
+    unsigned int m_trials_per_move = 1; //!< Number of trial configurations of each particle move
+    Scalar m_aabb_tree_refit_tolerance = 0; //!< Surface area growth that triggers a tree rebuild
+    bool m_detailed_counters = false; //!< True to record the detailed overlap search counters
+    hpmc_sweep_counters_t m_sweep_count; //!< Detailed counters of this rank since the run start
+
+    /// Calls to test_overlap of this rank since the run start, by the type of the moved particle
+    std::vector<unsigned long long int> m_narrow_phase_checks_by_type;
+
+    /// Target acceptance ratio of the move size tuning, 0 when disabled
+    Scalar m_move_size_target = 0;
+
+    /// Gain of the move size tuning
+    Scalar m_move_size_gain = 1;
+
+    /// Largest translation move size that the tuning sets
+    Scalar m_max_translation_move = std::numeric_limits<Scalar>::infinity();
+
+    /// Largest rotation move size that the tuning sets
+    Scalar m_max_rotation_move = std::numeric_limits<Scalar>::infinity();
+
+    detail::MoveSizeController m_translate_controller; //!< Tunes the translation move sizes
+    detail::MoveSizeController m_rotate_controller;    //!< Tunes the rotation move sizes
+
+    //! Scale the move sizes toward the target acceptance ratio
+    void tuneMoveSizes(const hpmc_counters_t& counters);
 
     GPUVector<Scalar> m_d; //!< Maximum move displacement by type
     GPUVector<Scalar> m_a; //!< Maximum angular displacement by type
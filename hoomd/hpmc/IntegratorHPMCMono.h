@@ -9,6 +9,10 @@
     \brief Declaration of IntegratorHPMC
 */
 
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
@@ -16,6 +20,7 @@
 #include "hoomd/Integrator.h"
 #include "IntegratorHPMC.h"
 #include "Moves.h"
+#include "OverlapCandidates.h"
 #include "hoomd/AABBTree.h"
 #include "GSDHPMCSchema.h"
 #include "hoomd/Index1D.h"
@@ -115,6 +120,25 @@ class UpdateOrder
         std::vector<unsigned int> m_update_order; //!< Update order
     };
 
+//! Pair energy term of a trial move whose evaluation is deferred
+struct PairEnergyTerm
+    {
+    vec3<LongReal> r_ij;            //!< Position of particle j relative to particle i
+    quat<LongReal> orientation_j;   //!< Orientation of particle j
+    unsigned int j;                 //!< Index of particle j
+    unsigned int type_j;            //!< Type of particle j
+    };
+
+//! Compute log(exp(a) + exp(b)) without overflow
+inline double log_add_exp(double a, double b)
+    {
+    if (a < b)
+        std::swap(a, b);
+    if (b == -std::numeric_limits<double>::infinity())
+        return a;
+    return a + std::log1p(std::exp(b - a));
+    }
+
 }; // end namespace detail
 
 //! HPMC on systems of mono-disperse shapes
@@ -214,6 +238,18 @@ class IntegratorHPMCMono : public IntegratorHPMC
             return m_ntrial;
             }
 
+        //! Set whether depletants are sampled in the bounding regions cached per pair of types
+        void setDepletantSamplingTables(bool tables)
+            {
+            m_depletant_sampling_tables = tables;
+            }
+
+        //! Get whether depletants are sampled in the bounding regions cached per pair of types
+        bool getDepletantSamplingTables() const
+            {
+            return m_depletant_sampling_tables;
+            }
+
         //! Get the current counter values
         virtual std::vector<hpmc_implicit_counters_t> getImplicitCounters(unsigned int mode=0);
 
@@ -272,7 +308,16 @@ class IntegratorHPMCMono : public IntegratorHPMC
             }
 
         //! Count overlaps with the option to exit early at the first detected overlap
-        virtual unsigned int countOverlaps(bool early_exit);
+        virtual unsigned int countOverlaps(bool early_exit)
+            {
+            return countOverlapsOfType(early_exit, UINT_MAX);
+            }
+
+        //! Test if any particle of the given type overlaps another particle
+        virtual bool checkTypeOverlaps(unsigned int type)
+            {
+            return countOverlapsOfType(true, type) > 0;
+            }
 
         //! Return a vector that is an unwrapped overlap map
         virtual std::vector<std::pair<unsigned int, unsigned int> > mapOverlaps();
@@ -281,7 +326,10 @@ class IntegratorHPMCMono : public IntegratorHPMC
         virtual Scalar getGhostLayerWidth(unsigned int type)
             {
             Scalar ghost_width = m_nominal_width + m_extra_ghost_width;
-            m_exec_conf->msg->notice(9) << "IntegratorHPMCMono: ghost layer width of " << ghost_width << std::endl;
+            m_exec_conf->msg->notice(9, [&](std::ostream& out)
+                {
+                out << "IntegratorHPMCMono: ghost layer width of " << ghost_width << std::endl;
+                });
             return ghost_width;
             }
 
@@ -293,9 +341,6 @@ class IntegratorHPMCMono : public IntegratorHPMC
             flags[comm_flag::position] = 1;
             flags[comm_flag::tag] = 1;
 
-            std::ostringstream o;
-            o << "IntegratorHPMCMono: Requesting communication flags for pos tag orientation";
-
             // many things depend internally on the orientation field (for ghosts) being initialized, therefore always request it
             flags[comm_flag::orientation] = 1;
 
@@ -303,7 +348,6 @@ class IntegratorHPMCMono : public IntegratorHPMC
                 {
                 flags[comm_flag::diameter] = 1;
                 flags[comm_flag::charge] = 1;
-                o << " diameter charge";
                 }
 
             bool have_auxilliary_variables = false;
@@ -319,10 +363,17 @@ class IntegratorHPMCMono : public IntegratorHPMC
             if (have_auxilliary_variables)
                 {
                 flags[comm_flag::velocity] = 1;
-                o << " velocity";
                 }
 
-            m_exec_conf->msg->notice(9) << o.str() << std::endl;
+            m_exec_conf->msg->notice(9, [&](std::ostream& out)
+                {
+                out << "IntegratorHPMCMono: Requesting communication flags for pos tag orientation";
+                if (flags[comm_flag::diameter])
+                    out << " diameter charge";
+                if (flags[comm_flag::velocity])
+                    out << " velocity";
+                out << std::endl;
+                });
             return flags;
             }
         #endif
@@ -445,6 +496,8 @@ class IntegratorHPMCMono : public IntegratorHPMC
         hoomd::detail::AABB* m_aabbs;                      //!< list of AABBs, one per particle
         unsigned int m_aabbs_capacity;              //!< Capacity of m_aabbs list
         bool m_aabb_tree_invalid;                   //!< Flag if the aabb tree has been invalidated
+        bool m_aabb_tree_rebuild = true;            //!< Flag if the particle indices in the tree have changed
+        Scalar m_aabb_tree_build_quality = 0;       //!< Relative surface area of the tree when it was built
 
         Scalar m_extra_image_width;                 //! Extra width to extend the image list
 
@@ -456,6 +509,65 @@ class IntegratorHPMCMono : public IntegratorHPMC
         /// Cached shape radius by type.
         std::vector<LongReal> m_shape_circumsphere_radius;
 
+        /// Cached lower bound of the pair energy by pair of types (indexed by m_overlap_idx).
+        std::vector<LongReal> m_pair_energy_lower_bound;
+
+        /// True when trial moves may reject early using the pair energy lower bounds.
+        bool m_pair_early_exit = false;
+
+        /// True when trial moves defer the pair energy terms until there are no overlaps.
+        bool m_defer_pair_energy = false;
+
+        /// Deferred pair energy terms of the old configuration in the serial trial moves.
+        std::vector<detail::PairEnergyTerm> m_old_pair_terms;
+
+        /// Deferred pair energy terms of the new configuration in the serial trial moves.
+        std::vector<detail::PairEnergyTerm> m_new_pair_terms;
+
+        /// Neighbors of the particle in a multiple-trial move, relative to its old position.
+        std::vector<detail::PairEnergyTerm> m_trial_neighbors;
+
+        /// Pair energy terms of one configuration in a multiple-trial move.
+        std::vector<detail::PairEnergyTerm> m_trial_terms;
+
+        /// True when depletants are sampled in the bounding regions cached per pair of types.
+        bool m_depletant_sampling_tables = false;
+
+        /// Radius of the sphere to sample depletants of type a in that overlap a particle of type i
+        /// (indexed by m_overlap_idx(i, a)), zero to sample in the extended OBB of the particle.
+        std::vector<ShortReal> m_depletant_sampling_radius;
+
+        /// Update m_depletant_sampling_radius for the current shape parameters
+        void updateDepletantSamplingTables(bool has_depletants);
+
+        /// Get the region to sample the depletants of type type_a in that overlap a particle
+        detail::OBB getDepletantSamplingRegion(const detail::OBB& obb, const vec3<Scalar>& pos,
+                                               unsigned int type_i, unsigned int type_a) const
+            {
+            const unsigned int idx = m_overlap_idx(type_i, type_a);
+            if (idx < m_depletant_sampling_radius.size() && m_depletant_sampling_radius[idx] > 0)
+                return detail::OBB(vec3<ShortReal>(pos), m_depletant_sampling_radius[idx]);
+            return obb;
+            }
+
+        /// First entry of each checkerboard cell in m_checkerboard_cell_particles.
+        std::vector<unsigned int> m_checkerboard_cell_start;
+
+        /// Particle indices sorted by checkerboard cell.
+        std::vector<unsigned int> m_checkerboard_cell_particles;
+
+        /// Checkerboard cell of each particle.
+        std::vector<unsigned int> m_checkerboard_cell;
+
+        /// Count the overlaps, with early_exit only those of the particles of the given type
+        unsigned int countOverlapsOfType(bool early_exit, unsigned int type);
+
+        /// Tags of the particles that overlapped in the most recent early exit overlap checks.
+        std::vector<unsigned int> m_recent_overlap_tags;
+
+        /// Maximum number of entries in m_recent_overlap_tags.
+        static constexpr size_t m_max_recent_overlaps = 16;
+
         /* Depletants related data members */
 
         GlobalVector<Scalar> m_fugacity;            //!< Average depletant number density in free volume, per type
@@ -481,6 +593,35 @@ class IntegratorHPMCMono : public IntegratorHPMC
         //! Limit the maximum move distances
         virtual void limitMoveDistances();
 
+        //! Get the dimensions of the checkerboard cell grid (zero when the box is too small)
+        uint3 getCheckerboardDim();
+
+        //! Perform all trial moves of this step on a checkerboard of cells
+        void updateCheckerboard(uint64_t timestep, uint3 dim, hpmc_counters_t& counters);
+
+        //! Test a batch of overlap candidates and empty it
+        bool testOverlapCandidates(detail::OverlapCandidates& candidates, unsigned int i, const Shape& shape_i, const Scalar4* orientation, hpmc_counters_t& counters,
+                                   hpmc_sweep_counters_t* sweep = nullptr);
+
+        //! Apply the Metropolis criterion to a trial move with deferred pair energy terms
+        bool acceptPairEnergyTerms(double u, double energy_diff, unsigned int i, unsigned int typ_i,
+                                   const quat<LongReal>& orientation_old, const quat<LongReal>& orientation_new,
+                                   const std::vector<detail::PairEnergyTerm>& old_terms,
+                                   const std::vector<detail::PairEnergyTerm>& new_terms,
+                                   const Scalar* diameter, const Scalar* charge);
+
+        //! Perform a multiple-trial move of particle i
+        bool multipleTrialMove(uint64_t timestep, unsigned int i, hoomd::RandomGenerator& rng_i, bool move_type_translate,
+                               Scalar move_size, LongReal min_core_radius,
+                               const std::vector<LongReal>& pair_energy_search_radius, vec3<Scalar>& pos_i, Shape& shape_i,
+                               const Scalar4* postype, const Scalar4* orientation, const Scalar* diameter,
+                               const Scalar* charge, const unsigned int* overlaps, hpmc_counters_t& counters);
+
+        //! Sum the deferred pair energy terms of particle i, evaluating the patch energies in batches
+        LongReal sumPairEnergyTerms(unsigned int i, unsigned int typ_i, const quat<LongReal>& orientation_i,
+                                    const std::vector<detail::PairEnergyTerm>& terms,
+                                    const Scalar* diameter, const Scalar* charge);
+
         //! callback so that the box change signal can invalidate the image list
         virtual void slotBoxChanged()
             {
@@ -495,6 +636,8 @@ class IntegratorHPMCMono : public IntegratorHPMC
         virtual void slotSorted()
             {
             m_aabb_tree_invalid = true;
+            // the leaves refer to particle indices, so the tree cannot be refit
+            m_aabb_tree_rebuild = true;
             }
     };
 
@@ -605,7 +748,10 @@ template <class Shape>
 void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
     {
     Integrator::update(timestep);
-    m_exec_conf->msg->notice(10) << "HPMCMono update: " << timestep << std::endl;
+    m_exec_conf->msg->notice(10, [&](std::ostream& out)
+        {
+        out << "HPMCMono update: " << timestep << std::endl;
+        });
     IntegratorHPMC::update(timestep);
 
     // get needed vars
@@ -628,8 +774,6 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
     m_update_order.resize(m_pdata->getN());
     m_update_order.shuffle(timestep, m_sysdef->getSeed(), m_exec_conf->getRank());
 
-    // update the AABB Tree
-    buildAABBTree();
     // limit m_d entries so that particles cannot possibly wander more than one box image in one time step
     limitMoveDistances();
     // update the image list
@@ -670,8 +814,53 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
         m_max_pair_additive_cutoff.push_back(getMaxPairInteractionAdditiveRCut(type));
         }
 
-    // loop over local particles nselect times
-    for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
+    updateDepletantSamplingTables(has_depletants);
+
+    // with finite lower bounds of the pair energy, trial moves are rejected as soon as the
+    // remaining pair energies cannot lead to acceptance
+    m_pair_early_exit = hasPairInteractions();
+    m_pair_energy_lower_bound.resize(m_overlap_idx.getNumElements());
+    for (unsigned int type_i = 0; type_i < m_pdata->getNTypes(); type_i++)
+        {
+        for (unsigned int type_j = 0; type_j < m_pdata->getNTypes(); type_j++)
+            {
+            LongReal energy_lower_bound = getPairEnergyLowerBound(type_i, type_j);
+            m_pair_energy_lower_bound[m_overlap_idx(type_i, type_j)] = energy_lower_bound;
+            m_pair_early_exit = m_pair_early_exit && std::isfinite(energy_lower_bound);
+            }
+        }
+
+    // patch energies have no lower bound, but deferring them evaluates them in batches
+    m_defer_pair_energy = m_pair_early_exit || m_patch;
+    const bool defer_pair_energy = m_defer_pair_energy;
+
+    // multiple-trial moves sample the serial sweep
+    const bool use_multiple_trials = m_trials_per_move > 1 && !has_depletants;
+
+    // sweep on a checkerboard of cells in parallel when possible
+    uint3 checkerboard_dim = make_uint3(0, 0, 0);
+    if (m_checkerboard && !has_depletants && !use_multiple_trials
+        #ifdef ENABLE_MPI
+        && !m_sysdef->isDomainDecomposed()
+        #endif
+        )
+        {
+        checkerboard_dim = getCheckerboardDim();
+        }
+    const bool use_checkerboard = checkerboard_dim.x > 0;
+
+    if (use_checkerboard)
+        updateCheckerboard(timestep, checkerboard_dim, counters);
+    else
+        buildAABBTree();
+
+    // otherwise, loop over local particles nselect times
+    const unsigned int n_serial_select = use_checkerboard ? 0 : m_nselect;
+    hpmc_sweep_counters_t sweep;
+    if (m_detailed_counters)
+        m_narrow_phase_checks_by_type.resize(m_pdata->getNTypes(), 0);
+
+    for (unsigned int i_nselect = 0; i_nselect < n_serial_select; i_nselect++)
         {
         // access particle data and system box
         ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
@@ -714,6 +903,49 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
             Shape shape_old(shape_i.orientation, m_params[typ_i]);
             vec3<Scalar> pos_old = pos_i;
 
+            if (use_multiple_trials)
+                {
+                // a zero move size leaves the particle in place, like the single trial move
+                const Scalar move_size = move_type_translate ? h_d.data[typ_i] : h_a.data[typ_i];
+                bool accept = move_size == 0.0
+                    || multipleTrialMove(timestep, i, rng_i, move_type_translate, move_size, min_core_radius,
+                                         pair_energy_search_radius, pos_i, shape_i, h_postype.data, h_orientation.data, h_diameter.data,
+                                         h_charge.data, h_overlaps.data, counters);
+
+                if (!shape_i.ignoreStatistics())
+                    {
+                    if (move_type_translate && accept)
+                        counters.translate_accept_count++;
+                    else if (move_type_translate)
+                        counters.translate_reject_count++;
+                    else if (accept)
+                        counters.rotate_accept_count++;
+                    else
+                        counters.rotate_reject_count++;
+                    }
+
+                if (accept)
+                    {
+                    hoomd::detail::AABB aabb;
+                    if (!hasPairInteractions())
+                        {
+                        aabb = shape_i.getAABB(pos_i);
+                        }
+                    else
+                        {
+                        Scalar radius = std::max(m_shape_circumsphere_radius[typ_i],
+                            LongReal(0.5) * m_max_pair_additive_cutoff[typ_i]);
+                        aabb = hoomd::detail::AABB(pos_i, radius);
+                        }
+                    m_aabb_tree.update(i, aabb);
+
+                    h_postype.data[i] = make_scalar4(pos_i.x, pos_i.y, pos_i.z, postype_i.w);
+                    if (shape_i.hasOrientation())
+                        h_orientation.data[i] = quat_to_scalar4(shape_i.orientation);
+                    }
+                continue;
+                }
+
             if (move_type_translate)
                 {
                 // skip if no overlap check is required
@@ -753,6 +985,10 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
 
             bool overlap=false;
 
+            // time the overlap search and attribute its narrow phase checks to the type of i
+            const int64_t search_start = m_detailed_counters ? m_clock.getTime() : 0;
+            const unsigned long long int narrow_phase_start = sweep.narrow_phase_checks;
+
             // search for all particles that might touch this one
             LongReal R_query = m_shape_circumsphere_radius[typ_i];
 
@@ -765,8 +1001,14 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
 
             hoomd::detail::AABB aabb_i_local = hoomd::detail::AABB(vec3<Scalar>(0,0,0),R_query);
 
+            // without pair interactions, test the overlaps in batches
+            const bool batch_overlaps = !hasPairInteractions();
+            detail::OverlapCandidates candidates;
+
             // patch + field interaction deltaU
             double patch_field_energy_diff = 0;
+            m_old_pair_terms.clear();
+            m_new_pair_terms.clear();
 
             // check for overlaps with neighboring particle's positions (also calculate the new energy)
             // All image boxes (including the primary)
@@ -780,6 +1022,7 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                 // stackless search
                 for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
                     {
+                    sweep.aabb_node_visits++;
                     if (aabb.overlaps(m_aabb_tree.getNodeAABB(cur_node_idx)))
                         {
                         if (m_aabb_tree.isNodeLeaf(cur_node_idx))
@@ -818,18 +1061,48 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                                 vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
 
                                 unsigned int typ_j = __scalar_as_int(postype_j.w);
+
+                                if (batch_overlaps)
+                                    {
+                                    LongReal max_overlap_distance = m_shape_circumsphere_radius[typ_i] + m_shape_circumsphere_radius[typ_j];
+                                    candidates.push(r_ij, j, typ_j,
+                                                    h_overlaps.data[m_overlap_idx(typ_i, typ_j)] ? max_overlap_distance * max_overlap_distance : LongReal(-1.0));
+                                    if (candidates.full() && testOverlapCandidates(candidates, i, shape_i, h_orientation.data, counters, &sweep))
+                                        {
+                                        overlap = true;
+                                        break;
+                                        }
+                                    continue;
+                                    }
+
                                 Shape shape_j(orientation_j, m_params[typ_j]);
 
                                 LongReal r_squared = dot(r_ij, r_ij);
                                 LongReal max_overlap_distance = m_shape_circumsphere_radius[typ_i] + m_shape_circumsphere_radius[typ_j];
 
                                 counters.overlap_checks++;
-                                if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
-                                    && r_squared < max_overlap_distance * max_overlap_distance
-                                    && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
+                                if (!h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
+                                    || r_squared >= max_overlap_distance * max_overlap_distance)
                                     {
-                                    overlap = true;
-                                    break;
+                                    sweep.circumsphere_rejections++;
+                                    }
+                                else
+                                    {
+                                    sweep.narrow_phase_checks++;
+                                    if (test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
+                                        {
+                                        overlap = true;
+                                        break;
+                                        }
+                                    }
+
+                                if (defer_pair_energy)
+                                    {
+                                    // defer the evaluation until there are no overlaps
+                                    LongReal r_cut = pair_energy_search_radius[typ_i] + LongReal(0.5) * m_max_pair_additive_cutoff[typ_j];
+                                    if (r_squared < r_cut * r_cut)
+                                        m_new_pair_terms.push_back({r_ij, shape_j.orientation, j, typ_j});
+                                    continue;
                                     }
 
                                 // deltaU = U_old - U_new: subtract energy of new configuration
@@ -855,10 +1128,20 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                         break;
                     }  // end loop over AABB nodes
 
+                // test the remaining candidates of this image
+                if (!overlap && candidates.n > 0)
+                    overlap = testOverlapCandidates(candidates, i, shape_i, h_orientation.data, counters, &sweep);
+
                 if (overlap)
                     break;
                 } // end loop over images
 
+            if (m_detailed_counters)
+                {
+                sweep.search_time += m_clock.getTime() - search_start;
+                m_narrow_phase_checks_by_type[typ_i] += sweep.narrow_phase_checks - narrow_phase_start;
+                }
+
             // Calculate old pair energy only when there are pair energies to calculate.
             if (hasPairInteractions() && !overlap)
                 {
@@ -910,6 +1193,14 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                                     unsigned int typ_j = __scalar_as_int(postype_j.w);
                                     Shape shape_j(orientation_j, m_params[typ_j]);
 
+                                    if (defer_pair_energy)
+                                        {
+                                        LongReal r_cut = pair_energy_search_radius[typ_i] + LongReal(0.5) * m_max_pair_additive_cutoff[typ_j];
+                                        if (dot(r_ij, r_ij) < r_cut * r_cut)
+                                            m_old_pair_terms.push_back({r_ij, shape_j.orientation, j, typ_j});
+                                        continue;
+                                        }
+
                                     // deltaU = U_old - U_new: add energy of old configuration
                                     patch_field_energy_diff += computeOnePairEnergy(dot(r_ij, r_ij),
                                                             r_ij,
@@ -939,7 +1230,16 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                 patch_field_energy_diff -= m_external->energydiff(timestep, i, pos_old, shape_old, pos_i, shape_i);
                 }
 
-            bool accept = !overlap && hoomd::detail::generate_canonical<double>(rng_i) < slow::exp(patch_field_energy_diff);
+            bool accept = false;
+            if (!overlap)
+                {
+                double u = hoomd::detail::generate_canonical<double>(rng_i);
+                if (defer_pair_energy)
+                    accept = acceptPairEnergyTerms(u, patch_field_energy_diff, i, typ_i, shape_old.orientation, shape_i.orientation,
+                                                   m_old_pair_terms, m_new_pair_terms, h_diameter.data, h_charge.data);
+                else
+                    accept = u < slow::exp(patch_field_energy_diff);
+                }
 
             // The trial move is valid, so check if it is invalidated by depletants
             unsigned int seed_i_new = hoomd::detail::generate_u32(rng_i);
@@ -1006,6 +1306,11 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
             } // end loop over all particles
         } // end loop over nselect
 
+    if (m_detailed_counters)
+        {
+        m_sweep_count = m_sweep_count + sweep;
+        }
+
         {
         ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
         ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
@@ -1059,15 +1364,823 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
     m_mps = double(run_counters.getNMoves()) / cur_time;
     }
 
-/*! \param timestep current step
-    \param early_exit exit at first overlap found if true
+/*! \param candidates Candidates found by the broad phase for particle i
+    \param i Index of the particle that is moved
+    \param shape_i Shape of particle i after the trial move
+    \param orientation Orientations of the particles
+    \param counters Counters to add the overlap checks to
+    \param sweep Detailed counters to add the rejections and the exact overlap tests to (may be null)
+    \returns true when particle i overlaps any of the candidates
+
+    The candidates that pass the batched circumsphere test proceed to the bounding volume test and
+    then to the exact overlap test in the order they were found. Like the unbatched loop, the
+    overlap checks count every candidate up to the first overlap. Candidate i is the image of
+    particle i itself and takes its new orientation.
+*/
+template <class Shape>
+bool IntegratorHPMCMono<Shape>::testOverlapCandidates(detail::OverlapCandidates& candidates,
+                                                      unsigned int i,
+                                                      const Shape& shape_i,
+                                                      const Scalar4* orientation,
+                                                      hpmc_counters_t& counters,
+                                                      hpmc_sweep_counters_t* sweep)
+    {
+    const unsigned int n_pass = candidates.filter();
+    if (sweep)
+        sweep->circumsphere_rejections += candidates.n - n_pass;
+    for (unsigned int cur_pass = 0; cur_pass < n_pass; cur_pass++)
+        {
+        const unsigned int k = candidates.pass[cur_pass];
+        const unsigned int j = candidates.index[k];
+        quat<LongReal> orientation_j = (j == i) ? quat<LongReal>(shape_i.orientation) : quat<LongReal>(orientation[j]);
+        Shape shape_j(orientation_j, m_params[candidates.type[k]]);
+        vec3<Scalar> r_ij(candidates.x[k], candidates.y[k], candidates.z[k]);
+
+        if (!test_bounding_volume_overlap(r_ij, shape_i, shape_j))
+            continue;
+
+        if (sweep)
+            sweep->narrow_phase_checks++;
+        if (test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
+            {
+            counters.overlap_checks += k + 1;
+            candidates.clear();
+            return true;
+            }
+        }
+
+    counters.overlap_checks += candidates.n;
+    candidates.clear();
+    return false;
+    }
+
+/*! \param timestep Current timestep
+    \param i Index of the particle that is moved
+    \param rng_i Random number generator of the trial move
+    \param move_type_translate True for translation moves, false for rotation moves
+    \param move_size Maximum translation or rotation move size
+    \param min_core_radius Half the minimum core diameter
+    \param pair_energy_search_radius Search radius of the pair energies by type
+    \param pos_i Position of particle i, set to the new position when the move is accepted
+    \param shape_i Shape of particle i, set to the new orientation when the move is accepted
+    \param postype Particle positions and types
+    \param orientation Particle orientations
+    \param diameter Particle diameters
+    \param charge Particle charges
+    \param overlaps Interaction matrix
+    \param counters Counters to add the overlap checks to
+
+    \returns true when the move is accepted
+
+    The move generates k = trials_per_move trial configurations b_j of particle i with the symmetric
+    single trial move and selects b_n with probability w(b_n) / W, where w(b) = exp(-U(b)) is the
+    Boltzmann weight of particle i in configuration b (zero when it overlaps) and W = sum_j w(b_j).
+    It then generates k - 1 reference configurations from b_n and accepts b_n with probability
+    min(1, W / W'), where W' is the sum of the weights of the reference configurations and the old
+    configuration. This satisfies detailed balance (Frenkel and Smit, Understanding Molecular
+    Simulation, section 13.1).
+
+    The trial and reference positions are within 2d of the old position, so the neighbors are
+    gathered once for all 2k configurations. The pair energy terms of each configuration are
+    evaluated with sumPairEnergyTerms() and the weights are summed in log space.
+*/
+template<class Shape>
+bool IntegratorHPMCMono<Shape>::multipleTrialMove(uint64_t timestep, unsigned int i, hoomd::RandomGenerator& rng_i, bool move_type_translate,
+                                                  Scalar move_size, LongReal min_core_radius,
+                                                  const std::vector<LongReal>& pair_energy_search_radius, vec3<Scalar>& pos_i, Shape& shape_i,
+                                                  const Scalar4* postype, const Scalar4* orientation, const Scalar* diameter,
+                                                  const Scalar* charge, const unsigned int* overlaps, hpmc_counters_t& counters)
+    {
+    const unsigned int ndim = this->m_sysdef->getNDimensions();
+    const unsigned int typ_i = __scalar_as_int(postype[i].w);
+    const vec3<Scalar> pos_old = pos_i;
+    const Shape shape_old(shape_i.orientation, m_params[typ_i]);
+
+    #ifdef ENABLE_MPI
+    const BoxDim box = m_pdata->getBox();
+    const Scalar3 ghost_fraction = m_nominal_width / box.getNearestPlaneDistance();
+    #endif
+
+    // gather the neighbors within reach of all trial and reference positions
+    LongReal R_query = m_shape_circumsphere_radius[typ_i];
+    if (hasPairInteractions())
+        R_query = std::max(R_query, pair_energy_search_radius[typ_i] - min_core_radius);
+    if (move_type_translate)
+        R_query += LongReal(2.0) * move_size;
+    const hoomd::detail::AABB aabb_i_local(vec3<Scalar>(0, 0, 0), R_query);
+
+    m_trial_neighbors.clear();
+    for (unsigned int cur_image = 0; cur_image < m_image_list.size(); cur_image++)
+        {
+        vec3<Scalar> pos_i_image = pos_old + m_image_list[cur_image];
+        hoomd::detail::AABB aabb = aabb_i_local;
+        aabb.translate(pos_i_image);
+
+        // stackless search
+        for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
+            {
+            if (aabb.overlaps(m_aabb_tree.getNodeAABB(cur_node_idx)))
+                {
+                if (m_aabb_tree.isNodeLeaf(cur_node_idx))
+                    {
+                    for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                        {
+                        unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                        // the images of particle i move and rotate with it
+                        if (j == i)
+                            {
+                            if (cur_image != 0)
+                                m_trial_neighbors.push_back({vec3<LongReal>(-m_image_list[cur_image]), quat<LongReal>(), i, typ_i});
+                            continue;
+                            }
+
+                        m_trial_neighbors.push_back({vec3<LongReal>(vec3<Scalar>(postype[j]) - pos_i_image),
+                                                     quat<LongReal>(orientation[j]), j, (unsigned int)__scalar_as_int(postype[j].w)});
+                        }
+                    }
+                }
+            else
+                {
+                // skip ahead
+                cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
+                }
+            }
+        }
+
+    const double inf = std::numeric_limits<double>::infinity();
+
+    // energy of particle i in a configuration, infinite when it overlaps
+    auto energy = [&](const vec3<Scalar>& pos, const Shape& shape, bool check_overlaps) -> double
+        {
+        #ifdef ENABLE_MPI
+        if (m_sysdef->isDomainDecomposed() && !isActive(vec_to_scalar3(pos), box, ghost_fraction))
+            return inf;
+        #endif
+
+        const vec3<LongReal> dr(pos - pos_old);
+        m_trial_terms.clear();
+        for (const auto& neighbor : m_trial_neighbors)
+            {
+            const bool self = neighbor.j == i;
+            const vec3<LongReal> r_ij = self ? neighbor.r_ij : neighbor.r_ij - dr;
+            const quat<LongReal> orientation_j = self ? quat<LongReal>(shape.orientation) : neighbor.orientation_j;
+            const LongReal r_squared = dot(r_ij, r_ij);
+
+            if (check_overlaps)
+                {
+                Shape shape_j(orientation_j, m_params[neighbor.type_j]);
+                LongReal max_overlap_distance = m_shape_circumsphere_radius[typ_i] + m_shape_circumsphere_radius[neighbor.type_j];
+
+                counters.overlap_checks++;
+                if (overlaps[m_overlap_idx(typ_i, neighbor.type_j)]
+                    && r_squared < max_overlap_distance * max_overlap_distance
+                    && test_overlap(vec3<Scalar>(r_ij), shape, shape_j, counters.overlap_err_count))
+                    return inf;
+                }
+
+            if (hasPairInteractions())
+                {
+                LongReal r_cut = pair_energy_search_radius[typ_i] + LongReal(0.5) * m_max_pair_additive_cutoff[neighbor.type_j];
+                if (r_squared < r_cut * r_cut)
+                    m_trial_terms.push_back({r_ij, orientation_j, neighbor.j, neighbor.type_j});
+                }
+            }
+
+        double u = sumPairEnergyTerms(i, typ_i, quat<LongReal>(shape.orientation), m_trial_terms, diameter, charge);
+        if (m_external)
+            u += m_external->energydiff(timestep, i, pos_old, shape_old, pos, shape);
+        return u;
+        };
+
+    // generate a configuration from the given one with the single trial move
+    auto generate_trial = [&](vec3<Scalar>& pos, Shape& shape)
+        {
+        if (move_type_translate)
+            move_translate(pos, rng_i, move_size, ndim);
+        else if (ndim == 2)
+            move_rotate<2>(shape.orientation, rng_i, move_size);
+        else
+            move_rotate<3>(shape.orientation, rng_i, move_size);
+        };
+
+    // select one of the trials with probability w / W as the trials are generated
+    double log_w_trials = -inf;
+    vec3<Scalar> pos_new = pos_old;
+    quat<Scalar> orientation_new = shape_old.orientation;
+    for (unsigned int k = 0; k < m_trials_per_move; k++)
+        {
+        vec3<Scalar> pos_trial = pos_old;
+        Shape shape_trial(shape_old.orientation, m_params[typ_i]);
+        generate_trial(pos_trial, shape_trial);
+
+        const double log_w = -energy(pos_trial, shape_trial, true);
+        if (log_w == -inf)
+            continue;
+
+        log_w_trials = detail::log_add_exp(log_w_trials, log_w);
+        if (hoomd::detail::generate_canonical<double>(rng_i) < slow::exp(log_w - log_w_trials))
+            {
+            pos_new = pos_trial;
+            orientation_new = shape_trial.orientation;
+            }
+        }
+
+    if (log_w_trials == -inf)
+        return false;
+
+    // the old configuration is one of the reference configurations
+    double log_w_reference = -energy(pos_old, shape_old, false);
+    for (unsigned int k = 1; k < m_trials_per_move; k++)
+        {
+        vec3<Scalar> pos_reference = pos_new;
+        Shape shape_reference(orientation_new, m_params[typ_i]);
+        generate_trial(pos_reference, shape_reference);
+        log_w_reference = detail::log_add_exp(log_w_reference, -energy(pos_reference, shape_reference, true));
+        }
+
+    const double u = hoomd::detail::generate_canonical<double>(rng_i);
+    if (!(std::log(u) < log_w_trials - log_w_reference))
+        return false;
+
+    pos_i = pos_new;
+    shape_i.orientation = orientation_new;
+    return true;
+    }
+
+/*! \param u Uniform random number that decides the acceptance
+    \param energy_diff Sum of the energy differences (U_old - U_new) evaluated so far
+    \param i Index of the moved particle
+    \param typ_i Type of the moved particle
+    \param orientation_old Orientation of particle i in the old configuration
+    \param orientation_new Orientation of particle i in the new configuration
+    \param old_terms Pair terms of particle i in the old configuration
+    \param new_terms Pair terms of particle i in the new configuration
+    \param diameter Particle diameters
+    \param charge Particle charges
+
+    \returns true when the trial move is accepted
+
+    The Metropolis criterion accepts the move when log(u) < U_old - U_new. When all pair energies
+    are bounded from below, the remaining new terms can increase U_old - U_new by at most the sum of
+    the negated bounds. The old terms are evaluated first and the move is rejected as soon as the
+    bound shows that it cannot be accepted. The outcome is the same as evaluating all terms.
+*/
+template<class Shape>
+bool IntegratorHPMCMono<Shape>::acceptPairEnergyTerms(double u, double energy_diff, unsigned int i, unsigned int typ_i,
+                                                      const quat<LongReal>& orientation_old, const quat<LongReal>& orientation_new,
+                                                      const std::vector<detail::PairEnergyTerm>& old_terms,
+                                                      const std::vector<detail::PairEnergyTerm>& new_terms,
+                                                      const Scalar* diameter, const Scalar* charge)
+    {
+    energy_diff += sumPairEnergyTerms(i, typ_i, orientation_old, old_terms, diameter, charge);
+
+    if (!m_pair_early_exit)
+        {
+        energy_diff -= sumPairEnergyTerms(i, typ_i, orientation_new, new_terms, diameter, charge);
+        return u < slow::exp(energy_diff);
+        }
+
+    double max_increase = 0;
+    for (const auto& term : new_terms)
+        max_increase -= m_pair_energy_lower_bound[m_overlap_idx(typ_i, term.type_j)];
+
+    const double log_u = std::log(u);
+    for (const auto& term : new_terms)
+        {
+        if (energy_diff + max_increase < log_u)
+            return false;
+
+        energy_diff -= computeOnePairEnergy(dot(term.r_ij, term.r_ij), term.r_ij, typ_i, orientation_new,
+                                            diameter[i], charge[i], term.type_j, term.orientation_j,
+                                            diameter[term.j], charge[term.j]);
+        max_increase += m_pair_energy_lower_bound[m_overlap_idx(typ_i, term.type_j)];
+        }
+
+    return u < slow::exp(energy_diff);
+    }
+
+/*! \param i Index of particle i
+    \param typ_i Type of particle i
+    \param orientation_i Orientation of particle i
+    \param terms Pair terms of particle i
+    \param diameter Particle diameters
+    \param charge Particle charges
+
+    \returns The sum of the pair energies
+
+    The patch energies of the pairs within the patch cutoff are evaluated in batches with
+    PatchEnergy::energyBatch().
+*/
+template<class Shape>
+LongReal IntegratorHPMCMono<Shape>::sumPairEnergyTerms(unsigned int i, unsigned int typ_i, const quat<LongReal>& orientation_i,
+                                                       const std::vector<detail::PairEnergyTerm>& terms,
+                                                       const Scalar* diameter, const Scalar* charge)
+    {
+    LongReal energy = 0;
+    for (const auto& term : terms)
+        {
+        energy += computeOnePairPotentialEnergy(dot(term.r_ij, term.r_ij), term.r_ij, typ_i, orientation_i, charge[i],
+                                                term.type_j, term.orientation_j, charge[term.j]);
+        }
+
+    if (m_patch)
+        {
+        const quat<float> q_i(orientation_i);
+        detail::PatchEnergyBatch batch;
+        auto evaluate_batch = [&]()
+            {
+            m_patch->energyBatch(batch, typ_i, q_i, float(diameter[i]), float(charge[i]));
+            for (unsigned int k = 0; k < batch.n; k++)
+                energy += batch.energy[k];
+            batch.clear();
+            };
+
+        const LongReal r_cut_patch = m_patch->getRCut();
+        const LongReal additive_cutoff_i = m_patch->getAdditiveCutoff(typ_i);
+        for (const auto& term : terms)
+            {
+            LongReal r_cut = r_cut_patch + LongReal(0.5) * (additive_cutoff_i + m_patch->getAdditiveCutoff(term.type_j));
+            if (dot(term.r_ij, term.r_ij) >= r_cut * r_cut)
+                continue;
+
+            batch.push(vec3<float>(term.r_ij), term.type_j, quat<float>(term.orientation_j),
+                       float(diameter[term.j]), float(charge[term.j]));
+            if (batch.full())
+                evaluate_batch();
+            }
+        evaluate_batch();
+        }
+
+    return energy;
+    }
+
+/*! \param has_depletants True when any depletant fugacity is non-zero
+
+    A depletant of type a overlaps a particle of type i only inside the particle's OBB extended by
+    the circumsphere radius of a, and only inside the sphere whose radius is the sum of both
+    circumsphere radii. checkDepletantOverlap() samples the depletants that may overlap the particle
+    uniformly in one of these regions. Both contain every depletant that overlaps the particle, so
+    the choice does not change the result. With depletant sampling tables, this method caches the
+    smaller region for each pair of types so that fewer sampled depletants miss the particle.
+
+    Shapes whose OBB is a sphere already sample in a sphere, and 2D systems always use the extended
+    OBB.
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::updateDepletantSamplingTables(bool has_depletants)
+    {
+    m_depletant_sampling_radius.assign(m_overlap_idx.getNumElements(), ShortReal(0.0));
+    if (!has_depletants || !m_depletant_sampling_tables || m_sysdef->getNDimensions() != 3)
+        return;
+
+    for (unsigned int type_i = 0; type_i < m_pdata->getNTypes(); type_i++)
+        {
+        Shape shape_i(quat<Scalar>(), m_params[type_i]);
+        detail::OBB obb_i = shape_i.getOBB(vec3<Scalar>(0, 0, 0));
+        if (obb_i.isSphere())
+            continue;
+
+        for (unsigned int type_a = 0; type_a < m_pdata->getNTypes(); type_a++)
+            {
+            Shape shape_a(quat<Scalar>(), m_params[type_a]);
+            ShortReal r = ShortReal(0.5) * shape_a.getCircumsphereDiameter();
+
+            detail::OBB obb = obb_i;
+            obb.lengths.x += r;
+            obb.lengths.y += r;
+            obb.lengths.z += r;
+
+            ShortReal R = ShortReal(0.5) * shape_i.getCircumsphereDiameter() + r;
+            if (ShortReal(4.0 / 3.0 * M_PI) * R * R * R < obb.getVolume(3))
+                m_depletant_sampling_radius[m_overlap_idx(type_i, type_a)] = R;
+            }
+        }
+    }
+
+/*! \returns The number of checkerboard cells in each direction. Each is even and at least 2, and
+    the cells are at least as wide as the largest distance at which two particles interact. Returns
+    zeros when the box is too small for such a grid.
+*/
+template <class Shape>
+uint3 IntegratorHPMCMono<Shape>::getCheckerboardDim()
+    {
+    const BoxDim box = m_pdata->getBox();
+    const unsigned int ndim = this->m_sysdef->getNDimensions();
+    const uchar3 periodic = box.getPeriodic();
+    if (!periodic.x || !periodic.y || (ndim == 3 && !periodic.z))
+        return make_uint3(0, 0, 0);
+
+    // particle i finds particle j within the search radius of i plus the AABB extent of j
+    const LongReal min_core_radius = getMinCoreDiameter() * LongReal(0.5);
+    const auto& pair_energy_search_radius = getPairEnergySearchRadius();
+    LongReal max_query = 0;
+    LongReal max_extent = 0;
+    for (unsigned int type = 0; type < m_pdata->getNTypes(); type++)
+        {
+        LongReal R_query = m_shape_circumsphere_radius[type];
+        LongReal extent = m_shape_circumsphere_radius[type];
+        if (hasPairInteractions())
+            {
+            R_query = std::max(R_query, pair_energy_search_radius[type] - min_core_radius);
+            extent = std::max(extent, LongReal(0.5) * m_max_pair_additive_cutoff[type]);
+            }
+        max_query = std::max(max_query, R_query);
+        max_extent = std::max(max_extent, extent);
+        }
+    const LongReal width = max_query + max_extent;
+
+    // bound the number of cells when the particles do not interact at all
+    const Scalar max_cells = Scalar(1024);
+    Scalar3 npd = box.getNearestPlaneDistance();
+    auto n_cells = [&](Scalar L) -> unsigned int
+        {
+        Scalar n = width > 0 ? std::min(Scalar(std::floor(L / width)), max_cells) : max_cells;
+        unsigned int result = (unsigned int)n;
+        return result - result % 2;
+        };
+
+    uint3 dim = make_uint3(n_cells(npd.x), n_cells(npd.y), ndim == 3 ? n_cells(npd.z) : 1);
+    if (dim.x < 2 || dim.y < 2 || (ndim == 3 && dim.z < 2))
+        return make_uint3(0, 0, 0);
+
+    return dim;
+    }
+
+/*! \param timestep Current time step
+    \param dim Dimensions of the checkerboard cell grid from getCheckerboardDim()
+    \param counters Counters to add the trial moves to
+
+    Each of the nselect sweeps assigns the particles to the cells of a grid shifted by a random
+    offset. The cells split into 2^d sets of cells that are two cells apart in every direction, and
+    the sweep processes the sets one after the other in a random order. Particles in different cells
+    of the same set cannot interact, so the cells of one set move in parallel while the rest of the
+    system is frozen. Within a cell, one thread moves the particles in the update order. A trial
+    move that would leave the cell is rejected, which preserves detailed balance as in
+    IntegratorHPMCMonoGPU. Each particle draws its trial move from its own RNG stream, so the result
+    does not depend on the number of threads.
+
+    The caller ensures that there are no depletants and no domain decomposition.
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::updateCheckerboard(uint64_t timestep,
+                                                   uint3 dim,
+                                                   hpmc_counters_t& counters)
+    {
+    const BoxDim box = m_pdata->getBox();
+    const unsigned int ndim = this->m_sysdef->getNDimensions();
+    const unsigned int N = m_pdata->getN();
+    const uint16_t seed = m_sysdef->getSeed();
+    const Index3D cell_indexer(dim.x, dim.y, dim.z);
+    const unsigned int n_cells = cell_indexer.getNumElements();
+    const unsigned int n_sets = ndim == 3 ? 8 : 4;
+    const uint3 set_dim = make_uint3(dim.x / 2, dim.y / 2, ndim == 3 ? dim.z / 2 : 1);
+    const unsigned int n_set_cells = set_dim.x * set_dim.y * set_dim.z;
+
+    const LongReal min_core_radius = getMinCoreDiameter() * LongReal(0.5);
+    const auto& pair_energy_search_radius = getPairEnergySearchRadius();
+    const bool defer_pair_energy = m_defer_pair_energy;
+
+    ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::read);
+
+    m_checkerboard_cell.resize(N);
+    m_checkerboard_cell_particles.resize(N);
+    m_checkerboard_cell_start.resize(n_cells + 1);
+
+    #ifdef ENABLE_TBB
+    tbb::enumerable_thread_specific<hpmc_counters_t> thread_counters;
+    #endif
+
+    for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
+        {
+        hoomd::RandomGenerator rng(hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoCheckerboard, timestep, seed),
+                                   hoomd::Counter(i_nselect));
+
+        // shift the grid by a random fraction of the box
+        hoomd::UniformDistribution<Scalar> uniform(Scalar(0.0), Scalar(1.0));
+        Scalar3 shift = make_scalar3(uniform(rng) / dim.x, uniform(rng) / dim.y, 0);
+        if (ndim == 3)
+            shift.z = uniform(rng) / dim.z;
+
+        auto get_cell = [&](const vec3<Scalar>& pos)
+            {
+            Scalar3 f = box.makeFraction(vec_to_scalar3(pos)) + shift;
+            f.x -= std::floor(f.x);
+            f.y -= std::floor(f.y);
+            f.z -= std::floor(f.z);
+            unsigned int ib = std::min((unsigned int)(f.x * dim.x), dim.x - 1);
+            unsigned int jb = std::min((unsigned int)(f.y * dim.y), dim.y - 1);
+            unsigned int kb = ndim == 3 ? std::min((unsigned int)(f.z * dim.z), dim.z - 1) : 0;
+            return cell_indexer(ib, jb, kb);
+            };
+
+        // sort the particles into the cells, keeping the update order within each cell
+        std::fill(m_checkerboard_cell_start.begin(), m_checkerboard_cell_start.end(), 0);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            m_checkerboard_cell[i] = get_cell(vec3<Scalar>(h_postype.data[i]));
+            m_checkerboard_cell_start[m_checkerboard_cell[i] + 1]++;
+            }
+        for (unsigned int cell = 0; cell < n_cells; cell++)
+            m_checkerboard_cell_start[cell + 1] += m_checkerboard_cell_start[cell];
+        std::vector<unsigned int> cell_fill(m_checkerboard_cell_start.begin(), m_checkerboard_cell_start.end() - 1);
+        for (unsigned int cur_particle = 0; cur_particle < N; cur_particle++)
+            {
+            unsigned int i = m_update_order[cur_particle];
+            m_checkerboard_cell_particles[cell_fill[m_checkerboard_cell[i]]++] = i;
+            }
+
+        // process the sets of cells in a random order
+        unsigned int set_order[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+        for (unsigned int k = n_sets - 1; k > 0; k--)
+            std::swap(set_order[k], set_order[hoomd::UniformIntDistribution(k)(rng)]);
+
+        for (unsigned int cur_set = 0; cur_set < n_sets; cur_set++)
+            {
+            const unsigned int set = set_order[cur_set];
+
+            auto move_cell = [&](unsigned int set_cell, hpmc_counters_t& cell_counters)
+                {
+                const unsigned int cx = 2 * (set_cell % set_dim.x) + (set & 1);
+                const unsigned int cy = 2 * ((set_cell / set_dim.x) % set_dim.y) + ((set >> 1) & 1);
+                const unsigned int cz = ndim == 3 ? 2 * (set_cell / (set_dim.x * set_dim.y)) + ((set >> 2) & 1) : 0;
+                const unsigned int my_cell = cell_indexer(cx, cy, cz);
+
+                // find the unique neighboring cells (including this one)
+                unsigned int neighbor_cells[27];
+                unsigned int n_neighbor_cells = 0;
+                const int kmax = ndim == 3 ? 1 : 0;
+                for (int k = -kmax; k <= kmax; k++)
+                    for (int j = -1; j <= 1; j++)
+                        for (int l = -1; l <= 1; l++)
+                            {
+                            unsigned int neigh = cell_indexer((cx + dim.x + l) % dim.x,
+                                                              (cy + dim.y + j) % dim.y,
+                                                              (cz + dim.z + k) % dim.z);
+                            if (std::find(neighbor_cells, neighbor_cells + n_neighbor_cells, neigh)
+                                == neighbor_cells + n_neighbor_cells)
+                                neighbor_cells[n_neighbor_cells++] = neigh;
+                            }
+
+                // deferred pair energy terms of each trial move
+                std::vector<detail::PairEnergyTerm> old_pair_terms;
+                std::vector<detail::PairEnergyTerm> new_pair_terms;
+
+                for (unsigned int cur_p = m_checkerboard_cell_start[my_cell];
+                     cur_p < m_checkerboard_cell_start[my_cell + 1]; cur_p++)
+                    {
+                    unsigned int i = m_checkerboard_cell_particles[cur_p];
+
+                    // read in the current position and orientation
+                    Scalar4 postype_i = h_postype.data[i];
+                    vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+
+                    // make a trial move for i
+                    hoomd::RandomGenerator rng_i(hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoTrialMove, timestep, seed),
+                                                 hoomd::Counter(i, m_exec_conf->getRank(), i_nselect));
+                    int typ_i = __scalar_as_int(postype_i.w);
+                    Shape shape_i(quat<LongReal>(h_orientation.data[i]), m_params[typ_i]);
+                    unsigned int move_type_select = hoomd::UniformIntDistribution(0xffff)(rng_i);
+                    bool move_type_translate = !shape_i.hasOrientation() || (move_type_select < m_translation_move_probability);
+
+                    Shape shape_old(shape_i.orientation, m_params[typ_i]);
+                    vec3<Scalar> pos_old = pos_i;
+
+                    bool overlap = false;
+                    if (move_type_translate)
+                        {
+                        // skip if no overlap check is required
+                        if (h_d.data[typ_i] == 0.0)
+                            {
+                            if (!shape_i.ignoreStatistics())
+                                cell_counters.translate_accept_count++;
+                            continue;
+                            }
+
+                        move_translate(pos_i, rng_i, h_d.data[typ_i], ndim);
+
+                        // reject moves that leave the cell
+                        overlap = get_cell(pos_i) != my_cell;
+                        }
+                    else
+                        {
+                        if (h_a.data[typ_i] == 0.0)
+                            {
+                            if (!shape_i.ignoreStatistics())
+                                cell_counters.rotate_accept_count++;
+                            continue;
+                            }
+
+                        if (ndim == 2)
+                            move_rotate<2>(shape_i.orientation, rng_i, h_a.data[typ_i]);
+                        else
+                            move_rotate<3>(shape_i.orientation, rng_i, h_a.data[typ_i]);
+                        }
+
+                    // without pair interactions, test the overlaps in batches
+                    const bool batch_overlaps = !hasPairInteractions();
+                    detail::OverlapCandidates candidates;
+
+                    // patch + field interaction deltaU
+                    double patch_field_energy_diff = 0;
+                    old_pair_terms.clear();
+                    new_pair_terms.clear();
+
+                    // check for overlaps with the particles in the neighboring cells (also calculate the new energy)
+                    for (unsigned int cur_cell = 0; cur_cell < n_neighbor_cells && !overlap; cur_cell++)
+                        {
+                        const unsigned int neigh_cell = neighbor_cells[cur_cell];
+                        for (unsigned int cur_j = m_checkerboard_cell_start[neigh_cell];
+                             cur_j < m_checkerboard_cell_start[neigh_cell + 1]; cur_j++)
+                            {
+                            unsigned int j = m_checkerboard_cell_particles[cur_j];
+                            if (j == i)
+                                continue;
+
+                            Scalar4 postype_j = h_postype.data[j];
+                            vec3<Scalar> r_ij = box.minImage(vec3<Scalar>(postype_j) - pos_i);
+
+                            unsigned int typ_j = __scalar_as_int(postype_j.w);
+
+                            if (batch_overlaps)
+                                {
+                                LongReal max_overlap_distance = m_shape_circumsphere_radius[typ_i] + m_shape_circumsphere_radius[typ_j];
+                                candidates.push(r_ij, j, typ_j,
+                                                h_overlaps.data[m_overlap_idx(typ_i, typ_j)] ? max_overlap_distance * max_overlap_distance : LongReal(-1.0));
+                                if (candidates.full() && testOverlapCandidates(candidates, i, shape_i, h_orientation.data, cell_counters))
+                                    {
+                                    overlap = true;
+                                    break;
+                                    }
+                                continue;
+                                }
+
+                            Shape shape_j(quat<LongReal>(h_orientation.data[j]), m_params[typ_j]);
+
+                            LongReal r_squared = dot(r_ij, r_ij);
+                            LongReal max_overlap_distance = m_shape_circumsphere_radius[typ_i] + m_shape_circumsphere_radius[typ_j];
+
+                            cell_counters.overlap_checks++;
+                            if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
+                                && r_squared < max_overlap_distance * max_overlap_distance
+                                && test_overlap(r_ij, shape_i, shape_j, cell_counters.overlap_err_count))
+                                {
+                                overlap = true;
+                                break;
+                                }
+
+                            if (defer_pair_energy)
+                                {
+                                // defer the evaluation until there are no overlaps
+                                LongReal r_cut = pair_energy_search_radius[typ_i] + LongReal(0.5) * m_max_pair_additive_cutoff[typ_j];
+                                if (r_squared < r_cut * r_cut)
+                                    new_pair_terms.push_back({r_ij, shape_j.orientation, j, typ_j});
+                                continue;
+                                }
+
+                            // deltaU = U_old - U_new: subtract energy of new configuration
+                            patch_field_energy_diff -= computeOnePairEnergy(r_squared, r_ij, typ_i,
+                                                    shape_i.orientation,
+                                                    h_diameter.data[i],
+                                                    h_charge.data[i],
+                                                    typ_j,
+                                                    shape_j.orientation,
+                                                    h_diameter.data[j],
+                                                    h_charge.data[j]);
+                            }
+                        }
+
+                    // test the remaining candidates
+                    if (!overlap && candidates.n > 0)
+                        overlap = testOverlapCandidates(candidates, i, shape_i, h_orientation.data, cell_counters);
+
+                    // Calculate old pair energy only when there are pair energies to calculate.
+                    if (hasPairInteractions() && !overlap)
+                        {
+                        for (unsigned int cur_cell = 0; cur_cell < n_neighbor_cells; cur_cell++)
+                            {
+                            const unsigned int neigh_cell = neighbor_cells[cur_cell];
+                            for (unsigned int cur_j = m_checkerboard_cell_start[neigh_cell];
+                                 cur_j < m_checkerboard_cell_start[neigh_cell + 1]; cur_j++)
+                                {
+                                unsigned int j = m_checkerboard_cell_particles[cur_j];
+                                if (j == i)
+                                    continue;
+
+                                Scalar4 postype_j = h_postype.data[j];
+                                vec3<Scalar> r_ij = box.minImage(vec3<Scalar>(postype_j) - pos_old);
+                                unsigned int typ_j = __scalar_as_int(postype_j.w);
+
+                                if (defer_pair_energy)
+                                    {
+                                    LongReal r_cut = pair_energy_search_radius[typ_i] + LongReal(0.5) * m_max_pair_additive_cutoff[typ_j];
+                                    if (dot(r_ij, r_ij) < r_cut * r_cut)
+                                        old_pair_terms.push_back({r_ij, quat<LongReal>(h_orientation.data[j]), j, typ_j});
+                                    continue;
+                                    }
+
+                                // deltaU = U_old - U_new: add energy of old configuration
+                                patch_field_energy_diff += computeOnePairEnergy(dot(r_ij, r_ij),
+                                                        r_ij,
+                                                        typ_i,
+                                                        shape_old.orientation,
+                                                        h_diameter.data[i],
+                                                        h_charge.data[i],
+                                                        typ_j,
+                                                        quat<LongReal>(h_orientation.data[j]),
+                                                        h_diameter.data[j],
+                                                        h_charge.data[j]);
+                                }
+                            }
+                        }
+
+                    // Add external energetic contribution if there are no overlaps
+                    if (m_external && !overlap)
+                        {
+                        patch_field_energy_diff -= m_external->energydiff(timestep, i, pos_old, shape_old, pos_i, shape_i);
+                        }
+
+                    bool accept = false;
+                    if (!overlap)
+                        {
+                        double u = hoomd::detail::generate_canonical<double>(rng_i);
+                        if (defer_pair_energy)
+                            accept = acceptPairEnergyTerms(u, patch_field_energy_diff, i, typ_i, shape_old.orientation, shape_i.orientation,
+                                                           old_pair_terms, new_pair_terms, h_diameter.data, h_charge.data);
+                        else
+                            accept = u < slow::exp(patch_field_energy_diff);
+                        }
+
+                    if (accept)
+                        {
+                        if (!shape_i.ignoreStatistics())
+                            {
+                            if (move_type_translate)
+                                cell_counters.translate_accept_count++;
+                            else
+                                cell_counters.rotate_accept_count++;
+                            }
+
+                        h_postype.data[i] = make_scalar4(pos_i.x, pos_i.y, pos_i.z, postype_i.w);
+                        if (shape_i.hasOrientation())
+                            {
+                            h_orientation.data[i] = quat_to_scalar4(shape_i.orientation);
+                            }
+                        }
+                    else
+                        {
+                        if (!shape_i.ignoreStatistics())
+                            {
+                            if (move_type_translate)
+                                cell_counters.translate_reject_count++;
+                            else
+                                cell_counters.rotate_reject_count++;
+                            }
+                        }
+                    } // end loop over the particles in the cell
+                };
+
+            #ifdef ENABLE_TBB
+            m_exec_conf->getTaskArena()->execute([&]{
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_set_cells),
+                [&](const tbb::blocked_range<unsigned int>& r) {
+                hpmc_counters_t& local_counters = thread_counters.local();
+                for (unsigned int set_cell = r.begin(); set_cell != r.end(); ++set_cell)
+                    move_cell(set_cell, local_counters);
+                });
+            });
+            #else
+            for (unsigned int set_cell = 0; set_cell < n_set_cells; set_cell++)
+                move_cell(set_cell, counters);
+            #endif
+            } // end loop over the sets of cells
+        } // end loop over nselect
+
+    #ifdef ENABLE_TBB
+    for (auto& local_counters : thread_counters)
+        counters = counters + local_counters;
+    #endif
+    }
+
+/*! \param early_exit exit at first overlap found if true
+    \param type With \a early_exit, test only the particles of this type (UINT_MAX tests all)
     \returns number of overlaps if early_exit=false, 1 if early_exit=true
+
+    With \a early_exit, the particles that overlapped in the most recent early exit checks are
+    tested first. Box and shape moves that are rejected tend to be rejected by the same tight
+    contacts, so most rejections test only a few particles. The remaining particles are then tested
+    on the TBB threads, which stop as soon as any thread finds an overlap.
 */
 template <class Shape>
-unsigned int IntegratorHPMCMono<Shape>::countOverlaps(bool early_exit)
+unsigned int IntegratorHPMCMono<Shape>::countOverlapsOfType(bool early_exit, unsigned int type)
     {
     unsigned int overlap_count = 0;
-    unsigned int err_count = 0;
 
     // build an up to date AABB tree
     buildAABBTree();
@@ -1082,9 +2195,12 @@ unsigned int IntegratorHPMCMono<Shape>::countOverlaps(bool early_exit)
     // access parameters and interaction matrix
     ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
 
-    // Loop over all particles
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    // count the overlaps of particle i, stop at the first one with early_exit. Without early_exit,
+    // each pair is counted from the particle with the lower tag.
+    auto count_particle_overlaps = [&](unsigned int i, unsigned int& err_count)
         {
+        unsigned int count = 0;
+
         // read in the current position and orientation
         Scalar4 postype_i = h_postype.data[i];
         Scalar4 orientation_i = h_orientation.data[i];
@@ -1127,18 +2243,15 @@ unsigned int IntegratorHPMCMono<Shape>::countOverlaps(bool early_exit)
                             unsigned int typ_j = __scalar_as_int(postype_j.w);
                             Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
 
-                            if (h_tag.data[i] <= h_tag.data[j]
+                            if ((early_exit || h_tag.data[i] <= h_tag.data[j])
                                 && h_overlaps.data[m_overlap_idx(typ_i,typ_j)]
                                 && check_circumsphere_overlap(r_ij, shape_i, shape_j)
                                 && test_overlap(r_ij, shape_i, shape_j, err_count)
                                 && test_overlap(-r_ij, shape_j, shape_i, err_count))
                                 {
-                                overlap_count++;
+                                count++;
                                 if (early_exit)
-                                    {
-                                    // exit early from loop over neighbor particles
-                                    break;
-                                    }
+                                    return count;
                                 }
                             }
                         }
@@ -1148,24 +2261,90 @@ unsigned int IntegratorHPMCMono<Shape>::countOverlaps(bool early_exit)
                     // skip ahead
                     cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
                     }
-
-                if (overlap_count && early_exit)
-                    {
-                    break;
-                    }
                 } // end loop over AABB nodes
+            } // end loop over images
+
+        return count;
+        };
+
+    const unsigned int N = m_pdata->getN();
+    unsigned int err_count = 0;
+    if (!early_exit)
+        {
+        for (unsigned int i = 0; i < N; i++)
+            overlap_count += count_particle_overlaps(i, err_count);
+        }
+    else
+        {
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+        const size_t n_rtag = m_pdata->getRTags().getNumElements();
 
-            if (overlap_count && early_exit)
+        // test the particles that overlapped most recently first
+        for (size_t k = 0; k < m_recent_overlap_tags.size() && !overlap_count; k++)
+            {
+            const unsigned int tag = m_recent_overlap_tags[k];
+            if (tag >= n_rtag || h_rtag.data[tag] >= N)
+                continue;
+            if (type != UINT_MAX
+                && (unsigned int)__scalar_as_int(h_postype.data[h_rtag.data[tag]].w) != type)
+                continue;
+
+            if (count_particle_overlaps(h_rtag.data[tag], err_count))
                 {
-                break;
+                // move the particle to the front of the list
+                std::rotate(m_recent_overlap_tags.begin(),
+                            m_recent_overlap_tags.begin() + k,
+                            m_recent_overlap_tags.begin() + k + 1);
+                overlap_count = 1;
                 }
-            } // end loop over images
+            }
 
-        if (overlap_count && early_exit)
+        if (!overlap_count)
             {
-            break;
+            // index of a particle with an overlap, N while none has been found
+            std::atomic<unsigned int> found(N);
+
+            auto test_range = [&](unsigned int begin, unsigned int end)
+                {
+                unsigned int local_err_count = 0;
+                for (unsigned int i = begin; i < end; i++)
+                    {
+                    if (found.load(std::memory_order_relaxed) != N)
+                        return;
+
+                    if (type != UINT_MAX && (unsigned int)__scalar_as_int(h_postype.data[i].w) != type)
+                        continue;
+
+                    if (count_particle_overlaps(i, local_err_count))
+                        {
+                        unsigned int none = N;
+                        found.compare_exchange_strong(none, i);
+                        return;
+                        }
+                    }
+                };
+
+            #ifdef ENABLE_TBB
+            m_exec_conf->getTaskArena()->execute([&]{
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                [&](const tbb::blocked_range<unsigned int>& r) {
+                test_range(r.begin(), r.end());
+                });
+            });
+            #else
+            test_range(0, N);
+            #endif
+
+            const unsigned int i = found.load();
+            if (i != N)
+                {
+                overlap_count = 1;
+                m_recent_overlap_tags.insert(m_recent_overlap_tags.begin(), h_tag.data[i]);
+                if (m_recent_overlap_tags.size() > m_max_recent_overlaps)
+                    m_recent_overlap_tags.pop_back();
+                }
             }
-        } // end loop over particles
+        }
 
     #ifdef ENABLE_MPI
     if (this->m_pdata->getDomainDecomposition())
@@ -1194,7 +2373,10 @@ double IntegratorHPMCMono<Shape>::computePairEnergy(uint64_t timestep, std::shar
     // return if nothing to do
     if (!hasPairInteractions()) return 0;
 
-    m_exec_conf->msg->notice(10) << "HPMC compute patch energy: " << timestep << std::endl;
+    m_exec_conf->msg->notice(10, [&](std::ostream& out)
+        {
+        out << "HPMC compute patch energy: " << timestep << std::endl;
+        });
 
     if (!m_past_first_run)
         {
@@ -1504,7 +2686,9 @@ inline const std::vector<vec3<Scalar> >& IntegratorHPMCMono<Shape>::updateImageL
                 Scalar range_ij = detail::max(r_cut_shape,r_cut_patch_ij);
                 range_i = detail::max(range_i,range_ij);
                 }
-            max_trans_d_and_diam = detail::max(max_trans_d_and_diam, range_i+Scalar(m_nselect)*h_d.data[typ_i]);
+            // the reference positions of multiple-trial moves reach one move size further
+            unsigned int n_moves = m_nselect + (m_trials_per_move > 1 ? 1 : 0);
+            max_trans_d_and_diam = detail::max(max_trans_d_and_diam, range_i+Scalar(n_moves)*h_d.data[typ_i]);
             }
         }
 
@@ -1717,7 +2901,10 @@ const hoomd::detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
     {
     if (m_aabb_tree_invalid)
         {
-        m_exec_conf->msg->notice(8) << "Building AABB tree: " << m_pdata->getN() << " ptls " << m_pdata->getNGhosts() << " ghosts" << std::endl;
+        m_exec_conf->msg->notice(8, [&](std::ostream& out)
+            {
+            out << "Building AABB tree: " << m_pdata->getN() << " ptls " << m_pdata->getNGhosts() << " ghosts" << std::endl;
+            });
         // build the AABB tree
             {
             ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
@@ -1754,7 +2941,39 @@ const hoomd::detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
                         m_aabbs[i] = hoomd::detail::AABB(vec3<Scalar>(h_postype.data[i]), radius);
                         }
                     }
-                m_aabb_tree.buildTree(m_aabbs, n_aabb);
+
+                // refit the existing tree while its quality remains close to that of a new build
+                bool refit = false;
+                if (m_aabb_tree_refit_tolerance > 0 && !m_aabb_tree_rebuild
+                    && n_aabb == m_aabb_tree.getNumParticles()
+                    #ifdef ENABLE_MPI
+                    && !m_sysdef->isDomainDecomposed()
+                    #endif
+                    )
+                    {
+                    m_aabb_tree.refit(m_aabbs, n_aabb);
+                    refit = m_aabb_tree.getRelativeSurfaceArea()
+                            <= (Scalar(1.0) + m_aabb_tree_refit_tolerance) * m_aabb_tree_build_quality;
+                    }
+
+                if (!refit)
+                    {
+                    #ifdef ENABLE_TBB
+                    // build the top levels of the tree in parallel on the user's threads
+                    if (m_exec_conf->getNumThreads() > 1)
+                        {
+                        m_exec_conf->getTaskArena()->execute([&]{
+                            m_aabb_tree.buildTree(m_aabbs, n_aabb, true);
+                            });
+                        }
+                    else
+                    #endif
+                        {
+                        m_aabb_tree.buildTree(m_aabbs, n_aabb);
+                        }
+                    m_aabb_tree_build_quality = m_aabb_tree.getRelativeSurfaceArea();
+                    m_aabb_tree_rebuild = false;
+                    }
                 }
             }
 
@@ -2172,7 +3391,9 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
         for (unsigned int new_config = 0; new_config < 2; ++new_config)
         #endif
             {
-            detail::OBB obb_i = new_config ? obb_i_new : obb_i_old;
+            detail::OBB obb_i = getDepletantSamplingRegion(new_config ? obb_i_new : obb_i_old,
+                                                           new_config ? pos_i : pos_i_old,
+                                                           typ_i, type_a);
             Scalar V_i = obb_i.getVolume(ndim);
 
             #ifdef ENABLE_TBB
@@ -2386,6 +3607,11 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
                         obb_k.lengths.y += r;
                         obb_k.lengths.z += r;
 
+                        obb_k = getDepletantSamplingRegion(obb_k,
+                                                           new_config ? pos_j_new[k] : pos_j_old[k],
+                                                           new_config ? type_j_new[k] : type_j_old[k],
+                                                           type_a);
+
                         V_k = obb_k.getVolume(ndim);
                         }
 
@@ -2730,6 +3956,9 @@ template < class Shape > void export_IntegratorHPMCMono(pybind11::module& m, con
           .def("setDepletantNtrial", &IntegratorHPMCMono<Shape>::setNtrialPy)
           .def("setDepletantFugacity", &IntegratorHPMCMono<Shape>::setDepletantFugacityPy)
           .def("getDepletantFugacity", &IntegratorHPMCMono<Shape>::getDepletantFugacityPy)
+          .def_property("depletant_sampling_tables",
+                        &IntegratorHPMCMono<Shape>::getDepletantSamplingTables,
+                        &IntegratorHPMCMono<Shape>::setDepletantSamplingTables)
           .def("getTypeShapesPy", &IntegratorHPMCMono<Shape>::getTypeShapesPy)
           .def("getShape", &IntegratorHPMCMono<Shape>::getShape)
           .def("setShape", &IntegratorHPMCMono<Shape>::setShape)
@@ -1965,8 +1965,9 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
 
     this->communicate(true);
 
-    // all particle have been moved, the aabb tree is now invalid
+    // all particle have been moved, the aabb tree and the cell list are now invalid
     this->m_aabb_tree_invalid = true;
+    this->m_cl->notifyParticlesMoved();
 
     // set current MPS value
     hpmc_counters_t run_counters = this->getCounters(1);
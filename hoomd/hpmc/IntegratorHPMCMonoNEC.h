@@ -7,6 +7,11 @@
 #include "IntegratorHPMCMono.h"
 #include "hoomd/Autotuner.h"
 
+#include <atomic>
+#include <limits>
+#include <utility>
+#include <vector>
+
 /*! \file IntegratorHPMCMonoNEC.h
     \brief Defines the template class for HPMC with Newtonian event chains
     \note This header cannot be compiled by nvcc
@@ -203,6 +208,22 @@ template<class Shape> class IntegratorHPMCMonoNEC : public IntegratorHPMCMono<Sh
                          hpmc_nec_counters_t& nec_counters,
                          vec3<Scalar>& collisionPlaneVector);
 
+    //! Get the dimensions of the checkerboard cell grid for chains (zero when the box is too small)
+    uint3 getChainCheckerboardDim(const Scalar* d);
+
+    //! Perform all chains and rotation moves of this step on a checkerboard of cells
+    void updateChainsCheckerboard(uint64_t timestep,
+                                  uint3 dim,
+                                  ArrayHandle<unsigned int>& h_overlaps,
+                                  ArrayHandle<Scalar4>& h_postype,
+                                  ArrayHandle<Scalar4>& h_velocities,
+                                  ArrayHandle<Scalar4>& h_orientation,
+                                  ArrayHandle<int3>& h_image,
+                                  ArrayHandle<Scalar>& h_d,
+                                  ArrayHandle<Scalar>& h_a,
+                                  hpmc_counters_t& counters,
+                                  hpmc_nec_counters_t& nec_counters);
+
     public:
     //! Take one timestep forward
     virtual void update(uint64_t timestep);
@@ -319,8 +340,31 @@ template<class Shape> void IntegratorHPMCMonoNEC<Shape>::update(uint64_t timeste
 
     uint16_t seed = this->m_sysdef->getSeed();
 
-    // loop over local particles nselect times
-    for (unsigned int i_nselect = 0; i_nselect < this->m_nselect; i_nselect++)
+    // run the chains on a checkerboard of cells in parallel when possible
+    uint3 checkerboard_dim = make_uint3(0, 0, 0);
+    if (this->m_checkerboard)
+        {
+        this->limitMoveDistances();
+        checkerboard_dim = getChainCheckerboardDim(h_d.data);
+        }
+    const bool use_checkerboard = checkerboard_dim.x > 0;
+
+    if (use_checkerboard)
+        updateChainsCheckerboard(timestep,
+                                 checkerboard_dim,
+                                 h_overlaps,
+                                 h_postype,
+                                 h_velocities,
+                                 h_orientation,
+                                 h_image,
+                                 h_d,
+                                 h_a,
+                                 counters,
+                                 nec_counters);
+
+    // otherwise, loop over local particles nselect times
+    const unsigned int n_serial_select = use_checkerboard ? 0 : this->m_nselect;
+    for (unsigned int i_nselect = 0; i_nselect < n_serial_select; i_nselect++)
         {
         // With chains particles move way more, so we need to update the AABB-Tree more often.
         // Previously n_select = 1 was fine. To avoid confusion
@@ -882,6 +926,545 @@ double IntegratorHPMCMonoNEC<Shape>::sweepDistance(vec3<Scalar>& direction,
     return sweepableDistance;
     }
 
+/*! \param d Maximum sweep distance of each particle type
+    \returns The number of checkerboard cells in each direction. Each is even and at least 2, and
+    all are zero when the box is too small for the checkerboard.
+
+    A sweep of particle i finds the particles j within the maximum sweep distance plus the
+    circumsphere radii of i and j, so the cells are at least that wide.
+*/
+template<class Shape> uint3 IntegratorHPMCMonoNEC<Shape>::getChainCheckerboardDim(const Scalar* d)
+    {
+    const BoxDim box = this->m_pdata->getBox();
+    const unsigned int ndim = this->m_sysdef->getNDimensions();
+    const uchar3 periodic = box.getPeriodic();
+    if (!periodic.x || !periodic.y || (ndim == 3 && !periodic.z))
+        return make_uint3(0, 0, 0);
+
+    Scalar max_diameter = 0;
+    Scalar max_d = 0;
+    for (unsigned int type = 0; type < this->m_pdata->getNTypes(); type++)
+        {
+        Shape shape(quat<Scalar>(), this->m_params[type]);
+        max_diameter = std::max(max_diameter, Scalar(shape.getCircumsphereDiameter()));
+        max_d = std::max(max_d, d[type]);
+        }
+    const Scalar width = max_diameter + max_d;
+
+    // bound the number of cells when the particles do not interact at all
+    const Scalar max_cells = Scalar(1024);
+    Scalar3 npd = box.getNearestPlaneDistance();
+    auto n_cells = [&](Scalar L) -> unsigned int
+    {
+        Scalar n = width > 0 ? std::min(Scalar(std::floor(L / width)), max_cells) : max_cells;
+        unsigned int result = (unsigned int)n;
+        return result - result % 2;
+    };
+
+    uint3 dim = make_uint3(n_cells(npd.x), n_cells(npd.y), ndim == 3 ? n_cells(npd.z) : 1);
+    if (dim.x < 2 || dim.y < 2 || (ndim == 3 && dim.z < 2))
+        return make_uint3(0, 0, 0);
+
+    return dim;
+    }
+
+/*! \param timestep Current time step
+    \param dim Dimensions of the checkerboard cell grid from getChainCheckerboardDim()
+    \param counters Counters to add the rotation moves and chain events to
+    \param nec_counters Counters to add the chain statistics to
+
+    Each of the nselect sweeps assigns the particles to the cells of a grid shifted by a random
+    offset, as IntegratorHPMCMono::updateCheckerboard() does, and processes the 2^d sets of cells
+    that are two cells apart in every direction one after the other in a random order. The cells
+    of one set run their chains in parallel. On average, each cell starts update_fraction times
+    its number of particles chains (or rotation moves) at random particles in the cell.
+
+    Chains stay in their cell. A chain ends when the moving particle reaches the cell boundary or
+    when it collides with a particle in a neighboring cell. The collided particle receives its
+    velocity change after all cells of the set finish, in the order of the cells, so the result
+    does not depend on the number of threads.
+*/
+template<class Shape>
+void IntegratorHPMCMonoNEC<Shape>::updateChainsCheckerboard(uint64_t timestep,
+                                                            uint3 dim,
+                                                            ArrayHandle<unsigned int>& h_overlaps,
+                                                            ArrayHandle<Scalar4>& h_postype,
+                                                            ArrayHandle<Scalar4>& h_velocities,
+                                                            ArrayHandle<Scalar4>& h_orientation,
+                                                            ArrayHandle<int3>& h_image,
+                                                            ArrayHandle<Scalar>& h_d,
+                                                            ArrayHandle<Scalar>& h_a,
+                                                            hpmc_counters_t& counters,
+                                                            hpmc_nec_counters_t& nec_counters)
+    {
+    const BoxDim box = this->m_pdata->getBox();
+    const unsigned int ndim = this->m_sysdef->getNDimensions();
+    const unsigned int N = this->m_pdata->getN();
+    const uint16_t seed = this->m_sysdef->getSeed();
+    const Index3D cell_indexer(dim.x, dim.y, dim.z);
+    const unsigned int n_cells = cell_indexer.getNumElements();
+    const unsigned int n_sets = ndim == 3 ? 8 : 4;
+    const uint3 set_dim = make_uint3(dim.x / 2, dim.y / 2, ndim == 3 ? dim.z / 2 : 1);
+    const unsigned int n_set_cells = set_dim.x * set_dim.y * set_dim.z;
+    const unsigned int max_chain_length = 100000;
+
+    this->m_checkerboard_cell.resize(N);
+    this->m_checkerboard_cell_particles.resize(N);
+    this->m_checkerboard_cell_start.resize(n_cells + 1);
+
+    // counters and pressure statistics of one thread
+    struct chain_counters_t
+        {
+        hpmc_counters_t counters;
+        hpmc_nec_counters_t nec_counters;
+        Scalar pressurevirial = 0;
+        Scalar movelength = 0;
+        };
+
+#ifdef ENABLE_TBB
+    tbb::enumerable_thread_specific<chain_counters_t> thread_counters;
+#else
+    chain_counters_t serial_counters;
+#endif
+
+    // velocity changes of the collided particles outside of each cell in the current set
+    std::vector<std::vector<std::pair<unsigned int, vec3<Scalar>>>> deferred_velocity(
+        n_set_cells);
+
+    std::atomic<bool> zero_velocity(false);
+    std::atomic<bool> chain_too_long(false);
+
+    for (unsigned int i_nselect = 0; i_nselect < this->m_nselect; i_nselect++)
+        {
+        hoomd::RandomGenerator rng(
+            hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoChainCheckerboard, timestep, seed),
+            hoomd::Counter(i_nselect));
+
+        // shift the grid by a random fraction of the box
+        hoomd::UniformDistribution<Scalar> uniform(Scalar(0.0), Scalar(1.0));
+        Scalar3 shift = make_scalar3(uniform(rng) / dim.x, uniform(rng) / dim.y, 0);
+        if (ndim == 3)
+            shift.z = uniform(rng) / dim.z;
+
+        auto get_fraction = [&](const vec3<Scalar>& pos)
+        {
+            Scalar3 f = box.makeFraction(vec_to_scalar3(pos)) + shift;
+            f.x -= std::floor(f.x);
+            f.y -= std::floor(f.y);
+            f.z -= std::floor(f.z);
+            return f;
+        };
+
+        auto get_cell = [&](const vec3<Scalar>& pos)
+        {
+            Scalar3 f = get_fraction(pos);
+            unsigned int ib = std::min((unsigned int)(f.x * dim.x), dim.x - 1);
+            unsigned int jb = std::min((unsigned int)(f.y * dim.y), dim.y - 1);
+            unsigned int kb = ndim == 3 ? std::min((unsigned int)(f.z * dim.z), dim.z - 1) : 0;
+            return cell_indexer(ib, jb, kb);
+        };
+
+        // distance from pos along the unit vector direction to the boundary of cell c
+        auto get_boundary_distance
+            = [&](const vec3<Scalar>& pos, const vec3<Scalar>& direction, const uint3& c)
+        {
+            Scalar3 f = get_fraction(pos);
+            Scalar3 df = box.makeFraction(vec_to_scalar3(pos + direction))
+                         - box.makeFraction(vec_to_scalar3(pos));
+            Scalar result = std::numeric_limits<Scalar>::max();
+            auto limit = [&result](Scalar f, Scalar df, unsigned int c, unsigned int n)
+            {
+                if (df > 0)
+                    result = std::min(result, (Scalar(c + 1) / Scalar(n) - f) / df);
+                else if (df < 0)
+                    result = std::min(result, (Scalar(c) / Scalar(n) - f) / df);
+            };
+            limit(f.x, df.x, c.x, dim.x);
+            limit(f.y, df.y, c.y, dim.y);
+            if (ndim == 3)
+                limit(f.z, df.z, c.z, dim.z);
+            return std::max(result, Scalar(0.0));
+        };
+
+        // sort the particles into the cells
+        std::fill(this->m_checkerboard_cell_start.begin(),
+                  this->m_checkerboard_cell_start.end(),
+                  0);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            this->m_checkerboard_cell[i] = get_cell(vec3<Scalar>(h_postype.data[i]));
+            this->m_checkerboard_cell_start[this->m_checkerboard_cell[i] + 1]++;
+            }
+        for (unsigned int cell = 0; cell < n_cells; cell++)
+            this->m_checkerboard_cell_start[cell + 1] += this->m_checkerboard_cell_start[cell];
+        std::vector<unsigned int> cell_fill(this->m_checkerboard_cell_start.begin(),
+                                            this->m_checkerboard_cell_start.end() - 1);
+        for (unsigned int i = 0; i < N; i++)
+            this->m_checkerboard_cell_particles[cell_fill[this->m_checkerboard_cell[i]]++] = i;
+
+        // process the sets of cells in a random order
+        unsigned int set_order[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+        for (unsigned int k = n_sets - 1; k > 0; k--)
+            std::swap(set_order[k], set_order[hoomd::UniformIntDistribution(k)(rng)]);
+
+        for (unsigned int cur_set = 0; cur_set < n_sets; cur_set++)
+            {
+            const unsigned int set = set_order[cur_set];
+
+            auto run_cell = [&](unsigned int set_cell, chain_counters_t& cell_counters)
+            {
+                const uint3 c = make_uint3(
+                    2 * (set_cell % set_dim.x) + (set & 1),
+                    2 * ((set_cell / set_dim.x) % set_dim.y) + ((set >> 1) & 1),
+                    ndim == 3 ? 2 * (set_cell / (set_dim.x * set_dim.y)) + ((set >> 2) & 1) : 0);
+                const unsigned int my_cell = cell_indexer(c.x, c.y, c.z);
+
+                auto& deferred = deferred_velocity[set_cell];
+                deferred.clear();
+
+                const unsigned int cell_start = this->m_checkerboard_cell_start[my_cell];
+                const unsigned int n_cell_particles
+                    = this->m_checkerboard_cell_start[my_cell + 1] - cell_start;
+                if (n_cell_particles == 0)
+                    return;
+
+                // find the unique neighboring cells (including this one)
+                unsigned int neighbor_cells[27];
+                unsigned int n_neighbor_cells = 0;
+                const int kmax = ndim == 3 ? 1 : 0;
+                for (int k = -kmax; k <= kmax; k++)
+                    for (int j = -1; j <= 1; j++)
+                        for (int l = -1; l <= 1; l++)
+                            {
+                            unsigned int neigh = cell_indexer((c.x + dim.x + l) % dim.x,
+                                                              (c.y + dim.y + j) % dim.y,
+                                                              (c.z + dim.z + k) % dim.z);
+                            if (std::find(neighbor_cells, neighbor_cells + n_neighbor_cells, neigh)
+                                == neighbor_cells + n_neighbor_cells)
+                                neighbor_cells[n_neighbor_cells++] = neigh;
+                            }
+
+                hoomd::RandomGenerator rng_cell(
+                    hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoChainCheckerboard, timestep, seed),
+                    hoomd::Counter(my_cell, i_nselect, 1));
+
+                const unsigned int n_chains = static_cast<unsigned int>(
+                    n_cell_particles * m_update_fraction
+                    + hoomd::detail::generate_canonical<Scalar>(rng_cell));
+
+                for (unsigned int cur_chain = 0; cur_chain < n_chains; cur_chain++)
+                    {
+                    unsigned int cur_p
+                        = hoomd::UniformIntDistribution(n_cell_particles - 1)(rng_cell);
+                    unsigned int i = this->m_checkerboard_cell_particles[cell_start + cur_p];
+
+                    Scalar4 postype_i = h_postype.data[i];
+                    int typ_i = __scalar_as_int(postype_i.w);
+                    Shape shape_i(quat<Scalar>(h_orientation.data[i]), this->m_params[typ_i]);
+
+                    unsigned int move_type_select = hoomd::UniformIntDistribution(0xffff)(rng_cell);
+                    bool move_type_translate
+                        = !shape_i.hasOrientation() || (move_type_select < m_chain_probability);
+
+                    if (!move_type_translate)
+                        {
+                        vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+
+                        if (ndim == 2)
+                            move_rotate<2>(shape_i.orientation, rng_cell, h_a.data[typ_i]);
+                        else
+                            move_rotate<3>(shape_i.orientation, rng_cell, h_a.data[typ_i]);
+
+                        // check for overlaps with the particles in the neighboring cells
+                        bool overlap = false;
+                        for (unsigned int cur_cell = 0; cur_cell < n_neighbor_cells && !overlap;
+                             cur_cell++)
+                            {
+                            const unsigned int neigh_cell = neighbor_cells[cur_cell];
+                            for (unsigned int cur_j = this->m_checkerboard_cell_start[neigh_cell];
+                                 cur_j < this->m_checkerboard_cell_start[neigh_cell + 1];
+                                 cur_j++)
+                                {
+                                unsigned int j = this->m_checkerboard_cell_particles[cur_j];
+                                if (j == i)
+                                    continue;
+
+                                Scalar4 postype_j = h_postype.data[j];
+                                vec3<Scalar> r_ij = box.minImage(vec3<Scalar>(postype_j) - pos_i);
+                                unsigned int typ_j = __scalar_as_int(postype_j.w);
+                                Shape shape_j(quat<Scalar>(h_orientation.data[j]),
+                                              this->m_params[typ_j]);
+
+                                cell_counters.counters.overlap_checks++;
+                                if (h_overlaps.data[this->m_overlap_idx(typ_i, typ_j)]
+                                    && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                                    && test_overlap(r_ij,
+                                                    shape_i,
+                                                    shape_j,
+                                                    cell_counters.counters.overlap_err_count))
+                                    {
+                                    overlap = true;
+                                    break;
+                                    }
+                                }
+                            }
+
+                        if (!overlap)
+                            {
+                            if (!shape_i.ignoreStatistics())
+                                cell_counters.counters.rotate_accept_count++;
+                            h_orientation.data[i] = quat_to_scalar4(shape_i.orientation);
+                            }
+                        else
+                            {
+                            if (!shape_i.ignoreStatistics())
+                                cell_counters.counters.rotate_reject_count++;
+                            }
+                        continue;
+                        }
+
+                    // start a chain in the direction of the particle's velocity
+                    cell_counters.nec_counters.chain_start_count++;
+
+                    vec3<Scalar> direction = vec3<Scalar>(h_velocities.data[i]);
+                    Scalar velocity = fast::sqrt(dot(direction, direction));
+                    if (velocity == 0.0)
+                        {
+                        zero_velocity = true;
+                        continue;
+                        }
+                    direction /= velocity;
+
+                    Scalar chain_time = m_chain_time;
+                    unsigned int count_chain = 0;
+
+                    // next denotes the next particle, where -1 means there is no further particle.
+                    int next = i;
+                    while (next > -1)
+                        {
+                        count_chain++;
+                        if (count_chain == max_chain_length)
+                            {
+                            chain_too_long = true;
+                            break;
+                            }
+
+                        // k is the current particle, which is to be moved
+                        unsigned int k = next;
+                        Scalar4 postype_k = h_postype.data[k];
+                        int typ_k = __scalar_as_int(postype_k.w);
+                        vec3<Scalar> pos_k = vec3<Scalar>(postype_k);
+                        Shape shape_k(quat<Scalar>(h_orientation.data[k]), this->m_params[typ_k]);
+
+                        // find the first collision within the search radius d, when there is
+                        // none, the particle moves by d and the chain continues with it
+                        Scalar sweep = h_d.data[typ_k];
+                        vec3<Scalar> collisionPlaneVector;
+                        vec3<Scalar> newCollisionPlaneVector;
+                        for (unsigned int cur_cell = 0; cur_cell < n_neighbor_cells; cur_cell++)
+                            {
+                            const unsigned int neigh_cell = neighbor_cells[cur_cell];
+                            for (unsigned int cur_j = this->m_checkerboard_cell_start[neigh_cell];
+                                 cur_j < this->m_checkerboard_cell_start[neigh_cell + 1];
+                                 cur_j++)
+                                {
+                                unsigned int j = this->m_checkerboard_cell_particles[cur_j];
+                                if (j == k)
+                                    continue;
+
+                                Scalar4 postype_j = h_postype.data[j];
+                                unsigned int typ_j = __scalar_as_int(postype_j.w);
+                                if (!h_overlaps.data[this->m_overlap_idx(typ_k, typ_j)])
+                                    continue;
+
+                                vec3<Scalar> r_kj = box.minImage(vec3<Scalar>(postype_j) - pos_k);
+                                Shape shape_j(quat<Scalar>(h_orientation.data[j]),
+                                              this->m_params[typ_j]);
+
+                                cell_counters.nec_counters.distance_queries++;
+
+                                Scalar maxR = Scalar(0.5)
+                                                  * (shape_k.getCircumsphereDiameter()
+                                                     + shape_j.getCircumsphereDiameter())
+                                              + sweep;
+                                if (dot(r_kj, r_kj) >= maxR * maxR)
+                                    continue;
+
+                                Scalar newDist
+                                    = sweep_distance(r_kj,
+                                                     shape_k,
+                                                     shape_j,
+                                                     direction,
+                                                     cell_counters.nec_counters.overlap_err_count,
+                                                     newCollisionPlaneVector);
+
+                                if (newDist >= 0.0 && newDist < sweep)
+                                    {
+                                    collisionPlaneVector = newCollisionPlaneVector;
+                                    sweep = newDist;
+                                    next = j;
+                                    }
+                                else if (newDist < -3.5 && dot(r_kj, direction) > 0)
+                                    {
+                                    // resultOverlapping = -3.0
+                                    collisionPlaneVector = newCollisionPlaneVector;
+                                    sweep = 0.0;
+                                    next = j;
+                                    }
+                                }
+                            }
+
+                        // if we go further than what is left: stop
+                        if (sweep > chain_time * velocity)
+                            {
+                            sweep = chain_time * velocity;
+                            next = -1;
+                            }
+
+                        // stop just inside the cell when the particle would leave it
+                        Scalar boundary_distance = get_boundary_distance(pos_k, direction, c);
+                        if (sweep >= boundary_distance)
+                            {
+                            sweep = boundary_distance * Scalar(0.999999);
+                            next = -1;
+                            if (get_cell(pos_k + sweep * direction) != my_cell)
+                                sweep = 0.0;
+                            }
+
+                        // statistics for pressure  -1-
+                        cell_counters.movelength += sweep;
+
+                        pos_k += sweep * direction;
+                        chain_time -= sweep / velocity;
+
+                        if (!shape_k.ignoreStatistics())
+                            {
+                            if (next != int(k) && next > -1)
+                                {
+                                cell_counters.counters.translate_reject_count++;
+                                cell_counters.nec_counters.chain_at_collision_count++;
+                                }
+                            else
+                                {
+                                if (next != -1)
+                                    cell_counters.counters.translate_accept_count++;
+                                cell_counters.nec_counters.chain_no_collision_count++;
+                                }
+                            }
+
+                        // update position of particle
+                        h_postype.data[k] = make_scalar4(pos_k.x, pos_k.y, pos_k.z, postype_k.w);
+                        box.wrap(h_postype.data[k], h_image.data[k]);
+
+                        // Update the velocities of 'k' and 'next' unless there was no collision
+                        if (next != int(k) && next > -1)
+                            {
+                            vec3<Scalar> pos_n = vec3<Scalar>(h_postype.data[next]);
+                            vec3<Scalar> vel_n = vec3<Scalar>(h_velocities.data[next]);
+                            vec3<Scalar> vel_k = vec3<Scalar>(h_velocities.data[k]);
+
+                            vec3<Scalar> delta_pos = box.minImage(pos_n - pos_k);
+
+                            // statistics for pressure  -2-
+                            cell_counters.pressurevirial += dot(delta_pos, direction);
+
+                            // Update Velocities (fully elastic)
+                            vec3<Scalar> delta_vel = vel_n - vel_k;
+                            vec3<Scalar> vel_change
+                                = collisionPlaneVector
+                                  * (dot(delta_vel, collisionPlaneVector)
+                                     / dot(collisionPlaneVector, collisionPlaneVector));
+
+                            vel_k += vel_change;
+                            h_velocities.data[k]
+                                = make_scalar4(vel_k.x, vel_k.y, vel_k.z, h_velocities.data[k].w);
+
+                            if (this->m_checkerboard_cell[next] == my_cell)
+                                {
+                                vel_n -= vel_change;
+                                h_velocities.data[next] = make_scalar4(vel_n.x,
+                                                                       vel_n.y,
+                                                                       vel_n.z,
+                                                                       h_velocities.data[next].w);
+
+                                velocity = fast::sqrt(dot(vel_n, vel_n));
+                                if (velocity == 0.0)
+                                    next = -1;
+                                else
+                                    direction = vel_n / velocity;
+                                }
+                            else
+                                {
+                                // other threads may read the velocity of a particle outside of
+                                // this cell until the set finishes
+                                deferred.push_back(std::make_pair(next, vel_change));
+                                next = -1;
+                                }
+                            }
+                        } // end loop over the chain
+                    }     // end loop over the chains in the cell
+            };
+
+#ifdef ENABLE_TBB
+            this->m_exec_conf->getTaskArena()->execute(
+                [&]
+                {
+                    tbb::parallel_for(
+                        tbb::blocked_range<unsigned int>(0, n_set_cells),
+                        [&](const tbb::blocked_range<unsigned int>& r)
+                        {
+                            chain_counters_t& local_counters = thread_counters.local();
+                            for (unsigned int set_cell = r.begin(); set_cell != r.end(); ++set_cell)
+                                run_cell(set_cell, local_counters);
+                        });
+                });
+#else
+            for (unsigned int set_cell = 0; set_cell < n_set_cells; set_cell++)
+                run_cell(set_cell, serial_counters);
+#endif
+
+            // apply the velocity changes of the collided particles outside of the cells
+            for (unsigned int set_cell = 0; set_cell < n_set_cells; set_cell++)
+                {
+                for (const auto& change : deferred_velocity[set_cell])
+                    {
+                    Scalar4& velocity_j = h_velocities.data[change.first];
+                    velocity_j.x -= change.second.x;
+                    velocity_j.y -= change.second.y;
+                    velocity_j.z -= change.second.z;
+                    }
+                }
+            } // end loop over the sets of cells
+        }     // end loop over nselect
+
+#ifdef ENABLE_TBB
+    for (auto& local_counters : thread_counters)
+        {
+        counters = counters + local_counters.counters;
+        nec_counters = nec_counters + local_counters.nec_counters;
+        count_pressurevirial += local_counters.pressurevirial;
+        count_movelength += local_counters.movelength;
+        }
+#else
+    counters = counters + serial_counters.counters;
+    nec_counters = nec_counters + serial_counters.nec_counters;
+    count_pressurevirial += serial_counters.pressurevirial;
+    count_movelength += serial_counters.movelength;
+#endif
+
+    if (zero_velocity)
+        this->m_exec_conf->msg->error() << "NEC requires non-zero velocities." << std::endl;
+
+    if (chain_too_long)
+        {
+        this->m_exec_conf->msg->error()
+            << "The number of chain elements exceeded safe-guard limit of " << max_chain_length
+            << ".\n";
+        this->m_exec_conf->msg->error()
+            << "Shorten chain_time if this message appears regularly." << std::endl;
+        }
+    }
+
 //! Export this hpmc integrator to python
 /*! \param name Name of the class in the exported python module
     \tparam Shape An instantiation of IntegratorHPMCMono<Shape> will be exported
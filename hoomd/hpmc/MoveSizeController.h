@@ -0,0 +1,65 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file MoveSizeController.h
+    \brief Declares the stochastic approximation controller that adapts trial move sizes
+*/
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+namespace detail
+    {
+//! Adapt a trial move size to reach a target acceptance ratio
+/*! update() returns the factor that scales the move size after one step. The controller applies
+    the Robbins-Monro rule to the logarithm of the move size:
+
+    \f[ \ln d_{k+1} = \ln d_k + \frac{g}{(k+1)^{0.6}} (r_k - r_\mathrm{target}) \f]
+
+    where r_k is the acceptance ratio of the moves in step k and g is the gain. The decaying step
+    size lets the move size follow the noisy acceptance ratio quickly at first and then settle.
+    reset() restarts the decay, e.g. when the target changes.
+*/
+class MoveSizeController
+    {
+    public:
+    //! Restart the adaptation
+    void reset()
+        {
+        m_n_updates = 0;
+        }
+
+    //! Get the factor that scales the move size
+    /*! \param accept Number of accepted moves in the last step
+        \param reject Number of rejected moves in the last step
+        \param target Target acceptance ratio
+        \param gain Gain of the controller
+        \returns The factor that scales the move size, 1 when there were no moves
+    */
+    Scalar update(unsigned long long accept,
+                  unsigned long long reject,
+                  Scalar target,
+                  Scalar gain)
+        {
+        unsigned long long total = accept + reject;
+        if (total == 0)
+            return Scalar(1.0);
+
+        Scalar ratio = Scalar(accept) / Scalar(total);
+        Scalar step = gain / pow(Scalar(m_n_updates + 1), Scalar(0.6));
+        m_n_updates++;
+        return exp(step * (ratio - target));
+        }
+
+    private:
+    unsigned long long m_n_updates = 0; //!< Number of updates since the last reset
+    };
+
+    } // end namespace detail
+    } // end namespace hpmc
+    } // end namespace hoomd
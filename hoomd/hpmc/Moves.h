@@ -321,6 +321,47 @@ DEVICE inline vec3<Scalar> lineReflection(vec3<Scalar> pos, vec3<Scalar> p, quat
     return r - (pos - r);
     }
 
+//! Radical inverse of an integer
+/*! \param i Integer to invert
+    \param base Base of the digit expansion
+    \returns The digits of \a i in base \a base mirrored about the radix point
+*/
+DEVICE inline Scalar radicalInverse(uint64_t i, unsigned int base)
+    {
+    Scalar inv_base = Scalar(1.0) / Scalar(base);
+    Scalar f = inv_base;
+    Scalar r = Scalar(0.0);
+    while (i > 0)
+        {
+        r += f * Scalar(i % base);
+        i /= base;
+        f *= inv_base;
+        }
+    return r;
+    }
+
+//! Point of a randomly shifted Halton sequence in the unit cube
+/*! \param i Index of the point in the sequence
+    \param shift Random shift applied to all points modulo 1
+    \param dim Dimension
+
+    The coordinates are the radical inverses of i+1 in bases 2, 3, and 5. The points fill the unit
+    cube more evenly than independent random points, so estimates of averages over the cube
+    converge faster with the number of points. The random shift (a Cranley-Patterson rotation)
+    keeps the estimates unbiased. When \a dim == 2, the z coordinate is 0.
+*/
+DEVICE inline Scalar3 generateHaltonPoint(uint64_t i, const Scalar3& shift, unsigned int dim)
+    {
+    Scalar3 f;
+    f.x = radicalInverse(i + 1, 2) + shift.x;
+    f.y = radicalInverse(i + 1, 3) + shift.y;
+    f.z = dim == 3 ? radicalInverse(i + 1, 5) + shift.z : Scalar(0.0);
+    f.x -= floor(f.x);
+    f.y -= floor(f.y);
+    f.z -= floor(f.z);
+    return f;
+    }
+
     }; // end namespace hpmc
     }  // namespace hoomd
 
@@ -0,0 +1,100 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VectorMath.h"
+
+/*! \file OverlapCandidates.h
+    \brief Declares a batch of candidate pairs for the CPU narrow phase
+*/
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+namespace detail
+    {
+//! Fixed size batch of candidate particles for the overlap checks of one particle
+/*! The broad phase appends every particle j that it finds in the AABB tree together with the
+    separation vector r_ij. filter() then applies the circumsphere test to the whole batch at once
+    and compacts the indices of the candidates that pass. The candidates are stored as a structure
+    of arrays and the test has no branches, so the compiler vectorizes it. Only the remaining
+    candidates proceed to the exact overlap test, in the order they were added.
+*/
+struct OverlapCandidates
+    {
+    //! Maximum number of candidates in a batch
+    static constexpr unsigned int capacity = 32;
+
+    //! Add a candidate to the batch
+    /*! \param r_ij Position of particle j relative to particle i
+        \param j Index of particle j
+        \param type_j Type of particle j
+        \param max_rsq Square of the largest distance at which the shapes may overlap, negative
+               when the pair of types never overlaps
+
+        The caller must check full() before adding a candidate.
+    */
+    inline void
+    push(const vec3<Scalar>& r_ij, unsigned int j, unsigned int type_j, LongReal max_rsq)
+        {
+        x[n] = r_ij.x;
+        y[n] = r_ij.y;
+        z[n] = r_ij.z;
+        max_r_squared[n] = max_rsq;
+        index[n] = j;
+        type[n] = type_j;
+        n++;
+        }
+
+    //! Test if the batch is full
+    inline bool full() const
+        {
+        return n == capacity;
+        }
+
+    //! Remove all candidates
+    inline void clear()
+        {
+        n = 0;
+        n_pass = 0;
+        }
+
+    //! Reject the candidates whose circumspheres do not overlap
+    /*! \returns The number of candidates that pass, their positions in the batch are stored in
+                 pass[0] to pass[n_pass - 1] in increasing order
+    */
+    inline unsigned int filter()
+        {
+        unsigned char keep[capacity];
+        for (unsigned int k = 0; k < n; k++)
+            {
+            LongReal r_squared = Scalar(x[k] * x[k] + y[k] * y[k] + z[k] * z[k]);
+            keep[k] = r_squared < max_r_squared[k];
+            }
+
+        n_pass = 0;
+        for (unsigned int k = 0; k < n; k++)
+            {
+            pass[n_pass] = k;
+            n_pass += keep[k];
+            }
+        return n_pass;
+        }
+
+    Scalar x[capacity];               //!< x component of r_ij
+    Scalar y[capacity];               //!< y component of r_ij
+    Scalar z[capacity];               //!< z component of r_ij
+    LongReal max_r_squared[capacity]; //!< Square of the sum of the circumsphere radii
+    unsigned int index[capacity];     //!< Index of particle j
+    unsigned int type[capacity];      //!< Type of particle j
+    unsigned int pass[capacity];      //!< Positions of the candidates that pass filter()
+    unsigned int n = 0;               //!< Number of candidates in the batch
+    unsigned int n_pass = 0;          //!< Number of candidates that passed filter()
+    };
+
+    } // end namespace detail
+    } // end namespace hpmc
+    } // end namespace hoomd
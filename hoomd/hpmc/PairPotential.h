@@ -6,6 +6,8 @@
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/SystemDefinition.h"
 
+#include <limits>
+
 namespace hoomd
     {
 namespace hpmc
@@ -46,6 +48,11 @@ namespace hpmc
     Subclasses must call notifyRCutChanged whenever they would change the value of their computed
     r_cut values. The cached values ensure that we can use non-virtual inlined calls in the
     inner loops where the total r_cut values are checked.
+
+    Subclasses may override computeEnergyLowerBound to return the smallest energy that the pair
+    interaction can take. IntegratorHPMC uses the bound to reject trial moves before it evaluates
+    all pair energies. The bound is cached along with r_cut, so notifyRCutChanged must also be
+    called whenever the bound changes. The base implementation returns -infinity (no bound).
 */
 class PairPotential
     {
@@ -54,7 +61,8 @@ class PairPotential
         : m_sysdef(sysdef), m_type_param_index(sysdef->getParticleData()->getNTypes()),
           m_r_cut_non_additive(m_type_param_index.getNumElements(), 0),
           m_r_cut_additive(sysdef->getParticleData()->getNTypes(), 0),
-          m_r_cut_squared_total(m_type_param_index.getNumElements(), 0)
+          m_r_cut_squared_total(m_type_param_index.getNumElements(), 0),
+          m_energy_lower_bound(m_type_param_index.getNumElements(), 0)
         {
         }
     virtual ~PairPotential() { }
@@ -83,6 +91,12 @@ class PairPotential
         return m_max_r_cut_non_additive;
         }
 
+    /// Returns the lower bound of the pair energy.
+    inline LongReal getEnergyLowerBound(unsigned int type_i, unsigned int type_j) const
+        {
+        return m_energy_lower_bound[m_type_param_index(type_i, type_j)];
+        }
+
     /// Set the parent potential
     void setParent(std::shared_ptr<PairPotential> parent)
         {
@@ -137,6 +151,12 @@ class PairPotential
         return 0;
         }
 
+    /// Compute the smallest energy that the pair interaction can take.
+    virtual LongReal computeEnergyLowerBound(unsigned int type_i, unsigned int type_j) const
+        {
+        return -std::numeric_limits<LongReal>::infinity();
+        }
+
     protected:
     /// The system definition.
     std::shared_ptr<SystemDefinition> m_sysdef;
@@ -165,6 +185,9 @@ class PairPotential
     /// Pre-computed total r_cut squared (indexed by m_type_param_index).
     std::vector<LongReal> m_r_cut_squared_total;
 
+    /// Pre-computed lower bound of the energy (indexed by m_type_param_index).
+    std::vector<LongReal> m_energy_lower_bound;
+
     /// Pre-computed maximum additive r_cut.
     LongReal m_max_r_cut_non_additive = 0;
 
@@ -200,6 +223,10 @@ class PairPotential
                       + LongReal(0.5) * (m_r_cut_additive[type_i] + m_r_cut_additive[type_j]);
                 m_r_cut_squared_total[param_index_1] = r_cut * r_cut;
                 m_r_cut_squared_total[param_index_2] = r_cut * r_cut;
+
+                LongReal energy_lower_bound = computeEnergyLowerBound(type_i, type_j);
+                m_energy_lower_bound[param_index_1] = energy_lower_bound;
+                m_energy_lower_bound[param_index_2] = energy_lower_bound;
                 }
             }
         }
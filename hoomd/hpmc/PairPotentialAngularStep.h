@@ -59,6 +59,14 @@ class PairPotentialAngularStep : public hpmc::PairPotential
         return m_isotropic_potential->computeRCutAdditive(type);
         }
 
+    /// Compute the smallest energy that the pair interaction can take.
+    virtual LongReal computeEnergyLowerBound(unsigned int type_i, unsigned int type_j) const
+        {
+        // the mask sets the energy to zero or leaves it unchanged
+        return std::min(LongReal(0),
+                        m_isotropic_potential->computeEnergyLowerBound(type_i, type_j));
+        }
+
     protected:
     bool maskingFunction(LongReal r_squared,
                          const vec3<LongReal>& r_ij,
@@ -36,6 +36,18 @@ class PairPotentialLennardJones : public hpmc::PairPotential
         return slow::sqrt(m_params[param_index].r_cut_squared);
         }
 
+    /// Compute the smallest energy that the pair interaction can take.
+    virtual LongReal computeEnergyLowerBound(unsigned int type_i, unsigned int type_j) const
+        {
+        // -epsilon is the minimum in all modes, a negative epsilon diverges at r=0
+        LongReal epsilon_x_4 = m_params[m_type_param_index(type_i, type_j)].epsilon_x_4;
+        if (epsilon_x_4 < 0)
+            {
+            return -std::numeric_limits<LongReal>::infinity();
+            }
+        return -epsilon_x_4 / LongReal(4.0);
+        }
+
     /// Set type pair dependent parameters to the potential.
     void setParamsPython(pybind11::tuple typ, pybind11::dict params);
 
@@ -27,6 +27,17 @@ LongReal PairPotentialStep::computeRCutNonAdditive(unsigned int type_i, unsigned
         }
     }
 
+LongReal PairPotentialStep::computeEnergyLowerBound(unsigned int type_i, unsigned int type_j) const
+    {
+    // the energy is zero beyond the last step
+    LongReal energy_lower_bound = 0;
+    for (auto epsilon : m_params[m_type_param_index(type_i, type_j)].m_epsilon)
+        {
+        energy_lower_bound = std::min(energy_lower_bound, epsilon);
+        }
+    return energy_lower_bound;
+    }
+
 LongReal PairPotentialStep::energy(const LongReal r_squared,
                                    const vec3<LongReal>& r_ij,
                                    const unsigned int type_i,
@@ -32,6 +32,9 @@ class PairPotentialStep : public hpmc::PairPotential
     /// Compute the non-additive cuttoff radius
     virtual LongReal computeRCutNonAdditive(unsigned int type_i, unsigned int type_j) const;
 
+    /// Compute the smallest energy that the pair interaction can take.
+    virtual LongReal computeEnergyLowerBound(unsigned int type_i, unsigned int type_j) const;
+
     /// Set type pair dependent parameters to the potential.
     void setParamsPython(pybind11::tuple typ, pybind11::object params);
 
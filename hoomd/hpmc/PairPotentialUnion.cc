@@ -193,6 +193,26 @@ LongReal PairPotentialUnion::computeRCutAdditive(unsigned int type) const
     return m_extent_type[type];
     }
 
+LongReal PairPotentialUnion::computeEnergyLowerBound(unsigned int type_i,
+                                                     unsigned int type_j) const
+    {
+    // Every pair of constituents may reach its lower bound at the same time
+    LongReal energy_lower_bound = 0;
+
+    for (auto& constituent_type_i : m_type[type_i])
+        {
+        for (auto& constituent_type_j : m_type[type_j])
+            {
+            energy_lower_bound
+                += std::min(LongReal(0),
+                            m_constituent_potential->computeEnergyLowerBound(constituent_type_i,
+                                                                            constituent_type_j));
+            }
+        }
+
+    return energy_lower_bound;
+    }
+
 void PairPotentialUnion::updateExtent(unsigned int type_id)
     {
     // The extent is 2x the maximum distance of constituent particles to the origin
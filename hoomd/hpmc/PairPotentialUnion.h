@@ -72,6 +72,9 @@ class PairPotentialUnion : public hpmc::PairPotential
     /// Returns the additive part of the cutoff distance for a given type.
     virtual LongReal computeRCutAdditive(unsigned int type) const;
 
+    /// Compute the smallest energy that the pair interaction can take.
+    virtual LongReal computeEnergyLowerBound(unsigned int type_i, unsigned int type_j) const;
+
     protected:
     /// The pair potential to apply between constituents.
     std::shared_ptr<PairPotential> m_constituent_potential;
@@ -0,0 +1,86 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VectorMath.h"
+
+/*! \file PatchEnergyBatch.h
+    \brief Declares a batch of particle pairs for the patch energy evaluation
+*/
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+namespace detail
+    {
+//! Fixed size batch of particles j that interact with one particle i
+/*! The trial moves collect the particles j within the patch cutoff of particle i and evaluate the
+    energies of the whole batch with one call to PatchEnergy::energyBatch(). The properties of the
+    particles j are stored as a structure of arrays so that a generated loop over the batch can be
+    vectorized. This header is also included by the code that PatchEnergyJIT compiles at run time.
+*/
+struct PatchEnergyBatch
+    {
+    //! Maximum number of pairs in a batch
+    static constexpr unsigned int capacity = 64;
+
+    //! Add a particle j to the batch
+    /*! \param r_ij Position of particle j relative to particle i
+        \param type_j Type of particle j
+        \param q_j Orientation of particle j
+        \param d_j Diameter of particle j
+        \param charge_j Charge of particle j
+
+        The caller must check full() before adding a particle.
+    */
+    inline void push(const vec3<float>& r_ij,
+                     unsigned int type_j,
+                     const quat<float>& q_j,
+                     float d_j,
+                     float charge_j)
+        {
+        r_x[n] = r_ij.x;
+        r_y[n] = r_ij.y;
+        r_z[n] = r_ij.z;
+        q_s[n] = q_j.s;
+        q_x[n] = q_j.v.x;
+        q_y[n] = q_j.v.y;
+        q_z[n] = q_j.v.z;
+        type[n] = type_j;
+        diameter[n] = d_j;
+        charge[n] = charge_j;
+        n++;
+        }
+
+    //! Test if the batch is full
+    inline bool full() const
+        {
+        return n == capacity;
+        }
+
+    //! Remove all pairs
+    inline void clear()
+        {
+        n = 0;
+        }
+
+    float r_x[capacity];         //!< x component of r_ij
+    float r_y[capacity];         //!< y component of r_ij
+    float r_z[capacity];         //!< z component of r_ij
+    float q_s[capacity];         //!< Real part of the orientation of particle j
+    float q_x[capacity];         //!< x component of the imaginary part of the orientation
+    float q_y[capacity];         //!< y component of the imaginary part of the orientation
+    float q_z[capacity];         //!< z component of the imaginary part of the orientation
+    unsigned int type[capacity]; //!< Type of particle j
+    float diameter[capacity];    //!< Diameter of particle j
+    float charge[capacity];      //!< Charge of particle j
+    float energy[capacity];      //!< Energy of each pair, written by the evaluation
+    unsigned int n = 0;          //!< Number of pairs in the batch
+    };
+
+    } // end namespace detail
+    } // end namespace hpmc
+    } // end namespace hoomd
@@ -38,6 +38,9 @@ PatchEnergyJIT::PatchEnergyJIT(std::shared_ptr<SystemDefinition> sysdef,
     // get the evaluator
     m_eval = factory->getEval();
 
+    // the batched evaluator calls eval, which unions replace with the sum over constituents
+    m_eval_batch = m_is_union ? nullptr : factory->getEvalBatch();
+
     if (!m_eval)
         {
         std::ostringstream s;
@@ -99,6 +99,26 @@ class PYBIND11_EXPORT PatchEnergyJIT : public hpmc::PatchEnergy
         return m_eval(r_ij, type_i, q_i, d_i, charge_i, type_j, q_j, d_j, charge_j);
         }
 
+    //! Evaluate the energies of a batch of patch interactions with particle i
+    /*! Calls the batched evaluator in the JIT module when it provides one, so that the loop over
+        the pairs is compiled together with (and vectorized over) the user code.
+    */
+    virtual void energyBatch(detail::PatchEnergyBatch& batch,
+                             unsigned int type_i,
+                             const quat<float>& q_i,
+                             float d_i,
+                             float charge_i)
+        {
+        if (m_eval_batch)
+            {
+            m_eval_batch(batch, type_i, q_i, d_i, charge_i);
+            }
+        else
+            {
+            PatchEnergy::energyBatch(batch, type_i, q_i, d_i, charge_i);
+            }
+        }
+
     static pybind11::object getParamArray(pybind11::object self)
         {
         auto self_cpp = self.cast<PatchEnergyJIT*>();
@@ -119,9 +139,10 @@ class PYBIND11_EXPORT PatchEnergyJIT : public hpmc::PatchEnergy
                                const quat<float>& q_j,
                                float,
                                float);
-    Scalar m_r_cut_isotropic;               //!< Cutoff radius
-    std::shared_ptr<EvalFactory> m_factory; //!< The factory for the evaluator function
-    EvalFactory::EvalFnPtr m_eval;          //!< Pointer to evaluator function inside the JIT module
+    Scalar m_r_cut_isotropic;                 //!< Cutoff radius
+    std::shared_ptr<EvalFactory> m_factory;   //!< The factory for the evaluator function
+    EvalFactory::EvalFnPtr m_eval;            //!< Pointer to evaluator function in the JIT module
+    EvalFactory::EvalBatchFnPtr m_eval_batch; //!< Pointer to the batched evaluator, may be nullptr
     std::vector<float, hoomd::detail::managed_allocator<float>>
         m_param_array; //!< Array containing adjustable parameters
     const bool m_is_union;
@@ -12,7 +12,9 @@
 #include "hoomd/VectorMath.h"
 #include "hoomd/hpmc/OBB.h"
 
+#include <algorithm>
 #include <cfloat>
+#include <vector>
 
 #ifdef __HIPCC__
 #define DEVICE __device__
@@ -45,14 +47,15 @@ struct PolyhedronVertices : ShapeParams
     {
     /// Default constructor initializes zero values.
     DEVICE PolyhedronVertices()
-        : n_hull_verts(0), N(0), diameter(ShortReal(0)), sweep_radius(ShortReal(0)), ignore(0)
+        : n_hull_verts(0), support_start(0), N(0), diameter(ShortReal(0)),
+          sweep_radius(ShortReal(0)), ignore(0)
         {
         }
 
 #ifndef __HIPCC__
     /** Initialize with a given number of vertices
      */
-    PolyhedronVertices(unsigned int _N, bool managed = false) : ignore(0)
+    PolyhedronVertices(unsigned int _N, bool managed = false) : support_start(0), ignore(0)
         {
         std::vector<vec3<ShortReal>> v(_N, vec3<ShortReal>(0, 0, 0));
         setVerts(v, 0, managed);
@@ -63,8 +66,8 @@ struct PolyhedronVertices : ShapeParams
                        unsigned int ignore_,
                        bool managed = false)
         : x((unsigned int)verts.size(), managed), y((unsigned int)verts.size(), managed),
-          z((unsigned int)verts.size(), managed), n_hull_verts(0), N((unsigned int)verts.size()),
-          diameter(0.0), sweep_radius(sweep_radius_), ignore(ignore_)
+          z((unsigned int)verts.size(), managed), n_hull_verts(0), support_start(0),
+          N((unsigned int)verts.size()), diameter(0.0), sweep_radius(sweep_radius_), ignore(ignore_)
         {
         setVerts(verts, sweep_radius_, managed);
         }
@@ -132,6 +135,13 @@ struct PolyhedronVertices : ShapeParams
             for (unsigned int i = 0; i < indexBuffer.size(); i++)
                 hull_verts[i] = (unsigned int)indexBuffer[i];
             }
+        else
+            {
+            hull_verts = ManagedArray<unsigned int>();
+            n_hull_verts = 0;
+            }
+
+        buildSupportGraph(managed);
 
         if (N >= 1)
             {
@@ -144,6 +154,59 @@ struct PolyhedronVertices : ShapeParams
             }
         }
 
+    /** Build the adjacency graph of the convex hull vertices
+
+        Polyhedra with at least hill_climbing_min_verts vertices find the support vertex by
+        walking the edges of the hull instead of scanning all vertices. Vertices inside the hull
+        have no neighbors. setVerts() builds the graph from the new hull.
+
+        @param managed Set to true to store the graph in managed memory
+    */
+    void buildSupportGraph(bool managed = false)
+        {
+        adjacency_offset = ManagedArray<unsigned int>();
+        adjacency = ManagedArray<unsigned int>();
+        support_start = 0;
+        if (N < hill_climbing_min_verts || n_hull_verts == 0)
+            return;
+
+        // the edges of the hull triangles connect each vertex to its neighbors
+        std::vector<std::vector<unsigned int>> neighbors(N);
+        for (unsigned int t = 0; t + 2 < n_hull_verts; t += 3)
+            {
+            for (unsigned int k = 0; k < 3; k++)
+                {
+                unsigned int a = hull_verts[t + k];
+                unsigned int b = hull_verts[t + (k + 1) % 3];
+                neighbors[a].push_back(b);
+                neighbors[b].push_back(a);
+                }
+            }
+
+        unsigned int n_edges = 0;
+        for (auto& neighbors_i : neighbors)
+            {
+            std::sort(neighbors_i.begin(), neighbors_i.end());
+            neighbors_i.erase(std::unique(neighbors_i.begin(), neighbors_i.end()),
+                              neighbors_i.end());
+            n_edges += (unsigned int)neighbors_i.size();
+            }
+
+        adjacency_offset = ManagedArray<unsigned int>(N + 1, managed);
+        adjacency = ManagedArray<unsigned int>(n_edges, managed);
+        unsigned int cur_edge = 0;
+        for (unsigned int i = 0; i < N; i++)
+            {
+            adjacency_offset[i] = cur_edge;
+            for (unsigned int j : neighbors[i])
+                adjacency[cur_edge++] = j;
+            }
+        adjacency_offset[N] = cur_edge;
+
+        // start the walks on the hull
+        support_start = hull_verts[0];
+        }
+
     /// Construct from a Python dictionary
     PolyhedronVertices(pybind11::dict v, bool managed = false)
         : PolyhedronVertices((unsigned int)pybind11::len(v["vertices"]), managed)
@@ -195,6 +258,8 @@ struct PolyhedronVertices : ShapeParams
         y.load_shared(ptr, available_bytes);
         z.load_shared(ptr, available_bytes);
         hull_verts.load_shared(ptr, available_bytes);
+        adjacency_offset.load_shared(ptr, available_bytes);
+        adjacency.load_shared(ptr, available_bytes);
         }
 
     /** Determine size of the shared memory allocation
@@ -208,6 +273,8 @@ struct PolyhedronVertices : ShapeParams
         y.allocate_shared(ptr, available_bytes);
         z.allocate_shared(ptr, available_bytes);
         hull_verts.allocate_shared(ptr, available_bytes);
+        adjacency_offset.allocate_shared(ptr, available_bytes);
+        adjacency.allocate_shared(ptr, available_bytes);
         }
 
 #ifdef ENABLE_HIP
@@ -217,6 +284,8 @@ struct PolyhedronVertices : ShapeParams
         y.set_memory_hint();
         z.set_memory_hint();
         hull_verts.set_memory_hint();
+        adjacency_offset.set_memory_hint();
+        adjacency.set_memory_hint();
         }
 #endif
 
@@ -237,6 +306,18 @@ struct PolyhedronVertices : ShapeParams
     /// Number of vertices in the convex hull
     unsigned int n_hull_verts;
 
+    /// Minimum number of vertices to find the support vertex by walking the hull edges
+    static constexpr unsigned int hill_climbing_min_verts = 48;
+
+    /// Index of the first neighbor of each vertex in adjacency, N + 1 entries
+    ManagedArray<unsigned int> adjacency_offset;
+
+    /// Neighbors of the vertices on the convex hull, empty for small polyhedra
+    ManagedArray<unsigned int> adjacency;
+
+    /// Vertex on the convex hull where the walks start
+    unsigned int support_start;
+
     /// Number of vertices
     unsigned int N;
 
@@ -256,7 +337,9 @@ struct PolyhedronVertices : ShapeParams
 /** Support function for ShapePolyhedron
 
     SupportFuncPolyhedron is a functor that computes the support function for ShapePolyhedron. For a
-    given input vector in local coordinates, it finds the vertex most in that direction.
+    given input vector in local coordinates, it finds the vertex most in that direction. Large
+    polyhedra walk the edges of the convex hull from the previous support vertex, smaller ones scan
+    all vertices.
 */
 class SupportFuncConvexPolyhedron
     {
@@ -270,7 +353,7 @@ class SupportFuncConvexPolyhedron
     */
     DEVICE SupportFuncConvexPolyhedron(const PolyhedronVertices& _verts,
                                        ShortReal extra_sweep_radius = ShortReal(0.0))
-        : verts(_verts), sweep_radius(extra_sweep_radius)
+        : verts(_verts), sweep_radius(extra_sweep_radius), start(_verts.support_start)
         {
         }
 
@@ -281,6 +364,16 @@ class SupportFuncConvexPolyhedron
     */
     DEVICE vec3<ShortReal> operator()(const vec3<ShortReal>& n) const
         {
+        if (verts.adjacency.size() > 0)
+            {
+            unsigned int idx = hillClimb(n);
+            vec3<ShortReal> v(verts.x[idx], verts.y[idx], verts.z[idx]);
+            if (sweep_radius != ShortReal(0.0))
+                return v + (sweep_radius * fast::rsqrt(dot(n, n))) * n;
+            else
+                return v;
+            }
+
         ShortReal max_dot = -(verts.diameter * verts.diameter);
         unsigned int max_idx = 0;
 
@@ -467,8 +560,46 @@ class SupportFuncConvexPolyhedron
         }
 
     private:
+    /** Find the support vertex by walking the edges of the convex hull
+
+        @param n Normal vector input (in the local frame)
+        @returns Index of the vertex furthest in the direction of n
+
+        The walk starts from the result of the previous call, which is close to the result for the
+        slowly changing directions of the overlap iterations. It moves to the neighbor furthest in
+        the direction of n until no neighbor is further. On a convex polyhedron, this local
+        maximum is the global maximum.
+    */
+    DEVICE unsigned int hillClimb(const vec3<ShortReal>& n) const
+        {
+        unsigned int idx = start;
+        ShortReal max_dot = dot(n, vec3<ShortReal>(verts.x[idx], verts.y[idx], verts.z[idx]));
+        bool moved = true;
+        while (moved)
+            {
+            moved = false;
+            const unsigned int first = verts.adjacency_offset[idx];
+            const unsigned int last = verts.adjacency_offset[idx + 1];
+            for (unsigned int k = first; k < last; k++)
+                {
+                unsigned int j = verts.adjacency[k];
+                ShortReal d = dot(n, vec3<ShortReal>(verts.x[j], verts.y[j], verts.z[j]));
+                if (d > max_dot)
+                    {
+                    max_dot = d;
+                    idx = j;
+                    moved = true;
+                    }
+                }
+            }
+
+        start = idx;
+        return idx;
+        }
+
     const PolyhedronVertices& verts; //!< Vertices of the polyhedron
     const ShortReal sweep_radius;    //!< Extra sweep radius
+    mutable unsigned int start;      //!< Vertex where the next walk starts
     };
 
 /** Geometric primitives for closest point calculation
@@ -778,6 +909,30 @@ struct ShapeConvexPolyhedron
     const detail::PolyhedronVertices& verts;
     };
 
+/** Convex polyhedron bounding volume test
+
+    @param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    @param a first shape
+    @param b second shape
+    @returns false when the OBBs of *a* and *b* are disjoint
+*/
+template<>
+DEVICE inline bool test_bounding_volume_overlap(const vec3<Scalar>& r_ab,
+                                                const ShapeConvexPolyhedron& a,
+                                                const ShapeConvexPolyhedron& b)
+    {
+    detail::OBB obb_a = a.getOBB(vec3<Scalar>(0, 0, 0));
+    detail::OBB obb_b = b.getOBB(r_ab);
+
+    // pad the boxes so that rounding in single precision never rejects an overlapping pair
+    ShortReal pad
+        = ShortReal(1e-5) * ShortReal(a.getCircumsphereDiameter() + b.getCircumsphereDiameter());
+    obb_a.lengths += vec3<ShortReal>(pad, pad, pad);
+    obb_b.lengths += vec3<ShortReal>(pad, pad, pad);
+
+    return detail::overlap(obb_a, obb_b);
+    }
+
 /** Convex polyhedron overlap test
 
     @param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
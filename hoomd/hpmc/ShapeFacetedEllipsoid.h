@@ -171,6 +171,8 @@ struct FacetedEllipsoidParams : ShapeParams
         additional_verts = detail::PolyhedronVertices(2 * N * N, managed);
         additional_verts.diameter = ShortReal(2.0); // for unit sphere
         additional_verts.N = 0;
+        // the support function scans the intersection points, they have no hull
+        additional_verts.buildSupportGraph(managed);
 
         // iterate over unique pairs of planes
         for (unsigned int i = 0; i < N; ++i)
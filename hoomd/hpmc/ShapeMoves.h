@@ -302,6 +302,12 @@ class ConvexPolyhedronVertexShapeMove : public ShapeMoveBase<ShapeConvexPolyhedr
             = static_cast<ShortReal>(fast::pow(this->m_volume[type_id] / volume, 1.0 / 3.0));
         scaleParticleVolume(shape, dr, scale);
         this->m_step_size[type_id] *= scale;
+
+        // the perturbed vertices change the faces of the convex hull
+        std::vector<vec3<ShortReal>> verts(shape.N);
+        for (unsigned int i = 0; i < shape.N; i++)
+            verts[i] = vec3<ShortReal>(shape.x[i], shape.y[i], shape.z[i]);
+        shape.setVerts(verts, shape.sweep_radius, managed);
         }
 
     void retreat(uint64_t timestep, unsigned int type)
@@ -0,0 +1,343 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "ShapeSphere.h"
+#include "hoomd/AABBTree.h"
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VectorMath.h"
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/*! \file ShapeOverlaps.h
+    \brief Declares ShapeOverlaps, which finds the overlapping shapes in given configurations
+    \note This header cannot be compiled by nvcc
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+//! Find the overlapping shapes in particle configurations
+/*! ShapeOverlaps tests configurations that are given directly as positions, orientations, types
+    and a box, without a system definition or an integrator. Each call to findOverlaps() builds a
+    temporary AABB tree of the particles and applies the test_overlap() functions that the
+    integrators use. The overlap tests of the particles run in parallel with TBB.
+
+    \tparam Shape Shape class
+*/
+template<class Shape> class ShapeOverlaps
+    {
+    public:
+    typedef typename Shape::param_type param_type;
+
+    //! Construct from the shape parameters of each type
+    /*! \param shapes List with the shape parameter dictionary of each type
+     */
+    ShapeOverlaps(pybind11::list shapes)
+        {
+        for (auto shape : shapes)
+            {
+            m_params.push_back(param_type(pybind11::cast<pybind11::dict>(shape), false));
+            }
+        }
+
+    //! Set the number of CPU threads
+    void setNumThreads(unsigned int num_threads)
+        {
+        if (num_threads == 0)
+            {
+            throw std::domain_error("num_threads must be positive.");
+            }
+        m_num_threads = num_threads;
+        }
+
+    //! Get the number of CPU threads
+    unsigned int getNumThreads() const
+        {
+        return m_num_threads;
+        }
+
+    //! Find the overlapping pairs of particles
+    std::vector<std::pair<unsigned int, unsigned int>>
+    findOverlaps(const BoxDim& box,
+                 unsigned int n_dimensions,
+                 const std::vector<vec3<Scalar>>& position,
+                 const std::vector<quat<Scalar>>& orientation,
+                 const std::vector<unsigned int>& type) const;
+
+    //! Find the overlapping pairs of particles given as numpy arrays
+    pybind11::array_t<unsigned int>
+    findOverlapsPy(std::shared_ptr<BoxDim> box,
+                   unsigned int n_dimensions,
+                   pybind11::array_t<Scalar, pybind11::array::c_style | pybind11::array::forcecast>
+                       position,
+                   pybind11::array_t<Scalar, pybind11::array::c_style | pybind11::array::forcecast>
+                       orientation,
+                   pybind11::array_t<unsigned int,
+                                     pybind11::array::c_style | pybind11::array::forcecast> type)
+        const;
+
+    private:
+    std::vector<param_type> m_params; //!< Shape parameters of each type
+    unsigned int m_num_threads = 1;   //!< Number of CPU threads
+    };
+
+/*! \param box Periodic simulation box
+    \param n_dimensions Number of dimensions of the box
+    \param position Particle positions
+    \param orientation Particle orientations
+    \param type Particle types
+
+    \returns The overlapping pairs (i, j) with i <= j, sorted. Pairs with i == j are particles that
+             overlap their own periodic image.
+
+    The periodic images of the box are those within the largest circumsphere diameter, so small
+    boxes are supported.
+*/
+template<class Shape>
+std::vector<std::pair<unsigned int, unsigned int>>
+ShapeOverlaps<Shape>::findOverlaps(const BoxDim& box,
+                                   unsigned int n_dimensions,
+                                   const std::vector<vec3<Scalar>>& position,
+                                   const std::vector<quat<Scalar>>& orientation,
+                                   const std::vector<unsigned int>& type) const
+    {
+    const unsigned int N = (unsigned int)position.size();
+    if (orientation.size() != N || type.size() != N)
+        {
+        throw std::runtime_error("position, orientation, and type must have the same length.");
+        }
+
+    // wrap the particles into the box and build the tree
+    std::vector<vec3<Scalar>> wrapped(position);
+    std::vector<hoomd::detail::AABB> aabbs(N);
+    Scalar max_diameter(0.0);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        if (type[i] >= m_params.size())
+            {
+            throw std::runtime_error("Particle type out of range.");
+            }
+
+        int3 image = make_int3(0, 0, 0);
+        box.wrap(wrapped[i], image);
+        Shape shape_i(orientation[i], m_params[type[i]]);
+        aabbs[i] = shape_i.getAABB(wrapped[i]);
+        max_diameter = std::max(max_diameter, Scalar(shape_i.getCircumsphereDiameter()));
+        }
+
+    hoomd::detail::AABBTree tree;
+    if (N > 0)
+        {
+        tree.buildTree(aabbs.data(), N);
+        }
+
+    // list the images within reach of the largest shape, the first image is the box itself
+    const Scalar3 npd = box.getNearestPlaneDistance();
+    const int n_x = int(std::ceil(max_diameter / npd.x));
+    const int n_y = int(std::ceil(max_diameter / npd.y));
+    const int n_z = n_dimensions == 2 ? 0 : int(std::ceil(max_diameter / npd.z));
+    std::vector<vec3<Scalar>> image_list(1, vec3<Scalar>(0, 0, 0));
+    for (int h = -n_x; h <= n_x; h++)
+        {
+        for (int k = -n_y; k <= n_y; k++)
+            {
+            for (int l = -n_z; l <= n_z; l++)
+                {
+                if (h != 0 || k != 0 || l != 0)
+                    {
+                    image_list.push_back(vec3<Scalar>(Scalar(h) * box.getLatticeVector(0)
+                                                      + Scalar(k) * box.getLatticeVector(1)
+                                                      + Scalar(l) * box.getLatticeVector(2)));
+                    }
+                }
+            }
+        }
+
+    // find the overlaps of particle i with the particles j >= i
+    auto find_overlaps_of = [&](unsigned int i,
+                                std::vector<std::pair<unsigned int, unsigned int>>& overlaps)
+    {
+        Shape shape_i(orientation[i], m_params[type[i]]);
+        hoomd::detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0, 0, 0));
+        unsigned int err_count = 0;
+
+        for (unsigned int cur_image = 0; cur_image < image_list.size(); cur_image++)
+            {
+            vec3<Scalar> pos_i_image = wrapped[i] + image_list[cur_image];
+            hoomd::detail::AABB aabb = aabb_i_local;
+            aabb.translate(pos_i_image);
+
+            // stackless search
+            for (unsigned int cur_node_idx = 0; cur_node_idx < tree.getNumNodes(); cur_node_idx++)
+                {
+                if (aabb.overlaps(tree.getNodeAABB(cur_node_idx)))
+                    {
+                    if (tree.isNodeLeaf(cur_node_idx))
+                        {
+                        for (unsigned int cur_p = 0; cur_p < tree.getNodeNumParticles(cur_node_idx);
+                             cur_p++)
+                            {
+                            unsigned int j = tree.getNodeParticle(cur_node_idx, cur_p);
+                            if (j < i || (cur_image == 0 && j == i))
+                                {
+                                continue;
+                                }
+
+                            vec3<Scalar> r_ij = wrapped[j] - pos_i_image;
+                            Shape shape_j(orientation[j], m_params[type[j]]);
+                            if (check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                                && test_overlap(r_ij, shape_i, shape_j, err_count)
+                                && test_overlap(-r_ij, shape_j, shape_i, err_count))
+                                {
+                                overlaps.push_back(std::make_pair(i, j));
+                                }
+                            }
+                        }
+                    }
+                else
+                    {
+                    // skip ahead
+                    cur_node_idx += tree.getNodeSkip(cur_node_idx);
+                    }
+                }
+            }
+    };
+
+    std::vector<std::pair<unsigned int, unsigned int>> overlaps;
+#ifdef ENABLE_TBB
+    tbb::enumerable_thread_specific<std::vector<std::pair<unsigned int, unsigned int>>>
+        thread_overlaps;
+    tbb::task_arena arena(m_num_threads);
+    arena.execute(
+        [&]
+        {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              {
+                                  auto& local_overlaps = thread_overlaps.local();
+                                  for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                      {
+                                      find_overlaps_of(i, local_overlaps);
+                                      }
+                              });
+        });
+
+    for (const auto& local_overlaps : thread_overlaps)
+        {
+        overlaps.insert(overlaps.end(), local_overlaps.begin(), local_overlaps.end());
+        }
+#else
+    for (unsigned int i = 0; i < N; i++)
+        {
+        find_overlaps_of(i, overlaps);
+        }
+#endif
+
+    // a pair may overlap in more than one image
+    std::sort(overlaps.begin(), overlaps.end());
+    overlaps.erase(std::unique(overlaps.begin(), overlaps.end()), overlaps.end());
+    return overlaps;
+    }
+
+/*! \param box Periodic simulation box
+    \param n_dimensions Number of dimensions of the box
+    \param position (N, 3) array of particle positions
+    \param orientation (N, 4) array of particle orientations
+    \param type (N,) array of particle types
+
+    \returns (M, 2) array of the overlapping pairs
+*/
+template<class Shape>
+pybind11::array_t<unsigned int> ShapeOverlaps<Shape>::findOverlapsPy(
+    std::shared_ptr<BoxDim> box,
+    unsigned int n_dimensions,
+    pybind11::array_t<Scalar, pybind11::array::c_style | pybind11::array::forcecast> position,
+    pybind11::array_t<Scalar, pybind11::array::c_style | pybind11::array::forcecast> orientation,
+    pybind11::array_t<unsigned int, pybind11::array::c_style | pybind11::array::forcecast> type)
+    const
+    {
+    if (position.ndim() != 2 || position.shape(1) != 3)
+        {
+        throw std::runtime_error("position must be a (N, 3) array.");
+        }
+    if (orientation.ndim() != 2 || orientation.shape(1) != 4)
+        {
+        throw std::runtime_error("orientation must be a (N, 4) array.");
+        }
+    if (type.ndim() != 1)
+        {
+        throw std::runtime_error("type must be a (N,) array.");
+        }
+
+    const size_t N = position.shape(0);
+    if (size_t(orientation.shape(0)) != N || size_t(type.shape(0)) != N)
+        {
+        throw std::runtime_error("position, orientation, and type must have the same length.");
+        }
+
+    const Scalar* p = position.data();
+    const Scalar* q = orientation.data();
+    std::vector<vec3<Scalar>> position_vector(N);
+    std::vector<quat<Scalar>> orientation_vector(N);
+    for (size_t i = 0; i < N; i++)
+        {
+        position_vector[i] = vec3<Scalar>(p[3 * i], p[3 * i + 1], p[3 * i + 2]);
+        orientation_vector[i]
+            = quat<Scalar>(q[4 * i], vec3<Scalar>(q[4 * i + 1], q[4 * i + 2], q[4 * i + 3]));
+        }
+    std::vector<unsigned int> type_vector(type.data(), type.data() + N);
+
+    auto overlaps
+        = findOverlaps(*box, n_dimensions, position_vector, orientation_vector, type_vector);
+
+    pybind11::array_t<unsigned int> result({overlaps.size(), size_t(2)});
+    unsigned int* r = result.mutable_data();
+    for (size_t k = 0; k < overlaps.size(); k++)
+        {
+        r[2 * k] = overlaps[k].first;
+        r[2 * k + 1] = overlaps[k].second;
+        }
+    return result;
+    }
+
+namespace detail
+    {
+//! Export ShapeOverlaps to python
+/*! \param name Name of the class in the exported python module
+    \tparam Shape Shape class to export
+*/
+template<class Shape> void export_ShapeOverlaps(pybind11::module& m, const std::string& name)
+    {
+    pybind11::class_<ShapeOverlaps<Shape>, std::shared_ptr<ShapeOverlaps<Shape>>>(m, name.c_str())
+        .def(pybind11::init<pybind11::list>())
+        .def_property("num_threads",
+                      &ShapeOverlaps<Shape>::getNumThreads,
+                      &ShapeOverlaps<Shape>::setNumThreads)
+        .def("findOverlaps", &ShapeOverlaps<Shape>::findOverlapsPy);
+    }
+
+    } // end namespace detail
+    } // end namespace hpmc
+    } // end namespace hoomd
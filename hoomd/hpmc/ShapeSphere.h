@@ -264,6 +264,24 @@ check_circumsphere_overlap(const vec3<LongReal>& r_ab, const ShapeA& a, const Sh
     return (r_squared * LongReal(4.0) <= diameter_sum * diameter_sum);
     }
 
+//! Check if the bounding volumes of two shapes overlap
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \returns false when *a* and *b* are certainly disjoint
+
+    The CPU narrow phase calls this before test_overlap() to reject pairs cheaply. The general
+    version rejects nothing. Shapes with tight bounding volumes specialize it.
+
+    \ingroup shape
+*/
+template<class ShapeA, class ShapeB>
+DEVICE inline bool
+test_bounding_volume_overlap(const vec3<Scalar>& r_ab, const ShapeA& a, const ShapeB& b)
+    {
+    return true;
+    }
+
 //! Define the general overlap function
 /*! This is just a convenient spot to put this to make sure it is defined early
     \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
@@ -138,6 +138,31 @@ struct ShapeSpheropolyhedron
     const detail::PolyhedronVertices& verts; //!< Vertices
     };
 
+//! Spheropolyhedron bounding volume test
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \returns false when the OBBs of *a* and *b* are disjoint
+
+    \ingroup shape
+*/
+template<>
+DEVICE inline bool test_bounding_volume_overlap(const vec3<Scalar>& r_ab,
+                                                const ShapeSpheropolyhedron& a,
+                                                const ShapeSpheropolyhedron& b)
+    {
+    detail::OBB obb_a = a.getOBB(vec3<Scalar>(0, 0, 0));
+    detail::OBB obb_b = b.getOBB(r_ab);
+
+    // pad the boxes so that rounding in single precision never rejects an overlapping pair
+    ShortReal pad
+        = ShortReal(1e-5) * ShortReal(a.getCircumsphereDiameter() + b.getCircumsphereDiameter());
+    obb_a.lengths += vec3<ShortReal>(pad, pad, pad);
+    obb_b.lengths += vec3<ShortReal>(pad, pad, pad);
+
+    return detail::overlap(obb_a, obb_b);
+    }
+
 //! Convex polyhedron overlap test
 /*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
     \param a first shape
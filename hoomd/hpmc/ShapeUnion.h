@@ -19,6 +19,7 @@
 #else
 #define DEVICE
 #define HOSTDEVICE
+#include <cstdint>
 #include <iostream>
 #endif
 
@@ -45,6 +46,79 @@ struct union_depletion_storage
     unsigned int cur_node_b;
     };
 
+#ifndef __HIPCC__
+/// Remembers the leaf node pairs that overlapped in recent union overlap checks
+/* Two unions in a similar relative configuration tend to overlap in the same pair of leaf nodes.
+   test_overlap() tests the remembered pair before it traverses the trees, and returns early when
+   that pair overlaps. Entries are addressed by the parameters of both unions and a coarse
+   quantization of the relative orientation and direction. Any entry is a valid guess, so hash
+   collisions and stale entries affect only the performance.
+
+   Each CPU thread has its own fixed size cache. The cache is not available in GPU kernels.
+*/
+struct UnionOverlapWitnessCache
+    {
+    /// Number of entries
+    static constexpr unsigned int size = 1024;
+
+    /// A remembered overlapping leaf node pair
+    struct Entry
+        {
+        /// Parameters of the first union
+        const void* params_a = nullptr;
+
+        /// Parameters of the second union
+        const void* params_b = nullptr;
+
+        /// The leaf node in the tree of the first union
+        unsigned int node_a = 0;
+
+        /// The leaf node in the tree of the second union
+        unsigned int node_b = 0;
+        };
+
+    /// Get the entry for a configuration
+    /** @param params_a Parameters of the first union
+        @param params_b Parameters of the second union
+        @param q Orientation of the first union relative to the second
+        @param dr Position of the first union in the frame of the second
+        @param range Sum of the circumsphere radii
+    */
+    static Entry& lookup(const void* params_a,
+                         const void* params_b,
+                         quat<ShortReal> q,
+                         const vec3<ShortReal>& dr,
+                         ShortReal range)
+        {
+        thread_local UnionOverlapWitnessCache cache;
+
+        // q and -q are the same rotation
+        if (q.s < ShortReal(0.0))
+            q = quat<ShortReal>(-q.s, -q.v);
+
+        // 8 bins per quaternion component and 4 bins per direction component
+        auto bin = [](ShortReal x, ShortReal n)
+        {
+            x = x < ShortReal(-1.0) ? ShortReal(-1.0) : (x > ShortReal(1.0) ? ShortReal(1.0) : x);
+            return uint64_t((x + ShortReal(1.0)) * ShortReal(0.5) * (n - ShortReal(0.5)));
+        };
+
+        ShortReal inv_range = range > ShortReal(0.0) ? ShortReal(1.0) / range : ShortReal(0.0);
+        uint64_t key = bin(q.s, 8) | bin(q.v.x, 8) << 3 | bin(q.v.y, 8) << 6 | bin(q.v.z, 8) << 9
+                       | bin(dr.x * inv_range, 4) << 12 | bin(dr.y * inv_range, 4) << 14
+                       | bin(dr.z * inv_range, 4) << 16;
+        key ^= uint64_t(reinterpret_cast<uintptr_t>(params_a)) * 0x9E3779B97F4A7C15ULL;
+        key ^= uint64_t(reinterpret_cast<uintptr_t>(params_b)) * 0xC2B2AE3D27D4EB4FULL;
+        key ^= key >> 29;
+
+        return cache.entries[key % size];
+        }
+
+    /// The entries
+    Entry entries[size];
+    };
+#endif
+
 /** Data structure for shape composed of a union of multiple shapes.
 
     Store N member shapes of the same type at given positions and orientations relative to the
@@ -462,6 +536,10 @@ DEVICE inline bool test_narrow_phase_overlap(vec3<ShortReal> dr,
 
     vec3<ShortReal> r_ab = rotate(conj(quat<ShortReal>(b.orientation)), vec3<ShortReal>(dr));
 
+    // orientation of a in the frame of b, shared by all member pairs
+    const quat<ShortReal> q_ab(conj(quat<ShortReal>(b.orientation))
+                               * quat<ShortReal>(a.orientation));
+
     // loop through leaf particles of cur_node_a
     // parallel loop over N^2 interacting particle pairs
     unsigned int ptl_i = a.members.tree.getLeafNodePtrByNode(cur_node_a);
@@ -495,14 +573,9 @@ DEVICE inline bool test_narrow_phase_overlap(vec3<ShortReal> dr,
             const mparam_type& params_i = a.members.mparams[ishape];
             Shape shape_i(quat<Scalar>(), params_i);
             if (shape_i.hasOrientation())
-                shape_i.orientation = conj(quat<ShortReal>(b.orientation))
-                                      * quat<ShortReal>(a.orientation)
-                                      * a.members.morientation[ishape];
-
-            vec3<ShortReal> pos_i(
-                rotate(conj(quat<ShortReal>(b.orientation)) * quat<ShortReal>(a.orientation),
-                       a.members.mpos[ishape])
-                - r_ab);
+                shape_i.orientation = q_ab * a.members.morientation[ishape];
+
+            vec3<ShortReal> pos_i(rotate(q_ab, a.members.mpos[ishape]) - r_ab);
             unsigned int overlap_i = a.members.moverlap[ishape];
 
             const auto& params_j = b.members.mparams[jshape];
@@ -548,6 +621,24 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
 
     detail::OBB obb_b = tree_b.getOBB(cur_node_b);
 
+#ifndef __HIPCC__
+    // first test the leaf nodes that overlapped in a similar configuration
+    detail::UnionOverlapWitnessCache::Entry& witness
+        = detail::UnionOverlapWitnessCache::lookup(&a.members,
+                                                   &b.members,
+                                                   q,
+                                                   dr_rot,
+                                                   ShortReal(0.5)
+                                                       * (a.getCircumsphereDiameter()
+                                                          + b.getCircumsphereDiameter()));
+    bool have_witness = witness.params_a == &a.members && witness.params_b == &b.members
+                        && witness.node_a < tree_a.getNumNodes()
+                        && witness.node_b < tree_b.getNumNodes();
+    if (have_witness
+        && test_narrow_phase_overlap(r_ab, a, b, witness.node_a, witness.node_b, err))
+        return true;
+#endif
+
     unsigned int query_node_a = UINT_MAX;
     unsigned int query_node_b = UINT_MAX;
 
@@ -566,9 +657,23 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
                                         q,
                                         dr_rot)
             && test_narrow_phase_overlap(r_ab, a, b, query_node_a, query_node_b, err))
+            {
+#ifndef __HIPCC__
+            witness.params_a = &a.members;
+            witness.params_b = &b.members;
+            witness.node_a = query_node_a;
+            witness.node_b = query_node_b;
+#endif
             return true;
+            }
         }
 
+#ifndef __HIPCC__
+    // do not test this pair again in similar configurations that do not overlap
+    if (have_witness)
+        witness.params_a = nullptr;
+#endif
+
     return false;
     }
 
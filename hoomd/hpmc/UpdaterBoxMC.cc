@@ -409,6 +409,11 @@ void UpdaterBoxMC::update(uint64_t timestep)
         return;
         }
 
+    if (m_move_size_target > Scalar(0.0))
+        {
+        tuneMoveSize(static_cast<unsigned int>(move_type_select));
+        }
+
     if (is_oversheared())
         {
         while (remove_overshear())
@@ -419,6 +424,62 @@ void UpdaterBoxMC::update(uint64_t timestep)
         }
     }
 
+/*! \param move_type Index of the move type attempted in this step
+
+    Each step attempts one box move, so the controller of each move type updates only in the steps
+    that select it. Length moves count as volume moves and share one factor for all dimensions.
+    Every rank attempts the same box move and computes the same factor.
+*/
+void UpdaterBoxMC::tuneMoveSize(unsigned int move_type)
+    {
+    hpmc_boxmc_counters_t counters = getCounters(2);
+    detail::MoveSizeController& controller = m_move_size_controllers[move_type];
+
+    if (move_type == 0)
+        {
+        m_volume_delta *= controller.update(counters.volume_accept_count,
+                                            counters.volume_reject_count,
+                                            m_move_size_target,
+                                            m_move_size_gain);
+        }
+    else if (move_type == 1)
+        {
+        m_ln_volume_delta *= controller.update(counters.ln_volume_accept_count,
+                                               counters.ln_volume_reject_count,
+                                               m_move_size_target,
+                                               m_move_size_gain);
+        }
+    else if (move_type == 2)
+        {
+        Scalar scale = controller.update(counters.volume_accept_count,
+                                         counters.volume_reject_count,
+                                         m_move_size_target,
+                                         m_move_size_gain);
+        for (unsigned int i = 0; i < 3; i++)
+            {
+            m_length_delta[i] *= scale;
+            }
+        }
+    else if (move_type == 3)
+        {
+        Scalar scale = controller.update(counters.shear_accept_count,
+                                         counters.shear_reject_count,
+                                         m_move_size_target,
+                                         m_move_size_gain);
+        for (unsigned int i = 0; i < 3; i++)
+            {
+            m_shear_delta[i] *= scale;
+            }
+        }
+    else if (move_type == 4)
+        {
+        m_aspect_delta *= controller.update(counters.aspect_accept_count,
+                                            counters.aspect_reject_count,
+                                            m_move_size_target,
+                                            m_move_size_gain);
+        }
+    }
+
 void UpdaterBoxMC::update_L(uint64_t timestep, hoomd::RandomGenerator& rng)
     {
     // Get updater parameters for current timestep
@@ -837,7 +898,13 @@ void export_UpdaterBoxMC(pybind11::module& m)
         .def_property("aspect", &UpdaterBoxMC::getAspectParams, &UpdaterBoxMC::setAspectParams)
         .def_property("betaP", &UpdaterBoxMC::getBetaP, &UpdaterBoxMC::setBetaP)
         .def("getCounters", &UpdaterBoxMC::getCounters)
-        .def_property("instance", &UpdaterBoxMC::getInstance, &UpdaterBoxMC::setInstance);
+        .def_property("instance", &UpdaterBoxMC::getInstance, &UpdaterBoxMC::setInstance)
+        .def_property("move_size_target",
+                      &UpdaterBoxMC::getMoveSizeTarget,
+                      &UpdaterBoxMC::setMoveSizeTarget)
+        .def_property("move_size_gain",
+                      &UpdaterBoxMC::getMoveSizeGain,
+                      &UpdaterBoxMC::setMoveSizeGain);
 
     pybind11::class_<hpmc_boxmc_counters_t>(m, "hpmc_boxmc_counters_t")
         .def_property_readonly("volume",
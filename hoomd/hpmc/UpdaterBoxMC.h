@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "IntegratorHPMC.h"
+#include "MoveSizeController.h"
 
 #ifndef __HIPCC__
 #include <pybind11/pybind11.h>
@@ -280,6 +281,42 @@ class UpdaterBoxMC : public Updater
         return m_instance;
         }
 
+    /// Set the target acceptance ratio of the delta tuning, 0 disables the tuning
+    void setMoveSizeTarget(Scalar target)
+        {
+        if (target < Scalar(0.0) || target >= Scalar(1.0))
+            {
+            throw std::domain_error("move_size_target must be in the range [0, 1).");
+            }
+        m_move_size_target = target;
+        for (auto& controller : m_move_size_controllers)
+            {
+            controller.reset();
+            }
+        }
+
+    /// Get the target acceptance ratio of the delta tuning
+    Scalar getMoveSizeTarget()
+        {
+        return m_move_size_target;
+        }
+
+    /// Set the gain of the delta tuning
+    void setMoveSizeGain(Scalar gain)
+        {
+        if (gain <= Scalar(0.0))
+            {
+            throw std::domain_error("move_size_gain must be positive.");
+            }
+        m_move_size_gain = gain;
+        }
+
+    /// Get the gain of the delta tuning
+    Scalar getMoveSizeGain()
+        {
+        return m_move_size_gain;
+        }
+
     private:
     std::shared_ptr<IntegratorHPMC> m_mc; //!< HPMC integrator object
     std::shared_ptr<Variant> m_beta_P;    //!< Reduced pressure in isobaric ensembles
@@ -312,6 +349,15 @@ class UpdaterBoxMC : public Updater
 
     std::vector<Scalar> m_weight_partial_sums; //!< Partial sums of all weights used to select moves
 
+    Scalar m_move_size_target = 0; //!< Target acceptance ratio of the delta tuning, 0 to disable
+    Scalar m_move_size_gain = 1;   //!< Gain of the delta tuning
+
+    /// Tunes the delta of each move type (volume, ln volume, length, shear, and aspect)
+    detail::MoveSizeController m_move_size_controllers[5];
+
+    /// Scale the delta of the move type attempted in this step toward the target acceptance
+    void tuneMoveSize(unsigned int move_type);
+
     inline bool is_oversheared();   //!< detect oversheared box
     inline bool remove_overshear(); //!< detect and remove overshear
     inline bool box_resize(Scalar Lx, Scalar Ly, Scalar Lz, Scalar xy, Scalar xz, Scalar yz);
@@ -22,16 +22,11 @@
 #ifdef ENABLE_TBB
 #include <tbb/concurrent_unordered_map.h>
 #include <tbb/concurrent_unordered_set.h>
-#include <tbb/concurrent_vector.h>
 #include <tbb/parallel_for.h>
-#include <tbb/task.h>
-#include <atomic>
-
-#if TBB_VERSION_MAJOR < 2021
-#define ENABLE_TBB_TASK
+#include <tbb/task_arena.h>
 #endif
 
-#endif
+#include <atomic>
 
 namespace hoomd {
 
@@ -41,49 +36,69 @@ namespace hpmc
 namespace detail
 {
 
-#ifdef ENABLE_TBB_TASK
-//! Wrapper around std::atomic_flag to allow use in a std::vector
-class my_atomic_flag
+//! Wrapper around std::atomic<unsigned int> to allow use in a std::vector
+class my_atomic_uint
     {
     public:
         //! Default constructor
-        my_atomic_flag()
+        my_atomic_uint()
+            : v(0)
             {
-            f.clear();
             }
 
-        //! Copy constructor
-        /*! \note this constructor doesn't really copy the value of its argument,
-            it just reset's the flag to zero
-         */
-        my_atomic_flag(const my_atomic_flag& other)
+        //! Copy constructor (non-atomic)
+        my_atomic_uint(const my_atomic_uint& other)
+            : v(other.load())
             {
-            f.clear();
             }
 
         //! Assignment operator (non-atomic)
-        /*! \note this assignment operator doesn't really copy the value of its argument,
-            it just reset's the flag to zero
-         */
-        my_atomic_flag& operator =( const my_atomic_flag& other)
+        my_atomic_uint& operator =( const my_atomic_uint& other)
             {
-            f.clear();
+            v.store(other.load(), std::memory_order_relaxed);
             return *this;
             }
 
-        //! Sets flag and returns old value
-        bool test_and_set()
+        //! Load the value
+        unsigned int load() const
+            {
+            return v.load(std::memory_order_relaxed);
+            }
+
+        //! Store a value
+        void store(unsigned int value)
+            {
+            v.store(value, std::memory_order_relaxed);
+            }
+
+        //! Replace the value with desired if it equals expected, returns true on success
+        bool compare_exchange(unsigned int expected, unsigned int desired)
             {
-            return f.test_and_set();
+            return v.compare_exchange_strong(expected, desired, std::memory_order_relaxed);
             }
 
     private:
-        std::atomic_flag f;
+        std::atomic<unsigned int> v;
+    };
+
+//! Hash function for particle index pairs
+struct pair_hash
+    {
+    size_t operator()(const std::pair<unsigned int, unsigned int>& p) const
+        {
+        return std::hash<uint64_t>()((uint64_t(p.first) << 32) | uint64_t(p.second));
+        }
     };
-#endif
 
 // Graph class represents a undirected graph
-// using adjacency list representation
+/* The connected components are maintained with a concurrent union-find structure, so that
+   addEdge() is lock-free and may be called from many threads at the same time. Every set is a
+   tree of vertices, and a root links below another root only with a compare-and-swap that succeeds
+   when it is still a root. Roots always link below the root with the smaller index, so the root of
+   a component is its smallest vertex. find() halves the paths it traverses. Percolating clusters
+   are therefore cheap: the work per edge is nearly constant and does not depend on the cluster
+   size, unlike a depth first search that spawns a task per vertex.
+*/
 class Graph
     {
     public:
@@ -97,13 +112,9 @@ class Graph
 
         inline void addEdge(unsigned int v, unsigned int w);
 
-        #ifdef ENABLE_TBB_TASK
-        inline void connectedComponents(std::vector<tbb::concurrent_vector<unsigned int> >& cc);
-        #else
         inline void connectedComponents(std::vector<std::vector<unsigned int> >& cc);
-        #endif
 
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
         void setTaskArena(std::shared_ptr<tbb::task_arena> task_arena)
             {
             m_task_arena = task_arena;
@@ -111,161 +122,110 @@ class Graph
         #endif
 
     private:
-        #ifndef ENABLE_TBB_TASK
-        std::multimap<unsigned int,unsigned int> adj;
-        #else
-        tbb::concurrent_unordered_multimap<unsigned int, unsigned int> adj;
-        #endif
-
-        #ifndef ENABLE_TBB_TASK
-        std::vector<unsigned int> visited;
-        #else
-        std::vector<my_atomic_flag> visited;
-        #endif
+        std::vector<my_atomic_uint> parent;  //!< Parent of every vertex in the union-find forest
+        std::vector<unsigned int> root;      //!< Scratch space for the root of every vertex
 
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
         /// The TBB task arena
         std::shared_ptr<tbb::task_arena> m_task_arena;
         #endif
 
-        #ifndef ENABLE_TBB_TASK
-        // A function used by DFS
-        inline void DFSUtil(unsigned int v, std::vector<unsigned int>& visited, std::vector<unsigned int>& cur_cc);
-        #endif
-
-        #ifdef ENABLE_TBB_TASK
-        class DFSTask : public tbb::task
-            {
-            public:
-                DFSTask(unsigned int _root, std::vector<my_atomic_flag>& _visited,
-                    tbb::concurrent_vector<unsigned int>& _cc,
-                    const tbb::concurrent_unordered_multimap<unsigned int, unsigned int>& _adj)
-                    : root(_root), visited(_visited), cc(_cc), adj(_adj)
-                    { }
-
-                tbb::task* execute()
-                    {
-                    cc.push_back(root);
-
-                    unsigned int count = 0;
-                    tbb::task_list list;
-
-                    auto begin = adj.equal_range(root).first;
-                    auto end = adj.equal_range(root).second;
-
-                    for (auto it = begin; it != end; ++it)
-                        {
-                        unsigned int neighbor = it->second;
-                        if (!visited[neighbor].test_and_set())
-                            {
-                            if (count++ == 0)
-                                {
-                                root = neighbor; // for task recycling
-                                continue;
-                                }
-                            list.push_back(*new(allocate_child()) DFSTask(neighbor, visited, cc, adj));
-                            }
-                        }
-
-                    if (count)
-                        {
-                        set_ref_count(count);
-                        spawn(list);
-
-                        recycle_as_safe_continuation();
-                        }
-
-                    return NULL;
-                    }
-
-            private:
-                unsigned int root;
-                std::vector<my_atomic_flag> & visited;
-                tbb::concurrent_vector<unsigned int>& cc;
-                const tbb::concurrent_unordered_multimap<unsigned int, unsigned int>& adj;
-            };
-        #endif // ENABLE_TBB_TASK
-
+        //! Find the root of the set of vertex v
+        inline unsigned int find(unsigned int v);
     };
 
 // Gather connected components in an undirected graph
-#ifdef ENABLE_TBB_TASK
-void Graph::connectedComponents(std::vector<tbb::concurrent_vector<unsigned int> >& cc)
-#else
+/* Every component is sorted by vertex index, and the components are sorted by their smallest
+   vertex, so the result does not depend on the number of threads or the order of the edges.
+*/
 void Graph::connectedComponents(std::vector<std::vector<unsigned int> >& cc)
-#endif
     {
-    #ifdef ENABLE_TBB_TASK
+    const unsigned int n_vertices = (unsigned int)parent.size();
+    root.resize(n_vertices);
+
+    #ifdef ENABLE_TBB
     this->m_task_arena->execute([&]{
-    for (unsigned int v = 0; v < visited.size(); ++v)
+    tbb::parallel_for((unsigned int)0, n_vertices, [&](unsigned int v)
+    #else
+    for (unsigned int v = 0; v < n_vertices; ++v)
+    #endif
         {
-        if (! visited[v].test_and_set())
-            {
-            tbb::concurrent_vector<unsigned int> component;
-            DFSTask& a = *new(tbb::task::allocate_root()) DFSTask(v, visited, component, adj);
-            tbb::task::spawn_root_and_wait(a);
-            cc.push_back(component);
-            }
+        root[v] = find(v);
         }
+    #ifdef ENABLE_TBB
+        );
     }); // end task arena execute()
-    #else
-    std::fill(visited.begin(), visited.end(), 0);
+    #endif
 
-    // Depth first search
-    for (unsigned int v=0; v<visited.size(); v++)
+    // number the components by their root, reusing the parent array for the component index
+    unsigned int n_components = (unsigned int)cc.size();
+    for (unsigned int v = 0; v < n_vertices; ++v)
         {
-        if (visited[v] == false)
+        if (root[v] == v)
             {
-            std::vector<unsigned int> cur_cc;
-            DFSUtil(v, visited, cur_cc);
-            cc.push_back(cur_cc);
+            parent[v].store(n_components++);
+            cc.push_back(std::vector<unsigned int>());
             }
         }
-    #endif
+
+    for (unsigned int v = 0; v < n_vertices; ++v)
+        {
+        cc[parent[root[v]].load()].push_back(v);
+        }
+
+    // the parent array no longer describes the forest
+    for (unsigned int v = 0; v < n_vertices; ++v)
+        {
+        parent[v].store(v);
+        }
     }
 
-#ifndef ENABLE_TBB_TASK
-void Graph::DFSUtil(unsigned int v, std::vector<unsigned int>& visited, std::vector<unsigned int>& cur_cc)
+unsigned int Graph::find(unsigned int v)
     {
-    visited[v] = 1;
-    cur_cc.push_back(v);
-
-    // Recur for all the vertices
-    // adjacent to this vertex
-    auto begin = adj.equal_range(v).first;
-    auto end = adj.equal_range(v).second;
-    for(auto i = begin; i != end; ++i)
+    while (true)
         {
-        if(!visited[i->second])
-            DFSUtil(i->second, visited, cur_cc);
+        unsigned int p = parent[v].load();
+        if (p == v)
+            return v;
+
+        // path halving, another thread may have already changed parent[v]
+        unsigned int gp = parent[p].load();
+        if (gp != p)
+            parent[v].compare_exchange(p, gp);
+        v = gp;
         }
     }
-#endif
+
 Graph::Graph(unsigned int V)
     {
-    #ifndef ENABLE_TBB_TASK
-    visited.resize(V, 0);
-    #else
-    visited.resize(V);
-    #endif
+    resize(V);
     }
 
 void Graph::resize(unsigned int V)
     {
-    #ifndef ENABLE_TBB_TASK
-    visited.resize(V, 0);
-    #else
-    visited.clear();
-    visited.resize(V);
-    #endif
-
-    adj.clear();
+    parent.resize(V);
+    for (unsigned int v = 0; v < V; ++v)
+        parent[v].store(v);
     }
 
-// method to add a directed edge
+// method to add an edge
 void Graph::addEdge(unsigned int v, unsigned int w)
     {
-    adj.insert(std::make_pair(v,w));
+    while (true)
+        {
+        v = find(v);
+        w = find(w);
+        if (v == w)
+            return;
+
+        // link the root with the larger index below the other root
+        if (v < w)
+            std::swap(v, w);
+        if (parent[v].compare_exchange(v, w))
+            return;
+
+        // v is no longer a root, retry with the new roots
+        }
     }
 } // end namespace detail
 
@@ -365,11 +325,7 @@ class UpdaterClusters : public Updater
 
         unsigned int m_instance=0;                  //!< Unique ID for RNG seeding
 
-        #ifdef ENABLE_TBB_TASK
-        std::vector<tbb::concurrent_vector<unsigned int> > m_clusters; //!< Cluster components
-        #else
         std::vector<std::vector<unsigned int> > m_clusters; //!< Cluster components
-        #endif
 
         detail::Graph m_G; //!< The graph
 
@@ -379,14 +335,14 @@ class UpdaterClusters : public Updater
         GlobalVector<Scalar4> m_orientation_backup;    //!< Old local orientations
         GlobalVector<int3> m_image_backup;             //!< Old local images
 
-        #ifndef ENABLE_TBB_TASK
+        #ifndef ENABLE_TBB
         std::set<std::pair<unsigned int, unsigned int> > m_overlap;   //!< A local vector of particle pairs due to overlap
         std::map<std::pair<unsigned int, unsigned int>,LongReal > m_energy_old_old;    //!< Energy of interaction old-old
         std::map<std::pair<unsigned int, unsigned int>,LongReal > m_energy_new_old;    //!< Energy of interaction old-old
         #else
-        tbb::concurrent_unordered_set<std::pair<unsigned int, unsigned int> > m_overlap;
-        tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>,LongReal > m_energy_old_old;
-        tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>,LongReal > m_energy_new_old;
+        tbb::concurrent_unordered_set<std::pair<unsigned int, unsigned int>, detail::pair_hash> m_overlap;
+        tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>,LongReal, detail::pair_hash> m_energy_old_old;
+        tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>,LongReal, detail::pair_hash> m_energy_new_old;
         #endif
 
         hpmc_clusters_counters_t m_count_total;                 //!< Total count since initialization
@@ -426,7 +382,7 @@ UpdaterClusters<Shape>::UpdaterClusters(std::shared_ptr<SystemDefinition> sysdef
     {
     m_exec_conf->msg->notice(5) << "Constructing UpdaterClusters" << std::endl;
 
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
     m_G.setTaskArena(sysdef->getParticleData()->getExecConf()->getTaskArena());
     #endif
 
@@ -494,7 +450,7 @@ inline void UpdaterClusters<Shape>::checkDepletantOverlap(unsigned int i, vec3<S
         }
     img_i = box.getImage(pos_i_transf);
 
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
     this->m_exec_conf->getTaskArena()->execute([&]{
     tbb::parallel_for(tbb::blocked_range<unsigned int>(0, this->m_pdata->getNTypes()),
         [=, &shape_i](const tbb::blocked_range<unsigned int>& x) {
@@ -507,7 +463,7 @@ inline void UpdaterClusters<Shape>::checkDepletantOverlap(unsigned int i, vec3<S
             {
             continue;
             }
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
         tbb::parallel_for(tbb::blocked_range<unsigned int>(type_a, this->m_pdata->getNTypes()),
             [=, &shape_i](const tbb::blocked_range<unsigned int>& w) {
         for (unsigned int type_b = w.begin(); type_b != w.end(); ++type_b)
@@ -655,7 +611,7 @@ inline void UpdaterClusters<Shape>::checkDepletantOverlap(unsigned int i, vec3<S
                 }
 
             // for every depletant
-            #ifdef ENABLE_TBB_TASK
+            #ifdef ENABLE_TBB
             tbb::parallel_for(tbb::blocked_range<unsigned int>(0, (unsigned int)n),
                 [=, &shape_i,
                     &pos_j, &orientation_j, &type_j, &V_all,
@@ -1051,15 +1007,15 @@ inline void UpdaterClusters<Shape>::checkDepletantOverlap(unsigned int i, vec3<S
                         }
                     } // end loop over intersections
                 } // end loop over depletants
-            #ifdef ENABLE_TBB_TASK
+            #ifdef ENABLE_TBB
                 });
             #endif
             } // end loop over type_b
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
             });
         #endif
         } // end loop over type_a
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
         });
     }); // end task arena execute()
     #endif
@@ -1192,7 +1148,7 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
     if (m_mc->hasPairInteractions())
         {
         // test old configuration against itself
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
         this->m_exec_conf->getTaskArena()->execute([&]{
         tbb::parallel_for((unsigned int)0,this->m_pdata->getN(), [&](unsigned int i)
         #else
@@ -1286,14 +1242,14 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
                 } // end loop over images
 
             } // end loop over old configuration
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
             );
         }); // end task arena execute()
         #endif
         }
 
     // loop over new configuration
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
     this->m_exec_conf->getTaskArena()->execute([&]{
     tbb::parallel_for((unsigned int)0,nptl, [&](unsigned int i)
     #else
@@ -1452,7 +1408,7 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
                 } // end loop over images
             } // end if patch
         } // end loop over local particles
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
         );
     }); // end task arena execute()
     #endif
@@ -1476,7 +1432,7 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
         return;
 
     // test old configuration against itself
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
     this->m_exec_conf->getTaskArena()->execute([&]{
     tbb::parallel_for((unsigned int)0,this->m_pdata->getN(), [&](unsigned int i) {
     #else
@@ -1494,7 +1450,7 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
             h_overlaps.data, h_fugacity.data,
             timestep, q, pivot, line);
         }
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
         });
     }); // end task arena execute()
     #endif
@@ -1629,7 +1585,7 @@ void UpdaterClusters<Shape>::update(uint64_t timestep)
     // resize the number of graph nodes in place
     m_G.resize(this->m_pdata->getN());
 
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
     this->m_exec_conf->getTaskArena()->execute([&]{
     tbb::parallel_for(m_overlap.range(), [&] (decltype(m_overlap.range()) r)
     #else
@@ -1646,7 +1602,7 @@ void UpdaterClusters<Shape>::update(uint64_t timestep)
             m_G.addEdge(i,j);
             }
         }
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
         );
     }); // end task arena execute()
     #endif
@@ -1654,8 +1610,8 @@ void UpdaterClusters<Shape>::update(uint64_t timestep)
     if (m_mc->hasPairInteractions())
         {
         // sum up interaction energies
-        #ifdef ENABLE_TBB_TASK
-        tbb::concurrent_unordered_map< std::pair<unsigned int, unsigned int>, LongReal> delta_U;
+        #ifdef ENABLE_TBB
+        tbb::concurrent_unordered_map< std::pair<unsigned int, unsigned int>, LongReal, detail::pair_hash> delta_U;
         #else
         std::map< std::pair<unsigned int, unsigned int>, LongReal> delta_U;
         #endif
@@ -1694,7 +1650,7 @@ void UpdaterClusters<Shape>::update(uint64_t timestep)
             delta_U[p] = delU;
             }
 
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
         this->m_exec_conf->getTaskArena()->execute([&]{
         tbb::parallel_for(delta_U.range(), [&] (decltype(delta_U.range()) r)
         #else
@@ -1719,7 +1675,7 @@ void UpdaterClusters<Shape>::update(uint64_t timestep)
                     }
                 }
             }
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
             );
         }); // end task arena execute()
         #endif
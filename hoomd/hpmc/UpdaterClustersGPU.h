@@ -349,7 +349,9 @@ template<class Shape> void UpdaterClustersGPU<Shape>::update(uint64_t timestep)
         max_d = std::max(max_d, static_cast<Scalar>(tmp_i.getCircumsphereDiameter()));
         }
     nominal_width += max_d;
-    if (this->m_cl->getNominalWidth() != nominal_width)
+    // A wider cell list still lists all interacting pairs. Keep the width set by the integrator
+    // when the two share the cell list.
+    if (this->m_cl->getNominalWidth() < nominal_width)
         this->m_cl->setNominalWidth(nominal_width);
 
     // update the cell list before re-initializing
@@ -399,6 +401,9 @@ template<class Shape> void UpdaterClustersGPU<Shape>::update(uint64_t timestep)
 
     // perform the update
     UpdaterClusters<Shape>::update(timestep);
+
+    // the integrator may share the cell list on this timestep
+    this->m_cl->notifyParticlesMoved();
     }
 
 template<class Shape> void UpdaterClustersGPU<Shape>::connectedComponents()
@@ -147,6 +147,18 @@ template<class Shape> class UpdaterMuVT : public Updater
         return m_n_trial;
         }
 
+    //! Set the number of domain-local insertion and removal trials per rank
+    void setLocalTrials(unsigned int local_trials)
+        {
+        m_local_trials = local_trials;
+        }
+
+    //! Get the number of domain-local insertion and removal trials per rank
+    unsigned int getLocalTrials()
+        {
+        return m_local_trials;
+        }
+
     //! Get the current counter values
     hpmc_muvt_counters_t getCounters(unsigned int mode = 0);
 
@@ -179,6 +191,8 @@ template<class Shape> class UpdaterMuVT : public Updater
 
     unsigned int m_n_trial;
 
+    unsigned int m_local_trials; //!< Number of domain-local trials per rank and update
+
     /*! Check for overlaps of a fictitious particle
      * \param timestep Current time step
      * \param type Type of particle to test
@@ -201,6 +215,38 @@ template<class Shape> class UpdaterMuVT : public Updater
      */
     virtual bool tryRemoveParticle(uint64_t timestep, unsigned int tag, Scalar& lnboltzmann);
 
+    //! Insert and remove particles in the active region of the local domain
+    /*! \param timestep Current time step
+     */
+    virtual void updateLocal(uint64_t timestep);
+
+    /*! Compute the interaction energy of a particle with the local configuration
+     *
+     * The local particles have the indices 0 to N-1 and the inserted particles follow them.
+     *
+     * \param type Type of the particle
+     * \param pos Position of the particle
+     * \param orientation Orientation of the particle
+     * \param diameter Diameter of the particle
+     * \param charge Charge of the particle
+     * \param skip_idx Index of the particle to exclude from the sum (UINT_MAX for none)
+     * \param removed Flags of the local and inserted particles that have been removed
+     * \param inserted Particles that have been inserted, not yet in the particle data
+     * \param check_overlaps Whether to test for hard overlaps
+     * \param energy Total interaction energy (return value)
+     * \returns True if the particle does not overlap
+     */
+    bool computeLocalEnergy(unsigned int type,
+                            const vec3<Scalar>& pos,
+                            const quat<Scalar>& orientation,
+                            Scalar diameter,
+                            Scalar charge,
+                            unsigned int skip_idx,
+                            const std::vector<bool>& removed,
+                            const std::vector<hoomd::detail::pdata_element>& inserted,
+                            bool check_overlaps,
+                            Scalar& energy);
+
     /*! Rescale box to new dimensions and scale particles
      * \param timestep current timestep
      * \param new_box the old BoxDim
@@ -334,7 +380,8 @@ UpdaterMuVT<Shape>::UpdaterMuVT(std::shared_ptr<SystemDefinition> sysdef,
                                 std::shared_ptr<IntegratorHPMCMono<Shape>> mc,
                                 unsigned int npartition)
     : Updater(sysdef, trigger), m_mc(mc), m_npartition(npartition), m_gibbs(false),
-      m_max_vol_rescale(0.1), m_volume_move_probability(0.5), m_gibbs_other(0), m_n_trial(1)
+      m_max_vol_rescale(0.1), m_volume_move_probability(0.5), m_gibbs_other(0), m_n_trial(1),
+      m_local_trials(0)
     {
     m_fugacity.resize(m_pdata->getNTypes(), std::shared_ptr<Variant>(new VariantConstant(0.0)));
     m_type_map.resize(m_pdata->getNTypes());
@@ -863,6 +910,19 @@ template<class Shape> void UpdaterMuVT<Shape>::update(uint64_t timestep)
 
     m_exec_conf->msg->notice(10) << "UpdaterMuVT update: " << timestep << std::endl;
 
+    if (m_local_trials > 0)
+        {
+        updateLocal(timestep);
+
+#ifdef ENABLE_MPI
+        // the global trial below needs the ghost particles
+        if (m_sysdef->isDomainDecomposed())
+            {
+            m_mc->communicate(false);
+            }
+#endif
+        }
+
     // initialize random number generator
     unsigned int group = (m_exec_conf->getPartition() / m_npartition);
 
@@ -2289,6 +2349,451 @@ bool UpdaterMuVT<Shape>::tryInsertParticle(uint64_t timestep,
    counts are absolute, relative to the start of the run, or relative to the start of the last
    executed step.
 */
+/*! Every rank attempts m_local_trials insertions and removals in the active region of its domain,
+    the region in which IntegratorHPMCMono moves particles. Particles in the active regions of
+    different ranks are further apart than the nominal width and do not interact, so the trials on
+    different ranks are independent and need no communication. Each trial satisfies detailed
+    balance in the grand canonical ensemble of the active region: the acceptance criterion uses the
+    volume of the region and the number of particles of the given type in it.
+
+    The accepted changes are applied to the particle data at the end, with MPI in a single
+    collective call. Ghost particles are invalid afterwards.
+*/
+template<class Shape> void UpdaterMuVT<Shape>::updateLocal(uint64_t timestep)
+    {
+    if (m_gibbs)
+        {
+        throw std::runtime_error("local_trials is not supported in the Gibbs ensemble.");
+        }
+
+    for (unsigned int type_d = 0; type_d < m_pdata->getNTypes(); ++type_d)
+        {
+        if (m_mc->getDepletantFugacity(type_d) != Scalar(0.0))
+            {
+            throw std::runtime_error("local_trials is not supported with depletants.");
+            }
+        }
+
+    const unsigned int ndim = m_sysdef->getNDimensions();
+    const BoxDim box = m_pdata->getBox();
+    const uchar3 periodic = box.getPeriodic();
+
+    // the upper faces of a domain are inactive, see isActive()
+    Scalar3 ghost_fraction = make_scalar3(0, 0, 0);
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        Scalar3 npd = box.getNearestPlaneDistance();
+        ghost_fraction = m_mc->getNominalWidth() / npd;
+        }
+#endif
+
+    Scalar3 active_fraction;
+    active_fraction.x = periodic.x ? Scalar(1.0) : Scalar(1.0) - ghost_fraction.x;
+    active_fraction.y = periodic.y ? Scalar(1.0) : Scalar(1.0) - ghost_fraction.y;
+    active_fraction.z = periodic.z ? Scalar(1.0) : Scalar(1.0) - ghost_fraction.z;
+
+    Scalar V = box.getVolume(ndim == 2) * active_fraction.x * active_fraction.y;
+    bool have_region = active_fraction.x > Scalar(0.0) && active_fraction.y > Scalar(0.0);
+    if (ndim == 3)
+        {
+        V *= active_fraction.z;
+        have_region = have_region && active_fraction.z > Scalar(0.0);
+        }
+
+    hoomd::RandomGenerator rng(
+        hoomd::Seed(hoomd::RNGIdentifier::UpdaterMuVTLocal, timestep, this->m_sysdef->getSeed()),
+        hoomd::Counter(m_exec_conf->getPartition(), m_exec_conf->getRank()));
+
+    const unsigned int N = m_pdata->getN();
+    std::vector<bool> removed(N, false);
+    std::vector<hoomd::detail::pdata_element> inserted;
+
+    // indices of the particles in the active region by type
+    std::vector<std::vector<unsigned int>> region_map(m_pdata->getNTypes());
+
+        {
+        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::read);
+        for (unsigned int idx = 0; idx < N; ++idx)
+            {
+            Scalar4 postype = h_postype.data[idx];
+            if (isActive(make_scalar3(postype.x, postype.y, postype.z), box, ghost_fraction))
+                {
+                region_map[__scalar_as_int(postype.w)].push_back(idx);
+                }
+            }
+        }
+
+    auto& params = m_mc->getParams();
+
+    for (unsigned int i_trial = 0; have_region && i_trial < m_local_trials; ++i_trial)
+        {
+        // choose a random particle type out of those being inserted or removed
+        unsigned int type = m_transfer_types[hoomd::UniformIntDistribution(
+            (unsigned int)(m_transfer_types.size() - 1))(rng)];
+        bool insert = hoomd::UniformIntDistribution(1)(rng);
+
+        Scalar fugacity = (*m_fugacity[type])(timestep);
+        if (fugacity <= Scalar(0.0))
+            {
+            m_exec_conf->msg->error() << "Fugacity has to be greater than zero." << std::endl;
+            throw std::runtime_error("Error in UpdaterMuVT");
+            }
+
+        unsigned int nptl_type = (unsigned int)region_map[type].size();
+
+        if (insert)
+            {
+            // propose a random position uniformly in the active region
+            Scalar3 f;
+            f.x = hoomd::detail::generate_canonical<Scalar>(rng) * active_fraction.x;
+            f.y = hoomd::detail::generate_canonical<Scalar>(rng) * active_fraction.y;
+            if (ndim == 2)
+                {
+                f.z = Scalar(0.5);
+                }
+            else
+                {
+                f.z = hoomd::detail::generate_canonical<Scalar>(rng) * active_fraction.z;
+                }
+            vec3<Scalar> pos(box.makeCoordinates(f));
+
+            Shape shape(quat<Scalar>(), params[type]);
+            if (shape.hasOrientation())
+                {
+                shape.orientation = generateRandomOrientation(rng, ndim);
+                }
+
+            Scalar lnboltzmann = log(fugacity * V / (Scalar)(nptl_type + 1));
+            Scalar energy;
+            bool accept = computeLocalEnergy(type,
+                                             pos,
+                                             shape.orientation,
+                                             Scalar(1.0),
+                                             Scalar(0.0),
+                                             UINT_MAX,
+                                             removed,
+                                             inserted,
+                                             true,
+                                             energy)
+                          && hoomd::detail::generate_canonical<double>(rng)
+                                 < exp(lnboltzmann - energy);
+
+            if (accept)
+                {
+                hoomd::detail::pdata_element p = {};
+                p.pos = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(type));
+                p.vel = make_scalar4(0, 0, 0, 1.0);
+                p.diameter = Scalar(1.0);
+                p.body = NO_BODY;
+                p.orientation = quat_to_scalar4(shape.orientation);
+
+                region_map[type].push_back(N + (unsigned int)inserted.size());
+                inserted.push_back(p);
+                removed.push_back(false);
+                m_count_total.insert_accept_count++;
+                }
+            else
+                {
+                m_count_total.insert_reject_count++;
+                }
+            }
+        else
+            {
+            if (!nptl_type)
+                {
+                m_count_total.remove_reject_count++;
+                continue;
+                }
+
+            // choose a random particle of that type in the active region
+            unsigned int offset = hoomd::UniformIntDistribution(nptl_type - 1)(rng);
+            unsigned int idx = region_map[type][offset];
+
+            vec3<Scalar> pos;
+            quat<Scalar> orientation;
+            Scalar diameter, charge;
+            if (idx < N)
+                {
+                ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
+                                               access_location::host,
+                                               access_mode::read);
+                ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                                   access_location::host,
+                                                   access_mode::read);
+                ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                               access_location::host,
+                                               access_mode::read);
+                ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
+                                             access_location::host,
+                                             access_mode::read);
+                pos = vec3<Scalar>(h_postype.data[idx]);
+                orientation = quat<Scalar>(h_orientation.data[idx]);
+                diameter = h_diameter.data[idx];
+                charge = h_charge.data[idx];
+                }
+            else
+                {
+                const hoomd::detail::pdata_element& p = inserted[idx - N];
+                pos = vec3<Scalar>(p.pos);
+                orientation = quat<Scalar>(p.orientation);
+                diameter = p.diameter;
+                charge = p.charge;
+                }
+
+            Scalar lnboltzmann = log((Scalar)nptl_type / (fugacity * V));
+            Scalar energy;
+            computeLocalEnergy(type,
+                               pos,
+                               orientation,
+                               diameter,
+                               charge,
+                               idx,
+                               removed,
+                               inserted,
+                               false,
+                               energy);
+
+            if (hoomd::detail::generate_canonical<double>(rng) < exp(lnboltzmann + energy))
+                {
+                removed[idx] = true;
+                region_map[type][offset] = region_map[type].back();
+                region_map[type].pop_back();
+                m_count_total.remove_accept_count++;
+                }
+            else
+                {
+                m_count_total.remove_reject_count++;
+                }
+            }
+        }
+
+    // apply the accepted trials
+    std::vector<unsigned int> remove_tags;
+        {
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+        for (unsigned int idx = 0; idx < N; ++idx)
+            {
+            if (removed[idx])
+                {
+                remove_tags.push_back(h_tag.data[idx]);
+                }
+            }
+        }
+
+    std::vector<hoomd::detail::pdata_element> add;
+    for (unsigned int k = 0; k < inserted.size(); ++k)
+        {
+        if (!removed[N + k])
+            {
+            add.push_back(inserted[k]);
+            }
+        }
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        m_pdata->removeAndAddParticles(remove_tags, add);
+        return;
+        }
+#endif
+
+    for (unsigned int tag : remove_tags)
+        {
+        m_pdata->removeParticle(tag);
+        }
+
+    for (const auto& p : add)
+        {
+        unsigned int tag = m_pdata->addParticle(__scalar_as_int(p.pos.w));
+
+        // setPosition() takes into account the grid shift, so subtract that one
+        Scalar3 pos = make_scalar3(p.pos.x, p.pos.y, p.pos.z) - m_pdata->getOrigin();
+        int3 tmp = make_int3(0, 0, 0);
+        m_pdata->getGlobalBox().wrap(pos, tmp);
+        m_pdata->setPosition(tag, pos);
+        m_pdata->setOrientation(tag, p.orientation);
+        }
+    }
+
+template<class Shape>
+bool UpdaterMuVT<Shape>::computeLocalEnergy(
+    unsigned int type,
+    const vec3<Scalar>& pos,
+    const quat<Scalar>& orientation,
+    Scalar diameter,
+    Scalar charge,
+    unsigned int skip_idx,
+    const std::vector<bool>& removed,
+    const std::vector<hoomd::detail::pdata_element>& inserted,
+    bool check_overlaps,
+    Scalar& energy)
+    {
+    energy = Scalar(0.0);
+
+    auto field = m_mc->getExternalField();
+    if (field)
+        {
+        energy += field->energy(m_pdata->getGlobalBox(),
+                                type,
+                                pos,
+                                quat<float>(orientation),
+                                float(diameter),
+                                float(charge));
+        }
+
+    auto& image_list = m_mc->updateImageList();
+    const unsigned int n_images = (unsigned int)image_list.size();
+    auto& params = m_mc->getParams();
+    const Index2D& overlap_idx = m_mc->getOverlapIndexer();
+    const bool pair = m_mc->hasPairInteractions();
+
+    ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(),
+                                         access_location::host,
+                                         access_mode::read);
+
+    Shape shape(orientation, params[type]);
+    unsigned int err_count = 0;
+
+    // add the interaction with particle j at r_ij, returns true on overlap
+    auto interact = [&](const vec3<Scalar>& r_ij,
+                        unsigned int type_j,
+                        const quat<Scalar>& orientation_j,
+                        Scalar diameter_j,
+                        Scalar charge_j)
+    {
+        if (check_overlaps)
+            {
+            Shape shape_j(orientation_j, params[type_j]);
+            if (h_overlaps.data[overlap_idx(type, type_j)]
+                && check_circumsphere_overlap(r_ij, shape, shape_j)
+                && test_overlap(r_ij, shape, shape_j, err_count))
+                {
+                return true;
+                }
+            }
+
+        if (pair)
+            {
+            energy += m_mc->computeOnePairEnergy(dot(r_ij, r_ij),
+                                                 r_ij,
+                                                 type,
+                                                 orientation,
+                                                 diameter,
+                                                 charge,
+                                                 type_j,
+                                                 orientation_j,
+                                                 diameter_j,
+                                                 charge_j);
+            }
+        return false;
+    };
+
+    LongReal r_cut_patch(0.0);
+    if (pair)
+        {
+        r_cut_patch = m_mc->getMaxPairEnergyRCutNonAdditive()
+                      + LongReal(0.5) * m_mc->getMaxPairInteractionAdditiveRCut(type);
+        }
+    LongReal R_query = std::max(shape.getCircumsphereDiameter() / LongReal(2.0),
+                                r_cut_patch - m_mc->getMinCoreDiameter() / LongReal(2.0));
+    hoomd::detail::AABB aabb_local = hoomd::detail::AABB(vec3<Scalar>(0, 0, 0), R_query);
+
+    const unsigned int N = m_pdata->getN();
+
+    // we cannot rely on a valid AABB tree when there are 0 particles
+    const bool use_tree = N + m_pdata->getNGhosts() > 0;
+    const hoomd::detail::AABBTree* aabb_tree = use_tree ? &m_mc->buildAABBTree() : nullptr;
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+
+    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+        {
+        vec3<Scalar> pos_image = pos + image_list[cur_image];
+
+        // self-interaction with the periodic images
+        if (cur_image != 0 && interact(pos - pos_image, type, orientation, diameter, charge))
+            {
+            return false;
+            }
+
+        // the inserted particles are not in the AABB tree
+        for (unsigned int k = 0; k < inserted.size(); ++k)
+            {
+            if (N + k == skip_idx || removed[N + k])
+                continue;
+
+            const hoomd::detail::pdata_element& p = inserted[k];
+            if (interact(vec3<Scalar>(p.pos) - pos_image,
+                         __scalar_as_int(p.pos.w),
+                         quat<Scalar>(p.orientation),
+                         p.diameter,
+                         p.charge))
+                {
+                return false;
+                }
+            }
+
+        if (!use_tree)
+            continue;
+
+        hoomd::detail::AABB aabb = aabb_local;
+        aabb.translate(pos_image);
+
+        // stackless search
+        for (unsigned int cur_node_idx = 0; cur_node_idx < aabb_tree->getNumNodes();
+             cur_node_idx++)
+            {
+            if (aabb.overlaps(aabb_tree->getNodeAABB(cur_node_idx)))
+                {
+                if (aabb_tree->isNodeLeaf(cur_node_idx))
+                    {
+                    for (unsigned int cur_p = 0;
+                         cur_p < aabb_tree->getNodeNumParticles(cur_node_idx);
+                         cur_p++)
+                        {
+                        unsigned int j = aabb_tree->getNodeParticle(cur_node_idx, cur_p);
+
+                        // ghost particles are never removed
+                        if (j < N && (j == skip_idx || removed[j]))
+                            continue;
+
+                        Scalar4 postype_j = h_postype.data[j];
+                        if (interact(vec3<Scalar>(postype_j) - pos_image,
+                                     __scalar_as_int(postype_j.w),
+                                     quat<Scalar>(h_orientation.data[j]),
+                                     h_diameter.data[j],
+                                     h_charge.data[j]))
+                            {
+                            return false;
+                            }
+                        }
+                    }
+                }
+            else
+                {
+                // skip ahead
+                cur_node_idx += aabb_tree->getNodeSkip(cur_node_idx);
+                }
+            } // end loop over AABB nodes
+        }     // end loop over images
+
+    return true;
+    }
+
 template<class Shape> hpmc_muvt_counters_t UpdaterMuVT<Shape>::getCounters(unsigned int mode)
     {
     hpmc_muvt_counters_t result;
@@ -3113,6 +3618,9 @@ template<class Shape> void export_UpdaterMuVT(pybind11::module& m, const std::st
                       &UpdaterMuVT<Shape>::getTransferTypes,
                       &UpdaterMuVT<Shape>::setTransferTypes)
         .def_property("ntrial", &UpdaterMuVT<Shape>::getNTrial, &UpdaterMuVT<Shape>::setNTrial)
+        .def_property("local_trials",
+                      &UpdaterMuVT<Shape>::getLocalTrials,
+                      &UpdaterMuVT<Shape>::setLocalTrials)
         .def_property_readonly("N", &UpdaterMuVT<Shape>::getN)
         .def("getCounters", &UpdaterMuVT<Shape>::getCounters);
     }
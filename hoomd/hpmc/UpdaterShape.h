@@ -318,8 +318,8 @@ template<class Shape> void UpdaterShape<Shape>::update(uint64_t timestep)
             // actually update the shape parameter in the integrator
             m_mc->setParam(typ_i, shape_param_new);
 
-            // check if at least one overlap was caused
-            bool overlaps = static_cast<bool>(m_mc->countOverlaps(true));
+            // check if at least one overlap was caused, only particles of typ_i changed
+            bool overlaps = m_mc->checkTypeOverlaps(typ_i);
             // automatically reject if there are overlaps
             if (overlaps)
                 {
@@ -24,6 +24,12 @@ See Also:
     describes the theory and implementation.
 """
 
+from hoomd.hpmc import _hpmc
+from hoomd.hpmc import _shape_modules
+
+# load the per-shape extension modules when they are first used
+_shape_modules.install(_hpmc)
+
 # need to import all submodules defined in this directory
 from hoomd.hpmc import integrate
 from hoomd.hpmc import update
@@ -33,3 +39,4 @@ from hoomd.hpmc import pair
 from hoomd.hpmc import external
 from hoomd.hpmc import nec
 from hoomd.hpmc import shape_move
+from hoomd.hpmc import overlap
@@ -0,0 +1,81 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+"""Load the per-shape HPMC extension modules on first use.
+
+`hoomd.hpmc._hpmc` exports the shape independent classes. The classes
+templated on each shape are in separate extension modules
+``hoomd.hpmc._hpmc_<shape>`` so that ``import hoomd.hpmc`` does not load the
+code for every shape.
+
+`install` adds a module ``__getattr__`` to `hoomd.hpmc._hpmc`. When python
+looks up a name that `hoomd.hpmc._hpmc` does not have, ``__getattr__`` imports
+the shape module that exports the name and adds all of the shape module's
+classes to `hoomd.hpmc._hpmc`. Code that accesses ``_hpmc.<ClassName>``
+continues to work unchanged.
+"""
+
+import importlib
+
+# The shape module that exports the classes whose names end with each suffix.
+_shape_modules = {
+    'Sphere': 'sphere',
+    'ConvexPolygon': 'convex_polygon',
+    'SimplePolygon': 'simple_polygon',
+    'Spheropolygon': 'spheropolygon',
+    'ConvexSpheropolygon': 'spheropolygon',
+    'Polyhedron': 'polyhedron',
+    'Ellipsoid': 'ellipsoid',
+    'FacetedEllipsoid': 'faceted_ellipsoid',
+    'Sphinx': 'sphinx',
+    'ConvexPolyhedronUnion': 'union_convex_polyhedron',
+    'ConvexSpheropolyhedronUnion': 'union_convex_polyhedron',
+    'FacetedEllipsoidUnion': 'union_faceted_ellipsoid',
+    'SphereUnion': 'union_sphere',
+    'ConvexPolyhedron': 'convex_polyhedron',
+    'Spheropolyhedron': 'convex_spheropolyhedron',
+    'ConvexSpheropolyhedron': 'convex_spheropolyhedron',
+}
+
+
+def _find_shape_module(name):
+    """Get the shape module that exports the class ``name``."""
+    if name.endswith('GPU'):
+        name = name[:-len('GPU')]
+
+    suffixes = [suffix for suffix in _shape_modules if name.endswith(suffix)]
+    if len(suffixes) == 0:
+        return None
+
+    return _shape_modules[max(suffixes, key=len)]
+
+
+def install(module):
+    """Load the shape modules when python accesses their classes in module."""
+
+    def __getattr__(name):
+        shape_module = None
+        if not name.startswith('_'):
+            shape_module = _find_shape_module(name)
+
+        if shape_module is not None:
+            package = module.__name__.rpartition('.')[0]
+            try:
+                extension = importlib.import_module(package + '._hpmc_'
+                                                    + shape_module)
+            except ModuleNotFoundError as error:
+                raise AttributeError(
+                    f"module {module.__name__!r} has no attribute {name!r}: "
+                    f"the shape module {shape_module!r} is not built, see "
+                    f"HPMC_SHAPES in BUILDING.rst") from error
+            for key, value in vars(extension).items():
+                if not key.startswith('_'):
+                    setattr(module, key, value)
+
+            if name in vars(module):
+                return vars(module)[name]
+
+        raise AttributeError(
+            f"module {module.__name__!r} has no attribute {name!r}")
+
+    module.__getattr__ = __getattr__
@@ -0,0 +1,63 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/hpmc/IntegratorHPMCMono.h"
+#include "hoomd/hpmc/ShapeConvexPolyhedron.h"
+
+#ifdef ENABLE_HIP
+#include "hoomd/CellListGPU.h"
+#include "hoomd/hpmc/IntegratorHPMCMonoGPU.h"
+#endif
+
+#include "hoomd/benchmark/Benchmark.h"
+
+using namespace hoomd;
+using namespace hoomd::hpmc;
+using namespace hoomd::benchmark;
+
+//! Benchmark the HPMC integrators
+void benchmark_hpmc(BenchmarkSuite& suite)
+    {
+    auto exec_conf = suite.getExecConf();
+    const unsigned int N = suite.scaleN(32000);
+
+    if (suite.isSelected("IntegratorHPMCMono<ShapeConvexPolyhedron>/cubes"))
+        {
+        // unit cubes at a packing fraction of 0.45, the lattice spacing leaves room for the random
+        // displacements of the generator
+        auto sysdef = makeLJLiquid(N, Scalar(0.45), exec_conf);
+
+        std::shared_ptr<IntegratorHPMCMono<ShapeConvexPolyhedron>> mc;
+#ifdef ENABLE_HIP
+        if (exec_conf->isCUDAEnabled())
+            {
+            auto cl = std::make_shared<CellListGPU>(sysdef);
+            mc = std::make_shared<IntegratorHPMCMonoGPU<ShapeConvexPolyhedron>>(sysdef, cl);
+            }
+        else
+#endif
+            mc = std::make_shared<IntegratorHPMCMono<ShapeConvexPolyhedron>>(sysdef);
+
+        std::vector<vec3<ShortReal>> vertices;
+        for (int i = 0; i < 8; i++)
+            {
+            vertices.push_back(vec3<ShortReal>(ShortReal((i & 1) ? 0.5 : -0.5),
+                                               ShortReal((i & 2) ? 0.5 : -0.5),
+                                               ShortReal((i & 4) ? 0.5 : -0.5)));
+            }
+        mc->setParam(0, ShapeConvexPolyhedron::param_type(vertices, ShortReal(0.0), 0));
+        mc->setD("A", Scalar(0.1));
+        mc->setA("A", Scalar(0.1));
+        mc->prepRun(0);
+
+        // each call performs one sweep of trial moves
+        suite.run("IntegratorHPMCMono<ShapeConvexPolyhedron>/cubes",
+                  N,
+                  [&](uint64_t timestep) { mc->update(timestep); });
+        }
+    }
+
+HOOMD_BENCHMARK_MAIN("hpmc", benchmark_hpmc)
@@ -28,6 +28,12 @@ class FreeVolume(Compute):
     Args:
         test_particle_type (str): Test particle type.
         num_samples (int): Number of samples to evaluate.
+        sequence (str): How to place the test particles, ``'random'`` or
+            ``'halton'``.
+        target_error (float): Target relative standard error of the free
+            volume.
+        max_num_samples (int): Maximum total number of samples when
+            ``target_error`` is positive.
 
     `FreeVolume` computes the free volume in the simulation state available to a
     given test particle shape using Monte Carlo integration. Use it in
@@ -71,6 +77,24 @@ class FreeVolume(Compute):
     where :math:`V_\mathrm{box}` is the volume of the simulation box (or area in
     2D).
 
+    .. rubric:: Sampling
+
+    When `sequence` is ``'halton'``, `FreeVolume` places the test particles at
+    the points of a randomly shifted Halton sequence instead of independent
+    uniform random positions. The points cover the box more evenly, so the
+    estimate converges faster with `num_samples`. The orientations remain
+    uniformly random.
+
+    When `target_error` is positive, `FreeVolume` evaluates batches of
+    `num_samples` samples until the relative standard error of the free volume
+    is at most `target_error` or the next batch would exceed
+    `max_num_samples` samples in total. The error estimate
+    (`relative_error`) assumes independent samples, so it overestimates the
+    error with ``'halton'`` positions.
+
+    On CPU devices, `FreeVolume` evaluates the samples in parallel when
+    HOOMD-blue is built with TBB.
+
     Note:
 
         `FreeVolume` respects the HPMC integrator's ``interaction_matrix``.
@@ -98,14 +122,36 @@ class FreeVolume(Compute):
 
         num_samples (int): Number of samples to evaluate.
 
+        sequence (str): How to place the test particles, ``'random'`` or
+            ``'halton'``.
+
+        target_error (float): Target relative standard error of the free
+            volume. Set to 0 to evaluate `num_samples` samples.
+
+        max_num_samples (int): Maximum total number of samples when
+            `target_error` is positive.
+
     """
 
-    def __init__(self, test_particle_type, num_samples):
+    def __init__(self,
+                 test_particle_type,
+                 num_samples,
+                 sequence='random',
+                 target_error=0.0,
+                 max_num_samples=10000000):
         # store metadata
-        param_dict = ParameterDict(test_particle_type=str, num_samples=int)
+        param_dict = ParameterDict(
+            test_particle_type=str,
+            num_samples=int,
+            sequence=hoomd.data.typeconverter.OnlyFrom(['random', 'halton']),
+            target_error=float,
+            max_num_samples=int)
         param_dict.update(
             dict(test_particle_type=test_particle_type,
-                 num_samples=num_samples))
+                 num_samples=num_samples,
+                 sequence=sequence,
+                 target_error=target_error,
+                 max_num_samples=max_num_samples))
         self._param_dict.update(param_dict)
 
     def _attach_hook(self):
@@ -136,6 +182,18 @@ class FreeVolume(Compute):
         self._cpp_obj.compute(self._simulation.timestep)
         return self._cpp_obj.free_volume
 
+    @log(requires_run=True)
+    def relative_error(self):
+        """float: Estimated relative standard error of `free_volume`."""
+        self._cpp_obj.compute(self._simulation.timestep)
+        return self._cpp_obj.relative_error
+
+    @log(requires_run=True)
+    def num_samples_taken(self):
+        """int: Total number of samples evaluated for `free_volume`."""
+        self._cpp_obj.compute(self._simulation.timestep)
+        return self._cpp_obj.num_samples_taken
+
 
 class SDF(Compute):
     r"""Compute the scale distribution function via volume perturbations.
@@ -313,8 +313,9 @@ class HPMCIntegrator(Integrator):
 
     .. rubric:: Threading
 
-    HPMC integrators use threaded execution on multiple CPU cores only when
-    placing implicit depletants (``depletant_fugacity != 0``).
+    HPMC integrators use threaded execution on multiple CPU cores when
+    placing implicit depletants (``depletant_fugacity != 0``) and when
+    `checkerboard` is `True`.
 
     .. deprecated:: 4.4.0
 
@@ -363,6 +364,76 @@ class HPMCIntegrator(Integrator):
         nselect (int): Number of trial moves to perform per particle per
             timestep.
 
+        checkerboard (bool): When `True`, perform the trial moves on the CPU
+            in parallel on a checkerboard of cells as on the GPU. Each sweep
+            places a randomly shifted grid of cells at least as wide as the
+            interaction range and moves the particles in every other cell
+            (in each direction) at the same time. Trial moves that leave the
+            cell are rejected. HPMC uses the serial sweeps when the box is
+            smaller than two cells in any direction, with depletants, and
+            with MPI domain decomposition or `trials_per_move` > 1. Has no
+            effect on the GPU (**default:** `False`).
+
+        trials_per_move (int): Number of trial configurations of each
+            particle move. When greater than 1, each move generates this many
+            trial configurations from the current one, selects one of them
+            with probability proportional to its Boltzmann factor, and accepts
+            it with the multiple-trial Monte Carlo criterion, which satisfies
+            detailed balance. The neighbors are found once for all trials.
+            Multiple trials raise the acceptance ratio with strongly
+            attractive `pair_potentials` and improve the sampling per unit of
+            compute time when the energy evaluation is cheaper than the
+            neighbor search. Has no effect with depletants and on the GPU
+            (**default:** 1).
+
+        depletant_sampling_tables (bool): When `True`, cache for each pair of
+            particle and depletant types the smaller of two regions that
+            contain all depletants overlapping the particle: the particle's
+            extended oriented bounding box and the sphere of the summed
+            circumsphere radii. The depletants are sampled in the cached
+            region, so fewer of them miss the particle at high fugacity. The
+            results are statistically equivalent. Has no effect in 2D and on
+            the GPU (**default:** `False`).
+
+        aabb_tree_refit_tolerance (float): When positive, refit the existing
+            AABB tree to the new particle positions after box moves, cluster
+            moves, and trial moves instead of building a new tree. HPMC builds
+            a new tree when the total surface area of the refit tree nodes,
+            relative to the root node, grows by more than this fraction over
+            that of the last build. Particle sorts and MPI communication
+            always trigger a new build (**default:** 0).
+
+        detailed_counters (bool): When `True`, record where the overlap
+            search spends its time: the AABB tree nodes visited, the
+            candidates rejected by the circumsphere test, the calls to the
+            exact overlap test by particle type, and the time per overlap
+            check. Read them from `sweep_counters` and the associated
+            loggable quantities. Only the serial CPU sweep records the
+            counters, they remain 0 with ``checkerboard``, ``trials_per_move``
+            > 1, and on the GPU (**default:** `False`).
+
+        move_size_target (float): When positive, adapt ``d`` and ``a`` at the
+            start of every timestep so that the acceptance ratios of the
+            translation and rotation moves approach this target. The
+            adaptation follows a Robbins-Monro rule with a step size that
+            decays as the number of steps grows. All types share the
+            acceptance ratio and scale their move sizes by the same factor.
+            Set to 0 to disable the adaptation (**default:** 0).
+
+        move_size_gain (float): Gain of the move size adaptation
+            (**default:** 1).
+
+        max_translation_move (float): Largest ``d`` that the move size
+            adaptation sets :math:`[\\mathrm{length}]` (**default:**
+            ``inf``).
+
+        max_rotation_move (float): Largest ``a`` that the move size
+            adaptation sets (**default:** ``inf``).
+
+    Note:
+        The move size adaptation breaks detailed balance. Use it to
+        equilibrate and set `move_size_target` to 0 before sampling.
+
     .. rubric:: Attributes
     """
     _ext_module = _hpmc
@@ -370,6 +441,8 @@ class HPMCIntegrator(Integrator):
     _skip_for_equality = Integrator._skip_for_equality | {'_cpp_cell'}
     _cpp_cls = None
 
+    _checkpoint_params = ('d', 'a')
+
     def __init__(self, default_d, default_a, translation_move_probability,
                  nselect):
         super().__init__()
@@ -377,7 +450,16 @@ class HPMCIntegrator(Integrator):
         # Set base parameter dict for hpmc integrators
         param_dict = ParameterDict(
             translation_move_probability=float(translation_move_probability),
-            nselect=int(nselect))
+            nselect=int(nselect),
+            checkerboard=False,
+            trials_per_move=1,
+            depletant_sampling_tables=False,
+            aabb_tree_refit_tolerance=0.0,
+            detailed_counters=False,
+            move_size_target=0.0,
+            move_size_gain=1.0,
+            max_translation_move=float('inf'),
+            max_rotation_move=float('inf'))
         self._param_dict.update(param_dict)
         self._pair_potential = None
         self._external_potential = None
@@ -416,6 +498,15 @@ class HPMCIntegrator(Integrator):
             hoomd.hpmc.pair.Pair,
             hoomd.data.syncedlist._PartialGetAttr('_cpp_obj'))
 
+    def _get_checkpoint_state(self):
+        state = super()._get_checkpoint_state()
+        state['counters'] = self._cpp_obj.getLocalCounters()
+        return state
+
+    def _set_checkpoint_state(self, state):
+        super()._set_checkpoint_state(state)
+        self._cpp_obj.setLocalCounters(state['counters'])
+
     def _attach_hook(self):
         """Initialize the reflected c++ class.
 
@@ -437,8 +528,9 @@ class HPMCIntegrator(Integrator):
         self._simulation._warn_if_seed_unset()
         sys_def = self._simulation.state._cpp_sys_def
         if (isinstance(self._simulation.device, hoomd.device.GPU)
-                and (self._cpp_cls + 'GPU') in _hpmc.__dict__):
-            self._cpp_cell = _hoomd.CellListGPU(sys_def)
+                and hasattr(_hpmc, self._cpp_cls + 'GPU')):
+            self._cpp_cell = self._simulation.state._get_cell_list(
+                'hpmc', _hoomd.CellListGPU)
             self._cpp_obj = getattr(self._ext_module,
                                     self._cpp_cls + 'GPU')(sys_def,
                                                            self._cpp_cell)
@@ -468,6 +560,9 @@ class HPMCIntegrator(Integrator):
         if self._pair_potential is not None:
             self._pair_potential._detach()
         self._pair_potentials._unsync()
+        if self._cpp_cell is not None:
+            self._simulation.state._release_cell_list('hpmc')
+            self._cpp_cell = None
 
     # TODO need to validate somewhere that quaternions are normalized
 
@@ -573,6 +668,75 @@ class HPMCIntegrator(Integrator):
         else:
             raise DataAccessError("counters")
 
+    @property
+    def sweep_counters(self):
+        """dict: Detailed counters of the overlap search.
+
+        The counter object has the following attributes:
+
+        * ``aabb_node_visits``: `int` - Number of AABB tree nodes tested
+          against the search volume of the moved particles.
+        * ``circumsphere_rejections``: `int` - Number of candidates rejected
+          by the circumsphere test, including the pairs of types that do not
+          interact.
+        * ``narrow_phase_checks``: `int` - Number of exact overlap tests.
+        * ``search_time``: `int` - Time spent in the overlap search
+          :math:`[\\mathrm{ns}]`.
+
+        Note:
+            The counts are reset to 0 at the start of each
+            `hoomd.Simulation.run` and remain 0 unless `detailed_counters` is
+            `True`.
+        """
+        if self._attached:
+            return self._cpp_obj.getSweepCounters()
+        else:
+            raise DataAccessError("sweep_counters")
+
+    @log(requires_run=True)
+    def aabb_node_visits(self):
+        """int: Number of AABB tree nodes visited in the overlap search.
+
+        Note:
+            The count is reset at the start of each `hoomd.Simulation.run`.
+        """
+        return self._cpp_obj.getSweepCounters().aabb_node_visits
+
+    @log(requires_run=True)
+    def circumsphere_rejections(self):
+        """int: Number of candidates rejected by the circumsphere test.
+
+        Note:
+            The count is reset at the start of each `hoomd.Simulation.run`.
+        """
+        return self._cpp_obj.getSweepCounters().circumsphere_rejections
+
+    @log(category='sequence', requires_run=True)
+    def narrow_phase_checks(self):
+        """list[int]: Number of exact overlap tests by the type of the moved \
+        particle.
+
+        Note:
+            The counts are reset at the start of each `hoomd.Simulation.run`.
+        """
+        return self._cpp_obj.getNarrowPhaseChecksByType()
+
+    @log(requires_run=True)
+    def overlap_check_time(self):
+        """float: Mean time of the overlap search per overlap check \
+        :math:`[\\mathrm{s}]`.
+
+        The time includes the AABB tree traversal. It is 0 when there are no
+        overlap checks.
+
+        Note:
+            The time is reset at the start of each `hoomd.Simulation.run`.
+        """
+        checks = self._cpp_obj.getCounters(1).overlap_checks
+        if checks == 0:
+            return 0.0
+        return self._cpp_obj.getSweepCounters().search_time * 1e-9 / checks
+
     @property
     def pair_potential(self):
         r"""The user-defined pair potential.
@@ -8,6 +8,7 @@
 
 #include "ComputeSDF.h"
 #include "ShapeConvexPolygon.h"
+#include "ShapeOverlaps.h"
 #include "ShapeUnion.h"
 
 #include "ExternalField.h"
@@ -34,6 +35,7 @@ void export_convex_polygon(pybind11::module& m)
     {
     export_IntegratorHPMCMono<ShapeConvexPolygon>(m, "IntegratorHPMCMonoConvexPolygon");
     export_ComputeFreeVolume<ShapeConvexPolygon>(m, "ComputeFreeVolumeConvexPolygon");
+    export_ShapeOverlaps<ShapeConvexPolygon>(m, "ShapeOverlapsConvexPolygon");
     export_ComputeSDF<ShapeConvexPolygon>(m, "ComputeSDFConvexPolygon");
     export_UpdaterMuVT<ShapeConvexPolygon>(m, "UpdaterMuVTConvexPolygon");
     export_UpdaterClusters<ShapeConvexPolygon>(m, "UpdaterClustersConvexPolygon");
@@ -52,3 +54,12 @@ void export_convex_polygon(pybind11::module& m)
     } // namespace detail
     } // namespace hpmc
     } // namespace hoomd
+
+//! Define the _hpmc_convex_polygon python module exports
+PYBIND11_MODULE(_hpmc_convex_polygon, m)
+    {
+    // the exported classes derive from classes in _hpmc
+    pybind11::module::import("hoomd.hpmc._hpmc");
+
+    hoomd::hpmc::detail::export_convex_polygon(m);
+    }
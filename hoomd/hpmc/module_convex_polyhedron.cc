@@ -9,6 +9,7 @@
 
 #include "ComputeSDF.h"
 #include "ShapeConvexPolyhedron.h"
+#include "ShapeOverlaps.h"
 #include "ShapeUnion.h"
 
 #include "ExternalField.h"
@@ -40,6 +41,7 @@ void export_convex_polyhedron(pybind11::module& m)
     export_IntegratorHPMCMono<ShapeConvexPolyhedron>(m, "IntegratorHPMCMonoConvexPolyhedron");
     export_IntegratorHPMCMonoNEC<ShapeConvexPolyhedron>(m, "IntegratorHPMCMonoNECConvexPolyhedron");
     export_ComputeFreeVolume<ShapeConvexPolyhedron>(m, "ComputeFreeVolumeConvexPolyhedron");
+    export_ShapeOverlaps<ShapeConvexPolyhedron>(m, "ShapeOverlapsConvexPolyhedron");
     export_ComputeSDF<ShapeConvexPolyhedron>(m, "ComputeSDFConvexPolyhedron");
     export_UpdaterMuVT<ShapeConvexPolyhedron>(m, "UpdaterMuVTConvexPolyhedron");
     export_UpdaterClusters<ShapeConvexPolyhedron>(m, "UpdaterClustersConvexPolyhedron");
@@ -69,3 +71,12 @@ void export_convex_polyhedron(pybind11::module& m)
     } // namespace detail
     } // namespace hpmc
     } // namespace hoomd
+
+//! Define the _hpmc_convex_polyhedron python module exports
+PYBIND11_MODULE(_hpmc_convex_polyhedron, m)
+    {
+    // the exported classes derive from classes in _hpmc
+    pybind11::module::import("hoomd.hpmc._hpmc");
+
+    hoomd::hpmc::detail::export_convex_polyhedron(m);
+    }
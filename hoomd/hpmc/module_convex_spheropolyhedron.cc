@@ -7,6 +7,7 @@
 #include "IntegratorHPMCMono.h"
 
 #include "ComputeSDF.h"
+#include "ShapeOverlaps.h"
 #include "ShapeSpheropolyhedron.h"
 #include "ShapeUnion.h"
 
@@ -37,6 +38,7 @@ void export_convex_spheropolyhedron(pybind11::module& m)
     {
     export_IntegratorHPMCMono<ShapeSpheropolyhedron>(m, "IntegratorHPMCMonoSpheropolyhedron");
     export_ComputeFreeVolume<ShapeSpheropolyhedron>(m, "ComputeFreeVolumeSpheropolyhedron");
+    export_ShapeOverlaps<ShapeSpheropolyhedron>(m, "ShapeOverlapsSpheropolyhedron");
     export_ComputeSDF<ShapeSpheropolyhedron>(m, "ComputeSDFConvexSpheropolyhedron");
     export_UpdaterMuVT<ShapeSpheropolyhedron>(m, "UpdaterMuVTConvexSpheropolyhedron");
     export_UpdaterClusters<ShapeSpheropolyhedron>(m, "UpdaterClustersConvexSpheropolyhedron");
@@ -62,3 +64,12 @@ void export_convex_spheropolyhedron(pybind11::module& m)
     } // namespace detail
     } // namespace hpmc
     } // namespace hoomd
+
+//! Define the _hpmc_convex_spheropolyhedron python module exports
+PYBIND11_MODULE(_hpmc_convex_spheropolyhedron, m)
+    {
+    // the exported classes derive from classes in _hpmc
+    pybind11::module::import("hoomd.hpmc._hpmc");
+
+    hoomd::hpmc::detail::export_convex_spheropolyhedron(m);
+    }
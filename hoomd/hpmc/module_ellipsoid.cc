@@ -8,6 +8,7 @@
 
 #include "ComputeSDF.h"
 #include "ShapeEllipsoid.h"
+#include "ShapeOverlaps.h"
 #include "ShapeUnion.h"
 
 #include "ExternalField.h"
@@ -37,6 +38,7 @@ void export_ellipsoid(pybind11::module& m)
     {
     export_IntegratorHPMCMono<ShapeEllipsoid>(m, "IntegratorHPMCMonoEllipsoid");
     export_ComputeFreeVolume<ShapeEllipsoid>(m, "ComputeFreeVolumeEllipsoid");
+    export_ShapeOverlaps<ShapeEllipsoid>(m, "ShapeOverlapsEllipsoid");
     export_ComputeSDF<ShapeEllipsoid>(m, "ComputeSDFEllipsoid");
     export_UpdaterMuVT<ShapeEllipsoid>(m, "UpdaterMuVTEllipsoid");
     export_UpdaterClusters<ShapeEllipsoid>(m, "UpdaterClustersEllipsoid");
@@ -62,3 +64,12 @@ void export_ellipsoid(pybind11::module& m)
     } // namespace detail
     } // namespace hpmc
     } // namespace hoomd
+
+//! Define the _hpmc_ellipsoid python module exports
+PYBIND11_MODULE(_hpmc_ellipsoid, m)
+    {
+    // the exported classes derive from classes in _hpmc
+    pybind11::module::import("hoomd.hpmc._hpmc");
+
+    hoomd::hpmc::detail::export_ellipsoid(m);
+    }
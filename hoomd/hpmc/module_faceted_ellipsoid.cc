@@ -13,6 +13,7 @@
 #include "ExternalFieldHarmonic.h"
 #include "ExternalFieldWall.h"
 
+#include "ShapeOverlaps.h"
 #include "UpdaterClusters.h"
 #include "UpdaterMuVT.h"
 
@@ -33,6 +34,7 @@ void export_faceted_ellipsoid(pybind11::module& m)
     {
     export_IntegratorHPMCMono<ShapeFacetedEllipsoid>(m, "IntegratorHPMCMonoFacetedEllipsoid");
     export_ComputeFreeVolume<ShapeFacetedEllipsoid>(m, "ComputeFreeVolumeFacetedEllipsoid");
+    export_ShapeOverlaps<ShapeFacetedEllipsoid>(m, "ShapeOverlapsFacetedEllipsoid");
     export_ComputeSDF<ShapeFacetedEllipsoid>(m, "ComputeSDFFacetedEllipsoid");
     export_UpdaterMuVT<ShapeFacetedEllipsoid>(m, "UpdaterMuVTFacetedEllipsoid");
     export_UpdaterClusters<ShapeFacetedEllipsoid>(m, "UpdaterClustersFacetedEllipsoid");
@@ -51,3 +53,12 @@ void export_faceted_ellipsoid(pybind11::module& m)
     } // namespace detail
     } // namespace hpmc
     } // namespace hoomd
+
+//! Define the _hpmc_faceted_ellipsoid python module exports
+PYBIND11_MODULE(_hpmc_faceted_ellipsoid, m)
+    {
+    // the exported classes derive from classes in _hpmc
+    pybind11::module::import("hoomd.hpmc._hpmc");
+
+    hoomd::hpmc::detail::export_faceted_ellipsoid(m);
+    }
@@ -7,6 +7,7 @@
 #include "IntegratorHPMCMono.h"
 
 #include "ComputeSDF.h"
+#include "ShapeOverlaps.h"
 #include "ShapePolyhedron.h"
 #include "ShapeUnion.h"
 
@@ -34,6 +35,7 @@ void export_polyhedron(pybind11::module& m)
     {
     export_IntegratorHPMCMono<ShapePolyhedron>(m, "IntegratorHPMCMonoPolyhedron");
     export_ComputeFreeVolume<ShapePolyhedron>(m, "ComputeFreeVolumePolyhedron");
+    export_ShapeOverlaps<ShapePolyhedron>(m, "ShapeOverlapsPolyhedron");
     export_ComputeSDF<ShapePolyhedron>(m, "ComputeSDFPolyhedron");
     export_UpdaterMuVT<ShapePolyhedron>(m, "UpdaterMuVTPolyhedron");
     export_UpdaterClusters<ShapePolyhedron>(m, "UpdaterClustersPolyhedron");
@@ -52,3 +54,12 @@ void export_polyhedron(pybind11::module& m)
     } // namespace detail
     } // namespace hpmc
     } // namespace hoomd
+
+//! Define the _hpmc_polyhedron python module exports
+PYBIND11_MODULE(_hpmc_polyhedron, m)
+    {
+    // the exported classes derive from classes in _hpmc
+    pybind11::module::import("hoomd.hpmc._hpmc");
+
+    hoomd::hpmc::detail::export_polyhedron(m);
+    }
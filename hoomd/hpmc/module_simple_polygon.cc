@@ -7,6 +7,7 @@
 #include "IntegratorHPMCMono.h"
 
 #include "ComputeSDF.h"
+#include "ShapeOverlaps.h"
 #include "ShapeSimplePolygon.h"
 #include "ShapeUnion.h"
 
@@ -34,6 +35,7 @@ void export_simple_polygon(pybind11::module& m)
     {
     export_IntegratorHPMCMono<ShapeSimplePolygon>(m, "IntegratorHPMCMonoSimplePolygon");
     export_ComputeFreeVolume<ShapeSimplePolygon>(m, "ComputeFreeVolumeSimplePolygon");
+    export_ShapeOverlaps<ShapeSimplePolygon>(m, "ShapeOverlapsSimplePolygon");
     export_ComputeSDF<ShapeSimplePolygon>(m, "ComputeSDFSimplePolygon");
     export_UpdaterMuVT<ShapeSimplePolygon>(m, "UpdaterMuVTSimplePolygon");
     export_UpdaterClusters<ShapeSimplePolygon>(m, "UpdaterClustersSimplePolygon");
@@ -52,3 +54,12 @@ void export_simple_polygon(pybind11::module& m)
     } // namespace detail
     } // namespace hpmc
     } // namespace hoomd
+
+//! Define the _hpmc_simple_polygon python module exports
+PYBIND11_MODULE(_hpmc_simple_polygon, m)
+    {
+    // the exported classes derive from classes in _hpmc
+    pybind11::module::import("hoomd.hpmc._hpmc");
+
+    hoomd::hpmc::detail::export_simple_polygon(m);
+    }
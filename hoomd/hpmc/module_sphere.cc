@@ -8,6 +8,7 @@
 #include "IntegratorHPMCMonoNEC.h"
 
 #include "ComputeSDF.h"
+#include "ShapeOverlaps.h"
 #include "ShapeSphere.h"
 #include "ShapeUnion.h"
 
@@ -36,6 +37,7 @@ void export_sphere(pybind11::module& m)
     export_IntegratorHPMCMono<ShapeSphere>(m, "IntegratorHPMCMonoSphere");
     export_IntegratorHPMCMonoNEC<ShapeSphere>(m, "IntegratorHPMCMonoNECSphere");
     export_ComputeFreeVolume<ShapeSphere>(m, "ComputeFreeVolumeSphere");
+    export_ShapeOverlaps<ShapeSphere>(m, "ShapeOverlapsSphere");
     export_ComputeSDF<ShapeSphere>(m, "ComputeSDFSphere");
     export_UpdaterMuVT<ShapeSphere>(m, "UpdaterMuVTSphere");
     export_UpdaterClusters<ShapeSphere>(m, "UpdaterClustersSphere");
@@ -54,3 +56,12 @@ void export_sphere(pybind11::module& m)
     } // namespace detail
     } // namespace hpmc
     } // namespace hoomd
+
+//! Define the _hpmc_sphere python module exports
+PYBIND11_MODULE(_hpmc_sphere, m)
+    {
+    // the exported classes derive from classes in _hpmc
+    pybind11::module::import("hoomd.hpmc._hpmc");
+
+    hoomd::hpmc::detail::export_sphere(m);
+    }
@@ -7,6 +7,7 @@
 #include "IntegratorHPMCMono.h"
 
 #include "ComputeSDF.h"
+#include "ShapeOverlaps.h"
 #include "ShapeSpheropolygon.h"
 #include "ShapeUnion.h"
 
@@ -34,6 +35,7 @@ void export_spheropolygon(pybind11::module& m)
     {
     export_IntegratorHPMCMono<ShapeSpheropolygon>(m, "IntegratorHPMCMonoSpheropolygon");
     export_ComputeFreeVolume<ShapeSpheropolygon>(m, "ComputeFreeVolumeSpheropolygon");
+    export_ShapeOverlaps<ShapeSpheropolygon>(m, "ShapeOverlapsSpheropolygon");
     export_ComputeSDF<ShapeSpheropolygon>(m, "ComputeSDFConvexSpheropolygon");
     export_UpdaterMuVT<ShapeSpheropolygon>(m, "UpdaterMuVTConvexSpheropolygon");
     export_UpdaterClusters<ShapeSpheropolygon>(m, "UpdaterClustersConvexSpheropolygon");
@@ -52,3 +54,12 @@ void export_spheropolygon(pybind11::module& m)
     } // namespace detail
     } // namespace hpmc
     } // namespace hoomd
+
+//! Define the _hpmc_spheropolygon python module exports
+PYBIND11_MODULE(_hpmc_spheropolygon, m)
+    {
+    // the exported classes derive from classes in _hpmc
+    pybind11::module::import("hoomd.hpmc._hpmc");
+
+    hoomd::hpmc::detail::export_spheropolygon(m);
+    }
@@ -7,6 +7,7 @@
 #include "IntegratorHPMCMono.h"
 
 #include "ComputeSDF.h"
+#include "ShapeOverlaps.h"
 #include "ShapeSphinx.h"
 #include "ShapeUnion.h"
 
@@ -34,6 +35,7 @@ void export_sphinx(pybind11::module& m)
     {
     export_IntegratorHPMCMono<ShapeSphinx>(m, "IntegratorHPMCMonoSphinx");
     export_ComputeFreeVolume<ShapeSphinx>(m, "ComputeFreeVolumeSphinx");
+    export_ShapeOverlaps<ShapeSphinx>(m, "ShapeOverlapsSphinx");
     export_ComputeSDF<ShapeSphinx>(m, "ComputeSDFSphinx");
     export_UpdaterMuVT<ShapeSphinx>(m, "UpdaterMuVTSphinx");
     export_UpdaterClusters<ShapeSphinx>(m, "UpdaterClustersSphinx");
@@ -56,3 +58,12 @@ void export_sphinx(pybind11::module& m)
     } // namespace detail
     } // namespace hpmc
     } // namespace hoomd
+
+//! Define the _hpmc_sphinx python module exports
+PYBIND11_MODULE(_hpmc_sphinx, m)
+    {
+    // the exported classes derive from classes in _hpmc
+    pybind11::module::import("hoomd.hpmc._hpmc");
+
+    hoomd::hpmc::detail::export_sphinx(m);
+    }
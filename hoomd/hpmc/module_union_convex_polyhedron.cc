@@ -7,6 +7,7 @@
 #include "IntegratorHPMC.h"
 #include "IntegratorHPMCMono.h"
 
+#include "ShapeOverlaps.h"
 #include "ShapeSpheropolyhedron.h"
 #include "ShapeUnion.h"
 
@@ -38,6 +39,8 @@ void export_union_convex_polyhedron(pybind11::module& m)
     export_ComputeFreeVolume<ShapeUnion<ShapeSpheropolyhedron>>(
         m,
         "ComputeFreeVolumeConvexPolyhedronUnion");
+    export_ShapeOverlaps<ShapeUnion<ShapeSpheropolyhedron>>(m,
+                                                            "ShapeOverlapsConvexPolyhedronUnion");
     export_ComputeSDF<ShapeUnion<ShapeSpheropolyhedron>>(m,
                                                          "ComputeSDFConvexSpheropolyhedronUnion");
     export_UpdaterMuVT<ShapeUnion<ShapeSpheropolyhedron>>(m,
@@ -73,3 +76,12 @@ void export_union_convex_polyhedron(pybind11::module& m)
     } // namespace detail
     } // namespace hpmc
     } // namespace hoomd
+
+//! Define the _hpmc_union_convex_polyhedron python module exports
+PYBIND11_MODULE(_hpmc_union_convex_polyhedron, m)
+    {
+    // the exported classes derive from classes in _hpmc
+    pybind11::module::import("hoomd.hpmc._hpmc");
+
+    hoomd::hpmc::detail::export_union_convex_polyhedron(m);
+    }
@@ -8,6 +8,7 @@
 #include "IntegratorHPMCMono.h"
 
 #include "ShapeFacetedEllipsoid.h"
+#include "ShapeOverlaps.h"
 #include "ShapeUnion.h"
 
 #include "ExternalField.h"
@@ -38,6 +39,8 @@ void export_union_faceted_ellipsoid(pybind11::module& m)
     export_ComputeFreeVolume<ShapeUnion<ShapeFacetedEllipsoid>>(
         m,
         "ComputeFreeVolumeFacetedEllipsoidUnion");
+    export_ShapeOverlaps<ShapeUnion<ShapeFacetedEllipsoid>>(m,
+                                                            "ShapeOverlapsFacetedEllipsoidUnion");
     export_ComputeSDF<ShapeUnion<ShapeFacetedEllipsoid>>(m, "ComputeSDFFacetedEllipsoidUnion");
     export_UpdaterMuVT<ShapeUnion<ShapeFacetedEllipsoid>>(m, "UpdaterMuVTFacetedEllipsoidUnion");
     export_UpdaterClusters<ShapeUnion<ShapeFacetedEllipsoid>>(
@@ -70,3 +73,12 @@ void export_union_faceted_ellipsoid(pybind11::module& m)
     } // namespace detail
     } // namespace hpmc
     } // namespace hoomd
+
+//! Define the _hpmc_union_faceted_ellipsoid python module exports
+PYBIND11_MODULE(_hpmc_union_faceted_ellipsoid, m)
+    {
+    // the exported classes derive from classes in _hpmc
+    pybind11::module::import("hoomd.hpmc._hpmc");
+
+    hoomd::hpmc::detail::export_union_faceted_ellipsoid(m);
+    }
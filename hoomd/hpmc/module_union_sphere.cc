@@ -7,6 +7,7 @@
 #include "IntegratorHPMC.h"
 #include "IntegratorHPMCMono.h"
 
+#include "ShapeOverlaps.h"
 #include "ShapeUnion.h"
 
 #include "ExternalField.h"
@@ -33,6 +34,7 @@ void export_union_sphere(pybind11::module& m)
     {
     export_IntegratorHPMCMono<ShapeUnion<ShapeSphere>>(m, "IntegratorHPMCMonoSphereUnion");
     export_ComputeFreeVolume<ShapeUnion<ShapeSphere>>(m, "ComputeFreeVolumeSphereUnion");
+    export_ShapeOverlaps<ShapeUnion<ShapeSphere>>(m, "ShapeOverlapsSphereUnion");
     export_ComputeSDF<ShapeUnion<ShapeSphere>>(m, "ComputeSDFSphereUnion");
     export_UpdaterMuVT<ShapeUnion<ShapeSphere>>(m, "UpdaterMuVTSphereUnion");
     export_UpdaterClusters<ShapeUnion<ShapeSphere>>(m, "UpdaterClustersSphereUnion");
@@ -53,3 +55,12 @@ void export_union_sphere(pybind11::module& m)
     } // namespace detail
     } // namespace hpmc
     } // namespace hoomd
+
+//! Define the _hpmc_union_sphere python module exports
+PYBIND11_MODULE(_hpmc_union_sphere, m)
+    {
+    // the exported classes derive from classes in _hpmc
+    pybind11::module::import("hoomd.hpmc._hpmc");
+
+    hoomd::hpmc::detail::export_union_sphere(m);
+    }
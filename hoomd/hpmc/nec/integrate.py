@@ -18,6 +18,15 @@ class HPMCNECIntegrator(HPMCIntegrator):
     integrators. The attributes documented here are available to all HPMC
     integrators.
 
+    .. rubric:: Threading
+
+    When `checkerboard <hoomd.hpmc.integrate.HPMCIntegrator.checkerboard>` is
+    `True`, NEC integrators run many independent chains in parallel on a
+    randomly shifted checkerboard of cells at least as wide as the largest
+    circumsphere diameter plus the largest ``d``. Chains stay in the cell of
+    their first particle: a chain ends when its particle reaches the cell
+    boundary or collides with a particle in a neighboring cell.
+
     Warning:
         This class should not be instantiated by users. The class can be used
         for `isinstance` or `issubclass` checks.
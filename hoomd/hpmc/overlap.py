@@ -0,0 +1,121 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+"""Find overlapping shapes in given configurations.
+
+`OverlapFinder` applies the HPMC overlap checks to particle configurations
+given as arrays, such as frames loaded from a trajectory file. It does not
+need a `hoomd.Simulation`.
+"""
+
+import numpy
+
+import hoomd
+from hoomd.data.collections import _to_base
+from hoomd.data.parameterdicts import _raise_if_required_arg
+from hoomd.hpmc import _hpmc
+from hoomd.hpmc import integrate
+
+
+class OverlapFinder:
+    """Find the overlapping pairs of shapes.
+
+    Args:
+        integrator (hoomd.hpmc.integrate.HPMCIntegrator): Integrator that
+            defines the shapes.
+        types (list[str]): Particle types, in the order of their type ids.
+        num_threads (int): Number of CPU threads to test overlaps with.
+
+    `OverlapFinder` copies the shape parameters from ``integrator.shape`` when
+    you construct it. The integrator does not need to be attached to a
+    simulation.
+
+    `find` tests every pair of particles in the given configuration with the
+    same overlap checks that the integrator applies, including the periodic
+    images of the particles. The checks run on the CPU with up to
+    `num_threads` threads when HOOMD-blue is built with TBB.
+
+    Example::
+
+        mc = hoomd.hpmc.integrate.ConvexPolyhedron()
+        mc.shape['A'] = dict(vertices=[(1, 1, 1), (-1, -1, 1),
+                                       (1, -1, -1), (-1, 1, -1)])
+        finder = hoomd.hpmc.overlap.OverlapFinder(mc, types=['A'],
+                                                  num_threads=4)
+
+        with gsd.hoomd.open('trajectory.gsd') as trajectory:
+            for frame in trajectory:
+                pairs = finder.find(box=frame.configuration.box,
+                                    position=frame.particles.position,
+                                    orientation=frame.particles.orientation,
+                                    typeid=frame.particles.typeid)
+    """
+
+    def __init__(self, integrator, types, num_threads=1):
+        if not isinstance(integrator, integrate.HPMCIntegrator):
+            raise TypeError("integrator must be an HPMC integrator.")
+
+        # Extract 'Shape' from 'IntegratorHPMCMono[NEC]Shape'
+        shape_name = integrator._cpp_cls.replace('IntegratorHPMCMono', '', 1)
+        if shape_name.startswith('NEC'):
+            shape_name = shape_name[len('NEC'):]
+
+        try:
+            cpp_cls = getattr(_hpmc, 'ShapeOverlaps' + shape_name)
+        except AttributeError:
+            raise RuntimeError("Unsupported integrator.")
+
+        shapes = []
+        for type_ in types:
+            shape = _to_base(integrator.shape[type_])
+            try:
+                _raise_if_required_arg(shape)
+            except hoomd.error.IncompleteSpecificationError as err:
+                raise hoomd.error.IncompleteSpecificationError(
+                    f"For type {type_} shape: {err}") from err
+            shapes.append(shape)
+
+        self._cpp_obj = cpp_cls(shapes)
+        self.num_threads = num_threads
+
+    @property
+    def num_threads(self):
+        """int: Number of CPU threads to test overlaps with."""
+        return self._cpp_obj.num_threads
+
+    @num_threads.setter
+    def num_threads(self, value):
+        self._cpp_obj.num_threads = int(value)
+
+    def find(self, box, position, orientation=None, typeid=None):
+        """Find the overlapping pairs of shapes in a configuration.
+
+        Args:
+            box (hoomd.box.box_like): Periodic box.
+            position ((*N*, 3) `numpy.ndarray` of `float`): Particle positions
+                :math:`[\\mathrm{length}]`.
+            orientation ((*N*, 4) `numpy.ndarray` of `float`): Particle
+                orientations :math:`[\\mathrm{dimensionless}]`. Defaults to
+                the identity orientation when `None`.
+            typeid ((*N*,) `numpy.ndarray` of `int`): Particle type ids.
+                Defaults to 0 when `None`.
+
+        Returns:
+            (*M*, 2) `numpy.ndarray` of `int`: The indices ``(i, j)`` of the
+            overlapping pairs with ``i <= j``, sorted. ``i == j`` when a
+            particle overlaps with its own periodic image.
+        """
+        box = hoomd.Box.from_box(box)
+        position = numpy.asarray(position, dtype=numpy.float64)
+        N = len(position)
+
+        if orientation is None:
+            orientation = numpy.zeros((N, 4))
+            orientation[:, 0] = 1
+        if typeid is None:
+            typeid = numpy.zeros(N, dtype=numpy.uint32)
+
+        return self._cpp_obj.findOverlaps(
+            box._cpp_obj, box.dimensions, position,
+            numpy.asarray(orientation, dtype=numpy.float64),
+            numpy.asarray(typeid, dtype=numpy.uint32))
@@ -120,6 +120,7 @@ class CPPPotentialBase(AutotunedObject):
                         #include <stdio.h>
                         #include "hoomd/HOOMDMath.h"
                         #include "hoomd/VectorMath.h"
+                        #include "hoomd/hpmc/PatchEnergyBatch.h"
 
                         // param_array (singlet class) or param_array_isotropic
                         // and param_array_constituent (union class) are
@@ -145,6 +146,42 @@ class CPPPotentialBase(AutotunedObject):
         cpp_function += code
         cpp_function += """
                             }
+                        """
+        if not self._is_union:
+            # The batched evaluator loops over the pairs in a
+            # PatchEnergyBatch. Compiled together with eval, the loop is
+            # inlined and vectorized.
+            cpp_function += """
+                        void eval_batch(
+                            hoomd::hpmc::detail::PatchEnergyBatch& batch,
+                            unsigned int type_i,
+                            const quat<float>& q_i,
+                            float d_i,
+                            float charge_i)
+                            {
+                            #pragma clang loop vectorize(enable)
+                            for (unsigned int k = 0; k < batch.n; k++)
+                                {
+                                vec3<float> r_ij(batch.r_x[k],
+                                                 batch.r_y[k],
+                                                 batch.r_z[k]);
+                                quat<float> q_j(batch.q_s[k],
+                                                vec3<float>(batch.q_x[k],
+                                                            batch.q_y[k],
+                                                            batch.q_z[k]));
+                                batch.energy[k] = eval(r_ij,
+                                                       type_i,
+                                                       q_i,
+                                                       d_i,
+                                                       charge_i,
+                                                       batch.type[k],
+                                                       q_j,
+                                                       batch.diameter[k],
+                                                       batch.charge[k]);
+                                }
+                            }
+                        """
+        cpp_function += """
                         }
                         """
         return cpp_function
@@ -317,3 +317,51 @@ def test_logging():
                 'default': True
             }
         })
+
+
+@pytest.mark.parametrize("box_move", box_moves_attrs)
+def test_aabb_tree_refit(box_move, simulation_factory,
+                         lattice_snapshot_factory):
+    """Test that refitting the AABB tree leaves the trajectory unchanged."""
+    results = []
+    for tolerance in [0.0, 1.0]:
+        sim = simulation_factory(
+            lattice_snapshot_factory(dimensions=3, n=7, a=1.3))
+        sim.seed = 7
+        boxmc = hoomd.hpmc.update.BoxMC(betaP=5, trigger=1)
+        setattr(boxmc, box_move['move'], box_move['params'])
+        sim.operations.updaters.append(boxmc)
+        mc = hoomd.hpmc.integrate.Sphere(default_d=0.05)
+        mc.shape['A'] = dict(diameter=1)
+        mc.aabb_tree_refit_tolerance = tolerance
+        sim.operations.integrator = mc
+
+        sim.run(10)
+        assert mc.aabb_tree_refit_tolerance == tolerance
+        assert mc.overlaps == 0
+        snap = sim.state.get_snapshot()
+        results.append((sim.state.box, snap.particles.position.copy()))
+
+    assert results[0][0] == results[1][0]
+    if snap.communicator.rank == 0:
+        np.testing.assert_array_equal(results[0][1], results[1][1])
+
+
+@pytest.mark.parametrize("box_move", box_moves_attrs)
+def test_move_size_target(box_move, simulation_factory,
+                          lattice_snapshot_factory):
+    """Test that BoxMC tunes delta toward the target acceptance."""
+    boxmc = hoomd.hpmc.update.BoxMC(betaP=5, trigger=1)
+    setattr(boxmc, box_move['move'], box_move['params'])
+    boxmc.move_size_target = 0.3
+    sim = simulation_factory(lattice_snapshot_factory(dimensions=3, n=5, a=1.3))
+    sim.operations.updaters.append(boxmc)
+    mc = hoomd.hpmc.integrate.Sphere(default_d=0.05)
+    mc.shape['A'] = dict(diameter=1)
+    sim.operations.integrator = mc
+
+    sim.run(20)
+    assert boxmc.move_size_target == 0.3
+    assert not _is_close(getattr(boxmc, box_move['move'])['delta'],
+                         box_move['params']['delta'])
+    assert mc.overlaps == 0
@@ -159,6 +159,41 @@ def test_pivot_moves(device, simulation_factory, lattice_snapshot_factory):
     assert avg > 0
 
 
+@pytest.mark.gpu
+def test_shared_cell_list(simulation_factory, lattice_snapshot_factory):
+    """Test that Clusters shares the integrator's cell list."""
+    sim = simulation_factory(
+        lattice_snapshot_factory(particle_types=['A', 'B'],
+                                 dimensions=3,
+                                 a=4,
+                                 n=7,
+                                 r=0.1))
+
+    mc = hoomd.hpmc.integrate.Sphere(default_d=0.1, default_a=0.1)
+    mc.shape['A'] = dict(diameter=1.1)
+    mc.shape['B'] = dict(diameter=1.3)
+    sim.operations.integrator = mc
+
+    cl = hoomd.hpmc.update.Clusters(trigger=hoomd.trigger.Periodic(2),
+                                    pivot_move_probability=0.5)
+    sim.operations.updaters.append(cl)
+
+    sim.run(10)
+
+    assert cl._cpp_cell is mc._cpp_cell
+    assert sim.state._cell_lists['hpmc'][1] == 2
+    assert mc.overlaps == 0
+
+    sim.operations.updaters.remove(cl)
+    assert sim.state._cell_lists['hpmc'][1] == 1
+
+    sim.run(10)
+    assert mc.overlaps == 0
+
+    sim.operations.integrator = None
+    assert 'hpmc' not in sim.state._cell_lists
+
+
 def test_pickling(simulation_factory, two_particle_snapshot_factory):
     """Test that Cluster objects are picklable."""
     sim = simulation_factory(two_particle_snapshot_factory())
@@ -87,13 +87,62 @@ def test_validation_systems(simulation_factory, lattice_snapshot_factory,
                                      activate=activate_tuner)
 
 
+@pytest.mark.parametrize("sequence", ['random', 'halton'])
+def test_target_error(simulation_factory, lattice_snapshot_factory, sequence):
+    n = 7
+    radius1 = 0.4
+    radius2 = 0.05
+    free_volume = (n**3) * (1 - (4 / 3) * np.pi * (radius1 + radius2)**3)
+    sim = simulation_factory(
+        lattice_snapshot_factory(particle_types=['A', 'B'],
+                                 n=n,
+                                 a=1,
+                                 dimensions=3,
+                                 r=0))
+
+    mc = hoomd.hpmc.integrate.Sphere()
+    mc.shape["A"] = {'diameter': radius1 * 2}
+    mc.shape["B"] = {'diameter': radius2 * 2}
+    sim.operations.add(mc)
+
+    free_volume_compute = hoomd.hpmc.compute.FreeVolume(test_particle_type='B',
+                                                        num_samples=1000,
+                                                        sequence=sequence,
+                                                        target_error=0.01)
+    sim.operations.add(free_volume_compute)
+    sim.run(0)
+
+    assert free_volume_compute.sequence == sequence
+    assert free_volume_compute.relative_error <= 0.01
+    assert free_volume_compute.num_samples_taken > 1000
+    assert free_volume_compute.num_samples_taken % 1000 == 0
+    np.testing.assert_allclose(free_volume,
+                               free_volume_compute.free_volume,
+                               rtol=3e-2)
+
+    # the total number of samples is limited
+    free_volume_compute.max_num_samples = 2000
+    sim.run(1)
+    assert free_volume_compute.num_samples_taken == 2000
+
+
 def test_logging():
     logging_check(
         hoomd.hpmc.compute.FreeVolume, ('hpmc', 'compute'),
-        {'free_volume': {
-            'category': LoggerCategories.scalar,
-            'default': True
-        }})
+        {
+            'free_volume': {
+                'category': LoggerCategories.scalar,
+                'default': True
+            },
+            'relative_error': {
+                'category': LoggerCategories.scalar,
+                'default': True
+            },
+            'num_samples_taken': {
+                'category': LoggerCategories.scalar,
+                'default': True
+            }
+        })
 
 
 def test_2d_free_volume(simulation_factory):
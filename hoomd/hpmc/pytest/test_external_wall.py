@@ -578,3 +578,41 @@ def test_overlaps(simulation_factory, one_particle_snapshot_factory,
     mc.shape['A'] = shapedef
     sim.run(0)
     assert (mc.external_potential.overlaps > 0) == expecting_overlap
+
+
+@pytest.mark.cpu
+def test_many_obstacles(simulation_factory):
+    """Test that particles never enter spherical obstacles on a lattice."""
+    L = 10
+    grid = np.array(list(itertools.product(range(4), repeat=3)))
+    snapshot = hoomd.Snapshot()
+    if snapshot.communicator.rank == 0:
+        snapshot.configuration.box = (L, L, L, 0, 0, 0)
+        snapshot.particles.N = len(grid)
+        snapshot.particles.types = ['A']
+        snapshot.particles.position[:] = -L / 2 + 2.5 * grid
+    sim = simulation_factory(snapshot)
+
+    mc = hoomd.hpmc.integrate.Sphere(default_d=0.5)
+    mc.shape['A'] = dict(diameter=1)
+    obstacles = -3.75 + 2.5 * grid
+    mc.external_potential = hoomd.hpmc.external.wall.WallPotential([
+        hoomd.wall.Sphere(radius=0.5, origin=tuple(o), inside=False)
+        for o in obstacles
+    ])
+    sim.operations.integrator = mc
+
+    sim.run(0)
+    assert mc.external_potential.overlaps == 0
+
+    sim.run(100)
+    assert mc.external_potential.overlaps == 0
+    assert mc.translate_moves[0] > 0
+    assert mc.translate_moves[1] > 0
+
+    snapshot = sim.state.get_snapshot()
+    if snapshot.communicator.rank == 0:
+        delta = (snapshot.particles.position[:, np.newaxis, :]
+                 - obstacles[np.newaxis, :, :])
+        delta -= L * np.round(delta / L)
+        assert np.min(np.linalg.norm(delta, axis=2)) >= 1.0
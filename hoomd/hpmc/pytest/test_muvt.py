@@ -29,6 +29,7 @@ valid_attrs = [
     ("transfer_types", ["A"]),
     ("transfer_types", ["B"]),
     ("transfer_types", ["A", "B"]),
+    ("local_trials", 10),
 ]
 
 
@@ -172,6 +173,45 @@ def test_insertion_removal(device, simulation_factory,
     assert muvt.N["B"] > 0
 
 
+def test_local_trials_ideal_gas(device, simulation_factory,
+                                lattice_snapshot_factory):
+    """Test that local trials sample the ideal gas particle number."""
+    sim = simulation_factory(
+        lattice_snapshot_factory(particle_types=["A", "B"],
+                                 dimensions=3,
+                                 a=4,
+                                 n=5,
+                                 r=0.1))
+
+    mc = hoomd.hpmc.integrate.Sphere(default_d=0.0, default_a=0.0)
+    mc.shape["A"] = dict(diameter=0.01)
+    mc.shape["B"] = dict(diameter=0.0)
+    sim.operations.integrator = mc
+
+    fugacity = 0.02
+    muvt = hoomd.hpmc.update.MuVT(trigger=hoomd.trigger.Periodic(1),
+                                  transfer_types=["B"],
+                                  local_trials=200)
+    muvt.fugacity["B"] = fugacity
+    sim.operations.updaters.append(muvt)
+
+    sim.run(200)
+    assert sum(muvt.insert_moves) > 0
+    assert sum(muvt.remove_moves) > 0
+
+    # point particles do not interact: <N> = fugacity * V
+    n_b = []
+    for i in range(100):
+        sim.run(2)
+        n_b.append(muvt.N["B"])
+
+    expected = fugacity * sim.state.box.volume
+    assert numpy.mean(n_b) == pytest.approx(expected, rel=0.1)
+
+    # the A particles are not transferred
+    assert muvt.N["A"] == 125
+
+
 @pytest.mark.cpu
 @pytest.mark.skipif(not hoomd.version.llvm_enabled, reason="LLVM not enabled")
 def test_jit_remove_insert(device, simulation_factory,
@@ -0,0 +1,110 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+import hoomd
+import numpy as np
+import numpy.testing as npt
+import pytest
+
+
+def test_spheres():
+    mc = hoomd.hpmc.integrate.Sphere()
+    mc.shape['A'] = dict(diameter=1.0)
+    mc.shape['B'] = dict(diameter=2.0)
+    finder = hoomd.hpmc.overlap.OverlapFinder(mc, types=['A', 'B'])
+
+    # particles 3 and 4 overlap through the periodic boundary
+    position = [(0, 0, 0), (0.9, 0, 0), (1.45, 0, 0), (4.9, 0, 0),
+                (-4.8, 0, 0)]
+    pairs = finder.find(box=[10, 10, 10, 0, 0, 0], position=position)
+    npt.assert_equal(pairs, [(0, 1), (1, 2), (3, 4)])
+
+    pairs = finder.find(box=[10, 10, 10, 0, 0, 0],
+                        position=position,
+                        typeid=[0, 0, 1, 0, 0])
+    npt.assert_equal(pairs, [(0, 1), (0, 2), (1, 2), (3, 4)])
+
+
+def test_empty():
+    mc = hoomd.hpmc.integrate.Sphere()
+    mc.shape['A'] = dict(diameter=1.0)
+    finder = hoomd.hpmc.overlap.OverlapFinder(mc, types=['A'])
+
+    pairs = finder.find(box=[10, 10, 10, 0, 0, 0], position=np.zeros((0, 3)))
+    assert pairs.shape == (0, 2)
+
+
+def test_small_box():
+    mc = hoomd.hpmc.integrate.Sphere()
+    mc.shape['A'] = dict(diameter=1.0)
+    finder = hoomd.hpmc.overlap.OverlapFinder(mc, types=['A'])
+
+    pairs = finder.find(box=[0.9, 5, 5, 0, 0, 0], position=[(0, 0, 0)])
+    npt.assert_equal(pairs, [(0, 0)])
+
+    pairs = finder.find(box=[1.1, 5, 5, 0, 0, 0], position=[(0, 0, 0)])
+    assert len(pairs) == 0
+
+
+def test_orientation():
+    mc = hoomd.hpmc.integrate.ConvexPolyhedron()
+    mc.shape['A'] = dict(vertices=[(-0.5, -0.5, -0.5), (-0.5, -0.5, 0.5),
+                                   (-0.5, 0.5, -0.5), (-0.5, 0.5, 0.5),
+                                   (0.5, -0.5, -0.5), (0.5, -0.5, 0.5),
+                                   (0.5, 0.5, -0.5), (0.5, 0.5, 0.5)])
+    finder = hoomd.hpmc.overlap.OverlapFinder(mc, types=['A'])
+
+    position = [(0, 0, 0), (1.1, 0, 0)]
+    pairs = finder.find(box=[10, 10, 10, 0, 0, 0], position=position)
+    assert len(pairs) == 0
+
+    # rotate the second cube by 45 degrees about z so its edge touches the first
+    q = (np.cos(np.pi / 8), 0, 0, np.sin(np.pi / 8))
+    pairs = finder.find(box=[10, 10, 10, 0, 0, 0],
+                        position=position,
+                        orientation=[(1, 0, 0, 0), q])
+    npt.assert_equal(pairs, [(0, 1)])
+
+
+def test_2d():
+    mc = hoomd.hpmc.integrate.ConvexPolygon()
+    mc.shape['A'] = dict(vertices=[(-0.5, -0.5), (0.5, -0.5), (0.5, 0.5),
+                                   (-0.5, 0.5)])
+    finder = hoomd.hpmc.overlap.OverlapFinder(mc, types=['A'])
+
+    position = [(0, 0, 0), (0.9, 0.9, 0), (2.0, 0, 0)]
+    pairs = finder.find(box=[10, 10, 0, 0, 0, 0], position=position)
+    npt.assert_equal(pairs, [(0, 1)])
+
+
+def test_incomplete_shape():
+    mc = hoomd.hpmc.integrate.Sphere()
+    with pytest.raises(hoomd.error.IncompleteSpecificationError):
+        hoomd.hpmc.overlap.OverlapFinder(mc, types=['A'])
+
+
+@pytest.mark.parametrize("num_threads", [1, 2])
+def test_matches_integrator(simulation_factory, lattice_snapshot_factory,
+                            num_threads):
+    snap = lattice_snapshot_factory(particle_types=['A'], n=6, a=1.0, r=0.3)
+    sim = simulation_factory(snap)
+    mc = hoomd.hpmc.integrate.Sphere()
+    mc.shape['A'] = dict(diameter=1.0)
+    sim.operations.integrator = mc
+    sim.run(0)
+
+    finder = hoomd.hpmc.overlap.OverlapFinder(mc,
+                                              types=['A'],
+                                              num_threads=num_threads)
+    assert finder.num_threads == num_threads
+
+    overlaps = mc.overlaps
+    assert overlaps > 0
+
+    snap = sim.state.get_snapshot()
+    if snap.communicator.rank == 0:
+        pairs = finder.find(box=snap.configuration.box,
+                            position=snap.particles.position,
+                            orientation=snap.particles.orientation,
+                            typeid=snap.particles.typeid)
+        assert len(pairs) == overlaps
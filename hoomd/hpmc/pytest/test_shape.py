@@ -694,6 +694,22 @@ def test_logging():
                 'category': LoggerCategories.scalar,
                 'default': True
             },
+            'aabb_node_visits': {
+                'category': LoggerCategories.scalar,
+                'default': True
+            },
+            'circumsphere_rejections': {
+                'category': LoggerCategories.scalar,
+                'default': True
+            },
+            'narrow_phase_checks': {
+                'category': LoggerCategories.sequence,
+                'default': True
+            },
+            'overlap_check_time': {
+                'category': LoggerCategories.scalar,
+                'default': True
+            },
             'overlaps': {
                 'category': LoggerCategories.scalar,
                 'default': True
@@ -731,13 +747,119 @@ def test_logging():
 # test_fugacity fails on the GPU for unknown reasons - not fixing as the
 # implicit depletant code is slated for removal.
 @pytest.mark.cpu
+@pytest.mark.parametrize('depletant_sampling_tables', [False, True])
 def test_fugacity(simulation_factory, two_particle_snapshot_factory,
-                  test_moves_args):
+                  test_moves_args, depletant_sampling_tables):
     integrator = test_moves_args[0]
     args = test_moves_args[1]
     mc = integrator()
     mc.shape['A'] = args
     mc.depletant_fugacity["A"] = 0.1
+    mc.depletant_sampling_tables = depletant_sampling_tables
     sim = simulation_factory(two_particle_snapshot_factory())
     sim.operations.integrator = mc
     sim.run(2)
+    assert mc.depletant_sampling_tables == depletant_sampling_tables
+
+
+@pytest.mark.cpu
+@pytest.mark.serial
+@pytest.mark.parametrize('n_dimensions', [2, 3])
+def test_checkerboard(simulation_factory, lattice_snapshot_factory,
+                      n_dimensions):
+    """Test the trial moves on a checkerboard of cells."""
+    mc = hoomd.hpmc.integrate.Sphere(default_d=0.2)
+    mc.shape['A'] = dict(diameter=1.0)
+    assert not mc.checkerboard
+    mc.checkerboard = True
+
+    sim = simulation_factory(
+        lattice_snapshot_factory(dimensions=n_dimensions, n=8, a=1.2))
+    sim.operations.integrator = mc
+    sim.run(0)
+    assert mc.checkerboard
+    assert mc.overlaps == 0
+
+    sim.run(20)
+    translate_moves = mc.translate_moves
+    assert translate_moves[0] > 0
+    assert translate_moves[1] > 0
+    assert sum(translate_moves) == 20 * mc.nselect * sim.state.N_particles
+    assert mc.overlaps == 0
+
+
+@pytest.mark.parametrize('n_dimensions', [2, 3])
+def test_trials_per_move(simulation_factory, lattice_snapshot_factory,
+                         n_dimensions):
+    """Test the multiple-trial moves."""
+    mc = hoomd.hpmc.integrate.Sphere(default_d=0.2)
+    mc.shape['A'] = dict(diameter=1.0)
+    assert mc.trials_per_move == 1
+    mc.trials_per_move = 4
+
+    sim = simulation_factory(
+        lattice_snapshot_factory(dimensions=n_dimensions, n=6, a=1.1))
+    sim.operations.integrator = mc
+    sim.run(0)
+    assert mc.trials_per_move == 4
+
+    sim.run(20)
+    translate_moves = mc.translate_moves
+    assert translate_moves[0] > 0
+    assert translate_moves[1] > 0
+    assert sum(translate_moves) == 20 * mc.nselect * sim.state.N_particles
+    assert mc.overlaps == 0
+
+
+def test_detailed_counters(simulation_factory, lattice_snapshot_factory):
+    """Test the detailed counters of the overlap search."""
+    mc = hoomd.hpmc.integrate.Sphere(default_d=0.2)
+    mc.shape['A'] = dict(diameter=1.0)
+    assert not mc.detailed_counters
+
+    sim = simulation_factory(lattice_snapshot_factory(n=6, a=1.1))
+    if isinstance(sim.device, hoomd.device.GPU):
+        pytest.skip("Detailed counters are only recorded on the CPU.")
+    sim.operations.integrator = mc
+
+    sim.run(10)
+    assert mc.sweep_counters.aabb_node_visits == 0
+    assert mc.narrow_phase_checks == [0]
+    assert mc.overlap_check_time == 0
+
+    mc.detailed_counters = True
+    sim.run(10)
+    counters = mc.sweep_counters
+    assert counters.aabb_node_visits > 0
+    assert counters.narrow_phase_checks > 0
+    assert counters.search_time > 0
+    assert mc.narrow_phase_checks == [counters.narrow_phase_checks]
+    assert mc.overlap_check_time > 0
+
+
+@pytest.mark.parametrize('n_dimensions', [2, 3])
+def test_move_size_target(simulation_factory, lattice_snapshot_factory,
+                          n_dimensions):
+    """Test that the integrator tunes d toward the target acceptance."""
+    mc = hoomd.hpmc.integrate.Sphere(default_d=1.0)
+    mc.shape['A'] = dict(diameter=1.0)
+    mc.move_size_target = 0.3
+    mc.max_translation_move = 0.8
+
+    sim = simulation_factory(
+        lattice_snapshot_factory(dimensions=n_dimensions, n=6, a=1.1))
+    sim.operations.integrator = mc
+    sim.run(200)
+    assert mc.move_size_target == 0.3
+    assert 0 < mc.d['A'] < 0.8
+
+    sim.run(100)
+    accept, reject = mc.translate_moves
+    assert accept / (accept + reject) == pytest.approx(0.3, abs=0.1)
+    assert mc.overlaps == 0
+
+    # disabling the tuning leaves d fixed
+    mc.move_size_target = 0
+    d = mc.d['A']
+    sim.run(10)
+    assert mc.d['A'] == d
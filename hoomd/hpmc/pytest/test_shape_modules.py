@@ -0,0 +1,55 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+import sys
+
+import pytest
+
+import hoomd
+import hoomd.hpmc
+from hoomd.hpmc import _hpmc, _shape_modules
+
+
+@pytest.mark.parametrize('name, shape_module',
+                         [('IntegratorHPMCMonoSphere', 'sphere'),
+                          ('IntegratorHPMCMonoSphereUnion', 'union_sphere'),
+                          ('UpdaterClustersConvexSpheropolygonGPU',
+                           'spheropolygon'),
+                          ('ComputeSDFConvexSpheropolyhedronUnion',
+                           'union_convex_polyhedron'),
+                          ('WallConvexPolyhedron', 'convex_polyhedron'),
+                          ('ShapeSpaceSpheropolyhedron',
+                           'convex_spheropolyhedron'),
+                          ('SphereWall', None), ('UpdaterBoxMC', None)])
+def test_find_shape_module(name, shape_module):
+    assert _shape_modules._find_shape_module(name) == shape_module
+
+
+def test_load_on_access():
+    cls = _hpmc.IntegratorHPMCMonoEllipsoid
+    assert 'hoomd.hpmc._hpmc_ellipsoid' in sys.modules
+    assert cls is sys.modules['hoomd.hpmc._hpmc_ellipsoid'].__dict__[
+        'IntegratorHPMCMonoEllipsoid']
+    assert 'IntegratorHPMCMonoEllipsoid' in _hpmc.__dict__
+    assert 'ComputeSDFEllipsoid' in _hpmc.__dict__
+
+
+def test_missing_attribute():
+    with pytest.raises(AttributeError):
+        _hpmc.IntegratorHPMCMonoNotAShape
+
+    with pytest.raises(AttributeError):
+        _hpmc.IntegratorHPMCMonoSpheropolygonNotAClass
+
+    assert hasattr(_hpmc, 'IntegratorHPMCMonoSphere')
+    assert not hasattr(_hpmc, 'IntegratorHPMCMonoSphereCPU')
+
+
+def test_simulation(simulation_factory, lattice_snapshot_factory):
+    mc = hoomd.hpmc.integrate.ConvexPolygon()
+    mc.shape['A'] = dict(vertices=[(-0.5, -0.5), (0.5, -0.5), (0.5, 0.5),
+                                   (-0.5, 0.5)])
+    sim = simulation_factory(lattice_snapshot_factory(dimensions=2))
+    sim.operations.integrator = mc
+    sim.run(10)
+    assert 'hoomd.hpmc._hpmc_convex_polygon' in sys.modules
@@ -105,3 +105,56 @@ UP_TEST(bigger)
         UP_ASSERT(in(i, hits));
         }
     }
+
+UP_TEST(parallel_build)
+    {
+    // enough AABBs to split the build into several tasks
+    const unsigned int N = 5 * PARALLEL_BUILD_GRAIN;
+    hoomd::RandomGenerator rng(hoomd::Seed(0, 1, 2), hoomd::Counter(7, 8, 9));
+
+    std::vector<vec3<Scalar>> points(N);
+    std::vector<AABB> aabbs(N);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] = vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                 hoomd::detail::generate_canonical<float>(rng),
+                                 hoomd::detail::generate_canonical<float>(rng))
+                    * Scalar(100);
+        aabbs[i] = AABB(points[i], Scalar(0.5));
+        aabbs[i].tag = i;
+        }
+    std::vector<AABB> aabbs_parallel(aabbs);
+
+    AABBTree tree;
+    tree.buildTree(aabbs.data(), N);
+    AABBTree tree_parallel;
+    tree_parallel.buildTree(aabbs_parallel.data(), N, true);
+
+    // the parallel build produces the same nodes in the same order
+    UP_ASSERT_EQUAL(tree_parallel.getNumNodes(), tree.getNumNodes());
+    for (unsigned int node = 0; node < tree.getNumNodes(); node++)
+        {
+        const AABBNode& a = tree.getNode(node);
+        const AABBNode& b = tree_parallel.getNode(node);
+        UP_ASSERT_EQUAL(b.left, a.left);
+        UP_ASSERT_EQUAL(b.right, a.right);
+        UP_ASSERT_EQUAL(b.parent, a.parent);
+        UP_ASSERT_EQUAL(b.skip, a.skip);
+        UP_ASSERT_EQUAL(b.num_particles, a.num_particles);
+        for (unsigned int j = 0; j < a.num_particles; j++)
+            {
+            UP_ASSERT_EQUAL(b.particles[j], a.particles[j]);
+            UP_ASSERT_EQUAL(b.particle_tags[j], a.particle_tags[j]);
+            }
+        }
+
+    // and finds every particle
+    std::vector<unsigned int> hits;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        hits.clear();
+        tree_parallel.query(hits, AABB(points[i], Scalar(0.01)));
+        UP_ASSERT(in(i, hits));
+        UP_ASSERT_EQUAL(tree_parallel.height(i), tree.height(i));
+        }
+    }
@@ -84,6 +84,36 @@ UP_TEST(support)
     UP_ASSERT(v1 == v2);
     }
 
+UP_TEST(support_hill_climbing)
+    {
+    // points on a sphere, enough for the support function to walk the hull edges
+    const unsigned int n_verts = 100;
+    vector<vec3<ShortReal>> vlist;
+    for (unsigned int i = 0; i < n_verts; i++)
+        {
+        Scalar z = 1 - 2 * (i + 0.5) / n_verts;
+        Scalar phi = i * M_PI * (3 - sqrt(5.0));
+        Scalar r = sqrt(1 - z * z);
+        vlist.push_back(
+            vec3<ShortReal>(ShortReal(r * cos(phi)), ShortReal(r * sin(phi)), ShortReal(z)));
+        }
+    PolyhedronVertices verts(vlist, 0, 0);
+    UP_ASSERT(verts.adjacency.size() > 0);
+
+    SupportFuncConvexPolyhedron sa = SupportFuncConvexPolyhedron(verts);
+    for (unsigned int k = 0; k < 200; k++)
+        {
+        vec3<ShortReal> n(ShortReal(cos(0.7 * k)),
+                          ShortReal(sin(1.3 * k)),
+                          ShortReal(cos(2.9 * k)));
+        ShortReal max_dot = -FLT_MAX;
+        for (unsigned int i = 0; i < n_verts; i++)
+            max_dot = std::max(max_dot, dot(n, vlist[i]));
+
+        MY_CHECK_CLOSE(dot(n, sa(n)), max_dot, tol_small);
+        }
+    }
+
 UP_TEST(overlap_octahedron_no_rot)
     {
     // first set of simple overlap checks is two octahedra at unit orientation
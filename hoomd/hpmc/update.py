@@ -266,6 +266,17 @@ class BoxMC(Updater):
             When using multiple `BoxMC` updaters in a single simulation,
             give each a unique value for `instance` so they generate
             different streams of random numbers.
+
+        move_size_target (float):
+            When positive, adapt the ``delta`` of the selected move type after
+            every box move so that its acceptance ratio approaches this
+            target. The adaptation follows a Robbins-Monro rule with a step
+            size that decays as the number of moves grows. Length and shear
+            moves scale all three components by the same factor. Set to 0 to
+            disable the adaptation (**default:** 0).
+
+        move_size_gain (float):
+            Gain of the ``delta`` adaptation (**default:** 1).
     """
 
     def __init__(self, trigger, betaP):
@@ -282,6 +293,8 @@ class BoxMC(Updater):
             shear=dict(weight=0.0, delta=(0.0,) * 3, reduce=0.0),
             betaP=hoomd.variant.Variant,
             instance=int,
+            move_size_target=0.0,
+            move_size_gain=1.0,
         )
         self._param_dict.update(param_dict)
         self.volume["mode"] = "standard"
@@ -379,6 +392,9 @@ class MuVT(Updater):
           ensemble)
         move_ratio (float): (if set) Set the ratio between volume and
           exchange/transfer moves (applies to Gibbs ensemble)
+        local_trials (int): Number of insertion and removal trials per MPI rank
+          in the active region of its domain (does not apply to Gibbs
+          ensemble)
 
     The muVT (or grand-canonical) ensemble simulates a system at constant
     fugacity.
@@ -399,6 +415,19 @@ class MuVT(Updater):
         with the ``ngibbs`` option to update.muvt(), where the number of
         partitions can be a multiple of ``ngibbs``.
 
+    .. rubric:: Local trials
+
+    Each grand canonical update attempts one insertion or removal in the whole
+    box, which requires several collective MPI calls. Set ``local_trials`` to
+    additionally attempt that many insertions and removals on every rank in the
+    active region of its domain, where HPMC moves particles, without any
+    communication during the trials. The accepted trials of all ranks are
+    applied together in a single collective call. The acceptance criterion uses
+    the volume of the active region and the number of particles in it, so
+    the local trials sample the same grand canonical ensemble. Without
+    domain decomposition, the active region is the whole box. Local trials do
+    not support depletants.
+
     Attributes:
         trigger (int): Select the timesteps on which to perform cluster moves.
         transfer_types (list): List of type names that are being transferred
@@ -409,6 +438,8 @@ class MuVT(Updater):
           (applies to Gibbs ensemble)
         ntrial (float): (**default**: 1) Number of configurational bias attempts
           to swap depletants
+        local_trials (int): Number of insertion and removal trials per MPI rank
+          in the active region of its domain
         fugacity (`TypeParameter` [ ``particle type``, `float`]):
             Particle fugacity
             :math:`[\mathrm{volume}^{-1}]` (**default:** 0).
@@ -419,7 +450,8 @@ class MuVT(Updater):
                  ngibbs=1,
                  max_volume_rescale=0.1,
                  volume_move_probability=0.5,
-                 trigger=1):
+                 trigger=1,
+                 local_trials=0):
         super().__init__(trigger)
 
         self.ngibbs = int(ngibbs)
@@ -429,6 +461,7 @@ class MuVT(Updater):
             transfer_types=list(transfer_types),
             max_volume_rescale=float(max_volume_rescale),
             volume_move_probability=float(volume_move_probability),
+            local_trials=int(local_trials),
             **_default_dict)
         self._param_dict.update(param_dict)
 
@@ -675,7 +708,9 @@ class Clusters(Updater):
             moves.
     """
     _remove_for_pickling = Updater._remove_for_pickling + ('_cpp_cell',)
-    _skip_for_equality = Updater._skip_for_equality | {'_cpp_cell'}
+    _skip_for_equality = Updater._skip_for_equality | {
+        '_cpp_cell', '_cell_list_key'
+    }
 
     def __init__(self,
                  pivot_move_probability=0.5,
@@ -701,7 +736,7 @@ class Clusters(Updater):
         cpp_cls_name += integrator.__class__.__name__
         cpp_cls = getattr(_hpmc, cpp_cls_name)
         use_gpu = (isinstance(self._simulation.device, hoomd.device.GPU)
-                   and (cpp_cls_name + 'GPU') in _hpmc.__dict__)
+                   and hasattr(_hpmc, cpp_cls_name + 'GPU'))
         if use_gpu:
             cpp_cls_name += "GPU"
         cpp_cls = getattr(_hpmc, cpp_cls_name)
@@ -710,15 +745,27 @@ class Clusters(Updater):
             raise RuntimeError("Integrator is not attached yet.")
 
         if use_gpu:
-            sys_def = self._simulation.state._cpp_sys_def
-            self._cpp_cell = _hoomd.CellListGPU(sys_def)
+            # Share the integrator's cell list when both use the same cell
+            # width, which is the case without depletants.
+            if all(f == 0 for f in integrator.depletant_fugacity.values()):
+                self._cell_list_key = 'hpmc'
+            else:
+                self._cell_list_key = ('hpmc', 'clusters', id(self))
+            self._cpp_cell = self._simulation.state._get_cell_list(
+                self._cell_list_key, _hoomd.CellListGPU)
             self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def,
                                     self.trigger, integrator._cpp_obj,
                                     self._cpp_cell)
         else:
+            self._cpp_cell = None
             self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def,
                                     self.trigger, integrator._cpp_obj)
 
+    def _detach_hook(self):
+        if self._cpp_cell is not None:
+            self._simulation.state._release_cell_list(self._cell_list_key)
+            self._cpp_cell = None
+
     @log(requires_run=True)
     def avg_cluster_size(self):
         """float: the typical size of clusters.
@@ -247,18 +247,37 @@ void ActiveForceCompute::rotationalDiffusion(Scalar rotational_diffusion, uint64
     assert(h_tag.data != NULL);
 
     const auto rotation_constant = slow::sqrt(2.0 * rotational_diffusion * m_deltaT);
-    for (unsigned int i = 0; i < m_group->getNumMembers(); i++)
+
+    // each particle draws one normal value in 2D, and a point on the sphere and a normal value in
+    // 3D
+    constexpr unsigned int batch_size = 16;
+    hoomd::RandomBatchDraws<batch_size, 3> draws;
+    const unsigned int n_draws = m_sysdef->getNDimensions() == 2 ? 1 : 3;
+    const unsigned int group_size = m_group->getNumMembers();
+
+    for (unsigned int i = 0; i < group_size; i++)
         {
         unsigned int idx = m_group->getMemberIndex(i);
         unsigned int type = __scalar_as_int(h_pos.data[idx].w);
 
+        // Draw the random numbers of the next batch of particles together
+        if (i % batch_size == 0)
+            {
+            hoomd::RandomGeneratorBatch<batch_size> rng_batch(
+                hoomd::Seed(hoomd::RNGIdentifier::ActiveForceCompute,
+                            timestep,
+                            m_sysdef->getSeed()));
+            for (unsigned int k = 0; k < batch_size && i + k < group_size; k++)
+                {
+                unsigned int ptag = h_tag.data[m_group->getMemberIndex(i + k)];
+                rng_batch.setCounter(k, hoomd::Counter(ptag));
+                }
+            draws.generate(rng_batch, n_draws);
+            }
+
         if (h_f_actVec.data[type].w != 0)
             {
-            unsigned int ptag = h_tag.data[idx];
-            hoomd::RandomGenerator rng(hoomd::Seed(hoomd::RNGIdentifier::ActiveForceCompute,
-                                                   timestep,
-                                                   m_sysdef->getSeed()),
-                                       hoomd::Counter(ptag));
+            auto rng = draws.getStream(i % batch_size);
 
             quat<Scalar> quati(h_orientation.data[idx]);
 
@@ -39,7 +39,7 @@ struct AlchemicalParticle
         }
 
     Scalar value; //!< Alpha space dimensionless position of the particle
-    uint64_t m_nextTimestep;
+    uint64_t m_nextTimestep = UINT64_MAX; //!< Next time step integrated by an alchemostat
 
     protected:
     bool m_attached;
@@ -8,6 +8,8 @@
 #include <memory>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 #ifdef ENABLE_HIP
 #include <hip/hip_runtime.h>
@@ -17,8 +19,15 @@
 #include "hoomd/ForceCompute.h"
 
 #include "hoomd/ManagedArray.h"
+#include "hoomd/ParallelLoop.h"
 #include "hoomd/VectorMath.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 /*! \file AnisoPotentialPair.h
     \brief Defines the template class for anisotropic pair potentials
     \details The heart of the code that computes anisotropic pair potentials is in this file.
@@ -35,6 +44,27 @@ namespace hoomd
     {
 namespace md
     {
+namespace detail
+    {
+//! Test if an aniso_evaluator accepts precomputed body frames
+/*! Evaluators that support it define frame_type, a static computeFrame(orientation, shape) that
+    returns the frame of a particle, and setFrames(frame_i, frame_j). frame_type is a placeholder
+    for the other evaluators.
+*/
+template<class aniso_evaluator, class = void> struct HasBodyFrame : std::false_type
+    {
+    typedef char frame_type;
+    };
+
+template<class aniso_evaluator>
+struct HasBodyFrame<aniso_evaluator, std::void_t<typename aniso_evaluator::frame_type>>
+    : std::true_type
+    {
+    typedef typename aniso_evaluator::frame_type frame_type;
+    };
+
+    } // end namespace detail
+
 //! Template class for computing pair potentials
 /*! <b>Overview:</b>
     AnisoPotentialPair computes standard pair potentials (and forces) between all particle pairs in
@@ -62,6 +92,12 @@ namespace md
    stored in GlobalArray for easy access on the GPU by a derived class. The type of the parameters
    is defined by \a param_type in the potential aniso_evaluator class passed in. See the appropriate
    documentation for the aniso_evaluator for the definition of each element of the parameters.
+
+    Evaluating a pair converts the orientations of both particles to rotation matrices, axes, or
+   moments in the space frame. When the aniso_evaluator defines a frame_type, computeForces() builds
+   the frames of all local and ghost particles once per step and passes them to the evaluator, so
+   each orientation is converted once instead of once per neighbor. The CPU loop over the particles
+   runs on the TBB threads.
 */
 
 template<class aniso_evaluator> class AnisoPotentialPair : public ForceCompute
@@ -73,6 +109,9 @@ template<class aniso_evaluator> class AnisoPotentialPair : public ForceCompute
     //! Shape param type from aniso_evaluator
     typedef typename aniso_evaluator::shape_type shape_type;
 
+    //! Body frame type from aniso_evaluator
+    typedef typename detail::HasBodyFrame<aniso_evaluator>::frame_type frame_type;
+
     //! Construct the pair potential
     AnisoPotentialPair(std::shared_ptr<SystemDefinition> sysdef,
                        std::shared_ptr<NeighborList> nlist);
@@ -234,6 +273,9 @@ template<class aniso_evaluator> class AnisoPotentialPair : public ForceCompute
     /// r_cut (not squared) given to the neighbor list
     std::shared_ptr<GlobalArray<Scalar>> m_r_cut_nlist;
 
+    /// Body frames of the local and ghost particles, rebuilt in every computeForces()
+    std::vector<frame_type> m_frames;
+
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
     };
@@ -504,17 +546,51 @@ void AnisoPotentialPair<aniso_evaluator>::computeForces(uint64_t timestep)
 
     const BoxDim box = m_pdata->getBox();
     ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
-        {
-        // need to start from a zero force, energy and virial
-        memset(&h_force.data[0], 0, sizeof(Scalar4) * m_pdata->getN());
-        memset(&h_torque.data[0], 0, sizeof(Scalar4) * m_pdata->getN());
-        memset(&h_virial.data[0], 0, sizeof(Scalar) * m_virial.getNumElements());
 
-        PDataFlags flags = this->m_pdata->getFlags();
-        bool compute_virial = flags[pdata_flag::pressure_tensor];
+    // need to start from a zero force, energy and virial
+    memset(&h_force.data[0], 0, sizeof(Scalar4) * m_pdata->getN());
+    memset(&h_torque.data[0], 0, sizeof(Scalar4) * m_pdata->getN());
+    memset(&h_virial.data[0], 0, sizeof(Scalar) * m_virial.getNumElements());
 
+    PDataFlags flags = this->m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor];
+
+    const unsigned int N = m_pdata->getN();
+
+    // convert the orientations of the local and ghost particles to body frames once, instead of
+    // once for every pair the particle is in
+    const frame_type* frames = nullptr;
+    if constexpr (detail::HasBodyFrame<aniso_evaluator>::value)
+        {
+        const unsigned int n_frames = N + m_pdata->getNGhosts();
+        m_frames.resize(n_frames);
+        hoomd::detail::parallel_loop(
+            *m_exec_conf,
+            n_frames,
+            [&](unsigned int first, unsigned int last)
+            {
+                for (unsigned int i = first; i < last; i++)
+                    {
+                    unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+                    m_frames[i] = aniso_evaluator::computeFrame(h_orientation.data[i],
+                                                                m_shape_params[typei]);
+                    }
+            });
+        frames = m_frames.data();
+        }
+
+    // Accumulate the forces, torques, energies, and virials of the particles [begin, end) into
+    // force, torque, and virial. With the third law, this also adds the reaction to local
+    // neighbors j.
+    auto compute_range = [&](unsigned int begin,
+                             unsigned int end,
+                             Scalar4* force,
+                             Scalar4* torque,
+                             Scalar* virial,
+                             size_t virial_pitch)
+    {
         // for each particle
-        for (int i = 0; i < (int)m_pdata->getN(); i++)
+        for (unsigned int i = begin; i < end; i++)
             {
             // access the particle's position and type (MEM TRANSFER: 4 scalars)
             Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
@@ -582,7 +658,7 @@ void AnisoPotentialPair<aniso_evaluator>::computeForces(uint64_t timestep)
                     energy_shift = true;
 
                 // compute the force and potential energy
-                Scalar3 force = make_scalar3(0.0, 0.0, 0.0);
+                Scalar3 pair_force = make_scalar3(0.0, 0.0, 0.0);
                 Scalar3 torque_i = make_scalar3(0.0, 0.0, 0.0);
                 Scalar3 torque_j = make_scalar3(0.0, 0.0, 0.0);
 
@@ -596,18 +672,21 @@ void AnisoPotentialPair<aniso_evaluator>::computeForces(uint64_t timestep)
                     eval.setShape(&m_shape_params[typei], &m_shape_params[typej]);
                 if (aniso_evaluator::needsTags())
                     eval.setTags(h_tag.data[i], h_tag.data[j]);
+                if constexpr (detail::HasBodyFrame<aniso_evaluator>::value)
+                    eval.setFrames(&frames[i], &frames[j]);
 
-                bool evaluated = eval.evaluate(force, pair_eng, energy_shift, torque_i, torque_j);
+                bool evaluated
+                    = eval.evaluate(pair_force, pair_eng, energy_shift, torque_i, torque_j);
 
                 if (evaluated)
                     {
-                    Scalar3 force2 = Scalar(0.5) * force;
+                    Scalar3 force2 = Scalar(0.5) * pair_force;
 
                     // add the force, potential energy and virial to the particle i
                     // (FLOPS: 8)
-                    fxi += force.x;
-                    fyi += force.y;
-                    fzi += force.z;
+                    fxi += pair_force.x;
+                    fyi += pair_force.y;
+                    fzi += pair_force.z;
                     txi += torque_i.x;
                     tyi += torque_i.y;
                     tzi += torque_i.z;
@@ -624,47 +703,139 @@ void AnisoPotentialPair<aniso_evaluator>::computeForces(uint64_t timestep)
                         }
 
                     // add the force to particle j if we are using the third law (MEM TRANSFER: 10
-                    // scalars / FLOPS: 8)
-                    if (third_law)
+                    // scalars / FLOPS: 8) only add force to local particles
+                    if (third_law && j < N)
                         {
-                        h_force.data[j].x -= force.x;
-                        h_force.data[j].y -= force.y;
-                        h_force.data[j].z -= force.z;
-                        h_torque.data[j].x += torque_j.x;
-                        h_torque.data[j].y += torque_j.y;
-                        h_torque.data[j].z += torque_j.z;
-                        h_force.data[j].w += pair_eng * Scalar(0.5);
+                        force[j].x -= pair_force.x;
+                        force[j].y -= pair_force.y;
+                        force[j].z -= pair_force.z;
+                        torque[j].x += torque_j.x;
+                        torque[j].y += torque_j.y;
+                        torque[j].z += torque_j.z;
+                        force[j].w += pair_eng * Scalar(0.5);
                         if (compute_virial)
                             {
-                            h_virial.data[0 * m_virial_pitch + j] += dx.x * force2.x;
-                            h_virial.data[1 * m_virial_pitch + j] += dx.y * force2.x;
-                            h_virial.data[2 * m_virial_pitch + j] += dx.z * force2.x;
-                            h_virial.data[3 * m_virial_pitch + j] += dx.y * force2.y;
-                            h_virial.data[4 * m_virial_pitch + j] += dx.z * force2.y;
-                            h_virial.data[5 * m_virial_pitch + j] += dx.z * force2.z;
+                            virial[0 * virial_pitch + j] += dx.x * force2.x;
+                            virial[1 * virial_pitch + j] += dx.y * force2.x;
+                            virial[2 * virial_pitch + j] += dx.z * force2.x;
+                            virial[3 * virial_pitch + j] += dx.y * force2.y;
+                            virial[4 * virial_pitch + j] += dx.z * force2.y;
+                            virial[5 * virial_pitch + j] += dx.z * force2.z;
                             }
                         }
                     }
                 }
 
             // finally, increment the force, potential energy and virial for particle i
-            h_force.data[i].x += fxi;
-            h_force.data[i].y += fyi;
-            h_force.data[i].z += fzi;
-            h_torque.data[i].x += txi;
-            h_torque.data[i].y += tyi;
-            h_torque.data[i].z += tzi;
-            h_force.data[i].w += pei;
+            force[i].x += fxi;
+            force[i].y += fyi;
+            force[i].z += fzi;
+            torque[i].x += txi;
+            torque[i].y += tyi;
+            torque[i].z += tzi;
+            force[i].w += pei;
             if (compute_virial)
                 {
-                h_virial.data[0 * m_virial_pitch + i] += virialxxi;
-                h_virial.data[1 * m_virial_pitch + i] += virialxyi;
-                h_virial.data[2 * m_virial_pitch + i] += virialxzi;
-                h_virial.data[3 * m_virial_pitch + i] += virialyyi;
-                h_virial.data[4 * m_virial_pitch + i] += virialyzi;
-                h_virial.data[5 * m_virial_pitch + i] += virialzzi;
+                virial[0 * virial_pitch + i] += virialxxi;
+                virial[1 * virial_pitch + i] += virialxyi;
+                virial[2 * virial_pitch + i] += virialxzi;
+                virial[3 * virial_pitch + i] += virialyyi;
+                virial[4 * virial_pitch + i] += virialyzi;
+                virial[5 * virial_pitch + i] += virialzzi;
                 }
             }
+    };
+
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                if (!third_law)
+                    {
+                    // with a full neighbor list, each thread only writes to its own particles
+                    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                                      [&](const tbb::blocked_range<unsigned int>& r)
+                                      {
+                                          compute_range(r.begin(),
+                                                        r.end(),
+                                                        h_force.data,
+                                                        h_torque.data,
+                                                        h_virial.data,
+                                                        m_virial_pitch);
+                                      });
+                    return;
+                    }
+
+                // with a half neighbor list, the reactions on j race between threads:
+                // accumulate into per-thread arrays and reduce them afterwards
+                const unsigned int n_virial = compute_virial ? 6 * N : 0;
+                tbb::enumerable_thread_specific<std::vector<Scalar4>> thread_force(
+                    N,
+                    make_scalar4(0, 0, 0, 0));
+                tbb::enumerable_thread_specific<std::vector<Scalar4>> thread_torque(
+                    N,
+                    make_scalar4(0, 0, 0, 0));
+                tbb::enumerable_thread_specific<std::vector<Scalar>> thread_virial(n_virial,
+                                                                                   Scalar(0.0));
+
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  {
+                                      compute_range(r.begin(),
+                                                    r.end(),
+                                                    thread_force.local().data(),
+                                                    thread_torque.local().data(),
+                                                    thread_virial.local().data(),
+                                                    N);
+                                  });
+
+                tbb::parallel_for(
+                    tbb::blocked_range<unsigned int>(0, N),
+                    [&](const tbb::blocked_range<unsigned int>& r)
+                    {
+                        for (const auto& f : thread_force)
+                            {
+                            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                {
+                                h_force.data[i].x += f[i].x;
+                                h_force.data[i].y += f[i].y;
+                                h_force.data[i].z += f[i].z;
+                                h_force.data[i].w += f[i].w;
+                                }
+                            }
+
+                        for (const auto& t : thread_torque)
+                            {
+                            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                {
+                                h_torque.data[i].x += t[i].x;
+                                h_torque.data[i].y += t[i].y;
+                                h_torque.data[i].z += t[i].z;
+                                }
+                            }
+
+                        if (!compute_virial)
+                            return;
+
+                        for (const auto& v : thread_virial)
+                            {
+                            for (unsigned int k = 0; k < 6; k++)
+                                {
+                                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                    {
+                                    h_virial.data[k * m_virial_pitch + i] += v[k * N + i];
+                                    }
+                                }
+                            }
+                    });
+            });
+        }
+    else
+#endif
+        {
+        compute_range(0, N, h_force.data, h_torque.data, h_virial.data, m_virial_pitch);
         }
     }
 
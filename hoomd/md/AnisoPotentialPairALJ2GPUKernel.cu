@@ -15,6 +15,13 @@ gpu_compute_pair_aniso_forces<EvaluatorPairALJ<2>>(
     const a_pair_args_t& pair_args,
     const EvaluatorPairALJ<2>::param_type* d_param,
     const EvaluatorPairALJ<2>::shape_type* d_shape_param);
+
+template hipError_t __attribute__((visibility("default")))
+gpu_compute_pair_aniso_forces_queue<EvaluatorPairALJ<2>>(
+    const a_pair_args_t& pair_args,
+    const a_pair_queue_args_t& queue_args,
+    const EvaluatorPairALJ<2>::param_type* d_param,
+    const EvaluatorPairALJ<2>::shape_type* d_shape_param);
     } // end namespace kernel
     } // end namespace md
     } // end namespace hoomd
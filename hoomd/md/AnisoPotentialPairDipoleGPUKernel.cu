@@ -15,6 +15,13 @@ gpu_compute_pair_aniso_forces<EvaluatorPairDipole>(
     const a_pair_args_t& pair_args,
     const EvaluatorPairDipole::param_type* d_param,
     const EvaluatorPairDipole::shape_type* d_shape_param);
+
+template hipError_t __attribute__((visibility("default")))
+gpu_compute_pair_aniso_forces_queue<EvaluatorPairDipole>(
+    const a_pair_args_t& pair_args,
+    const a_pair_queue_args_t& queue_args,
+    const EvaluatorPairDipole::param_type* d_param,
+    const EvaluatorPairDipole::shape_type* d_shape_param);
     } // end namespace kernel
     } // end namespace md
     } // end namespace hoomd
@@ -14,6 +14,13 @@ template hipError_t __attribute__((visibility("default")))
 gpu_compute_pair_aniso_forces<EvaluatorPairGB>(const a_pair_args_t& pair_args,
                                                const EvaluatorPairGB::param_type* d_param,
                                                const EvaluatorPairGB::shape_type* d_shape_param);
+
+template hipError_t __attribute__((visibility("default")))
+gpu_compute_pair_aniso_forces_queue<EvaluatorPairGB>(
+    const a_pair_args_t& pair_args,
+    const a_pair_queue_args_t& queue_args,
+    const EvaluatorPairGB::param_type* d_param,
+    const EvaluatorPairGB::shape_type* d_shape_param);
     } // end namespace kernel
     } // end namespace md
     } // end namespace hoomd
@@ -0,0 +1,287 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "AnisoPotentialPairGPU.cuh"
+
+#include <hipcub/hipcub.hpp>
+
+#include <assert.h>
+
+/*! \file AnisoPotentialPairGPU.cu
+    \brief Defines the GPU kernels that build and reduce the pair queue of AnisoPotentialPairGPU
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Kernel for counting or listing the pairs within the cutoff
+/*! \param d_pair_count Number of pairs of each particle (written when \a fill is false)
+    \param d_pair_offset Index of the first pair of each particle (read when \a fill is true)
+    \param d_pair_i Particle i of each pair (written when \a fill is true)
+    \param d_pair_j Particle j of each pair (written when \a fill is true)
+    \param N number of particles
+    \param d_pos particle positions
+    \param box Box dimensions used to implement periodic boundary conditions
+    \param d_n_neigh Device memory array listing the number of neighbors for each particle
+    \param d_nlist Device memory array containing the neighbor list contents
+    \param d_head_list Device memory array listing beginning of each particle's neighbors
+    \param d_rcutsq rcut squared, stored per type pair
+    \param ntypes Number of types in the simulation
+
+    \tparam fill When false, count the pairs. When true, write them to the queue in neighbor list
+    order.
+
+    The count pass also sets d_pair_count[N] to 0, so that the exclusive scan of the N+1 counts
+    yields the total number of pairs in its last element.
+*/
+template<bool fill>
+__global__ void gpu_aniso_pair_queue_kernel(unsigned int* d_pair_count,
+                                            const unsigned int* d_pair_offset,
+                                            unsigned int* d_pair_i,
+                                            unsigned int* d_pair_j,
+                                            const unsigned int N,
+                                            const Scalar4* d_pos,
+                                            const BoxDim box,
+                                            const unsigned int* d_n_neigh,
+                                            const unsigned int* d_nlist,
+                                            const size_t* d_head_list,
+                                            const Scalar* d_rcutsq,
+                                            const unsigned int ntypes)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx > N)
+        return;
+
+    if (idx == N)
+        {
+        if (!fill)
+            d_pair_count[N] = 0;
+        return;
+        }
+
+    Index2D typpair_idx(ntypes);
+
+    Scalar4 postypei = __ldg(d_pos + idx);
+    Scalar3 posi = make_scalar3(postypei.x, postypei.y, postypei.z);
+    unsigned int typei = __scalar_as_int(postypei.w);
+
+    unsigned int n_neigh = d_n_neigh[idx];
+    size_t my_head = d_head_list[idx];
+    unsigned int n_pairs = 0;
+    unsigned int first_pair = fill ? d_pair_offset[idx] : 0;
+
+    for (unsigned int neigh_idx = 0; neigh_idx < n_neigh; neigh_idx++)
+        {
+        unsigned int cur_j = __ldg(d_nlist + my_head + neigh_idx);
+
+        Scalar4 postypej = __ldg(d_pos + cur_j);
+        Scalar3 dx = posi - make_scalar3(postypej.x, postypej.y, postypej.z);
+        dx = box.minImage(dx);
+
+        Scalar rcutsq = __ldg(d_rcutsq + typpair_idx(typei, __scalar_as_int(postypej.w)));
+        if (dot(dx, dx) <= rcutsq)
+            {
+            if (fill)
+                {
+                d_pair_i[first_pair + n_pairs] = idx;
+                d_pair_j[first_pair + n_pairs] = cur_j;
+                }
+            n_pairs++;
+            }
+        }
+
+    if (!fill)
+        d_pair_count[idx] = n_pairs;
+    }
+
+//! Kernel for summing the pair queue results of each particle
+/*! \param d_force Device memory to write computed forces
+    \param d_torque Device memory to write computed torques
+    \param d_virial Device memory to write computed virials
+    \param virial_pitch pitch of 2D virial array
+    \param N number of particles
+    \param d_pair_offset Index of the first pair of each particle
+    \param d_pair_force Force and half the energy on i of each pair
+    \param d_pair_torque Torque on i of each pair
+    \param d_pair_virial Virial contribution of each pair
+    \param pair_virial_pitch pitch of 2D pair virial array
+    \param compute_virial When non-zero, the virial tensor is computed
+
+    Each thread sums the pairs of one particle in order, so the results do not depend on the
+    launch configuration.
+*/
+__global__ void gpu_reduce_aniso_pair_queue_kernel(Scalar4* d_force,
+                                                   Scalar4* d_torque,
+                                                   Scalar* d_virial,
+                                                   const size_t virial_pitch,
+                                                   const unsigned int N,
+                                                   const unsigned int* d_pair_offset,
+                                                   const Scalar4* d_pair_force,
+                                                   const Scalar4* d_pair_torque,
+                                                   const Scalar* d_pair_virial,
+                                                   const size_t pair_virial_pitch,
+                                                   const unsigned int compute_virial)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    Scalar4 force = make_scalar4(Scalar(0), Scalar(0), Scalar(0), Scalar(0));
+    Scalar4 torque = make_scalar4(Scalar(0), Scalar(0), Scalar(0), Scalar(0));
+    Scalar virial[6] = {Scalar(0), Scalar(0), Scalar(0), Scalar(0), Scalar(0), Scalar(0)};
+
+    unsigned int first_pair = d_pair_offset[idx];
+    unsigned int last_pair = d_pair_offset[idx + 1];
+    for (unsigned int pair_idx = first_pair; pair_idx < last_pair; pair_idx++)
+        {
+        Scalar4 f = d_pair_force[pair_idx];
+        Scalar4 t = d_pair_torque[pair_idx];
+        force.x += f.x;
+        force.y += f.y;
+        force.z += f.z;
+        force.w += f.w;
+        torque.x += t.x;
+        torque.y += t.y;
+        torque.z += t.z;
+
+        if (compute_virial)
+            {
+            for (unsigned int k = 0; k < 6; k++)
+                virial[k] += d_pair_virial[k * pair_virial_pitch + pair_idx];
+            }
+        }
+
+    d_force[idx] = force;
+    d_torque[idx] = torque;
+
+    if (compute_virial)
+        {
+        for (unsigned int k = 0; k < 6; k++)
+            d_virial[k * virial_pitch + idx] = virial[k];
+        }
+    }
+
+/*! \param pair_args Arguments of the pair force computation
+    \param d_pair_count Temporary storage for the number of pairs of each particle (N+1 entries)
+    \param d_pair_offset Index of the first pair of each particle (N+1 entries)
+    \param n_pairs Set to the total number of pairs
+    \param alloc Caching allocator for temporary storage
+*/
+hipError_t gpu_count_aniso_pairs(const a_pair_args_t& pair_args,
+                                 unsigned int* d_pair_count,
+                                 unsigned int* d_pair_offset,
+                                 unsigned int& n_pairs,
+                                 CachedAllocator& alloc)
+    {
+    assert(d_pair_count);
+    assert(d_pair_offset);
+
+    unsigned int block_size = pair_args.block_size;
+    unsigned int n_blocks = (pair_args.N + 1) / block_size + 1;
+
+    hipLaunchKernelGGL((gpu_aniso_pair_queue_kernel<false>),
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       d_pair_count,
+                       nullptr,
+                       nullptr,
+                       nullptr,
+                       pair_args.N,
+                       pair_args.d_pos,
+                       pair_args.box,
+                       pair_args.d_n_neigh,
+                       pair_args.d_nlist,
+                       pair_args.d_head_list,
+                       pair_args.d_rcutsq,
+                       pair_args.ntypes);
+
+    // compute the offsets, the last element is the total number of pairs
+    void* d_temp_storage = NULL;
+    size_t temp_storage_bytes = 0;
+
+    hipcub::DeviceScan::ExclusiveSum(d_temp_storage,
+                                     temp_storage_bytes,
+                                     d_pair_count,
+                                     d_pair_offset,
+                                     pair_args.N + 1);
+
+    d_temp_storage = alloc.getTemporaryBuffer<char>(temp_storage_bytes);
+    hipcub::DeviceScan::ExclusiveSum(d_temp_storage,
+                                     temp_storage_bytes,
+                                     d_pair_count,
+                                     d_pair_offset,
+                                     pair_args.N + 1);
+    alloc.deallocate((char*)d_temp_storage);
+
+    hipMemcpy(&n_pairs, d_pair_offset + pair_args.N, sizeof(unsigned int), hipMemcpyDeviceToHost);
+
+    return hipSuccess;
+    }
+
+/*! \param pair_args Arguments of the pair force computation
+    \param queue_args The pair queue, sized for the number of pairs from gpu_count_aniso_pairs()
+*/
+hipError_t gpu_fill_aniso_pair_queue(const a_pair_args_t& pair_args,
+                                     const a_pair_queue_args_t& queue_args)
+    {
+    unsigned int block_size = pair_args.block_size;
+    unsigned int n_blocks = pair_args.N / block_size + 1;
+
+    hipLaunchKernelGGL((gpu_aniso_pair_queue_kernel<true>),
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       nullptr,
+                       queue_args.d_pair_offset,
+                       queue_args.d_pair_i,
+                       queue_args.d_pair_j,
+                       pair_args.N,
+                       pair_args.d_pos,
+                       pair_args.box,
+                       pair_args.d_n_neigh,
+                       pair_args.d_nlist,
+                       pair_args.d_head_list,
+                       pair_args.d_rcutsq,
+                       pair_args.ntypes);
+
+    return hipSuccess;
+    }
+
+/*! \param pair_args Arguments of the pair force computation
+    \param queue_args The pair queue with the evaluated pairs
+*/
+hipError_t gpu_reduce_aniso_pair_queue(const a_pair_args_t& pair_args,
+                                       const a_pair_queue_args_t& queue_args)
+    {
+    unsigned int block_size = pair_args.block_size;
+    unsigned int n_blocks = pair_args.N / block_size + 1;
+
+    hipLaunchKernelGGL((gpu_reduce_aniso_pair_queue_kernel),
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       pair_args.d_force,
+                       pair_args.d_torque,
+                       pair_args.d_virial,
+                       pair_args.virial_pitch,
+                       pair_args.N,
+                       queue_args.d_pair_offset,
+                       queue_args.d_pair_force,
+                       queue_args.d_pair_torque,
+                       queue_args.d_pair_virial,
+                       queue_args.pair_virial_pitch,
+                       pair_args.compute_virial);
+
+    return hipSuccess;
+    }
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
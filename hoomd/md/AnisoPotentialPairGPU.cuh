@@ -5,6 +5,7 @@
 // Copyright (c) 2009-2021 The Regents of the University of Michigan
 // This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
 
+#include "hoomd/CachedAllocator.h"
 #include "hoomd/GPUPartition.cuh"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/Index1D.h"
@@ -99,8 +100,129 @@ struct a_pair_args_t
                              //!< stream
     };
 
+//! Wraps the arrays of the pair queue variant of the anisotropic pair force kernels
+/*! The pair queue lists the pairs (i, j) in the neighbor list that are within the cutoff, sorted by
+    i. The pairs of particle i are at d_pair_offset[i] to d_pair_offset[i+1]-1. The evaluation
+    kernel computes one pair per thread and stores the force, energy, torque, and virial on i for
+    each pair. A second kernel sums them for each particle.
+*/
+struct a_pair_queue_args_t
+    {
+    //! Construct a a_pair_queue_args_t
+    a_pair_queue_args_t(const unsigned int* _d_pair_offset,
+                        unsigned int* _d_pair_i,
+                        unsigned int* _d_pair_j,
+                        Scalar4* _d_pair_force,
+                        Scalar4* _d_pair_torque,
+                        Scalar* _d_pair_virial,
+                        const size_t _pair_virial_pitch,
+                        const unsigned int _n_pairs)
+        : d_pair_offset(_d_pair_offset), d_pair_i(_d_pair_i), d_pair_j(_d_pair_j),
+          d_pair_force(_d_pair_force), d_pair_torque(_d_pair_torque),
+          d_pair_virial(_d_pair_virial), pair_virial_pitch(_pair_virial_pitch),
+          n_pairs(_n_pairs) {};
+
+    const unsigned int* d_pair_offset; //!< Index of the first pair of each particle (N+1 entries)
+    unsigned int* d_pair_i;            //!< Particle i of each pair
+    unsigned int* d_pair_j;            //!< Particle j of each pair
+    Scalar4* d_pair_force;             //!< Force and half the energy on i of each pair
+    Scalar4* d_pair_torque;            //!< Torque on i of each pair
+    Scalar* d_pair_virial;             //!< Virial contribution of each pair
+    const size_t pair_virial_pitch;    //!< The pitch of the 2D array of pair virials
+    const unsigned int n_pairs;        //!< Number of pairs in the queue
+    };
+
+//! Count the pairs within the cutoff and compute the offsets of each particle's pairs
+hipError_t gpu_count_aniso_pairs(const a_pair_args_t& pair_args,
+                                 unsigned int* d_pair_count,
+                                 unsigned int* d_pair_offset,
+                                 unsigned int& n_pairs,
+                                 CachedAllocator& alloc);
+
+//! Write the pairs within the cutoff to the pair queue
+hipError_t gpu_fill_aniso_pair_queue(const a_pair_args_t& pair_args,
+                                     const a_pair_queue_args_t& queue_args);
+
+//! Sum the forces, torques, and virials of each particle's pairs
+hipError_t gpu_reduce_aniso_pair_queue(const a_pair_args_t& pair_args,
+                                       const a_pair_queue_args_t& queue_args);
+
 #ifdef __HIPCC__
 
+//! Load the per type pair parameters and per type shapes into shared memory
+/*! \param s_data Dynamic shared memory of the kernel
+    \param d_params Parameters for the potential, stored per type pair
+    \param d_shape_params Shape parameters, stored per type
+    \param d_rcutsq rcut squared, stored per type pair
+    \param ntypes Number of types in the simulation
+    \param max_extra_bytes Shared memory available to the parameters' extra data
+    \param s_params Set to the parameters in shared memory
+    \param s_rcutsq Set to rcut squared in shared memory
+    \param s_shape_params Set to the shape parameters in shared memory
+
+    All threads in the block must call this function.
+*/
+template<class evaluator>
+__device__ void load_aniso_pair_parameters(char* s_data,
+                                           const typename evaluator::param_type* d_params,
+                                           const typename evaluator::shape_type* d_shape_params,
+                                           const Scalar* d_rcutsq,
+                                           const unsigned int ntypes,
+                                           unsigned int max_extra_bytes,
+                                           typename evaluator::param_type*& s_params,
+                                           Scalar*& s_rcutsq,
+                                           typename evaluator::shape_type*& s_shape_params)
+    {
+    Index2D typpair_idx(ntypes);
+    const unsigned int num_typ_parameters = typpair_idx.getNumElements();
+
+    s_params = (typename evaluator::param_type*)(&s_data[0]);
+    s_rcutsq = (Scalar*)(&s_data[num_typ_parameters * sizeof(typename evaluator::param_type)]);
+    s_shape_params = (typename evaluator::shape_type*)(&s_rcutsq[num_typ_parameters]);
+
+    // load in the per type pair parameters
+    for (unsigned int cur_offset = 0; cur_offset < num_typ_parameters; cur_offset += blockDim.x)
+        {
+        if (cur_offset + threadIdx.x < num_typ_parameters)
+            {
+            s_rcutsq[cur_offset + threadIdx.x] = d_rcutsq[cur_offset + threadIdx.x];
+            }
+        }
+
+    unsigned int param_size
+        = num_typ_parameters * sizeof(typename evaluator::param_type) / sizeof(int);
+    for (unsigned int cur_offset = 0; cur_offset < param_size; cur_offset += blockDim.x)
+        {
+        if (cur_offset + threadIdx.x < param_size)
+            {
+            ((int*)s_params)[cur_offset + threadIdx.x] = ((int*)d_params)[cur_offset + threadIdx.x];
+            }
+        }
+
+    unsigned int shape_param_size = sizeof(typename evaluator::shape_type) * ntypes / sizeof(int);
+    for (unsigned int cur_offset = 0; cur_offset < shape_param_size; cur_offset += blockDim.x)
+        {
+        if (cur_offset + threadIdx.x < shape_param_size)
+            {
+            ((int*)s_shape_params)[cur_offset + threadIdx.x]
+                = ((int*)d_shape_params)[cur_offset + threadIdx.x];
+            }
+        }
+    __syncthreads();
+
+    // initialize extra shared mem
+    char* s_extra = (char*)(s_shape_params + ntypes);
+
+    unsigned int available_bytes = max_extra_bytes;
+    for (unsigned int cur_pair = 0; cur_pair < num_typ_parameters; ++cur_pair)
+        s_params[cur_pair].load_shared(s_extra, available_bytes);
+
+    for (unsigned int cur_type = 0; cur_type < ntypes; ++cur_type)
+        s_shape_params[cur_type].load_shared(s_extra, available_bytes);
+
+    __syncthreads();
+    }
+
 //! Kernel for calculating pair forces
 /*! This kernel is called to calculate the pair forces on all N particles. Actual evaluation of the
    potentials and forces for each pair is handled via the template class \a evaluator.
@@ -163,55 +285,21 @@ gpu_compute_pair_aniso_forces_kernel(Scalar4* d_force,
                                      unsigned int max_extra_bytes)
     {
     Index2D typpair_idx(ntypes);
-    const unsigned int num_typ_parameters = typpair_idx.getNumElements();
 
     // shared arrays for per type pair parameters
     HIP_DYNAMIC_SHARED(char, s_data)
-    typename evaluator::param_type* s_params = (typename evaluator::param_type*)(&s_data[0]);
-    Scalar* s_rcutsq
-        = (Scalar*)(&s_data[num_typ_parameters * sizeof(typename evaluator::param_type)]);
-    typename evaluator::shape_type* s_shape_params
-        = (typename evaluator::shape_type*)(&s_rcutsq[num_typ_parameters]);
-
-    // load in the per type pair parameters
-    for (unsigned int cur_offset = 0; cur_offset < num_typ_parameters; cur_offset += blockDim.x)
-        {
-        if (cur_offset + threadIdx.x < num_typ_parameters)
-            {
-            s_rcutsq[cur_offset + threadIdx.x] = d_rcutsq[cur_offset + threadIdx.x];
-            }
-        }
-
-    unsigned int param_size
-        = num_typ_parameters * sizeof(typename evaluator::param_type) / sizeof(int);
-    for (unsigned int cur_offset = 0; cur_offset < param_size; cur_offset += blockDim.x)
-        {
-        if (cur_offset + threadIdx.x < param_size)
-            {
-            ((int*)s_params)[cur_offset + threadIdx.x] = ((int*)d_params)[cur_offset + threadIdx.x];
-            }
-        }
-
-    unsigned int shape_param_size = sizeof(typename evaluator::shape_type) * ntypes / sizeof(int);
-    for (unsigned int cur_offset = 0; cur_offset < shape_param_size; cur_offset += blockDim.x)
-        {
-        if (cur_offset + threadIdx.x < shape_param_size)
-            {
-            ((int*)s_shape_params)[cur_offset + threadIdx.x]
-                = ((int*)d_shape_params)[cur_offset + threadIdx.x];
-            }
-        }
-    __syncthreads();
-
-    // initialize extra shared mem
-    char* s_extra = (char*)(s_shape_params + ntypes);
-
-    unsigned int available_bytes = max_extra_bytes;
-    for (unsigned int cur_pair = 0; cur_pair < typpair_idx.getNumElements(); ++cur_pair)
-        s_params[cur_pair].load_shared(s_extra, available_bytes);
-
-    for (unsigned int cur_type = 0; cur_type < ntypes; ++cur_type)
-        s_shape_params[cur_type].load_shared(s_extra, available_bytes);
+    typename evaluator::param_type* s_params;
+    Scalar* s_rcutsq;
+    typename evaluator::shape_type* s_shape_params;
+    load_aniso_pair_parameters<evaluator>(s_data,
+                                          d_params,
+                                          d_shape_params,
+                                          d_rcutsq,
+                                          ntypes,
+                                          max_extra_bytes,
+                                          s_params,
+                                          s_rcutsq,
+                                          s_shape_params);
 
     // start by identifying which particle we are to handle
     unsigned int idx;
@@ -385,6 +473,165 @@ gpu_compute_pair_aniso_forces_kernel(Scalar4* d_force,
         }
     }
 
+//! Kernel for calculating the pair forces in the pair queue
+/*! \param d_pair_force Device memory to write the force and half the energy on i of each pair
+    \param d_pair_torque Device memory to write the torque on i of each pair
+    \param d_pair_virial Device memory to write the virial contribution of each pair
+    \param pair_virial_pitch pitch of 2D pair virial array
+    \param n_pairs Number of pairs in the queue
+    \param d_pair_i Particle i of each pair
+    \param d_pair_j Particle j of each pair
+    \param d_pos particle positions
+    \param d_charge particle charges
+    \param d_orientation Quaternion data on the GPU to calculate forces on
+    \param d_tag Tag data on the GPU to calculate forces on
+    \param box Box dimensions used to implement periodic boundary conditions
+    \param d_params Parameters for the potential, stored per type pair
+    \param d_shape_params Shape parameters, stored per type
+    \param d_rcutsq rcut squared, stored per type pair
+    \param ntypes Number of types in the simulation
+    \param max_extra_bytes Shared memory available to the parameters' extra data
+
+    Each thread evaluates one pair. Unlike gpu_compute_pair_aniso_forces_kernel(), all threads in a
+    warp evaluate pairs within the cutoff, and the work per particle does not depend on its number
+    of neighbors. This pays off when a single evaluation is expensive and divergent.
+*/
+template<class evaluator, unsigned int shift_mode, unsigned int compute_virial>
+__global__ void
+gpu_compute_pair_aniso_queue_kernel(Scalar4* d_pair_force,
+                                    Scalar4* d_pair_torque,
+                                    Scalar* d_pair_virial,
+                                    const size_t pair_virial_pitch,
+                                    const unsigned int n_pairs,
+                                    const unsigned int* d_pair_i,
+                                    const unsigned int* d_pair_j,
+                                    const Scalar4* d_pos,
+                                    const Scalar* d_charge,
+                                    const Scalar4* d_orientation,
+                                    const unsigned int* d_tag,
+                                    const BoxDim box,
+                                    const typename evaluator::param_type* d_params,
+                                    const typename evaluator::shape_type* d_shape_params,
+                                    const Scalar* d_rcutsq,
+                                    const unsigned int ntypes,
+                                    unsigned int max_extra_bytes)
+    {
+    Index2D typpair_idx(ntypes);
+
+    // shared arrays for per type pair parameters
+    HIP_DYNAMIC_SHARED(char, s_data)
+    typename evaluator::param_type* s_params;
+    Scalar* s_rcutsq;
+    typename evaluator::shape_type* s_shape_params;
+    load_aniso_pair_parameters<evaluator>(s_data,
+                                          d_params,
+                                          d_shape_params,
+                                          d_rcutsq,
+                                          ntypes,
+                                          max_extra_bytes,
+                                          s_params,
+                                          s_rcutsq,
+                                          s_shape_params);
+
+    unsigned int pair_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (pair_idx >= n_pairs)
+        return;
+
+    unsigned int i = __ldg(d_pair_i + pair_idx);
+    unsigned int j = __ldg(d_pair_j + pair_idx);
+
+    Scalar4 postypei = __ldg(d_pos + i);
+    Scalar4 postypej = __ldg(d_pos + j);
+    Scalar3 dx = make_scalar3(postypei.x - postypej.x,
+                              postypei.y - postypej.y,
+                              postypei.z - postypej.z);
+    dx = box.minImage(dx);
+
+    unsigned int typei = __scalar_as_int(postypei.w);
+    unsigned int typej = __scalar_as_int(postypej.w);
+    unsigned int typpair = typpair_idx(typei, typej);
+
+    Scalar3 jforce = {Scalar(0), Scalar(0), Scalar(0)};
+    Scalar3 torquei = {Scalar(0), Scalar(0), Scalar(0)};
+    Scalar3 torquej = {Scalar(0), Scalar(0), Scalar(0)};
+    Scalar pair_eng = Scalar(0);
+
+    evaluator eval(dx,
+                   __ldg(d_orientation + i),
+                   __ldg(d_orientation + j),
+                   s_rcutsq[typpair],
+                   s_params[typpair]);
+    if (evaluator::needsCharge())
+        eval.setCharge(__ldg(d_charge + i), __ldg(d_charge + j));
+    if (evaluator::needsShape())
+        eval.setShape(&(s_shape_params[typei]), &(s_shape_params[typej]));
+    if (evaluator::needsTags())
+        eval.setTags(__ldg(d_tag + i), __ldg(d_tag + j));
+
+    eval.evaluate(jforce, pair_eng, shift_mode == 1, torquei, torquej);
+
+    // potential energy per particle must be halved
+    d_pair_force[pair_idx] = make_scalar4(jforce.x, jforce.y, jforce.z, Scalar(0.5) * pair_eng);
+    d_pair_torque[pair_idx] = make_scalar4(torquei.x, torquei.y, torquei.z, Scalar(0));
+
+    if (compute_virial)
+        {
+        Scalar3 jforce2 = Scalar(0.5) * jforce;
+        d_pair_virial[0 * pair_virial_pitch + pair_idx] = dx.x * jforce2.x;
+        d_pair_virial[1 * pair_virial_pitch + pair_idx] = dx.y * jforce2.x;
+        d_pair_virial[2 * pair_virial_pitch + pair_idx] = dx.z * jforce2.x;
+        d_pair_virial[3 * pair_virial_pitch + pair_idx] = dx.y * jforce2.y;
+        d_pair_virial[4 * pair_virial_pitch + pair_idx] = dx.z * jforce2.y;
+        d_pair_virial[5 * pair_virial_pitch + pair_idx] = dx.z * jforce2.z;
+        }
+    }
+
+//! Compute the dynamic shared memory of the anisotropic pair force kernels
+/*! \param pair_args Other arguments passed onto the kernel
+    \param params Parameters for the potential, stored per type pair
+    \param shape_params Shape parameters, stored per type
+    \param attr Attributes of the kernel
+    \param max_extra_bytes Set to the shared memory available to the parameters' extra data
+    \returns The number of bytes of dynamic shared memory to launch the kernel with
+*/
+template<class evaluator>
+size_t aniso_pair_shared_bytes(const a_pair_args_t& pair_args,
+                               const typename evaluator::param_type* params,
+                               const typename evaluator::shape_type* shape_params,
+                               const hipFuncAttributes& attr,
+                               unsigned int& max_extra_bytes)
+    {
+    Index2D typpair_idx(pair_args.ntypes);
+    size_t shared_bytes = (2 * sizeof(Scalar) + sizeof(typename evaluator::param_type))
+                              * typpair_idx.getNumElements()
+                          + sizeof(typename evaluator::shape_type) * pair_args.ntypes;
+
+    unsigned int base_shared_bytes;
+    base_shared_bytes = (unsigned int)(shared_bytes + attr.sharedSizeBytes);
+
+    if (base_shared_bytes > pair_args.devprop.sharedMemPerBlock)
+        {
+        throw std::runtime_error("Pair potential parameters exceed the available shared "
+                                 "memory per block.");
+        }
+
+    max_extra_bytes = (unsigned int)(pair_args.devprop.sharedMemPerBlock - base_shared_bytes);
+
+    // determine dynamically requested shared memory
+    char* ptr = (char*)nullptr;
+    unsigned int available_bytes = max_extra_bytes;
+    for (unsigned int i = 0; i < typpair_idx.getNumElements(); ++i)
+        {
+        params[i].allocate_shared(ptr, available_bytes);
+        }
+    for (unsigned int i = 0; i < pair_args.ntypes; ++i)
+        {
+        shape_params[i].allocate_shared(ptr, available_bytes);
+        }
+
+    return shared_bytes + (max_extra_bytes - available_bytes);
+    }
+
 //! Aniso pair force compute kernel launcher
 /*!
  * \tparam evaluator EvaluatorPair class to evaluate V(r) and -delta V(r)/r
@@ -419,11 +666,6 @@ struct AnisoPairForceComputeKernel
             {
             unsigned int block_size = pair_args.block_size;
 
-            Index2D typpair_idx(pair_args.ntypes);
-            size_t shared_bytes = (2 * sizeof(Scalar) + sizeof(typename evaluator::param_type))
-                                      * typpair_idx.getNumElements()
-                                  + sizeof(typename evaluator::shape_type) * pair_args.ntypes;
-
             unsigned int max_block_size;
             hipFuncAttributes attr;
             hipFuncGetAttributes(
@@ -436,32 +678,12 @@ struct AnisoPairForceComputeKernel
             // number of threads has to be multiple of warp size
             max_block_size = max_threads - max_threads % gpu_aniso_pair_force_max_tpp;
 
-            unsigned int base_shared_bytes;
-            base_shared_bytes = (unsigned int)(shared_bytes + attr.sharedSizeBytes);
-
-            if (base_shared_bytes > pair_args.devprop.sharedMemPerBlock)
-                {
-                throw std::runtime_error("Pair potential parameters exceed the available shared "
-                                         "memory per block.");
-                }
-
-            unsigned int max_extra_bytes
-                = (unsigned int)(pair_args.devprop.sharedMemPerBlock - base_shared_bytes);
-            unsigned int extra_bytes;
-            // determine dynamically requested shared memory
-            char* ptr = (char*)nullptr;
-            unsigned int available_bytes = max_extra_bytes;
-            for (unsigned int i = 0; i < typpair_idx.getNumElements(); ++i)
-                {
-                params[i].allocate_shared(ptr, available_bytes);
-                }
-            for (unsigned int i = 0; i < pair_args.ntypes; ++i)
-                {
-                shape_params[i].allocate_shared(ptr, available_bytes);
-                }
-            extra_bytes = max_extra_bytes - available_bytes;
-
-            shared_bytes += extra_bytes;
+            unsigned int max_extra_bytes;
+            size_t shared_bytes = aniso_pair_shared_bytes<evaluator>(pair_args,
+                                                                     params,
+                                                                     shape_params,
+                                                                     attr,
+                                                                     max_extra_bytes);
 
             block_size = block_size < max_block_size ? block_size : max_block_size;
             dim3 grid(N / (block_size / tpp) + 1, 1, 1);
@@ -596,11 +818,146 @@ hipError_t gpu_compute_pair_aniso_forces(const a_pair_args_t& pair_args,
         }
     return hipSuccess;
     }
+
+//! Launch gpu_compute_pair_aniso_queue_kernel()
+/*! \param pair_args Other arguments to pass onto the kernel
+    \param queue_args The pair queue
+    \param params Parameters for the potential, stored per type pair
+    \param shape_params Shape parameters, stored per type
+*/
+template<class evaluator, unsigned int shift_mode, unsigned int compute_virial>
+void launch_pair_aniso_queue_kernel(const a_pair_args_t& pair_args,
+                                    const a_pair_queue_args_t& queue_args,
+                                    const typename evaluator::param_type* params,
+                                    const typename evaluator::shape_type* shape_params)
+    {
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(
+        &attr,
+        reinterpret_cast<const void*>(
+            &gpu_compute_pair_aniso_queue_kernel<evaluator, shift_mode, compute_virial>));
+    unsigned int max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int max_extra_bytes;
+    size_t shared_bytes = aniso_pair_shared_bytes<evaluator>(pair_args,
+                                                             params,
+                                                             shape_params,
+                                                             attr,
+                                                             max_extra_bytes);
+
+    unsigned int block_size
+        = pair_args.block_size < max_block_size ? pair_args.block_size : max_block_size;
+    dim3 grid(queue_args.n_pairs / block_size + 1, 1, 1);
+
+    hipLaunchKernelGGL(
+        (gpu_compute_pair_aniso_queue_kernel<evaluator, shift_mode, compute_virial>),
+        dim3(grid),
+        dim3(block_size),
+        shared_bytes,
+        0,
+        queue_args.d_pair_force,
+        queue_args.d_pair_torque,
+        queue_args.d_pair_virial,
+        queue_args.pair_virial_pitch,
+        queue_args.n_pairs,
+        queue_args.d_pair_i,
+        queue_args.d_pair_j,
+        pair_args.d_pos,
+        pair_args.d_charge,
+        pair_args.d_orientation,
+        pair_args.d_tag,
+        pair_args.box,
+        params,
+        shape_params,
+        pair_args.d_rcutsq,
+        pair_args.ntypes,
+        max_extra_bytes);
+    }
+
+//! Kernel driver that computes the anisotropic pair forces with the pair queue
+/*! \param pair_args Other arguments to pass onto the kernel
+    \param queue_args The pair queue filled by gpu_fill_aniso_pair_queue()
+    \param d_params Parameters for the potential, stored per type pair
+    \param d_shape_params Shape parameters, stored per type
+
+    Evaluate the pairs in the queue with gpu_compute_pair_aniso_queue_kernel(), then sum the
+    results per particle with gpu_reduce_aniso_pair_queue(). The pair queue supports a single GPU.
+*/
+template<class evaluator>
+hipError_t
+gpu_compute_pair_aniso_forces_queue(const a_pair_args_t& pair_args,
+                                    const a_pair_queue_args_t& queue_args,
+                                    const typename evaluator::param_type* d_params,
+                                    const typename evaluator::shape_type* d_shape_params)
+    {
+    assert(d_params);
+    assert(pair_args.d_rcutsq);
+    assert(pair_args.ntypes > 0);
+
+    if (queue_args.n_pairs > 0)
+        {
+        if (pair_args.compute_virial)
+            {
+            switch (pair_args.shift_mode)
+                {
+            case 0:
+                {
+                launch_pair_aniso_queue_kernel<evaluator, 0, 1>(pair_args,
+                                                                queue_args,
+                                                                d_params,
+                                                                d_shape_params);
+                break;
+                }
+            case 1:
+                {
+                launch_pair_aniso_queue_kernel<evaluator,
+                                               1 && evaluator::implementsEnergyShift(),
+                                               1>(pair_args, queue_args, d_params, d_shape_params);
+                break;
+                }
+            default:
+                return hipErrorUnknown;
+                }
+            }
+        else
+            {
+            switch (pair_args.shift_mode)
+                {
+            case 0:
+                {
+                launch_pair_aniso_queue_kernel<evaluator, 0, 0>(pair_args,
+                                                                queue_args,
+                                                                d_params,
+                                                                d_shape_params);
+                break;
+                }
+            case 1:
+                {
+                launch_pair_aniso_queue_kernel<evaluator,
+                                               1 && evaluator::implementsEnergyShift(),
+                                               0>(pair_args, queue_args, d_params, d_shape_params);
+                break;
+                }
+            default:
+                return hipErrorUnknown;
+                }
+            }
+        }
+
+    return gpu_reduce_aniso_pair_queue(pair_args, queue_args);
+    }
 #else
 template<class evaluator>
 hipError_t gpu_compute_pair_aniso_forces(const a_pair_args_t& pair_args,
                                          const typename evaluator::param_type* d_params,
                                          const typename evaluator::shape_type* d_shape_params);
+
+template<class evaluator>
+hipError_t
+gpu_compute_pair_aniso_forces_queue(const a_pair_args_t& pair_args,
+                                    const a_pair_queue_args_t& queue_args,
+                                    const typename evaluator::param_type* d_params,
+                                    const typename evaluator::shape_type* d_shape_params);
 #endif
 
     } // end namespace kernel
@@ -31,6 +31,13 @@ namespace md
    serves as a shell dealing with all the details common to every pair potential calculation while
    te \a evaluator calculates \f$V(\vec r,\vec e_i, \vec e_j)\f$ in a generic way.
 
+    The autotuner chooses between two kernel variants. The default variant assigns a group of
+    threads to each particle, which loop over its neighbors. The pair queue variant first lists
+    the pairs within the cutoff, then evaluates one pair per thread and sums the results per
+    particle. It keeps every thread of a warp busy with a pair evaluation, which pays off for
+    evaluators with expensive and divergent evaluations (such as EvaluatorPairALJ). The pair queue
+    variant is available for evaluators that need shape parameters and on a single GPU.
+
     \tparam evaluator EvaluatorPair class used to evaluate potential, force and torque.
     \sa export_AnisoPotentialPairGPU()
 */
@@ -49,10 +56,22 @@ template<class evaluator> class AnisoPotentialPairGPU : public AnisoPotentialPai
     virtual void setShape(unsigned int typ, const typename evaluator::shape_type& shape_param);
 
     protected:
-    std::shared_ptr<Autotuner<2>> m_tuner; //!< Autotuner for block size and threads per particle
+    /// Autotuner for block size, threads per particle, and kernel variant
+    std::shared_ptr<Autotuner<3>> m_tuner;
+
+    GPUArray<unsigned int> m_pair_count;  //!< Number of pairs of each particle
+    GPUArray<unsigned int> m_pair_offset; //!< Index of the first pair of each particle
+    GPUArray<unsigned int> m_pair_i;      //!< Particle i of each pair in the queue
+    GPUArray<unsigned int> m_pair_j;      //!< Particle j of each pair in the queue
+    GPUArray<Scalar4> m_pair_force;       //!< Force and half the energy of each pair
+    GPUArray<Scalar4> m_pair_torque;      //!< Torque of each pair
+    GPUArray<Scalar> m_pair_virial;       //!< Virial of each pair
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
+
+    //! Compute the forces with the pair queue kernel variant
+    void computeForcesPairQueue(const kernel::a_pair_args_t& pair_args);
     };
 
 template<class evaluator>
@@ -71,9 +90,32 @@ AnisoPotentialPairGPU<evaluator>::AnisoPotentialPairGPU(std::shared_ptr<SystemDe
         throw std::runtime_error("Error initializing AnisoPotentialPairGPU");
         }
 
-    // Initialize autotuner that tunes block sizes and threads per particle.
-    m_tuner.reset(new Autotuner<2>({AutotunerBase::makeBlockSizeRange(this->m_exec_conf),
-                                    AutotunerBase::getTppListPow2(this->m_exec_conf)},
+    GPUArray<unsigned int> pair_count(1, this->m_exec_conf);
+    m_pair_count.swap(pair_count);
+    GPUArray<unsigned int> pair_offset(1, this->m_exec_conf);
+    m_pair_offset.swap(pair_offset);
+    GPUArray<unsigned int> pair_i(1, this->m_exec_conf);
+    m_pair_i.swap(pair_i);
+    GPUArray<unsigned int> pair_j(1, this->m_exec_conf);
+    m_pair_j.swap(pair_j);
+    GPUArray<Scalar4> pair_force(1, this->m_exec_conf);
+    m_pair_force.swap(pair_force);
+    GPUArray<Scalar4> pair_torque(1, this->m_exec_conf);
+    m_pair_torque.swap(pair_torque);
+    GPUArray<Scalar> pair_virial(6, this->m_exec_conf);
+    m_pair_virial.swap(pair_virial);
+
+    // kernel variant 0 loops over the neighbors of each particle, 1 uses the pair queue
+    std::vector<unsigned int> variants = {0};
+    if (evaluator::needsShape() && this->m_exec_conf->getNumActiveGPUs() == 1)
+        {
+        variants.push_back(1);
+        }
+
+    // Initialize autotuner that tunes block sizes, threads per particle, and the kernel variant.
+    m_tuner.reset(new Autotuner<3>({AutotunerBase::makeBlockSizeRange(this->m_exec_conf),
+                                    AutotunerBase::getTppListPow2(this->m_exec_conf),
+                                    variants},
                                    this->m_exec_conf,
                                    "aniso_pair_" + evaluator::getName()));
     this->m_autotuners.push_back(m_tuner);
@@ -140,37 +182,46 @@ template<class evaluator> void AnisoPotentialPairGPU<evaluator>::computeForces(u
     this->m_tuner->begin();
     unsigned int block_size = this->m_tuner->getParam()[0];
     unsigned int threads_per_particle = this->m_tuner->getParam()[1];
+    bool use_pair_queue = this->m_tuner->getParam()[2] == 1;
 
     // On the first iteration, shape parameters are updated. For optimization,
     // could track this between calls to avoid extra copying.
     bool first = true;
 
-    kernel::gpu_compute_pair_aniso_forces<evaluator>(
-        kernel::a_pair_args_t(d_force.data,
-                              d_torque.data,
-                              d_virial.data,
-                              this->m_virial.getPitch(),
-                              this->m_pdata->getN(),
-                              this->m_pdata->getMaxN(),
-                              d_pos.data,
-                              d_charge.data,
-                              d_orientation.data,
-                              d_tag.data,
-                              box,
-                              d_n_neigh.data,
-                              d_nlist.data,
-                              d_head_list.data,
-                              d_rcutsq.data,
-                              this->m_pdata->getNTypes(),
-                              block_size,
-                              this->m_shift_mode,
-                              flags[pdata_flag::pressure_tensor],
-                              threads_per_particle,
-                              this->m_pdata->getGPUPartition(),
-                              this->m_exec_conf->dev_prop,
-                              first),
-        this->m_params.data(),
-        this->m_shape_params.data());
+    kernel::a_pair_args_t pair_args(d_force.data,
+                                    d_torque.data,
+                                    d_virial.data,
+                                    this->m_virial.getPitch(),
+                                    this->m_pdata->getN(),
+                                    this->m_pdata->getMaxN(),
+                                    d_pos.data,
+                                    d_charge.data,
+                                    d_orientation.data,
+                                    d_tag.data,
+                                    box,
+                                    d_n_neigh.data,
+                                    d_nlist.data,
+                                    d_head_list.data,
+                                    d_rcutsq.data,
+                                    this->m_pdata->getNTypes(),
+                                    block_size,
+                                    this->m_shift_mode,
+                                    flags[pdata_flag::pressure_tensor],
+                                    threads_per_particle,
+                                    this->m_pdata->getGPUPartition(),
+                                    this->m_exec_conf->dev_prop,
+                                    first);
+
+    if (use_pair_queue)
+        {
+        computeForcesPairQueue(pair_args);
+        }
+    else
+        {
+        kernel::gpu_compute_pair_aniso_forces<evaluator>(pair_args,
+                                                         this->m_params.data(),
+                                                         this->m_shape_params.data());
+        }
 
     this->m_tuner->end();
 
@@ -180,6 +231,79 @@ template<class evaluator> void AnisoPotentialPairGPU<evaluator>::computeForces(u
     this->m_exec_conf->endMultiGPU();
     }
 
+/*! \param pair_args Arguments of the pair force computation
+
+    List the pairs within the cutoff, grow the pair queue arrays when needed, and evaluate the
+    pairs. Counting the pairs reads the total number of pairs back to the host.
+*/
+template<class evaluator>
+void AnisoPotentialPairGPU<evaluator>::computeForcesPairQueue(
+    const kernel::a_pair_args_t& pair_args)
+    {
+    unsigned int N = this->m_pdata->getN();
+    if (m_pair_offset.getNumElements() < N + 1)
+        {
+        m_pair_count.resize(N + 1);
+        m_pair_offset.resize(N + 1);
+        }
+
+    unsigned int n_pairs = 0;
+        {
+        ArrayHandle<unsigned int> d_pair_count(m_pair_count,
+                                               access_location::device,
+                                               access_mode::overwrite);
+        ArrayHandle<unsigned int> d_pair_offset(m_pair_offset,
+                                                access_location::device,
+                                                access_mode::overwrite);
+        kernel::gpu_count_aniso_pairs(pair_args,
+                                      d_pair_count.data,
+                                      d_pair_offset.data,
+                                      n_pairs,
+                                      this->m_exec_conf->getCachedAllocator());
+        }
+
+    if (m_pair_i.getNumElements() < n_pairs)
+        {
+        // leave room for the number of pairs to fluctuate
+        size_t capacity = n_pairs + n_pairs / 4;
+        m_pair_i.resize(capacity);
+        m_pair_j.resize(capacity);
+        m_pair_force.resize(capacity);
+        m_pair_torque.resize(capacity);
+        m_pair_virial.resize(6 * capacity);
+        }
+
+    ArrayHandle<unsigned int> d_pair_offset(m_pair_offset,
+                                            access_location::device,
+                                            access_mode::read);
+    ArrayHandle<unsigned int> d_pair_i(m_pair_i, access_location::device, access_mode::overwrite);
+    ArrayHandle<unsigned int> d_pair_j(m_pair_j, access_location::device, access_mode::overwrite);
+    ArrayHandle<Scalar4> d_pair_force(m_pair_force,
+                                      access_location::device,
+                                      access_mode::overwrite);
+    ArrayHandle<Scalar4> d_pair_torque(m_pair_torque,
+                                       access_location::device,
+                                       access_mode::overwrite);
+    ArrayHandle<Scalar> d_pair_virial(m_pair_virial,
+                                      access_location::device,
+                                      access_mode::overwrite);
+
+    kernel::a_pair_queue_args_t queue_args(d_pair_offset.data,
+                                           d_pair_i.data,
+                                           d_pair_j.data,
+                                           d_pair_force.data,
+                                           d_pair_torque.data,
+                                           d_pair_virial.data,
+                                           m_pair_i.getNumElements(),
+                                           n_pairs);
+
+    kernel::gpu_fill_aniso_pair_queue(pair_args, queue_args);
+    kernel::gpu_compute_pair_aniso_forces_queue<evaluator>(pair_args,
+                                                           queue_args,
+                                                           this->m_params.data(),
+                                                           this->m_shape_params.data());
+    }
+
 template<class evaluator>
 void AnisoPotentialPairGPU<evaluator>::setParams(unsigned int typ1,
                                                  unsigned int typ2,
@@ -0,0 +1,125 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#ifndef __BONDED_FORCE_THREADS_H__
+#define __BONDED_FORCE_THREADS_H__
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "hoomd/ExecutionConfiguration.h"
+#include "hoomd/HOOMDMath.h"
+
+#include <memory>
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#include <vector>
+#endif
+
+/*! \file BondedForceThreads.h
+    \brief Declares a helper that distributes the bonded groups of a force compute over threads
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace detail
+    {
+//! Compute the forces of bonded groups, in parallel when TBB threads are available
+/*! \param exec_conf Execution configuration that provides the threads
+    \param n_groups Number of bonded groups
+    \param N Number of particles that compute_range writes to (local particles, and ghosts for
+        computes that also write the ghost forces)
+    \param compute_virial True when the virial is computed
+    \param force Force array of the compute, zeroed by the caller
+    \param virial Virial array of the compute, zeroed by the caller
+    \param virial_pitch Pitch of \a virial
+    \param compute_range Callable compute_range(first, last, force, virial, virial_pitch) that adds
+        the forces, energies and virials of groups [first, last) to the given arrays
+
+    Every group scatters into all of its members, so two threads may hold groups that share a
+    particle. Each thread accumulates into its own copy of the force and virial arrays, and the
+    copies are summed into \a force and \a virial afterwards. The copies have N elements and the
+    virial copies have pitch N.
+*/
+template<class ComputeRange>
+void computeBondedForces(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                         unsigned int n_groups,
+                         unsigned int N,
+                         bool compute_virial,
+                         Scalar4* force,
+                         Scalar* virial,
+                         size_t virial_pitch,
+                         const ComputeRange& compute_range)
+    {
+#ifdef ENABLE_TBB
+    if (exec_conf->getNumThreads() > 1)
+        {
+        exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                const unsigned int n_virial = compute_virial ? 6 * N : 0;
+                tbb::enumerable_thread_specific<std::vector<Scalar4>> thread_force(
+                    N,
+                    make_scalar4(0, 0, 0, 0));
+                tbb::enumerable_thread_specific<std::vector<Scalar>> thread_virial(n_virial,
+                                                                                   Scalar(0.0));
+
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_groups),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  {
+                                      compute_range(r.begin(),
+                                                    r.end(),
+                                                    thread_force.local().data(),
+                                                    thread_virial.local().data(),
+                                                    size_t(N));
+                                  });
+
+                tbb::parallel_for(
+                    tbb::blocked_range<unsigned int>(0, N),
+                    [&](const tbb::blocked_range<unsigned int>& r)
+                    {
+                        for (const auto& f : thread_force)
+                            {
+                            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                {
+                                force[i].x += f[i].x;
+                                force[i].y += f[i].y;
+                                force[i].z += f[i].z;
+                                force[i].w += f[i].w;
+                                }
+                            }
+
+                        if (!compute_virial)
+                            return;
+
+                        for (const auto& v : thread_virial)
+                            {
+                            for (unsigned int k = 0; k < 6; k++)
+                                {
+                                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                    {
+                                    virial[k * virial_pitch + i] += v[k * N + i];
+                                    }
+                                }
+                            }
+                    });
+            });
+        }
+    else
+#endif
+        {
+        compute_range(0, n_groups, force, virial, virial_pitch);
+        }
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __BONDED_FORCE_THREADS_H__
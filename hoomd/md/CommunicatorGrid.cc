@@ -204,17 +204,38 @@ template<typename T> void CommunicatorGrid<T>::initGridComm()
 
 template<typename T> void CommunicatorGrid<T>::communicate(const GlobalArray<T>& grid)
     {
-    assert(grid.getNumElements() >= m_embed.x * m_embed.y * m_embed.z);
+    communicate(std::vector<const GlobalArray<T>*>(1, &grid));
+    }
+
+/*! \param grids The grids to communicate
+
+    The boundary layers of all grids are interleaved in the send and receive buffers, so that every
+    neighbor receives one message regardless of the number of grids.
+*/
+template<typename T>
+void CommunicatorGrid<T>::communicate(const std::vector<const GlobalArray<T>*>& grids)
+    {
+    unsigned int n_grids = (unsigned int)grids.size();
+    unsigned int n_cells = (unsigned int)m_send_idx.getNumElements();
+    if (m_send_buf.getNumElements() < size_t(n_cells) * n_grids)
+        {
+        m_send_buf.resize(size_t(n_cells) * n_grids);
+        m_recv_buf.resize(size_t(n_cells) * n_grids);
+        }
 
         {
         ArrayHandle<T> h_send_buf(m_send_buf, access_location::host, access_mode::overwrite);
         ArrayHandle<unsigned int> h_send_idx(m_send_idx, access_location::host, access_mode::read);
-        ArrayHandle<T> h_grid(grid, access_location::host, access_mode::read);
 
         // gather grid elements into send buf
-        unsigned int n = (unsigned int)m_send_buf.getNumElements();
-        for (unsigned int i = 0; i < n; ++i)
-            h_send_buf.data[i] = h_grid.data[h_send_idx.data[i]];
+        for (unsigned int g = 0; g < n_grids; ++g)
+            {
+            assert(grids[g]->getNumElements() >= m_embed.x * m_embed.y * m_embed.z);
+            ArrayHandle<T> h_grid(*grids[g], access_location::host, access_mode::read);
+
+            for (unsigned int i = 0; i < n_cells; ++i)
+                h_send_buf.data[i * n_grids + g] = h_grid.data[h_send_idx.data[i]];
+            }
         }
 
         {
@@ -234,8 +255,8 @@ template<typename T> void CommunicatorGrid<T>::communicate(const GlobalArray<T>&
             it_t e = m_end.find(*it);
             assert(e != m_end.end());
 
-            unsigned int offs = b->second;
-            unsigned int n_elem = e->second - b->second;
+            unsigned int offs = b->second * n_grids;
+            unsigned int n_elem = (e->second - b->second) * n_grids;
 
             MPI_Isend(&h_send_buf.data[offs],
                       int(n_elem * sizeof(T)),
@@ -259,20 +280,21 @@ template<typename T> void CommunicatorGrid<T>::communicate(const GlobalArray<T>&
 
         {
         ArrayHandle<T> h_recv_buf(m_recv_buf, access_location::host, access_mode::read);
-        ArrayHandle<unsigned int> h_recv_idx(m_recv_idx,
-                                             access_location::host,
-                                             access_mode::overwrite);
-        ArrayHandle<T> h_grid(grid, access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_recv_idx(m_recv_idx, access_location::host, access_mode::read);
 
         // scatter recv buf into grid
-        unsigned int n = (unsigned int)m_send_buf.getNumElements();
-        if (m_add_outer)
-            for (unsigned int i = 0; i < n; ++i)
-                h_grid.data[h_recv_idx.data[i]]
-                    = h_grid.data[h_recv_idx.data[i]] + h_recv_buf.data[i];
-        else
-            for (unsigned int i = 0; i < n; ++i)
-                h_grid.data[h_recv_idx.data[i]] = h_recv_buf.data[i];
+        for (unsigned int g = 0; g < n_grids; ++g)
+            {
+            ArrayHandle<T> h_grid(*grids[g], access_location::host, access_mode::readwrite);
+
+            if (m_add_outer)
+                for (unsigned int i = 0; i < n_cells; ++i)
+                    h_grid.data[h_recv_idx.data[i]]
+                        = h_grid.data[h_recv_idx.data[i]] + h_recv_buf.data[i * n_grids + g];
+            else
+                for (unsigned int i = 0; i < n_cells; ++i)
+                    h_grid.data[h_recv_idx.data[i]] = h_recv_buf.data[i * n_grids + g];
+            }
         }
     }
 
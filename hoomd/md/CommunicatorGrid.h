@@ -8,6 +8,7 @@
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/SystemDefinition.h"
 #include <memory>
+#include <vector>
 
 #ifdef ENABLE_MPI
 
@@ -32,6 +33,9 @@ template<typename T> class CommunicatorGrid
     //! Communicate grid
     virtual void communicate(const GlobalArray<T>& grid);
 
+    //! Communicate several grids with the same layout in a single exchange
+    void communicate(const std::vector<const GlobalArray<T>*>& grids);
+
     protected:
     std::shared_ptr<SystemDefinition> m_sysdef;                //!< System definition
     std::shared_ptr<ParticleData> m_pdata;                     //!< Particle data
@@ -122,7 +122,7 @@ template<typename T> void CommunicatorGridGPU<T>::communicate(const GlobalArray<
                                              access_mode::read);
         ArrayHandle<T> d_grid(grid, access_location::device, access_mode::read);
 
-        kernel::gpu_gridcomm_scatter_send_cells<T>((unsigned int)this->m_send_buf.getNumElements(),
+        kernel::gpu_gridcomm_scatter_send_cells<T>((unsigned int)this->m_send_idx.getNumElements(),
                                                    d_send_idx.data,
                                                    d_grid.data,
                                                    d_send_buf.data);
@@ -132,10 +132,23 @@ template<typename T> void CommunicatorGridGPU<T>::communicate(const GlobalArray<
 
         {
         // access send and recv buffers
+#ifdef ENABLE_GPU_AWARE_MPI
+        // MPI reads and writes the device buffers directly
+        ArrayHandle<T> send_buf_handle(this->m_send_buf,
+                                       access_location::device,
+                                       access_mode::read);
+        ArrayHandle<T> recv_buf_handle(this->m_recv_buf,
+                                       access_location::device,
+                                       access_mode::overwrite);
+
+        // wait for the scatter kernel, MPI does not order its accesses with the stream
+        hipDeviceSynchronize();
+#else
         ArrayHandle<T> send_buf_handle(this->m_send_buf, access_location::host, access_mode::read);
         ArrayHandle<T> recv_buf_handle(this->m_recv_buf,
                                        access_location::host,
                                        access_mode::overwrite);
+#endif
         typedef std::map<unsigned int, unsigned int>::iterator it_t;
         std::vector<MPI_Request> reqs(2 * this->m_neighbors.size());
 
@@ -6,6 +6,7 @@
 */
 
 #include "ComputeThermo.h"
+#include "hoomd/ParallelLoop.h"
 #include "hoomd/VectorMath.h"
 
 #ifdef ENABLE_MPI
@@ -83,93 +84,105 @@ void ComputeThermo::computeProperties()
 
     assert(m_pdata);
 
+    // access the group members before the tags (the index array may be rebuilt from the tags)
+    ArrayHandle<unsigned int> h_index(m_group->getIndexArray(),
+                                      access_location::host,
+                                      access_mode::read);
+
     // access the particle data
     ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
                                      access_location::host,
                                      access_mode::read);
     ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::read);
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
+                                  access_location::host,
+                                  access_mode::read);
+    ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                   access_location::host,
+                                   access_mode::read);
 
     // access the net force, pe, and virial
     const GlobalArray<Scalar4>& net_force = m_pdata->getNetForce();
     const GlobalArray<Scalar>& net_virial = m_pdata->getNetVirial();
     ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::read);
-
-    // total kinetic energy
-    double ke_trans_total = 0.0;
+    size_t virial_pitch = net_virial.getPitch();
 
     PDataFlags flags = m_pdata->getFlags();
+    const bool compute_pressure_tensor = flags[pdata_flag::pressure_tensor];
+    const bool compute_rotational = flags[pdata_flag::rotational_kinetic_energy];
 
-    double pressure_kinetic_xx = 0.0;
-    double pressure_kinetic_xy = 0.0;
-    double pressure_kinetic_xz = 0.0;
-    double pressure_kinetic_yy = 0.0;
-    double pressure_kinetic_yz = 0.0;
-    double pressure_kinetic_zz = 0.0;
-
-    if (flags[pdata_flag::pressure_tensor])
+    // sums over the group members
+    struct ThermoSums
         {
-        // Calculate kinetic part of pressure tensor
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        double ke_trans = 0.0;           //!< Total translational kinetic energy (times 2)
+        double ke_rot = 0.0;             //!< Total rotational kinetic energy (times 2)
+        double pe = 0.0;                 //!< Total potential energy
+        double pressure_kinetic[6] = {}; //!< Kinetic part of the pressure tensor
+        double virial[6] = {};           //!< Upper triangular virial tensor
+
+        ThermoSums& operator+=(const ThermoSums& other)
             {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            // ignore rigid body constituent particles in the sum
-            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
+            ke_trans += other.ke_trans;
+            ke_rot += other.ke_rot;
+            pe += other.pe;
+            for (unsigned int k = 0; k < 6; k++)
                 {
-                double mass = h_vel.data[j].w;
-                pressure_kinetic_xx += mass * ((double)h_vel.data[j].x * (double)h_vel.data[j].x);
-                pressure_kinetic_xy += mass * ((double)h_vel.data[j].x * (double)h_vel.data[j].y);
-                pressure_kinetic_xz += mass * ((double)h_vel.data[j].x * (double)h_vel.data[j].z);
-                pressure_kinetic_yy += mass * ((double)h_vel.data[j].y * (double)h_vel.data[j].y);
-                pressure_kinetic_yz += mass * ((double)h_vel.data[j].y * (double)h_vel.data[j].z);
-                pressure_kinetic_zz += mass * ((double)h_vel.data[j].z * (double)h_vel.data[j].z);
+                pressure_kinetic[k] += other.pressure_kinetic[k];
+                virial[k] += other.virial[k];
                 }
+            return *this;
             }
-        // kinetic energy = 1/2 trace of kinetic part of pressure tensor
-        ke_trans_total
-            = Scalar(0.5) * (pressure_kinetic_xx + pressure_kinetic_yy + pressure_kinetic_zz);
-        }
-    else
+        };
+
+    ThermoSums sums;
+    for (unsigned int k = 0; k < 6; k++)
         {
-        // total kinetic energy
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        sums.virial[k] = m_pdata->getExternalVirial(k);
+        }
+
+    // sum all requested quantities in a single pass over the group members
+    auto sum_range = [&](unsigned int first, unsigned int last, ThermoSums& sum)
+    {
+        for (unsigned int group_idx = first; group_idx < last; group_idx++)
             {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            // ignore rigid body constituent particles in the sum
-            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
-                {
-                ke_trans_total += (double)h_vel.data[j].w
-                                  * ((double)h_vel.data[j].x * (double)h_vel.data[j].x
-                                     + (double)h_vel.data[j].y * (double)h_vel.data[j].y
-                                     + (double)h_vel.data[j].z * (double)h_vel.data[j].z);
-                }
-            }
+            unsigned int j = h_index.data[group_idx];
 
-        ke_trans_total *= Scalar(0.5);
-        }
+            // ignore rigid body constituent particles in the sum
+            if (!(h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j]))
+                continue;
 
-    // total rotational kinetic energy
-    double ke_rot_total = 0.0;
+            double mass = h_vel.data[j].w;
+            double vx = h_vel.data[j].x;
+            double vy = h_vel.data[j].y;
+            double vz = h_vel.data[j].z;
 
-    if (flags[pdata_flag::rotational_kinetic_energy])
-        {
-        // Calculate rotational part of kinetic energy
-        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
-                                           access_location::host,
-                                           access_mode::read);
-        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
-                                      access_location::host,
-                                      access_mode::read);
-        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
-                                       access_location::host,
-                                       access_mode::read);
+            if (compute_pressure_tensor)
+                {
+                // kinetic part of pressure tensor
+                sum.pressure_kinetic[0] += mass * (vx * vx);
+                sum.pressure_kinetic[1] += mass * (vx * vy);
+                sum.pressure_kinetic[2] += mass * (vx * vz);
+                sum.pressure_kinetic[3] += mass * (vy * vy);
+                sum.pressure_kinetic[4] += mass * (vy * vz);
+                sum.pressure_kinetic[5] += mass * (vz * vz);
+
+                // upper triangular virial tensor
+                for (unsigned int k = 0; k < 6; k++)
+                    {
+                    sum.virial[k] += (double)h_net_virial.data[j + k * virial_pitch];
+                    }
+                }
+            else
+                {
+                sum.ke_trans += mass * (vx * vx + vy * vy + vz * vz);
+                }
 
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            // ignore rigid body constituent particles in the sum
-            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
+            if (compute_rotational)
                 {
                 Scalar3 I = h_inertia.data[j];
                 quat<Scalar> q(h_orientation.data[j]);
@@ -180,64 +193,59 @@ void ComputeThermo::computeProperties()
                 // carries angular momentum
                 if (I.x > 0)
                     {
-                    ke_rot_total += s.v.x * s.v.x / I.x;
+                    sum.ke_rot += s.v.x * s.v.x / I.x;
                     }
                 if (I.y > 0)
                     {
-                    ke_rot_total += s.v.y * s.v.y / I.y;
+                    sum.ke_rot += s.v.y * s.v.y / I.y;
                     }
                 if (I.z > 0)
                     {
-                    ke_rot_total += s.v.z * s.v.z / I.z;
+                    sum.ke_rot += s.v.z * s.v.z / I.z;
                     }
                 }
-            }
 
-        ke_rot_total /= Scalar(2.0);
+            sum.pe += (double)h_net_force.data[j].w;
+            }
+    };
+    detail::parallel_accumulate(*m_exec_conf, group_size, sums, sum_range);
+
+    double ke_trans_total = sums.ke_trans;
+    double ke_rot_total = sums.ke_rot;
+    double pe_total = sums.pe;
+
+    double pressure_kinetic_xx = sums.pressure_kinetic[0];
+    double pressure_kinetic_xy = sums.pressure_kinetic[1];
+    double pressure_kinetic_xz = sums.pressure_kinetic[2];
+    double pressure_kinetic_yy = sums.pressure_kinetic[3];
+    double pressure_kinetic_yz = sums.pressure_kinetic[4];
+    double pressure_kinetic_zz = sums.pressure_kinetic[5];
+
+    double virial_xx = sums.virial[0];
+    double virial_xy = sums.virial[1];
+    double virial_xz = sums.virial[2];
+    double virial_yy = sums.virial[3];
+    double virial_yz = sums.virial[4];
+    double virial_zz = sums.virial[5];
+
+    if (compute_pressure_tensor)
+        {
+        // kinetic energy = 1/2 trace of kinetic part of pressure tensor
+        ke_trans_total
+            = Scalar(0.5) * (pressure_kinetic_xx + pressure_kinetic_yy + pressure_kinetic_zz);
         }
-
-    // total potential energy
-    double pe_total = 0.0;
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    else
         {
-        unsigned int j = m_group->getMemberIndex(group_idx);
-
-        // ignore rigid body constituent particles in the sum
-        if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
-            {
-            pe_total += (double)h_net_force.data[j].w;
-            }
+        ke_trans_total *= Scalar(0.5);
         }
 
+    ke_rot_total /= Scalar(2.0);
+
     pe_total += m_pdata->getExternalEnergy();
 
     double W = 0.0;
-    double virial_xx = m_pdata->getExternalVirial(0);
-    double virial_xy = m_pdata->getExternalVirial(1);
-    double virial_xz = m_pdata->getExternalVirial(2);
-    double virial_yy = m_pdata->getExternalVirial(3);
-    double virial_yz = m_pdata->getExternalVirial(4);
-    double virial_zz = m_pdata->getExternalVirial(5);
-
-    if (flags[pdata_flag::pressure_tensor])
+    if (compute_pressure_tensor)
         {
-        // Calculate upper triangular virial tensor
-        size_t virial_pitch = net_virial.getPitch();
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            // ignore rigid body constituent particles in the sum
-            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
-                {
-                virial_xx += (double)h_net_virial.data[j + 0 * virial_pitch];
-                virial_xy += (double)h_net_virial.data[j + 1 * virial_pitch];
-                virial_xz += (double)h_net_virial.data[j + 2 * virial_pitch];
-                virial_yy += (double)h_net_virial.data[j + 3 * virial_pitch];
-                virial_yz += (double)h_net_virial.data[j + 4 * virial_pitch];
-                virial_zz += (double)h_net_virial.data[j + 5 * virial_pitch];
-                }
-            }
-
         // isotropic virial = 1/3 trace of virial tensor
         W = Scalar(1. / 3.) * (virial_xx + virial_yy + virial_zz);
         }
@@ -109,6 +109,9 @@ void CosineSqAngleForceCompute::computeForces(uint64_t timestep)
     ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
     size_t virial_pitch = m_virial.getPitch();
 
+    PDataFlags flags = m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor];
+
     // there are enough other checks on the input data: but it doesn't hurt to be safe
     assert(h_force.data);
     assert(h_virial.data);
@@ -232,8 +235,9 @@ void CosineSqAngleForceCompute::computeForces(uint64_t timestep)
             h_force.data[idx_a].y += fab[1];
             h_force.data[idx_a].z += fab[2];
             h_force.data[idx_a].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j * virial_pitch + idx_a] += angle_virial[j];
+            if (compute_virial)
+                for (int j = 0; j < 6; j++)
+                    h_virial.data[j * virial_pitch + idx_a] += angle_virial[j];
             }
 
         if (idx_b < m_pdata->getN())
@@ -242,8 +246,9 @@ void CosineSqAngleForceCompute::computeForces(uint64_t timestep)
             h_force.data[idx_b].y -= fab[1] + fcb[1];
             h_force.data[idx_b].z -= fab[2] + fcb[2];
             h_force.data[idx_b].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j * virial_pitch + idx_b] += angle_virial[j];
+            if (compute_virial)
+                for (int j = 0; j < 6; j++)
+                    h_virial.data[j * virial_pitch + idx_b] += angle_virial[j];
             }
 
         if (idx_c < m_pdata->getN())
@@ -252,8 +257,9 @@ void CosineSqAngleForceCompute::computeForces(uint64_t timestep)
             h_force.data[idx_c].y += fcb[1];
             h_force.data[idx_c].z += fcb[2];
             h_force.data[idx_c].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j * virial_pitch + idx_c] += angle_virial[j];
+            if (compute_virial)
+                for (int j = 0; j < 6; j++)
+                    h_virial.data[j * virial_pitch + idx_c] += angle_virial[j];
             }
         }
     }
@@ -87,6 +87,7 @@ void CosineSqAngleForceComputeGPU::computeForces(uint64_t timestep)
     kernel::gpu_compute_cosinesq_angle_forces(d_force.data,
                                               d_virial.data,
                                               m_virial.getPitch(),
+                                              m_pdata->getFlags()[pdata_flag::pressure_tensor],
                                               m_pdata->getN(),
                                               d_pos.data,
                                               box,
@@ -5,8 +5,10 @@
 #define __EVALUATOR_PAIR_ALJ_H__
 
 #ifndef __HIPCC__
+#include <set>
 #include <sstream>
 #include <string>
+#include <utility>
 #endif
 
 #include "GJK_SV.h"
@@ -340,9 +342,70 @@ template<unsigned int ndim> class EvaluatorPairALJ
                 for (unsigned int j = 0; j < len(face_tmp); ++j)
                     {
                     faces[counter] = pybind11::cast<unsigned int>(face_tmp[j]);
+                    if (faces[counter] >= N_vertices)
+                        {
+                        throw std::runtime_error("Face vertex index out of range.");
+                        }
                     ++counter;
                     }
                 }
+
+            if (N_vertices >= min_vertices_hill_climb)
+                {
+                buildVertexNeighbors(managed);
+                }
+            }
+
+        //! Minimum number of vertices for which GJK finds support vertices by hill climbing.
+        /*! A full scan of the vertices is faster for small polyhedra.
+         */
+        static constexpr unsigned int min_vertices_hill_climb = 16;
+
+        //! Build the edge graph of the polyhedron from its faces
+        /*! Consecutive vertices of each face share an edge of the convex hull.
+            \param managed Whether or not the arrays are managed, as in the constructor.
+        */
+        void buildVertexNeighbors(bool managed)
+            {
+            const unsigned int N_vertices = verts.size();
+            std::set<std::pair<unsigned int, unsigned int>> edges;
+            for (unsigned int i = 0; i < face_offsets.size(); ++i)
+                {
+                const unsigned int begin = face_offsets[i];
+                const unsigned int end
+                    = (i + 1 < face_offsets.size()) ? face_offsets[i + 1] : faces.size();
+                for (unsigned int k = begin; k < end; ++k)
+                    {
+                    const unsigned int a = faces[k];
+                    const unsigned int b = faces[(k + 1 < end) ? k + 1 : begin];
+                    if (a != b)
+                        {
+                        edges.insert(std::make_pair(a, b));
+                        edges.insert(std::make_pair(b, a));
+                        }
+                    }
+                }
+
+            // The set is sorted by the first vertex, so the neighbors of each vertex are
+            // contiguous.
+            vertex_neighbor_offsets = ManagedArray<unsigned int>(N_vertices + 1, managed);
+            vertex_neighbors
+                = ManagedArray<unsigned int>(static_cast<unsigned int>(edges.size()), managed);
+            for (unsigned int i = 0; i <= N_vertices; ++i)
+                {
+                vertex_neighbor_offsets[i] = 0;
+                }
+            unsigned int counter = 0;
+            for (const auto& edge : edges)
+                {
+                vertex_neighbor_offsets[edge.first + 1]++;
+                vertex_neighbors[counter] = edge.second;
+                ++counter;
+                }
+            for (unsigned int i = 0; i < N_vertices; ++i)
+                {
+                vertex_neighbor_offsets[i + 1] += vertex_neighbor_offsets[i];
+                }
             }
 
         pybind11::object toPython()
@@ -407,6 +470,8 @@ template<unsigned int ndim> class EvaluatorPairALJ
             verts.load_shared(ptr, available_bytes);
             faces.load_shared(ptr, available_bytes);
             face_offsets.load_shared(ptr, available_bytes);
+            vertex_neighbors.load_shared(ptr, available_bytes);
+            vertex_neighbor_offsets.load_shared(ptr, available_bytes);
             }
 
         HOSTDEVICE void allocate_shared(char*& ptr, unsigned int& available_bytes) const
@@ -414,6 +479,8 @@ template<unsigned int ndim> class EvaluatorPairALJ
             verts.allocate_shared(ptr, available_bytes);
             faces.allocate_shared(ptr, available_bytes);
             face_offsets.allocate_shared(ptr, available_bytes);
+            vertex_neighbors.allocate_shared(ptr, available_bytes);
+            vertex_neighbor_offsets.allocate_shared(ptr, available_bytes);
             }
 
 #ifdef ENABLE_HIP
@@ -423,6 +490,8 @@ template<unsigned int ndim> class EvaluatorPairALJ
             verts.set_memory_hint();
             faces.set_memory_hint();
             face_offsets.set_memory_hint();
+            vertex_neighbors.set_memory_hint();
+            vertex_neighbor_offsets.set_memory_hint();
             }
 #endif
 
@@ -430,10 +499,31 @@ template<unsigned int ndim> class EvaluatorPairALJ
         ManagedArray<vec3<Scalar>> verts;        //! Shape vertices.
         ManagedArray<unsigned int> faces;        //! Shape faces.
         ManagedArray<unsigned int> face_offsets; //! Index where each faces starts.
+        //! Vertices that share an edge with each vertex (empty when GJK scans all vertices).
+        ManagedArray<unsigned int> vertex_neighbors;
+        //! Index of the first neighbor of each vertex in vertex_neighbors.
+        ManagedArray<unsigned int> vertex_neighbor_offsets;
         vec3<Scalar> rounding_radii;             //! The semimajor axes of the rounding ellipse.
         bool has_rounding;                       //! Whether or not the shape has rounding radii.
         };
 
+    //! Body frame of a particle: the rotation matrix of its orientation
+    struct frame_type
+        {
+        Scalar mat[3][3]; //!< Rotation matrix (body->space)
+        };
+
+    //! Compute the body frame of a particle
+    /*! \param orientation Orientation quaternion of the particle
+        \param shape Shape of the particle
+    */
+    HOSTDEVICE static frame_type computeFrame(const Scalar4& orientation, const shape_type& shape)
+        {
+        frame_type frame;
+        quat2mat(quat<Scalar>(orientation), frame.mat);
+        return frame;
+        }
+
     //! Constructs the pair potential evaluator.
     /*! \param _dr Displacement vector between particle centers of mass.
         \param _rcutsq Squared distance at which the potential goes to 0.
@@ -446,7 +536,8 @@ template<unsigned int ndim> class EvaluatorPairALJ
                                 Scalar4& _qj,
                                 Scalar _rcutsq,
                                 const param_type& _params)
-        : dr(_dr), rcutsq(_rcutsq), qi(_qi), qj(_qj), _params(_params)
+        : dr(_dr), rcutsq(_rcutsq), qi(_qi), qj(_qj), frame_i(nullptr), frame_j(nullptr),
+          _params(_params)
         {
         }
 
@@ -500,6 +591,16 @@ template<unsigned int ndim> class EvaluatorPairALJ
     */
     HOSTDEVICE void setCharge(Scalar qi, Scalar qj) { }
 
+    //! Accept the optional precomputed body frames
+    /*! \param _frame_i Body frame of particle i
+        \param _frame_j Body frame of particle j
+    */
+    HOSTDEVICE void setFrames(const frame_type* _frame_i, const frame_type* _frame_j)
+        {
+        frame_i = _frame_i;
+        frame_j = _frame_j;
+        }
+
     //! Evaluate the force and energy.
     /*! \param force Output parameter to write the computed force.
         \param pair_eng Output parameter to write the computed pair energy.
@@ -529,10 +630,15 @@ template<unsigned int ndim> class EvaluatorPairALJ
             // conversion is only really important for low vertex shapes where the
             // additional cost of the conversion could offset the added speed of the
             // rotations. We create local scope for all the intermediate products to
-            // avoid namespace pollution with unnecessary variables..
-            Scalar mati[3][3], matj[3][3];
-            quat2mat(qi, mati);
-            quat2mat(qj, matj);
+            // avoid namespace pollution with unnecessary variables.. The matrices are
+            // converted only when the caller did not provide precomputed frames.
+            Scalar mati_local[3][3], matj_local[3][3];
+            if (!frame_i)
+                quat2mat(qi, mati_local);
+            if (!frame_j)
+                quat2mat(qj, matj_local);
+            const Scalar(&mati)[3][3](frame_i ? frame_i->mat : mati_local);
+            const Scalar(&matj)[3][3](frame_j ? frame_j->mat : matj_local);
 
             // Call GJK. In order to ensure that Newton's third law is
             // obeyed, we must avoid any imbalance caused by numerical
@@ -570,7 +676,13 @@ template<unsigned int ndim> class EvaluatorPairALJ
                           shape_i->rounding_radii,
                           shape_j->rounding_radii,
                           shape_i->has_rounding,
-                          shape_j->has_rounding);
+                          shape_j->has_rounding,
+                          flip ? shape_j->vertex_neighbors : shape_i->vertex_neighbors,
+                          flip ? shape_j->vertex_neighbor_offsets
+                               : shape_i->vertex_neighbor_offsets,
+                          flip ? shape_i->vertex_neighbors : shape_j->vertex_neighbors,
+                          flip ? shape_i->vertex_neighbor_offsets
+                               : shape_j->vertex_neighbor_offsets);
                 // Unphysical ALJ simulation results may be the result of
                 // invalid collision detection from GJK, which will normally
                 // occur silently. This assertion helps debug such errors by
@@ -835,6 +947,8 @@ template<unsigned int ndim> class EvaluatorPairALJ
     Scalar rcutsq;             //!< Stored rcutsq from the constructor
     quat<Scalar> qi;           //!< Orientation quaternion for particle i
     quat<Scalar> qj;           //!< Orientation quaternion for particle j
+    const frame_type* frame_i; //!< Precomputed body frame of particle i, or null
+    const frame_type* frame_j; //!< Precomputed body frame of particle j, or null
     unsigned int tag_i;        //!< Tag of particle i.
     unsigned int tag_j;        //!< Tag of particle j.
     const shape_type* shape_i; //!< Shape parameters of particle i.
@@ -44,6 +44,16 @@ class EvaluatorPairDLVO
         Scalar a1;
         Scalar a2;
 
+        // Coefficients packed from the parameters above when they are set
+        Scalar radsum;        //!< a1 + a2
+        Scalar radsumsq;      //!< (a1 + a2)^2
+        Scalar radsubsq;      //!< (a1 - a2)^2
+        Scalar two_radsqsum;  //!< 2 (a1^2 + a2^2)
+        Scalar radsqsub_sq;   //!< (a1^2 - a2^2)^2
+        Scalar rep_prefactor; //!< Z a1 a2 / (a1 + a2)
+        Scalar atr_prefactor; //!< -32 A (a1 a2)^3 / 3
+        Scalar eng_prefactor; //!< A a1 a2 / 3
+
         DEVICE void load_shared(char*& ptr, unsigned int& available_bytes) { }
 
         HOSTDEVICE void allocate_shared(char*& ptr, unsigned int& available_bytes) const { }
@@ -57,7 +67,10 @@ class EvaluatorPairDLVO
 #endif
 
 #ifndef __HIPCC__
-        param_type() : kappa(0), Z(0), A(0) { }
+        param_type() : kappa(0), Z(0), A(0), a1(0), a2(0)
+            {
+            pack();
+            }
 
         param_type(pybind11::dict v, bool managed = false)
             {
@@ -66,6 +79,24 @@ class EvaluatorPairDLVO
             A = v["A"].cast<Scalar>();
             a1 = v["a1"].cast<Scalar>();
             a2 = v["a2"].cast<Scalar>();
+            pack();
+            }
+
+        //! Compute the per type pair coefficients used by the evaluator
+        void pack()
+            {
+            radsum = a1 + a2;
+            Scalar radsub = a1 - a2;
+            Scalar radprod = a1 * a2;
+            Scalar radsqsub = a1 * a1 - a2 * a2;
+
+            radsumsq = radsum * radsum;
+            radsubsq = radsub * radsub;
+            two_radsqsum = Scalar(2.0) * (a1 * a1 + a2 * a2);
+            radsqsub_sq = radsqsub * radsqsub;
+            rep_prefactor = radsum != Scalar(0.0) ? Z * radprod / radsum : Scalar(0.0);
+            atr_prefactor = -Scalar(32.0) * A / Scalar(3.0) * radprod * radprod * radprod;
+            eng_prefactor = radprod * A / Scalar(3.0);
             }
 
         pybind11::dict asDict()
@@ -87,14 +118,12 @@ class EvaluatorPairDLVO
         \param _params Per type pair parameters of this potential
     */
     DEVICE EvaluatorPairDLVO(Scalar _rsq, Scalar _rcutsq, const param_type& _params)
-        : rsq(_rsq), rcutsq(_rcutsq), kappa(_params.kappa), Z(_params.Z), A(_params.A)
+        : rsq(_rsq), rcutsq(_rcutsq), kappa(_params.kappa), A(_params.A), radsum(_params.radsum),
+          radsumsq(_params.radsumsq), radsubsq(_params.radsubsq),
+          two_radsqsum(_params.two_radsqsum), radsqsub_sq(_params.radsqsub_sq),
+          rep_prefactor(_params.rep_prefactor), atr_prefactor(_params.atr_prefactor),
+          eng_prefactor(_params.eng_prefactor)
         {
-        radsum = _params.a1 + _params.a2;
-        radsub = _params.a1 - _params.a2;
-        radprod = _params.a1 * _params.a2;
-        radsumsq = _params.a1 * _params.a1 + _params.a2 * _params.a2;
-        radsubsq = _params.a1 * _params.a1 - _params.a2 * _params.a2;
-        delta = radsum - Scalar(1.0);
         }
 
     //! DLVO doesn't use charge
@@ -128,39 +157,37 @@ class EvaluatorPairDLVO
         // compute the force divided by r in force_divr
         if (r < rcut && kappa != 0)
             {
+            Scalar r2 = r * r;
             Scalar rmds = r - radsum;
-            Scalar rmdsqs = r * r - radsum * radsum;
-            Scalar rmdsqm = r * r - radsub * radsub;
-            Scalar radsuminv = Scalar(1.0) / radsum;
+            Scalar rmdsqs = r2 - radsumsq;
+            Scalar rmdsqm = r2 - radsubsq;
             Scalar rmdsqsinv = Scalar(1.0) / rmdsqs;
             Scalar rmdsqminv = Scalar(1.0) / rmdsqm;
-            Scalar exp_val = fast::exp(-kappa * rmds);
-            Scalar forcerep_divr = kappa * radprod * radsuminv * Z * exp_val / r;
-            Scalar fatrterm1 = r * r * r * r + radsubsq * radsubsq - Scalar(2.0) * r * r * radsumsq;
+            Scalar engrep = rep_prefactor * fast::exp(-kappa * rmds);
+            Scalar forcerep_divr = kappa * engrep / r;
+            Scalar fatrterm1 = r2 * r2 + radsqsub_sq - r2 * two_radsqsum;
             Scalar fatrterm1inv = Scalar(1.0) / fatrterm1 * Scalar(1.0) / fatrterm1;
-            Scalar forceatr_divr
-                = -Scalar(32.0) * A / Scalar(3.0) * radprod * radprod * radprod * fatrterm1inv;
+            Scalar forceatr_divr = atr_prefactor * fatrterm1inv;
             force_divr = forcerep_divr + forceatr_divr;
 
-            Scalar engt1 = radprod * rmdsqsinv * A / Scalar(3.0);
-            Scalar engt2 = radprod * rmdsqminv * A / Scalar(3.0);
+            Scalar engt1 = eng_prefactor * rmdsqsinv;
+            Scalar engt2 = eng_prefactor * rmdsqminv;
             Scalar engt3 = slow::log(rmdsqs * rmdsqminv) * A / Scalar(6.0);
-            pair_eng = r * forcerep_divr / kappa - engt1 - engt2 - engt3;
+            pair_eng = engrep - engt1 - engt2 - engt3;
             if (energy_shift)
                 {
                 Scalar rcutt = rcut;
                 Scalar rmdscut = rcutt - radsum;
-                Scalar rmdsqscut = rcutt * rcutt - radsum * radsum;
-                Scalar rmdsqmcut = rcutt * rcutt - radsub * radsub;
+                Scalar rmdsqscut = rcutt * rcutt - radsumsq;
+                Scalar rmdsqmcut = rcutt * rcutt - radsubsq;
                 Scalar rmdsqsinvcut = Scalar(1.0) / rmdsqscut;
                 Scalar rmdsqminvcut = Scalar(1.0) / rmdsqmcut;
 
-                Scalar engt1cut = radprod * rmdsqsinvcut * A / Scalar(3.0);
-                Scalar engt2cut = radprod * rmdsqminvcut * A / Scalar(3.0);
+                Scalar engt1cut = eng_prefactor * rmdsqsinvcut;
+                Scalar engt2cut = eng_prefactor * rmdsqminvcut;
                 Scalar engt3cut = slow::log(rmdsqscut * rmdsqminvcut) * A / Scalar(6.0);
-                Scalar exp_valcut = fast::exp(-kappa * rmdscut);
-                Scalar forcerepcut_divr = kappa * radprod * radsuminv * Z * exp_valcut / rcutt;
-                pair_eng -= rcutt * forcerepcut_divr / kappa - engt1cut - engt2cut - engt3cut;
+                Scalar engrepcut = rep_prefactor * fast::exp(-kappa * rmdscut);
+                pair_eng -= engrepcut - engt1cut - engt2cut - engt3cut;
                 }
             return true;
             }
@@ -194,17 +221,18 @@ class EvaluatorPairDLVO
 #endif
 
     protected:
-    Scalar rsq;      //!< Stored rsq from the constructor
-    Scalar rcutsq;   //!< Stored rcutsq from the constructor
-    Scalar kappa;    //!< kappa parameter extracted from the params passed to the constructor
-    Scalar Z;        //!< Z parameter extracted from the params passed to the constructor
-    Scalar A;        //!< A parameter extracted from the params passed to the constructor
-    Scalar radsum;   //!< radsum parameter extracted from the call to setDiameter
-    Scalar radsub;   //!< radsub parameter extracted from the call to setDiameter
-    Scalar radprod;  //!< radprod parameter extracted from the call to setDiameter
-    Scalar radsumsq; //!< radsumsq parameter extracted from the call to setDiameter
-    Scalar radsubsq; //!< radsubsq parameter extracted from the call to setDiameter
-    Scalar delta;    //!< Diameter sum minus one
+    Scalar rsq;           //!< Stored rsq from the constructor
+    Scalar rcutsq;        //!< Stored rcutsq from the constructor
+    Scalar kappa;         //!< kappa parameter extracted from the params passed to the constructor
+    Scalar A;             //!< A parameter extracted from the params passed to the constructor
+    Scalar radsum;        //!< Sum of the radii
+    Scalar radsumsq;      //!< Square of the sum of the radii
+    Scalar radsubsq;      //!< Square of the difference of the radii
+    Scalar two_radsqsum;  //!< Twice the sum of the squared radii
+    Scalar radsqsub_sq;   //!< Square of the difference of the squared radii
+    Scalar rep_prefactor; //!< Prefactor of the repulsive energy
+    Scalar atr_prefactor; //!< Prefactor of the attractive force
+    Scalar eng_prefactor; //!< Prefactor of the attractive energy
     };
 
     } // end namespace md
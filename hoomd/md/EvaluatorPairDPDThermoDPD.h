@@ -135,7 +135,8 @@ class EvaluatorPairDPDThermoDPD
         \param _params Per type pair parameters of this potential
     */
     DEVICE EvaluatorPairDPDThermoDPD(Scalar _rsq, Scalar _rcutsq, const param_type& _params)
-        : rsq(_rsq), rcutsq(_rcutsq), a(_params.A), gamma(_params.gamma)
+        : rsq(_rsq), rcutsq(_rcutsq), a(_params.A), gamma(_params.gamma), m_have_alpha(false),
+          m_alpha(0)
         {
         }
 
@@ -149,6 +150,19 @@ class EvaluatorPairDPDThermoDPD
         m_timestep = timestep;
         }
 
+    //! Set the random value of this pair
+    /*! \param alpha Uniform random value in [-1, 1]
+
+        Callers that draw the values of many pairs at once (see RandomGeneratorBatch) set alpha so
+        that evalForceEnergyThermo() does not build an RNG. alpha must be the value that the RNG
+        seeded by set_seed_ij_timestep() would produce.
+    */
+    DEVICE void setRandomValue(Scalar alpha)
+        {
+        m_alpha = alpha;
+        m_have_alpha = true;
+        }
+
     //! Set the timestep size
     DEVICE void setDeltaT(Scalar dt)
         {
@@ -234,25 +248,30 @@ class EvaluatorPairDPDThermoDPD
 
             // force calculation
 
-            unsigned int m_oi, m_oj;
-            // initialize the RNG
-            if (m_i > m_j)
+            // use the random value drawn by the caller, if any
+            Scalar alpha = m_alpha;
+            if (!m_have_alpha)
                 {
-                m_oi = m_j;
-                m_oj = m_i;
-                }
-            else
-                {
-                m_oi = m_i;
-                m_oj = m_j;
-                }
+                unsigned int m_oi, m_oj;
+                // initialize the RNG
+                if (m_i > m_j)
+                    {
+                    m_oi = m_j;
+                    m_oj = m_i;
+                    }
+                else
+                    {
+                    m_oi = m_i;
+                    m_oj = m_j;
+                    }
 
-            hoomd::RandomGenerator rng(
-                hoomd::Seed(hoomd::RNGIdentifier::EvaluatorPairDPDThermo, m_timestep, m_seed),
-                hoomd::Counter(m_oi, m_oj));
+                hoomd::RandomGenerator rng(
+                    hoomd::Seed(hoomd::RNGIdentifier::EvaluatorPairDPDThermo, m_timestep, m_seed),
+                    hoomd::Counter(m_oi, m_oj));
 
-            // Generate a single random number
-            Scalar alpha = hoomd::UniformDistribution<Scalar>(-1, 1)(rng);
+                // Generate a single random number
+                alpha = hoomd::UniformDistribution<Scalar>(-1, 1)(rng);
+                }
 
             // conservative dpd
             // force_divr = FDIV(a,r)*(Scalar(1.0) - r*rcutinv);
@@ -314,6 +333,8 @@ class EvaluatorPairDPDThermoDPD
     Scalar m_T;          //!< Temperature for Themostat
     Scalar m_dot;        //!< Velocity difference dotted with displacement vector
     Scalar m_deltaT;     //!<  timestep size stored from constructor
+    bool m_have_alpha;   //!< True when setRandomValue() set m_alpha
+    Scalar m_alpha;      //!< Random value set by setRandomValue()
     };
 
 #undef DEVICE
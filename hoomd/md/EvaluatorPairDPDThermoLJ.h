@@ -125,7 +125,8 @@ class EvaluatorPairDPDThermoLJ
     */
     DEVICE EvaluatorPairDPDThermoLJ(Scalar _rsq, Scalar _rcutsq, const param_type& _params)
         : rsq(_rsq), rcutsq(_rcutsq), lj1(_params.epsilon_x_4 * _params.sigma_6 * _params.sigma_6),
-          lj2(_params.epsilon_x_4 * _params.sigma_6), gamma(_params.gamma)
+          lj2(_params.epsilon_x_4 * _params.sigma_6), gamma(_params.gamma), m_have_alpha(false),
+          m_alpha(0)
         {
         }
 
@@ -139,6 +140,19 @@ class EvaluatorPairDPDThermoLJ
         m_timestep = timestep;
         }
 
+    //! Set the random value of this pair
+    /*! \param alpha Uniform random value in [-1, 1]
+
+        Callers that draw the values of many pairs at once (see RandomGeneratorBatch) set alpha so
+        that evalForceEnergyThermo() does not build an RNG. alpha must be the value that the RNG
+        seeded by set_seed_ij_timestep() would produce.
+    */
+    DEVICE void setRandomValue(Scalar alpha)
+        {
+        m_alpha = alpha;
+        m_have_alpha = true;
+        }
+
     //! Set the timestep size
     DEVICE void setDeltaT(Scalar dt)
         {
@@ -228,25 +242,30 @@ class EvaluatorPairDPDThermoLJ
 
             // force calculation
 
-            unsigned int m_oi, m_oj;
-            // initialize the RNG
-            if (m_i > m_j)
+            // use the random value drawn by the caller, if any
+            Scalar alpha = m_alpha;
+            if (!m_have_alpha)
                 {
-                m_oi = m_j;
-                m_oj = m_i;
+                unsigned int m_oi, m_oj;
+                // initialize the RNG
+                if (m_i > m_j)
+                    {
+                    m_oi = m_j;
+                    m_oj = m_i;
+                    }
+                else
+                    {
+                    m_oi = m_i;
+                    m_oj = m_j;
+                    }
+
+                hoomd::RandomGenerator rng(
+                    hoomd::Seed(hoomd::RNGIdentifier::EvaluatorPairDPDThermo, m_timestep, m_seed),
+                    hoomd::Counter(m_oi, m_oj));
+
+                // Generate a single random number
+                alpha = hoomd::UniformDistribution<Scalar>(-1, 1)(rng);
                 }
-            else
-                {
-                m_oi = m_i;
-                m_oj = m_j;
-                }
-
-            hoomd::RandomGenerator rng(
-                hoomd::Seed(hoomd::RNGIdentifier::EvaluatorPairDPDThermo, m_timestep, m_seed),
-                hoomd::Counter(m_oi, m_oj));
-
-            // Generate a single random number
-            Scalar alpha = hoomd::UniformDistribution<Scalar>(-1, 1)(rng);
 
             // conservative lj
             force_divr = r2inv * r6inv * (Scalar(12.0) * lj1 * r6inv - Scalar(6.0) * lj2);
@@ -313,6 +332,8 @@ class EvaluatorPairDPDThermoLJ
     Scalar m_T;          //!< Temperature for Themostat
     Scalar m_dot;        //!< Velocity difference dotted with displacement vector
     Scalar m_deltaT;     //!<  timestep size stored from constructor
+    bool m_have_alpha;   //!< True when setRandomValue() set m_alpha
+    Scalar m_alpha;      //!< Random value set by setRandomValue()
     };
 
 #undef DEVICE
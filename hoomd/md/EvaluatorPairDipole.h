@@ -122,6 +122,18 @@ class EvaluatorPairDipole
 #endif
         };
 
+    //! Body frame of a particle: the dipole moment in the space frame
+    typedef vec3<Scalar> frame_type;
+
+    //! Compute the body frame of a particle
+    /*! \param orientation Orientation quaternion of the particle
+        \param shape Shape of the particle
+    */
+    HOSTDEVICE static frame_type computeFrame(const Scalar4& orientation, const shape_type& shape)
+        {
+        return rotate(quat<Scalar>(orientation), shape.mu);
+        }
+
     //! Constructs the pair potential evaluator
     /*! \param _dr Displacement vector between particle centers of mass
         \param _rcutsq Squared distance at which the potential goes to 0
@@ -137,7 +149,8 @@ class EvaluatorPairDipole
                                    Scalar _rcutsq,
                                    const param_type& _params)
         : dr(_dr), rcutsq(_rcutsq), q_i(0), q_j(0), quat_i(_quat_i), quat_j(_quat_j),
-          mu_i {0, 0, 0}, mu_j {0, 0, 0}, A(_params.A), kappa(_params.kappa)
+          mu_i {0, 0, 0}, mu_j {0, 0, 0}, frame_i(nullptr), frame_j(nullptr), A(_params.A),
+          kappa(_params.kappa)
         {
         }
 
@@ -191,6 +204,16 @@ class EvaluatorPairDipole
         q_j = qj;
         }
 
+    //! Accept the optional precomputed body frames
+    /*! \param _frame_i Body frame of particle i
+        \param _frame_j Body frame of particle j
+    */
+    HOSTDEVICE void setFrames(const frame_type* _frame_i, const frame_type* _frame_j)
+        {
+        frame_i = _frame_i;
+        frame_j = _frame_j;
+        }
+
     //! Evaluate the force and energy
     /*! \param force Output parameter to write the computed force.
         \param pair_eng Output parameter to write the computed pair energy.
@@ -220,8 +243,8 @@ class EvaluatorPairDipole
 
         // convert dipole vector in the body frame of each particle to space
         // frame
-        vec3<Scalar> p_i = rotate(quat<Scalar>(quat_i), mu_i);
-        vec3<Scalar> p_j = rotate(quat<Scalar>(quat_j), mu_j);
+        vec3<Scalar> p_i = frame_i ? *frame_i : rotate(quat<Scalar>(quat_i), mu_i);
+        vec3<Scalar> p_j = frame_j ? *frame_j : rotate(quat<Scalar>(quat_j), mu_j);
 
         vec3<Scalar> f;
         vec3<Scalar> t_i;
@@ -331,12 +354,14 @@ class EvaluatorPairDipole
 #endif
 
     protected:
-    Scalar3 dr;             //!< Stored vector pointing between particle centers of mass
-    Scalar rcutsq;          //!< Stored rcutsq from the constructor
-    Scalar q_i, q_j;        //!< Stored particle charges
-    Scalar4 quat_i, quat_j; //!< Stored quaternion of ith and jth particle from constructor
-    vec3<Scalar> mu_i;      /// Magnetic moment for ith particle
-    vec3<Scalar> mu_j;      /// Magnetic moment for jth particle
+    Scalar3 dr;                //!< Stored vector pointing between particle centers of mass
+    Scalar rcutsq;             //!< Stored rcutsq from the constructor
+    Scalar q_i, q_j;           //!< Stored particle charges
+    Scalar4 quat_i, quat_j;    //!< Stored quaternion of ith and jth particle from constructor
+    vec3<Scalar> mu_i;         /// Magnetic moment for ith particle
+    vec3<Scalar> mu_j;         /// Magnetic moment for jth particle
+    const frame_type* frame_i; //!< Precomputed space frame moment of particle i, or null
+    const frame_type* frame_j; //!< Precomputed space frame moment of particle j, or null
     Scalar A;
     Scalar kappa;
     // const param_type &params;   //!< The pair potential parameters
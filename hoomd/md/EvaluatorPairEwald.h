@@ -10,6 +10,10 @@
 
 #include "hoomd/HOOMDMath.h"
 
+#ifndef __HIPCC__
+#include "PairEvaluatorBatch.h"
+#endif
+
 /*! \file EvaluatorPairEwald.h
     \brief Defines the pair evaluator class for Ewald potentials
 */
@@ -147,6 +151,110 @@ class EvaluatorPairEwald
             return false;
         }
 
+    //! Evaluate the long range part of the interaction of unit charges
+    /*! \param rsq Squared distance between the particles
+        \param kappa Splitting parameter
+        \param alpha Debye screening parameter
+        \param force_divr Output parameter to write the force divided by r
+        \param energy Output parameter to write the energy
+
+        The long range part is the screened Coulomb interaction minus the real space term,
+        \f$ e^{-\alpha r} / r - V_{\mathrm{ewald}}(r) \f$. The reciprocal space sum includes it for
+        every pair, including the excluded ones.
+    */
+    HOSTDEVICE static void
+    evalLongRange(Scalar rsq, Scalar kappa, Scalar alpha, Scalar& force_divr, Scalar& energy)
+        {
+        Scalar rinv = fast::rsqrt(rsq);
+        Scalar r = Scalar(1.0) / rinv;
+
+        Scalar arg1 = kappa * r - alpha / (Scalar(2.0) * kappa);
+        Scalar arg2 = kappa * r + alpha / (Scalar(2.0) * kappa);
+        Scalar expfac1 = fast::exp(-alpha * r);
+        Scalar expfac2 = fast::exp(alpha * r);
+
+        // use erf for the leading term so that the difference does not cancel at small r
+        energy = Scalar(0.5) * rinv
+                 * (fast::erf(arg1) * expfac1 + expfac1 - fast::erfc(arg2) * expfac2);
+        force_divr = -rinv * rinv
+                     * (expfac1 * Scalar(2.0) * kappa * fast::exp(-arg1 * arg1)
+                            / fast::sqrt(Scalar(M_PI))
+                        - Scalar(0.5) * alpha
+                              * (expfac1 * fast::erfc(arg1) + expfac2 * fast::erfc(arg2))
+                        - energy);
+        }
+
+    //! Evaluate the correction for an excluded pair
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy
+        \param energy_shift Ignored, the correction is not shifted
+
+        PotentialPair does not compute the real space term for excluded pairs. The correction
+        removes the long range part of their interaction from the reciprocal space term. It
+        applies at all distances.
+
+        \return True if the correction is evaluated
+    */
+    DEVICE bool evalExclusionCorrection(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+        {
+        if (qiqj == 0 || rsq == 0)
+            return false;
+
+        evalLongRange(rsq, kappa, alpha, force_divr, pair_eng);
+        force_divr *= -qiqj;
+        pair_eng *= -qiqj;
+        return true;
+        }
+
+#ifndef __HIPCC__
+    //! Evaluate the force and energy of a batch of pairs on the CPU
+    /*! \tparam Real Precision of the evaluation, Scalar or float in mixed precision
+        \param batch Packed pairs, see detail::PairEvaluatorBatch
+     */
+    template<class Real>
+    static void evalForceAndEnergyBatch(detail::PairEvaluatorBatch<param_type, Real>& batch)
+        {
+        constexpr unsigned int width = detail::PairEvaluatorBatch<param_type, Real>::width;
+
+        // gather the parameters first so that the evaluation loop vectorizes
+        Real kappa[width];
+        Real alpha[width];
+        for (unsigned int lane = 0; lane < width; lane++)
+            {
+            const param_type& params = batch.params[batch.param_idx[lane]];
+            kappa[lane] = params.kappa;
+            alpha[lane] = params.alpha;
+            }
+
+        for (unsigned int lane = 0; lane < width; lane++)
+            {
+            const Real qiqj = batch.qiqj[lane];
+            const bool evaluated = batch.rsq[lane] < batch.rcutsq[lane];
+
+            // evaluate the masked lanes at r = 1 to avoid divisions by zero
+            const Real rinv = fast::rsqrt(evaluated ? batch.rsq[lane] : Real(1.0));
+            const Real r = Real(1.0) / rinv;
+
+            const Real arg1 = kappa[lane] * r + alpha[lane] / (Real(2.0) * kappa[lane]);
+            const Real arg2 = kappa[lane] * r - alpha[lane] / (Real(2.0) * kappa[lane]);
+            const Real expfac1 = fast::exp(alpha[lane] * r);
+            const Real expfac2 = fast::exp(-alpha[lane] * r);
+            const Real erfc1 = fast::erfc(arg1);
+            const Real erfc2 = fast::erfc(arg2);
+            const Real val = Real(0.5) * (erfc1 * expfac1 + erfc2 * expfac2) * rinv;
+
+            const Real force_divr = qiqj * rinv * rinv
+                                      * (val
+                                         + expfac2 * Real(2.0) * kappa[lane]
+                                               * fast::exp(-arg2 * arg2) / fast::sqrt(Real(M_PI))
+                                         + alpha[lane] * Real(0.5) * expfac2 * erfc2
+                                         - alpha[lane] * Real(0.5) * expfac1 * erfc1);
+            batch.force_divr[lane] = evaluated ? force_divr : Real(0.0);
+            batch.pair_eng[lane] = evaluated ? qiqj * val : Real(0.0);
+            }
+        }
+#endif
+
     DEVICE Scalar evalPressureLRCIntegral()
         {
         return 0;
@@ -0,0 +1,430 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#ifndef __PAIR_EVALUATOR_EWALD_TABLE_H__
+#define __PAIR_EVALUATOR_EWALD_TABLE_H__
+
+#ifndef __HIPCC__
+#include <string>
+#endif
+
+#include "EvaluatorPairEwald.h"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/ManagedArray.h"
+
+#ifndef __HIPCC__
+#include "PairEvaluatorBatch.h"
+#include <algorithm>
+#include <pybind11/pybind11.h>
+#endif
+
+/*! \file EvaluatorPairEwaldTable.h
+    \brief Defines the pair evaluator class for tabulated Ewald potentials
+*/
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// DEVICE is __host__ __device__ when included in nvcc and blank when included into the host
+// compiler
+#ifdef __HIPCC__
+#define DEVICE __device__
+#define HOSTDEVICE __host__ __device__
+#else
+#define DEVICE
+#define HOSTDEVICE
+#endif
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Class for evaluating the Ewald pair potential from a table
+/*! <b>General Overview</b>
+
+    See EvaluatorPairLJ
+
+    <b>Ewald table specifics</b>
+
+    EvaluatorPairEwaldTable evaluates the same function as EvaluatorPairEwald without calling erfc
+    and exp for every pair. The smooth functions \f$ r V(r) / (q_i q_j) \f$ and
+    \f$ r^3 F(r) / (q_i q_j r) \f$ are tabulated on a uniform grid in \f$ r^2 \f$ between
+    \f$ r_\mathrm{min} \f$ and the distance \f$ r_\mathrm{max} = (6 + \alpha / (2 \kappa)) /
+    \kappa \f$ where the complementary error functions vanish. The table holds the coefficients of
+    the cubic Hermite interpolant in each interval, so an evaluation is one table row lookup, two
+    polynomials, and a reciprocal square root. Pairs closer than \f$ r_\mathrm{min} \f$ or
+    beyond \f$ r_\mathrm{max} \f$ are evaluated directly.
+
+    On the GPU, the table is loaded into shared memory when it fits.
+*/
+class EvaluatorPairEwaldTable
+    {
+    public:
+    //! Number of coefficients per table interval: 4 for the energy and 4 for the force
+    static constexpr unsigned int n_coeff = 8;
+
+    //! Define the parameter type used by this pair potential evaluator
+    struct param_type
+        {
+        Scalar kappa;               //!< Splitting parameter
+        Scalar alpha;               //!< Debye screening parameter
+        Scalar r_min;               //!< Smallest tabulated distance
+        Scalar rsq_min;             //!< Square of the smallest tabulated distance
+        Scalar rsq_max;             //!< Square of the largest tabulated distance
+        Scalar inv_delta;           //!< Inverse of the table spacing in r^2
+        unsigned int width;         //!< Number of table intervals
+        ManagedArray<Scalar> coeff; //!< Interpolation coefficients, n_coeff per interval
+
+        //! Load dynamic data members into shared memory and increase pointer
+        /*! \param ptr Pointer to load data to (will be incremented)
+            \param available_bytes Size of remaining shared memory allocation
+         */
+        DEVICE void load_shared(char*& ptr, unsigned int& available_bytes)
+            {
+            coeff.load_shared(ptr, available_bytes);
+            }
+
+        HOSTDEVICE void allocate_shared(char*& ptr, unsigned int& available_bytes) const
+            {
+            coeff.allocate_shared(ptr, available_bytes);
+            }
+
+#ifdef ENABLE_HIP
+        //! Attach managed memory to CUDA stream
+        void set_memory_hint() const
+            {
+            coeff.set_memory_hint();
+            }
+#endif
+
+#ifndef __HIPCC__
+        param_type()
+            : kappa(0), alpha(0), r_min(0.5), rsq_min(0), rsq_max(0), inv_delta(0), width(1024)
+            {
+            }
+
+        param_type(pybind11::dict v, bool managed = false)
+            {
+            kappa = v["kappa"].cast<Scalar>();
+            alpha = v["alpha"].cast<Scalar>();
+            r_min = v["r_min"].cast<Scalar>();
+            width = v["width"].cast<unsigned int>();
+
+            if (r_min <= Scalar(0.0))
+                {
+                throw std::domain_error("r_min must be positive.");
+                }
+            if (width == 0)
+                {
+                throw std::domain_error("width must be positive.");
+                }
+
+            rsq_min = r_min * r_min;
+            rsq_max = rsq_min;
+            inv_delta = 0;
+
+            // kappa is 0 before md.long_range.pppm.Coulomb sets the parameters
+            if (kappa <= Scalar(0.0))
+                {
+                return;
+                }
+
+            double r_max = (6.0 + double(alpha) / (2.0 * double(kappa))) / double(kappa);
+            if (r_max <= double(r_min))
+                {
+                return;
+                }
+
+            rsq_max = Scalar(r_max * r_max);
+            double h = (r_max * r_max - double(rsq_min)) / double(width);
+            inv_delta = Scalar(1.0 / h);
+            coeff = ManagedArray<Scalar>(n_coeff * width, managed);
+
+            // step of the numerical derivatives, small enough to stay at positive r^2
+            double eps = std::min(h / 8.0, double(rsq_min) / 4.0);
+
+            for (unsigned int i = 0; i < width; i++)
+                {
+                double s0 = double(rsq_min) + double(i) * h;
+                double s1 = s0 + h;
+
+                double y0[2], y1[2], m0[2], m1[2];
+                evalSmooth(s0, y0);
+                evalSmooth(s1, y1);
+                evalSmoothDerivative(s0, eps, m0);
+                evalSmoothDerivative(s1, eps, m1);
+
+                // cubic Hermite interpolant in t = (s - s0) / h
+                for (unsigned int f = 0; f < 2; f++)
+                    {
+                    Scalar* c = coeff.get() + n_coeff * i + 4 * f;
+                    c[0] = Scalar(y0[f]);
+                    c[1] = Scalar(h * m0[f]);
+                    c[2] = Scalar(3.0 * (y1[f] - y0[f]) - 2.0 * h * m0[f] - h * m1[f]);
+                    c[3] = Scalar(2.0 * (y0[f] - y1[f]) + h * m0[f] + h * m1[f]);
+                    }
+                }
+            }
+
+        pybind11::dict asDict()
+            {
+            pybind11::dict v;
+            v["kappa"] = kappa;
+            v["alpha"] = alpha;
+            v["r_min"] = r_min;
+            v["width"] = width;
+            return v;
+            }
+
+        private:
+        //! Evaluate the tabulated functions r V / (q_i q_j) and r^3 F / (q_i q_j r)
+        void evalSmooth(double rsq, double* y) const
+            {
+            double force_divr, energy;
+            evalUnitCharges(rsq, double(kappa), double(alpha), force_divr, energy);
+            double r = sqrt(rsq);
+            y[0] = energy * r;
+            y[1] = force_divr * rsq * r;
+            }
+
+        //! Evaluate the derivatives of the tabulated functions with respect to r^2
+        void evalSmoothDerivative(double rsq, double eps, double* m) const
+            {
+            double ym2[2], ym1[2], yp1[2], yp2[2];
+            evalSmooth(rsq - 2.0 * eps, ym2);
+            evalSmooth(rsq - eps, ym1);
+            evalSmooth(rsq + eps, yp1);
+            evalSmooth(rsq + 2.0 * eps, yp2);
+            for (unsigned int f = 0; f < 2; f++)
+                m[f] = (ym2[f] - 8.0 * ym1[f] + 8.0 * yp1[f] - yp2[f]) / (12.0 * eps);
+            }
+#endif
+        }
+#if HOOMD_LONGREAL_SIZE == 32
+        __attribute__((aligned(8)));
+#else
+        __attribute__((aligned(16)));
+#endif
+
+    //! Constructs the pair potential evaluator
+    /*! \param _rsq Squared distance between the particles
+        \param _rcutsq Squared distance at which the potential goes to 0
+        \param _params Per type pair parameters of this potential
+    */
+    DEVICE EvaluatorPairEwaldTable(Scalar _rsq, Scalar _rcutsq, const param_type& _params)
+        : rsq(_rsq), rcutsq(_rcutsq), params(_params)
+        {
+        }
+
+    //! Ewald uses charge
+    DEVICE static bool needsCharge()
+        {
+        return true;
+        }
+
+    //! Accept the optional charge values.
+    /*! \param qi Charge of particle i
+        \param qj Charge of particle j
+    */
+    DEVICE void setCharge(Scalar qi, Scalar qj)
+        {
+        qiqj = qi * qj;
+        }
+
+    //! Evaluate the Ewald force and energy of two unit charges without the table
+    /*! \param rsq Squared distance between the particles
+        \param kappa Splitting parameter
+        \param alpha Debye screening parameter
+        \param force_divr Output parameter to write the computed force divided by r
+        \param energy Output parameter to write the computed pair energy
+    */
+    template<class Real>
+    HOSTDEVICE static void
+    evalUnitCharges(Real rsq, Real kappa, Real alpha, Real& force_divr, Real& energy)
+        {
+        Real rinv = fast::rsqrt(rsq);
+        Real r = Real(1.0) / rinv;
+
+        Real arg1 = kappa * r + alpha / (Real(2.0) * kappa);
+        Real arg2 = kappa * r - alpha / (Real(2.0) * kappa);
+        Real expfac1 = fast::exp(alpha * r);
+        Real expfac2 = fast::exp(-alpha * r);
+        Real erfc1 = fast::erfc(arg1);
+        Real erfc2 = fast::erfc(arg2);
+        energy = Real(0.5) * (erfc1 * expfac1 + erfc2 * expfac2) * rinv;
+
+        force_divr = rinv * rinv
+                     * (energy
+                        + expfac2 * Real(2.0) * kappa * fast::exp(-arg2 * arg2)
+                              / fast::sqrt(Real(M_PI))
+                        + alpha * Real(0.5) * expfac2 * erfc2
+                        - alpha * Real(0.5) * expfac1 * erfc1);
+        }
+
+    //! Evaluate the force and energy
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy
+        \param energy_shift Ignored, the Ewald potential is not shifted.
+
+        \return True if they are evaluated or false if they are not because we are beyond the cutoff
+    */
+    DEVICE bool evalForceAndEnergy(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+        {
+        if (rsq < rcutsq && qiqj != 0)
+            {
+            if (rsq >= params.rsq_min && rsq < params.rsq_max)
+                {
+                Scalar x = (rsq - params.rsq_min) * params.inv_delta;
+                unsigned int i = static_cast<unsigned int>(x);
+                i = i < params.width ? i : params.width - 1;
+                Scalar t = x - Scalar(i);
+                const unsigned int offset = n_coeff * i;
+
+                Scalar energy_r = params.coeff[offset]
+                                  + t
+                                        * (params.coeff[offset + 1]
+                                           + t
+                                                 * (params.coeff[offset + 2]
+                                                    + t * params.coeff[offset + 3]));
+                Scalar force_r3 = params.coeff[offset + 4]
+                                  + t
+                                        * (params.coeff[offset + 5]
+                                           + t
+                                                 * (params.coeff[offset + 6]
+                                                    + t * params.coeff[offset + 7]));
+
+                Scalar rinv = fast::rsqrt(rsq);
+                pair_eng = qiqj * energy_r * rinv;
+                force_divr = qiqj * force_r3 * rinv * rinv * rinv;
+                }
+            else
+                {
+                Scalar unit_force_divr, unit_energy;
+                evalUnitCharges(rsq, params.kappa, params.alpha, unit_force_divr, unit_energy);
+                force_divr = qiqj * unit_force_divr;
+                pair_eng = qiqj * unit_energy;
+                }
+
+            return true;
+            }
+        else
+            return false;
+        }
+
+    //! Evaluate the correction for an excluded pair
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy
+        \param energy_shift Ignored, the correction is not shifted
+
+        See EvaluatorPairEwald::evalExclusionCorrection(). The correction is evaluated directly.
+
+        \return True if the correction is evaluated
+    */
+    DEVICE bool evalExclusionCorrection(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+        {
+        if (qiqj == 0 || rsq == 0)
+            return false;
+
+        EvaluatorPairEwald::evalLongRange(rsq, params.kappa, params.alpha, force_divr, pair_eng);
+        force_divr *= -qiqj;
+        pair_eng *= -qiqj;
+        return true;
+        }
+
+#ifndef __HIPCC__
+    //! Evaluate the force and energy of a batch of pairs on the CPU
+    /*! \tparam Real Precision of the evaluation, Scalar or float in mixed precision
+        \param batch Packed pairs, see detail::PairEvaluatorBatch
+
+        The table lookups and the interpolation of all lanes are one loop without branches. The
+        rare lanes outside of the table are evaluated directly afterwards.
+     */
+    template<class Real>
+    static void evalForceAndEnergyBatch(detail::PairEvaluatorBatch<param_type, Real>& batch)
+        {
+        constexpr unsigned int width = detail::PairEvaluatorBatch<param_type, Real>::width;
+
+        // gather the table rows first so that the interpolation loop vectorizes, the lanes outside
+        // of the table read the first row
+        Real c[n_coeff][width];
+        Real t[width];
+        for (unsigned int lane = 0; lane < width; lane++)
+            {
+            const param_type& params = batch.params[batch.param_idx[lane]];
+            const Real rsq = batch.rsq[lane];
+            const bool tabulated = rsq >= Real(params.rsq_min) && rsq < Real(params.rsq_max);
+
+            const Real x
+                = tabulated ? (rsq - Real(params.rsq_min)) * Real(params.inv_delta) : Real(0.0);
+            const unsigned int i
+                = tabulated ? std::min(static_cast<unsigned int>(x), params.width - 1) : 0;
+            t[lane] = x - Real(i);
+            for (unsigned int k = 0; k < n_coeff; k++)
+                c[k][lane] = tabulated ? Real(params.coeff[n_coeff * i + k]) : Real(0.0);
+            }
+
+        for (unsigned int lane = 0; lane < width; lane++)
+            {
+            const Real qiqj = batch.qiqj[lane];
+            const bool evaluated = batch.rsq[lane] < batch.rcutsq[lane];
+
+            // evaluate the masked lanes at r = 1 to avoid divisions by zero
+            const Real rinv = fast::rsqrt(evaluated ? batch.rsq[lane] : Real(1.0));
+            const Real x = t[lane];
+            const Real energy_r = c[0][lane] + x * (c[1][lane] + x * (c[2][lane] + x * c[3][lane]));
+            const Real force_r3 = c[4][lane] + x * (c[5][lane] + x * (c[6][lane] + x * c[7][lane]));
+
+            batch.force_divr[lane] = evaluated ? qiqj * force_r3 * rinv * rinv * rinv : Real(0.0);
+            batch.pair_eng[lane] = evaluated ? qiqj * energy_r * rinv : Real(0.0);
+            }
+
+        for (unsigned int lane = 0; lane < width; lane++)
+            {
+            const param_type& params = batch.params[batch.param_idx[lane]];
+            const Real rsq = batch.rsq[lane];
+            if (!(rsq < batch.rcutsq[lane])
+                || (rsq >= Real(params.rsq_min) && rsq < Real(params.rsq_max)))
+                continue;
+
+            Real force_divr, energy;
+            evalUnitCharges(rsq, Real(params.kappa), Real(params.alpha), force_divr, energy);
+            batch.force_divr[lane] = batch.qiqj[lane] * force_divr;
+            batch.pair_eng[lane] = batch.qiqj[lane] * energy;
+            }
+        }
+#endif
+
+    DEVICE Scalar evalPressureLRCIntegral()
+        {
+        return 0;
+        }
+
+    DEVICE Scalar evalEnergyLRCIntegral()
+        {
+        return 0;
+        }
+
+#ifndef __HIPCC__
+    //! Get the name of this potential
+    /*! \returns The potential name.
+     */
+    static std::string getName()
+        {
+        return std::string("ewald_table");
+        }
+
+    std::string getShapeSpec() const
+        {
+        throw std::runtime_error("Shape definition not supported for this pair potential.");
+        }
+#endif
+
+    protected:
+    Scalar rsq;               //!< Stored rsq from the constructor
+    Scalar rcutsq;            //!< Stored rcutsq from the constructor
+    const param_type& params; //!< Parameters of the pair, including the table
+    Scalar qiqj;              //!< product of qi and qj
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __PAIR_EVALUATOR_EWALD_TABLE_H__
@@ -129,6 +129,18 @@ class EvaluatorPairGB
 #endif
         };
 
+    //! Body frame of a particle: the long axis in the space frame
+    typedef vec3<Scalar> frame_type;
+
+    //! Compute the body frame of a particle
+    /*! \param orientation Orientation quaternion of the particle
+        \param shape Shape of the particle
+    */
+    HOSTDEVICE static frame_type computeFrame(const Scalar4& orientation, const shape_type& shape)
+        {
+        return rotmat3<Scalar>(conj(quat<Scalar>(orientation))).row2;
+        }
+
     //! Constructs the pair potential evaluator
     /*! \param _dr Displacement vector between particle centers of mass
         \param _rcutsq Squared distance at which the potential goes to 0
@@ -141,8 +153,8 @@ class EvaluatorPairGB
                                const Scalar4& _qj,
                                const Scalar _rcutsq,
                                const param_type& _params)
-        : dr(_dr), rcutsq(_rcutsq), qi(_qi), qj(_qj), epsilon(_params.epsilon),
-          lperp(_params.lperp), lpar(_params.lpar)
+        : dr(_dr), rcutsq(_rcutsq), qi(_qi), qj(_qj), frame_i(nullptr), frame_j(nullptr),
+          epsilon(_params.epsilon), lperp(_params.lperp), lpar(_params.lpar)
         {
         }
 
@@ -188,6 +200,16 @@ class EvaluatorPairGB
     */
     HOSTDEVICE void setCharge(Scalar qi, Scalar qj) { }
 
+    //! Accept the optional precomputed body frames
+    /*! \param _frame_i Body frame of particle i
+        \param _frame_j Body frame of particle j
+    */
+    HOSTDEVICE void setFrames(const frame_type* _frame_i, const frame_type* _frame_j)
+        {
+        frame_i = _frame_i;
+        frame_j = _frame_j;
+        }
+
     //! Evaluate the force and energy
     /*! \param force Output parameter to write the computed force.
         \param pair_eng Output parameter to write the computed pair energy.
@@ -206,13 +228,9 @@ class EvaluatorPairGB
         Scalar r = fast::sqrt(rsq);
         vec3<Scalar> unitr = fast::rsqrt(dot(dr, dr)) * dr;
 
-        // obtain rotation matrices (space->body)
-        rotmat3<Scalar> rotA(conj(qi));
-        rotmat3<Scalar> rotB(conj(qj));
-
-        // last row of rotation matrix
-        vec3<Scalar> a3 = rotA.row2;
-        vec3<Scalar> b3 = rotB.row2;
+        // last row of the rotation matrices (space->body)
+        vec3<Scalar> a3 = frame_i ? *frame_i : rotmat3<Scalar>(conj(qi)).row2;
+        vec3<Scalar> b3 = frame_j ? *frame_j : rotmat3<Scalar>(conj(qj)).row2;
 
         Scalar ca = dot(a3, unitr);
         Scalar cb = dot(b3, unitr);
@@ -308,10 +326,12 @@ class EvaluatorPairGB
 #endif
 
     protected:
-    vec3<Scalar> dr; //!< Stored dr from the constructor
-    Scalar rcutsq;   //!< Stored rcutsq from the constructor
-    quat<Scalar> qi; //!< Orientation quaternion for particle i
-    quat<Scalar> qj; //!< Orientation quaternion for particle j
+    vec3<Scalar> dr;           //!< Stored dr from the constructor
+    Scalar rcutsq;             //!< Stored rcutsq from the constructor
+    quat<Scalar> qi;           //!< Orientation quaternion for particle i
+    quat<Scalar> qj;           //!< Orientation quaternion for particle j
+    const frame_type* frame_i; //!< Precomputed body frame of particle i, or null
+    const frame_type* frame_j; //!< Precomputed body frame of particle j, or null
     Scalar epsilon;
     Scalar lperp;
     Scalar lpar;
@@ -10,6 +10,10 @@
 
 #include "hoomd/HOOMDMath.h"
 
+#ifndef __HIPCC__
+#include "PairEvaluatorBatch.h"
+#endif
+
 /*! \file EvaluatorPairGauss.h
     \brief Defines the pair evaluator class for Gaussian potentials
 */
@@ -144,6 +148,45 @@ class EvaluatorPairGauss
             return false;
         }
 
+#ifndef __HIPCC__
+    //! Evaluate the force and energy of a batch of pairs on the CPU
+    /*! \tparam Real Precision of the evaluation, Scalar or float in mixed precision
+        \param batch Packed pairs, see detail::PairEvaluatorBatch
+     */
+    template<class Real>
+    static void evalForceAndEnergyBatch(detail::PairEvaluatorBatch<param_type, Real>& batch)
+        {
+        constexpr unsigned int width = detail::PairEvaluatorBatch<param_type, Real>::width;
+
+        // gather the parameters first so that the evaluation loop vectorizes
+        Real epsilon[width];
+        Real sigma_sq[width];
+        for (unsigned int lane = 0; lane < width; lane++)
+            {
+            const param_type& params = batch.params[batch.param_idx[lane]];
+            epsilon[lane] = params.epsilon;
+            sigma_sq[lane] = params.sigma * params.sigma;
+            }
+
+        for (unsigned int lane = 0; lane < width; lane++)
+            {
+            const bool evaluated = batch.rsq[lane] < batch.rcutsq[lane];
+            const bool shift = batch.energy_shift[lane] != Real(0.0);
+
+            const Real exp_val
+                = fast::exp(-Real(1.0) / Real(2.0) * batch.rsq[lane] / sigma_sq[lane]);
+            const Real exp_cut
+                = fast::exp(-Real(1.0) / Real(2.0) * batch.rcutsq[lane] / sigma_sq[lane]);
+
+            const Real force_divr = epsilon[lane] / sigma_sq[lane] * exp_val;
+            const Real pair_eng
+                = epsilon[lane] * exp_val - (shift ? epsilon[lane] * exp_cut : Real(0.0));
+            batch.force_divr[lane] = evaluated ? force_divr : Real(0.0);
+            batch.pair_eng[lane] = evaluated ? pair_eng : Real(0.0);
+            }
+        }
+#endif
+
     DEVICE Scalar evalPressureLRCIntegral()
         {
         return 0;
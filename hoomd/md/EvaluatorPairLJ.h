@@ -10,6 +10,10 @@
 
 #include "hoomd/HOOMDMath.h"
 
+#ifndef __HIPCC__
+#include "PairEvaluatorBatch.h"
+#endif
+
 /*! \file EvaluatorPairLJ.h
     \brief Defines the pair evaluator class for LJ potentials
     \details As the prototypical example of a MD pair potential, this also serves as the primary
@@ -210,6 +214,44 @@ class EvaluatorPairLJ
             return false;
         }
 
+#ifndef __HIPCC__
+    //! Evaluate the force and energy of a batch of pairs on the CPU
+    /*! \tparam Real Precision of the evaluation, Scalar or float in mixed precision
+        \param batch Packed pairs, see detail::PairEvaluatorBatch
+     */
+    template<class Real>
+    static void evalForceAndEnergyBatch(detail::PairEvaluatorBatch<param_type, Real>& batch)
+        {
+        constexpr unsigned int width = detail::PairEvaluatorBatch<param_type, Real>::width;
+
+        // gather the parameters first so that the evaluation loop vectorizes
+        Real lj1[width];
+        Real lj2[width];
+        for (unsigned int lane = 0; lane < width; lane++)
+            {
+            const param_type& params = batch.params[batch.param_idx[lane]];
+            lj1[lane] = params.epsilon_x_4 * params.sigma_6 * params.sigma_6;
+            lj2[lane] = params.epsilon_x_4 * params.sigma_6;
+            }
+
+        for (unsigned int lane = 0; lane < width; lane++)
+            {
+            const bool evaluated = batch.rsq[lane] < batch.rcutsq[lane];
+            const bool shift = evaluated && batch.energy_shift[lane] != Real(0.0);
+
+            const Real r2inv = evaluated ? Real(1.0) / batch.rsq[lane] : Real(0.0);
+            const Real r6inv = r2inv * r2inv * r2inv;
+            const Real rcut2inv = shift ? Real(1.0) / batch.rcutsq[lane] : Real(0.0);
+            const Real rcut6inv = rcut2inv * rcut2inv * rcut2inv;
+
+            batch.force_divr[lane]
+                = r2inv * r6inv * (Real(12.0) * lj1[lane] * r6inv - Real(6.0) * lj2[lane]);
+            batch.pair_eng[lane] = r6inv * (lj1[lane] * r6inv - lj2[lane])
+                                   - rcut6inv * (lj1[lane] * rcut6inv - lj2[lane]);
+            }
+        }
+#endif
+
     DEVICE Scalar evalPressureLRCIntegral()
         {
         if (rcutsq == 0)
@@ -0,0 +1,275 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#ifndef __PAIR_EVALUATOR_LJ_DISPERSION_EWALD_H__
+#define __PAIR_EVALUATOR_LJ_DISPERSION_EWALD_H__
+
+#ifndef __HIPCC__
+#include <string>
+#endif
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file EvaluatorPairLJDispersionEwald.h
+    \brief Defines the pair evaluator class for the real space part of LJ with dispersion PPPM
+*/
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// DEVICE is __host__ __device__ when included in nvcc and blank when included into the host
+// compiler
+#ifdef __HIPCC__
+#define DEVICE __device__
+#define HOSTDEVICE __host__ __device__
+#else
+#define DEVICE
+#define HOSTDEVICE
+#endif
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Class for evaluating the real space part of the LJ potential with dispersion PPPM
+/*! <b>General Overview</b>
+
+    See EvaluatorPairLJ
+
+    <b>LJDispersionEwald specifics</b>
+
+    PPPMForceCompute in dispersion mode computes the long range part
+    \f$ -C_{ij} [1 - g(\kappa r)] / r^6 \f$ of the dispersion interaction of every pair on the
+    mesh, where \f$ C_{ij} = c_i c_j \f$ is the geometric combination of per type coefficients and
+
+    \f[ g(x) = e^{-x^2} \left(1 + x^2 + \frac{x^4}{2}\right) \f]
+
+    EvaluatorPairLJDispersionEwald evaluates the LJ potential minus the mesh term inside the cutoff:
+
+    \f[ V(r) = 4 \varepsilon \left[ \left(\frac{\sigma}{r}\right)^{12}
+                                    - \left(\frac{\sigma}{r}\right)^{6} \right]
+               + C_{ij} \frac{1 - g(\kappa r)}{r^6} \f]
+
+    When \f$ 4 \varepsilon \sigma^6 = C_{ij} \f$, the dispersion terms combine to
+    \f$ -C_{ij} g(\kappa r) / r^6 \f$, which decays as a Gaussian, and the sum of the real space
+    and mesh terms is the full LJ potential without truncation.
+*/
+class EvaluatorPairLJDispersionEwald
+    {
+    public:
+    //! Define the parameter type used by this pair potential evaluator
+    struct param_type
+        {
+        Scalar sigma_6;
+        Scalar epsilon_x_4;
+        Scalar kappa;
+        Scalar c6_mesh;
+
+        DEVICE void load_shared(char*& ptr, unsigned int& available_bytes) { }
+
+        HOSTDEVICE void allocate_shared(char*& ptr, unsigned int& available_bytes) const { }
+
+#ifdef ENABLE_HIP
+        //! Set CUDA memory hints
+        void set_memory_hint() const { }
+#endif
+
+#ifndef __HIPCC__
+        param_type() : sigma_6(0), epsilon_x_4(0), kappa(0), c6_mesh(0) { }
+
+        param_type(pybind11::dict v, bool managed = false)
+            {
+            auto sigma(v["sigma"].cast<Scalar>());
+            auto epsilon(v["epsilon"].cast<Scalar>());
+
+            sigma_6 = sigma * sigma * sigma * sigma * sigma * sigma;
+            epsilon_x_4 = Scalar(4.0) * epsilon;
+            kappa = v["kappa"].cast<Scalar>();
+            c6_mesh = v["c6_mesh"].cast<Scalar>();
+            }
+
+        pybind11::dict asDict()
+            {
+            pybind11::dict v;
+            v["sigma"] = pow(sigma_6, 1. / 6.);
+            v["epsilon"] = epsilon_x_4 / 4.0;
+            v["kappa"] = kappa;
+            v["c6_mesh"] = c6_mesh;
+            return v;
+            }
+#endif
+        }
+#if HOOMD_LONGREAL_SIZE == 32
+        __attribute__((aligned(8)));
+#else
+        __attribute__((aligned(16)));
+#endif
+
+    //! Constructs the pair potential evaluator
+    /*! \param _rsq Squared distance between the particles
+        \param _rcutsq Squared distance at which the potential goes to 0
+        \param _params Per type pair parameters of this potential
+    */
+    DEVICE EvaluatorPairLJDispersionEwald(Scalar _rsq, Scalar _rcutsq, const param_type& _params)
+        : rsq(_rsq), rcutsq(_rcutsq), lj1(_params.epsilon_x_4 * _params.sigma_6 * _params.sigma_6),
+          lj2(_params.epsilon_x_4 * _params.sigma_6), kappa(_params.kappa),
+          c6_mesh(_params.c6_mesh)
+        {
+        }
+
+    //! LJDispersionEwald doesn't use charge
+    DEVICE static bool needsCharge()
+        {
+        return false;
+        }
+    //! Accept the optional charge values.
+    /*! \param qi Charge of particle i
+        \param qj Charge of particle j
+    */
+    DEVICE void setCharge(Scalar qi, Scalar qj) { }
+
+    //! Evaluate (1 - g(x)) / x^6
+    /*! \param y Square of x
+
+        The series \f$ e^{-y} \sum_{n \ge 3} y^{n - 3} / n! \f$ avoids the cancellation of the
+        closed form at small y.
+    */
+    HOSTDEVICE static Scalar evalScreening(Scalar y)
+        {
+        if (y < Scalar(1.0))
+            {
+            Scalar term = Scalar(1.0) / Scalar(6.0);
+            Scalar sum = Scalar(0.0);
+            for (unsigned int n = 4; n < 16; n++)
+                {
+                sum += term;
+                term *= y / Scalar(n);
+                }
+            return fast::exp(-y) * sum;
+            }
+
+        return (Scalar(1.0) - fast::exp(-y) * (Scalar(1.0) + y + Scalar(0.5) * y * y))
+               / (y * y * y);
+        }
+
+    //! Evaluate the long range part of the dispersion interaction of unit coefficients
+    /*! \param rsq Squared distance between the particles
+        \param kappa Splitting parameter
+        \param force_divr Output parameter to write the force divided by r
+        \param energy Output parameter to write the energy
+
+        The long range part is \f$ -[1 - g(\kappa r)] / r^6 \f$. The mesh includes it for every
+        pair, including the excluded ones.
+    */
+    HOSTDEVICE static void
+    evalLongRange(Scalar rsq, Scalar kappa, Scalar& force_divr, Scalar& energy)
+        {
+        Scalar kappa_sq = kappa * kappa;
+        Scalar kappa_6 = kappa_sq * kappa_sq * kappa_sq;
+        Scalar y = kappa_sq * rsq;
+
+        Scalar screening = kappa_6 * evalScreening(y);
+        energy = -screening;
+        force_divr = (kappa_6 * fast::exp(-y) - Scalar(6.0) * screening) / rsq;
+        }
+
+    //! Evaluate the force and energy
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy
+        \param energy_shift If true, the potential must be shifted so that
+        V(r) is continuous at the cutoff
+        \note There is no need to check if rsq < rcutsq in this method.
+        Cutoff tests are performed in PotentialPair.
+
+        \return True if they are evaluated or false if they are not because
+        we are beyond the cutoff
+    */
+    DEVICE bool evalForceAndEnergy(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+        {
+        if (rsq < rcutsq && (lj1 != 0 || c6_mesh != 0))
+            {
+            Scalar r2inv = Scalar(1.0) / rsq;
+            Scalar r6inv = r2inv * r2inv * r2inv;
+
+            Scalar mesh_force_divr, mesh_eng;
+            evalLongRange(rsq, kappa, mesh_force_divr, mesh_eng);
+
+            // subtract the mesh term
+            force_divr = r2inv * r6inv * (Scalar(12.0) * lj1 * r6inv - Scalar(6.0) * lj2)
+                         - c6_mesh * mesh_force_divr;
+            pair_eng = r6inv * (lj1 * r6inv - lj2) - c6_mesh * mesh_eng;
+
+            if (energy_shift)
+                {
+                Scalar rcut2inv = Scalar(1.0) / rcutsq;
+                Scalar rcut6inv = rcut2inv * rcut2inv * rcut2inv;
+                Scalar rcut_force_divr, rcut_mesh_eng;
+                evalLongRange(rcutsq, kappa, rcut_force_divr, rcut_mesh_eng);
+                pair_eng -= rcut6inv * (lj1 * rcut6inv - lj2) - c6_mesh * rcut_mesh_eng;
+                }
+            return true;
+            }
+        else
+            return false;
+        }
+
+    //! Evaluate the correction for an excluded pair
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy
+        \param energy_shift Ignored, the correction is not shifted
+
+        PotentialPair does not compute the real space term for excluded pairs. The correction
+        removes the long range part of their interaction from the mesh term. It applies at all
+        distances.
+
+        \return True if the correction is evaluated
+    */
+    DEVICE bool evalExclusionCorrection(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+        {
+        if (c6_mesh == 0 || rsq == 0)
+            return false;
+
+        evalLongRange(rsq, kappa, force_divr, pair_eng);
+        force_divr *= -c6_mesh;
+        pair_eng *= -c6_mesh;
+        return true;
+        }
+
+    //! The mesh term includes the dispersion interaction beyond the cutoff
+    DEVICE Scalar evalPressureLRCIntegral()
+        {
+        return 0;
+        }
+
+    //! The mesh term includes the dispersion interaction beyond the cutoff
+    DEVICE Scalar evalEnergyLRCIntegral()
+        {
+        return 0;
+        }
+
+#ifndef __HIPCC__
+    //! Get the name of this potential
+    /*! \returns The potential name.
+     */
+    static std::string getName()
+        {
+        return std::string("lj_dispersion_ewald");
+        }
+
+    std::string getShapeSpec() const
+        {
+        throw std::runtime_error("Shape definition not supported for this pair potential.");
+        }
+#endif
+
+    protected:
+    Scalar rsq;     //!< Stored rsq from the constructor
+    Scalar rcutsq;  //!< Stored rcutsq from the constructor
+    Scalar lj1;     //!< lj1 parameter extracted from the params passed to the constructor
+    Scalar lj2;     //!< lj2 parameter extracted from the params passed to the constructor
+    Scalar kappa;   //!< Splitting parameter
+    Scalar c6_mesh; //!< Dispersion coefficient of the mesh term
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __PAIR_EVALUATOR_LJ_DISPERSION_EWALD_H__
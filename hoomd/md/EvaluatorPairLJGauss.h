@@ -165,6 +165,28 @@ class EvaluatorPairLJGauss
         return 0;
         }
 
+    /** Calculate derivative of the alchemical potential with repsect to alpha.
+
+        \param alchemical_derivatives Output dU/d alpha of the num_alchemical_parameters parameters
+        \param alphas Values of the num_alchemical_parameters alchemical degrees of freedom
+
+        The parameters of the evaluator must not be updated with the alphas.
+    */
+    DEVICE void evalAlchemyDerivatives(Scalar* alchemical_derivatives, const Scalar* alphas)
+        {
+        Scalar r = fast::sqrt(rsq);
+        Scalar sigma2 = sigma * sigma;
+        Scalar inva1 = Scalar(1.0) / alphas[1];
+        Scalar invsiga1sq = inva1 * inva1 * (Scalar(1.0) / sigma2);
+        Scalar rdiff = r - alphas[2] * r0;
+        Scalar rdiffsq = rdiff * rdiff;
+        Scalar exp_term = fast::exp(-Scalar(0.5) * rdiffsq * invsiga1sq);
+        Scalar c = -alphas[0] * epsilon * exp_term * invsiga1sq;
+        alchemical_derivatives[0] = -epsilon * exp_term;
+        alchemical_derivatives[1] = c * rdiffsq * inva1;
+        alchemical_derivatives[2] = c * r0 * rdiff;
+        }
+
 #ifndef __HIPCC__
 
     /** Get the index of am alchemical parameter based on the string name.
@@ -222,19 +244,7 @@ class EvaluatorPairLJGauss
     evalAlchemyDerivatives(std::array<Scalar, num_alchemical_parameters>& alchemical_derivatives,
                            const std::array<Scalar, num_alchemical_parameters>& alphas)
         {
-            {
-            Scalar r = fast::sqrt(rsq);
-            Scalar sigma2 = sigma * sigma;
-            Scalar inva1 = 1.0 / alphas[1];
-            Scalar invsiga1sq = inva1 * inva1 * (1 / sigma2);
-            Scalar rdiff = r - alphas[2] * r0;
-            Scalar rdiffsq = rdiff * rdiff;
-            Scalar exp_term = fast::exp(-Scalar(0.5) * rdiffsq * invsiga1sq);
-            Scalar c = -alphas[0] * epsilon * exp_term * invsiga1sq;
-            alchemical_derivatives[0] = -epsilon * exp_term;
-            alchemical_derivatives[1] = c * rdiffsq * inva1;
-            alchemical_derivatives[2] = c * r0 * rdiff;
-            }
+        evalAlchemyDerivatives(alchemical_derivatives.data(), alphas.data());
         }
 
     //! Get the name of this potential
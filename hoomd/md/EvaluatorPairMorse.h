@@ -10,6 +10,10 @@
 
 #include "hoomd/HOOMDMath.h"
 
+#ifndef __HIPCC__
+#include "PairEvaluatorBatch.h"
+#endif
+
 /*! \file EvaluatorPairMorse.h
     \brief Defines the pair evaluator class for Morse potential
 */
@@ -141,6 +145,51 @@ class EvaluatorPairMorse
             return false;
         }
 
+#ifndef __HIPCC__
+    //! Evaluate the force and energy of a batch of pairs on the CPU
+    /*! \tparam Real Precision of the evaluation, Scalar or float in mixed precision
+        \param batch Packed pairs, see detail::PairEvaluatorBatch
+     */
+    template<class Real>
+    static void evalForceAndEnergyBatch(detail::PairEvaluatorBatch<param_type, Real>& batch)
+        {
+        constexpr unsigned int width = detail::PairEvaluatorBatch<param_type, Real>::width;
+
+        // gather the parameters first so that the evaluation loop vectorizes
+        Real D0[width];
+        Real alpha[width];
+        Real r0[width];
+        for (unsigned int lane = 0; lane < width; lane++)
+            {
+            const param_type& params = batch.params[batch.param_idx[lane]];
+            D0[lane] = params.D0;
+            alpha[lane] = params.alpha;
+            r0[lane] = params.r0;
+            }
+
+        for (unsigned int lane = 0; lane < width; lane++)
+            {
+            const bool evaluated = batch.rsq[lane] < batch.rcutsq[lane];
+            const bool shift = batch.energy_shift[lane] != Real(0.0);
+
+            // evaluate the masked lanes at r = 1 to avoid divisions by zero, the results of all
+            // masked lanes are discarded below
+            const Real r = fast::sqrt(evaluated ? batch.rsq[lane] : Real(1.0));
+            const Real exp_factor = fast::exp(-alpha[lane] * (r - r0[lane]));
+            const Real rcut = fast::sqrt(batch.rcutsq[lane]);
+            const Real exp_factor_cut = fast::exp(-alpha[lane] * (rcut - r0[lane]));
+            const Real eng_cut
+                = shift ? D0[lane] * exp_factor_cut * (exp_factor_cut - Real(2.0)) : Real(0.0);
+
+            const Real force_divr = Real(2.0) * D0[lane] * alpha[lane] * exp_factor
+                                      * (exp_factor - Real(1.0)) / r;
+            const Real pair_eng = D0[lane] * exp_factor * (exp_factor - Real(2.0)) - eng_cut;
+            batch.force_divr[lane] = evaluated ? force_divr : Real(0.0);
+            batch.pair_eng[lane] = evaluated ? pair_eng : Real(0.0);
+            }
+        }
+#endif
+
     DEVICE Scalar evalPressureLRCIntegral()
         {
         return 0;
@@ -150,6 +150,44 @@ class EvaluatorPairReactionField
             return false;
         }
 
+    //! Evaluate the correction for an excluded pair
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy
+        \param energy_shift If true, the correction is shifted by the same constant as the potential
+
+        The dielectric continuum beyond the cutoff also polarizes in response to excluded pairs.
+        Excluded pairs within the cutoff interact with the reaction field term of the potential,
+        without the direct \f$ 1/r \f$ term.
+
+        \return True if the correction is evaluated or false if the pair is beyond the cutoff
+    */
+    DEVICE bool evalExclusionCorrection(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+        {
+        if (rsq < rcutsq && epsilon != 0 && qiqj != 0)
+            {
+            Scalar rcut3inv = fast::rsqrt(rcutsq) / rcutsq;
+
+            Scalar eps_fac = (epsrf - Scalar(1.0)) / (Scalar(2.0) * epsrf + Scalar(1.0)) * rcut3inv;
+            if (epsrf == Scalar(0.0))
+                {
+                eps_fac = Scalar(1.0 / 2.0) * rcut3inv;
+                }
+
+            force_divr = -qiqj * epsilon * Scalar(2.0) * eps_fac;
+            pair_eng = qiqj * epsilon * eps_fac * rsq;
+
+            if (energy_shift)
+                {
+                Scalar rcutinv = fast::rsqrt(rcutsq);
+                Scalar rcut = Scalar(1.0) / rcutinv;
+                pair_eng -= qiqj * epsilon * (rcutinv + eps_fac * rcut * rcut);
+                }
+            return true;
+            }
+        else
+            return false;
+        }
+
     DEVICE Scalar evalPressureLRCIntegral()
         {
         return 0;
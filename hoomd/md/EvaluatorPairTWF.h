@@ -44,6 +44,7 @@ class EvaluatorPairTWF
         Scalar sigma;
         Scalar alpha;
         Scalar prefactor;
+        Scalar sigma_sq_inv; //!< 1 / sigma^2, packed from sigma when it is set
 
         DEVICE void load_shared(char*& ptr, unsigned int& available_bytes) { }
 
@@ -58,17 +59,19 @@ class EvaluatorPairTWF
 #endif
 
 #ifndef __HIPCC__
-        param_type() : sigma(1), alpha(1), prefactor(1) { }
+        param_type() : sigma(1), alpha(1), prefactor(1), sigma_sq_inv(1) { }
 
         param_type(pybind11::dict v, bool managed = false)
             {
             sigma = v["sigma"].cast<Scalar>();
             alpha = v["alpha"].cast<Scalar>();
             prefactor = 4.0 * v["epsilon"].cast<Scalar>() / (alpha * alpha);
+            sigma_sq_inv = Scalar(1.0) / (sigma * sigma);
             }
 
         param_type(Scalar sigma, Scalar epsilon, Scalar alpha, bool managed = false)
-            : sigma(sigma), alpha(alpha), prefactor(4 * epsilon / (alpha * alpha))
+            : sigma(sigma), alpha(alpha), prefactor(4 * epsilon / (alpha * alpha)),
+              sigma_sq_inv(Scalar(1.0) / (sigma * sigma))
             {
             }
 
@@ -133,19 +136,19 @@ class EvaluatorPairTWF
                 return true;
                 }
 
-            Scalar common_term = 1.0 / (rsq / sigma2 - 1.0);
+            Scalar common_term = 1.0 / (rsq * params.sigma_sq_inv - 1.0);
             Scalar common_term3 = common_term * common_term * common_term;
             Scalar common_term6 = common_term3 * common_term3;
             // Compute force and energy
             pair_eng = params.prefactor * (common_term6 - params.alpha * common_term3);
             // The force term is -(dE / dr) * (1 / r).
-            Scalar force_term = 6 * common_term / sigma2;
+            Scalar force_term = 6 * common_term * params.sigma_sq_inv;
             force_divr
                 = params.prefactor * force_term * (2 * common_term6 - params.alpha * common_term3);
 
             if (energy_shift)
                 {
-                Scalar common_term_shift = 1.0 / (rcutsq / sigma2 - 1.0);
+                Scalar common_term_shift = 1.0 / (rcutsq * params.sigma_sq_inv - 1.0);
                 Scalar common_term3_shift
                     = common_term_shift * common_term_shift * common_term_shift;
                 Scalar common_term6_shift = common_term3_shift * common_term3_shift;
@@ -14,6 +14,7 @@
 #endif
 
 #ifndef __HIPCC__
+#include "PairEvaluatorBatch.h"
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #endif
@@ -193,6 +194,49 @@ class EvaluatorPairTable
         return true;
         }
 
+#ifndef __HIPCC__
+    //! Evaluate the force and energy of a batch of pairs on the CPU
+    /*! \tparam Real Precision of the evaluation, Scalar or float in mixed precision
+        \param batch Packed pairs, see detail::PairEvaluatorBatch
+
+        Table potentials do not support energy shifting. The table lookups are gathers, so this
+        batch mainly saves the per pair call overhead.
+     */
+    template<class Real>
+    static void evalForceAndEnergyBatch(detail::PairEvaluatorBatch<param_type, Real>& batch)
+        {
+        constexpr unsigned int width = detail::PairEvaluatorBatch<param_type, Real>::width;
+
+        for (unsigned int lane = 0; lane < width; lane++)
+            {
+            const param_type& params = batch.params[batch.param_idx[lane]];
+            const unsigned int table_width = params.V_table.size();
+
+            const Real r = fast::sqrt(batch.rsq[lane]);
+            const bool evaluated
+                = batch.rsq[lane] < batch.rcutsq[lane] && r >= params.rmin && table_width > 0;
+            const Real rcut = fast::sqrt(batch.rcutsq[lane]);
+            const Real delta_r = (rcut - params.rmin) / static_cast<Real>(table_width);
+
+            // the masked lanes read no table entries
+            const Real value_f = evaluated ? (r - params.rmin) / delta_r : Real(0.0);
+            const unsigned int value_i = static_cast<unsigned int>(slow::floor(value_f));
+            const bool interpolate = evaluated && value_i + 1 < table_width;
+            const Real V0 = evaluated ? params.V_table[value_i] : Real(0.0);
+            const Real F0 = evaluated ? params.F_table[value_i] : Real(0.0);
+            const Real V1 = interpolate ? params.V_table[value_i + 1] : Real(0.0);
+            const Real F1 = interpolate ? params.F_table[value_i + 1] : Real(0.0);
+
+            const Real f = value_f - Real(value_i);
+            const Real V = V0 + f * (V1 - V0);
+            const Real F = F0 + f * (F1 - F0);
+
+            batch.force_divr[lane] = evaluated && r > Real(0.0) ? F / r : Real(0.0);
+            batch.pair_eng[lane] = V;
+            }
+        }
+#endif
+
     DEVICE Scalar evalPressureLRCIntegral()
         {
         return 0;
@@ -0,0 +1,323 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/ManagedArray.h"
+#include <memory>
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+#ifdef __HIPCC__
+#define DEVICE __device__
+#define HOSTDEVICE __host__ __device__
+#else
+#define DEVICE
+#define HOSTDEVICE
+#endif
+
+#ifndef __HIPCC__
+#include "PairEvaluatorBatch.h"
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#endif
+
+#ifndef __TABLESPLINEPOTENTIAL_H__
+#define __TABLESPLINEPOTENTIAL_H__
+
+/*! \file EvaluatorPairTableSpline.h
+    \brief Defines the pair evaluator class for tabulated potentials on non-uniform grids
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Computes the result of a tabulated pair potential on a non-uniform grid
+/*! The potential and force values are provided at N knots r_0 < r_1 < ... < r_{N-1} that may be
+    spaced arbitrarily, so that the table can place more knots where the potential varies quickly
+    (e.g. near the core) and few knots in the tail.
+
+    Between two knots, the evaluator interpolates V(r) with the cubic Hermite polynomial that
+    matches V and dV/dr = -F at both knots. The force is the derivative of the interpolated
+    energy, so energy and force are consistent and continuous at the knots. The constructor
+    converts the knots into the coefficients of the polynomial of each interval in
+    t = r - r_k:
+
+    \f[ V(r) = c_0 + c_1 t + c_2 t^2 + c_3 t^3 \f]
+
+    V(r) and F(r) for r < r_0, r >= r_{N-1}, or r >= rcut is 0.
+
+    The interval search is a branchless binary search that takes the same number of iterations for
+    every r, so threads of a warp and lanes of a CPU batch that evaluate the same type pair do not
+    diverge.
+*/
+class EvaluatorPairTableSpline
+    {
+    public:
+    //! Define the parameter type used by this pair potential evaluator
+    struct param_type
+        {
+        ManagedArray<Scalar> knots;  //!< the N knots in increasing order
+        ManagedArray<Scalar4> coeff; //!< c0, c1, c2, c3 of the N - 1 intervals
+        Scalar V_last;               //!< the energy at the last knot
+        Scalar F_last;               //!< the force at the last knot
+
+        //! Load dynamic data members into shared memory and increase pointer
+        /*! \param ptr Pointer to load data to (will be incremented)
+            \param available_bytes Size of remaining shared memory allocation
+         */
+        DEVICE void load_shared(char*& ptr, unsigned int& available_bytes)
+            {
+            coeff.load_shared(ptr, available_bytes);
+            knots.load_shared(ptr, available_bytes);
+            }
+
+        HOSTDEVICE void allocate_shared(char*& ptr, unsigned int& available_bytes) const
+            {
+            coeff.allocate_shared(ptr, available_bytes);
+            knots.allocate_shared(ptr, available_bytes);
+            }
+
+#ifdef ENABLE_HIP
+        //! Attach managed memory to CUDA stream
+        void set_memory_hint() const
+            {
+            knots.set_memory_hint();
+            coeff.set_memory_hint();
+            }
+#endif
+
+#ifndef __HIPCC__
+        param_type() : V_last(0.0), F_last(0.0) { }
+
+        param_type(pybind11::dict v, bool managed = false)
+            {
+            const auto r_py = v["r"].cast<pybind11::array_t<Scalar>>().unchecked<1>();
+            const auto V_py = v["U"].cast<pybind11::array_t<Scalar>>().unchecked<1>();
+            const auto F_py = v["F"].cast<pybind11::array_t<Scalar>>().unchecked<1>();
+
+            if (V_py.size() != r_py.size() || F_py.size() != r_py.size())
+                {
+                throw std::runtime_error("The length of r, U, and F arrays must be equal.");
+                }
+
+            if (r_py.size() < 2)
+                {
+                throw std::runtime_error("The table must have at least 2 knots.");
+                }
+
+            const unsigned int n_knots = static_cast<unsigned int>(r_py.size());
+            knots = ManagedArray<Scalar>(n_knots, managed);
+            coeff = ManagedArray<Scalar4>(n_knots - 1, managed);
+
+            for (unsigned int k = 0; k < n_knots; k++)
+                {
+                knots[k] = r_py(k);
+                if (k > 0 && !(r_py(k) > r_py(k - 1)))
+                    {
+                    throw std::runtime_error("The knots r must be strictly increasing.");
+                    }
+                }
+
+            for (unsigned int k = 0; k < n_knots - 1; k++)
+                {
+                const Scalar h = r_py(k + 1) - r_py(k);
+                const Scalar slope = (V_py(k + 1) - V_py(k)) / h;
+                const Scalar m0 = -F_py(k);
+                const Scalar m1 = -F_py(k + 1);
+                coeff[k] = make_scalar4(V_py(k),
+                                        m0,
+                                        (Scalar(3.0) * slope - Scalar(2.0) * m0 - m1) / h,
+                                        (m0 + m1 - Scalar(2.0) * slope) / (h * h));
+                }
+
+            V_last = V_py(n_knots - 1);
+            F_last = F_py(n_knots - 1);
+            }
+
+        pybind11::dict asDict() const
+            {
+            const unsigned int n_knots = knots.size();
+            auto r = pybind11::array_t<Scalar>(n_knots, knots.get());
+            auto V = pybind11::array_t<Scalar>(n_knots);
+            auto F = pybind11::array_t<Scalar>(n_knots);
+            auto V_data = V.mutable_unchecked<1>();
+            auto F_data = F.mutable_unchecked<1>();
+
+            // c0 and c1 are the energy and minus the force at the first knot of each interval
+            for (unsigned int k = 0; k + 1 < n_knots; k++)
+                {
+                V_data(k) = coeff[k].x;
+                F_data(k) = -coeff[k].y;
+                }
+            V_data(n_knots - 1) = V_last;
+            F_data(n_knots - 1) = F_last;
+
+            auto params = pybind11::dict();
+            params["r"] = r;
+            params["U"] = V;
+            params["F"] = F;
+            return params;
+            }
+#endif
+        }
+#if HOOMD_LONGREAL_SIZE == 32
+        __attribute__((aligned(8)));
+#else
+        __attribute__((aligned(16)));
+#endif
+
+    //! Constructs the pair potential evaluator
+    /*! \param _rsq Squared distance between the particles
+        \param _rcutsq Squared distance at which the potential goes to 0
+        \param _params Per type pair parameters of this potential
+    */
+    DEVICE EvaluatorPairTableSpline(Scalar _rsq, Scalar _rcutsq, const param_type& _params)
+        : rsq(_rsq), rcutsq(_rcutsq), knots(_params.knots), coeff(_params.coeff)
+        {
+        }
+
+    //! Table doesn't use charge
+    DEVICE static bool needsCharge()
+        {
+        return false;
+        }
+
+    //! Accept the optional charge values.
+    /*! \param qi Charge of particle i
+        \param qj Charge of particle j
+    */
+    DEVICE void setCharge(Scalar qi, Scalar qj) { }
+
+    //! Find the interval of the table that contains r
+    /*! \param knots The knots of the table
+        \param r Distance, knots[0] <= r < knots[N-1]
+        \returns k such that knots[k] <= r < knots[k+1]
+
+        The number of iterations depends only on the number of knots.
+    */
+    template<class Real>
+    HOSTDEVICE static unsigned int findInterval(const ManagedArray<Scalar>& knots, Real r)
+        {
+        unsigned int base = 0;
+        unsigned int n = knots.size() - 1;
+        while (n > 1)
+            {
+            const unsigned int half = n / 2;
+            base = (r >= Real(knots[base + half])) ? base + half : base;
+            n -= half;
+            }
+        return base;
+        }
+
+    //! Evaluate the force and energy
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy.
+        \param energy_shift Table potentials do not support energy shifting.
+
+        \return True if the force and energy are evaluated or false if r is outside the valid
+        range.
+    */
+    DEVICE bool
+    evalForceAndEnergy(Scalar& force_divr, Scalar& pair_eng, const bool energy_shift) const
+        {
+        const unsigned int n_knots = knots.size();
+        if (rsq >= rcutsq || n_knots < 2)
+            {
+            return false;
+            }
+
+        const Scalar r = fast::sqrt(rsq);
+        if (r < knots[0] || r >= knots[n_knots - 1])
+            {
+            return false;
+            }
+
+        const unsigned int k = findInterval(knots, r);
+        const Scalar4 c = coeff[k];
+        const Scalar t = r - knots[k];
+
+        pair_eng = c.x + t * (c.y + t * (c.z + t * c.w));
+        const Scalar F = -(c.y + t * (Scalar(2.0) * c.z + Scalar(3.0) * t * c.w));
+
+        // return the force divided by r
+        if (rsq > Scalar(0.0))
+            {
+            force_divr = F / r;
+            }
+        return true;
+        }
+
+#ifndef __HIPCC__
+    //! Evaluate the force and energy of a batch of pairs on the CPU
+    /*! \tparam Real Precision of the evaluation, Scalar or float in mixed precision
+        \param batch Packed pairs, see detail::PairEvaluatorBatch
+
+        Table potentials do not support energy shifting. The interval search and the coefficient
+        loads are gathers, so this batch mainly saves the per pair call overhead.
+     */
+    template<class Real>
+    static void evalForceAndEnergyBatch(detail::PairEvaluatorBatch<param_type, Real>& batch)
+        {
+        constexpr unsigned int width = detail::PairEvaluatorBatch<param_type, Real>::width;
+
+        for (unsigned int lane = 0; lane < width; lane++)
+            {
+            const param_type& params = batch.params[batch.param_idx[lane]];
+            const unsigned int n_knots = params.knots.size();
+
+            const Real r = fast::sqrt(batch.rsq[lane]);
+            const bool evaluated = batch.rsq[lane] < batch.rcutsq[lane] && n_knots >= 2
+                                   && r >= Real(params.knots[0])
+                                   && r < Real(params.knots[n_knots - 1]);
+
+            // the masked lanes read no table entries
+            const unsigned int k = evaluated ? findInterval(params.knots, r) : 0;
+            const Scalar4 c = evaluated ? params.coeff[k] : make_scalar4(0, 0, 0, 0);
+            const Real t = evaluated ? r - Real(params.knots[k]) : Real(0.0);
+            const Real c0 = Real(c.x), c1 = Real(c.y), c2 = Real(c.z), c3 = Real(c.w);
+
+            const Real V = c0 + t * (c1 + t * (c2 + t * c3));
+            const Real F = -(c1 + t * (Real(2.0) * c2 + Real(3.0) * t * c3));
+
+            batch.force_divr[lane] = evaluated && r > Real(0.0) ? F / r : Real(0.0);
+            batch.pair_eng[lane] = V;
+            }
+        }
+#endif
+
+    DEVICE Scalar evalPressureLRCIntegral()
+        {
+        return 0;
+        }
+
+    DEVICE Scalar evalEnergyLRCIntegral()
+        {
+        return 0;
+        }
+
+#ifndef __HIPCC__
+    //! Get the name of this potential
+    /*! \returns The potential name.
+     */
+    static std::string getName()
+        {
+        return std::string("table_spline");
+        }
+
+    std::string getShapeSpec() const
+        {
+        throw std::runtime_error("Shape definition not supported for this pair potential.");
+        }
+#endif
+
+    protected:
+    Scalar rsq;                         //!< distance squared
+    Scalar rcutsq;                      //!< the potential cuttoff distance squared
+    const ManagedArray<Scalar>& knots;  //!< the knots of the table
+    const ManagedArray<Scalar4>& coeff; //!< the polynomial coefficients of the intervals
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
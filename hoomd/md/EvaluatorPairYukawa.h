@@ -10,6 +10,10 @@
 
 #include "hoomd/HOOMDMath.h"
 
+#ifndef __HIPCC__
+#include "PairEvaluatorBatch.h"
+#endif
+
 /*! \file EvaluatorPairYukawa.h
     \brief Defines the pair evaluator class for Yukawa potentials
 */
@@ -151,6 +155,49 @@ class EvaluatorPairYukawa
             return false;
         }
 
+#ifndef __HIPCC__
+    //! Evaluate the force and energy of a batch of pairs on the CPU
+    /*! \tparam Real Precision of the evaluation, Scalar or float in mixed precision
+        \param batch Packed pairs, see detail::PairEvaluatorBatch
+     */
+    template<class Real>
+    static void evalForceAndEnergyBatch(detail::PairEvaluatorBatch<param_type, Real>& batch)
+        {
+        constexpr unsigned int width = detail::PairEvaluatorBatch<param_type, Real>::width;
+
+        // gather the parameters first so that the evaluation loop vectorizes
+        Real epsilon[width];
+        Real kappa[width];
+        for (unsigned int lane = 0; lane < width; lane++)
+            {
+            const param_type& params = batch.params[batch.param_idx[lane]];
+            epsilon[lane] = params.epsilon;
+            kappa[lane] = params.kappa;
+            }
+
+        for (unsigned int lane = 0; lane < width; lane++)
+            {
+            const bool evaluated = batch.rsq[lane] < batch.rcutsq[lane];
+            const bool shift = batch.energy_shift[lane] != Real(0.0);
+
+            // evaluate the masked lanes at r = 1 to avoid divisions by zero, the results of all
+            // masked lanes are discarded below
+            const Real rinv = fast::rsqrt(evaluated ? batch.rsq[lane] : Real(1.0));
+            const Real r = Real(1.0) / rinv;
+            const Real exp_val = fast::exp(-kappa[lane] * r);
+            const Real rcutinv = fast::rsqrt(batch.rcutsq[lane]);
+            const Real rcut = Real(1.0) / rcutinv;
+            const Real exp_cut = fast::exp(-kappa[lane] * rcut);
+            const Real eng_cut = shift ? epsilon[lane] * exp_cut * rcutinv : Real(0.0);
+
+            const Real force_divr = epsilon[lane] * exp_val * rinv * rinv * (rinv + kappa[lane]);
+            const Real pair_eng = epsilon[lane] * exp_val * rinv - eng_cut;
+            batch.force_divr[lane] = evaluated ? force_divr : Real(0.0);
+            batch.pair_eng[lane] = evaluated ? pair_eng : Real(0.0);
+            }
+        }
+#endif
+
     DEVICE Scalar evalPressureLRCIntegral()
         {
         return 0;
@@ -12,6 +12,109 @@ namespace hoomd
     {
 namespace md
     {
+/*! \param box Simulation box
+    \param r_cut Largest cutoff radius of all particle types
+    \param extrapolate True when any particle type extrapolates the potential
+    \param managed True to allocate the masks in managed memory
+
+    The cells evenly divide the fractional coordinates of the box with at least r_cut between
+    opposite cell faces. A wall is masked out of a cell when every point in the bounding sphere of
+    the cell is on the active side at a distance of at least r_cut, or on the inactive side when the
+    potential is not extrapolated. Such walls contribute no force or energy, so the masks do not
+    change the result. The signed distance to a wall changes at most as fast as the position, so the
+    distance at the cell center bounds it within the bounding sphere.
+*/
+void wall_type::updateCells(const BoxDim& box, Scalar r_cut, bool extrapolate, bool managed)
+    {
+    if (!cellsNeedUpdate(box, r_cut, extrapolate))
+        {
+        return;
+        }
+
+    // bound the memory and build time of the masks
+    const unsigned int max_cells_per_dim = 32;
+    const Scalar3 L = box.getNearestPlaneDistance();
+    auto num_cells = [&](Scalar length) -> unsigned int
+    {
+        const Scalar n = r_cut > Scalar(0.0) ? floor(length / r_cut) : Scalar(1.0);
+        return static_cast<unsigned int>(
+            std::max(Scalar(1.0), std::min(n, Scalar(max_cells_per_dim))));
+    };
+    const unsigned int nx = num_cells(L.x);
+    const unsigned int ny = num_cells(L.y);
+    const unsigned int nz = num_cells(L.z);
+
+    const vec3<Scalar> a = vec3<Scalar>(box.getLatticeVector(0)) / Scalar(nx);
+    const vec3<Scalar> b = vec3<Scalar>(box.getLatticeVector(1)) / Scalar(ny);
+    const vec3<Scalar> c = vec3<Scalar>(box.getLatticeVector(2)) / Scalar(nz);
+    Scalar max_diagonal_sq = 0;
+    for (const vec3<Scalar>& diagonal : {a + b + c, a + b - c, a - b + c, -a + b + c})
+        {
+        max_diagonal_sq = std::max(max_diagonal_sq, dot(diagonal, diagonal));
+        }
+    // radius of the bounding sphere, with a margin for round-off and particles on the box faces
+    const Scalar h = Scalar(0.5005) * sqrt(max_diagonal_sq);
+
+    // s is the signed distance from the wall to the cell center, positive on the active side
+    auto may_interact = [&](Scalar s)
+    { return s - h < r_cut && (extrapolate || s + h >= Scalar(0.0)); };
+
+    cell_indexer = Index3D(nx, ny, nz);
+    cell_masks = ManagedArray<wall_mask_type>(cell_indexer.getNumElements(), managed);
+
+    for (unsigned int i = 0; i < nx; i++)
+        for (unsigned int j = 0; j < ny; j++)
+            for (unsigned int k = 0; k < nz; k++)
+                {
+                const Scalar3 f = make_scalar3((Scalar(i) + Scalar(0.5)) / Scalar(nx),
+                                               (Scalar(j) + Scalar(0.5)) / Scalar(ny),
+                                               (Scalar(k) + Scalar(0.5)) / Scalar(nz));
+                const vec3<Scalar> center(box.makeCoordinates(f));
+                wall_mask_type mask {0, 0, 0};
+
+                // the evaluator treats points on the origin or axis as on the wall, keep them
+                for (unsigned int w = 0; w < numSpheres; w++)
+                    {
+                    const SphereWall& wall = Spheres[w];
+                    const Scalar d = sqrt(dot(center - wall.origin, center - wall.origin));
+                    const Scalar s = wall.inside ? wall.r - d : d - wall.r;
+                    if (d <= h || may_interact(s))
+                        {
+                        mask.spheres |= 1u << w;
+                        }
+                    }
+
+                for (unsigned int w = 0; w < numCylinders; w++)
+                    {
+                    const CylinderWall& wall = Cylinders[w];
+                    vec3<Scalar> dr = rotate(wall.quatAxisToZRot, center - wall.origin);
+                    dr.z = 0;
+                    const Scalar d = sqrt(dot(dr, dr));
+                    const Scalar s = wall.inside ? wall.r - d : d - wall.r;
+                    if (d <= h || may_interact(s))
+                        {
+                        mask.cylinders |= 1u << w;
+                        }
+                    }
+
+                for (unsigned int w = 0; w < numPlanes; w++)
+                    {
+                    const PlaneWall& wall = Planes[w];
+                    if (may_interact(dot(wall.normal, center - wall.origin)))
+                        {
+                        mask.planes |= 1ull << w;
+                        }
+                    }
+
+                cell_masks[cell_indexer(i, j, k)] = mask;
+                }
+
+    cell_box = box;
+    cell_r_cut = r_cut;
+    cell_extrapolate = extrapolate;
+    cells_valid = true;
+    }
+
 namespace detail
     {
 
@@ -38,6 +141,7 @@ void export_wall_field(pybind11::module& m)
                                            [&wall_list](const ArrayView<SphereWall>* view) -> void {
                                                wall_list.numSpheres
                                                    = static_cast<unsigned int>(view->size);
+                                               wall_list.invalidateCells();
                                            }));
              })
         .def("get_cylinder_list",
@@ -49,7 +153,10 @@ void export_wall_field(pybind11::module& m)
                      wall_list.numCylinders,
                      std::function<void(const ArrayView<CylinderWall>*)>(
                          [&wall_list](const ArrayView<CylinderWall>* view) -> void
-                         { wall_list.numCylinders = static_cast<unsigned int>(view->size); }));
+                         {
+                             wall_list.numCylinders = static_cast<unsigned int>(view->size);
+                             wall_list.invalidateCells();
+                         }));
              })
         .def("get_plane_list",
              [](wall_type& wall_list)
@@ -61,6 +168,7 @@ void export_wall_field(pybind11::module& m)
                                            [&wall_list](const ArrayView<PlaneWall>* view) -> void {
                                                wall_list.numPlanes
                                                    = static_cast<unsigned int>(view->size);
+                                               wall_list.invalidateCells();
                                            }));
              })
         // These functions are not necessary for the Python interface but allow for more ready
@@ -16,6 +16,8 @@
 #include "WallData.h"
 #include "hoomd/BoxDim.h"
 #include "hoomd/HOOMDMath.h"
+#include "hoomd/Index1D.h"
+#include "hoomd/ManagedArray.h"
 #include "hoomd/VectorMath.h"
 
 #undef DEVICE
@@ -36,6 +38,19 @@ namespace hoomd
     {
 namespace md
     {
+//! Bit masks of the walls that may interact with the particles in a cell
+/*! Bit k is set when wall k of the given geometry may interact.
+ */
+struct wall_mask_type
+    {
+    unsigned int spheres;
+    unsigned int cylinders;
+    unsigned long long planes;
+    };
+
+static_assert(MAX_N_SWALLS <= 32 && MAX_N_CWALLS <= 32 && MAX_N_PWALLS <= 64,
+              "The wall masks must have a bit per wall.");
+
 struct HOOMD_PYBIND11_EXPORT wall_type
     {
     unsigned int numSpheres; // these data types come first, since the structs are aligned already
@@ -45,7 +60,73 @@ struct HOOMD_PYBIND11_EXPORT wall_type
     CylinderWall Cylinders[MAX_N_CWALLS];
     PlaneWall Planes[MAX_N_PWALLS];
 
-    wall_type() : numSpheres(0), numCylinders(0), numPlanes(0) { }
+    /// Walls that may interact with the particles in each cell, empty to evaluate all walls
+    ManagedArray<wall_mask_type> cell_masks;
+    /// Indexes the cells, which evenly divide the fractional coordinates of cell_box
+    Index3D cell_indexer;
+    /// Box the cells were built for
+    BoxDim cell_box;
+    /// Largest r_cut the cells were built for
+    Scalar cell_r_cut;
+    /// True when the cells were built for extrapolated potentials
+    bool cell_extrapolate;
+    /// False when the walls changed since the cells were built
+    bool cells_valid;
+
+    wall_type()
+        : numSpheres(0), numCylinders(0), numPlanes(0), cell_r_cut(0), cell_extrapolate(false),
+          cells_valid(false)
+        {
+        }
+
+    //! Get the walls that may interact with a particle
+    /*! \param box Simulation box, must be the box given to updateCells()
+        \param pos Position of the particle
+    */
+    DEVICE wall_mask_type getCellMask(const BoxDim& box, const Scalar3& pos) const
+        {
+        if (cell_masks.size() == 0)
+            {
+            return wall_mask_type {~0u, ~0u, ~0ull};
+            }
+
+        // particles on the upper box faces or rounded outside of the box use the nearest cell
+        const Scalar3 f = box.makeFraction(pos);
+        const unsigned int i = cellCoordinate(f.x, cell_indexer.getW());
+        const unsigned int j = cellCoordinate(f.y, cell_indexer.getH());
+        const unsigned int k = cellCoordinate(f.z, cell_indexer.getD());
+        return cell_masks[cell_indexer(i, j, k)];
+        }
+
+    //! Get the cell coordinate of a fractional coordinate, clamped to [0, n)
+    DEVICE static unsigned int cellCoordinate(Scalar f, unsigned int n)
+        {
+        const Scalar c = f * Scalar(n);
+        if (!(c > Scalar(0.0)))
+            {
+            return 0;
+            }
+        const unsigned int i = static_cast<unsigned int>(c);
+        return i < n ? i : n - 1;
+        }
+
+#ifndef __HIPCC__
+    //! Notify the wall list that the walls changed
+    void invalidateCells()
+        {
+        cells_valid = false;
+        }
+
+    //! Build the cell masks when the walls, the box, or the interaction range changed
+    void updateCells(const BoxDim& box, Scalar r_cut, bool extrapolate, bool managed);
+
+    //! Test whether updateCells() will rebuild the cell masks
+    bool cellsNeedUpdate(const BoxDim& box, Scalar r_cut, bool extrapolate) const
+        {
+        return !cells_valid || !(box == cell_box) || r_cut != cell_r_cut
+               || extrapolate != cell_extrapolate;
+        }
+#endif
 
     // The following methods are to test the ArrayView<> templated class.
 
@@ -139,7 +220,7 @@ template<class evaluator> class EvaluatorWalls
                           const BoxDim& box,
                           const param_type& p,
                           const field_type& f)
-        : m_pos(pos), m_field(f), m_params(p)
+        : m_pos(pos), m_field(f), m_mask(f.getCellMask(box, pos)), m_params(p)
         {
         }
 
@@ -264,6 +345,8 @@ template<class evaluator> class EvaluatorWalls
             Scalar rsq;
             for (unsigned int k = 0; k < m_field.numSpheres; k++)
                 {
+                if (!(m_mask.spheres & (1u << k)))
+                    continue;
                 drv = distVectorWallToPoint(m_field.Spheres[k], position, in_active_space);
                 rsq = dot(drv, drv);
                 if (in_active_space && rsq >= rextrapsq)
@@ -293,6 +376,8 @@ template<class evaluator> class EvaluatorWalls
             vec3<Scalar> intermediate_distance_vector;
             for (unsigned int k = 0; k < m_field.numCylinders; k++)
                 {
+                if (!(m_mask.cylinders & (1u << k)))
+                    continue;
                 drv = distVectorWallToPoint(m_field.Cylinders[k], position, in_active_space);
                 rsq = dot(drv, drv);
                 if (in_active_space && rsq >= rextrapsq)
@@ -318,6 +403,8 @@ template<class evaluator> class EvaluatorWalls
                 }
             for (unsigned int k = 0; k < m_field.numPlanes; k++)
                 {
+                if (!(m_mask.planes & (1ull << k)))
+                    continue;
                 drv = distVectorWallToPoint(m_field.Planes[k], position, in_active_space);
                 rsq = dot(drv, drv);
                 if (in_active_space && rsq >= rextrapsq)
@@ -346,6 +433,8 @@ template<class evaluator> class EvaluatorWalls
             {
             for (unsigned int k = 0; k < m_field.numSpheres; k++)
                 {
+                if (!(m_mask.spheres & (1u << k)))
+                    continue;
                 drv = distVectorWallToPoint(m_field.Spheres[k], position, in_active_space);
                 if (in_active_space)
                     {
@@ -354,6 +443,8 @@ template<class evaluator> class EvaluatorWalls
                 }
             for (unsigned int k = 0; k < m_field.numCylinders; k++)
                 {
+                if (!(m_mask.cylinders & (1u << k)))
+                    continue;
                 drv = distVectorWallToPoint(m_field.Cylinders[k], position, in_active_space);
                 if (in_active_space)
                     {
@@ -362,6 +453,8 @@ template<class evaluator> class EvaluatorWalls
                 }
             for (unsigned int k = 0; k < m_field.numPlanes; k++)
                 {
+                if (!(m_mask.planes & (1ull << k)))
+                    continue;
                 drv = distVectorWallToPoint(m_field.Planes[k], position, in_active_space);
                 if (in_active_space)
                     {
@@ -392,6 +485,7 @@ template<class evaluator> class EvaluatorWalls
     protected:
     Scalar3 m_pos;             //!< particle position
     const field_type& m_field; //!< contains all information about the walls.
+    wall_mask_type m_mask;     //!< walls that may interact with the particle
     param_type m_params;
     Scalar qi;
     };
@@ -340,7 +340,7 @@ void FIREEnergyMinimizer::update(uint64_t timestep)
 
     if ((fnorm / sqrt(Scalar(ndof)) < m_ftol && wnorm / sqrt(Scalar(ndof)) < m_wtol
          && fabs(energy - m_old_energy) < m_etol)
-        && m_n_since_start >= m_run_minsteps)
+        && m_n_since_start >= m_run_minsteps && isCheckIteration())
         {
         m_exec_conf->msg->notice(4) << "FIRE converged in timestep " << timestep << std::endl;
         m_converged = true;
@@ -496,7 +496,10 @@ void export_FIREEnergyMinimizer(pybind11::module& m)
         .def_property("energy_tol", &FIREEnergyMinimizer::getEtol, &FIREEnergyMinimizer::setEtol)
         .def_property("min_steps_conv",
                       &FIREEnergyMinimizer::getMinSteps,
-                      &FIREEnergyMinimizer::setMinSteps);
+                      &FIREEnergyMinimizer::setMinSteps)
+        .def_property("check_interval",
+                      &FIREEnergyMinimizer::getCheckInterval,
+                      &FIREEnergyMinimizer::setCheckInterval);
     }
 
     } // end namespace detail
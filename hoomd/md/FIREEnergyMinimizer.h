@@ -4,6 +4,7 @@
 #include "IntegratorTwoStep.h"
 
 #include <memory>
+#include <stdexcept>
 
 #ifndef __FIRE_ENERGY_MINIMIZER_H__
 #define __FIRE_ENERGY_MINIMIZER_H__
@@ -47,7 +48,7 @@ class PYBIND11_EXPORT FIREEnergyMinimizer : public IntegratorTwoStep
         }
 
     //! Return the potential energy after the last iteration
-    Scalar getEnergy() const
+    virtual Scalar getEnergy() const
         {
         if (m_was_reset)
             {
@@ -167,7 +168,31 @@ class PYBIND11_EXPORT FIREEnergyMinimizer : public IntegratorTwoStep
         return m_run_minsteps;
         }
 
+    //! Set the number of iterations between convergence checks
+    /*! \param check_interval is the new number of iterations between checks
+     */
+    void setCheckInterval(unsigned int check_interval)
+        {
+        if (check_interval == 0)
+            {
+            throw std::domain_error("check_interval must be positive.");
+            }
+        m_check_interval = check_interval;
+        }
+
+    //! Get the number of iterations between convergence checks
+    unsigned int getCheckInterval()
+        {
+        return m_check_interval;
+        }
+
     protected:
+    //! Return whether the convergence criteria are evaluated in the current iteration
+    bool isCheckIteration() const
+        {
+        return (m_n_since_start + 1) % m_check_interval == 0;
+        }
+
     //! Function to create the underlying integrator
     unsigned int m_nmin; //!< minimum number of consecutive successful search directions before
                          //!< modifying alpha
@@ -190,6 +215,8 @@ class PYBIND11_EXPORT FIREEnergyMinimizer : public IntegratorTwoStep
     unsigned int m_run_minsteps;  //!< A minimum number of search attempts the search will use
     bool m_was_reset;             //!< whether or not the minimizer was reset
 
+    unsigned int m_check_interval = 1; //!< number of iterations between convergence checks
+
     private:
     };
 
@@ -2,7 +2,6 @@
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
 #include "FIREEnergyMinimizerGPU.h"
-#include "FIREEnergyMinimizerGPU.cuh"
 
 using namespace std;
 
@@ -30,8 +29,11 @@ FIREEnergyMinimizerGPU::FIREEnergyMinimizerGPU(std::shared_ptr<SystemDefinition>
     // allocate the sum arrays
     GPUArray<Scalar> sum(1, m_exec_conf);
     m_sum.swap(sum);
-    GPUArray<Scalar> sum3(3, m_exec_conf);
-    m_sum3.swap(sum3);
+    GPUArray<Scalar> sum_all(6, m_exec_conf);
+    m_sum_all.swap(sum_all);
+
+    GPUArray<kernel::fire_state> state(1, m_exec_conf);
+    m_state.swap(state);
 
     // initialize the partial sum arrays
     m_partial_sum1 = GPUVector<Scalar>(m_exec_conf);
@@ -41,6 +43,31 @@ FIREEnergyMinimizerGPU::FIREEnergyMinimizerGPU(std::shared_ptr<SystemDefinition>
     reset();
     }
 
+void FIREEnergyMinimizerGPU::reset()
+    {
+    FIREEnergyMinimizer::reset();
+    m_state_dirty = true;
+    }
+
+/*! \param deltaT new step size
+
+    The FIRE rules evaluated on the device continue from the new step size.
+*/
+void FIREEnergyMinimizerGPU::setDeltaT(Scalar deltaT)
+    {
+    FIREEnergyMinimizer::setDeltaT(deltaT);
+    m_deltaT_dirty = true;
+    }
+
+Scalar FIREEnergyMinimizerGPU::getEnergy() const
+    {
+    if (m_was_reset)
+        return FIREEnergyMinimizer::getEnergy();
+
+    ArrayHandle<kernel::fire_state> h_state(m_state, access_location::host, access_mode::read);
+    return h_state.data->energy_total;
+    }
+
 /*
  * Update the size of the memory buffers to store the partial sums, if needed.
  */
@@ -64,6 +91,14 @@ void FIREEnergyMinimizerGPU::resizePartialSumArrays()
         m_partial_sum2.resize(num_blocks);
         m_partial_sum3.resize(num_blocks);
         }
+
+    // one slot per method in the sum arrays
+    size_t n_methods = std::max(m_methods.size(), size_t(1));
+    if (n_methods != m_sum.getNumElements())
+        {
+        m_sum.resize(n_methods);
+        m_sum_all.resize(6 * n_methods);
+        }
     }
 
 /*! \param timesteps is the iteration number
@@ -76,27 +111,41 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
 
     IntegratorTwoStep::update(timestep);
 
-    Scalar Pt(0.0); // translational power
-    Scalar Pr(0.0); // rotational power
-    Scalar vnorm(0.0);
-    Scalar fnorm(0.0);
-    Scalar energy(0.0);
-    Scalar tnorm(0.0);
-    Scalar wnorm(0.0);
-
     // update partial sum memory space if needed
     resizePartialSumArrays();
 
-    // compute the total energy on the GPU
-    // CPU version is Scalar energy = computePotentialEnergy(timesteps)/Scalar(group_size);
+    // pass values set on the host to the device
+    if (m_state_dirty || m_deltaT_dirty)
+        {
+        ArrayHandle<kernel::fire_state> h_state(m_state,
+                                                access_location::host,
+                                                access_mode::readwrite);
+        if (m_state_dirty)
+            {
+            h_state.data->alpha = m_alpha;
+            h_state.data->n_since_negative = m_n_since_negative;
+            }
+        h_state.data->deltaT = m_deltaT;
+        m_state_dirty = false;
+        m_deltaT_dirty = false;
+        }
+
     unsigned int total_group_size = 0;
 
-    for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
         {
-        std::shared_ptr<ParticleGroup> current_group = (*method)->getGroup();
+        ArrayHandle<Scalar> d_sum_all(m_sum_all, access_location::device, access_mode::overwrite);
+        // methods without rotational degrees of freedom leave their rotational sums at zero
+        hipMemset(d_sum_all.data, 0, sizeof(Scalar) * m_sum_all.getNumElements());
+        }
+
+    // sum E, P, vsq, asq (and Pr, wsq, tsq) of each method into its own slot
+    for (unsigned int i = 0; i < m_methods.size(); i++)
+        {
+        std::shared_ptr<ParticleGroup> current_group = m_methods[i]->getGroup();
 
         unsigned int group_size = current_group->getNumMembers();
         total_group_size += group_size;
+        unsigned int num_blocks = group_size / m_block_size + 1;
 
         ArrayHandle<unsigned int> d_index_array(current_group->getIndexArray(),
                                                 access_location::device,
@@ -109,13 +158,12 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
             ArrayHandle<Scalar> d_partial_sumE(m_partial_sum1,
                                                access_location::device,
                                                access_mode::overwrite);
-            ArrayHandle<Scalar> d_sumE(m_sum, access_location::device, access_mode::overwrite);
+            ArrayHandle<Scalar> d_sumE(m_sum, access_location::device, access_mode::readwrite);
 
-            unsigned int num_blocks = group_size / m_block_size + 1;
             kernel::gpu_fire_compute_sum_pe(d_index_array.data,
                                             group_size,
                                             d_net_force.data,
-                                            d_sumE.data,
+                                            d_sumE.data + i,
                                             d_partial_sumE.data,
                                             m_block_size,
                                             num_blocks);
@@ -124,52 +172,6 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
                 CHECK_CUDA_ERROR();
             }
 
-        ArrayHandle<Scalar> h_sumE(m_sum, access_location::host, access_mode::read);
-        energy += h_sumE.data[0];
-        }
-
-#ifdef ENABLE_MPI
-    if (m_pdata->getDomainDecomposition())
-        {
-        MPI_Allreduce(MPI_IN_PLACE,
-                      &energy,
-                      1,
-                      MPI_HOOMD_SCALAR,
-                      MPI_SUM,
-                      m_exec_conf->getMPICommunicator());
-        MPI_Allreduce(MPI_IN_PLACE,
-                      &total_group_size,
-                      1,
-                      MPI_INT,
-                      MPI_SUM,
-                      m_exec_conf->getMPICommunicator());
-        }
-#endif
-
-    m_energy_total = energy;
-    energy /= (Scalar)total_group_size;
-
-    if (m_was_reset)
-        {
-        m_was_reset = false;
-        m_old_energy = energy + Scalar(100000) * m_etol;
-        }
-
-    // sum P, vnorm, fnorm
-
-#ifdef ENABLE_MPI
-    bool aniso = false;
-#endif
-
-    for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
-        {
-        std::shared_ptr<ParticleGroup> current_group = (*method)->getGroup();
-
-        unsigned int group_size = current_group->getNumMembers();
-        ArrayHandle<unsigned int> d_index_array(current_group->getIndexArray(),
-                                                access_location::device,
-                                                access_mode::read);
-
             {
             ArrayHandle<Scalar> d_partial_sum_P(m_partial_sum1,
                                                 access_location::device,
@@ -180,7 +182,7 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
             ArrayHandle<Scalar> d_partial_sum_fsq(m_partial_sum3,
                                                   access_location::device,
                                                   access_mode::overwrite);
-            ArrayHandle<Scalar> d_sum(m_sum3, access_location::device, access_mode::overwrite);
+            ArrayHandle<Scalar> d_sum(m_sum_all, access_location::device, access_mode::readwrite);
             ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
                                        access_location::device,
                                        access_mode::read);
@@ -188,14 +190,12 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
                                          access_location::device,
                                          access_mode::read);
 
-            unsigned int num_blocks = group_size / m_block_size + 1;
-
             kernel::gpu_fire_compute_sum_all(m_pdata->getN(),
                                              d_vel.data,
                                              d_accel.data,
                                              d_index_array.data,
                                              group_size,
-                                             d_sum.data,
+                                             d_sum.data + 6 * i,
                                              d_partial_sum_P.data,
                                              d_partial_sum_vsq.data,
                                              d_partial_sum_fsq.data,
@@ -206,148 +206,162 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
                 CHECK_CUDA_ERROR();
             }
 
-        ArrayHandle<Scalar> h_sum(m_sum3, access_location::host, access_mode::read);
-        Pt += h_sum.data[0];
-        vnorm += h_sum.data[1];
-        fnorm += h_sum.data[2];
-
-        if ((*method)->getAnisotropic())
+        if (m_methods[i]->getAnisotropic())
             {
-#ifdef ENABLE_MPI
-            aniso = true;
-#endif
-
-                {
-                ArrayHandle<Scalar> d_partial_sum_Pr(m_partial_sum1,
-                                                     access_location::device,
-                                                     access_mode::overwrite);
-                ArrayHandle<Scalar> d_partial_sum_wnorm(m_partial_sum2,
-                                                        access_location::device,
-                                                        access_mode::overwrite);
-                ArrayHandle<Scalar> d_partial_sum_tsq(m_partial_sum3,
-                                                      access_location::device,
-                                                      access_mode::overwrite);
-                ArrayHandle<Scalar> d_sum(m_sum3, access_location::device, access_mode::overwrite);
-                ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
-                                                   access_location::device,
-                                                   access_mode::read);
-                ArrayHandle<Scalar4> d_angmom(m_pdata->getAngularMomentumArray(),
-                                              access_location::device,
-                                              access_mode::read);
-                ArrayHandle<Scalar4> d_net_torque(m_pdata->getNetTorqueArray(),
+            ArrayHandle<Scalar> d_partial_sum_Pr(m_partial_sum1,
+                                                 access_location::device,
+                                                 access_mode::overwrite);
+            ArrayHandle<Scalar> d_partial_sum_wnorm(m_partial_sum2,
+                                                    access_location::device,
+                                                    access_mode::overwrite);
+            ArrayHandle<Scalar> d_partial_sum_tsq(m_partial_sum3,
                                                   access_location::device,
-                                                  access_mode::read);
-                ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                                  access_mode::overwrite);
+            ArrayHandle<Scalar> d_sum(m_sum_all, access_location::device, access_mode::readwrite);
+            ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
                                                access_location::device,
                                                access_mode::read);
+            ArrayHandle<Scalar4> d_angmom(m_pdata->getAngularMomentumArray(),
+                                          access_location::device,
+                                          access_mode::read);
+            ArrayHandle<Scalar4> d_net_torque(m_pdata->getNetTorqueArray(),
+                                              access_location::device,
+                                              access_mode::read);
+            ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                           access_location::device,
+                                           access_mode::read);
+
+            kernel::gpu_fire_compute_sum_all_angular(m_pdata->getN(),
+                                                     d_orientation.data,
+                                                     d_inertia.data,
+                                                     d_angmom.data,
+                                                     d_net_torque.data,
+                                                     d_index_array.data,
+                                                     group_size,
+                                                     d_sum.data + 6 * i + 3,
+                                                     d_partial_sum_Pr.data,
+                                                     d_partial_sum_wnorm.data,
+                                                     d_partial_sum_tsq.data,
+                                                     m_block_size,
+                                                     num_blocks);
 
-                unsigned int num_blocks = group_size / m_block_size + 1;
-
-                kernel::gpu_fire_compute_sum_all_angular(m_pdata->getN(),
-                                                         d_orientation.data,
-                                                         d_inertia.data,
-                                                         d_angmom.data,
-                                                         d_net_torque.data,
-                                                         d_index_array.data,
-                                                         group_size,
-                                                         d_sum.data,
-                                                         d_partial_sum_Pr.data,
-                                                         d_partial_sum_wnorm.data,
-                                                         d_partial_sum_tsq.data,
-                                                         m_block_size,
-                                                         num_blocks);
-
-                if (m_exec_conf->isCUDAErrorCheckingEnabled())
-                    CHECK_CUDA_ERROR();
-                }
-            ArrayHandle<Scalar> h_sum(m_sum3, access_location::host, access_mode::read);
-            Pr += h_sum.data[0];
-            wnorm += h_sum.data[1];
-            tnorm += h_sum.data[2];
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
             }
         }
 
+        {
+        ArrayHandle<kernel::fire_state> d_state(m_state,
+                                                access_location::device,
+                                                access_mode::readwrite);
+        ArrayHandle<Scalar> d_sumE(m_sum, access_location::device, access_mode::read);
+        ArrayHandle<Scalar> d_sum_all(m_sum_all, access_location::device, access_mode::read);
+
+        kernel::gpu_fire_reduce_state(d_state.data,
+                                      d_sumE.data,
+                                      d_sum_all.data,
+                                      (unsigned int)m_methods.size());
+
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
 #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
+        ArrayHandle<kernel::fire_state> h_state(m_state,
+                                                access_location::host,
+                                                access_mode::readwrite);
+        Scalar sums[7] = {h_state.data->energy_total,
+                          h_state.data->Pt,
+                          h_state.data->vsq,
+                          h_state.data->fsq,
+                          h_state.data->Pr,
+                          h_state.data->wsq,
+                          h_state.data->tsq};
         MPI_Allreduce(MPI_IN_PLACE,
-                      &fnorm,
-                      1,
-                      MPI_HOOMD_SCALAR,
-                      MPI_SUM,
-                      m_exec_conf->getMPICommunicator());
-        MPI_Allreduce(MPI_IN_PLACE,
-                      &vnorm,
-                      1,
+                      sums,
+                      7,
                       MPI_HOOMD_SCALAR,
                       MPI_SUM,
                       m_exec_conf->getMPICommunicator());
+        h_state.data->energy_total = sums[0];
+        h_state.data->Pt = sums[1];
+        h_state.data->vsq = sums[2];
+        h_state.data->fsq = sums[3];
+        h_state.data->Pr = sums[4];
+        h_state.data->wsq = sums[5];
+        h_state.data->tsq = sums[6];
+
         MPI_Allreduce(MPI_IN_PLACE,
-                      &Pt,
+                      &total_group_size,
                       1,
-                      MPI_HOOMD_SCALAR,
+                      MPI_INT,
                       MPI_SUM,
                       m_exec_conf->getMPICommunicator());
-
-        if (aniso)
-            {
-            MPI_Allreduce(MPI_IN_PLACE,
-                          &tnorm,
-                          1,
-                          MPI_HOOMD_SCALAR,
-                          MPI_SUM,
-                          m_exec_conf->getMPICommunicator());
-            MPI_Allreduce(MPI_IN_PLACE,
-                          &wnorm,
-                          1,
-                          MPI_HOOMD_SCALAR,
-                          MPI_SUM,
-                          m_exec_conf->getMPICommunicator());
-            MPI_Allreduce(MPI_IN_PLACE,
-                          &Pr,
-                          1,
-                          MPI_HOOMD_SCALAR,
-                          MPI_SUM,
-                          m_exec_conf->getMPICommunicator());
-            }
         }
 #endif
 
-    vnorm = sqrt(vnorm);
-    fnorm = sqrt(fnorm);
-    wnorm = sqrt(wnorm);
-    tnorm = sqrt(tnorm);
+        {
+        ArrayHandle<kernel::fire_state> d_state(m_state,
+                                                access_location::device,
+                                                access_mode::readwrite);
 
-    unsigned int ndof = m_sysdef->getNDimensions() * total_group_size;
-    m_exec_conf->msg->notice(10) << "FIRE fnorm " << fnorm << " tnorm " << tnorm << " delta_E "
-                                 << energy - m_old_energy << std::endl;
-    m_exec_conf->msg->notice(10) << "FIRE vnorm " << vnorm << " tnorm " << wnorm << std::endl;
-    m_exec_conf->msg->notice(10) << "FIRE Pt " << Pt << " Pr " << Pr << std::endl;
+        kernel::fire_params params;
+        params.nmin = m_nmin;
+        params.finc = m_finc;
+        params.fdec = m_fdec;
+        params.alpha_start = m_alpha_start;
+        params.falpha = m_falpha;
+        params.deltaT_max = m_deltaT_max;
+        params.etol = m_etol;
 
-    if ((fnorm / sqrt(Scalar(ndof)) < m_ftol && wnorm / sqrt(Scalar(ndof)) < m_wtol
-         && fabs(energy - m_old_energy) < m_etol)
-        && m_n_since_start >= m_run_minsteps)
-        {
-        m_converged = true;
-        m_exec_conf->msg->notice(4) << "FIRE converged in timestep " << timestep << std::endl;
-        return;
+        kernel::gpu_fire_update_state(d_state.data, total_group_size, m_was_reset, params);
+
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
         }
+    m_was_reset = false;
 
-    // update velocities
+    // read the state back only in the iterations that check for convergence
+    if (isCheckIteration())
+        {
+        ArrayHandle<kernel::fire_state> h_state(m_state, access_location::host, access_mode::read);
+        const kernel::fire_state& state = *h_state.data;
+
+        Scalar vnorm = sqrt(state.vsq);
+        Scalar fnorm = sqrt(state.fsq);
+        Scalar wnorm = sqrt(state.wsq);
+        Scalar tnorm = sqrt(state.tsq);
+
+        m_energy_total = state.energy_total;
 
-    Scalar factor_t;
-    if (fabs(fnorm) > 0)
-        factor_t = m_alpha * vnorm / fnorm;
-    else
-        factor_t = 1.0;
+        unsigned int ndof = m_sysdef->getNDimensions() * total_group_size;
+        m_exec_conf->msg->notice(10) << "FIRE fnorm " << fnorm << " tnorm " << tnorm
+                                     << " delta_E " << state.energy - state.old_energy << std::endl;
+        m_exec_conf->msg->notice(10) << "FIRE vnorm " << vnorm << " tnorm " << wnorm << std::endl;
+        m_exec_conf->msg->notice(10) << "FIRE Pt " << state.Pt << " Pr " << state.Pr << std::endl;
 
-    Scalar factor_r = 0.0;
+        if ((fnorm / sqrt(Scalar(ndof)) < m_ftol && wnorm / sqrt(Scalar(ndof)) < m_wtol
+             && fabs(state.energy - state.old_energy) < m_etol)
+            && m_n_since_start >= m_run_minsteps)
+            {
+            m_converged = true;
+            m_exec_conf->msg->notice(4) << "FIRE converged in timestep " << timestep << std::endl;
+            return;
+            }
 
-    if (fabs(tnorm) > 0)
-        factor_r = m_alpha * wnorm / tnorm;
-    else
-        factor_r = 1.0;
+        if (state.zero_velocity)
+            m_exec_conf->msg->notice(6) << "FIRE zero velocities" << std::endl;
 
+        // apply the step size chosen on the device to the next iteration
+        IntegratorTwoStep::setDeltaT(state.deltaT);
+        m_alpha = state.alpha;
+        m_n_since_negative = state.n_since_negative;
+        m_old_energy = state.energy;
+        }
+
+    // update velocities
     for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
         {
         std::shared_ptr<ParticleGroup> current_group = (*method)->getGroup();
@@ -356,6 +370,9 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
         ArrayHandle<unsigned int> d_index_array(current_group->getIndexArray(),
                                                 access_location::device,
                                                 access_mode::read);
+        ArrayHandle<kernel::fire_state> d_state(m_state,
+                                                access_location::device,
+                                                access_mode::read);
 
         ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
                                    access_location::device,
@@ -368,8 +385,7 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
                                   d_accel.data,
                                   d_index_array.data,
                                   group_size,
-                                  m_alpha,
-                                  factor_t);
+                                  d_state.data);
 
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
@@ -395,62 +411,14 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
                                            d_angmom.data,
                                            d_index_array.data,
                                            group_size,
-                                           m_alpha,
-                                           factor_r);
-
-            if (m_exec_conf->isCUDAErrorCheckingEnabled())
-                CHECK_CUDA_ERROR();
-            }
-        }
-
-    Scalar P = Pt + Pr;
-
-    if (P > Scalar(0.0))
-        {
-        m_n_since_negative++;
-        if (m_n_since_negative > m_nmin)
-            {
-            IntegratorTwoStep::setDeltaT(std::min(m_deltaT * m_finc, m_deltaT_max));
-            m_alpha *= m_falpha;
-            }
-        }
-    else if (P <= Scalar(0.0))
-        {
-        IntegratorTwoStep::setDeltaT(m_deltaT * m_fdec);
-        m_alpha = m_alpha_start;
-        m_n_since_negative = 0;
-        m_exec_conf->msg->notice(6) << "FIRE zero velocities" << std::endl;
+                                           d_state.data);
 
-        for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
-            {
-            std::shared_ptr<ParticleGroup> current_group = (*method)->getGroup();
-            unsigned int group_size = current_group->getNumMembers();
-            ArrayHandle<unsigned int> d_index_array(current_group->getIndexArray(),
-                                                    access_location::device,
-                                                    access_mode::read);
-
-            ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
-                                       access_location::device,
-                                       access_mode::readwrite);
-
-            kernel::gpu_fire_zero_v(d_vel.data, d_index_array.data, group_size);
             if (m_exec_conf->isCUDAErrorCheckingEnabled())
                 CHECK_CUDA_ERROR();
-
-            if ((*method)->getAnisotropic())
-                {
-                ArrayHandle<Scalar4> d_angmom(m_pdata->getAngularMomentumArray(),
-                                              access_location::device,
-                                              access_mode::readwrite);
-                kernel::gpu_fire_zero_angmom(d_angmom.data, d_index_array.data, group_size);
-                if (m_exec_conf->isCUDAErrorCheckingEnabled())
-                    CHECK_CUDA_ERROR();
-                }
             }
         }
 
     m_n_since_start++;
-    m_old_energy = energy;
     }
 
 namespace detail
@@ -24,95 +24,157 @@ namespace md
     {
 namespace kernel
     {
-//! The kernel function to zeros velocities, called by gpu_fire_zero_v()
-/*! \param d_vel device array of particle velocities
-    \param d_group_members Device array listing the indices of the members of the group to zero
-    \param group_size Number of members in the group
+//! Kernel function that sums the per method sums into the FIRE state
+/*! \param d_state FIRE state to write the sums to
+    \param d_sum_pe Sum of the potential energy of each method
+    \param d_sum_all Sums over P, vsq, asq, Pr, wsq, and tsq of each method (6 per method)
+    \param n_methods Number of integration methods
 */
-__global__ void
-gpu_fire_zero_v_kernel(Scalar4* d_vel, unsigned int* d_group_members, unsigned int group_size)
+__global__ void gpu_fire_reduce_state_kernel(fire_state* d_state,
+                                             const Scalar* d_sum_pe,
+                                             const Scalar* d_sum_all,
+                                             unsigned int n_methods)
     {
-    // determine which particle this thread works on (MEM TRANSFER: 4 bytes)
-    int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
-
-    if (group_idx < group_size)
+    if (blockIdx.x * blockDim.x + threadIdx.x != 0)
+        return;
+
+    fire_state state = *d_state;
+    state.energy_total = Scalar(0.0);
+    state.Pt = Scalar(0.0);
+    state.vsq = Scalar(0.0);
+    state.fsq = Scalar(0.0);
+    state.Pr = Scalar(0.0);
+    state.wsq = Scalar(0.0);
+    state.tsq = Scalar(0.0);
+
+    for (unsigned int i = 0; i < n_methods; i++)
         {
-        unsigned int idx = d_group_members[group_idx];
-
-        // read the particle's velocity (MEM TRANSFER: 32 bytes)
-        Scalar4 vel = d_vel[idx];
-
-        // zero the velocity(FLOPS: ?)
-        vel.x = Scalar(0.0);
-        vel.y = Scalar(0.0);
-        vel.z = Scalar(0.0);
-
-        // write out the results (MEM_TRANSFER: 32 bytes)
-        d_vel[idx] = vel;
+        state.energy_total += d_sum_pe[i];
+        state.Pt += d_sum_all[6 * i];
+        state.vsq += d_sum_all[6 * i + 1];
+        state.fsq += d_sum_all[6 * i + 2];
+        state.Pr += d_sum_all[6 * i + 3];
+        state.wsq += d_sum_all[6 * i + 4];
+        state.tsq += d_sum_all[6 * i + 5];
         }
-    }
-
-//! The kernel function to zero angular momenta, called by gpu_fire_zero_angmom()
-__global__ void gpu_fire_zero_angmom_kernel(Scalar4* d_angmom,
-                                            unsigned int* d_group_members,
-                                            unsigned int group_size)
-    {
-    // determine which particle this thread works on (MEM TRANSFER: 4 bytes)
-    int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
 
-    if (group_idx < group_size)
-        {
-        unsigned int idx = d_group_members[group_idx];
-
-        // write out the results (MEM_TRANSFER: 32 bytes)
-        d_angmom[idx] = make_scalar4(0, 0, 0, 0);
-        }
+    *d_state = state;
     }
 
-/*! \param d_vel device array of particle velocities
-    \param d_group_members Device array listing the indices of the members of the group to integrate
-    \param group_size Number of members in the group
+/*! \param d_state FIRE state to write the sums to
+    \param d_sum_pe Sum of the potential energy of each method
+    \param d_sum_all Sums over P, vsq, asq, Pr, wsq, and tsq of each method (6 per method)
+    \param n_methods Number of integration methods
 
-This function is just the driver for gpu_fire_zero_v_kernel(), see that function
-for details.
+    This is a driver for gpu_fire_reduce_state_kernel(), see it for details.
 */
-hipError_t gpu_fire_zero_v(Scalar4* d_vel, unsigned int* d_group_members, unsigned int group_size)
+hipError_t gpu_fire_reduce_state(fire_state* d_state,
+                                 const Scalar* d_sum_pe,
+                                 const Scalar* d_sum_all,
+                                 unsigned int n_methods)
     {
-    // setup the grid to run the kernel
-    int block_size = 256;
-    dim3 grid((group_size / block_size) + 1, 1, 1);
-    dim3 threads(block_size, 1, 1);
-
-    // run the kernel
-    hipLaunchKernelGGL((gpu_fire_zero_v_kernel),
-                       dim3(grid),
-                       dim3(threads),
+    hipLaunchKernelGGL((gpu_fire_reduce_state_kernel),
+                       dim3(1),
+                       dim3(1),
                        0,
                        0,
-                       d_vel,
-                       d_group_members,
-                       group_size);
+                       d_state,
+                       d_sum_pe,
+                       d_sum_all,
+                       n_methods);
 
     return hipSuccess;
     }
 
-hipError_t
-gpu_fire_zero_angmom(Scalar4* d_angmom, unsigned int* d_group_members, unsigned int group_size)
+//! Kernel function that applies the FIRE rules to the state
+/*! \param d_state FIRE state to update
+    \param total_group_size Number of particles in all integrator groups
+    \param was_reset True in the first iteration after a reset
+    \param params Parameters of the FIRE algorithm
+
+    Computes the mixing factors for this iteration from the current coupling parameter, then
+    adapts the coupling parameter and the step size for the next iteration from the sign of the
+    power. The energy per particle of this and the previous iteration remain in the state for the
+    convergence check on the host.
+*/
+__global__ void gpu_fire_update_state_kernel(fire_state* d_state,
+                                             unsigned int total_group_size,
+                                             bool was_reset,
+                                             const fire_params params)
     {
-    // setup the grid to run the kernel
-    int block_size = 256;
-    dim3 grid((group_size / block_size) + 1, 1, 1);
-    dim3 threads(block_size, 1, 1);
+    if (blockIdx.x * blockDim.x + threadIdx.x != 0)
+        return;
 
-    // run the kernel
-    hipLaunchKernelGGL((gpu_fire_zero_angmom_kernel),
-                       dim3(grid),
-                       dim3(threads),
+    fire_state state = *d_state;
+
+    Scalar energy = state.energy_total / Scalar(total_group_size);
+    if (was_reset)
+        state.old_energy = energy + Scalar(100000) * params.etol;
+    else
+        state.old_energy = state.energy;
+    state.energy = energy;
+
+    Scalar vnorm = sqrt(state.vsq);
+    Scalar fnorm = sqrt(state.fsq);
+    Scalar wnorm = sqrt(state.wsq);
+    Scalar tnorm = sqrt(state.tsq);
+
+    state.mix_alpha = state.alpha;
+
+    if (fabs(fnorm) > 0)
+        state.factor_t = state.alpha * vnorm / fnorm;
+    else
+        state.factor_t = 1.0;
+
+    if (fabs(tnorm) > 0)
+        state.factor_r = state.alpha * wnorm / tnorm;
+    else
+        state.factor_r = 1.0;
+
+    Scalar P = state.Pt + state.Pr;
+
+    if (P > Scalar(0.0))
+        {
+        state.n_since_negative++;
+        if (state.n_since_negative > params.nmin)
+            {
+            state.deltaT = min(state.deltaT * params.finc, params.deltaT_max);
+            state.alpha *= params.falpha;
+            }
+        state.zero_velocity = 0;
+        }
+    else
+        {
+        state.deltaT *= params.fdec;
+        state.alpha = params.alpha_start;
+        state.n_since_negative = 0;
+        state.zero_velocity = 1;
+        }
+
+    *d_state = state;
+    }
+
+/*! \param d_state FIRE state to update
+    \param total_group_size Number of particles in all integrator groups
+    \param was_reset True in the first iteration after a reset
+    \param params Parameters of the FIRE algorithm
+
+    This is a driver for gpu_fire_update_state_kernel(), see it for details.
+*/
+hipError_t gpu_fire_update_state(fire_state* d_state,
+                                 unsigned int total_group_size,
+                                 bool was_reset,
+                                 const fire_params& params)
+    {
+    hipLaunchKernelGGL((gpu_fire_update_state_kernel),
+                       dim3(1),
+                       dim3(1),
                        0,
                        0,
-                       d_angmom,
-                       d_group_members,
-                       group_size);
+                       d_state,
+                       total_group_size,
+                       was_reset,
+                       params);
 
     return hipSuccess;
     }
@@ -745,15 +807,14 @@ hipError_t gpu_fire_compute_sum_all_angular(const unsigned int N,
     \param d_accel Array of accelerations
     \param d_group_members Device array listing the indices of the members of the group to update
     \param group_size Number of members in the grou
-    \param alpha Alpha coupling parameter used by the FIRE algorithm
-    \param factor_t Combined factor vnorm/fnorm*alpha, or 1 if fnorm==0
+    \param d_state FIRE state with the coupling parameter alpha, the combined factor
+        vnorm/fnorm*alpha (or 1 if fnorm==0), and whether to zero the velocities
 */
 __global__ void gpu_fire_update_v_kernel(Scalar4* d_vel,
                                          const Scalar3* d_accel,
                                          unsigned int* d_group_members,
                                          unsigned int group_size,
-                                         Scalar alpha,
-                                         Scalar factor_t)
+                                         const fire_state* d_state)
     {
     // determine which particle this thread works on (MEM TRANSFER: 4 bytes)
     int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -765,9 +826,20 @@ __global__ void gpu_fire_update_v_kernel(Scalar4* d_vel,
         Scalar4 v = d_vel[idx];
         Scalar3 a = d_accel[idx];
 
-        v.x = v.x * (Scalar(1.0) - alpha) + a.x * factor_t;
-        v.y = v.y * (Scalar(1.0) - alpha) + a.y * factor_t;
-        v.z = v.z * (Scalar(1.0) - alpha) + a.z * factor_t;
+        if (d_state->zero_velocity)
+            {
+            v.x = Scalar(0.0);
+            v.y = Scalar(0.0);
+            v.z = Scalar(0.0);
+            }
+        else
+            {
+            Scalar alpha = d_state->mix_alpha;
+            Scalar factor_t = d_state->factor_t;
+            v.x = v.x * (Scalar(1.0) - alpha) + a.x * factor_t;
+            v.y = v.y * (Scalar(1.0) - alpha) + a.y * factor_t;
+            v.z = v.z * (Scalar(1.0) - alpha) + a.z * factor_t;
+            }
 
         // write out the results (MEM_TRANSFER: 32 bytes)
         d_vel[idx] = v;
@@ -778,9 +850,7 @@ __global__ void gpu_fire_update_v_kernel(Scalar4* d_vel,
     \param d_accel array of particle accelerations
     \param d_group_members Device array listing the indices of the members of the group to integrate
     \param group_size Number of members in the group
-    \param alpha Alpha coupling parameter used by the FIRE algorithm
-    \param vnorm Magnitude of the (3*N) dimensional velocity vector
-    \param invfnorm 1 over the magnitude of the (3*N) dimensional force vector
+    \param d_state FIRE state computed by gpu_fire_update_state()
 
     This function is a driver for gpu_fire_update_v_kernel(), see it for details.
 */
@@ -788,8 +858,7 @@ hipError_t gpu_fire_update_v(Scalar4* d_vel,
                              const Scalar3* d_accel,
                              unsigned int* d_group_members,
                              unsigned int group_size,
-                             Scalar alpha,
-                             Scalar factor_t)
+                             const fire_state* d_state)
     {
     // setup the grid to run the kernel
     int block_size = 256;
@@ -806,8 +875,7 @@ hipError_t gpu_fire_update_v(Scalar4* d_vel,
                        d_accel,
                        d_group_members,
                        group_size,
-                       alpha,
-                       factor_t);
+                       d_state);
 
     return hipSuccess;
     }
@@ -818,8 +886,7 @@ __global__ void gpu_fire_update_angmom_kernel(const Scalar4* d_net_torque,
                                               Scalar4* d_angmom,
                                               unsigned int* d_group_members,
                                               unsigned int group_size,
-                                              Scalar alpha,
-                                              Scalar factor_r)
+                                              const fire_state* d_state)
     {
     // determine which particle this thread works on (MEM TRANSFER: 4 bytes)
     int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -827,6 +894,13 @@ __global__ void gpu_fire_update_angmom_kernel(const Scalar4* d_net_torque,
     if (group_idx < group_size)
         {
         unsigned int idx = d_group_members[group_idx];
+
+        if (d_state->zero_velocity)
+            {
+            d_angmom[idx] = make_scalar4(0, 0, 0, 0);
+            return;
+            }
+
         quat<Scalar> q(d_orientation[idx]);
         vec3<Scalar> t(d_net_torque[idx]);
         quat<Scalar> p(d_angmom[idx]);
@@ -849,7 +923,7 @@ __global__ void gpu_fire_update_angmom_kernel(const Scalar4* d_net_torque,
         if (z_zero)
             t.z = 0;
 
-        p = p * Scalar(1.0 - alpha) + Scalar(2.0) * q * t * factor_r;
+        p = p * Scalar(1.0 - d_state->mix_alpha) + Scalar(2.0) * q * t * d_state->factor_r;
 
         d_angmom[idx] = quat_to_scalar4(p);
         }
@@ -861,8 +935,7 @@ hipError_t gpu_fire_update_angmom(const Scalar4* d_net_torque,
                                   Scalar4* d_angmom,
                                   unsigned int* d_group_members,
                                   unsigned int group_size,
-                                  Scalar alpha,
-                                  Scalar factor_r)
+                                  const fire_state* d_state)
     {
     // setup the grid to run the kernel
     int block_size = 256;
@@ -881,8 +954,7 @@ hipError_t gpu_fire_update_angmom(const Scalar4* d_net_torque,
                        d_angmom,
                        d_group_members,
                        group_size,
-                       alpha,
-                       factor_r);
+                       d_state);
 
     return hipSuccess;
     }
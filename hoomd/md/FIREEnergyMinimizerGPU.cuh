@@ -17,11 +17,50 @@ namespace md
     {
 namespace kernel
     {
-//! Kernel driver for zeroing velocities called by FIREEnergyMinimizerGPU
-hipError_t gpu_fire_zero_v(Scalar4* d_vel, unsigned int* d_group_members, unsigned int group_size);
+//! State of the FIRE algorithm that FIREEnergyMinimizerGPU keeps in device memory
+struct fire_state
+    {
+    Scalar energy_total;           //!< Sum of the potential energy over all integrator groups
+    Scalar Pt;                     //!< Translational power
+    Scalar vsq;                    //!< Sum of the squared velocities
+    Scalar fsq;                    //!< Sum of the squared accelerations
+    Scalar Pr;                     //!< Rotational power
+    Scalar wsq;                    //!< Sum of the squared angular velocities
+    Scalar tsq;                    //!< Sum of the squared torques
+    Scalar energy;                 //!< Potential energy per particle in this iteration
+    Scalar old_energy;             //!< Potential energy per particle in the previous iteration
+    Scalar alpha;                  //!< Coupling parameter for the next iteration
+    Scalar deltaT;                 //!< Step size for the next iteration
+    unsigned int n_since_negative; //!< Consecutive iterations with positive power
+    Scalar mix_alpha;              //!< Coupling parameter applied to the velocities
+    Scalar factor_t;               //!< Translational mixing factor alpha*vnorm/fnorm
+    Scalar factor_r;               //!< Rotational mixing factor alpha*wnorm/tnorm
+    unsigned int zero_velocity;    //!< Nonzero when the velocities are to be zeroed
+    };
+
+//! Parameters of the FIRE algorithm passed to gpu_fire_update_state()
+struct fire_params
+    {
+    unsigned int nmin;  //!< Iterations with positive power before alpha and dt adapt
+    Scalar finc;        //!< Fractional increase of the step size
+    Scalar fdec;        //!< Fractional decrease of the step size
+    Scalar alpha_start; //!< Initial coupling parameter
+    Scalar falpha;      //!< Fractional decrease of the coupling parameter
+    Scalar deltaT_max;  //!< Maximum step size
+    Scalar etol;        //!< Energy tolerance
+    };
+
+//! Kernel driver for summing the per method sums into the FIRE state
+hipError_t gpu_fire_reduce_state(fire_state* d_state,
+                                 const Scalar* d_sum_pe,
+                                 const Scalar* d_sum_all,
+                                 unsigned int n_methods);
 
-hipError_t
-gpu_fire_zero_angmom(Scalar4* d_angmom, unsigned int* d_group_members, unsigned int group_size);
+//! Kernel driver for applying the FIRE rules to the state on the device
+hipError_t gpu_fire_update_state(fire_state* d_state,
+                                 unsigned int total_group_size,
+                                 bool was_reset,
+                                 const fire_params& params);
 
 //! Kernel driver for summing the potential energy called by FIREEnergyMinimizerGPU
 hipError_t gpu_fire_compute_sum_pe(unsigned int* d_group_members,
@@ -64,8 +103,7 @@ hipError_t gpu_fire_update_v(Scalar4* d_vel,
                              const Scalar3* d_accel,
                              unsigned int* d_group_members,
                              unsigned int group_size,
-                             Scalar alpha,
-                             Scalar factor_t);
+                             const fire_state* d_state);
 
 hipError_t gpu_fire_update_angmom(const Scalar4* d_net_torque,
                                   const Scalar4* d_orientation,
@@ -73,8 +111,7 @@ hipError_t gpu_fire_update_angmom(const Scalar4* d_net_torque,
                                   Scalar4* d_angmom,
                                   unsigned int* d_group_members,
                                   unsigned int group_size,
-                                  Scalar alpha,
-                                  Scalar factor_r);
+                                  const fire_state* d_state);
 
     } // end namespace kernel
     } // end namespace md
@@ -2,6 +2,7 @@
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
 #include "FIREEnergyMinimizer.h"
+#include "FIREEnergyMinimizerGPU.cuh"
 
 #include <memory>
 
@@ -25,6 +26,12 @@ namespace md
 //! Finds the nearest basin in the potential energy landscape
 /*! \b Overview
 
+    The sums over the integrator groups and the FIRE rules that adapt alpha and the step size are
+    evaluated on the device, in the fire_state held by m_state. The host reads the state only in
+    the iterations that check for convergence (every m_check_interval iterations) and then applies
+    the step size chosen on the device. With domain decomposition, the sums are reduced over the
+    ranks on the host in every iteration.
+
     \ingroup updaters
 */
 class PYBIND11_EXPORT FIREEnergyMinimizerGPU : public FIREEnergyMinimizer
@@ -36,17 +43,31 @@ class PYBIND11_EXPORT FIREEnergyMinimizerGPU : public FIREEnergyMinimizer
     //! Destroys the minimizer
     virtual ~FIREEnergyMinimizerGPU() { }
 
+    //! Reset the minimization
+    virtual void reset();
+
     //! Iterates forward one step
     virtual void update(uint64_t timestep);
 
+    //! Change the step size
+    virtual void setDeltaT(Scalar deltaT);
+
+    //! Return the potential energy after the last iteration
+    virtual Scalar getEnergy() const;
+
     protected:
     unsigned int m_block_size; //!< block size for partial sum memory
 
     GPUVector<Scalar> m_partial_sum1; //!< memory space for partial sum over P and E
     GPUVector<Scalar> m_partial_sum2; //!< memory space for partial sum over vsq
     GPUVector<Scalar> m_partial_sum3; //!< memory space for partial sum over asq
-    GPUArray<Scalar> m_sum;           //!< memory space for sum over E
-    GPUArray<Scalar> m_sum3;          //!< memory space for the sum over P, vsq, asq
+    GPUArray<Scalar> m_sum;           //!< memory space for the sum over E of each method
+    GPUArray<Scalar> m_sum_all; //!< memory space for the sums over P, vsq, asq, Pr, wsq, tsq of
+                                //!< each method
+
+    GPUArray<kernel::fire_state> m_state; //!< FIRE state in device memory
+    bool m_state_dirty = true;  //!< True when alpha and the counters must be written to m_state
+    bool m_deltaT_dirty = true; //!< True when the step size must be written to m_state
 
     private:
     //! allocate the memory needed to store partial sums
@@ -3,6 +3,7 @@
 
 #include "ForceDistanceConstraint.h"
 
+#include <algorithm>
 #include <string.h>
 using namespace Eigen;
 
@@ -19,8 +20,9 @@ namespace md
 ForceDistanceConstraint::ForceDistanceConstraint(std::shared_ptr<SystemDefinition> sysdef)
     : MolecularForceCompute(sysdef), m_cdata(m_sysdef->getConstraintData()), m_cmatrix(m_exec_conf),
       m_cvec(m_exec_conf), m_lagrange(m_exec_conf), m_rel_tol(1e-3),
-      m_constraint_violated(m_exec_conf), m_condition(m_exec_conf), m_sparse_idxlookup(m_exec_conf),
-      m_constraint_reorder(true), m_constraints_added_removed(true), m_d_max(0.0)
+      m_constraint_violated(m_exec_conf), m_condition(m_exec_conf), m_solver(direct),
+      m_lagrange_valid(false), m_sparse_idxlookup(m_exec_conf), m_constraint_reorder(true),
+      m_constraints_added_removed(true), m_d_max(0.0)
     {
     m_constraint_violated.resetFlags(0);
 
@@ -170,6 +172,11 @@ void ForceDistanceConstraint::fillMatrixVector(uint64_t timestep)
     ArrayHandle<double> h_cmatrix(m_cmatrix, access_location::host, access_mode::overwrite);
     ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::overwrite);
 
+    // access the reverse lookup into the sparse matrix
+    ArrayHandle<int> h_sparse_idxlookup(m_sparse_idxlookup,
+                                        access_location::host,
+                                        access_mode::read);
+
     // clear matrix
     memset(h_cmatrix.data, 0, sizeof(double) * m_cmatrix.size());
 
@@ -264,7 +271,7 @@ void ForceDistanceConstraint::fillMatrixVector(uint64_t timestep)
             h_cmatrix.data[m * n_constraint + n] += delta;
 
             // update sparse matrix
-            int k = m_sparse_idxlookup[m * n_constraint + n];
+            int k = h_sparse_idxlookup.data[m * n_constraint + n];
 
             if ((k == -1 && delta != double(0.0)) || (k != -1 && delta == double(0.0)))
                 {
@@ -364,6 +371,7 @@ void ForceDistanceConstraint::solveConstraints(uint64_t timestep)
 
         // sparsity pattern changed
         m_sparse = map_matrix.sparseView();
+        m_sparse.makeCompressed();
 
             {
             ArrayHandle<int> h_sparse_idxlookup(m_sparse_idxlookup,
@@ -401,8 +409,21 @@ void ForceDistanceConstraint::solveConstraints(uint64_t timestep)
                 }
             }
 
-        // Compute the ordering permutation vector from the structural pattern of A
-        m_sparse_solver.analyzePattern(m_sparse);
+        if (m_solver == direct)
+            analyzePattern();
+        }
+
+    if (m_solver == iterative)
+        {
+        if (solveIterative())
+            return;
+
+        m_exec_conf->msg->notice(4)
+            << "ForceDistanceConstraint: iterative solver did not converge. Using LU factorization"
+            << std::endl;
+
+        // solve this step with the direct solver
+        analyzePattern();
         }
 
     // Compute the numerical factorization
@@ -421,6 +442,79 @@ void ForceDistanceConstraint::solveConstraints(uint64_t timestep)
 
     // Use the factors to solve the linear system
     map_lagrange = m_sparse_solver.solve(map_vec);
+    m_lagrange_valid = true;
+    }
+
+/*! The constraint order changes every time the ghost constraints are communicated, which
+    invalidates the sparse matrix. The sparsity pattern itself changes only when the topology or
+    the set of local constraints changes, so keep the symbolic analysis when the rebuilt matrix
+    has the same pattern.
+*/
+void ForceDistanceConstraint::analyzePattern()
+    {
+    const int* outer = m_sparse.outerIndexPtr();
+    const int* inner = m_sparse.innerIndexPtr();
+    size_t n_outer = m_sparse.outerSize() + 1;
+    size_t nnz = m_sparse.nonZeros();
+
+    if (m_analyzed_outer.size() == n_outer && m_analyzed_inner.size() == nnz
+        && std::equal(outer, outer + n_outer, m_analyzed_outer.begin())
+        && std::equal(inner, inner + nnz, m_analyzed_inner.begin()))
+        {
+        return;
+        }
+
+    m_exec_conf->msg->notice(6) << "ForceDistanceConstraint: analyzing sparsity pattern"
+                                << std::endl;
+
+    // Compute the ordering permutation vector from the structural pattern of A
+    m_sparse_solver.analyzePattern(m_sparse);
+
+    m_analyzed_outer.assign(outer, outer + n_outer);
+    m_analyzed_inner.assign(inner, inner + nnz);
+    }
+
+/*! Solves the constraint matrix equation with BiCGSTAB. The constraint matrix is not symmetric, so
+    conjugate gradients do not apply. The Lagrange multipliers change little between steps, so
+    the solver starts from the previous solution and typically needs only a few iterations.
+
+    \returns True if the solver converged
+*/
+bool ForceDistanceConstraint::solveIterative()
+    {
+    typedef Matrix<double, Dynamic, 1> vec_t;
+    typedef Map<vec_t> vec_map_t;
+
+    unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
+
+    // the Jacobi preconditioner depends only on the diagonal
+    m_iterative_solver.setTolerance(1e-10);
+    m_iterative_solver.compute(m_sparse);
+
+    ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::read);
+    ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::readwrite);
+    vec_map_t map_vec(h_cvec.data, n_constraint, 1);
+    vec_map_t map_lagrange(h_lagrange.data, n_constraint, 1);
+
+    if (!m_lagrange_valid)
+        map_lagrange.setZero();
+
+    vec_t guess = map_lagrange;
+    vec_t solution = m_iterative_solver.solveWithGuess(map_vec, guess);
+
+    m_exec_conf->msg->notice(10) << "ForceDistanceConstraint: " << m_iterative_solver.iterations()
+                                 << " iterations, error " << m_iterative_solver.error()
+                                 << std::endl;
+
+    if (m_iterative_solver.info() != Success)
+        {
+        m_lagrange_valid = false;
+        return false;
+        }
+
+    map_lagrange = solution;
+    m_lagrange_valid = true;
+    return true;
     }
 
 void ForceDistanceConstraint::computeConstraintForces(uint64_t timestep)
@@ -658,7 +752,10 @@ void export_ForceDistanceConstraint(pybind11::module& m)
         .def(pybind11::init<std::shared_ptr<SystemDefinition>>())
         .def_property("tolerance",
                       &ForceDistanceConstraint::getRelativeTolerance,
-                      &ForceDistanceConstraint::setRelativeTolerance);
+                      &ForceDistanceConstraint::setRelativeTolerance)
+        .def_property("solver",
+                      &ForceDistanceConstraint::getSolver,
+                      &ForceDistanceConstraint::setSolver);
     }
 
     } // end namespace detail
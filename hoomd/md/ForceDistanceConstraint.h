@@ -20,6 +20,7 @@
 #include "hoomd/GPUVector.h"
 
 #include <Eigen/Dense>
+#include <Eigen/IterativeLinearSolvers>
 #include <Eigen/SparseLU>
 
 namespace hoomd
@@ -39,6 +40,13 @@ namespace md
 class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
     {
     public:
+    //! Methods to solve the constraint matrix equation
+    enum solverMode
+        {
+        direct,   //!< Sparse LU factorization
+        iterative //!< Jacobi preconditioned BiCGSTAB, started from the previous solution
+        };
+
     //! Constructs the compute
     ForceDistanceConstraint(std::shared_ptr<SystemDefinition> sysdef);
 
@@ -63,6 +71,40 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
         return m_rel_tol;
         }
 
+    //! Set the method to solve the constraint matrix equation
+    void setSolver(std::string solver)
+        {
+        if (solver == "direct")
+            {
+            m_solver = direct;
+            }
+        else if (solver == "iterative")
+            {
+            m_solver = iterative;
+            }
+        else
+            {
+            throw std::runtime_error("Invalid constraint solver.");
+            }
+
+        // rebuild the solver state from scratch
+        m_condition.resetFlags(1);
+        }
+
+    /// Get the method to solve the constraint matrix equation
+    std::string getSolver()
+        {
+        switch (m_solver)
+            {
+        case direct:
+            return "direct";
+        case iterative:
+            return "iterative";
+        default:
+            throw std::runtime_error("Error getting constraint solver.");
+            }
+        }
+
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
@@ -87,6 +129,13 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
     Eigen::SparseLU<Eigen::SparseMatrix<double, Eigen::ColMajor>, Eigen::COLAMDOrdering<int>>
         m_sparse_solver;
     //!< The persistent state of the sparse matrix solver
+    Eigen::BiCGSTAB<Eigen::SparseMatrix<double, Eigen::ColMajor>,
+                    Eigen::DiagonalPreconditioner<double>>
+        m_iterative_solver; //!< The iterative solver
+    solverMode m_solver;    //!< Method to solve the constraint matrix equation
+    bool m_lagrange_valid;  //!< True if m_lagrange holds the previous solution in the current order
+    std::vector<int> m_analyzed_outer; //!< Column offsets of the pattern analyzed by the LU solver
+    std::vector<int> m_analyzed_inner; //!< Row indices of the pattern analyzed by the LU solver
     GPUVector<int>
         m_sparse_idxlookup; //!< Reverse lookup from column-major to sparse matrix element
 
@@ -114,14 +163,22 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
     virtual void slotConstraintReorder()
         {
         m_constraint_reorder = true;
+        m_lagrange_valid = false;
         }
 
     //! Method called when constraint order changes
     virtual void slotConstraintsAddedRemoved()
         {
         m_constraints_added_removed = true;
+        m_lagrange_valid = false;
         }
 
+    //! Solve the constraint matrix equation iteratively
+    bool solveIterative();
+
+    //! Analyze the sparsity pattern for the direct solver unless it is unchanged
+    void analyzePattern();
+
     //! Returns the requested ghost layer width for all types
     /*! \param type the type for which we are requesting info
      */
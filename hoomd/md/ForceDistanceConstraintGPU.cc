@@ -203,23 +203,15 @@ void ForceDistanceConstraintGPU::solveConstraints(uint64_t timestep)
     unsigned int sparsity_pattern_changed = m_condition.readFlags();
 
 #ifndef CUSOLVER_AVAILABLE
-    if (!sparsity_pattern_changed)
+    solveConstraintsHost(timestep, sparsity_pattern_changed);
+#else
+    if (m_solver == iterative)
         {
-        // copy new sparse values to host sparse matrix
-        ArrayHandle<double> h_sparse_val(m_sparse_val, access_location::device, access_mode::read);
-        hipMemcpy(m_sparse.valuePtr(),
-                  h_sparse_val.data,
-                  sizeof(double) * m_sparse.data().size(),
-                  hipMemcpyDeviceToHost);
+        // the iterative solver runs on the host
+        solveConstraintsHost(timestep, sparsity_pattern_changed);
+        return;
         }
 
-    // solve on CPU
-    ForceDistanceConstraint::solveConstraints(timestep);
-
-    // a sparse matrix should have been constructed, resize values array
-    m_sparse_val.resize(m_sparse.data().size());
-#else
-
     unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
 
     // skip if zero constraints
@@ -717,6 +709,30 @@ void ForceDistanceConstraintGPU::solveConstraints(uint64_t timestep)
 #endif
     }
 
+/*! Solves the matrix equation on the host with the sparse matrix filled on the device
+    \param timestep Current timestep
+    \param sparsity_pattern_changed Nonzero if the sparse matrix must be rebuilt
+*/
+void ForceDistanceConstraintGPU::solveConstraintsHost(uint64_t timestep,
+                                                      unsigned int sparsity_pattern_changed)
+    {
+    if (!sparsity_pattern_changed)
+        {
+        // copy new sparse values to host sparse matrix
+        ArrayHandle<double> h_sparse_val(m_sparse_val, access_location::device, access_mode::read);
+        hipMemcpy(m_sparse.valuePtr(),
+                  h_sparse_val.data,
+                  sizeof(double) * m_sparse.data().size(),
+                  hipMemcpyDeviceToHost);
+        }
+
+    // solve on CPU
+    ForceDistanceConstraint::solveConstraints(timestep);
+
+    // a sparse matrix should have been constructed, resize values array
+    m_sparse_val.resize(m_sparse.data().size());
+    }
+
 void ForceDistanceConstraintGPU::computeConstraintForces(uint64_t timestep)
     {
     // access solution vector
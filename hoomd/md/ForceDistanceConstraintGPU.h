@@ -105,6 +105,9 @@ class ForceDistanceConstraintGPU : public ForceDistanceConstraint
     //! Solve the matrix equation
     virtual void solveConstraints(uint64_t timestep);
 
+    //! Solve the matrix equation on the host
+    void solveConstraintsHost(uint64_t timestep, unsigned int sparsity_pattern_changed);
+
     //! Compute the constraint forces using the Lagrange multipliers
     virtual void computeConstraintForces(uint64_t timestep);
     };
@@ -0,0 +1,113 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+
+#include <string>
+
+#include <pybind11/pybind11.h>
+
+/*! \file ForcePlugin.h
+    \brief Declares the interface of forces implemented in external C++ code
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __FORCE_PLUGIN_H__
+#define __FORCE_PLUGIN_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+/// Arguments passed to ForcePlugin::compute()
+/*! All pointers address either host or device memory, as selected by \a on_device. The position,
+    tag, and charge arrays hold the \a N local particles followed by the \a n_ghost ghost
+    particles. The force, torque, and virial arrays hold the \a N local particles and are zeroed
+    before the call.
+
+    When the plugin requests a neighbor list, neighbor \a k of particle \a i is
+    <code>nlist[head_list[i] + k]</code> with \a k in <code>[0, n_neigh[i])</code>. The neighbors
+    include ghost particles. Otherwise, the neighbor list pointers are null.
+*/
+struct ForcePluginArgs
+    {
+    uint64_t timestep;    //!< Current timestep
+    bool on_device;       //!< True when the pointers address device memory
+    unsigned int N;       //!< Number of local particles
+    unsigned int n_ghost; //!< Number of ghost particles
+    BoxDim box;           //!< Local box
+
+    const Scalar4* pos;      //!< Positions (x, y, z) and types (w, as int)
+    const unsigned int* tag; //!< Tags
+    const Scalar* charge;    //!< Charges
+
+    const unsigned int* n_neigh; //!< Number of neighbors of each local particle
+    const unsigned int* nlist;   //!< Neighbor indices
+    const size_t* head_list;     //!< Start of each particle's neighbors in nlist
+    bool full_nlist;             //!< True when each pair is listed for both particles
+
+    Scalar4* force;      //!< Forces (x, y, z) and potential energies (w)
+    Scalar4* torque;     //!< Torques, null when the plugin is not anisotropic
+    Scalar* virial;      //!< Virials, null when the pressure tensor is not needed
+    size_t virial_pitch; //!< Pitch of the virial array (xx, xy, xz, yy, yz, zz rows)
+    };
+
+/// Force implemented in external C++ code
+/*! Plugins let components evaluate forces, such as machine learned potentials hosted by an
+    inference runtime, without calling back into Python. Components derive from ForcePlugin,
+    export the derived class to Python with a std::shared_ptr holder, and pass an instance to
+    hoomd.md.force.Plugin. PluginForceCompute then calls compute() every time it computes forces
+    with the Python global interpreter lock released.
+
+    On the GPU, HOOMD enqueues all of its work on the default stream. compute() may launch work on
+    the default stream and return without synchronizing, or order work on its own streams after
+    the default stream (e.g. with events) and make the default stream wait on its completion
+    before it returns.
+*/
+class PYBIND11_EXPORT ForcePlugin
+    {
+    public:
+    virtual ~ForcePlugin() { }
+
+    /// Compute the forces, energies, and (when requested) the virials and torques
+    virtual void compute(const ForcePluginArgs& args) = 0;
+
+    /// Get the cutoff radius of the neighbor list, or 0 when the plugin needs no neighbors
+    virtual Scalar getRCut() const
+        {
+        return 0;
+        }
+
+    /// Test if the plugin needs a full neighbor list (each pair listed for both particles)
+    virtual bool needsFullNeighborList() const
+        {
+        return true;
+        }
+
+    /// Test if the plugin computes on the GPU, it receives host pointers otherwise
+    virtual bool supportsDevice() const
+        {
+        return false;
+        }
+
+    /// Test if the plugin computes torques
+    virtual bool isAnisotropic() const
+        {
+        return false;
+        }
+
+    /// Get the name of the plugin for messages
+    virtual std::string getName() const
+        {
+        return "plugin";
+        }
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __FORCE_PLUGIN_H__
@@ -30,6 +30,18 @@ HOSTDEVICE inline vec3<Scalar> rotate(const Scalar (&mat)[3][3], const vec3<Scal
                         mat[2][0] * v.x + mat[2][1] * v.y + mat[2][2] * v.z);
     }
 
+// Multiply by the transpose of mat, which is the inverse rotation.
+template<typename Scalar>
+HOSTDEVICE inline vec3<Scalar> rotate_transpose(const Scalar (&mat)[3][3], const vec3<Scalar>& v)
+    {
+    return vec3<Scalar>(mat[0][0] * v.x + mat[1][0] * v.y + mat[2][0] * v.z,
+                        mat[0][1] * v.x + mat[1][1] * v.y + mat[2][1] * v.z,
+                        mat[0][2] * v.x + mat[1][2] * v.y + mat[2][2] * v.z);
+    }
+
+// The support vertex maximizes dot(rotate(mat, verts[i]) + shift, vector). The shift adds the same
+// value to every vertex, and dot(rotate(mat, x), vector) = dot(x, rotate_transpose(mat, vector)),
+// so it suffices to rotate the direction into the body frame once instead of rotating each vertex.
 HOSTDEVICE inline void support_polyhedron(const ManagedArray<vec3<Scalar>>& verts,
                                           const vec3<Scalar>& vector,
                                           const Scalar (&mat)[3][3],
@@ -37,12 +49,13 @@ HOSTDEVICE inline void support_polyhedron(const ManagedArray<vec3<Scalar>>& vert
                                           unsigned int& idx)
     {
     // Compute the support function of the polyhedron.
+    vec3<Scalar> body_vector = rotate_transpose(mat, vector);
     unsigned int index = 0;
 
-    Scalar max_dist_sq = dot((rotate(mat, verts[index]) + shift), vector);
+    Scalar max_dist_sq = dot(verts[index], body_vector);
     for (unsigned int i = 1; i < verts.size(); ++i)
         {
-        Scalar dist_sq = dot((rotate(mat, verts[i]) + shift), vector);
+        Scalar dist_sq = dot(verts[i], body_vector);
 
         if (dist_sq > max_dist_sq)
             {
@@ -53,6 +66,43 @@ HOSTDEVICE inline void support_polyhedron(const ManagedArray<vec3<Scalar>>& vert
     idx = index;
     }
 
+// Compute the support function of a convex polyhedron by hill climbing on its edge graph. A vertex
+// that is no further along the direction than any of its neighbors is the support vertex. idx is
+// the starting vertex on entry and the support vertex on exit. Starting from the support vertex
+// of a nearby direction, such as the one found in the previous GJK iteration, visits few vertices.
+HOSTDEVICE inline void support_polyhedron_hill_climb(const ManagedArray<vec3<Scalar>>& verts,
+                                                     const ManagedArray<unsigned int>& neighbors,
+                                                     const ManagedArray<unsigned int>& offsets,
+                                                     const vec3<Scalar>& vector,
+                                                     const Scalar (&mat)[3][3],
+                                                     unsigned int& idx)
+    {
+    vec3<Scalar> body_vector = rotate_transpose(mat, vector);
+    unsigned int current = idx;
+    Scalar max_dist = dot(verts[current], body_vector);
+
+    while (true)
+        {
+        unsigned int best = current;
+        for (unsigned int k = offsets[current]; k < offsets[current + 1]; ++k)
+            {
+            Scalar dist = dot(verts[neighbors[k]], body_vector);
+            if (dist > max_dist)
+                {
+                max_dist = dist;
+                best = neighbors[k];
+                }
+            }
+
+        if (best == current)
+            {
+            break;
+            }
+        current = best;
+        }
+    idx = current;
+    }
+
 HOSTDEVICE inline void support_ellipsoid(const vec3<Scalar>& rounding_radii,
                                          const vec3<Scalar>& vector,
                                          const quat<Scalar>& q,
@@ -612,6 +662,12 @@ HOSTDEVICE inline void sv_subalgorithm(vec3<Scalar>* W, unsigned int& W_used, Sc
  * function.
  * \param has_rounding2 Whether or not to actually use roundingradii2 to add to the support
  * function.
+ * \param neighbors1 Indices of the vertices that share an edge with each vertex of verts1.
+ * \param neighbor_offsets1 Index of the first neighbor of each vertex of verts1 in neighbors1
+ * (verts1.size + 1 entries), or empty to scan all vertices of verts1 in the support function.
+ * \param neighbors2 Indices of the vertices that share an edge with each vertex of verts2.
+ * \param neighbor_offsets2 Index of the first neighbor of each vertex of verts2 in neighbors2
+ * (verts2.size + 1 entries), or empty to scan all vertices of verts2 in the support function.
  */
 template<unsigned int ndim>
 HOSTDEVICE inline void gjk(const ManagedArray<vec3<Scalar>>& verts1,
@@ -629,7 +685,11 @@ HOSTDEVICE inline void gjk(const ManagedArray<vec3<Scalar>>& verts1,
                            const vec3<Scalar>& rounding_radii1,
                            const vec3<Scalar>& rounding_radii2,
                            bool has_rounding1,
-                           bool has_rounding2)
+                           bool has_rounding2,
+                           const ManagedArray<unsigned int>& neighbors1,
+                           const ManagedArray<unsigned int>& neighbor_offsets1,
+                           const ManagedArray<unsigned int>& neighbors2,
+                           const ManagedArray<unsigned int>& neighbor_offsets2)
     {
     // At any point only a subset of W is in use (identified by W_used), but
     // the total possible is capped at ndim+1 because that is the largest
@@ -669,6 +729,9 @@ HOSTDEVICE inline void gjk(const ManagedArray<vec3<Scalar>>& verts1,
     const unsigned int max_iterations
         = ((has_rounding1 || has_rounding2) ? 50 : verts1.size() + verts2.size() + 1);
     unsigned int iteration = 0;
+    // The hill climbing support functions start from the support vertices of the previous
+    // iteration.
+    unsigned int i1 = 0, i2 = 0;
     while (!close_enough)
         {
         iteration += 1;
@@ -679,9 +742,22 @@ HOSTDEVICE inline void gjk(const ManagedArray<vec3<Scalar>>& verts1,
             }
         // support_{A-B}(-v) = support(A, -v) - support(B, v)
         vec3<Scalar> ellipsoid_support1, ellipsoid_support2;
-        unsigned int i1, i2;
-        support_polyhedron(verts1, -v, mati, vec3<Scalar>(0, 0, 0), i1);
-        support_polyhedron(verts2, v, matj, Scalar(-1.0) * dr, i2);
+        if (neighbor_offsets1.size() > 0)
+            {
+            support_polyhedron_hill_climb(verts1, neighbors1, neighbor_offsets1, -v, mati, i1);
+            }
+        else
+            {
+            support_polyhedron(verts1, -v, mati, vec3<Scalar>(0, 0, 0), i1);
+            }
+        if (neighbor_offsets2.size() > 0)
+            {
+            support_polyhedron_hill_climb(verts2, neighbors2, neighbor_offsets2, v, matj, i2);
+            }
+        else
+            {
+            support_polyhedron(verts2, v, matj, Scalar(-1.0) * dr, i2);
+            }
         if (has_rounding1)
             {
             support_ellipsoid(rounding_radii1, -v, qi, ellipsoid_support1);
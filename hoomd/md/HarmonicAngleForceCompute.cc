@@ -2,6 +2,7 @@
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
 #include "HarmonicAngleForceCompute.h"
+#include "BondedForceThreads.h"
 
 #include <iostream>
 #include <math.h>
@@ -105,17 +106,18 @@ void HarmonicAngleForceCompute::computeForces(uint64_t timestep)
     assert(m_pdata);
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<AngleData::members_t> h_angle_idx(m_angle_data->getMemberIndexTable(),
+                                                  access_location::host,
+                                                  access_mode::read);
 
     ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
-    size_t virial_pitch = m_virial.getPitch();
 
     // there are enough other checks on the input data: but it doesn't hurt to be safe
     assert(h_force.data);
     assert(h_virial.data);
     assert(h_pos.data);
-    assert(h_rtag.data);
+    assert(h_angle_idx.data);
 
     // Zero data for force calculation.
     memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
@@ -124,144 +126,175 @@ void HarmonicAngleForceCompute::computeForces(uint64_t timestep)
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getGlobalBox();
 
-    // for each of the angles
-    const unsigned int size = (unsigned int)m_angle_data->getN();
-    for (unsigned int i = 0; i < size; i++)
-        {
-        // lookup the tag of each of the particles participating in the angle
-        const AngleData::members_t& angle = m_angle_data->getMembersByIndex(i);
-        assert(angle.tag[0] <= m_pdata->getMaximumTag());
-        assert(angle.tag[1] <= m_pdata->getMaximumTag());
-        assert(angle.tag[2] <= m_pdata->getMaximumTag());
-
-        // transform a, b, and c into indices into the particle data arrays
-        // MEM TRANSFER: 6 ints
-        unsigned int idx_a = h_rtag.data[angle.tag[0]];
-        unsigned int idx_b = h_rtag.data[angle.tag[1]];
-        unsigned int idx_c = h_rtag.data[angle.tag[2]];
-
-        // throw an error if this angle is incomplete
-        if (idx_a == NOT_LOCAL || idx_b == NOT_LOCAL || idx_c == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error()
-                << "angle.harmonic: angle " << angle.tag[0] << " " << angle.tag[1] << " "
-                << angle.tag[2] << " incomplete." << endl
-                << endl;
-            throw std::runtime_error("Error in angle calculation");
-            }
+    PDataFlags flags = m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor];
 
-        assert(idx_a < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_b < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_c < m_pdata->getN() + m_pdata->getNGhosts());
-
-        // calculate d\vec{r}
-        Scalar3 dab;
-        dab.x = h_pos.data[idx_a].x - h_pos.data[idx_b].x;
-        dab.y = h_pos.data[idx_a].y - h_pos.data[idx_b].y;
-        dab.z = h_pos.data[idx_a].z - h_pos.data[idx_b].z;
-
-        Scalar3 dcb;
-        dcb.x = h_pos.data[idx_c].x - h_pos.data[idx_b].x;
-        dcb.y = h_pos.data[idx_c].y - h_pos.data[idx_b].y;
-        dcb.z = h_pos.data[idx_c].z - h_pos.data[idx_b].z;
-
-        Scalar3 dac;
-        dac.x = h_pos.data[idx_a].x - h_pos.data[idx_c].x; // used for the 1-3 JL interaction
-        dac.y = h_pos.data[idx_a].y - h_pos.data[idx_c].y;
-        dac.z = h_pos.data[idx_a].z - h_pos.data[idx_c].z;
-
-        // apply minimum image conventions to all 3 vectors
-        dab = box.minImage(dab);
-        dcb = box.minImage(dcb);
-        dac = box.minImage(dac);
-
-        // on paper, the formula turns out to be: F = K*\vec{r} * (r_0/r - 1)
-        // FLOPS: 14 / MEM TRANSFER: 2 Scalars
-
-        // FLOPS: 42 / MEM TRANSFER: 6 Scalars
-        Scalar rsqab = dab.x * dab.x + dab.y * dab.y + dab.z * dab.z;
-        Scalar rab = sqrt(rsqab);
-        Scalar rsqcb = dcb.x * dcb.x + dcb.y * dcb.y + dcb.z * dcb.z;
-        Scalar rcb = sqrt(rsqcb);
-
-        Scalar c_abbc = dab.x * dcb.x + dab.y * dcb.y + dab.z * dcb.z;
-        c_abbc /= rab * rcb;
-
-        if (c_abbc > 1.0)
-            c_abbc = 1.0;
-        if (c_abbc < -1.0)
-            c_abbc = -1.0;
-
-        Scalar s_abbc = sqrt(1.0 - c_abbc * c_abbc);
-        if (s_abbc < SMALL)
-            s_abbc = SMALL;
-        s_abbc = 1.0 / s_abbc;
-
-        // actually calculate the force
-        unsigned int angle_type = m_angle_data->getTypeByIndex(i);
-        Scalar dth = acos(c_abbc) - m_t_0[angle_type];
-        Scalar tk = m_K[angle_type] * dth;
-
-        Scalar a = -1.0 * tk * s_abbc;
-        Scalar a11 = a * c_abbc / rsqab;
-        Scalar a12 = -a / (rab * rcb);
-        Scalar a22 = a * c_abbc / rsqcb;
-
-        Scalar fab[3], fcb[3];
-
-        fab[0] = a11 * dab.x + a12 * dcb.x;
-        fab[1] = a11 * dab.y + a12 * dcb.y;
-        fab[2] = a11 * dab.z + a12 * dcb.z;
-
-        fcb[0] = a22 * dcb.x + a12 * dab.x;
-        fcb[1] = a22 * dcb.y + a12 * dab.y;
-        fcb[2] = a22 * dcb.z + a12 * dab.z;
-
-        // compute 1/3 of the energy, 1/3 for each atom in the angle
-        Scalar angle_eng = (tk * dth) * Scalar(1.0 / 6.0);
-
-        // compute 1/3 of the virial, 1/3 for each atom in the angle
-        // upper triangular version of virial tensor
-        Scalar angle_virial[6];
-        angle_virial[0] = Scalar(1. / 3.) * (dab.x * fab[0] + dcb.x * fcb[0]);
-        angle_virial[1] = Scalar(1. / 3.) * (dab.y * fab[0] + dcb.y * fcb[0]);
-        angle_virial[2] = Scalar(1. / 3.) * (dab.z * fab[0] + dcb.z * fcb[0]);
-        angle_virial[3] = Scalar(1. / 3.) * (dab.y * fab[1] + dcb.y * fcb[1]);
-        angle_virial[4] = Scalar(1. / 3.) * (dab.z * fab[1] + dcb.z * fcb[1]);
-        angle_virial[5] = Scalar(1. / 3.) * (dab.z * fab[2] + dcb.z * fcb[2]);
-
-        // Now, apply the force to each individual atom a,b,c, and accumulate the energy/virial
-        // do not update ghost particles
-        if (idx_a < m_pdata->getN())
-            {
-            h_force.data[idx_a].x += fab[0];
-            h_force.data[idx_a].y += fab[1];
-            h_force.data[idx_a].z += fab[2];
-            h_force.data[idx_a].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j * virial_pitch + idx_a] += angle_virial[j];
-            }
+    const unsigned int N = m_pdata->getN();
 
-        if (idx_b < m_pdata->getN())
-            {
-            h_force.data[idx_b].x -= fab[0] + fcb[0];
-            h_force.data[idx_b].y -= fab[1] + fcb[1];
-            h_force.data[idx_b].z -= fab[2] + fcb[2];
-            h_force.data[idx_b].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j * virial_pitch + idx_b] += angle_virial[j];
-            }
+    ArrayHandle<AngleData::members_t> h_angles(m_angle_data->getMembersArray(),
+                                               access_location::host,
+                                               access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_angle_data->getTypeValArray(),
+                                     access_location::host,
+                                     access_mode::read);
 
-        if (idx_c < m_pdata->getN())
+    // for each of the angles
+    const unsigned int size = (unsigned int)m_angle_data->getN();
+    auto compute_range = [&](unsigned int first,
+                             unsigned int last,
+                             Scalar4* force,
+                             Scalar* virial,
+                             size_t virial_pitch)
+    {
+        for (unsigned int i = first; i < last; i++)
             {
-            h_force.data[idx_c].x += fcb[0];
-            h_force.data[idx_c].y += fcb[1];
-            h_force.data[idx_c].z += fcb[2];
-            h_force.data[idx_c].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j * virial_pitch + idx_c] += angle_virial[j];
+            // lookup the tag of each of the particles participating in the angle
+            const AngleData::members_t& angle = h_angles.data[i];
+            assert(angle.tag[0] <= m_pdata->getMaximumTag());
+            assert(angle.tag[1] <= m_pdata->getMaximumTag());
+            assert(angle.tag[2] <= m_pdata->getMaximumTag());
+
+            // transform a, b, and c into indices into the particle data arrays
+            // MEM TRANSFER: 6 ints
+            unsigned int idx_a = h_angle_idx.data[i].idx[0];
+            unsigned int idx_b = h_angle_idx.data[i].idx[1];
+            unsigned int idx_c = h_angle_idx.data[i].idx[2];
+
+            // throw an error if this angle is incomplete
+            if (idx_a == NOT_LOCAL || idx_b == NOT_LOCAL || idx_c == NOT_LOCAL)
+                {
+                this->m_exec_conf->msg->error()
+                    << "angle.harmonic: angle " << angle.tag[0] << " " << angle.tag[1] << " "
+                    << angle.tag[2] << " incomplete." << endl
+                    << endl;
+                throw std::runtime_error("Error in angle calculation");
+                }
+
+            assert(idx_a < N + m_pdata->getNGhosts());
+            assert(idx_b < N + m_pdata->getNGhosts());
+            assert(idx_c < N + m_pdata->getNGhosts());
+
+            // calculate d\vec{r}
+            Scalar3 dab;
+            dab.x = h_pos.data[idx_a].x - h_pos.data[idx_b].x;
+            dab.y = h_pos.data[idx_a].y - h_pos.data[idx_b].y;
+            dab.z = h_pos.data[idx_a].z - h_pos.data[idx_b].z;
+
+            Scalar3 dcb;
+            dcb.x = h_pos.data[idx_c].x - h_pos.data[idx_b].x;
+            dcb.y = h_pos.data[idx_c].y - h_pos.data[idx_b].y;
+            dcb.z = h_pos.data[idx_c].z - h_pos.data[idx_b].z;
+
+            Scalar3 dac;
+            dac.x = h_pos.data[idx_a].x - h_pos.data[idx_c].x; // used for the 1-3 JL interaction
+            dac.y = h_pos.data[idx_a].y - h_pos.data[idx_c].y;
+            dac.z = h_pos.data[idx_a].z - h_pos.data[idx_c].z;
+
+            // apply minimum image conventions to all 3 vectors
+            dab = box.minImage(dab);
+            dcb = box.minImage(dcb);
+            dac = box.minImage(dac);
+
+            // on paper, the formula turns out to be: F = K*\vec{r} * (r_0/r - 1)
+            // FLOPS: 14 / MEM TRANSFER: 2 Scalars
+
+            // FLOPS: 42 / MEM TRANSFER: 6 Scalars
+            Scalar rsqab = dab.x * dab.x + dab.y * dab.y + dab.z * dab.z;
+            Scalar rab = sqrt(rsqab);
+            Scalar rsqcb = dcb.x * dcb.x + dcb.y * dcb.y + dcb.z * dcb.z;
+            Scalar rcb = sqrt(rsqcb);
+
+            Scalar c_abbc = dab.x * dcb.x + dab.y * dcb.y + dab.z * dcb.z;
+            c_abbc /= rab * rcb;
+
+            if (c_abbc > 1.0)
+                c_abbc = 1.0;
+            if (c_abbc < -1.0)
+                c_abbc = -1.0;
+
+            Scalar s_abbc = sqrt(1.0 - c_abbc * c_abbc);
+            if (s_abbc < SMALL)
+                s_abbc = SMALL;
+            s_abbc = 1.0 / s_abbc;
+
+            // actually calculate the force
+            unsigned int angle_type = h_typeval.data[i].type;
+            Scalar dth = acos(c_abbc) - m_t_0[angle_type];
+            Scalar tk = m_K[angle_type] * dth;
+
+            Scalar a = -1.0 * tk * s_abbc;
+            Scalar a11 = a * c_abbc / rsqab;
+            Scalar a12 = -a / (rab * rcb);
+            Scalar a22 = a * c_abbc / rsqcb;
+
+            Scalar fab[3], fcb[3];
+
+            fab[0] = a11 * dab.x + a12 * dcb.x;
+            fab[1] = a11 * dab.y + a12 * dcb.y;
+            fab[2] = a11 * dab.z + a12 * dcb.z;
+
+            fcb[0] = a22 * dcb.x + a12 * dab.x;
+            fcb[1] = a22 * dcb.y + a12 * dab.y;
+            fcb[2] = a22 * dcb.z + a12 * dab.z;
+
+            // compute 1/3 of the energy, 1/3 for each atom in the angle
+            Scalar angle_eng = (tk * dth) * Scalar(1.0 / 6.0);
+
+            // compute 1/3 of the virial, 1/3 for each atom in the angle
+            // upper triangular version of virial tensor
+            Scalar angle_virial[6];
+            angle_virial[0] = Scalar(1. / 3.) * (dab.x * fab[0] + dcb.x * fcb[0]);
+            angle_virial[1] = Scalar(1. / 3.) * (dab.y * fab[0] + dcb.y * fcb[0]);
+            angle_virial[2] = Scalar(1. / 3.) * (dab.z * fab[0] + dcb.z * fcb[0]);
+            angle_virial[3] = Scalar(1. / 3.) * (dab.y * fab[1] + dcb.y * fcb[1]);
+            angle_virial[4] = Scalar(1. / 3.) * (dab.z * fab[1] + dcb.z * fcb[1]);
+            angle_virial[5] = Scalar(1. / 3.) * (dab.z * fab[2] + dcb.z * fcb[2]);
+
+            // Now, apply the force to each individual atom a,b,c, and accumulate the energy/virial
+            // do not update ghost particles
+            if (idx_a < N)
+                {
+                force[idx_a].x += fab[0];
+                force[idx_a].y += fab[1];
+                force[idx_a].z += fab[2];
+                force[idx_a].w += angle_eng;
+                if (compute_virial)
+                    for (int j = 0; j < 6; j++)
+                        virial[j * virial_pitch + idx_a] += angle_virial[j];
+                }
+
+            if (idx_b < N)
+                {
+                force[idx_b].x -= fab[0] + fcb[0];
+                force[idx_b].y -= fab[1] + fcb[1];
+                force[idx_b].z -= fab[2] + fcb[2];
+                force[idx_b].w += angle_eng;
+                if (compute_virial)
+                    for (int j = 0; j < 6; j++)
+                        virial[j * virial_pitch + idx_b] += angle_virial[j];
+                }
+
+            if (idx_c < N)
+                {
+                force[idx_c].x += fcb[0];
+                force[idx_c].y += fcb[1];
+                force[idx_c].z += fcb[2];
+                force[idx_c].w += angle_eng;
+                if (compute_virial)
+                    for (int j = 0; j < 6; j++)
+                        virial[j * virial_pitch + idx_c] += angle_virial[j];
+                }
             }
-        }
+    };
+
+    detail::computeBondedForces(m_exec_conf,
+                                size,
+                                N,
+                                compute_virial,
+                                h_force.data,
+                                h_virial.data,
+                                m_virial.getPitch(),
+                                compute_range);
     }
 
 namespace detail
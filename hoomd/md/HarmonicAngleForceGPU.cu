@@ -35,7 +35,9 @@ namespace kernel
     \param alist Angle data to use in calculating the forces
     \param pitch Pitch of 2D angles list
     \param n_angles_list List of numbers of angles stored on the GPU
+    \tparam compute_virial When false, the kernel does not write the virial
 */
+template<bool compute_virial>
 __global__ void gpu_compute_harmonic_angle_forces_kernel(Scalar4* d_force,
                                                          Scalar* d_virial,
                                                          const size_t virial_pitch,
@@ -198,13 +200,17 @@ __global__ void gpu_compute_harmonic_angle_forces_kernel(Scalar4* d_force,
 
     // now that the force calculation is complete, write out the result (MEM TRANSFER: 20 bytes)
     d_force[idx] = force_idx;
-    for (int i = 0; i < 6; i++)
-        d_virial[i * virial_pitch + idx] = virial[i];
+    if (compute_virial)
+        {
+        for (int i = 0; i < 6; i++)
+            d_virial[i * virial_pitch + idx] = virial[i];
+        }
     }
 
 /*! \param d_force Device memory to write computed forces
     \param d_virial Device memory to write computed virials
     \param virial_pitch pitch of 2D virial array
+    \param compute_virial True to compute the virial
     \param N number of particles
     \param d_pos device array of particle positions
     \param box Box dimensions (in GPU format) to use for periodic boundary conditions
@@ -225,6 +231,7 @@ __global__ void gpu_compute_harmonic_angle_forces_kernel(Scalar4* d_force,
 hipError_t gpu_compute_harmonic_angle_forces(Scalar4* d_force,
                                              Scalar* d_virial,
                                              const size_t virial_pitch,
+                                             bool compute_virial,
                                              const unsigned int N,
                                              const Scalar4* d_pos,
                                              const BoxDim& box,
@@ -240,7 +247,9 @@ hipError_t gpu_compute_harmonic_angle_forces(Scalar4* d_force,
 
     unsigned int max_block_size;
     hipFuncAttributes attr;
-    hipFuncGetAttributes(&attr, (const void*)gpu_compute_harmonic_angle_forces_kernel);
+    auto func = compute_virial ? &gpu_compute_harmonic_angle_forces_kernel<true>
+                               : &gpu_compute_harmonic_angle_forces_kernel<false>;
+    hipFuncGetAttributes(&attr, (const void*)func);
     max_block_size = attr.maxThreadsPerBlock;
 
     unsigned int run_block_size = min(block_size, max_block_size);
@@ -250,7 +259,7 @@ hipError_t gpu_compute_harmonic_angle_forces(Scalar4* d_force,
     dim3 threads(run_block_size, 1, 1);
 
     // run the kernel
-    hipLaunchKernelGGL((gpu_compute_harmonic_angle_forces_kernel),
+    hipLaunchKernelGGL((func),
                        dim3(grid),
                        dim3(threads),
                        0,
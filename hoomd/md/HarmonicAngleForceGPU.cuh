@@ -23,6 +23,7 @@ namespace kernel
 hipError_t gpu_compute_harmonic_angle_forces(Scalar4* d_force,
                                              Scalar* d_virial,
                                              const size_t virial_pitch,
+                                             bool compute_virial,
                                              const unsigned int N,
                                              const Scalar4* d_pos,
                                              const BoxDim& box,
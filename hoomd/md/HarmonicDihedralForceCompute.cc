@@ -2,6 +2,7 @@
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
 #include "HarmonicDihedralForceCompute.h"
+#include "BondedForceThreads.h"
 
 #include <iostream>
 #include <math.h>
@@ -118,7 +119,9 @@ void HarmonicDihedralForceCompute::computeForces(uint64_t timestep)
     assert(m_pdata);
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<ImproperData::members_t> h_dihedral_idx(m_dihedral_data->getMemberIndexTable(),
+                                                        access_location::host,
+                                                        access_mode::read);
 
     ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
@@ -131,228 +134,257 @@ void HarmonicDihedralForceCompute::computeForces(uint64_t timestep)
     assert(h_force.data);
     assert(h_virial.data);
     assert(h_pos.data);
-    assert(h_rtag.data);
-
-    size_t virial_pitch = m_virial.getPitch();
+    assert(h_dihedral_idx.data);
 
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getBox();
 
-    // for each of the dihedrals
-    const unsigned int size = (unsigned int)m_dihedral_data->getN();
-    for (unsigned int i = 0; i < size; i++)
-        {
-        // lookup the tag of each of the particles participating in the dihedral
-        const ImproperData::members_t& dihedral = m_dihedral_data->getMembersByIndex(i);
-        assert(dihedral.tag[0] <= m_pdata->getMaximumTag());
-        assert(dihedral.tag[1] <= m_pdata->getMaximumTag());
-        assert(dihedral.tag[2] <= m_pdata->getMaximumTag());
-        assert(dihedral.tag[3] <= m_pdata->getMaximumTag());
-
-        // transform a, b, and c into indices into the particle data arrays
-        // MEM TRANSFER: 6 ints
-        unsigned int idx_a = h_rtag.data[dihedral.tag[0]];
-        unsigned int idx_b = h_rtag.data[dihedral.tag[1]];
-        unsigned int idx_c = h_rtag.data[dihedral.tag[2]];
-        unsigned int idx_d = h_rtag.data[dihedral.tag[3]];
-
-        // throw an error if this angle is incomplete
-        if (idx_a == NOT_LOCAL || idx_b == NOT_LOCAL || idx_c == NOT_LOCAL || idx_d == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error()
-                << "dihedral.harmonic: dihedral " << dihedral.tag[0] << " " << dihedral.tag[1]
-                << " " << dihedral.tag[2] << " " << dihedral.tag[3] << " incomplete." << endl
-                << endl;
-            throw std::runtime_error("Error in dihedral calculation");
-            }
+    PDataFlags flags = m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor];
 
-        assert(idx_a < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_b < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_c < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_d < m_pdata->getN() + m_pdata->getNGhosts());
-
-        // calculate d\vec{r}
-        Scalar3 dab;
-        dab.x = h_pos.data[idx_a].x - h_pos.data[idx_b].x;
-        dab.y = h_pos.data[idx_a].y - h_pos.data[idx_b].y;
-        dab.z = h_pos.data[idx_a].z - h_pos.data[idx_b].z;
-
-        Scalar3 dcb;
-        dcb.x = h_pos.data[idx_c].x - h_pos.data[idx_b].x;
-        dcb.y = h_pos.data[idx_c].y - h_pos.data[idx_b].y;
-        dcb.z = h_pos.data[idx_c].z - h_pos.data[idx_b].z;
-
-        Scalar3 ddc;
-        ddc.x = h_pos.data[idx_d].x - h_pos.data[idx_c].x;
-        ddc.y = h_pos.data[idx_d].y - h_pos.data[idx_c].y;
-        ddc.z = h_pos.data[idx_d].z - h_pos.data[idx_c].z;
-
-        // apply periodic boundary conditions
-        dab = box.minImage(dab);
-        dcb = box.minImage(dcb);
-        ddc = box.minImage(ddc);
-
-        Scalar3 dcbm;
-        dcbm.x = -dcb.x;
-        dcbm.y = -dcb.y;
-        dcbm.z = -dcb.z;
-
-        dcbm = box.minImage(dcbm);
-
-        Scalar aax = dab.y * dcbm.z - dab.z * dcbm.y;
-        Scalar aay = dab.z * dcbm.x - dab.x * dcbm.z;
-        Scalar aaz = dab.x * dcbm.y - dab.y * dcbm.x;
-
-        Scalar bbx = ddc.y * dcbm.z - ddc.z * dcbm.y;
-        Scalar bby = ddc.z * dcbm.x - ddc.x * dcbm.z;
-        Scalar bbz = ddc.x * dcbm.y - ddc.y * dcbm.x;
-
-        Scalar raasq = aax * aax + aay * aay + aaz * aaz;
-        Scalar rbbsq = bbx * bbx + bby * bby + bbz * bbz;
-        Scalar rgsq = dcbm.x * dcbm.x + dcbm.y * dcbm.y + dcbm.z * dcbm.z;
-        Scalar rg = sqrt(rgsq);
-
-        Scalar rginv, raa2inv, rbb2inv;
-        rginv = raa2inv = rbb2inv = Scalar(0.0);
-        if (rg > Scalar(0.0))
-            rginv = Scalar(1.0) / rg;
-        if (raasq > Scalar(0.0))
-            raa2inv = Scalar(1.0) / raasq;
-        if (rbbsq > Scalar(0.0))
-            rbb2inv = Scalar(1.0) / rbbsq;
-        Scalar rabinv = sqrt(raa2inv * rbb2inv);
-
-        Scalar c_abcd = (aax * bbx + aay * bby + aaz * bbz) * rabinv;
-        Scalar s_abcd = rg * rabinv * (aax * ddc.x + aay * ddc.y + aaz * ddc.z);
-
-        if (c_abcd > 1.0)
-            c_abcd = 1.0;
-        if (c_abcd < -1.0)
-            c_abcd = -1.0;
-
-        unsigned int dihedral_type = m_dihedral_data->getTypeByIndex(i);
-        int multi = m_multi[dihedral_type];
-        Scalar p = Scalar(1.0);
-        Scalar dfab = Scalar(0.0);
-        Scalar ddfab = Scalar(0.0);
-
-        for (int j = 0; j < multi; j++)
-            {
-            ddfab = p * c_abcd - dfab * s_abcd;
-            dfab = p * s_abcd + dfab * c_abcd;
-            p = ddfab;
-            }
+    ArrayHandle<ImproperData::members_t> h_dihedrals(m_dihedral_data->getMembersArray(),
+                                                     access_location::host,
+                                                     access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_dihedral_data->getTypeValArray(),
+                                     access_location::host,
+                                     access_mode::read);
 
-        /////////////////////////
-        // FROM LAMMPS: sin_shift is always 0... so dropping all sin_shift terms!!!!
-        // Adding charmm dihedral functionality, sin_shift not always 0,
-        // cos_shift not always 1
-        /////////////////////////
-
-        Scalar sign = m_sign[dihedral_type];
-        Scalar phi_0 = m_phi_0[dihedral_type];
-        Scalar sin_phi_0 = fast::sin(phi_0);
-        Scalar cos_phi_0 = fast::cos(phi_0);
-        p = p * cos_phi_0 + dfab * sin_phi_0;
-        p = p * sign;
-        dfab = dfab * cos_phi_0 - ddfab * sin_phi_0;
-        dfab = dfab * sign;
-        dfab *= (Scalar)-multi;
-        p += Scalar(1.0);
-
-        if (multi == 0)
+    // for each of the dihedrals
+    const unsigned int size = (unsigned int)m_dihedral_data->getN();
+    auto compute_range = [&](unsigned int first,
+                             unsigned int last,
+                             Scalar4* force,
+                             Scalar* virial,
+                             size_t virial_pitch)
+    {
+        for (unsigned int i = first; i < last; i++)
             {
-            p = Scalar(1.0) + sign;
-            dfab = Scalar(0.0);
+            // lookup the tag of each of the particles participating in the dihedral
+            const ImproperData::members_t& dihedral = h_dihedrals.data[i];
+            assert(dihedral.tag[0] <= m_pdata->getMaximumTag());
+            assert(dihedral.tag[1] <= m_pdata->getMaximumTag());
+            assert(dihedral.tag[2] <= m_pdata->getMaximumTag());
+            assert(dihedral.tag[3] <= m_pdata->getMaximumTag());
+
+            // transform a, b, and c into indices into the particle data arrays
+            // MEM TRANSFER: 6 ints
+            unsigned int idx_a = h_dihedral_idx.data[i].idx[0];
+            unsigned int idx_b = h_dihedral_idx.data[i].idx[1];
+            unsigned int idx_c = h_dihedral_idx.data[i].idx[2];
+            unsigned int idx_d = h_dihedral_idx.data[i].idx[3];
+
+            // throw an error if this angle is incomplete
+            if (idx_a == NOT_LOCAL || idx_b == NOT_LOCAL || idx_c == NOT_LOCAL
+                || idx_d == NOT_LOCAL)
+                {
+                this->m_exec_conf->msg->error()
+                    << "dihedral.harmonic: dihedral " << dihedral.tag[0] << " " << dihedral.tag[1]
+                    << " " << dihedral.tag[2] << " " << dihedral.tag[3] << " incomplete." << endl
+                    << endl;
+                throw std::runtime_error("Error in dihedral calculation");
+                }
+
+            assert(idx_a < m_pdata->getN() + m_pdata->getNGhosts());
+            assert(idx_b < m_pdata->getN() + m_pdata->getNGhosts());
+            assert(idx_c < m_pdata->getN() + m_pdata->getNGhosts());
+            assert(idx_d < m_pdata->getN() + m_pdata->getNGhosts());
+
+            // calculate d\vec{r}
+            Scalar3 dab;
+            dab.x = h_pos.data[idx_a].x - h_pos.data[idx_b].x;
+            dab.y = h_pos.data[idx_a].y - h_pos.data[idx_b].y;
+            dab.z = h_pos.data[idx_a].z - h_pos.data[idx_b].z;
+
+            Scalar3 dcb;
+            dcb.x = h_pos.data[idx_c].x - h_pos.data[idx_b].x;
+            dcb.y = h_pos.data[idx_c].y - h_pos.data[idx_b].y;
+            dcb.z = h_pos.data[idx_c].z - h_pos.data[idx_b].z;
+
+            Scalar3 ddc;
+            ddc.x = h_pos.data[idx_d].x - h_pos.data[idx_c].x;
+            ddc.y = h_pos.data[idx_d].y - h_pos.data[idx_c].y;
+            ddc.z = h_pos.data[idx_d].z - h_pos.data[idx_c].z;
+
+            // apply periodic boundary conditions
+            dab = box.minImage(dab);
+            dcb = box.minImage(dcb);
+            ddc = box.minImage(ddc);
+
+            Scalar3 dcbm;
+            dcbm.x = -dcb.x;
+            dcbm.y = -dcb.y;
+            dcbm.z = -dcb.z;
+
+            dcbm = box.minImage(dcbm);
+
+            Scalar aax = dab.y * dcbm.z - dab.z * dcbm.y;
+            Scalar aay = dab.z * dcbm.x - dab.x * dcbm.z;
+            Scalar aaz = dab.x * dcbm.y - dab.y * dcbm.x;
+
+            Scalar bbx = ddc.y * dcbm.z - ddc.z * dcbm.y;
+            Scalar bby = ddc.z * dcbm.x - ddc.x * dcbm.z;
+            Scalar bbz = ddc.x * dcbm.y - ddc.y * dcbm.x;
+
+            Scalar raasq = aax * aax + aay * aay + aaz * aaz;
+            Scalar rbbsq = bbx * bbx + bby * bby + bbz * bbz;
+            Scalar rgsq = dcbm.x * dcbm.x + dcbm.y * dcbm.y + dcbm.z * dcbm.z;
+            Scalar rg = sqrt(rgsq);
+
+            Scalar rginv, raa2inv, rbb2inv;
+            rginv = raa2inv = rbb2inv = Scalar(0.0);
+            if (rg > Scalar(0.0))
+                rginv = Scalar(1.0) / rg;
+            if (raasq > Scalar(0.0))
+                raa2inv = Scalar(1.0) / raasq;
+            if (rbbsq > Scalar(0.0))
+                rbb2inv = Scalar(1.0) / rbbsq;
+            Scalar rabinv = sqrt(raa2inv * rbb2inv);
+
+            Scalar c_abcd = (aax * bbx + aay * bby + aaz * bbz) * rabinv;
+            Scalar s_abcd = rg * rabinv * (aax * ddc.x + aay * ddc.y + aaz * ddc.z);
+
+            if (c_abcd > 1.0)
+                c_abcd = 1.0;
+            if (c_abcd < -1.0)
+                c_abcd = -1.0;
+
+            unsigned int dihedral_type = h_typeval.data[i].type;
+            int multi = m_multi[dihedral_type];
+            Scalar p = Scalar(1.0);
+            Scalar dfab = Scalar(0.0);
+            Scalar ddfab = Scalar(0.0);
+
+            for (int j = 0; j < multi; j++)
+                {
+                ddfab = p * c_abcd - dfab * s_abcd;
+                dfab = p * s_abcd + dfab * c_abcd;
+                p = ddfab;
+                }
+
+            /////////////////////////
+            // FROM LAMMPS: sin_shift is always 0... so dropping all sin_shift terms!!!!
+            // Adding charmm dihedral functionality, sin_shift not always 0,
+            // cos_shift not always 1
+            /////////////////////////
+
+            Scalar sign = m_sign[dihedral_type];
+            Scalar phi_0 = m_phi_0[dihedral_type];
+            Scalar sin_phi_0 = fast::sin(phi_0);
+            Scalar cos_phi_0 = fast::cos(phi_0);
+            p = p * cos_phi_0 + dfab * sin_phi_0;
+            p = p * sign;
+            dfab = dfab * cos_phi_0 - ddfab * sin_phi_0;
+            dfab = dfab * sign;
+            dfab *= (Scalar)-multi;
+            p += Scalar(1.0);
+
+            if (multi == 0)
+                {
+                p = Scalar(1.0) + sign;
+                dfab = Scalar(0.0);
+                }
+
+            Scalar fg = dab.x * dcbm.x + dab.y * dcbm.y + dab.z * dcbm.z;
+            Scalar hg = ddc.x * dcbm.x + ddc.y * dcbm.y + ddc.z * dcbm.z;
+
+            Scalar fga = fg * raa2inv * rginv;
+            Scalar hgb = hg * rbb2inv * rginv;
+            Scalar gaa = -raa2inv * rg;
+            Scalar gbb = rbb2inv * rg;
+
+            Scalar dtfx = gaa * aax;
+            Scalar dtfy = gaa * aay;
+            Scalar dtfz = gaa * aaz;
+            Scalar dtgx = fga * aax - hgb * bbx;
+            Scalar dtgy = fga * aay - hgb * bby;
+            Scalar dtgz = fga * aaz - hgb * bbz;
+            Scalar dthx = gbb * bbx;
+            Scalar dthy = gbb * bby;
+            Scalar dthz = gbb * bbz;
+
+            //      Scalar df = -m_K[dihedral.type] * dfab;
+            // the 0.5 term is for 1/2K in the forces
+            Scalar df = -m_K[dihedral_type] * dfab * Scalar(0.500);
+
+            Scalar sx2 = df * dtgx;
+            Scalar sy2 = df * dtgy;
+            Scalar sz2 = df * dtgz;
+
+            Scalar ffax = df * dtfx;
+            Scalar ffay = df * dtfy;
+            Scalar ffaz = df * dtfz;
+
+            Scalar ffbx = sx2 - ffax;
+            Scalar ffby = sy2 - ffay;
+            Scalar ffbz = sz2 - ffaz;
+
+            Scalar ffdx = df * dthx;
+            Scalar ffdy = df * dthy;
+            Scalar ffdz = df * dthz;
+
+            Scalar ffcx = -sx2 - ffdx;
+            Scalar ffcy = -sy2 - ffdy;
+            Scalar ffcz = -sz2 - ffdz;
+
+            // Now, apply the force to each individual atom a,b,c,d
+            // and accumulate the energy/virial
+            // compute 1/4 of the energy, 1/4 for each atom in the dihedral
+            // Scalar dihedral_eng = p*m_K[dihedral.type]*Scalar(1.0/4.0);
+            Scalar dihedral_eng
+                = p * m_K[dihedral_type] * Scalar(0.125); // the .125 term is (1/2)K * 1/4
+
+            // compute 1/4 of the virial, 1/4 for each atom in the dihedral
+            // upper triangular version of virial tensor
+            Scalar dihedral_virial[6];
+            dihedral_virial[0] = (1. / 4.) * (dab.x * ffax + dcb.x * ffcx + (ddc.x + dcb.x) * ffdx);
+            dihedral_virial[1] = (1. / 4.) * (dab.y * ffax + dcb.y * ffcx + (ddc.y + dcb.y) * ffdx);
+            dihedral_virial[2] = (1. / 4.) * (dab.z * ffax + dcb.z * ffcx + (ddc.z + dcb.z) * ffdx);
+            dihedral_virial[3] = (1. / 4.) * (dab.y * ffay + dcb.y * ffcy + (ddc.y + dcb.y) * ffdy);
+            dihedral_virial[4] = (1. / 4.) * (dab.z * ffay + dcb.z * ffcy + (ddc.z + dcb.z) * ffdy);
+            dihedral_virial[5] = (1. / 4.) * (dab.z * ffaz + dcb.z * ffcz + (ddc.z + dcb.z) * ffdz);
+
+            force[idx_a].x += ffax;
+            force[idx_a].y += ffay;
+            force[idx_a].z += ffaz;
+            force[idx_a].w += dihedral_eng;
+            if (compute_virial)
+                for (int k = 0; k < 6; k++)
+                    virial[virial_pitch * k + idx_a] += dihedral_virial[k];
+
+            force[idx_b].x += ffbx;
+            force[idx_b].y += ffby;
+            force[idx_b].z += ffbz;
+            force[idx_b].w += dihedral_eng;
+            if (compute_virial)
+                for (int k = 0; k < 6; k++)
+                    virial[virial_pitch * k + idx_b] += dihedral_virial[k];
+
+            force[idx_c].x += ffcx;
+            force[idx_c].y += ffcy;
+            force[idx_c].z += ffcz;
+            force[idx_c].w += dihedral_eng;
+            if (compute_virial)
+                for (int k = 0; k < 6; k++)
+                    virial[virial_pitch * k + idx_c] += dihedral_virial[k];
+
+            force[idx_d].x += ffdx;
+            force[idx_d].y += ffdy;
+            force[idx_d].z += ffdz;
+            force[idx_d].w += dihedral_eng;
+            if (compute_virial)
+                for (int k = 0; k < 6; k++)
+                    virial[virial_pitch * k + idx_d] += dihedral_virial[k];
             }
-
-        Scalar fg = dab.x * dcbm.x + dab.y * dcbm.y + dab.z * dcbm.z;
-        Scalar hg = ddc.x * dcbm.x + ddc.y * dcbm.y + ddc.z * dcbm.z;
-
-        Scalar fga = fg * raa2inv * rginv;
-        Scalar hgb = hg * rbb2inv * rginv;
-        Scalar gaa = -raa2inv * rg;
-        Scalar gbb = rbb2inv * rg;
-
-        Scalar dtfx = gaa * aax;
-        Scalar dtfy = gaa * aay;
-        Scalar dtfz = gaa * aaz;
-        Scalar dtgx = fga * aax - hgb * bbx;
-        Scalar dtgy = fga * aay - hgb * bby;
-        Scalar dtgz = fga * aaz - hgb * bbz;
-        Scalar dthx = gbb * bbx;
-        Scalar dthy = gbb * bby;
-        Scalar dthz = gbb * bbz;
-
-        //      Scalar df = -m_K[dihedral.type] * dfab;
-        Scalar df
-            = -m_K[dihedral_type] * dfab * Scalar(0.500); // the 0.5 term is for 1/2K in the forces
-
-        Scalar sx2 = df * dtgx;
-        Scalar sy2 = df * dtgy;
-        Scalar sz2 = df * dtgz;
-
-        Scalar ffax = df * dtfx;
-        Scalar ffay = df * dtfy;
-        Scalar ffaz = df * dtfz;
-
-        Scalar ffbx = sx2 - ffax;
-        Scalar ffby = sy2 - ffay;
-        Scalar ffbz = sz2 - ffaz;
-
-        Scalar ffdx = df * dthx;
-        Scalar ffdy = df * dthy;
-        Scalar ffdz = df * dthz;
-
-        Scalar ffcx = -sx2 - ffdx;
-        Scalar ffcy = -sy2 - ffdy;
-        Scalar ffcz = -sz2 - ffdz;
-
-        // Now, apply the force to each individual atom a,b,c,d
-        // and accumulate the energy/virial
-        // compute 1/4 of the energy, 1/4 for each atom in the dihedral
-        // Scalar dihedral_eng = p*m_K[dihedral.type]*Scalar(1.0/4.0);
-        Scalar dihedral_eng
-            = p * m_K[dihedral_type] * Scalar(0.125); // the .125 term is (1/2)K * 1/4
-
-        // compute 1/4 of the virial, 1/4 for each atom in the dihedral
-        // upper triangular version of virial tensor
-        Scalar dihedral_virial[6];
-        dihedral_virial[0] = (1. / 4.) * (dab.x * ffax + dcb.x * ffcx + (ddc.x + dcb.x) * ffdx);
-        dihedral_virial[1] = (1. / 4.) * (dab.y * ffax + dcb.y * ffcx + (ddc.y + dcb.y) * ffdx);
-        dihedral_virial[2] = (1. / 4.) * (dab.z * ffax + dcb.z * ffcx + (ddc.z + dcb.z) * ffdx);
-        dihedral_virial[3] = (1. / 4.) * (dab.y * ffay + dcb.y * ffcy + (ddc.y + dcb.y) * ffdy);
-        dihedral_virial[4] = (1. / 4.) * (dab.z * ffay + dcb.z * ffcy + (ddc.z + dcb.z) * ffdy);
-        dihedral_virial[5] = (1. / 4.) * (dab.z * ffaz + dcb.z * ffcz + (ddc.z + dcb.z) * ffdz);
-
-        h_force.data[idx_a].x += ffax;
-        h_force.data[idx_a].y += ffay;
-        h_force.data[idx_a].z += ffaz;
-        h_force.data[idx_a].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-            h_virial.data[virial_pitch * k + idx_a] += dihedral_virial[k];
-
-        h_force.data[idx_b].x += ffbx;
-        h_force.data[idx_b].y += ffby;
-        h_force.data[idx_b].z += ffbz;
-        h_force.data[idx_b].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-            h_virial.data[virial_pitch * k + idx_b] += dihedral_virial[k];
-
-        h_force.data[idx_c].x += ffcx;
-        h_force.data[idx_c].y += ffcy;
-        h_force.data[idx_c].z += ffcz;
-        h_force.data[idx_c].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-            h_virial.data[virial_pitch * k + idx_c] += dihedral_virial[k];
-
-        h_force.data[idx_d].x += ffdx;
-        h_force.data[idx_d].y += ffdy;
-        h_force.data[idx_d].z += ffdz;
-        h_force.data[idx_d].w += dihedral_eng;
-        for (int k = 0; k < 6; k++)
-            h_virial.data[virial_pitch * k + idx_d] += dihedral_virial[k];
-        }
+    };
+
+    detail::computeBondedForces(m_exec_conf,
+                                size,
+                                m_pdata->getN() + m_pdata->getNGhosts(),
+                                compute_virial,
+                                h_force.data,
+                                h_virial.data,
+                                m_virial.getPitch(),
+                                compute_range);
     }
 
 namespace detail
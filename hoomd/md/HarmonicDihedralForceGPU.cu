@@ -35,7 +35,9 @@ namespace kernel
     \param dihedral_ABCD List of relative atom positions in the dihedrals
     \param pitch Pitch of 2D dihedral list
     \param n_dihedrals_list List of numbers of dihedrals per atom
+    \tparam compute_virial When false, the kernel does not write the virial
 */
+template<bool compute_virial>
 __global__ void gpu_compute_harmonic_dihedral_forces_kernel(Scalar4* d_force,
                                                             Scalar* d_virial,
                                                             const size_t virial_pitch,
@@ -298,13 +300,17 @@ __global__ void gpu_compute_harmonic_dihedral_forces_kernel(Scalar4* d_force,
 
     // now that the force calculation is complete, write out the result (MEM TRANSFER: 20 bytes)
     d_force[idx] = force_idx;
-    for (int k = 0; k < 6; k++)
-        d_virial[k * virial_pitch + idx] = virial_idx[k];
+    if (compute_virial)
+        {
+        for (int k = 0; k < 6; k++)
+            d_virial[k * virial_pitch + idx] = virial_idx[k];
+        }
     }
 
 /*! \param d_force Device memory to write computed forces
     \param d_virial Device memory to write computed virials
     \param virial_pitch pitch of 2D virial array
+    \param compute_virial True to compute the virial
     \param N number of particles
     \param d_pos particle positions on the GPU
     \param box Box dimensions (in GPU format) to use for periodic boundary conditions
@@ -326,6 +332,7 @@ __global__ void gpu_compute_harmonic_dihedral_forces_kernel(Scalar4* d_force,
 hipError_t gpu_compute_harmonic_dihedral_forces(Scalar4* d_force,
                                                 Scalar* d_virial,
                                                 const size_t virial_pitch,
+                                                bool compute_virial,
                                                 const unsigned int N,
                                                 const Scalar4* d_pos,
                                                 const BoxDim& box,
@@ -342,7 +349,9 @@ hipError_t gpu_compute_harmonic_dihedral_forces(Scalar4* d_force,
 
     unsigned int max_block_size;
     hipFuncAttributes attr;
-    hipFuncGetAttributes(&attr, (const void*)gpu_compute_harmonic_dihedral_forces_kernel);
+    auto func = compute_virial ? &gpu_compute_harmonic_dihedral_forces_kernel<true>
+                               : &gpu_compute_harmonic_dihedral_forces_kernel<false>;
+    hipFuncGetAttributes(&attr, (const void*)func);
     max_block_size = attr.maxThreadsPerBlock;
     if (max_block_size % warp_size)
         // handle non-sensical return values from hipFuncGetAttributes
@@ -355,7 +364,7 @@ hipError_t gpu_compute_harmonic_dihedral_forces(Scalar4* d_force,
     dim3 threads(run_block_size, 1, 1);
 
     // run the kernel
-    hipLaunchKernelGGL((gpu_compute_harmonic_dihedral_forces_kernel),
+    hipLaunchKernelGGL((func),
                        grid,
                        threads,
                        0,
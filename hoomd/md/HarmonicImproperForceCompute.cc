@@ -97,6 +97,9 @@ void HarmonicImproperForceCompute::computeForces(uint64_t timestep)
     ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
     size_t virial_pitch = m_virial.getPitch();
 
+    PDataFlags flags = m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor];
+
     // there are enough other checks on the input data: but it doesn't hurt to be safe
     assert(h_force.data);
     assert(h_virial.data);
@@ -257,8 +260,9 @@ void HarmonicImproperForceCompute::computeForces(uint64_t timestep)
             h_force.data[idx_a].y += ffay;
             h_force.data[idx_a].z += ffaz;
             h_force.data[idx_a].w += improper_eng;
-            for (int k = 0; k < 6; k++)
-                h_virial.data[k * virial_pitch + idx_a] += improper_virial[k];
+            if (compute_virial)
+                for (int k = 0; k < 6; k++)
+                    h_virial.data[k * virial_pitch + idx_a] += improper_virial[k];
             }
 
         if (idx_b < m_pdata->getN())
@@ -267,8 +271,9 @@ void HarmonicImproperForceCompute::computeForces(uint64_t timestep)
             h_force.data[idx_b].y += ffby;
             h_force.data[idx_b].z += ffbz;
             h_force.data[idx_b].w += improper_eng;
-            for (int k = 0; k < 6; k++)
-                h_virial.data[k * virial_pitch + idx_b] += improper_virial[k];
+            if (compute_virial)
+                for (int k = 0; k < 6; k++)
+                    h_virial.data[k * virial_pitch + idx_b] += improper_virial[k];
             }
 
         if (idx_c < m_pdata->getN())
@@ -277,8 +282,9 @@ void HarmonicImproperForceCompute::computeForces(uint64_t timestep)
             h_force.data[idx_c].y += ffcy;
             h_force.data[idx_c].z += ffcz;
             h_force.data[idx_c].w += improper_eng;
-            for (int k = 0; k < 6; k++)
-                h_virial.data[k * virial_pitch + idx_c] += improper_virial[k];
+            if (compute_virial)
+                for (int k = 0; k < 6; k++)
+                    h_virial.data[k * virial_pitch + idx_c] += improper_virial[k];
             }
 
         if (idx_d < m_pdata->getN())
@@ -287,8 +293,9 @@ void HarmonicImproperForceCompute::computeForces(uint64_t timestep)
             h_force.data[idx_d].y += ffdy;
             h_force.data[idx_d].z += ffdz;
             h_force.data[idx_d].w += improper_eng;
-            for (int k = 0; k < 6; k++)
-                h_virial.data[k * virial_pitch + idx_d] += improper_virial[k];
+            if (compute_virial)
+                for (int k = 0; k < 6; k++)
+                    h_virial.data[k * virial_pitch + idx_d] += improper_virial[k];
             }
         }
     }
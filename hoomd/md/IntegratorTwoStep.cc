@@ -17,7 +17,7 @@ namespace hoomd
 namespace md
     {
 IntegratorTwoStep::IntegratorTwoStep(std::shared_ptr<SystemDefinition> sysdef, Scalar deltaT)
-    : Integrator(sysdef, deltaT), m_prepared(false)
+    : Integrator(sysdef, deltaT), m_prepared(false), m_step_deltaT(deltaT)
     {
     m_exec_conf->msg->notice(5) << "Constructing IntegratorTwoStep" << endl;
 
@@ -55,13 +55,21 @@ void IntegratorTwoStep::update(uint64_t timestep)
     // ensure that prepRun() has been called
     assert(m_prepared);
 
+    // choose the step size from the velocities and the net force of the previous step
+    m_step_deltaT = m_deltaT;
+    if (m_max_displacement > Scalar(0.0))
+        {
+        m_step_deltaT = computeAdaptiveDeltaT();
+        setStepDeltaT(m_step_deltaT);
+        }
+
     // perform the first step of the integration on all groups
     for (auto& method : m_methods)
         {
         // deltaT should probably be passed as an argument, but that would require modifying many
         // files. Work around this by calling setDeltaT every timestep.
         method->setAnisotropic(m_integrate_rotational_dof);
-        method->setDeltaT(m_deltaT);
+        method->setDeltaT(m_step_deltaT);
         method->integrateStepOne(timestep);
         }
 
@@ -76,7 +84,8 @@ void IntegratorTwoStep::update(uint64_t timestep)
         // a) that particles have migrated to the correct domains
         // b) that forces are calculated correctly, if ghost atom positions are updated every time
         // step
-        m_comm->communicate(timestep + 1);
+        // c) that the ghost position update overlaps with force computations that support it
+        m_comm->communicate(timestep + 1, true);
 
         // Communicator uses a compute callback to trigger updateRigidBodies again and ensure that
         // all ghost constituent particle positions are set in accordance with any just communicated
@@ -112,6 +121,8 @@ void IntegratorTwoStep::update(uint64_t timestep)
         method->includeRATTLEForce(timestep + 1);
         }
 
+    m_time += m_step_deltaT;
+
     /* NOTE: For composite particles, it is assumed that positions and orientations are not updated
        in the second step.
 
@@ -122,6 +133,118 @@ void IntegratorTwoStep::update(uint64_t timestep)
      */
     }
 
+/*! The step size is the largest \f$ \Delta t \le \f$ dt for which no particle moves further than
+    the maximum displacement when it continues with its current velocity \f$ v \f$ and
+    acceleration \f$ a = F/m \f$. The bound \f$ v \Delta t + a \Delta t^2 / 2 \le d \f$ is
+    solved as \f$ \Delta t = 2 d / (v + \sqrt{v^2 + 2 a d}) \f$, which is finite for \f$ a = 0
+    \f$. The velocities and the net force are read on the host.
+
+    The neighbor list needs no adjustment: its distance check compares the particle displacements
+    since the last build with the buffer, so it remains valid for any step size. Choose a maximum
+    displacement well below half of the buffer to avoid rebuilding the list every step.
+*/
+Scalar IntegratorTwoStep::computeAdaptiveDeltaT()
+    {
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(),
+                                     access_location::host,
+                                     access_mode::read);
+
+    Scalar deltaT = m_deltaT;
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        {
+        Scalar mass = h_vel.data[i].w;
+        if (mass <= Scalar(0.0))
+            continue;
+
+        Scalar3 v = make_scalar3(h_vel.data[i].x, h_vel.data[i].y, h_vel.data[i].z);
+        Scalar3 f
+            = make_scalar3(h_net_force.data[i].x, h_net_force.data[i].y, h_net_force.data[i].z);
+        Scalar speed = fast::sqrt(dot(v, v));
+        Scalar accel = fast::sqrt(dot(f, f)) / mass;
+
+        Scalar denominator
+            = speed + fast::sqrt(speed * speed + Scalar(2.0) * accel * m_max_displacement);
+        if (denominator > Scalar(0.0))
+            deltaT = std::min(deltaT, Scalar(2.0) * m_max_displacement / denominator);
+        }
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &deltaT,
+                      1,
+                      MPI_HOOMD_SCALAR,
+                      MPI_MIN,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    return deltaT;
+    }
+
+/*! \param deltaT Step size of this step
+
+    Integrator::update() sets dt on the forces. This overrides it with the step size of this step
+    and leaves m_deltaT unchanged.
+*/
+void IntegratorTwoStep::setStepDeltaT(Scalar deltaT)
+    {
+    for (auto& force : m_forces)
+        {
+        force->setDeltaT(deltaT);
+        }
+
+    for (auto& force : m_slow_forces)
+        {
+        force->setDeltaT(deltaT);
+        }
+
+    for (auto& constraint_force : m_constraint_forces)
+        {
+        constraint_force->setDeltaT(deltaT);
+        }
+
+    if (m_rigid_bodies)
+        {
+        m_rigid_bodies->setDeltaT(deltaT);
+        }
+    }
+
+/*! \param max_displacement Maximum distance a particle may move in one step, or None
+ */
+void IntegratorTwoStep::setMaxDisplacementPython(pybind11::object max_displacement)
+    {
+    if (max_displacement.is_none())
+        {
+        m_max_displacement = 0;
+
+        // restore the fixed step size on the rigid bodies, Integrator::update() resets the forces
+        if (m_rigid_bodies)
+            {
+            m_rigid_bodies->setDeltaT(m_deltaT);
+            }
+        return;
+        }
+
+    Scalar value = max_displacement.cast<Scalar>();
+    if (value <= Scalar(0.0))
+        {
+        throw std::domain_error("max_displacement must be positive");
+        }
+    m_max_displacement = value;
+    }
+
+pybind11::object IntegratorTwoStep::getMaxDisplacementPython()
+    {
+    if (m_max_displacement > Scalar(0.0))
+        {
+        return pybind11::cast(m_max_displacement);
+        }
+    return pybind11::none();
+    }
+
 /*! \param deltaT new deltaT to set
     \post \a deltaT is also set on all contained integration methods
 */
@@ -429,7 +552,12 @@ void export_IntegratorTwoStep(pybind11::module& m)
         .def_property("half_step_hook",
                       &IntegratorTwoStep::getHalfStepHook,
                       &IntegratorTwoStep::setHalfStepHook)
-        .def("validate_groups", &IntegratorTwoStep::validateGroups);
+        .def("validate_groups", &IntegratorTwoStep::validateGroups)
+        .def_property("max_displacement",
+                      &IntegratorTwoStep::getMaxDisplacementPython,
+                      &IntegratorTwoStep::setMaxDisplacementPython)
+        .def_property_readonly("step_dt", &IntegratorTwoStep::getStepDeltaT)
+        .def_property("time", &IntegratorTwoStep::getTime, &IntegratorTwoStep::setTime);
     }
 
     } // end namespace detail
@@ -113,6 +113,30 @@ class PYBIND11_EXPORT IntegratorTwoStep : public Integrator
     /// Validate method groups.
     void validateGroups();
 
+    /// Set the maximum distance a particle may move in one step (None for a fixed step size)
+    void setMaxDisplacementPython(pybind11::object max_displacement);
+
+    /// Get the maximum distance a particle may move in one step
+    pybind11::object getMaxDisplacementPython();
+
+    /// Get the step size of the most recent step
+    Scalar getStepDeltaT()
+        {
+        return m_step_deltaT;
+        }
+
+    /// Get the simulation time elapsed in the steps taken by this integrator
+    double getTime()
+        {
+        return m_time;
+        }
+
+    /// Set the simulation time, e.g. when restoring a checkpoint
+    void setTime(double time)
+        {
+        m_time = time;
+        }
+
     protected:
     std::vector<std::shared_ptr<IntegrationMethodTwoStep>>
         m_methods; //!< List of all the integration methods
@@ -123,6 +147,21 @@ class PYBIND11_EXPORT IntegratorTwoStep : public Integrator
 
     /// True when orientation degrees of freedom should be integrated
     bool m_integrate_rotational_dof = false;
+
+    /// Maximum distance a particle may move in one step, 0 when the step size is fixed
+    Scalar m_max_displacement = 0;
+
+    /// Step size of the most recent step
+    Scalar m_step_deltaT;
+
+    /// Simulation time elapsed in the steps taken by this integrator
+    double m_time = 0;
+
+    /// Choose the step size that bounds the displacement of every particle
+    Scalar computeAdaptiveDeltaT();
+
+    /// Set the step size of this step on the forces and rigid bodies
+    void setStepDeltaT(Scalar deltaT);
     };
 
     } // end namespace md
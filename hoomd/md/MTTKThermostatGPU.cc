@@ -0,0 +1,116 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "MTTKThermostatGPU.h"
+
+namespace hoomd::md
+    {
+MTTKThermostatGPU::MTTKThermostatGPU(std::shared_ptr<Variant> T,
+                                     std::shared_ptr<ParticleGroup> group,
+                                     std::shared_ptr<ComputeThermo> thermo,
+                                     std::shared_ptr<SystemDefinition> sysdef,
+                                     Scalar tau)
+    : MTTKThermostat(T, group, thermo, sysdef, tau),
+      m_exec_conf(sysdef->getParticleData()->getExecConf())
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        throw std::runtime_error("Cannot create MTTKThermostatGPU on a CPU device.");
+        }
+
+    GlobalArray<kernel::mttk_state> device_state(1, m_exec_conf);
+    m_device_state.swap(device_state);
+    TAG_ALLOCATION(m_device_state);
+
+    GlobalArray<Scalar> rescale_factors(2, m_exec_conf);
+    m_rescale_factors.swap(rescale_factors);
+    TAG_ALLOCATION(m_rescale_factors);
+
+    syncStateToDevice();
+    }
+
+void MTTKThermostatGPU::advanceThermostat(uint64_t timestep, Scalar deltaT, bool aniso)
+    {
+    // compute the current thermodynamic properties, which remain on the device
+    m_thermo->compute(timestep);
+
+    ArrayHandle<Scalar> d_properties(m_thermo->getProperties(),
+                                     access_location::device,
+                                     access_mode::read);
+    ArrayHandle<kernel::mttk_state> d_state(m_device_state,
+                                            access_location::device,
+                                            access_mode::readwrite);
+
+    kernel::gpu_mttk_advance_thermostat(d_state.data,
+                                        d_properties.data,
+                                        m_T->operator()(timestep),
+                                        m_group->getTranslationalDOF(),
+                                        m_group->getRotationalDOF(),
+                                        m_tau,
+                                        deltaT,
+                                        aniso);
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+
+    m_host_state_stale = true;
+    }
+
+void MTTKThermostatGPU::computeRescalingFactors(Scalar deltaT)
+    {
+    ArrayHandle<Scalar> d_rescale_factors(m_rescale_factors,
+                                          access_location::device,
+                                          access_mode::overwrite);
+    ArrayHandle<kernel::mttk_state> d_state(m_device_state,
+                                            access_location::device,
+                                            access_mode::read);
+
+    kernel::gpu_mttk_rescaling_factors(d_rescale_factors.data, d_state.data, deltaT);
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+void MTTKThermostatGPU::syncStateToHost()
+    {
+    if (!m_host_state_stale)
+        return;
+
+    ArrayHandle<kernel::mttk_state> h_state(m_device_state,
+                                            access_location::host,
+                                            access_mode::read);
+    m_state.xi = h_state.data[0].xi;
+    m_state.eta = h_state.data[0].eta;
+    m_state.xi_rot = h_state.data[0].xi_rot;
+    m_state.eta_rot = h_state.data[0].eta_rot;
+    m_host_state_stale = false;
+    }
+
+void MTTKThermostatGPU::syncStateToDevice()
+    {
+    ArrayHandle<kernel::mttk_state> h_state(m_device_state,
+                                            access_location::host,
+                                            access_mode::overwrite);
+    h_state.data[0].xi = m_state.xi;
+    h_state.data[0].eta = m_state.eta;
+    h_state.data[0].xi_rot = m_state.xi_rot;
+    h_state.data[0].eta_rot = m_state.eta_rot;
+    m_host_state_stale = false;
+    }
+
+namespace detail
+    {
+void export_MTTKThermostatGPU(pybind11::module& m)
+    {
+    pybind11::class_<MTTKThermostatGPU, MTTKThermostat, std::shared_ptr<MTTKThermostatGPU>>(
+        m,
+        "MTTKThermostatGPU")
+        .def(pybind11::init<std::shared_ptr<Variant>,
+                            std::shared_ptr<ParticleGroup>,
+                            std::shared_ptr<ComputeThermo>,
+                            std::shared_ptr<SystemDefinition>,
+                            Scalar>());
+    }
+    } // end namespace detail
+
+    } // end namespace hoomd::md
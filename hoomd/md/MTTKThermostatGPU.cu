@@ -0,0 +1,144 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "ComputeThermoTypes.h"
+#include "MTTKThermostatGPU.cuh"
+#include "hip/hip_runtime.h"
+
+/*! \file MTTKThermostatGPU.cu
+    \brief Defines the GPU kernels used by MTTKThermostatGPU.
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Advance the MTTK thermostat by one step
+/*! \param d_state Thermostat state to update
+    \param d_properties Properties of the group reduced by ComputeThermoGPU
+    \param T Temperature set point
+    \param translational_dof Translational degrees of freedom of the group
+    \param rotational_dof Rotational degrees of freedom of the group
+    \param tau Thermostat time constant
+    \param deltaT Step size
+    \param aniso True when the rotational thermostat is advanced
+
+    Runs in a single thread. See MTTKThermostat::advanceThermostat() for the equations.
+*/
+__global__ void gpu_mttk_advance_thermostat_kernel(mttk_state* d_state,
+                                                   const Scalar* d_properties,
+                                                   Scalar T,
+                                                   Scalar translational_dof,
+                                                   Scalar rotational_dof,
+                                                   Scalar tau,
+                                                   Scalar deltaT,
+                                                   bool aniso)
+    {
+    if (blockIdx.x * blockDim.x + threadIdx.x != 0)
+        return;
+
+    mttk_state state = *d_state;
+
+    Scalar curr_T_trans = Scalar(0.0);
+    if (translational_dof > 0)
+        {
+        curr_T_trans = Scalar(2.0) / translational_dof
+                       * d_properties[thermo_index::translational_kinetic_energy];
+        }
+
+    Scalar xi_prime
+        = state.xi + Scalar(1.0 / 2.0) * deltaT / tau / tau * (curr_T_trans / T - Scalar(1.0));
+    state.xi = xi_prime + Scalar(1.0 / 2.0) * deltaT / tau / tau * (curr_T_trans / T - Scalar(1.0));
+    state.eta += xi_prime * deltaT;
+
+    if (aniso)
+        {
+        Scalar curr_ke_rot = d_properties[thermo_index::rotational_kinetic_energy];
+        Scalar curr_T_rot = Scalar(2.0) * curr_ke_rot / rotational_dof;
+
+        Scalar xi_prime_rot
+            = state.xi_rot
+              + Scalar(1.0 / 2.0) * deltaT / tau / tau * (curr_T_rot / T - Scalar(1.0));
+        state.xi_rot = xi_prime_rot
+                       + Scalar(1.0 / 2.0) * deltaT / tau / tau * (curr_T_rot / T - Scalar(1.0));
+        state.eta_rot += xi_prime_rot * deltaT;
+        }
+
+    *d_state = state;
+    }
+
+//! Compute the rescaling factors of the MTTK thermostat
+/*! \param d_rescale_factors Output translational and rotational rescaling factors
+    \param d_state Thermostat state
+    \param deltaT Step size
+*/
+__global__ void gpu_mttk_rescaling_factors_kernel(Scalar* d_rescale_factors,
+                                                  const mttk_state* d_state,
+                                                  Scalar deltaT)
+    {
+    if (blockIdx.x * blockDim.x + threadIdx.x != 0)
+        return;
+
+    d_rescale_factors[0] = exp(-Scalar(1.0 / 2.0) * d_state->xi * deltaT);
+    d_rescale_factors[1] = exp(-d_state->xi_rot * deltaT / Scalar(2.0));
+    }
+
+/*! \param d_state Thermostat state to update
+    \param d_properties Properties of the group reduced by ComputeThermoGPU
+    \param T Temperature set point
+    \param translational_dof Translational degrees of freedom of the group
+    \param rotational_dof Rotational degrees of freedom of the group
+    \param tau Thermostat time constant
+    \param deltaT Step size
+    \param aniso True when the rotational thermostat is advanced
+*/
+hipError_t gpu_mttk_advance_thermostat(mttk_state* d_state,
+                                       const Scalar* d_properties,
+                                       Scalar T,
+                                       Scalar translational_dof,
+                                       Scalar rotational_dof,
+                                       Scalar tau,
+                                       Scalar deltaT,
+                                       bool aniso)
+    {
+    hipLaunchKernelGGL((gpu_mttk_advance_thermostat_kernel),
+                       dim3(1),
+                       dim3(1),
+                       0,
+                       0,
+                       d_state,
+                       d_properties,
+                       T,
+                       translational_dof,
+                       rotational_dof,
+                       tau,
+                       deltaT,
+                       aniso);
+
+    return hipSuccess;
+    }
+
+/*! \param d_rescale_factors Output translational and rotational rescaling factors
+    \param d_state Thermostat state
+    \param deltaT Step size
+*/
+hipError_t
+gpu_mttk_rescaling_factors(Scalar* d_rescale_factors, const mttk_state* d_state, Scalar deltaT)
+    {
+    hipLaunchKernelGGL((gpu_mttk_rescaling_factors_kernel),
+                       dim3(1),
+                       dim3(1),
+                       0,
+                       0,
+                       d_rescale_factors,
+                       d_state,
+                       deltaT);
+
+    return hipSuccess;
+    }
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
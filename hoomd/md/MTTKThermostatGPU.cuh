@@ -0,0 +1,46 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "hoomd/HOOMDMath.h"
+
+#ifndef __MTTK_THERMOSTAT_GPU_CUH__
+#define __MTTK_THERMOSTAT_GPU_CUH__
+
+/*! \file MTTKThermostatGPU.cuh
+    \brief Declares the GPU kernel drivers used by MTTKThermostatGPU.
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Internal degrees of freedom of the MTTK thermostat that MTTKThermostatGPU keeps in device memory
+struct mttk_state
+    {
+    Scalar xi;      //!< Translational thermostat momentum
+    Scalar eta;     //!< Translational thermostat position
+    Scalar xi_rot;  //!< Rotational thermostat momentum
+    Scalar eta_rot; //!< Rotational thermostat position
+    };
+
+//! Advance the MTTK thermostat by one step using the properties reduced by ComputeThermoGPU
+hipError_t gpu_mttk_advance_thermostat(mttk_state* d_state,
+                                       const Scalar* d_properties,
+                                       Scalar T,
+                                       Scalar translational_dof,
+                                       Scalar rotational_dof,
+                                       Scalar tau,
+                                       Scalar deltaT,
+                                       bool aniso);
+
+//! Compute the translational and rotational rescaling factors from the thermostat state
+hipError_t
+gpu_mttk_rescaling_factors(Scalar* d_rescale_factors, const mttk_state* d_state, Scalar deltaT);
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __MTTK_THERMOSTAT_GPU_CUH__
@@ -0,0 +1,79 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#ifndef HOOMD_MTTK_THERMOSTAT_GPU_H
+#define HOOMD_MTTK_THERMOSTAT_GPU_H
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "MTTKThermostatGPU.cuh"
+#include "Thermostat.h"
+#include "hoomd/GlobalArray.h"
+
+namespace hoomd::md
+    {
+/** Implement the MTTK thermostat on the GPU.
+
+    MTTKThermostatGPU keeps the thermostat degrees of freedom in device memory. advanceThermostat()
+    reads the kinetic energies that ComputeThermoGPU reduces on the device and updates the state in
+    a single thread kernel, so the integration step does not wait for a device to host copy.
+    computeRescalingFactors() writes the factors to a device array that TwoStepConstantVolumeGPU
+    and TwoStepConstantPressureGPU pass to their kernels.
+
+    The host copy in m_state is refreshed only when a host method (a logger, the Python properties,
+    or an integration method that calls getRescalingFactorsOne()) reads it.
+*/
+class PYBIND11_EXPORT MTTKThermostatGPU : public MTTKThermostat
+    {
+    public:
+    /** Construct the thermostat.
+
+        @param T Temperature set point over time.
+        @param group Group of particles this thermostat is applied to.
+        @param thermo Use to compute the thermodynamic properties of the group.
+        @param sysdef Used to access the simulation seed and MPI communicator.
+        @param tau Thermostat time constant.
+    */
+    MTTKThermostatGPU(std::shared_ptr<Variant> T,
+                      std::shared_ptr<ParticleGroup> group,
+                      std::shared_ptr<ComputeThermo> thermo,
+                      std::shared_ptr<SystemDefinition> sysdef,
+                      Scalar tau);
+
+    void advanceThermostat(uint64_t timestep, Scalar deltaT, bool aniso = true) override;
+
+    /** Compute the rescaling factors from the current thermostat state on the device.
+
+        @param deltaT Simulation step size.
+    */
+    void computeRescalingFactors(Scalar deltaT);
+
+    /// Get the device array of [translation rescale factor, rotation rescale factor].
+    const GlobalArray<Scalar>& getRescalingFactorsArray() const
+        {
+        return m_rescale_factors;
+        }
+
+    protected:
+    /// The execution configuration.
+    std::shared_ptr<const ExecutionConfiguration> m_exec_conf;
+
+    /// The thermostat internal degrees of freedom.
+    GlobalArray<kernel::mttk_state> m_device_state;
+
+    /// Rescaling factors written by computeRescalingFactors().
+    GlobalArray<Scalar> m_rescale_factors;
+
+    /// True when the device state has changed since the last copy to m_state.
+    bool m_host_state_stale = false;
+
+    void syncStateToHost() override;
+
+    void syncStateToDevice() override;
+    };
+
+    } // namespace hoomd::md
+
+#endif // HOOMD_MTTK_THERMOSTAT_GPU_H
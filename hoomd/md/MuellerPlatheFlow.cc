@@ -5,6 +5,8 @@
 #include "hoomd/HOOMDMPI.h"
 #include "hoomd/HOOMDMath.h"
 
+#include <algorithm>
+
 using namespace std;
 
 //! \file MuellerPlatheFlow.cc Implementation of CPU version of MuellerPlatheFlow.
@@ -16,6 +18,21 @@ namespace md
 const unsigned int INVALID_TAG = UINT_MAX;
 const Scalar INVALID_VEL = FLT_MAX; // should be ok, even for double.
 
+namespace
+    {
+//! Orders the max slab candidates so that the largest momentum is on top of the heap
+bool lessMomentum(const Scalar3& a, const Scalar3& b)
+    {
+    return a.x < b.x;
+    }
+
+//! Orders the min slab candidates so that the smallest momentum is on top of the heap
+bool greaterMomentum(const Scalar3& a, const Scalar3& b)
+    {
+    return a.x > b.x;
+    }
+    } // end anonymous namespace
+
 MuellerPlatheFlow::MuellerPlatheFlow(std::shared_ptr<SystemDefinition> sysdef,
                                      std::shared_ptr<Trigger> trigger,
                                      std::shared_ptr<ParticleGroup> group,
@@ -76,6 +93,9 @@ void MuellerPlatheFlow::update(uint64_t timestep)
     if (m_needs_orthorhombic_check)
         this->verifyOrthorhombicBox();
 
+    // the velocities changed since the last call
+    m_candidates_valid = false;
+
     const BoxDim& box = m_pdata->getGlobalBox();
     double area = 1.; // Init to shut up compiler warning
     switch (m_slab_direction)
@@ -241,8 +261,28 @@ void MuellerPlatheFlow::updateDomainDecomposition(void)
 #endif // ENABLE_MPI
     }
 
+/*! The swaps of one update() call only change the velocities of the exchanged particles, so the
+    slabs are scanned once and the candidates are kept in heaps between the swaps.
+*/
 void MuellerPlatheFlow::searchMinMaxVelocity(void)
     {
+    if (!m_candidates_valid)
+        {
+        buildCandidates();
+        m_candidates_valid = true;
+        }
+
+    if (!m_max_candidates.empty())
+        m_last_max_vel = m_max_candidates.front();
+    if (!m_min_candidates.empty())
+        m_last_min_vel = m_min_candidates.front();
+    }
+
+void MuellerPlatheFlow::buildCandidates(void)
+    {
+    m_max_candidates.clear();
+    m_min_candidates.clear();
+
     const unsigned int group_size = m_group->getNumMembers();
     if (group_size == 0)
         return;
@@ -293,21 +333,17 @@ void MuellerPlatheFlow::searchMinMaxVelocity(void)
                     }
                 const Scalar mass = h_vel.data[j].w;
                 vel *= mass; // Use momentum instead of velocity
-                if (index == this->getMaxSlab() && m_last_max_vel.x < vel && this->hasMaxSlab())
-                    {
-                    m_last_max_vel.x = vel;
-                    m_last_max_vel.y = mass;
-                    m_last_max_vel.z = __int_as_scalar(h_tag.data[j]);
-                    }
-                if (index == this->getMinSlab() && m_last_min_vel.x > vel && this->hasMinSlab())
-                    {
-                    m_last_min_vel.x = vel;
-                    m_last_max_vel.y = mass;
-                    m_last_min_vel.z = __int_as_scalar(h_tag.data[j]);
-                    }
+                const Scalar3 candidate = make_scalar3(vel, mass, __int_as_scalar(h_tag.data[j]));
+                if (index == this->getMaxSlab() && this->hasMaxSlab())
+                    m_max_candidates.push_back(candidate);
+                if (index == this->getMinSlab() && this->hasMinSlab())
+                    m_min_candidates.push_back(candidate);
                 }
             }
         }
+
+    std::make_heap(m_max_candidates.begin(), m_max_candidates.end(), lessMomentum);
+    std::make_heap(m_min_candidates.begin(), m_min_candidates.end(), greaterMomentum);
     }
 
 void MuellerPlatheFlow::updateMinMaxVelocity(void)
@@ -358,6 +394,22 @@ void MuellerPlatheFlow::updateMinMaxVelocity(void)
                 }
             }
         }
+
+    // reinsert the exchanged particles of this rank with their new momentum
+    if (!m_max_candidates.empty()
+        && static_cast<unsigned int>(__scalar_as_int(m_max_candidates.front().z)) == max_tag)
+        {
+        std::pop_heap(m_max_candidates.begin(), m_max_candidates.end(), lessMomentum);
+        m_max_candidates.back().x = m_last_min_vel.x;
+        std::push_heap(m_max_candidates.begin(), m_max_candidates.end(), lessMomentum);
+        }
+    if (!m_min_candidates.empty()
+        && static_cast<unsigned int>(__scalar_as_int(m_min_candidates.front().z)) == min_tag)
+        {
+        std::pop_heap(m_min_candidates.begin(), m_min_candidates.end(), greaterMomentum);
+        m_min_candidates.back().x = m_last_max_vel.x;
+        std::push_heap(m_min_candidates.begin(), m_min_candidates.end(), greaterMomentum);
+        }
     }
 
 void MuellerPlatheFlow::verifyOrthorhombicBox(void)
@@ -12,6 +12,7 @@
 
 #include <cfloat>
 #include <memory>
+#include <vector>
 
 namespace hoomd
     {
@@ -185,6 +186,19 @@ class PYBIND11_EXPORT MuellerPlatheFlow : public Updater
 
     Scalar3 m_last_max_vel;
 
+    //! Candidates of the max slab on this rank, as a heap with the largest momentum on top (CPU)
+    //!
+    //! Same layout as m_last_max_vel. The slabs are scanned once per update() call, and each swap
+    //! only reinserts the exchanged particle with its new momentum.
+    std::vector<Scalar3> m_max_candidates;
+    //! Candidates of the min slab on this rank, as a heap with the smallest momentum on top (CPU)
+    std::vector<Scalar3> m_min_candidates;
+    //! True when the candidate heaps hold the current velocities
+    bool m_candidates_valid = false;
+
+    //! Fill the candidate heaps with the group members in the min and max slabs (CPU)
+    void buildCandidates(void);
+
     //! Direction perpendicular to the slabs.
     enum flow_enum::Direction m_slab_direction;
     //! Direction of the induced flow.
@@ -0,0 +1,189 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file MultiTauCorrelator.cc
+    \brief Contains code for the MultiTauLevels and MultiTauCorrelator classes
+*/
+
+#include "MultiTauCorrelator.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param points Number of values per level
+    \param averaging Number of values that produce one value of the next level
+    \param max_levels Maximum number of levels
+*/
+MultiTauLevels::MultiTauLevels(unsigned int points,
+                               unsigned int averaging,
+                               unsigned int max_levels)
+    : m_points(points), m_averaging(averaging), m_max_levels(max_levels)
+    {
+    if (averaging < 2)
+        {
+        throw std::runtime_error("averaging must be at least 2.");
+        }
+    if (points < averaging || points % averaging != 0)
+        {
+        throw std::runtime_error("points must be a positive multiple of averaging.");
+        }
+    if (max_levels == 0 || max_levels > MAX_LEVELS)
+        {
+        throw std::runtime_error("max_levels must be in the range [1, "
+                                 + std::to_string(MAX_LEVELS) + "].");
+        }
+
+    reset();
+    }
+
+void MultiTauLevels::reset()
+    {
+    m_count.clear();
+    m_samples.assign(getNumSums(), 0);
+    }
+
+/*! \returns The number of levels that receive a value from the new sample
+
+    Level 0 receives every sample. Level l + 1 receives a value when the number of values received
+    by level l becomes a multiple of the averaging factor. The correlator must store the new values
+    of the returned number of levels at getPosition() and then evaluate the lags of these levels.
+*/
+unsigned int MultiTauLevels::push()
+    {
+    unsigned int n_levels = 0;
+    for (unsigned int level = 0; level < m_max_levels; level++)
+        {
+        if (level == m_count.size())
+            {
+            m_count.push_back(0);
+            }
+
+        m_count[level]++;
+        n_levels++;
+        if (m_count[level] % m_averaging != 0)
+            {
+            break;
+            }
+        }
+    return n_levels;
+    }
+
+/*! \param n_levels Number of levels that received a value, as returned by push()
+    \param weight Number of samples of each evaluated lag, e.g. the number of particles
+*/
+void MultiTauLevels::addSamples(unsigned int n_levels, unsigned long long weight)
+    {
+    for (unsigned int level = 0; level < n_levels; level++)
+        {
+        const unsigned int n_filled = getNumFilled(level);
+        for (unsigned int j = getFirstLag(level); j < n_filled; j++)
+            {
+            m_samples[level * m_points + j] += weight;
+            }
+        }
+    }
+
+/*! \param sums Correlation sums of each lag, getNumSums() elements
+    \param lags Set to the lags with samples in units of the sample period, in increasing order
+    \param values Set to the average correlation of each lag in \a lags
+*/
+void MultiTauLevels::getCorrelation(const double* sums,
+                                    std::vector<uint64_t>& lags,
+                                    std::vector<double>& values) const
+    {
+    lags.clear();
+    values.clear();
+
+    uint64_t spacing = 1;
+    for (unsigned int level = 0; level < m_max_levels; level++)
+        {
+        for (unsigned int j = getFirstLag(level); j < m_points; j++)
+            {
+            const unsigned int k = level * m_points + j;
+            if (m_samples[k] > 0)
+                {
+                lags.push_back(j * spacing);
+                values.push_back(sums[k] / double(m_samples[k]));
+                }
+            }
+        spacing *= m_averaging;
+        }
+    }
+
+/*! \param dimension Number of components of the signal
+    \param points Number of values per level
+    \param averaging Number of values that produce one value of the next level
+    \param max_levels Maximum number of levels
+*/
+MultiTauCorrelator::MultiTauCorrelator(unsigned int dimension,
+                                       unsigned int points,
+                                       unsigned int averaging,
+                                       unsigned int max_levels)
+    : m_dimension(dimension), m_levels(points, averaging, max_levels)
+    {
+    reset();
+    }
+
+void MultiTauCorrelator::reset()
+    {
+    m_levels.reset();
+    m_values.clear();
+    m_accum.clear();
+    m_sums.assign(m_levels.getNumSums(), 0.0);
+    }
+
+/*! \param x The signal, \a dimension components
+ */
+void MultiTauCorrelator::push(const std::vector<double>& x)
+    {
+    const unsigned int points = m_levels.getPoints();
+    const unsigned int n_levels = m_levels.push();
+    while (m_values.size() < m_levels.getNumLevels())
+        {
+        m_values.push_back(std::vector<double>(points * m_dimension, 0.0));
+        m_accum.push_back(std::vector<double>(m_dimension, 0.0));
+        }
+
+    std::vector<double> value(x);
+    for (unsigned int level = 0; level < n_levels; level++)
+        {
+        // the value of a higher level is the average of the values that entered the level below
+        if (level > 0)
+            {
+            for (unsigned int a = 0; a < m_dimension; a++)
+                {
+                value[a] = m_accum[level - 1][a] / double(m_levels.getAveraging());
+                m_accum[level - 1][a] = 0.0;
+                }
+            }
+
+        const unsigned int position = m_levels.getPosition(level);
+        std::vector<double>& values = m_values[level];
+        for (unsigned int a = 0; a < m_dimension; a++)
+            {
+            values[position * m_dimension + a] = value[a];
+            m_accum[level][a] += value[a];
+            }
+
+        const unsigned int n_filled = m_levels.getNumFilled(level);
+        for (unsigned int j = m_levels.getFirstLag(level); j < n_filled; j++)
+            {
+            const unsigned int old = (position + points - j) % points;
+            double product = 0.0;
+            for (unsigned int a = 0; a < m_dimension; a++)
+                {
+                product += value[a] * values[old * m_dimension + a];
+                }
+            m_sums[level * points + j] += product / double(m_dimension);
+            }
+        }
+
+    m_levels.addSamples(n_levels, 1);
+    }
+
+    } // end namespace md
+    } // end namespace hoomd
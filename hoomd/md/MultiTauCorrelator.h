@@ -0,0 +1,167 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file MultiTauCorrelator.h
+    \brief Declares the bookkeeping of multi-tau correlators
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "hoomd/HOOMDMath.h"
+
+#include <vector>
+
+#ifndef __MULTI_TAU_CORRELATOR_H__
+#define __MULTI_TAU_CORRELATOR_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Tracks the levels of a multi-tau correlator
+/*! A multi-tau correlator stores the recent samples of a signal in a hierarchy of levels. Level 0
+    holds the last \a points samples. Every \a averaging values that enter level l produce one value
+    of level l + 1, so level l holds values spaced by averaging^l samples. The correlation at the
+    lag j averaging^l is evaluated at level l, for j in [0, points) at level 0 and for
+    j in [points / averaging, points) at the higher levels. The lags grow geometrically, and the
+    storage grows with the logarithm of the longest lag.
+
+    MultiTauLevels holds the state that is common to all elements of a correlator: the number of
+    values received per level and the number of samples per lag. The correlators keep the values
+    themselves in ring buffers of \a points entries per level. The sums and samples of the lag
+    j averaging^l are stored at the index l * points + j.
+
+    Levels start when they receive their first value and stop growing at \a max_levels.
+*/
+class MultiTauLevels
+    {
+    public:
+    //! Largest supported number of levels
+    static const unsigned int MAX_LEVELS = 32;
+
+    //! Constructor
+    MultiTauLevels(unsigned int points, unsigned int averaging, unsigned int max_levels);
+
+    //! Register a new sample
+    unsigned int push();
+
+    //! Add the samples of the lags evaluated by the last push()
+    void addSamples(unsigned int n_levels, unsigned long long weight);
+
+    //! Convert the correlation sums to averages
+    void getCorrelation(const double* sums,
+                        std::vector<uint64_t>& lags,
+                        std::vector<double>& values) const;
+
+    //! Clear the levels and the samples
+    void reset();
+
+    //! Get the number of started levels
+    unsigned int getNumLevels() const
+        {
+        return (unsigned int)m_count.size();
+        }
+
+    //! Get the position of the newest value of a level in its ring buffer
+    unsigned int getPosition(unsigned int level) const
+        {
+        return (unsigned int)((m_count[level] - 1) % m_points);
+        }
+
+    //! Get the number of values in the ring buffer of a level
+    unsigned int getNumFilled(unsigned int level) const
+        {
+        return m_count[level] < m_points ? (unsigned int)m_count[level] : m_points;
+        }
+
+    //! Get the smallest lag index that is evaluated at a level
+    unsigned int getFirstLag(unsigned int level) const
+        {
+        return level == 0 ? 0 : m_points / m_averaging;
+        }
+
+    //! Get the number of sums of the correlator
+    unsigned int getNumSums() const
+        {
+        return m_max_levels * m_points;
+        }
+
+    //! Get the number of samples received
+    uint64_t getNumSamples() const
+        {
+        return m_count.empty() ? 0 : m_count[0];
+        }
+
+    //! Get the number of values per level
+    unsigned int getPoints() const
+        {
+        return m_points;
+        }
+
+    //! Get the number of values averaged into one value of the next level
+    unsigned int getAveraging() const
+        {
+        return m_averaging;
+        }
+
+    //! Get the maximum number of levels
+    unsigned int getMaxLevels() const
+        {
+        return m_max_levels;
+        }
+
+    protected:
+    unsigned int m_points;                     //!< Number of values per level
+    unsigned int m_averaging;                  //!< Values per value of the next level
+    unsigned int m_max_levels;                 //!< Maximum number of levels
+    std::vector<uint64_t> m_count;             //!< Number of values received by each level
+    std::vector<unsigned long long> m_samples; //!< Number of samples of each lag
+    };
+
+//! Multi-tau correlator of a global vector signal
+/*! MultiTauCorrelator accumulates the autocorrelation
+    \f[ C(\tau) = \frac{1}{d} \sum_{a=1}^{d} \langle x_a(t) x_a(t + \tau) \rangle \f]
+    of a signal with \a d components on the host. The values of the higher levels are the
+    averages of \a averaging values of the level below.
+*/
+class MultiTauCorrelator
+    {
+    public:
+    //! Constructor
+    MultiTauCorrelator(unsigned int dimension,
+                       unsigned int points,
+                       unsigned int averaging,
+                       unsigned int max_levels);
+
+    //! Add a sample of the signal
+    void push(const std::vector<double>& x);
+
+    //! Get the lags and the correlation of the lags that have samples
+    void getCorrelation(std::vector<uint64_t>& lags, std::vector<double>& values) const
+        {
+        m_levels.getCorrelation(m_sums.data(), lags, values);
+        }
+
+    //! Clear the correlator
+    void reset();
+
+    //! Get the level bookkeeping
+    const MultiTauLevels& getLevels() const
+        {
+        return m_levels;
+        }
+
+    protected:
+    unsigned int m_dimension;                  //!< Number of components of the signal
+    MultiTauLevels m_levels;                   //!< Level bookkeeping
+    std::vector<std::vector<double>> m_values; //!< Ring buffer of each level
+    std::vector<std::vector<double>> m_accum;  //!< Sum of the values entering each level
+    std::vector<double> m_sums;                //!< Correlation sums of each lag
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
@@ -7,7 +7,9 @@
 
 #include "NeighborList.h"
 #include "hoomd/BondedGroupData.h"
+#include "hoomd/ParallelLoop.h"
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 
@@ -377,7 +379,11 @@ void NeighborList::compute(uint64_t timestep)
 
     // skip if we shouldn't compute this step
     if (!shouldCompute(timestep) && !m_force_update)
+        {
+        if (m_image_shifts_active)
+            updateImagePositions();
         return;
+        }
 
     // when the number of particles or bonds in the system changes, rebuild the exclusion list
     if (m_n_particles_changed || m_topology_changed)
@@ -405,35 +411,199 @@ void NeighborList::compute(uint64_t timestep)
     // check if the list needs to be updated and update it
     if (needsUpdating(timestep))
         {
+#ifdef ENABLE_MPI
+        // the build reads the ghost positions
+        if (m_comm)
+            m_comm->finishUpdateGhosts(timestep);
+#endif
+
+        ScopedProfile profile(m_sysdef->getProfiler(), getProfileName());
+
         // check simulation box size is OK
         checkBoxSize();
 
+        int64_t build_start = m_build_clock.getTime();
+
+        // try to update only the neighbors of the particles that moved
+        bool partial = m_partial_update_pending && buildNlistPartial(timestep);
+        m_partial_update_pending = false;
+        if (partial && checkConditions())
+            {
+            // the reallocated list needs a full build
+            buildHeadList();
+            resetConditions();
+            partial = false;
+            }
+
         // rebuild the list until there is no overflow
-        bool overflowed = false;
-        do
+        if (!partial)
             {
-            buildNlist(timestep);
+            m_image_shifts_active = imageShiftsSupported();
 
-            overflowed = checkConditions();
-            // if we overflowed, need to reallocate memory and reset the conditions
-            if (overflowed)
+            bool overflowed = false;
+            do
                 {
-                // always rebuild the head list after an overflow
-                buildHeadList();
+                buildNlist(timestep);
 
-                // zero out the conditions for the next build
-                resetConditions();
-                }
-            } while (overflowed);
+                overflowed = checkConditions();
+                // if we overflowed, need to reallocate memory and reset the conditions
+                if (overflowed)
+                    {
+                    // always rebuild the head list after an overflow
+                    buildHeadList();
 
-        if (m_exclusions_set)
+                    // zero out the conditions for the next build
+                    resetConditions();
+                    }
+                } while (overflowed);
+            }
+
+        // compressed builds and builds that skip excluded pairs filter the exclusions themselves,
+        // partial updates do not
+        if (m_exclusions_set && !m_compressed && (partial || !m_builds_exclusions))
             filterNlist();
 
-        setLastUpdatedPos();
+#ifdef ENABLE_MPI
+        if (m_comm && !m_exec_conf->isCUDAEnabled())
+            updateBoundaryParticles();
+#endif
+
+        m_build_time += m_build_clock.getTime() - build_start;
+
+        if (partial)
+            {
+            // the displacements remain relative to the last full build
+            m_partial_updates += 1;
+            }
+        else
+            {
+            setLastUpdatedPos();
+            m_moved_particles.clear();
+            m_moved.assign(m_pdata->getN(), 0);
+
+            if (m_image_shifts_active)
+                resetImagePositions();
+            }
         m_has_been_updated_once = true;
         }
+
+    if (m_image_shifts_active)
+        updateImagePositions();
+    }
+
+/*! \returns True when the list is uncompressed and built on the CPU in a simulation without domain
+    decomposition, so that it has no ghost particles
+*/
+bool NeighborList::imageShiftsSupported() const
+    {
+    if (!m_image_shifts || !m_builds_image_shifts || m_compressed || m_exec_conf->isCUDAEnabled())
+        return false;
+
+#ifdef ENABLE_MPI
+    if (m_comm)
+        return false;
+#endif
+
+    return true;
     }
 
+void NeighborList::resetImagePositions()
+    {
+    const unsigned int N = m_pdata->getN();
+    if (m_image_ref.getNumElements() < N)
+        {
+        GlobalArray<int3> image_ref(m_pdata->getMaxN(), m_exec_conf);
+        m_image_ref.swap(image_ref);
+        TAG_ALLOCATION(m_image_ref);
+
+        GlobalArray<Scalar4> image_pos(m_pdata->getMaxN(), m_exec_conf);
+        m_image_pos.swap(image_pos);
+        TAG_ALLOCATION(m_image_pos);
+        }
+
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image_ref(m_image_ref, access_location::host, access_mode::overwrite);
+    std::copy(h_image.data, h_image.data + N, h_image_ref.data);
+    }
+
+/*! The integrators wrap the particles back into the box when they cross a boundary. The image
+    positions undo the wraps since the last full build, so that the stored image of each neighbor
+    remains valid until the next build.
+*/
+void NeighborList::updateImagePositions()
+    {
+    const BoxDim& box = m_pdata->getGlobalBox();
+    for (int c = -1; c <= 1; c++)
+        {
+        for (int b = -1; b <= 1; b++)
+            {
+            for (int a = -1; a <= 1; a++)
+                {
+                m_image_shift[(a + 1) + 3 * (b + 1) + 9 * (c + 1)]
+                    = box.shift(make_scalar3(0, 0, 0), make_int3(a, b, c));
+                }
+            }
+        }
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image_ref(m_image_ref, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_image_pos(m_image_pos, access_location::host, access_mode::overwrite);
+
+    auto unwrap = [&](unsigned int first, unsigned int last)
+    {
+        for (unsigned int i = first; i < last; i++)
+            {
+            const Scalar4 postype = h_pos.data[i];
+            const int3 image = h_image.data[i];
+            const int3 image_ref = h_image_ref.data[i];
+            const Scalar3 pos = box.shift(make_scalar3(postype.x, postype.y, postype.z),
+                                          make_int3(image.x - image_ref.x,
+                                                    image.y - image_ref.y,
+                                                    image.z - image_ref.z));
+            h_image_pos.data[i] = make_scalar4(pos.x, pos.y, pos.z, postype.w);
+            }
+    };
+    hoomd::detail::parallel_loop(*m_exec_conf, m_pdata->getN(), unwrap);
+    }
+
+#ifdef ENABLE_MPI
+/*! A local particle is on the boundary when any of its neighbors is a ghost particle. The ghost
+    indices remain valid until the next particle migration, which always triggers a rebuild.
+*/
+void NeighborList::updateBoundaryParticles()
+    {
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::read);
+    ArrayHandle<size_t> h_head_list(m_head_list, access_location::host, access_mode::read);
+
+    const unsigned int N = m_pdata->getN();
+    m_interior_particles.clear();
+    m_boundary_particles.clear();
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        size_t offset = h_head_list.data[i];
+        unsigned int j = 0;
+        bool boundary = false;
+        for (unsigned int k = 0; k < h_n_neigh.data[i]; k++)
+            {
+            j = detail::nextNeighbor(h_nlist.data, m_compressed, offset, j);
+            if (j >= N)
+                {
+                boundary = true;
+                break;
+                }
+            }
+
+        if (boundary)
+            m_boundary_particles.push_back(i);
+        else
+            m_interior_particles.push_back(i);
+        }
+    }
+#endif
+
 /*! \param r_buff New buffer radius to set
     \note Changing the buffer radius does NOT immediately update the neighborlist.
             The new buffer will take effect when compute is called for the next timestep.
@@ -1238,10 +1408,26 @@ bool NeighborList::distanceCheck(uint64_t timestep)
     Scalar lambda_min = (lambda.x < lambda.y) ? lambda.x : lambda.y;
     lambda_min = (lambda_min < lambda.z) ? lambda_min : (Scalar)lambda.z;
 
+    // incremental updates are valid only in a fixed box, they track the particles that moved and
+    // leave the decision to rebuild to the end of the loop
+    const unsigned int N = m_pdata->getN();
+    bool partial = m_partial_update_fraction > Scalar(0.0) && lambda.x == Scalar(1.0)
+                   && lambda.y == Scalar(1.0) && lambda.z == Scalar(1.0);
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        partial = false;
+#endif
+    if (m_moved.size() != N)
+        {
+        m_moved_particles.clear();
+        m_moved.assign(N, 0);
+        }
+
     ArrayHandle<Scalar4> h_last_pos(m_last_pos, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_rcut_max(m_rcut_max, access_location::host, access_mode::read);
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    m_rebuild_trigger_type = UINT_MAX;
+    for (unsigned int i = 0; i < N; i++)
         {
         const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
 
@@ -1263,11 +1449,31 @@ bool NeighborList::distanceCheck(uint64_t timestep)
 
         if (dot(dx, dx) >= maxsq)
             {
-            result = true;
-            break;
+            if (m_rebuild_trigger_type == UINT_MAX)
+                m_rebuild_trigger_type = type_i;
+
+            if (!partial)
+                {
+                result = true;
+                break;
+                }
+
+            // particles remain flagged until the next full build
+            if (!m_moved[i])
+                {
+                m_moved[i] = 1;
+                m_moved_particles.push_back(i);
+                }
             }
         }
 
+    if (partial && !m_moved_particles.empty())
+        {
+        result = true;
+        m_partial_update_pending
+            = Scalar(m_moved_particles.size()) <= m_partial_update_fraction * Scalar(N);
+        }
+
 #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
@@ -1312,6 +1518,10 @@ void NeighborList::setLastUpdatedPos()
 
 bool NeighborList::shouldCheckDistance(uint64_t timestep)
     {
+    // the rows of the moved particles are valid only on the step they were built
+    if (!m_moved_particles.empty())
+        return !m_force_update;
+
     return !m_force_update && !(timestep < (m_last_updated_tstep + m_rebuild_check_delay));
     }
 
@@ -1384,6 +1594,14 @@ bool NeighborList::needsUpdating(uint64_t timestep)
         else
             {
             result = distanceCheck(timestep);
+
+            // count the build for the type of the particle that triggered it on this rank
+            if (result && m_rebuild_trigger_type != UINT_MAX)
+                {
+                if (m_rebuild_trigger_types.size() < m_pdata->getNTypes())
+                    m_rebuild_trigger_types.resize(m_pdata->getNTypes(), 0);
+                m_rebuild_trigger_types[m_rebuild_trigger_type]++;
+                }
             }
 
         if (result)
@@ -1420,6 +1638,9 @@ bool NeighborList::needsUpdating(uint64_t timestep)
 void NeighborList::resetStats()
     {
     m_updates = m_forced_updates = m_dangerous_updates = 0;
+    m_partial_updates = 0;
+    m_build_time = 0;
+    m_rebuild_trigger_types.assign(m_pdata->getNTypes(), 0);
 
     for (unsigned int i = 0; i < m_update_periods.size(); i++)
         m_update_periods[i] = 0;
@@ -1496,6 +1717,10 @@ void NeighborList::filterNlist()
                                             access_mode::read);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::readwrite);
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned char> h_nlist_image(m_nlist_image,
+                                             access_location::host,
+                                             access_mode::readwrite);
+    unsigned char* nlist_image = m_image_shifts_active ? h_nlist_image.data : nullptr;
 
     // for each particle's neighbor list
     for (unsigned int idx = 0; idx < m_pdata->getN(); idx++)
@@ -1526,6 +1751,8 @@ void NeighborList::filterNlist()
             if (!excluded)
                 {
                 h_nlist.data[myHead + new_n_neigh] = cur_neigh;
+                if (nlist_image)
+                    nlist_image[myHead + new_n_neigh] = nlist_image[myHead + cur_neigh_idx];
                 new_n_neigh++;
                 }
             }
@@ -1561,21 +1788,28 @@ void NeighborList::buildHeadList()
             }
         }
 
-    resizeNlist(headAddress);
+    // the compressed format stores two 16-bit units per element
+    resizeNlist(m_compressed ? (headAddress + 1) / 2 : headAddress);
     }
 
 /*!
  * \param size the requested number of elements in the neighbor list
  *
  * Increases the size of the neighbor list memory using amortized resizing (growth factor: 9/8)
- * only when needed.
+ * only when needed. When the particle data has a shrink fraction and the requested size is below
+ * that fraction of the allocated memory, the memory is reduced to the requested size grown by the
+ * same factor.
  */
 void NeighborList::resizeNlist(size_t size)
     {
     if (size > m_nlist.getNumElements())
         {
-        m_exec_conf->msg->notice(6)
-            << "nlist: (Re-)allocating neighbor list, new size " << size << " uints " << endl;
+        m_exec_conf->msg->notice(6,
+                                 [size](std::ostream& out)
+                                 {
+                                     out << "nlist: (Re-)allocating neighbor list, new size "
+                                         << size << " uints " << endl;
+                                 });
 
         size_t alloc_size = m_nlist.getNumElements() ? m_nlist.getNumElements() : 1;
 
@@ -1589,6 +1823,51 @@ void NeighborList::resizeNlist(size_t size)
 
         m_nlist.resize(alloc_size);
         }
+    else if ((Scalar)std::max(size, (size_t)1)
+             < m_pdata->getShrinkFraction() * (Scalar)m_nlist.getNumElements())
+        {
+        size_t alloc_size = ((size_t)(((float)std::max(size, (size_t)1)) * 1.125f)) + 1;
+
+        // round up to nearest multiple of 4
+        alloc_size = (alloc_size > 4) ? (alloc_size + 3) & ~3 : 4;
+
+        m_exec_conf->msg->notice(6,
+                                 [alloc_size](std::ostream& out)
+                                 {
+                                     out << "nlist: Shrinking neighbor list, new size "
+                                         << alloc_size << " uints " << endl;
+                                 });
+
+        m_nlist.resize(alloc_size);
+        }
+
+    // the image of each entry is rewritten in every full build
+    if (m_image_shifts && m_nlist_image.getNumElements() != m_nlist.getNumElements())
+        {
+        GlobalArray<unsigned char> nlist_image(m_nlist.getNumElements(), m_exec_conf);
+        m_nlist_image.swap(nlist_image);
+        TAG_ALLOCATION(m_nlist_image);
+        }
+    }
+
+/*! \param other Neighbor list to exchange the arrays with
+
+    The arrays read by the consumers of the neighbor list are swapped in O(1) and so are the
+    exclusion index arrays that the GPU neighbor list builds read back. The exclusion tag arrays
+    and all build state remain with their owner.
+*/
+void NeighborList::swapOutput(NeighborList& other)
+    {
+    m_nlist.swap(other.m_nlist);
+    m_n_neigh.swap(other.m_n_neigh);
+    m_head_list.swap(other.m_head_list);
+    m_n_ex_idx.swap(other.m_n_ex_idx);
+    m_ex_list_idx.swap(other.m_ex_list_idx);
+    std::swap(m_ex_list_indexer, other.m_ex_list_indexer);
+#ifdef ENABLE_MPI
+    m_interior_particles.swap(other.m_interior_particles);
+    m_boundary_particles.swap(other.m_boundary_particles);
+#endif
     }
 
 /*!
@@ -1728,6 +2007,119 @@ void NeighborList::updateMemoryMapping()
     }
 #endif
 
+/*! \param timestep Current time step
+
+    \returns A dictionary with the mean and the maximum number of stored neighbors per particle, the
+    fraction of the stored pairs that are within r_cut (the list efficiency), and the fraction of
+    the allocated neighbor list storage that is unused, all over all ranks.
+
+    The separations use the current positions with the minimum image convention, so the efficiency
+    decreases as the particles move after a build. In half storage mode, each pair is stored once.
+    The metrics are cached until the time step or the number of builds changes.
+*/
+pybind11::dict NeighborList::getQualityMetrics(uint64_t timestep)
+    {
+    compute(timestep);
+
+    if (m_quality.timestep != timestep || m_quality.num_updates != getNumUpdates())
+        {
+        ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::read);
+        ArrayHandle<size_t> h_head_list(m_head_list, access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar> h_r_cut(m_r_cut, access_location::host, access_mode::read);
+
+        const BoxDim& box = m_pdata->getBox();
+        const unsigned int N = m_pdata->getN();
+
+        // number of particles, stored pairs, pairs within r_cut, used and allocated storage
+        uint64_t sums[5] = {N, 0, 0, 0, m_nlist.getNumElements() * (m_compressed ? 2 : 1)};
+        unsigned int max_neighbors = 0;
+        for (unsigned int i = 0; i < N; i++)
+            {
+            const Scalar3 pos_i = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
+            const unsigned int size = h_n_neigh.data[i];
+            sums[1] += size;
+            max_neighbors = std::max(max_neighbors, size);
+
+            size_t offset = h_head_list.data[i];
+            unsigned int j = 0;
+            for (unsigned int k = 0; k < size; k++)
+                {
+                j = detail::nextNeighbor(h_nlist.data, m_compressed, offset, j);
+                const Scalar3 pos_j
+                    = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                const Scalar3 dx = box.minImage(pos_i - pos_j);
+                const Scalar r_cut
+                    = h_r_cut.data[m_typpair_idx(type_i, __scalar_as_int(h_pos.data[j].w))];
+                if (dot(dx, dx) < r_cut * r_cut)
+                    sums[2]++;
+                }
+            sums[3] += offset - h_head_list.data[i];
+            }
+
+#ifdef ENABLE_MPI
+        if (m_sysdef->isDomainDecomposed())
+            {
+            MPI_Allreduce(MPI_IN_PLACE,
+                          sums,
+                          5,
+                          MPI_UINT64_T,
+                          MPI_SUM,
+                          m_exec_conf->getMPICommunicator());
+            MPI_Allreduce(MPI_IN_PLACE,
+                          &max_neighbors,
+                          1,
+                          MPI_UNSIGNED,
+                          MPI_MAX,
+                          m_exec_conf->getMPICommunicator());
+            }
+#endif
+
+        m_quality.timestep = timestep;
+        m_quality.num_updates = getNumUpdates();
+        m_quality.mean_neighbors = sums[0] > 0 ? double(sums[1]) / double(sums[0]) : 0.0;
+        m_quality.max_neighbors = max_neighbors;
+        m_quality.efficiency = sums[1] > 0 ? double(sums[2]) / double(sums[1]) : 1.0;
+        m_quality.unused_storage = sums[4] > 0 ? 1.0 - double(sums[3]) / double(sums[4]) : 0.0;
+        }
+
+    pybind11::dict result;
+    result["mean_neighbors"] = m_quality.mean_neighbors;
+    result["max_neighbors"] = m_quality.max_neighbors;
+    result["efficiency"] = m_quality.efficiency;
+    result["unused_storage"] = m_quality.unused_storage;
+    return result;
+    }
+
+/*! \returns The number of builds since the last call to resetStats that a distance check
+    triggered, by the type of the first local particle found to move beyond half the buffer, summed
+    over all ranks.
+
+    With domain decomposition, every rank that finds such a particle counts the build.
+*/
+std::vector<uint64_t> NeighborList::getRebuildTriggerTypes()
+    {
+    std::vector<uint64_t> result(m_rebuild_trigger_types);
+    result.resize(m_pdata->getNTypes(), 0);
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      result.data(),
+                      (int)result.size(),
+                      MPI_UINT64_T,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+    return result;
+    }
+
 pybind11::array_t<uint32_t> NeighborList::getLocalPairListPython(uint64_t timestep)
     {
     compute(timestep);
@@ -1735,7 +2127,7 @@ pybind11::array_t<uint32_t> NeighborList::getLocalPairListPython(uint64_t timest
     bool third_law = getStorageMode() == NeighborList::half;
 
     ArrayHandle<unsigned int> h_n_neigh(getNNeighArray(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_nlist(getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(getNListStorage(), access_location::host, access_mode::read);
     ArrayHandle<size_t> h_head_list(getHeadList(), access_location::host, access_mode::read);
 
     auto* pair_list = new std::vector<vec2<uint32_t>>();
@@ -1760,11 +2152,12 @@ pybind11::array_t<uint32_t> NeighborList::getLocalPairListPython(uint64_t timest
 
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         {
-        const size_t my_head = h_head_list.data[i];
+        size_t offset = h_head_list.data[i];
         const unsigned int size = h_n_neigh.data[i];
+        unsigned int j = 0;
         for (unsigned int k = 0; k < size; k++)
             {
-            const unsigned int j = h_nlist.data[my_head + k];
+            j = detail::nextNeighbor(h_nlist.data, m_compressed, offset, j);
             // if j is not a ghost, only accept it if i < j
             if (!third_law && j < m_pdata->getN() && i > j)
                 continue;
@@ -1795,7 +2188,7 @@ pybind11::object NeighborList::getPairListPython(uint64_t timestep)
 #endif
 
     ArrayHandle<unsigned int> h_n_neigh(getNNeighArray(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_nlist(getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(getNListStorage(), access_location::host, access_mode::read);
     ArrayHandle<size_t> h_head_list(getHeadList(), access_location::host, access_mode::read);
 
     ArrayHandle<unsigned int> h_tags(m_pdata->getTags(), access_location::host, access_mode::read);
@@ -1814,11 +2207,12 @@ pybind11::object NeighborList::getPairListPython(uint64_t timestep)
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         {
         unsigned int tag_i = h_tags.data[i];
-        const size_t my_head = h_head_list.data[i];
+        size_t offset = h_head_list.data[i];
         const unsigned int size = h_n_neigh.data[i];
+        unsigned int j = 0;
         for (unsigned int k = 0; k < size; k++)
             {
-            const unsigned int j = h_nlist.data[my_head + k];
+            j = detail::nextNeighbor(h_nlist.data, m_compressed, offset, j);
             const unsigned int tag_j = h_tags.data[j];
             if ((!third_law || j >= m_pdata->getN()) && tag_i > tag_j)
                 continue;
@@ -2008,6 +2402,20 @@ void export_NeighborList(pybind11::module& m)
         .def("getNumUpdates", &NeighborList::getNumUpdates)
         .def("getNumExclusions", &NeighborList::getNumExclusions)
         .def_property_readonly("num_builds", &NeighborList::getNumUpdates)
+        .def_property_readonly("build_time", &NeighborList::getBuildTime)
+        .def_property("partial_update_fraction",
+                      &NeighborList::getPartialUpdateFraction,
+                      &NeighborList::setPartialUpdateFraction)
+        .def_property_readonly("num_partial_builds", &NeighborList::getNumPartialUpdates)
+        .def("getQualityMetrics", &NeighborList::getQualityMetrics)
+        .def_property_readonly("rebuild_trigger_types", &NeighborList::getRebuildTriggerTypes)
+        .def_property("compressed", &NeighborList::isCompressed, &NeighborList::setCompressed)
+        .def_property("sort_neighbors",
+                      &NeighborList::getSortNeighbors,
+                      &NeighborList::setSortNeighbors)
+        .def_property("image_shifts",
+                      &NeighborList::getImageShifts,
+                      &NeighborList::setImageShifts)
         .def("getLocalPairList", &NeighborList::getLocalPairListPython)
         .def("getPairList", &NeighborList::getPairListPython)
         .def("setRCut", &NeighborList::setRCutPython)
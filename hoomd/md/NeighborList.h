@@ -1,6 +1,7 @@
 // Copyright (c) 2009-2024 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+#include "hoomd/ClockSource.h"
 #include "hoomd/Compute.h"
 #include "hoomd/GPUFlags.h"
 #include "hoomd/GPUVector.h"
@@ -10,8 +11,10 @@
 #include "hoomd/PythonLocalDataAccess.h"
 
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
+#include <climits>
 #include <memory>
 #include <set>
+#include <stdexcept>
 #include <vector>
 
 /*! \file NeighborList.h
@@ -31,10 +34,80 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 namespace hoomd
     {
 namespace md
     {
+namespace detail
+    {
+/// Read the next neighbor from a neighbor list row
+/*! \param nlist Host pointer to the neighbor list storage
+    \param compressed True when the list is stored in the compressed format
+    \param offset Position in the row, advanced past the neighbor read
+    \param prev Previously read neighbor of the row, 0 for the first neighbor
+    \returns The index of the neighbor
+*/
+inline unsigned int
+nextNeighbor(const unsigned int* nlist, bool compressed, size_t& offset, unsigned int prev)
+    {
+    if (!compressed)
+        return nlist[offset++];
+
+    const uint16_t* units = reinterpret_cast<const uint16_t*>(nlist);
+    unsigned int delta = units[offset++];
+    if (delta & 0x8000)
+        delta = ((delta & 0x7fff) << 16) | units[offset++];
+    return prev + delta;
+    }
+
+/// Write a sorted neighbor list row in the compressed format
+/*! \param neigh Neighbor indices in ascending order
+    \param n Number of neighbors
+    \param nlist Host pointer to the neighbor list storage
+    \param head Position of the row in 16-bit units
+    \param capacity Number of 16-bit units available in the row
+    \returns The number of 16-bit units needed for the row, only the first \a capacity are written
+*/
+inline unsigned int compressNeighbors(const unsigned int* neigh,
+                                      unsigned int n,
+                                      unsigned int* nlist,
+                                      size_t head,
+                                      unsigned int capacity)
+    {
+    uint16_t* units = reinterpret_cast<uint16_t*>(nlist) + head;
+    unsigned int n_units = 0;
+    unsigned int prev = 0;
+    for (unsigned int k = 0; k < n; k++)
+        {
+        const unsigned int delta = neigh[k] - prev;
+        prev = neigh[k];
+
+        if (delta < 0x8000)
+            {
+            if (n_units < capacity)
+                units[n_units] = uint16_t(delta);
+            n_units++;
+            }
+        else
+            {
+            if (n_units + 1 < capacity)
+                {
+                units[n_units] = uint16_t(0x8000 | (delta >> 16));
+                units[n_units + 1] = uint16_t(delta & 0xffff);
+                }
+            n_units += 2;
+            }
+        }
+    return n_units;
+    }
+    } // end namespace detail
+
 //! Computes a Neighborlist from the particles
 /*! \b Overview:
 
@@ -69,6 +142,29 @@ namespace md
     \a jf includes flags in the highest bits. The format and use of these flags are yet to be
    determined.
 
+    <b>Compressed storage:</b>
+
+    Neighbor lists that support it may store the rows in a compressed format (isCompressed()).
+   Each row is then sorted and stored as a sequence of 16-bit units: the first neighbor index
+   followed by the differences between consecutive neighbors. Values below 2^15 take one unit,
+   larger values take two units with the highest bit of the first unit set. After a particle sort,
+   most differences fit in a single unit, which halves the memory used by the list. The head list
+   and Nmax count 16-bit units in this format. Consumers read the rows with detail::nextNeighbor(),
+   which handles both formats. getNListArray() throws when the list is compressed so that
+   consumers that do not support the format fail loudly.
+
+    <b>Image shifts:</b>
+
+    In simulations on a single rank, neighbor lists that support it may store the periodic image
+   of each neighbor (setImageShifts()). The image of entry k of the list is in entry k of
+   getNListImageArray(), encoded as (a+1) + 3(b+1) + 9(c+1) for the translation by a, b, and c
+   lattice vectors. Particles are wrapped into the box between builds, so the list also provides
+   the positions unwrapped since the last full build in getImagePositions(). The separation of
+   particle i and neighbor j is then q_i - q_j - getImageShiftVectors()[image] without the minimum
+   image convention. hasImageShifts() is true when consumers may read this data. Compressed
+   lists, partial updates, GPU builds, and domain decomposed simulations do not use image shifts.
+   Subclasses that store the images set m_builds_image_shifts.
+
     \b Filtering:
 
     By default, a neighbor list includes all particles within a single cutoff distance r_cut.
@@ -103,7 +199,9 @@ namespace md
    indices whenever a particle sort occurs (updateExListIdx()). If any exclusions are set,
    filterNlist() is called after buildNlist(). filterNlist() loops through the neighbor list and
    removes any particles that are excluded. This allows an arbitrary number of exclusions to be
-   processed without slowing the performance of the buildNlist() step itself.
+   processed without slowing the performance of the buildNlist() step itself. Subclasses that skip
+   the excluded pairs while they build the rows set m_builds_exclusions, and compute() calls
+   filterNlist() only after partial updates.
 
     <b>Overflow handling:</b>
     For easy support of derived GPU classes to implement overflow detection the overflow condition
@@ -148,7 +246,7 @@ class PYBIND11_EXPORT NeighborList : public Compute
     Consumers should call notifyRCutMatrixChange() when they any element of of their matrix.
     They should call removeRCutMatrix() when they no longer need to use the neighbor list.
     */
-    void addRCutMatrix(const std::shared_ptr<GlobalArray<Scalar>>& r_cut_matrix)
+    virtual void addRCutMatrix(const std::shared_ptr<GlobalArray<Scalar>>& r_cut_matrix)
         {
         if (r_cut_matrix->getNumElements() != m_r_cut.getNumElements())
             {
@@ -182,7 +280,7 @@ class PYBIND11_EXPORT NeighborList : public Compute
     Remove a r_cut matrix from the neighbor list. The given matrix will no longer be included
     in the min & max r_cuts when computing the neighbor list.
     */
-    void removeRCutMatrix(const std::shared_ptr<GlobalArray<Scalar>>& r_cut_matrix)
+    virtual void removeRCutMatrix(const std::shared_ptr<GlobalArray<Scalar>>& r_cut_matrix)
         {
         auto p = std::find(m_consumer_r_cut.begin(), m_consumer_r_cut.end(), r_cut_matrix);
         if (p == m_consumer_r_cut.end())
@@ -200,7 +298,7 @@ class PYBIND11_EXPORT NeighborList : public Compute
        a sufficient distance to require a neighbor list update. \param dist_check Set to false to
        enforce nlist builds exactly \a every steps
     */
-    void setRebuildCheckDelay(uint64_t every)
+    virtual void setRebuildCheckDelay(uint64_t every)
         {
         m_rebuild_check_delay = every;
         forceUpdate();
@@ -211,7 +309,7 @@ class PYBIND11_EXPORT NeighborList : public Compute
         return m_rebuild_check_delay;
         }
 
-    void setDistCheck(bool dist_check)
+    virtual void setDistCheck(bool dist_check)
         {
         m_dist_check = dist_check;
         }
@@ -221,6 +319,30 @@ class PYBIND11_EXPORT NeighborList : public Compute
         return m_dist_check;
         }
 
+    /// Set the maximum fraction of particles that may be updated incrementally
+    /*! \param fraction Maximum fraction of the local particles that may move more than half the
+       buffer distance before a full rebuild is necessary. Set to 0 to disable incremental updates.
+
+        When the fraction is not exceeded, only the neighbors of the particles that moved are
+        rebuilt. Incremental updates are only performed by neighbor lists that implement
+        buildNlistPartial() and only in simulations without domain decomposition.
+    */
+    void setPartialUpdateFraction(Scalar fraction)
+        {
+        if (fraction < Scalar(0.0) || fraction > Scalar(1.0))
+            {
+            throw std::domain_error("partial_update_fraction must be in the range [0, 1].");
+            }
+        m_partial_update_fraction = fraction;
+        forceUpdate();
+        }
+
+    /// Get the maximum fraction of particles that may be updated incrementally
+    Scalar getPartialUpdateFraction()
+        {
+        return m_partial_update_fraction;
+        }
+
     //! Set the storage mode
     /*! \param mode Storage mode to set
         - half only stores neighbors where i < j
@@ -229,7 +351,7 @@ class PYBIND11_EXPORT NeighborList : public Compute
         The neighborlist is not immediately updated to reflect this change. It will take effect
         when compute is called for the next timestep.
     */
-    void setStorageMode(storageMode mode)
+    virtual void setStorageMode(storageMode mode)
         {
         m_storage_mode = mode;
         forceUpdate();
@@ -287,7 +409,13 @@ class PYBIND11_EXPORT NeighborList : public Compute
     virtual void resetStats();
 
     //! Gets the shortest rebuild period this nlist has experienced since a call to resetStats
-    unsigned int getSmallestRebuild();
+    virtual unsigned int getSmallestRebuild();
+
+    //! Get the mean and maximum neighbors per particle, the list efficiency, and the unused storage
+    pybind11::dict getQualityMetrics(uint64_t timestep);
+
+    /// Get the number of distance check builds triggered by a particle of each type
+    std::vector<uint64_t> getRebuildTriggerTypes();
 
     // @}
     //! \name Get data
@@ -302,15 +430,120 @@ class PYBIND11_EXPORT NeighborList : public Compute
     //! Get the neighbor list
     const GlobalArray<unsigned int>& getNListArray() const
         {
+        if (m_compressed)
+            {
+            throw std::runtime_error("This force does not support compressed neighbor lists.");
+            }
         return m_nlist;
         }
 
+    /// Get the neighbor list storage in either format, read it with detail::nextNeighbor()
+    const GlobalArray<unsigned int>& getNListStorage() const
+        {
+        return m_nlist;
+        }
+
+    /// Test if the neighbor list is stored in the compressed format
+    bool isCompressed() const
+        {
+        return m_compressed;
+        }
+
+    /// Set the compressed storage format
+    /*! \param compressed True to store the neighbor list in the compressed format
+
+        The base class supports only the uncompressed format.
+    */
+    virtual void setCompressed(bool compressed)
+        {
+        if (compressed)
+            {
+            throw std::runtime_error("This neighbor list does not support compressed storage.");
+            }
+        }
+
+    /// Set whether the full build sorts each row by particle index
+    /*! \param sort_neighbors True to sort the rows
+
+        Sorted rows improve the locality of the pair loops. Builds that do not support sorting
+        ignore the setting.
+    */
+    void setSortNeighbors(bool sort_neighbors)
+        {
+        m_sort_neighbors = sort_neighbors;
+        forceUpdate();
+        }
+
+    /// Get whether the full build sorts each row by particle index
+    bool getSortNeighbors() const
+        {
+        return m_sort_neighbors;
+        }
+
+    /// Set whether the list stores the periodic image of each neighbor
+    /*! \param image_shifts True to store the periodic images
+
+        Builds that can not store the periodic images ignore this setting.
+    */
+    void setImageShifts(bool image_shifts)
+        {
+        m_image_shifts = image_shifts;
+        forceUpdate();
+        }
+
+    /// Get whether the list stores the periodic image of each neighbor
+    bool getImageShifts() const
+        {
+        return m_image_shifts;
+        }
+
+    /// Test if consumers may read the periodic images of the neighbors
+    bool hasImageShifts() const
+        {
+        return m_image_shifts_active;
+        }
+
+    /// Get the periodic image of each entry of the neighbor list
+    const GlobalArray<unsigned char>& getNListImageArray() const
+        {
+        return m_nlist_image;
+        }
+
+    /// Get the particle positions unwrapped since the last full build
+    const GlobalArray<Scalar4>& getImagePositions() const
+        {
+        return m_image_pos;
+        }
+
+    /// Get the translation of each periodic image in the current box
+    const Scalar3* getImageShiftVectors() const
+        {
+        return m_image_shift;
+        }
+
     //! Get the head list
     const GlobalArray<size_t>& getHeadList() const
         {
         return m_head_list;
         }
 
+#ifdef ENABLE_MPI
+    /// Get the indices of the local particles that have no ghost neighbors
+    /*! Only valid in domain decomposed simulations on the CPU. Forces on these particles may be
+        computed while the ghost update is in progress.
+    */
+    const std::vector<unsigned int>& getInteriorParticles() const
+        {
+        return m_interior_particles;
+        }
+
+    /// Get the indices of the local particles that have at least one ghost neighbor
+    const std::vector<unsigned int>& getBoundaryParticles() const
+        {
+        return m_boundary_particles;
+        }
+#endif
+
     //! Get the number of exclusions array
     const GlobalArray<unsigned int>& getNExArray()
         {
@@ -332,7 +565,7 @@ class PYBIND11_EXPORT NeighborList : public Compute
         return m_ex_list_indexer;
         }
 
-    void setExclusions(pybind11::list exclusions);
+    virtual void setExclusions(pybind11::list exclusions);
 
     void setSingleExclusion(std::string exclusion);
 
@@ -402,7 +635,7 @@ class PYBIND11_EXPORT NeighborList : public Compute
     void compute(uint64_t timestep);
 
     //! Forces a full update of the list on the next call to compute()
-    void forceUpdate()
+    virtual void forceUpdate()
         {
         m_force_update = true;
         }
@@ -413,6 +646,26 @@ class PYBIND11_EXPORT NeighborList : public Compute
         return m_updates + m_forced_updates;
         }
 
+    /// Get the number of builds that happened on the first step checked after the last build
+    /*! Particles may have moved more than half the buffer before a dangerous build.
+     */
+    virtual uint64_t getNumDangerousUpdates()
+        {
+        return m_dangerous_updates;
+        }
+
+    /// Get the number of updates that rebuilt only the neighbors of the moved particles
+    uint64_t getNumPartialUpdates()
+        {
+        return m_partial_updates;
+        }
+
+    /// Get the total wall clock time spent in buildNlist since the last call to resetStats [s]
+    virtual double getBuildTime()
+        {
+        return double(m_build_time) / 1e9;
+        }
+
 #ifdef ENABLE_MPI
     //! Returns true if the particle migration criterion is fulfilled
     /*! \param timestep The current timestep
@@ -485,6 +738,29 @@ class PYBIND11_EXPORT NeighborList : public Compute
     bool m_filter_body;         //!< Set to true if particles in the same body are to be filtered
     storageMode m_storage_mode; //!< The storage mode
 
+    /// True when the rows are stored in the compressed format
+    bool m_compressed = false;
+
+    /// True when the full build sorts each row by particle index
+    bool m_sort_neighbors = false;
+
+    /// True when the list should store the periodic image of each neighbor
+    bool m_image_shifts = false;
+
+    /// True when buildNlist() stores the periodic image of each neighbor
+    bool m_builds_image_shifts = false;
+
+    /// True when buildNlist() leaves out the excluded pairs
+    bool m_builds_exclusions = false;
+
+    /// True when the periodic images were stored in the last full build
+    bool m_image_shifts_active = false;
+
+    GlobalArray<unsigned char> m_nlist_image; //!< Periodic image of each neighbor list entry
+    GlobalArray<Scalar4> m_image_pos;         //!< Positions unwrapped since the last full build
+    GlobalArray<int3> m_image_ref;            //!< Particle images at the last full build
+    Scalar3 m_image_shift[27];                //!< Translation of each image in the current box
+
     GlobalArray<unsigned int> m_nlist;   //!< Neighbor list data
     GlobalArray<unsigned int> m_n_neigh; //!< Number of neighbors for each particle
     GlobalArray<Scalar4> m_last_pos;     //!< coordinates of last updated particle positions
@@ -516,6 +792,15 @@ class PYBIND11_EXPORT NeighborList : public Compute
 #ifdef ENABLE_MPI
     /// The system's communicator.
     std::shared_ptr<Communicator> m_comm;
+
+    /// Local particles that have no ghost neighbors
+    std::vector<unsigned int> m_interior_particles;
+
+    /// Local particles that have at least one ghost neighbor
+    std::vector<unsigned int> m_boundary_particles;
+
+    /// Sort the local particles into interior and boundary particles
+    void updateBoundaryParticles();
 #endif
 
     //! Return true if we are supposed to do a distance check in this time step
@@ -530,6 +815,84 @@ class PYBIND11_EXPORT NeighborList : public Compute
     //! Builds the neighbor list
     virtual void buildNlist(uint64_t timestep);
 
+    /// Maximum fraction of particles that may be updated incrementally (0 disables)
+    Scalar m_partial_update_fraction = Scalar(0.0);
+
+    /// Local particles that moved more than half the buffer since the last full build
+    std::vector<unsigned int> m_moved_particles;
+
+    /// Flags the local particles in m_moved_particles
+    std::vector<uint8_t> m_moved;
+
+    /// Type of a particle that moved beyond the buffer in the last distanceCheck() of this rank
+    /*! distanceCheck() sets this to UINT_MAX when no local particle moved beyond the buffer.
+     */
+    unsigned int m_rebuild_trigger_type = UINT_MAX;
+
+    /// Set by distanceCheck() when the next build may be incremental
+    bool m_partial_update_pending = false;
+
+    /// Incrementally update the neighbor list of the particles in m_moved_particles
+    /*! \param timestep Current time step
+        \returns false when the neighbor list does not support incremental updates and needs a
+                 full build
+
+        Derived classes rebuild the rows of the moved particles from scratch and replace the
+        entries of the moved particles in the rows of all other particles. Rows of pairs of
+        particles that have both moved less than half the buffer since the last full build remain
+        valid. Overflows are recorded in m_conditions and trigger a full build.
+    */
+    virtual bool buildNlistPartial(uint64_t timestep)
+        {
+        return false;
+        }
+
+    /// Build the neighbor list of all local particles in chunks
+    /*! \param h_conditions Host pointer to the per-type overflow conditions
+        \param build Callable build(begin, end, conditions) that builds the neighbor list of the
+               local particles in [begin, end) and records overflows in conditions.
+
+        Each particle writes only to its own segment of the neighbor list (given by the head list),
+        so the chunks are independent. When TBB threads are available, the chunks execute in
+        parallel and each thread records overflows in its own copy of the conditions, which are
+        reduced into \a h_conditions afterwards.
+    */
+    template<class Func> void buildNlistParticles(unsigned int* h_conditions, Func build)
+        {
+        const unsigned int N = m_pdata->getN();
+
+#ifdef ENABLE_TBB
+        if (m_exec_conf->getNumThreads() > 1)
+            {
+            const unsigned int n_types = m_pdata->getNTypes();
+            tbb::enumerable_thread_specific<std::vector<unsigned int>> thread_conditions(n_types,
+                                                                                         0);
+            m_exec_conf->getTaskArena()->execute(
+                [&]
+                {
+                    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                                      [&](const tbb::blocked_range<unsigned int>& r)
+                                      {
+                                          build(r.begin(),
+                                                r.end(),
+                                                thread_conditions.local().data());
+                                      });
+                });
+
+            for (const auto& conditions : thread_conditions)
+                {
+                for (unsigned int i = 0; i < n_types; ++i)
+                    {
+                    h_conditions[i] = std::max(h_conditions[i], conditions[i]);
+                    }
+                }
+            return;
+            }
+#endif
+
+        build(0, N, h_conditions);
+        }
+
     //! Updates the idx exclusion list
     virtual void updateExListIdx();
 
@@ -548,6 +911,30 @@ class PYBIND11_EXPORT NeighborList : public Compute
     //! Amortized resizing of the neighborlist
     void resizeNlist(size_t size);
 
+    //! Exchange the neighbor and exclusion index arrays with another neighbor list
+    void swapOutput(NeighborList& other);
+
+    /// Encode the periodic image of a neighbor
+    /*! \param box Simulation box
+        \param dx Separation of the particle and the neighbor
+        \param dx_min Separation after the minimum image convention
+        \returns The code of the image of the neighbor that is within the cutoff
+    */
+    static unsigned char encodeImage(const BoxDim& box, const Scalar3& dx, const Scalar3& dx_min)
+        {
+        int3 n = box.getImage(dx - dx_min);
+        return (unsigned char)((n.x + 1) + 3 * (n.y + 1) + 9 * (n.z + 1));
+        }
+
+    /// Test if the next full build stores the periodic images
+    bool imageShiftsSupported() const;
+
+    /// Record the particle images after a full build
+    void resetImagePositions();
+
+    /// Update the unwrapped positions and the image translations
+    void updateImagePositions();
+
 #ifdef ENABLE_MPI
     CommFlags getRequestedCommFlags(uint64_t timestep)
         {
@@ -583,6 +970,8 @@ class PYBIND11_EXPORT NeighborList : public Compute
     uint64_t m_updates;           //!< Number of times the neighbor list has been updated
     uint64_t m_forced_updates;    //!< Number of times the neighbor list has been forcibly updated
     uint64_t m_dangerous_updates; //!< Number of dangerous builds counted
+    int64_t m_build_time = 0;     //!< Time spent building the neighbor list [ns]
+    ClockSource m_build_clock;    //!< Clock used to time neighbor list builds
     bool m_force_update;          //!< Flag to handle the forcing of neighborlist updates
     bool m_dist_check;            //!< Set to false to disable distance checks (nlist always built
                                   //!< m_rebuild_check_delay steps)
@@ -596,6 +985,24 @@ class PYBIND11_EXPORT NeighborList : public Compute
     std::vector<uint64_t> m_update_periods; //!< Steps between updates
     std::set<std::string> m_exclusions;     //!< Exclusions that have been set
 
+    /// Number of incremental updates since the last call to resetStats
+    uint64_t m_partial_updates = 0;
+
+    /// Number of distance check builds since the last call to resetStats, by the triggering type
+    std::vector<uint64_t> m_rebuild_trigger_types;
+
+    /// Quality metrics of the neighbor list, cached by getQualityMetrics()
+    struct QualityMetrics
+        {
+        uint64_t timestep = UINT64_MAX; //!< Time step of the metrics
+        uint64_t num_updates = 0;       //!< Value of getNumUpdates() at the time step
+        double mean_neighbors = 0;      //!< Mean number of stored neighbors per particle
+        unsigned int max_neighbors = 0; //!< Maximum number of stored neighbors of a particle
+        double efficiency = 0;          //!< Fraction of the stored pairs within r_cut
+        double unused_storage = 0;      //!< Fraction of the allocated storage that is unused
+        };
+    QualityMetrics m_quality;
+
     //! Test if the list needs updating
     bool needsUpdating(uint64_t timestep);
 
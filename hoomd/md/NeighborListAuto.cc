@@ -0,0 +1,384 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file NeighborListAuto.cc
+    \brief Defines NeighborListAuto
+*/
+
+#include "NeighborListAuto.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/Communicator.h"
+#endif
+
+#include <limits>
+#include <pybind11/stl.h>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System definition
+    \param r_buff Neighbor list buffer width
+    \param candidates Neighbor lists to select from, constructed for the same system
+*/
+NeighborListAuto::NeighborListAuto(std::shared_ptr<SystemDefinition> sysdef,
+                                   Scalar r_buff,
+                                   std::vector<std::shared_ptr<NeighborList>> candidates)
+    : NeighborList(sysdef, r_buff), m_candidates(candidates)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing NeighborListAuto" << endl;
+
+    if (m_candidates.empty())
+        {
+        throw std::runtime_error("NeighborListAuto requires at least one candidate.");
+        }
+
+    for (auto& candidate : m_candidates)
+        {
+        if (!candidate)
+            {
+            throw std::runtime_error("NeighborListAuto candidates must not be None.");
+            }
+        candidate->setRBuff(r_buff);
+        candidate->setRebuildCheckDelay(getRebuildCheckDelay());
+        candidate->setDistCheck(getDistCheck());
+        candidate->setStorageMode(getStorageMode());
+        }
+
+    m_candidate_times.resize(m_candidates.size(), 0);
+    m_selection_widths = m_pdata->getGlobalBox().getNearestPlaneDistance();
+
+#ifdef ENABLE_MPI
+    // only the active candidate decides when the particles migrate, the others hold stale positions
+    if (m_comm)
+        {
+        m_comm->getMigrateSignal().disconnect<NeighborList, &NeighborList::peekUpdate>(this);
+        for (auto& candidate : m_candidates)
+            {
+            m_comm->getMigrateSignal().disconnect<NeighborList, &NeighborList::peekUpdate>(
+                candidate.get());
+            }
+        m_comm->getMigrateSignal()
+            .connect<NeighborListAuto, &NeighborListAuto::peekActiveUpdate>(this);
+        }
+#endif
+    }
+
+NeighborListAuto::~NeighborListAuto()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying NeighborListAuto" << endl;
+
+    // return the arrays before the candidates may be destroyed
+    reclaimOutput();
+
+#ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        m_comm->getMigrateSignal()
+            .disconnect<NeighborListAuto, &NeighborListAuto::peekActiveUpdate>(this);
+        }
+#endif
+    }
+
+void NeighborListAuto::reclaimOutput()
+    {
+    if (m_published)
+        {
+        swapOutput(*m_candidates[m_active]);
+        m_published = false;
+        }
+    }
+
+void NeighborListAuto::publishOutput()
+    {
+    if (!m_published)
+        {
+        swapOutput(*m_candidates[m_active]);
+        m_published = true;
+        }
+    }
+
+/*! \returns True when a nearest plane distance of the global box differs by more than the box
+    tolerance from its value at the last selection
+*/
+bool NeighborListAuto::boxChanged()
+    {
+    Scalar3 widths = m_pdata->getGlobalBox().getNearestPlaneDistance();
+    bool changed = fabs(widths.x - m_selection_widths.x) > m_box_tolerance * m_selection_widths.x
+                   || fabs(widths.y - m_selection_widths.y)
+                          > m_box_tolerance * m_selection_widths.y;
+    if (m_sysdef->getNDimensions() == 3)
+        {
+        changed = changed
+                  || fabs(widths.z - m_selection_widths.z) > m_box_tolerance * m_selection_widths.z;
+        }
+    return changed;
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void NeighborListAuto::compute(uint64_t timestep)
+    {
+    if (m_selection_period > 0 && timestep >= m_last_selection + m_selection_period)
+        m_selection_pending = true;
+
+    if (boxChanged())
+        m_selection_pending = true;
+
+    reclaimOutput();
+    m_candidates[m_active]->compute(timestep);
+
+    // the other candidates can build valid lists only right after the active one did
+    if (m_selection_pending && m_candidates[m_active]->hasBeenUpdated(timestep))
+        selectActive(timestep);
+
+    publishOutput();
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    Every candidate is built m_n_trials times at \a timestep. The candidate with the shortest build
+    becomes active. The last build of each candidate remains valid, so the new active candidate
+    need not be rebuilt.
+*/
+void NeighborListAuto::selectActive(uint64_t timestep)
+    {
+    for (unsigned int i = 0; i < m_candidates.size(); i++)
+        {
+        int64_t fastest = std::numeric_limits<int64_t>::max();
+        for (unsigned int trial = 0; trial < m_n_trials; trial++)
+            {
+            m_candidates[i]->forceUpdate();
+#ifdef ENABLE_HIP
+            if (m_exec_conf->isCUDAEnabled())
+                hipDeviceSynchronize();
+#endif
+            int64_t start = m_selection_clock.getTime();
+            m_candidates[i]->compute(timestep);
+#ifdef ENABLE_HIP
+            if (m_exec_conf->isCUDAEnabled())
+                hipDeviceSynchronize();
+#endif
+            fastest = std::min(fastest, m_selection_clock.getTime() - start);
+            }
+        m_candidate_times[i] = fastest;
+        }
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        // all ranks select the candidate that is fastest on the slowest rank
+        MPI_Allreduce(MPI_IN_PLACE,
+                      m_candidate_times.data(),
+                      (int)m_candidate_times.size(),
+                      MPI_INT64_T,
+                      MPI_MAX,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    unsigned int fastest = 0;
+    for (unsigned int i = 1; i < m_candidates.size(); i++)
+        {
+        if (m_candidate_times[i] < m_candidate_times[fastest])
+            fastest = i;
+        }
+
+    if (fastest != m_active)
+        {
+        m_exec_conf->msg->notice(4)
+            << "nlist.Auto: switching from candidate " << m_active << " to candidate "
+            << fastest << " (" << double(m_candidate_times[fastest]) / 1e6 << " ms per build)"
+            << endl;
+        }
+
+    m_active = fastest;
+    m_selection_pending = false;
+    m_last_selection = timestep;
+    m_selection_widths = m_pdata->getGlobalBox().getNearestPlaneDistance();
+    }
+
+/*! \returns The fastest build time of each candidate at the last selection in seconds
+ */
+std::vector<double> NeighborListAuto::getCandidateTimes()
+    {
+    std::vector<double> result(m_candidate_times.size());
+    for (unsigned int i = 0; i < m_candidate_times.size(); i++)
+        result[i] = double(m_candidate_times[i]) / 1e9;
+    return result;
+    }
+
+void NeighborListAuto::addRCutMatrix(const std::shared_ptr<GlobalArray<Scalar>>& r_cut_matrix)
+    {
+    for (auto& candidate : m_candidates)
+        candidate->addRCutMatrix(r_cut_matrix);
+    NeighborList::addRCutMatrix(r_cut_matrix);
+    }
+
+void NeighborListAuto::removeRCutMatrix(const std::shared_ptr<GlobalArray<Scalar>>& r_cut_matrix)
+    {
+    for (auto& candidate : m_candidates)
+        candidate->removeRCutMatrix(r_cut_matrix);
+    NeighborList::removeRCutMatrix(r_cut_matrix);
+    }
+
+void NeighborListAuto::notifyRCutMatrixChange()
+    {
+    for (auto& candidate : m_candidates)
+        candidate->notifyRCutMatrixChange();
+    NeighborList::notifyRCutMatrixChange();
+    m_selection_pending = true;
+    }
+
+void NeighborListAuto::AddMesh(std::shared_ptr<MeshDefinition> meshdef)
+    {
+    for (auto& candidate : m_candidates)
+        candidate->AddMesh(meshdef);
+    NeighborList::AddMesh(meshdef);
+    }
+
+void NeighborListAuto::setRBuff(Scalar r_buff)
+    {
+    for (auto& candidate : m_candidates)
+        candidate->setRBuff(r_buff);
+    NeighborList::setRBuff(r_buff);
+    m_selection_pending = true;
+    }
+
+void NeighborListAuto::setRebuildCheckDelay(uint64_t every)
+    {
+    for (auto& candidate : m_candidates)
+        candidate->setRebuildCheckDelay(every);
+    NeighborList::setRebuildCheckDelay(every);
+    }
+
+void NeighborListAuto::setDistCheck(bool dist_check)
+    {
+    for (auto& candidate : m_candidates)
+        candidate->setDistCheck(dist_check);
+    NeighborList::setDistCheck(dist_check);
+    }
+
+void NeighborListAuto::setStorageMode(storageMode mode)
+    {
+    for (auto& candidate : m_candidates)
+        candidate->setStorageMode(mode);
+    NeighborList::setStorageMode(mode);
+    }
+
+/*! The exclusions of this class are kept up to date so that getExclusions() reports them. Its own
+    exclusion index arrays are reclaimed first because they are rebuilt here.
+*/
+void NeighborListAuto::setExclusions(pybind11::list exclusions)
+    {
+    bool published = m_published;
+    reclaimOutput();
+
+    for (auto& candidate : m_candidates)
+        candidate->setExclusions(exclusions);
+    NeighborList::setExclusions(exclusions);
+
+    if (published)
+        publishOutput();
+    }
+
+void NeighborListAuto::setFilterBody(bool filter_body)
+    {
+    for (auto& candidate : m_candidates)
+        candidate->setFilterBody(filter_body);
+    NeighborList::setFilterBody(filter_body);
+    }
+
+void NeighborListAuto::setCompressed(bool compressed)
+    {
+    if (compressed)
+        {
+        throw std::runtime_error("NeighborListAuto does not support compressed storage.");
+        }
+    }
+
+void NeighborListAuto::setRcut(unsigned int typ1, unsigned int typ2, Scalar rcut)
+    {
+    for (auto& candidate : m_candidates)
+        candidate->setRcut(typ1, typ2, rcut);
+    NeighborList::setRcut(typ1, typ2, rcut);
+    }
+
+void NeighborListAuto::forceUpdate()
+    {
+    for (auto& candidate : m_candidates)
+        candidate->forceUpdate();
+    NeighborList::forceUpdate();
+    }
+
+void NeighborListAuto::resetStats()
+    {
+    for (auto& candidate : m_candidates)
+        candidate->resetStats();
+    NeighborList::resetStats();
+    }
+
+/*! \returns The shortest rebuild period of the active candidate
+ */
+unsigned int NeighborListAuto::getSmallestRebuild()
+    {
+    return m_candidates[m_active]->getSmallestRebuild();
+    }
+
+/*! \returns The number of builds by all candidates, including the builds timed for the selection
+ */
+uint64_t NeighborListAuto::getNumUpdates()
+    {
+    uint64_t n_updates = 0;
+    for (auto& candidate : m_candidates)
+        n_updates += candidate->getNumUpdates();
+    return n_updates;
+    }
+
+/*! \returns The number of dangerous builds by all candidates
+ */
+uint64_t NeighborListAuto::getNumDangerousUpdates()
+    {
+    uint64_t n_updates = 0;
+    for (auto& candidate : m_candidates)
+        n_updates += candidate->getNumDangerousUpdates();
+    return n_updates;
+    }
+
+/*! \returns The build time of all candidates, including the builds timed for the selection [s]
+ */
+double NeighborListAuto::getBuildTime()
+    {
+    double build_time = 0.0;
+    for (auto& candidate : m_candidates)
+        build_time += candidate->getBuildTime();
+    return build_time;
+    }
+
+namespace detail
+    {
+void export_NeighborListAuto(pybind11::module& m)
+    {
+    pybind11::class_<NeighborListAuto, NeighborList, std::shared_ptr<NeighborListAuto>>(
+        m,
+        "NeighborListAuto")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            Scalar,
+                            std::vector<std::shared_ptr<NeighborList>>>())
+        .def_property_readonly("active", &NeighborListAuto::getActive)
+        .def_property_readonly("candidate_times", &NeighborListAuto::getCandidateTimes)
+        .def_property("selection_period",
+                      &NeighborListAuto::getSelectionPeriod,
+                      &NeighborListAuto::setSelectionPeriod)
+        .def_property("box_tolerance",
+                      &NeighborListAuto::getBoxTolerance,
+                      &NeighborListAuto::setBoxTolerance)
+        .def("requestSelection", &NeighborListAuto::requestSelection);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
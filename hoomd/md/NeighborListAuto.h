@@ -0,0 +1,181 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "NeighborList.h"
+#include "hoomd/ClockSource.h"
+#include <vector>
+
+/*! \file NeighborListAuto.h
+    \brief Declares the NeighborListAuto class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __NEIGHBORLISTAUTO_H__
+#define __NEIGHBORLISTAUTO_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Neighbor list that selects the fastest of several build algorithms at runtime
+/*! NeighborListAuto owns a set of candidate neighbor lists (typically the cell list, stencil and
+    tree builds) and delegates every compute() to the active one. After the active candidate builds
+    the list, its neighbor and exclusion index arrays are exchanged with the (unused) arrays of
+    NeighborListAuto, so consumers read the result through the usual accessors without a copy.
+
+    The candidates are timed on the live configuration and the fastest build becomes active:
+    - on the first build,
+    - after any change of the cutoff radii or the buffer width,
+    - when a nearest plane distance of the global box changes by more than the box tolerance, and
+    - every \a selection_period time steps (0 disables the periodic selection).
+
+    The selection is deferred to the next step on which the active candidate rebuilds its list. At
+    that point, every particle is within the ghost layer of the last migration, so the forced
+    builds of the other candidates are valid also with domain decomposition. Each candidate is
+    built a few times and its fastest build counts. With MPI, the slowest rank decides so that all
+    ranks select the same algorithm.
+
+    All settings are forwarded to the candidates. Compressed storage is not supported.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT NeighborListAuto : public NeighborList
+    {
+    public:
+    //! Constructs the compute
+    NeighborListAuto(std::shared_ptr<SystemDefinition> sysdef,
+                     Scalar r_buff,
+                     std::vector<std::shared_ptr<NeighborList>> candidates);
+
+    //! Destructor
+    virtual ~NeighborListAuto();
+
+    //! Computes the NeighborList with the active candidate
+    virtual void compute(uint64_t timestep);
+
+    // The settings below are forwarded to all candidates
+
+    virtual void addRCutMatrix(const std::shared_ptr<GlobalArray<Scalar>>& r_cut_matrix);
+
+    virtual void removeRCutMatrix(const std::shared_ptr<GlobalArray<Scalar>>& r_cut_matrix);
+
+    virtual void notifyRCutMatrixChange();
+
+    virtual void AddMesh(std::shared_ptr<MeshDefinition> meshdef);
+
+    virtual void setRBuff(Scalar r_buff);
+
+    virtual void setRebuildCheckDelay(uint64_t every);
+
+    virtual void setDistCheck(bool dist_check);
+
+    virtual void setStorageMode(storageMode mode);
+
+    virtual void setExclusions(pybind11::list exclusions);
+
+    virtual void setFilterBody(bool filter_body);
+
+    virtual void setCompressed(bool compressed);
+
+    virtual void setRcut(unsigned int typ1, unsigned int typ2, Scalar rcut);
+
+    virtual void forceUpdate();
+
+    // The statistics below combine the builds of all candidates
+
+    virtual void resetStats();
+
+    virtual unsigned int getSmallestRebuild();
+
+    virtual uint64_t getNumUpdates();
+
+    virtual uint64_t getNumDangerousUpdates();
+
+    virtual double getBuildTime();
+
+    //! Get the index of the active candidate
+    unsigned int getActive()
+        {
+        return m_active;
+        }
+
+    //! Set the number of steps between periodic selections (0 disables them)
+    void setSelectionPeriod(uint64_t period)
+        {
+        m_selection_period = period;
+        }
+
+    //! Get the number of steps between periodic selections
+    uint64_t getSelectionPeriod()
+        {
+        return m_selection_period;
+        }
+
+    //! Set the relative change in the box that triggers a selection
+    void setBoxTolerance(Scalar tolerance)
+        {
+        if (tolerance <= Scalar(0.0))
+            {
+            throw std::domain_error("box_tolerance must be positive.");
+            }
+        m_box_tolerance = tolerance;
+        }
+
+    //! Get the relative change in the box that triggers a selection
+    Scalar getBoxTolerance()
+        {
+        return m_box_tolerance;
+        }
+
+    //! Request a selection on the next build
+    void requestSelection()
+        {
+        m_selection_pending = true;
+        }
+
+    //! Get the fastest build time of each candidate at the last selection [s]
+    std::vector<double> getCandidateTimes();
+
+    protected:
+    //! Time the candidates and activate the fastest
+    void selectActive(uint64_t timestep);
+
+    //! Move the output arrays back to the active candidate
+    void reclaimOutput();
+
+    //! Expose the output arrays of the active candidate
+    void publishOutput();
+
+    //! Check for a significant change of the global box
+    bool boxChanged();
+
+#ifdef ENABLE_MPI
+    //! Returns true if the active candidate requires a particle migration
+    bool peekActiveUpdate(uint64_t timestep)
+        {
+        return m_candidates[m_active]->peekUpdate(timestep);
+        }
+#endif
+
+    std::vector<std::shared_ptr<NeighborList>> m_candidates; //!< Candidate neighbor lists
+    unsigned int m_active = 0;        //!< Index of the active candidate
+    bool m_published = false;         //!< True when this holds the arrays of the active candidate
+    bool m_selection_pending = true;  //!< True when a selection is due on the next build
+    uint64_t m_selection_period = 0;  //!< Steps between periodic selections
+    uint64_t m_last_selection = 0;    //!< Time step of the last selection
+    Scalar m_box_tolerance = Scalar(0.1); //!< Relative box change that triggers a selection
+    Scalar3 m_selection_widths;           //!< Nearest plane distances at the last selection
+    std::vector<int64_t> m_candidate_times; //!< Fastest build time of each candidate [ns]
+    unsigned int m_n_trials = 3;            //!< Builds timed per candidate
+    ClockSource m_selection_clock;          //!< Clock used to time the candidates
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __NEIGHBORLISTAUTO_H__
@@ -11,6 +11,8 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#include <algorithm>
+
 using namespace std;
 
 namespace hoomd
@@ -26,6 +28,10 @@ NeighborListBinned::NeighborListBinned(std::shared_ptr<SystemDefinition> sysdef,
     m_cl->setComputeXYZF(true);
     m_cl->setComputeTypeBody(false);
     m_cl->setFlagIndex();
+    m_cl->setSortByType(true);
+
+    m_builds_image_shifts = true;
+    m_builds_exclusions = true;
     }
 
 NeighborListBinned::~NeighborListBinned()
@@ -44,6 +50,8 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
         m_update_cell_size = false;
         }
 
+    // group the constituents of each body in the cells so that they can be skipped together
+    m_cl->setGroupBodies(m_filter_body);
     m_cl->compute(timestep);
 
     uint3 dim = m_cl->getDim();
@@ -71,6 +79,16 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
     ArrayHandle<unsigned int> h_cell_adj(m_cl->getCellAdjArray(),
                                          access_location::host,
                                          access_mode::read);
+    ArrayHandle<unsigned int> h_cell_type_offsets(m_cl->getTypeOffsetArray(),
+                                                  access_location::host,
+                                                  access_mode::read);
+    std::unique_ptr<ArrayHandle<unsigned int>> h_cell_body_run_end;
+    if (m_filter_body)
+        {
+        h_cell_body_run_end.reset(new ArrayHandle<unsigned int>(m_cl->getBodyRunEndArray(),
+                                                                access_location::host,
+                                                                access_mode::read));
+        }
 
     // access the neighbor list data
     ArrayHandle<size_t> h_head_list(m_head_list, access_location::host, access_mode::read);
@@ -80,30 +98,296 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
                                            access_mode::readwrite);
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned char> h_nlist_image(m_nlist_image,
+                                             access_location::host,
+                                             access_mode::overwrite);
+    unsigned char* nlist_image = m_image_shifts_active ? h_nlist_image.data : nullptr;
 
     // access indexers
     Index3D ci = m_cl->getCellIndexer();
     Index2D cli = m_cl->getCellListIndexer();
     Index2D cadji = m_cl->getCellAdjIndexer();
+    Index2D cti = m_cl->getTypeOffsetIndexer();
+    const unsigned int n_types = m_pdata->getNTypes();
 
     // get periodic flags
     uchar3 periodic = box.getPeriodic();
 
-    // for each local particle
-    unsigned int nparticles = m_pdata->getN();
+    // excluded pairs are skipped before they are written, compressed rows are also sorted
+    const bool compressed = m_compressed;
+    const bool filter_exclusions = m_exclusions_set;
+    ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx,
+                                            access_location::host,
+                                            access_mode::read);
+
+    // compressed rows are always sorted
+    const bool sort_rows = m_sort_neighbors && !compressed;
+
+    // build the neighbor list of the local particles in [begin, end)
+    auto build = [&](unsigned int begin, unsigned int end, unsigned int* conditions)
+    {
+        std::vector<unsigned int> row;
+        std::vector<uint64_t> sort_keys;
+        std::vector<unsigned int> ex_row;
+
+        // test membership without branches, rows have only a few exclusions
+        auto is_excluded = [&](unsigned int j)
+        {
+            bool excluded = false;
+            for (unsigned int k = 0; k < ex_row.size(); k++)
+                excluded |= ex_row[k] == j;
+            return excluded;
+        };
+
+        for (unsigned int i = begin; i < end; i++)
+            {
+            unsigned int cur_n_neigh = 0;
+            row.clear();
+
+            // gather the exclusions of particle i, which are strided in the exclusion list
+            ex_row.clear();
+            if (filter_exclusions)
+                {
+                const unsigned int n_ex = h_n_ex_idx.data[i];
+                for (unsigned int k = 0; k < n_ex; k++)
+                    ex_row.push_back(h_ex_list_idx.data[m_ex_list_indexer(i, k)]);
+                }
+
+            const Scalar3 my_pos
+                = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
+            const unsigned int body_i = h_body.data[i];
+
+            const unsigned int Nmax_i = h_Nmax.data[type_i];
+            const size_t head_idx_i = h_head_list.data[i];
+
+            // find the bin each particle belongs in
+            Scalar3 f = box.makeFraction(my_pos, ghost_width);
+            int ib = (unsigned int)(f.x * dim.x);
+            int jb = (unsigned int)(f.y * dim.y);
+            int kb = (unsigned int)(f.z * dim.z);
+
+            // need to handle the case where the particle is exactly at the box hi
+            if (ib == (int)dim.x && periodic.x)
+                ib = 0;
+            if (jb == (int)dim.y && periodic.y)
+                jb = 0;
+            if (kb == (int)dim.z && periodic.z)
+                kb = 0;
+
+            // identify the bin
+            unsigned int my_cell = ci(ib, jb, kb);
+
+            // loop through all neighboring bins
+            for (unsigned int cur_adj = 0; cur_adj < cadji.getW(); cur_adj++)
+                {
+                unsigned int neigh_cell = h_cell_adj.data[cadji(cur_adj, my_cell)];
+
+                // the members of the neighboring bin are grouped by type, skip the types that do
+                // not interact with type_i without reading their members
+                for (unsigned int cur_neigh_type = 0; cur_neigh_type < n_types; cur_neigh_type++)
+                    {
+                    const unsigned int type_begin
+                        = h_cell_type_offsets.data[cti(cur_neigh_type, neigh_cell)];
+                    const unsigned int type_end
+                        = h_cell_type_offsets.data[cti(cur_neigh_type + 1, neigh_cell)];
+                    if (type_begin == type_end)
+                        continue;
+
+                    Scalar r_cut = h_r_cut.data[m_typpair_idx(type_i, cur_neigh_type)];
+                    if (r_cut <= Scalar(0.0))
+                        continue;
+
+                    Scalar r_listsq = h_r_listsq.data[m_typpair_idx(type_i, cur_neigh_type)];
+
+                    // check against all the particles of this type in the neighboring bin to see
+                    // if it is a neighbor
+                    for (unsigned int cur_offset = type_begin; cur_offset < type_end; cur_offset++)
+                        {
+                        Scalar4& cur_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
+                        unsigned int cur_neigh = __scalar_as_int(cur_xyzf.w);
+
+                        // skip all the members of the same body in this bin at once
+                        if (m_filter_body && body_i != NO_BODY
+                            && body_i == h_body.data[cur_neigh])
+                            {
+                            cur_offset
+                                = h_cell_body_run_end->data[cli(cur_offset, neigh_cell)] - 1;
+                            continue;
+                            }
+
+                        // a particle cannot neighbor itself
+                        if (i == cur_neigh)
+                            continue;
+
+                        Scalar3 neigh_pos = make_scalar3(cur_xyzf.x, cur_xyzf.y, cur_xyzf.z);
+                        Scalar3 dx = box.minImage(my_pos - neigh_pos);
+
+                        Scalar dr_sq = dot(dx, dx);
+
+                        if (dr_sq <= r_listsq && !(ex_row.size() > 0 && is_excluded(cur_neigh)))
+                            {
+                            // Add the neighbor index to the list.
+                            if (compressed && (m_storage_mode == full || i < cur_neigh))
+                                {
+                                row.push_back(cur_neigh);
+                                }
+                            else if (m_storage_mode == full || i < cur_neigh)
+                                {
+                                // local neighbor
+                                if (cur_n_neigh < Nmax_i)
+                                    {
+                                    h_nlist.data[head_idx_i + cur_n_neigh] = cur_neigh;
+                                    if (nlist_image)
+                                        nlist_image[head_idx_i + cur_n_neigh]
+                                            = encodeImage(box, my_pos - neigh_pos, dx);
+                                    }
+                                else
+                                    conditions[type_i] = max(conditions[type_i], cur_n_neigh + 1);
+
+                                cur_n_neigh++;
+                                }
+                            }
+                        }
+                    }
+                }
+
+            if (compressed)
+                {
+                std::sort(row.begin(), row.end());
+                cur_n_neigh = (unsigned int)row.size();
+                unsigned int n_units = detail::compressNeighbors(row.data(),
+                                                                 cur_n_neigh,
+                                                                 h_nlist.data,
+                                                                 head_idx_i,
+                                                                 Nmax_i);
+                if (n_units > Nmax_i)
+                    conditions[type_i] = max(conditions[type_i], n_units);
+                }
+            else if (sort_rows && cur_n_neigh <= Nmax_i)
+                {
+                unsigned int* row_begin = h_nlist.data + head_idx_i;
+                if (nlist_image)
+                    {
+                    // sort the images with the neighbors
+                    unsigned char* image_begin = nlist_image + head_idx_i;
+                    sort_keys.resize(cur_n_neigh);
+                    for (unsigned int k = 0; k < cur_n_neigh; k++)
+                        sort_keys[k] = (uint64_t(row_begin[k]) << 8) | image_begin[k];
+                    std::sort(sort_keys.begin(), sort_keys.end());
+                    for (unsigned int k = 0; k < cur_n_neigh; k++)
+                        {
+                        row_begin[k] = (unsigned int)(sort_keys[k] >> 8);
+                        image_begin[k] = (unsigned char)(sort_keys[k] & 0xff);
+                        }
+                    }
+                else
+                    {
+                    std::sort(row_begin, row_begin + cur_n_neigh);
+                    }
+                }
+
+            h_n_neigh.data[i] = cur_n_neigh;
+            }
+    };
+
+    buildNlistParticles(h_conditions.data, build);
+    }
+
+/*! Only the rows of the moved particles are searched in the cell list. Entries that reference
+    moved particles are first removed from the rows of the other particles and then re-added for the
+    pairs that are currently within the list cutoff. All other entries are left in place.
+*/
+bool NeighborListBinned::buildNlistPartial(uint64_t timestep)
+    {
+    // a new cell size changes the list cutoff, which needs a full build, and compressed rows and
+    // the images of the neighbors can not be edited in place
+    if (m_update_cell_size || m_compressed || m_image_shifts)
+        return false;
+
+    m_cl->compute(timestep);
+
+    uint3 dim = m_cl->getDim();
+    Scalar3 ghost_width = m_cl->getGhostWidth();
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                     access_location::host,
+                                     access_mode::read);
+
+    const BoxDim& box = m_pdata->getBox();
+
+    ArrayHandle<Scalar> h_r_cut(m_r_cut, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_r_listsq(m_r_listsq, access_location::host, access_mode::read);
+
+    ArrayHandle<unsigned int> h_cell_size(m_cl->getCellSizeArray(),
+                                          access_location::host,
+                                          access_mode::read);
+    ArrayHandle<Scalar4> h_cell_xyzf(m_cl->getXYZFArray(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<unsigned int> h_cell_adj(m_cl->getCellAdjArray(),
+                                         access_location::host,
+                                         access_mode::read);
+
+    ArrayHandle<size_t> h_head_list(m_head_list, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_conditions(m_conditions,
+                                           access_location::host,
+                                           access_mode::readwrite);
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::readwrite);
 
-    for (int i = 0; i < (int)nparticles; i++)
+    Index3D ci = m_cl->getCellIndexer();
+    Index2D cli = m_cl->getCellListIndexer();
+    Index2D cadji = m_cl->getCellAdjIndexer();
+
+    uchar3 periodic = box.getPeriodic();
+    const unsigned int N = m_pdata->getN();
+
+    // remove the moved particles from the rows of the other particles
+    for (unsigned int j = 0; j < N; j++)
         {
-        unsigned int cur_n_neigh = 0;
+        if (m_moved[j])
+            continue;
 
+        const size_t head_idx_j = h_head_list.data[j];
+        const unsigned int n_neigh = h_n_neigh.data[j];
+        unsigned int new_n_neigh = 0;
+        for (unsigned int k = 0; k < n_neigh; k++)
+            {
+            const unsigned int neigh = h_nlist.data[head_idx_j + k];
+            if (!m_moved[neigh])
+                {
+                h_nlist.data[head_idx_j + new_n_neigh] = neigh;
+                new_n_neigh++;
+                }
+            }
+        h_n_neigh.data[j] = new_n_neigh;
+        }
+
+    // add a neighbor to the row of particle i, recording overflows
+    auto add_neighbor = [&](unsigned int i, unsigned int type_i, unsigned int neigh)
+    {
+        const unsigned int n_neigh = h_n_neigh.data[i];
+        if (n_neigh < h_Nmax.data[type_i])
+            h_nlist.data[h_head_list.data[i] + n_neigh] = neigh;
+        else
+            h_conditions.data[type_i] = max(h_conditions.data[type_i], n_neigh + 1);
+        h_n_neigh.data[i] = n_neigh + 1;
+    };
+
+    // rebuild the rows of the moved particles from scratch
+    for (unsigned int i : m_moved_particles)
+        h_n_neigh.data[i] = 0;
+
+    for (unsigned int i : m_moved_particles)
+        {
         const Scalar3 my_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
         const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
         const unsigned int body_i = h_body.data[i];
 
-        const unsigned int Nmax_i = h_Nmax.data[type_i];
-        const size_t head_idx_i = h_head_list.data[i];
-
-        // find the bin each particle belongs in
         Scalar3 f = box.makeFraction(my_pos, ghost_width);
         int ib = (unsigned int)(f.x * dim.x);
         int jb = (unsigned int)(f.y * dim.y);
@@ -117,65 +401,45 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
         if (kb == (int)dim.z && periodic.z)
             kb = 0;
 
-        // identify the bin
         unsigned int my_cell = ci(ib, jb, kb);
 
-        // loop through all neighboring bins
         for (unsigned int cur_adj = 0; cur_adj < cadji.getW(); cur_adj++)
             {
             unsigned int neigh_cell = h_cell_adj.data[cadji(cur_adj, my_cell)];
 
-            // check against all the particles in that neighboring bin to see if it is a neighbor
             unsigned int size = h_cell_size.data[neigh_cell];
             for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
                 {
                 Scalar4& cur_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
                 unsigned int cur_neigh = __scalar_as_int(cur_xyzf.w);
 
-                // get the current neighbor type from the position data (will use TypeBody on the
-                // GPU)
                 unsigned int cur_neigh_type = __scalar_as_int(h_pos.data[cur_neigh].w);
                 Scalar r_cut = h_r_cut.data[m_typpair_idx(type_i, cur_neigh_type)];
 
-                // automatically exclude particles without a distance check when:
-                // (1) they are the same particle, or
-                // (2) the r_cut(i,j) indicates to skip, or
-                // (3) they are in the same body
-                bool excluded = ((i == (int)cur_neigh) || (r_cut <= Scalar(0.0)));
+                bool excluded = ((i == cur_neigh) || (r_cut <= Scalar(0.0)));
                 if (m_filter_body && body_i != NO_BODY)
                     excluded = excluded | (body_i == h_body.data[cur_neigh]);
                 if (excluded)
                     continue;
 
                 Scalar3 neigh_pos = make_scalar3(cur_xyzf.x, cur_xyzf.y, cur_xyzf.z);
-                Scalar3 dx = my_pos - neigh_pos;
-                dx = box.minImage(dx);
-
-                Scalar dr_sq = dot(dx, dx);
+                Scalar3 dx = box.minImage(my_pos - neigh_pos);
 
                 Scalar r_listsq = h_r_listsq.data[m_typpair_idx(type_i, cur_neigh_type)];
-                if (dr_sq <= r_listsq && !excluded)
-                    {
-                    // Add the neighbor index to the list.
-                    if (m_storage_mode == full || i < (int)cur_neigh)
-                        {
-                        // local neighbor
-                        if (cur_n_neigh < Nmax_i)
-                            {
-                            h_nlist.data[head_idx_i + cur_n_neigh] = cur_neigh;
-                            }
-                        else
-                            h_conditions.data[type_i]
-                                = max(h_conditions.data[type_i], cur_n_neigh + 1);
+                if (dot(dx, dx) > r_listsq)
+                    continue;
 
-                        cur_n_neigh++;
-                        }
-                    }
+                if (m_storage_mode == full || i < cur_neigh)
+                    add_neighbor(i, type_i, cur_neigh);
+
+                // moved neighbors add the pair to their own rows
+                if (!m_moved[cur_neigh] && (m_storage_mode == full || cur_neigh < i))
+                    add_neighbor(cur_neigh, cur_neigh_type, i);
                 }
             }
-
-        h_n_neigh.data[i] = cur_n_neigh;
         }
+
+    return true;
     }
 
 namespace detail
@@ -24,6 +24,12 @@ namespace md
 //! Efficient neighbor list build on the CPU
 /*! Implements the O(N) neighbor list build on the CPU using a cell list.
 
+    The build visits the adjacent cells in a fixed order, so each row lists the neighbors in the
+    order of the cells. When setSortNeighbors() is enabled, the full build sorts every row by the
+    local particle index. After the particles are sorted along a space filling curve, the pair loops
+    then read the neighbor data in memory order. Rows that a partial update modifies are not sorted
+    until the next full build.
+
     \ingroup computes
 */
 class PYBIND11_EXPORT NeighborListBinned : public NeighborList
@@ -54,6 +60,13 @@ class PYBIND11_EXPORT NeighborListBinned : public NeighborList
         return m_cl->getSortCellList();
         }
 
+    /// Set the compressed storage format
+    virtual void setCompressed(bool compressed)
+        {
+        m_compressed = compressed;
+        forceUpdate();
+        }
+
     /// Get the dimensions of the cell list
     const uint3& getDim() const
         {
@@ -74,6 +87,9 @@ class PYBIND11_EXPORT NeighborListBinned : public NeighborList
 
     //! Builds the neighbor list
     virtual void buildNlist(uint64_t timestep);
+
+    /// Rebuild the neighbor list rows of the moved particles
+    virtual bool buildNlistPartial(uint64_t timestep);
     };
 
     } // end namespace md
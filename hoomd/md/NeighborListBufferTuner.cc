@@ -0,0 +1,197 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file NeighborListBufferTuner.cc
+    \brief Defines the NeighborListBufferTuner class
+*/
+
+#include "NeighborListBufferTuner.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System definition
+    \param trigger Steps on which to end a measurement interval
+    \param nlist Neighbor list to tune
+    \param minimum_buffer Smallest buffer to allow
+    \param maximum_buffer Largest buffer to allow
+*/
+NeighborListBufferTuner::NeighborListBufferTuner(std::shared_ptr<SystemDefinition> sysdef,
+                                                 std::shared_ptr<Trigger> trigger,
+                                                 std::shared_ptr<NeighborList> nlist,
+                                                 Scalar minimum_buffer,
+                                                 Scalar maximum_buffer)
+    : Tuner(sysdef, trigger), m_nlist(nlist)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing NeighborListBufferTuner" << endl;
+
+    setMinimumBuffer(minimum_buffer);
+    setMaximumBuffer(maximum_buffer);
+    }
+
+NeighborListBufferTuner::~NeighborListBufferTuner()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying NeighborListBufferTuner" << endl;
+    }
+
+/*! \param timestep Current time step
+ */
+void NeighborListBufferTuner::setReference(uint64_t timestep)
+    {
+    m_have_reference = true;
+    m_reference_time = m_clock.getTime();
+    m_reference_timestep = timestep;
+    m_reference_builds = m_nlist->getNumUpdates();
+    m_reference_dangerous = m_nlist->getNumDangerousUpdates();
+    m_reference_build_time = m_nlist->getBuildTime();
+    }
+
+/*! \param timestep Current time step
+ */
+void NeighborListBufferTuner::update(uint64_t timestep)
+    {
+    Tuner::update(timestep);
+
+    // the neighbor list statistics reset at the start of each run
+    if (!m_have_reference || timestep <= m_reference_timestep
+        || m_nlist->getNumUpdates() < m_reference_builds)
+        {
+        setReference(timestep);
+        return;
+        }
+
+    if (m_minimum_buffer > m_maximum_buffer)
+        {
+        throw std::runtime_error("minimum_buffer must not exceed maximum_buffer.");
+        }
+
+    const uint64_t n_steps = timestep - m_reference_timestep;
+    const uint64_t n_builds = m_nlist->getNumUpdates() - m_reference_builds;
+    const uint64_t n_dangerous = m_nlist->getNumDangerousUpdates() - m_reference_dangerous;
+    double interval_time = double(m_clock.getTime() - m_reference_time);
+    double build_time = (m_nlist->getBuildTime() - m_reference_build_time) * 1e9;
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        // the slowest rank sets the pace, and all ranks must make the same choice
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &interval_time,
+                      1,
+                      MPI_DOUBLE,
+                      MPI_MAX,
+                      m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &build_time,
+                      1,
+                      MPI_DOUBLE,
+                      MPI_MAX,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    const double cost = interval_time / double(n_steps);
+    m_last_build_fraction = interval_time > 0 ? build_time / interval_time : 0.0;
+
+    // hill climbing step on the buffer
+    const Scalar r_buff = m_nlist->getRBuff();
+    const Scalar range = m_maximum_buffer - m_minimum_buffer;
+    const Scalar min_step = m_min_step_fraction * range;
+    if (!m_have_last)
+        {
+        m_step = std::max(Scalar(0.1) * range, min_step);
+        }
+    else if (cost < m_last_cost)
+        {
+        m_step = std::min(m_step * Scalar(1.5), Scalar(0.25) * range);
+        }
+    else
+        {
+        m_direction = -m_direction;
+        m_step = std::max(m_step * Scalar(0.5), min_step);
+        }
+
+    Scalar new_r_buff = r_buff + m_direction * m_step;
+    if (new_r_buff > m_maximum_buffer || new_r_buff < m_minimum_buffer)
+        {
+        // bounce off the ends of the range
+        m_direction = -m_direction;
+        new_r_buff = r_buff + m_direction * m_step;
+        }
+    new_r_buff = std::min(std::max(new_r_buff, m_minimum_buffer), m_maximum_buffer);
+
+    m_have_last = true;
+    m_last_cost = cost;
+
+    if (m_tune_check_delay)
+        {
+        uint64_t delay = m_nlist->getRebuildCheckDelay();
+        if (n_dangerous > 0)
+            {
+            delay = std::max(uint64_t(1), delay / 2);
+            }
+        else if (n_builds > 0 && r_buff > Scalar(0.0))
+            {
+            // particles move a similar distance per step, so the steps between builds scale with
+            // the buffer
+            double mean_period = double(n_steps) / double(n_builds);
+            double scale = std::min(1.0, double(new_r_buff / r_buff));
+            delay = std::max(uint64_t(1), uint64_t(std::floor(0.25 * mean_period * scale)));
+            }
+
+        if (delay != m_nlist->getRebuildCheckDelay())
+            {
+            m_exec_conf->msg->notice(6)
+                << "NeighborListBufferTuner: rebuild_check_delay = " << delay << endl;
+            m_nlist->setRebuildCheckDelay(delay);
+            }
+        }
+
+    if (new_r_buff != r_buff)
+        {
+        m_exec_conf->msg->notice(6) << "NeighborListBufferTuner: " << cost / 1e3
+                                    << " us per step with buffer " << r_buff
+                                    << ", next buffer " << new_r_buff << endl;
+        m_nlist->setRBuff(new_r_buff);
+        }
+
+    setReference(timestep);
+    }
+
+namespace detail
+    {
+void export_NeighborListBufferTuner(pybind11::module& m)
+    {
+    pybind11::class_<NeighborListBufferTuner, Tuner, std::shared_ptr<NeighborListBufferTuner>>(
+        m,
+        "NeighborListBufferTuner")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            std::shared_ptr<NeighborList>,
+                            Scalar,
+                            Scalar>())
+        .def_property("minimum_buffer",
+                      &NeighborListBufferTuner::getMinimumBuffer,
+                      &NeighborListBufferTuner::setMinimumBuffer)
+        .def_property("maximum_buffer",
+                      &NeighborListBufferTuner::getMaximumBuffer,
+                      &NeighborListBufferTuner::setMaximumBuffer)
+        .def_property("min_step_fraction",
+                      &NeighborListBufferTuner::getMinimumStepFraction,
+                      &NeighborListBufferTuner::setMinimumStepFraction)
+        .def_property("tune_check_delay",
+                      &NeighborListBufferTuner::getTuneCheckDelay,
+                      &NeighborListBufferTuner::setTuneCheckDelay)
+        .def_property_readonly("time_per_step", &NeighborListBufferTuner::getTimePerStep)
+        .def_property_readonly("build_fraction", &NeighborListBufferTuner::getBuildFraction);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
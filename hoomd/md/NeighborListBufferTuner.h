@@ -0,0 +1,166 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file NeighborListBufferTuner.h
+    \brief Declares a tuner that continuously adjusts the neighbor list buffer
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "NeighborList.h"
+#include "hoomd/ClockSource.h"
+#include "hoomd/Tuner.h"
+
+#include <memory>
+#include <pybind11/pybind11.h>
+
+#ifndef __NEIGHBORLISTBUFFERTUNER_H__
+#define __NEIGHBORLISTBUFFERTUNER_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Continuously tunes the neighbor list buffer and rebuild check delay
+/*! Each call to update() ends a measurement interval. The tuner measures the wall clock time per
+    step over the interval, which includes the neighbor list builds and the pair force evaluations
+    that depend on the buffer, and the number of neighbor list builds in the interval.
+
+    The buffer follows a hill climbing search that never stops: the buffer moves by the current step
+    size in the current direction. The step grows while the time per step decreases. When the time
+    per step increases, the direction reverses and the step shrinks down to a minimum of
+    \a min_step_fraction of the buffer range. The tuner therefore keeps tracking the optimum as the
+    density changes, for example during an NPT compression.
+
+    The rebuild check delay is set to a quarter of the mean number of steps between builds, scaled
+    down when the buffer shrinks. Dangerous builds in an interval halve it.
+
+    The first interval of each run is discarded because it includes the time between runs.
+
+    \ingroup tuners
+*/
+class PYBIND11_EXPORT NeighborListBufferTuner : public Tuner
+    {
+    public:
+    //! Constructor
+    NeighborListBufferTuner(std::shared_ptr<SystemDefinition> sysdef,
+                            std::shared_ptr<Trigger> trigger,
+                            std::shared_ptr<NeighborList> nlist,
+                            Scalar minimum_buffer,
+                            Scalar maximum_buffer);
+
+    virtual ~NeighborListBufferTuner();
+
+    //! Measure the last interval and adjust the buffer
+    virtual void update(uint64_t timestep);
+
+    //! Start a new measurement at the beginning of each run
+    virtual void resetStats()
+        {
+        m_have_reference = false;
+        }
+
+    //! Set the smallest buffer to allow
+    void setMinimumBuffer(Scalar minimum_buffer)
+        {
+        if (minimum_buffer < Scalar(0.0))
+            {
+            throw std::domain_error("minimum_buffer must be non-negative.");
+            }
+        m_minimum_buffer = minimum_buffer;
+        }
+
+    //! Get the smallest buffer to allow
+    Scalar getMinimumBuffer()
+        {
+        return m_minimum_buffer;
+        }
+
+    //! Set the largest buffer to allow
+    void setMaximumBuffer(Scalar maximum_buffer)
+        {
+        if (maximum_buffer <= Scalar(0.0))
+            {
+            throw std::domain_error("maximum_buffer must be positive.");
+            }
+        m_maximum_buffer = maximum_buffer;
+        }
+
+    //! Get the largest buffer to allow
+    Scalar getMaximumBuffer()
+        {
+        return m_maximum_buffer;
+        }
+
+    //! Set the smallest step as a fraction of the buffer range
+    void setMinimumStepFraction(Scalar fraction)
+        {
+        if (fraction <= Scalar(0.0) || fraction > Scalar(1.0))
+            {
+            throw std::domain_error("min_step_fraction must be in the range (0, 1].");
+            }
+        m_min_step_fraction = fraction;
+        }
+
+    //! Get the smallest step as a fraction of the buffer range
+    Scalar getMinimumStepFraction()
+        {
+        return m_min_step_fraction;
+        }
+
+    //! Set whether the tuner also sets the rebuild check delay
+    void setTuneCheckDelay(bool tune_check_delay)
+        {
+        m_tune_check_delay = tune_check_delay;
+        }
+
+    //! Get whether the tuner also sets the rebuild check delay
+    bool getTuneCheckDelay()
+        {
+        return m_tune_check_delay;
+        }
+
+    //! Get the wall clock time per step measured over the last interval [s]
+    double getTimePerStep()
+        {
+        return m_last_cost / 1e9;
+        }
+
+    //! Get the fraction of the last interval spent in neighbor list builds
+    double getBuildFraction()
+        {
+        return m_last_build_fraction;
+        }
+
+    protected:
+    std::shared_ptr<NeighborList> m_nlist; //!< Neighbor list to tune
+
+    Scalar m_minimum_buffer;                  //!< Smallest buffer to allow
+    Scalar m_maximum_buffer;                  //!< Largest buffer to allow
+    Scalar m_min_step_fraction = Scalar(0.02); //!< Smallest step relative to the buffer range
+    bool m_tune_check_delay = true;            //!< True when the check delay is tuned
+
+    ClockSource m_clock;               //!< Wall clock
+    bool m_have_reference = false;     //!< True when the current interval has a start
+    int64_t m_reference_time = 0;      //!< Wall clock time at the start of the interval [ns]
+    uint64_t m_reference_timestep = 0; //!< Time step at the start of the interval
+    uint64_t m_reference_builds = 0;   //!< Number of builds at the start of the interval
+    uint64_t m_reference_dangerous = 0; //!< Number of dangerous builds at the start
+    double m_reference_build_time = 0;  //!< Build time at the start of the interval [s]
+
+    bool m_have_last = false;         //!< True when a previous interval has been measured
+    double m_last_cost = 0;           //!< Time per step in the last interval [ns]
+    double m_last_build_fraction = 0; //!< Fraction of the last interval spent in builds
+    Scalar m_step = 0;                //!< Current step of the buffer
+    Scalar m_direction = Scalar(1.0); //!< Current direction of the buffer steps
+
+    //! Record the start of a measurement interval
+    void setReference(uint64_t timestep);
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
@@ -78,7 +78,8 @@ bool NeighborListGPU::distanceCheck(uint64_t timestep)
         {
         // read back flags
         ArrayHandle<unsigned int> h_flags(m_flags, access_location::host, access_mode::read);
-        result = m_checkn == *h_flags.data;
+        result = m_checkn == h_flags.data[0];
+        m_rebuild_trigger_type = result ? h_flags.data[1] : UINT_MAX;
         }
 
 #ifdef ENABLE_MPI
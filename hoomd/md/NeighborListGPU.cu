@@ -37,7 +37,8 @@ namespace kernel
 
     gpu_nlist_needs_update_check_new_kernel() executes one thread per particle. Every particle's
    current position is compared to its last position. If the particle has moved a distance more than
-   the buffer width, then *d_result is set to \a checkn.
+   the buffer width, then *d_result is set to \a checkn and d_result[1] to the type of one such
+   particle.
 */
 __global__ void gpu_nlist_needs_update_check_new_kernel(unsigned int* d_result,
                                                         const Scalar4* d_last_pos,
@@ -75,11 +76,15 @@ __global__ void gpu_nlist_needs_update_check_new_kernel(unsigned int* d_result,
         Scalar maxshiftsq = (delta_max > 0) ? delta_max * delta_max : 0.0f;
 
         if (dot(dx, dx) >= maxshiftsq)
+            {
 #if (__CUDA_ARCH__ >= 600)
             atomicMax_system(d_result, checkn);
 #else
             atomicMax(d_result, checkn);
 #endif
+            // any of the triggering particles may record its type
+            d_result[1] = cur_type;
+            }
         }
     }
 
@@ -40,7 +40,7 @@ class PYBIND11_EXPORT NeighborListGPU : public NeighborList
         {
         m_exec_conf->msg->notice(5) << "Constructing NeighborlistGPU" << std::endl;
 
-        GlobalArray<unsigned int> flags(1, m_exec_conf);
+        GlobalArray<unsigned int> flags(2, m_exec_conf);
         std::swap(m_flags, flags);
         TAG_ALLOCATION(m_flags);
 
@@ -59,7 +59,8 @@ class PYBIND11_EXPORT NeighborListGPU : public NeighborList
             ArrayHandle<unsigned int> h_flags(m_flags,
                                               access_location::host,
                                               access_mode::overwrite);
-            *h_flags.data = 0;
+            h_flags.data[0] = 0;
+            h_flags.data[1] = 0;
             }
 
         // default to full mode
@@ -98,7 +99,7 @@ class PYBIND11_EXPORT NeighborListGPU : public NeighborList
     virtual void updateExListIdx();
 
     protected:
-    GlobalArray<unsigned int> m_flags; //!< Storage for device flags on the GPU
+    GlobalArray<unsigned int> m_flags; //!< Distance check result and the type that triggered it
 
     GlobalArray<size_t> m_req_size_nlist; //!< Flag to hold the required size of the neighborlist
 
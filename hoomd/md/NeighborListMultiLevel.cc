@@ -0,0 +1,402 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file NeighborListMultiLevel.cc
+    \brief Defines NeighborListMultiLevel
+*/
+
+#include "NeighborListMultiLevel.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/Communicator.h"
+#endif
+
+#include <algorithm>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace
+    {
+//! Find the range of cells along one direction that overlap a sphere
+/*! \param c Position of the center in units of the cell width
+    \param r Radius of the sphere in units of the cell width
+    \param n Number of cells along the direction
+    \param periodic True when the direction is periodic
+    \param lo Set to the first cell of the range
+    \param hi Set to the last cell of the range
+
+    In periodic directions the range may extend by less than one grid length outside of the grid.
+*/
+inline void cellRange(Scalar c, Scalar r, unsigned int n, bool periodic, int& lo, int& hi)
+    {
+    lo = int(floor(c - r));
+    hi = int(floor(c + r));
+    if (periodic)
+        {
+        // visit every cell only once when the sphere spans the whole grid
+        if (hi - lo + 1 >= int(n))
+            {
+            lo = 0;
+            hi = int(n) - 1;
+            }
+        }
+    else
+        {
+        lo = max(lo, 0);
+        hi = min(hi, int(n) - 1);
+        }
+    }
+
+//! Wrap a cell index from cellRange() into the grid
+inline int wrapCell(int c, unsigned int n)
+    {
+    if (c < 0)
+        return c + int(n);
+    if (c >= int(n))
+        return c - int(n);
+    return c;
+    }
+    } // end anonymous namespace
+
+/*!
+ * \param sysdef System definition
+ * \param r_buff Neighbor list buffer width
+ */
+NeighborListMultiLevel::NeighborListMultiLevel(std::shared_ptr<SystemDefinition> sysdef,
+                                               Scalar r_buff)
+    : NeighborList(sysdef, r_buff)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing NeighborListMultiLevel" << endl;
+    }
+
+NeighborListMultiLevel::~NeighborListMultiLevel()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying NeighborListMultiLevel" << endl;
+    }
+
+/*! The interacting types are ordered by their size, the cutoff radius with themselves or the
+    largest cutoff radius when they do not interact with themselves. Each level starts with the
+    smallest remaining type and takes all types up to level_ratio times its size. The cell lists of
+    the current levels are reused.
+*/
+void NeighborListMultiLevel::updateLevels()
+    {
+    ArrayHandle<Scalar> h_r_cut(m_r_cut, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_rcut_max(m_rcut_max, access_location::host, access_mode::read);
+    const unsigned int n_types = m_pdata->getNTypes();
+
+    std::vector<std::pair<Scalar, unsigned int>> sizes;
+    for (unsigned int cur_type = 0; cur_type < n_types; ++cur_type)
+        {
+        if (h_rcut_max.data[cur_type] <= Scalar(0.0))
+            continue;
+
+        const Scalar self = h_r_cut.data[m_typpair_idx(cur_type, cur_type)];
+        sizes.push_back(
+            std::make_pair(self > Scalar(0.0) ? self : h_rcut_max.data[cur_type], cur_type));
+        }
+    std::sort(sizes.begin(), sizes.end());
+
+    std::vector<std::vector<unsigned int>> level_types;
+    Scalar level_min = 0.0;
+    for (const auto& size : sizes)
+        {
+        if (level_types.empty() || size.first > level_ratio * level_min)
+            {
+            level_types.emplace_back();
+            level_min = size.first;
+            }
+        level_types.back().push_back(size.second);
+        }
+
+    m_levels.resize(level_types.size());
+    for (unsigned int cur_level = 0; cur_level < m_levels.size(); ++cur_level)
+        {
+        Level& level = m_levels[cur_level];
+        if (!level.cl)
+            {
+            level.cl = std::make_shared<CellList>(m_sysdef);
+            level.cl->setRadius(1);
+            level.cl->setComputeTypeBody(true);
+            level.cl->setFlagIndex();
+            level.cl->setComputeAdjList(false);
+            level.cl->setSortByType(true);
+            level.cl->setSortCellList(m_deterministic);
+            }
+        level.types = level_types[cur_level];
+
+        // the cells are as wide as the largest list radius within the level, or as the largest
+        // list radius of its types when they only interact with the other levels
+        std::vector<bool> type_filter(n_types, false);
+        Scalar width = 0.0;
+        for (unsigned int type_a : level.types)
+            {
+            type_filter[type_a] = true;
+            for (unsigned int type_b : level.types)
+                {
+                const Scalar r_cut = h_r_cut.data[m_typpair_idx(type_a, type_b)];
+                if (r_cut > Scalar(0.0))
+                    width = max(width, r_cut + m_r_buff);
+                }
+            }
+        if (width <= Scalar(0.0))
+            {
+            for (unsigned int type_a : level.types)
+                width = max(width, h_rcut_max.data[type_a] + m_r_buff);
+            }
+        level.cl->setTypeFilter(type_filter);
+        level.cl->setNominalWidth(width);
+
+        // the particles of each type search the cells of the level within their largest list
+        // radius with the types of the level
+        level.r_search.assign(n_types, Scalar(-1.0));
+        for (unsigned int type_i = 0; type_i < n_types; ++type_i)
+            {
+            for (unsigned int type_j : level.types)
+                {
+                const Scalar r_cut = h_r_cut.data[m_typpair_idx(type_i, type_j)];
+                if (r_cut > Scalar(0.0))
+                    level.r_search[type_i] = max(level.r_search[type_i], r_cut + m_r_buff);
+                }
+            }
+        }
+    }
+
+void NeighborListMultiLevel::buildNlist(uint64_t timestep)
+    {
+    if (m_update_levels)
+        {
+        updateLevels();
+        m_update_levels = false;
+        }
+
+    for (auto& level : m_levels)
+        {
+        // group the constituents of each body in the cells so that they can be skipped together
+        level.cl->setGroupBodies(m_filter_body);
+        level.cl->compute(timestep);
+        }
+
+    const BoxDim& box = m_pdata->getBox();
+    Scalar3 nearest_plane_distance = box.getNearestPlaneDistance();
+
+    // validate that the cutoff fits inside the box
+    Scalar rmax = getMaxRCut() + m_r_buff;
+
+    if ((box.getPeriodic().x && nearest_plane_distance.x <= rmax * 2.0)
+        || (box.getPeriodic().y && nearest_plane_distance.y <= rmax * 2.0)
+        || (this->m_sysdef->getNDimensions() == 3 && box.getPeriodic().z
+            && nearest_plane_distance.z <= rmax * 2.0))
+        {
+        std::ostringstream oss;
+        oss << "nlist: Simulation box is too small! Particles would be interacting with themselves."
+            << "rmax=" << rmax << std::endl;
+
+        if (box.getPeriodic().x)
+            oss << "nearest_plane_distance.x=" << nearest_plane_distance.x << std::endl;
+        if (box.getPeriodic().y)
+            oss << "nearest_plane_distance.y=" << nearest_plane_distance.y << std::endl;
+        if (this->m_sysdef->getNDimensions() == 3 && box.getPeriodic().z)
+            oss << "nearest_plane_distance.z=" << nearest_plane_distance.z << std::endl;
+        throw std::runtime_error(oss.str());
+        }
+
+        {
+        ArrayHandle<unsigned int> h_n_neigh(m_n_neigh,
+                                            access_location::host,
+                                            access_mode::overwrite);
+        memset(h_n_neigh.data, 0, sizeof(unsigned int) * m_pdata->getN());
+        }
+
+    // each level appends the neighbors of its types
+    for (const auto& level : m_levels)
+        buildLevel(level);
+    }
+
+/*! \param level Level to search
+
+    Every particle visits the cells of the level that overlap the sphere of its largest list radius
+    with the types of the level. Only the members of the types of the level that interact with the
+    particle are read in each cell.
+*/
+void NeighborListMultiLevel::buildLevel(const Level& level)
+    {
+    const uint3 dim = level.cl->getDim();
+    const Scalar3 ghost_width = level.cl->getGhostWidth();
+    const Scalar3 cell_width = level.cl->getCellWidth();
+    const bool is_2d = m_sysdef->getNDimensions() == 2;
+
+    // acquire the particle data and box dimension
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                     access_location::host,
+                                     access_mode::read);
+
+    const BoxDim& box = m_pdata->getBox();
+    uchar3 periodic = box.getPeriodic();
+
+    // access the rlist data
+    ArrayHandle<Scalar> h_r_cut(m_r_cut, access_location::host, access_mode::read);
+
+    // access the cell list data arrays
+    ArrayHandle<Scalar4> h_cell_xyzf(level.cl->getXYZFArray(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<uint2> h_cell_type_body(level.cl->getTypeBodyArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> h_cell_type_offsets(level.cl->getTypeOffsetArray(),
+                                                  access_location::host,
+                                                  access_mode::read);
+    std::unique_ptr<ArrayHandle<unsigned int>> h_cell_body_run_end;
+    if (m_filter_body)
+        {
+        h_cell_body_run_end.reset(new ArrayHandle<unsigned int>(level.cl->getBodyRunEndArray(),
+                                                                access_location::host,
+                                                                access_mode::read));
+        }
+
+    // access the neighbor list data
+    ArrayHandle<size_t> h_head_list(m_head_list, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_conditions(m_conditions,
+                                           access_location::host,
+                                           access_mode::readwrite);
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::readwrite);
+
+    // access indexers
+    Index3D ci = level.cl->getCellIndexer();
+    Index2D cli = level.cl->getCellListIndexer();
+    Index2D cti = level.cl->getTypeOffsetIndexer();
+
+    // for each local particle
+    unsigned int nparticles = m_pdata->getN();
+
+    for (int i = 0; i < (int)nparticles; i++)
+        {
+        const Scalar3 my_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
+        const unsigned int body_i = h_body.data[i];
+
+        const Scalar r_search = level.r_search[type_i];
+        if (r_search <= Scalar(0.0))
+            continue;
+
+        const unsigned int Nmax_i = h_Nmax.data[type_i];
+        const size_t head_idx_i = h_head_list.data[i];
+        unsigned int cur_n_neigh = h_n_neigh.data[i];
+
+        // find the range of cells that overlap the search sphere
+        Scalar3 f = box.makeFraction(my_pos, ghost_width);
+        int lo_x, hi_x, lo_y, hi_y, lo_z = 0, hi_z = 0;
+        cellRange(f.x * dim.x, r_search / cell_width.x, dim.x, periodic.x, lo_x, hi_x);
+        cellRange(f.y * dim.y, r_search / cell_width.y, dim.y, periodic.y, lo_y, hi_y);
+        if (!is_2d)
+            cellRange(f.z * dim.z, r_search / cell_width.z, dim.z, periodic.z, lo_z, hi_z);
+
+        for (int skb = lo_z; skb <= hi_z; ++skb)
+            {
+            const int kb = wrapCell(skb, dim.z);
+            for (int sjb = lo_y; sjb <= hi_y; ++sjb)
+                {
+                const int jb = wrapCell(sjb, dim.y);
+                for (int sib = lo_x; sib <= hi_x; ++sib)
+                    {
+                    const unsigned int neigh_cell = ci(wrapCell(sib, dim.x), jb, kb);
+
+                    // the members of the neighboring bin are grouped by type, skip the types that
+                    // do not interact with type_i without reading their members
+                    for (unsigned int type_j : level.types)
+                        {
+                        const unsigned int type_begin
+                            = h_cell_type_offsets.data[cti(type_j, neigh_cell)];
+                        const unsigned int type_end
+                            = h_cell_type_offsets.data[cti(type_j + 1, neigh_cell)];
+                        if (type_begin == type_end)
+                            continue;
+
+                        // read cutoff and skip if pair is inactive
+                        Scalar r_cut = h_r_cut.data[m_typpair_idx(type_i, type_j)];
+                        if (r_cut <= Scalar(0.0))
+                            continue;
+
+                        // compute the rlist based on the particle type we're interacting with
+                        Scalar r_list = r_cut + m_r_buff;
+                        Scalar r_listsq = r_list * r_list;
+
+                        for (unsigned int cur_offset = type_begin; cur_offset < type_end;
+                             cur_offset++)
+                            {
+                            // skip all the members of the same body in this bin at once
+                            if (m_filter_body && body_i != NO_BODY
+                                && body_i == h_cell_type_body.data[cli(cur_offset, neigh_cell)].y)
+                                {
+                                cur_offset
+                                    = h_cell_body_run_end->data[cli(cur_offset, neigh_cell)] - 1;
+                                continue;
+                                }
+
+                            const Scalar4& neigh_xyzf
+                                = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
+                            unsigned int cur_neigh = __scalar_as_int(neigh_xyzf.w);
+
+                            // a particle cannot neighbor itself
+                            if (i == (int)cur_neigh)
+                                continue;
+
+                            Scalar3 neigh_pos
+                                = make_scalar3(neigh_xyzf.x, neigh_xyzf.y, neigh_xyzf.z);
+                            Scalar3 dx = my_pos - neigh_pos;
+                            dx = box.minImage(dx);
+
+                            Scalar dr_sq = dot(dx, dx);
+
+                            if (dr_sq <= r_listsq)
+                                {
+                                if (m_storage_mode == full || i < (int)cur_neigh)
+                                    {
+                                    // local neighbor
+                                    if (cur_n_neigh < Nmax_i)
+                                        {
+                                        h_nlist.data[head_idx_i + cur_n_neigh] = cur_neigh;
+                                        }
+                                    else
+                                        h_conditions.data[type_i]
+                                            = max(h_conditions.data[type_i], cur_n_neigh + 1);
+
+                                    ++cur_n_neigh;
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+        h_n_neigh.data[i] = cur_n_neigh;
+        }
+    }
+
+namespace detail
+    {
+void export_NeighborListMultiLevel(pybind11::module& m)
+    {
+    pybind11::class_<NeighborListMultiLevel, NeighborList, std::shared_ptr<NeighborListMultiLevel>>(
+        m,
+        "NeighborListMultiLevel")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>, Scalar>())
+        .def_property("deterministic",
+                      &NeighborListMultiLevel::getDeterministic,
+                      &NeighborListMultiLevel::setDeterministic)
+        .def_property_readonly("num_levels", &NeighborListMultiLevel::getNumLevels)
+        .def_property_readonly("level_widths", &NeighborListMultiLevel::getLevelWidths);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,112 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "NeighborList.h"
+#include "hoomd/CellList.h"
+
+/*! \file NeighborListMultiLevel.h
+    \brief Declares the NeighborListMultiLevel class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+#include <vector>
+
+#ifndef __NEIGHBORLISTMULTILEVEL_H__
+#define __NEIGHBORLISTMULTILEVEL_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Efficient neighbor list build on the CPU with a hierarchy of cell lists
+/*! The particle types are grouped into levels by the size of their cutoff radius with themselves.
+    The ratio of the largest to the smallest size in a level is at most level_ratio. Each level bins
+    only the particles of its types in a cell list with a width set by the largest cutoff radius
+    between the types of the level.
+
+    A particle finds its neighbors of the types in each level by visiting the cells of that level
+    that overlap its list radius with the types of the level. Large particles thereby search few
+    large cells for other large particles and many small cells for small particles, while small
+    particles search small cells for small particles and only the one to eight large cells around
+    them for large particles.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT NeighborListMultiLevel : public NeighborList
+    {
+    public:
+    //! Constructs the compute
+    NeighborListMultiLevel(std::shared_ptr<SystemDefinition> sysdef, Scalar r_buff);
+
+    //! Destructor
+    virtual ~NeighborListMultiLevel();
+
+    /// Notify NeighborList that a r_cut matrix value has changed
+    virtual void notifyRCutMatrixChange()
+        {
+        m_update_levels = true;
+        NeighborList::notifyRCutMatrixChange();
+        }
+
+    void setDeterministic(bool deterministic)
+        {
+        m_deterministic = deterministic;
+        for (auto& level : m_levels)
+            level.cl->setSortCellList(deterministic);
+        }
+
+    bool getDeterministic()
+        {
+        return m_deterministic;
+        }
+
+    //! Get the number of levels
+    unsigned int getNumLevels()
+        {
+        return (unsigned int)m_levels.size();
+        }
+
+    //! Get the cell width of each level
+    std::vector<Scalar> getLevelWidths()
+        {
+        std::vector<Scalar> widths;
+        for (const auto& level : m_levels)
+            widths.push_back(level.cl->getNominalWidth());
+        return widths;
+        }
+
+    //! Maximum ratio of the largest to the smallest cutoff radius of the types in a level
+    static constexpr Scalar level_ratio = 2.0;
+
+    protected:
+    //! Builds the neighbor list
+    virtual void buildNlist(uint64_t timestep);
+
+    private:
+    //! A level of the hierarchy
+    struct Level
+        {
+        std::shared_ptr<CellList> cl;    //!< Cell list of the particles of the level
+        std::vector<unsigned int> types; //!< Types of the level
+        std::vector<Scalar> r_search;    //!< Largest list radius of each type with the level
+        };
+
+    std::vector<Level> m_levels;  //!< The levels, from the smallest to the largest cells
+    bool m_deterministic = false; //!< Flag to sort the cell lists
+    bool m_update_levels = true;  //!< Flag for updating the levels
+
+    //! Group the types into levels
+    void updateLevels();
+
+    //! Add the neighbors of the particles of one level
+    void buildLevel(const Level& level);
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __NEIGHBORLISTMULTILEVEL_H__
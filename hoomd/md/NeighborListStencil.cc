@@ -36,6 +36,7 @@ NeighborListStencil::NeighborListStencil(std::shared_ptr<SystemDefinition> sysde
     m_cl->setComputeTypeBody(true);
     m_cl->setFlagIndex();
     m_cl->setComputeAdjList(false);
+    m_cl->setSortByType(true);
     }
 
 NeighborListStencil::~NeighborListStencil()
@@ -74,6 +75,8 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
         m_update_cell_size = false;
         }
 
+    // group the constituents of each body in the cells so that they can be skipped together
+    m_cl->setGroupBodies(m_filter_body);
     m_cl->compute(timestep);
 
     // update the stencil radii if there was a change
@@ -133,6 +136,16 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
     ArrayHandle<uint2> h_cell_type_body(m_cl->getTypeBodyArray(),
                                         access_location::host,
                                         access_mode::read);
+    ArrayHandle<unsigned int> h_cell_type_offsets(m_cl->getTypeOffsetArray(),
+                                                  access_location::host,
+                                                  access_mode::read);
+    std::unique_ptr<ArrayHandle<unsigned int>> h_cell_body_run_end;
+    if (m_filter_body)
+        {
+        h_cell_body_run_end.reset(new ArrayHandle<unsigned int>(m_cl->getBodyRunEndArray(),
+                                                                access_location::host,
+                                                                access_mode::read));
+        }
     ArrayHandle<Scalar4> h_stencil(m_cls->getStencils(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_n_stencil(m_cls->getStencilSizes(),
                                           access_location::host,
@@ -151,6 +164,8 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
     // access indexers
     Index3D ci = m_cl->getCellIndexer();
     Index2D cli = m_cl->getCellListIndexer();
+    Index2D cti = m_cl->getTypeOffsetIndexer();
+    const unsigned int n_types = m_pdata->getNTypes();
 
     // for each local particle
     unsigned int nparticles = m_pdata->getN();
@@ -237,18 +252,13 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
 
             unsigned int neigh_cell = ci(sib, sjb, skb);
 
-            // check against all the particles in that neighboring bin to see if it is a neighbor
-            unsigned int size = h_cell_size.data[neigh_cell];
-            for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
+            // the members of the neighboring bin are grouped by type, skip the types that do not
+            // interact with type_i or that are beyond the list cutoff without reading their members
+            for (unsigned int type_j = 0; type_j < n_types; type_j++)
                 {
-                // read in the particle type (diameter and body as well while we've got the Scalar4
-                // in)
-                const uint2& neigh_type_body = h_cell_type_body.data[cli(cur_offset, neigh_cell)];
-                const unsigned int type_j = neigh_type_body.x;
-                const unsigned int body_j = neigh_type_body.y;
-
-                // skip any particles belonging to the same body if requested
-                if (m_filter_body && body_i != NO_BODY && body_i == body_j)
+                const unsigned int type_begin = h_cell_type_offsets.data[cti(type_j, neigh_cell)];
+                const unsigned int type_end = h_cell_type_offsets.data[cti(type_j + 1, neigh_cell)];
+                if (type_begin == type_end)
                     continue;
 
                 // read cutoff and skip if pair is inactive
@@ -265,34 +275,47 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
                 if (cell_dist2 > r_listsq)
                     continue;
 
-                // only load in the particle position and id if distance check is satisfied
-                const Scalar4& neigh_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
-                unsigned int cur_neigh = __scalar_as_int(neigh_xyzf.w);
+                // check against all the particles of this type in the neighboring bin to see if it
+                // is a neighbor
+                for (unsigned int cur_offset = type_begin; cur_offset < type_end; cur_offset++)
+                    {
+                    // skip all the members of the same body in this bin at once
+                    if (m_filter_body && body_i != NO_BODY
+                        && body_i == h_cell_type_body.data[cli(cur_offset, neigh_cell)].y)
+                        {
+                        cur_offset = h_cell_body_run_end->data[cli(cur_offset, neigh_cell)] - 1;
+                        continue;
+                        }
 
-                // a particle cannot neighbor itself
-                if (i == (int)cur_neigh)
-                    continue;
+                    // only load in the particle position and id if distance check is satisfied
+                    const Scalar4& neigh_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
+                    unsigned int cur_neigh = __scalar_as_int(neigh_xyzf.w);
 
-                Scalar3 neigh_pos = make_scalar3(neigh_xyzf.x, neigh_xyzf.y, neigh_xyzf.z);
-                Scalar3 dx = my_pos - neigh_pos;
-                dx = box.minImage(dx);
+                    // a particle cannot neighbor itself
+                    if (i == (int)cur_neigh)
+                        continue;
 
-                Scalar dr_sq = dot(dx, dx);
+                    Scalar3 neigh_pos = make_scalar3(neigh_xyzf.x, neigh_xyzf.y, neigh_xyzf.z);
+                    Scalar3 dx = my_pos - neigh_pos;
+                    dx = box.minImage(dx);
 
-                if (dr_sq <= r_listsq)
-                    {
-                    if (m_storage_mode == full || i < (int)cur_neigh)
+                    Scalar dr_sq = dot(dx, dx);
+
+                    if (dr_sq <= r_listsq)
                         {
-                        // local neighbor
-                        if (cur_n_neigh < Nmax_i)
+                        if (m_storage_mode == full || i < (int)cur_neigh)
                             {
-                            h_nlist.data[head_idx_i + cur_n_neigh] = cur_neigh;
+                            // local neighbor
+                            if (cur_n_neigh < Nmax_i)
+                                {
+                                h_nlist.data[head_idx_i + cur_n_neigh] = cur_neigh;
+                                }
+                            else
+                                h_conditions.data[type_i]
+                                    = max(h_conditions.data[type_i], cur_n_neigh + 1);
+
+                            ++cur_n_neigh;
                             }
-                        else
-                            h_conditions.data[type_i]
-                                = max(h_conditions.data[type_i], cur_n_neigh + 1);
-
-                        ++cur_n_neigh;
                         }
                     }
                 }
@@ -30,6 +30,8 @@ NeighborListTree::NeighborListTree(std::shared_ptr<SystemDefinition> sysdef, Sca
         .connect<NeighborListTree, &NeighborListTree::slotMaxNumChanged>(this);
     m_pdata->getParticleSortSignal()
         .connect<NeighborListTree, &NeighborListTree::slotRemapParticles>(this);
+
+    m_builds_image_shifts = true;
     }
 
 NeighborListTree::~NeighborListTree()
@@ -156,6 +158,7 @@ void NeighborListTree::updateImageVectors()
     if (m_n_images > m_image_list.size())
         {
         m_image_list.resize(m_n_images);
+        m_image_code.resize(m_n_images);
         }
 
     vec3<Scalar> latt_a = vec3<Scalar>(box.getLatticeVector(0));
@@ -164,6 +167,7 @@ void NeighborListTree::updateImageVectors()
 
     // there is always at least 1 image, which we put as our first thing to look at
     m_image_list[0] = vec3<Scalar>(0.0, 0.0, 0.0);
+    m_image_code[0] = 13;
 
     // iterate over all other combinations of images, skipping those that are
     unsigned int n_images = 1;
@@ -185,6 +189,10 @@ void NeighborListTree::updateImageVectors()
 
                     m_image_list[n_images]
                         = Scalar(i) * latt_a + Scalar(j) * latt_b + Scalar(k) * latt_c;
+                    // neighbors found with this translation of particle i are in the opposite
+                    // image
+                    m_image_code[n_images]
+                        = (unsigned char)((1 - i) + 3 * (1 - j) + 9 * (1 - k));
                     ++n_images;
                     }
                 }
@@ -257,13 +265,28 @@ void NeighborListTree::buildTree()
         }
 
     // call the tree build routine, one tree per type
-    for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
-        {
-        if (m_num_per_type[i] > 0)
+    auto build_trees = [&](bool parallel)
+    {
+        for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
             {
-            m_aabb_trees[i].buildTree(&(h_aabbs.data[0]) + m_type_head[i], m_num_per_type[i]);
+            if (m_num_per_type[i] > 0)
+                {
+                m_aabb_trees[i].buildTree(&(h_aabbs.data[0]) + m_type_head[i],
+                                          m_num_per_type[i],
+                                          parallel);
+                }
             }
+    };
+
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        m_exec_conf->getTaskArena()->execute([&] { build_trees(true); });
+        return;
         }
+#endif
+
+    build_trees(false);
     }
 
 /*!
@@ -292,104 +315,118 @@ void NeighborListTree::traverseTree()
                                            access_mode::readwrite);
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned char> h_nlist_image(m_nlist_image,
+                                             access_location::host,
+                                             access_mode::overwrite);
+    unsigned char* nlist_image = m_image_shifts_active ? h_nlist_image.data : nullptr;
 
-    // Loop over all particles
-    for (unsigned int i = 0; i < m_pdata->getN(); ++i)
-        {
-        // read in the current position and orientation
-        const Scalar4 postype_i = h_postype.data[i];
-        const vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
-        const unsigned int type_i = __scalar_as_int(postype_i.w);
-        const unsigned int body_i = h_body.data[i];
-
-        const unsigned int Nmax_i = h_Nmax.data[type_i];
-        const size_t nlist_head_i = h_head_list.data[i];
-
-        unsigned int n_neigh_i = 0;
-        for (unsigned int cur_pair_type = 0; cur_pair_type < m_pdata->getNTypes();
-             ++cur_pair_type) // loop on pair types
+    // traverse the trees for the local particles in [begin, end)
+    auto traverse = [&](unsigned int begin, unsigned int end, unsigned int* conditions)
+    {
+        for (unsigned int i = begin; i < end; ++i)
             {
-            // pass on empty types
-            if (!m_num_per_type[cur_pair_type])
-                continue;
-
-            // Check if this tree type should be excluded by r_cut(i,j) <= 0.0
-            Scalar r_cut = h_r_cut.data[m_typpair_idx(type_i, cur_pair_type)];
-            if (r_cut <= Scalar(0.0))
-                continue;
+            // read in the current position and orientation
+            const Scalar4 postype_i = h_postype.data[i];
+            const vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+            const unsigned int type_i = __scalar_as_int(postype_i.w);
+            const unsigned int body_i = h_body.data[i];
+
+            const unsigned int Nmax_i = h_Nmax.data[type_i];
+            const size_t nlist_head_i = h_head_list.data[i];
+
+            unsigned int n_neigh_i = 0;
+            for (unsigned int cur_pair_type = 0; cur_pair_type < m_pdata->getNTypes();
+                 ++cur_pair_type) // loop on pair types
+                {
+                // pass on empty types
+                if (!m_num_per_type[cur_pair_type])
+                    continue;
 
-            // Determine the minimum r_cut_i (with buffer) for this particle
-            Scalar r_cut_i = r_cut + m_r_buff;
-            Scalar r_cutsq_i = r_cut_i * r_cut_i;
-            Scalar r_list_i = r_cut_i;
+                // Check if this tree type should be excluded by r_cut(i,j) <= 0.0
+                Scalar r_cut = h_r_cut.data[m_typpair_idx(type_i, cur_pair_type)];
+                if (r_cut <= Scalar(0.0))
+                    continue;
 
-            hoomd::detail::AABBTree* cur_aabb_tree = &m_aabb_trees[cur_pair_type];
+                // Determine the minimum r_cut_i (with buffer) for this particle
+                Scalar r_cut_i = r_cut + m_r_buff;
+                Scalar r_cutsq_i = r_cut_i * r_cut_i;
+                Scalar r_list_i = r_cut_i;
 
-            for (unsigned int cur_image = 0; cur_image < m_n_images;
-                 ++cur_image) // for each image vector
-                {
-                // make an AABB for the image of this particle
-                vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
-                hoomd::detail::AABB aabb = hoomd::detail::AABB(pos_i_image, r_list_i);
+                hoomd::detail::AABBTree* cur_aabb_tree = &m_aabb_trees[cur_pair_type];
 
-                // stackless traversal of the tree
-                for (unsigned int cur_node_idx = 0; cur_node_idx < cur_aabb_tree->getNumNodes();
-                     ++cur_node_idx)
+                for (unsigned int cur_image = 0; cur_image < m_n_images;
+                     ++cur_image) // for each image vector
                     {
-                    if (aabb.overlaps(cur_aabb_tree->getNodeAABB(cur_node_idx)))
+                    // make an AABB for the image of this particle
+                    vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
+                    hoomd::detail::AABB aabb = hoomd::detail::AABB(pos_i_image, r_list_i);
+
+                    // stackless traversal of the tree
+                    for (unsigned int cur_node_idx = 0; cur_node_idx < cur_aabb_tree->getNumNodes();
+                         ++cur_node_idx)
                         {
-                        if (cur_aabb_tree->isNodeLeaf(cur_node_idx))
+                        if (aabb.overlaps(cur_aabb_tree->getNodeAABB(cur_node_idx)))
                             {
-                            for (unsigned int cur_p = 0;
-                                 cur_p < cur_aabb_tree->getNodeNumParticles(cur_node_idx);
-                                 ++cur_p)
+                            if (cur_aabb_tree->isNodeLeaf(cur_node_idx))
                                 {
-                                // neighbor j
-                                unsigned int j
-                                    = cur_aabb_tree->getNodeParticleTag(cur_node_idx, cur_p);
+                                for (unsigned int cur_p = 0;
+                                     cur_p < cur_aabb_tree->getNodeNumParticles(cur_node_idx);
+                                     ++cur_p)
+                                    {
+                                    // neighbor j
+                                    unsigned int j
+                                        = cur_aabb_tree->getNodeParticleTag(cur_node_idx, cur_p);
 
-                                // skip self-interaction always
-                                bool excluded = (i == j);
+                                    // skip self-interaction always
+                                    bool excluded = (i == j);
 
-                                if (m_filter_body && body_i != NO_BODY)
-                                    excluded = excluded | (body_i == h_body.data[j]);
+                                    if (m_filter_body && body_i != NO_BODY)
+                                        excluded = excluded | (body_i == h_body.data[j]);
 
-                                if (!excluded)
-                                    {
-                                    // compute distance
-                                    Scalar4 postype_j = h_postype.data[j];
-                                    Scalar3 drij
-                                        = make_scalar3(postype_j.x, postype_j.y, postype_j.z)
-                                          - vec_to_scalar3(pos_i_image);
-                                    Scalar dr_sq = dot(drij, drij);
-
-                                    if (dr_sq <= r_cutsq_i)
+                                    if (!excluded)
                                         {
-                                        if (m_storage_mode == full || i < j)
+                                        // compute distance
+                                        Scalar4 postype_j = h_postype.data[j];
+                                        Scalar3 drij
+                                            = make_scalar3(postype_j.x, postype_j.y, postype_j.z)
+                                              - vec_to_scalar3(pos_i_image);
+                                        Scalar dr_sq = dot(drij, drij);
+
+                                        if (dr_sq <= r_cutsq_i)
                                             {
-                                            if (n_neigh_i < Nmax_i)
-                                                h_nlist.data[nlist_head_i + n_neigh_i] = j;
-                                            else
-                                                h_conditions.data[type_i]
-                                                    = max(h_conditions.data[type_i], n_neigh_i + 1);
-
-                                            ++n_neigh_i;
+                                            if (m_storage_mode == full || i < j)
+                                                {
+                                                if (n_neigh_i < Nmax_i)
+                                                    {
+                                                    h_nlist.data[nlist_head_i + n_neigh_i] = j;
+                                                    if (nlist_image)
+                                                        nlist_image[nlist_head_i + n_neigh_i]
+                                                            = m_image_code[cur_image];
+                                                    }
+                                                else
+                                                    conditions[type_i]
+                                                        = max(conditions[type_i], n_neigh_i + 1);
+
+                                                ++n_neigh_i;
+                                                }
                                             }
                                         }
                                     }
                                 }
                             }
-                        }
-                    else
-                        {
-                        // skip ahead
-                        cur_node_idx += cur_aabb_tree->getNodeSkip(cur_node_idx);
-                        }
-                    } // end stackless search
-                }     // end loop over images
-            }         // end loop over pair types
-        h_n_neigh.data[i] = n_neigh_i;
-        } // end loop over particles
+                        else
+                            {
+                            // skip ahead
+                            cur_node_idx += cur_aabb_tree->getNodeSkip(cur_node_idx);
+                            }
+                        } // end stackless search
+                    }     // end loop over images
+                }         // end loop over pair types
+            h_n_neigh.data[i] = n_neigh_i;
+            } // end loop over particles
+    };
+
+    buildNlistParticles(h_conditions.data, traverse);
     }
 
 namespace detail
@@ -89,6 +89,7 @@ class PYBIND11_EXPORT NeighborListTree : public NeighborList
         m_map_pid_tree; //!< Maps the particle id to its tag in tree for sorting
 
     std::vector<vec3<Scalar>> m_image_list; //!< List of translation vectors
+    std::vector<unsigned char> m_image_code; //!< Image of the neighbors found with each vector
     unsigned int m_n_images;                //!< The number of image vectors to check
 
     //! Driver for tree configuration
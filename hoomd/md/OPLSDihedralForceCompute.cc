@@ -2,6 +2,7 @@
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
 #include "OPLSDihedralForceCompute.h"
+#include "BondedForceThreads.h"
 
 #include <cmath>
 #include <iostream>
@@ -38,6 +39,10 @@ OPLSDihedralForceCompute::OPLSDihedralForceCompute(std::shared_ptr<SystemDefinit
     // allocate the parameters
     GPUArray<Scalar4> params(m_dihedral_data->getNTypes(), m_exec_conf);
     m_params.swap(params);
+
+    GPUArray<Scalar4> special_pair_params(m_dihedral_data->getNTypes(), m_exec_conf);
+    m_special_pair_params.swap(special_pair_params);
+    m_special_pair.resize(m_dihedral_data->getNTypes());
     }
 
 OPLSDihedralForceCompute::~OPLSDihedralForceCompute()
@@ -97,6 +102,59 @@ pybind11::dict OPLSDihedralForceCompute::getParams(std::string type)
     return params;
     }
 
+/*! \param type Name of the dihedral type
+    \param params Special pair parameters: epsilon, sigma, alpha, and r_cut
+
+    The special pair interaction of a type is disabled when r_cut is 0 or both epsilon and alpha
+    are 0.
+*/
+void OPLSDihedralForceCompute::setSpecialPair(std::string type, pybind11::dict params)
+    {
+    auto typ = m_dihedral_data->getTypeByName(type);
+    dihedral_special_pair_params p(params);
+    if (p.r_cut < Scalar(0.0))
+        {
+        throw runtime_error("The special pair r_cut must not be negative.");
+        }
+
+    const bool enabled
+        = p.r_cut > Scalar(0.0) && (p.epsilon != Scalar(0.0) || p.alpha != Scalar(0.0));
+    if (enabled && m_exec_conf->isCUDAEnabled())
+        {
+        throw runtime_error("OPLS dihedral special pairs are not supported on the GPU.");
+        }
+
+    m_special_pair[typ] = p;
+
+    ArrayHandle<Scalar4> h_special_pair_params(m_special_pair_params,
+                                               access_location::host,
+                                               access_mode::readwrite);
+    if (enabled)
+        {
+        Scalar sigma_6 = p.sigma * p.sigma * p.sigma * p.sigma * p.sigma * p.sigma;
+        Scalar lj2 = Scalar(4.0) * p.epsilon * sigma_6;
+        h_special_pair_params.data[typ]
+            = make_scalar4(lj2 * sigma_6, lj2, p.alpha, p.r_cut * p.r_cut);
+        }
+    else
+        {
+        h_special_pair_params.data[typ] = make_scalar4(0, 0, 0, 0);
+        }
+
+    m_has_special_pairs = false;
+    for (unsigned int i = 0; i < m_dihedral_data->getNTypes(); i++)
+        {
+        if (h_special_pair_params.data[i].w > Scalar(0.0))
+            m_has_special_pairs = true;
+        }
+    }
+
+pybind11::dict OPLSDihedralForceCompute::getSpecialPair(std::string type)
+    {
+    auto typ = m_dihedral_data->getTypeByName(type);
+    return m_special_pair[typ].asDict();
+    }
+
 /*! Actually perform the force computation
     \param timestep Current time step
  */
@@ -105,7 +163,9 @@ void OPLSDihedralForceCompute::computeForces(uint64_t timestep)
     assert(m_pdata);
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<ImproperData::members_t> h_dihedral_idx(m_dihedral_data->getMemberIndexTable(),
+                                                        access_location::host,
+                                                        access_mode::read);
 
     // access the force and virial tensor arrays
     ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
@@ -113,6 +173,11 @@ void OPLSDihedralForceCompute::computeForces(uint64_t timestep)
 
     // access parameter data
     ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_special_pair_params(m_special_pair_params,
+                                               access_location::host,
+                                               access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    const bool has_special_pairs = m_has_special_pairs;
 
     // Zero data for force calculation before computation
     memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
@@ -122,241 +187,317 @@ void OPLSDihedralForceCompute::computeForces(uint64_t timestep)
     assert(h_force.data);
     assert(h_virial.data);
     assert(h_pos.data);
-    assert(h_rtag.data);
-
-    size_t virial_pitch = m_virial.getPitch();
-
-    // From LAMMPS OPLS dihedral implementation
-    unsigned int i1, i2, i3, i4, n, dihedral_type;
-    Scalar3 vb1, vb2, vb3, vb2m;
-
-    // this volatile is not strictly needed, but it works around a compiler bug on Mac arm64
-    // with Apple clang version 13.0.0 (clang-1300.0.29.30)
-    // without the volatile, the x component of f2 is always computed the same as the y component
-    volatile Scalar4 f1, f2, f3, f4;
-    Scalar ax, ay, az, bx, by, bz, rasq, rbsq, rgsq, rg, rginv, ra2inv, rb2inv, rabinv;
-    Scalar df, df1, ddf1, fg, hg, fga, hgb, gaa, gbb;
-    Scalar dtfx, dtfy, dtfz, dtgx, dtgy, dtgz, dthx, dthy, dthz;
-    Scalar c, s, p, sx2, sy2, sz2, cos_term, e_dihedral;
-    Scalar k1, k2, k3, k4;
-    Scalar dihedral_virial[6];
+    assert(h_dihedral_idx.data);
 
     // get a local copy of the simulation box
     const BoxDim& box = m_pdata->getBox();
 
+    PDataFlags flags = m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor];
+
+    ArrayHandle<ImproperData::members_t> h_dihedrals(m_dihedral_data->getMembersArray(),
+                                                     access_location::host,
+                                                     access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_dihedral_data->getTypeValArray(),
+                                     access_location::host,
+                                     access_mode::read);
+
     // iterate through each dihedral
     const unsigned int numDihedrals = (unsigned int)m_dihedral_data->getN();
-    for (n = 0; n < numDihedrals; n++)
-        {
-        // lookup the tag of each of the particles participating in the dihedral
-        const ImproperData::members_t& dihedral = m_dihedral_data->getMembersByIndex(n);
-        assert(dihedral.tag[0] < m_pdata->getNGlobal());
-        assert(dihedral.tag[1] < m_pdata->getNGlobal());
-        assert(dihedral.tag[2] < m_pdata->getNGlobal());
-        assert(dihedral.tag[3] < m_pdata->getNGlobal());
-
-        // i1 to i4 are the tags
-        i1 = h_rtag.data[dihedral.tag[0]];
-        i2 = h_rtag.data[dihedral.tag[1]];
-        i3 = h_rtag.data[dihedral.tag[2]];
-        i4 = h_rtag.data[dihedral.tag[3]];
-
-        // throw an error if this angle is incomplete
-        if (i1 == NOT_LOCAL || i2 == NOT_LOCAL || i3 == NOT_LOCAL || i4 == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error()
-                << "dihedral.opls: dihedral " << dihedral.tag[0] << " " << dihedral.tag[1] << " "
-                << dihedral.tag[2] << " " << dihedral.tag[3] << " incomplete." << endl
-                << endl;
-            throw std::runtime_error("Error in dihedral calculation");
-            }
-
-        assert(i1 < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(i2 < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(i3 < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(i4 < m_pdata->getN() + m_pdata->getNGhosts());
-
-        // 1st bond
-
-        vb1.x = h_pos.data[i1].x - h_pos.data[i2].x;
-        vb1.y = h_pos.data[i1].y - h_pos.data[i2].y;
-        vb1.z = h_pos.data[i1].z - h_pos.data[i2].z;
-
-        // 2nd bond
-
-        vb2.x = h_pos.data[i3].x - h_pos.data[i2].x;
-        vb2.y = h_pos.data[i3].y - h_pos.data[i2].y;
-        vb2.z = h_pos.data[i3].z - h_pos.data[i2].z;
-
-        // 3rd bond
-
-        vb3.x = h_pos.data[i4].x - h_pos.data[i3].x;
-        vb3.y = h_pos.data[i4].y - h_pos.data[i3].y;
-        vb3.z = h_pos.data[i4].z - h_pos.data[i3].z;
-
-        // apply periodic boundary conditions
-        vb1 = box.minImage(vb1);
-        vb2 = box.minImage(vb2);
-        vb3 = box.minImage(vb3);
-
-        vb2m.x = -vb2.x;
-        vb2m.y = -vb2.y;
-        vb2m.z = -vb2.z;
-        vb2m = box.minImage(vb2m);
-
-        // c,s calculation
-
-        ax = vb1.y * vb2m.z - vb1.z * vb2m.y;
-        ay = vb1.z * vb2m.x - vb1.x * vb2m.z;
-        az = vb1.x * vb2m.y - vb1.y * vb2m.x;
-        bx = vb3.y * vb2m.z - vb3.z * vb2m.y;
-        by = vb3.z * vb2m.x - vb3.x * vb2m.z;
-        bz = vb3.x * vb2m.y - vb3.y * vb2m.x;
-
-        rasq = ax * ax + ay * ay + az * az;
-        rbsq = bx * bx + by * by + bz * bz;
-        rgsq = vb2m.x * vb2m.x + vb2m.y * vb2m.y + vb2m.z * vb2m.z;
-        rg = sqrt(rgsq);
-
-        rginv = ra2inv = rb2inv = 0.0;
-        if (rg > 0)
-            rginv = 1.0 / rg;
-        if (rasq > 0)
-            ra2inv = 1.0 / rasq;
-        if (rbsq > 0)
-            rb2inv = 1.0 / rbsq;
-        rabinv = sqrt(ra2inv * rb2inv);
-
-        c = (ax * bx + ay * by + az * bz) * rabinv;
-        s = rg * rabinv * (ax * vb3.x + ay * vb3.y + az * vb3.z);
-
-        if (c > 1.0)
-            c = 1.0;
-        if (c < -1.0)
-            c = -1.0;
-
-        // get values for k1/2 through k4/2
-        // ----- The 1/2 factor is already stored in the parameters --------
-        dihedral_type = m_dihedral_data->getTypeByIndex(n);
-        k1 = h_params.data[dihedral_type].x;
-        k2 = h_params.data[dihedral_type].y;
-        k3 = h_params.data[dihedral_type].z;
-        k4 = h_params.data[dihedral_type].w;
-
-        // calculate the potential p = sum (i=1,4) k_i * (1 + (-1)**(i+1)*cos(i*phi) )
-        // and df = dp/dc
-
-        // cos(phi) term
-        ddf1 = c;
-        df1 = s;
-        cos_term = ddf1;
-
-        p = k1 * (1.0 + cos_term);
-        df = k1 * df1;
-
-        // cos(2*phi) term
-        ddf1 = cos_term * c - df1 * s;
-        df1 = cos_term * s + df1 * c;
-        cos_term = ddf1;
-
-        p += k2 * (1.0 - cos_term);
-        df += -2.0 * k2 * df1;
-
-        // cos(3*phi) term
-        ddf1 = cos_term * c - df1 * s;
-        df1 = cos_term * s + df1 * c;
-        cos_term = ddf1;
-
-        p += k3 * (1.0 + cos_term);
-        df += 3.0 * k3 * df1;
-
-        // cos(4*phi) term
-        ddf1 = cos_term * c - df1 * s;
-        df1 = cos_term * s + df1 * c;
-        cos_term = ddf1;
-
-        p += k4 * (1.0 - cos_term);
-        df += -4.0 * k4 * df1;
-
-        // Compute 1/4 of energy to assign to each of 4 atoms in the dihedral
-        e_dihedral = 0.25 * p;
-
-        fg = vb1.x * vb2m.x + vb1.y * vb2m.y + vb1.z * vb2m.z;
-        hg = vb3.x * vb2m.x + vb3.y * vb2m.y + vb3.z * vb2m.z;
-        fga = fg * ra2inv * rginv;
-        hgb = hg * rb2inv * rginv;
-        gaa = -ra2inv * rg;
-        gbb = rb2inv * rg;
-
-        dtfx = gaa * ax;
-        dtfy = gaa * ay;
-        dtfz = gaa * az;
-        dtgx = fga * ax - hgb * bx;
-        dtgy = fga * ay - hgb * by;
-        dtgz = fga * az - hgb * bz;
-        dthx = gbb * bx;
-        dthy = gbb * by;
-        dthz = gbb * bz;
-
-        sx2 = df * dtgx;
-        sy2 = df * dtgy;
-        sz2 = df * dtgz;
-
-        f1.x = df * dtfx;
-        f1.y = df * dtfy;
-        f1.z = df * dtfz;
-        f1.w = e_dihedral;
-
-        f2.x = sx2 - f1.x;
-        f2.y = sy2 - f1.y;
-        f2.z = sz2 - f1.z;
-        f2.w = e_dihedral;
-
-        f4.x = df * dthx;
-        f4.y = df * dthy;
-        f4.z = df * dthz;
-        f4.w = e_dihedral;
-
-        f3.x = -sx2 - f4.x;
-        f3.y = -sy2 - f4.y;
-        f3.z = -sz2 - f4.z;
-        f3.w = e_dihedral;
-
-        // Apply force to each of the 4 atoms
-        h_force.data[i1].x = h_force.data[i1].x + f1.x;
-        h_force.data[i1].y = h_force.data[i1].y + f1.y;
-        h_force.data[i1].z = h_force.data[i1].z + f1.z;
-        h_force.data[i1].w = h_force.data[i1].w + f1.w;
-        h_force.data[i2].x = h_force.data[i2].x + f2.x;
-        h_force.data[i2].y = h_force.data[i2].y + f2.y;
-        h_force.data[i2].z = h_force.data[i2].z + f2.z;
-        h_force.data[i2].w = h_force.data[i2].w + f2.w;
-        h_force.data[i3].x = h_force.data[i3].x + f3.x;
-        h_force.data[i3].y = h_force.data[i3].y + f3.y;
-        h_force.data[i3].z = h_force.data[i3].z + f3.z;
-        h_force.data[i3].w = h_force.data[i3].w + f3.w;
-        h_force.data[i4].x = h_force.data[i4].x + f4.x;
-        h_force.data[i4].y = h_force.data[i4].y + f4.y;
-        h_force.data[i4].z = h_force.data[i4].z + f4.z;
-        h_force.data[i4].w = h_force.data[i4].w + f4.w;
-
-        // Compute 1/4 of the virial, 1/4 for each atom in the dihedral
-        // upper triangular version of virial tensor
-        dihedral_virial[0] = 0.25 * (vb1.x * f1.x + vb2.x * f3.x + (vb3.x + vb2.x) * f4.x);
-        dihedral_virial[1] = 0.25 * (vb1.y * f1.x + vb2.y * f3.x + (vb3.y + vb2.y) * f4.x);
-        dihedral_virial[2] = 0.25 * (vb1.z * f1.x + vb2.z * f3.x + (vb3.z + vb2.z) * f4.x);
-        dihedral_virial[3] = 0.25 * (vb1.y * f1.y + vb2.y * f3.y + (vb3.y + vb2.y) * f4.y);
-        dihedral_virial[4] = 0.25 * (vb1.z * f1.y + vb2.z * f3.y + (vb3.z + vb2.z) * f4.y);
-        dihedral_virial[5] = 0.25 * (vb1.z * f1.z + vb2.z * f3.z + (vb3.z + vb2.z) * f4.z);
-
-        for (int k = 0; k < 6; k++)
+    auto compute_range = [&](unsigned int first,
+                             unsigned int last,
+                             Scalar4* force,
+                             Scalar* virial,
+                             size_t virial_pitch)
+    {
+        // From LAMMPS OPLS dihedral implementation
+        unsigned int i1, i2, i3, i4, dihedral_type;
+        Scalar3 vb1, vb2, vb3, vb2m;
+
+        // this volatile is not strictly needed, but it works around a compiler bug on Mac arm64
+        // with Apple clang version 13.0.0 (clang-1300.0.29.30)
+        // without the volatile, the x component of f2 is always computed the same as the y
+        // component
+        volatile Scalar4 f1, f2, f3, f4;
+        Scalar ax, ay, az, bx, by, bz, rasq, rbsq, rgsq, rg, rginv, ra2inv, rb2inv, rabinv;
+        Scalar df, df1, ddf1, fg, hg, fga, hgb, gaa, gbb;
+        Scalar dtfx, dtfy, dtfz, dtgx, dtgy, dtgz, dthx, dthy, dthz;
+        Scalar c, s, p, sx2, sy2, sz2, cos_term, e_dihedral;
+        Scalar k1, k2, k3, k4;
+        Scalar dihedral_virial[6];
+
+        for (unsigned int n = first; n < last; n++)
             {
-            h_virial.data[virial_pitch * k + i1] += dihedral_virial[k];
-            h_virial.data[virial_pitch * k + i2] += dihedral_virial[k];
-            h_virial.data[virial_pitch * k + i3] += dihedral_virial[k];
-            h_virial.data[virial_pitch * k + i4] += dihedral_virial[k];
+            // lookup the tag of each of the particles participating in the dihedral
+            const ImproperData::members_t& dihedral = h_dihedrals.data[n];
+            assert(dihedral.tag[0] < m_pdata->getNGlobal());
+            assert(dihedral.tag[1] < m_pdata->getNGlobal());
+            assert(dihedral.tag[2] < m_pdata->getNGlobal());
+            assert(dihedral.tag[3] < m_pdata->getNGlobal());
+
+            // i1 to i4 are the tags
+            i1 = h_dihedral_idx.data[n].idx[0];
+            i2 = h_dihedral_idx.data[n].idx[1];
+            i3 = h_dihedral_idx.data[n].idx[2];
+            i4 = h_dihedral_idx.data[n].idx[3];
+
+            // throw an error if this angle is incomplete
+            if (i1 == NOT_LOCAL || i2 == NOT_LOCAL || i3 == NOT_LOCAL || i4 == NOT_LOCAL)
+                {
+                this->m_exec_conf->msg->error()
+                    << "dihedral.opls: dihedral " << dihedral.tag[0] << " " << dihedral.tag[1]
+                    << " " << dihedral.tag[2] << " " << dihedral.tag[3] << " incomplete." << endl
+                    << endl;
+                throw std::runtime_error("Error in dihedral calculation");
+                }
+
+            assert(i1 < m_pdata->getN() + m_pdata->getNGhosts());
+            assert(i2 < m_pdata->getN() + m_pdata->getNGhosts());
+            assert(i3 < m_pdata->getN() + m_pdata->getNGhosts());
+            assert(i4 < m_pdata->getN() + m_pdata->getNGhosts());
+
+            // 1st bond
+
+            vb1.x = h_pos.data[i1].x - h_pos.data[i2].x;
+            vb1.y = h_pos.data[i1].y - h_pos.data[i2].y;
+            vb1.z = h_pos.data[i1].z - h_pos.data[i2].z;
+
+            // 2nd bond
+
+            vb2.x = h_pos.data[i3].x - h_pos.data[i2].x;
+            vb2.y = h_pos.data[i3].y - h_pos.data[i2].y;
+            vb2.z = h_pos.data[i3].z - h_pos.data[i2].z;
+
+            // 3rd bond
+
+            vb3.x = h_pos.data[i4].x - h_pos.data[i3].x;
+            vb3.y = h_pos.data[i4].y - h_pos.data[i3].y;
+            vb3.z = h_pos.data[i4].z - h_pos.data[i3].z;
+
+            // apply periodic boundary conditions
+            vb1 = box.minImage(vb1);
+            vb2 = box.minImage(vb2);
+            vb3 = box.minImage(vb3);
+
+            vb2m.x = -vb2.x;
+            vb2m.y = -vb2.y;
+            vb2m.z = -vb2.z;
+            vb2m = box.minImage(vb2m);
+
+            // c,s calculation
+
+            ax = vb1.y * vb2m.z - vb1.z * vb2m.y;
+            ay = vb1.z * vb2m.x - vb1.x * vb2m.z;
+            az = vb1.x * vb2m.y - vb1.y * vb2m.x;
+            bx = vb3.y * vb2m.z - vb3.z * vb2m.y;
+            by = vb3.z * vb2m.x - vb3.x * vb2m.z;
+            bz = vb3.x * vb2m.y - vb3.y * vb2m.x;
+
+            rasq = ax * ax + ay * ay + az * az;
+            rbsq = bx * bx + by * by + bz * bz;
+            rgsq = vb2m.x * vb2m.x + vb2m.y * vb2m.y + vb2m.z * vb2m.z;
+            rg = sqrt(rgsq);
+
+            rginv = ra2inv = rb2inv = 0.0;
+            if (rg > 0)
+                rginv = 1.0 / rg;
+            if (rasq > 0)
+                ra2inv = 1.0 / rasq;
+            if (rbsq > 0)
+                rb2inv = 1.0 / rbsq;
+            rabinv = sqrt(ra2inv * rb2inv);
+
+            c = (ax * bx + ay * by + az * bz) * rabinv;
+            s = rg * rabinv * (ax * vb3.x + ay * vb3.y + az * vb3.z);
+
+            if (c > 1.0)
+                c = 1.0;
+            if (c < -1.0)
+                c = -1.0;
+
+            // get values for k1/2 through k4/2
+            // ----- The 1/2 factor is already stored in the parameters --------
+            dihedral_type = h_typeval.data[n].type;
+            k1 = h_params.data[dihedral_type].x;
+            k2 = h_params.data[dihedral_type].y;
+            k3 = h_params.data[dihedral_type].z;
+            k4 = h_params.data[dihedral_type].w;
+
+            // calculate the potential p = sum (i=1,4) k_i * (1 + (-1)**(i+1)*cos(i*phi) )
+            // and df = dp/dc
+
+            // cos(phi) term
+            ddf1 = c;
+            df1 = s;
+            cos_term = ddf1;
+
+            p = k1 * (1.0 + cos_term);
+            df = k1 * df1;
+
+            // cos(2*phi) term
+            ddf1 = cos_term * c - df1 * s;
+            df1 = cos_term * s + df1 * c;
+            cos_term = ddf1;
+
+            p += k2 * (1.0 - cos_term);
+            df += -2.0 * k2 * df1;
+
+            // cos(3*phi) term
+            ddf1 = cos_term * c - df1 * s;
+            df1 = cos_term * s + df1 * c;
+            cos_term = ddf1;
+
+            p += k3 * (1.0 + cos_term);
+            df += 3.0 * k3 * df1;
+
+            // cos(4*phi) term
+            ddf1 = cos_term * c - df1 * s;
+            df1 = cos_term * s + df1 * c;
+            cos_term = ddf1;
+
+            p += k4 * (1.0 - cos_term);
+            df += -4.0 * k4 * df1;
+
+            // Compute 1/4 of energy to assign to each of 4 atoms in the dihedral
+            e_dihedral = 0.25 * p;
+
+            fg = vb1.x * vb2m.x + vb1.y * vb2m.y + vb1.z * vb2m.z;
+            hg = vb3.x * vb2m.x + vb3.y * vb2m.y + vb3.z * vb2m.z;
+            fga = fg * ra2inv * rginv;
+            hgb = hg * rb2inv * rginv;
+            gaa = -ra2inv * rg;
+            gbb = rb2inv * rg;
+
+            dtfx = gaa * ax;
+            dtfy = gaa * ay;
+            dtfz = gaa * az;
+            dtgx = fga * ax - hgb * bx;
+            dtgy = fga * ay - hgb * by;
+            dtgz = fga * az - hgb * bz;
+            dthx = gbb * bx;
+            dthy = gbb * by;
+            dthz = gbb * bz;
+
+            sx2 = df * dtgx;
+            sy2 = df * dtgy;
+            sz2 = df * dtgz;
+
+            f1.x = df * dtfx;
+            f1.y = df * dtfy;
+            f1.z = df * dtfz;
+            f1.w = e_dihedral;
+
+            f2.x = sx2 - f1.x;
+            f2.y = sy2 - f1.y;
+            f2.z = sz2 - f1.z;
+            f2.w = e_dihedral;
+
+            f4.x = df * dthx;
+            f4.y = df * dthy;
+            f4.z = df * dthz;
+            f4.w = e_dihedral;
+
+            f3.x = -sx2 - f4.x;
+            f3.y = -sy2 - f4.y;
+            f3.z = -sz2 - f4.z;
+            f3.w = e_dihedral;
+
+            // Apply force to each of the 4 atoms
+            force[i1].x = force[i1].x + f1.x;
+            force[i1].y = force[i1].y + f1.y;
+            force[i1].z = force[i1].z + f1.z;
+            force[i1].w = force[i1].w + f1.w;
+            force[i2].x = force[i2].x + f2.x;
+            force[i2].y = force[i2].y + f2.y;
+            force[i2].z = force[i2].z + f2.z;
+            force[i2].w = force[i2].w + f2.w;
+            force[i3].x = force[i3].x + f3.x;
+            force[i3].y = force[i3].y + f3.y;
+            force[i3].z = force[i3].z + f3.z;
+            force[i3].w = force[i3].w + f3.w;
+            force[i4].x = force[i4].x + f4.x;
+            force[i4].y = force[i4].y + f4.y;
+            force[i4].z = force[i4].z + f4.z;
+            force[i4].w = force[i4].w + f4.w;
+
+            // Compute 1/4 of the virial, 1/4 for each atom in the dihedral
+            // upper triangular version of virial tensor
+            dihedral_virial[0] = 0.25 * (vb1.x * f1.x + vb2.x * f3.x + (vb3.x + vb2.x) * f4.x);
+            dihedral_virial[1] = 0.25 * (vb1.y * f1.x + vb2.y * f3.x + (vb3.y + vb2.y) * f4.x);
+            dihedral_virial[2] = 0.25 * (vb1.z * f1.x + vb2.z * f3.x + (vb3.z + vb2.z) * f4.x);
+            dihedral_virial[3] = 0.25 * (vb1.y * f1.y + vb2.y * f3.y + (vb3.y + vb2.y) * f4.y);
+            dihedral_virial[4] = 0.25 * (vb1.z * f1.y + vb2.z * f3.y + (vb3.z + vb2.z) * f4.y);
+            dihedral_virial[5] = 0.25 * (vb1.z * f1.z + vb2.z * f3.z + (vb3.z + vb2.z) * f4.z);
+
+            if (compute_virial)
+                for (int k = 0; k < 6; k++)
+                    {
+                    virial[virial_pitch * k + i1] += dihedral_virial[k];
+                    virial[virial_pitch * k + i2] += dihedral_virial[k];
+                    virial[virial_pitch * k + i3] += dihedral_virial[k];
+                    virial[virial_pitch * k + i4] += dihedral_virial[k];
+                    }
+
+            if (!has_special_pairs)
+                continue;
+
+            // 1-4 special pair between the end atoms, from the minimum image bond vectors
+            const Scalar4 special_pair = h_special_pair_params.data[dihedral_type];
+            const Scalar3 dx = vb2 + vb3 - vb1;
+            const Scalar rsq = dot(dx, dx);
+            if (rsq >= special_pair.w)
+                continue;
+
+            const Scalar r2inv = Scalar(1.0) / rsq;
+            const Scalar r6inv = r2inv * r2inv * r2inv;
+            Scalar force_divr = r2inv * r6inv * (Scalar(12.0) * special_pair.x * r6inv
+                                                 - Scalar(6.0) * special_pair.y);
+            Scalar pair_eng = r6inv * (special_pair.x * r6inv - special_pair.y);
+            if (special_pair.z != Scalar(0.0))
+                {
+                const Scalar r1inv = fast::sqrt(r2inv);
+                const Scalar scaled_q = special_pair.z * h_charge.data[i1] * h_charge.data[i4];
+                force_divr += scaled_q * r2inv * r1inv;
+                pair_eng += scaled_q * r1inv;
+                }
+
+            // half of the energy and virial to each end atom
+            force[i4].x += force_divr * dx.x;
+            force[i4].y += force_divr * dx.y;
+            force[i4].z += force_divr * dx.z;
+            force[i4].w += Scalar(0.5) * pair_eng;
+            force[i1].x -= force_divr * dx.x;
+            force[i1].y -= force_divr * dx.y;
+            force[i1].z -= force_divr * dx.z;
+            force[i1].w += Scalar(0.5) * pair_eng;
+
+            if (compute_virial)
+                {
+                const Scalar force_div2r = Scalar(0.5) * force_divr;
+                Scalar pair_virial[6];
+                pair_virial[0] = dx.x * dx.x * force_div2r;
+                pair_virial[1] = dx.x * dx.y * force_div2r;
+                pair_virial[2] = dx.x * dx.z * force_div2r;
+                pair_virial[3] = dx.y * dx.y * force_div2r;
+                pair_virial[4] = dx.y * dx.z * force_div2r;
+                pair_virial[5] = dx.z * dx.z * force_div2r;
+                for (int k = 0; k < 6; k++)
+                    {
+                    virial[virial_pitch * k + i1] += pair_virial[k];
+                    virial[virial_pitch * k + i4] += pair_virial[k];
+                    }
+                }
             }
-        }
+    };
+
+    detail::computeBondedForces(m_exec_conf,
+                                numDihedrals,
+                                m_pdata->getN() + m_pdata->getNGhosts(),
+                                compute_virial,
+                                h_force.data,
+                                h_virial.data,
+                                m_virial.getPitch(),
+                                compute_range);
     }
 
 namespace detail
@@ -368,7 +509,9 @@ void export_OPLSDihedralForceCompute(pybind11::module& m)
                      std::shared_ptr<OPLSDihedralForceCompute>>(m, "OPLSDihedralForceCompute")
         .def(pybind11::init<std::shared_ptr<SystemDefinition>>())
         .def("setParams", &OPLSDihedralForceCompute::setParamsPython)
-        .def("getParams", &OPLSDihedralForceCompute::getParams);
+        .def("getParams", &OPLSDihedralForceCompute::getParams)
+        .def("setSpecialPair", &OPLSDihedralForceCompute::setSpecialPair)
+        .def("getSpecialPair", &OPLSDihedralForceCompute::getSpecialPair);
     }
 
     } // end namespace detail
@@ -51,10 +51,47 @@ struct dihedral_opls_params
         }
 #endif
     } __attribute__((aligned(32)));
+
+//! 1-4 special pair parameters of a dihedral type
+struct dihedral_special_pair_params
+    {
+    Scalar epsilon;
+    Scalar sigma;
+    Scalar alpha;
+    Scalar r_cut;
+
+#ifndef __HIPCC__
+    dihedral_special_pair_params() : epsilon(0.), sigma(1.), alpha(0.), r_cut(0.) { }
+
+    dihedral_special_pair_params(pybind11::dict v)
+        : epsilon(v["epsilon"].cast<Scalar>()), sigma(v["sigma"].cast<Scalar>()),
+          alpha(v["alpha"].cast<Scalar>()), r_cut(v["r_cut"].cast<Scalar>())
+        {
+        }
+
+    pybind11::dict asDict()
+        {
+        pybind11::dict v;
+        v["epsilon"] = epsilon;
+        v["sigma"] = sigma;
+        v["alpha"] = alpha;
+        v["r_cut"] = r_cut;
+        return v;
+        }
+#endif
+    };
+
 //! Computes OPLS dihedral forces on each particle
 /*! OPLS dihedral forces are computed on every particle in the simulation.
 
     The dihedrals which forces are computed on are accessed from ParticleData::getDihedralData
+
+    Optionally, the compute also evaluates the 1-4 special pair interaction (the same LJ and
+    Coulomb forms as EvaluatorSpecialPairLJ and EvaluatorSpecialPairCoulomb) between the end
+    atoms of every dihedral with non-zero special pair parameters for its type. The separation of
+    the end atoms follows from the three bond vectors of the dihedral, so the special pair reuses
+    the positions that the dihedral already loaded and needs no separate pair topology.
+
     \ingroup computes
 */
 class PYBIND11_EXPORT OPLSDihedralForceCompute : public ForceCompute
@@ -74,6 +111,12 @@ class PYBIND11_EXPORT OPLSDihedralForceCompute : public ForceCompute
     /// Get the parameters for a specified type
     pybind11::dict getParams(std::string type);
 
+    /// Set the 1-4 special pair parameters for a specified type
+    void setSpecialPair(std::string type, pybind11::dict params);
+
+    /// Get the 1-4 special pair parameters for a specified type
+    pybind11::dict getSpecialPair(std::string type);
+
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     /*! \param timestep Current time step
@@ -82,6 +125,9 @@ class PYBIND11_EXPORT OPLSDihedralForceCompute : public ForceCompute
         {
         CommFlags flags = CommFlags(0);
         flags[comm_flag::tag] = 1;
+        // the special pairs read the charges of the end atoms
+        if (m_has_special_pairs)
+            flags[comm_flag::charge] = 1;
         flags |= ForceCompute::getRequestedCommFlags(timestep);
         return flags;
         }
@@ -90,6 +136,15 @@ class PYBIND11_EXPORT OPLSDihedralForceCompute : public ForceCompute
     protected:
     GPUArray<Scalar4> m_params;
 
+    /// 1-4 special pair parameters per type (lj1, lj2, alpha, r_cutsq)
+    GPUArray<Scalar4> m_special_pair_params;
+
+    /// Parameters of the special pairs as set by the user
+    std::vector<dihedral_special_pair_params> m_special_pair;
+
+    /// True when any type has a special pair interaction
+    bool m_has_special_pairs = false;
+
     //!< Dihedral data to use in computing dihedrals
     std::shared_ptr<DihedralData> m_dihedral_data;
 
@@ -2,7 +2,16 @@
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
 #include "PPPMForceCompute.h"
+#include "EvaluatorPairLJDispersionEwald.h"
+
+#ifdef ENABLE_FFTW
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#endif
+#include <algorithm>
 #include <map>
+#include <vector>
 
 namespace hoomd
     {
@@ -26,6 +35,32 @@ const Scalar cpu_sinc_coeff[] = {Scalar(1.0),
                                  Scalar(1.0 / 362880.0),
                                  Scalar(-1.0 / 39916800.0)};
 
+//! Fourier transform of the long range part of the dispersion interaction of unit coefficients
+/*! \param ksq Squared wave vector
+    \param kappa Splitting parameter
+
+    The transform of -[1 - g(kappa r)] / r^6 is -pi^(3/2) kappa^3 f(k / (2 kappa)) with
+    f(b) = [(1 - 2 b^2) exp(-b^2) + 2 sqrt(pi) b^3 erfc(b)] / 3, see Essmann et al. (1995).
+*/
+static Scalar cpu_dispersion_reference(Scalar ksq, Scalar kappa)
+    {
+    Scalar b = sqrt(ksq) / (Scalar(2.0) * kappa);
+    Scalar f = ((Scalar(1.0) - Scalar(2.0) * b * b) * exp(-b * b)
+                + Scalar(2.0 * sqrt(M_PI)) * b * b * b * erfc(b))
+               / Scalar(3.0);
+    return -Scalar(M_PI * sqrt(M_PI)) * kappa * kappa * kappa * f;
+    }
+
+//! Logarithmic derivative 2 d ln(phi) / d(k^2) of the dispersion reference, for the virial
+static Scalar cpu_dispersion_vterm(Scalar ksq, Scalar kappa)
+    {
+    Scalar b = sqrt(ksq) / (Scalar(2.0) * kappa);
+    Scalar f = ((Scalar(1.0) - Scalar(2.0) * b * b) * exp(-b * b)
+                + Scalar(2.0 * sqrt(M_PI)) * b * b * b * erfc(b))
+               / Scalar(3.0);
+    return (Scalar(sqrt(M_PI)) * b * erfc(b) - exp(-b * b)) / (Scalar(2.0) * kappa * kappa * f);
+    }
+
 /*! \param sysdef The system definition
     \param nx Number of cells along first axis
     \param ny Number of cells along second axis
@@ -38,7 +73,10 @@ PPPMForceCompute::PPPMForceCompute(std::shared_ptr<SystemDefinition> sysdef,
     : ForceCompute(sysdef), m_nlist(nlist), m_group(group), m_n_ghost_cells(make_uint3(0, 0, 0)),
       m_grid_dim(make_uint3(0, 0, 0)), m_ghost_width(make_scalar3(0, 0, 0)), m_ghost_offset(0),
       m_n_cells(0), m_radius(1), m_n_inner_cells(0), m_need_initialize(true), m_params_set(false),
-      m_box_changed(false), m_q(0.0), m_q2(0.0), m_body_energy(0.0), m_ptls_added_removed(false),
+      m_box_changed(false), m_influence_tolerance(0.0), m_influence_recompute_period(100),
+      m_n_influence_rescaled(0), m_analytical_differentiation(false),
+      m_slab_correction(SlabCorrection::none), m_q(0.0), m_q2(0.0),
+      m_body_energy(0.0), m_ptls_added_removed(false),
       m_kiss_fft_initialized(false), m_dfft_initialized(false)
     {
     m_pdata->getBoxChangeSignal().connect<PPPMForceCompute, &PPPMForceCompute::setBoxChange>(this);
@@ -63,11 +101,13 @@ void PPPMForceCompute::setParams(unsigned int nx,
                                  unsigned int order,
                                  Scalar kappa,
                                  Scalar rcut,
-                                 Scalar alpha)
+                                 Scalar alpha,
+                                 bool analytical_differentiation)
     {
     m_kappa = kappa;
     m_rcut = rcut;
     m_alpha = alpha;
+    m_analytical_differentiation = analytical_differentiation;
 
     m_mesh_points = make_uint3(nx, ny, nz);
     m_global_dim = m_mesh_points;
@@ -144,6 +184,9 @@ PPPMForceCompute::~PPPMForceCompute()
         kiss_fft_free(m_kiss_ifft);
         kiss_fft_cleanup();
         }
+#ifdef ENABLE_FFTW
+    destroyFFTW();
+#endif
 #ifdef ENABLE_MPI
     if (m_dfft_initialized)
         {
@@ -302,7 +345,7 @@ Scalar PPPMForceCompute::rms(Scalar h, Scalar prd, Scalar natoms)
 
 void PPPMForceCompute::setupCoeffs()
     {
-    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(getCoefficients(), access_location::host, access_mode::read);
 
     // get system charge
     m_q = Scalar(0.0);
@@ -336,6 +379,19 @@ void PPPMForceCompute::setupCoeffs()
         }
 #endif
 
+    // initialize coefficients for charge assignment
+    compute_rho_coeff();
+
+    // initialize coefficients for Green's function
+    compute_gf_denom();
+
+    // the dispersion sum does not require neutrality and the error estimates below are for the
+    // Coulomb interaction
+    if (m_dispersion)
+        {
+        return;
+        }
+
     if (fabs(m_q) > 1e-5 && m_alpha == Scalar(0.0))
         {
         m_exec_conf->msg->warning() << "charge.pppm: system is not neutral and unscreened "
@@ -368,12 +424,6 @@ void PPPMForceCompute::setupCoeffs()
         {
         m_exec_conf->msg->notice(2) << "charge.pppm: RMS error: " << RMS_error << std::endl;
         }
-
-    // initialize coefficients for charge assignment
-    compute_rho_coeff();
-
-    // initialize coefficients for Green's function
-    compute_gf_denom();
     }
 
 void PPPMForceCompute::setupMesh()
@@ -545,6 +595,10 @@ void PPPMForceCompute::initializeFFT()
         m_kiss_ifft = kiss_fftnd_alloc(dims, 3, 1, NULL, NULL);
 
         m_kiss_fft_initialized = true;
+
+#ifdef ENABLE_FFTW
+        setupFFTW(dims);
+#endif
         }
 
     // allocate mesh and transformed mesh
@@ -707,7 +761,9 @@ void PPPMForceCompute::computeInfluenceFunction()
         if (n.x != 0 || n.y != 0 || n.z != 0)
             {
             Scalar sum1(0.0);
-            Scalar numerator = Scalar(4.0 * M_PI) / dot(k, k);
+
+            // the dispersion reference is part of the sum, the Coulomb one is 4 pi / k_n^2
+            Scalar numerator = (m_dispersion ? Scalar(1.0) : Scalar(4.0 * M_PI)) / dot(k, k);
 
             Scalar denominator = gf_denom(snx * snx, sny * sny, snz * snz);
 
@@ -751,7 +807,18 @@ void PPPMForceCompute::computeInfluenceFunction()
                             }
 
                         Scalar3 kn = knx + kny + knz;
-                        Scalar dot1 = dot(kn, k);
+
+                        // the ad scheme differentiates every alias exactly, so the projection
+                        // of the aliased wave vector onto k is replaced by its square
+                        Scalar dot1 = m_analytical_differentiation ? dot(kn, kn) : dot(kn, k);
+
+                        if (m_dispersion)
+                            {
+                            sum1 += dot1 * cpu_dispersion_reference(dot(kn, kn), m_kappa) * wx
+                                    * wx * wy * wy * wz * wz;
+                            continue;
+                            }
+
                         Scalar dot2 = dot(kn, kn) + m_alpha * m_alpha;
 
                         Scalar arg_gauss = Scalar(0.25) * dot2 / m_kappa / m_kappa;
@@ -772,16 +839,248 @@ void PPPMForceCompute::computeInfluenceFunction()
         }
     }
 
+//! Evaluate the assignment function at the points of a stencil
+/*! \param rho_coeff Polynomial coefficients of the assignment function, order values per power
+    \param d Offset of the particle from the stencil center in mesh units
+    \param W Weights of the order stencil points (output)
+*/
+template<int order> inline void cpu_assignment_weights(const Scalar* rho_coeff, Scalar d, Scalar* W)
+    {
+    for (int i = 0; i < order; ++i)
+        {
+        Scalar w(0.0);
+        for (int iorder = order - 1; iorder >= 0; iorder--)
+            {
+            w = rho_coeff[i + iorder * order] + w * d;
+            }
+        W[i] = w;
+        }
+    }
+
+//! Evaluate the derivative of the assignment function at the points of a stencil
+/*! \param rho_coeff Polynomial coefficients of the assignment function, order values per power
+    \param d Offset of the particle from the stencil center in mesh units
+    \param dW Derivatives of the weights with respect to d (output)
+*/
+template<int order>
+inline void cpu_assignment_derivatives(const Scalar* rho_coeff, Scalar d, Scalar* dW)
+    {
+    for (int i = 0; i < order; ++i)
+        {
+        Scalar w(0.0);
+        for (int iorder = order - 1; iorder >= 1; iorder--)
+            {
+            w = Scalar(iorder) * rho_coeff[i + iorder * order] + w * d;
+            }
+        dW[i] = w;
+        }
+    }
+
+/*! \param rho_coeff Coefficients of the assignment function (output), order values per power
+
+    Copies the part of m_rho_coeff that the stencil uses into a dense array.
+*/
+template<int order> void PPPMForceCompute::loadRhoCoeff(Scalar* rho_coeff)
+    {
+    ArrayHandle<Scalar> h_rho_coeff(m_rho_coeff, access_location::host, access_mode::read);
+    const int mult_fact = 2 * order + 1;
+    for (int iorder = 0; iorder < order; ++iorder)
+        for (int i = 0; i < order; ++i)
+            rho_coeff[i + iorder * order] = h_rho_coeff.data[i + iorder * mult_fact];
+    }
+
+/*! \param exact True when the influence function must be computed exactly
+
+    In NPT simulations the box changes every step, and the exact influence function is an expensive
+    sum over aliased wave vectors. When the box lengths and tilt factors differ from those of the
+    last exact computation by less than m_influence_tolerance, the stored reference is rescaled
+    instead. The exact computation runs again after m_influence_recompute_period rescaled updates.
+*/
+void PPPMForceCompute::updateInfluenceFunction(bool exact)
+    {
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+
+    // the GPU implementation always computes the influence function on the device
+    if (!exact && m_influence_tolerance > Scalar(0.0) && !m_exec_conf->isCUDAEnabled()
+        && m_n_influence_rescaled < m_influence_recompute_period
+        && m_inf_f_ref.getNumElements() == m_inf_f.getNumElements())
+        {
+        Scalar3 L = global_box.getL();
+        Scalar3 L_ref = m_inf_f_ref_box.getL();
+        Scalar dxy = global_box.getTiltFactorXY() - m_inf_f_ref_box.getTiltFactorXY();
+        Scalar dxz = global_box.getTiltFactorXZ() - m_inf_f_ref_box.getTiltFactorXZ();
+        Scalar dyz = global_box.getTiltFactorYZ() - m_inf_f_ref_box.getTiltFactorYZ();
+        Scalar change = std::max({fabs(L.x / L_ref.x - Scalar(1.0)),
+                                  fabs(L.y / L_ref.y - Scalar(1.0)),
+                                  fabs(L.z / L_ref.z - Scalar(1.0)),
+                                  fabs(dxy),
+                                  fabs(dxz),
+                                  fabs(dyz)});
+
+        if (change < m_influence_tolerance)
+            {
+            rescaleInfluenceFunction();
+            m_n_influence_rescaled++;
+            return;
+            }
+        }
+
+    computeInfluenceFunction();
+    m_n_influence_rescaled = 0;
+    m_inf_f_ref_box = global_box;
+    m_k_box = global_box;
+
+    if (m_influence_tolerance > Scalar(0.0) && !m_exec_conf->isCUDAEnabled())
+        {
+        if (m_inf_f_ref.getNumElements() != m_inf_f.getNumElements())
+            {
+            GlobalArray<Scalar> inf_f_ref(m_inf_f.getNumElements(), m_exec_conf);
+            m_inf_f_ref.swap(inf_f_ref);
+            }
+
+        ArrayHandle<Scalar> h_inf_f(m_inf_f, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_inf_f_ref(m_inf_f_ref,
+                                        access_location::host,
+                                        access_mode::overwrite);
+        std::copy(h_inf_f.data, h_inf_f.data + m_inf_f.getNumElements(), h_inf_f_ref.data);
+        }
+    }
+
+//! Compute the reciprocal lattice vectors of a box
+static void cpu_reciprocal_lattice(const BoxDim& box, Scalar3& b1, Scalar3& b2, Scalar3& b3)
+    {
+    Scalar3 a1 = box.getLatticeVector(0);
+    Scalar3 a2 = box.getLatticeVector(1);
+    Scalar3 a3 = box.getLatticeVector(2);
+
+    Scalar V_box = box.getVolume();
+    b1 = Scalar(2.0 * M_PI)
+         * make_scalar3(a2.y * a3.z - a2.z * a3.y,
+                        a2.z * a3.x - a2.x * a3.z,
+                        a2.x * a3.y - a2.y * a3.x)
+         / V_box;
+    b2 = Scalar(2.0 * M_PI)
+         * make_scalar3(a3.y * a1.z - a3.z * a1.y,
+                        a3.z * a1.x - a3.x * a1.z,
+                        a3.x * a1.y - a3.y * a1.x)
+         / V_box;
+    b3 = Scalar(2.0 * M_PI)
+         * make_scalar3(a1.y * a2.z - a1.z * a2.y,
+                        a1.z * a2.x - a1.x * a2.z,
+                        a1.x * a2.y - a1.y * a2.x)
+         / V_box;
+    }
+
+/*! The charge assignment and aliasing factors of the optimal influence function depend only on
+    the Miller indices of the wave vector. Its box dependence is dominated by the principal term
+    exp(-(k^2 + alpha^2) / (4 kappa^2)) / (k^2 + alpha^2), or the dispersion reference, so the
+    reference is scaled by the ratio of that term at the new and the reference wave vectors. The
+    error comes from the aliased terms only and vanishes as the box change goes to zero.
+*/
+void PPPMForceCompute::rescaleInfluenceFunction()
+    {
+    ArrayHandle<Scalar> h_inf_f(m_inf_f, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_inf_f_ref(m_inf_f_ref, access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_k(m_k, access_location::host, access_mode::readwrite);
+
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+
+    Scalar3 b1, b2, b3;
+    cpu_reciprocal_lattice(global_box, b1, b2, b3);
+    Scalar3 b1_ref, b2_ref, b3_ref;
+    cpu_reciprocal_lattice(m_inf_f_ref_box, b1_ref, b2_ref, b3_ref);
+
+    // lattice vectors of the box that the stored wave vectors belong to
+    Scalar3 a1 = m_k_box.getLatticeVector(0);
+    Scalar3 a2 = m_k_box.getLatticeVector(1);
+    Scalar3 a3 = m_k_box.getLatticeVector(2);
+
+    Scalar alpha_sq = m_alpha * m_alpha;
+    Scalar inv_four_kappa_sq = Scalar(0.25) / (m_kappa * m_kappa);
+
+    for (unsigned int cell_idx = 0; cell_idx < m_n_inner_cells; ++cell_idx)
+        {
+        // recover the Miller indices from the previous wave vector
+        Scalar3 k_old = h_k.data[cell_idx];
+        Scalar nx = rint(dot(k_old, a1) / Scalar(2.0 * M_PI));
+        Scalar ny = rint(dot(k_old, a2) / Scalar(2.0 * M_PI));
+        Scalar nz = rint(dot(k_old, a3) / Scalar(2.0 * M_PI));
+
+        Scalar3 k = nx * b1 + ny * b2 + nz * b3;
+        Scalar3 k_ref = nx * b1_ref + ny * b2_ref + nz * b3_ref;
+        h_k.data[cell_idx] = k;
+
+        Scalar dot_k = dot(k, k) + alpha_sq;
+        Scalar dot_ref = dot(k_ref, k_ref) + alpha_sq;
+        Scalar inf_f_ref = h_inf_f_ref.data[cell_idx];
+
+        // the DC term stays zero
+        if (inf_f_ref == Scalar(0.0))
+            {
+            h_inf_f.data[cell_idx] = Scalar(0.0);
+            continue;
+            }
+
+        if (m_dispersion)
+            {
+            h_inf_f.data[cell_idx] = inf_f_ref
+                                     * cpu_dispersion_reference(dot(k, k), m_kappa)
+                                     / cpu_dispersion_reference(dot(k_ref, k_ref), m_kappa);
+            continue;
+            }
+
+        h_inf_f.data[cell_idx]
+            = inf_f_ref * dot_ref / dot_k * exp((dot_ref - dot_k) * inv_four_kappa_sq);
+        }
+
+    m_k_box = global_box;
+    }
+
 //! Assignment of particles to mesh using variable order interpolation scheme
 void PPPMForceCompute::assignParticles()
+    {
+    // dispatch to the stencil of the interpolation order
+    switch (m_order)
+        {
+    case 1:
+        assignParticlesOrder<1>();
+        break;
+    case 2:
+        assignParticlesOrder<2>();
+        break;
+    case 3:
+        assignParticlesOrder<3>();
+        break;
+    case 4:
+        assignParticlesOrder<4>();
+        break;
+    case 5:
+        assignParticlesOrder<5>();
+        break;
+    case 6:
+        assignParticlesOrder<6>();
+        break;
+    case 7:
+        assignParticlesOrder<7>();
+        break;
+    default:
+        throw std::runtime_error("Invalid interpolation order.");
+        }
+    }
+
+/*! The stencil size is a compile time constant, so the loops over the stencil points unroll and
+    the weights of each particle stay in registers.
+*/
+template<int order> void PPPMForceCompute::assignParticlesOrder()
     {
     ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
                                    access_location::host,
                                    access_mode::read);
     ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(getCoefficients(), access_location::host, access_mode::read);
 
-    ArrayHandle<Scalar> h_rho_coeff(m_rho_coeff, access_location::host, access_mode::read);
+    Scalar rho_coeff[order * order];
+    loadRhoCoeff<order>(rho_coeff);
 
     const BoxDim& box = m_pdata->getBox();
 
@@ -790,6 +1089,10 @@ void PPPMForceCompute::assignParticles()
 
     Scalar V_cell = box.getVolume() / (Scalar)(m_mesh_points.x * m_mesh_points.y * m_mesh_points.z);
 
+    const Scalar shift = (order % 2) ? Scalar(0.5) : Scalar(0.0);
+    const Scalar shiftone = (order % 2) ? Scalar(0.0) : Scalar(0.5);
+    const int nlower = -(order - 1) / 2;
+
     // loop over group
     unsigned int group_size = m_group->getNumMembers();
     for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
@@ -817,19 +1120,6 @@ void PPPMForceCompute::assignParticles()
         reduced_pos.y += (Scalar)m_n_ghost_cells.y;
         reduced_pos.z += (Scalar)m_n_ghost_cells.z;
 
-        Scalar shift, shiftone;
-
-        if (m_order % 2)
-            {
-            shift = 0.5;
-            shiftone = 0.0;
-            }
-        else
-            {
-            shift = 0.0;
-            shiftone = 0.5;
-            }
-
         // find cell of the mesh the particle is in
         int ix = int(reduced_pos.x + shift);
         int iy = int(reduced_pos.y + shift);
@@ -854,21 +1144,17 @@ void PPPMForceCompute::assignParticles()
             continue;
             }
 
-        int mult_fact = 2 * m_order + 1;
-        Scalar Wx, Wy, Wz;
+        // weights of the stencil points along each direction
+        Scalar Wx[order], Wy[order], Wz[order];
+        cpu_assignment_weights<order>(rho_coeff, dx, Wx);
+        cpu_assignment_weights<order>(rho_coeff, dy, Wy);
+        cpu_assignment_weights<order>(rho_coeff, dz, Wz);
 
-        int nlower = -(m_order - 1) / 2;
-        int nupper = m_order / 2;
+        Scalar q_cell = qi / V_cell;
 
-        for (int i = nlower; i <= nupper; ++i)
+        for (int i = 0; i < order; ++i)
             {
-            Wx = Scalar(0.0);
-            for (int iorder = m_order - 1; iorder >= 0; iorder--)
-                {
-                Wx = h_rho_coeff.data[i - nlower + iorder * mult_fact] + Wx * dx;
-                }
-
-            int neighi = (int)ix + i;
+            int neighi = ix + nlower + i;
 
             if (!m_n_ghost_cells.x)
                 {
@@ -878,15 +1164,9 @@ void PPPMForceCompute::assignParticles()
                     neighi += m_grid_dim.x;
                 }
 
-            for (int j = nlower; j <= nupper; ++j)
+            for (int j = 0; j < order; ++j)
                 {
-                Wy = Scalar(0.0);
-                for (int iorder = m_order - 1; iorder >= 0; iorder--)
-                    {
-                    Wy = h_rho_coeff.data[j - nlower + iorder * mult_fact] + Wy * dy;
-                    }
-
-                int neighj = (int)iy + j;
+                int neighj = iy + nlower + j;
 
                 if (!m_n_ghost_cells.y)
                     {
@@ -896,15 +1176,11 @@ void PPPMForceCompute::assignParticles()
                         neighj += m_grid_dim.y;
                     }
 
-                for (int k = nlower; k <= nupper; ++k)
-                    {
-                    Wz = Scalar(0.0);
-                    for (int iorder = m_order - 1; iorder >= 0; iorder--)
-                        {
-                        Wz = h_rho_coeff.data[k - nlower + iorder * mult_fact] + Wz * dz;
-                        }
+                Scalar Wxy = q_cell * Wx[i] * Wy[j];
 
-                    int neighk = (int)iz + k;
+                for (int k = 0; k < order; ++k)
+                    {
+                    int neighk = iz + nlower + k;
                     if (!m_n_ghost_cells.z)
                         {
                         if (neighk >= (int)m_grid_dim.z)
@@ -913,19 +1189,111 @@ void PPPMForceCompute::assignParticles()
                             neighk += m_grid_dim.z;
                         }
 
-                    Scalar W = Wx * Wy * Wz;
-
                     // store in row major order
                     unsigned int neigh_idx
                         = neighi + m_grid_dim.x * (neighj + m_grid_dim.y * neighk);
 
-                    h_mesh.data[neigh_idx].r += float(qi * W / V_cell);
+                    h_mesh.data[neigh_idx].r += float(Wxy * Wz[k]);
                     }
                 }
             }
         } // end loop over particles
     }
 
+/*! \param in Input mesh
+    \param out Output mesh
+    \param inverse True for the inverse transform
+
+    Uses the FFTW plans when they exist and KISS FFT otherwise. Both compute the unnormalized
+    transform with the same sign convention.
+*/
+void PPPMForceCompute::localFFT(kiss_fft_cpx* in, kiss_fft_cpx* out, bool inverse)
+    {
+#ifdef ENABLE_FFTW
+    fftwf_plan plan = inverse ? m_fftw_plan_inverse : m_fftw_plan_forward;
+    if (plan)
+        {
+        fftwf_execute_dft(plan,
+                          reinterpret_cast<fftwf_complex*>(in),
+                          reinterpret_cast<fftwf_complex*>(out));
+        return;
+        }
+#endif
+
+    kiss_fftnd(inverse ? m_kiss_ifft : m_kiss_fft, in, out);
+    }
+
+#ifdef ENABLE_FFTW
+/*! \param dims Mesh dimensions, slowest varying first
+
+    The plans are measured on scratch arrays and created with FFTW_UNALIGNED, so that they apply
+    to the GlobalArray meshes with fftwf_execute_dft(). When the environment variable
+    HOOMD_FFTW_WISDOM names a file, the wisdom is read from it before planning and written back
+    afterwards, so that later simulations with the same mesh plan instantly.
+*/
+void PPPMForceCompute::setupFFTW(const int dims[3])
+    {
+    static_assert(sizeof(kiss_fft_cpx) == sizeof(fftwf_complex),
+                  "kiss_fft_cpx must have the layout of fftwf_complex");
+
+    destroyFFTW();
+
+    const char* wisdom_file = std::getenv("HOOMD_FFTW_WISDOM");
+    if (wisdom_file)
+        {
+        fftwf_import_wisdom_from_filename(wisdom_file);
+        }
+
+    const size_t n = size_t(dims[0]) * size_t(dims[1]) * size_t(dims[2]);
+    fftwf_complex* in = fftwf_alloc_complex(n);
+    fftwf_complex* out = fftwf_alloc_complex(n);
+    if (in && out)
+        {
+        const unsigned int flags = FFTW_MEASURE | FFTW_UNALIGNED;
+        m_fftw_plan_forward = fftwf_plan_dft(3, dims, in, out, FFTW_FORWARD, flags);
+        m_fftw_plan_inverse = fftwf_plan_dft(3, dims, in, out, FFTW_BACKWARD, flags);
+        }
+    fftwf_free(in);
+    fftwf_free(out);
+
+    if (!m_fftw_plan_forward || !m_fftw_plan_inverse)
+        {
+        m_exec_conf->msg->notice(2) << "PPPM: FFTW planning failed, using KISS FFT." << std::endl;
+        destroyFFTW();
+        return;
+        }
+
+    if (wisdom_file)
+        {
+        // write to a temporary file and rename it, concurrent jobs may share the wisdom file
+        std::string temporary_file
+            = std::string(wisdom_file) + "." + std::to_string(getpid()) + ".tmp";
+        if (fftwf_export_wisdom_to_filename(temporary_file.c_str()))
+            {
+            std::rename(temporary_file.c_str(), wisdom_file);
+            }
+        else
+            {
+            std::remove(temporary_file.c_str());
+            }
+        }
+    }
+
+void PPPMForceCompute::destroyFFTW()
+    {
+    if (m_fftw_plan_forward)
+        {
+        fftwf_destroy_plan(m_fftw_plan_forward);
+        m_fftw_plan_forward = nullptr;
+        }
+    if (m_fftw_plan_inverse)
+        {
+        fftwf_destroy_plan(m_fftw_plan_inverse);
+        m_fftw_plan_inverse = nullptr;
+        }
+    }
+#endif
+
 void PPPMForceCompute::updateMeshes()
     {
     if (m_kiss_fft_initialized)
@@ -936,7 +1304,7 @@ void PPPMForceCompute::updateMeshes()
                                                  access_location::host,
                                                  access_mode::overwrite);
 
-        kiss_fftnd(m_kiss_fft, h_mesh.data, h_fourier_mesh.data);
+        localFFT(h_mesh.data, h_fourier_mesh.data, false);
         }
 
 #ifdef ENABLE_MPI
@@ -986,6 +1354,14 @@ void PPPMForceCompute::updateMeshes()
 
             Scalar scaled_inf_f = h_inf_f.data[k] / ((Scalar)NNN);
 
+            if (m_analytical_differentiation)
+                {
+                // only the potential is needed, the x-component mesh holds it
+                h_fourier_mesh_G_x.data[k].r = float(f.r * scaled_inf_f);
+                h_fourier_mesh_G_x.data[k].i = float(f.i * scaled_inf_f);
+                continue;
+                }
+
             Scalar3 kvec = h_k.data[k];
 
             h_fourier_mesh_G_x.data[k].r = float(f.i * kvec.x * scaled_inf_f);
@@ -1020,9 +1396,12 @@ void PPPMForceCompute::updateMeshes()
         ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_z(m_inv_fourier_mesh_z,
                                                        access_location::host,
                                                        access_mode::overwrite);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_x.data, h_inv_fourier_mesh_x.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data);
+        localFFT(h_fourier_mesh_G_x.data, h_inv_fourier_mesh_x.data, true);
+        if (!m_analytical_differentiation)
+            {
+            localFFT(h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data, true);
+            localFFT(h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data, true);
+            }
         }
 
 #ifdef ENABLE_MPI
@@ -1054,14 +1433,17 @@ void PPPMForceCompute::updateMeshes()
                      (cpx_t*)(h_inv_fourier_mesh_x.data + m_ghost_offset),
                      1,
                      m_dfft_plan_inverse);
-        dfft_execute((cpx_t*)h_fourier_mesh_G_y.data,
-                     (cpx_t*)(h_inv_fourier_mesh_y.data + m_ghost_offset),
-                     1,
-                     m_dfft_plan_inverse);
-        dfft_execute((cpx_t*)h_fourier_mesh_G_z.data,
-                     (cpx_t*)(h_inv_fourier_mesh_z.data + m_ghost_offset),
-                     1,
-                     m_dfft_plan_inverse);
+        if (!m_analytical_differentiation)
+            {
+            dfft_execute((cpx_t*)h_fourier_mesh_G_y.data,
+                         (cpx_t*)(h_inv_fourier_mesh_y.data + m_ghost_offset),
+                         1,
+                         m_dfft_plan_inverse);
+            dfft_execute((cpx_t*)h_fourier_mesh_G_z.data,
+                         (cpx_t*)(h_inv_fourier_mesh_z.data + m_ghost_offset),
+                         1,
+                         m_dfft_plan_inverse);
+            }
         }
 #endif
 
@@ -1072,20 +1454,59 @@ void PPPMForceCompute::updateMeshes()
         {
         // update outer cells of force mesh using ghost cells from neighboring processors
         m_exec_conf->msg->notice(8) << "charge.pppm: Ghost cell update" << std::endl;
-        m_grid_comm_reverse->communicate(m_inv_fourier_mesh_x);
-        m_grid_comm_reverse->communicate(m_inv_fourier_mesh_y);
-        m_grid_comm_reverse->communicate(m_inv_fourier_mesh_z);
+        if (m_analytical_differentiation)
+            {
+            m_grid_comm_reverse->communicate(m_inv_fourier_mesh_x);
+            }
+        else
+            {
+            // exchange the three components in one message per neighbor
+            m_grid_comm_reverse->communicate({&m_inv_fourier_mesh_x,
+                                              &m_inv_fourier_mesh_y,
+                                              &m_inv_fourier_mesh_z});
+            }
         }
 #endif
     }
 
 void PPPMForceCompute::interpolateForces()
+    {
+    // dispatch to the stencil of the interpolation order
+    switch (m_order)
+        {
+    case 1:
+        interpolateForcesOrder<1>();
+        break;
+    case 2:
+        interpolateForcesOrder<2>();
+        break;
+    case 3:
+        interpolateForcesOrder<3>();
+        break;
+    case 4:
+        interpolateForcesOrder<4>();
+        break;
+    case 5:
+        interpolateForcesOrder<5>();
+        break;
+    case 6:
+        interpolateForcesOrder<6>();
+        break;
+    case 7:
+        interpolateForcesOrder<7>();
+        break;
+    default:
+        throw std::runtime_error("Invalid interpolation order.");
+        }
+    }
+
+template<int order> void PPPMForceCompute::interpolateForcesOrder()
     {
     // access particle data
     ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
                                    access_location::host,
                                    access_mode::read);
-    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(getCoefficients(), access_location::host, access_mode::read);
 
     // access inverse Fourier transform mesh
     ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x,
@@ -1104,10 +1525,36 @@ void PPPMForceCompute::interpolateForces()
     // reset force for ALL particles
     memset(h_force.data, 0, sizeof(Scalar4) * m_pdata->getN());
 
-    ArrayHandle<Scalar> h_rho_coeff(m_rho_coeff, access_location::host, access_mode::read);
+    Scalar rho_coeff[order * order];
+    loadRhoCoeff<order>(rho_coeff);
 
     const BoxDim& box = m_pdata->getBox();
 
+    // gradients of the fractional coordinates in the local box, scaled to mesh units
+    Scalar3 a1 = box.getLatticeVector(0);
+    Scalar3 a2 = box.getLatticeVector(1);
+    Scalar3 a3 = box.getLatticeVector(2);
+    Scalar V_box = box.getVolume();
+    Scalar3 grad_x = Scalar(m_mesh_points.x)
+                     * make_scalar3(a2.y * a3.z - a2.z * a3.y,
+                                    a2.z * a3.x - a2.x * a3.z,
+                                    a2.x * a3.y - a2.y * a3.x)
+                     / V_box;
+    Scalar3 grad_y = Scalar(m_mesh_points.y)
+                     * make_scalar3(a3.y * a1.z - a3.z * a1.y,
+                                    a3.z * a1.x - a3.x * a1.z,
+                                    a3.x * a1.y - a3.y * a1.x)
+                     / V_box;
+    Scalar3 grad_z = Scalar(m_mesh_points.z)
+                     * make_scalar3(a1.y * a2.z - a1.z * a2.y,
+                                    a1.z * a2.x - a1.x * a2.z,
+                                    a1.x * a2.y - a1.y * a2.x)
+                     / V_box;
+
+    const Scalar shift = (order % 2) ? Scalar(0.5) : Scalar(0.0);
+    const Scalar shiftone = (order % 2) ? Scalar(0.0) : Scalar(0.5);
+    const int nlower = -(order - 1) / 2;
+
     // loop over group
     unsigned int group_size = m_group->getNumMembers();
     for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
@@ -1134,19 +1581,6 @@ void PPPMForceCompute::interpolateForces()
         reduced_pos.y += (Scalar)m_n_ghost_cells.y;
         reduced_pos.z += (Scalar)m_n_ghost_cells.z;
 
-        Scalar shift, shiftone;
-
-        if (m_order % 2)
-            {
-            shift = 0.5;
-            shiftone = 0.0;
-            }
-        else
-            {
-            shift = 0.0;
-            shiftone = 0.5;
-            }
-
         // find cell of the force mesh the particle is in
         int ix = int(reduced_pos.x + shift);
         int iy = int(reduced_pos.y + shift);
@@ -1173,21 +1607,27 @@ void PPPMForceCompute::interpolateForces()
 
         Scalar3 force = make_scalar3(0.0, 0.0, 0.0);
 
-        int mult_fact = 2 * m_order + 1;
-        Scalar Wx, Wy, Wz;
+        // gradient of the potential in mesh units (ad scheme)
+        Scalar3 grad_phi = make_scalar3(0.0, 0.0, 0.0);
 
-        int nlower = -(m_order - 1) / 2;
-        int nupper = m_order / 2;
+        // weights of the stencil points along each direction
+        Scalar Wx[order], Wy[order], Wz[order];
+        cpu_assignment_weights<order>(rho_coeff, dx, Wx);
+        cpu_assignment_weights<order>(rho_coeff, dy, Wy);
+        cpu_assignment_weights<order>(rho_coeff, dz, Wz);
 
-        for (int i = nlower; i <= nupper; ++i)
+        // derivatives of the weights with respect to dx, dy and dz (ad scheme)
+        Scalar dWx[order], dWy[order], dWz[order];
+        if (m_analytical_differentiation)
             {
-            Wx = Scalar(0.0);
-            for (int iorder = m_order - 1; iorder >= 0; iorder--)
-                {
-                Wx = h_rho_coeff.data[i - nlower + iorder * mult_fact] + Wx * dx;
-                }
+            cpu_assignment_derivatives<order>(rho_coeff, dx, dWx);
+            cpu_assignment_derivatives<order>(rho_coeff, dy, dWy);
+            cpu_assignment_derivatives<order>(rho_coeff, dz, dWz);
+            }
 
-            int neighi = (int)ix + i;
+        for (int i = 0; i < order; ++i)
+            {
+            int neighi = ix + nlower + i;
 
             if (!m_n_ghost_cells.x)
                 {
@@ -1197,15 +1637,9 @@ void PPPMForceCompute::interpolateForces()
                     neighi += m_grid_dim.x;
                 }
 
-            for (int j = nlower; j <= nupper; ++j)
+            for (int j = 0; j < order; ++j)
                 {
-                Wy = Scalar(0.0);
-                for (int iorder = m_order - 1; iorder >= 0; iorder--)
-                    {
-                    Wy = h_rho_coeff.data[j - nlower + iorder * mult_fact] + Wy * dy;
-                    }
-
-                int neighj = (int)iy + j;
+                int neighj = iy + nlower + j;
 
                 if (!m_n_ghost_cells.y)
                     {
@@ -1215,15 +1649,9 @@ void PPPMForceCompute::interpolateForces()
                         neighj += m_grid_dim.y;
                     }
 
-                for (int k = nlower; k <= nupper; ++k)
+                for (int k = 0; k < order; ++k)
                     {
-                    Wz = Scalar(0.0);
-                    for (int iorder = m_order - 1; iorder >= 0; iorder--)
-                        {
-                        Wz = h_rho_coeff.data[k - nlower + iorder * mult_fact] + Wz * dz;
-                        }
-
-                    int neighk = (int)iz + k;
+                    int neighk = iz + nlower + k;
                     if (!m_n_ghost_cells.z)
                         {
                         if (neighk >= (int)m_grid_dim.z)
@@ -1235,11 +1663,20 @@ void PPPMForceCompute::interpolateForces()
                     unsigned int neigh_idx
                         = neighi + m_grid_dim.x * (neighj + m_grid_dim.y * neighk);
 
+                    if (m_analytical_differentiation)
+                        {
+                        Scalar phi = h_inv_fourier_mesh_x.data[neigh_idx].r;
+                        grad_phi.x += dWx[i] * Wy[j] * Wz[k] * phi;
+                        grad_phi.y += Wx[i] * dWy[j] * Wz[k] * phi;
+                        grad_phi.z += Wx[i] * Wy[j] * dWz[k] * phi;
+                        continue;
+                        }
+
                     kiss_fft_cpx E_x = h_inv_fourier_mesh_x.data[neigh_idx];
                     kiss_fft_cpx E_y = h_inv_fourier_mesh_y.data[neigh_idx];
                     kiss_fft_cpx E_z = h_inv_fourier_mesh_z.data[neigh_idx];
 
-                    Scalar W = Wx * Wy * Wz;
+                    Scalar W = Wx[i] * Wy[j] * Wz[k];
                     force.x += qi * W * E_x.r;
                     force.y += qi * W * E_y.r;
                     force.z += qi * W * E_z.r;
@@ -1247,6 +1684,12 @@ void PPPMForceCompute::interpolateForces()
                 }
             }
 
+        if (m_analytical_differentiation)
+            {
+            // dx decreases as the reduced position increases, so F = -q grad(phi) changes sign
+            force = qi * (grad_phi.x * grad_x + grad_phi.y * grad_y + grad_phi.z * grad_z);
+            }
+
         h_force.data[idx] = make_scalar4(force.x, force.y, force.z, 0.0);
         } // end of loop over particles
     }
@@ -1288,7 +1731,17 @@ Scalar PPPMForceCompute::computePE()
     Scalar scale = Scalar(1.0) / ((Scalar)(m_global_dim.x * m_global_dim.y * m_global_dim.z));
     sum *= Scalar(0.5) * V * scale * scale;
 
-    if (m_exec_conf->getRank() == 0)
+    if (m_exec_conf->getRank() == 0 && m_dispersion)
+        {
+        // remove the self-energy, the long range part of the interaction of a particle with
+        // itself is -c_i^2 kappa^6 / 6
+        sum += m_q2 * pow(m_kappa, Scalar(6.0)) / Scalar(12.0);
+
+        // the dispersion sum has a k = 0 term
+        sum -= Scalar(M_PI * sqrt(M_PI)) * m_kappa * m_kappa * m_kappa * m_q * m_q
+               / (Scalar(6.0) * V);
+        }
+    else if (m_exec_conf->getRank() == 0)
         {
         // subtract self-energy on rank 0 (see Frenkel and Smit, and Salin and Caillol)
         sum -= m_q2
@@ -1324,6 +1777,11 @@ Scalar PPPMForceCompute::computePE()
 
 void PPPMForceCompute::computeForces(uint64_t timestep)
     {
+    if (m_dispersion)
+        {
+        updateParticleCoefficients();
+        }
+
     if (m_need_initialize || m_ptls_added_removed)
         {
         if (!m_params_set)
@@ -1340,7 +1798,7 @@ void PPPMForceCompute::computeForces(uint64_t timestep)
         // setup tables and do misc validation
         setupCoeffs();
 
-        computeInfluenceFunction();
+        updateInfluenceFunction(true);
 
         if (m_nlist->getFilterBody())
             {
@@ -1365,7 +1823,7 @@ void PPPMForceCompute::computeForces(uint64_t timestep)
         {
         if (ghost_cell_num_changed)
             setupMesh();
-        computeInfluenceFunction();
+        updateInfluenceFunction(ghost_cell_num_changed);
         m_box_changed = false;
         }
 
@@ -1378,6 +1836,11 @@ void PPPMForceCompute::computeForces(uint64_t timestep)
 
     interpolateForces();
 
+    if (m_slab_correction != SlabCorrection::none)
+        {
+        computeSlabCorrection();
+        }
+
     if (flags[pdata_flag::pressure_tensor])
         {
         computeVirial();
@@ -1388,8 +1851,9 @@ void PPPMForceCompute::computeForces(uint64_t timestep)
             m_external_virial[i] = Scalar(0.0);
         }
 
-    // If there are exclusions, correct for the long-range part of the potential
-    if (m_nlist->getExclusionsSet())
+    // If there are exclusions, correct for the long-range part of the potential unless the pair
+    // force already does
+    if (m_nlist->getExclusionsSet() && !m_pair_exclusion_correction)
         {
         m_nlist->compute(timestep);
         fixExclusions();
@@ -1435,7 +1899,10 @@ void PPPMForceCompute::computeVirial()
 
             Scalar rhog = (fourier.r * fourier.r + fourier.i * fourier.i) * h_inf_f.data[kidx];
 
-            Scalar vterm = -Scalar(2.0) * (Scalar(1.0) / ksq + Scalar(0.25) / (m_kappa * m_kappa));
+            Scalar vterm = m_dispersion ? cpu_dispersion_vterm(ksq, m_kappa)
+                                        : -Scalar(2.0)
+                                              * (Scalar(1.0) / ksq
+                                                 + Scalar(0.25) / (m_kappa * m_kappa));
             virial[0] += rhog * (Scalar(1.0) + vterm * k.x * k.x); // xx
             virial[1] += rhog * (vterm * k.x * k.y);               // xy
             virial[2] += rhog * (vterm * k.x * k.z);               // xz
@@ -1453,6 +1920,16 @@ void PPPMForceCompute::computeVirial()
         // store this rank's contribution in m_external_virial
         m_external_virial[k] = Scalar(0.5) * virial[k] * V * scale * scale;
         }
+
+    if (m_dispersion && m_exec_conf->getRank() == 0)
+        {
+        // the k = 0 term of the dispersion sum is inversely proportional to the volume
+        Scalar energy_dc = -Scalar(M_PI * sqrt(M_PI)) * m_kappa * m_kappa * m_kappa * m_q * m_q
+                           / (Scalar(6.0) * V);
+        m_external_virial[0] += energy_dc;
+        m_external_virial[3] += energy_dc;
+        m_external_virial[5] += energy_dc;
+        }
     }
 
 //! The real space form of the long-range interaction part, for exclusions
@@ -1476,6 +1953,24 @@ eval_pppm_real_space(Scalar alpha, Scalar kappa, Scalar rsq, Scalar& pair_eng, S
           / rsq;
     }
 
+//! The long range part of the Coulomb or the dispersion interaction of unit coefficients
+inline void eval_pppm_long_range(bool dispersion,
+                                 Scalar alpha,
+                                 Scalar kappa,
+                                 Scalar rsq,
+                                 Scalar& pair_eng,
+                                 Scalar& force_divr)
+    {
+    if (dispersion)
+        {
+        EvaluatorPairLJDispersionEwald::evalLongRange(rsq, kappa, force_divr, pair_eng);
+        }
+    else
+        {
+        eval_pppm_real_space(alpha, kappa, rsq, pair_eng, force_divr);
+        }
+    }
+
 void PPPMForceCompute::computeBodyCorrection()
     {
     // do an N^2 search over particles in a body, subtracting the real-space long-range part from
@@ -1542,14 +2037,14 @@ void PPPMForceCompute::computeBodyCorrection()
                 unsigned int i = iti->second;
 
                 vec3<Scalar> posi(snap.pos[i]);
-                Scalar qi(snap.charge[i]);
+                Scalar qi(m_dispersion ? m_type_coefficients[snap.type[i]] : snap.charge[i]);
                 int3 img_i = snap.image[i];
 
                 for (auto itj = it; itj != body_end; ++itj)
                     {
                     unsigned int j = itj->second;
                     vec3<Scalar> posj(snap.pos[j]);
-                    Scalar qj(snap.charge[j]);
+                    Scalar qj(m_dispersion ? m_type_coefficients[snap.type[j]] : snap.charge[j]);
 
                     Scalar qiqj = qi * qj;
 
@@ -1566,7 +2061,12 @@ void PPPMForceCompute::computeBodyCorrection()
                         Scalar pair_eng(0.0);
 
                         // compute correction
-                        eval_pppm_real_space(m_alpha, m_kappa, rsq, pair_eng, force_divr);
+                        eval_pppm_long_range(m_dispersion,
+                                             m_alpha,
+                                             m_kappa,
+                                             rsq,
+                                             pair_eng,
+                                             force_divr);
 
                         // subtract long range self-energy
                         body_energy -= Scalar(0.5) * qiqj * pair_eng;
@@ -1613,7 +2113,7 @@ void PPPMForceCompute::fixExclusions()
     Index2D nex = m_nlist->getExListIndexer();
 
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(getCoefficients(), access_location::host, access_mode::read);
 
     for (unsigned int i = 0; i < group_size; i++)
         {
@@ -1655,7 +2155,7 @@ void PPPMForceCompute::fixExclusions()
             if (qiqj != Scalar(0.0))
                 {
                 // evaluate the long-range pair potential
-                eval_pppm_real_space(m_alpha, m_kappa, rsq, pair_eng, force_divr);
+                eval_pppm_long_range(m_dispersion, m_alpha, m_kappa, rsq, pair_eng, force_divr);
 
                 // subtract long-range part of pair-interaction
                 force_divr = -qiqj * force_divr;
@@ -1683,6 +2183,337 @@ void PPPMForceCompute::fixExclusions()
         }
     }
 
+/*! \param slab_correction Name of the slab correction
+ */
+void PPPMForceCompute::setSlabCorrection(const std::string& slab_correction)
+    {
+    if (slab_correction == "none")
+        {
+        m_slab_correction = SlabCorrection::none;
+        }
+    else if (m_dispersion)
+        {
+        throw std::invalid_argument("The slab corrections apply to the Coulomb interaction only.");
+        }
+    else if (slab_correction == "dipole")
+        {
+        m_slab_correction = SlabCorrection::dipole;
+        }
+    else if (slab_correction == "elc")
+        {
+        m_slab_correction = SlabCorrection::elc;
+        }
+    else
+        {
+        throw std::invalid_argument("Invalid slab correction: " + slab_correction);
+        }
+    }
+
+std::string PPPMForceCompute::getSlabCorrection()
+    {
+    switch (m_slab_correction)
+        {
+    case SlabCorrection::dipole:
+        return "dipole";
+    case SlabCorrection::elc:
+        return "elc";
+    default:
+        return "none";
+        }
+    }
+
+/*! The dipole correction of Yeh and Berkowitz (1999), with the terms for non-neutral systems of
+    Ballenegger et al. (2009), removes the interactions of the slab with its periodic images along z
+    to the order of the dipole moment. It requires a large vacuum gap.
+
+    The electrostatic layer correction (ELC) of Arnold, de Joannis, and Holm (2002) also subtracts
+    the remaining interactions with the image layers. It expands them in Fourier modes k of the
+    xy-plane:
+
+    E_lc = 2 pi / A sum_{k != 0} [C_c^2 + S_c^2 - C_s^2 - S_s^2] / (|k| (exp(|k| L_z) - 1))
+
+    where C_c = sum_i q_i cos(k.r_i) cosh(|k| z_i), S_s = sum_i q_i sin(k.r_i) sinh(|k| z_i), and so
+    on. The terms decay with exp(-|k| gap), so a small vacuum gap suffices. Modes are included up to
+    the wave number at which this factor drops below EPS_HOC. ELC assumes a neutral system.
+
+    Neither correction contributes to the virial.
+*/
+void PPPMForceCompute::computeSlabCorrection()
+    {
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    if (global_box.getTiltFactorXZ() != Scalar(0.0) || global_box.getTiltFactorYZ() != Scalar(0.0))
+        {
+        throw std::runtime_error("The PPPM slab correction requires a box with xz = yz = 0.");
+        }
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::readwrite);
+
+    Scalar3 L = global_box.getL();
+    Scalar V = global_box.getVolume();
+    Scalar z_center = global_box.getLo().z + Scalar(0.5) * L.z;
+
+    // total charge, dipole moment, and second moment along z, and the extent of the slab
+    Scalar moments[3] = {Scalar(0.0), Scalar(0.0), Scalar(0.0)};
+    Scalar z_min = L.z;
+    Scalar z_max = -L.z;
+
+    unsigned int group_size = m_group->getNumMembers();
+    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        {
+        unsigned int idx = m_group->getMemberIndex(group_idx);
+        Scalar qi = h_charge.data[idx];
+        Scalar z = h_postype.data[idx].z - z_center;
+
+        if (std::isnan(z) || qi == Scalar(0.0))
+            {
+            continue;
+            }
+
+        moments[0] += qi;
+        moments[1] += qi * z;
+        moments[2] += qi * z * z;
+        z_min = std::min(z_min, z);
+        z_max = std::max(z_max, z);
+        }
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Comm comm = m_exec_conf->getMPICommunicator();
+        MPI_Allreduce(MPI_IN_PLACE, moments, 3, MPI_HOOMD_SCALAR, MPI_SUM, comm);
+        MPI_Allreduce(MPI_IN_PLACE, &z_min, 1, MPI_HOOMD_SCALAR, MPI_MIN, comm);
+        MPI_Allreduce(MPI_IN_PLACE, &z_max, 1, MPI_HOOMD_SCALAR, MPI_MAX, comm);
+        }
+#endif
+
+    Scalar Q = moments[0];
+    Scalar M_z = moments[1];
+    Scalar energy = Scalar(2.0 * M_PI) / V
+                    * (M_z * M_z - Q * moments[2] - Q * Q * L.z * L.z / Scalar(12.0));
+
+    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        {
+        unsigned int idx = m_group->getMemberIndex(group_idx);
+        Scalar qi = h_charge.data[idx];
+        Scalar z = h_postype.data[idx].z - z_center;
+
+        if (std::isnan(z))
+            {
+            continue;
+            }
+
+        h_force.data[idx].z -= Scalar(4.0 * M_PI) / V * qi * (M_z - Q * z);
+        }
+
+    if (m_slab_correction == SlabCorrection::elc)
+        {
+        double gap = L.z - (z_max - z_min);
+        if (gap <= 0.0)
+            {
+            throw std::runtime_error("ELC requires a vacuum gap along z.");
+            }
+
+        // measure z from the middle of the slab to keep cosh(|k| z) small
+        double z_slab = z_center + 0.5 * (z_min + z_max);
+        double k_cut = -log(EPS_HOC) / gap;
+
+        // reciprocal lattice vectors of the xy-plane
+        Scalar3 a1 = global_box.getLatticeVector(0);
+        Scalar3 a2 = global_box.getLatticeVector(1);
+        double area = double(L.x) * double(L.y);
+        double b1_x = 2.0 * M_PI / L.x;
+        double b1_y = -2.0 * M_PI * a2.x / area;
+        double b2_y = 2.0 * M_PI / L.y;
+
+        int p_max = int(ceil(k_cut * sqrt(dot(a1, a1)) / (2.0 * M_PI)));
+        int q_max = int(ceil(k_cut * sqrt(dot(a2, a2)) / (2.0 * M_PI)));
+
+        // one wave vector of each pair k, -k, both contribute equally to the weight
+        std::vector<double> k_x, k_y, k_norm, weight;
+        for (int p = 0; p <= p_max; ++p)
+            {
+            for (int q = -q_max; q <= q_max; ++q)
+                {
+                if (p == 0 && q <= 0)
+                    {
+                    continue;
+                    }
+
+                double kx = p * b1_x;
+                double ky = p * b1_y + q * b2_y;
+                double k = sqrt(kx * kx + ky * ky);
+                if (k > k_cut)
+                    {
+                    continue;
+                    }
+
+                k_x.push_back(kx);
+                k_y.push_back(ky);
+                k_norm.push_back(k);
+                weight.push_back(2.0 * 2.0 * M_PI / area / (k * expm1(k * L.z)));
+                }
+            }
+
+        // the sums C_c, S_c, C_s, and S_s of every mode
+        unsigned int n_modes = (unsigned int)k_norm.size();
+        std::vector<double> sums(4 * n_modes, 0.0);
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            {
+            unsigned int idx = m_group->getMemberIndex(group_idx);
+            Scalar4 postype = h_postype.data[idx];
+            double qi = h_charge.data[idx];
+            double z = postype.z - z_slab;
+
+            if (std::isnan(z) || qi == 0.0)
+                {
+                continue;
+                }
+
+            for (unsigned int m = 0; m < n_modes; ++m)
+                {
+                double arg = k_x[m] * postype.x + k_y[m] * postype.y;
+                double c = cos(arg);
+                double s = sin(arg);
+                double ch = cosh(k_norm[m] * z);
+                double sh = sinh(k_norm[m] * z);
+                sums[4 * m] += qi * c * ch;
+                sums[4 * m + 1] += qi * s * ch;
+                sums[4 * m + 2] += qi * c * sh;
+                sums[4 * m + 3] += qi * s * sh;
+                }
+            }
+
+#ifdef ENABLE_MPI
+        if (m_pdata->getDomainDecomposition())
+            {
+            MPI_Allreduce(MPI_IN_PLACE,
+                          sums.data(),
+                          4 * n_modes,
+                          MPI_DOUBLE,
+                          MPI_SUM,
+                          m_exec_conf->getMPICommunicator());
+            }
+#endif
+
+        for (unsigned int m = 0; m < n_modes; ++m)
+            {
+            const double* sum = &sums[4 * m];
+            energy -= Scalar(
+                weight[m]
+                * (sum[0] * sum[0] + sum[1] * sum[1] - sum[2] * sum[2] - sum[3] * sum[3]));
+            }
+
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            {
+            unsigned int idx = m_group->getMemberIndex(group_idx);
+            Scalar4 postype = h_postype.data[idx];
+            double qi = h_charge.data[idx];
+            double z = postype.z - z_slab;
+
+            if (std::isnan(z) || qi == 0.0)
+                {
+                continue;
+                }
+
+            double3 force = make_double3(0.0, 0.0, 0.0);
+            for (unsigned int m = 0; m < n_modes; ++m)
+                {
+                const double* sum = &sums[4 * m];
+                double arg = k_x[m] * postype.x + k_y[m] * postype.y;
+                double c = cos(arg);
+                double s = sin(arg);
+                double ch = cosh(k_norm[m] * z);
+                double sh = sinh(k_norm[m] * z);
+
+                // derivatives of the mode term with respect to arg and z
+                double d_arg = 2.0 * qi * (-sum[0] * s * ch + sum[1] * c * ch + sum[2] * s * sh
+                                           - sum[3] * c * sh);
+                double d_z = 2.0 * qi * k_norm[m]
+                             * (sum[0] * c * sh + sum[1] * s * sh - sum[2] * c * ch
+                                - sum[3] * s * ch);
+
+                // the energy correction is -E_lc
+                force.x += weight[m] * d_arg * k_x[m];
+                force.y += weight[m] * d_arg * k_y[m];
+                force.z += weight[m] * d_z;
+                }
+
+            h_force.data[idx].x += Scalar(force.x);
+            h_force.data[idx].y += Scalar(force.y);
+            h_force.data[idx].z += Scalar(force.z);
+            }
+        }
+
+    // the sums are global, add the energy once
+    if (m_exec_conf->getRank() == 0)
+        {
+        m_external_energy += energy;
+        }
+    }
+
+/*! \param coefficients Dispersion coefficient c of each type, empty for the Coulomb interaction
+
+    The mesh computes the dispersion interaction -c_i c_j / r^6 of all pairs instead of the Coulomb
+    interaction of the charges.
+*/
+void PPPMForceCompute::setDispersionCoefficients(pybind11::list coefficients)
+    {
+    std::vector<Scalar> type_coefficients;
+    for (auto item : coefficients)
+        {
+        type_coefficients.push_back(item.cast<Scalar>());
+        }
+
+    if (!type_coefficients.empty() && type_coefficients.size() != m_pdata->getNTypes())
+        {
+        throw std::invalid_argument("Expected one dispersion coefficient per particle type.");
+        }
+    if (!type_coefficients.empty() && m_slab_correction != SlabCorrection::none)
+        {
+        throw std::invalid_argument("The slab corrections apply to the Coulomb interaction only.");
+        }
+
+    m_type_coefficients = type_coefficients;
+    m_dispersion = !m_type_coefficients.empty();
+    m_need_initialize = true;
+    }
+
+pybind11::list PPPMForceCompute::getDispersionCoefficients()
+    {
+    pybind11::list result;
+    for (Scalar c : m_type_coefficients)
+        {
+        result.append(c);
+        }
+    return result;
+    }
+
+void PPPMForceCompute::updateParticleCoefficients()
+    {
+    unsigned int n = m_pdata->getN() + m_pdata->getNGhosts();
+    if (m_particle_coefficients.getNumElements() < n)
+        {
+        GlobalArray<Scalar> particle_coefficients(m_pdata->getMaxN(), m_exec_conf);
+        m_particle_coefficients.swap(particle_coefficients);
+        }
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<Scalar> h_coefficients(m_particle_coefficients,
+                                       access_location::host,
+                                       access_mode::overwrite);
+
+    for (unsigned int i = 0; i < n; i++)
+        {
+        h_coefficients.data[i] = m_type_coefficients[__scalar_as_int(h_postype.data[i].w)];
+        }
+    }
+
 Scalar PPPMForceCompute::getQSum()
     {
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
@@ -1755,7 +2586,23 @@ void export_PPPMForceCompute(pybind11::module& m)
         .def_property_readonly("order", &PPPMForceCompute::getOrder)
         .def_property_readonly("kappa", &PPPMForceCompute::getKappa)
         .def_property_readonly("r_cut", &PPPMForceCompute::getRCut)
-        .def_property_readonly("alpha", &PPPMForceCompute::getAlpha);
+        .def_property_readonly("alpha", &PPPMForceCompute::getAlpha)
+        .def_property_readonly("differentiation", &PPPMForceCompute::getDifferentiation)
+        .def_property("slab_correction",
+                      &PPPMForceCompute::getSlabCorrection,
+                      &PPPMForceCompute::setSlabCorrection)
+        .def_property("influence_tolerance",
+                      &PPPMForceCompute::getInfluenceTolerance,
+                      &PPPMForceCompute::setInfluenceTolerance)
+        .def_property("influence_recompute_period",
+                      &PPPMForceCompute::getInfluenceRecomputePeriod,
+                      &PPPMForceCompute::setInfluenceRecomputePeriod)
+        .def_property("pair_exclusion_correction",
+                      &PPPMForceCompute::getPairExclusionCorrection,
+                      &PPPMForceCompute::setPairExclusionCorrection)
+        .def_property_readonly("dispersion", &PPPMForceCompute::getDispersion)
+        .def("setDispersionCoefficients", &PPPMForceCompute::setDispersionCoefficients)
+        .def("getDispersionCoefficients", &PPPMForceCompute::getDispersionCoefficients);
     }
 
     } // end namespace detail
@@ -15,8 +15,14 @@
 
 #include "hoomd/extern/kiss_fftnd.h"
 
+#ifdef ENABLE_FFTW
+#include <fftw3.h>
+#endif
+
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
+#include <stdexcept>
+#include <vector>
 
 namespace hoomd
     {
@@ -43,7 +49,8 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
                            unsigned int order,
                            Scalar kappa,
                            Scalar rcut,
-                           Scalar alpha = 0);
+                           Scalar alpha = 0,
+                           bool analytical_differentiation = false);
 
     void computeForces(uint64_t timestep);
 
@@ -84,6 +91,74 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         return m_alpha;
         }
 
+    /// Get the differentiation scheme, "ik" or "ad"
+    std::string getDifferentiation()
+        {
+        return m_analytical_differentiation ? "ad" : "ik";
+        }
+
+    /// Set the slab correction, "none", "dipole", or "elc"
+    void setSlabCorrection(const std::string& slab_correction);
+
+    /// Get the slab correction
+    std::string getSlabCorrection();
+
+    /// Set the largest box change for which the influence function is rescaled
+    void setInfluenceTolerance(Scalar tolerance)
+        {
+        if (tolerance < Scalar(0.0))
+            {
+            throw std::domain_error("influence_tolerance must be non-negative.");
+            }
+        m_influence_tolerance = tolerance;
+        }
+
+    /// Get the largest box change for which the influence function is rescaled
+    Scalar getInfluenceTolerance()
+        {
+        return m_influence_tolerance;
+        }
+
+    /// Set the number of rescaled updates between exact computations of the influence function
+    void setInfluenceRecomputePeriod(unsigned int period)
+        {
+        if (period == 0)
+            {
+            throw std::domain_error("influence_recompute_period must be positive.");
+            }
+        m_influence_recompute_period = period;
+        }
+
+    /// Get the number of rescaled updates between exact computations of the influence function
+    unsigned int getInfluenceRecomputePeriod()
+        {
+        return m_influence_recompute_period;
+        }
+
+    /// Compute the dispersion interaction with the given per type coefficients
+    void setDispersionCoefficients(pybind11::list coefficients);
+
+    /// Get the per type dispersion coefficients, empty for the Coulomb interaction
+    pybind11::list getDispersionCoefficients();
+
+    /// Get whether the mesh computes the dispersion interaction instead of the Coulomb one
+    bool getDispersion()
+        {
+        return m_dispersion;
+        }
+
+    /// Set whether the pair force corrects the excluded pairs instead of fixExclusions()
+    void setPairExclusionCorrection(bool pair_exclusion_correction)
+        {
+        m_pair_exclusion_correction = pair_exclusion_correction;
+        }
+
+    /// Get whether the pair force corrects the excluded pairs instead of fixExclusions()
+    bool getPairExclusionCorrection()
+        {
+        return m_pair_exclusion_correction;
+        }
+
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     /*! \param timestep Current time step
@@ -136,6 +211,22 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
     bool m_params_set;            //!< True if parameters are set
     bool m_box_changed;           //!< True if box has changed since last compute
 
+    /// Relative box change below which the influence function is rescaled, 0 to disable
+    Scalar m_influence_tolerance;
+
+    /// Largest number of consecutive rescaled updates of the influence function
+    unsigned int m_influence_recompute_period;
+
+    /// True when the real space pair force adds the exclusion correction in its pair loop
+    bool m_pair_exclusion_correction = false;
+
+    /// Number of rescaled updates since the last exact computation
+    unsigned int m_n_influence_rescaled;
+
+    GlobalArray<Scalar> m_inf_f_ref; //!< Influence function from the last exact computation
+    BoxDim m_inf_f_ref_box;          //!< Global box of the last exact computation
+    BoxDim m_k_box;                  //!< Global box of the wave vectors in m_k
+
     GlobalArray<Scalar> m_virial_mesh; //!< k-space mesh of virial tensor values
 
     Scalar m_kappa; //!< Splitting parameter
@@ -143,9 +234,28 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
     int m_order;    //!< Order of interpolation scheme
     Scalar m_alpha; //!< Debye screening parameter
 
+    /// True when the forces are computed by differentiating the assignment function (ad scheme)
+    bool m_analytical_differentiation;
+
+    /// Corrections for systems that are periodic in x and y only
+    enum class SlabCorrection
+        {
+        none,   //!< Fully periodic system
+        dipole, //!< Dipole correction of Yeh and Berkowitz
+        elc     //!< Dipole correction and electrostatic layer correction (ELC)
+        };
+
+    SlabCorrection m_slab_correction; //!< The slab correction to apply
+
     Scalar m_q;  //!< Total system charge
     Scalar m_q2; //!< Sum of charge squared
 
+    /// True when the mesh computes the dispersion interaction -c_i c_j / r^6
+    bool m_dispersion = false;
+
+    std::vector<Scalar> m_type_coefficients;     //!< Dispersion coefficient c of each type
+    GlobalArray<Scalar> m_particle_coefficients; //!< Dispersion coefficient of each particle
+
     GlobalArray<Scalar> m_rho_coeff; //!< Coefficients for computing the grid based charge density
     GlobalArray<Scalar> m_gf_b;      //!< Green function coefficients
 
@@ -164,6 +274,15 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         m_box_changed = true;
         }
 
+    //! Get the per particle coefficients that are assigned to the mesh
+    const GlobalArray<Scalar>& getCoefficients()
+        {
+        return m_dispersion ? m_particle_coefficients : m_pdata->getCharges();
+        }
+
+    //! Look up the dispersion coefficients of the local and ghost particles
+    void updateParticleCoefficients();
+
     //! Helper function to setup the mesh indices
     void setupMesh();
 
@@ -173,6 +292,12 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
     //! Compute the optimal influence function
     virtual void computeInfluenceFunction();
 
+    //! Update the influence function after a box change, rescaling it when possible
+    void updateInfluenceFunction(bool exact);
+
+    //! Rescale the reference influence function to the current box
+    void rescaleInfluenceFunction();
+
     //! Helper function to assign particle coordinates to mesh
     virtual void assignParticles();
 
@@ -182,6 +307,15 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
     //! Helper function to interpolate the forces
     virtual void interpolateForces();
 
+    //! Copy the coefficients of the assignment function for a compile time order
+    template<int order> void loadRhoCoeff(Scalar* rho_coeff);
+
+    //! Assign particles to the mesh with a compile time interpolation order
+    template<int order> void assignParticlesOrder();
+
+    //! Interpolate the forces with a compile time interpolation order
+    template<int order> void interpolateForcesOrder();
+
     //! Helper function to calculate value of potential energy
     virtual Scalar computePE();
 
@@ -197,6 +331,9 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
     //! Compute rigid body correction
     virtual void computeBodyCorrection();
 
+    //! Add the slab correction to the forces and the energy
+    void computeSlabCorrection();
+
     private:
     kiss_fftnd_cfg m_kiss_fft = NULL;  //!< The FFT configuration
     kiss_fftnd_cfg m_kiss_ifft = NULL; //!< Inverse FFT configuration
@@ -212,6 +349,20 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
 
     bool m_kiss_fft_initialized; //!< True if a local KISS FFT has been set up
 
+#ifdef ENABLE_FFTW
+    fftwf_plan m_fftw_plan_forward = nullptr; //!< Local FFTW plan for the forward transform
+    fftwf_plan m_fftw_plan_inverse = nullptr; //!< Local FFTW plan for the inverse transform
+
+    //! Create the local FFTW plans, falling back to KISS FFT when planning fails
+    void setupFFTW(const int dims[3]);
+
+    //! Destroy the local FFTW plans
+    void destroyFFTW();
+#endif
+
+    //! Perform a local forward or inverse transform
+    void localFFT(kiss_fft_cpx* in, kiss_fft_cpx* out, bool inverse);
+
     GlobalArray<kiss_fft_cpx> m_mesh;         //!< The particle density mesh
     GlobalArray<kiss_fft_cpx> m_fourier_mesh; //!< The fourier transformed mesh
     GlobalArray<kiss_fft_cpx>
@@ -121,6 +121,13 @@ __device__ int3 find_cell(const Scalar3& pos,
     return make_int3(ix, iy, iz);
     }
 
+//! Assign the particle charges to the mesh
+/*! \tparam order Interpolation order
+
+    The stencil loops have compile time bounds and the weights along each direction are computed
+    once per particle and kept in registers.
+*/
+template<int order>
 __global__ void gpu_assign_particles_kernel(const uint3 mesh_dim,
                                             const uint3 n_ghost_bins,
                                             unsigned int work_size,
@@ -129,7 +136,6 @@ __global__ void gpu_assign_particles_kernel(const uint3 mesh_dim,
                                             const Scalar* d_charge,
                                             hipfftComplex* d_mesh,
                                             Scalar V_cell,
-                                            int order,
                                             unsigned int offset,
                                             BoxDim box,
                                             const Scalar* d_rho_coeff)
@@ -137,7 +143,7 @@ __global__ void gpu_assign_particles_kernel(const uint3 mesh_dim,
     extern __shared__ Scalar s_coeff[];
 
     // load in interpolation coefficients
-    unsigned int ncoeffs = order * (2 * order + 1);
+    const unsigned int ncoeffs = order * (2 * order + 1);
     for (unsigned int cur_offset = 0; cur_offset < ncoeffs; cur_offset += blockDim.x)
         {
         if (cur_offset + threadIdx.x < ncoeffs)
@@ -179,35 +185,34 @@ __global__ void gpu_assign_particles_kernel(const uint3 mesh_dim,
         return;
         }
 
-    int i = bin_coord.x;
-    int j = bin_coord.y;
-    int k = bin_coord.z;
-
-    int nlower = -(order - 1) / 2;
-    int nupper = order / 2;
-
-    Scalar result;
-
-    int mult_fact = 2 * order + 1;
-
-    Scalar x0 = qi;
-
-    bool ignore_x = false;
-    bool ignore_y = false;
-    bool ignore_z = false;
+    const int nlower = -(order - 1) / 2;
+    const int mult_fact = 2 * order + 1;
 
-    // loop over neighboring bins
-    for (int l = nlower; l <= nupper; ++l)
+    // precalculate the assignment factors along each direction
+    Scalar Wx[order], Wy[order], Wz[order];
+#pragma unroll
+    for (int l = 0; l < order; ++l)
         {
-        // precalculate assignment factor
-        result = Scalar(0.0);
+        Scalar wx(0.0), wy(0.0), wz(0.0);
+#pragma unroll
         for (int iorder = order - 1; iorder >= 0; iorder--)
             {
-            result = s_coeff[l - nlower + iorder * mult_fact] + result * dr.x;
+            Scalar c = s_coeff[l + iorder * mult_fact];
+            wx = c + wx * dr.x;
+            wy = c + wy * dr.y;
+            wz = c + wz * dr.z;
             }
-        Scalar y0 = x0 * result;
+        Wx[l] = qi * wx;
+        Wy[l] = wy;
+        Wz[l] = wz / V_cell;
+        }
 
-        int neighi = i + l;
+    // loop over neighboring bins
+#pragma unroll
+    for (int l = 0; l < order; ++l)
+        {
+        int neighi = bin_coord.x + nlower + l;
+        bool ignore_x = false;
         if (neighi >= (int)bin_dim.x)
             {
             if (!n_ghost_bins.x)
@@ -223,16 +228,11 @@ __global__ void gpu_assign_particles_kernel(const uint3 mesh_dim,
                 ignore_x = true;
             }
 
-        for (int m = nlower; m <= nupper; ++m)
+#pragma unroll
+        for (int m = 0; m < order; ++m)
             {
-            result = Scalar(0.0);
-            for (int iorder = order - 1; iorder >= 0; iorder--)
-                {
-                result = s_coeff[m - nlower + iorder * mult_fact] + result * dr.y;
-                }
-            Scalar z0 = y0 * result;
-
-            int neighj = j + m;
+            int neighj = bin_coord.y + nlower + m;
+            bool ignore_y = false;
             if (neighj >= (int)bin_dim.y)
                 {
                 if (!n_ghost_bins.y)
@@ -248,16 +248,13 @@ __global__ void gpu_assign_particles_kernel(const uint3 mesh_dim,
                     ignore_y = true;
                 }
 
-            for (int n = nlower; n <= nupper; ++n)
-                {
-                result = Scalar(0.0);
-                for (int iorder = order - 1; iorder >= 0; iorder--)
-                    {
-                    result = s_coeff[n - nlower + iorder * mult_fact] + result * dr.z;
-                    }
-
-                int neighk = k + n;
+            Scalar Wxy = Wx[l] * Wy[m];
 
+#pragma unroll
+            for (int n = 0; n < order; ++n)
+                {
+                int neighk = bin_coord.z + nlower + n;
+                bool ignore_z = false;
                 if (neighk >= (int)bin_dim.z)
                     {
                     if (!n_ghost_bins.z)
@@ -280,14 +277,10 @@ __global__ void gpu_assign_particles_kernel(const uint3 mesh_dim,
 
                     // compute fraction of particle density assigned to cell
                     // from particles in this bin
-                    myAtomicAdd(&d_mesh[cell_idx].x, z0 * result / V_cell);
+                    myAtomicAdd(&d_mesh[cell_idx].x, Wxy * Wz[n]);
                     }
-
-                ignore_z = false;
                 }
-            ignore_y = false;
             }
-        ignore_x = false;
         } // end of loop over neighboring bins
     }
 
@@ -335,9 +328,33 @@ void gpu_assign_particles(const uint3 mesh_dim,
     hipMemsetAsync(d_mesh, 0, sizeof(hipfftComplex) * grid_dim.x * grid_dim.y * grid_dim.z);
     Scalar V_cell = box.getVolume() / (Scalar)(mesh_dim.x * mesh_dim.y * mesh_dim.z);
 
+    // select the kernel for the interpolation order
+    auto kernel = &gpu_assign_particles_kernel<GPU_PPPM_MAX_ORDER>;
+    switch (order)
+        {
+    case 1:
+        kernel = &gpu_assign_particles_kernel<1>;
+        break;
+    case 2:
+        kernel = &gpu_assign_particles_kernel<2>;
+        break;
+    case 3:
+        kernel = &gpu_assign_particles_kernel<3>;
+        break;
+    case 4:
+        kernel = &gpu_assign_particles_kernel<4>;
+        break;
+    case 5:
+        kernel = &gpu_assign_particles_kernel<5>;
+        break;
+    case 6:
+        kernel = &gpu_assign_particles_kernel<6>;
+        break;
+        }
+
     unsigned int max_block_size;
     hipFuncAttributes attr;
-    hipFuncGetAttributes(&attr, (const void*)gpu_assign_particles_kernel);
+    hipFuncGetAttributes(&attr, (const void*)kernel);
     max_block_size = attr.maxThreadsPerBlock;
 
     unsigned int run_block_size = min(max_block_size, block_size);
@@ -365,7 +382,7 @@ void gpu_assign_particles(const uint3 mesh_dim,
         unsigned int n_blocks = nwork / run_block_size + 1;
         const size_t shared_bytes = order * (2 * order + 1) * sizeof(Scalar);
 
-        hipLaunchKernelGGL((gpu_assign_particles_kernel),
+        hipLaunchKernelGGL((kernel),
                            dim3(n_blocks),
                            dim3(run_block_size),
                            shared_bytes,
@@ -378,7 +395,6 @@ void gpu_assign_particles(const uint3 mesh_dim,
                            d_charge,
                            ngpu > 1 ? d_mesh_scratch + idev * mesh_elements : d_mesh,
                            V_cell,
-                           order,
                            range.first,
                            box,
                            d_rho_coeff);
@@ -549,6 +565,10 @@ void gpu_update_meshes(const unsigned int n_wave_vectors,
                        NNN);
     }
 
+//! Interpolate the forces from the field meshes
+/*! \tparam order Interpolation order
+*/
+template<int order>
 __global__ void gpu_compute_forces_kernel(const unsigned int work_size,
                                           const Scalar4* d_postype,
                                           Scalar4* d_force,
@@ -556,7 +576,6 @@ __global__ void gpu_compute_forces_kernel(const unsigned int work_size,
                                           const uint3 n_ghost_cells,
                                           const Scalar* d_charge,
                                           const BoxDim box,
-                                          int order,
                                           const unsigned int* d_index_array,
                                           const hipfftComplex* inv_fourier_mesh_x,
                                           const hipfftComplex* inv_fourier_mesh_y,
@@ -567,7 +586,7 @@ __global__ void gpu_compute_forces_kernel(const unsigned int work_size,
     extern __shared__ Scalar s_coeff[];
 
     // load in interpolation coefficients
-    unsigned int ncoeffs = order * (2 * order + 1);
+    const unsigned int ncoeffs = order * (2 * order + 1);
     for (unsigned int cur_offset = 0; cur_offset < ncoeffs; cur_offset += blockDim.x)
         {
         if (cur_offset + threadIdx.x < ncoeffs)
@@ -593,7 +612,6 @@ __global__ void gpu_compute_forces_kernel(const unsigned int work_size,
     Scalar4 postype = d_postype[idx];
 
     Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
-    unsigned int type = __scalar_as_int(postype.w);
     Scalar qi = d_charge[idx];
 
     Scalar3 dr = make_scalar3(0, 0, 0);
@@ -612,60 +630,59 @@ __global__ void gpu_compute_forces_kernel(const unsigned int work_size,
 
     Scalar3 force = make_scalar3(0.0, 0.0, 0.0);
 
-    int nlower = -(order - 1) / 2;
-    int nupper = order / 2;
+    const int nlower = -(order - 1) / 2;
+    const int mult_fact = 2 * order + 1;
 
-    Scalar result;
-    int mult_fact = 2 * order + 1;
+    // precalculate the assignment factors along each direction
+    Scalar Wx[order], Wy[order], Wz[order];
+#pragma unroll
+    for (int l = 0; l < order; ++l)
+        {
+        Scalar wx(0.0), wy(0.0), wz(0.0);
+#pragma unroll
+        for (int k = order - 1; k >= 0; k--)
+            {
+            Scalar c = s_coeff[l + k * mult_fact];
+            wx = c + wx * dr.x;
+            wy = c + wy * dr.y;
+            wz = c + wz * dr.z;
+            }
+        Wx[l] = qi * wx;
+        Wy[l] = wy;
+        Wz[l] = wz;
+        }
 
     // back-interpolate forces from neighboring mesh points
-    for (int l = nlower; l <= nupper; ++l)
+#pragma unroll
+    for (int l = 0; l < order; ++l)
         {
-        result = Scalar(0.0);
-        for (int k = order - 1; k >= 0; k--)
+        int neighl = cell_coord.x + nlower + l;
+        if (!n_ghost_cells.x)
             {
-            result = s_coeff[l - nlower + k * mult_fact] + result * dr.x;
+            if (neighl >= (int)grid_dim.x)
+                neighl -= grid_dim.x;
+            else if (neighl < 0)
+                neighl += grid_dim.x;
             }
-        Scalar x0 = result;
 
-        for (int m = nlower; m <= nupper; ++m)
+#pragma unroll
+        for (int m = 0; m < order; ++m)
             {
-            result = Scalar(0.0);
-            for (int k = order - 1; k >= 0; k--)
+            int neighm = cell_coord.y + nlower + m;
+            if (!n_ghost_cells.y)
                 {
-                result = s_coeff[m - nlower + k * mult_fact] + result * dr.y;
+                if (neighm >= (int)grid_dim.y)
+                    neighm -= grid_dim.y;
+                else if (neighm < 0)
+                    neighm += grid_dim.y;
                 }
-            Scalar y0 = x0 * result;
-
-            for (int n = nlower; n <= nupper; ++n)
-                {
-                result = Scalar(0.0);
-                for (int k = order - 1; k >= 0; k--)
-                    {
-                    result = s_coeff[n - nlower + k * mult_fact] + result * dr.z;
-                    }
-                Scalar z0 = y0 * result;
 
-                int neighl = (int)cell_coord.x + l;
-                int neighm = (int)cell_coord.y + m;
-                int neighn = (int)cell_coord.z + n;
-
-                if (!n_ghost_cells.x)
-                    {
-                    if (neighl >= (int)grid_dim.x)
-                        neighl -= grid_dim.x;
-                    else if (neighl < 0)
-                        neighl += grid_dim.x;
-                    }
-
-                if (!n_ghost_cells.y)
-                    {
-                    if (neighm >= (int)grid_dim.y)
-                        neighm -= grid_dim.y;
-                    else if (neighm < 0)
-                        neighm += grid_dim.y;
-                    }
+            Scalar y0 = Wx[l] * Wy[m];
 
+#pragma unroll
+            for (int n = 0; n < order; ++n)
+                {
+                int neighn = cell_coord.z + nlower + n;
                 if (!n_ghost_cells.z)
                     {
                     if (neighn >= (int)grid_dim.z)
@@ -674,6 +691,8 @@ __global__ void gpu_compute_forces_kernel(const unsigned int work_size,
                         neighn += grid_dim.z;
                     }
 
+                Scalar z0 = y0 * Wz[n];
+
                 // use column-major layout
                 unsigned int cell_idx = neighl + grid_dim.x * (neighm + grid_dim.y * neighn);
 
@@ -681,9 +700,9 @@ __global__ void gpu_compute_forces_kernel(const unsigned int work_size,
                 hipfftComplex inv_mesh_y = inv_fourier_mesh_y[cell_idx];
                 hipfftComplex inv_mesh_z = inv_fourier_mesh_z[cell_idx];
 
-                force.x += qi * z0 * inv_mesh_x.x;
-                force.y += qi * z0 * inv_mesh_y.x;
-                force.z += qi * z0 * inv_mesh_z.x;
+                force.x += z0 * inv_mesh_x.x;
+                force.y += z0 * inv_mesh_y.x;
+                force.z += z0 * inv_mesh_z.x;
                 }
             }
         } // end neighbor cells loop
@@ -710,9 +729,33 @@ void gpu_compute_forces(const unsigned int N,
                         bool local_fft,
                         unsigned int inv_mesh_elements)
     {
+    // select the kernel for the interpolation order
+    auto kernel = &gpu_compute_forces_kernel<GPU_PPPM_MAX_ORDER>;
+    switch (order)
+        {
+    case 1:
+        kernel = &gpu_compute_forces_kernel<1>;
+        break;
+    case 2:
+        kernel = &gpu_compute_forces_kernel<2>;
+        break;
+    case 3:
+        kernel = &gpu_compute_forces_kernel<3>;
+        break;
+    case 4:
+        kernel = &gpu_compute_forces_kernel<4>;
+        break;
+    case 5:
+        kernel = &gpu_compute_forces_kernel<5>;
+        break;
+    case 6:
+        kernel = &gpu_compute_forces_kernel<6>;
+        break;
+        }
+
     unsigned int max_block_size;
     hipFuncAttributes attr;
-    hipFuncGetAttributes(&attr, (const void*)gpu_compute_forces_kernel);
+    hipFuncGetAttributes(&attr, (const void*)kernel);
     max_block_size = attr.maxThreadsPerBlock;
 
     unsigned int run_block_size = min(max_block_size, block_size);
@@ -736,7 +779,7 @@ void gpu_compute_forces(const unsigned int N,
         const size_t shared_bytes = order * (2 * order + 1) * sizeof(Scalar);
 
         hipLaunchKernelGGL(
-            (gpu_compute_forces_kernel),
+            (kernel),
             dim3(n_blocks),
             dim3(run_block_size),
             shared_bytes,
@@ -748,7 +791,6 @@ void gpu_compute_forces(const unsigned int N,
             n_ghost_cells,
             d_charge,
             box,
-            order,
             d_index_array,
             local_fft ? d_inv_fourier_mesh_x + idev * inv_mesh_elements : d_inv_fourier_mesh_x,
             local_fft ? d_inv_fourier_mesh_y + idev * inv_mesh_elements : d_inv_fourier_mesh_y,
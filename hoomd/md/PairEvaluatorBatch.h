@@ -0,0 +1,93 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#ifndef __PAIR_EVALUATOR_BATCH_H__
+#define __PAIR_EVALUATOR_BATCH_H__
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "hoomd/HOOMDMath.h"
+
+#include <type_traits>
+#include <utility>
+
+/*! \file PairEvaluatorBatch.h
+    \brief Defines the packed lanes for batched pair evaluation on the CPU
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace detail
+    {
+//! Packed lanes of pairs for batched evaluation on the CPU
+/*! PotentialPair packs up to \a width pairs of a particle into the input lanes and calls
+    evaluator::evalForceAndEnergyBatch(batch), which evaluates all \a width lanes and writes the
+    outputs. Lanes with rsq >= rcutsq, including the unused lanes after the last pair, must produce
+    zero force and energy.
+
+    Evaluators implement the batch entry point as a loop over the lanes without branches or early
+    exits so that the compiler can vectorize it. They gather their per type pair parameters from
+    \a params into local arrays in a separate loop first, because gathers through the parameter
+    structs prevent the vectorization of the evaluation loop. Evaluators that call exp() or erfc()
+    vectorize only when the compiler may use vector math functions (e.g. -ffast-math with glibc).
+
+    \a Real is the precision of the lanes. In mixed precision, PotentialPair evaluates the pairs in
+    float and accumulates the results in Scalar. The batches then have twice as many lanes, so that
+    a batch fills the same number of vector registers.
+
+    Evaluators that do not implement evalForceAndEnergyBatch() are evaluated one pair at a time.
+*/
+template<class param_type, class Real = Scalar> struct PairEvaluatorBatch
+    {
+    /// Number of lanes in a batch
+    static constexpr unsigned int width = 64 / sizeof(Real);
+
+    /// Squared distance between the particles of each pair
+    Real rsq[width];
+
+    /// Squared cutoff radius of each pair
+    Real rcutsq[width];
+
+    /// Product of the charges of each pair, only set when the evaluator needs charge
+    Real qiqj[width];
+
+    /// 1 to shift the energy of each pair so that it is 0 at the cutoff, 0 otherwise
+    /*! Stored as Real because arrays of bool prevent the vectorization of the evaluator loops.
+     */
+    Real energy_shift[width];
+
+    /// Parameters of all type pairs
+    const param_type* params;
+
+    /// Index of the parameters of each pair in params
+    unsigned int param_idx[width];
+
+    /// Output force divided by r of each pair
+    Real force_divr[width];
+
+    /// Output energy of each pair
+    Real pair_eng[width];
+    };
+
+//! Test if an evaluator implements evalForceAndEnergyBatch()
+template<class evaluator, class = void> struct HasBatchEvaluation : std::false_type
+    {
+    };
+
+template<class evaluator>
+struct HasBatchEvaluation<evaluator,
+                          std::void_t<decltype(evaluator::evalForceAndEnergyBatch(
+                              std::declval<PairEvaluatorBatch<typename evaluator::param_type>&>()))>>
+    : std::true_type
+    {
+    };
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __PAIR_EVALUATOR_BATCH_H__
@@ -0,0 +1,289 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file ParticleCorrelatorAnalyzer.cc
+    \brief Contains code for the ParticleCorrelatorAnalyzer class
+*/
+
+#include "ParticleCorrelatorAnalyzer.h"
+#include "hoomd/ParallelLoop.h"
+
+#include <string.h>
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System definition
+    \param trigger Steps on which to sample, must be equally spaced
+    \param group Particles to sample
+    \param quantity "msd" or "vacf"
+    \param points Number of values per level
+    \param averaging Number of values that produce one value of the next level
+    \param max_levels Maximum number of levels
+*/
+ParticleCorrelatorAnalyzer::ParticleCorrelatorAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                                                       std::shared_ptr<Trigger> trigger,
+                                                       std::shared_ptr<ParticleGroup> group,
+                                                       const std::string& quantity,
+                                                       unsigned int points,
+                                                       unsigned int averaging,
+                                                       unsigned int max_levels)
+    : Analyzer(sysdef, trigger), m_group(group), m_levels(points, averaging, max_levels),
+      m_n_levels_allocated(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing ParticleCorrelatorAnalyzer" << std::endl;
+
+    if (quantity == "msd")
+        {
+        m_quantity = msd;
+        }
+    else if (quantity == "vacf")
+        {
+        m_quantity = vacf;
+        }
+    else
+        {
+        throw std::runtime_error("Invalid correlator quantity: " + quantity);
+        }
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        throw std::runtime_error("Per-particle correlators do not support domain decomposition.");
+        }
+#endif
+
+    m_n_tags = (unsigned int)m_pdata->getRTags().size();
+
+    GPUArray<double> sums(m_levels.getNumSums(), m_exec_conf);
+    m_sums.swap(sums);
+    reset();
+    }
+
+ParticleCorrelatorAnalyzer::~ParticleCorrelatorAnalyzer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying ParticleCorrelatorAnalyzer" << std::endl;
+    }
+
+void ParticleCorrelatorAnalyzer::reset()
+    {
+    m_levels.reset();
+
+    ArrayHandle<double> h_sums(m_sums, access_location::host, access_mode::overwrite);
+    memset(h_sums.data, 0, sizeof(double) * m_levels.getNumSums());
+
+    // the ring buffers refill from the start, only the partial averages need clearing
+    if (m_n_levels_allocated > 0)
+        {
+        ArrayHandle<Scalar3> h_accum(m_accum, access_location::host, access_mode::overwrite);
+        memset(h_accum.data, 0, sizeof(Scalar3) * m_accum.getNumElements());
+        }
+    }
+
+/*! \param n_levels Number of levels to allocate
+
+    The partial averages of the new levels start at zero. GPUArray::resize() keeps the values of
+    the existing levels, which are at the front of the arrays.
+*/
+void ParticleCorrelatorAnalyzer::allocateLevels(unsigned int n_levels)
+    {
+    const size_t n_values = size_t(n_levels) * m_levels.getPoints() * m_n_tags;
+    const size_t n_accum = size_t(n_levels) * m_n_tags;
+    if (m_n_levels_allocated == 0)
+        {
+        GPUArray<Scalar3> values(n_values, m_exec_conf);
+        m_values.swap(values);
+        GPUArray<Scalar3> accum(n_accum, m_exec_conf);
+        m_accum.swap(accum);
+        }
+    else
+        {
+        m_values.resize(n_values);
+        m_accum.resize(n_accum);
+        }
+
+    ArrayHandle<Scalar3> h_accum(m_accum, access_location::host, access_mode::readwrite);
+    const size_t first_accum = size_t(m_n_levels_allocated) * m_n_tags;
+    memset(h_accum.data + first_accum, 0, sizeof(Scalar3) * (n_accum - first_accum));
+
+    m_n_levels_allocated = n_levels;
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void ParticleCorrelatorAnalyzer::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    if (m_pdata->getRTags().size() != m_n_tags)
+        {
+        throw std::runtime_error("The number of particles changed while sampling correlations.");
+        }
+
+    const unsigned int n_levels = m_levels.push();
+    if (m_levels.getNumLevels() > m_n_levels_allocated)
+        {
+        allocateLevels(m_levels.getNumLevels());
+        }
+
+    sampleParticles(n_levels);
+    m_levels.addSamples(n_levels, m_group->getNumMembersGlobal());
+    }
+
+/*! \param n_levels Number of levels that receive a value from this sample
+ */
+void ParticleCorrelatorAnalyzer::sampleParticles(unsigned int n_levels)
+    {
+    const unsigned int points = m_levels.getPoints();
+    const Scalar averaging = Scalar(m_levels.getAveraging());
+    const BoxDim box = m_pdata->getGlobalBox();
+    const size_t n_tags = m_n_tags;
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_index_array(m_group->getIndexArray(),
+                                            access_location::host,
+                                            access_mode::read);
+    ArrayHandle<Scalar3> h_values(m_values, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar3> h_accum(m_accum, access_location::host, access_mode::readwrite);
+
+    struct CorrelationSums
+        {
+        std::vector<double> sums; //!< Correlation sum of each evaluated lag
+
+        CorrelationSums& operator+=(const CorrelationSums& other)
+            {
+            if (sums.size() < other.sums.size())
+                {
+                sums.resize(other.sums.size(), 0.0);
+                }
+            for (size_t k = 0; k < other.sums.size(); k++)
+                {
+                sums[k] += other.sums[k];
+                }
+            return *this;
+            }
+        };
+
+    // each particle writes only its own buffer entries, so the ranges are independent
+    auto sample_range = [&](unsigned int first, unsigned int last, CorrelationSums& result)
+    {
+        result.sums.resize(n_levels * points, 0.0);
+        for (unsigned int group_idx = first; group_idx < last; group_idx++)
+            {
+            const unsigned int idx = h_index_array.data[group_idx];
+            const size_t tag = h_tag.data[idx];
+
+            Scalar3 value;
+            if (m_quantity == msd)
+                {
+                const Scalar4 postype = h_pos.data[idx];
+                value = box.shift(make_scalar3(postype.x, postype.y, postype.z),
+                                  h_image.data[idx]);
+                }
+            else
+                {
+                value = make_scalar3(h_vel.data[idx].x, h_vel.data[idx].y, h_vel.data[idx].z);
+                }
+
+            for (unsigned int level = 0; level < n_levels; level++)
+                {
+                if (level > 0 && m_quantity == vacf)
+                    {
+                    Scalar3& accum = h_accum.data[(level - 1) * n_tags + tag];
+                    value = accum / averaging;
+                    accum = make_scalar3(0, 0, 0);
+                    }
+
+                const unsigned int position = m_levels.getPosition(level);
+                h_values.data[(level * points + position) * n_tags + tag] = value;
+                if (m_quantity == vacf)
+                    {
+                    h_accum.data[level * n_tags + tag] += value;
+                    }
+
+                const unsigned int n_filled = m_levels.getNumFilled(level);
+                for (unsigned int j = m_levels.getFirstLag(level); j < n_filled; j++)
+                    {
+                    const unsigned int old = (position + points - j) % points;
+                    const Scalar3 value_old = h_values.data[(level * points + old) * n_tags + tag];
+                    Scalar correlation;
+                    if (m_quantity == msd)
+                        {
+                        const Scalar3 dr = value - value_old;
+                        correlation = dot(dr, dr);
+                        }
+                    else
+                        {
+                        correlation = dot(value, value_old);
+                        }
+                    result.sums[level * points + j] += correlation;
+                    }
+                }
+            }
+    };
+
+    CorrelationSums total;
+    total.sums.resize(n_levels * points, 0.0);
+    hoomd::detail::parallel_accumulate(*m_exec_conf,
+                                       m_group->getNumMembers(),
+                                       total,
+                                       sample_range);
+
+    ArrayHandle<double> h_sums(m_sums, access_location::host, access_mode::readwrite);
+    for (size_t k = 0; k < total.sums.size(); k++)
+        {
+        h_sums.data[k] += total.sums[k];
+        }
+    }
+
+/*! \returns The lags with samples in units of the sample period
+ */
+pybind11::object ParticleCorrelatorAnalyzer::getLags()
+    {
+    ArrayHandle<double> h_sums(m_sums, access_location::host, access_mode::read);
+    std::vector<uint64_t> lags;
+    std::vector<double> values;
+    m_levels.getCorrelation(h_sums.data, lags, values);
+    return pybind11::array_t<uint64_t>(lags.size(), lags.data());
+    }
+
+/*! \returns The correlation averaged over the members and the time origins of each lag in
+    getLags()
+*/
+pybind11::object ParticleCorrelatorAnalyzer::getCorrelation()
+    {
+    ArrayHandle<double> h_sums(m_sums, access_location::host, access_mode::read);
+    std::vector<uint64_t> lags;
+    std::vector<double> values;
+    m_levels.getCorrelation(h_sums.data, lags, values);
+    return pybind11::array_t<double>(values.size(), values.data());
+    }
+
+namespace detail
+    {
+void export_ParticleCorrelatorAnalyzer(pybind11::module& m)
+    {
+    pybind11::class_<ParticleCorrelatorAnalyzer,
+                     Analyzer,
+                     std::shared_ptr<ParticleCorrelatorAnalyzer>>(m, "ParticleCorrelatorAnalyzer")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            std::shared_ptr<ParticleGroup>,
+                            const std::string&,
+                            unsigned int,
+                            unsigned int,
+                            unsigned int>())
+        .def("getLags", &ParticleCorrelatorAnalyzer::getLags)
+        .def("getCorrelation", &ParticleCorrelatorAnalyzer::getCorrelation)
+        .def("reset", &ParticleCorrelatorAnalyzer::reset)
+        .def_property_readonly("num_samples", &ParticleCorrelatorAnalyzer::getNumSamples)
+        .def_property_readonly("num_levels", &ParticleCorrelatorAnalyzer::getNumLevels);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,116 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "MultiTauCorrelator.h"
+#include "hoomd/Analyzer.h"
+#include "hoomd/GPUArray.h"
+#include "hoomd/ParticleGroup.h"
+
+/*! \file ParticleCorrelatorAnalyzer.h
+    \brief Declares a class that accumulates per-particle time correlation functions
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#ifndef __PARTICLE_CORRELATOR_ANALYZER_H__
+#define __PARTICLE_CORRELATOR_ANALYZER_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Accumulates the mean square displacement or the velocity autocorrelation with multi-tau buffers
+/*! ParticleCorrelatorAnalyzer samples a vector of each member of the group on every call to
+    analyze() and correlates it with the past samples of the same particle in a multi-tau scheme
+    (see MultiTauLevels). The quantity is either
+
+    - \c msd: the unwrapped position \f$ \vec{r} \f$ and the correlation
+      \f$ \langle |\vec{r}(t + \tau) - \vec{r}(t)|^2 \rangle \f$. The higher levels store the newest
+      of the values that entered the level below, so that the lags are exact displacements.
+    - \c vacf: the velocity \f$ \vec{v} \f$ and the correlation
+      \f$ \langle \vec{v}(t) \cdot \vec{v}(t + \tau) \rangle \f$. The higher levels store the
+      average of the values that entered the level below.
+
+    The averages run over the group members and the time origins. The ring buffers are indexed by
+    particle tag so that they follow the particles through sorting. They occupy
+    points * levels * N values, where levels grows with the logarithm of the longest lag. The
+    correlation sums of the lags reduce over the group members on every call.
+
+    The sample period is the period of the trigger, so the trigger must select equally spaced
+    steps. Particles cannot migrate between ranks with their ring buffers, so the analyzer does not
+    support domain decomposition. The number of particles must remain constant.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT ParticleCorrelatorAnalyzer : public Analyzer
+    {
+    public:
+    //! Sampled quantities
+    enum quantity
+        {
+        msd,
+        vacf
+        };
+
+    //! Constructs the analyzer
+    ParticleCorrelatorAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                               std::shared_ptr<Trigger> trigger,
+                               std::shared_ptr<ParticleGroup> group,
+                               const std::string& quantity,
+                               unsigned int points,
+                               unsigned int averaging,
+                               unsigned int max_levels);
+
+    //! Destructor
+    virtual ~ParticleCorrelatorAnalyzer();
+
+    //! Add a sample of the current configuration
+    virtual void analyze(uint64_t timestep);
+
+    //! Get the lags that have samples in units of the sample period
+    pybind11::object getLags();
+
+    //! Get the correlation of each lag
+    pybind11::object getCorrelation();
+
+    //! Clear the buffers and the sums
+    void reset();
+
+    //! Get the number of accumulated samples
+    uint64_t getNumSamples()
+        {
+        return m_levels.getNumSamples();
+        }
+
+    //! Get the number of started levels
+    unsigned int getNumLevels()
+        {
+        return m_levels.getNumLevels();
+        }
+
+    protected:
+    std::shared_ptr<ParticleGroup> m_group; //!< Particles to sample
+    quantity m_quantity;                    //!< The sampled quantity
+    MultiTauLevels m_levels;                //!< Level bookkeeping
+    unsigned int m_n_tags;                  //!< Number of particle tags
+    unsigned int m_n_levels_allocated;      //!< Number of levels with allocated buffers
+    GPUArray<Scalar3> m_values;             //!< Ring buffers, ((level * points + k) * n_tags + tag)
+    GPUArray<Scalar3> m_accum;              //!< Sum of the values entering each level
+    GPUArray<double> m_sums;                //!< Correlation sums of each lag, summed over members
+
+    //! Store the samples of the group members and add their correlations to m_sums
+    virtual void sampleParticles(unsigned int n_levels);
+
+    //! Grow the buffers to the given number of levels
+    void allocateLevels(unsigned int n_levels);
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
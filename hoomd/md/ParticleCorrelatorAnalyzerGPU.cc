@@ -0,0 +1,121 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "ParticleCorrelatorAnalyzerGPU.h"
+#include "ParticleCorrelatorAnalyzerGPU.cuh"
+
+/*! \file ParticleCorrelatorAnalyzerGPU.cc
+    \brief Contains code for the ParticleCorrelatorAnalyzerGPU class
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+static_assert(kernel::MULTI_TAU_MAX_LEVELS == MultiTauLevels::MAX_LEVELS,
+              "The GPU kernel supports a different number of levels");
+
+/*! \param sysdef System definition
+    \param trigger Steps on which to sample, must be equally spaced
+    \param group Particles to sample
+    \param quantity "msd" or "vacf"
+    \param points Number of values per level
+    \param averaging Number of values that produce one value of the next level
+    \param max_levels Maximum number of levels
+*/
+ParticleCorrelatorAnalyzerGPU::ParticleCorrelatorAnalyzerGPU(
+    std::shared_ptr<SystemDefinition> sysdef,
+    std::shared_ptr<Trigger> trigger,
+    std::shared_ptr<ParticleGroup> group,
+    const std::string& quantity,
+    unsigned int points,
+    unsigned int averaging,
+    unsigned int max_levels)
+    : ParticleCorrelatorAnalyzer(sysdef, trigger, group, quantity, points, averaging, max_levels)
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        throw std::runtime_error(
+            "Error initializing ParticleCorrelatorAnalyzerGPU: no GPU available.");
+        }
+
+    // the sample kernel sums the correlations of the lags in shared memory
+    if (m_levels.getNumSums() * sizeof(double) > m_exec_conf->dev_prop.sharedMemPerBlock)
+        {
+        throw std::runtime_error("points * max_levels is too large for the GPU shared memory.");
+        }
+
+    m_tuner.reset(new Autotuner<1>({AutotunerBase::makeBlockSizeRange(m_exec_conf)},
+                                   m_exec_conf,
+                                   "particle_correlator"));
+    m_autotuners.push_back(m_tuner);
+    }
+
+/*! \param n_levels Number of levels that receive a value from this sample
+ */
+void ParticleCorrelatorAnalyzerGPU::sampleParticles(unsigned int n_levels)
+    {
+    kernel::multi_tau_update update;
+    update.n_levels = n_levels;
+    update.points = m_levels.getPoints();
+    update.averaging = m_levels.getAveraging();
+    for (unsigned int level = 0; level < n_levels; level++)
+        {
+        update.position[level] = m_levels.getPosition(level);
+        update.n_filled[level] = m_levels.getNumFilled(level);
+        }
+
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<int3> d_image(m_pdata->getImages(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                               access_location::device,
+                               access_mode::read);
+    ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(),
+                                            access_location::device,
+                                            access_mode::read);
+    ArrayHandle<Scalar3> d_values(m_values, access_location::device, access_mode::readwrite);
+    ArrayHandle<Scalar3> d_accum(m_accum, access_location::device, access_mode::readwrite);
+    ArrayHandle<double> d_sums(m_sums, access_location::device, access_mode::readwrite);
+
+    m_tuner->begin();
+    kernel::gpu_particle_correlator_sample(d_sums.data,
+                                           d_values.data,
+                                           d_accum.data,
+                                           d_pos.data,
+                                           d_image.data,
+                                           d_vel.data,
+                                           d_tag.data,
+                                           d_index_array.data,
+                                           m_group->getNumMembers(),
+                                           m_n_tags,
+                                           m_pdata->getGlobalBox(),
+                                           update,
+                                           m_quantity == msd,
+                                           m_tuner->getParam()[0]);
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner->end();
+    }
+
+namespace detail
+    {
+void export_ParticleCorrelatorAnalyzerGPU(pybind11::module& m)
+    {
+    pybind11::class_<ParticleCorrelatorAnalyzerGPU,
+                     ParticleCorrelatorAnalyzer,
+                     std::shared_ptr<ParticleCorrelatorAnalyzerGPU>>(
+        m,
+        "ParticleCorrelatorAnalyzerGPU")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            std::shared_ptr<ParticleGroup>,
+                            const std::string&,
+                            unsigned int,
+                            unsigned int,
+                            unsigned int>());
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
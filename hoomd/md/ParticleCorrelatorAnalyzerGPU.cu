@@ -0,0 +1,205 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "ParticleCorrelatorAnalyzerGPU.cuh"
+
+/*! \file ParticleCorrelatorAnalyzerGPU.cu
+    \brief Defines GPU kernel code for the per-particle multi-tau correlators. Used by
+   ParticleCorrelatorAnalyzerGPU.
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Kernel that stores a sample of the group members and adds their correlations to the sums
+/*! \param d_sums Correlation sums of each lag, (level * points + j)
+    \param d_values Ring buffers, ((level * points + k) * n_tags + tag)
+    \param d_accum Sum of the values entering each level, (level * n_tags + tag)
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param d_vel Particle velocities
+    \param d_tag Particle tags
+    \param d_index_array Indices of the group members
+    \param group_size Number of group members
+    \param n_tags Number of particle tags
+    \param box Simulation box
+    \param update Levels that receive a value
+
+    \tparam msd Correlate the squared displacements of the unwrapped positions when true, the dot
+    products of the velocities when false.
+
+    One thread per group member passes the sample up through the levels. The threads of a block sum
+    the correlations of each lag in shared memory, and one atomic add per lag and block adds the
+    block sums to d_sums.
+*/
+template<bool msd>
+__global__ void gpu_particle_correlator_sample_kernel(double* d_sums,
+                                                      Scalar3* d_values,
+                                                      Scalar3* d_accum,
+                                                      const Scalar4* d_pos,
+                                                      const int3* d_image,
+                                                      const Scalar4* d_vel,
+                                                      const unsigned int* d_tag,
+                                                      const unsigned int* d_index_array,
+                                                      const unsigned int group_size,
+                                                      const unsigned int n_tags,
+                                                      const BoxDim box,
+                                                      const multi_tau_update update)
+    {
+    HIP_DYNAMIC_SHARED(double, s_sums)
+
+    const unsigned int points = update.points;
+    const unsigned int n_sums = update.n_levels * points;
+    for (unsigned int k = threadIdx.x; k < n_sums; k += blockDim.x)
+        {
+        s_sums[k] = 0.0;
+        }
+    __syncthreads();
+
+    const unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (group_idx < group_size)
+        {
+        const unsigned int idx = d_index_array[group_idx];
+        const size_t tag = d_tag[idx];
+
+        Scalar3 value;
+        if (msd)
+            {
+            const Scalar4 postype = d_pos[idx];
+            value = box.shift(make_scalar3(postype.x, postype.y, postype.z), d_image[idx]);
+            }
+        else
+            {
+            const Scalar4 vel = d_vel[idx];
+            value = make_scalar3(vel.x, vel.y, vel.z);
+            }
+
+        for (unsigned int level = 0; level < update.n_levels; level++)
+            {
+            if (!msd && level > 0)
+                {
+                value = d_accum[(level - 1) * n_tags + tag] / Scalar(update.averaging);
+                d_accum[(level - 1) * n_tags + tag] = make_scalar3(0, 0, 0);
+                }
+
+            const unsigned int position = update.position[level];
+            d_values[(level * points + position) * n_tags + tag] = value;
+            if (!msd)
+                {
+                d_accum[level * n_tags + tag] += value;
+                }
+
+            const unsigned int first_lag = level == 0 ? 0 : points / update.averaging;
+            for (unsigned int j = first_lag; j < update.n_filled[level]; j++)
+                {
+                const unsigned int old = (position + points - j) % points;
+                const Scalar3 value_old = d_values[(level * points + old) * n_tags + tag];
+                Scalar correlation;
+                if (msd)
+                    {
+                    const Scalar3 dr = value - value_old;
+                    correlation = dot(dr, dr);
+                    }
+                else
+                    {
+                    correlation = dot(value, value_old);
+                    }
+                atomicAdd(&s_sums[level * points + j], double(correlation));
+                }
+            }
+        }
+    __syncthreads();
+
+    for (unsigned int k = threadIdx.x; k < n_sums; k += blockDim.x)
+        {
+        if (s_sums[k] != 0.0)
+            {
+            atomicAdd(&d_sums[k], s_sums[k]);
+            }
+        }
+    }
+
+/*! \param d_sums Correlation sums of each lag
+    \param d_values Ring buffers
+    \param d_accum Sum of the values entering each level
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param d_vel Particle velocities
+    \param d_tag Particle tags
+    \param d_index_array Indices of the group members
+    \param group_size Number of group members
+    \param n_tags Number of particle tags
+    \param box Simulation box
+    \param update Levels that receive a value
+    \param msd Correlate the displacements when true, the velocities when false
+    \param block_size Number of threads per block
+*/
+hipError_t gpu_particle_correlator_sample(double* d_sums,
+                                          Scalar3* d_values,
+                                          Scalar3* d_accum,
+                                          const Scalar4* d_pos,
+                                          const int3* d_image,
+                                          const Scalar4* d_vel,
+                                          const unsigned int* d_tag,
+                                          const unsigned int* d_index_array,
+                                          const unsigned int group_size,
+                                          const unsigned int n_tags,
+                                          const BoxDim box,
+                                          const multi_tau_update update,
+                                          const bool msd,
+                                          const unsigned int block_size)
+    {
+    if (group_size == 0)
+        return hipSuccess;
+
+    const size_t shared_bytes = update.n_levels * update.points * sizeof(double);
+    if (msd)
+        {
+        hipLaunchKernelGGL((gpu_particle_correlator_sample_kernel<true>),
+                           dim3(group_size / block_size + 1),
+                           dim3(block_size),
+                           shared_bytes,
+                           0,
+                           d_sums,
+                           d_values,
+                           d_accum,
+                           d_pos,
+                           d_image,
+                           d_vel,
+                           d_tag,
+                           d_index_array,
+                           group_size,
+                           n_tags,
+                           box,
+                           update);
+        }
+    else
+        {
+        hipLaunchKernelGGL((gpu_particle_correlator_sample_kernel<false>),
+                           dim3(group_size / block_size + 1),
+                           dim3(block_size),
+                           shared_bytes,
+                           0,
+                           d_sums,
+                           d_values,
+                           d_accum,
+                           d_pos,
+                           d_image,
+                           d_vel,
+                           d_tag,
+                           d_index_array,
+                           group_size,
+                           n_tags,
+                           box,
+                           update);
+        }
+
+    return hipSuccess;
+    }
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,55 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "hip/hip_runtime.h"
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+
+/*! \file ParticleCorrelatorAnalyzerGPU.cuh
+    \brief Declares GPU kernel code for the per-particle multi-tau correlators. Used by
+   ParticleCorrelatorAnalyzerGPU.
+*/
+
+#ifndef __PARTICLE_CORRELATOR_ANALYZER_GPU_CUH__
+#define __PARTICLE_CORRELATOR_ANALYZER_GPU_CUH__
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Largest number of levels of a multi_tau_update, matches MultiTauLevels::MAX_LEVELS
+const unsigned int MULTI_TAU_MAX_LEVELS = 32;
+
+//! Levels of a multi-tau correlator that receive a value from a sample
+struct multi_tau_update
+    {
+    unsigned int n_levels;                       //!< Number of levels that receive a value
+    unsigned int points;                         //!< Number of values per level
+    unsigned int averaging;                      //!< Values per value of the next level
+    unsigned int position[MULTI_TAU_MAX_LEVELS]; //!< Position of the new value of each level
+    unsigned int n_filled[MULTI_TAU_MAX_LEVELS]; //!< Number of values in each level
+    };
+
+//! Store a sample of the group members and add their correlations to the sums
+hipError_t gpu_particle_correlator_sample(double* d_sums,
+                                          Scalar3* d_values,
+                                          Scalar3* d_accum,
+                                          const Scalar4* d_pos,
+                                          const int3* d_image,
+                                          const Scalar4* d_vel,
+                                          const unsigned int* d_tag,
+                                          const unsigned int* d_index_array,
+                                          const unsigned int group_size,
+                                          const unsigned int n_tags,
+                                          const BoxDim box,
+                                          const multi_tau_update update,
+                                          const bool msd,
+                                          const unsigned int block_size);
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
@@ -0,0 +1,51 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "ParticleCorrelatorAnalyzer.h"
+#include "hoomd/Autotuner.h"
+
+/*! \file ParticleCorrelatorAnalyzerGPU.h
+    \brief Declares a class that accumulates per-particle time correlation functions on the GPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __PARTICLE_CORRELATOR_ANALYZER_GPU_H__
+#define __PARTICLE_CORRELATOR_ANALYZER_GPU_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Accumulates per-particle time correlation functions on the GPU
+/*! The ring buffers and the correlation sums stay on the device, so a sample reads no particle
+    data on the host. The sums are copied to the host only when the correlation is requested.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT ParticleCorrelatorAnalyzerGPU : public ParticleCorrelatorAnalyzer
+    {
+    public:
+    //! Constructs the analyzer
+    ParticleCorrelatorAnalyzerGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                  std::shared_ptr<Trigger> trigger,
+                                  std::shared_ptr<ParticleGroup> group,
+                                  const std::string& quantity,
+                                  unsigned int points,
+                                  unsigned int averaging,
+                                  unsigned int max_levels);
+
+    protected:
+    std::shared_ptr<Autotuner<1>> m_tuner; //!< Autotuner for the sample kernel
+
+    //! Store the samples of the group members and add their correlations to m_sums
+    virtual void sampleParticles(unsigned int n_levels);
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+#endif
@@ -85,6 +85,9 @@ void PeriodicImproperForceCompute::computeForces(uint64_t timestep)
 
     size_t virial_pitch = m_virial.getPitch();
 
+    PDataFlags flags = m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor];
+
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getBox();
 
@@ -277,29 +280,33 @@ void PeriodicImproperForceCompute::computeForces(uint64_t timestep)
         h_force.data[idx_a].y += ffay;
         h_force.data[idx_a].z += ffaz;
         h_force.data[idx_a].w += improper_eng;
-        for (int k = 0; k < 6; k++)
-            h_virial.data[virial_pitch * k + idx_a] += improper_virial[k];
+        if (compute_virial)
+            for (int k = 0; k < 6; k++)
+                h_virial.data[virial_pitch * k + idx_a] += improper_virial[k];
 
         h_force.data[idx_b].x += ffbx;
         h_force.data[idx_b].y += ffby;
         h_force.data[idx_b].z += ffbz;
         h_force.data[idx_b].w += improper_eng;
-        for (int k = 0; k < 6; k++)
-            h_virial.data[virial_pitch * k + idx_b] += improper_virial[k];
+        if (compute_virial)
+            for (int k = 0; k < 6; k++)
+                h_virial.data[virial_pitch * k + idx_b] += improper_virial[k];
 
         h_force.data[idx_c].x += ffcx;
         h_force.data[idx_c].y += ffcy;
         h_force.data[idx_c].z += ffcz;
         h_force.data[idx_c].w += improper_eng;
-        for (int k = 0; k < 6; k++)
-            h_virial.data[virial_pitch * k + idx_c] += improper_virial[k];
+        if (compute_virial)
+            for (int k = 0; k < 6; k++)
+                h_virial.data[virial_pitch * k + idx_c] += improper_virial[k];
 
         h_force.data[idx_d].x += ffdx;
         h_force.data[idx_d].y += ffdy;
         h_force.data[idx_d].z += ffdz;
         h_force.data[idx_d].w += improper_eng;
-        for (int k = 0; k < 6; k++)
-            h_virial.data[virial_pitch * k + idx_d] += improper_virial[k];
+        if (compute_virial)
+            for (int k = 0; k < 6; k++)
+                h_virial.data[virial_pitch * k + idx_d] += improper_virial[k];
         }
     }
 
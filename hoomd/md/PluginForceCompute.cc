@@ -0,0 +1,234 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "PluginForceCompute.h"
+
+#ifdef ENABLE_HIP
+#include <hip/hip_runtime.h>
+#endif
+
+#include <string.h>
+
+namespace py = pybind11;
+
+using namespace std;
+
+/*! \file PluginForceCompute.cc
+    \brief Contains code for the PluginForceCompute class
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef SystemDefinition containing the ParticleData to compute forces on
+    \param plugin Plugin that computes the forces
+    \param nlist Neighbor list to pass to the plugin, may be null when the plugin's cutoff is 0
+*/
+PluginForceCompute::PluginForceCompute(std::shared_ptr<SystemDefinition> sysdef,
+                                       std::shared_ptr<ForcePlugin> plugin,
+                                       std::shared_ptr<NeighborList> nlist)
+    : ForceCompute(sysdef), m_plugin(plugin), m_nlist(nlist), m_r_cut(-1)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing PluginForceCompute" << endl;
+
+    if (!m_plugin)
+        {
+        throw runtime_error("PluginForceCompute requires a plugin.");
+        }
+
+    if (m_plugin->getRCut() > Scalar(0.0) && !m_nlist)
+        {
+        throw runtime_error("The plugin " + m_plugin->getName() + " requires a neighbor list.");
+        }
+
+    if (m_nlist)
+        {
+        if (m_plugin->needsFullNeighborList())
+            {
+            m_nlist->setStorageMode(NeighborList::full);
+            }
+
+        unsigned int n_types = m_pdata->getNTypes();
+        m_r_cut_nlist = std::make_shared<GlobalArray<Scalar>>(n_types * n_types, m_exec_conf);
+        updateRCut();
+        m_nlist->addRCutMatrix(m_r_cut_nlist);
+        }
+    }
+
+PluginForceCompute::~PluginForceCompute()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying PluginForceCompute" << endl;
+
+    if (m_attached && m_nlist)
+        {
+        m_nlist->removeRCutMatrix(m_r_cut_nlist);
+        }
+    }
+
+/*! Notifies the neighbor list when the plugin's cutoff changes.
+ */
+void PluginForceCompute::updateRCut()
+    {
+    Scalar r_cut = m_plugin->getRCut();
+    if (r_cut != m_r_cut)
+        {
+            {
+            ArrayHandle<Scalar> h_r_cut_nlist(*m_r_cut_nlist,
+                                              access_location::host,
+                                              access_mode::overwrite);
+            for (unsigned int i = 0; i < m_r_cut_nlist->getNumElements(); i++)
+                {
+                h_r_cut_nlist.data[i] = r_cut;
+                }
+            }
+        m_r_cut = r_cut;
+        m_nlist->notifyRCutMatrixChange();
+        }
+    }
+
+/*! \param timestep Current timestep
+
+    Zero the force arrays and call the plugin with host or device pointers.
+*/
+void PluginForceCompute::computeForces(uint64_t timestep)
+    {
+#ifdef ENABLE_HIP
+    const bool on_device = m_exec_conf->isCUDAEnabled() && m_plugin->supportsDevice();
+    const access_location::Enum location = on_device ? access_location::device
+                                                     : access_location::host;
+#else
+    const bool on_device = false;
+    const access_location::Enum location = access_location::host;
+#endif
+    const bool compute_virial = m_pdata->getFlags()[pdata_flag::pressure_tensor];
+    const bool aniso = m_plugin->isAnisotropic();
+
+    const bool use_nlist = m_nlist && m_plugin->getRCut() > Scalar(0.0);
+    if (use_nlist)
+        {
+        updateRCut();
+        m_nlist->compute(timestep);
+        }
+
+    ArrayHandle<Scalar4> force(m_force, location, access_mode::overwrite);
+    ArrayHandle<Scalar4> torque(m_torque, location, access_mode::overwrite);
+    ArrayHandle<Scalar> virial(m_virial, location, access_mode::overwrite);
+
+#ifdef ENABLE_HIP
+    if (on_device)
+        {
+        hipMemset(force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
+        if (aniso)
+            hipMemset(torque.data, 0, sizeof(Scalar4) * m_torque.getNumElements());
+        if (compute_virial)
+            hipMemset(virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+        }
+    else
+#endif
+        {
+        memset(force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
+        if (aniso)
+            memset(torque.data, 0, sizeof(Scalar4) * m_torque.getNumElements());
+        if (compute_virial)
+            memset(virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+        }
+
+    ArrayHandle<Scalar4> pos(m_pdata->getPositions(), location, access_mode::read);
+    ArrayHandle<unsigned int> tag(m_pdata->getTags(), location, access_mode::read);
+    ArrayHandle<Scalar> charge(m_pdata->getCharges(), location, access_mode::read);
+
+    ForcePluginArgs args;
+    args.timestep = timestep;
+    args.on_device = on_device;
+    args.N = m_pdata->getN();
+    args.n_ghost = m_pdata->getNGhosts();
+    args.box = m_pdata->getBox();
+    args.pos = pos.data;
+    args.tag = tag.data;
+    args.charge = charge.data;
+    args.n_neigh = nullptr;
+    args.nlist = nullptr;
+    args.head_list = nullptr;
+    args.full_nlist = false;
+    args.force = force.data;
+    args.torque = aniso ? torque.data : nullptr;
+    args.virial = compute_virial ? virial.data : nullptr;
+    args.virial_pitch = m_virial.getPitch();
+
+    if (!use_nlist)
+        {
+        callPlugin(args);
+        return;
+        }
+
+    ArrayHandle<unsigned int> n_neigh(m_nlist->getNNeighArray(), location, access_mode::read);
+    ArrayHandle<unsigned int> nlist(m_nlist->getNListArray(), location, access_mode::read);
+    ArrayHandle<size_t> head_list(m_nlist->getHeadList(), location, access_mode::read);
+
+    args.n_neigh = n_neigh.data;
+    args.nlist = nlist.data;
+    args.head_list = head_list.data;
+    args.full_nlist = m_nlist->getStorageMode() == NeighborList::full;
+
+    callPlugin(args);
+    }
+
+/*! \param args Arguments to pass to the plugin
+
+    Release the global interpreter lock, when the calling thread holds it, so that Python threads
+    may run while the plugin computes.
+*/
+void PluginForceCompute::callPlugin(const ForcePluginArgs& args)
+    {
+    if (PyGILState_Check())
+        {
+        py::gil_scoped_release release;
+        m_plugin->compute(args);
+        }
+    else
+        {
+        m_plugin->compute(args);
+        }
+    }
+
+#ifdef ENABLE_MPI
+/*! \param timestep Current time step
+ */
+CommFlags PluginForceCompute::getRequestedCommFlags(uint64_t timestep)
+    {
+    CommFlags flags = CommFlags(0);
+
+    // the plugin receives the tags and charges of the ghost particles
+    flags[comm_flag::tag] = 1;
+    flags[comm_flag::charge] = 1;
+
+    flags |= ForceCompute::getRequestedCommFlags(timestep);
+
+    return flags;
+    }
+#endif
+
+namespace detail
+    {
+void export_PluginForceCompute(py::module& m)
+    {
+    py::class_<ForcePlugin, std::shared_ptr<ForcePlugin>>(m, "ForcePlugin")
+        .def("getRCut", &ForcePlugin::getRCut)
+        .def("needsFullNeighborList", &ForcePlugin::needsFullNeighborList)
+        .def("supportsDevice", &ForcePlugin::supportsDevice)
+        .def("isAnisotropic", &ForcePlugin::isAnisotropic)
+        .def("getName", &ForcePlugin::getName);
+
+    py::class_<PluginForceCompute, ForceCompute, std::shared_ptr<PluginForceCompute>>(
+        m,
+        "PluginForceCompute")
+        .def(py::init<std::shared_ptr<SystemDefinition>,
+                      std::shared_ptr<ForcePlugin>,
+                      std::shared_ptr<NeighborList>>())
+        .def("getPlugin", &PluginForceCompute::getPlugin);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,93 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "ForcePlugin.h"
+#include "NeighborList.h"
+#include "hoomd/ForceCompute.h"
+
+#include <memory>
+
+/*! \file PluginForceCompute.h
+    \brief Declares the backend for computing forces with ForcePlugin objects
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __PLUGINFORCECOMPUTE_H__
+#define __PLUGINFORCECOMPUTE_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+/// Computes forces with a ForcePlugin
+/*! PluginForceCompute zeroes the force arrays, updates the neighbor list (when the plugin has a
+    nonzero cutoff), and passes the raw particle and neighbor list arrays to the plugin. The arrays
+    are in device memory when the execution configuration has a GPU and the plugin supports it.
+
+    The plugin runs with the Python global interpreter lock released, so it must not call into
+    Python.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT PluginForceCompute : public ForceCompute
+    {
+    public:
+    /// Constructs the compute
+    PluginForceCompute(std::shared_ptr<SystemDefinition> sysdef,
+                       std::shared_ptr<ForcePlugin> plugin,
+                       std::shared_ptr<NeighborList> nlist);
+
+    /// Destructor
+    virtual ~PluginForceCompute();
+
+    /// Get the plugin
+    std::shared_ptr<ForcePlugin> getPlugin()
+        {
+        return m_plugin;
+        }
+
+    bool isAnisotropic()
+        {
+        return m_plugin->isAnisotropic();
+        }
+
+    virtual void notifyDetach()
+        {
+        if (m_attached && m_nlist)
+            {
+            m_nlist->removeRCutMatrix(m_r_cut_nlist);
+            }
+        m_attached = false;
+        }
+
+#ifdef ENABLE_MPI
+    /// Get ghost particle fields requested by this force
+    virtual CommFlags getRequestedCommFlags(uint64_t timestep);
+#endif
+
+    protected:
+    /// Actually compute the forces
+    virtual void computeForces(uint64_t timestep);
+
+    /// Set the neighbor list cutoff of all type pairs to the plugin's cutoff
+    void updateRCut();
+
+    /// Call the plugin without the global interpreter lock
+    void callPlugin(const ForcePluginArgs& args);
+
+    std::shared_ptr<ForcePlugin> m_plugin;              //!< The plugin that computes the forces
+    std::shared_ptr<NeighborList> m_nlist;              //!< Neighbor list, may be null
+    std::shared_ptr<GlobalArray<Scalar>> m_r_cut_nlist; //!< Cutoff matrix of the neighbor list
+    Scalar m_r_cut;                                     //!< Cutoff in m_r_cut_nlist
+    bool m_attached = true;                             //!< True while the cutoff is registered
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
@@ -1,6 +1,7 @@
 // Copyright (c) 2009-2024 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+#include "BondedForceThreads.h"
 #include "hoomd/ForceCompute.h"
 #include "hoomd/GPUArray.h"
 #include "hoomd/MeshDefinition.h"
@@ -82,6 +83,9 @@ PotentialBond<evaluator, Bonds>::PotentialBond(std::shared_ptr<SystemDefinition>
     // allocate the parameters
     GPUArray<param_type> params(m_bond_data->getNTypes(), m_exec_conf);
     m_params.swap(params);
+
+    // bond forces write the per-particle virial only when the pressure tensor is requested
+    setDeferVirialAllocation(true);
     }
 
 template<class evaluator, class Bonds>
@@ -99,6 +103,9 @@ PotentialBond<evaluator, Bonds>::PotentialBond(std::shared_ptr<SystemDefinition>
     // allocate the parameters
     GPUArray<param_type> params(m_bond_data->getNTypes(), m_exec_conf);
     m_params.swap(params);
+
+    // bond forces write the per-particle virial only when the pressure tensor is requested
+    setDeferVirialAllocation(true);
     }
 
 template<class evaluator, class Bonds> PotentialBond<evaluator, Bonds>::~PotentialBond()
@@ -170,7 +177,10 @@ void PotentialBond<evaluator, Bonds>::computeForces(uint64_t timestep)
 
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    // local indices of the bond members, refreshed only when the particles or groups are reordered
+    ArrayHandle<typename Bonds::members_t> h_bond_idx(m_bond_data->getMemberIndexTable(),
+                                                      access_location::host,
+                                                      access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::readwrite);
@@ -181,13 +191,13 @@ void PotentialBond<evaluator, Bonds>::computeForces(uint64_t timestep)
 
     // there are enough other checks on the input data: but it doesn't hurt to be safe
     assert(h_force.data);
-    assert(h_virial.data);
     assert(h_pos.data);
     assert(h_charge.data);
 
-    // Zero data for force calculation
+    // Zero data for force calculation, the virial is not allocated until the pressure is needed
     memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
-    memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+    if (h_virial.data)
+        memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
 
     // we are using the minimum image of the global box here
     // to ensure that ghosts are always correctly wrapped (even if a bond exceeds half the domain
@@ -197,10 +207,6 @@ void PotentialBond<evaluator, Bonds>::computeForces(uint64_t timestep)
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor];
 
-    Scalar bond_virial[6];
-    for (unsigned int i = 0; i < 6; i++)
-        bond_virial[i] = Scalar(0.0);
-
     ArrayHandle<typename Bonds::members_t> h_bonds(m_bond_data->getMembersArray(),
                                                    access_location::host,
                                                    access_mode::read);
@@ -213,105 +219,125 @@ void PotentialBond<evaluator, Bonds>::computeForces(uint64_t timestep)
     // for each of the bonds
     const unsigned int size = (unsigned int)m_bond_data->getN();
 
-    for (unsigned int i = 0; i < size; i++)
-        {
-        // lookup the tag of each of the particles participating in the bond
-        const typename Bonds::members_t& bond = h_bonds.data[i];
-        assert(bond.tag[0] < m_pdata->getMaximumTag() + 1);
-        assert(bond.tag[1] < m_pdata->getMaximumTag() + 1);
-
-        // transform a and b into indices into the particle data arrays
-        // (MEM TRANSFER: 4 integers)
-        unsigned int idx_a = h_rtag.data[bond.tag[0]];
-        unsigned int idx_b = h_rtag.data[bond.tag[1]];
-
-        // throw an error if this bond is incomplete
-        if (idx_a >= max_local || idx_b >= max_local)
+    auto compute_range = [&](unsigned int first,
+                             unsigned int last,
+                             Scalar4* force,
+                             Scalar* virial,
+                             size_t virial_pitch)
+    {
+        for (unsigned int i = first; i < last; i++)
             {
-            std::ostringstream stream;
-            stream << "Error: bond " << bond.tag[0] << " " << bond.tag[1] << " is incomplete.";
-            throw std::runtime_error(stream.str());
-            }
-
-        // calculate d\vec{r}
-        // (MEM TRANSFER: 6 Scalars / FLOPS: 3)
-        Scalar3 posa = make_scalar3(h_pos.data[idx_a].x, h_pos.data[idx_a].y, h_pos.data[idx_a].z);
-        Scalar3 posb = make_scalar3(h_pos.data[idx_b].x, h_pos.data[idx_b].y, h_pos.data[idx_b].z);
+            // lookup the tag of each of the particles participating in the bond
+            const typename Bonds::members_t& bond = h_bonds.data[i];
+            assert(bond.tag[0] < m_pdata->getMaximumTag() + 1);
+            assert(bond.tag[1] < m_pdata->getMaximumTag() + 1);
+
+            // transform a and b into indices into the particle data arrays
+            // (MEM TRANSFER: 4 integers)
+            unsigned int idx_a = h_bond_idx.data[i].idx[0];
+            unsigned int idx_b = h_bond_idx.data[i].idx[1];
+
+            // throw an error if this bond is incomplete
+            if (idx_a >= max_local || idx_b >= max_local)
+                {
+                std::ostringstream stream;
+                stream << "Error: bond " << bond.tag[0] << " " << bond.tag[1]
+                       << " is incomplete.";
+                throw std::runtime_error(stream.str());
+                }
 
-        Scalar3 dx = posb - posa;
+            // calculate d\vec{r}
+            // (MEM TRANSFER: 6 Scalars / FLOPS: 3)
+            Scalar3 posa
+                = make_scalar3(h_pos.data[idx_a].x, h_pos.data[idx_a].y, h_pos.data[idx_a].z);
+            Scalar3 posb
+                = make_scalar3(h_pos.data[idx_b].x, h_pos.data[idx_b].y, h_pos.data[idx_b].z);
 
-        // access charge (if needed)
-        Scalar charge_a = Scalar(0.0);
-        Scalar charge_b = Scalar(0.0);
-        if (evaluator::needsCharge())
-            {
-            charge_a = h_charge.data[idx_a];
-            charge_b = h_charge.data[idx_b];
-            }
+            Scalar3 dx = posb - posa;
 
-        // if the vector crosses the box, pull it back
-        dx = box.minImage(dx);
+            // access charge (if needed)
+            Scalar charge_a = Scalar(0.0);
+            Scalar charge_b = Scalar(0.0);
+            if (evaluator::needsCharge())
+                {
+                charge_a = h_charge.data[idx_a];
+                charge_b = h_charge.data[idx_b];
+                }
 
-        // calculate r_ab squared
-        Scalar rsq = dot(dx, dx);
+            // if the vector crosses the box, pull it back
+            dx = box.minImage(dx);
 
-        // compute the force and potential energy
-        Scalar force_divr = Scalar(0.0);
-        Scalar bond_eng = Scalar(0.0);
-        evaluator eval(rsq, h_params.data[h_typeval.data[i].type]);
-        if (evaluator::needsCharge())
-            eval.setCharge(charge_a, charge_b);
+            // calculate r_ab squared
+            Scalar rsq = dot(dx, dx);
 
-        bool evaluated = eval.evalForceAndEnergy(force_divr, bond_eng);
+            // compute the force and potential energy
+            Scalar force_divr = Scalar(0.0);
+            Scalar bond_eng = Scalar(0.0);
+            evaluator eval(rsq, h_params.data[h_typeval.data[i].type]);
+            if (evaluator::needsCharge())
+                eval.setCharge(charge_a, charge_b);
 
-        // Bond energy must be halved
-        bond_eng *= Scalar(0.5);
+            bool evaluated = eval.evalForceAndEnergy(force_divr, bond_eng);
 
-        if (evaluated)
-            {
-            // calculate virial
-            if (compute_virial)
-                {
-                Scalar force_div2r = Scalar(1.0 / 2.0) * force_divr;
-                bond_virial[0] = dx.x * dx.x * force_div2r; // xx
-                bond_virial[1] = dx.x * dx.y * force_div2r; // xy
-                bond_virial[2] = dx.x * dx.z * force_div2r; // xz
-                bond_virial[3] = dx.y * dx.y * force_div2r; // yy
-                bond_virial[4] = dx.y * dx.z * force_div2r; // yz
-                bond_virial[5] = dx.z * dx.z * force_div2r; // zz
-                }
+            // Bond energy must be halved
+            bond_eng *= Scalar(0.5);
 
-            // add the force to the particles (only for non-ghost particles)
-            if (idx_b < m_pdata->getN())
+            if (evaluated)
                 {
-                h_force.data[idx_b].x += force_divr * dx.x;
-                h_force.data[idx_b].y += force_divr * dx.y;
-                h_force.data[idx_b].z += force_divr * dx.z;
-                h_force.data[idx_b].w += bond_eng;
+                // calculate virial
+                Scalar bond_virial[6];
                 if (compute_virial)
-                    for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i * m_virial_pitch + idx_b] += bond_virial[i];
+                    {
+                    Scalar force_div2r = Scalar(1.0 / 2.0) * force_divr;
+                    bond_virial[0] = dx.x * dx.x * force_div2r; // xx
+                    bond_virial[1] = dx.x * dx.y * force_div2r; // xy
+                    bond_virial[2] = dx.x * dx.z * force_div2r; // xz
+                    bond_virial[3] = dx.y * dx.y * force_div2r; // yy
+                    bond_virial[4] = dx.y * dx.z * force_div2r; // yz
+                    bond_virial[5] = dx.z * dx.z * force_div2r; // zz
+                    }
+
+                // add the force to the particles (only for non-ghost particles)
+                if (idx_b < m_pdata->getN())
+                    {
+                    force[idx_b].x += force_divr * dx.x;
+                    force[idx_b].y += force_divr * dx.y;
+                    force[idx_b].z += force_divr * dx.z;
+                    force[idx_b].w += bond_eng;
+                    if (compute_virial)
+                        for (unsigned int i = 0; i < 6; i++)
+                            virial[i * virial_pitch + idx_b] += bond_virial[i];
+                    }
+
+                if (idx_a < m_pdata->getN())
+                    {
+                    force[idx_a].x -= force_divr * dx.x;
+                    force[idx_a].y -= force_divr * dx.y;
+                    force[idx_a].z -= force_divr * dx.z;
+                    force[idx_a].w += bond_eng;
+                    if (compute_virial)
+                        for (unsigned int i = 0; i < 6; i++)
+                            virial[i * virial_pitch + idx_a] += bond_virial[i];
+                    }
                 }
-
-            if (idx_a < m_pdata->getN())
+            else
                 {
-                h_force.data[idx_a].x -= force_divr * dx.x;
-                h_force.data[idx_a].y -= force_divr * dx.y;
-                h_force.data[idx_a].z -= force_divr * dx.z;
-                h_force.data[idx_a].w += bond_eng;
-                if (compute_virial)
-                    for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i * m_virial_pitch + idx_a] += bond_virial[i];
+                this->m_exec_conf->msg->error()
+                    << "bond." << evaluator::getName() << ": bond out of bounds" << std::endl
+                    << std::endl;
+                throw std::runtime_error("Error in bond calculation");
                 }
             }
-        else
-            {
-            this->m_exec_conf->msg->error()
-                << "bond." << evaluator::getName() << ": bond out of bounds" << std::endl
-                << std::endl;
-            throw std::runtime_error("Error in bond calculation");
-            }
-        }
+    };
+
+    detail::computeBondedForces(m_exec_conf,
+                                size,
+                                m_pdata->getN(),
+                                compute_virial,
+                                h_force.data,
+                                h_virial.data,
+                                m_virial_pitch,
+                                compute_range);
     }
 
 #ifdef ENABLE_MPI
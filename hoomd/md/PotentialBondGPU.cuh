@@ -31,6 +31,7 @@ template<int group_size> struct bond_args_t
     bond_args_t(Scalar4* _d_force,
                 Scalar* _d_virial,
                 const size_t _virial_pitch,
+                const bool _compute_virial,
                 const unsigned int _N,
                 const unsigned int _n_max,
                 const Scalar4* _d_pos,
@@ -42,16 +43,19 @@ template<int group_size> struct bond_args_t
                 const unsigned int* _d_gpu_n_bonds,
                 const unsigned int _n_bond_types,
                 const unsigned int _block_size,
-                const hipDeviceProp_t& _devprop)
-        : d_force(_d_force), d_virial(_d_virial), virial_pitch(_virial_pitch), N(_N), n_max(_n_max),
-          d_pos(_d_pos), d_charge(_d_charge), box(_box), d_gpu_bondlist(_d_gpu_bondlist),
+                const hipDeviceProp_t& _devprop,
+                hipStream_t _stream = 0)
+        : d_force(_d_force), d_virial(_d_virial), virial_pitch(_virial_pitch),
+          compute_virial(_compute_virial), N(_N), n_max(_n_max), d_pos(_d_pos),
+          d_charge(_d_charge), box(_box), d_gpu_bondlist(_d_gpu_bondlist),
           gpu_table_indexer(_gpu_table_indexer), d_gpu_bond_pos(_d_gpu_bond_pos),
           d_gpu_n_bonds(_d_gpu_n_bonds), n_bond_types(_n_bond_types), block_size(_block_size),
-          devprop(_devprop) {};
+          devprop(_devprop), stream(_stream) {};
 
     Scalar4* d_force;          //!< Force to write out
     Scalar* d_virial;          //!< Virial to write out
     const size_t virial_pitch; //!< pitch of 2D array of virial matrix elements
+    const bool compute_virial; //!< True when the virial is computed
     unsigned int N;            //!< number of particles
     unsigned int n_max;        //!< Size of local pdata arrays
     const Scalar4* d_pos;      //!< particle positions
@@ -65,6 +69,7 @@ template<int group_size> struct bond_args_t
     const unsigned int n_bond_types;   //!< Number of bond types in the simulation
     const unsigned int block_size;     //!< Block size to execute
     const hipDeviceProp_t& devprop;    //!< CUDA device properties
+    hipStream_t stream;                //!< Stream to launch the kernel on
     };
 
 #ifdef __HIPCC__
@@ -92,9 +97,10 @@ template<int group_size> struct bond_args_t
 
     Certain options are controlled via template parameters to avoid the performance hit when they
    are not enabled. \tparam evaluator EvaluatorBond class to evaluate V(r) and -delta V(r)/r
+    \tparam compute_virial When false, the kernel neither computes nor writes the virial
 
 */
-template<class evaluator, int group_size, bool enable_shared_cache>
+template<class evaluator, int group_size, bool enable_shared_cache, bool compute_virial>
 __global__ void gpu_compute_bond_forces_kernel(Scalar4* d_force,
                                                Scalar* d_virial,
                                                const size_t virial_pitch,
@@ -208,14 +214,17 @@ __global__ void gpu_compute_bond_forces_kernel(Scalar4* d_force,
 
         if (evaluated)
             {
-            // add up the virial (double counting, multiply by 0.5)
-            Scalar force_div2r = force_divr / Scalar(2.0);
-            virial[0] += dx.x * dx.x * force_div2r; // xx
-            virial[1] += dx.x * dx.y * force_div2r; // xy
-            virial[2] += dx.x * dx.z * force_div2r; // xz
-            virial[3] += dx.y * dx.y * force_div2r; // yy
-            virial[4] += dx.y * dx.z * force_div2r; // yz
-            virial[5] += dx.z * dx.z * force_div2r; // zz
+            if (compute_virial)
+                {
+                // add up the virial (double counting, multiply by 0.5)
+                Scalar force_div2r = force_divr / Scalar(2.0);
+                virial[0] += dx.x * dx.x * force_div2r; // xx
+                virial[1] += dx.x * dx.y * force_div2r; // xy
+                virial[2] += dx.x * dx.z * force_div2r; // xz
+                virial[3] += dx.y * dx.y * force_div2r; // yy
+                virial[4] += dx.y * dx.z * force_div2r; // yz
+                virial[5] += dx.z * dx.z * force_div2r; // zz
+                }
 
             // add up the forces
             force.x += dx.x * force_divr;
@@ -234,8 +243,51 @@ __global__ void gpu_compute_bond_forces_kernel(Scalar4* d_force,
     // now that the force calculation is complete, write out the result (MEM TRANSFER: 20 bytes);
     d_force[idx] = force;
 
-    for (unsigned int i = 0; i < 6; i++)
-        d_virial[i * virial_pitch + idx] = virial[i];
+    if (compute_virial)
+        {
+        for (unsigned int i = 0; i < 6; i++)
+            d_virial[i * virial_pitch + idx] = virial[i];
+        }
+    }
+
+//! Launch gpu_compute_bond_forces_kernel
+/*! \param bond_args Other arguments to pass onto the kernel
+    \param d_params Parameters for the potential, stored per bond type
+    \param d_flags flags on the device
+    \param grid Grid to run the kernel
+    \param threads Threads per block
+    \param shared_bytes Bytes of dynamic shared memory, 0 without the shared cache
+*/
+template<class evaluator, int group_size, bool enable_shared_cache, bool compute_virial>
+void launch_bond_forces_kernel(const kernel::bond_args_t<group_size>& bond_args,
+                               const typename evaluator::param_type* d_params,
+                               unsigned int* d_flags,
+                               dim3 grid,
+                               dim3 threads,
+                               size_t shared_bytes)
+    {
+    hipLaunchKernelGGL((gpu_compute_bond_forces_kernel<evaluator,
+                                                       group_size,
+                                                       enable_shared_cache,
+                                                       compute_virial>),
+                       grid,
+                       threads,
+                       shared_bytes,
+                       bond_args.stream,
+                       bond_args.d_force,
+                       bond_args.d_virial,
+                       bond_args.virial_pitch,
+                       bond_args.N,
+                       bond_args.d_pos,
+                       bond_args.d_charge,
+                       bond_args.box,
+                       bond_args.d_gpu_bondlist,
+                       bond_args.gpu_table_indexer,
+                       bond_args.d_gpu_bond_pos,
+                       bond_args.d_gpu_n_bonds,
+                       bond_args.n_bond_types,
+                       d_params,
+                       d_flags);
     }
 
 //! Kernel driver that computes lj forces on the GPU for LJForceComputeGPU
@@ -262,7 +314,7 @@ gpu_compute_bond_forces(const kernel::bond_args_t<group_size>& bond_args,
     hipFuncAttributes attr;
     hipFuncGetAttributes(&attr,
                          reinterpret_cast<const void*>(
-                             &gpu_compute_bond_forces_kernel<evaluator, group_size, true>));
+                             &gpu_compute_bond_forces_kernel<evaluator, group_size, true, true>));
     max_block_size = attr.maxThreadsPerBlock;
 
     unsigned int run_block_size = min(bond_args.block_size, max_block_size);
@@ -284,47 +336,37 @@ gpu_compute_bond_forces(const kernel::bond_args_t<group_size>& bond_args,
     // run the kernel
     if (enable_shared_cache)
         {
-        hipLaunchKernelGGL((gpu_compute_bond_forces_kernel<evaluator, group_size, true>),
-                           grid,
-                           threads,
-                           shared_bytes,
-                           0,
-                           bond_args.d_force,
-                           bond_args.d_virial,
-                           bond_args.virial_pitch,
-                           bond_args.N,
-                           bond_args.d_pos,
-                           bond_args.d_charge,
-                           bond_args.box,
-                           bond_args.d_gpu_bondlist,
-                           bond_args.gpu_table_indexer,
-                           bond_args.d_gpu_bond_pos,
-                           bond_args.d_gpu_n_bonds,
-                           bond_args.n_bond_types,
-                           d_params,
-                           d_flags);
+        if (bond_args.compute_virial)
+            launch_bond_forces_kernel<evaluator, group_size, true, true>(bond_args,
+                                                                         d_params,
+                                                                         d_flags,
+                                                                         grid,
+                                                                         threads,
+                                                                         shared_bytes);
+        else
+            launch_bond_forces_kernel<evaluator, group_size, true, false>(bond_args,
+                                                                          d_params,
+                                                                          d_flags,
+                                                                          grid,
+                                                                          threads,
+                                                                          shared_bytes);
         }
     else
         {
-        hipLaunchKernelGGL((gpu_compute_bond_forces_kernel<evaluator, group_size, false>),
-                           grid,
-                           threads,
-                           shared_bytes,
-                           0,
-                           bond_args.d_force,
-                           bond_args.d_virial,
-                           bond_args.virial_pitch,
-                           bond_args.N,
-                           bond_args.d_pos,
-                           bond_args.d_charge,
-                           bond_args.box,
-                           bond_args.d_gpu_bondlist,
-                           bond_args.gpu_table_indexer,
-                           bond_args.d_gpu_bond_pos,
-                           bond_args.d_gpu_n_bonds,
-                           bond_args.n_bond_types,
-                           d_params,
-                           d_flags);
+        if (bond_args.compute_virial)
+            launch_bond_forces_kernel<evaluator, group_size, false, true>(bond_args,
+                                                                          d_params,
+                                                                          d_flags,
+                                                                          grid,
+                                                                          threads,
+                                                                          shared_bytes);
+        else
+            launch_bond_forces_kernel<evaluator, group_size, false, false>(bond_args,
+                                                                           d_params,
+                                                                           d_flags,
+                                                                           grid,
+                                                                           threads,
+                                                                           shared_bytes);
         }
 
     return hipSuccess;
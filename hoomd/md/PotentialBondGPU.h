@@ -41,6 +41,12 @@ class PotentialBondGPU : public PotentialBond<evaluator, Bonds>
     //! Destructor
     virtual ~PotentialBondGPU() { }
 
+    //! Bond kernels run on m_stream and write only this compute's force and virial arrays
+    virtual bool supportsConcurrentStream()
+        {
+        return true;
+        }
+
     protected:
     std::shared_ptr<Autotuner<1>> m_tuner; //!< Autotuner for block size
     GPUArray<unsigned int> m_flags;        //!< Flags set during the kernel execution
@@ -162,6 +168,7 @@ void PotentialBondGPU<evaluator, Bonds>::computeForces(uint64_t timestep)
             kernel::bond_args_t<Bonds::size>(d_force.data,
                                              d_virial.data,
                                              this->m_virial.getPitch(),
+                                             this->m_pdata->getFlags()[pdata_flag::pressure_tensor],
                                              this->m_pdata->getN(),
                                              this->m_pdata->getMaxN(),
                                              d_pos.data,
@@ -173,7 +180,8 @@ void PotentialBondGPU<evaluator, Bonds>::computeForces(uint64_t timestep)
                                              d_gpu_n_bonds.data,
                                              this->m_bond_data->getNTypes(),
                                              this->m_tuner->getParam()[0],
-                                             this->m_exec_conf->dev_prop),
+                                             this->m_exec_conf->dev_prop,
+                                             this->m_stream),
             d_params.data,
             d_flags.data);
         }
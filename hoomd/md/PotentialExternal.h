@@ -7,6 +7,7 @@
 #include "hoomd/VectorMath.h"
 #include "hoomd/managed_allocator.h"
 #include "hoomd/md/EvaluatorExternalPeriodic.h"
+#include "hoomd/md/EvaluatorWalls.h"
 #include <memory>
 #include <stdexcept>
 
@@ -70,6 +71,9 @@ template<class evaluator> class PotentialExternal : public ForceCompute
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
+
+    //! Update the cells of the walls that may interact with the particles
+    void updateWallCells(const BoxDim& box);
     };
 
 /*! Constructor
@@ -100,6 +104,8 @@ template<class evaluator> void PotentialExternal<evaluator>::computeForces(uint6
         }
 
     assert(m_pdata);
+    updateWallCells(m_pdata->getGlobalBox());
+
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
@@ -172,6 +178,38 @@ void PotentialExternal<evaluator>::validateType(unsigned int type, std::string a
     }
 
 //! Returns true if this ForceCompute requires anisotropic integration
+/*! \param box Global simulation box
+
+    Only wall fields have cells. The cells depend on the largest r_cut of all types and whether any
+    type extrapolates the potential.
+*/
+template<class evaluator> void PotentialExternal<evaluator>::updateWallCells(const BoxDim& box)
+    {
+    if constexpr (std::is_same<field_type, wall_type>::value)
+        {
+        ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
+        Scalar r_cut = 0;
+        bool extrapolate = false;
+        for (unsigned int i = 0; i < m_pdata->getNTypes(); i++)
+            {
+            r_cut = std::max(r_cut, sqrt(h_params.data[i].rcutsq));
+            extrapolate = extrapolate || h_params.data[i].rextrap > Scalar(0.0);
+            }
+
+        if (m_field->cellsNeedUpdate(box, r_cut, extrapolate))
+            {
+#ifdef ENABLE_HIP
+            // kernels may still read the previous masks
+            if (m_exec_conf->isCUDAEnabled())
+                {
+                hipDeviceSynchronize();
+                }
+#endif
+            m_field->updateCells(box, r_cut, extrapolate, m_exec_conf->isCUDAEnabled());
+            }
+        }
+    }
+
 template<class evaluator> bool PotentialExternal<evaluator>::isAnisotropic()
     {
     // by default, only translational degrees of freedom are integrated
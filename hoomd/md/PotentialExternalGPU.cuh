@@ -37,10 +37,11 @@ struct external_potential_args_t
                               const Scalar* _d_charge,
                               const BoxDim& _box,
                               const unsigned int _block_size,
-                              const hipDeviceProp_t& _devprop)
+                              const hipDeviceProp_t& _devprop,
+                              hipStream_t _stream = 0)
         : d_force(_d_force), d_torque(_d_torque), d_virial(_d_virial), virial_pitch(_virial_pitch),
           box(_box), N(_N), d_pos(_d_pos), d_orientation(_d_orientation), d_charge(_d_charge),
-          block_size(_block_size), devprop(_devprop) {};
+          block_size(_block_size), devprop(_devprop), stream(_stream) {};
 
     Scalar4* d_force;               //!< Force to write out
     Scalar4* d_torque;              //!< Torque to write out
@@ -53,6 +54,7 @@ struct external_potential_args_t
     const Scalar* d_charge;         //!< particle charges
     const unsigned int block_size;  //!< Block size to execute
     const hipDeviceProp_t& devprop; //!< Device properties
+    hipStream_t stream;             //!< Stream to launch the kernel on
     };
 
 //! Driver function for compute external field kernel
@@ -200,7 +202,7 @@ hipError_t gpu_compute_potential_external_forces(
                        dim3(grid),
                        dim3(threads),
                        bytes,
-                       0,
+                       external_potential_args.stream,
                        external_potential_args.d_force,
                        external_potential_args.d_torque,
                        external_potential_args.d_virial,
@@ -32,6 +32,12 @@ template<class evaluator> class PotentialExternalGPU : public PotentialExternal<
     //! Constructs the compute
     PotentialExternalGPU(std::shared_ptr<SystemDefinition> sysdef);
 
+    //! External kernels run on m_stream and write only this compute's force arrays
+    virtual bool supportsConcurrentStream()
+        {
+        return true;
+        }
+
     protected:
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
@@ -69,6 +75,7 @@ template<class evaluator> void PotentialExternalGPU<evaluator>::computeForces(ui
                                  access_mode::read);
 
     const BoxDim box = this->m_pdata->getGlobalBox();
+    this->updateWallCells(box);
 
     ArrayHandle<Scalar4> d_force(this->m_force, access_location::device, access_mode::overwrite);
     ArrayHandle<Scalar4> d_torque(this->m_torque, access_location::device, access_mode::overwrite);
@@ -89,7 +96,8 @@ template<class evaluator> void PotentialExternalGPU<evaluator>::computeForces(ui
                                           d_charge.data,
                                           box,
                                           m_tuner->getParam()[0],
-                                          this->m_exec_conf->dev_prop),
+                                          this->m_exec_conf->dev_prop,
+                                          this->m_stream),
         d_params.data,
         this->m_field.get());
 
@@ -11,10 +11,13 @@
 #include <stdexcept>
 
 #include "NeighborList.h"
+#include "PairEvaluatorBatch.h"
+#include "hoomd/CellList.h"
 #include "hoomd/ForceCompute.h"
 #include "hoomd/GlobalArray.h"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/Index1D.h"
+#include "hoomd/ParallelLoop.h"
 #include "hoomd/managed_allocator.h"
 #include "hoomd/md/EvaluatorPairLJ.h"
 
@@ -26,6 +29,12 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 /*! \file PotentialPair.h
     \brief Defines the template class for standard pair potentials
     \details The heart of the code that computes pair potentials is in this file.
@@ -40,6 +49,25 @@ namespace hoomd
     {
 namespace md
     {
+namespace detail
+    {
+//! Test if an evaluator implements evalExclusionCorrection()
+template<class evaluator, class = void> struct HasExclusionCorrection : std::false_type
+    {
+    };
+
+template<class evaluator>
+struct HasExclusionCorrection<
+    evaluator,
+    std::void_t<decltype(std::declval<evaluator&>().evalExclusionCorrection(std::declval<Scalar&>(),
+                                                                            std::declval<Scalar&>(),
+                                                                            false))>>
+    : std::true_type
+    {
+    };
+
+    } // end namespace detail
+
 //! Template class for computing pair potentials
 /*! <b>Overview:</b>
     PotentialPair computes standard pair potentials (and forces) between all particle pairs in the
@@ -182,9 +210,96 @@ template<class evaluator> class PotentialPair : public ForceCompute
         return m_tail_correction_enabled;
         }
 
+    //! Set whether the pairs are evaluated in float and accumulated in Scalar on the CPU
+    void setMixedPrecision(bool mixed_precision)
+        {
+        if (mixed_precision && !detail::HasBatchEvaluation<evaluator>::value)
+            {
+            throw std::runtime_error("Mixed precision is not supported by "
+                                     + evaluator::getName());
+            }
+        m_mixed_precision = mixed_precision;
+        }
+
+    bool getMixedPrecision()
+        {
+        return m_mixed_precision;
+        }
+
+    //! Set whether the pairs are found in a cell list instead of the neighbor list on the CPU
+    /*! In cell list mode, computeForces() traverses the cells adjacent to each particle and
+        evaluates the pairs within the cutoff directly. The neighbor list is neither built nor read.
+        This pays off when the neighbor list would be rebuilt every few steps, e.g. for very short
+        cutoffs or fast particles. The neighbor list must not have exclusions.
+    */
+    void setUseCellList(bool use_cell_list)
+        {
+        if (use_cell_list)
+            {
+            if (m_exec_conf->isCUDAEnabled())
+                {
+                throw std::runtime_error("Cell list mode is only available on the CPU.");
+                }
+#ifdef ENABLE_MPI
+            if (m_sysdef->isDomainDecomposed())
+                {
+                throw std::runtime_error("Cell list mode does not support domain decomposition.");
+                }
+#endif
+            if (!m_cell_list)
+                {
+                m_cell_list = std::make_shared<CellList>(m_sysdef);
+                m_cell_list->setRadius(1);
+                m_cell_list->setComputeXYZF(true);
+                m_cell_list->setComputeTypeBody(false);
+                m_cell_list->setFlagIndex();
+                m_cell_list->setSortByType(true);
+                }
+            }
+        m_use_cell_list = use_cell_list;
+        }
+
+    bool getUseCellList()
+        {
+        return m_use_cell_list;
+        }
+
+    //! Set whether the excluded pairs are corrected in the pair loop
+    /*! With the exclusion correction, computeForces() also visits the excluded partners of each
+        particle and adds evaluator::evalExclusionCorrection(). This replaces separate passes over
+        the exclusion list, such as the one in PPPMForceCompute.
+    */
+    void setExclusionCorrection(bool exclusion_correction)
+        {
+        if (exclusion_correction)
+            {
+            if (!detail::HasExclusionCorrection<evaluator>::value)
+                {
+                throw std::runtime_error("Exclusion correction is not supported by "
+                                         + evaluator::getName());
+                }
+            if (m_exec_conf->isCUDAEnabled())
+                {
+                throw std::runtime_error("Exclusion correction is only available on the CPU.");
+                }
+            }
+        m_exclusion_correction = exclusion_correction;
+        }
+
+    bool getExclusionCorrection()
+        {
+        return m_exclusion_correction;
+        }
+
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
+
+    //! Compute the interior particles while the ghost update is in progress
+    virtual bool overlapsGhostUpdate()
+        {
+        return true;
+        }
 #endif
 
     //! Calculates the energy between two lists of particles.
@@ -199,6 +314,18 @@ template<class evaluator> class PotentialPair : public ForceCompute
     computeEnergyBetweenSetsPythonList(pybind11::array_t<int, pybind11::array::c_style> tags1,
                                        pybind11::array_t<int, pybind11::array::c_style> tags2);
 
+    //! Calculates the energy between each pair of sets of particles
+    void computeEnergyMatrix(const std::vector<unsigned int>& tags,
+                             const std::vector<unsigned int>& sets,
+                             unsigned int n_sets,
+                             std::vector<double>& matrix);
+
+    //! Calculates the energy between each pair of sets of particles
+    pybind11::array_t<double>
+    computeEnergyMatrixPython(pybind11::array_t<unsigned int, pybind11::array::c_style> tags,
+                              pybind11::array_t<unsigned int, pybind11::array::c_style> sets,
+                              unsigned int n_sets);
+
     std::vector<std::string> getTypeShapeMapping() const
         {
         std::vector<std::string> type_shape_mapping(m_pdata->getNTypes());
@@ -236,6 +363,25 @@ template<class evaluator> class PotentialPair : public ForceCompute
     bool m_attached = true;
 
     bool m_tail_correction_enabled = false;
+
+    /// Evaluate the pairs in float and accumulate in Scalar (CPU only)
+    bool m_mixed_precision = false;
+
+    /// Find the pairs in m_cell_list instead of the neighbor list (CPU only)
+    bool m_use_cell_list = false;
+
+    /// Add the exclusion correction of the evaluator for the excluded pairs (CPU only)
+    bool m_exclusion_correction = false;
+
+    /// Cell list with a width of the largest cutoff, allocated on first use
+    std::shared_ptr<CellList> m_cell_list;
+
+    /// Cell list that finds the pairs between particle sets, allocated on first use
+    std::shared_ptr<CellList> m_set_cell_list;
+
+    /// Minimum number of selected particles for which the set energies are found in a cell list
+    static const unsigned int set_cell_list_min_particles = 1024;
+
     /// r_cut (not squared) given to the neighbor list
     std::shared_ptr<GlobalArray<Scalar>> m_r_cut_nlist;
 
@@ -247,9 +393,38 @@ template<class evaluator> class PotentialPair : public ForceCompute
     std::shared_ptr<Communicator> m_comm;
 #endif
 
+#ifdef ENABLE_TBB
+    /// Per-thread forces with a half neighbor list, zero between calls to computePairForces()
+    tbb::enumerable_thread_specific<std::vector<Scalar4>> m_thread_force;
+
+    /// Per-thread virials (pitch N) with a half neighbor list, zero between calls
+    tbb::enumerable_thread_specific<std::vector<Scalar>> m_thread_virial;
+
+    //! Size the per-thread buffers to the maximum number of particles
+    void slotMaxNChange();
+#endif
+
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
 
+    //! Accumulate the forces on the given local particles
+    void computePairForces(const unsigned int* particles, unsigned int n_particles);
+
+    //! Add the energies of the pairs of selected particles to the matrix of their sets
+    virtual void computeSelectedEnergies(const std::vector<unsigned int>& selected,
+                                         const std::vector<unsigned int>& selected_set,
+                                         unsigned int n_owned,
+                                         unsigned int n_sets,
+                                         std::vector<double>& matrix);
+
+    //! Evaluate the energy of one pair of particles
+    Scalar computePairEnergy(Scalar rsq,
+                             unsigned int typpair,
+                             Scalar qi,
+                             Scalar qj,
+                             const Scalar* rcutsq,
+                             const Scalar* ronsq) const;
+
     //! Compute the long-range corrections to energy and pressure to account for truncating the pair
     //! potentials
     virtual void computeTailCorrection()
@@ -357,6 +532,9 @@ PotentialPair<evaluator>::PotentialPair(std::shared_ptr<SystemDefinition> sysdef
     assert(m_pdata);
     assert(m_nlist);
 
+    // pair forces write the per-particle virial only when the pressure tensor is requested
+    setDeferVirialAllocation(true);
+
     GlobalArray<Scalar> rcutsq(m_typpair_idx.getNumElements(), m_exec_conf);
     m_rcutsq.swap(rcutsq);
     GlobalArray<Scalar> ronsq(m_typpair_idx.getNumElements(), m_exec_conf);
@@ -370,6 +548,12 @@ PotentialPair<evaluator>::PotentialPair(std::shared_ptr<SystemDefinition> sysdef
         = std::make_shared<GlobalArray<Scalar>>(m_typpair_idx.getNumElements(), m_exec_conf);
     nlist->addRCutMatrix(m_r_cut_nlist);
 
+#ifdef ENABLE_TBB
+    slotMaxNChange();
+    m_pdata->getMaxParticleNumberChangeSignal()
+        .connect<PotentialPair<evaluator>, &PotentialPair<evaluator>::slotMaxNChange>(this);
+#endif
+
 #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
     if (m_pdata->getExecConf()->isCUDAEnabled())
         {
@@ -455,8 +639,26 @@ template<class evaluator> PotentialPair<evaluator>::~PotentialPair()
         {
         m_nlist->removeRCutMatrix(m_r_cut_nlist);
         }
+
+#ifdef ENABLE_TBB
+    m_pdata->getMaxParticleNumberChangeSignal()
+        .disconnect<PotentialPair<evaluator>, &PotentialPair<evaluator>::slotMaxNChange>(this);
+#endif
     }
 
+#ifdef ENABLE_TBB
+/*! Threads allocate their buffers on first use, as zero filled copies of the exemplars.
+ */
+template<class evaluator> void PotentialPair<evaluator>::slotMaxNChange()
+    {
+    const unsigned int max_n = m_pdata->getMaxN();
+    m_thread_force
+        = tbb::enumerable_thread_specific<std::vector<Scalar4>>(max_n, make_scalar4(0, 0, 0, 0));
+    m_thread_virial
+        = tbb::enumerable_thread_specific<std::vector<Scalar>>(6 * max_n, Scalar(0.0));
+    }
+#endif
+
 /*! \param typ1 First type index in the pair
     \param typ2 Second type index in the pair
     \param param Parameter to set
@@ -586,9 +788,78 @@ void PotentialPair<evaluator>::setROnPython(pybind11::tuple types, Scalar r_on)
 */
 template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t timestep)
     {
-    // start by updating the neighborlist
-    m_nlist->compute(timestep);
+    if (m_use_cell_list)
+        {
+        if (m_nlist->getExclusionsSet() || m_nlist->getFilterBody())
+            {
+            throw std::runtime_error("Cell list mode does not support exclusions.");
+            }
+
+        // size the cells to the largest cutoff
+        Scalar rcutsq_max = Scalar(0.0);
+            {
+            ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
+            for (unsigned int i = 0; i < m_rcutsq.getNumElements(); i++)
+                rcutsq_max = std::max(rcutsq_max, h_rcutsq.data[i]);
+            }
+        Scalar r_cut_max = rcutsq_max > Scalar(0.0) ? fast::sqrt(rcutsq_max) : Scalar(1.0);
+        if (r_cut_max != m_cell_list->getNominalWidth())
+            m_cell_list->setNominalWidth(r_cut_max);
+
+        m_cell_list->compute(timestep);
+        }
+    else
+        {
+        // start by updating the neighborlist
+        m_nlist->compute(timestep);
+        }
+
+        {
+        // need to start from a zero force, energy and virial
+        ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+        memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
+        if (h_virial.data)
+            memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+        }
+
+#ifdef ENABLE_MPI
+    if (m_comm && m_comm->isGhostUpdatePending())
+        {
+        const std::vector<unsigned int>& interior = m_nlist->getInteriorParticles();
+        const std::vector<unsigned int>& boundary = m_nlist->getBoundaryParticles();
+
+        // the excluded partners of interior particles may be ghosts
+        if (interior.size() + boundary.size() == m_pdata->getN() && !m_exclusion_correction)
+            {
+            // compute the particles without ghost neighbors while the ghost positions are in
+            // flight, then the remaining particles once they arrive
+            computePairForces(interior.data(), (unsigned int)interior.size());
+            finishGhostUpdate(timestep);
+            computePairForces(boundary.data(), (unsigned int)boundary.size());
+            computeTailCorrection();
+            return;
+            }
 
+        finishGhostUpdate(timestep);
+        }
+#endif
+
+    computePairForces(nullptr, m_pdata->getN());
+    computeTailCorrection();
+    }
+
+/*! \param particles Indices of the local particles to compute, or nullptr to compute the particles
+                     0 through n_particles - 1
+    \param n_particles Number of particles to compute
+
+    Add the forces, energies, and virials of the given particles to the force and virial arrays.
+    With the third law, this also adds the reactions on the local neighbors.
+*/
+template<class evaluator>
+void PotentialPair<evaluator>::computePairForces(const unsigned int* particles,
+                                                 unsigned int n_particles)
+    {
     // depending on the neighborlist settings, we can take advantage of newton's third law
     // to reduce computations at the cost of memory access complexity: set that flag now
     bool third_law = m_nlist->getStorageMode() == NeighborList::half;
@@ -597,7 +868,8 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
     ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
                                         access_location::host,
                                         access_mode::read);
-    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
+    const bool compressed = m_nlist->isCompressed();
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListStorage(),
                                       access_location::host,
                                       access_mode::read);
     //     Index2D nli = m_nlist->getNListIndexer();
@@ -605,12 +877,77 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
                                     access_location::host,
                                     access_mode::read);
 
+    // access the exclusion list to correct the excluded pairs
+    const bool exclusion_correction = m_exclusion_correction;
+    std::unique_ptr<ArrayHandle<unsigned int>> h_n_ex;
+    std::unique_ptr<ArrayHandle<unsigned int>> h_ex_list;
+    Index2D exli;
+    if (exclusion_correction)
+        {
+        h_n_ex.reset(new ArrayHandle<unsigned int>(m_nlist->getNExArray(),
+                                                   access_location::host,
+                                                   access_mode::read));
+        h_ex_list.reset(new ArrayHandle<unsigned int>(m_nlist->getExListArray(),
+                                                      access_location::host,
+                                                      access_mode::read));
+        exli = m_nlist->getExListIndexer();
+        }
+
+    // in cell list mode, the neighbors are found in the cells adjacent to each particle
+    const bool use_cell_list = m_use_cell_list;
+    std::unique_ptr<ArrayHandle<Scalar4>> h_cell_xyzf;
+    std::unique_ptr<ArrayHandle<unsigned int>> h_cell_adj;
+    std::unique_ptr<ArrayHandle<unsigned int>> h_cell_type_offsets;
+    uint3 cell_dim = make_uint3(0, 0, 0);
+    Scalar3 ghost_width = make_scalar3(0, 0, 0);
+    Index3D ci;
+    Index2D cli;
+    Index2D cadji;
+    Index2D cti;
+    if (use_cell_list)
+        {
+        h_cell_xyzf.reset(new ArrayHandle<Scalar4>(m_cell_list->getXYZFArray(),
+                                                   access_location::host,
+                                                   access_mode::read));
+        h_cell_adj.reset(new ArrayHandle<unsigned int>(m_cell_list->getCellAdjArray(),
+                                                       access_location::host,
+                                                       access_mode::read));
+        h_cell_type_offsets.reset(new ArrayHandle<unsigned int>(m_cell_list->getTypeOffsetArray(),
+                                                                access_location::host,
+                                                                access_mode::read));
+        cell_dim = m_cell_list->getDim();
+        ghost_width = m_cell_list->getGhostWidth();
+        ci = m_cell_list->getCellIndexer();
+        cli = m_cell_list->getCellListIndexer();
+        cadji = m_cell_list->getCellAdjIndexer();
+        cti = m_cell_list->getTypeOffsetIndexer();
+        }
+    const BoxDim local_box = m_pdata->getBox();
+    const uchar3 periodic = local_box.getPeriodic();
+    const unsigned int n_types = m_pdata->getNTypes();
+
+    // on a single rank, the neighbor list may store the periodic image of each neighbor so that
+    // the separations need no minimum image convention
+    const bool image_shifts = !use_cell_list && m_nlist->hasImageShifts();
+    std::unique_ptr<ArrayHandle<unsigned char>> h_nlist_image;
+    std::unique_ptr<ArrayHandle<Scalar4>> h_image_pos;
+    const Scalar3* image_shift = m_nlist->getImageShiftVectors();
+    if (image_shifts)
+        {
+        h_nlist_image.reset(new ArrayHandle<unsigned char>(m_nlist->getNListImageArray(),
+                                                           access_location::host,
+                                                           access_mode::read));
+        h_image_pos.reset(new ArrayHandle<Scalar4>(m_nlist->getImagePositions(),
+                                                   access_location::host,
+                                                   access_mode::read));
+        }
+
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
     // force arrays
-    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::readwrite);
 
     const BoxDim box = m_pdata->getGlobalBox();
     ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::read);
@@ -619,94 +956,54 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor];
 
-    // need to start from a zero force, energy and virial
-    memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
-    memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+    const unsigned int N = m_pdata->getN();
 
-    // for each particle
-    for (int i = 0; i < (int)m_pdata->getN(); i++)
-        {
-        // access the particle's position and type (MEM TRANSFER: 4 scalars)
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
-
-        // access charge (if needed)
-        Scalar qi = Scalar(0.0);
-        if (evaluator::needsCharge())
-            qi = h_charge.data[i];
-
-        // initialize current particle force, potential energy, and virial to 0
-        Scalar3 fi = make_scalar3(0, 0, 0);
-        Scalar pei = 0.0;
-        Scalar virialxxi = 0.0;
-        Scalar virialxyi = 0.0;
-        Scalar virialxzi = 0.0;
-        Scalar virialyyi = 0.0;
-        Scalar virialyzi = 0.0;
-        Scalar virialzzi = 0.0;
-
-        // loop over all of the neighbors of this particle
-        const size_t myHead = h_head_list.data[i];
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        for (unsigned int k = 0; k < size; k++)
+    // Accumulate the forces, energies, and virials of the entries [begin, end) of the particle
+    // list into force and virial. With the third law, this also adds the reaction to local
+    // neighbors j.
+    auto compute_range = [&](unsigned int begin,
+                             unsigned int end,
+                             Scalar4* force,
+                             Scalar* virial,
+                             size_t virial_pitch)
+    {
+        // for each particle in the range
+        for (unsigned int particle_idx = begin; particle_idx < end; particle_idx++)
             {
-            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int j = h_nlist.data[myHead + k];
-            assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+            unsigned int i = particles ? particles[particle_idx] : particle_idx;
 
-            // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-            Scalar3 dx = pi - pj;
+            // access the particle's position and type (MEM TRANSFER: 4 scalars)
+            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
 
-            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
-            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
-            assert(typej < m_pdata->getNTypes());
+            // sanity check
+            assert(typei < m_pdata->getNTypes());
 
             // access charge (if needed)
-            Scalar qj = Scalar(0.0);
-            if (evaluator::needsCharge())
-                qj = h_charge.data[j];
-
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
-
-            // calculate r_ij squared (FLOPS: 5)
-            Scalar rsq = dot(dx, dx);
-
-            // get parameters for this type pair
-            unsigned int typpair_idx = m_typpair_idx(typei, typej);
-            const param_type& param = m_params[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
-            Scalar ronsq = Scalar(0.0);
-            if (m_shift_mode == xplor)
-                ronsq = h_ronsq.data[typpair_idx];
-
-            // design specifies that energies are shifted if
-            // 1) shift mode is set to shift
-            // or 2) shift mode is explor and ron > rcut
-            bool energy_shift = false;
-            if (m_shift_mode == shift)
-                energy_shift = true;
-            else if (m_shift_mode == xplor)
-                {
-                if (ronsq > rcutsq)
-                    energy_shift = true;
-                }
-
-            // compute the force and potential energy
-            Scalar force_divr = Scalar(0.0);
-            Scalar pair_eng = Scalar(0.0);
-            evaluator eval(rsq, rcutsq, param);
+            Scalar qi = Scalar(0.0);
             if (evaluator::needsCharge())
-                eval.setCharge(qi, qj);
-
-            bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
-
-            if (evaluated)
-                {
+                qi = h_charge.data[i];
+
+            // initialize current particle force, potential energy, and virial to 0
+            Scalar3 fi = make_scalar3(0, 0, 0);
+            Scalar pei = 0.0;
+            Scalar virialxxi = 0.0;
+            Scalar virialxyi = 0.0;
+            Scalar virialxzi = 0.0;
+            Scalar virialyyi = 0.0;
+            Scalar virialyzi = 0.0;
+            Scalar virialzzi = 0.0;
+
+            // add the force, energy, and virial of the evaluated pair i,j (and the reaction on j
+            // with the third law)
+            auto add_pair = [&](unsigned int j,
+                                const Scalar3& dx,
+                                Scalar rsq,
+                                Scalar rcutsq,
+                                Scalar ronsq,
+                                Scalar force_divr,
+                                Scalar pair_eng)
+            {
                 // modify the potential for xplor shifting
                 if (m_shift_mode == xplor)
                     {
@@ -730,8 +1027,8 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
 
                         // make modifications to the old pair energy and force
                         pair_eng = old_pair_eng * s;
-                        // note: I'm not sure why the minus sign needs to be there: my notes have a
-                        // + But this is verified correct via plotting
+                        // note: I'm not sure why the minus sign needs to be there: my notes
+                        // have a + But this is verified correct via plotting
                         force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
                         }
                     }
@@ -753,44 +1050,386 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
 
                 // add the force to particle j if we are using the third law (MEM TRANSFER: 10
                 // scalars / FLOPS: 8) only add force to local particles
-                if (third_law && j < m_pdata->getN())
+                if (third_law && j < N)
                     {
                     unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x * force_divr;
-                    h_force.data[mem_idx].y -= dx.y * force_divr;
-                    h_force.data[mem_idx].z -= dx.z * force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
+                    force[mem_idx].x -= dx.x * force_divr;
+                    force[mem_idx].y -= dx.y * force_divr;
+                    force[mem_idx].z -= dx.z * force_divr;
+                    force[mem_idx].w += pair_eng * Scalar(0.5);
                     if (compute_virial)
                         {
-                        h_virial.data[0 * m_virial_pitch + mem_idx] += force_div2r * dx.x * dx.x;
-                        h_virial.data[1 * m_virial_pitch + mem_idx] += force_div2r * dx.x * dx.y;
-                        h_virial.data[2 * m_virial_pitch + mem_idx] += force_div2r * dx.x * dx.z;
-                        h_virial.data[3 * m_virial_pitch + mem_idx] += force_div2r * dx.y * dx.y;
-                        h_virial.data[4 * m_virial_pitch + mem_idx] += force_div2r * dx.y * dx.z;
-                        h_virial.data[5 * m_virial_pitch + mem_idx] += force_div2r * dx.z * dx.z;
+                        virial[0 * virial_pitch + mem_idx] += force_div2r * dx.x * dx.x;
+                        virial[1 * virial_pitch + mem_idx] += force_div2r * dx.x * dx.y;
+                        virial[2 * virial_pitch + mem_idx] += force_div2r * dx.x * dx.z;
+                        virial[3 * virial_pitch + mem_idx] += force_div2r * dx.y * dx.y;
+                        virial[4 * virial_pitch + mem_idx] += force_div2r * dx.y * dx.z;
+                        virial[5 * virial_pitch + mem_idx] += force_div2r * dx.z * dx.z;
+                        }
+                    }
+            };
+
+            // call visit(j, dx) for each neighbor j of this particle, where dx is the separation
+            // of the particles with periodic boundary conditions applied
+            auto for_each_neighbor = [&](auto&& visit)
+            {
+                if (image_shifts)
+                    {
+                    const Scalar4* image_pos = h_image_pos->data;
+                    const unsigned char* nlist_image = h_nlist_image->data;
+                    const Scalar3 qi
+                        = make_scalar3(image_pos[i].x, image_pos[i].y, image_pos[i].z);
+                    const size_t head = h_head_list.data[i];
+                    const unsigned int size = (unsigned int)h_n_neigh.data[i];
+                    for (unsigned int k = 0; k < size; k++)
+                        {
+                        const unsigned int j = h_nlist.data[head + k];
+                        assert(j < m_pdata->getN());
+                        const Scalar4 qj = image_pos[j];
+                        visit(j,
+                              qi - make_scalar3(qj.x, qj.y, qj.z)
+                                  - image_shift[nlist_image[head + k]]);
+                        }
+                    return;
+                    }
+
+                if (!use_cell_list)
+                    {
+                    // loop over all of the neighbors of this particle
+                    size_t offset = h_head_list.data[i];
+                    const unsigned int size = (unsigned int)h_n_neigh.data[i];
+                    unsigned int j = 0;
+                    for (unsigned int k = 0; k < size; k++)
+                        {
+                        // access the index of this neighbor (MEM TRANSFER: 1 scalar)
+                        j = detail::nextNeighbor(h_nlist.data, compressed, offset, j);
+                        assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+                        Scalar3 pj
+                            = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                        visit(j, box.minImage(pi - pj));
                         }
+                    return;
                     }
+
+                // find the cell of this particle
+                Scalar3 f = local_box.makeFraction(pi, ghost_width);
+                int ib = (int)(f.x * cell_dim.x);
+                int jb = (int)(f.y * cell_dim.y);
+                int kb = (int)(f.z * cell_dim.z);
+
+                // need to handle the case where the particle is exactly at the box hi
+                if (ib == (int)cell_dim.x && periodic.x)
+                    ib = 0;
+                if (jb == (int)cell_dim.y && periodic.y)
+                    jb = 0;
+                if (kb == (int)cell_dim.z && periodic.z)
+                    kb = 0;
+                const unsigned int my_cell = ci(ib, jb, kb);
+
+                // visit the members of the adjacent cells that are within the cutoff
+                for (unsigned int cur_adj = 0; cur_adj < cadji.getW(); cur_adj++)
+                    {
+                    const unsigned int neigh_cell = h_cell_adj->data[cadji(cur_adj, my_cell)];
+                    for (unsigned int typej = 0; typej < n_types; typej++)
+                        {
+                        const unsigned int type_begin
+                            = h_cell_type_offsets->data[cti(typej, neigh_cell)];
+                        const unsigned int type_end
+                            = h_cell_type_offsets->data[cti(typej + 1, neigh_cell)];
+                        const Scalar rcutsq = h_rcutsq.data[m_typpair_idx(typei, typej)];
+                        if (type_begin == type_end || rcutsq <= Scalar(0.0))
+                            continue;
+
+                        for (unsigned int cur_offset = type_begin; cur_offset < type_end;
+                             cur_offset++)
+                            {
+                            const Scalar4& xyzf = h_cell_xyzf->data[cli(cur_offset, neigh_cell)];
+                            const unsigned int j = __scalar_as_int(xyzf.w);
+
+                            // with the third law, each pair is visited once from its lower index
+                            if (j == i || (third_law && j < i))
+                                continue;
+
+                            Scalar3 dx = box.minImage(pi - make_scalar3(xyzf.x, xyzf.y, xyzf.z));
+                            if (dot(dx, dx) < rcutsq)
+                                visit(j, dx);
+                            }
+                        }
+                    }
+            };
+
+            if constexpr (detail::HasBatchEvaluation<evaluator>::value)
+                {
+                // pack the neighbors into batches that the evaluator computes together in the
+                // precision Real, the results are accumulated in Scalar
+                auto compute_batches = [&](auto real)
+                {
+                    using Real = decltype(real);
+                    detail::PairEvaluatorBatch<param_type, Real> batch;
+                    batch.params = m_params.data();
+                    constexpr unsigned int width
+                        = detail::PairEvaluatorBatch<param_type, Real>::width;
+                    unsigned int batch_j[width];
+                    Scalar3 batch_dx[width];
+                    Scalar batch_rsq[width];
+                    Scalar batch_rcutsq[width];
+                    Scalar batch_ronsq[width];
+                    unsigned int n_lanes = 0;
+
+                    auto evaluate_batch = [&]()
+                    {
+                        // the unused lanes are beyond the cutoff
+                        for (unsigned int lane = n_lanes; lane < width; lane++)
+                            {
+                            batch.rsq[lane] = Real(1.0);
+                            batch.rcutsq[lane] = Real(0.0);
+                            batch.qiqj[lane] = Real(0.0);
+                            batch.energy_shift[lane] = Real(0.0);
+                            batch.param_idx[lane] = 0;
+                            }
+
+                        evaluator::evalForceAndEnergyBatch(batch);
+
+                        for (unsigned int lane = 0; lane < n_lanes; lane++)
+                            {
+                            if (batch.rsq[lane] < batch.rcutsq[lane])
+                                {
+                                add_pair(batch_j[lane],
+                                         batch_dx[lane],
+                                         batch_rsq[lane],
+                                         batch_rcutsq[lane],
+                                         batch_ronsq[lane],
+                                         Scalar(batch.force_divr[lane]),
+                                         Scalar(batch.pair_eng[lane]));
+                                }
+                            }
+                        n_lanes = 0;
+                    };
+
+                    for_each_neighbor(
+                        [&](unsigned int j, const Scalar3& dx)
+                        {
+                        unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+                        assert(typej < m_pdata->getNTypes());
+
+                        unsigned int typpair_idx = m_typpair_idx(typei, typej);
+                        Scalar rsq = dot(dx, dx);
+                        Scalar rcutsq = h_rcutsq.data[typpair_idx];
+                        Scalar ronsq
+                            = m_shift_mode == xplor ? h_ronsq.data[typpair_idx] : Scalar(0.0);
+
+                        batch_j[n_lanes] = j;
+                        batch_dx[n_lanes] = dx;
+                        batch_rsq[n_lanes] = rsq;
+                        batch_rcutsq[n_lanes] = rcutsq;
+                        batch_ronsq[n_lanes] = ronsq;
+                        batch.rsq[n_lanes] = Real(rsq);
+                        batch.rcutsq[n_lanes] = Real(rcutsq);
+                        batch.qiqj[n_lanes]
+                            = evaluator::needsCharge() ? Real(qi * h_charge.data[j]) : Real(0.0);
+                        batch.energy_shift[n_lanes]
+                            = m_shift_mode == shift || (m_shift_mode == xplor && ronsq > rcutsq)
+                                  ? Real(1.0)
+                                  : Real(0.0);
+                        batch.param_idx[n_lanes] = typpair_idx;
+                        n_lanes++;
+
+                        if (n_lanes == width)
+                            evaluate_batch();
+                        });
+
+                    if (n_lanes > 0)
+                        evaluate_batch();
+                };
+
+                if (m_mixed_precision)
+                    compute_batches(float());
+                else
+                    compute_batches(Scalar());
+                }
+            else
+                {
+                for_each_neighbor(
+                    [&](unsigned int j, const Scalar3& dx)
+                    {
+                    // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
+                    unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+                    assert(typej < m_pdata->getNTypes());
+
+                    // access charge (if needed)
+                    Scalar qj = Scalar(0.0);
+                    if (evaluator::needsCharge())
+                        qj = h_charge.data[j];
+
+                    // calculate r_ij squared (FLOPS: 5)
+                    Scalar rsq = dot(dx, dx);
+
+                    // get parameters for this type pair
+                    unsigned int typpair_idx = m_typpair_idx(typei, typej);
+                    const param_type& param = m_params[typpair_idx];
+                    Scalar rcutsq = h_rcutsq.data[typpair_idx];
+                    Scalar ronsq = Scalar(0.0);
+                    if (m_shift_mode == xplor)
+                        ronsq = h_ronsq.data[typpair_idx];
+
+                    // design specifies that energies are shifted if
+                    // 1) shift mode is set to shift
+                    // or 2) shift mode is explor and ron > rcut
+                    bool energy_shift = false;
+                    if (m_shift_mode == shift)
+                        energy_shift = true;
+                    else if (m_shift_mode == xplor)
+                        {
+                        if (ronsq > rcutsq)
+                            energy_shift = true;
+                        }
+
+                    // compute the force and potential energy
+                    Scalar force_divr = Scalar(0.0);
+                    Scalar pair_eng = Scalar(0.0);
+                    evaluator eval(rsq, rcutsq, param);
+                    if (evaluator::needsCharge())
+                        eval.setCharge(qi, qj);
+
+                    bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+
+                    if (evaluated)
+                        add_pair(j, dx, rsq, rcutsq, ronsq, force_divr, pair_eng);
+                    });
+                }
+
+            if constexpr (detail::HasExclusionCorrection<evaluator>::value)
+                {
+                if (exclusion_correction)
+                    {
+                    // the exclusion list holds both i,j and j,i: with the third law, correct each
+                    // pair once from its lower index
+                    const unsigned int n_ex = h_n_ex->data[i];
+                    for (unsigned int k = 0; k < n_ex; k++)
+                        {
+                        const unsigned int j = h_ex_list->data[exli(i, k)];
+                        assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+                        if (third_law && j < i)
+                            continue;
+
+                        Scalar3 pj
+                            = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                        Scalar3 dx = box.minImage(pi - pj);
+                        unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+                        assert(typej < m_pdata->getNTypes());
+
+                        unsigned int typpair_idx = m_typpair_idx(typei, typej);
+                        Scalar rsq = dot(dx, dx);
+                        Scalar rcutsq = h_rcutsq.data[typpair_idx];
+                        bool energy_shift = m_shift_mode == shift
+                                            || (m_shift_mode == xplor
+                                                && h_ronsq.data[typpair_idx] > rcutsq);
+
+                        Scalar force_divr = Scalar(0.0);
+                        Scalar pair_eng = Scalar(0.0);
+                        evaluator eval(rsq, rcutsq, m_params[typpair_idx]);
+                        if (evaluator::needsCharge())
+                            eval.setCharge(qi, h_charge.data[j]);
+
+                        // the correction is not smoothed: pass an empty xplor range
+                        if (eval.evalExclusionCorrection(force_divr, pair_eng, energy_shift))
+                            add_pair(j, dx, rsq, Scalar(0.0), Scalar(0.0), force_divr, pair_eng);
+                        }
+                    }
+                }
+
+            // finally, increment the force, potential energy and virial for particle i
+            unsigned int mem_idx = i;
+            force[mem_idx].x += fi.x;
+            force[mem_idx].y += fi.y;
+            force[mem_idx].z += fi.z;
+            force[mem_idx].w += pei;
+            if (compute_virial)
+                {
+                virial[0 * virial_pitch + mem_idx] += virialxxi;
+                virial[1 * virial_pitch + mem_idx] += virialxyi;
+                virial[2 * virial_pitch + mem_idx] += virialxzi;
+                virial[3 * virial_pitch + mem_idx] += virialyyi;
+                virial[4 * virial_pitch + mem_idx] += virialyzi;
+                virial[5 * virial_pitch + mem_idx] += virialzzi;
                 }
             }
+    };
 
-        // finally, increment the force, potential energy and virial for particle i
-        unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
-        if (compute_virial)
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        m_exec_conf->getTaskArena()->execute(
+            [&]
             {
-            h_virial.data[0 * m_virial_pitch + mem_idx] += virialxxi;
-            h_virial.data[1 * m_virial_pitch + mem_idx] += virialxyi;
-            h_virial.data[2 * m_virial_pitch + mem_idx] += virialxzi;
-            h_virial.data[3 * m_virial_pitch + mem_idx] += virialyyi;
-            h_virial.data[4 * m_virial_pitch + mem_idx] += virialyzi;
-            h_virial.data[5 * m_virial_pitch + mem_idx] += virialzzi;
-            }
-        }
+                if (!third_law)
+                    {
+                    // with a full neighbor list, each thread only writes to its own particles
+                    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_particles),
+                                      [&](const tbb::blocked_range<unsigned int>& r)
+                                      {
+                                          compute_range(r.begin(),
+                                                        r.end(),
+                                                        h_force.data,
+                                                        h_virial.data,
+                                                        m_virial_pitch);
+                                      });
+                    return;
+                    }
 
-    computeTailCorrection();
+                // with a half neighbor list, the reactions on j race between threads:
+                // accumulate into per-thread arrays and reduce them afterwards
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_particles),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  {
+                                      compute_range(r.begin(),
+                                                    r.end(),
+                                                    m_thread_force.local().data(),
+                                                    compute_virial
+                                                        ? m_thread_virial.local().data()
+                                                        : nullptr,
+                                                    N);
+                                  });
+
+                // the reduction zeroes the per-thread arrays for the next call
+                tbb::parallel_for(
+                    tbb::blocked_range<unsigned int>(0, N),
+                    [&](const tbb::blocked_range<unsigned int>& r)
+                    {
+                        for (auto& f : m_thread_force)
+                            {
+                            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                {
+                                h_force.data[i].x += f[i].x;
+                                h_force.data[i].y += f[i].y;
+                                h_force.data[i].z += f[i].z;
+                                h_force.data[i].w += f[i].w;
+                                f[i] = make_scalar4(0, 0, 0, 0);
+                                }
+                            }
+
+                        if (!compute_virial)
+                            return;
+
+                        for (auto& v : m_thread_virial)
+                            {
+                            for (unsigned int k = 0; k < 6; k++)
+                                {
+                                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                    {
+                                    h_virial.data[k * m_virial_pitch + i] += v[k * N + i];
+                                    v[k * N + i] = Scalar(0.0);
+                                    }
+                                }
+                            }
+                    });
+            });
+        }
+    else
+#endif
+        {
+        compute_range(0, n_particles, h_force.data, h_virial.data, m_virial_pitch);
+        }
     }
 
 #ifdef ENABLE_MPI
@@ -839,6 +1478,60 @@ inline void PotentialPair<evaluator>::computeEnergyBetweenSets(InputIterator fir
     if (first1 == last1 || first2 == last2)
         return;
 
+    // the energy between the sets is the off-diagonal element of the matrix of two sets
+    std::vector<unsigned int> tags;
+    std::vector<unsigned int> sets;
+    for (; first1 != last1; ++first1)
+        {
+        tags.push_back(*first1);
+        sets.push_back(0);
+        }
+    for (; first2 != last2; ++first2)
+        {
+        tags.push_back(*first2);
+        sets.push_back(1);
+        }
+
+    std::vector<double> matrix;
+    computeEnergyMatrix(tags, sets, 2, matrix);
+    energy = Scalar(matrix[1]);
+    }
+
+/*! \param tags Tags of the particles
+    \param sets Set of each particle in \a tags, in the range [0, n_sets)
+    \param n_sets Number of sets
+    \param matrix Set to the n_sets x n_sets energies between the sets
+
+    The element (a, b) of \a matrix is the sum of the pair energies u_ij of the particles i in the
+    set a and j in the set b. The diagonal elements are the energies within the sets, which count
+    each pair once. Each particle may belong to only one set.
+
+    The result is reduced over all ranks.
+*/
+template<class evaluator>
+void PotentialPair<evaluator>::computeEnergyMatrix(const std::vector<unsigned int>& tags,
+                                                   const std::vector<unsigned int>& sets,
+                                                   unsigned int n_sets,
+                                                   std::vector<double>& matrix)
+    {
+    if (tags.size() != sets.size())
+        {
+        throw std::runtime_error("tags and sets must have the same length.");
+        }
+
+    const size_t n_tags = m_pdata->getRTags().size();
+    for (size_t k = 0; k < tags.size(); k++)
+        {
+        if (tags[k] >= n_tags)
+            {
+            throw std::runtime_error("Invalid particle tag: " + std::to_string(tags[k]));
+            }
+        if (sets[k] >= n_sets)
+            {
+            throw std::runtime_error("Set index out of range: " + std::to_string(sets[k]));
+            }
+        }
+
 #ifdef ENABLE_MPI
     if (m_sysdef->isDomainDecomposed())
         {
@@ -857,137 +1550,310 @@ inline void PotentialPair<evaluator>::computeEnergyBetweenSets(InputIterator fir
         }
 #endif
 
-    energy = Scalar(0.0);
+    // find the local indices of the selected particles, the owned particles first
+    std::vector<unsigned int> selected;
+    std::vector<unsigned int> selected_set;
+    unsigned int n_owned = 0;
+        {
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        const unsigned int N = m_pdata->getN();
+        const unsigned int n_total = N + m_pdata->getNGhosts();
+        for (size_t k = 0; k < tags.size(); k++)
+            {
+            const unsigned int idx = h_rtag.data[tags[k]];
+            if (idx < N)
+                {
+                selected.push_back(idx);
+                selected_set.push_back(sets[k]);
+                }
+            }
+        n_owned = (unsigned int)selected.size();
+        for (size_t k = 0; k < tags.size(); k++)
+            {
+            const unsigned int idx = h_rtag.data[tags[k]];
+            if (idx >= N && idx < n_total)
+                {
+                selected.push_back(idx);
+                selected_set.push_back(sets[k]);
+                }
+            }
+        }
+
+    matrix.assign(size_t(n_sets) * n_sets, 0.0);
+    computeSelectedEnergies(selected, selected_set, n_owned, n_sets, matrix);
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      matrix.data(),
+                      (int)matrix.size(),
+                      MPI_DOUBLE,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    // both orders of the pairs within a set were added to the diagonal
+    for (unsigned int a = 0; a < n_sets; a++)
+        {
+        matrix[a * n_sets + a] *= 0.5;
+        }
+    }
+
+/*! \param selected Local indices of the selected particles, the owned particles first
+    \param selected_set Set of each selected particle
+    \param n_owned Number of selected particles owned by this rank
+    \param n_sets Number of sets
+    \param matrix n_sets x n_sets energy sums to add to
+
+    Adds u_ij to the element (set of i, set of j) for every ordered pair of distinct selected
+    particles within the cutoff, where i is owned by this rank and j is a local or ghost particle.
+    Large selections find the pairs in a cell list of the width of the largest cutoff, small
+    selections evaluate all pairs of selected particles.
+*/
+template<class evaluator>
+void PotentialPair<evaluator>::computeSelectedEnergies(
+    const std::vector<unsigned int>& selected,
+    const std::vector<unsigned int>& selected_set,
+    unsigned int n_owned,
+    unsigned int n_sets,
+    std::vector<double>& matrix)
+    {
+    const bool use_cell_list = selected.size() >= set_cell_list_min_particles;
+    const unsigned int n_total = m_pdata->getN() + m_pdata->getNGhosts();
+    const unsigned int n_types = m_pdata->getNTypes();
+
+    // the set of each local index, n_sets for particles that are not selected
+    std::vector<unsigned int> set_of_index;
+    if (use_cell_list)
+        {
+        set_of_index.assign(n_total, n_sets);
+        for (size_t k = 0; k < selected.size(); k++)
+            {
+            set_of_index[selected[k]] = selected_set[k];
+            }
+
+        if (!m_set_cell_list)
+            {
+            m_set_cell_list = std::make_shared<CellList>(m_sysdef);
+            m_set_cell_list->setRadius(1);
+            m_set_cell_list->setComputeXYZF(true);
+            m_set_cell_list->setComputeTypeBody(false);
+            m_set_cell_list->setFlagIndex();
+            m_set_cell_list->setSortByType(true);
+            }
+
+        // size the cells to the largest cutoff
+        Scalar rcutsq_max = Scalar(0.0);
+            {
+            ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
+            for (unsigned int i = 0; i < m_rcutsq.getNumElements(); i++)
+                rcutsq_max = std::max(rcutsq_max, h_rcutsq.data[i]);
+            }
+        Scalar r_cut_max = rcutsq_max > Scalar(0.0) ? fast::sqrt(rcutsq_max) : Scalar(1.0);
+        if (r_cut_max != m_set_cell_list->getNominalWidth())
+            m_set_cell_list->setNominalWidth(r_cut_max);
+
+        // the particles may have moved since the last step
+        m_set_cell_list->forceCompute(m_last_computed);
+        }
 
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtags(m_pdata->getRTags(),
-                                      access_location::host,
-                                      access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
-
-    const BoxDim box = m_pdata->getGlobalBox();
     ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
+    const BoxDim box = m_pdata->getGlobalBox();
 
-    // for each particle in tags1
-    while (first1 != last1)
+    std::unique_ptr<ArrayHandle<Scalar4>> h_cell_xyzf;
+    std::unique_ptr<ArrayHandle<unsigned int>> h_cell_adj;
+    std::unique_ptr<ArrayHandle<unsigned int>> h_cell_type_offsets;
+    uint3 cell_dim = make_uint3(0, 0, 0);
+    Scalar3 ghost_width = make_scalar3(0, 0, 0);
+    Index3D ci;
+    Index2D cli;
+    Index2D cadji;
+    Index2D cti;
+    if (use_cell_list)
         {
-        unsigned int i = h_rtags.data[*first1];
-        first1++;
-        if (i >= m_pdata->getN()) // not owned by this processor.
-            continue;
-        // access the particle's position and type (MEM TRANSFER: 4 scalars)
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
-
-        // access charge (if needed)
-        Scalar qi = Scalar(0.0);
-        if (evaluator::needsCharge())
-            qi = h_charge.data[i];
-
-        // loop over all particles in tags2
-        for (InputIterator iter = first2; iter != last2; ++iter)
-            {
-            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int j = h_rtags.data[*iter];
-            if (j >= m_pdata->getN() + m_pdata->getNGhosts()) // not on this processor at all
-                continue;
-            // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-            Scalar3 dx = pi - pj;
+        h_cell_xyzf.reset(new ArrayHandle<Scalar4>(m_set_cell_list->getXYZFArray(),
+                                                   access_location::host,
+                                                   access_mode::read));
+        h_cell_adj.reset(new ArrayHandle<unsigned int>(m_set_cell_list->getCellAdjArray(),
+                                                       access_location::host,
+                                                       access_mode::read));
+        h_cell_type_offsets.reset(
+            new ArrayHandle<unsigned int>(m_set_cell_list->getTypeOffsetArray(),
+                                          access_location::host,
+                                          access_mode::read));
+        cell_dim = m_set_cell_list->getDim();
+        ghost_width = m_set_cell_list->getGhostWidth();
+        ci = m_set_cell_list->getCellIndexer();
+        cli = m_set_cell_list->getCellListIndexer();
+        cadji = m_set_cell_list->getCellAdjIndexer();
+        cti = m_set_cell_list->getTypeOffsetIndexer();
+        }
+    const BoxDim local_box = m_pdata->getBox();
+    const uchar3 periodic = local_box.getPeriodic();
 
-            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
-            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
-            assert(typej < m_pdata->getNTypes());
+    struct EnergyMatrix
+        {
+        std::vector<double> values; //!< Energy sums of the set pairs
 
-            // access charge (if needed)
-            Scalar qj = Scalar(0.0);
-            if (evaluator::needsCharge())
-                qj = h_charge.data[j];
-
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
-
-            // calculate r_ij squared (FLOPS: 5)
-            Scalar rsq = dot(dx, dx);
-
-            // get parameters for this type pair
-            unsigned int typpair_idx = m_typpair_idx(typei, typej);
-            const param_type& param = m_params[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
-            Scalar ronsq = Scalar(0.0);
-            if (m_shift_mode == xplor)
-                ronsq = h_ronsq.data[typpair_idx];
-
-            // design specifies that energies are shifted if
-            // 1) shift mode is set to shift
-            // or 2) shift mode is explor and ron > rcut
-            bool energy_shift = false;
-            if (m_shift_mode == shift)
-                energy_shift = true;
-            else if (m_shift_mode == xplor)
+        EnergyMatrix& operator+=(const EnergyMatrix& other)
+            {
+            if (values.size() < other.values.size())
                 {
-                if (ronsq > rcutsq)
-                    energy_shift = true;
+                values.resize(other.values.size(), 0.0);
                 }
+            for (size_t k = 0; k < other.values.size(); k++)
+                {
+                values[k] += other.values[k];
+                }
+            return *this;
+            }
+        };
 
-            // compute the force and potential energy
-            Scalar force_divr = Scalar(0.0);
-            Scalar pair_eng = Scalar(0.0);
-            evaluator eval(rsq, rcutsq, param);
-            if (evaluator::needsCharge())
-                eval.setCharge(qi, qj);
+    auto compute_range = [&](unsigned int first, unsigned int last, EnergyMatrix& result)
+    {
+        result.values.resize(matrix.size(), 0.0);
+        for (unsigned int k = first; k < last; k++)
+            {
+            const unsigned int i = selected[k];
+            const unsigned int set_i = selected_set[k];
+            const Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            const unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            const Scalar qi = evaluator::needsCharge() ? h_charge.data[i] : Scalar(0.0);
 
-            bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+            auto add_pair = [&](unsigned int j, unsigned int set_j)
+            {
+                const Scalar4 postypej = h_pos.data[j];
+                const Scalar3 dx
+                    = box.minImage(pi - make_scalar3(postypej.x, postypej.y, postypej.z));
+                const unsigned int typpair = m_typpair_idx(typei, __scalar_as_int(postypej.w));
+                const Scalar qj = evaluator::needsCharge() ? h_charge.data[j] : Scalar(0.0);
+                result.values[set_i * n_sets + set_j]
+                    += computePairEnergy(dot(dx, dx), typpair, qi, qj, h_rcutsq.data, h_ronsq.data);
+            };
+
+            if (!use_cell_list)
+                {
+                for (size_t l = 0; l < selected.size(); l++)
+                    {
+                    if (selected[l] != i)
+                        add_pair(selected[l], selected_set[l]);
+                    }
+                continue;
+                }
 
-            if (evaluated)
+            // find the cell of this particle
+            Scalar3 f = local_box.makeFraction(pi, ghost_width);
+            int ib = (int)(f.x * cell_dim.x);
+            int jb = (int)(f.y * cell_dim.y);
+            int kb = (int)(f.z * cell_dim.z);
+
+            // need to handle the case where the particle is exactly at the box hi
+            if (ib == (int)cell_dim.x && periodic.x)
+                ib = 0;
+            if (jb == (int)cell_dim.y && periodic.y)
+                jb = 0;
+            if (kb == (int)cell_dim.z && periodic.z)
+                kb = 0;
+            const unsigned int my_cell = ci(ib, jb, kb);
+
+            // visit the selected members of the adjacent cells
+            for (unsigned int cur_adj = 0; cur_adj < cadji.getW(); cur_adj++)
                 {
-                // modify the potential for xplor shifting
-                if (m_shift_mode == xplor)
+                const unsigned int neigh_cell = h_cell_adj->data[cadji(cur_adj, my_cell)];
+                for (unsigned int typej = 0; typej < n_types; typej++)
                     {
-                    if (rsq >= ronsq && rsq < rcutsq)
+                    const unsigned int type_begin
+                        = h_cell_type_offsets->data[cti(typej, neigh_cell)];
+                    const unsigned int type_end
+                        = h_cell_type_offsets->data[cti(typej + 1, neigh_cell)];
+                    if (type_begin == type_end
+                        || h_rcutsq.data[m_typpair_idx(typei, typej)] <= Scalar(0.0))
+                        continue;
+
+                    for (unsigned int cur_offset = type_begin; cur_offset < type_end; cur_offset++)
                         {
-                        // Implement XPLOR smoothing (FLOPS: 16)
-                        Scalar old_pair_eng = pair_eng;
-                        Scalar old_force_divr = force_divr;
-
-                        // calculate 1.0 / (xplor denominator)
-                        Scalar xplor_denom_inv
-                            = Scalar(1.0)
-                              / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
-
-                        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
-                        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq
-                                   * (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq)
-                                   * xplor_denom_inv;
-                        Scalar ds_dr_divr
-                            = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
-
-                        // make modifications to the old pair energy and force
-                        pair_eng = old_pair_eng * s;
-                        // note: I'm not sure why the minus sign needs to be there: my notes have a
-                        // + But this is verified correct via plotting
-                        force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
+                        const Scalar4& xyzf = h_cell_xyzf->data[cli(cur_offset, neigh_cell)];
+                        const unsigned int j = __scalar_as_int(xyzf.w);
+                        if (j != i && set_of_index[j] != n_sets)
+                            add_pair(j, set_of_index[j]);
                         }
                     }
-                energy += pair_eng;
                 }
             }
+    };
+
+    EnergyMatrix total;
+    total.values.resize(matrix.size(), 0.0);
+    hoomd::detail::parallel_accumulate(*m_exec_conf, n_owned, total, compute_range);
+    for (size_t k = 0; k < matrix.size(); k++)
+        {
+        matrix[k] += total.values[k];
         }
-#ifdef ENABLE_MPI
-    if (this->m_pdata->getDomainDecomposition())
+    }
+
+/*! \param rsq Squared distance between the particles
+    \param typpair Index of the type pair
+    \param qi Charge of the first particle
+    \param qj Charge of the second particle
+    \param rcutsq r_cut squared per type pair
+    \param ronsq r_on squared per type pair
+    \returns The pair energy with the shift mode applied, 0 beyond the cutoff
+*/
+template<class evaluator>
+inline Scalar PotentialPair<evaluator>::computePairEnergy(Scalar rsq,
+                                                          unsigned int typpair,
+                                                          Scalar qi,
+                                                          Scalar qj,
+                                                          const Scalar* rcutsq,
+                                                          const Scalar* ronsq) const
+    {
+    const Scalar pair_rcutsq = rcutsq[typpair];
+    Scalar pair_ronsq = Scalar(0.0);
+    if (m_shift_mode == xplor)
+        pair_ronsq = ronsq[typpair];
+
+    // design specifies that energies are shifted if
+    // 1) shift mode is set to shift
+    // or 2) shift mode is explor and ron > rcut
+    bool energy_shift = false;
+    if (m_shift_mode == shift)
+        energy_shift = true;
+    else if (m_shift_mode == xplor)
         {
-        MPI_Allreduce(MPI_IN_PLACE,
-                      &energy,
-                      1,
-                      MPI_HOOMD_SCALAR,
-                      MPI_SUM,
-                      m_exec_conf->getMPICommunicator());
+        if (pair_ronsq > pair_rcutsq)
+            energy_shift = true;
         }
-#endif
+
+    // compute the force and potential energy
+    Scalar force_divr = Scalar(0.0);
+    Scalar pair_eng = Scalar(0.0);
+    evaluator eval(rsq, pair_rcutsq, m_params[typpair]);
+    if (evaluator::needsCharge())
+        eval.setCharge(qi, qj);
+
+    if (!eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift))
+        return Scalar(0.0);
+
+    // modify the potential for xplor shifting
+    if (m_shift_mode == xplor && rsq >= pair_ronsq && rsq < pair_rcutsq)
+        {
+        // Implement XPLOR smoothing (FLOPS: 16)
+        const Scalar xplor_width = pair_rcutsq - pair_ronsq;
+        Scalar xplor_denom_inv = Scalar(1.0) / (xplor_width * xplor_width * xplor_width);
+
+        Scalar rsq_minus_r_cut_sq = rsq - pair_rcutsq;
+        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq
+                   * (pair_rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * pair_ronsq) * xplor_denom_inv;
+        pair_eng *= s;
+        }
+    return pair_eng;
     }
 
 //! Calculates the energy between two lists of particles.
@@ -1008,6 +1874,30 @@ Scalar PotentialPair<evaluator>::computeEnergyBetweenSetsPythonList(
     return eng;
     }
 
+/*! \param tags Tags of the particles
+    \param sets Set of each particle in \a tags
+    \param n_sets Number of sets
+    \returns The n_sets x n_sets energies between the sets, see computeEnergyMatrix()
+*/
+template<class evaluator>
+pybind11::array_t<double> PotentialPair<evaluator>::computeEnergyMatrixPython(
+    pybind11::array_t<unsigned int, pybind11::array::c_style> tags,
+    pybind11::array_t<unsigned int, pybind11::array::c_style> sets,
+    unsigned int n_sets)
+    {
+    if (tags.ndim() != 1 || sets.ndim() != 1)
+        throw std::domain_error("tags and sets must be one dimensional.");
+
+    std::vector<unsigned int> tag_list(tags.data(), tags.data() + tags.size());
+    std::vector<unsigned int> set_list(sets.data(), sets.data() + sets.size());
+    std::vector<double> matrix;
+    computeEnergyMatrix(tag_list, set_list, n_sets, matrix);
+
+    pybind11::array_t<double> result({size_t(n_sets), size_t(n_sets)});
+    std::copy(matrix.begin(), matrix.end(), result.mutable_data());
+    return result;
+    }
+
 namespace detail
     {
 //! Export this pair potential to python
@@ -1032,7 +1922,17 @@ template<class T> void export_PotentialPair(pybind11::module& m, const std::stri
         .def_property("tail_correction",
                       &PotentialPair<T>::getTailCorrectionEnabled,
                       &PotentialPair<T>::setTailCorrectionEnabled)
-        .def("computeEnergyBetweenSets", &PotentialPair<T>::computeEnergyBetweenSetsPythonList);
+        .def_property("mixed_precision",
+                      &PotentialPair<T>::getMixedPrecision,
+                      &PotentialPair<T>::setMixedPrecision)
+        .def_property("use_cell_list",
+                      &PotentialPair<T>::getUseCellList,
+                      &PotentialPair<T>::setUseCellList)
+        .def_property("exclusion_correction",
+                      &PotentialPair<T>::getExclusionCorrection,
+                      &PotentialPair<T>::setExclusionCorrection)
+        .def("computeEnergyBetweenSets", &PotentialPair<T>::computeEnergyBetweenSetsPythonList)
+        .def("computeEnergyMatrix", &PotentialPair<T>::computeEnergyMatrixPython);
     }
 
     } // end namespace detail
@@ -38,10 +38,17 @@ template<class evaluator> struct AlchemyPackage
 
 //! Template class for computing alchemical pair potentials
 /*! <b>Overview:</b>
+    PotentialPairAlchemical computes the pair forces with parameters scaled by alchemical degrees
+    of freedom (alphas) and the per particle derivatives dU/d alpha that alchemostats integrate.
 
     <b>Implementation details</b>
+    computeForces() updates the parameters of all type pairs with the alphas and computes the
+    forces with PotentialPair. The derivatives are only computed on the time steps where an
+    alchemical particle is integrated (AlchemicalParticle::m_nextTimestep) and only for the type
+    pairs with such particles.
 
-
+    Subclasses that need to modify every pair evaluation override computeForces() to call
+    computeForcesPerPair(), which calls pkgPerNeighbor() for every pair.
 
     \sa export_PotentialPair()
 */
@@ -90,9 +97,18 @@ class PotentialPairAlchemical : public PotentialPair<evaluator>
             = false;
         }
 
+#ifdef ENABLE_MPI
+    //! computeForces() reads the ghosts of all particles
+    virtual bool overlapsGhostUpdate()
+        {
+        return false;
+        }
+#endif
+
     protected:
     typedef std::bitset<evaluator::num_alchemical_parameters> mask_type;
     typedef std::array<Scalar, evaluator::num_alchemical_parameters> alpha_array_t;
+    typedef typename PotentialPair<evaluator>::param_type param_type;
 
     // allow copy and paste from PotentialPair without using this-> on every member
     using PotentialPair<evaluator>::m_exec_conf;
@@ -119,6 +135,9 @@ class PotentialPairAlchemical : public PotentialPair<evaluator>
     std::vector<std::shared_ptr<alpha_particle_type>>
         m_alchemical_particles; //!< 2D array (alchemy_index,alchemical param)
 
+    /// Parameters of all type pairs updated with the current alphas
+    std::vector<param_type, hoomd::detail::managed_allocator<param_type>> m_alchemical_params;
+
     //! Method to be called when number of particles changes
     void slotNumParticlesChange()
         {
@@ -139,6 +158,15 @@ class PotentialPairAlchemical : public PotentialPair<evaluator>
                                        extra_pkg&);
     virtual inline void pkgFinalize(extra_pkg&);
 
+    //! Update the parameters of all type pairs with the alphas
+    void updateAlchemicalParams(extra_pkg& pkg);
+
+    //! Compute the alchemical derivatives of the particles on the CPU
+    void computeAlchemicalDerivatives(extra_pkg& pkg);
+
+    //! Compute the forces and alchemical derivatives with the per neighbor package steps
+    void computeForcesPerPair(uint64_t timestep, extra_pkg& pkg);
+
     virtual void computeForces(uint64_t timestep);
     };
 
@@ -151,7 +179,7 @@ PotentialPairAlchemical<evaluator, extra_pkg, alpha_particle_type>::PotentialPai
     m_alchemy_index = Index2DUpperTriangular(m_pdata->getNTypes());
     m_alchemical_particles.resize(m_alchemy_index.getNumElements()
                                   * evaluator::num_alchemical_parameters);
-    m_alchemy_mask.resize(m_pdata->getNTypes());
+    m_alchemy_mask.resize(m_alchemy_index.getNumElements());
 
     m_exec_conf->msg->notice(5) << "Constructing PotentialPairAlchemical<" << evaluator::getName()
                                 << ">" << std::endl;
@@ -283,12 +311,145 @@ PotentialPairAlchemical<evaluator, extra_pkg, alpha_particle_type>::pkgFinalize(
                 }
     }
 
+/*! Fill m_alchemical_params with the parameters of all type pairs updated with the alphas.
+    \param pkg Package made by pkgInitialize()
+ */
+template<class evaluator, typename extra_pkg, typename alpha_particle_type>
+void PotentialPairAlchemical<evaluator, extra_pkg, alpha_particle_type>::updateAlchemicalParams(
+    extra_pkg& pkg)
+    {
+    if (m_alchemical_params.size() != m_params.size())
+        {
+        m_alchemical_params = std::vector<param_type, hoomd::detail::managed_allocator<param_type>>(
+            m_params.size(),
+            param_type(),
+            hoomd::detail::managed_allocator<param_type>(m_exec_conf->isCUDAEnabled()));
+        }
+
+    const unsigned int n_types = m_pdata->getNTypes();
+    for (unsigned int typei = 0; typei < n_types; typei++)
+        for (unsigned int typej = 0; typej < n_types; typej++)
+            {
+            const unsigned int typpair_idx = m_typpair_idx(typei, typej);
+            m_alchemical_params[typpair_idx]
+                = evaluator::updateAlchemyParams(m_params[typpair_idx],
+                                                 pkg.alphas[m_alchemy_index(typei, typej)]);
+            }
+    }
+
 /*! Compute pair forces with extra alchemical derivatives.
+
+    The forces depend on the alphas only through the parameters, so PotentialPair computes them
+    with the updated parameters in m_alchemical_params. The derivatives are computed in a separate
+    loop and only on the time steps that an alchemostat integrates.
  */
 template<class evaluator, typename extra_pkg, typename alpha_particle_type>
 void PotentialPairAlchemical<evaluator, extra_pkg, alpha_particle_type>::computeForces(
     uint64_t timestep)
     {
+    extra_pkg pkg = pkgInitialize(timestep);
+    updateAlchemicalParams(pkg);
+
+    m_params.swap(m_alchemical_params);
+    try
+        {
+        PotentialPair<evaluator>::computeForces(timestep);
+        }
+    catch (...)
+        {
+        m_params.swap(m_alchemical_params);
+        throw;
+        }
+    m_params.swap(m_alchemical_params);
+
+    if (pkg.calculate_derivatives)
+        {
+        computeAlchemicalDerivatives(pkg);
+        }
+
+    pkgFinalize(pkg);
+    }
+
+/*! Accumulate -dU/d alpha of every particle into the alchemical particles in the package.
+    \param pkg Package made by pkgInitialize()
+ */
+template<class evaluator, typename extra_pkg, typename alpha_particle_type>
+void PotentialPairAlchemical<evaluator, extra_pkg, alpha_particle_type>::
+    computeAlchemicalDerivatives(extra_pkg& pkg)
+    {
+    bool third_law = m_nlist->getStorageMode() == NeighborList::half;
+
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<size_t> h_head_list(m_nlist->getHeadList(),
+                                    access_location::host,
+                                    access_mode::read);
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
+
+    const BoxDim box = m_pdata->getGlobalBox();
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_elements = m_alchemy_index.getNumElements();
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+
+        const size_t myHead = h_head_list.data[i];
+        const unsigned int size = (unsigned int)h_n_neigh.data[i];
+        for (unsigned int k = 0; k < size; k++)
+            {
+            unsigned int j = h_nlist.data[myHead + k];
+            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+
+            // skip the type pairs without alchemical particles to integrate
+            unsigned int alchemy_index = m_alchemy_index(typei, typej);
+            const mask_type& mask = pkg.compute_mask[alchemy_index];
+            if (mask.none())
+                continue;
+
+            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            Scalar3 dx = box.minImage(pi - pj);
+            Scalar rsq = dot(dx, dx);
+
+            unsigned int typpair_idx = m_typpair_idx(typei, typej);
+            Scalar rcutsq = h_rcutsq.data[typpair_idx];
+            if (rsq >= rcutsq)
+                continue;
+
+            evaluator eval(rsq, rcutsq, m_params[typpair_idx]);
+            alpha_array_t alchemical_derivatives = {};
+            eval.evalAlchemyDerivatives(alchemical_derivatives, pkg.alphas[alchemy_index]);
+
+            // the alchemical particles of each parameter follow in blocks of n_elements
+            for (unsigned int p = 0; p < evaluator::num_alchemical_parameters; p++)
+                {
+                if (mask[p])
+                    {
+                    Scalar* derivatives = pkg.force_handles[p * n_elements + alchemy_index].data;
+                    derivatives[i] += alchemical_derivatives[p] * Scalar(-0.5);
+                    if (third_law && j < N)
+                        derivatives[j] += alchemical_derivatives[p] * Scalar(-0.5);
+                    }
+                }
+            }
+        }
+    }
+
+/*! Compute pair forces with extra alchemical derivatives, calling pkgPerNeighbor() for every pair.
+    \param timestep Current time step
+    \param pkg Package made by pkgInitialize()
+ */
+template<class evaluator, typename extra_pkg, typename alpha_particle_type>
+void PotentialPairAlchemical<evaluator, extra_pkg, alpha_particle_type>::computeForcesPerPair(
+    uint64_t timestep,
+    extra_pkg& pkg)
+    {
     // start by updating the neighborlist
     m_nlist->compute(timestep);
 
@@ -324,9 +485,8 @@ void PotentialPairAlchemical<evaluator, extra_pkg, alpha_particle_type>::compute
 
     // need to start from a zero force, energy and virial
     memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
-    memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
-
-    extra_pkg pkg = pkgInitialize(timestep);
+    if (h_virial.data)
+        memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
 
     // for each particle
     for (int i = 0; i < (int)m_pdata->getN(); i++)
@@ -496,7 +656,6 @@ void PotentialPairAlchemical<evaluator, extra_pkg, alpha_particle_type>::compute
             h_virial.data[5 * m_virial_pitch + mem_idx] += virialzzi;
             }
         }
-    pkgFinalize(pkg);
 
     computeTailCorrection();
     }
@@ -0,0 +1,254 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "hip/hip_runtime.h"
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/GPUPartition.cuh"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/Index1D.h"
+
+/*! \file PotentialPairAlchemicalGPU.cuh
+    \brief Defines templated GPU kernel code for calculating alchemical derivatives of pair
+    potentials.
+*/
+
+#ifndef __POTENTIAL_PAIR_ALCHEMICAL_GPU_CUH__
+#define __POTENTIAL_PAIR_ALCHEMICAL_GPU_CUH__
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Wraps arguments to gpu_compute_alchemical_derivatives
+struct alchemical_derivative_args_t
+    {
+    //! Construct a alchemical_derivative_args_t
+    alchemical_derivative_args_t(Scalar* const* _d_derivatives,
+                                 const unsigned int* _d_compute_mask,
+                                 const Scalar* _d_alphas,
+                                 const Scalar4* _d_pos,
+                                 const BoxDim& _box,
+                                 const unsigned int* _d_n_neigh,
+                                 const unsigned int* _d_nlist,
+                                 const size_t* _d_head_list,
+                                 const Scalar* _d_rcutsq,
+                                 const unsigned int _ntypes,
+                                 const unsigned int _block_size,
+                                 const GPUPartition& _gpu_partition)
+        : d_derivatives(_d_derivatives), d_compute_mask(_d_compute_mask), d_alphas(_d_alphas),
+          d_pos(_d_pos), box(_box), d_n_neigh(_d_n_neigh), d_nlist(_d_nlist),
+          d_head_list(_d_head_list), d_rcutsq(_d_rcutsq), ntypes(_ntypes), block_size(_block_size),
+          gpu_partition(_gpu_partition) {};
+
+    Scalar* const* d_derivatives;       //!< Per particle derivatives of each alchemical particle
+    const unsigned int* d_compute_mask; //!< Bit mask of the parameters to compute per type pair
+    const Scalar* d_alphas;             //!< Alphas of the parameters per type pair
+    const Scalar4* d_pos;               //!< particle positions
+    const BoxDim box;                   //!< Simulation box in GPU format
+    const unsigned int* d_n_neigh;      //!< Number of neighbors of each particle
+    const unsigned int* d_nlist;        //!< Neighbor list
+    const size_t* d_head_list;          //!< Head list indexes for accessing d_nlist
+    const Scalar* d_rcutsq;             //!< r_cut squared per particle type pair
+    const unsigned int ntypes;          //!< Number of particle types in the simulation
+    const unsigned int block_size;      //!< Block size to execute
+    const GPUPartition& gpu_partition;  //!< The load balancing partition of particles between GPUs
+    };
+
+#ifdef __HIPCC__
+
+//! Add the accumulated derivatives of one type pair to the per particle derivatives
+/*! \param d_derivatives Per particle derivatives of each alchemical particle
+    \param mask Bit mask of the parameters to compute for the type pair
+    \param alchemy_index Index of the type pair
+    \param n_elements Number of type pairs
+    \param idx Particle index
+    \param sum Accumulated derivatives
+*/
+template<unsigned int n_alchemical>
+__device__ inline void add_alchemical_derivatives(Scalar* const* d_derivatives,
+                                                  unsigned int mask,
+                                                  unsigned int alchemy_index,
+                                                  unsigned int n_elements,
+                                                  unsigned int idx,
+                                                  const Scalar* sum)
+    {
+    for (unsigned int p = 0; p < n_alchemical; p++)
+        {
+        if (mask & (1u << p))
+            {
+            d_derivatives[p * n_elements + alchemy_index][idx] += sum[p];
+            }
+        }
+    }
+
+//! Kernel for calculating the alchemical derivatives of pair potentials
+/*! \param d_derivatives Per particle derivatives of each alchemical particle
+    \param d_compute_mask Bit mask of the parameters to compute per type pair
+    \param d_alphas Alphas of the parameters per type pair
+    \param d_pos particle positions
+    \param box Box dimensions used to implement periodic boundary conditions
+    \param d_n_neigh Number of neighbors of each particle
+    \param d_nlist Neighbor list
+    \param d_head_list Indexes for reading \a d_nlist
+    \param d_params Parameters of the potential per type pair, not updated with the alphas
+    \param d_rcutsq rcut squared, stored per type pair
+    \param ntypes Number of types in the simulation
+    \param N Number of particles in this GPU's range
+    \param offset Offset of the first particle
+
+    Each thread computes the derivatives of one particle over the full neighbor list and adds -1/2
+    of the derivative of each pair to the particle. The thread accumulates the derivatives in
+    registers while consecutive neighbors belong to the same type pair. Only this thread writes
+    the derivatives of its particle, so no atomic operations are needed.
+
+    The derivatives of alchemical parameter p of type pair e (Index2DUpperTriangular) are in
+    d_derivatives[p * n_elements + e], which is only read when bit p of d_compute_mask[e] is set.
+*/
+template<class evaluator>
+__global__ void
+gpu_compute_alchemical_derivatives_kernel(Scalar* const* d_derivatives,
+                                          const unsigned int* d_compute_mask,
+                                          const Scalar* d_alphas,
+                                          const Scalar4* d_pos,
+                                          const BoxDim box,
+                                          const unsigned int* d_n_neigh,
+                                          const unsigned int* d_nlist,
+                                          const size_t* d_head_list,
+                                          const typename evaluator::param_type* d_params,
+                                          const Scalar* d_rcutsq,
+                                          const unsigned int ntypes,
+                                          const unsigned int N,
+                                          const unsigned int offset)
+    {
+    constexpr unsigned int n_alchemical = evaluator::num_alchemical_parameters;
+    const unsigned int work_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (work_idx >= N)
+        return;
+    const unsigned int idx = work_idx + offset;
+
+    const Index2D typpair_idx(ntypes);
+    const Index2DUpperTriangular alchemy_idx(ntypes);
+    const unsigned int n_elements = alchemy_idx.getNumElements();
+
+    const Scalar4 postypei = d_pos[idx];
+    const Scalar3 posi = make_scalar3(postypei.x, postypei.y, postypei.z);
+    const unsigned int typei = __scalar_as_int(postypei.w);
+
+    const size_t head = d_head_list[idx];
+    const unsigned int n_neigh = d_n_neigh[idx];
+
+    unsigned int current_index = n_elements;
+    unsigned int current_mask = 0;
+    Scalar sum[n_alchemical] = {};
+
+    for (unsigned int k = 0; k < n_neigh; k++)
+        {
+        const unsigned int j = d_nlist[head + k];
+        const Scalar4 postypej = d_pos[j];
+        const unsigned int typej = __scalar_as_int(postypej.w);
+
+        const unsigned int alchemy_index = alchemy_idx(typei, typej);
+        if (alchemy_index != current_index)
+            {
+            if (current_mask)
+                add_alchemical_derivatives<n_alchemical>(d_derivatives,
+                                                         current_mask,
+                                                         current_index,
+                                                         n_elements,
+                                                         idx,
+                                                         sum);
+            current_index = alchemy_index;
+            current_mask = d_compute_mask[alchemy_index];
+            for (unsigned int p = 0; p < n_alchemical; p++)
+                sum[p] = Scalar(0.0);
+            }
+
+        if (!current_mask)
+            continue;
+
+        const Scalar3 posj = make_scalar3(postypej.x, postypej.y, postypej.z);
+        const Scalar3 dx = box.minImage(posi - posj);
+        const Scalar rsq = dot(dx, dx);
+        const unsigned int typpair = typpair_idx(typei, typej);
+        const Scalar rcutsq = d_rcutsq[typpair];
+        if (rsq >= rcutsq)
+            continue;
+
+        evaluator eval(rsq, rcutsq, d_params[typpair]);
+        Scalar derivatives[n_alchemical];
+        eval.evalAlchemyDerivatives(derivatives, d_alphas + alchemy_index * n_alchemical);
+        for (unsigned int p = 0; p < n_alchemical; p++)
+            sum[p] += Scalar(-0.5) * derivatives[p];
+        }
+
+    if (current_mask)
+        add_alchemical_derivatives<n_alchemical>(d_derivatives,
+                                                 current_mask,
+                                                 current_index,
+                                                 n_elements,
+                                                 idx,
+                                                 sum);
+    }
+
+//! Kernel driver that computes the alchemical derivatives of pair potentials
+/*! \param args Kernel arguments
+    \param d_params Parameters of the potential per type pair, not updated with the alphas
+
+    The per particle derivatives must be zeroed before the call.
+*/
+template<class evaluator>
+__attribute__((visibility("default"))) hipError_t
+gpu_compute_alchemical_derivatives(const alchemical_derivative_args_t& args,
+                                   const typename evaluator::param_type* d_params)
+    {
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr,
+                         reinterpret_cast<const void*>(
+                             &gpu_compute_alchemical_derivatives_kernel<evaluator>));
+    max_block_size = attr.maxThreadsPerBlock;
+    unsigned int run_block_size = min(args.block_size, max_block_size);
+
+    // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
+    for (int idev = args.gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = args.gpu_partition.getRangeAndSetGPU(idev);
+        unsigned int nwork = range.second - range.first;
+
+        hipLaunchKernelGGL((gpu_compute_alchemical_derivatives_kernel<evaluator>),
+                           dim3(nwork / run_block_size + 1),
+                           dim3(run_block_size),
+                           0,
+                           0,
+                           args.d_derivatives,
+                           args.d_compute_mask,
+                           args.d_alphas,
+                           args.d_pos,
+                           args.box,
+                           args.d_n_neigh,
+                           args.d_nlist,
+                           args.d_head_list,
+                           d_params,
+                           args.d_rcutsq,
+                           args.ntypes,
+                           nwork,
+                           range.first);
+        }
+
+    return hipSuccess;
+    }
+#else
+template<class evaluator>
+__attribute__((visibility("default"))) hipError_t
+gpu_compute_alchemical_derivatives(const alchemical_derivative_args_t& args,
+                                   const typename evaluator::param_type* d_params);
+#endif
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __POTENTIAL_PAIR_ALCHEMICAL_GPU_CUH__
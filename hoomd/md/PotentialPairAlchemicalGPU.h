@@ -0,0 +1,326 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#pragma once
+
+#ifdef ENABLE_HIP
+
+#include <memory>
+
+#include "PotentialPairAlchemical.h"
+#include "PotentialPairAlchemicalGPU.cuh"
+#include "PotentialPairGPU.cuh"
+
+#include "hoomd/Autotuner.h"
+
+/*! \file PotentialPairAlchemicalGPU.h
+    \brief Defines the template class for alchemical pair potentials on the GPU
+    \note This header cannot be compiled by nvcc
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Template class for computing alchemical pair potentials on the GPU
+/*! Derived from PotentialPairAlchemical, this class computes the forces with the kernel of
+    PotentialPairGPU and the parameters updated with the alphas. On the time steps where alchemical
+    particles are integrated, a second kernel computes the per particle alchemical derivatives.
+
+    The driver gpu_compute_pair_forces() must be instantiated for \a evaluator (e.g. by listing it
+    in _pair_evaluators in md/CMakeLists.txt) in addition to gpu_compute_alchemical_derivatives().
+
+    \tparam evaluator EvaluatorPair class used to evaluate V(r), F(r)/r, and dV/d alpha
+
+    \sa export_PotentialPairAlchemicalGPU()
+*/
+template<class evaluator,
+         typename extra_pkg = AlchemyPackage<evaluator>,
+         typename alpha_particle_type = AlchemicalPairParticle>
+class PotentialPairAlchemicalGPU
+    : public PotentialPairAlchemical<evaluator, extra_pkg, alpha_particle_type>
+    {
+    public:
+    //! Construct the pair potential
+    PotentialPairAlchemicalGPU(std::shared_ptr<SystemDefinition> sysdef,
+                               std::shared_ptr<NeighborList> nlist);
+    //! Destructor
+    virtual ~PotentialPairAlchemicalGPU() { }
+
+    protected:
+    std::shared_ptr<Autotuner<2>> m_tuner; //!< Autotuner for block size and threads per particle
+    std::shared_ptr<Autotuner<1>> m_tuner_derivatives; //!< Autotuner for the derivatives kernel
+
+    /// Per particle derivatives of each alchemical particle, nullptr when not computed
+    std::vector<Scalar*, hoomd::detail::managed_allocator<Scalar*>> m_derivative_ptrs;
+
+    /// Bit mask of the alchemical parameters to compute per type pair
+    std::vector<unsigned int, hoomd::detail::managed_allocator<unsigned int>> m_compute_mask;
+
+    /// Alphas of the alchemical parameters per type pair
+    std::vector<Scalar, hoomd::detail::managed_allocator<Scalar>> m_alphas;
+
+    //! Actually compute the forces
+    virtual void computeForces(uint64_t timestep);
+
+    //! Compute the alchemical derivatives of the particles on the GPU
+    void computeAlchemicalDerivativesGPU(extra_pkg& pkg);
+    };
+
+template<class evaluator, typename extra_pkg, typename alpha_particle_type>
+PotentialPairAlchemicalGPU<evaluator, extra_pkg, alpha_particle_type>::PotentialPairAlchemicalGPU(
+    std::shared_ptr<SystemDefinition> sysdef,
+    std::shared_ptr<NeighborList> nlist)
+    : PotentialPairAlchemical<evaluator, extra_pkg, alpha_particle_type>(sysdef, nlist)
+    {
+    // can't run on the GPU if there aren't any GPUs in the execution configuration
+    if (!this->m_exec_conf->isCUDAEnabled())
+        {
+        this->m_exec_conf->msg->error()
+            << "Creating a PotentialPairAlchemicalGPU with no GPU in the execution configuration"
+            << std::endl;
+        throw std::runtime_error("Error initializing PotentialPairAlchemicalGPU");
+        }
+
+    m_tuner.reset(new Autotuner<2>({AutotunerBase::makeBlockSizeRange(this->m_exec_conf),
+                                    AutotunerBase::getTppListPow2(this->m_exec_conf)},
+                                   this->m_exec_conf,
+                                   "pair_alchemical_" + evaluator::getName()));
+    m_tuner_derivatives.reset(
+        new Autotuner<1>({AutotunerBase::makeBlockSizeRange(this->m_exec_conf)},
+                         this->m_exec_conf,
+                         "pair_alchemical_derivatives_" + evaluator::getName()));
+
+    this->m_autotuners.insert(this->m_autotuners.end(), {m_tuner, m_tuner_derivatives});
+
+#ifdef ENABLE_MPI
+    // synchronize autotuner results across ranks
+    m_tuner->setSync(bool(this->m_pdata->getDomainDecomposition()));
+    m_tuner_derivatives->setSync(bool(this->m_pdata->getDomainDecomposition()));
+#endif
+
+    const bool managed = this->m_exec_conf->isCUDAEnabled();
+    m_derivative_ptrs = std::vector<Scalar*, hoomd::detail::managed_allocator<Scalar*>>(
+        this->m_alchemical_particles.size(),
+        nullptr,
+        hoomd::detail::managed_allocator<Scalar*>(managed));
+    m_compute_mask = std::vector<unsigned int, hoomd::detail::managed_allocator<unsigned int>>(
+        this->m_alchemy_index.getNumElements(),
+        0,
+        hoomd::detail::managed_allocator<unsigned int>(managed));
+    m_alphas = std::vector<Scalar, hoomd::detail::managed_allocator<Scalar>>(
+        this->m_alchemy_index.getNumElements() * evaluator::num_alchemical_parameters,
+        Scalar(1.0),
+        hoomd::detail::managed_allocator<Scalar>(managed));
+    }
+
+template<class evaluator, typename extra_pkg, typename alpha_particle_type>
+void PotentialPairAlchemicalGPU<evaluator, extra_pkg, alpha_particle_type>::computeForces(
+    uint64_t timestep)
+    {
+    extra_pkg pkg = this->pkgInitialize(timestep);
+    // the derivatives are accumulated on the device, release the host handles
+    pkg.force_handles.clear();
+    this->updateAlchemicalParams(pkg);
+
+    this->m_nlist->compute(timestep);
+
+    // The GPU implementation CANNOT handle a half neighborlist, error out now
+    bool third_law = this->m_nlist->getStorageMode() == NeighborList::half;
+    if (third_law)
+        {
+        this->m_exec_conf->msg->error()
+            << "PotentialPairAlchemicalGPU cannot handle a half neighborlist" << std::endl;
+        throw std::runtime_error("Error computing forces in PotentialPairAlchemicalGPU");
+        }
+
+        {
+        // access the neighbor list
+        ArrayHandle<unsigned int> d_n_neigh(this->m_nlist->getNNeighArray(),
+                                            access_location::device,
+                                            access_mode::read);
+        ArrayHandle<unsigned int> d_nlist(this->m_nlist->getNListArray(),
+                                          access_location::device,
+                                          access_mode::read);
+        ArrayHandle<size_t> d_head_list(this->m_nlist->getHeadList(),
+                                        access_location::device,
+                                        access_mode::read);
+
+        // access the particle data
+        ArrayHandle<Scalar4> d_pos(this->m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::read);
+        ArrayHandle<Scalar> d_charge(this->m_pdata->getCharges(),
+                                     access_location::device,
+                                     access_mode::read);
+
+        BoxDim box = this->m_pdata->getBox();
+
+        // access parameters
+        ArrayHandle<Scalar> d_ronsq(this->m_ronsq, access_location::device, access_mode::read);
+        ArrayHandle<Scalar> d_rcutsq(this->m_rcutsq, access_location::device, access_mode::read);
+        ArrayHandle<Scalar4> d_force(this->m_force,
+                                     access_location::device,
+                                     access_mode::readwrite);
+        ArrayHandle<Scalar> d_virial(this->m_virial,
+                                     access_location::device,
+                                     access_mode::readwrite);
+
+        // access flags
+        PDataFlags flags = this->m_pdata->getFlags();
+
+        this->m_exec_conf->beginMultiGPU();
+
+        m_tuner->begin();
+        auto param = m_tuner->getParam();
+        unsigned int block_size = param[0];
+        unsigned int threads_per_particle = param[1];
+
+        kernel::gpu_compute_pair_forces<evaluator>(
+            kernel::pair_args_t(d_force.data,
+                                d_virial.data,
+                                this->m_virial.getPitch(),
+                                this->m_pdata->getN(),
+                                this->m_pdata->getMaxN(),
+                                d_pos.data,
+                                d_charge.data,
+                                box,
+                                d_n_neigh.data,
+                                d_nlist.data,
+                                d_head_list.data,
+                                d_rcutsq.data,
+                                d_ronsq.data,
+                                this->m_nlist->getNListArray().getPitch(),
+                                this->m_pdata->getNTypes(),
+                                block_size,
+                                this->m_shift_mode,
+                                flags[pdata_flag::pressure_tensor],
+                                threads_per_particle,
+                                this->m_pdata->getGPUPartition(),
+                                this->m_exec_conf->dev_prop),
+            this->m_alchemical_params.data());
+
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+
+        m_tuner->end();
+
+        this->m_exec_conf->endMultiGPU();
+        }
+
+    if (pkg.calculate_derivatives)
+        {
+        computeAlchemicalDerivativesGPU(pkg);
+        }
+
+    // energy and pressure corrections with the updated parameters
+    this->m_params.swap(this->m_alchemical_params);
+    this->computeTailCorrection();
+    this->m_params.swap(this->m_alchemical_params);
+
+    this->pkgFinalize(pkg);
+    }
+
+/*! The per particle derivatives were zeroed by pkgInitialize().
+    \param pkg Package made by pkgInitialize()
+ */
+template<class evaluator, typename extra_pkg, typename alpha_particle_type>
+void PotentialPairAlchemicalGPU<evaluator, extra_pkg, alpha_particle_type>::
+    computeAlchemicalDerivativesGPU(extra_pkg& pkg)
+    {
+    const unsigned int n_elements = this->m_alchemy_index.getNumElements();
+    const unsigned int n_alchemical = evaluator::num_alchemical_parameters;
+
+    // pack the masks and alphas of the type pairs for the kernel
+    for (unsigned int i = 0; i < n_elements; i++)
+        {
+        m_compute_mask[i] = static_cast<unsigned int>(pkg.compute_mask[i].to_ulong());
+        for (unsigned int j = 0; j < n_alchemical; j++)
+            {
+            m_alphas[i * n_alchemical + j] = pkg.alphas[i][j];
+            }
+        }
+
+    // access the derivatives of the alchemical particles with computed derivatives
+    std::vector<ArrayHandle<Scalar>> d_derivatives;
+    d_derivatives.reserve(this->m_alchemical_particles.size());
+    for (unsigned int k = 0; k < this->m_alchemical_particles.size(); k++)
+        {
+        const auto& particle = this->m_alchemical_particles[k];
+        m_derivative_ptrs[k] = nullptr;
+        if (particle && pkg.compute_mask[k % n_elements][k / n_elements])
+            {
+            d_derivatives.emplace_back(particle->m_alchemical_derivatives,
+                                       access_location::device,
+                                       access_mode::readwrite);
+            m_derivative_ptrs[k] = d_derivatives.back().data;
+            }
+        }
+
+    ArrayHandle<unsigned int> d_n_neigh(this->m_nlist->getNNeighArray(),
+                                        access_location::device,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> d_nlist(this->m_nlist->getNListArray(),
+                                      access_location::device,
+                                      access_mode::read);
+    ArrayHandle<size_t> d_head_list(this->m_nlist->getHeadList(),
+                                    access_location::device,
+                                    access_mode::read);
+    ArrayHandle<Scalar4> d_pos(this->m_pdata->getPositions(),
+                               access_location::device,
+                               access_mode::read);
+    ArrayHandle<Scalar> d_rcutsq(this->m_rcutsq, access_location::device, access_mode::read);
+
+    this->m_exec_conf->beginMultiGPU();
+    m_tuner_derivatives->begin();
+
+    kernel::gpu_compute_alchemical_derivatives<evaluator>(
+        kernel::alchemical_derivative_args_t(m_derivative_ptrs.data(),
+                                             m_compute_mask.data(),
+                                             m_alphas.data(),
+                                             d_pos.data,
+                                             this->m_pdata->getBox(),
+                                             d_n_neigh.data,
+                                             d_nlist.data,
+                                             d_head_list.data,
+                                             d_rcutsq.data,
+                                             this->m_pdata->getNTypes(),
+                                             m_tuner_derivatives->getParam()[0],
+                                             this->m_pdata->getGPUPartition()),
+        this->m_params.data());
+
+    if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+
+    m_tuner_derivatives->end();
+    this->m_exec_conf->endMultiGPU();
+    }
+
+namespace detail
+    {
+//! Export this pair potential to python
+/*! \param name Name of the class in the exported python module
+    \tparam evaluator Evaluator type to export.
+*/
+template<class evaluator,
+         typename extra_pkg = AlchemyPackage<evaluator>,
+         typename alpha_particle_type = AlchemicalPairParticle>
+void export_PotentialPairAlchemicalGPU(pybind11::module& m, const std::string& name)
+    {
+    typedef PotentialPairAlchemical<evaluator, extra_pkg, alpha_particle_type> base;
+    typedef PotentialPairAlchemicalGPU<evaluator, extra_pkg, alpha_particle_type> T;
+    pybind11::class_<T, base, std::shared_ptr<T>>(m, name.c_str())
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<NeighborList>>());
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // ENABLE_HIP
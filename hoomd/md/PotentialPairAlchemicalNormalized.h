@@ -104,6 +104,14 @@ class PotentialPairAlchemicalNormalized
                                evaluator& eval,
                                extra_pkg&) override;
     inline void pkgFinalize(extra_pkg&) override;
+
+    //! The normalization scales every pair, evaluate the pairs with the package steps
+    void computeForces(uint64_t timestep) override
+        {
+        extra_pkg pkg = pkgInitialize(timestep);
+        this->computeForcesPerPair(timestep, pkg);
+        pkgFinalize(pkg);
+        }
     };
 
 template<class evaluator, typename extra_pkg, typename alpha_particle_type>
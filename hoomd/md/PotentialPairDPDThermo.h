@@ -5,8 +5,12 @@
 #define __POTENTIAL_PAIR_DPDTHERMO_H__
 
 #include "PotentialPair.h"
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
 #include "hoomd/Variant.h"
 
+#include <algorithm>
+
 /*! \file PotentialPairDPDThermo.h
     \brief Defines the template class for a dpd thermostat and LJ pair potential
     \note This header cannot be compiled by nvcc
@@ -62,6 +66,12 @@ template<class evaluator> class PotentialPairDPDThermo : public PotentialPair<ev
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
+
+    //! computeForces() reads the ghosts of all particles
+    virtual bool overlapsGhostUpdate()
+        {
+        return false;
+        }
 #endif
 
     protected:
@@ -79,6 +89,8 @@ PotentialPairDPDThermo<evaluator>::PotentialPairDPDThermo(std::shared_ptr<System
                                                           std::shared_ptr<NeighborList> nlist)
     : PotentialPair<evaluator>(sysdef, nlist)
     {
+    // the thermostat writes the per-particle virial on every step
+    this->setDeferVirialAllocation(false);
     }
 
 /*! \param T the temperature the system is thermostated on this time step.
@@ -142,6 +154,23 @@ template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(
     memset((void*)h_virial.data, 0, sizeof(Scalar) * this->m_virial.getNumElements());
 
     uint16_t seed = this->m_sysdef->getSeed();
+    const Seed rng_seed(RNGIdentifier::EvaluatorPairDPDThermo, timestep, seed);
+
+    // Special Potential Pair DPD Requirements
+    const Scalar currentTemp = m_T->operator()(timestep);
+
+    // design specifies that energies are shifted if
+    // 1) shift mode is set to shift
+    bool energy_shift = false;
+    if (this->m_shift_mode == this->shift)
+        energy_shift = true;
+
+    // pairs within the cutoff are packed into lanes that draw their random values together
+    constexpr unsigned int width = 16;
+    unsigned int batch_j[width];
+    Scalar3 batch_dx[width];
+    Scalar batch_rsq[width];
+    unsigned int batch_typpair[width];
 
     // for each particle
     for (int i = 0; i < (int)this->m_pdata->getN(); i++)
@@ -152,6 +181,7 @@ template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(
 
         unsigned int typei = __scalar_as_int(h_pos.data[i].w);
         const size_t head_i = h_head_list.data[i];
+        unsigned int tagi = h_tag.data[i];
 
         // sanity check
         assert(typei < this->m_pdata->getNTypes());
@@ -163,6 +193,89 @@ template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(
         for (unsigned int l = 0; l < 6; l++)
             viriali[l] = 0.0;
 
+        unsigned int n_lanes = 0;
+
+        auto evaluate_batch = [&]()
+        {
+            // draw the random values of all lanes, seeded by the global tags
+            RandomGeneratorBatch<width> rng(rng_seed);
+            for (unsigned int lane = 0; lane < n_lanes; lane++)
+                {
+                unsigned int tagj = h_tag.data[batch_j[lane]];
+                rng.setCounter(lane, Counter(std::min(tagi, tagj), std::max(tagi, tagj)));
+                }
+            Scalar alpha[width];
+            UniformDistribution<Scalar>(-1, 1)(rng, alpha);
+
+            for (unsigned int lane = 0; lane < n_lanes; lane++)
+                {
+                unsigned int j = batch_j[lane];
+                Scalar3 dx = batch_dx[lane];
+
+                // calculate dv_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
+                Scalar3 vj = make_scalar3(h_vel.data[j].x, h_vel.data[j].y, h_vel.data[j].z);
+                Scalar3 dv = vi - vj;
+
+                // calculate the drag term r \dot v
+                Scalar rdotv = dot(dx, dv);
+
+                // get parameters for this type pair
+                unsigned int typpair_idx = batch_typpair[lane];
+                const param_type& param = this->m_params[typpair_idx];
+                Scalar rcutsq = h_rcutsq.data[typpair_idx];
+
+                // compute the force and potential energy
+                Scalar force_divr = Scalar(0.0);
+                Scalar force_divr_cons = Scalar(0.0);
+                Scalar pair_eng = Scalar(0.0);
+                evaluator eval(batch_rsq[lane], rcutsq, param);
+
+                eval.set_seed_ij_timestep(seed, tagi, h_tag.data[j], timestep);
+                eval.setRandomValue(alpha[lane]);
+                eval.setDeltaT(this->m_deltaT);
+                eval.setRDotV(rdotv);
+                eval.setT(currentTemp);
+
+                bool evaluated = eval.evalForceEnergyThermo(force_divr,
+                                                            force_divr_cons,
+                                                            pair_eng,
+                                                            energy_shift);
+
+                if (evaluated)
+                    {
+                    // compute the virial (FLOPS: 2)
+                    Scalar pair_virial[6];
+                    pair_virial[0] = Scalar(0.5) * dx.x * dx.x * force_divr_cons;
+                    pair_virial[1] = Scalar(0.5) * dx.x * dx.y * force_divr_cons;
+                    pair_virial[2] = Scalar(0.5) * dx.x * dx.z * force_divr_cons;
+                    pair_virial[3] = Scalar(0.5) * dx.y * dx.y * force_divr_cons;
+                    pair_virial[4] = Scalar(0.5) * dx.y * dx.z * force_divr_cons;
+                    pair_virial[5] = Scalar(0.5) * dx.z * dx.z * force_divr_cons;
+
+                    // add the force, potential energy and virial to the particle i
+                    // (FLOPS: 8)
+                    fi += dx * force_divr;
+                    pei += pair_eng * Scalar(0.5);
+                    for (unsigned int l = 0; l < 6; l++)
+                        viriali[l] += pair_virial[l];
+
+                    // add the force to particle j if we are using the third law (MEM TRANSFER: 10
+                    // scalars / FLOPS: 8)
+                    if (third_law)
+                        {
+                        unsigned int mem_idx = j;
+                        h_force.data[mem_idx].x -= dx.x * force_divr;
+                        h_force.data[mem_idx].y -= dx.y * force_divr;
+                        h_force.data[mem_idx].z -= dx.z * force_divr;
+                        h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
+                        for (unsigned int l = 0; l < 6; l++)
+                            h_virial.data[l * this->m_virial_pitch + mem_idx] += pair_virial[l];
+                        }
+                    }
+                }
+            n_lanes = 0;
+        };
+
         // loop over all of the neighbors of this particle
         const unsigned int size = (unsigned int)h_n_neigh.data[i];
         for (unsigned int k = 0; k < size; k++)
@@ -175,10 +288,6 @@ template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(
             Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
             Scalar3 dx = pi - pj;
 
-            // calculate dv_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 vj = make_scalar3(h_vel.data[j].x, h_vel.data[j].y, h_vel.data[j].z);
-            Scalar3 dv = vi - vj;
-
             // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
             unsigned int typej = __scalar_as_int(h_pos.data[j].w);
             assert(typej < this->m_pdata->getNTypes());
@@ -189,73 +298,25 @@ template<class evaluator> void PotentialPairDPDThermo<evaluator>::computeForces(
             // calculate r_ij squared (FLOPS: 5)
             Scalar rsq = dot(dx, dx);
 
-            // calculate the drag term r \dot v
-            Scalar rdotv = dot(dx, dv);
-
-            // get parameters for this type pair
+            // the evaluators compute nothing beyond the cutoff, skip those pairs before drawing
+            // random values for them
             unsigned int typpair_idx = this->m_typpair_idx(typei, typej);
-            const param_type& param = this->m_params[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
-
-            // design specifies that energies are shifted if
-            // 1) shift mode is set to shift
-            bool energy_shift = false;
-            if (this->m_shift_mode == this->shift)
-                energy_shift = true;
-
-            // compute the force and potential energy
-            Scalar force_divr = Scalar(0.0);
-            Scalar force_divr_cons = Scalar(0.0);
-            Scalar pair_eng = Scalar(0.0);
-            evaluator eval(rsq, rcutsq, param);
-
-            // Special Potential Pair DPD Requirements
-            const Scalar currentTemp = m_T->operator()(timestep);
-
-            // set seed using global tags
-            unsigned int tagi = h_tag.data[i];
-            unsigned int tagj = h_tag.data[j];
-            eval.set_seed_ij_timestep(seed, tagi, tagj, timestep);
-            eval.setDeltaT(this->m_deltaT);
-            eval.setRDotV(rdotv);
-            eval.setT(currentTemp);
-
-            bool evaluated
-                = eval.evalForceEnergyThermo(force_divr, force_divr_cons, pair_eng, energy_shift);
-
-            if (evaluated)
-                {
-                // compute the virial (FLOPS: 2)
-                Scalar pair_virial[6];
-                pair_virial[0] = Scalar(0.5) * dx.x * dx.x * force_divr_cons;
-                pair_virial[1] = Scalar(0.5) * dx.x * dx.y * force_divr_cons;
-                pair_virial[2] = Scalar(0.5) * dx.x * dx.z * force_divr_cons;
-                pair_virial[3] = Scalar(0.5) * dx.y * dx.y * force_divr_cons;
-                pair_virial[4] = Scalar(0.5) * dx.y * dx.z * force_divr_cons;
-                pair_virial[5] = Scalar(0.5) * dx.z * dx.z * force_divr_cons;
-
-                // add the force, potential energy and virial to the particle i
-                // (FLOPS: 8)
-                fi += dx * force_divr;
-                pei += pair_eng * Scalar(0.5);
-                for (unsigned int l = 0; l < 6; l++)
-                    viriali[l] += pair_virial[l];
-
-                // add the force to particle j if we are using the third law (MEM TRANSFER: 10
-                // scalars / FLOPS: 8)
-                if (third_law)
-                    {
-                    unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x * force_divr;
-                    h_force.data[mem_idx].y -= dx.y * force_divr;
-                    h_force.data[mem_idx].z -= dx.z * force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
-                    for (unsigned int l = 0; l < 6; l++)
-                        h_virial.data[l * this->m_virial_pitch + mem_idx] += pair_virial[l];
-                    }
-                }
+            if (rsq >= h_rcutsq.data[typpair_idx])
+                continue;
+
+            batch_j[n_lanes] = j;
+            batch_dx[n_lanes] = dx;
+            batch_rsq[n_lanes] = rsq;
+            batch_typpair[n_lanes] = typpair_idx;
+            n_lanes++;
+
+            if (n_lanes == width)
+                evaluate_batch();
             }
 
+        if (n_lanes > 0)
+            evaluate_batch();
+
         // finally, increment the force, potential energy and virial for particle i
         unsigned int mem_idx = i;
         h_force.data[mem_idx].x += fi.x;
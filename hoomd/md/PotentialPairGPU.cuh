@@ -97,6 +97,45 @@ struct pair_args_t
     const hipDeviceProp_t& devprop;    //!< CUDA device properties
     };
 
+//! Wraps arguments to gpu_compute_energy_matrix
+struct energy_matrix_args_t
+    {
+    //! Construct an energy_matrix_args_t
+    energy_matrix_args_t(double* _d_matrix,
+                         const unsigned int* _d_selected,
+                         const unsigned int* _d_set,
+                         const unsigned int _n_owned,
+                         const unsigned int _n_selected,
+                         const unsigned int _n_sets,
+                         const Scalar4* _d_pos,
+                         const Scalar* _d_charge,
+                         const BoxDim& _box,
+                         const Scalar* _d_rcutsq,
+                         const Scalar* _d_ronsq,
+                         const unsigned int _ntypes,
+                         const unsigned int _block_size,
+                         const unsigned int _shift_mode)
+        : d_matrix(_d_matrix), d_selected(_d_selected), d_set(_d_set), n_owned(_n_owned),
+          n_selected(_n_selected), n_sets(_n_sets), d_pos(_d_pos), d_charge(_d_charge), box(_box),
+          d_rcutsq(_d_rcutsq), d_ronsq(_d_ronsq), ntypes(_ntypes), block_size(_block_size),
+          shift_mode(_shift_mode) {};
+
+    double* d_matrix;               //!< Energy sums of the set pairs, n_sets x n_sets
+    const unsigned int* d_selected; //!< Indices of the selected particles, owned particles first
+    const unsigned int* d_set;      //!< Set of each selected particle
+    const unsigned int n_owned;     //!< Number of selected particles owned by this rank
+    const unsigned int n_selected;  //!< Number of selected particles, including ghosts
+    const unsigned int n_sets;      //!< Number of sets
+    const Scalar4* d_pos;           //!< particle positions
+    const Scalar* d_charge;         //!< particle charges
+    const BoxDim box;               //!< Simulation box in GPU format
+    const Scalar* d_rcutsq;         //!< Device array listing r_cut squared per particle type pair
+    const Scalar* d_ronsq;          //!< Device array listing r_on squared per particle type pair
+    const unsigned int ntypes;      //!< Number of particle types in the simulation
+    const unsigned int block_size;  //!< Block size to execute
+    const unsigned int shift_mode;  //!< The potential energy shift mode
+    };
+
 #ifdef __HIPCC__
 
 //! Kernel for calculating pair forces
@@ -186,14 +225,19 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
                 }
             }
 
+        // copy the packed parameters in the widest words that evenly divide them
+        typedef typename std::conditional<sizeof(typename evaluator::param_type) % sizeof(int4)
+                                              == 0,
+                                          int4,
+                                          int>::type word_type;
         unsigned int param_size
-            = num_typ_parameters * sizeof(typename evaluator::param_type) / sizeof(int);
+            = num_typ_parameters * sizeof(typename evaluator::param_type) / sizeof(word_type);
         for (unsigned int cur_offset = 0; cur_offset < param_size; cur_offset += blockDim.x)
             {
             if (cur_offset + threadIdx.x < param_size)
                 {
-                ((int*)s_params)[cur_offset + threadIdx.x]
-                    = ((int*)d_params)[cur_offset + threadIdx.x];
+                ((word_type*)s_params)[cur_offset + threadIdx.x]
+                    = ((const word_type*)d_params)[cur_offset + threadIdx.x];
                 }
             }
 
@@ -654,11 +698,162 @@ gpu_compute_pair_forces(const pair_args_t& pair_args,
 
     return hipSuccess;
     }
+
+//! Kernel that sums the pair energies between sets of particles
+/*! \param args Selected particles and parameters, see energy_matrix_args_t
+    \param d_params Parameters for the potential, stored per type pair
+
+    \tparam evaluator EvaluatorPair class to evaluate V(r)
+    \tparam shift_mode 0: No energy shifting is done. 1: V(r) is shifted to be 0 at rcut. 2: XPLOR
+    switching is enabled
+
+    One thread per owned selected particle i evaluates the energy with every other selected
+    particle j and adds it to the matrix element of the sets of i and j.
+*/
+template<class evaluator, unsigned int shift_mode>
+__global__ void gpu_compute_energy_matrix_kernel(const energy_matrix_args_t args,
+                                                 const typename evaluator::param_type* d_params)
+    {
+    const unsigned int k = blockIdx.x * blockDim.x + threadIdx.x;
+    if (k >= args.n_owned)
+        return;
+
+    Index2D typpair_idx(args.ntypes);
+    const unsigned int i = args.d_selected[k];
+    const unsigned int set_i = args.d_set[k];
+    const Scalar4 postypei = __ldg(args.d_pos + i);
+    const Scalar3 posi = make_scalar3(postypei.x, postypei.y, postypei.z);
+    const unsigned int typei = __scalar_as_int(postypei.w);
+
+    Scalar qi = Scalar(0);
+    if (evaluator::needsCharge())
+        qi = __ldg(args.d_charge + i);
+
+    for (unsigned int l = 0; l < args.n_selected; l++)
+        {
+        const unsigned int j = args.d_selected[l];
+        if (j == i)
+            continue;
+
+        const Scalar4 postypej = __ldg(args.d_pos + j);
+        const Scalar3 dx
+            = args.box.minImage(posi - make_scalar3(postypej.x, postypej.y, postypej.z));
+        const Scalar rsq = dot(dx, dx);
+
+        const unsigned int typpair = typpair_idx(typei, __scalar_as_int(postypej.w));
+        const Scalar rcutsq = args.d_rcutsq[typpair];
+        if (rsq >= rcutsq)
+            continue;
+
+        Scalar ronsq = Scalar(0.0);
+        if (shift_mode == 2)
+            ronsq = args.d_ronsq[typpair];
+
+        // design specifies that energies are shifted if
+        // 1) shift mode is set to shift
+        // or 2) shift mode is explor and ron > rcut
+        bool energy_shift = false;
+        if (shift_mode == 1)
+            energy_shift = true;
+        else if (shift_mode == 2)
+            {
+            if (ronsq > rcutsq)
+                energy_shift = true;
+            }
+
+        Scalar qj = Scalar(0.0);
+        if (evaluator::needsCharge())
+            qj = __ldg(args.d_charge + j);
+
+        Scalar force_divr = Scalar(0.0);
+        Scalar pair_eng = Scalar(0.0);
+        evaluator eval(rsq, rcutsq, d_params[typpair]);
+        if (evaluator::needsCharge())
+            eval.setCharge(qi, qj);
+
+        if (!eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift))
+            continue;
+
+        if (shift_mode == 2)
+            {
+            if (rsq >= ronsq && rsq < rcutsq)
+                {
+                // Implement XPLOR smoothing
+                Scalar xplor_denom_inv
+                    = Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+                Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
+                Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq
+                           * (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
+                pair_eng *= s;
+                }
+            }
+
+        atomicAdd(&args.d_matrix[set_i * args.n_sets + args.d_set[l]], double(pair_eng));
+        }
+    }
+
+//! Sum the pair energies between sets of particles on the GPU
+/*! \param args Selected particles and parameters, see energy_matrix_args_t
+    \param d_params Parameters for the potential, stored per type pair
+
+    Adds the energy of every ordered pair (i, j) of distinct selected particles, where i is owned by
+    this rank, to the element (set of i, set of j) of args.d_matrix.
+*/
+template<class evaluator>
+__attribute__((visibility("default"))) hipError_t
+gpu_compute_energy_matrix(const energy_matrix_args_t& args,
+                          const typename evaluator::param_type* d_params)
+    {
+    if (args.n_owned == 0)
+        return hipSuccess;
+
+    const dim3 grid(args.n_owned / args.block_size + 1);
+    const dim3 threads(args.block_size);
+    switch (args.shift_mode)
+        {
+    case 0:
+        hipLaunchKernelGGL((gpu_compute_energy_matrix_kernel<evaluator, 0>),
+                           grid,
+                           threads,
+                           0,
+                           0,
+                           args,
+                           d_params);
+        break;
+    case 1:
+        hipLaunchKernelGGL((gpu_compute_energy_matrix_kernel<evaluator, 1>),
+                           grid,
+                           threads,
+                           0,
+                           0,
+                           args,
+                           d_params);
+        break;
+    case 2:
+        hipLaunchKernelGGL((gpu_compute_energy_matrix_kernel<evaluator, 2>),
+                           grid,
+                           threads,
+                           0,
+                           0,
+                           args,
+                           d_params);
+        break;
+    default:
+        break;
+        }
+
+    return hipSuccess;
+    }
 #else
 template<class evaluator>
 __attribute__((visibility("default"))) hipError_t
 gpu_compute_pair_forces(const pair_args_t& pair_args,
                         const typename evaluator::param_type* d_params);
+
+template<class evaluator>
+__attribute__((visibility("default"))) hipError_t
+gpu_compute_energy_matrix(const energy_matrix_args_t& args,
+                          const typename evaluator::param_type* d_params);
 #endif
 
     } // end namespace kernel
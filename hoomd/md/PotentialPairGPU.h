@@ -53,9 +53,17 @@ template<class evaluator> class PotentialPairGPU : public PotentialPair<evaluato
 
     protected:
     std::shared_ptr<Autotuner<2>> m_tuner; //!< Autotuner for block size and threads per particle
+    std::shared_ptr<Autotuner<1>> m_tuner_energy_matrix; //!< Autotuner for the set energies
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
+
+    //! Add the energies of the pairs of selected particles to the matrix of their sets
+    virtual void computeSelectedEnergies(const std::vector<unsigned int>& selected,
+                                         const std::vector<unsigned int>& selected_set,
+                                         unsigned int n_owned,
+                                         unsigned int n_sets,
+                                         std::vector<double>& matrix);
     };
 
 template<class evaluator>
@@ -78,7 +86,11 @@ PotentialPairGPU<evaluator>::PotentialPairGPU(std::shared_ptr<SystemDefinition>
                                    this->m_exec_conf,
                                    "pair_" + evaluator::getName()));
 
-    this->m_autotuners.push_back(m_tuner);
+    m_tuner_energy_matrix.reset(
+        new Autotuner<1>({AutotunerBase::makeBlockSizeRange(this->m_exec_conf)},
+                         this->m_exec_conf,
+                         "pair_energy_matrix_" + evaluator::getName()));
+    this->m_autotuners.insert(this->m_autotuners.end(), {m_tuner, m_tuner_energy_matrix});
 
 #ifdef ENABLE_MPI
     // synchronize autotuner results across ranks
@@ -171,6 +183,83 @@ template<class evaluator> void PotentialPairGPU<evaluator>::computeForces(uint64
     this->computeTailCorrection();
     }
 
+/*! \param selected Local indices of the selected particles, the owned particles first
+    \param selected_set Set of each selected particle
+    \param n_owned Number of selected particles owned by this rank
+    \param n_sets Number of sets
+    \param matrix n_sets x n_sets energy sums to add to
+
+    One GPU thread per owned selected particle evaluates its pairs with all selected particles.
+*/
+template<class evaluator>
+void PotentialPairGPU<evaluator>::computeSelectedEnergies(
+    const std::vector<unsigned int>& selected,
+    const std::vector<unsigned int>& selected_set,
+    unsigned int n_owned,
+    unsigned int n_sets,
+    std::vector<double>& matrix)
+    {
+    if (n_owned == 0)
+        return;
+
+    GPUArray<unsigned int> selected_array(selected.size(), this->m_exec_conf);
+    GPUArray<unsigned int> set_array(selected.size(), this->m_exec_conf);
+    GPUArray<double> matrix_array(matrix.size(), this->m_exec_conf);
+        {
+        ArrayHandle<unsigned int> h_selected(selected_array,
+                                             access_location::host,
+                                             access_mode::overwrite);
+        ArrayHandle<unsigned int> h_set(set_array, access_location::host, access_mode::overwrite);
+        ArrayHandle<double> h_matrix(matrix_array, access_location::host, access_mode::overwrite);
+        std::copy(selected.begin(), selected.end(), h_selected.data);
+        std::copy(selected_set.begin(), selected_set.end(), h_set.data);
+        std::fill(h_matrix.data, h_matrix.data + matrix.size(), 0.0);
+        }
+
+        {
+        ArrayHandle<unsigned int> d_selected(selected_array,
+                                             access_location::device,
+                                             access_mode::read);
+        ArrayHandle<unsigned int> d_set(set_array, access_location::device, access_mode::read);
+        ArrayHandle<double> d_matrix(matrix_array, access_location::device, access_mode::readwrite);
+        ArrayHandle<Scalar4> d_pos(this->m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::read);
+        ArrayHandle<Scalar> d_charge(this->m_pdata->getCharges(),
+                                     access_location::device,
+                                     access_mode::read);
+        ArrayHandle<Scalar> d_ronsq(this->m_ronsq, access_location::device, access_mode::read);
+        ArrayHandle<Scalar> d_rcutsq(this->m_rcutsq, access_location::device, access_mode::read);
+
+        m_tuner_energy_matrix->begin();
+        kernel::gpu_compute_energy_matrix<evaluator>(
+            kernel::energy_matrix_args_t(d_matrix.data,
+                                         d_selected.data,
+                                         d_set.data,
+                                         n_owned,
+                                         (unsigned int)selected.size(),
+                                         n_sets,
+                                         d_pos.data,
+                                         d_charge.data,
+                                         this->m_pdata->getGlobalBox(),
+                                         d_rcutsq.data,
+                                         d_ronsq.data,
+                                         this->m_pdata->getNTypes(),
+                                         m_tuner_energy_matrix->getParam()[0],
+                                         this->m_shift_mode),
+            this->m_params.data());
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner_energy_matrix->end();
+        }
+
+    ArrayHandle<double> h_matrix(matrix_array, access_location::host, access_mode::read);
+    for (size_t k = 0; k < matrix.size(); k++)
+        {
+        matrix[k] += h_matrix.data[k];
+        }
+    }
+
 namespace detail
     {
 //! Export this pair potential to python
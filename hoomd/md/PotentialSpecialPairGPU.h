@@ -126,6 +126,7 @@ template<class evaluator> void PotentialSpecialPairGPU<evaluator>::computeForces
             kernel::bond_args_t<2>(d_force.data,
                                    d_virial.data,
                                    this->m_virial.getPitch(),
+                                   this->m_pdata->getFlags()[pdata_flag::pressure_tensor],
                                    this->m_pdata->getN(),
                                    this->m_pdata->getMaxN(),
                                    d_pos.data,
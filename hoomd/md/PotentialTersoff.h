@@ -9,6 +9,7 @@
 #include <memory>
 #include <stdexcept>
 
+#include "BondedForceThreads.h"
 #include "NeighborList.h"
 #include "hoomd/ForceCompute.h"
 #include "hoomd/GPUArray.h"
@@ -135,6 +136,9 @@ template<class evaluator> class PotentialTersoff : public ForceCompute
     // r_cut (not squared) given to the neighborlist
     std::shared_ptr<GlobalArray<Scalar>> m_r_cut_nlist;
 
+    /// dr (x, y, z) and rsq (w) of each neighbor list entry
+    GPUArray<Scalar4> m_pair_dr;
+
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
     };
@@ -156,6 +160,8 @@ PotentialTersoff<evaluator>::PotentialTersoff(std::shared_ptr<SystemDefinition>
     m_rcutsq.swap(rcutsq);
     GPUArray<param_type> params(m_typpair_idx.getNumElements(), m_exec_conf);
     m_params.swap(params);
+    GPUArray<Scalar4> pair_dr(1, m_exec_conf);
+    m_pair_dr.swap(pair_dr);
 
     m_r_cut_nlist
         = std::make_shared<GlobalArray<Scalar>>(m_typpair_idx.getNumElements(), m_exec_conf);
@@ -269,66 +275,99 @@ template<class evaluator> Scalar PotentialTersoff<evaluator>::getRCut(pybind11::
    called to ensure that it is up to date before proceeding.
 
     \param timestep specifies the current time step of the simulation
+
+    The triplet loops need dr and rsq of every neighbor of particle i many times. They are computed
+    once per particle into m_pair_dr, which is aligned with the neighbor list, so the loops over k
+    read them instead of applying the minimum image convention again. The particles are distributed
+    over the TBB threads with computeBondedForces(), because the forces scatter to j and k.
 */
 template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64_t timestep)
     {
-    // *****  check if we need the structure of the Tersoff or the RevCross potential for evaluation
-    if (evaluator::flag_for_RevCross)
+    const std::string name
+        = evaluator::flag_for_RevCross ? "PotentialRevCross" : "PotentialTersoff";
+
+    // start by updating the neighborlist
+    m_nlist->compute(timestep);
+
+    // The three-body potentials can't handle a half neighbor list, so check now.
+    bool third_law = m_nlist->getStorageMode() == NeighborList::half;
+    if (third_law)
         {
-        // ***** RevCross potential
-        // start by updating the neighborlist
-        m_nlist->compute(timestep);
+        m_exec_conf->msg->error() << std::endl
+                                  << name << " cannot handle a half neighborlist" << std::endl;
+        throw std::runtime_error("Error computing forces in " + name);
+        }
 
-        // The three-body potentials can't handle a half neighbor list, so check now.
-        bool third_law = m_nlist->getStorageMode() == NeighborList::half;
-        if (third_law)
-            {
-            m_exec_conf->msg->error()
-                << std::endl
-                << "PotentialRevCross cannot handle a half neighborlist" << std::endl;
-            throw std::runtime_error("Error computing forces in PotentialRevCross");
-            }
+    // grow the pair buffer with the neighbor list
+    if (m_pair_dr.getNumElements() < m_nlist->getNListArray().getNumElements())
+        {
+        m_pair_dr.resize(m_nlist->getNListArray().getNumElements());
+        }
 
-        // access the neighbor list, particle data, and system box
-        ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
-                                            access_location::host,
-                                            access_mode::read);
-        ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
-                                          access_location::host,
-                                          access_mode::read);
-        ArrayHandle<size_t> h_head_list(m_nlist->getHeadList(),
+    // access the neighbor list, particle data, and system box
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
                                         access_location::host,
                                         access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<size_t> h_head_list(m_nlist->getHeadList(),
+                                    access_location::host,
+                                    access_mode::read);
+    ArrayHandle<Scalar4> h_pair_dr(m_pair_dr, access_location::host, access_mode::overwrite);
 
-        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::read);
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
 
-        // force and virial arrays
-        ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+    // force and virial arrays
+    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
 
-        PDataFlags flags = this->m_pdata->getFlags();
-        bool compute_virial = flags[pdata_flag::pressure_tensor];
+    PDataFlags flags = this->m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor];
 
-        const BoxDim box = m_pdata->getBox();
-        ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
-        ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
+    const BoxDim box = m_pdata->getBox();
+    ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
+    ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
 
-        // need to start from a zero force, energy
-        memset(h_force.data, 0, sizeof(Scalar4) * (m_pdata->getN() + m_pdata->getNGhosts()));
-        memset(h_virial.data, 0, sizeof(Scalar) * 6 * m_virial_pitch);
+    // need to start from a zero force, energy
+    memset(h_force.data, 0, sizeof(Scalar4) * (m_pdata->getN() + m_pdata->getNGhosts()));
+    memset(h_virial.data, 0, sizeof(Scalar) * 6 * m_virial_pitch);
 
+    // compute dr and rsq of each neighbor of particle i, only particle i reads its entries
+    auto fill_pair_buffer = [&](unsigned int i)
+    {
+        Scalar3 posi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        const size_t head_i = h_head_list.data[i];
+        const unsigned int size = (unsigned int)h_n_neigh.data[i];
+        for (unsigned int j = 0; j < size; j++)
+            {
+            unsigned int jj = h_nlist.data[head_i + j];
+            assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
+
+            Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
+            Scalar3 dx = box.minImage(posi - posj);
+            h_pair_dr.data[head_i + j] = make_scalar4(dx.x, dx.y, dx.z, dot(dx, dx));
+            }
+    };
+
+    // ***** RevCross potential
+    auto compute_revcross_range = [&](unsigned int first,
+                                      unsigned int last,
+                                      Scalar4* force,
+                                      Scalar* virial,
+                                      size_t virial_pitch)
+    {
         // for each particle
-        for (int i = 0; i < (int)m_pdata->getN(); i++)
+        for (unsigned int i = first; i < last; i++)
             {
-            // access the particle's position and type (MEM TRANSFER: 4 scalars)
-            Scalar3 posi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            // access the particle's type
             unsigned int typei = __scalar_as_int(h_pos.data[i].w);
             const size_t head_i = h_head_list.data[i];
             // sanity check
             assert(typei < m_pdata->getNTypes());
 
+            fill_pair_buffer(i);
+
             // initialize current force and potential energy of particle i to 0
             Scalar3 fi = make_scalar3(0.0, 0.0, 0.0);
             Scalar pei = 0.0;
@@ -348,8 +387,7 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
                 unsigned int jj = h_nlist.data[head_i + j];
                 assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
 
-                // access the position and type of particle j
-                Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
+                // access the type of particle j
                 unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
                 assert(typej < m_pdata->getNTypes());
 
@@ -357,14 +395,10 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
                 Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
                 Scalar pej = 0.0;
 
-                // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-                Scalar3 dxij = posi - posj;
-
-                // apply periodic boundary conditions
-                dxij = box.minImage(dxij);
-
-                // compute rij_sq (FLOPS: 5)
-                Scalar rij_sq = dot(dxij, dxij);
+                // read dr_ij and rij_sq from the pair buffer
+                const Scalar4 drij = h_pair_dr.data[head_i + j];
+                Scalar3 dxij = make_scalar3(drij.x, drij.y, drij.z);
+                Scalar rij_sq = drij.w;
 
                 // get parameters for this type pair
                 unsigned int typpair_idx = m_typpair_idx(typei, typej);
@@ -423,9 +457,7 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
                         unsigned int kk = h_nlist.data[head_i + k];
                         assert(kk < m_pdata->getN() + m_pdata->getNGhosts());
 
-                        // access the position and type of neighbor k
-                        Scalar3 posk
-                            = make_scalar3(h_pos.data[kk].x, h_pos.data[kk].y, h_pos.data[kk].z);
+                        // access the type of neighbor k
                         unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
                         assert(typek < m_pdata->getNTypes());
 
@@ -435,12 +467,10 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
                             = h_params.data[typpair_idx]; // use this to control the species wich
                                                           // have to interact
 
-                        // compute dr_ik
-                        Scalar3 dxik = posi - posk;
-                        // apply periodic boundary conditions
-                        dxik = box.minImage(dxik);
-                        // compute rik_sq
-                        Scalar rik_sq = dot(dxik, dxik);
+                        // read dr_ik and rik_sq from the pair buffer
+                        const Scalar4 drik = h_pair_dr.data[head_i + k];
+                        Scalar3 dxik = make_scalar3(drik.x, drik.y, drik.z);
+                        Scalar rik_sq = drik.w;
 
                         // check if k interacts using a temporary evaluator to analyze i-k
                         // parameters
@@ -501,9 +531,9 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
 
                                 // increment the force for particle k
                                 unsigned int mem_idx = kk;
-                                h_force.data[mem_idx].x += fk.x;
-                                h_force.data[mem_idx].y += fk.y;
-                                h_force.data[mem_idx].z += fk.z;
+                                force[mem_idx].x += fk.x;
+                                force[mem_idx].y += fk.y;
+                                force[mem_idx].z += fk.z;
                                 }
                             }
                         }
@@ -511,89 +541,52 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
 
                 // increment the force and potential energy for particle j
                 unsigned int mem_idx = jj;
-                h_force.data[mem_idx].x += fj.x;
-                h_force.data[mem_idx].y += fj.y;
-                h_force.data[mem_idx].z += fj.z;
-                h_force.data[mem_idx].w += pej;
+                force[mem_idx].x += fj.x;
+                force[mem_idx].y += fj.y;
+                force[mem_idx].z += fj.z;
+                force[mem_idx].w += pej;
                 }
 
             // finally, increment the force and potential energy for particle i
             unsigned int mem_idx = i;
-            h_force.data[mem_idx].x += fi.x;
-            h_force.data[mem_idx].y += fi.y;
-            h_force.data[mem_idx].z += fi.z;
-            h_force.data[mem_idx].w += pei;
+            force[mem_idx].x += fi.x;
+            force[mem_idx].y += fi.y;
+            force[mem_idx].z += fi.z;
+            force[mem_idx].w += pei;
 
             // imcrement vir for i
             if (compute_virial)
                 {
-                h_virial.data[0 * m_virial_pitch + mem_idx] += virialixx;
-                h_virial.data[1 * m_virial_pitch + mem_idx] += virialixy;
-                h_virial.data[2 * m_virial_pitch + mem_idx] += virialixz;
-                h_virial.data[3 * m_virial_pitch + mem_idx] += virialiyy;
-                h_virial.data[4 * m_virial_pitch + mem_idx] += virialiyz;
-                h_virial.data[5 * m_virial_pitch + mem_idx] += virializz;
+                virial[0 * virial_pitch + mem_idx] += virialixx;
+                virial[1 * virial_pitch + mem_idx] += virialixy;
+                virial[2 * virial_pitch + mem_idx] += virialixz;
+                virial[3 * virial_pitch + mem_idx] += virialiyy;
+                virial[4 * virial_pitch + mem_idx] += virialiyz;
+                virial[5 * virial_pitch + mem_idx] += virializz;
                 }
             }
-        }
-    else
-        {
-        // ****** Tersoff or SquareDensity potential
-        // start by updating the neighborlist
-        m_nlist->compute(timestep);
-
-        // The three-body potentials can't handle a half neighbor list, so check now.
-        bool third_law = m_nlist->getStorageMode() == NeighborList::half;
-        if (third_law)
-            {
-            m_exec_conf->msg->error()
-                << std::endl
-                << "PotentialTersoff cannot handle a half neighborlist" << std::endl;
-            throw std::runtime_error("Error computing forces in PotentialTersoff");
-            }
-
-        // access the neighbor list, particle data, and system box
-        ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
-                                            access_location::host,
-                                            access_mode::read);
-        ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
-                                          access_location::host,
-                                          access_mode::read);
-        ArrayHandle<size_t> h_head_list(m_nlist->getHeadList(),
-                                        access_location::host,
-                                        access_mode::read);
-
-        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::read);
-
-        // force and virial arrays
-        ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
-
-        PDataFlags flags = this->m_pdata->getFlags();
-        bool compute_virial = flags[pdata_flag::pressure_tensor];
-
-        const BoxDim box = m_pdata->getBox();
-        ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
-        ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
-
-        // need to start from a zero force, energy
-        memset(h_force.data, 0, sizeof(Scalar4) * (m_pdata->getN() + m_pdata->getNGhosts()));
-        memset(h_virial.data, 0, sizeof(Scalar) * 6 * m_virial_pitch);
+    };
 
+    // ****** Tersoff or SquareDensity potential
+    auto compute_tersoff_range = [&](unsigned int first,
+                                     unsigned int last,
+                                     Scalar4* force,
+                                     Scalar* virial,
+                                     size_t virial_pitch)
+    {
         unsigned int ntypes = m_pdata->getNTypes();
 
         // for each particle
-        for (int i = 0; i < (int)m_pdata->getN(); i++)
+        for (unsigned int i = first; i < last; i++)
             {
-            // access the particle's position and type (MEM TRANSFER: 4 scalars)
-            Scalar3 posi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            // access the particle's type
             unsigned int typei = __scalar_as_int(h_pos.data[i].w);
             const size_t head_i = h_head_list.data[i];
             // sanity check
             assert(typei < m_pdata->getNTypes());
 
+            fill_pair_buffer(i);
+
             // initialize current force and potential energy of particle i to 0
             Scalar3 fi = make_scalar3(0.0, 0.0, 0.0);
             Scalar pei = 0.0;
@@ -623,20 +616,12 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
                     unsigned int jj = h_nlist.data[head_i + j];
                     assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
 
-                    // access the position and type of particle j
-                    Scalar3 posj
-                        = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
+                    // access the type of particle j
                     unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
                     assert(typej < m_pdata->getNTypes());
 
-                    // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-                    Scalar3 dxij = posi - posj;
-
-                    // apply periodic boundary conditions
-                    dxij = box.minImage(dxij);
-
-                    // compute rij_sq (FLOPS: 5)
-                    Scalar rij_sq = dot(dxij, dxij);
+                    // read rij_sq from the pair buffer
+                    Scalar rij_sq = h_pair_dr.data[head_i + j].w;
 
                     // get parameters for this type pair
                     unsigned int typpair_idx = m_typpair_idx(typei, typej);
@@ -668,8 +653,7 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
                 unsigned int jj = h_nlist.data[head_i + j];
                 assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
 
-                // access the position and type of particle j
-                Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
+                // access the type of particle j
                 unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
                 assert(typej < m_pdata->getNTypes());
 
@@ -677,14 +661,10 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
                 Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
                 Scalar pej = 0.0;
 
-                // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-                Scalar3 dxij = posi - posj;
-
-                // apply periodic boundary conditions
-                dxij = box.minImage(dxij);
-
-                // compute rij_sq (FLOPS: 5)
-                Scalar rij_sq = dot(dxij, dxij);
+                // read dr_ij and rij_sq from the pair buffer
+                const Scalar4 drij = h_pair_dr.data[head_i + j];
+                Scalar3 dxij = make_scalar3(drij.x, drij.y, drij.z);
+                Scalar rij_sq = drij.w;
 
                 // get parameters for this type pair
                 unsigned int typpair_idx = m_typpair_idx(typei, typej);
@@ -716,10 +696,7 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
                             unsigned int kk = h_nlist.data[head_i + k];
                             assert(kk < m_pdata->getN() + m_pdata->getNGhosts());
 
-                            // access the position and type of neighbor k
-                            Scalar3 posk = make_scalar3(h_pos.data[kk].x,
-                                                        h_pos.data[kk].y,
-                                                        h_pos.data[kk].z);
+                            // access the type of neighbor k
                             unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
                             assert(typek < m_pdata->getNTypes());
 
@@ -732,14 +709,10 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
 
                             if (kk != jj && temp_evaluated)
                                 {
-                                // compute drik
-                                Scalar3 dxik = posi - posk;
-
-                                // apply periodic boundary conditions
-                                dxik = box.minImage(dxik);
-
-                                // compute rik_sq
-                                Scalar rik_sq = dot(dxik, dxik);
+                                // read dr_ik and rik_sq from the pair buffer
+                                const Scalar4 drik = h_pair_dr.data[head_i + k];
+                                Scalar3 dxik = make_scalar3(drik.x, drik.y, drik.z);
+                                Scalar rik_sq = drik.w;
 
                                 // compute the bond angle (if needed)
                                 Scalar cos_th = Scalar(0.0);
@@ -803,10 +776,7 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
                             unsigned int kk = h_nlist.data[head_i + k];
                             assert(kk < m_pdata->getN() + m_pdata->getNGhosts());
 
-                            // access the position and type of neighbor k
-                            Scalar3 posk = make_scalar3(h_pos.data[kk].x,
-                                                        h_pos.data[kk].y,
-                                                        h_pos.data[kk].z);
+                            // access the type of neighbor k
                             unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
                             assert(typek < m_pdata->getNTypes());
 
@@ -822,14 +792,10 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
                                 // create variable for the force on k
                                 Scalar3 fk = make_scalar3(0.0, 0.0, 0.0);
 
-                                // compute dr_ik
-                                Scalar3 dxik = posi - posk;
-
-                                // apply periodic boundary conditions
-                                dxik = box.minImage(dxik);
-
-                                // compute rik_sq
-                                Scalar rik_sq = dot(dxik, dxik);
+                                // read dr_ik and rik_sq from the pair buffer
+                                const Scalar4 drik = h_pair_dr.data[head_i + k];
+                                Scalar3 dxik = make_scalar3(drik.x, drik.y, drik.z);
+                                Scalar rik_sq = drik.w;
 
                                 // compute the bond angle (if needed)
                                 Scalar cos_th = Scalar(0.0);
@@ -902,30 +868,30 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
 
                                 // increment the force for particle k
                                 unsigned int mem_idx = kk;
-                                h_force.data[mem_idx].x += fk.x;
-                                h_force.data[mem_idx].y += fk.y;
-                                h_force.data[mem_idx].z += fk.z;
+                                force[mem_idx].x += fk.x;
+                                force[mem_idx].y += fk.y;
+                                force[mem_idx].z += fk.z;
 
                                 if (compute_virial)
                                     {
                                     Scalar force_div2r_ij = Scalar(0.5) * force_divr_ij.z;
                                     Scalar force_div2r_ik = Scalar(0.5) * force_divr_ik.z;
-                                    h_virial.data[0 * m_virial_pitch + mem_idx]
+                                    virial[0 * virial_pitch + mem_idx]
                                         += force_div2r_ij * dxij.x * dxij.x
                                            + force_div2r_ik * dxik.x * dxik.x;
-                                    h_virial.data[1 * m_virial_pitch + mem_idx]
+                                    virial[1 * virial_pitch + mem_idx]
                                         += force_div2r_ij * dxij.x * dxij.y
                                            + force_div2r_ik * dxik.x * dxik.y;
-                                    h_virial.data[2 * m_virial_pitch + mem_idx]
+                                    virial[2 * virial_pitch + mem_idx]
                                         += force_div2r_ij * dxij.x * dxij.z
                                            + force_div2r_ik * dxik.x * dxik.z;
-                                    h_virial.data[3 * m_virial_pitch + mem_idx]
+                                    virial[3 * virial_pitch + mem_idx]
                                         += force_div2r_ij * dxij.y * dxij.y
                                            + force_div2r_ik * dxik.y * dxik.y;
-                                    h_virial.data[4 * m_virial_pitch + mem_idx]
+                                    virial[4 * virial_pitch + mem_idx]
                                         += force_div2r_ij * dxij.y * dxij.z
                                            + force_div2r_ik * dxik.y * dxik.z;
-                                    h_virial.data[5 * m_virial_pitch + mem_idx]
+                                    virial[5 * virial_pitch + mem_idx]
                                         += force_div2r_ij * dxij.z * dxij.z
                                            + force_div2r_ik * dxik.z * dxik.z;
                                     }
@@ -935,38 +901,63 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
                     }
                 // increment the force and potential energy for particle j
                 unsigned int mem_idx = jj;
-                h_force.data[mem_idx].x += fj.x;
-                h_force.data[mem_idx].y += fj.y;
-                h_force.data[mem_idx].z += fj.z;
-                h_force.data[mem_idx].w += pej;
+                force[mem_idx].x += fj.x;
+                force[mem_idx].y += fj.y;
+                force[mem_idx].z += fj.z;
+                force[mem_idx].w += pej;
 
                 if (compute_virial)
                     {
-                    h_virial.data[0 * m_virial_pitch + mem_idx] += virialj_xx;
-                    h_virial.data[1 * m_virial_pitch + mem_idx] += virialj_xy;
-                    h_virial.data[2 * m_virial_pitch + mem_idx] += virialj_xz;
-                    h_virial.data[3 * m_virial_pitch + mem_idx] += virialj_yy;
-                    h_virial.data[4 * m_virial_pitch + mem_idx] += virialj_yz;
-                    h_virial.data[5 * m_virial_pitch + mem_idx] += virialj_zz;
+                    virial[0 * virial_pitch + mem_idx] += virialj_xx;
+                    virial[1 * virial_pitch + mem_idx] += virialj_xy;
+                    virial[2 * virial_pitch + mem_idx] += virialj_xz;
+                    virial[3 * virial_pitch + mem_idx] += virialj_yy;
+                    virial[4 * virial_pitch + mem_idx] += virialj_yz;
+                    virial[5 * virial_pitch + mem_idx] += virialj_zz;
                     }
                 }
             // finally, increment the force and potential energy for particle i
             unsigned int mem_idx = i;
-            h_force.data[mem_idx].x += fi.x;
-            h_force.data[mem_idx].y += fi.y;
-            h_force.data[mem_idx].z += fi.z;
-            h_force.data[mem_idx].w += pei;
+            force[mem_idx].x += fi.x;
+            force[mem_idx].y += fi.y;
+            force[mem_idx].z += fi.z;
+            force[mem_idx].w += pei;
 
             if (compute_virial)
                 {
-                h_virial.data[0 * m_virial_pitch + mem_idx] += viriali_xx;
-                h_virial.data[1 * m_virial_pitch + mem_idx] += viriali_xy;
-                h_virial.data[2 * m_virial_pitch + mem_idx] += viriali_xz;
-                h_virial.data[3 * m_virial_pitch + mem_idx] += viriali_yy;
-                h_virial.data[4 * m_virial_pitch + mem_idx] += viriali_yz;
-                h_virial.data[5 * m_virial_pitch + mem_idx] += viriali_zz;
+                virial[0 * virial_pitch + mem_idx] += viriali_xx;
+                virial[1 * virial_pitch + mem_idx] += viriali_xy;
+                virial[2 * virial_pitch + mem_idx] += viriali_xz;
+                virial[3 * virial_pitch + mem_idx] += viriali_yy;
+                virial[4 * virial_pitch + mem_idx] += viriali_yz;
+                virial[5 * virial_pitch + mem_idx] += viriali_zz;
                 }
             }
+    };
+
+    // *****  check if we need the structure of the Tersoff or the RevCross potential for evaluation
+    const unsigned int N = m_pdata->getN() + m_pdata->getNGhosts();
+    if (evaluator::flag_for_RevCross)
+        {
+        detail::computeBondedForces(m_exec_conf,
+                                    m_pdata->getN(),
+                                    N,
+                                    compute_virial,
+                                    h_force.data,
+                                    h_virial.data,
+                                    m_virial_pitch,
+                                    compute_revcross_range);
+        }
+    else
+        {
+        detail::computeBondedForces(m_exec_conf,
+                                    m_pdata->getN(),
+                                    N,
+                                    compute_virial,
+                                    h_force.data,
+                                    h_virial.data,
+                                    m_virial_pitch,
+                                    compute_tersoff_range);
         }
     }
 
@@ -55,12 +55,13 @@ struct tersoff_args_t
                    const unsigned int _ntypes,
                    const unsigned int _block_size,
                    const unsigned int _tpp,
+                   const unsigned int _pair_cache_size,
                    const hipDeviceProp_t& _devprop)
         : d_force(_d_force), N(_N), Nghosts(_Nghosts), d_virial(_d_virial),
           virial_pitch(_virial_pitch), compute_virial(_compute_virial), d_pos(_d_pos), box(_box),
           d_n_neigh(_d_n_neigh), d_nlist(_d_nlist), d_head_list(_d_head_list), d_rcutsq(_d_rcutsq),
           size_nlist(_size_nlist), ntypes(_ntypes), block_size(_block_size), tpp(_tpp),
-          devprop(_devprop) {};
+          pair_cache_size(_pair_cache_size), devprop(_devprop) {};
 
     Scalar4* d_force;           //!< Force to write out
     const unsigned int N;       //!< Number of particles
@@ -79,6 +80,7 @@ struct tersoff_args_t
     const unsigned int ntypes;   //!< Number of particle types in the simulation
     const unsigned int block_size;  //!< Block size to execute
     const unsigned int tpp;         //!< Threads per particle
+    const unsigned int pair_cache_size; //!< Neighbors per particle cached in shared memory
     const hipDeviceProp_t& devprop; //!< CUDA device properties
     };
 
@@ -138,6 +140,50 @@ inline __device__ float myAtomicAdd(float* address, float val)
     }
 #endif
 
+//! Get the type of neighbor k from the pair cache or from global memory
+/*! \param neigh_idy Index of k in the neighbor list of i
+    \param cur_k Particle index of k
+    \param s_pair_type Cached neighbor types of particle i
+    \param pair_cache_size Number of neighbors of each particle in the cache
+    \param d_pos Positions of all the particles
+*/
+__device__ inline unsigned int tersoff_neighbor_type(unsigned int neigh_idy,
+                                                     unsigned int cur_k,
+                                                     const unsigned int* s_pair_type,
+                                                     const unsigned int pair_cache_size,
+                                                     const Scalar4* d_pos)
+    {
+    if (neigh_idy < pair_cache_size)
+        return s_pair_type[neigh_idy];
+
+    return __scalar_as_int(__ldg(d_pos + cur_k).w);
+    }
+
+//! Get dr_ik and rik_sq from the pair cache or compute them
+/*! \param neigh_idy Index of k in the neighbor list of i
+    \param cur_k Particle index of k
+    \param s_pair_dr Cached dr (x, y, z) and rsq (w) of the neighbors of particle i
+    \param pair_cache_size Number of neighbors of each particle in the cache
+    \param posi Position of particle i
+    \param d_pos Positions of all the particles
+    \param box Box dimensions used to implement periodic boundary conditions
+*/
+__device__ inline Scalar4 tersoff_neighbor_dr(unsigned int neigh_idy,
+                                              unsigned int cur_k,
+                                              const Scalar4* s_pair_dr,
+                                              const unsigned int pair_cache_size,
+                                              const Scalar3& posi,
+                                              const Scalar4* d_pos,
+                                              const BoxDim& box)
+    {
+    if (neigh_idy < pair_cache_size)
+        return s_pair_dr[neigh_idy];
+
+    Scalar4 postypek = __ldg(d_pos + cur_k);
+    Scalar3 dxik = box.minImage(posi - make_scalar3(postypek.x, postypek.y, postypek.z));
+    return make_scalar4(dxik.x, dxik.y, dxik.z, dot(dxik, dxik));
+    }
+
 //! Kernel for calculating the Tersoff forces
 /*! This kernel is called to calculate the forces on all N particles. Actual evaluation of the
    potentials and forces for each pair is handled via the template class \a evaluator.
@@ -153,6 +199,7 @@ inline __device__ float myAtomicAdd(float* address, float val)
     \param d_rcutsq rcut squared, stored per type pair
     \param d_ronsq ron squared, stored per type pair
     \param ntypes Number of types in the simulation
+    \param pair_cache_size Number of neighbors of each particle to cache in shared memory
 
     \a d_params, \a d_rcutsq, and \a d_ronsq must be indexed with an Index2DUpperTriangular(typei,
    typej) to access the unique value for that type pair. These values are all cached into shared
@@ -167,6 +214,10 @@ inline __device__ float myAtomicAdd(float* address, float val)
     Each block will calculate the forces on a block of particles.
     Each thread will calculate the total force on one particle.
     The neighborlist is arranged in columns so that reads are fully coalesced when doing this.
+
+    The loops over k need dr_ik of the same neighbors for every j. The threads of each particle
+    first compute dr and rsq of its first \a pair_cache_size neighbors into shared memory, and the
+    loops over k read them from there. Neighbors past the end of the cache are computed as needed.
 */
 template<class evaluator, unsigned char compute_virial, int tpp>
 __global__ void gpu_compute_triplet_forces_kernel(Scalar4* d_force,
@@ -180,18 +231,22 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4* d_force,
                                                   const size_t* d_head_list,
                                                   const typename evaluator::param_type* d_params,
                                                   const Scalar* d_rcutsq,
-                                                  const unsigned int ntypes)
+                                                  const unsigned int ntypes,
+                                                  const unsigned int pair_cache_size)
     {
     Index2D typpair_idx(ntypes);
     const unsigned int num_typ_parameters = typpair_idx.getNumElements();
 
-    // shared arrays for per type pair parameters
+    // shared arrays for the pair cache and the per type pair parameters
     HIP_DYNAMIC_SHARED(char, s_data)
-    typename evaluator::param_type* s_params = (typename evaluator::param_type*)(&s_data[0]);
-    Scalar* s_rcutsq
-        = (Scalar*)(&s_data[num_typ_parameters * sizeof(typename evaluator::param_type)]);
+    const unsigned int pair_cache_elements = (blockDim.x / tpp) * pair_cache_size;
+    Scalar4* s_pair_dr = (Scalar4*)(&s_data[0]);
+    typename evaluator::param_type* s_params
+        = (typename evaluator::param_type*)(s_pair_dr + pair_cache_elements);
+    Scalar* s_rcutsq = (Scalar*)(s_params + num_typ_parameters);
 
     Scalar* s_phi_ab = s_rcutsq + num_typ_parameters;
+    unsigned int* s_pair_type = (unsigned int*)(s_phi_ab + blockDim.x * ntypes);
 
     // load in the per type pair parameters
     for (unsigned int cur_offset = 0; cur_offset < num_typ_parameters; cur_offset += blockDim.x)
@@ -214,15 +269,40 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4* d_force,
     // start by identifying which particle we are to handle
     unsigned int idx = blockIdx.x * (blockDim.x / tpp) + threadIdx.x / tpp;
 
-    if (idx >= N)
-        return;
+    // the cached neighbors of this particle
+    s_pair_dr += (threadIdx.x / tpp) * pair_cache_size;
+    s_pair_type += (threadIdx.x / tpp) * pair_cache_size;
+
+    unsigned int n_neigh = 0;
+    Scalar4 postypei = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
+    Scalar3 posi = make_scalar3(Scalar(0.0), Scalar(0.0), Scalar(0.0));
 
-    // load in the length of the neighbor list (MEM_TRANSFER: 4 bytes)
-    unsigned int n_neigh = d_n_neigh[idx];
+    // fill the pair cache, all threads of the block reach the barrier
+    if (idx < N)
+        {
+        // load in the length of the neighbor list (MEM_TRANSFER: 4 bytes)
+        n_neigh = d_n_neigh[idx];
 
-    // read in the position of the particle
-    Scalar4 postypei = __ldg(d_pos + idx);
-    Scalar3 posi = make_scalar3(postypei.x, postypei.y, postypei.z);
+        // read in the position of the particle
+        postypei = __ldg(d_pos + idx);
+        posi = make_scalar3(postypei.x, postypei.y, postypei.z);
+
+        const size_t head_idx = d_head_list[idx];
+        const unsigned int n_cache = min(n_neigh, pair_cache_size);
+        for (unsigned int neigh_idx = threadIdx.x % tpp; neigh_idx < n_cache; neigh_idx += tpp)
+            {
+            unsigned int cur_k = __ldg(d_nlist + head_idx + neigh_idx);
+            Scalar4 postypek = __ldg(d_pos + cur_k);
+            Scalar3 dxik = box.minImage(posi - make_scalar3(postypek.x, postypek.y, postypek.z));
+            s_pair_dr[neigh_idx] = make_scalar4(dxik.x, dxik.y, dxik.z, dot(dxik, dxik));
+            s_pair_type[neigh_idx] = __scalar_as_int(postypek.w);
+            }
+        }
+
+    __syncthreads();
+
+    if (idx >= N)
+        return;
 
     // initialize the force to 0
     Scalar4 forcei = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
@@ -325,6 +405,7 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4* d_force,
                 // now evaluate the force from the ik interactions
                 unsigned int cur_k = 0;
                 unsigned int next_k(0);
+                next_k = __ldg(d_nlist + head_idx);
 
                 // loop over k neighbors one by one
                 for (int neigh_idy = 0; neigh_idy < n_neigh; neigh_idy++)
@@ -336,22 +417,26 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4* d_force,
                     // I continue only if k is not the same as j
                     if ((cur_k > cur_j) && (cur_j > idx))
                         {
-                        // get the position of neighbor k
-                        Scalar4 postypek = __ldg(d_pos + cur_k);
-                        Scalar3 posk = make_scalar3(postypek.x, postypek.y, postypek.z);
-
                         // get the type pair parameters for i and k
-                        typpair
-                            = typpair_idx(__scalar_as_int(postypei.w), __scalar_as_int(postypek.w));
+                        unsigned int typek = tersoff_neighbor_type(neigh_idy,
+                                                                   cur_k,
+                                                                   s_pair_type,
+                                                                   pair_cache_size,
+                                                                   d_pos);
+                        typpair = typpair_idx(__scalar_as_int(postypei.w), typek);
                         Scalar temp_rcutsq = s_rcutsq[typpair];
                         typename evaluator::param_type temp_param = s_params[typpair];
 
-                        // compute rik
-                        Scalar3 dxik = posi - posk;
-                        // apply the periodic boundary conditions
-                        dxik = box.minImage(dxik);
-                        // compute rik_sq
-                        Scalar rik_sq = dot(dxik, dxik);
+                        // get rik and rik_sq
+                        Scalar4 drik = tersoff_neighbor_dr(neigh_idy,
+                                                           cur_k,
+                                                           s_pair_dr,
+                                                           pair_cache_size,
+                                                           posi,
+                                                           d_pos,
+                                                           box);
+                        Scalar3 dxik = make_scalar3(drik.x, drik.y, drik.z);
+                        Scalar rik_sq = drik.w;
 
                         evaluator temp_eval(rij_sq, temp_rcutsq, temp_param);
                         temp_eval.setRik(rik_sq);
@@ -601,13 +686,13 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4* d_force,
                         cur_k = next_k;
                         next_k = __ldg(d_nlist + head_idx + neigh_idy + 1);
 
-                        // get the position of neighbor k
-                        Scalar4 postypek = __ldg(d_pos + cur_k);
-                        Scalar3 posk = make_scalar3(postypek.x, postypek.y, postypek.z);
-
                         // get the type pair parameters for i and k
-                        typpair
-                            = typpair_idx(__scalar_as_int(postypei.w), __scalar_as_int(postypek.w));
+                        unsigned int typek = tersoff_neighbor_type(neigh_idy,
+                                                                   cur_k,
+                                                                   s_pair_type,
+                                                                   pair_cache_size,
+                                                                   d_pos);
+                        typpair = typpair_idx(__scalar_as_int(postypei.w), typek);
                         Scalar temp_rcutsq = s_rcutsq[typpair];
                         typename evaluator::param_type& temp_param = s_params[typpair];
 
@@ -616,14 +701,16 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4* d_force,
 
                         if (cur_k != cur_j && temp_evaluated)
                             {
-                            // compute rik
-                            Scalar3 dxik = posi - posk;
-
-                            // apply the periodic boundary conditions
-                            dxik = box.minImage(dxik);
-
-                            // compute rik_sq
-                            Scalar rik_sq = dot(dxik, dxik);
+                            // get rik and rik_sq
+                            Scalar4 drik = tersoff_neighbor_dr(neigh_idy,
+                                                               cur_k,
+                                                               s_pair_dr,
+                                                               pair_cache_size,
+                                                               posi,
+                                                               d_pos,
+                                                               box);
+                            Scalar3 dxik = make_scalar3(drik.x, drik.y, drik.z);
+                            Scalar rik_sq = drik.w;
 
                             // compute the bond angle (if needed)
                             Scalar cos_th = Scalar(0.0);
@@ -701,13 +788,13 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4* d_force,
                         cur_k = next_k;
                         next_k = __ldg(d_nlist + head_idx + neigh_idy + 1);
 
-                        // get the position of neighbor k
-                        Scalar4 postypek = __ldg(d_pos + cur_k);
-                        Scalar3 posk = make_scalar3(postypek.x, postypek.y, postypek.z);
-
                         // get the type pair parameters for i and k
-                        typpair
-                            = typpair_idx(__scalar_as_int(postypei.w), __scalar_as_int(postypek.w));
+                        unsigned int typek = tersoff_neighbor_type(neigh_idy,
+                                                                   cur_k,
+                                                                   s_pair_type,
+                                                                   pair_cache_size,
+                                                                   d_pos);
+                        typpair = typpair_idx(__scalar_as_int(postypei.w), typek);
                         Scalar temp_rcutsq = s_rcutsq[typpair];
                         typename evaluator::param_type& temp_param = s_params[typpair];
 
@@ -719,14 +806,16 @@ __global__ void gpu_compute_triplet_forces_kernel(Scalar4* d_force,
                             Scalar4 forcek
                                 = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
 
-                            // compute rik
-                            Scalar3 dxik = posi - posk;
-
-                            // apply the periodic boundary conditions
-                            dxik = box.minImage(dxik);
-
-                            // compute rik_sq
-                            Scalar rik_sq = dot(dxik, dxik);
+                            // get rik and rik_sq
+                            Scalar4 drik = tersoff_neighbor_dr(neigh_idy,
+                                                               cur_k,
+                                                               s_pair_dr,
+                                                               pair_cache_size,
+                                                               posi,
+                                                               d_pos,
+                                                               box);
+                            Scalar3 dxik = make_scalar3(drik.x, drik.y, drik.z);
+                            Scalar rik_sq = drik.w;
 
                             // compute the bond angle (if needed)
                             Scalar cos_th = Scalar(0.0);
@@ -916,17 +1005,26 @@ template<class evaluator, unsigned int compute_virial, int tpp> struct TersoffCo
 
             // size shared bytes
             Index2D typpair_idx(pair_args.ntypes);
-            size_t shared_bytes = (sizeof(Scalar) + sizeof(typename evaluator::param_type))
-                                      * typpair_idx.getNumElements()
-                                  + pair_args.ntypes * run_block_size * sizeof(Scalar);
-
+            unsigned int pair_cache_size = pair_args.pair_cache_size;
+            auto get_shared_bytes = [&]()
+            {
+                return (sizeof(Scalar) + sizeof(typename evaluator::param_type))
+                           * typpair_idx.getNumElements()
+                       + pair_args.ntypes * run_block_size * sizeof(Scalar)
+                       + (run_block_size / tpp) * pair_cache_size
+                             * (sizeof(Scalar4) + sizeof(unsigned int));
+            };
+            size_t shared_bytes = get_shared_bytes();
+
+            // shrink the pair cache first, then the block
             while (shared_bytes + kernel_shared_bytes >= pair_args.devprop.sharedMemPerBlock)
                 {
-                run_block_size -= pair_args.devprop.warpSize;
+                if (pair_cache_size > 0)
+                    pair_cache_size /= 2;
+                else
+                    run_block_size -= pair_args.devprop.warpSize;
 
-                shared_bytes = (sizeof(Scalar) + sizeof(typename evaluator::param_type))
-                                   * typpair_idx.getNumElements()
-                               + pair_args.ntypes * run_block_size * sizeof(Scalar);
+                shared_bytes = get_shared_bytes();
                 }
 
             if (shared_bytes > pair_args.devprop.sharedMemPerBlock)
@@ -959,7 +1057,8 @@ template<class evaluator, unsigned int compute_virial, int tpp> struct TersoffCo
                                pair_args.d_head_list,
                                d_params,
                                pair_args.d_rcutsq,
-                               pair_args.ntypes);
+                               pair_args.ntypes,
+                               pair_cache_size);
             }
         else
             {
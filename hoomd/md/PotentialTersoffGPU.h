@@ -46,7 +46,8 @@ template<class evaluator> class PotentialTersoffGPU : public PotentialTersoff<ev
     virtual ~PotentialTersoffGPU();
 
     protected:
-    std::shared_ptr<Autotuner<2>> m_tuner; //!< Autotuner for block size
+    /// Autotuner for block size, threads per particle, and pair cache size
+    std::shared_ptr<Autotuner<3>> m_tuner;
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
@@ -68,9 +69,11 @@ PotentialTersoffGPU<evaluator>::PotentialTersoffGPU(std::shared_ptr<SystemDefini
         throw std::runtime_error("Error initializing PotentialTersoffGPU");
         }
 
-    // Initialize autotuner.
-    m_tuner.reset(new Autotuner<2>({AutotunerBase::makeBlockSizeRange(this->m_exec_conf),
-                                    AutotunerBase::getTppListPow2(this->m_exec_conf)},
+    // Initialize autotuner that tunes block sizes, threads per particle, and the number of
+    // neighbors per particle in the shared memory pair cache.
+    m_tuner.reset(new Autotuner<3>({AutotunerBase::makeBlockSizeRange(this->m_exec_conf),
+                                    AutotunerBase::getTppListPow2(this->m_exec_conf),
+                                    {0, 8, 16, 32}},
                                    this->m_exec_conf,
                                    "pair_tersoff"));
     this->m_autotuners.push_back(m_tuner);
@@ -129,6 +132,7 @@ template<class evaluator> void PotentialTersoffGPU<evaluator>::computeForces(uin
     auto param = m_tuner->getParam();
     unsigned int block_size = param[0];
     unsigned int threads_per_particle = param[1];
+    unsigned int pair_cache_size = param[2];
 
     kernel::gpu_compute_triplet_forces<evaluator>(
         kernel::tersoff_args_t(d_force.data,
@@ -147,6 +151,7 @@ template<class evaluator> void PotentialTersoffGPU<evaluator>::computeForces(uin
                                this->m_pdata->getNTypes(),
                                block_size,
                                threads_per_particle,
+                               pair_cache_size,
                                this->m_exec_conf->dev_prop),
         d_params.data);
 
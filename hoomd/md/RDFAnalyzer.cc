@@ -0,0 +1,325 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file RDFAnalyzer.cc
+    \brief Contains code for the RDFAnalyzer class
+*/
+
+#include "RDFAnalyzer.h"
+#include "hoomd/ParallelLoop.h"
+#include "hoomd/filter/ParticleFilterType.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/HOOMDMPI.h"
+#endif
+
+#include <string.h>
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System definition
+    \param trigger Steps on which to accumulate the histogram
+    \param nlist Neighbor list to read the pairs from
+    \param r_max Maximum pair distance
+    \param bins Number of bins in [0, r_max)
+    \param type_a Name of the first type, an empty string selects all types
+    \param type_b Name of the second type, an empty string selects all types
+*/
+RDFAnalyzer::RDFAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                         std::shared_ptr<Trigger> trigger,
+                         std::shared_ptr<NeighborList> nlist,
+                         Scalar r_max,
+                         unsigned int bins,
+                         const std::string& type_a,
+                         const std::string& type_b)
+    : Analyzer(sysdef, trigger), m_nlist(nlist), m_r_max(r_max), m_bins(bins), m_norm(0.0),
+      m_num_frames(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing RDFAnalyzer" << std::endl;
+
+    if (!(r_max > Scalar(0.0)))
+        {
+        throw std::runtime_error("r_max must be positive.");
+        }
+    if (bins == 0)
+        {
+        throw std::runtime_error("bins must be positive.");
+        }
+
+    m_type_a = getTypeFilter(type_a, m_group_a);
+    m_type_b = getTypeFilter(type_b, m_group_b);
+
+    GPUArray<unsigned long long> counts(m_bins, m_exec_conf);
+    m_counts.swap(counts);
+    reset();
+
+    // request r_max for the selected type pairs from the neighbor list
+    const unsigned int ntypes = m_pdata->getNTypes();
+    Index2D typpair_idx(ntypes);
+    m_r_cut_nlist
+        = std::make_shared<GlobalArray<Scalar>>(typpair_idx.getNumElements(), m_exec_conf);
+        {
+        ArrayHandle<Scalar> h_r_cut_nlist(*m_r_cut_nlist,
+                                          access_location::host,
+                                          access_mode::overwrite);
+        for (unsigned int typ1 = 0; typ1 < ntypes; typ1++)
+            {
+            for (unsigned int typ2 = 0; typ2 < ntypes; typ2++)
+                {
+                const bool selected
+                    = ((m_type_a == ALL_TYPES || typ1 == m_type_a)
+                       && (m_type_b == ALL_TYPES || typ2 == m_type_b))
+                      || ((m_type_a == ALL_TYPES || typ2 == m_type_a)
+                          && (m_type_b == ALL_TYPES || typ1 == m_type_b));
+                h_r_cut_nlist.data[typpair_idx(typ1, typ2)] = selected ? r_max : Scalar(0.0);
+                }
+            }
+        }
+    m_nlist->addRCutMatrix(m_r_cut_nlist);
+    }
+
+RDFAnalyzer::~RDFAnalyzer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying RDFAnalyzer" << std::endl;
+
+    if (m_attached)
+        {
+        m_nlist->removeRCutMatrix(m_r_cut_nlist);
+        }
+    }
+
+/*! \param name Name of the type
+    \param group Set to the group of the particles of the type, or null when \a name is empty
+    \returns The type id of \a name, or ALL_TYPES when \a name is empty
+*/
+unsigned int RDFAnalyzer::getTypeFilter(const std::string& name,
+                                        std::shared_ptr<ParticleGroup>& group)
+    {
+    if (name.empty())
+        {
+        return ALL_TYPES;
+        }
+
+    const unsigned int type = m_pdata->getTypeByName(name);
+    group = std::make_shared<ParticleGroup>(
+        m_sysdef,
+        std::make_shared<ParticleFilterType>(std::unordered_set<std::string> {name}));
+    return type;
+    }
+
+void RDFAnalyzer::reset()
+    {
+    ArrayHandle<unsigned long long> h_counts(m_counts,
+                                             access_location::host,
+                                             access_mode::overwrite);
+    memset(h_counts.data, 0, sizeof(unsigned long long) * m_bins);
+    m_norm = 0.0;
+    m_num_frames = 0;
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void RDFAnalyzer::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    m_nlist->compute(timestep);
+    countPairs();
+
+    // count the members of both sets
+    const double n_a = m_group_a ? m_group_a->getNumMembersGlobal() : m_pdata->getNGlobal();
+    const double n_b = m_group_b ? m_group_b->getNumMembersGlobal() : m_pdata->getNGlobal();
+    double n_ab = 0.0;
+    if (m_type_a == ALL_TYPES)
+        n_ab = n_b;
+    else if (m_type_b == ALL_TYPES || m_type_b == m_type_a)
+        n_ab = n_a;
+
+    const double volume = m_pdata->getGlobalBox().getVolume(m_sysdef->getNDimensions() == 2);
+    m_norm += (n_a * n_b - n_ab) / volume;
+    m_num_frames++;
+    }
+
+void RDFAnalyzer::countPairs()
+    {
+    const bool third_law = m_nlist->getStorageMode() == NeighborList::half;
+    const bool compressed = m_nlist->isCompressed();
+    const unsigned int N = m_pdata->getN();
+    const BoxDim box = m_pdata->getBox();
+    const Scalar r_max_sq = m_r_max * m_r_max;
+    const Scalar bin_scale = Scalar(m_bins) / m_r_max;
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListStorage(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<size_t> h_head_list(m_nlist->getHeadList(),
+                                    access_location::host,
+                                    access_mode::read);
+
+    struct Histogram
+        {
+        std::vector<unsigned long long> counts; //!< Number of pairs in each bin
+
+        Histogram& operator+=(const Histogram& other)
+            {
+            if (counts.size() < other.counts.size())
+                {
+                counts.resize(other.counts.size(), 0);
+                }
+            for (size_t k = 0; k < other.counts.size(); k++)
+                {
+                counts[k] += other.counts[k];
+                }
+            return *this;
+            }
+        };
+
+    auto count_range = [&](unsigned int first, unsigned int last, Histogram& hist)
+    {
+        hist.counts.resize(m_bins, 0);
+        for (unsigned int i = first; i < last; i++)
+            {
+            const Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            const unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            const bool i_in_a = m_type_a == ALL_TYPES || typei == m_type_a;
+            const bool i_in_b = m_type_b == ALL_TYPES || typei == m_type_b;
+
+            size_t offset = h_head_list.data[i];
+            const unsigned int size = h_n_neigh.data[i];
+            unsigned int j = 0;
+            for (unsigned int k = 0; k < size; k++)
+                {
+                j = detail::nextNeighbor(h_nlist.data, compressed, offset, j);
+                const unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+
+                // count (i, j), and (j, i) when the half list stores the pair only once
+                unsigned int weight = i_in_a && (m_type_b == ALL_TYPES || typej == m_type_b);
+                if (third_law && j < N)
+                    {
+                    weight += i_in_b && (m_type_a == ALL_TYPES || typej == m_type_a);
+                    }
+                if (!weight)
+                    continue;
+
+                const Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                const Scalar3 dx = box.minImage(pi - pj);
+                const Scalar rsq = dot(dx, dx);
+                if (rsq >= r_max_sq)
+                    continue;
+
+                const unsigned int bin
+                    = std::min((unsigned int)(fast::sqrt(rsq) * bin_scale), m_bins - 1);
+                hist.counts[bin] += weight;
+                }
+            }
+    };
+
+    Histogram sum;
+    sum.counts.resize(m_bins, 0);
+    hoomd::detail::parallel_accumulate(*m_exec_conf, N, sum, count_range);
+
+    ArrayHandle<unsigned long long> h_counts(m_counts,
+                                             access_location::host,
+                                             access_mode::readwrite);
+    for (unsigned int bin = 0; bin < m_bins; bin++)
+        {
+        h_counts.data[bin] += sum.counts[bin];
+        }
+    }
+
+/*! \returns The pair counts summed over the ranks on the root rank
+ */
+std::vector<unsigned long long> RDFAnalyzer::reduceCounts()
+    {
+    std::vector<unsigned long long> counts(m_bins);
+    ArrayHandle<unsigned long long> h_counts(m_counts, access_location::host, access_mode::read);
+    std::copy(h_counts.data, h_counts.data + m_bins, counts.begin());
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        std::vector<unsigned long long> counts_local(counts);
+        MPI_Reduce(counts_local.data(),
+                   counts.data(),
+                   m_bins,
+                   MPI_UNSIGNED_LONG_LONG,
+                   MPI_SUM,
+                   0,
+                   m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    return counts;
+    }
+
+/*! \returns The number of pairs in each bin on the root rank and None on other ranks
+ */
+pybind11::object RDFAnalyzer::getCounts()
+    {
+    std::vector<unsigned long long> counts = reduceCounts();
+
+#ifdef ENABLE_MPI
+    if (!m_exec_conf->isRoot())
+        return pybind11::none();
+#endif
+
+    return pybind11::array_t<unsigned long long>(counts.size(), counts.data());
+    }
+
+/*! \returns g(r) in each bin on the root rank and None on other ranks
+
+    g(r) is 0 before the first frame.
+*/
+pybind11::object RDFAnalyzer::getRDF()
+    {
+    std::vector<unsigned long long> counts = reduceCounts();
+
+#ifdef ENABLE_MPI
+    if (!m_exec_conf->isRoot())
+        return pybind11::none();
+#endif
+
+    const bool twod = m_sysdef->getNDimensions() == 2;
+    const double dr = double(m_r_max) / double(m_bins);
+    std::vector<double> rdf(m_bins, 0.0);
+    for (unsigned int bin = 0; bin < m_bins && m_norm > 0.0; bin++)
+        {
+        const double r1 = bin * dr;
+        const double r2 = (bin + 1) * dr;
+        const double shell = twod ? M_PI * (r2 * r2 - r1 * r1)
+                                  : 4.0 / 3.0 * M_PI * (r2 * r2 * r2 - r1 * r1 * r1);
+        rdf[bin] = double(counts[bin]) / (m_norm * shell);
+        }
+
+    return pybind11::array_t<double>(rdf.size(), rdf.data());
+    }
+
+namespace detail
+    {
+void export_RDFAnalyzer(pybind11::module& m)
+    {
+    pybind11::class_<RDFAnalyzer, Analyzer, std::shared_ptr<RDFAnalyzer>>(m, "RDFAnalyzer")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            std::shared_ptr<NeighborList>,
+                            Scalar,
+                            unsigned int,
+                            const std::string&,
+                            const std::string&>())
+        .def("getRDF", &RDFAnalyzer::getRDF)
+        .def("getCounts", &RDFAnalyzer::getCounts)
+        .def("reset", &RDFAnalyzer::reset)
+        .def_property_readonly("num_frames", &RDFAnalyzer::getNumFrames)
+        .def_property_readonly("r_max", &RDFAnalyzer::getRMax)
+        .def_property_readonly("bins", &RDFAnalyzer::getBins);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
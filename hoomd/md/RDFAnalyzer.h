@@ -0,0 +1,128 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "NeighborList.h"
+#include "hoomd/Analyzer.h"
+#include "hoomd/GPUArray.h"
+#include "hoomd/ParticleGroup.h"
+
+/*! \file RDFAnalyzer.h
+    \brief Declares a class that accumulates the radial distribution function
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#ifndef __RDF_ANALYZER_H__
+#define __RDF_ANALYZER_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Accumulates the radial distribution function from the neighbor list
+/*! RDFAnalyzer histograms the distances of the pairs of particles (a, b) in the neighbor list,
+    where a has type \a type_a and b has type \a type_b, on every call to analyze(). The counts
+    accumulate over the calls until reset(). The analyzer registers an r_cut matrix with the
+    neighbor list so that the list includes all pairs of the selected types within \a r_max.
+    Pairs excluded from the neighbor list are not counted.
+
+    Each call adds (N_a N_b - N_ab) / V to the normalization, where N_ab is the number of particles
+    in both sets. The histogram is therefore normalized by the number of pairs and the average
+    pair density of the sampled frames when getRDF() converts the counts to g(r).
+
+    Both storage modes of the neighbor list are supported. In the half mode, each local pair in
+    the list is counted in both directions.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT RDFAnalyzer : public Analyzer
+    {
+    public:
+    //! Type filter value that selects all particle types
+    static const unsigned int ALL_TYPES = 0xffffffff;
+
+    //! Constructs the analyzer
+    RDFAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                std::shared_ptr<Trigger> trigger,
+                std::shared_ptr<NeighborList> nlist,
+                Scalar r_max,
+                unsigned int bins,
+                const std::string& type_a,
+                const std::string& type_b);
+
+    //! Destructor
+    virtual ~RDFAnalyzer();
+
+    //! Add the pairs of the current configuration to the histogram
+    virtual void analyze(uint64_t timestep);
+
+    //! Get the radial distribution function
+    pybind11::object getRDF();
+
+    //! Get the raw pair counts of each bin
+    pybind11::object getCounts();
+
+    //! Clear the accumulated histogram
+    void reset();
+
+    //! Get the number of accumulated frames
+    uint64_t getNumFrames()
+        {
+        return m_num_frames;
+        }
+
+    //! Get the maximum pair distance
+    Scalar getRMax()
+        {
+        return m_r_max;
+        }
+
+    //! Get the number of bins
+    unsigned int getBins()
+        {
+        return m_bins;
+        }
+
+    /// Remove the r_cut matrix from the neighbor list when detached from the simulation
+    virtual void notifyDetach()
+        {
+        if (m_attached)
+            {
+            m_nlist->removeRCutMatrix(m_r_cut_nlist);
+            }
+        m_attached = false;
+        }
+
+    protected:
+    std::shared_ptr<NeighborList> m_nlist;              //!< The neighbor list to read pairs from
+    std::shared_ptr<GlobalArray<Scalar>> m_r_cut_nlist; //!< r_cut matrix passed to the nlist
+    Scalar m_r_max;                                     //!< Maximum pair distance
+    unsigned int m_bins;                                //!< Number of bins
+    unsigned int m_type_a;                              //!< First type, or ALL_TYPES
+    unsigned int m_type_b;                              //!< Second type, or ALL_TYPES
+    std::shared_ptr<ParticleGroup> m_group_a;           //!< Particles of the first type
+    std::shared_ptr<ParticleGroup> m_group_b;           //!< Particles of the second type
+    GPUArray<unsigned long long> m_counts;              //!< Rank local pair counts per bin
+    double m_norm;                                      //!< Sum of the pair densities
+    uint64_t m_num_frames;                              //!< Number of accumulated frames
+    bool m_attached = true;                             //!< True when attached to a simulation
+
+    //! Add the pairs in the neighbor list to m_counts
+    virtual void countPairs();
+
+    //! Get the type id and the group of a type name, or ALL_TYPES for an empty name
+    unsigned int getTypeFilter(const std::string& name, std::shared_ptr<ParticleGroup>& group);
+
+    //! Get the histogram summed over all ranks, only valid on the root rank
+    std::vector<unsigned long long> reduceCounts();
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
@@ -0,0 +1,100 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "RDFAnalyzerGPU.h"
+#include "RDFAnalyzerGPU.cuh"
+
+/*! \file RDFAnalyzerGPU.cc
+    \brief Contains code for the RDFAnalyzerGPU class
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System definition
+    \param trigger Steps on which to accumulate the histogram
+    \param nlist Neighbor list to read the pairs from
+    \param r_max Maximum pair distance
+    \param bins Number of bins in [0, r_max)
+    \param type_a Name of the first type, an empty string selects all types
+    \param type_b Name of the second type, an empty string selects all types
+*/
+RDFAnalyzerGPU::RDFAnalyzerGPU(std::shared_ptr<SystemDefinition> sysdef,
+                               std::shared_ptr<Trigger> trigger,
+                               std::shared_ptr<NeighborList> nlist,
+                               Scalar r_max,
+                               unsigned int bins,
+                               const std::string& type_a,
+                               const std::string& type_b)
+    : RDFAnalyzer(sysdef, trigger, nlist, r_max, bins, type_a, type_b)
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        throw std::runtime_error("Error initializing RDFAnalyzerGPU: no GPU available.");
+        }
+
+    m_tuner.reset(new Autotuner<1>({AutotunerBase::makeBlockSizeRange(m_exec_conf)},
+                                   m_exec_conf,
+                                   "rdf_analyzer"));
+    m_autotuners.push_back(m_tuner);
+    }
+
+void RDFAnalyzerGPU::countPairs()
+    {
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_n_neigh(m_nlist->getNNeighArray(),
+                                        access_location::device,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> d_nlist(m_nlist->getNListArray(),
+                                      access_location::device,
+                                      access_mode::read);
+    ArrayHandle<size_t> d_head_list(m_nlist->getHeadList(),
+                                    access_location::device,
+                                    access_mode::read);
+    ArrayHandle<unsigned long long> d_counts(m_counts,
+                                             access_location::device,
+                                             access_mode::readwrite);
+
+    const bool use_shared
+        = m_bins * sizeof(unsigned int) <= (size_t)m_exec_conf->dev_prop.sharedMemPerBlock;
+
+    m_tuner->begin();
+    kernel::gpu_rdf_count_pairs(d_counts.data,
+                                d_pos.data,
+                                m_pdata->getBox(),
+                                d_n_neigh.data,
+                                d_nlist.data,
+                                d_head_list.data,
+                                m_pdata->getN(),
+                                m_nlist->getStorageMode() == NeighborList::half,
+                                m_r_max,
+                                m_bins,
+                                m_type_a,
+                                m_type_b,
+                                m_tuner->getParam()[0],
+                                use_shared);
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner->end();
+    }
+
+namespace detail
+    {
+void export_RDFAnalyzerGPU(pybind11::module& m)
+    {
+    pybind11::class_<RDFAnalyzerGPU, RDFAnalyzer, std::shared_ptr<RDFAnalyzerGPU>>(
+        m,
+        "RDFAnalyzerGPU")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            std::shared_ptr<NeighborList>,
+                            Scalar,
+                            unsigned int,
+                            const std::string&,
+                            const std::string&>());
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,180 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "RDFAnalyzerGPU.cuh"
+
+/*! \file RDFAnalyzerGPU.cu
+    \brief Defines GPU kernel code for accumulating the radial distribution function. Used by
+   RDFAnalyzerGPU.
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Test if a type is in a type filter
+__device__ inline bool rdf_type_in(unsigned int type, unsigned int filter)
+    {
+    return filter == 0xffffffff || type == filter;
+    }
+
+//! Kernel that adds the pairs in the neighbor list to the histogram
+/*! \param d_counts Pair counts in each bin
+    \param d_pos Particle positions and types, including ghosts
+    \param box Local box
+    \param d_n_neigh Number of neighbors of each particle
+    \param d_nlist Neighbor list
+    \param d_head_list Indexes for reading \a d_nlist
+    \param N Number of local particles
+    \param third_law True when the neighbor list stores each local pair once
+    \param r_max Maximum pair distance
+    \param bins Number of bins
+    \param type_a First type, or 0xffffffff for all types
+    \param type_b Second type, or 0xffffffff for all types
+
+    Each thread processes the neighbors of one particle. With \a use_shared, the threads of a
+    block count the pairs in a histogram in shared memory that is added to \a d_counts at the end
+    of the kernel, which limits the number of atomic operations in global memory.
+*/
+template<bool use_shared>
+__global__ void gpu_rdf_count_pairs_kernel(unsigned long long* d_counts,
+                                           const Scalar4* d_pos,
+                                           const BoxDim box,
+                                           const unsigned int* d_n_neigh,
+                                           const unsigned int* d_nlist,
+                                           const size_t* d_head_list,
+                                           const unsigned int N,
+                                           const bool third_law,
+                                           const Scalar r_max,
+                                           const unsigned int bins,
+                                           const unsigned int type_a,
+                                           const unsigned int type_b)
+    {
+    HIP_DYNAMIC_SHARED(unsigned int, s_counts)
+
+    if (use_shared)
+        {
+        for (unsigned int bin = threadIdx.x; bin < bins; bin += blockDim.x)
+            s_counts[bin] = 0;
+        __syncthreads();
+        }
+
+    const unsigned int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i < N)
+        {
+        const Scalar4 postypei = d_pos[i];
+        const Scalar3 pi = make_scalar3(postypei.x, postypei.y, postypei.z);
+        const unsigned int typei = __scalar_as_int(postypei.w);
+        const bool i_in_a = rdf_type_in(typei, type_a);
+        const bool i_in_b = rdf_type_in(typei, type_b);
+        const Scalar r_max_sq = r_max * r_max;
+        const Scalar bin_scale = Scalar(bins) / r_max;
+
+        const size_t head = d_head_list[i];
+        const unsigned int n_neigh = d_n_neigh[i];
+        for (unsigned int k = 0; k < n_neigh; k++)
+            {
+            const unsigned int j = d_nlist[head + k];
+            const Scalar4 postypej = d_pos[j];
+            const unsigned int typej = __scalar_as_int(postypej.w);
+
+            // count (i, j), and (j, i) when the half list stores the pair only once
+            unsigned int weight = i_in_a && rdf_type_in(typej, type_b);
+            if (third_law && j < N)
+                weight += i_in_b && rdf_type_in(typej, type_a);
+            if (!weight)
+                continue;
+
+            const Scalar3 dx
+                = box.minImage(pi - make_scalar3(postypej.x, postypej.y, postypej.z));
+            const Scalar rsq = dot(dx, dx);
+            if (rsq >= r_max_sq)
+                continue;
+
+            const unsigned int bin = min((unsigned int)(fast::sqrt(rsq) * bin_scale), bins - 1);
+            if (use_shared)
+                atomicAdd(&s_counts[bin], weight);
+            else
+                atomicAdd(&d_counts[bin], (unsigned long long)weight);
+            }
+        }
+
+    if (use_shared)
+        {
+        __syncthreads();
+        for (unsigned int bin = threadIdx.x; bin < bins; bin += blockDim.x)
+            {
+            if (s_counts[bin])
+                atomicAdd(&d_counts[bin], (unsigned long long)s_counts[bin]);
+            }
+        }
+    }
+
+/*! \param d_counts Pair counts in each bin, the pairs are added to the existing counts
+    \param d_pos Particle positions and types, including ghosts
+    \param box Local box
+    \param d_n_neigh Number of neighbors of each particle
+    \param d_nlist Neighbor list
+    \param d_head_list Indexes for reading \a d_nlist
+    \param N Number of local particles
+    \param third_law True when the neighbor list stores each local pair once
+    \param r_max Maximum pair distance
+    \param bins Number of bins
+    \param type_a First type, or 0xffffffff for all types
+    \param type_b Second type, or 0xffffffff for all types
+    \param block_size Number of threads per block
+    \param use_shared Count in shared memory, requires bins * sizeof(unsigned int) bytes
+*/
+hipError_t gpu_rdf_count_pairs(unsigned long long* d_counts,
+                               const Scalar4* d_pos,
+                               const BoxDim& box,
+                               const unsigned int* d_n_neigh,
+                               const unsigned int* d_nlist,
+                               const size_t* d_head_list,
+                               const unsigned int N,
+                               const bool third_law,
+                               const Scalar r_max,
+                               const unsigned int bins,
+                               const unsigned int type_a,
+                               const unsigned int type_b,
+                               const unsigned int block_size,
+                               const bool use_shared)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    auto func = use_shared ? &gpu_rdf_count_pairs_kernel<true> : &gpu_rdf_count_pairs_kernel<false>;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(func));
+    max_block_size = attr.maxThreadsPerBlock;
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    const size_t shared_bytes = use_shared ? bins * sizeof(unsigned int) : 0;
+    hipLaunchKernelGGL(func,
+                       dim3(N / run_block_size + 1),
+                       dim3(run_block_size),
+                       shared_bytes,
+                       0,
+                       d_counts,
+                       d_pos,
+                       box,
+                       d_n_neigh,
+                       d_nlist,
+                       d_head_list,
+                       N,
+                       third_law,
+                       r_max,
+                       bins,
+                       type_a,
+                       type_b);
+
+    return hipSuccess;
+    }
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
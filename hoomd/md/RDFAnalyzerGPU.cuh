@@ -0,0 +1,42 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "hip/hip_runtime.h"
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+
+/*! \file RDFAnalyzerGPU.cuh
+    \brief Declares GPU kernel code for accumulating the radial distribution function. Used by
+   RDFAnalyzerGPU.
+*/
+
+#ifndef __RDF_ANALYZER_GPU_CUH__
+#define __RDF_ANALYZER_GPU_CUH__
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Add the pairs in the neighbor list to the histogram
+hipError_t gpu_rdf_count_pairs(unsigned long long* d_counts,
+                               const Scalar4* d_pos,
+                               const BoxDim& box,
+                               const unsigned int* d_n_neigh,
+                               const unsigned int* d_nlist,
+                               const size_t* d_head_list,
+                               const unsigned int N,
+                               const bool third_law,
+                               const Scalar r_max,
+                               const unsigned int bins,
+                               const unsigned int type_a,
+                               const unsigned int type_b,
+                               const unsigned int block_size,
+                               const bool use_shared);
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
@@ -0,0 +1,51 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "RDFAnalyzer.h"
+#include "hoomd/Autotuner.h"
+
+/*! \file RDFAnalyzerGPU.h
+    \brief Declares a class that accumulates the radial distribution function on the GPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __RDF_ANALYZER_GPU_H__
+#define __RDF_ANALYZER_GPU_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Accumulates the radial distribution function from the neighbor list on the GPU
+/*! The histogram stays on the device between frames. Blocks count the pairs in shared memory
+    when the histogram fits.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT RDFAnalyzerGPU : public RDFAnalyzer
+    {
+    public:
+    //! Constructs the analyzer
+    RDFAnalyzerGPU(std::shared_ptr<SystemDefinition> sysdef,
+                   std::shared_ptr<Trigger> trigger,
+                   std::shared_ptr<NeighborList> nlist,
+                   Scalar r_max,
+                   unsigned int bins,
+                   const std::string& type_a,
+                   const std::string& type_b);
+
+    protected:
+    std::shared_ptr<Autotuner<1>> m_tuner; //!< Autotuner for block size
+
+    //! Add the pairs in the neighbor list to m_counts
+    virtual void countPairs();
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+#endif
@@ -0,0 +1,241 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file ReplicaExchangeUpdater.cc
+    \brief Defines the ReplicaExchangeUpdater class
+*/
+
+#include "ReplicaExchangeUpdater.h"
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
+
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System definition
+    \param trigger Steps on which to attempt exchanges
+    \param thermo Compute that provides the potential energy
+    \param kT Variant that holds the temperature of the local replica
+    \param kT_ladder Temperature at each ladder position, one per partition
+*/
+ReplicaExchangeUpdater::ReplicaExchangeUpdater(std::shared_ptr<SystemDefinition> sysdef,
+                                               std::shared_ptr<Trigger> trigger,
+                                               std::shared_ptr<ComputeThermo> thermo,
+                                               std::shared_ptr<VariantConstant> kT,
+                                               pybind11::list kT_ladder)
+    : Updater(sysdef, trigger), m_thermo(thermo), m_kT(kT), m_n_rounds(0)
+    {
+    assert(m_thermo);
+    assert(m_kT);
+    m_exec_conf->msg->notice(5) << "Constructing ReplicaExchangeUpdater" << endl;
+
+    for (auto item : kT_ladder)
+        {
+        Scalar value = item.cast<Scalar>();
+        if (!(value > Scalar(0.0)))
+            {
+            throw std::runtime_error("Replica exchange temperatures must be positive.");
+            }
+        m_ladder.push_back(value);
+        }
+
+    std::shared_ptr<MPIConfiguration> mpi_config = m_exec_conf->getMPIConfig();
+    const unsigned int n_partitions = mpi_config->getNPartitions();
+    if (m_ladder.size() != n_partitions)
+        {
+        throw std::runtime_error("Replica exchange needs one temperature per partition: "
+                                 + std::to_string(m_ladder.size()) + " temperatures given for "
+                                 + std::to_string(n_partitions) + " partitions.");
+        }
+
+    // replica i starts at ladder position i
+    m_partition = mpi_config->getPartition();
+    m_ladder_index.resize(n_partitions);
+    for (unsigned int i = 0; i < n_partitions; i++)
+        {
+        m_ladder_index[i] = i;
+        }
+    m_attempted.resize(n_partitions - 1, 0);
+    m_accepted.resize(n_partitions - 1, 0);
+
+    m_kT->setValue(m_ladder[m_partition]);
+
+#ifdef ENABLE_MPI
+    // rank r of every partition exchanges with rank r of the other partitions
+    MPI_Comm_split(mpi_config->getHOOMDWorldCommunicator(),
+                   mpi_config->getRank(),
+                   m_partition,
+                   &m_exchange_comm);
+#endif
+    }
+
+ReplicaExchangeUpdater::~ReplicaExchangeUpdater()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying ReplicaExchangeUpdater" << endl;
+
+#ifdef ENABLE_MPI
+    MPI_Comm_free(&m_exchange_comm);
+#endif
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    Every rank calls update() on the same steps, so every exchange round is collective over the
+    HOOMD world communicator.
+*/
+void ReplicaExchangeUpdater::update(uint64_t timestep)
+    {
+    Updater::update(timestep);
+    const unsigned int n_partitions = (unsigned int)m_ladder.size();
+    if (n_partitions < 2)
+        {
+        return;
+        }
+
+    // all ranks of a partition hold the reduced energy of their replica
+    m_thermo->compute(timestep);
+    double local[2] = {double(m_thermo->getPotentialEnergy()), double(m_sysdef->getSeed())};
+
+    std::vector<double> gathered(2 * n_partitions);
+    gathered[2 * m_partition] = local[0];
+    gathered[2 * m_partition + 1] = local[1];
+#ifdef ENABLE_MPI
+    MPI_Allgather(local, 2, MPI_DOUBLE, gathered.data(), 2, MPI_DOUBLE, m_exchange_comm);
+#endif
+
+    // partition that holds each ladder position
+    std::vector<unsigned int> replica_at(n_partitions);
+    for (unsigned int i = 0; i < n_partitions; i++)
+        {
+        replica_at[m_ladder_index[i]] = i;
+        }
+
+    const uint16_t seed = uint16_t(gathered[1]);
+    const Scalar kT_old = m_ladder[m_ladder_index[m_partition]];
+
+    for (unsigned int k = (unsigned int)(m_n_rounds % 2); k + 1 < n_partitions; k += 2)
+        {
+        const unsigned int i = replica_at[k];
+        const unsigned int j = replica_at[k + 1];
+        const double delta = (1.0 / m_ladder[k] - 1.0 / m_ladder[k + 1])
+                             * (gathered[2 * i] - gathered[2 * j]);
+
+        bool accept = delta >= 0.0;
+        if (!accept)
+            {
+            hoomd::RandomGenerator rng(
+                hoomd::Seed(hoomd::RNGIdentifier::ReplicaExchange, timestep, seed),
+                hoomd::Counter(k));
+            accept = hoomd::UniformDistribution<double>(0.0, 1.0)(rng) < exp(delta);
+            }
+
+        m_attempted[k]++;
+        if (accept)
+            {
+            m_accepted[k]++;
+            std::swap(m_ladder_index[i], m_ladder_index[j]);
+            }
+        }
+    m_n_rounds++;
+
+    const Scalar kT_new = m_ladder[m_ladder_index[m_partition]];
+    if (kT_new != kT_old)
+        {
+        rescaleMomenta(slow::sqrt(kT_new / kT_old));
+        m_kT->setValue(kT_new);
+        }
+    }
+
+/*! \param factor Factor to multiply the momenta by
+ */
+void ReplicaExchangeUpdater::rescaleMomenta(Scalar factor)
+    {
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                               access_location::host,
+                               access_mode::readwrite);
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
+                                  access_location::host,
+                                  access_mode::readwrite);
+
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        {
+        h_vel.data[i].x *= factor;
+        h_vel.data[i].y *= factor;
+        h_vel.data[i].z *= factor;
+
+        h_angmom.data[i].x *= factor;
+        h_angmom.data[i].y *= factor;
+        h_angmom.data[i].z *= factor;
+        h_angmom.data[i].w *= factor;
+        }
+    }
+
+pybind11::list ReplicaExchangeUpdater::getLadder() const
+    {
+    pybind11::list result;
+    for (Scalar kT : m_ladder)
+        {
+        result.append(kT);
+        }
+    return result;
+    }
+
+pybind11::list ReplicaExchangeUpdater::getLadderIndices() const
+    {
+    pybind11::list result;
+    for (unsigned int index : m_ladder_index)
+        {
+        result.append(index);
+        }
+    return result;
+    }
+
+pybind11::list ReplicaExchangeUpdater::getAttempted() const
+    {
+    pybind11::list result;
+    for (uint64_t n : m_attempted)
+        {
+        result.append(n);
+        }
+    return result;
+    }
+
+pybind11::list ReplicaExchangeUpdater::getAccepted() const
+    {
+    pybind11::list result;
+    for (uint64_t n : m_accepted)
+        {
+        result.append(n);
+        }
+    return result;
+    }
+
+namespace detail
+    {
+void export_ReplicaExchangeUpdater(pybind11::module& m)
+    {
+    pybind11::class_<ReplicaExchangeUpdater, Updater, std::shared_ptr<ReplicaExchangeUpdater>>(
+        m,
+        "ReplicaExchangeUpdater")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            std::shared_ptr<ComputeThermo>,
+                            std::shared_ptr<VariantConstant>,
+                            pybind11::list>())
+        .def_property_readonly("kT_ladder", &ReplicaExchangeUpdater::getLadder)
+        .def_property_readonly("ladder_index", &ReplicaExchangeUpdater::getLadderIndex)
+        .def_property_readonly("ladder_indices", &ReplicaExchangeUpdater::getLadderIndices)
+        .def_property_readonly("num_attempted", &ReplicaExchangeUpdater::getAttempted)
+        .def_property_readonly("num_accepted", &ReplicaExchangeUpdater::getAccepted);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
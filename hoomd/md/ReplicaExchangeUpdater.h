@@ -0,0 +1,105 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file ReplicaExchangeUpdater.h
+    \brief Declares an updater that exchanges temperatures between partitions
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "ComputeThermo.h"
+#include "hoomd/Updater.h"
+#include "hoomd/Variant.h"
+
+#include <memory>
+#include <pybind11/pybind11.h>
+#include <vector>
+
+#pragma once
+
+namespace hoomd
+    {
+namespace md
+    {
+/// Exchanges temperatures between the partitions of a parallel tempering simulation
+/** Each partition of the MPI world runs one replica of the system at one temperature of the
+ * ladder. When triggered, ReplicaExchangeUpdater attempts to exchange the temperatures of replicas
+ * at neighboring ladder positions. Exchanges alternate between the pairs (0, 1), (2, 3), ... and
+ * the pairs (1, 2), (3, 4), ....
+ *
+ * The replicas exchange temperatures, not configurations. Each rank sends its potential energy in
+ * a single MPI_Allgather over the ranks with the same rank in every partition, so every rank holds
+ * the energies of all replicas and evaluates the same acceptance test:
+ *
+ * \f$ P = \min(1, \exp[(\beta_k - \beta_{k+1})(U_i - U_j)]) \f$
+ *
+ * where replica i is at position k and replica j at position k+1. All ranks draw the random number
+ * from the same seed, the seed of partition 0, so they agree on the outcome without further
+ * messages.
+ *
+ * The updater sets the value of a VariantConstant to the temperature of the local replica. The
+ * thermostat reads the temperature from this variant. After an exchange, the updater rescales the
+ * velocities and angular momenta by \f$ \sqrt{kT_\mathrm{new} / kT_\mathrm{old}} \f$.
+ */
+class PYBIND11_EXPORT ReplicaExchangeUpdater : public Updater
+    {
+    public:
+    /// Constructor
+    ReplicaExchangeUpdater(std::shared_ptr<SystemDefinition> sysdef,
+                           std::shared_ptr<Trigger> trigger,
+                           std::shared_ptr<ComputeThermo> thermo,
+                           std::shared_ptr<VariantConstant> kT,
+                           pybind11::list kT_ladder);
+
+    /// Destructor
+    virtual ~ReplicaExchangeUpdater();
+
+    /// Attempt exchanges
+    virtual void update(uint64_t timestep);
+
+    /// Get the temperature ladder
+    pybind11::list getLadder() const;
+
+    /// Get the ladder position of the local replica
+    unsigned int getLadderIndex() const
+        {
+        return m_ladder_index[m_partition];
+        }
+
+    /// Get the ladder positions of all replicas
+    pybind11::list getLadderIndices() const;
+
+    /// Get the number of attempted exchanges between each pair of neighboring positions
+    pybind11::list getAttempted() const;
+
+    /// Get the number of accepted exchanges between each pair of neighboring positions
+    pybind11::list getAccepted() const;
+
+    private:
+    std::shared_ptr<ComputeThermo> m_thermo; //!< Computes the potential energy
+    std::shared_ptr<VariantConstant> m_kT;   //!< Temperature of the local replica
+    std::vector<Scalar> m_ladder;            //!< Temperature at each ladder position
+    unsigned int m_partition;                //!< Partition of this rank
+    std::vector<unsigned int> m_ladder_index; //!< Ladder position of the replica in each partition
+    std::vector<uint64_t> m_attempted;        //!< Attempts between positions k and k+1
+    std::vector<uint64_t> m_accepted;         //!< Accepted exchanges between k and k+1
+    uint64_t m_n_rounds;                      //!< Number of exchange rounds performed
+
+#ifdef ENABLE_MPI
+    MPI_Comm m_exchange_comm; //!< Ranks with the same rank in every partition
+#endif
+
+    /// Rescale the velocities and angular momenta of the local particles
+    void rescaleMomenta(Scalar factor);
+    };
+
+namespace detail
+    {
+/// Export ReplicaExchangeUpdater to python
+void export_ReplicaExchangeUpdater(pybind11::module& m);
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,104 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file StressAutocorrelationAnalyzer.cc
+    \brief Contains code for the StressAutocorrelationAnalyzer class
+*/
+
+#include "StressAutocorrelationAnalyzer.h"
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System definition
+    \param trigger Steps on which to sample, must be equally spaced
+    \param thermo Computes the pressure tensor
+    \param points Number of values per level
+    \param averaging Number of values that produce one value of the next level
+    \param max_levels Maximum number of levels
+*/
+StressAutocorrelationAnalyzer::StressAutocorrelationAnalyzer(
+    std::shared_ptr<SystemDefinition> sysdef,
+    std::shared_ptr<Trigger> trigger,
+    std::shared_ptr<ComputeThermo> thermo,
+    unsigned int points,
+    unsigned int averaging,
+    unsigned int max_levels)
+    : Analyzer(sysdef, trigger), m_thermo(thermo),
+      m_correlator(sysdef->getNDimensions() == 2 ? 1 : 3, points, averaging, max_levels)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing StressAutocorrelationAnalyzer" << std::endl;
+    }
+
+StressAutocorrelationAnalyzer::~StressAutocorrelationAnalyzer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying StressAutocorrelationAnalyzer" << std::endl;
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void StressAutocorrelationAnalyzer::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    m_thermo->compute(timestep);
+    const PressureTensor P = m_thermo->getPressureTensor();
+
+    std::vector<double> x;
+    if (m_sysdef->getNDimensions() == 2)
+        {
+        x = {P.xy};
+        }
+    else
+        {
+        x = {P.xy, P.xz, P.yz};
+        }
+    m_correlator.push(x);
+    }
+
+/*! \returns The lags with samples in units of the sample period
+ */
+pybind11::object StressAutocorrelationAnalyzer::getLags()
+    {
+    std::vector<uint64_t> lags;
+    std::vector<double> values;
+    m_correlator.getCorrelation(lags, values);
+    return pybind11::array_t<uint64_t>(lags.size(), lags.data());
+    }
+
+/*! \returns The autocorrelation averaged over the components and the time origins of each lag in
+    getLags()
+*/
+pybind11::object StressAutocorrelationAnalyzer::getCorrelation()
+    {
+    std::vector<uint64_t> lags;
+    std::vector<double> values;
+    m_correlator.getCorrelation(lags, values);
+    return pybind11::array_t<double>(values.size(), values.data());
+    }
+
+namespace detail
+    {
+void export_StressAutocorrelationAnalyzer(pybind11::module& m)
+    {
+    pybind11::class_<StressAutocorrelationAnalyzer,
+                     Analyzer,
+                     std::shared_ptr<StressAutocorrelationAnalyzer>>(
+        m,
+        "StressAutocorrelationAnalyzer")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            std::shared_ptr<ComputeThermo>,
+                            unsigned int,
+                            unsigned int,
+                            unsigned int>())
+        .def("getLags", &StressAutocorrelationAnalyzer::getLags)
+        .def("getCorrelation", &StressAutocorrelationAnalyzer::getCorrelation)
+        .def("reset", &StressAutocorrelationAnalyzer::reset)
+        .def_property_readonly("num_samples", &StressAutocorrelationAnalyzer::getNumSamples);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
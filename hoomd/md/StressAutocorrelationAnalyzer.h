@@ -0,0 +1,90 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "ComputeThermo.h"
+#include "MultiTauCorrelator.h"
+#include "hoomd/Analyzer.h"
+
+/*! \file StressAutocorrelationAnalyzer.h
+    \brief Declares a class that accumulates the shear stress autocorrelation function
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#ifndef __STRESS_AUTOCORRELATION_ANALYZER_H__
+#define __STRESS_AUTOCORRELATION_ANALYZER_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Accumulates the autocorrelation of the off-diagonal pressure tensor with a multi-tau correlator
+/*! StressAutocorrelationAnalyzer samples the off-diagonal components \f$ P_{xy}, P_{xz}, P_{yz} \f$
+    (\f$ P_{xy} \f$ in 2D) of the pressure tensor computed by \a thermo on every call to analyze()
+    and accumulates their autocorrelation, averaged over the components, in a MultiTauCorrelator.
+    The Green-Kubo integral of the correlation gives the shear viscosity.
+
+    The pressure tensor is a global quantity that ComputeThermo reduces over the ranks, so the
+    correlator runs on the host and its storage is independent of the number of particles. The
+    analyzer requests the pressure tensor flag so that the forces compute the virials on the
+    sampled steps.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT StressAutocorrelationAnalyzer : public Analyzer
+    {
+    public:
+    //! Constructs the analyzer
+    StressAutocorrelationAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                                  std::shared_ptr<Trigger> trigger,
+                                  std::shared_ptr<ComputeThermo> thermo,
+                                  unsigned int points,
+                                  unsigned int averaging,
+                                  unsigned int max_levels);
+
+    //! Destructor
+    virtual ~StressAutocorrelationAnalyzer();
+
+    //! Add a sample of the current pressure tensor
+    virtual void analyze(uint64_t timestep);
+
+    //! Request the pressure tensor
+    virtual PDataFlags getRequestedPDataFlags()
+        {
+        PDataFlags flags;
+        flags[pdata_flag::pressure_tensor] = 1;
+        return flags;
+        }
+
+    //! Get the lags that have samples in units of the sample period
+    pybind11::object getLags();
+
+    //! Get the correlation of each lag
+    pybind11::object getCorrelation();
+
+    //! Clear the correlator
+    void reset()
+        {
+        m_correlator.reset();
+        }
+
+    //! Get the number of accumulated samples
+    uint64_t getNumSamples()
+        {
+        return m_correlator.getLevels().getNumSamples();
+        }
+
+    protected:
+    std::shared_ptr<ComputeThermo> m_thermo; //!< Computes the pressure tensor
+    MultiTauCorrelator m_correlator;         //!< Correlator of the off-diagonal components
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
@@ -0,0 +1,303 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file StructureFactorAnalyzer.cc
+    \brief Contains code for the StructureFactorAnalyzer class
+*/
+
+#include "StructureFactorAnalyzer.h"
+#include "hoomd/ParallelLoop.h"
+#include "hoomd/VectorMath.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/HOOMDMPI.h"
+#endif
+
+#include <string.h>
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System definition
+    \param trigger Steps on which to accumulate the structure factor
+    \param group Particles to include in the density
+    \param q_max Maximum wave vector magnitude
+    \param bins Number of bins in [0, q_max)
+*/
+StructureFactorAnalyzer::StructureFactorAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                                                 std::shared_ptr<Trigger> trigger,
+                                                 std::shared_ptr<ParticleGroup> group,
+                                                 Scalar q_max,
+                                                 unsigned int bins)
+    : Analyzer(sysdef, trigger), m_group(group), m_q_max(q_max), m_bins(bins),
+      m_wave_vectors_valid(false), m_n_wave_vectors(0), m_frames_in_sum(0),
+      m_bin_sum(bins, 0.0), m_bin_samples(bins, 0), m_num_frames(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing StructureFactorAnalyzer" << std::endl;
+
+    if (!(q_max > Scalar(0.0)))
+        {
+        throw std::runtime_error("q_max must be positive.");
+        }
+    if (bins == 0)
+        {
+        throw std::runtime_error("bins must be positive.");
+        }
+    }
+
+StructureFactorAnalyzer::~StructureFactorAnalyzer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying StructureFactorAnalyzer" << std::endl;
+    }
+
+void StructureFactorAnalyzer::reset()
+    {
+    if (m_n_wave_vectors > 0)
+        {
+        ArrayHandle<double> h_sum(m_sum, access_location::host, access_mode::overwrite);
+        memset(h_sum.data, 0, sizeof(double) * m_n_wave_vectors);
+        }
+    m_frames_in_sum = 0;
+    std::fill(m_bin_sum.begin(), m_bin_sum.end(), 0.0);
+    std::fill(m_bin_samples.begin(), m_bin_samples.end(), 0);
+    m_num_frames = 0;
+    }
+
+/*! Wave vectors q = 2 pi (n_1 b_1 + n_2 b_2 + n_3 b_3) satisfy q . a_i = 2 pi n_i for the lattice
+    vectors a_i, so |n_i| <= q_max |a_i| / (2 pi). The first nonzero n_i is positive to select one
+    of q and -q. n_3 is 0 in 2D.
+*/
+void StructureFactorAnalyzer::updateWaveVectors()
+    {
+    if (m_n_wave_vectors > 0)
+        {
+        foldSums(m_bin_sum, m_bin_samples);
+        }
+
+    m_box = m_pdata->getGlobalBox();
+    m_wave_vectors_valid = true;
+
+    const bool twod = m_sysdef->getNDimensions() == 2;
+    const vec3<Scalar> a1(m_box.getLatticeVector(0));
+    const vec3<Scalar> a2(m_box.getLatticeVector(1));
+    const vec3<Scalar> a3 = twod ? vec3<Scalar>(0, 0, 1) : vec3<Scalar>(m_box.getLatticeVector(2));
+    const Scalar scale = Scalar(2.0 * M_PI) / dot(a1, cross(a2, a3));
+    const vec3<Scalar> b1 = scale * cross(a2, a3);
+    const vec3<Scalar> b2 = scale * cross(a3, a1);
+    const vec3<Scalar> b3 = scale * cross(a1, a2);
+
+    const Scalar n_scale = m_q_max / Scalar(2.0 * M_PI);
+    const int n1_max = int(n_scale * fast::sqrt(dot(a1, a1)));
+    const int n2_max = int(n_scale * fast::sqrt(dot(a2, a2)));
+    const int n3_max = twod ? 0 : int(n_scale * fast::sqrt(dot(a3, a3)));
+    const Scalar q_max_sq = m_q_max * m_q_max;
+    const Scalar bin_scale = Scalar(m_bins) / m_q_max;
+
+    std::vector<Scalar3> wave_vectors;
+    std::vector<unsigned int> wave_bin;
+    for (int n1 = 0; n1 <= n1_max; n1++)
+        {
+        for (int n2 = -n2_max; n2 <= n2_max; n2++)
+            {
+            for (int n3 = -n3_max; n3 <= n3_max; n3++)
+                {
+                if (n1 == 0 && (n2 < 0 || (n2 == 0 && n3 <= 0)))
+                    continue;
+
+                const vec3<Scalar> q = Scalar(n1) * b1 + Scalar(n2) * b2 + Scalar(n3) * b3;
+                const Scalar q_sq = dot(q, q);
+                if (q_sq > q_max_sq)
+                    continue;
+
+                wave_vectors.push_back(vec_to_scalar3(q));
+                wave_bin.push_back(
+                    std::min((unsigned int)(fast::sqrt(q_sq) * bin_scale), m_bins - 1));
+                }
+            }
+        }
+
+    m_n_wave_vectors = (unsigned int)wave_vectors.size();
+    m_exec_conf->msg->notice(6) << "StructureFactorAnalyzer: " << m_n_wave_vectors
+                                << " wave vectors" << std::endl;
+
+    GPUArray<Scalar3> new_wave_vectors(m_n_wave_vectors, m_exec_conf);
+    m_wave_vectors.swap(new_wave_vectors);
+    GPUArray<unsigned int> new_wave_bin(m_n_wave_vectors, m_exec_conf);
+    m_wave_bin.swap(new_wave_bin);
+    GPUArray<Scalar2> new_density(m_n_wave_vectors, m_exec_conf);
+    m_density.swap(new_density);
+    GPUArray<double> new_sum(m_n_wave_vectors, m_exec_conf);
+    m_sum.swap(new_sum);
+    m_frames_in_sum = 0;
+
+    if (m_n_wave_vectors > 0)
+        {
+        ArrayHandle<Scalar3> h_wave_vectors(m_wave_vectors,
+                                            access_location::host,
+                                            access_mode::overwrite);
+        ArrayHandle<unsigned int> h_wave_bin(m_wave_bin,
+                                             access_location::host,
+                                             access_mode::overwrite);
+        ArrayHandle<double> h_sum(m_sum, access_location::host, access_mode::overwrite);
+        std::copy(wave_vectors.begin(), wave_vectors.end(), h_wave_vectors.data);
+        std::copy(wave_bin.begin(), wave_bin.end(), h_wave_bin.data);
+        memset(h_sum.data, 0, sizeof(double) * m_n_wave_vectors);
+        }
+    }
+
+/*! \param bin_sum Sums of |rho|^2 / N in each bin
+    \param bin_samples Number of samples in each bin
+*/
+void StructureFactorAnalyzer::foldSums(std::vector<double>& bin_sum,
+                                       std::vector<unsigned long long>& bin_samples)
+    {
+    if (m_frames_in_sum == 0)
+        return;
+
+    ArrayHandle<double> h_sum(m_sum, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_wave_bin(m_wave_bin, access_location::host, access_mode::read);
+    for (unsigned int k = 0; k < m_n_wave_vectors; k++)
+        {
+        bin_sum[h_wave_bin.data[k]] += h_sum.data[k];
+        bin_samples[h_wave_bin.data[k]] += m_frames_in_sum;
+        }
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void StructureFactorAnalyzer::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    if (!m_wave_vectors_valid || m_pdata->getGlobalBox() != m_box)
+        {
+        updateWaveVectors();
+        }
+
+    if (m_n_wave_vectors > 0)
+        {
+        computeDensity();
+
+#ifdef ENABLE_MPI
+        if (m_sysdef->isDomainDecomposed())
+            {
+            ArrayHandle<Scalar2> h_density(m_density,
+                                           access_location::host,
+                                           access_mode::readwrite);
+            MPI_Allreduce(MPI_IN_PLACE,
+                          h_density.data,
+                          2 * m_n_wave_vectors,
+                          MPI_HOOMD_SCALAR,
+                          MPI_SUM,
+                          m_exec_conf->getMPICommunicator());
+            }
+#endif
+
+        const unsigned int N = m_group->getNumMembersGlobal();
+        accumulateDensity(N > 0 ? Scalar(1.0) / Scalar(N) : Scalar(0.0));
+        }
+
+    m_frames_in_sum++;
+    m_num_frames++;
+    }
+
+void StructureFactorAnalyzer::computeDensity()
+    {
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_index_array(m_group->getIndexArray(),
+                                            access_location::host,
+                                            access_mode::read);
+    ArrayHandle<Scalar3> h_wave_vectors(m_wave_vectors, access_location::host, access_mode::read);
+    ArrayHandle<Scalar2> h_density(m_density, access_location::host, access_mode::overwrite);
+
+    const unsigned int group_size = m_group->getNumMembers();
+
+    // each wave vector writes only its own density mode
+    auto density_range = [&](unsigned int first, unsigned int last)
+    {
+        for (unsigned int k = first; k < last; k++)
+            {
+            const Scalar3 q = h_wave_vectors.data[k];
+            Scalar re(0.0), im(0.0);
+            for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+                {
+                const Scalar4 postype = h_pos.data[h_index_array.data[group_idx]];
+                Scalar s, c;
+                fast::sincos(q.x * postype.x + q.y * postype.y + q.z * postype.z, s, c);
+                re += c;
+                im -= s;
+                }
+            h_density.data[k] = make_scalar2(re, im);
+            }
+    };
+    hoomd::detail::parallel_loop(*m_exec_conf, m_n_wave_vectors, density_range);
+    }
+
+/*! \param norm Factor to multiply |rho|^2 with
+ */
+void StructureFactorAnalyzer::accumulateDensity(Scalar norm)
+    {
+    ArrayHandle<Scalar2> h_density(m_density, access_location::host, access_mode::read);
+    ArrayHandle<double> h_sum(m_sum, access_location::host, access_mode::readwrite);
+
+    for (unsigned int k = 0; k < m_n_wave_vectors; k++)
+        {
+        const Scalar2 rho = h_density.data[k];
+        h_sum.data[k] += double(rho.x * rho.x + rho.y * rho.y) * double(norm);
+        }
+    }
+
+/*! \returns S(q) in each bin on the root rank and None on other ranks
+
+    Bins that contain no wave vectors are 0.
+*/
+pybind11::object StructureFactorAnalyzer::getStructureFactor()
+    {
+#ifdef ENABLE_MPI
+    if (!m_exec_conf->isRoot())
+        return pybind11::none();
+#endif
+
+    std::vector<double> bin_sum(m_bin_sum);
+    std::vector<unsigned long long> bin_samples(m_bin_samples);
+    if (m_n_wave_vectors > 0)
+        {
+        foldSums(bin_sum, bin_samples);
+        }
+
+    std::vector<double> structure_factor(m_bins, 0.0);
+    for (unsigned int bin = 0; bin < m_bins; bin++)
+        {
+        if (bin_samples[bin] > 0)
+            {
+            structure_factor[bin] = bin_sum[bin] / double(bin_samples[bin]);
+            }
+        }
+
+    return pybind11::array_t<double>(structure_factor.size(), structure_factor.data());
+    }
+
+namespace detail
+    {
+void export_StructureFactorAnalyzer(pybind11::module& m)
+    {
+    pybind11::class_<StructureFactorAnalyzer, Analyzer, std::shared_ptr<StructureFactorAnalyzer>>(
+        m,
+        "StructureFactorAnalyzer")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            std::shared_ptr<ParticleGroup>,
+                            Scalar,
+                            unsigned int>())
+        .def("getStructureFactor", &StructureFactorAnalyzer::getStructureFactor)
+        .def("reset", &StructureFactorAnalyzer::reset)
+        .def_property_readonly("num_frames", &StructureFactorAnalyzer::getNumFrames)
+        .def_property_readonly("num_wave_vectors", &StructureFactorAnalyzer::getNumWaveVectors)
+        .def_property_readonly("q_max", &StructureFactorAnalyzer::getQMax)
+        .def_property_readonly("bins", &StructureFactorAnalyzer::getBins);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
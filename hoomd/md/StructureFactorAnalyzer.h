@@ -0,0 +1,127 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "hoomd/Analyzer.h"
+#include "hoomd/GPUArray.h"
+#include "hoomd/ParticleGroup.h"
+
+/*! \file StructureFactorAnalyzer.h
+    \brief Declares a class that accumulates the static structure factor
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#ifndef __STRUCTURE_FACTOR_ANALYZER_H__
+#define __STRUCTURE_FACTOR_ANALYZER_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Accumulates the static structure factor of a group of particles
+/*! StructureFactorAnalyzer evaluates the density modes
+
+    \f[ \rho(\vec{q}) = \sum_{i \in \mathrm{group}} e^{-i \vec{q} \cdot \vec{r}_i} \f]
+
+    of the wave vectors \f$ \vec{q} = 2\pi (n_1 \vec{b}_1 + n_2 \vec{b}_2 + n_3 \vec{b}_3) \f$ with
+    \f$ 0 < |\vec{q}| \le q_{max} \f$ on every call to analyze(), where the \f$ \vec{b}_i \f$ are
+    the reciprocal lattice vectors of the box. The modes are exact sums over the particles: the
+    wave vectors are compatible with the periodic box, so the particle positions need no
+    unwrapping and no mesh assignment is needed. Only one of \f$ \pm\vec{q} \f$ is evaluated
+    because \f$ S(\vec{q}) = S(-\vec{q}) \f$. Each rank sums its local members, and a single
+    reduction of the modes per frame combines the ranks.
+
+    \f$ |\rho(\vec{q})|^2 / N \f$ accumulates per wave vector in m_sum. When the box changes, the
+    sums are folded into the bins of \f$ |\vec{q}| \f$ and the wave vectors are regenerated from
+    the new box. getStructureFactor() averages the samples in each bin.
+
+    The cost of a frame is proportional to the number of group members times the number of wave
+    vectors, which grows as \f$ q_{max}^3 V \f$ in 3D.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT StructureFactorAnalyzer : public Analyzer
+    {
+    public:
+    //! Constructs the analyzer
+    StructureFactorAnalyzer(std::shared_ptr<SystemDefinition> sysdef,
+                            std::shared_ptr<Trigger> trigger,
+                            std::shared_ptr<ParticleGroup> group,
+                            Scalar q_max,
+                            unsigned int bins);
+
+    //! Destructor
+    virtual ~StructureFactorAnalyzer();
+
+    //! Add the density modes of the current configuration to the sums
+    virtual void analyze(uint64_t timestep);
+
+    //! Get the structure factor in each bin
+    pybind11::object getStructureFactor();
+
+    //! Clear the accumulated sums
+    void reset();
+
+    //! Get the number of accumulated frames
+    uint64_t getNumFrames()
+        {
+        return m_num_frames;
+        }
+
+    //! Get the number of wave vectors in the current box
+    unsigned int getNumWaveVectors()
+        {
+        return m_n_wave_vectors;
+        }
+
+    //! Get the maximum wave vector magnitude
+    Scalar getQMax()
+        {
+        return m_q_max;
+        }
+
+    //! Get the number of bins
+    unsigned int getBins()
+        {
+        return m_bins;
+        }
+
+    protected:
+    std::shared_ptr<ParticleGroup> m_group; //!< Particles to include in the density
+    Scalar m_q_max;                         //!< Maximum wave vector magnitude
+    unsigned int m_bins;                    //!< Number of bins in [0, q_max)
+
+    BoxDim m_box;                                  //!< Global box of the current wave vectors
+    bool m_wave_vectors_valid;                     //!< True when the wave vectors match m_box
+    unsigned int m_n_wave_vectors;                 //!< Number of wave vectors
+    GPUArray<Scalar3> m_wave_vectors;              //!< The wave vectors
+    GPUArray<unsigned int> m_wave_bin;             //!< Bin of each wave vector
+    GPUArray<Scalar2> m_density;                   //!< Density mode of each wave vector
+    GPUArray<double> m_sum;                        //!< Sum of |rho|^2 / N of each wave vector
+    uint64_t m_frames_in_sum;                      //!< Number of frames in m_sum
+    std::vector<double> m_bin_sum;                 //!< Sums folded from previous boxes
+    std::vector<unsigned long long> m_bin_samples; //!< Number of samples in m_bin_sum
+    uint64_t m_num_frames;                         //!< Number of accumulated frames
+
+    //! Evaluate the density modes of the local group members in m_density
+    virtual void computeDensity();
+
+    //! Add |rho|^2 * norm to m_sum
+    virtual void accumulateDensity(Scalar norm);
+
+    //! Fold m_sum into the bins and generate the wave vectors of the current box
+    void updateWaveVectors();
+
+    //! Add the samples in m_sum to the given bins
+    void foldSums(std::vector<double>& bin_sum, std::vector<unsigned long long>& bin_samples);
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
@@ -0,0 +1,109 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "StructureFactorAnalyzerGPU.h"
+#include "StructureFactorAnalyzerGPU.cuh"
+
+/*! \file StructureFactorAnalyzerGPU.cc
+    \brief Contains code for the StructureFactorAnalyzerGPU class
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System definition
+    \param trigger Steps on which to accumulate the structure factor
+    \param group Particles to include in the density
+    \param q_max Maximum wave vector magnitude
+    \param bins Number of bins in [0, q_max)
+*/
+StructureFactorAnalyzerGPU::StructureFactorAnalyzerGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                                       std::shared_ptr<Trigger> trigger,
+                                                       std::shared_ptr<ParticleGroup> group,
+                                                       Scalar q_max,
+                                                       unsigned int bins)
+    : StructureFactorAnalyzer(sysdef, trigger, group, q_max, bins)
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        throw std::runtime_error(
+            "Error initializing StructureFactorAnalyzerGPU: no GPU available.");
+        }
+
+    // the density kernel reduces in shared memory and needs power of two block sizes
+    std::vector<unsigned int> pow2_block_sizes;
+    for (unsigned int block_size = m_exec_conf->dev_prop.warpSize;
+         block_size <= (unsigned int)m_exec_conf->dev_prop.maxThreadsPerBlock;
+         block_size *= 2)
+        {
+        pow2_block_sizes.push_back(block_size);
+        }
+
+    m_tuner_density.reset(
+        new Autotuner<1>({pow2_block_sizes}, m_exec_conf, "structure_factor_density"));
+    m_tuner_accumulate.reset(new Autotuner<1>({AutotunerBase::makeBlockSizeRange(m_exec_conf)},
+                                              m_exec_conf,
+                                              "structure_factor_accumulate"));
+    m_autotuners.insert(m_autotuners.end(), {m_tuner_density, m_tuner_accumulate});
+    }
+
+void StructureFactorAnalyzerGPU::computeDensity()
+    {
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(),
+                                            access_location::device,
+                                            access_mode::read);
+    ArrayHandle<Scalar3> d_wave_vectors(m_wave_vectors,
+                                        access_location::device,
+                                        access_mode::read);
+    ArrayHandle<Scalar2> d_density(m_density, access_location::device, access_mode::overwrite);
+
+    m_tuner_density->begin();
+    kernel::gpu_structure_factor_density(d_density.data,
+                                         d_wave_vectors.data,
+                                         m_n_wave_vectors,
+                                         d_pos.data,
+                                         d_index_array.data,
+                                         m_group->getNumMembers(),
+                                         m_tuner_density->getParam()[0]);
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner_density->end();
+    }
+
+/*! \param norm Factor to multiply |rho|^2 with
+ */
+void StructureFactorAnalyzerGPU::accumulateDensity(Scalar norm)
+    {
+    ArrayHandle<Scalar2> d_density(m_density, access_location::device, access_mode::read);
+    ArrayHandle<double> d_sum(m_sum, access_location::device, access_mode::readwrite);
+
+    m_tuner_accumulate->begin();
+    kernel::gpu_structure_factor_accumulate(d_sum.data,
+                                            d_density.data,
+                                            m_n_wave_vectors,
+                                            norm,
+                                            m_tuner_accumulate->getParam()[0]);
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner_accumulate->end();
+    }
+
+namespace detail
+    {
+void export_StructureFactorAnalyzerGPU(pybind11::module& m)
+    {
+    pybind11::class_<StructureFactorAnalyzerGPU,
+                     StructureFactorAnalyzer,
+                     std::shared_ptr<StructureFactorAnalyzerGPU>>(m, "StructureFactorAnalyzerGPU")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            std::shared_ptr<ParticleGroup>,
+                            Scalar,
+                            unsigned int>());
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
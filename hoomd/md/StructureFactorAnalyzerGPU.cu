@@ -0,0 +1,144 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "StructureFactorAnalyzerGPU.cuh"
+
+/*! \file StructureFactorAnalyzerGPU.cu
+    \brief Defines GPU kernel code for accumulating the static structure factor. Used by
+   StructureFactorAnalyzerGPU.
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Kernel that evaluates the density modes of the group members
+/*! \param d_density Density mode of each wave vector
+    \param d_wave_vectors The wave vectors
+    \param d_pos Particle positions
+    \param d_index_array Indices of the group members
+    \param group_size Number of local group members
+
+    Each block evaluates the mode of one wave vector. The threads sum a strided subset of the group
+    members and reduce the partial sums in shared memory. blockDim.x must be a power of two.
+*/
+__global__ void gpu_structure_factor_density_kernel(Scalar2* d_density,
+                                                    const Scalar3* d_wave_vectors,
+                                                    const Scalar4* d_pos,
+                                                    const unsigned int* d_index_array,
+                                                    const unsigned int group_size)
+    {
+    HIP_DYNAMIC_SHARED(Scalar2, s_density)
+
+    const Scalar3 q = d_wave_vectors[blockIdx.x];
+    Scalar re(0.0), im(0.0);
+    for (unsigned int group_idx = threadIdx.x; group_idx < group_size; group_idx += blockDim.x)
+        {
+        const Scalar4 postype = d_pos[d_index_array[group_idx]];
+        Scalar s, c;
+        fast::sincos(q.x * postype.x + q.y * postype.y + q.z * postype.z, s, c);
+        re += c;
+        im -= s;
+        }
+    s_density[threadIdx.x] = make_scalar2(re, im);
+    __syncthreads();
+
+    for (unsigned int offset = blockDim.x / 2; offset > 0; offset >>= 1)
+        {
+        if (threadIdx.x < offset)
+            {
+            s_density[threadIdx.x].x += s_density[threadIdx.x + offset].x;
+            s_density[threadIdx.x].y += s_density[threadIdx.x + offset].y;
+            }
+        __syncthreads();
+        }
+
+    if (threadIdx.x == 0)
+        d_density[blockIdx.x] = s_density[0];
+    }
+
+//! Kernel that adds |rho|^2 * norm to the sums of the wave vectors
+/*! \param d_sum Sum of each wave vector
+    \param d_density Density mode of each wave vector
+    \param n_wave_vectors Number of wave vectors
+    \param norm Factor to multiply |rho|^2 with
+*/
+__global__ void gpu_structure_factor_accumulate_kernel(double* d_sum,
+                                                       const Scalar2* d_density,
+                                                       const unsigned int n_wave_vectors,
+                                                       const Scalar norm)
+    {
+    const unsigned int k = blockIdx.x * blockDim.x + threadIdx.x;
+    if (k >= n_wave_vectors)
+        return;
+
+    const Scalar2 rho = d_density[k];
+    d_sum[k] += double(rho.x * rho.x + rho.y * rho.y) * double(norm);
+    }
+
+/*! \param d_density Density mode of each wave vector
+    \param d_wave_vectors The wave vectors
+    \param n_wave_vectors Number of wave vectors
+    \param d_pos Particle positions
+    \param d_index_array Indices of the group members
+    \param group_size Number of local group members
+    \param block_size Number of threads per block, a power of two
+*/
+hipError_t gpu_structure_factor_density(Scalar2* d_density,
+                                        const Scalar3* d_wave_vectors,
+                                        const unsigned int n_wave_vectors,
+                                        const Scalar4* d_pos,
+                                        const unsigned int* d_index_array,
+                                        const unsigned int group_size,
+                                        const unsigned int block_size)
+    {
+    if (n_wave_vectors == 0)
+        return hipSuccess;
+
+    hipLaunchKernelGGL((gpu_structure_factor_density_kernel),
+                       dim3(n_wave_vectors),
+                       dim3(block_size),
+                       block_size * sizeof(Scalar2),
+                       0,
+                       d_density,
+                       d_wave_vectors,
+                       d_pos,
+                       d_index_array,
+                       group_size);
+
+    return hipSuccess;
+    }
+
+/*! \param d_sum Sum of each wave vector
+    \param d_density Density mode of each wave vector
+    \param n_wave_vectors Number of wave vectors
+    \param norm Factor to multiply |rho|^2 with
+    \param block_size Number of threads per block
+*/
+hipError_t gpu_structure_factor_accumulate(double* d_sum,
+                                           const Scalar2* d_density,
+                                           const unsigned int n_wave_vectors,
+                                           const Scalar norm,
+                                           const unsigned int block_size)
+    {
+    if (n_wave_vectors == 0)
+        return hipSuccess;
+
+    hipLaunchKernelGGL((gpu_structure_factor_accumulate_kernel),
+                       dim3(n_wave_vectors / block_size + 1),
+                       dim3(block_size),
+                       0,
+                       0,
+                       d_sum,
+                       d_density,
+                       n_wave_vectors,
+                       norm);
+
+    return hipSuccess;
+    }
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,41 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "hip/hip_runtime.h"
+#include "hoomd/HOOMDMath.h"
+
+/*! \file StructureFactorAnalyzerGPU.cuh
+    \brief Declares GPU kernel code for accumulating the static structure factor. Used by
+   StructureFactorAnalyzerGPU.
+*/
+
+#ifndef __STRUCTURE_FACTOR_ANALYZER_GPU_CUH__
+#define __STRUCTURE_FACTOR_ANALYZER_GPU_CUH__
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Evaluate the density modes of the group members
+hipError_t gpu_structure_factor_density(Scalar2* d_density,
+                                        const Scalar3* d_wave_vectors,
+                                        const unsigned int n_wave_vectors,
+                                        const Scalar4* d_pos,
+                                        const unsigned int* d_index_array,
+                                        const unsigned int group_size,
+                                        const unsigned int block_size);
+
+//! Add |rho|^2 * norm to the sums of the wave vectors
+hipError_t gpu_structure_factor_accumulate(double* d_sum,
+                                           const Scalar2* d_density,
+                                           const unsigned int n_wave_vectors,
+                                           const Scalar norm,
+                                           const unsigned int block_size);
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
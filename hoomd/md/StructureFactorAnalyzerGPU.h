@@ -0,0 +1,53 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "StructureFactorAnalyzer.h"
+#include "hoomd/Autotuner.h"
+
+/*! \file StructureFactorAnalyzerGPU.h
+    \brief Declares a class that accumulates the static structure factor on the GPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __STRUCTURE_FACTOR_ANALYZER_GPU_H__
+#define __STRUCTURE_FACTOR_ANALYZER_GPU_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Accumulates the static structure factor of a group of particles on the GPU
+/*! The density modes and the sums of the wave vectors stay on the device between frames. The
+    density modes are copied to the host only for the reduction over the ranks.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT StructureFactorAnalyzerGPU : public StructureFactorAnalyzer
+    {
+    public:
+    //! Constructs the analyzer
+    StructureFactorAnalyzerGPU(std::shared_ptr<SystemDefinition> sysdef,
+                               std::shared_ptr<Trigger> trigger,
+                               std::shared_ptr<ParticleGroup> group,
+                               Scalar q_max,
+                               unsigned int bins);
+
+    protected:
+    std::shared_ptr<Autotuner<1>> m_tuner_density;    //!< Autotuner for the density kernel
+    std::shared_ptr<Autotuner<1>> m_tuner_accumulate; //!< Autotuner for the accumulate kernel
+
+    //! Evaluate the density modes of the local group members in m_density
+    virtual void computeDensity();
+
+    //! Add |rho|^2 * norm to m_sum
+    virtual void accumulateDensity(Scalar norm);
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+#endif
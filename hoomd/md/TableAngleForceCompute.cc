@@ -151,6 +151,9 @@ void TableAngleForceCompute::computeForces(uint64_t timestep)
 
     size_t virial_pitch = m_virial.getPitch();
 
+    PDataFlags flags = m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor];
+
     // Zero data for force calculation.
     memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
     memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
@@ -296,8 +299,9 @@ void TableAngleForceCompute::computeForces(uint64_t timestep)
             h_force.data[idx_a].y += fab[1];
             h_force.data[idx_a].z += fab[2];
             h_force.data[idx_a].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j * virial_pitch + idx_a] += angle_virial[j];
+            if (compute_virial)
+                for (int j = 0; j < 6; j++)
+                    h_virial.data[j * virial_pitch + idx_a] += angle_virial[j];
             }
 
         if (idx_b < m_pdata->getN())
@@ -306,8 +310,9 @@ void TableAngleForceCompute::computeForces(uint64_t timestep)
             h_force.data[idx_b].y -= fab[1] + fcb[1];
             h_force.data[idx_b].z -= fab[2] + fcb[2];
             h_force.data[idx_b].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j * virial_pitch + idx_b] += angle_virial[j];
+            if (compute_virial)
+                for (int j = 0; j < 6; j++)
+                    h_virial.data[j * virial_pitch + idx_b] += angle_virial[j];
             }
 
         if (idx_c < m_pdata->getN())
@@ -316,8 +321,9 @@ void TableAngleForceCompute::computeForces(uint64_t timestep)
             h_force.data[idx_c].y += fcb[1];
             h_force.data[idx_c].z += fcb[2];
             h_force.data[idx_c].w += angle_eng;
-            for (int j = 0; j < 6; j++)
-                h_virial.data[j * virial_pitch + idx_c] += angle_virial[j];
+            if (compute_virial)
+                for (int j = 0; j < 6; j++)
+                    h_virial.data[j * virial_pitch + idx_c] += angle_virial[j];
             }
         }
     }
@@ -42,7 +42,9 @@ namespace kernel
     \param delta_th angle delta of the table
 
     See TableAngleForceCompute for information on the memory layout.
+    \tparam compute_virial When false, the kernel does not write the virial
 */
+template<bool compute_virial>
 __global__ void gpu_compute_table_angle_forces_kernel(Scalar4* d_force,
                                                       Scalar* d_virial,
                                                       const size_t virial_pitch,
@@ -219,13 +221,17 @@ __global__ void gpu_compute_table_angle_forces_kernel(Scalar4* d_force,
 
     // now that the force calculation is complete, write out the result (MEM TRANSFER: 20 bytes);
     d_force[idx] = force_idx;
-    for (unsigned int i = 0; i < 6; i++)
-        d_virial[i * virial_pitch + idx] = virial[i];
+    if (compute_virial)
+        {
+        for (unsigned int i = 0; i < 6; i++)
+            d_virial[i * virial_pitch + idx] = virial[i];
+        }
     }
 
 /*! \param d_force Device memory to write computed forces
     \param d_virial Device memory to write computed virials
     \param virial_pitch pitch of 2D virial array
+    \param compute_virial True to compute the virial
     \param N number of particles
     \param d_pos particle positions on the device
     \param box Box dimensions used to implement periodic boundary conditions
@@ -245,6 +251,7 @@ __global__ void gpu_compute_table_angle_forces_kernel(Scalar4* d_force,
 hipError_t gpu_compute_table_angle_forces(Scalar4* d_force,
                                           Scalar* d_virial,
                                           const size_t virial_pitch,
+                                          bool compute_virial,
                                           const unsigned int N,
                                           const Scalar4* d_pos,
                                           const BoxDim& box,
@@ -265,7 +272,9 @@ hipError_t gpu_compute_table_angle_forces(Scalar4* d_force,
 
     unsigned int max_block_size;
     hipFuncAttributes attr;
-    hipFuncGetAttributes(&attr, (const void*)gpu_compute_table_angle_forces_kernel);
+    auto func = compute_virial ? &gpu_compute_table_angle_forces_kernel<true>
+                               : &gpu_compute_table_angle_forces_kernel<false>;
+    hipFuncGetAttributes(&attr, (const void*)func);
     max_block_size = attr.maxThreadsPerBlock;
 
     unsigned int run_block_size = min(block_size, max_block_size);
@@ -276,7 +285,7 @@ hipError_t gpu_compute_table_angle_forces(Scalar4* d_force,
 
     Scalar delta_th = Scalar(M_PI) / (Scalar)(table_width - 1);
 
-    hipLaunchKernelGGL((gpu_compute_table_angle_forces_kernel),
+    hipLaunchKernelGGL((func),
                        dim3(grid),
                        dim3(threads),
                        0,
@@ -147,6 +147,7 @@ class MTTKThermostat : public Thermostat
 
     std::array<Scalar, 2> getRescalingFactorsOne(uint64_t timestep, Scalar deltaT) override
         {
+        syncStateToHost();
         Scalar exp_thermo_fac = exp(-Scalar(1.0 / 2.0) * m_state.xi * deltaT);
         Scalar exp_thermo_fac_rot = exp(-m_state.xi_rot * deltaT / Scalar(2.0));
         return {exp_thermo_fac, exp_thermo_fac_rot};
@@ -154,6 +155,7 @@ class MTTKThermostat : public Thermostat
 
     std::array<Scalar, 2> getRescalingFactorsTwo(uint64_t timestep, Scalar deltaT) override
         {
+        syncStateToHost();
         Scalar exp_thermo_fac = exp(-Scalar(1.0 / 2.0) * m_state.xi * deltaT);
         Scalar exp_thermo_fac_rot = exp(-m_state.xi_rot * deltaT / Scalar(2.0));
         return {exp_thermo_fac, exp_thermo_fac_rot};
@@ -199,6 +201,7 @@ class MTTKThermostat : public Thermostat
     */
     Scalar getThermostatEnergy(uint64_t timestep)
         {
+        syncStateToHost();
         Scalar translation_dof = m_group->getTranslationalDOF();
         Scalar thermostat_energy
             = static_cast<Scalar>(translation_dof) * m_T->operator()(timestep)
@@ -221,8 +224,10 @@ class MTTKThermostat : public Thermostat
             {
             throw std::length_error("translational_thermostat_dof must have length 2");
             }
+        syncStateToHost();
         m_state.xi = v[0].cast<Scalar>();
         m_state.eta = v[1].cast<Scalar>();
+        syncStateToDevice();
         }
 
     /** Get the translational degrees of freedom from Python.
@@ -231,6 +236,7 @@ class MTTKThermostat : public Thermostat
     */
     pybind11::tuple getTranslationalDOF()
         {
+        syncStateToHost();
         return pybind11::make_tuple(m_state.xi, m_state.eta);
         }
 
@@ -244,8 +250,10 @@ class MTTKThermostat : public Thermostat
             {
             throw std::length_error("rotational_thermostat_dof must have length 2");
             }
+        syncStateToHost();
         m_state.xi_rot = v[0].cast<Scalar>();
         m_state.eta_rot = v[1].cast<Scalar>();
+        syncStateToDevice();
         }
 
     /** Get the rotational degrees of freedom from Python.
@@ -254,6 +262,7 @@ class MTTKThermostat : public Thermostat
     */
     pybind11::tuple getRotationalDOF()
         {
+        syncStateToHost();
         return pybind11::make_tuple(m_state.xi_rot, m_state.eta_rot);
         };
 
@@ -274,6 +283,7 @@ class MTTKThermostat : public Thermostat
         {
         auto exec_conf = m_sysdef->getParticleData()->getExecConf();
         exec_conf->msg->notice(6) << "TwoStepNVTMTK randomizing thermostat DOF" << std::endl;
+        syncStateToHost();
 
         Scalar g = m_group->getTranslationalDOF();
         Scalar sigmasq_t = Scalar(1.0) / (static_cast<Scalar>(g) * m_tau * m_tau);
@@ -320,6 +330,8 @@ class MTTKThermostat : public Thermostat
                 }
 #endif
             }
+
+        syncStateToDevice();
         }
 
     protected:
@@ -328,6 +340,16 @@ class MTTKThermostat : public Thermostat
 
     /// The thermostat internal degrees of freedom.
     MTTKThermostat::state m_state {};
+
+    /** Bring m_state up to date before the host reads it.
+
+        Subclasses that keep the thermostat state elsewhere (such as in device memory) copy it into
+        m_state here.
+    */
+    virtual void syncStateToHost() { }
+
+    /// Copy m_state to the subclass's storage after the host modifies it.
+    virtual void syncStateToDevice() { }
     };
 
 /** Implement the Bussi stochastic velocity rescaling thermostat.
@@ -2,6 +2,7 @@
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
 #include "TwoStepConstantPressureGPU.cuh"
+#include "MTTKThermostatGPU.h"
 #include "TwoStepConstantPressureGPU.h"
 #include "TwoStepNVEGPU.cuh"
 
@@ -82,8 +83,18 @@ void TwoStepConstantPressureGPU::integrateStepOne(uint64_t timestep)
     Scalar mtk = exp(-Scalar(1.0 / 2.0) * m_deltaT
                      * (m_barostat.nu_xx + m_barostat.nu_yy + m_barostat.nu_zz)
                      / static_cast<Scalar>(m_ndof));
-    const auto rf = m_thermostat ? m_thermostat->getRescalingFactorsOne(timestep, m_deltaT)
-                                 : std::array<Scalar, 2> {1., 1.};
+
+    // the MTTK thermostat on the GPU provides its rescaling factors in device memory
+    auto mttk_gpu = std::dynamic_pointer_cast<MTTKThermostatGPU>(m_thermostat);
+    std::array<Scalar, 2> rf {1., 1.};
+    if (mttk_gpu)
+        {
+        mttk_gpu->computeRescalingFactors(m_deltaT);
+        }
+    else if (m_thermostat)
+        {
+        rf = m_thermostat->getRescalingFactorsOne(timestep, m_deltaT);
+        }
     std::array<Scalar, 2> rescalingFactors = {rf[0] * mtk, rf[1] * mtk};
 
     // update the propagator matrix using current barostat momenta
@@ -128,6 +139,14 @@ void TwoStepConstantPressureGPU::integrateStepOne(uint64_t timestep)
     // update the propagator matrix
     updatePropagator();
 
+    std::unique_ptr<ArrayHandle<Scalar>> d_rescale_factors;
+    if (mttk_gpu)
+        {
+        d_rescale_factors.reset(new ArrayHandle<Scalar>(mttk_gpu->getRescalingFactorsArray(),
+                                                        access_location::device,
+                                                        access_mode::read));
+        }
+
     if (m_rescale_all)
         {
         ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
@@ -186,7 +205,8 @@ void TwoStepConstantPressureGPU::integrateStepOne(uint64_t timestep)
                                          m_mat_exp_r_int,
                                          m_deltaT,
                                          m_rescale_all,
-                                         m_tuner_one->getParam()[0]);
+                                         m_tuner_one->getParam()[0],
+                                         d_rescale_factors ? d_rescale_factors->data : nullptr);
 
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
@@ -250,13 +270,16 @@ void TwoStepConstantPressureGPU::integrateStepOne(uint64_t timestep)
                                          m_group->getGPUPartition(),
                                          m_deltaT,
                                          rescalingFactors[1],
-                                         m_tuner_angular_one->getParam()[0]);
+                                         m_tuner_angular_one->getParam()[0],
+                                         d_rescale_factors ? d_rescale_factors->data + 1 : nullptr);
 
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
         m_tuner_angular_one->end();
         m_exec_conf->endMultiGPU();
         }
+    d_rescale_factors.reset();
+
     if (m_thermostat)
         {
         m_thermostat->advanceThermostat(timestep, m_deltaT, m_aniso);
@@ -282,9 +305,27 @@ void TwoStepConstantPressureGPU::integrateStepTwo(uint64_t timestep)
     Scalar mtk = exp(-Scalar(1.0 / 2.0) * m_deltaT
                      * (m_barostat.nu_xx + m_barostat.nu_yy + m_barostat.nu_zz)
                      / static_cast<Scalar>(m_ndof));
-    const auto rf = m_thermostat ? m_thermostat->getRescalingFactorsTwo(timestep, m_deltaT)
-                                 : std::array<Scalar, 2> {1., 1.};
+
+    auto mttk_gpu = std::dynamic_pointer_cast<MTTKThermostatGPU>(m_thermostat);
+    std::array<Scalar, 2> rf {1., 1.};
+    if (mttk_gpu)
+        {
+        mttk_gpu->computeRescalingFactors(m_deltaT);
+        }
+    else if (m_thermostat)
+        {
+        rf = m_thermostat->getRescalingFactorsTwo(timestep, m_deltaT);
+        }
     std::array<Scalar, 2> rescalingFactors = {rf[0] * mtk, rf[1] * mtk};
+
+    std::unique_ptr<ArrayHandle<Scalar>> d_rescale_factors;
+    if (mttk_gpu)
+        {
+        d_rescale_factors.reset(new ArrayHandle<Scalar>(mttk_gpu->getRescalingFactorsArray(),
+                                                        access_location::device,
+                                                        access_mode::read));
+        }
+
         {
         ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
                                    access_location::device,
@@ -313,7 +354,8 @@ void TwoStepConstantPressureGPU::integrateStepTwo(uint64_t timestep)
                                          m_mat_exp_v,
                                          m_deltaT,
                                          rescalingFactors[0], // exp_thermo_fac,
-                                         m_tuner_two->getParam()[0]);
+                                         m_tuner_two->getParam()[0],
+                                         d_rescale_factors ? d_rescale_factors->data : nullptr);
 
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
@@ -354,7 +396,8 @@ void TwoStepConstantPressureGPU::integrateStepTwo(uint64_t timestep)
                                          m_group->getGPUPartition(),
                                          m_deltaT,
                                          rescalingFactors[1], // exp_thermo_fac_rot,
-                                         m_tuner_angular_two->getParam()[0]);
+                                         m_tuner_angular_two->getParam()[0],
+                                         d_rescale_factors ? d_rescale_factors->data + 1 : nullptr);
 
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
@@ -362,6 +405,7 @@ void TwoStepConstantPressureGPU::integrateStepTwo(uint64_t timestep)
         m_tuner_angular_two->end();
         m_exec_conf->endMultiGPU();
         }
+    d_rescale_factors.reset();
 
     // advance barostat (m_barostat.nu_xx, m_barostat.nu_yy, m_barostat.nu_zz) half a time step
     advanceBarostat(timestep + 1);
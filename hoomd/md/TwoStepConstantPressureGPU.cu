@@ -48,7 +48,8 @@ __global__ void gpu_npt_mtk_step_one_kernel(Scalar4* d_pos,
                                             Scalar mat_exp_r_int_yz,
                                             Scalar mat_exp_r_int_zz,
                                             Scalar deltaT,
-                                            bool rescale_all)
+                                            bool rescale_all,
+                                            const Scalar* d_rescale_factors)
     {
     // determine which particle this thread works on
     int work_idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -56,6 +57,11 @@ __global__ void gpu_npt_mtk_step_one_kernel(Scalar4* d_pos,
     // initialize eigenvectors
     if (work_idx < nwork)
         {
+        if (d_rescale_factors)
+            {
+            thermo_rescale *= d_rescale_factors[0];
+            }
+
         const unsigned int group_idx = work_idx + offset;
         unsigned int idx = d_group_members[group_idx];
 
@@ -111,6 +117,8 @@ __global__ void gpu_npt_mtk_step_one_kernel(Scalar4* d_pos,
     \param deltaT Time to advance (for one full step)
     \param deltaT Time to move forward in one whole step
     \param rescale_all True if all particles in the system should be rescaled at once
+    \param d_rescale_factors Thermostat rescaling factors in device memory that multiply
+        \a thermo_rescale, or null
 
     This is just a kernel driver for gpu_npt_mtk_step_one_kernel(). See it for more details.
 */
@@ -125,7 +133,8 @@ hipError_t gpu_npt_rescale_step_one(Scalar4* d_pos,
                                     Scalar* mat_exp_r_int,
                                     Scalar deltaT,
                                     bool rescale_all,
-                                    const unsigned int block_size)
+                                    const unsigned int block_size,
+                                    const Scalar* d_rescale_factors)
     {
     unsigned int max_block_size;
     hipFuncAttributes attr;
@@ -177,7 +186,8 @@ hipError_t gpu_npt_rescale_step_one(Scalar4* d_pos,
                            mat_exp_r_int[4],
                            mat_exp_r_int[5],
                            deltaT,
-                           rescale_all);
+                           rescale_all,
+                           d_rescale_factors);
         }
 
     return hipSuccess;
@@ -281,13 +291,19 @@ __global__ void gpu_npt_mtk_step_two_kernel(Scalar4* d_vel,
                                             Scalar mat_exp_v_yz,
                                             Scalar mat_exp_v_zz,
                                             Scalar deltaT,
-                                            Scalar thermo_rescale)
+                                            Scalar thermo_rescale,
+                                            const Scalar* d_rescale_factors)
     {
     // determine which particle this thread works on
     int work_idx = blockIdx.x * blockDim.x + threadIdx.x;
 
     if (work_idx < nwork)
         {
+        if (d_rescale_factors)
+            {
+            thermo_rescale *= d_rescale_factors[0];
+            }
+
         const unsigned int group_idx = work_idx + offset;
         unsigned int idx = d_group_members[group_idx];
 
@@ -329,6 +345,8 @@ __global__ void gpu_npt_mtk_step_two_kernel(Scalar4* d_vel,
     \param d_net_force Net force on each particle
 
     \param deltaT Time to move forward in one whole step
+    \param d_rescale_factors Thermostat rescaling factors in device memory that multiply
+        \a thermo_rescale, or null
 
     This is just a kernel driver for gpu_npt_mtk_step_kernel(). See it for more details.
 */
@@ -340,7 +358,8 @@ hipError_t gpu_npt_rescale_step_two(Scalar4* d_vel,
                                     Scalar* mat_exp_v,
                                     Scalar deltaT,
                                     Scalar thermo_rescale,
-                                    const unsigned int block_size)
+                                    const unsigned int block_size,
+                                    const Scalar* d_rescale_factors)
     {
     unsigned int max_block_size;
     hipFuncAttributes attr;
@@ -379,7 +398,8 @@ hipError_t gpu_npt_rescale_step_two(Scalar4* d_vel,
                            mat_exp_v[4],
                            mat_exp_v[5],
                            deltaT,
-                           thermo_rescale);
+                           thermo_rescale,
+                           d_rescale_factors);
         }
 
     return hipSuccess;
@@ -33,7 +33,8 @@ hipError_t gpu_npt_rescale_step_one(Scalar4* d_pos,
                                     Scalar* mat_exp_r_int,
                                     Scalar deltaT,
                                     bool rescale_all,
-                                    const unsigned int block_size);
+                                    const unsigned int block_size,
+                                    const Scalar* d_rescale_factors = nullptr);
 
 //! Kernel driver for wrapping particles back in the box (part of first step)
 hipError_t gpu_npt_rescale_wrap(const GPUPartition& gpu_partition,
@@ -51,7 +52,8 @@ hipError_t gpu_npt_rescale_step_two(Scalar4* d_vel,
                                     Scalar* mat_exp_v,
                                     Scalar deltaT,
                                     Scalar thermo_rescale,
-                                    const unsigned int block_size);
+                                    const unsigned int block_size,
+                                    const Scalar* d_rescale_factors = nullptr);
 
 //! Rescale all positions
 void gpu_npt_rescale_rescale(const GPUPartition& gpu_partition,
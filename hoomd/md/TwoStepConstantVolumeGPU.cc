@@ -2,8 +2,8 @@
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
 #include "TwoStepConstantVolumeGPU.h"
+#include "MTTKThermostatGPU.h"
 #include "TwoStepConstantVolumeGPU.cuh"
-#include "TwoStepNVEGPU.cuh"
 #ifdef ENABLE_MPI
 #include "hoomd/Communicator.h"
 #include "hoomd/HOOMDMPI.h"
@@ -11,6 +11,40 @@
 
 namespace hoomd::md
     {
+namespace
+    {
+/// Device access to the angular degrees of freedom for the fused NVT kernels
+struct AngularHandles
+    {
+    /** @param pdata Particle data
+        @param orientation_mode Access mode for the orientations
+    */
+    AngularHandles(ParticleData& pdata, access_mode::Enum orientation_mode)
+        : orientation(pdata.getOrientationArray(), access_location::device, orientation_mode),
+          angmom(pdata.getAngularMomentumArray(), access_location::device, access_mode::readwrite),
+          net_torque(pdata.getNetTorqueArray(), access_location::device, access_mode::read),
+          inertia(pdata.getMomentsOfInertiaArray(), access_location::device, access_mode::read)
+        {
+        }
+
+    /// Get the arrays to pass to the kernel drivers
+    kernel::nvt_angular_arrays getArrays(Scalar rescale_factor) const
+        {
+        kernel::nvt_angular_arrays arrays;
+        arrays.d_orientation = orientation.data;
+        arrays.d_angmom = angmom.data;
+        arrays.d_inertia = inertia.data;
+        arrays.d_net_torque = net_torque.data;
+        arrays.rescale_factor = rescale_factor;
+        return arrays;
+        }
+
+    ArrayHandle<Scalar4> orientation;
+    ArrayHandle<Scalar4> angmom;
+    ArrayHandle<Scalar4> net_torque;
+    ArrayHandle<Scalar3> inertia;
+    };
+    } // end namespace
 
 TwoStepConstantVolumeGPU::TwoStepConstantVolumeGPU(std::shared_ptr<SystemDefinition> sysdef,
                                                    std::shared_ptr<ParticleGroup> group,
@@ -29,18 +63,7 @@ TwoStepConstantVolumeGPU::TwoStepConstantVolumeGPU(std::shared_ptr<SystemDefinit
     m_tuner_two.reset(new Autotuner<1>({AutotunerBase::makeBlockSizeRange(m_exec_conf)},
                                        m_exec_conf,
                                        "nvt_mtk_step_two"));
-    m_tuner_angular_one.reset(new Autotuner<1>({AutotunerBase::makeBlockSizeRange(m_exec_conf)},
-                                               m_exec_conf,
-                                               "nvt_mtk_angular_one",
-                                               5,
-                                               true));
-    m_tuner_angular_two.reset(new Autotuner<1>({AutotunerBase::makeBlockSizeRange(m_exec_conf)},
-                                               m_exec_conf,
-                                               "nvt_mtk_angular_two",
-                                               5,
-                                               true));
-    m_autotuners.insert(m_autotuners.end(),
-                        {m_tuner_one, m_tuner_two, m_tuner_angular_one, m_tuner_angular_two});
+    m_autotuners.insert(m_autotuners.end(), {m_tuner_one, m_tuner_two});
     }
 
 void TwoStepConstantVolumeGPU::integrateStepOne(uint64_t timestep)
@@ -51,9 +74,19 @@ void TwoStepConstantVolumeGPU::integrateStepOne(uint64_t timestep)
         }
 
     unsigned int group_size = m_group->getNumMembers();
-    const auto&& rescalingFactors = m_thermostat
-                                        ? m_thermostat->getRescalingFactorsOne(timestep, m_deltaT)
-                                        : std::array<Scalar, 2> {1., 1.};
+
+    // the MTTK thermostat on the GPU provides the rescaling factors in device memory
+    auto mttk_gpu = std::dynamic_pointer_cast<MTTKThermostatGPU>(m_thermostat);
+    std::array<Scalar, 2> rescalingFactors {1., 1.};
+    if (mttk_gpu)
+        {
+        mttk_gpu->computeRescalingFactors(m_deltaT);
+        }
+    else if (m_thermostat)
+        {
+        rescalingFactors = m_thermostat->getRescalingFactorsOne(timestep, m_deltaT);
+        }
+
         {
         // access all the needed data
         ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
@@ -73,9 +106,27 @@ void TwoStepConstantVolumeGPU::integrateStepOne(uint64_t timestep)
         ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(),
                                                 access_location::device,
                                                 access_mode::read);
+        const bool contiguous = m_group->isContiguous();
+
+        // angular degrees of freedom, integrated in the same kernel
+        std::unique_ptr<AngularHandles> angular_handles;
+        kernel::nvt_angular_arrays angular;
+        if (m_aniso)
+            {
+            angular_handles.reset(new AngularHandles(*m_pdata, access_mode::readwrite));
+            angular = angular_handles->getArrays(rescalingFactors[1]);
+            }
 
         auto limits = getKernelLimitValues(timestep);
 
+        std::unique_ptr<ArrayHandle<Scalar>> d_rescale_factors;
+        if (mttk_gpu)
+            {
+            d_rescale_factors.reset(new ArrayHandle<Scalar>(mttk_gpu->getRescalingFactorsArray(),
+                                                            access_location::device,
+                                                            access_mode::read));
+            }
+
         m_exec_conf->beginMultiGPU();
 
         // perform the update on the GPU
@@ -84,7 +135,7 @@ void TwoStepConstantVolumeGPU::integrateStepOne(uint64_t timestep)
                                          d_vel.data,
                                          d_accel.data,
                                          d_image.data,
-                                         d_index_array.data,
+                                         contiguous ? nullptr : d_index_array.data,
                                          group_size,
                                          box,
                                          m_tuner_one->getParam()[0],
@@ -92,49 +143,25 @@ void TwoStepConstantVolumeGPU::integrateStepOne(uint64_t timestep)
                                          m_deltaT,
                                          m_group->getGPUPartition(),
                                          limits.first,
-                                         limits.second);
+                                         limits.second,
+                                         angular,
+                                         d_rescale_factors ? d_rescale_factors->data : nullptr,
+                                         m_group->getFirstIndex());
 
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
-        m_tuner_one->end();
-
-        m_exec_conf->endMultiGPU();
-        }
 
-    if (m_aniso)
-        {
-        // angular degrees of freedom, step one
-        ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
-                                           access_location::device,
-                                           access_mode::readwrite);
-        ArrayHandle<Scalar4> d_angmom(m_pdata->getAngularMomentumArray(),
-                                      access_location::device,
-                                      access_mode::readwrite);
-        ArrayHandle<Scalar4> d_net_torque(m_pdata->getNetTorqueArray(),
-                                          access_location::device,
-                                          access_mode::read);
-        ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(),
-                                       access_location::device,
-                                       access_mode::read);
-        ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(),
-                                                access_location::device,
-                                                access_mode::read);
-
-        m_exec_conf->beginMultiGPU();
-        m_tuner_angular_one->begin();
-        kernel::gpu_nve_angular_step_one(d_orientation.data,
-                                         d_angmom.data,
-                                         d_inertia.data,
-                                         d_net_torque.data,
-                                         d_index_array.data,
-                                         m_group->getGPUPartition(),
-                                         m_deltaT,
-                                         rescalingFactors[1],
-                                         m_tuner_angular_one->getParam()[0]);
+        // index, read and write position, velocity, and image, read acceleration
+        uint64_t bytes_per_member = (contiguous ? 0 : sizeof(unsigned int))
+                                    + 2 * sizeof(Scalar4) * 2 + 2 * sizeof(int3) + sizeof(Scalar3);
+        if (m_aniso)
+            {
+            // read and write orientation and angular momentum, read torque and inertia
+            bytes_per_member += 2 * sizeof(Scalar4) * 2 + sizeof(Scalar4) + sizeof(Scalar3);
+            }
+        m_tuner_one->setBytes(bytes_per_member * group_size);
+        m_tuner_one->end();
 
-        if (m_exec_conf->isCUDAErrorCheckingEnabled())
-            CHECK_CUDA_ERROR();
-        m_tuner_angular_one->end();
         m_exec_conf->endMultiGPU();
         }
 
@@ -154,73 +181,73 @@ void TwoStepConstantVolumeGPU::integrateStepTwo(uint64_t timestep)
     ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(),
                                             access_location::device,
                                             access_mode::read);
-    const auto&& rescalingFactors = m_thermostat
-                                        ? m_thermostat->getRescalingFactorsTwo(timestep, m_deltaT)
-                                        : std::array<Scalar, 2> {1., 1.};
+    const bool contiguous = m_group->isContiguous();
 
+    auto mttk_gpu = std::dynamic_pointer_cast<MTTKThermostatGPU>(m_thermostat);
+    std::array<Scalar, 2> rescalingFactors {1., 1.};
+    std::unique_ptr<ArrayHandle<Scalar>> d_rescale_factors;
+    if (mttk_gpu)
         {
-        ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
-                                   access_location::device,
-                                   access_mode::readwrite);
-        ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(),
-                                     access_location::device,
-                                     access_mode::readwrite);
-        ArrayHandle<Scalar4> d_net_force(net_force, access_location::device, access_mode::read);
+        mttk_gpu->computeRescalingFactors(m_deltaT);
+        d_rescale_factors.reset(new ArrayHandle<Scalar>(mttk_gpu->getRescalingFactorsArray(),
+                                                        access_location::device,
+                                                        access_mode::read));
+        }
+    else if (m_thermostat)
+        {
+        rescalingFactors = m_thermostat->getRescalingFactorsTwo(timestep, m_deltaT);
+        }
 
-        m_exec_conf->beginMultiGPU();
+    ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                               access_location::device,
+                               access_mode::readwrite);
+    ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(),
+                                 access_location::device,
+                                 access_mode::readwrite);
+    ArrayHandle<Scalar4> d_net_force(net_force, access_location::device, access_mode::read);
 
-        // perform the update on the GPU
-        m_tuner_two->begin();
-        kernel::gpu_nvt_rescale_step_two(d_vel.data,
-                                         d_accel.data,
-                                         d_index_array.data,
-                                         group_size,
-                                         d_net_force.data,
-                                         m_tuner_two->getParam()[0],
-                                         m_deltaT,
-                                         rescalingFactors[0],
-                                         m_group->getGPUPartition());
+    // angular degrees of freedom, integrated in the same kernel
+    std::unique_ptr<AngularHandles> angular_handles;
+    kernel::nvt_angular_arrays angular;
+    if (m_aniso)
+        {
+        angular_handles.reset(new AngularHandles(*m_pdata, access_mode::read));
+        angular = angular_handles->getArrays(rescalingFactors[1]);
+        }
 
-        if (m_exec_conf->isCUDAErrorCheckingEnabled())
-            CHECK_CUDA_ERROR();
-        m_tuner_two->end();
+    m_exec_conf->beginMultiGPU();
 
-        m_exec_conf->endMultiGPU();
-        }
+    // perform the update on the GPU
+    m_tuner_two->begin();
+    kernel::gpu_nvt_rescale_step_two(d_vel.data,
+                                     d_accel.data,
+                                     contiguous ? nullptr : d_index_array.data,
+                                     group_size,
+                                     d_net_force.data,
+                                     m_tuner_two->getParam()[0],
+                                     m_deltaT,
+                                     rescalingFactors[0],
+                                     m_group->getGPUPartition(),
+                                     angular,
+                                     d_rescale_factors ? d_rescale_factors->data : nullptr,
+                                     m_group->getFirstIndex());
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
 
+    // index, read and write velocity, write acceleration, read net force
+    uint64_t bytes_per_member = (contiguous ? 0 : sizeof(unsigned int)) + 2 * sizeof(Scalar4)
+                                + sizeof(Scalar3) + sizeof(Scalar4);
     if (m_aniso)
         {
-        // second part of angular update
-        ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
-                                           access_location::device,
-                                           access_mode::read);
-        ArrayHandle<Scalar4> d_angmom(m_pdata->getAngularMomentumArray(),
-                                      access_location::device,
-                                      access_mode::readwrite);
-        ArrayHandle<Scalar4> d_net_torque(m_pdata->getNetTorqueArray(),
-                                          access_location::device,
-                                          access_mode::read);
-        ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(),
-                                       access_location::device,
-                                       access_mode::read);
-
-        m_exec_conf->beginMultiGPU();
-        m_tuner_angular_two->begin();
-        kernel::gpu_nve_angular_step_two(d_orientation.data,
-                                         d_angmom.data,
-                                         d_inertia.data,
-                                         d_net_torque.data,
-                                         d_index_array.data,
-                                         m_group->getGPUPartition(),
-                                         m_deltaT,
-                                         rescalingFactors[1],
-                                         m_tuner_angular_two->getParam()[0]);
-
-        if (m_exec_conf->isCUDAErrorCheckingEnabled())
-            CHECK_CUDA_ERROR();
-        m_tuner_angular_two->end();
-        m_exec_conf->endMultiGPU();
+        // read orientation, torque, and inertia, read and write angular momentum
+        bytes_per_member += sizeof(Scalar4) + 2 * sizeof(Scalar4) + sizeof(Scalar4)
+                            + sizeof(Scalar3);
         }
+    m_tuner_two->setBytes(bytes_per_member * group_size);
+    m_tuner_two->end();
+
+    m_exec_conf->endMultiGPU();
     }
     } // namespace hoomd::md
 
@@ -2,6 +2,7 @@
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
 #include "TwoStepConstantVolumeGPU.cuh"
+#include "TwoStepNVEGPU.cuh"
 #include "hip/hip_runtime.h"
 #include <assert.h>
 
@@ -26,12 +27,17 @@ namespace kernel
     \param rescale_factor Velocity rescaling factor from thermostat
     \param deltaT Amount of real time to step forward in one time step
     \param offset The offset of this GPU into the list of particles
+    \param angular Angular degrees of freedom to integrate in the same pass
+    \param d_rescale_factors Translational and rotational rescaling factors in device memory, used
+        in place of \a rescale_factor and \a angular.rescale_factor when not null
+    \param first_index Index of the first member when the members are contiguous
 
     Take the first half step forward in the NVT integration.
 
     See gpu_nve_step_one_kernel() for some performance notes on how to handle the group data reads
    efficiently.
 */
+template<bool aniso, bool contiguous>
 __global__ void gpu_nvt_rescale_step_one_kernel(Scalar4* d_pos,
                                                 Scalar4* d_vel,
                                                 const Scalar3* d_accel,
@@ -42,15 +48,25 @@ __global__ void gpu_nvt_rescale_step_one_kernel(Scalar4* d_pos,
                                                 Scalar rescale_factor,
                                                 Scalar deltaT,
                                                 unsigned int offset,
-                                                bool limit = false,
-                                                Scalar maximum_displacement = Scalar(0.))
+                                                bool limit,
+                                                Scalar maximum_displacement,
+                                                nvt_angular_arrays angular,
+                                                const Scalar* d_rescale_factors,
+                                                unsigned int first_index)
     {
     // determine which particle this thread works on
     int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
 
     if (group_idx < work_size)
         {
-        unsigned int idx = d_group_members[group_idx + offset];
+        if (d_rescale_factors)
+            {
+            rescale_factor = d_rescale_factors[0];
+            angular.rescale_factor = d_rescale_factors[1];
+            }
+
+        unsigned int idx = contiguous ? first_index + group_idx + offset
+                                      : d_group_members[group_idx + offset];
 
         // update positions to the next timestep and update velocities to the next half step
         Scalar4 postype = d_pos[idx];
@@ -85,6 +101,19 @@ __global__ void gpu_nvt_rescale_step_one_kernel(Scalar4* d_pos,
         d_pos[idx] = make_scalar4(pos.x, pos.y, pos.z, postype.w);
         d_vel[idx] = make_scalar4(vel.x, vel.y, vel.z, velmass.w);
         d_image[idx] = image;
+
+        if (aniso)
+            {
+            quat<Scalar> q(angular.d_orientation[idx]);
+            quat<Scalar> p(angular.d_angmom[idx]);
+            vec3<Scalar> t(angular.d_net_torque[idx]);
+            vec3<Scalar> I(angular.d_inertia[idx]);
+
+            nve_angular_step_one(q, p, t, I, deltaT, angular.rescale_factor);
+
+            angular.d_orientation[idx] = quat_to_scalar4(q);
+            angular.d_angmom[idx] = quat_to_scalar4(p);
+            }
         }
     }
 
@@ -98,6 +127,12 @@ __global__ void gpu_nvt_rescale_step_one_kernel(Scalar4* d_pos,
     \param block_size Size of the block to run
     \param rescale_factor Thermostat rescaling factor
     \param deltaT Amount of real time to step forward in one time step
+    \param angular Angular degrees of freedom to integrate in the same pass, or all null
+    \param d_rescale_factors Thermostat rescaling factors in device memory, or null
+    \param first_index Index of the first member when \a d_group_members is null
+
+    When \a d_group_members is null, the members are the contiguous indices starting at
+    \a first_index and the kernel does not read an index list.
 */
 hipError_t gpu_nvt_rescale_step_one(Scalar4* d_pos,
                                     Scalar4* d_vel,
@@ -111,11 +146,23 @@ hipError_t gpu_nvt_rescale_step_one(Scalar4* d_pos,
                                     Scalar deltaT,
                                     const GPUPartition& gpu_partition,
                                     bool use_limit,
-                                    Scalar maximum_displacement)
+                                    Scalar maximum_displacement,
+                                    const nvt_angular_arrays& angular,
+                                    const Scalar* d_rescale_factors,
+                                    unsigned int first_index)
     {
+    const bool aniso = angular.d_angmom != nullptr;
+    auto kernel = aniso ? gpu_nvt_rescale_step_one_kernel<true, false>
+                        : gpu_nvt_rescale_step_one_kernel<false, false>;
+    if (!d_group_members)
+        {
+        kernel = aniso ? gpu_nvt_rescale_step_one_kernel<true, true>
+                       : gpu_nvt_rescale_step_one_kernel<false, true>;
+        }
+
     unsigned int max_block_size;
     hipFuncAttributes attr;
-    hipFuncGetAttributes(&attr, (const void*)gpu_nvt_rescale_step_one_kernel);
+    hipFuncGetAttributes(&attr, (const void*)kernel);
     max_block_size = attr.maxThreadsPerBlock;
 
     unsigned int run_block_size = min(block_size, max_block_size);
@@ -132,7 +179,7 @@ hipError_t gpu_nvt_rescale_step_one(Scalar4* d_pos,
         dim3 threads(run_block_size, 1, 1);
 
         // run the kernel, starting with offset range.first
-        hipLaunchKernelGGL((gpu_nvt_rescale_step_one_kernel),
+        hipLaunchKernelGGL((kernel),
                            dim3(grid),
                            dim3(threads),
                            0,
@@ -148,7 +195,10 @@ hipError_t gpu_nvt_rescale_step_one(Scalar4* d_pos,
                            deltaT,
                            range.first,
                            use_limit,
-                           maximum_displacement);
+                           maximum_displacement,
+                           angular,
+                           d_rescale_factors,
+                           first_index);
         }
 
     return hipSuccess;
@@ -162,7 +212,12 @@ hipError_t gpu_nvt_rescale_step_one(Scalar4* d_pos,
     \param d_net_force Net force on each particle
     \param deltaT Amount of real time to step forward in one time step
     \param offset The offset of this GPU into the list of particles
+    \param angular Angular degrees of freedom to integrate in the same pass
+    \param d_rescale_factors Translational and rotational rescaling factors in device memory, used
+        in place of \a rescale_factor and \a angular.rescale_factor when not null
+    \param first_index Index of the first member when the members are contiguous
 */
+template<bool aniso, bool contiguous>
 __global__ void gpu_nvt_rescale_step_two_kernel(Scalar4* d_vel,
                                                 Scalar3* d_accel,
                                                 unsigned int* d_group_members,
@@ -170,14 +225,24 @@ __global__ void gpu_nvt_rescale_step_two_kernel(Scalar4* d_vel,
                                                 Scalar4* d_net_force,
                                                 Scalar deltaT,
                                                 Scalar rescale_factor,
-                                                unsigned int offset)
+                                                unsigned int offset,
+                                                nvt_angular_arrays angular,
+                                                const Scalar* d_rescale_factors,
+                                                unsigned int first_index)
     {
     // determine which particle this thread works on
     int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
 
     if (group_idx < work_size)
         {
-        unsigned int idx = d_group_members[group_idx + offset];
+        if (d_rescale_factors)
+            {
+            rescale_factor = d_rescale_factors[0];
+            angular.rescale_factor = d_rescale_factors[1];
+            }
+
+        unsigned int idx = contiguous ? first_index + group_idx + offset
+                                      : d_group_members[group_idx + offset];
 
         // read in the net force and calculate the acceleration
         Scalar4 net_force = d_net_force[idx];
@@ -200,6 +265,18 @@ __global__ void gpu_nvt_rescale_step_two_kernel(Scalar4* d_vel,
 
         // since we calculate the acceleration, we need to write it for the next step
         d_accel[idx] = accel;
+
+        if (aniso)
+            {
+            quat<Scalar> q(angular.d_orientation[idx]);
+            quat<Scalar> p(angular.d_angmom[idx]);
+            vec3<Scalar> t(angular.d_net_torque[idx]);
+            vec3<Scalar> I(angular.d_inertia[idx]);
+
+            nve_angular_step_two(q, p, t, I, deltaT, angular.rescale_factor);
+
+            angular.d_angmom[idx] = quat_to_scalar4(p);
+            }
         }
     }
 
@@ -211,6 +288,12 @@ __global__ void gpu_nvt_rescale_step_two_kernel(Scalar4* d_vel,
     \param block_size Size of the block to execute on the device
     \param deltaT Amount of real time to step forward in one time step
     \param rescale_factor Exponential velocity scaling factor
+    \param angular Angular degrees of freedom to integrate in the same pass, or all null
+    \param d_rescale_factors Thermostat rescaling factors in device memory, or null
+    \param first_index Index of the first member when \a d_group_members is null
+
+    When \a d_group_members is null, the members are the contiguous indices starting at
+    \a first_index and the kernel does not read an index list.
 */
 hipError_t gpu_nvt_rescale_step_two(Scalar4* d_vel,
                                     Scalar3* d_accel,
@@ -220,11 +303,23 @@ hipError_t gpu_nvt_rescale_step_two(Scalar4* d_vel,
                                     unsigned int block_size,
                                     Scalar deltaT,
                                     Scalar rescale_factor,
-                                    const GPUPartition& gpu_partition)
+                                    const GPUPartition& gpu_partition,
+                                    const nvt_angular_arrays& angular,
+                                    const Scalar* d_rescale_factors,
+                                    unsigned int first_index)
     {
+    const bool aniso = angular.d_angmom != nullptr;
+    auto kernel = aniso ? gpu_nvt_rescale_step_two_kernel<true, false>
+                        : gpu_nvt_rescale_step_two_kernel<false, false>;
+    if (!d_group_members)
+        {
+        kernel = aniso ? gpu_nvt_rescale_step_two_kernel<true, true>
+                       : gpu_nvt_rescale_step_two_kernel<false, true>;
+        }
+
     unsigned int max_block_size;
     hipFuncAttributes attr;
-    hipFuncGetAttributes(&attr, (const void*)gpu_nvt_rescale_step_two_kernel);
+    hipFuncGetAttributes(&attr, (const void*)kernel);
     max_block_size = attr.maxThreadsPerBlock;
 
     unsigned int run_block_size = min(block_size, max_block_size);
@@ -241,7 +336,7 @@ hipError_t gpu_nvt_rescale_step_two(Scalar4* d_vel,
         dim3 threads(run_block_size, 1, 1);
 
         // run the kernel
-        hipLaunchKernelGGL((gpu_nvt_rescale_step_two_kernel),
+        hipLaunchKernelGGL((kernel),
                            dim3(grid),
                            dim3(threads),
                            0,
@@ -253,7 +348,10 @@ hipError_t gpu_nvt_rescale_step_two(Scalar4* d_vel,
                            d_net_force,
                            deltaT,
                            rescale_factor,
-                           range.first);
+                           range.first,
+                           angular,
+                           d_rescale_factors,
+                           first_index);
         }
 
     return hipSuccess;
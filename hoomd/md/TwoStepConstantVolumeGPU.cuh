@@ -14,6 +14,16 @@ namespace md
     {
 namespace kernel
     {
+//! Angular degrees of freedom updated by the NVT kernels in the same pass as the translational ones
+struct nvt_angular_arrays
+    {
+    Scalar4* d_orientation = nullptr;      //!< Particle orientations
+    Scalar4* d_angmom = nullptr;           //!< Conjugate quaternions, null to skip the update
+    const Scalar3* d_inertia = nullptr;    //!< Principal moments of inertia
+    const Scalar4* d_net_torque = nullptr; //!< Net torques
+    Scalar rescale_factor = Scalar(1.0);   //!< Thermostat rescaling factor for the rotations
+    };
+
 //! Kernel driver for the first part of the NVT update called by TwoStepNVTGPU
 hipError_t gpu_nvt_rescale_step_one(Scalar4* d_pos,
                                     Scalar4* d_vel,
@@ -27,7 +37,10 @@ hipError_t gpu_nvt_rescale_step_one(Scalar4* d_pos,
                                     Scalar deltaT,
                                     const GPUPartition& gpu_partition,
                                     bool limit = false,
-                                    Scalar limit_displacement = Scalar(0.));
+                                    Scalar limit_displacement = Scalar(0.),
+                                    const nvt_angular_arrays& angular = nvt_angular_arrays(),
+                                    const Scalar* d_rescale_factors = nullptr,
+                                    unsigned int first_index = 0);
 
 //! Kernel driver for the second part of the NVT update called by NVTUpdaterGPU
 hipError_t gpu_nvt_rescale_step_two(Scalar4* d_vel,
@@ -38,7 +51,10 @@ hipError_t gpu_nvt_rescale_step_two(Scalar4* d_vel,
                                     unsigned int block_size,
                                     Scalar deltaT,
                                     Scalar rescale_factor,
-                                    const GPUPartition& gpu_partition);
+                                    const GPUPartition& gpu_partition,
+                                    const nvt_angular_arrays& angular = nvt_angular_arrays(),
+                                    const Scalar* d_rescale_factors = nullptr,
+                                    unsigned int first_index = 0);
 
     }  // end namespace kernel
     }  // end namespace md
@@ -26,17 +26,11 @@ class PYBIND11_EXPORT TwoStepConstantVolumeGPU : public TwoStepConstantVolume
     virtual void integrateStepTwo(uint64_t timestep);
 
     protected:
-    /// Autotuner for block size (step one kernel).
+    /// Autotuner for block size (step one kernel, including the angular update).
     std::shared_ptr<Autotuner<1>> m_tuner_one;
 
-    /// Autotuner for block size (step two kernel).
+    /// Autotuner for block size (step two kernel, including the angular update).
     std::shared_ptr<Autotuner<1>> m_tuner_two;
-
-    /// Autotuner_angular for block size (angular step one kernel).
-    std::shared_ptr<Autotuner<1>> m_tuner_angular_one;
-
-    /// Autotuner_angular for block size (angular step two kernel).
-    std::shared_ptr<Autotuner<1>> m_tuner_angular_two;
     };
     }  // namespace hoomd::md
 #endif // HOOMD_TWOSTEPCONSTANTVOLUMEGPU_H
@@ -196,13 +196,19 @@ __global__ void gpu_nve_angular_step_one_kernel(Scalar4* d_orientation,
                                                 const unsigned int nwork,
                                                 const unsigned int offset,
                                                 Scalar deltaT,
-                                                Scalar scale)
+                                                Scalar scale,
+                                                const Scalar* d_scale)
     {
     // determine which particle this thread works on (MEM TRANSFER: 4 bytes)
     int work_idx = blockIdx.x * blockDim.x + threadIdx.x;
 
     if (work_idx < nwork)
         {
+        if (d_scale)
+            {
+            scale *= *d_scale;
+            }
+
         const unsigned int group_idx = work_idx + offset;
         unsigned int idx = d_group_members[group_idx];
 
@@ -212,96 +218,7 @@ __global__ void gpu_nve_angular_step_one_kernel(Scalar4* d_orientation,
         vec3<Scalar> t(d_net_torque[idx]);
         vec3<Scalar> I(d_inertia[idx]);
 
-        // rotate torque into principal frame
-        t = rotate(conj(q), t);
-
-        // check for zero moment of inertia
-        bool x_zero, y_zero, z_zero;
-        x_zero = (I.x == 0);
-        y_zero = (I.y == 0);
-        z_zero = (I.z == 0);
-
-        // ignore torque component along an axis for which the moment of inertia zero
-        if (x_zero)
-            t.x = Scalar(0.0);
-        if (y_zero)
-            t.y = Scalar(0.0);
-        if (z_zero)
-            t.z = Scalar(0.0);
-
-        // advance p(t)->p(t+deltaT/2), q(t)->q(t+deltaT)
-        p += deltaT * q * t;
-
-        p = p * scale;
-
-        quat<Scalar> p1, p2, p3; // permutated quaternions
-        quat<Scalar> q1, q2, q3;
-        Scalar phi1, cphi1, sphi1;
-        Scalar phi2, cphi2, sphi2;
-        Scalar phi3, cphi3, sphi3;
-
-        if (!z_zero)
-            {
-            p3 = quat<Scalar>(-p.v.z, vec3<Scalar>(p.v.y, -p.v.x, p.s));
-            q3 = quat<Scalar>(-q.v.z, vec3<Scalar>(q.v.y, -q.v.x, q.s));
-            phi3 = Scalar(1. / 4.) / I.z * dot(p, q3);
-            cphi3 = slow::cos(Scalar(1. / 2.) * deltaT * phi3);
-            sphi3 = slow::sin(Scalar(1. / 2.) * deltaT * phi3);
-
-            p = cphi3 * p + sphi3 * p3;
-            q = cphi3 * q + sphi3 * q3;
-            }
-
-        if (!y_zero)
-            {
-            p2 = quat<Scalar>(-p.v.y, vec3<Scalar>(-p.v.z, p.s, p.v.x));
-            q2 = quat<Scalar>(-q.v.y, vec3<Scalar>(-q.v.z, q.s, q.v.x));
-            phi2 = Scalar(1. / 4.) / I.y * dot(p, q2);
-            cphi2 = slow::cos(Scalar(1. / 2.) * deltaT * phi2);
-            sphi2 = slow::sin(Scalar(1. / 2.) * deltaT * phi2);
-
-            p = cphi2 * p + sphi2 * p2;
-            q = cphi2 * q + sphi2 * q2;
-            }
-
-        if (!x_zero)
-            {
-            p1 = quat<Scalar>(-p.v.x, vec3<Scalar>(p.s, p.v.z, -p.v.y));
-            q1 = quat<Scalar>(-q.v.x, vec3<Scalar>(q.s, q.v.z, -q.v.y));
-            phi1 = Scalar(1. / 4.) / I.x * dot(p, q1);
-            cphi1 = slow::cos(deltaT * phi1);
-            sphi1 = slow::sin(deltaT * phi1);
-
-            p = cphi1 * p + sphi1 * p1;
-            q = cphi1 * q + sphi1 * q1;
-            }
-
-        if (!y_zero)
-            {
-            p2 = quat<Scalar>(-p.v.y, vec3<Scalar>(-p.v.z, p.s, p.v.x));
-            q2 = quat<Scalar>(-q.v.y, vec3<Scalar>(-q.v.z, q.s, q.v.x));
-            phi2 = Scalar(1. / 4.) / I.y * dot(p, q2);
-            cphi2 = slow::cos(Scalar(1. / 2.) * deltaT * phi2);
-            sphi2 = slow::sin(Scalar(1. / 2.) * deltaT * phi2);
-
-            p = cphi2 * p + sphi2 * p2;
-            q = cphi2 * q + sphi2 * q2;
-            }
-
-        if (!z_zero)
-            {
-            p3 = quat<Scalar>(-p.v.z, vec3<Scalar>(p.v.y, -p.v.x, p.s));
-            q3 = quat<Scalar>(-q.v.z, vec3<Scalar>(q.v.y, -q.v.x, q.s));
-            phi3 = Scalar(1. / 4.) / I.z * dot(p, q3);
-            cphi3 = slow::cos(Scalar(1. / 2.) * deltaT * phi3);
-            sphi3 = slow::sin(Scalar(1. / 2.) * deltaT * phi3);
-
-            p = cphi3 * p + sphi3 * p3;
-            q = cphi3 * q + sphi3 * q3;
-            }
-
-        // renormalize (improves stability)
-        q = q * (Scalar(1.0) / slow::sqrt(norm2(q)));
+        nve_angular_step_one(q, p, t, I, deltaT, scale);
 
         d_orientation[idx] = quat_to_scalar4(q);
         d_angmom[idx] = quat_to_scalar4(p);
@@ -315,6 +232,8 @@ __global__ void gpu_nve_angular_step_one_kernel(Scalar4* d_orientation,
     \param d_group_members Device array listing the indices of the members of the group to integrate
     \param group_size Number of members in the group
     \param deltaT timestep
+    \param scale Thermostat rescaling factor
+    \param d_scale Rescaling factor in device memory that multiplies \a scale, or null
 */
 hipError_t gpu_nve_angular_step_one(Scalar4* d_orientation,
                                     Scalar4* d_angmom,
@@ -324,7 +243,8 @@ hipError_t gpu_nve_angular_step_one(Scalar4* d_orientation,
                                     const GPUPartition& gpu_partition,
                                     Scalar deltaT,
                                     Scalar scale,
-                                    const unsigned int block_size)
+                                    const unsigned int block_size,
+                                    const Scalar* d_scale)
     {
     unsigned int max_block_size;
     hipFuncAttributes attr;
@@ -358,7 +278,8 @@ hipError_t gpu_nve_angular_step_one(Scalar4* d_orientation,
                            nwork,
                            range.first,
                            deltaT,
-                           scale);
+                           scale,
+                           d_scale);
         }
 
     return hipSuccess;
@@ -520,13 +441,19 @@ __global__ void gpu_nve_angular_step_two_kernel(const Scalar4* d_orientation,
                                                 const unsigned int nwork,
                                                 const unsigned int offset,
                                                 Scalar deltaT,
-                                                Scalar scale)
+                                                Scalar scale,
+                                                const Scalar* d_scale)
     {
     // determine which particle this thread works on (MEM TRANSFER: 4 bytes)
     int work_idx = blockIdx.x * blockDim.x + threadIdx.x;
 
     if (work_idx < nwork)
         {
+        if (d_scale)
+            {
+            scale *= *d_scale;
+            }
+
         const unsigned int group_idx = work_idx + offset;
         unsigned int idx = d_group_members[group_idx];
 
@@ -536,28 +463,7 @@ __global__ void gpu_nve_angular_step_two_kernel(const Scalar4* d_orientation,
         vec3<Scalar> t(d_net_torque[idx]);
         vec3<Scalar> I(d_inertia[idx]);
 
-        // rotate torque into principal frame
-        t = rotate(conj(q), t);
-
-        // check for zero moment of inertia
-        bool x_zero, y_zero, z_zero;
-        x_zero = (I.x == 0);
-        y_zero = (I.y == 0);
-        z_zero = (I.z == 0);
-
-        // ignore torque component along an axis for which the moment of inertia zero
-        if (x_zero)
-            t.x = Scalar(0.0);
-        if (y_zero)
-            t.y = Scalar(0.0);
-        if (z_zero)
-            t.z = Scalar(0.0);
-
-        // rescale
-        p = p * scale;
-
-        // advance p(t)->p(t+deltaT/2), q(t)->q(t+deltaT)
-        p += deltaT * q * t;
+        nve_angular_step_two(q, p, t, I, deltaT, scale);
 
         d_angmom[idx] = quat_to_scalar4(p);
         }
@@ -570,6 +476,8 @@ __global__ void gpu_nve_angular_step_two_kernel(const Scalar4* d_orientation,
     \param d_group_members Device array listing the indices of the members of the group to integrate
     \param group_size Number of members in the group
     \param deltaT timestep
+    \param scale Thermostat rescaling factor
+    \param d_scale Rescaling factor in device memory that multiplies \a scale, or null
 */
 hipError_t gpu_nve_angular_step_two(const Scalar4* d_orientation,
                                     Scalar4* d_angmom,
@@ -579,7 +487,8 @@ hipError_t gpu_nve_angular_step_two(const Scalar4* d_orientation,
                                     const GPUPartition& gpu_partition,
                                     Scalar deltaT,
                                     Scalar scale,
-                                    const unsigned int block_size)
+                                    const unsigned int block_size,
+                                    const Scalar* d_scale)
     {
     unsigned int max_block_size;
     hipFuncAttributes attr;
@@ -613,7 +522,8 @@ hipError_t gpu_nve_angular_step_two(const Scalar4* d_orientation,
                            nwork,
                            range.first,
                            deltaT,
-                           scale);
+                           scale,
+                           d_scale);
         }
 
     return hipSuccess;
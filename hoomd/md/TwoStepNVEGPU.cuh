@@ -9,6 +9,10 @@
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/ParticleData.cuh"
 
+#ifdef __HIPCC__
+#include "hoomd/VectorMath.h"
+#endif
+
 #ifndef __TWO_STEP_NVE_GPU_CUH__
 #define __TWO_STEP_NVE_GPU_CUH__
 
@@ -53,7 +57,8 @@ hipError_t gpu_nve_angular_step_one(Scalar4* d_orientation,
                                     const GPUPartition& gpu_partition,
                                     Scalar deltaT,
                                     Scalar scale,
-                                    const unsigned int block_size);
+                                    const unsigned int block_size,
+                                    const Scalar* d_scale = nullptr);
 
 //! Kernel driver for the second part of the angular NVE update (NO_SQUISH) by TwoStepNVEPU
 hipError_t gpu_nve_angular_step_two(const Scalar4* d_orientation,
@@ -64,7 +69,155 @@ hipError_t gpu_nve_angular_step_two(const Scalar4* d_orientation,
                                     const GPUPartition& gpu_partition,
                                     Scalar deltaT,
                                     Scalar scale,
-                                    const unsigned int block_size);
+                                    const unsigned int block_size,
+                                    const Scalar* d_scale = nullptr);
+
+#ifdef __HIPCC__
+//! Zero the torque components along axes with a zero moment of inertia
+/*! \param q Particle orientation
+    \param t Net torque on the particle in the space frame
+    \param I Principal moments of inertia
+    \returns The torque in the principal frame
+*/
+__device__ inline vec3<Scalar>
+nve_angular_principal_torque(const quat<Scalar>& q, vec3<Scalar> t, const vec3<Scalar>& I)
+    {
+    // rotate torque into principal frame
+    t = rotate(conj(q), t);
+
+    // ignore torque component along an axis for which the moment of inertia zero
+    if (I.x == 0)
+        t.x = Scalar(0.0);
+    if (I.y == 0)
+        t.y = Scalar(0.0);
+    if (I.z == 0)
+        t.z = Scalar(0.0);
+
+    return t;
+    }
+
+//! NO_SQUISH angular part of the first half step for one particle
+/*! \param q Particle orientation, advanced to t+deltaT
+    \param p Conjugate quaternion, advanced to t+deltaT/2
+    \param t_space Net torque on the particle in the space frame
+    \param I Principal moments of inertia
+    \param deltaT timestep
+    \param scale Thermostat rescaling factor
+*/
+__device__ inline void nve_angular_step_one(quat<Scalar>& q,
+                                            quat<Scalar>& p,
+                                            const vec3<Scalar>& t_space,
+                                            const vec3<Scalar>& I,
+                                            Scalar deltaT,
+                                            Scalar scale)
+    {
+    vec3<Scalar> t = nve_angular_principal_torque(q, t_space, I);
+
+    // check for zero moment of inertia
+    bool x_zero, y_zero, z_zero;
+    x_zero = (I.x == 0);
+    y_zero = (I.y == 0);
+    z_zero = (I.z == 0);
+
+    // advance p(t)->p(t+deltaT/2), q(t)->q(t+deltaT)
+    p += deltaT * q * t;
+
+    p = p * scale;
+
+    quat<Scalar> p1, p2, p3; // permutated quaternions
+    quat<Scalar> q1, q2, q3;
+    Scalar phi1, cphi1, sphi1;
+    Scalar phi2, cphi2, sphi2;
+    Scalar phi3, cphi3, sphi3;
+
+    if (!z_zero)
+        {
+        p3 = quat<Scalar>(-p.v.z, vec3<Scalar>(p.v.y, -p.v.x, p.s));
+        q3 = quat<Scalar>(-q.v.z, vec3<Scalar>(q.v.y, -q.v.x, q.s));
+        phi3 = Scalar(1. / 4.) / I.z * dot(p, q3);
+        cphi3 = slow::cos(Scalar(1. / 2.) * deltaT * phi3);
+        sphi3 = slow::sin(Scalar(1. / 2.) * deltaT * phi3);
+
+        p = cphi3 * p + sphi3 * p3;
+        q = cphi3 * q + sphi3 * q3;
+        }
+
+    if (!y_zero)
+        {
+        p2 = quat<Scalar>(-p.v.y, vec3<Scalar>(-p.v.z, p.s, p.v.x));
+        q2 = quat<Scalar>(-q.v.y, vec3<Scalar>(-q.v.z, q.s, q.v.x));
+        phi2 = Scalar(1. / 4.) / I.y * dot(p, q2);
+        cphi2 = slow::cos(Scalar(1. / 2.) * deltaT * phi2);
+        sphi2 = slow::sin(Scalar(1. / 2.) * deltaT * phi2);
+
+        p = cphi2 * p + sphi2 * p2;
+        q = cphi2 * q + sphi2 * q2;
+        }
+
+    if (!x_zero)
+        {
+        p1 = quat<Scalar>(-p.v.x, vec3<Scalar>(p.s, p.v.z, -p.v.y));
+        q1 = quat<Scalar>(-q.v.x, vec3<Scalar>(q.s, q.v.z, -q.v.y));
+        phi1 = Scalar(1. / 4.) / I.x * dot(p, q1);
+        cphi1 = slow::cos(deltaT * phi1);
+        sphi1 = slow::sin(deltaT * phi1);
+
+        p = cphi1 * p + sphi1 * p1;
+        q = cphi1 * q + sphi1 * q1;
+        }
+
+    if (!y_zero)
+        {
+        p2 = quat<Scalar>(-p.v.y, vec3<Scalar>(-p.v.z, p.s, p.v.x));
+        q2 = quat<Scalar>(-q.v.y, vec3<Scalar>(-q.v.z, q.s, q.v.x));
+        phi2 = Scalar(1. / 4.) / I.y * dot(p, q2);
+        cphi2 = slow::cos(Scalar(1. / 2.) * deltaT * phi2);
+        sphi2 = slow::sin(Scalar(1. / 2.) * deltaT * phi2);
+
+        p = cphi2 * p + sphi2 * p2;
+        q = cphi2 * q + sphi2 * q2;
+        }
+
+    if (!z_zero)
+        {
+        p3 = quat<Scalar>(-p.v.z, vec3<Scalar>(p.v.y, -p.v.x, p.s));
+        q3 = quat<Scalar>(-q.v.z, vec3<Scalar>(q.v.y, -q.v.x, q.s));
+        phi3 = Scalar(1. / 4.) / I.z * dot(p, q3);
+        cphi3 = slow::cos(Scalar(1. / 2.) * deltaT * phi3);
+        sphi3 = slow::sin(Scalar(1. / 2.) * deltaT * phi3);
+
+        p = cphi3 * p + sphi3 * p3;
+        q = cphi3 * q + sphi3 * q3;
+        }
+
+    // renormalize (improves stability)
+    q = q * (Scalar(1.0) / slow::sqrt(norm2(q)));
+    }
+
+//! NO_SQUISH angular part of the second half step for one particle
+/*! \param q Particle orientation
+    \param p Conjugate quaternion, advanced to t+deltaT
+    \param t_space Net torque on the particle in the space frame
+    \param I Principal moments of inertia
+    \param deltaT timestep
+    \param scale Thermostat rescaling factor
+*/
+__device__ inline void nve_angular_step_two(const quat<Scalar>& q,
+                                            quat<Scalar>& p,
+                                            const vec3<Scalar>& t_space,
+                                            const vec3<Scalar>& I,
+                                            Scalar deltaT,
+                                            Scalar scale)
+    {
+    vec3<Scalar> t = nve_angular_principal_torque(q, t_space, I);
+
+    // rescale
+    p = p * scale;
+
+    // advance p(t)->p(t+deltaT/2), q(t)->q(t+deltaT)
+    p += deltaT * q * t;
+    }
+#endif
 
     } // end namespace kernel
     } // end namespace md
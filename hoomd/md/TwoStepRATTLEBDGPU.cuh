@@ -19,6 +19,8 @@
 
 #include "hoomd/GPUPartition.cuh"
 
+#include "TwoStepRATTLENVEGPU.cuh"
+
 #include "hoomd/RNGIdentifiers.h"
 #include "hoomd/RandomNumbers.h"
 
@@ -93,6 +95,7 @@ hipError_t gpu_include_rattle_force_bd(const Scalar4* d_pos,
                                        size_t net_virial_pitch,
                                        const Scalar deltaT,
                                        const bool d_noiseless_t,
+                                       const rattle_queue_args_t& queue,
                                        const GPUPartition& gpu_partition);
 
 #ifdef __HIPCC__
@@ -443,7 +446,14 @@ __global__ void gpu_include_rattle_force_bd_kernel(const Scalar4* d_pos,
                                                    size_t net_virial_pitch,
                                                    const Scalar deltaT,
                                                    const bool d_noiseless_t,
-                                                   const unsigned int offset)
+                                                   const unsigned int offset,
+                                                   Scalar4* d_state,
+                                                   const unsigned int* d_queue_in,
+                                                   const unsigned int* d_n_queue_in,
+                                                   unsigned int* d_queue_out,
+                                                   unsigned int* d_n_queue_out,
+                                                   const unsigned int n_iterations,
+                                                   const bool last_pass)
     {
     HIP_DYNAMIC_SHARED(char, s_data2)
 
@@ -460,11 +470,14 @@ __global__ void gpu_include_rattle_force_bd_kernel(const Scalar4* d_pos,
     __syncthreads();
 
     // determine which particle this thread works on (MEM TRANSFER: 4 bytes)
-    int local_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    unsigned int local_idx = blockIdx.x * blockDim.x + threadIdx.x;
 
-    if (local_idx < nwork)
+    // the first pass works on all members, later passes on the queued members
+    const unsigned int n_work = d_queue_in ? *d_n_queue_in : nwork;
+
+    if (local_idx < n_work)
         {
-        const unsigned int group_idx = local_idx + offset;
+        const unsigned int group_idx = d_queue_in ? d_queue_in[local_idx] : local_idx + offset;
 
         // determine the particle to work on
         unsigned int idx = d_group_members[group_idx];
@@ -546,9 +559,16 @@ __global__ void gpu_include_rattle_force_bd_kernel(const Scalar4* d_pos,
 
         Scalar3 residual;
         Scalar resid;
-        unsigned int iteration = 0;
-        const unsigned int maxiteration = 10;
 
+        // continue the iterations of a queued particle
+        if (d_queue_in)
+            {
+            Scalar4 state = d_state[group_idx];
+            next_pos = make_scalar3(state.x, state.y, state.z);
+            mu = state.w;
+            }
+
+        unsigned int iteration = 0;
         do
             {
             iteration++;
@@ -576,7 +596,15 @@ __global__ void gpu_include_rattle_force_bd_kernel(const Scalar4* d_pos,
             if (vec_norm > resid)
                 resid = vec_norm;
 
-            } while (resid > tolerance && iteration < maxiteration);
+            } while (resid > tolerance && iteration < n_iterations);
+
+        // queue the particle for the next pass
+        if (resid > tolerance && !last_pass)
+            {
+            d_state[group_idx] = make_scalar4(next_pos.x, next_pos.y, next_pos.z, mu);
+            d_queue_out[atomicAdd(d_n_queue_out, 1)] = group_idx;
+            return;
+            }
 
         net_force.x -= mu * normal.x;
         net_force.y -= mu * normal.y;
@@ -599,6 +627,11 @@ __global__ void gpu_include_rattle_force_bd_kernel(const Scalar4* d_pos,
         }
     }
 
+/*! \param queue Scratch arrays of the compacted iterations
+
+    This is a driver for gpu_include_rattle_force_bd_kernel(). It launches the kernel once per pass
+    of rattle_iterations_per_pass iterations, see gpu_include_rattle_force_nve().
+*/
 template<class Manifold>
 hipError_t gpu_include_rattle_force_bd(const Scalar4* d_pos,
                                        Scalar4* d_net_force,
@@ -611,53 +644,78 @@ hipError_t gpu_include_rattle_force_bd(const Scalar4* d_pos,
                                        size_t net_virial_pitch,
                                        const Scalar deltaT,
                                        const bool d_noiseless_t,
+                                       const rattle_queue_args_t& queue,
                                        const GPUPartition& gpu_partition)
     {
     unsigned int run_block_size = 256;
 
-    // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
-    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
-        {
-        auto range = gpu_partition.getRangeAndSetGPU(idev);
-
-        unsigned int nwork = range.second - range.first;
+    const auto shared_bytes
+        = (sizeof(Scalar) * rattle_bd_args.n_types + sizeof(Scalar3) * rattle_bd_args.n_types);
 
-        // setup the grid to run the kernel
-        dim3 grid((nwork / run_block_size) + 1, 1, 1);
-        dim3 threads(run_block_size, 1, 1);
-
-        const auto shared_bytes
-            = (sizeof(Scalar) * rattle_bd_args.n_types + sizeof(Scalar3) * rattle_bd_args.n_types);
+    if (shared_bytes > rattle_bd_args.devprop.sharedMemPerBlock)
+        {
+        throw std::runtime_error("Brownian gamma parameters exceed the available shared "
+                                 "memory per block.");
+        }
 
-        if (shared_bytes > rattle_bd_args.devprop.sharedMemPerBlock)
+    for (unsigned int first_iteration = 0; first_iteration < rattle_max_iterations;
+         first_iteration += rattle_iterations_per_pass)
+        {
+        const unsigned int pass = first_iteration / rattle_iterations_per_pass;
+        const unsigned int n_iterations
+            = min(rattle_iterations_per_pass, rattle_max_iterations - first_iteration);
+        const bool last_pass = first_iteration + n_iterations >= rattle_max_iterations;
+
+        // iterate over active GPUs in reverse, to end up on first GPU when returning from this
+        // function
+        for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
             {
-            throw std::runtime_error("Brownian gamma parameters exceed the available shared "
-                                     "memory per block.");
+            auto range = gpu_partition.getRangeAndSetGPU(idev);
+
+            unsigned int nwork = range.second - range.first;
+
+            const unsigned int in = (pass + 1) % 2;
+            const unsigned int out = pass % 2;
+            unsigned int* d_n_queue_out = queue.d_n_queue + 2 * idev + out;
+            if (!last_pass)
+                hipMemsetAsync(d_n_queue_out, 0, sizeof(unsigned int));
+
+            // setup the grid to run the kernel
+            dim3 grid((nwork / run_block_size) + 1, 1, 1);
+            dim3 threads(run_block_size, 1, 1);
+
+            // run the kernel
+            hipLaunchKernelGGL((gpu_include_rattle_force_bd_kernel<Manifold>),
+                               dim3(grid),
+                               dim3(threads),
+                               shared_bytes,
+                               0,
+                               d_pos,
+                               d_net_force,
+                               d_net_virial,
+                               d_tag,
+                               d_group_members,
+                               nwork,
+                               rattle_bd_args.d_gamma,
+                               rattle_bd_args.n_types,
+                               rattle_bd_args.timestep,
+                               rattle_bd_args.seed,
+                               rattle_bd_args.T,
+                               rattle_bd_args.tolerance,
+                               manifold,
+                               net_virial_pitch,
+                               deltaT,
+                               d_noiseless_t,
+                               range.first,
+                               queue.d_state,
+                               pass > 0 ? queue.d_queue + in * queue.group_size + range.first
+                                        : nullptr,
+                               queue.d_n_queue + 2 * idev + in,
+                               queue.d_queue + out * queue.group_size + range.first,
+                               d_n_queue_out,
+                               n_iterations,
+                               last_pass);
             }
-
-        // run the kernel
-        hipLaunchKernelGGL((gpu_include_rattle_force_bd_kernel<Manifold>),
-                           dim3(grid),
-                           dim3(threads),
-                           shared_bytes,
-                           0,
-                           d_pos,
-                           d_net_force,
-                           d_net_virial,
-                           d_tag,
-                           d_group_members,
-                           nwork,
-                           rattle_bd_args.d_gamma,
-                           rattle_bd_args.n_types,
-                           rattle_bd_args.timestep,
-                           rattle_bd_args.seed,
-                           rattle_bd_args.T,
-                           rattle_bd_args.tolerance,
-                           manifold,
-                           net_virial_pitch,
-                           deltaT,
-                           d_noiseless_t,
-                           range.first);
         }
 
     return hipSuccess;
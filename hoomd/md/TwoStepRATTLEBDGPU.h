@@ -213,6 +213,19 @@ template<class Manifold> void TwoStepRATTLEBDGPU<Manifold>::includeRATTLEForce(u
 
     size_t net_virial_pitch = net_virial.getPitch();
 
+    // scratch arrays for the particles that need more than one pass of iterations
+    const unsigned int n_gpu = this->m_group->getGPUPartition().getNumActiveGPUs();
+    ScopedAllocation<Scalar4> d_rattle_state(this->m_exec_conf->getCachedAllocatorManaged(),
+                                             group_size);
+    ScopedAllocation<unsigned int> d_rattle_queue(this->m_exec_conf->getCachedAllocatorManaged(),
+                                                  2 * group_size);
+    ScopedAllocation<unsigned int> d_rattle_n_queue(this->m_exec_conf->getCachedAllocatorManaged(),
+                                                    2 * n_gpu);
+    kernel::rattle_queue_args_t queue(d_rattle_state.data,
+                                      d_rattle_queue.data,
+                                      d_rattle_n_queue.data,
+                                      group_size);
+
     kernel::rattle_bd_step_one_args args(d_gamma.data,
                                          this->m_gamma.getNumElements(),
                                          (*this->m_T)(timestep),
@@ -251,6 +264,7 @@ template<class Manifold> void TwoStepRATTLEBDGPU<Manifold>::includeRATTLEForce(u
                                                   net_virial_pitch,
                                                   this->m_deltaT,
                                                   this->m_noiseless_t,
+                                                  queue,
                                                   this->m_group->getGPUPartition());
 
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
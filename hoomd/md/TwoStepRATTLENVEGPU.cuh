@@ -33,6 +33,41 @@ namespace md
     {
 namespace kernel
     {
+//! Maximum number of iterations of the RATTLE position projection
+const unsigned int rattle_max_iterations = 10;
+
+//! Number of iterations of the RATTLE position projection per kernel launch
+const unsigned int rattle_iterations_per_pass = 2;
+
+//! Scratch arrays for the compacted RATTLE position projection
+/*! The number of Newton iterations that a particle needs to reach the manifold varies between
+    particles. Instead of running all threads of a warp until the slowest particle converges, the
+    projection kernels run at most rattle_iterations_per_pass iterations per launch. Particles that
+    have not converged store their state in d_state and append their group index to the queue of
+    their GPU. The next launch only iterates the queued particles, so the threads of a warp work on
+    unconverged particles.
+
+    The queues alternate between two buffers of group_size entries each. The entries of GPU idev
+    start at the first group index of the GPU and its queue lengths are d_n_queue[2 * idev] and
+    d_n_queue[2 * idev + 1].
+*/
+struct rattle_queue_args_t
+    {
+    //! Construct a rattle_queue_args_t
+    rattle_queue_args_t(Scalar4* _d_state,
+                        unsigned int* _d_queue,
+                        unsigned int* _d_n_queue,
+                        const unsigned int _group_size)
+        : d_state(_d_state), d_queue(_d_queue), d_n_queue(_d_n_queue), group_size(_group_size)
+        {
+        }
+
+    Scalar4* d_state;              //!< Position (x,y,z) and multiplier (w) per group member
+    unsigned int* d_queue;         //!< Two queues of group_size group indices each
+    unsigned int* d_n_queue;       //!< Two queue lengths per active GPU
+    const unsigned int group_size; //!< Number of members in the group
+    };
+
 hipError_t gpu_rattle_nve_step_one(Scalar4* d_pos,
                                    Scalar4* d_vel,
                                    const Scalar3* d_accel,
@@ -93,6 +128,7 @@ hipError_t gpu_include_rattle_force_nve(const Scalar4* d_pos,
                                         Scalar tolerance,
                                         Scalar deltaT,
                                         bool zero_force,
+                                        const rattle_queue_args_t& queue,
                                         unsigned int block_size);
 
 #ifdef __HIPCC__
@@ -310,14 +346,24 @@ __global__ void gpu_include_rattle_force_nve_kernel(const Scalar4* d_pos,
                                                     Manifold manifold,
                                                     Scalar tolerance,
                                                     Scalar deltaT,
-                                                    bool zero_force)
+                                                    bool zero_force,
+                                                    Scalar4* d_state,
+                                                    const unsigned int* d_queue_in,
+                                                    const unsigned int* d_n_queue_in,
+                                                    unsigned int* d_queue_out,
+                                                    unsigned int* d_n_queue_out,
+                                                    const unsigned int n_iterations,
+                                                    const bool last_pass)
     {
     // determine which particle this thread works on (MEM TRANSFER: 4 bytes)
-    int work_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    unsigned int work_idx = blockIdx.x * blockDim.x + threadIdx.x;
 
-    if (work_idx < nwork)
+    // the first pass works on all members, later passes on the queued members
+    const unsigned int n_work = d_queue_in ? *d_n_queue_in : nwork;
+
+    if (work_idx < n_work)
         {
-        const unsigned int group_idx = work_idx + offset;
+        const unsigned int group_idx = d_queue_in ? d_queue_in[work_idx] : work_idx + offset;
         unsigned int idx = d_group_members[group_idx];
 
         // do velocity verlet update
@@ -361,7 +407,14 @@ __global__ void gpu_include_rattle_force_nve_kernel(const Scalar4* d_pos,
         Scalar resid;
         Scalar3 half_vel;
 
-        const unsigned int maxiteration = 10;
+        // continue the iterations of a queued particle
+        if (d_queue_in)
+            {
+            Scalar4 state = d_state[group_idx];
+            next_pos = make_scalar3(state.x, state.y, state.z);
+            lambda = state.w;
+            }
+
         unsigned int iteration = 0;
         do
             {
@@ -384,7 +437,15 @@ __global__ void gpu_include_rattle_force_nve_kernel(const Scalar4* d_pos,
             if (vec_norm > resid)
                 resid = vec_norm;
 
-            } while (resid > tolerance && iteration < maxiteration);
+            } while (resid > tolerance && iteration < n_iterations);
+
+        // queue the particle for the next pass
+        if (resid > tolerance && !last_pass)
+            {
+            d_state[group_idx] = make_scalar4(next_pos.x, next_pos.y, next_pos.z, lambda);
+            d_queue_out[atomicAdd(d_n_queue_out, 1)] = group_idx;
+            return;
+            }
 
         accel = accel - lambda * normal;
 
@@ -408,6 +469,13 @@ __global__ void gpu_include_rattle_force_nve_kernel(const Scalar4* d_pos,
         }
     }
 
+/*! \param queue Scratch arrays of the compacted iterations
+
+    This is a driver for gpu_include_rattle_force_nve_kernel(). It launches the kernel once per
+    pass of rattle_iterations_per_pass iterations. The launches of later passes are sized for all
+    members, and the threads beyond the queue length of the previous pass exit immediately, so the
+    driver does not synchronize with the device.
+*/
 template<class Manifold>
 hipError_t gpu_include_rattle_force_nve(const Scalar4* d_pos,
                                         const Scalar4* d_vel,
@@ -421,6 +489,7 @@ hipError_t gpu_include_rattle_force_nve(const Scalar4* d_pos,
                                         Scalar tolerance,
                                         Scalar deltaT,
                                         bool zero_force,
+                                        const rattle_queue_args_t& queue,
                                         unsigned int block_size)
     {
     unsigned int max_block_size;
@@ -430,36 +499,60 @@ hipError_t gpu_include_rattle_force_nve(const Scalar4* d_pos,
 
     unsigned int run_block_size = min(block_size, max_block_size);
 
-    // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
-    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+    for (unsigned int first_iteration = 0; first_iteration < rattle_max_iterations;
+         first_iteration += rattle_iterations_per_pass)
         {
-        auto range = gpu_partition.getRangeAndSetGPU(idev);
-
-        unsigned int nwork = range.second - range.first;
-
-        // setup the grid to run the kernel
-        dim3 grid((nwork / run_block_size) + 1, 1, 1);
-        dim3 threads(run_block_size, 1, 1);
-
-        // run the kernel
-        hipLaunchKernelGGL((gpu_include_rattle_force_nve_kernel<Manifold>),
-                           dim3(grid),
-                           dim3(threads),
-                           0,
-                           0,
-                           d_pos,
-                           d_vel,
-                           d_accel,
-                           d_net_force,
-                           d_net_virial,
-                           d_group_members,
-                           nwork,
-                           range.first,
-                           net_virial_pitch,
-                           manifold,
-                           tolerance,
-                           deltaT,
-                           zero_force);
+        const unsigned int pass = first_iteration / rattle_iterations_per_pass;
+        const unsigned int n_iterations
+            = min(rattle_iterations_per_pass, rattle_max_iterations - first_iteration);
+        const bool last_pass = first_iteration + n_iterations >= rattle_max_iterations;
+
+        // iterate over active GPUs in reverse, to end up on first GPU when returning from this
+        // function
+        for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+            {
+            auto range = gpu_partition.getRangeAndSetGPU(idev);
+
+            unsigned int nwork = range.second - range.first;
+
+            const unsigned int in = (pass + 1) % 2;
+            const unsigned int out = pass % 2;
+            unsigned int* d_n_queue_out = queue.d_n_queue + 2 * idev + out;
+            if (!last_pass)
+                hipMemsetAsync(d_n_queue_out, 0, sizeof(unsigned int));
+
+            // setup the grid to run the kernel
+            dim3 grid((nwork / run_block_size) + 1, 1, 1);
+            dim3 threads(run_block_size, 1, 1);
+
+            // run the kernel
+            hipLaunchKernelGGL((gpu_include_rattle_force_nve_kernel<Manifold>),
+                               dim3(grid),
+                               dim3(threads),
+                               0,
+                               0,
+                               d_pos,
+                               d_vel,
+                               d_accel,
+                               d_net_force,
+                               d_net_virial,
+                               d_group_members,
+                               nwork,
+                               range.first,
+                               net_virial_pitch,
+                               manifold,
+                               tolerance,
+                               deltaT,
+                               zero_force,
+                               queue.d_state,
+                               pass > 0 ? queue.d_queue + in * queue.group_size + range.first
+                                        : nullptr,
+                               queue.d_n_queue + 2 * idev + in,
+                               queue.d_queue + out * queue.group_size + range.first,
+                               d_n_queue_out,
+                               n_iterations,
+                               last_pass);
+            }
         }
 
     return hipSuccess;
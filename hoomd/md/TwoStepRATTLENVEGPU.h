@@ -335,6 +335,20 @@ template<class Manifold> void TwoStepRATTLENVEGPU<Manifold>::includeRATTLEForce(
 
     size_t net_virial_pitch = net_virial.getPitch();
 
+    // scratch arrays for the particles that need more than one pass of iterations
+    const unsigned int group_size = this->m_group->getNumMembers();
+    const unsigned int n_gpu = this->m_group->getGPUPartition().getNumActiveGPUs();
+    ScopedAllocation<Scalar4> d_rattle_state(this->m_exec_conf->getCachedAllocatorManaged(),
+                                             group_size);
+    ScopedAllocation<unsigned int> d_rattle_queue(this->m_exec_conf->getCachedAllocatorManaged(),
+                                                  2 * group_size);
+    ScopedAllocation<unsigned int> d_rattle_n_queue(this->m_exec_conf->getCachedAllocatorManaged(),
+                                                    2 * n_gpu);
+    kernel::rattle_queue_args_t queue(d_rattle_state.data,
+                                      d_rattle_queue.data,
+                                      d_rattle_n_queue.data,
+                                      group_size);
+
     // perform the update on the GPU
     this->m_exec_conf->beginMultiGPU();
     m_tuner_force->begin();
@@ -350,6 +364,7 @@ template<class Manifold> void TwoStepRATTLENVEGPU<Manifold>::includeRATTLEForce(
                                                    this->m_tolerance,
                                                    this->m_deltaT,
                                                    this->m_zero_force,
+                                                   queue,
                                                    m_tuner_force->getParam()[0]);
 
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
@@ -0,0 +1,102 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file ZeroMomentumUpdaterGPU.cc
+    \brief Defines the ZeroMomentumUpdaterGPU class
+*/
+
+#include "ZeroMomentumUpdaterGPU.h"
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System to zero the momentum of
+    \param trigger Steps on which to zero the momentum
+ */
+ZeroMomentumUpdaterGPU::ZeroMomentumUpdaterGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                               std::shared_ptr<Trigger> trigger)
+    : ZeroMomentumUpdater(sysdef, trigger), m_sum(m_exec_conf)
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        throw std::runtime_error("Cannot initialize ZeroMomentumUpdaterGPU on a CPU device.");
+        }
+
+    m_tuner.reset(new Autotuner<1>({AutotunerBase::makeBlockSizeRange(m_exec_conf)},
+                                   m_exec_conf,
+                                   "zero_momentum"));
+    m_autotuners.push_back(m_tuner);
+    }
+
+/*! Perform the needed calculations to zero the system's momentum
+    \param timestep Current time step of the simulation
+*/
+void ZeroMomentumUpdaterGPU::update(uint64_t timestep)
+    {
+    Updater::update(timestep);
+
+    ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                               access_location::device,
+                               access_mode::readwrite);
+    ArrayHandle<unsigned int> d_body(m_pdata->getBodies(),
+                                     access_location::device,
+                                     access_mode::read);
+    ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
+
+    // add up the momentum of every free particle (including floppy body particles) and every
+    // central particle of a rigid body
+    kernel::gpu_zero_momentum_sum(m_sum.getDeviceFlags(),
+                                  d_vel.data,
+                                  d_body.data,
+                                  d_tag.data,
+                                  m_pdata->getN(),
+                                  m_exec_conf->getCachedAllocator());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+
+    const kernel::zero_momentum_sum sum = m_sum.readFlags();
+    Scalar p[3] = {sum.px, sum.py, sum.pz};
+    unsigned int n = sum.n;
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &n, 1, MPI_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE,
+                      p,
+                      3,
+                      MPI_HOOMD_SCALAR,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    // subtract the average momentum from the same particles
+    const Scalar3 avg_p = make_scalar3(p[0], p[1], p[2]) / Scalar(n);
+    m_tuner->begin();
+    kernel::gpu_zero_momentum_remove(d_vel.data,
+                                     d_body.data,
+                                     d_tag.data,
+                                     m_pdata->getN(),
+                                     avg_p,
+                                     m_tuner->getParam()[0]);
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner->end();
+    }
+
+namespace detail
+    {
+void export_ZeroMomentumUpdaterGPU(pybind11::module& m)
+    {
+    pybind11::class_<ZeroMomentumUpdaterGPU,
+                     ZeroMomentumUpdater,
+                     std::shared_ptr<ZeroMomentumUpdaterGPU>>(m, "ZeroMomentumUpdaterGPU")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<Trigger>>());
+    }
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
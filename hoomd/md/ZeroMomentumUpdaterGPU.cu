@@ -0,0 +1,174 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "ZeroMomentumUpdaterGPU.cuh"
+#include "hoomd/ParticleData.cuh"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#include <hipcub/hipcub.hpp>
+#pragma GCC diagnostic pop
+
+/*! \file ZeroMomentumUpdaterGPU.cu
+    \brief Defines GPU kernel code used by ZeroMomentumUpdaterGPU
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Test if a particle carries momentum: free particles, floppy body particles, and central
+//! particles of rigid bodies
+__device__ inline bool zero_momentum_carries(unsigned int body, unsigned int tag)
+    {
+    return body >= MIN_FLOPPY || body == tag;
+    }
+
+//! Gets the momentum of a particle, or zero when it does not carry momentum
+struct zero_momentum_of_particle
+    {
+    const Scalar4* d_vel;
+    const unsigned int* d_body;
+    const unsigned int* d_tag;
+
+    __device__ zero_momentum_sum operator()(unsigned int i) const
+        {
+        zero_momentum_sum p = {0, 0, 0, 0};
+        if (zero_momentum_carries(d_body[i], d_tag[i]))
+            {
+            const Scalar4 vel = d_vel[i];
+            p.px = vel.w * vel.x;
+            p.py = vel.w * vel.y;
+            p.pz = vel.w * vel.z;
+            p.n = 1;
+            }
+        return p;
+        }
+    };
+
+//! Adds two momentum sums
+struct zero_momentum_add
+    {
+    __device__ zero_momentum_sum operator()(const zero_momentum_sum& a,
+                                            const zero_momentum_sum& b) const
+        {
+        return zero_momentum_sum {a.px + b.px, a.py + b.py, a.pz + b.pz, a.n + b.n};
+        }
+    };
+
+/*! \param d_sum Device memory to write the sum to
+    \param d_vel Particle velocities and masses
+    \param d_body Particle body ids
+    \param d_tag Particle tags
+    \param N Number of local particles
+    \param alloc Allocator for the temporary storage of the reduction
+
+    The sum is written asynchronously, the caller must synchronize before reading it on the host.
+*/
+hipError_t gpu_zero_momentum_sum(zero_momentum_sum* d_sum,
+                                 const Scalar4* d_vel,
+                                 const unsigned int* d_body,
+                                 const unsigned int* d_tag,
+                                 unsigned int N,
+                                 CachedAllocator& alloc)
+    {
+    if (N == 0)
+        {
+        return hipMemsetAsync(d_sum, 0, sizeof(zero_momentum_sum));
+        }
+
+    hipcub::CountingInputIterator<unsigned int> indices(0);
+    hipcub::TransformInputIterator<zero_momentum_sum,
+                                   zero_momentum_of_particle,
+                                   hipcub::CountingInputIterator<unsigned int>>
+        momenta(indices, zero_momentum_of_particle {d_vel, d_body, d_tag});
+    const zero_momentum_sum zero = {0, 0, 0, 0};
+
+    // determine the temporary storage size
+    void* d_temp_storage = NULL;
+    size_t temp_storage_bytes = 0;
+    hipcub::DeviceReduce::Reduce(d_temp_storage,
+                                 temp_storage_bytes,
+                                 momenta,
+                                 d_sum,
+                                 N,
+                                 zero_momentum_add(),
+                                 zero);
+
+    d_temp_storage = alloc.getTemporaryBuffer<char>(temp_storage_bytes);
+    hipcub::DeviceReduce::Reduce(d_temp_storage,
+                                 temp_storage_bytes,
+                                 momenta,
+                                 d_sum,
+                                 N,
+                                 zero_momentum_add(),
+                                 zero);
+    alloc.deallocate((char*)d_temp_storage);
+
+    return hipSuccess;
+    }
+
+//! Subtracts the average momentum from the particles that carry momentum
+__global__ void gpu_zero_momentum_remove_kernel(Scalar4* d_vel,
+                                                const unsigned int* d_body,
+                                                const unsigned int* d_tag,
+                                                unsigned int N,
+                                                Scalar3 avg_p)
+    {
+    const unsigned int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= N || !zero_momentum_carries(d_body[i], d_tag[i]))
+        return;
+
+    Scalar4 vel = d_vel[i];
+    const Scalar mass = vel.w;
+    vel.x -= avg_p.x / mass;
+    vel.y -= avg_p.y / mass;
+    vel.z -= avg_p.z / mass;
+    d_vel[i] = vel;
+    }
+
+/*! \param d_vel Particle velocities and masses
+    \param d_body Particle body ids
+    \param d_tag Particle tags
+    \param N Number of local particles
+    \param avg_p Average momentum to remove
+    \param block_size Block size to execute
+*/
+hipError_t gpu_zero_momentum_remove(Scalar4* d_vel,
+                                    const unsigned int* d_body,
+                                    const unsigned int* d_tag,
+                                    unsigned int N,
+                                    Scalar3 avg_p,
+                                    unsigned int block_size)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_zero_momentum_remove_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    const unsigned int run_block_size = min(block_size, max_block_size);
+    dim3 grid(N / run_block_size + 1, 1, 1);
+    dim3 threads(run_block_size, 1, 1);
+
+    hipLaunchKernelGGL((gpu_zero_momentum_remove_kernel),
+                       dim3(grid),
+                       dim3(threads),
+                       0,
+                       0,
+                       d_vel,
+                       d_body,
+                       d_tag,
+                       N,
+                       avg_p);
+
+    return hipSuccess;
+    }
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,49 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file ZeroMomentumUpdaterGPU.cuh
+    \brief Declares GPU kernel code used by ZeroMomentumUpdaterGPU
+*/
+
+#include "hoomd/CachedAllocator.h"
+#include "hoomd/HOOMDMath.h"
+
+#ifndef __ZERO_MOMENTUM_UPDATER_GPU_CUH__
+#define __ZERO_MOMENTUM_UPDATER_GPU_CUH__
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Momentum and number of the particles that carry momentum
+struct zero_momentum_sum
+    {
+    Scalar px;      //!< Momentum along x
+    Scalar py;      //!< Momentum along y
+    Scalar pz;      //!< Momentum along z
+    unsigned int n; //!< Number of particles
+    };
+
+//! Sum the momentum of the free particles and the central particles of rigid bodies
+hipError_t gpu_zero_momentum_sum(zero_momentum_sum* d_sum,
+                                 const Scalar4* d_vel,
+                                 const unsigned int* d_body,
+                                 const unsigned int* d_tag,
+                                 unsigned int N,
+                                 CachedAllocator& alloc);
+
+//! Remove the average momentum from the free particles and the central particles of rigid bodies
+hipError_t gpu_zero_momentum_remove(Scalar4* d_vel,
+                                    const unsigned int* d_body,
+                                    const unsigned int* d_tag,
+                                    unsigned int N,
+                                    Scalar3 avg_p,
+                                    unsigned int block_size);
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __ZERO_MOMENTUM_UPDATER_GPU_CUH__
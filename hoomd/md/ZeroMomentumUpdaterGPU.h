@@ -0,0 +1,48 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file ZeroMomentumUpdaterGPU.h
+    \brief Declares an updater that zeros the momentum of the system on the GPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "ZeroMomentumUpdater.h"
+#include "ZeroMomentumUpdaterGPU.cuh"
+#include "hoomd/Autotuner.h"
+#include "hoomd/GPUFlags.h"
+
+#ifndef __ZEROMOMENTUMUPDATER_GPU_H__
+#define __ZEROMOMENTUMUPDATER_GPU_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Updates particle velocities to zero the momentum on the GPU
+/*! The momentum is summed and removed on the device. Only the sum is copied to the host, where it
+    is reduced over the ranks.
+
+    \ingroup updaters
+*/
+class PYBIND11_EXPORT ZeroMomentumUpdaterGPU : public ZeroMomentumUpdater
+    {
+    public:
+    //! Constructor
+    ZeroMomentumUpdaterGPU(std::shared_ptr<SystemDefinition> sysdef,
+                           std::shared_ptr<Trigger> trigger);
+
+    //! Take one timestep forward
+    virtual void update(uint64_t timestep);
+
+    private:
+    GPUFlags<kernel::zero_momentum_sum> m_sum; //!< Momentum summed on the device
+    std::shared_ptr<Autotuner<1>> m_tuner;     //!< Autotuner for the block size
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
@@ -20,6 +20,7 @@ See Also:
 """
 
 from hoomd.md import alchemy
+from hoomd.md import analyze
 from hoomd.md import angle
 from hoomd.md import bond
 from hoomd.md import compute
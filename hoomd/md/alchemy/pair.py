@@ -15,8 +15,8 @@ def _modify_pair_cls_to_alchemical(cls):
     """Modifies a created class inheriting from `_AlchemicalPairForce`.
 
     This decorator sets the _dof_cls type, updates the ``_cpp_class_name``,
-    ``_accepted_modes``, and ``_reserved_default_attrs``, and sets ``normalize =
-    False`` if not set.
+    ``_accepted_modes``, and ``_reserved_default_attrs``, disables the cell list
+    mode, and sets ``normalize = False`` if not set.
     """
     new_cpp_name = [
         'PotentialPair', 'Alchemical', cls.__mro__[0]._cpp_class_name[13:]
@@ -29,6 +29,7 @@ def _modify_pair_cls_to_alchemical(cls):
         cls._dof_cls = AlchemicalDOF
     cls._cpp_class_name = ''.join(new_cpp_name)
     cls._accepted_modes = ('none', 'shift')
+    cls._supports_cell_list = False
     return cls
 
 
@@ -280,9 +281,6 @@ class LJGauss(BaseLJGauss, _AlchemicalPairForce):
     Note:
         :math:`\alpha_i` not accessed are set to 1.
 
-    Attention:
-        `hoomd.md.alchemy.pair.LJGauss` does not support execution on GPUs.
-
     Attention:
         `hoomd.md.alchemy.pair.LJGauss` does not support MPI parallel
         simulations.
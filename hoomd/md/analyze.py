@@ -0,0 +1,587 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+"""Accumulate structural and dynamical properties of MD simulations.
+
+The MD analyzers sample the simulation state on the timesteps selected by their
+trigger and accumulate the samples in memory on the CPU or GPU. They provide
+the averages as loggable quantities for use with `hoomd.logging.Logger` or by
+direct access via the Python API, so that averages over many frames do not
+require writing the frames to a trajectory file. The time correlation functions
+use multi-tau buffers that cover lags from one sample to the length of the run
+in memory that grows with the logarithm of the longest lag.
+
+Add the analyzers to the writers of the simulation:
+
+.. code-block:: python
+
+    rdf = hoomd.md.analyze.RDF(trigger=hoomd.trigger.Periodic(100),
+                               nlist=hoomd.md.nlist.Cell(buffer=0.4),
+                               r_max=3.0,
+                               bins=100)
+    simulation.operations.writers.append(rdf)
+"""
+
+import copy
+import warnings
+
+import numpy
+
+import hoomd
+from hoomd.md import _md
+from hoomd.operation import Writer
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import OnlyTypes
+from hoomd.filter import ParticleFilter
+from hoomd.logging import log
+
+
+class RDF(Writer):
+    r"""Accumulate the radial distribution function.
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps on which to
+            sample the pairs.
+        nlist (hoomd.md.nlist.NeighborList): Neighbor list to find the pairs
+            with.
+        r_max (float): Maximum pair distance :math:`[\mathrm{length}]`.
+        bins (int): Number of bins in :math:`[0, r_\mathrm{max})`.
+        type_a (str): Type of the first particle of the pairs. `None` selects
+            all types.
+        type_b (str): Type of the second particle of the pairs. `None` selects
+            all types.
+
+    `RDF` counts the pairs of particles :math:`(i, j)` with :math:`i` of type
+    `type_a` and :math:`j` of type `type_b` in each bin of the distance
+    :math:`r_{ij}` on every timestep selected by `trigger`:
+
+    .. math::
+
+        g(r) = \frac{\sum_\mathrm{frames} n(r)}
+            {\left(\sum_\mathrm{frames}
+            \frac{N_a N_b - N_{ab}}{V}\right) \Delta V(r)}
+
+    where :math:`n(r)` is the number of pairs in the bin, :math:`N_{ab}` is
+    the number of particles in both sets, and :math:`\Delta V(r)` is the
+    volume (area in 2D) of the spherical shell of the bin.
+
+    `RDF` reads the pairs from the neighbor list. It requests `r_max` from the
+    neighbor list for the selected type pairs, so you can share the neighbor
+    list with a pair force and `RDF` reuses the neighbor list build of the pair
+    force when `r_max` is not larger than the pair force cutoff. A larger
+    `r_max` makes the neighbor list larger for all of its consumers.
+
+    Note:
+        `RDF` does not count pairs that are excluded from the neighbor list,
+        such as bonded particles.
+
+    .. rubric:: Example:
+
+    .. code-block:: python
+
+        rdf = hoomd.md.analyze.RDF(trigger=hoomd.trigger.Periodic(100),
+                                   nlist=lj.nlist,
+                                   r_max=2.5,
+                                   bins=100)
+        simulation.operations.writers.append(rdf)
+
+    Attributes:
+        nlist (hoomd.md.nlist.NeighborList): Neighbor list to find the pairs
+            with (*read only* when attached).
+
+        r_max (float): Maximum pair distance :math:`[\mathrm{length}]` (*read
+            only*).
+
+        bins (int): Number of bins (*read only*).
+
+        type_a (str): Type of the first particle of the pairs (*read only*).
+
+        type_b (str): Type of the second particle of the pairs (*read only*).
+    """
+
+    def __init__(self, trigger, nlist, r_max, bins, type_a=None, type_b=None):
+        super().__init__(trigger)
+        self._param_dict.update(
+            ParameterDict(r_max=float(r_max),
+                          bins=int(bins),
+                          type_a=OnlyTypes(str, allow_none=True),
+                          type_b=OnlyTypes(str, allow_none=True),
+                          nlist=hoomd.md.nlist.NeighborList))
+        self.type_a = type_a
+        self.type_b = type_b
+        self.nlist = nlist
+
+    def _attach_hook(self):
+        if self.nlist._attached and self._simulation != self.nlist._simulation:
+            warnings.warn(
+                f"{self} object is creating a new equivalent neighbor list."
+                f" This is happending since the analyzer is moving to a new "
+                f"simulation. Set a new nlist to suppress this warning.",
+                RuntimeWarning)
+            self.nlist = copy.deepcopy(self.nlist)
+        self.nlist._attach(self._simulation)
+
+        # RDF reads both storage modes, keep the mode of other consumers
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            cls = _md.RDFAnalyzer
+            storage_mode = _md.NeighborList.storageMode.half
+        else:
+            cls = _md.RDFAnalyzerGPU
+            storage_mode = _md.NeighborList.storageMode.full
+        if self.nlist._use_count == 1:
+            self.nlist._cpp_obj.setStorageMode(storage_mode)
+
+        self._cpp_obj = cls(self._simulation.state._cpp_sys_def, self.trigger,
+                            self.nlist._cpp_obj, self.r_max, self.bins,
+                            self.type_a or '', self.type_b or '')
+
+    def _detach_hook(self):
+        self.nlist._detach()
+
+    def _setattr_param(self, attr, value):
+        if attr == "nlist":
+            if value is self.nlist:
+                return
+            if self._attached:
+                raise RuntimeError("nlist cannot be set after scheduling.")
+        super()._setattr_param(attr, value)
+
+    def reset(self):
+        """Clear the accumulated histogram."""
+        if self._attached:
+            self._cpp_obj.reset()
+
+    @log(category='sequence', requires_run=True)
+    def rdf(self):
+        """(*bins*,) `numpy.ndarray` of `float`: The radial distribution \
+        function :math:`g(r)` in each bin :math:`[\\mathrm{dimensionless}]`.
+
+        `rdf` is 0 before `RDF` samples the first frame.
+
+        See Also:
+            `r` defines the bin center locations.
+
+        Attention:
+            In MPI parallel execution, the array is available on rank 0 only.
+            `rdf` is `None` on ranks >= 1.
+        """
+        return self._cpp_obj.getRDF()
+
+    @log(category='sequence', requires_run=True)
+    def counts(self):
+        """(*bins*,) `numpy.ndarray` of `int`: The number of pairs sampled \
+        in each bin.
+
+        Attention:
+            In MPI parallel execution, the array is available on rank 0 only.
+            `counts` is `None` on ranks >= 1.
+        """
+        return self._cpp_obj.getCounts()
+
+    @log(category='sequence')
+    def r(self):
+        """(*bins*,) `numpy.ndarray` of `float`: The distance at the center \
+        of each bin :math:`[\\mathrm{length}]`."""
+        dr = self.r_max / self.bins
+        return (numpy.arange(self.bins) + 0.5) * dr
+
+    @property
+    def num_frames(self):
+        """int: Number of frames sampled since the last `reset`."""
+        if not self._attached:
+            return 0
+        return self._cpp_obj.num_frames
+
+
+class StructureFactor(Writer):
+    r"""Accumulate the static structure factor.
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps on which to
+            sample the structure factor.
+        filter (hoomd.filter.filter_like): Particles to include in the
+            density.
+        q_max (float): Maximum wave vector magnitude
+            :math:`[\mathrm{length}^{-1}]`.
+        bins (int): Number of bins in :math:`[0, q_\mathrm{max})`.
+
+    `StructureFactor` evaluates the density modes
+
+    .. math::
+
+        \rho(\vec{q}) = \sum_{i \in \mathrm{filter}} e^{-i \vec{q} \cdot
+        \vec{r}_i}
+
+    on every timestep selected by `trigger` for all wave vectors
+    :math:`\vec{q} = 2\pi (n_1 \vec{b}_1 + n_2 \vec{b}_2 + n_3 \vec{b}_3)` with
+    integers :math:`n_i` and :math:`0 < |\vec{q}| \le q_\mathrm{max}`, where
+    the :math:`\vec{b}_i` are the reciprocal lattice vectors of the box
+    (:math:`n_3 = 0` in 2D). It averages
+
+    .. math::
+
+        S(q) = \left\langle \frac{|\rho(\vec{q})|^2}{N} \right\rangle
+
+    over the frames and the wave vectors in each bin of :math:`|\vec{q}|`,
+    where :math:`N` is the number of particles in the filter. The wave vectors
+    follow the box when it changes.
+
+    The density modes are exact sums over the particles, so `StructureFactor`
+    has no aliasing or mesh assignment errors. The cost of a frame is
+    proportional to the number of particles times the number of wave vectors,
+    which grows as :math:`q_\mathrm{max}^3 V` in 3D. Choose `q_max` to cover
+    the peaks of interest.
+
+    .. rubric:: Example:
+
+    .. code-block:: python
+
+        structure_factor = hoomd.md.analyze.StructureFactor(
+            trigger=hoomd.trigger.Periodic(1000),
+            filter=hoomd.filter.All(),
+            q_max=8.0,
+            bins=40)
+        simulation.operations.writers.append(structure_factor)
+
+    Attributes:
+        filter (hoomd.filter.filter_like): Particles to include in the density
+            (*read only*).
+
+        q_max (float): Maximum wave vector magnitude
+            :math:`[\mathrm{length}^{-1}]` (*read only*).
+
+        bins (int): Number of bins (*read only*).
+    """
+
+    def __init__(self, trigger, filter, q_max, bins):
+        super().__init__(trigger)
+        self._param_dict.update(
+            ParameterDict(filter=ParticleFilter,
+                          q_max=float(q_max),
+                          bins=int(bins)))
+        self.filter = filter
+
+    def _attach_hook(self):
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            cls = _md.StructureFactorAnalyzer
+        else:
+            cls = _md.StructureFactorAnalyzerGPU
+
+        self._cpp_obj = cls(self._simulation.state._cpp_sys_def, self.trigger,
+                            self._simulation.state._get_group(self.filter),
+                            self.q_max, self.bins)
+
+    def reset(self):
+        """Clear the accumulated structure factor."""
+        if self._attached:
+            self._cpp_obj.reset()
+
+    @log(category='sequence', requires_run=True)
+    def structure_factor(self):
+        """(*bins*,) `numpy.ndarray` of `float`: The structure factor \
+        :math:`S(q)` in each bin :math:`[\\mathrm{dimensionless}]`.
+
+        Bins that contain no wave vectors are 0.
+
+        See Also:
+            `q` defines the bin center locations.
+
+        Attention:
+            In MPI parallel execution, the array is available on rank 0 only.
+            `structure_factor` is `None` on ranks >= 1.
+        """
+        return self._cpp_obj.getStructureFactor()
+
+    @log(category='sequence')
+    def q(self):
+        """(*bins*,) `numpy.ndarray` of `float`: The wave vector magnitude \
+        at the center of each bin :math:`[\\mathrm{length}^{-1}]`."""
+        dq = self.q_max / self.bins
+        return (numpy.arange(self.bins) + 0.5) * dq
+
+    @property
+    def num_frames(self):
+        """int: Number of frames sampled since the last `reset`."""
+        if not self._attached:
+            return 0
+        return self._cpp_obj.num_frames
+
+    @property
+    def num_wave_vectors(self):
+        """int: Number of wave vectors in the current box.
+
+        Only one of :math:`\\pm\\vec{q}` is counted.
+        """
+        if not self._attached:
+            return 0
+        return self._cpp_obj.num_wave_vectors
+
+
+
+class _MultiTauCorrelator(Writer):
+    """Common interface of the multi-tau correlators."""
+
+    def __init__(self, trigger, points, averaging, max_levels):
+        super().__init__(trigger)
+        self._param_dict.update(
+            ParameterDict(points=int(points),
+                          averaging=int(averaging),
+                          max_levels=int(max_levels)))
+
+    def _check_trigger(self):
+        if not isinstance(self.trigger, hoomd.trigger.Periodic):
+            raise ValueError(f"{type(self).__name__} samples equally spaced "
+                             f"steps and requires a hoomd.trigger.Periodic "
+                             f"trigger.")
+
+    def reset(self):
+        """Clear the buffers and the accumulated correlation."""
+        if self._attached:
+            self._cpp_obj.reset()
+
+    @log(category='sequence', requires_run=True)
+    def lag(self):
+        """(*N_lag*,) `numpy.ndarray` of `int`: The lag of each correlation \
+        value in time steps.
+
+        The lags of level 0 are spaced by the trigger period and the lags of
+        level :math:`l` by :math:`\\mathrm{averaging}^l` periods. `lag`
+        includes only the lags with at least one sample.
+        """
+        return self._cpp_obj.getLags() * self.trigger.period
+
+    @property
+    def num_samples(self):
+        """int: Number of samples since the last `reset`."""
+        if not self._attached:
+            return 0
+        return self._cpp_obj.num_samples
+
+
+class _ParticleCorrelator(_MultiTauCorrelator):
+    """Multi-tau correlator of a per-particle quantity."""
+
+    def __init__(self, trigger, filter, points, averaging, max_levels):
+        super().__init__(trigger, points, averaging, max_levels)
+        self._param_dict.update(ParameterDict(filter=ParticleFilter))
+        self.filter = filter
+
+    def _attach_hook(self):
+        self._check_trigger()
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            cls = _md.ParticleCorrelatorAnalyzer
+        else:
+            cls = _md.ParticleCorrelatorAnalyzerGPU
+
+        self._cpp_obj = cls(self._simulation.state._cpp_sys_def, self.trigger,
+                            self._simulation.state._get_group(self.filter),
+                            self._quantity, self.points, self.averaging,
+                            self.max_levels)
+
+
+class MSD(_ParticleCorrelator):
+    r"""Accumulate the mean square displacement with a multi-tau correlator.
+
+    Args:
+        trigger (hoomd.trigger.Periodic): Select the timesteps on which to
+            sample the positions.
+        filter (hoomd.filter.filter_like): Particles to include in the average.
+        points (int): Number of values stored per level.
+        averaging (int): Number of values of a level per value of the next
+            level.
+        max_levels (int): Maximum number of levels.
+
+    `MSD` computes
+
+    .. math::
+
+        \mathrm{MSD}(\tau) = \left\langle |\vec{r}_i(t + \tau) -
+        \vec{r}_i(t)|^2 \right\rangle
+
+    averaged over the particles :math:`i` in the filter and the time origins
+    :math:`t`, where :math:`\vec{r}_i` is the position unwrapped with the
+    particle image.
+
+    `MSD` samples the positions on the timesteps selected by `trigger` and
+    keeps the recent samples of each particle in a multi-tau buffer: level 0
+    holds the last `points` samples and level :math:`l` holds `points` values
+    spaced by :math:`\mathrm{averaging}^l` samples. Level :math:`l` evaluates
+    the lags :math:`j \cdot \mathrm{averaging}^l` for :math:`\mathrm{points}
+    / \mathrm{averaging} \le j < \mathrm{points}` (:math:`0 \le j` at level
+    0). The lags grow geometrically, so the memory grows with the logarithm
+    of the longest lag as :math:`\mathrm{points} \cdot \mathrm{levels} \cdot
+    N` positions. The higher levels store every :math:`\mathrm{averaging}`-th
+    value of the level below, so the displacements are exact at all lags.
+
+    On the GPU, the buffers and the sums stay on the device and `MSD` can
+    sample every step at a small cost.
+
+    Note:
+        `MSD` does not support MPI domain decomposition, and the number of
+        particles must remain constant.
+
+    .. rubric:: Example:
+
+    .. code-block:: python
+
+        msd = hoomd.md.analyze.MSD(trigger=hoomd.trigger.Periodic(10),
+                                   filter=hoomd.filter.All())
+        simulation.operations.writers.append(msd)
+
+    Attributes:
+        filter (hoomd.filter.filter_like): Particles to include in the average
+            (*read only*).
+
+        points (int): Number of values stored per level (*read only*).
+
+        averaging (int): Number of values of a level per value of the next
+            level (*read only*).
+
+        max_levels (int): Maximum number of levels (*read only*).
+    """
+
+    _quantity = 'msd'
+
+    def __init__(self, trigger, filter, points=16, averaging=2, max_levels=20):
+        super().__init__(trigger, filter, points, averaging, max_levels)
+
+    @log(category='sequence', requires_run=True)
+    def msd(self):
+        """(*N_lag*,) `numpy.ndarray` of `float`: The mean square \
+        displacement at each `lag` :math:`[\\mathrm{length}^2]`."""
+        return self._cpp_obj.getCorrelation()
+
+
+class VelocityAutocorrelation(_ParticleCorrelator):
+    r"""Accumulate the velocity autocorrelation with a multi-tau correlator.
+
+    Args:
+        trigger (hoomd.trigger.Periodic): Select the timesteps on which to
+            sample the velocities.
+        filter (hoomd.filter.filter_like): Particles to include in the average.
+        points (int): Number of values stored per level.
+        averaging (int): Number of values of a level per value of the next
+            level.
+        max_levels (int): Maximum number of levels.
+
+    `VelocityAutocorrelation` computes
+
+    .. math::
+
+        C_v(\tau) = \left\langle \vec{v}_i(t) \cdot \vec{v}_i(t + \tau)
+        \right\rangle
+
+    averaged over the particles :math:`i` in the filter and the time origins
+    :math:`t`. It stores the velocities in multi-tau buffers like `MSD`,
+    except that each value of level :math:`l` is the average of `averaging`
+    values of level :math:`l - 1`. The self-diffusion coefficient is
+    :math:`D = \frac{1}{d} \int_0^\infty C_v(\tau) \, d\tau` in :math:`d`
+    dimensions.
+
+    Note:
+        `VelocityAutocorrelation` does not support MPI domain decomposition,
+        and the number of particles must remain constant.
+
+    .. rubric:: Example:
+
+    .. code-block:: python
+
+        vacf = hoomd.md.analyze.VelocityAutocorrelation(
+            trigger=hoomd.trigger.Periodic(1), filter=hoomd.filter.All())
+        simulation.operations.writers.append(vacf)
+
+    Attributes:
+        filter (hoomd.filter.filter_like): Particles to include in the average
+            (*read only*).
+
+        points (int): Number of values stored per level (*read only*).
+
+        averaging (int): Number of values of a level per value of the next
+            level (*read only*).
+
+        max_levels (int): Maximum number of levels (*read only*).
+    """
+
+    _quantity = 'vacf'
+
+    def __init__(self, trigger, filter, points=16, averaging=2, max_levels=20):
+        super().__init__(trigger, filter, points, averaging, max_levels)
+
+    @log(category='sequence', requires_run=True)
+    def autocorrelation(self):
+        """(*N_lag*,) `numpy.ndarray` of `float`: The velocity \
+        autocorrelation at each `lag` :math:`[\\mathrm{velocity}^2]`."""
+        return self._cpp_obj.getCorrelation()
+
+
+class StressAutocorrelation(_MultiTauCorrelator):
+    r"""Accumulate the shear stress autocorrelation with a multi-tau correlator.
+
+    Args:
+        trigger (hoomd.trigger.Periodic): Select the timesteps on which to
+            sample the pressure tensor.
+        points (int): Number of values stored per level.
+        averaging (int): Number of values of a level per value of the next
+            level.
+        max_levels (int): Maximum number of levels.
+
+    `StressAutocorrelation` computes
+
+    .. math::
+
+        C_P(\tau) = \frac{1}{3} \sum_{\alpha\beta \in \{xy, xz, yz\}}
+        \left\langle P_{\alpha\beta}(t) P_{\alpha\beta}(t + \tau)
+        \right\rangle
+
+    averaged over the time origins :math:`t`, where :math:`P` is the
+    pressure tensor of all particles (:math:`C_P = \langle P_{xy}(t)
+    P_{xy}(t + \tau) \rangle` in 2D). The correlator uses the multi-tau
+    levels of `VelocityAutocorrelation` on the global pressure tensor, so its
+    memory is independent of the number of particles. The Green-Kubo relation
+    gives the shear viscosity
+
+    .. math::
+
+        \eta = \frac{V}{kT} \int_0^\infty C_P(\tau) \, d\tau.
+
+    `StressAutocorrelation` requests the pressure tensor, so the forces compute
+    the virials on every step selected by `trigger`.
+
+    .. rubric:: Example:
+
+    .. code-block:: python
+
+        stress_acf = hoomd.md.analyze.StressAutocorrelation(
+            trigger=hoomd.trigger.Periodic(1))
+        simulation.operations.writers.append(stress_acf)
+
+    Attributes:
+        points (int): Number of values stored per level (*read only*).
+
+        averaging (int): Number of values of a level per value of the next
+            level (*read only*).
+
+        max_levels (int): Maximum number of levels (*read only*).
+    """
+
+    def __init__(self, trigger, points=16, averaging=2, max_levels=20):
+        super().__init__(trigger, points, averaging, max_levels)
+
+    def _attach_hook(self):
+        self._check_trigger()
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            thermo_cls = _md.ComputeThermo
+        else:
+            thermo_cls = _md.ComputeThermoGPU
+        group = self._simulation.state._get_group(hoomd.filter.All())
+        thermo = thermo_cls(self._simulation.state._cpp_sys_def, group)
+
+        self._cpp_obj = _md.StressAutocorrelationAnalyzer(
+            self._simulation.state._cpp_sys_def, self.trigger, thermo,
+            self.points, self.averaging, self.max_levels)
+
+    @log(category='sequence', requires_run=True)
+    def autocorrelation(self):
+        """(*N_lag*,) `numpy.ndarray` of `float`: The shear stress \
+        autocorrelation at each `lag` :math:`[\\mathrm{pressure}^2]`."""
+        return self._cpp_obj.getCorrelation()
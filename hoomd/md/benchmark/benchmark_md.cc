@@ -0,0 +1,168 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/ParticleGroup.h"
+#include "hoomd/filter/ParticleFilterAll.h"
+#include "hoomd/md/EvaluatorPairLJ.h"
+#include "hoomd/md/NeighborListBinned.h"
+#include "hoomd/md/NeighborListTree.h"
+#include "hoomd/md/PPPMForceCompute.h"
+#include "hoomd/md/PotentialPair.h"
+
+#ifdef ENABLE_HIP
+#include "hoomd/md/NeighborListGPUBinned.h"
+#include "hoomd/md/NeighborListGPUTree.h"
+#include "hoomd/md/PPPMForceComputeGPU.h"
+#include "hoomd/md/PotentialPairGPU.h"
+#endif
+
+#include "hoomd/benchmark/Benchmark.h"
+
+using namespace hoomd;
+using namespace hoomd::md;
+using namespace hoomd::benchmark;
+
+//! Construct a neighbor list of the given type
+/*! \param type "binned" or "tree"
+    \param sysdef System to build the neighbor list for
+    \param r_cut Cutoff radius for all type pairs
+*/
+std::shared_ptr<NeighborList>
+make_nlist(const std::string& type, std::shared_ptr<SystemDefinition> sysdef, Scalar r_cut)
+    {
+    const Scalar r_buff = Scalar(0.4);
+    std::shared_ptr<NeighborList> nlist;
+#ifdef ENABLE_HIP
+    if (sysdef->getParticleData()->getExecConf()->isCUDAEnabled())
+        {
+        if (type == "binned")
+            nlist = std::make_shared<NeighborListGPUBinned>(sysdef, r_buff);
+        else
+            nlist = std::make_shared<NeighborListGPUTree>(sysdef, r_buff);
+        }
+    else
+#endif
+        {
+        if (type == "binned")
+            nlist = std::make_shared<NeighborListBinned>(sysdef, r_buff);
+        else
+            nlist = std::make_shared<NeighborListTree>(sysdef, r_buff);
+        }
+
+    auto r_cut_matrix = std::make_shared<GlobalArray<Scalar>>(
+        nlist->getTypePairIndexer().getNumElements(),
+        sysdef->getParticleData()->getExecConf());
+        {
+        ArrayHandle<Scalar> h_r_cut(*r_cut_matrix, access_location::host, access_mode::overwrite);
+        for (unsigned int i = 0; i < r_cut_matrix->getNumElements(); i++)
+            h_r_cut.data[i] = r_cut;
+        }
+    nlist->addRCutMatrix(r_cut_matrix);
+    return nlist;
+    }
+
+//! Construct a Lennard-Jones pair force with epsilon = sigma = 1
+std::shared_ptr<PotentialPair<EvaluatorPairLJ>> make_lj(std::shared_ptr<SystemDefinition> sysdef,
+                                                         std::shared_ptr<NeighborList> nlist)
+    {
+    std::shared_ptr<PotentialPair<EvaluatorPairLJ>> lj;
+#ifdef ENABLE_HIP
+    if (sysdef->getParticleData()->getExecConf()->isCUDAEnabled())
+        lj = std::make_shared<PotentialPairGPU<EvaluatorPairLJ>>(sysdef, nlist);
+    else
+#endif
+        lj = std::make_shared<PotentialPair<EvaluatorPairLJ>>(sysdef, nlist);
+
+    EvaluatorPairLJ::param_type params;
+    params.sigma_6 = Scalar(1.0);
+    params.epsilon_x_4 = Scalar(4.0);
+    lj->setParams(0, 0, params);
+    lj->setRcut(0, 0, Scalar(2.5));
+    return lj;
+    }
+
+//! Benchmark the MD neighbor lists and forces
+void benchmark_md(BenchmarkSuite& suite)
+    {
+    auto exec_conf = suite.getExecConf();
+    const unsigned int N = suite.scaleN(64000);
+
+    for (const std::string type : {"binned", "tree"})
+        {
+        const std::string name = type == "binned" ? "NeighborListBinned" : "NeighborListTree";
+
+        if (suite.isSelected(name + "/lj_liquid"))
+            {
+            auto sysdef = makeLJLiquid(N, Scalar(0.8), exec_conf);
+            auto nlist = make_nlist(type, sysdef, Scalar(2.5));
+
+            suite.run(name + "/lj_liquid",
+                      N,
+                      [&](uint64_t timestep)
+                      {
+                          nlist->forceUpdate();
+                          nlist->compute(timestep);
+                      });
+            }
+
+        if (suite.isSelected(name + "/polymer_melt"))
+            {
+            auto sysdef = makePolymerMelt(N / 100, 100, Scalar(0.85), exec_conf);
+            auto nlist = make_nlist(type, sysdef, Scalar(1.122));
+
+            suite.run(name + "/polymer_melt",
+                      sysdef->getParticleData()->getNGlobal(),
+                      [&](uint64_t timestep)
+                      {
+                          nlist->forceUpdate();
+                          nlist->compute(timestep);
+                      });
+            }
+        }
+
+    if (suite.isSelected("PotentialPair<EvaluatorPairLJ>/lj_liquid"))
+        {
+        auto sysdef = makeLJLiquid(N, Scalar(0.8), exec_conf);
+        auto nlist = make_nlist("binned", sysdef, Scalar(2.5));
+        auto lj = make_lj(sysdef, nlist);
+
+        // the particles do not move, so the neighbor list is built only once
+        suite.run("PotentialPair<EvaluatorPairLJ>/lj_liquid",
+                  N,
+                  [&](uint64_t timestep) { lj->compute(timestep); });
+        }
+
+    if (suite.isSelected("PPPMForceCompute/lj_liquid"))
+        {
+        auto sysdef = makeLJLiquid(N, Scalar(0.8), exec_conf);
+        auto pdata = sysdef->getParticleData();
+            {
+            ArrayHandle<Scalar> h_charge(pdata->getCharges(),
+                                         access_location::host,
+                                         access_mode::overwrite);
+            for (unsigned int i = 0; i < pdata->getN(); i++)
+                h_charge.data[i] = (i % 2 == 0) ? Scalar(1.0) : Scalar(-1.0);
+            }
+
+        auto nlist = make_nlist("binned", sysdef, Scalar(2.5));
+        auto group = std::make_shared<ParticleGroup>(sysdef, std::make_shared<ParticleFilterAll>());
+
+        std::shared_ptr<PPPMForceCompute> pppm;
+#ifdef ENABLE_HIP
+        if (exec_conf->isCUDAEnabled())
+            pppm = std::make_shared<PPPMForceComputeGPU>(sysdef, nlist, group);
+        else
+#endif
+            pppm = std::make_shared<PPPMForceCompute>(sysdef, nlist, group);
+        pppm->setParams(64, 64, 64, 5, Scalar(1.2), Scalar(2.5));
+
+        suite.run("PPPMForceCompute/lj_liquid",
+                  N,
+                  [&](uint64_t timestep) { pppm->compute(timestep); });
+        }
+    }
+
+HOOMD_BENCHMARK_MAIN("md", benchmark_md)
@@ -22,7 +22,7 @@ Warning:
 from hoomd.md import _md
 from hoomd.data.parameterdicts import ParameterDict, TypeParameterDict
 from hoomd.data.typeparam import TypeParameter
-from hoomd.data.typeconverter import OnlyIf, to_type_converter
+from hoomd.data.typeconverter import OnlyFrom, OnlyIf, to_type_converter
 from hoomd.md.force import Force
 import hoomd
 
@@ -52,6 +52,8 @@ class Distance(Constraint):
 
     Args:
         tolerance (float): Relative tolerance for constraint violation warnings.
+        solver (str): Method to solve the linear system of equations
+            (``'direct'`` or ``'iterative'``).
 
     `Distance` applies forces between particles that constrain the distances
     between particles to specific values. The algorithm implemented is described
@@ -96,14 +98,28 @@ class Distance(Constraint):
         issue a warning message. It does not influence the computation of the
         constraint force.
 
+    With ``solver='direct'``, `Distance` solves the linear system with a sparse
+    LU factorization. With ``solver='iterative'``, it uses the BiCGSTAB method
+    with a Jacobi preconditioner, starting from the solution of the previous
+    step. The iterative solver avoids the factorization and is faster for
+    large numbers of constraints. It falls back to the LU factorization in
+    steps where it does not converge. Both solvers run on the host, except
+    the direct solver on GPUs when HOOMD-blue is built with cuSOLVER.
+
     Attributes:
         tolerance (float): Relative tolerance for constraint violation warnings.
+
+        solver (str): Method to solve the linear system of equations
+            (``'direct'`` or ``'iterative'``).
     """
 
     _cpp_class_name = "ForceDistanceConstraint"
 
-    def __init__(self, tolerance=1e-3):
-        self._param_dict.update(ParameterDict(tolerance=float(tolerance)))
+    def __init__(self, tolerance=1e-3, solver='direct'):
+        self._param_dict.update(
+            ParameterDict(tolerance=float(tolerance),
+                          solver=OnlyFrom(['direct', 'iterative'])))
+        self.solver = solver
 
 
 class Rigid(Constraint):
@@ -202,6 +202,31 @@ class OPLS(Dihedral):
 
     :math:`k_n` are the force coefficients in the Fourier series.
 
+    .. rubric:: 1-4 special pairs
+
+    `OPLS` optionally computes the 1-4 interaction between the end particles
+    :math:`i` and :math:`l` of each dihedral in the same loop as the dihedral:
+
+    .. math::
+
+        U_{14}(r) = 4 \varepsilon \left[ \left(\frac{\sigma}{r}\right)^{12}
+                    - \left(\frac{\sigma}{r}\right)^6 \right]
+                    + \alpha \frac{q_i q_l}{r}
+
+    for :math:`r < r_{\mathrm{cut}}` (no shifting). This is the same
+    interaction as `hoomd.md.special_pair.LJ` plus
+    `hoomd.md.special_pair.Coulomb`, without a separate list of pairs in the
+    state. `OPLS` assigns 1/2 of :math:`U_{14}` to each end particle.
+
+    Note:
+        Set non-zero `special_pair` parameters for only one dihedral type of
+        every 1-4 pair. `OPLS` computes the special pair once for every
+        dihedral with a non-zero interaction, and dihedrals with multiple terms
+        or rings may list the same pair more than once.
+
+    Note:
+        1-4 special pairs are only available on the CPU.
+
     Attributes:
         params (`TypeParameter` [``dihedral type``, `dict`]):
             The parameter of the OPLS bonds for each particle type.
@@ -219,10 +244,32 @@ class OPLS(Dihedral):
             * ``k4`` (`float`, **required**) -  force constant of the
               fourth term :math:`[\mathrm{energy}]`
 
+        special_pair (`TypeParameter` [``dihedral type``, `dict`]):
+            The 1-4 special pair parameters for each dihedral type.
+            The dictionary has the following keys:
+
+            * ``epsilon`` (`float`, **optional**) - energy parameter
+              :math:`\varepsilon` :math:`[\mathrm{energy}]` (default: 0)
+
+            * ``sigma`` (`float`, **optional**) - particle size
+              :math:`\sigma` :math:`[\mathrm{length}]` (default: 1)
+
+            * ``alpha`` (`float`, **optional**) - Coulomb scaling factor
+              :math:`\alpha` :math:`[\mathrm{energy} \cdot \mathrm{length}
+              \cdot \mathrm{charge}^{-2}]` (default: 0)
+
+            * ``r_cut`` (`float`, **optional**) - cutoff radius
+              :math:`[\mathrm{length}]`. Set to 0 to disable the special
+              pair (default: 0)
+
     Examples::
 
         opls = dihedral.OPLS()
         opls.params['A-A-A-A'] = dict(k1=1.0, k2=1.0, k3=1.0, k4=1.0)
+        opls.special_pair['A-A-A-A'] = dict(epsilon=0.5,
+                                             sigma=1.0,
+                                             alpha=0.5,
+                                             r_cut=3.0)
     """
     _cpp_class_name = "OPLSDihedralForceCompute"
 
@@ -237,3 +284,12 @@ class OPLS(Dihedral):
                               k4=float,
                               len_keys=1))
         self._add_typeparam(params)
+
+        special_pair = TypeParameter(
+            'special_pair', 'dihedral_types',
+            TypeParameterDict(epsilon=0.0,
+                              sigma=1.0,
+                              alpha=0.0,
+                              r_cut=0.0,
+                              len_keys=1))
+        self._add_typeparam(special_pair)
@@ -4,6 +4,7 @@
 """Apply forces to particles."""
 
 from abc import abstractmethod
+import copy
 
 import hoomd
 from hoomd.md import _md
@@ -317,6 +318,83 @@ class Custom(Force):
         pass
 
 
+class Plugin(Force):
+    """Forces implemented by C++ plugins.
+
+    Args:
+        plugin (hoomd.md._md.ForcePlugin): The plugin that computes the forces.
+        nlist (hoomd.md.nlist.NeighborList): Neighbor list to pass to the
+            plugin. Required when the plugin has a nonzero cutoff radius.
+
+    `Plugin` computes forces with a C++ object provided by a component, such as
+    a host for a machine learned potential. Unlike `Custom`, `Plugin` does not
+    call into Python when it computes forces. It passes the positions, tags,
+    charges, and neighbor list of the local and ghost particles directly to
+    the plugin, which writes the forces, energies, virials, and torques. On the
+    GPU, the plugin receives device pointers when it supports them and runs on
+    HOOMD's stream. The plugin computes without holding the Python global
+    interpreter lock.
+
+    Components implement plugins by deriving from the ``ForcePlugin`` class in
+    ``hoomd/md/ForcePlugin.h`` and exporting the derived class to Python with a
+    ``std::shared_ptr`` holder.
+
+    Example::
+
+        plugin = my_component.Model("model.pt")
+        force = hoomd.md.force.Plugin(plugin=plugin, nlist=nlist)
+        integrator.forces.append(force)
+
+    Note:
+        `Plugin` sets the neighbor list storage mode to full when the plugin
+        requests it.
+
+    Attributes:
+        nlist (hoomd.md.nlist.NeighborList): Neighbor list passed to the
+            plugin.
+    """
+
+    def __init__(self, plugin, nlist=None):
+        super().__init__()
+        if not isinstance(plugin, _md.ForcePlugin):
+            raise TypeError("plugin must be a hoomd.md._md.ForcePlugin.")
+        if plugin.getRCut() > 0 and nlist is None:
+            raise ValueError(f"The plugin {plugin.getName()} requires a "
+                             f"neighbor list.")
+        self._plugin = plugin
+
+        self._param_dict.update(
+            ParameterDict(nlist=OnlyTypes(hoomd.md.nlist.NeighborList,
+                                          allow_none=True)))
+        self.nlist = nlist
+
+    @property
+    def plugin(self):
+        """hoomd.md._md.ForcePlugin: The plugin that computes the forces."""
+        return self._plugin
+
+    def _setattr_param(self, attr, value):
+        if attr == "nlist" and self._attached:
+            raise RuntimeError("nlist cannot be set after scheduling.")
+        super()._setattr_param(attr, value)
+
+    def _attach_hook(self):
+        nlist = None
+        if self.nlist is not None:
+            if (self.nlist._attached
+                    and self.nlist._simulation != self._simulation):
+                self.nlist = copy.deepcopy(self.nlist)
+            self.nlist._attach(self._simulation)
+            nlist = self.nlist._cpp_obj
+
+        self._cpp_obj = _md.PluginForceCompute(
+            self._simulation.state._cpp_sys_def, self._plugin, nlist)
+
+    def _detach_hook(self):
+        if self.nlist is not None:
+            self.nlist._detach()
+
+
 class Active(Force):
     r"""Active force.
 
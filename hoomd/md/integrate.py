@@ -53,6 +53,10 @@ class _DynamicIntegrator(BaseIntegrator):
     def _post_attach_hook(self):
         self.validate_groups()
 
+    @property
+    def _checkpoint_children(self):
+        return [*self.forces, *self.constraints, *self.methods]
+
     def _detach_hook(self):
         self._forces._unsync()
         self._methods._unsync()
@@ -153,6 +157,20 @@ class Integrator(_DynamicIntegrator):
         half_step_hook (hoomd.md.HalfStepHook): Enables the user to perform
             arbitrary computations during the half-step of the integration.
 
+        slow_forces (Sequence[hoomd.md.force.Force]): Sequence of forces
+          evaluated every `slow_force_interval` time steps. The default value
+          of ``None`` initializes an empty list.
+
+        slow_force_interval (int): Number of time steps between evaluations of
+          the `slow_forces`.
+
+        max_displacement (float): Maximum distance a particle may move in one
+          time step :math:`[\mathrm{length}]`. Set to ``None`` to integrate
+          with the fixed time step `dt`.
+
+        concurrent_forces (bool): When True, compute independent forces on
+          separate GPU streams.
+
     `Integrator` is the top level class that orchestrates the time integration
     step in molecular dynamics simulations. The integration `methods` define
     the equations of motion to integrate under the influence of the given
@@ -191,6 +209,63 @@ class Integrator(_DynamicIntegrator):
     special case, as it only integrates the degrees of freedom of each body's
     center of mass. See `hoomd.md.constrain.Rigid` for details.
 
+    .. rubric:: Multiple time steps
+
+    `Integrator` evaluates the forces in `slow_forces` only on time steps that
+    are multiples of `slow_force_interval` :math:`n`. On those steps, it adds
+    :math:`n` times their forces and torques to the net force and torque. The
+    integration methods apply the net force in two half step kicks, so this
+    is the impulse (r-RESPA) multiple time step scheme: the slow forces kick
+    the particles by half of the outer time step :math:`n \cdot dt` at the
+    start and end of every outer step while the `forces` are integrated with
+    the time step :math:`dt`. Use `slow_forces` for forces that vary slowly
+    in time, such as `hoomd.md.long_range.pppm.Coulomb`, and keep
+    `hoomd.md.pair.Ewald` and all short ranged forces in `forces`.
+
+    The net energy and virial include the energies and virials of the
+    `slow_forces` only on the steps where they are evaluated. Log quantities
+    that depend on them, such as the potential energy and pressure, on those
+    steps only. Integration methods that couple to the pressure or the
+    potential energy, such as barostats, see the missing contribution on the
+    other steps.
+
+    .. rubric:: Adaptive time step
+
+    When `max_displacement` :math:`d` is set, `Integrator` chooses the size of
+    each time step :math:`\Delta t \le dt` so that no particle moves further
+    than :math:`d` when it continues with its current velocity
+    :math:`\vec{v}_i` and acceleration :math:`\vec{F}_{\mathrm{net},i} / m_i`:
+
+    .. math::
+
+        \Delta t = \min \left( dt, \min_i \frac{2 d}{|\vec{v}_i| +
+        \sqrt{|\vec{v}_i|^2 + 2 d |\vec{F}_{\mathrm{net},i}| / m_i}}
+        \right)
+
+    Use this in protocols (such as compressions and quenches) where the
+    largest stable step size changes over the course of the run: set `dt` to
+    the step size that is stable in the steady state and `max_displacement` to
+    bound the steps taken when the forces are large. Triggers and
+    `slow_force_interval` continue to count time steps, while `time` reports
+    the elapsed simulation time. The neighbor list distance check compares
+    the actual displacements with the buffer, so it remains valid at any step
+    size. Set :math:`d` well below half of the neighbor list buffer.
+
+    Note:
+        The adaptive time step reads the particle velocities and net forces on
+        the host every time step.
+
+    .. rubric:: Concurrent forces
+
+    On the GPU, `Integrator` computes the forces one after another by default.
+    Set `concurrent_forces` to ``True`` to launch the kernels of the bond
+    forces (`hoomd.md.bond`, `hoomd.md.mesh.bond`) and external potentials
+    (`hoomd.md.external.field`, `hoomd.md.external.wall`) each on a separate
+    stream so that they may run at the same time. These forces write only to
+    their own arrays. All streams complete before `Integrator` sums the net
+    force. `force_streams` reports the stream used by each force.
+    `concurrent_forces` has no effect on the CPU.
+
     .. rubric:: Degrees of freedom
 
     `Integrator` always integrates the translational degrees of freedom.
@@ -262,6 +337,19 @@ class Integrator(_DynamicIntegrator):
 
         half_step_hook (hoomd.md.HalfStepHook): User defined implementation to
             perform computations during the half-step of the integration.
+
+        slow_forces (list[hoomd.md.force.Force]): List of forces evaluated
+            every `slow_force_interval` time steps.
+
+        slow_force_interval (int): Number of time steps between evaluations of
+            the `slow_forces`.
+
+        max_displacement (float): Maximum distance a particle may move in one
+            time step :math:`[\mathrm{length}]`. ``None`` when the time step
+            is fixed.
+
+        concurrent_forces (bool): When True, compute independent forces on
+            separate GPU streams.
     """
 
     def __init__(self,
@@ -271,27 +359,67 @@ class Integrator(_DynamicIntegrator):
                  constraints=None,
                  methods=None,
                  rigid=None,
-                 half_step_hook=None):
+                 half_step_hook=None,
+                 slow_forces=None,
+                 slow_force_interval=1,
+                 max_displacement=None,
+                 concurrent_forces=False):
 
         super().__init__(forces, constraints, methods, rigid)
 
+        slow_forces = [] if slow_forces is None else slow_forces
+        self._slow_forces = syncedlist.SyncedList(
+            Force,
+            syncedlist._PartialGetAttr('_cpp_obj'),
+            iterable=slow_forces)
+
         self._param_dict.update(
             ParameterDict(
                 dt=float(dt),
                 integrate_rotational_dof=bool(integrate_rotational_dof),
                 half_step_hook=OnlyTypes(hoomd.md.HalfStepHook,
-                                         allow_none=True)))
+                                         allow_none=True),
+                slow_force_interval=int(slow_force_interval),
+                max_displacement=OnlyTypes(float, allow_none=True),
+                concurrent_forces=bool(concurrent_forces)))
 
         self.half_step_hook = half_step_hook
+        self.max_displacement = max_displacement
 
     def _attach_hook(self):
         # initialize the reflected c++ class
         self._cpp_obj = _md.IntegratorTwoStep(
             self._simulation.state._cpp_sys_def, self.dt)
+        self._slow_forces._sync(self._simulation, self._cpp_obj.slow_forces)
         # Call attach from DynamicIntegrator which attaches forces,
         # constraint_forces, and methods, and calls super()._attach() itself.
         super()._attach_hook()
 
+    def _detach_hook(self):
+        self._slow_forces._unsync()
+        super()._detach_hook()
+
+    @property
+    def _checkpoint_children(self):
+        return [*super()._checkpoint_children, *self.slow_forces]
+
+    def _get_checkpoint_state(self):
+        state = super()._get_checkpoint_state()
+        state['time'] = self._cpp_obj.time
+        return state
+
+    def _set_checkpoint_state(self, state):
+        super()._set_checkpoint_state(state)
+        self._cpp_obj.time = state['time']
+
+    @property
+    def slow_forces(self):
+        return self._slow_forces
+
+    @slow_forces.setter
+    def slow_forces(self, value):
+        _set_synced_list(self._slow_forces, value)
+
     def __setattr__(self, attr, value):
         """Hande group DOF update when setting integrate_rotational_dof."""
         super().__setattr__(attr, value)
@@ -299,6 +427,37 @@ class Integrator(_DynamicIntegrator):
                 and self._simulation.state is not None):
             self._simulation.state.update_group_dof()
 
+    @property
+    def force_streams(self):
+        """list[int]: The GPU stream used by each force in the last step.
+
+        The list holds one entry per element of `forces` followed by one entry
+        per element of `slow_forces`. Stream 0 is the default stream. Forces on
+        streams 1 and up may run concurrently with each other. `force_streams`
+        is empty before the first step and on the CPU.
+        """
+        if not self._attached:
+            return []
+        return list(self._cpp_obj.force_streams)
+
+    @hoomd.logging.log(requires_run=True)
+    def step_dt(self):
+        """float: Size of the most recent time step :math:`[\mathrm{time}]`.
+
+        `step_dt` is equal to `dt` unless `max_displacement` is set.
+        """
+        return self._cpp_obj.step_dt
+
+    @hoomd.logging.log(requires_run=True)
+    def time(self):
+        """float: Simulation time elapsed in the steps taken by this integrator \
+            :math:`[\mathrm{time}]`.
+
+        `time` is the sum of the sizes of all time steps since the integrator
+        was attached to the simulation.
+        """
+        return self._cpp_obj.time
+
     @hoomd.logging.log(category="sequence", requires_run=True)
     def linear_momentum(self):
         """tuple(float,float,float): The linear momentum vector of the system \
@@ -9,7 +9,15 @@ import math
 import numpy
 
 
-def make_pppm_coulomb_forces(nlist, resolution, order, r_cut, alpha=0):
+def make_pppm_coulomb_forces(nlist,
+                             resolution,
+                             order,
+                             r_cut,
+                             alpha=0,
+                             differentiation='ik',
+                             slab_correction='none',
+                             tabulate=False,
+                             exclusion_correction=False):
     """Long range Coulomb interactions evaluated using the PPPM method.
 
     Args:
@@ -22,6 +30,14 @@ def make_pppm_coulomb_forces(nlist, resolution, order, r_cut, alpha=0):
           space terms :math:`\\mathrm{[length]}`.
         alpha (float): Debye screening parameter
           :math:`\\mathrm{[length^{-1}]}`.
+        differentiation (str): Scheme that computes the forces from the
+          mesh, ``'ik'`` or ``'ad'``.
+        slab_correction (str): Correction for systems that are periodic only
+          in x and y, ``'none'``, ``'dipole'``, or ``'elc'``.
+        tabulate (bool): Set to `True` to compute the real space term with
+          `md.pair.EwaldTable` instead of `md.pair.Ewald`.
+        exclusion_correction (bool): Set to `True` to correct the excluded
+          pairs in the real space pair loop.
 
     Evaluate the potential energy :math:`U_\\mathrm{coulomb}` and apply
     the corresponding forces to the particles in the simulation.
@@ -85,12 +101,72 @@ def make_pppm_coulomb_forces(nlist, resolution, order, r_cut, alpha=0):
     * :math:`U_\\mathrm{ewald,i}` (``Ewald.additional_energy``):
       Energies from the real space calculation for non-excluded particle pairs.
 
+    With ``exclusion_correction=True``, the real space force visits the
+    excluded pairs in its pair loop and subtracts the long range part of
+    their interaction there, which saves `md.long_range.pppm.Coulomb` a
+    separate pass over the exclusions. The energies from the non-body
+    neighbor list exclusions are then part of :math:`U_\\mathrm{ewald,i}`
+    instead of :math:`U_{\\mathrm{coulomb},i}`. The total energy is the same.
+
+    Note:
+        ``exclusion_correction=True`` is only implemented on the CPU.
+
     Warning:
         Do not apply bonds, angles, dihedrals, or impropers between particles
         in the same rigid body. Doing so will cause the exclusions to be double
         counted (once in :math:`U_\\mathrm{coulomb,additional}` and again in
         :math:`U_{\\mathrm{coulomb},i}`).
 
+    .. rubric:: Differentiation
+
+    With ``differentiation='ik'``, `md.long_range.pppm.Coulomb` computes the
+    electric field on the mesh in reciprocal space, which takes three inverse
+    Fourier transforms. With ``differentiation='ad'``, it computes only the
+    potential on the mesh and differentiates the charge assignment function
+    analytically to obtain the forces, which takes a single inverse Fourier
+    transform and less communication in MPI simulations. The ``'ad'`` scheme
+    uses the matching optimal influence function. It does not conserve
+    momentum exactly and is somewhat less accurate than ``'ik'`` for the same
+    mesh, especially for low orders.
+
+    Note:
+        ``differentiation='ad'`` is only implemented on the CPU.
+
+    .. rubric:: Slab systems
+
+    To model a slab that is periodic in x and y only, place a vacuum gap
+    between the slab and its periodic images in z and set
+    ``slab_correction``:
+
+    * ``'dipole'``: Subtract the interaction of the slab with its images to
+      the order of the dipole moment (`Yeh and Berkowitz 1999`_, with the
+      terms for non-neutral systems of `Ballenegger et al. 2009`_). This
+      requires a large gap, typically twice the thickness of the slab.
+    * ``'elc'``: Also subtract the remaining interactions with the image
+      layers using the electrostatic layer correction (`Arnold et al. 2002`_).
+      The correction converges exponentially with the width of the gap, so
+      a gap of a few particle diameters suffices. Its cost grows with the
+      number of in-plane Fourier modes, which is inversely proportional to
+      the square of the gap width. ELC requires a neutral system.
+
+    The box must have :math:`xz = yz = 0`. The slab corrections do not
+    contribute to the virial.
+
+    .. rubric:: Box fluctuations
+
+    `md.long_range.pppm.Coulomb` recomputes the influence function whenever
+    the box changes, which is every step with a constant pressure integration
+    method. Set ``Coulomb.influence_tolerance`` to a positive value to instead
+    rescale the influence function analytically while the box lengths and tilt
+    factors differ from those of the last exact computation by less than the
+    tolerance. The rescaling neglects the change of the aliasing terms, so the
+    force error grows with the tolerance; values of order ``1e-3`` keep it well
+    below the error of the mesh. The influence function is computed exactly
+    again after ``Coulomb.influence_recompute_period`` rescaled updates.
+
+    Note:
+        The rescaling is only implemented on the CPU.
+
     .. rubric:: Screening
 
     The Debye screening parameter :math:`\\alpha` enables the screening of
@@ -120,20 +196,32 @@ def make_pppm_coulomb_forces(nlist, resolution, order, r_cut, alpha=0):
     .. _D. LeBard et. al. 2012: http://dx.doi.org/10.1039/c1sm06787g
 
     .. _Salin, G and Caillol, J. 2000: http://dx.doi.org/10.1063/1.1326477
+
+    .. _Yeh and Berkowitz 1999: https://doi.org/10.1063/1.479595
+
+    .. _Ballenegger et al. 2009: https://doi.org/10.1063/1.3216473
+
+    .. _Arnold et al. 2002: https://doi.org/10.1063/1.1491955
     """
-    real_space_force = hoomd.md.pair.Ewald(nlist)
+    if tabulate:
+        real_space_force = hoomd.md.pair.EwaldTable(nlist)
+    else:
+        real_space_force = hoomd.md.pair.Ewald(nlist)
 
     # the real space force may be attached before the reciprocal space one
     # set default parameters to avoid errors in this case
     real_space_force.params.default = dict(kappa=0, alpha=0)
     real_space_force.r_cut.default = r_cut
+    real_space_force.exclusion_correction = exclusion_correction
 
     reciprocal_space_force = Coulomb(nlist=nlist,
                                      resolution=resolution,
                                      order=order,
                                      r_cut=r_cut,
                                      alpha=0,
-                                     pair_force=real_space_force)
+                                     pair_force=real_space_force,
+                                     differentiation=differentiation,
+                                     slab_correction=slab_correction)
 
     return real_space_force, reciprocal_space_force
 
@@ -155,22 +243,49 @@ class Coulomb(Force):
           space terms :math:`\\mathrm{[length]}`.
         alpha (float): Debye screening parameter
           :math:`\\mathrm{[length^{-1}]}`.
+        differentiation (str): Scheme that computes the forces from the
+          mesh, ``'ik'`` or ``'ad'``.
+        slab_correction (str): Correction for systems that are periodic only
+          in x and y, ``'none'``, ``'dipole'``, or ``'elc'``.
+        influence_tolerance (float): Largest relative change of the box
+          lengths and change of the tilt factors for which the influence
+          function is rescaled instead of recomputed, 0 to always recompute
+          :math:`\mathrm{[dimensionless]}`. Defaults to 0.
+        influence_recompute_period (int): Largest number of consecutive
+          rescaled updates of the influence function. Defaults to 100.
     """
 
-    def __init__(self, nlist, resolution, order, r_cut, alpha, pair_force):
+    def __init__(self,
+                 nlist,
+                 resolution,
+                 order,
+                 r_cut,
+                 alpha,
+                 pair_force,
+                 differentiation='ik',
+                 slab_correction='none'):
         super().__init__()
         self._nlist = hoomd.data.typeconverter.OnlyTypes(
             hoomd.md.nlist.NeighborList)(nlist)
         self._param_dict.update(
-            hoomd.data.parameterdicts.ParameterDict(resolution=(int, int, int),
-                                                    order=int,
-                                                    r_cut=float,
-                                                    alpha=float))
+            hoomd.data.parameterdicts.ParameterDict(
+                resolution=(int, int, int),
+                order=int,
+                r_cut=float,
+                alpha=float,
+                differentiation=hoomd.data.typeconverter.OnlyFrom(
+                    ['ik', 'ad']),
+                slab_correction=hoomd.data.typeconverter.OnlyFrom(
+                    ['none', 'dipole', 'elc']),
+                influence_tolerance=float(0.0),
+                influence_recompute_period=int(100)))
 
         self.resolution = resolution
         self.order = order
         self.r_cut = r_cut
         self.alpha = alpha
+        self.differentiation = differentiation
+        self.slab_correction = slab_correction
         self._pair_force = pair_force
 
     def _attach_hook(self):
@@ -179,6 +294,9 @@ class Coulomb(Force):
         if isinstance(self._simulation.device, hoomd.device.CPU):
             cls = hoomd.md._md.PPPMForceCompute
         else:
+            if self.differentiation == 'ad':
+                raise RuntimeError("differentiation='ad' is not implemented "
+                                   "on the GPU.")
             cls = hoomd.md._md.PPPMForceComputeGPU
 
         # Access set parameters before attaching. These values are needed to
@@ -248,12 +366,20 @@ class Coulomb(Force):
         # self._pair_force.r_cut[(particle_types, particle_types)] = rcut
 
         # workaround
+        # keep the remaining parameters, such as those of md.pair.EwaldTable
         for a in particle_types:
             for b in particle_types:
-                self._pair_force.params[(a, b)] = dict(kappa=kappa, alpha=alpha)
+                params = dict(self._pair_force.params[(a, b)])
+                params.update(kappa=kappa, alpha=alpha)
+                self._pair_force.params[(a, b)] = params
                 self._pair_force.r_cut[(a, b)] = rcut
 
-        self._cpp_obj.setParams(Nx, Ny, Nz, order, kappa, rcut, alpha)
+        self._cpp_obj.setParams(Nx, Ny, Nz, order, kappa, rcut, alpha,
+                                self.differentiation == 'ad')
+
+        # skip the pass over the exclusions when the pair force corrects them
+        self._cpp_obj.pair_exclusion_correction = (
+            self._pair_force.exclusion_correction)
 
     @property
     def nlist(self):
@@ -272,6 +398,205 @@ class Coulomb(Force):
             self._pair_force.nlist = value
 
 
+def make_pppm_dispersion_forces(nlist,
+                                resolution,
+                                order,
+                                r_cut,
+                                tolerance=1e-3,
+                                exclusion_correction=False):
+    """Lennard-Jones forces with long range dispersion evaluated using PPPM.
+
+    Args:
+        nlist (hoomd.md.nlist.NeighborList): Neighbor list.
+        resolution (tuple[int, int, int]): Number of grid points in the x, y,
+          and z directions :math:`\\mathrm{[dimensionless]}`.
+        order (int): Number of grid points in each direction to assign the
+          dispersion coefficients to :math:`\\mathrm{[dimensionless]}`.
+        r_cut (float): Cutoff distance between the real space and reciprocal
+          space terms :math:`\\mathrm{[length]}`.
+        tolerance (float): Relative truncation error of the real space term
+          at the cutoff :math:`\\mathrm{[dimensionless]}`.
+        exclusion_correction (bool): Set to `True` to correct the excluded
+          pairs in the real space pair loop.
+
+    Evaluate the Lennard-Jones potential energy without truncation, including
+    the dispersion interactions with all periodic images:
+
+    .. math::
+
+        U = \\frac{1}{2} \\sum_\\vec{n} \\sum_{i=0}^{N-1}
+          \\sum_{j=0}^{N-1} u_\\mathrm{LJ}(\\vec{r}_j - \\vec{r}_i +
+          n_1 \\cdot \\vec{a}_1 + n_2 \\cdot \\vec{a}_2 +
+          n_3 \\cdot \\vec{a}_3)
+
+    The dispersion term :math:`-4 \\varepsilon \\sigma^6 / r^6` is split as
+    in `Essmann et al. 1995`_. `md.pair.LJDispersionEwald` computes the
+    Lennard-Jones potential inside the cutoff minus the long range part of the
+    dispersion term, which decays as :math:`e^{-\\kappa^2 r^2}`.
+    `md.long_range.pppm.Dispersion` computes the long range part with fast
+    Fourier transforms of a mesh of per particle dispersion coefficients
+    :math:`c_i = \\sqrt{4 \\varepsilon_{ii} \\sigma_{ii}^6}`, where
+    :math:`\\varepsilon_{ii}` and :math:`\\sigma_{ii}` are the parameters of
+    the type of particle :math:`i`. The splitting parameter :math:`\\kappa`
+    is chosen so that the real space term at the cutoff is *tolerance* times
+    the dispersion term.
+
+    The mesh term is exact for the geometric combination
+    :math:`4 \\varepsilon_{ij} \\sigma_{ij}^6 = c_i c_j`. With other mixing
+    rules, the real space term is exact inside the cutoff and the mesh term
+    approximates the dispersion interaction beyond it with the geometric
+    combination.
+
+    Set the ``epsilon`` and ``sigma`` parameters of every pair of types in the
+    returned real space force before the simulation is scheduled. Exclusions
+    are handled as in `make_pppm_coulomb_forces`.
+
+    Note:
+        The dispersion mesh is only implemented on the CPU and does not
+        support the slab corrections.
+
+    Important:
+        In MPI simulations with multiple ranks, the grid resolution must be a
+        power of two in each dimension.
+
+    Returns:
+        ``real_space_force``, ``reciprocal_space_force``
+
+        Add both of these forces to the integrator.
+
+    .. _Essmann et al. 1995: https://doi.org/10.1063/1.470117
+    """
+    real_space_force = hoomd.md.pair.LJDispersionEwald(nlist)
+    real_space_force.r_cut.default = r_cut
+    real_space_force.exclusion_correction = exclusion_correction
+
+    reciprocal_space_force = Dispersion(nlist=nlist,
+                                        resolution=resolution,
+                                        order=order,
+                                        r_cut=r_cut,
+                                        tolerance=tolerance,
+                                        pair_force=real_space_force)
+
+    return real_space_force, reciprocal_space_force
+
+
+class Dispersion(Force):
+    """Reciprocal space part of the PPPM dispersion forces.
+
+    Note:
+        Use `make_pppm_dispersion_forces` to create a connected pair of
+        `md.pair.LJDispersionEwald` and `md.long_range.pppm.Dispersion`
+        instances that together implement the PPPM method for dispersion.
+
+    Attributes:
+        resolution (tuple[int, int, int]): Number of grid points in the x, y,
+          and z directions :math:`\\mathrm{[dimensionless]}`.
+        order (int): Number of grid points in each direction to assign the
+          dispersion coefficients to :math:`\\mathrm{[dimensionless]}`.
+        r_cut (float): Cutoff distance between the real space and reciprocal
+          space terms :math:`\\mathrm{[length]}`.
+        tolerance (float): Relative truncation error of the real space term
+          at the cutoff :math:`\\mathrm{[dimensionless]}`.
+    """
+
+    def __init__(self, nlist, resolution, order, r_cut, tolerance,
+                 pair_force):
+        super().__init__()
+        self._nlist = hoomd.data.typeconverter.OnlyTypes(
+            hoomd.md.nlist.NeighborList)(nlist)
+        self._param_dict.update(
+            hoomd.data.parameterdicts.ParameterDict(
+                resolution=(int, int, int),
+                order=int,
+                r_cut=float,
+                tolerance=float))
+
+        self.resolution = resolution
+        self.order = order
+        self.r_cut = r_cut
+        self.tolerance = tolerance
+        self._pair_force = pair_force
+
+    def _attach_hook(self):
+        if not isinstance(self._simulation.device, hoomd.device.CPU):
+            raise RuntimeError("Dispersion PPPM is not implemented on the "
+                               "GPU.")
+
+        self.nlist._attach(self._simulation)
+
+        Nx, Ny, Nz = self.resolution
+        rcut = self.r_cut
+        kappa = _dispersion_kappa(rcut, self.tolerance)
+
+        group = self._simulation.state._get_group(hoomd.filter.All())
+        self._cpp_obj = hoomd.md._md.PPPMForceCompute(
+            self._simulation.state._cpp_sys_def, self.nlist._cpp_obj, group)
+
+        # per type coefficients of the geometric combination
+        particle_types = self._simulation.state.particle_types
+        coefficients = []
+        for a in particle_types:
+            params = self._pair_force.params[(a, a)]
+            coefficients.append(
+                math.sqrt(4 * params['epsilon'] * params['sigma']**6))
+
+        # see the workaround in Coulomb
+        for i, a in enumerate(particle_types):
+            for j, b in enumerate(particle_types):
+                params = dict(self._pair_force.params[(a, b)])
+                params.update(kappa=kappa,
+                              c6_mesh=coefficients[i] * coefficients[j])
+                self._pair_force.params[(a, b)] = params
+                self._pair_force.r_cut[(a, b)] = rcut
+
+        self._cpp_obj.setParams(Nx, Ny, Nz, self.order, kappa, rcut, 0, False)
+        self._cpp_obj.setDispersionCoefficients(coefficients)
+
+        # skip the pass over the exclusions when the pair force corrects them
+        self._cpp_obj.pair_exclusion_correction = (
+            self._pair_force.exclusion_correction)
+
+    @property
+    def nlist(self):
+        """Neighbor list used to compute the real space term."""
+        return self._nlist
+
+    @nlist.setter
+    def nlist(self, value):
+        if self._attached:
+            raise RuntimeError("nlist cannot be set after scheduling.")
+        else:
+            self._nlist = hoomd.data.typeconverter.OnlyTypes(
+                hoomd.md.nlist.NeighborList)(value)
+
+            # ensure that the pair force uses the same neighbor list
+            self._pair_force.nlist = value
+
+
+def _dispersion_kappa(rcut, tolerance):
+    """Solve g(kappa * rcut) = tolerance for the splitting parameter."""
+    if not 0 < tolerance < 1:
+        raise ValueError("The dispersion tolerance must be in (0, 1).")
+
+    # g(x) = exp(-x^2) (1 + x^2 + x^4 / 2) decreases monotonically from 1
+    def g(x):
+        return math.exp(-x * x) * (1 + x * x + x**4 / 2)
+
+    lower = 0.0
+    upper = 1.0
+    while g(upper) > tolerance:
+        upper *= 2
+
+    while upper - lower > 1e-10 * upper:
+        middle = 0.5 * (lower + upper)
+        if g(middle) > tolerance:
+            lower = middle
+        else:
+            upper = middle
+
+    return 0.5 * (lower + upper) / rcut
+
+
 def _diffpr(hx, hy, hz, xprd, yprd, zprd, N, order, kappa, q2, rcut):
     """Part of the algorithm that computes the estimated error of the method."""
     lprx = _rms(hx, xprd, N, order, kappa, q2)
@@ -62,6 +62,10 @@ class Thermostatted(Method):
             return
         super()._setattr_param(attr, value)
 
+    @property
+    def _checkpoint_children(self):
+        return [] if self.thermostat is None else [self.thermostat]
+
     def _thermostat_setter(self, new_thermostat):
         if new_thermostat is self.thermostat:
             return
@@ -462,6 +466,8 @@ class ConstantPressure(Thermostatted):
                 npt.barostat_dof = numpy.load(file=path / 'barostat_dof.npy')
     """
 
+    _checkpoint_params = ('barostat_dof',)
+
     def __init__(self,
                  filter,
                  S,
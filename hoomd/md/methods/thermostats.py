@@ -91,6 +91,11 @@ class MTTK(Thermostat):
         and to avoid long time to equilibration. The recommended value for most
         systems is :math:`\tau = 100 \delta t`.
 
+    Note:
+        On GPU devices, the thermostat degrees of freedom remain in device
+        memory during the run. Reading `translational_dof`,
+        `rotational_dof`, or `energy` copies them to the host.
+
     See Also:
         `G. J. Martyna, D. J. Tobias, M. L. Klein 1994
         <http://dx.doi.org/10.1063/1.467468>`_ and `J. Cao, G. J. Martyna 1996
@@ -186,6 +191,8 @@ class MTTK(Thermostat):
                     file=path / 'rotational_dof.npy')
     """
 
+    _checkpoint_params = ('translational_dof', 'rotational_dof')
+
     def __init__(self, kT, tau):
         super().__init__(kT)
         param_dict = ParameterDict(tau=float(tau),
@@ -196,9 +203,12 @@ class MTTK(Thermostat):
 
     def _attach_hook(self):
         group = self._simulation.state._get_group(self._filter)
-        self._cpp_obj = _md.MTTKThermostat(self.kT, group, self._thermo,
-                                           self._simulation.state._cpp_sys_def,
-                                           self.tau)
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            cpp_cls = _md.MTTKThermostat
+        else:
+            cpp_cls = _md.MTTKThermostatGPU
+        self._cpp_obj = cpp_cls(self.kT, group, self._thermo,
+                                self._simulation.state._cpp_sys_def, self.tau)
 
     @hoomd.logging.log(requires_run=True)
     def energy(self):
@@ -64,6 +64,8 @@ class FIRE(_DynamicIntegrator):
         min_steps_conv (int):
             A minimum number of attempts before convergence criteria are
             considered.
+        check_interval (int):
+            Number of steps between evaluations of the convergence criteria.
 
     `FIRE` is a `hoomd.md.Integrator` that uses the Fast Inertial Relaxation
     Engine (FIRE) algorithm to minimize the potential energy for a group of
@@ -110,6 +112,16 @@ class FIRE(_DynamicIntegrator):
     system, the other particles will be kept frozen but will still interact
     with the particles being moved.
 
+    `FIRE` evaluates the convergence criteria every `check_interval` steps.
+    On the GPU, the sums over the particles and the adaptation of
+    :math:`\\alpha` and :math:`\\delta t` take place on the device, which
+    copies its state to the host only on the steps that check for convergence.
+    Set `check_interval` larger than 1 to avoid waiting on the device every
+    step. The integration methods then apply the :math:`\\delta t` chosen by
+    the algorithm at the next check, and `converged` updates only on those
+    steps. Simulations with domain decomposition communicate the sums every
+    step regardless of `check_interval`.
+
     Examples::
 
         fire = md.minimize.FIRE(dt=0.05,
@@ -194,6 +206,8 @@ class FIRE(_DynamicIntegrator):
         min_steps_conv (int):
             A minimum number of attempts before convergence criteria are
             considered.
+        check_interval (int):
+            Number of steps between evaluations of the convergence criteria.
 
     """
     _cpp_class_name = "FIREEnergyMinimizer"
@@ -213,7 +227,8 @@ class FIRE(_DynamicIntegrator):
                  fdec_dt=0.5,
                  alpha_start=0.1,
                  fdec_alpha=0.99,
-                 min_steps_conv=10):
+                 min_steps_conv=10,
+                 check_interval=1):
 
         super().__init__(forces, constraints, methods, rigid)
 
@@ -229,9 +244,11 @@ class FIRE(_DynamicIntegrator):
             angmom_tol=float(angmom_tol),
             energy_tol=float(energy_tol),
             min_steps_conv=OnlyTypes(int, preprocess=positive_real),
+            check_interval=OnlyTypes(int, preprocess=positive_real),
             _defaults={
                 'min_steps_adapt': 5,
-                'min_steps_conv': 10
+                'min_steps_conv': 10,
+                'check_interval': 1
             })
 
         self._param_dict.update(pdict)
@@ -239,6 +256,7 @@ class FIRE(_DynamicIntegrator):
         # set these values explicitly so they can be validated
         self.min_steps_adapt = min_steps_adapt
         self.min_steps_conv = min_steps_conv
+        self.check_interval = check_interval
 
         # have to remove methods from old syncedlist so new syncedlist doesn't
         # think members are attached to multiple syncedlists
@@ -32,53 +32,26 @@ void export_TableDihedralForceCompute(pybind11::module& m);
 void export_HarmonicImproperForceCompute(pybind11::module& m);
 void export_BondTablePotential(pybind11::module& m);
 void export_CustomForceCompute(pybind11::module& m);
+void export_PluginForceCompute(pybind11::module& m);
 void export_NeighborList(pybind11::module& m);
+void export_NeighborListAuto(pybind11::module& m);
 void export_NeighborListBinned(pybind11::module& m);
+void export_NeighborListBufferTuner(pybind11::module& m);
 void export_NeighborListStencil(pybind11::module& m);
+void export_NeighborListMultiLevel(pybind11::module& m);
 void export_NeighborListTree(pybind11::module& m);
 void export_MolecularForceCompute(pybind11::module& m);
 void export_ForceDistanceConstraint(pybind11::module& m);
 void export_ForceComposite(pybind11::module& m);
 void export_PPPMForceCompute(pybind11::module& m);
+void export_RDFAnalyzer(pybind11::module& m);
+void export_StructureFactorAnalyzer(pybind11::module& m);
+void export_ParticleCorrelatorAnalyzer(pybind11::module& m);
+void export_StressAutocorrelationAnalyzer(pybind11::module& m);
 void export_wall_data(pybind11::module& m);
 void export_wall_field(pybind11::module& m);
 void export_LocalNeighborListDataHost(pybind11::module& m);
-
-void export_PotentialPairBuckingham(pybind11::module& m);
-void export_PotentialPairLJ(pybind11::module& m);
-void export_PotentialPairLJ1208(pybind11::module& m);
-void export_PotentialPairLJ0804(pybind11::module& m);
-void export_PotentialPairGauss(pybind11::module& m);
-void export_PotentialPairExpandedLJ(pybind11::module& m);
-void export_PotentialPairExpandedGaussian(pybind11::module& m);
-void export_PotentialPairExpandedMie(pybind11::module& m);
-void export_PotentialPairYukawa(pybind11::module& m);
-void export_PotentialPairEwald(pybind11::module& m);
-void export_PotentialPairMorse(pybind11::module& m);
-void export_PotentialPairMoliere(pybind11::module& m);
-void export_PotentialPairZBL(pybind11::module& m);
-void export_PotentialPairMie(pybind11::module& m);
-void export_PotentialPairReactionField(pybind11::module& m);
-void export_PotentialPairDLVO(pybind11::module& m);
-void export_PotentialPairFourier(pybind11::module& m);
-void export_PotentialPairOPP(pybind11::module& m);
-void export_PotentialPairTWF(pybind11::module& m);
-void export_PotentialPairLJGauss(pybind11::module& m);
-void export_PotentialPairForceShiftedLJ(pybind11::module& m);
-void export_PotentialPairTable(pybind11::module& m);
-
-void export_AnisoPotentialPairALJ2D(pybind11::module& m);
-void export_AnisoPotentialPairALJ3D(pybind11::module& m);
-void export_AnisoPotentialPairDipole(pybind11::module& m);
-void export_AnisoPotentialPairGB(pybind11::module& m);
-
-void export_PotentialBondHarmonic(pybind11::module& m);
-void export_PotentialBondFENE(pybind11::module& m);
-void export_PotentialBondTether(pybind11::module& m);
-
-void export_PotentialMeshBondHarmonic(pybind11::module& m);
-void export_PotentialMeshBondFENE(pybind11::module& m);
-void export_PotentialMeshBondTether(pybind11::module& m);
+void export_SelectedEvaluators(pybind11::module& m);
 
 void export_PotentialSpecialPairLJ(pybind11::module& m);
 void export_PotentialSpecialPairCoulomb(pybind11::module& m);
@@ -104,6 +77,7 @@ void export_PotentialPairDPDThermoLJ(pybind11::module& m);
 void export_IntegratorTwoStep(pybind11::module& m);
 void export_IntegrationMethodTwoStep(pybind11::module& m);
 void export_ZeroMomentumUpdater(pybind11::module& m);
+void export_ReplicaExchangeUpdater(pybind11::module& m);
 
 void export_Thermostat(pybind11::module& m);
 void export_MTTKThermostat(pybind11::module& m);
@@ -154,7 +128,6 @@ void export_ManifoldXYPlane(pybind11::module& m);
 void export_ManifoldZCylinder(pybind11::module& m);
 
 void export_AlchemicalMDParticles(pybind11::module& m);
-void export_PotentialPairAlchemicalLJGauss(pybind11::module& m);
 
 #ifdef ENABLE_HIP
 
@@ -185,45 +158,11 @@ void export_ForceDistanceConstraintGPU(pybind11::module& m);
 void export_ForceCompositeGPU(pybind11::module& m);
 void export_PeriodicImproperForceComputeGPU(pybind11::module& m);
 void export_PPPMForceComputeGPU(pybind11::module& m);
+void export_RDFAnalyzerGPU(pybind11::module& m);
+void export_StructureFactorAnalyzerGPU(pybind11::module& m);
+void export_ParticleCorrelatorAnalyzerGPU(pybind11::module& m);
 void export_LocalNeighborListDataGPU(pybind11::module& m);
 
-void export_PotentialPairBuckinghamGPU(pybind11::module& m);
-void export_PotentialPairLJGPU(pybind11::module& m);
-void export_PotentialPairLJ1208GPU(pybind11::module& m);
-void export_PotentialPairLJ0804GPU(pybind11::module& m);
-void export_PotentialPairGaussGPU(pybind11::module& m);
-void export_PotentialPairExpandedLJGPU(pybind11::module& m);
-void export_PotentialPairExpandedGaussianGPU(pybind11::module& m);
-void export_PotentialPairExpandedMieGPU(pybind11::module& m);
-void export_PotentialPairYukawaGPU(pybind11::module& m);
-void export_PotentialPairEwaldGPU(pybind11::module& m);
-void export_PotentialPairMorseGPU(pybind11::module& m);
-void export_PotentialPairMoliereGPU(pybind11::module& m);
-void export_PotentialPairZBLGPU(pybind11::module& m);
-void export_PotentialPairMieGPU(pybind11::module& m);
-void export_PotentialPairReactionFieldGPU(pybind11::module& m);
-void export_PotentialPairDLVOGPU(pybind11::module& m);
-void export_PotentialPairFourierGPU(pybind11::module& m);
-void export_PotentialPairOPPGPU(pybind11::module& m);
-void export_PotentialPairTWFGPU(pybind11::module& m);
-void export_PotentialPairLJGaussGPU(pybind11::module& m);
-void export_PotentialPairForceShiftedLJGPU(pybind11::module& m);
-void export_PotentialPairTableGPU(pybind11::module& m);
-void export_PotentialPairConservativeDPDGPU(pybind11::module& m);
-
-void export_AnisoPotentialPairALJ2DGPU(pybind11::module& m);
-void export_AnisoPotentialPairALJ3DGPU(pybind11::module& m);
-void export_AnisoPotentialPairDipoleGPU(pybind11::module& m);
-void export_AnisoPotentialPairGBGPU(pybind11::module& m);
-
-void export_PotentialBondHarmonicGPU(pybind11::module& m);
-void export_PotentialBondFENEGPU(pybind11::module& m);
-void export_PotentialBondTetherGPU(pybind11::module& m);
-
-void export_PotentialMeshBondHarmonicGPU(pybind11::module& m);
-void export_PotentialMeshBondFENEGPU(pybind11::module& m);
-void export_PotentialMeshBondTetherGPU(pybind11::module& m);
-
 void export_PotentialSpecialPairLJGPU(pybind11::module& m);
 void export_PotentialSpecialPairCoulombGPU(pybind11::module& m);
 
@@ -246,11 +185,13 @@ void export_PotentialPairDPDThermoDPDGPU(pybind11::module& m);
 void export_PotentialPairDPDThermoLJGPU(pybind11::module& m);
 
 void export_TwoStepConstantVolumeGPU(pybind11::module& m);
+void export_MTTKThermostatGPU(pybind11::module& m);
 void export_TwoStepLangevinGPU(pybind11::module& m);
 void export_TwoStepBDGPU(pybind11::module& m);
 void export_TwoStepConstantPressureGPU(pybind11::module& m);
 void export_FIREEnergyMinimizerGPU(pybind11::module& m);
 void export_MuellerPlatheFlowGPU(pybind11::module& m);
+void export_ZeroMomentumUpdaterGPU(pybind11::module& m);
 
 void export_TwoStepRATTLEBDGPUCylinder(pybind11::module& m);
 void export_TwoStepRATTLEBDGPUDiamond(pybind11::module& m);
@@ -312,64 +253,38 @@ PYBIND11_MODULE(_md, m)
     export_HarmonicImproperForceCompute(m);
     export_BondTablePotential(m);
 
-    export_PotentialPairBuckingham(m);
-    export_PotentialPairLJ(m);
-    export_PotentialPairLJ1208(m);
-    export_PotentialPairLJ0804(m);
-    export_PotentialPairGauss(m);
-    export_PotentialPairExpandedLJ(m);
-    export_PotentialPairExpandedGaussian(m);
-    export_PotentialPairExpandedMie(m);
-    export_PotentialPairYukawa(m);
-    export_PotentialPairEwald(m);
-    export_PotentialPairMorse(m);
-    export_PotentialPairMoliere(m);
-    export_PotentialPairZBL(m);
-    export_PotentialPairMie(m);
-    export_PotentialPairReactionField(m);
-    export_PotentialPairDLVO(m);
-    export_PotentialPairFourier(m);
-    export_PotentialPairOPP(m);
-    export_PotentialPairTWF(m);
-    export_PotentialPairLJGauss(m);
-    export_PotentialPairForceShiftedLJ(m);
-    export_PotentialPairTable(m);
-
     export_AlchemicalMDParticles(m);
-    export_PotentialPairAlchemicalLJGauss(m);
 
     export_PotentialTersoff(m);
     export_PotentialSquareDensity(m);
     export_PotentialRevCross(m);
 
-    export_AnisoPotentialPairALJ2D(m);
-    export_AnisoPotentialPairALJ3D(m);
-    export_AnisoPotentialPairDipole(m);
-    export_AnisoPotentialPairGB(m);
-
     export_PotentialPairDPDThermoDPD(m);
     export_PotentialPairDPDThermoLJ(m);
 
-    export_PotentialBondHarmonic(m);
-    export_PotentialBondFENE(m);
-    export_PotentialBondTether(m);
-
-    export_PotentialMeshBondHarmonic(m);
-    export_PotentialMeshBondFENE(m);
-    export_PotentialMeshBondTether(m);
+    // pair, anisotropic pair, and bond evaluators selected at configure time
+    export_SelectedEvaluators(m);
 
     export_PotentialSpecialPairLJ(m);
     export_PotentialSpecialPairCoulomb(m);
 
     export_CustomForceCompute(m);
+    export_PluginForceCompute(m);
     export_NeighborList(m);
+    export_NeighborListAuto(m);
     export_NeighborListBinned(m);
+    export_NeighborListBufferTuner(m);
     export_NeighborListStencil(m);
+    export_NeighborListMultiLevel(m);
     export_NeighborListTree(m);
     export_MolecularForceCompute(m);
     export_ForceDistanceConstraint(m);
     export_ForceComposite(m);
     export_PPPMForceCompute(m);
+    export_RDFAnalyzer(m);
+    export_StructureFactorAnalyzer(m);
+    export_ParticleCorrelatorAnalyzer(m);
+    export_StressAutocorrelationAnalyzer(m);
     export_LocalNeighborListDataHost(m);
 
     export_PotentialExternalPeriodic(m);
@@ -394,30 +309,6 @@ PYBIND11_MODULE(_md, m)
     export_ForceCompositeGPU(m);
     export_LocalNeighborListDataGPU(m);
 
-    export_PotentialPairBuckinghamGPU(m);
-    export_PotentialPairLJGPU(m);
-    export_PotentialPairLJ1208GPU(m);
-    export_PotentialPairLJ0804GPU(m);
-    export_PotentialPairGaussGPU(m);
-    export_PotentialPairExpandedLJGPU(m);
-    export_PotentialPairExpandedGaussianGPU(m);
-    export_PotentialPairExpandedMieGPU(m);
-    export_PotentialPairYukawaGPU(m);
-    export_PotentialPairEwaldGPU(m);
-    export_PotentialPairMorseGPU(m);
-    export_PotentialPairMoliereGPU(m);
-    export_PotentialPairZBLGPU(m);
-    export_PotentialPairMieGPU(m);
-    export_PotentialPairReactionFieldGPU(m);
-    export_PotentialPairDLVOGPU(m);
-    export_PotentialPairFourierGPU(m);
-    export_PotentialPairOPPGPU(m);
-    export_PotentialPairTWFGPU(m);
-    export_PotentialPairLJGaussGPU(m);
-    export_PotentialPairForceShiftedLJGPU(m);
-    export_PotentialPairTableGPU(m);
-    export_PotentialPairConservativeDPDGPU(m);
-
     export_PotentialTersoffGPU(m);
     export_PotentialSquareDensityGPU(m);
     export_PotentialRevCrossGPU(m);
@@ -425,19 +316,6 @@ PYBIND11_MODULE(_md, m)
     export_PotentialPairDPDThermoDPDGPU(m);
     export_PotentialPairDPDThermoLJGPU(m);
 
-    export_AnisoPotentialPairALJ2DGPU(m);
-    export_AnisoPotentialPairALJ3DGPU(m);
-    export_AnisoPotentialPairDipoleGPU(m);
-    export_AnisoPotentialPairGBGPU(m);
-
-    export_PotentialBondHarmonicGPU(m);
-    export_PotentialBondFENEGPU(m);
-    export_PotentialBondTetherGPU(m);
-
-    export_PotentialMeshBondHarmonicGPU(m);
-    export_PotentialMeshBondFENEGPU(m);
-    export_PotentialMeshBondTetherGPU(m);
-
     export_PotentialSpecialPairLJGPU(m);
     export_PotentialSpecialPairCoulombGPU(m);
     export_BondTablePotentialGPU(m);
@@ -453,6 +331,9 @@ PYBIND11_MODULE(_md, m)
     export_ComputeThermoHMAGPU(m);
     export_PeriodicImproperForceComputeGPU(m);
     export_PPPMForceComputeGPU(m);
+    export_RDFAnalyzerGPU(m);
+    export_StructureFactorAnalyzerGPU(m);
+    export_ParticleCorrelatorAnalyzerGPU(m);
     export_ActiveForceComputeGPU(m);
     export_ActiveForceConstraintComputeCylinderGPU(m);
     export_ActiveForceConstraintComputeDiamondGPU(m);
@@ -483,6 +364,7 @@ PYBIND11_MODULE(_md, m)
     export_IntegratorTwoStep(m);
     export_IntegrationMethodTwoStep(m);
     export_ZeroMomentumUpdater(m);
+    export_ReplicaExchangeUpdater(m);
     export_TwoStepConstantVolume(m);
     export_TwoStepLangevinBase(m);
     export_TwoStepLangevin(m);
@@ -521,11 +403,13 @@ PYBIND11_MODULE(_md, m)
 
 #ifdef ENABLE_HIP
     export_TwoStepConstantVolumeGPU(m);
+    export_MTTKThermostatGPU(m);
     export_TwoStepLangevinGPU(m);
     export_TwoStepBDGPU(m);
     export_TwoStepConstantPressureGPU(m);
     export_FIREEnergyMinimizerGPU(m);
     export_MuellerPlatheFlowGPU(m);
+    export_ZeroMomentumUpdaterGPU(m);
 
     export_TwoStepRATTLEBDGPUCylinder(m);
     export_TwoStepRATTLEBDGPUDiamond(m);
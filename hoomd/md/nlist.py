@@ -6,7 +6,8 @@ r"""Neighbor list acceleration structures.
 Pair forces (`hoomd.md.pair`) use neighbor list data structures to find
 neighboring particle pairs (those within a distance of :math:`r_\mathrm{cut}`)
 efficiently. HOOMD-blue provides a several types of neighbor list construction
-algorithms that you can select from: `Cell`, `Tree`, and `Stencil`.
+algorithms that you can select from: `Cell`, `Tree`, and `Stencil`. `Auto`
+selects the fastest of the three at runtime.
 
 Multiple pair force objects can share a single neighbor list, or use independent
 neighbor list objects. When neighbor lists are shared, they find neighbors
@@ -322,6 +323,67 @@ class NeighborList(Compute):
         """
         return self._cpp_obj.num_builds
 
+    @log(requires_run=True, default=False)
+    def build_time(self):
+        """float: Time spent building the neighbor list (in seconds).
+
+        `build_time` is the total time spent in neighbor list rebuilds
+        (including overflow reallocations and exclusion filtering) since the
+        last call to `Simulation.run`. Compare `build_time` between runs with
+        different values of `hoomd.device.Device.num_cpu_threads` to measure
+        how the neighbor list build scales with the number of threads.
+        """
+        return self._cpp_obj.build_time
+
+    @log(requires_run=True, default=False)
+    def mean_neighbors(self):
+        """float: Average number of neighbors per particle within the \
+        cutoff.
+
+        The quality metrics (`mean_neighbors`, `max_neighbors`,
+        `list_efficiency`, and `unused_storage_fraction`) are computed from the
+        current particle positions by iterating over the whole neighbor list.
+        They are computed once per time step, on demand, and do not slow down
+        the simulation when not logged.
+        """
+        return self._quality_metric('mean_neighbors')
+
+    @log(requires_run=True, default=False)
+    def max_neighbors(self):
+        """int: Largest number of neighbors of any particle within the \
+        cutoff."""
+        return self._quality_metric('max_neighbors')
+
+    @log(requires_run=True, default=False)
+    def list_efficiency(self):
+        """float: Fraction of the stored pairs that are within the cutoff.
+
+        The remaining pairs are within the buffer. A low efficiency suggests
+        that the `buffer` is too large.
+        """
+        return self._quality_metric('efficiency')
+
+    @log(requires_run=True, default=False)
+    def unused_storage_fraction(self):
+        """float: Fraction of the allocated neighbor list storage that holds \
+        no neighbors."""
+        return self._quality_metric('unused_storage')
+
+    @log(requires_run=True, default=False, category='sequence')
+    def rebuild_trigger_types(self):
+        """tuple[int]: Number of distance check triggered rebuilds by the \
+        type of the particle that moved too far.
+
+        Each rebuild caused by the distance check counts once, toward the type
+        of one particle that moved more than half the buffer width since the
+        last rebuild. The counts are reset at the start of every
+        `Simulation.run`.
+        """
+        return tuple(self._cpp_obj.rebuild_trigger_types)
+
+    def _quality_metric(self, key):
+        return self._cpp_obj.getQualityMetrics(self._simulation.timestep)[key]
+
 
 class Cell(NeighborList):
     r"""Neighbor list computed via a cell list.
@@ -339,6 +401,14 @@ class Cell(NeighborList):
             mesh to determine the bond exclusions in addition to all other
             set exclusions.
         default_r_cut
+        partial_update_fraction (float): Largest fraction of the particles
+            that may move more than ``buffer/2`` before a full rebuild.
+        compressed (bool): When `True`, store the neighbor list in the
+            compressed format.
+        image_shifts (bool): When `True`, store the periodic image of each
+            neighbor.
+        sort_neighbors (bool): When `True`, sort each neighbor list row by
+            particle index.
 
     `Cell` finds neighboring particles using a fixed width cell list, allowing
     for *O(kN)* construction of the neighbor list where *k* is the number of
@@ -363,6 +433,60 @@ class Cell(NeighborList):
         number of cells in the system. In these cases, consider using `Stencil`
         or `Tree`, which can use less memory.
 
+    .. rubric:: Partial updates
+
+    When a few particles move much faster than the rest, most rebuilds are
+    caused by a small fraction of the particles. Set `partial_update_fraction`
+    to a positive value to rebuild only the neighbors of the particles that
+    have moved more than ``buffer/2`` since the last full rebuild. The
+    remaining pairs stay valid until either particle in the pair moves more
+    than ``buffer/2``. `Cell` performs a full rebuild when the fraction of
+    moved particles exceeds `partial_update_fraction`. While any particle has
+    moved, `Cell` performs a partial update every time step regardless of
+    `rebuild_check_delay`.
+
+    Note:
+        Partial updates are only performed on the CPU in simulations with a
+        single MPI rank and a constant box.
+
+    .. rubric:: Compressed storage
+
+    Set `compressed` to `True` to store each neighbor list row as sorted,
+    difference encoded 16-bit values instead of 32-bit particle indices. After
+    the particles are sorted (see `hoomd.tune.ParticleSorter`), the compressed
+    list uses about half of the memory.
+
+    Note:
+        Compressed storage is only available on the CPU. Only `hoomd.md.pair`
+        potentials computed by `hoomd.md.pair.Pair` read compressed neighbor
+        lists, other forces raise an error when attached with a compressed
+        neighbor list. Partial updates are disabled in the compressed format.
+
+    .. rubric:: Image shifts
+
+    Set `image_shifts` to `True` to store the periodic image of each neighbor
+    in the neighbor list. `hoomd.md.pair.Pair` potentials then compute the
+    separation of each pair without the minimum image convention, which speeds
+    up dense systems with short cutoffs.
+
+    Note:
+        Image shifts are only used on the CPU in simulations with a single MPI
+        rank and the uncompressed format. Partial updates are disabled with
+        image shifts.
+
+    .. rubric:: Sorted neighbors
+
+    `Cell` writes the neighbors of each particle in the order that it visits
+    the neighboring cells. Set `sort_neighbors` to `True` to sort each row by
+    the particle index after every full rebuild. When the particles are sorted
+    (see `hoomd.tune.ParticleSorter`), sorted rows access the neighbor data in
+    memory order, which may speed up the pair and exclusion loops. The cost of
+    the sort is spread over the steps between rebuilds.
+
+    Note:
+        `sort_neighbors` only takes effect on the CPU. Partial updates do not
+        sort the rows that they modify. Compressed rows are always sorted.
+
     Examples::
 
         cell = nlist.Cell()
@@ -370,6 +494,19 @@ class Cell(NeighborList):
     Attributes:
         deterministic (bool): When `True`, sort neighbors to help provide
             deterministic simulation runs.
+
+        partial_update_fraction (float): Largest fraction of the particles
+            that may move more than ``buffer/2`` before a full rebuild. Set to
+            0 to disable partial updates.
+
+        compressed (bool): When `True`, store the neighbor list in the
+            compressed format.
+
+        image_shifts (bool): When `True`, store the periodic image of each
+            neighbor.
+
+        sort_neighbors (bool): When `True`, sort each neighbor list row by
+            particle index.
     """
 
     def __init__(self,
@@ -379,13 +516,22 @@ class Cell(NeighborList):
                  check_dist=True,
                  deterministic=False,
                  mesh=None,
-                 default_r_cut=0.0):
+                 default_r_cut=0.0,
+                 partial_update_fraction=0.0,
+                 compressed=False,
+                 image_shifts=False,
+                 sort_neighbors=False):
 
         super().__init__(buffer, exclusions, rebuild_check_delay, check_dist,
                          mesh, default_r_cut)
 
         self._param_dict.update(
-            ParameterDict(deterministic=bool(deterministic)))
+            ParameterDict(deterministic=bool(deterministic),
+                          partial_update_fraction=float(
+                              partial_update_fraction),
+                          compressed=bool(compressed),
+                          image_shifts=bool(image_shifts),
+                          sort_neighbors=bool(sort_neighbors)))
 
     def _attach_hook(self):
         if isinstance(self._simulation.device, hoomd.device.CPU):
@@ -417,6 +563,16 @@ class Cell(NeighborList):
         """
         return self._cpp_obj.getNmax()
 
+    @log(requires_run=True, default=False)
+    def num_partial_builds(self):
+        """int: The number of partial neighbor list builds.
+
+        `num_partial_builds` is the number of the `num_builds` that rebuilt
+        only the neighbors of the moved particles since the last call to
+        `Simulation.run`.
+        """
+        return self._cpp_obj.num_partial_builds
+
 
 class Stencil(NeighborList):
     """Cell list based neighbor list using stencils.
@@ -520,6 +676,8 @@ class Tree(NeighborList):
         mesh (Mesh): When a mesh object is passed, the neighbor list uses the
             mesh to determine the bond exclusions in addition to all other
             set exclusions.
+        image_shifts (bool): When `True`, store the periodic image of each
+            neighbor.
 
     `Tree` creates a neighbor list using a bounding volume hierarchy (BVH) tree
     traversal in :math:`O(N \\log N)` time. A BVH tree of axis-aligned bounding
@@ -549,9 +707,16 @@ class Tree(NeighborList):
         improved algorithm that is currently implemented. Cite both if you
         utilize this neighbor list style in your work.
 
+    `Tree` stores the periodic image of each neighbor when `image_shifts` is
+    `True`, see `Cell`.
+
     Examples::
 
         nl_t = nlist.Tree(check_dist=False)
+
+    Attributes:
+        image_shifts (bool): When `True`, store the periodic image of each
+            neighbor.
     """
 
     def __init__(self,
@@ -560,11 +725,15 @@ class Tree(NeighborList):
                  rebuild_check_delay=1,
                  check_dist=True,
                  mesh=None,
-                 default_r_cut=0.0):
+                 default_r_cut=0.0,
+                 image_shifts=False):
 
         super().__init__(buffer, exclusions, rebuild_check_delay, check_dist,
                          mesh, default_r_cut)
 
+        self._param_dict.update(
+            ParameterDict(image_shifts=bool(image_shifts)))
+
     def _attach_hook(self):
         if isinstance(self._simulation.device, hoomd.device.CPU):
             nlist_cls = _md.NeighborListTree
@@ -573,3 +742,176 @@ class Tree(NeighborList):
         self._cpp_obj = nlist_cls(self._simulation.state._cpp_sys_def,
                                   self.buffer)
         super()._attach_hook()
+
+
+class MultiLevel(NeighborList):
+    r"""Neighbor list computed via a hierarchy of cell lists.
+
+    Args:
+        buffer (float): Buffer width :math:`[\mathrm{length}]`.
+        exclusions (tuple[str]): Defines which particles to exclude from the
+            neighbor list, see more details in `NeighborList`.
+        rebuild_check_delay (int): How often to attempt to rebuild the neighbor
+            list.
+        check_dist (bool): Flag to enable / disable distance checking.
+        deterministic (bool): When `True`, sort neighbors to help provide
+            deterministic simulation runs.
+        mesh (Mesh): When a mesh object is passed, the neighbor list uses the
+            mesh to determine the bond exclusions in addition to all other
+            set exclusions.
+        default_r_cut (float): Default cutoff distance
+            :math:`[\mathrm{length}]`.
+
+    `MultiLevel` groups the particle types into levels by the size of their
+    cutoff radius with themselves, such that the largest size in each level is
+    at most twice the smallest. Each level bins only the particles of its types
+    in a cell list with cells as wide as the largest list radius between the
+    types of the level. A particle searches the cells of each level that
+    overlap its largest list radius with the types of that level. In mixtures
+    with large size ratios, such as colloids in a solvent, small particles
+    visit only the few large cells around them to find the large particles
+    and large particles find the small particles in many small cells, so that
+    neither compares distances to many particles beyond their cutoff.
+
+    `MultiLevel` builds in *O(kN)* time like `Cell`, at a lower cost than
+    `Tree`. With a single level (cutoff radii within a 2:1 ratio), use `Cell`
+    instead.
+
+    Note:
+        `MultiLevel` executes on the CPU even when using a GPU device.
+
+    Examples::
+
+        nl_m = nlist.MultiLevel(buffer=0.4)
+
+    Attributes:
+        deterministic (bool): When `True`, sort neighbors to help provide
+            deterministic simulation runs.
+    """
+
+    def __init__(self,
+                 buffer,
+                 exclusions=('bond',),
+                 rebuild_check_delay=1,
+                 check_dist=True,
+                 deterministic=False,
+                 mesh=None,
+                 default_r_cut=0.0):
+
+        super().__init__(buffer, exclusions, rebuild_check_delay, check_dist,
+                         mesh, default_r_cut)
+
+        self._param_dict.update(
+            ParameterDict(deterministic=bool(deterministic)))
+
+    def _attach_hook(self):
+        if isinstance(self._simulation.device, hoomd.device.GPU):
+            self._simulation.device._cpp_msg.warning(
+                "Falling back on CPU. No GPU implementation available.\n")
+
+        self._cpp_obj = _md.NeighborListMultiLevel(
+            self._simulation.state._cpp_sys_def, self.buffer)
+        super()._attach_hook()
+
+    @log(requires_run=True, default=False)
+    def num_levels(self):
+        """int: Number of levels in the hierarchy."""
+        return self._cpp_obj.num_levels
+
+    @log(requires_run=True, default=False, category='sequence')
+    def level_widths(self):
+        """tuple[float]: Nominal cell width of each level, from the smallest \
+        to the largest :math:`[\\mathrm{length}]`."""
+        return tuple(self._cpp_obj.level_widths)
+
+
+class Auto(NeighborList):
+    r"""Neighbor list that selects the fastest build algorithm at runtime.
+
+    Args:
+        buffer (float): Buffer width :math:`[\mathrm{length}]`.
+        exclusions (tuple[str]): Defines which particles to exclude from the
+            neighbor list, see more details in `NeighborList`.
+        rebuild_check_delay (int): How often to attempt to rebuild the neighbor
+            list.
+        check_dist (bool): Flag to enable / disable distance checking.
+        mesh (Mesh): When a mesh object is passed, the neighbor list uses the
+            mesh to determine the bond exclusions in addition to all other
+            set exclusions.
+        default_r_cut (float): Default cutoff distance
+            :math:`[\mathrm{length}]`.
+        selection_period (int): Number of time steps between periodic
+            selections. Set to 0 to select only after the cutoff radii, the
+            buffer, or the box change.
+        box_tolerance (float): Relative change of any nearest plane distance of
+            the box that triggers a selection.
+
+    `Auto` builds the neighbor list with one of `Cell`, `Stencil` (with the
+    default cell width), and `Tree`. It times repeated builds of each algorithm
+    on the current configuration and uses the fastest one until the next
+    selection. `Auto` selects an algorithm on the first build, after changes to
+    the cutoff radii or `buffer <NeighborList.buffer>`, when a nearest plane
+    distance of the box changes by more than `box_tolerance` since the last
+    selection, and every `selection_period` time steps.
+
+    Each selection delays until the next step on which the neighbor list is
+    rebuilt anyway and then performs 3 builds with each algorithm. `Auto`
+    allocates memory for all three algorithms.
+
+    Examples::
+
+        nl_a = nlist.Auto(buffer=0.4)
+
+    Attributes:
+        selection_period (int): Number of time steps between periodic
+            selections.
+        box_tolerance (float): Relative change of any nearest plane distance of
+            the box that triggers a selection.
+    """
+
+    _algorithms = ('Cell', 'Stencil', 'Tree')
+
+    def __init__(self,
+                 buffer,
+                 exclusions=('bond',),
+                 rebuild_check_delay=1,
+                 check_dist=True,
+                 mesh=None,
+                 default_r_cut=0.0,
+                 selection_period=100000,
+                 box_tolerance=0.1):
+
+        super().__init__(buffer, exclusions, rebuild_check_delay, check_dist,
+                         mesh, default_r_cut)
+
+        self._param_dict.update(
+            ParameterDict(selection_period=int(selection_period),
+                          box_tolerance=float(box_tolerance)))
+
+    def _attach_hook(self):
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            candidate_cls = (_md.NeighborListBinned, _md.NeighborListStencil,
+                             _md.NeighborListTree)
+        else:
+            candidate_cls = (_md.NeighborListGPUBinned,
+                             _md.NeighborListGPUStencil,
+                             _md.NeighborListGPUTree)
+        sys_def = self._simulation.state._cpp_sys_def
+        candidates = [cls(sys_def, self.buffer) for cls in candidate_cls]
+        self._cpp_obj = _md.NeighborListAuto(sys_def, self.buffer, candidates)
+        super()._attach_hook()
+
+    @log(requires_run=True, category='string')
+    def algorithm(self):
+        """str: Name of the selected algorithm: ``'Cell'``, ``'Stencil'``, \
+        or ``'Tree'``."""
+        return self._algorithms[self._cpp_obj.active]
+
+    @log(requires_run=True, default=False, category='sequence')
+    def algorithm_build_times(self):
+        """tuple[float]: Fastest build time of each algorithm at the last \
+        selection (in seconds).
+
+        The times are in the order ``('Cell', 'Stencil', 'Tree')``.
+        """
+        return tuple(self._cpp_obj.candidate_times)
@@ -141,6 +141,8 @@ from .pair import (
     ExpandedGaussian,
     Yukawa,
     Ewald,
+    EwaldTable,
+    LJDispersionEwald,
     Morse,
     DPD,
     DPDConservative,
@@ -158,6 +160,7 @@ from .pair import (
     Fourier,
     OPP,
     Table,
+    TableSpline,
     TWF,
     LJGauss,
 )
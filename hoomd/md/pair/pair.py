@@ -54,12 +54,55 @@ class Pair(force.Force):
         Neighbor list used to compute the pair force.
 
         Type: `hoomd.md.nlist.NeighborList`
+
+    .. py:attribute:: mixed_precision
+
+        When `True`, evaluate the pair force in single precision and
+        accumulate the forces, energies, and virials in double precision on
+        the CPU. This doubles the number of pairs that a vector instruction
+        evaluates at once. Has no effect on the GPU. Only `LJ`, `Gaussian`,
+        `Yukawa`, `Ewald`, `Table`, and `Morse` provide this attribute.
+        Defaults to `False`.
+
+        Type: `bool`
+
+    .. py:attribute:: use_cell_list
+
+        When `True`, find the interacting pairs in a cell list with a width of
+        the largest ``r_cut`` and evaluate them directly on the CPU instead of
+        building and reading the neighbor list. This is faster when the
+        neighbor list would be rebuilt every few steps. Not available on the
+        GPU, with MPI domain decomposition, or with exclusions,
+        and not provided by `DPD` and `DPDLJ`. Defaults to `False`.
+
+        Type: `bool`
+
+    .. py:attribute:: exclusion_correction
+
+        When `True`, also visit the pairs excluded by ``nlist`` in the pair
+        loop and apply the exclusion correction of the potential to them. Only
+        `Ewald`, `EwaldTable`, and `ReactionField` provide this attribute and
+        only on the CPU. Defaults to `False`.
+
+        Type: `bool`
     """
 
     # The accepted modes for the potential. Should be reset by subclasses with
     # restricted modes.
     _accepted_modes = ("none", "shift", "xplor")
 
+    # Whether the C++ class evaluates pairs in mixed precision. Set to True in
+    # subclasses that support it.
+    _supports_mixed_precision = False
+
+    # Whether the C++ class can find the pairs in a cell list. Set to False in
+    # subclasses that override the force computation.
+    _supports_cell_list = True
+
+    # Whether the evaluator implements a correction for excluded pairs. Set to
+    # True in subclasses that support it.
+    _supports_exclusion_correction = False
+
     # Module where the C++ class is defined. Reassign this when developing an
     # external plugin.
     _ext_module = _md
@@ -84,6 +127,12 @@ class Pair(force.Force):
         self._param_dict.update(
             ParameterDict(mode=OnlyFrom(self._accepted_modes),
                           nlist=hoomd.md.nlist.NeighborList))
+        if self._supports_mixed_precision:
+            self._param_dict.update(ParameterDict(mixed_precision=False))
+        if self._supports_cell_list:
+            self._param_dict.update(ParameterDict(use_cell_list=False))
+        if self._supports_exclusion_correction:
+            self._param_dict.update(ParameterDict(exclusion_correction=False))
         self.mode = mode
         self.nlist = nlist
 
@@ -123,6 +172,43 @@ class Pair(force.Force):
         # above and raise an error if they occur.
         return self._cpp_obj.computeEnergyBetweenSets(tags1, tags2)
 
+    def compute_energy_matrix(self, tags, sets):
+        r"""Compute the energy between each pair of particle sets.
+
+        Args:
+            tags ((*N*,) `numpy.ndarray` of ``uint32``): Particle tags.
+            sets ((*N*,) `numpy.ndarray` of ``uint32``): The set of each
+                particle in *tags*.
+
+        Returns:
+            ((*M*, *M*) `numpy.ndarray` of ``float``): The energy matrix, where
+            :math:`M` is the largest set index plus one.
+
+        .. math::
+
+            U_{ab} = \sum_{i \in a} \sum_{j \in b} V_{ij}(r)
+            \quad (a \ne b), \qquad
+            U_{aa} = \frac{1}{2} \sum_{i \in a} \sum_{j \in a, j \ne i}
+            V_{ij}(r)
+
+        One call evaluates the energies between all pairs of sets, e.g. the
+        interaction matrix of the molecules in the system. Each particle may
+        belong to only one set. Large selections find the pairs with a cell
+        list. `compute_energy_matrix` ignores the neighbor list exclusions.
+
+        Example::
+
+            # interaction matrix of the molecules of 10 particles each
+            tags = numpy.arange(N, dtype=numpy.uint32)
+            U = pair.compute_energy_matrix(tags=tags, sets=tags // 10)
+        """
+        tags = np.ascontiguousarray(tags, dtype=np.uint32)
+        sets = np.ascontiguousarray(sets, dtype=np.uint32)
+        if tags.shape != sets.shape or tags.ndim != 1:
+            raise ValueError("tags and sets must be 1D arrays of equal length.")
+        n_sets = int(sets.max()) + 1 if len(sets) > 0 else 0
+        return self._cpp_obj.computeEnergyMatrix(tags, sets, n_sets)
+
     def _attach_hook(self):
         if self.nlist._attached and self._simulation != self.nlist._simulation:
             warnings.warn(
@@ -211,6 +297,7 @@ class LJ(Pair):
         Type: `bool`
     """
     _cpp_class_name = "PotentialPairLJ"
+    _supports_mixed_precision = True
 
     def __init__(self,
                  nlist,
@@ -270,6 +357,7 @@ class Gaussian(Pair):
         Type: `str`
     """
     _cpp_class_name = "PotentialPairGauss"
+    _supports_mixed_precision = True
 
     def __init__(self, nlist, default_r_cut=None, default_r_on=0., mode='none'):
         super().__init__(nlist, default_r_cut, default_r_on, mode)
@@ -445,6 +533,7 @@ class Yukawa(Pair):
         Type: `str`
     """
     _cpp_class_name = "PotentialPairYukawa"
+    _supports_mixed_precision = True
 
     def __init__(self, nlist, default_r_cut=None, default_r_on=0., mode='none'):
         super().__init__(nlist, default_r_cut, default_r_on, mode)
@@ -501,8 +590,20 @@ class Ewald(Pair):
         Energy shifting/smoothing mode: ``"none"``.
 
         Type: `str`
+
+    .. py:attribute:: exclusion_correction
+
+        When `True`, subtract the long range part of the interaction of the
+        excluded pairs, :math:`q_i q_j e^{-\alpha r} / r - U(r)`, which the
+        reciprocal space term includes. `md.long_range.pppm.Coulomb` then skips
+        its own pass over the excluded pairs. Set before the simulation is
+        scheduled. Defaults to `False`.
+
+        Type: `bool`
     """
     _cpp_class_name = "PotentialPairEwald"
+    _supports_mixed_precision = True
+    _supports_exclusion_correction = True
     _accepted_modes = ("none",)
 
     def __init__(self, nlist, default_r_cut=None):
@@ -517,6 +618,175 @@ class Ewald(Pair):
         self._add_typeparam(params)
 
 
+class EwaldTable(Pair):
+    r"""Tabulated Ewald pair force.
+
+    Args:
+        nlist (hoomd.md.nlist.NeighborList): Neighbor list.
+        default_r_cut (float): Default cutoff radius :math:`[\mathrm{length}]`.
+
+    `EwaldTable` computes the same pair force as `Ewald` from a table, which
+    avoids the evaluation of the complementary error function and exponentials
+    for every pair. The table stores :math:`r U(r)` and
+    :math:`r^3 F(r) / r` for unit charges on ``width`` intervals in
+    :math:`r^2` between ``r_min`` and the distance where the complementary
+    error functions vanish, and `EwaldTable` interpolates them with cubic
+    Hermite polynomials. The relative error of the interpolation is of the
+    order of :math:`10^{-7}` with the default parameters. Pairs closer than
+    ``r_min`` are evaluated with the exact expression.
+
+    Call `md.long_range.pppm.make_pppm_coulomb_forces` with
+    ``tabulate=True`` to use `EwaldTable` for the real space part of the PPPM
+    method.
+
+    Tip:
+        On the GPU, the tables of all type pairs are loaded into shared memory
+        when they fit. Reduce ``width`` to fit larger numbers of types.
+
+    Example::
+
+        nl = nlist.Cell()
+        ewald = pair.EwaldTable(default_r_cut=3.0, nlist=nl)
+        ewald.params[('A', 'A')] = dict(kappa=1.0, alpha=1.5)
+        ewald.r_cut[('A', 'B')] = 3.0
+
+    .. py:attribute:: params
+
+        The Ewald potential parameters. The dictionary has the following keys:
+
+        * ``kappa`` (`float`, **required**) - Splitting parameter
+          :math:`\kappa` :math:`[\mathrm{length}^{-1}]`
+        * ``alpha`` (`float`, **optional**) - Debye screening length
+          :math:`\alpha` :math:`[\mathrm{length}^{-1}]`. Defaults to 0.
+        * ``r_min`` (`float`, **optional**) - Smallest tabulated distance
+          :math:`[\mathrm{length}]`. Defaults to 0.5.
+        * ``width`` (`int`, **optional**) - Number of table intervals.
+          Defaults to 1024.
+
+        Type: `TypeParameter` [`tuple` [``particle_type``, ``particle_type``],
+        `dict`]
+
+    .. py:attribute:: mode
+
+        Energy shifting/smoothing mode: ``"none"``.
+
+        Type: `str`
+
+    .. py:attribute:: exclusion_correction
+
+        When `True`, subtract the long range part of the interaction of the
+        excluded pairs. See `Ewald`. Defaults to `False`.
+
+        Type: `bool`
+    """
+    _cpp_class_name = "PotentialPairEwaldTable"
+    _supports_mixed_precision = True
+    _supports_exclusion_correction = True
+    _accepted_modes = ("none",)
+
+    def __init__(self, nlist, default_r_cut=None):
+        super().__init__(nlist=nlist,
+                         default_r_cut=default_r_cut,
+                         default_r_on=0,
+                         mode='none')
+        params = TypeParameter(
+            'params', 'particle_types',
+            TypeParameterDict(kappa=float,
+                              alpha=0.0,
+                              r_min=0.5,
+                              width=1024,
+                              len_keys=2))
+
+        self._add_typeparam(params)
+
+
+class LJDispersionEwald(Pair):
+    r"""Lennard-Jones pair force with the dispersion mesh term removed.
+
+    Args:
+        nlist (hoomd.md.nlist.NeighborList): Neighbor list.
+        default_r_cut (float): Default cutoff radius :math:`[\mathrm{length}]`.
+
+    `LJDispersionEwald` computes the real space part of the Lennard-Jones pair
+    force when `md.long_range.pppm.Dispersion` computes the long range part of
+    the dispersion interaction on a mesh:
+
+    .. math::
+
+        U(r) = 4 \varepsilon \left[ \left( \frac{\sigma}{r} \right)^{12}
+               - \left( \frac{\sigma}{r} \right)^{6} \right]
+               + C \frac{1 - g(\kappa r)}{r^6}
+
+    where :math:`g(x) = e^{-x^2} (1 + x^2 + x^4 / 2)`. When
+    :math:`C = 4 \varepsilon \sigma^6`, the sum of `LJDispersionEwald` and
+    `md.long_range.pppm.Dispersion` is the Lennard-Jones potential without
+    truncation.
+
+    Call `md.long_range.pppm.make_pppm_dispersion_forces` to create an instance
+    of `LJDispersionEwald` and `md.long_range.pppm.Dispersion` that together
+    implement the PPPM method for dispersion.
+
+    Example::
+
+        nl = nlist.Cell()
+        lj = pair.LJDispersionEwald(default_r_cut=3.0, nlist=nl)
+        lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+
+    .. py:attribute:: params
+
+        The potential parameters. The dictionary has the following keys:
+
+        * ``epsilon`` (`float`, **required**) - energy parameter
+          :math:`\varepsilon` :math:`[\mathrm{energy}]`
+        * ``sigma`` (`float`, **required**) - particle size
+          :math:`\sigma` :math:`[\mathrm{length}]`
+        * ``kappa`` (`float`, **optional**) - Splitting parameter
+          :math:`\kappa` :math:`[\mathrm{length}^{-1}]`. Defaults to 0.
+        * ``c6_mesh`` (`float`, **optional**) - Dispersion coefficient of the
+          mesh term :math:`C` :math:`[\mathrm{energy} \cdot
+          \mathrm{length}^6]`. Defaults to 0.
+
+        `md.long_range.pppm.Dispersion` sets ``kappa`` and ``c6_mesh``.
+
+        Type: `TypeParameter` [`tuple` [``particle_type``, ``particle_type``],
+        `dict`]
+
+    .. py:attribute:: mode
+
+        Energy shifting/smoothing mode: ``"none"``.
+
+        Type: `str`
+
+    .. py:attribute:: exclusion_correction
+
+        When `True`, subtract the long range part of the interaction of the
+        excluded pairs, :math:`-C [1 - g(\kappa r)] / r^6`, which the mesh
+        term includes. `md.long_range.pppm.Dispersion` then skips its own pass
+        over the excluded pairs. Set before the simulation is scheduled.
+        Defaults to `False`.
+
+        Type: `bool`
+    """
+    _cpp_class_name = "PotentialPairLJDispersionEwald"
+    _supports_exclusion_correction = True
+    _accepted_modes = ("none",)
+
+    def __init__(self, nlist, default_r_cut=None):
+        super().__init__(nlist=nlist,
+                         default_r_cut=default_r_cut,
+                         default_r_on=0,
+                         mode='none')
+        params = TypeParameter(
+            'params', 'particle_types',
+            TypeParameterDict(epsilon=float,
+                              sigma=float,
+                              kappa=0.0,
+                              c6_mesh=0.0,
+                              len_keys=2))
+
+        self._add_typeparam(params)
+
+
 class Table(Pair):
     """Tabulated pair force.
 
@@ -601,6 +871,7 @@ class Table(Pair):
         mode (str): Energy shifting/smoothing mode: ``"none"``.
     """
     _cpp_class_name = "PotentialPairTable"
+    _supports_mixed_precision = True
     _accepted_modes = ("none",)
 
     def __init__(self, nlist, default_r_cut=None):
@@ -618,6 +889,86 @@ class Table(Pair):
         self._add_typeparam(params)
 
 
+class TableSpline(Pair):
+    """Tabulated pair force on a non-uniform grid.
+
+    Args:
+        nlist (hoomd.md.nlist.NeighborList): Neighbor list
+        default_r_cut (float): Default cutoff radius :math:`[\\mathrm{length}]`.
+
+    `TableSpline` computes the tabulated pair force on every particle in the
+    simulation state. Unlike `Table`, the grid points (knots) :math:`r_k` may
+    be spaced arbitrarily. Place more knots where the potential varies quickly,
+    such as near the core, and fewer knots in the tail to reach the same
+    accuracy as `Table` with a smaller table.
+
+    The potential :math:`U(r)` is:
+
+    .. math::
+
+        U(r) =
+        \\begin{cases}
+        0 & r < r_0 \\\\
+        U_\\mathrm{spline}(r)
+        & r_0 \\le r < \\min(r_{N-1}, r_{\\mathrm{cut}}) \\\\
+        0 & r \\ge \\min(r_{N-1}, r_{\\mathrm{cut}}) \\\\
+        \\end{cases}
+
+    where :math:`U_\\mathrm{spline}(r)` is the cubic Hermite spline that
+    matches :math:`U` and :math:`\\frac{\\partial U}{\\partial r} = -F` at
+    every knot, and ``r_cut`` is defined in `Pair.r_cut`. The force
+    :math:`\\vec{F} = -\\nabla U_\\mathrm{spline}` is continuous and
+    consistent with the energy. The tabulated force must be specified
+    commensurate with the potential:
+    :math:`F = -\\frac{\\partial U}{\\partial r}`.
+
+    `TableSpline` does not support energy shifting or smoothing modes.
+
+    Example::
+
+        r = 0.85 + (2.5 - 0.85) * numpy.linspace(0, 1, 100)**2
+        U = 4 * (r**-12 - r**-6)
+        F = 4 * (12 * r**-13 - 6 * r**-7)
+        table = hoomd.md.pair.TableSpline(nlist=nl, default_r_cut=2.5)
+        table.params[('A', 'A')] = dict(r=r, U=U, F=F)
+
+    Attributes:
+        params (`TypeParameter` [\\
+          `tuple` [``particle_type``, ``particle_type``],\\
+          `dict`]):
+          The potential parameters. The dictionary has the following keys:
+
+          * ``r`` ((*N*,) `numpy.ndarray` of `float`, **required**) -
+            the knots in strictly increasing order, :math:`N \\ge 2`
+            :math:`[\\mathrm{length}]`.
+
+          * ``U`` ((*N*,) `numpy.ndarray` of `float`, **required**) -
+            the energy values at the knots :math:`[\\mathrm{energy}]`.
+
+          * ``F`` ((*N*,) `numpy.ndarray` of `float`, **required**) -
+            the force values at the knots :math:`[\\mathrm{force}]`.
+
+        mode (str): Energy shifting/smoothing mode: ``"none"``.
+    """
+    _cpp_class_name = "PotentialPairTableSpline"
+    _supports_mixed_precision = True
+    _accepted_modes = ("none",)
+
+    def __init__(self, nlist, default_r_cut=None):
+        super().__init__(nlist,
+                         default_r_cut=default_r_cut,
+                         default_r_on=0,
+                         mode='none')
+        params = TypeParameter(
+            'params', 'particle_types',
+            TypeParameterDict(
+                r=hoomd.data.typeconverter.NDArrayValidator(np.float64),
+                U=hoomd.data.typeconverter.NDArrayValidator(np.float64),
+                F=hoomd.data.typeconverter.NDArrayValidator(np.float64),
+                len_keys=2))
+        self._add_typeparam(params)
+
+
 class Morse(Pair):
     r"""Morse pair force.
 
@@ -664,6 +1015,7 @@ class Morse(Pair):
     """
 
     _cpp_class_name = "PotentialPairMorse"
+    _supports_mixed_precision = True
 
     def __init__(self, nlist, default_r_cut=None, default_r_on=0., mode='none'):
         super().__init__(nlist, default_r_cut, default_r_on, mode)
@@ -754,6 +1106,7 @@ class DPD(Pair):
     """
     _cpp_class_name = "PotentialPairDPDThermoDPD"
     _accepted_modes = ("none",)
+    _supports_cell_list = False
 
     def __init__(
         self,
@@ -909,6 +1262,7 @@ class DPDLJ(Pair):
     """
     _cpp_class_name = "PotentialPairDPDThermoLJ"
     _accepted_modes = ("none", "shift")
+    _supports_cell_list = False
 
     def __init__(self, nlist, kT, default_r_cut=None, mode='none'):
 
@@ -1357,8 +1711,19 @@ class ReactionField(Pair):
         Energy shifting/smoothing mode: ``"none"``, ``"shift"``, or ``"xplor"``.
 
         Type: `str`
+
+    .. py:attribute:: exclusion_correction
+
+        When `True`, excluded pairs within the cutoff interact with the
+        reaction field term :math:`q_i q_j \varepsilon \frac{(\epsilon_{RF}-1)
+        r^2}{(2 \epsilon_{RF} + 1) r_c^3}` (shifted with ``mode="shift"``),
+        as the dielectric continuum also responds to the excluded pairs.
+        Defaults to `False`.
+
+        Type: `bool`
     """
     _cpp_class_name = "PotentialPairReactionField"
+    _supports_exclusion_correction = True
 
     def __init__(self, nlist, default_r_cut=None, default_r_on=0., mode='none'):
         super().__init__(nlist, default_r_cut, default_r_on, mode)
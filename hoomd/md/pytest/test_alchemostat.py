@@ -4,6 +4,7 @@
 import hoomd
 from hoomd.conftest import pickling_check
 import hoomd.md.alchemy
+import numpy
 import pytest
 
 _NVT_args = (hoomd.md.alchemy.methods.NVT, {
@@ -117,3 +118,31 @@ def test_pickling_potential(simulation_factory, two_particle_snapshot_factory,
     sim.operations.integrator = integrator
     sim.run(0)
     pickling_check(ljg)
+
+
+@pytest.mark.serial
+def test_alchemical_derivatives(simulation_factory,
+                                two_particle_snapshot_factory):
+    """Test the derivatives computed on the alchemostat time steps."""
+    sim = simulation_factory(two_particle_snapshot_factory(dimensions=3, d=1))
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    ljg = hoomd.md.alchemy.pair.LJGauss(nlist, default_r_cut=3.0)
+    ljg.params[('A', 'A')] = dict(epsilon=1., sigma=0.5, r0=1.2)
+    integrator = hoomd.md.Integrator(dt=0.005)
+    integrator.forces.append(ljg)
+    sim.operations.integrator = integrator
+    sim.run(0)
+
+    epsilon_alchemical_dof = ljg.epsilon[('A', 'A')]
+    alchemostat = hoomd.md.alchemy.methods.NVT(
+        alchemical_kT=hoomd.variant.Constant(1),
+        alchemical_dof=[epsilon_alchemical_dof],
+        period=5)
+    sim.operations.integrator.methods.insert(0, alchemostat)
+    sim.run(0)
+
+    # each particle carries half of -dU/d alpha of the pair, averaged over N
+    expected = numpy.exp(-(1 - 1.2)**2 / (2 * 0.5**2)) / 2
+    numpy.testing.assert_allclose(epsilon_alchemical_dof.net_alchemical_force,
+                                  expected,
+                                  rtol=1e-5)
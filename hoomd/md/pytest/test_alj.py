@@ -106,3 +106,56 @@ def test_type_shapes(simulation_factory, two_particle_snapshot_factory):
     assert np.isclose(
         shape_spec["a"],
         get_rounding_radius(ellipse_axes[1], alj.params[("A", "A")]))
+
+
+@pytest.mark.gpu
+def test_kernel_variants(simulation_factory, lattice_snapshot_factory):
+    """Check that all tuned kernel variants compute the same forces."""
+    snapshot = lattice_snapshot_factory(n=4, a=1.6)
+    if snapshot.communicator.rank == 0:
+        rng = np.random.default_rng(2)
+        orientation = rng.normal(size=(snapshot.particles.N, 4))
+        orientation /= np.linalg.norm(orientation, axis=1)[:, np.newaxis]
+        snapshot.particles.orientation[:] = orientation
+    sim = simulation_factory(snapshot)
+
+    alj = md.pair.aniso.ALJ(md.nlist.Cell(buffer=0.4), default_r_cut=2.5)
+    alj.shape["A"] = {
+        "vertices": [(0.5, 0, 0), (-0.5, 0, 0), (0, 0.5, 0), (0, -0.5, 0),
+                     (0, 0, 0.5), (0, 0, -0.5)],
+        "faces": [[5, 3, 1], [0, 3, 5], [1, 3, 4], [4, 3, 0], [5, 2, 0],
+                  [1, 2, 5], [0, 2, 4], [4, 2, 1]],
+        "rounding_radii": 0.1
+    }
+    alj.params[("A", "A")] = {
+        "epsilon": 1.0,
+        "sigma_i": 1.0,
+        "sigma_j": 1.0,
+        "alpha": 1
+    }
+    # Without integration methods, the particles do not move and every step
+    # computes the same forces with the next kernel parameters in the scan.
+    sim.operations.integrator = md.Integrator(0.005, forces=[alj])
+
+    sim.run(0)
+    forces = alj.forces
+    torques = alj.torques
+    energy = alj.energy
+    while not alj.is_tuning_complete:
+        sim.run(1)
+        step_forces = alj.forces
+        step_torques = alj.torques
+        if sim.device.communicator.rank == 0:
+            np.testing.assert_allclose(step_forces,
+                                       forces,
+                                       rtol=1e-5,
+                                       atol=1e-6)
+            np.testing.assert_allclose(step_torques,
+                                       torques,
+                                       rtol=1e-5,
+                                       atol=1e-6)
+        assert alj.energy == pytest.approx(energy, rel=1e-5)
+
+        # Prevent infinite loops:
+        if sim.timestep > 100_000:
+            raise RuntimeError("Tuning is not completing as expected.")
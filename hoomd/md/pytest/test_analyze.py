@@ -0,0 +1,365 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+import itertools
+
+import numpy
+import numpy.testing as npt
+import pytest
+
+import hoomd
+from hoomd.conftest import logging_check
+from hoomd.error import DataAccessError
+from hoomd.logging import LoggerCategories
+
+
+def _pair_distances(snapshot, type_a=None, type_b=None):
+    """Distances of the ordered pairs (i, j) of the selected types."""
+    L = snapshot.configuration.box[:3]
+    position = snapshot.particles.position
+    typeid = snapshot.particles.typeid
+    types = snapshot.particles.types
+
+    in_a = numpy.ones(len(position), dtype=bool)
+    in_b = numpy.ones(len(position), dtype=bool)
+    if type_a is not None:
+        in_a = typeid == types.index(type_a)
+    if type_b is not None:
+        in_b = typeid == types.index(type_b)
+
+    dx = position[:, numpy.newaxis, :] - position[numpy.newaxis, :, :]
+    dx -= L * numpy.round(dx / L)
+    r = numpy.linalg.norm(dx, axis=2)
+    select = in_a[:, numpy.newaxis] & in_b[numpy.newaxis, :]
+    numpy.fill_diagonal(select, False)
+    return r[select], numpy.sum(in_a), numpy.sum(in_b), numpy.sum(in_a & in_b)
+
+
+@pytest.mark.parametrize("type_a, type_b", [(None, None), ('A', 'B'),
+                                            ('B', 'B'), (None, 'A')])
+def test_rdf(simulation_factory, lattice_snapshot_factory, type_a, type_b):
+    snapshot = lattice_snapshot_factory(particle_types=['A', 'B'],
+                                        n=6,
+                                        a=1.5,
+                                        r=0.2)
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.typeid[::3] = 1
+    sim = simulation_factory(snapshot)
+
+    r_max = 3.0
+    bins = 15
+    rdf = hoomd.md.analyze.RDF(trigger=hoomd.trigger.Periodic(1),
+                               nlist=hoomd.md.nlist.Cell(buffer=0.4),
+                               r_max=r_max,
+                               bins=bins,
+                               type_a=type_a,
+                               type_b=type_b)
+    sim.operations.writers.append(rdf)
+
+    with pytest.raises(DataAccessError):
+        rdf.rdf
+    npt.assert_allclose(rdf.r, (numpy.arange(bins) + 0.5) * r_max / bins)
+
+    sim.run(2)
+    assert rdf.num_frames == 2
+    counts = rdf.counts
+    g = rdf.rdf
+
+    if snapshot.communicator.rank == 0:
+        r, N_a, N_b, N_ab = _pair_distances(snapshot, type_a, type_b)
+        expected_counts, edges = numpy.histogram(r,
+                                                 bins=bins,
+                                                 range=(0, r_max))
+        npt.assert_array_equal(counts, 2 * expected_counts)
+
+        volume = numpy.prod(snapshot.configuration.box[:3])
+        shell = 4 / 3 * numpy.pi * (edges[1:]**3 - edges[:-1]**3)
+        density = (N_a * N_b - N_ab) / volume
+        npt.assert_allclose(g, expected_counts / (density * shell), rtol=1e-6)
+
+    rdf.reset()
+    assert rdf.num_frames == 0
+    if snapshot.communicator.rank == 0:
+        npt.assert_array_equal(rdf.counts, 0)
+
+
+def test_rdf_shared_nlist(simulation_factory, lattice_snapshot_factory):
+    snapshot = lattice_snapshot_factory(n=6, a=1.5, r=0.2)
+    sim = simulation_factory(snapshot)
+
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    lj = hoomd.md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.0, forces=[lj])
+
+    rdf = hoomd.md.analyze.RDF(trigger=hoomd.trigger.Periodic(1),
+                               nlist=nlist,
+                               r_max=3.0,
+                               bins=30)
+    sim.operations.writers.append(rdf)
+    sim.run(1)
+    counts = rdf.counts
+
+    if snapshot.communicator.rank == 0:
+        r, _, _, _ = _pair_distances(snapshot)
+        expected_counts, _ = numpy.histogram(r, bins=30, range=(0, 3.0))
+        npt.assert_array_equal(counts, expected_counts)
+
+    sim.operations.writers.remove(rdf)
+    sim.run(1)
+
+
+def test_structure_factor(simulation_factory, lattice_snapshot_factory):
+    snapshot = lattice_snapshot_factory(n=5, a=1.5, r=0.2)
+    sim = simulation_factory(snapshot)
+
+    q_max = 4.0
+    bins = 8
+    structure_factor = hoomd.md.analyze.StructureFactor(
+        trigger=hoomd.trigger.Periodic(1),
+        filter=hoomd.filter.All(),
+        q_max=q_max,
+        bins=bins)
+    sim.operations.writers.append(structure_factor)
+
+    with pytest.raises(DataAccessError):
+        structure_factor.structure_factor
+    npt.assert_allclose(structure_factor.q,
+                        (numpy.arange(bins) + 0.5) * q_max / bins)
+
+    sim.run(3)
+    assert structure_factor.num_frames == 3
+    S = structure_factor.structure_factor
+
+    if snapshot.communicator.rank == 0:
+        L = snapshot.configuration.box[0]
+        position = snapshot.particles.position
+        N = len(position)
+
+        n_max = int(q_max * L / (2 * numpy.pi))
+        S_sum = numpy.zeros(bins)
+        n_q = numpy.zeros(bins)
+        for n in itertools.product(range(-n_max, n_max + 1), repeat=3):
+            # select one of q and -q
+            if n <= (0, 0, 0):
+                continue
+            q = 2 * numpy.pi * numpy.array(n) / L
+            q_norm = numpy.linalg.norm(q)
+            if q_norm > q_max:
+                continue
+            rho = numpy.sum(numpy.exp(-1j * position @ q))
+            bin = min(int(q_norm * bins / q_max), bins - 1)
+            S_sum[bin] += numpy.abs(rho)**2 / N
+            n_q[bin] += 1
+
+        assert structure_factor.num_wave_vectors == numpy.sum(n_q)
+        expected = numpy.divide(S_sum,
+                                n_q,
+                                out=numpy.zeros(bins),
+                                where=n_q > 0)
+        npt.assert_allclose(S, expected, rtol=1e-4, atol=1e-6)
+
+
+def test_structure_factor_lattice(simulation_factory,
+                                  lattice_snapshot_factory):
+    # a perfect lattice has Bragg peaks at q = 2 pi / a and no scattering at
+    # other wave vectors
+    a = 1.5
+    snapshot = lattice_snapshot_factory(n=4, a=a)
+    sim = simulation_factory(snapshot)
+
+    q_max = 2 * numpy.pi / a * 1.01
+    structure_factor = hoomd.md.analyze.StructureFactor(
+        trigger=hoomd.trigger.Periodic(1),
+        filter=hoomd.filter.All(),
+        q_max=q_max,
+        bins=21)
+    sim.operations.writers.append(structure_factor)
+    sim.run(1)
+    S = structure_factor.structure_factor
+
+    if snapshot.communicator.rank == 0:
+        npt.assert_allclose(S[-1], 64, atol=1e-3)
+        npt.assert_allclose(S[:-1], 0, atol=1e-3)
+
+
+
+def _expected_lags(n_samples, points, averaging, max_levels):
+    """Lags in samples with at least one sample in a multi-tau correlator."""
+    lags = []
+    for level in range(max_levels):
+        n_filled = min(n_samples // averaging**level, points)
+        first = 0 if level == 0 else points // averaging
+        lags.extend(j * averaging**level for j in range(first, n_filled))
+    return numpy.array(lags)
+
+
+def _free_flight_simulation(simulation_factory, lattice_snapshot_factory,
+                            dt):
+    """Simulation of non-interacting particles with random velocities."""
+    snapshot = lattice_snapshot_factory(n=4, a=1.5)
+    if snapshot.communicator.rank == 0:
+        rng = numpy.random.default_rng(5)
+        snapshot.particles.velocity[:] = rng.uniform(-1, 1, size=(64, 3))
+    sim = simulation_factory(snapshot)
+    sim.operations.integrator = hoomd.md.Integrator(
+        dt=dt,
+        methods=[hoomd.md.methods.ConstantVolume(filter=hoomd.filter.All())])
+    return sim, snapshot
+
+
+@pytest.mark.serial
+def test_msd_vacf(simulation_factory, lattice_snapshot_factory):
+    dt = 0.01
+    sim, snapshot = _free_flight_simulation(simulation_factory,
+                                            lattice_snapshot_factory, dt)
+    period = 2
+    points = 4
+    averaging = 2
+    max_levels = 5
+    msd = hoomd.md.analyze.MSD(trigger=hoomd.trigger.Periodic(period),
+                               filter=hoomd.filter.All(),
+                               points=points,
+                               averaging=averaging,
+                               max_levels=max_levels)
+    vacf = hoomd.md.analyze.VelocityAutocorrelation(
+        trigger=hoomd.trigger.Periodic(period),
+        filter=hoomd.filter.All(),
+        points=points,
+        averaging=averaging,
+        max_levels=max_levels)
+    sim.operations.writers.extend([msd, vacf])
+
+    with pytest.raises(DataAccessError):
+        msd.msd
+
+    # the particles cross the box, so MSD must unwrap the positions
+    n_samples = 150
+    sim.run(n_samples * period)
+    assert msd.num_samples == n_samples
+    assert vacf.num_samples == n_samples
+
+    lags = _expected_lags(n_samples, points, averaging, max_levels)
+    npt.assert_array_equal(msd.lag, lags * period)
+    npt.assert_array_equal(vacf.lag, lags * period)
+
+    v_sq = numpy.mean(numpy.sum(snapshot.particles.velocity**2, axis=1))
+    npt.assert_allclose(msd.msd, v_sq * (lags * period * dt)**2, rtol=1e-5)
+    npt.assert_allclose(vacf.autocorrelation, v_sq, rtol=1e-5)
+
+    msd.reset()
+    assert msd.num_samples == 0
+    sim.run(period)
+    npt.assert_array_equal(msd.lag, [0])
+    npt.assert_allclose(msd.msd, [0])
+
+
+@pytest.mark.serial
+def test_msd_filter(simulation_factory, lattice_snapshot_factory):
+    dt = 0.01
+    sim, snapshot = _free_flight_simulation(simulation_factory,
+                                            lattice_snapshot_factory, dt)
+    msd = hoomd.md.analyze.MSD(trigger=hoomd.trigger.Periodic(1),
+                               filter=hoomd.filter.Tags([0, 5, 7]))
+    sim.operations.writers.append(msd)
+    sim.run(40)
+
+    v = snapshot.particles.velocity[[0, 5, 7]]
+    v_sq = numpy.mean(numpy.sum(v**2, axis=1))
+    npt.assert_allclose(msd.msd, v_sq * (msd.lag * dt)**2, rtol=1e-5)
+
+
+def test_stress_autocorrelation(simulation_factory, lattice_snapshot_factory):
+    sim, snapshot = _free_flight_simulation(simulation_factory,
+                                            lattice_snapshot_factory, 0.01)
+    stress_acf = hoomd.md.analyze.StressAutocorrelation(
+        trigger=hoomd.trigger.Periodic(1), points=8, averaging=2)
+    sim.operations.writers.append(stress_acf)
+    sim.run(50)
+    assert stress_acf.num_samples == 50
+    npt.assert_array_equal(stress_acf.lag,
+                           _expected_lags(50, 8, 2, 20))
+
+    # free particles have a constant, kinetic pressure tensor
+    if snapshot.communicator.rank == 0:
+        v = snapshot.particles.velocity
+        volume = numpy.prod(snapshot.configuration.box[:3])
+        P = [
+            numpy.sum(v[:, a] * v[:, b]) / volume
+            for a, b in ((0, 1), (0, 2), (1, 2))
+        ]
+        npt.assert_allclose(stress_acf.autocorrelation,
+                            numpy.mean(numpy.square(P)),
+                            rtol=1e-5)
+
+
+def test_correlator_trigger(simulation_factory, lattice_snapshot_factory):
+    sim, _ = _free_flight_simulation(simulation_factory,
+                                     lattice_snapshot_factory, 0.01)
+    stress_acf = hoomd.md.analyze.StressAutocorrelation(
+        trigger=hoomd.trigger.After(10))
+    sim.operations.writers.append(stress_acf)
+    with pytest.raises(ValueError):
+        sim.run(1)
+
+
+def test_logging():
+    logging_check(
+        hoomd.md.analyze.RDF, ('md', 'analyze'), {
+            'rdf': {
+                'category': LoggerCategories.sequence,
+                'default': True
+            },
+            'counts': {
+                'category': LoggerCategories.sequence,
+                'default': True
+            },
+            'r': {
+                'category': LoggerCategories.sequence,
+                'default': True
+            },
+        })
+    logging_check(
+        hoomd.md.analyze.StructureFactor, ('md', 'analyze'), {
+            'structure_factor': {
+                'category': LoggerCategories.sequence,
+                'default': True
+            },
+            'q': {
+                'category': LoggerCategories.sequence,
+                'default': True
+            },
+        })
+    logging_check(
+        hoomd.md.analyze.MSD, ('md', 'analyze'), {
+            'msd': {
+                'category': LoggerCategories.sequence,
+                'default': True
+            },
+            'lag': {
+                'category': LoggerCategories.sequence,
+                'default': True
+            },
+        })
+    logging_check(
+        hoomd.md.analyze.VelocityAutocorrelation, ('md', 'analyze'), {
+            'autocorrelation': {
+                'category': LoggerCategories.sequence,
+                'default': True
+            },
+            'lag': {
+                'category': LoggerCategories.sequence,
+                'default': True
+            },
+        })
+    logging_check(
+        hoomd.md.analyze.StressAutocorrelation, ('md', 'analyze'), {
+            'autocorrelation': {
+                'category': LoggerCategories.sequence,
+                'default': True
+            },
+            'lag': {
+                'category': LoggerCategories.sequence,
+                'default': True
+            },
+        })
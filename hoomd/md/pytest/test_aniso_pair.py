@@ -418,6 +418,47 @@ def test_run(simulation_factory, lattice_snapshot_factory, pair_potential):
                                      activate=lambda: sim.run(1))
 
 
+@pytest.mark.cpu
+@pytest.mark.skipif(not hoomd.version.tbb_enabled,
+                    reason="TBB threads not available.")
+def test_threaded_forces(device, simulation_factory, lattice_snapshot_factory,
+                         pair_potential):
+    """Test that threaded CPU forces and torques match serial ones."""
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'],
+                                    n=7,
+                                    a=2.0,
+                                    r=0.01)
+    if snap.communicator.rank == 0:
+        rng = np.random.default_rng(7)
+        snap.particles.typeid[:] = rng.integers(0, 2, snap.particles.N)
+        orientation = rng.normal(size=(snap.particles.N, 4))
+        orientation /= np.linalg.norm(orientation, axis=1)[:, np.newaxis]
+        snap.particles.orientation[:] = orientation
+    sim = simulation_factory(snap)
+    integrator = md.Integrator(dt=0.005, integrate_rotational_dof=True)
+    integrator.forces.append(pair_potential)
+    sim.operations.integrator = integrator
+    sim.always_compute_pressure = True
+
+    device.num_cpu_threads = 1
+    sim.run(0)
+    serial = (pair_potential.forces, pair_potential.torques,
+              pair_potential.energies, pair_potential.virials)
+
+    device.num_cpu_threads = 4
+    sim.operations._unschedule()
+    sim.run(0)
+    threaded = (pair_potential.forces, pair_potential.torques,
+                pair_potential.energies, pair_potential.virials)
+
+    if sim.device.communicator.rank == 0:
+        for threaded_values, serial_values in zip(threaded, serial):
+            np.testing.assert_allclose(threaded_values,
+                                       serial_values,
+                                       rtol=1e-5,
+                                       atol=1e-6)
+
+
 @pytest.mark.parametrize("aniso_forces_and_energies",
                          _aniso_forces_and_energies(),
                          ids=lambda x: x.pair_potential.__name__)
@@ -186,6 +186,46 @@ def test_burst_max_size(sim, tmp_path):
     check_write(sim, filename, 1)
 
 
+def test_burst_ring_buffer(sim, tmp_path):
+    filename = Path(tmp_path / "temporary_test_file.gsd")
+    burst_writer = hoomd.write.Burst(filename=str(filename),
+                                     trigger=hoomd.trigger.Periodic(1),
+                                     mode='wb',
+                                     dynamic=['property', 'momentum'],
+                                     max_burst_size=N_RUN_STEPS,
+                                     write_at_start=True,
+                                     max_burst_bytes=2**24)
+    sim.operations.writers.append(burst_writer)
+    assert burst_writer.max_burst_bytes == 2**24
+    sim.run(N_RUN_STEPS + 1)
+    check_write(sim, filename, 1)
+
+
+def test_burst_max_bytes(sim, tmp_path):
+    filename = tmp_path / "temporary_test_file.gsd"
+    burst_writer = hoomd.write.Burst(filename=filename,
+                                     trigger=hoomd.trigger.Periodic(1),
+                                     mode='wb',
+                                     dynamic=['property', 'momentum'],
+                                     write_at_start=True,
+                                     max_burst_bytes=300_000)
+    sim.operations.writers.append(burst_writer)
+    sim.run(10)
+
+    # The buffer holds the newest frames that fit.
+    n_frames = len(burst_writer)
+    assert 1 <= n_frames < 10
+    burst_writer.dump()
+    burst_writer.flush()
+    assert len(burst_writer) == 0
+    if sim.device.communicator.rank == 0:
+        with gsd.hoomd.open(name=filename, mode='r') as traj:
+            steps = [frame.configuration.step for frame in traj[1:]]
+        assert len(steps) == n_frames
+        assert steps == list(range(steps[-1] - n_frames + 1, steps[-1] + 1))
+        assert steps[-1] == sim.timestep - 1
+
+
 def test_burst_mode_xb(sim, tmp_path):
     filename = tmp_path / "temporary_test_file.gsd"
     if sim.device.communicator.rank == 0:
@@ -77,6 +77,7 @@ def test_attach_detach(simulation_factory, polymer_snapshot_factory):
     assert d.tolerance == 1e-5
     d.tolerance = 1e-3
     assert d.tolerance == 1e-3
+    assert d.solver == 'direct'
 
     # attached
     sim = simulation_factory(polymer_snapshot_factory())
@@ -90,6 +91,9 @@ def test_attach_detach(simulation_factory, polymer_snapshot_factory):
     assert d.tolerance == 1e-3
     d.tolerance = 1e-5
     assert d.tolerance == 1e-5
+    d.solver = 'iterative'
+    assert d.solver == 'iterative'
+    sim.run(1)
 
 
 def test_pickling(simulation_factory, polymer_snapshot_factory):
@@ -109,9 +113,11 @@ def test_pickling(simulation_factory, polymer_snapshot_factory):
     pickling_check(d)
 
 
-def test_basic_simulation(simulation_factory, polymer_snapshot_factory):
+@pytest.mark.parametrize('solver', ['direct', 'iterative'])
+def test_basic_simulation(simulation_factory, polymer_snapshot_factory,
+                          solver):
     """Ensure that distances are constrained in a basic simulation."""
-    d = hoomd.md.constrain.Distance()
+    d = hoomd.md.constrain.Distance(solver=solver)
 
     sim = simulation_factory(polymer_snapshot_factory())
     integrator = hoomd.md.Integrator(dt=0.005)
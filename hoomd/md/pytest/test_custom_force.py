@@ -115,6 +115,34 @@ def test_simulation(local_force_names, force_simulation_factory,
                 npt.assert_allclose(virials[:, i], i)
 
 
+class ForceAsFunctionOfTimestep(md.force.Custom):
+
+    def __init__(self):
+        super().__init__()
+
+    def set_forces(self, timestep):
+        with self.cpu_local_force_arrays as arrays:
+            arrays.force[:] = 0
+            arrays.potential_energy[:] = timestep
+
+
+def test_energy_sum(force_simulation_factory, lattice_snapshot_factory):
+    """Check that the total energy follows the per-particle energies."""
+    snap = lattice_snapshot_factory()
+    custom_force = ForceAsFunctionOfTimestep()
+    sim = force_simulation_factory(custom_force, snap)
+
+    for _ in range(3):
+        sim.run(1)
+        energy = custom_force.energy
+        # repeated reads on the same step return the same sum
+        assert custom_force.energy == energy
+        energies = custom_force.energies
+        if sim.device.communicator.rank == 0:
+            npt.assert_allclose(energies, sim.timestep)
+            npt.assert_allclose(energy, np.sum(energies))
+
+
 class ForceAsFunctionOfTag(md.force.Custom):
 
     def __init__(self):
@@ -477,3 +505,9 @@ def test_force_zeroing(force_simulation_factory, two_particle_snapshot_factory):
             assert np.allclose(forces, timestep)
             assert np.allclose(torques, timestep)
             assert np.allclose(virials, timestep)
+
+
+def test_plugin_requires_force_plugin():
+    """Test that Plugin rejects objects that are not C++ plugins."""
+    with pytest.raises(TypeError):
+        hoomd.md.force.Plugin(plugin=lambda timestep: None)
@@ -197,6 +197,68 @@ def test_kernel_parameters(dihedral_snapshot_factory, simulation_factory,
                                      activate=lambda: sim.run(1))
 
 
+@pytest.mark.cpu
+@pytest.mark.skipif(not hoomd.version.tbb_enabled,
+                    reason="TBB threads not available.")
+@pytest.mark.parametrize('dihedral_cls, dihedral_args, params, force, energy',
+                         dihedral_test_parameters)
+def test_threaded_forces(device, simulation_factory, dihedral_cls,
+                         dihedral_args, params, force, energy):
+    """Test that threaded CPU dihedral forces match serial forces."""
+    # place a chain of particles on a helix so that neighboring dihedrals
+    # share particles and have different angles
+    snapshot = hoomd.Snapshot(device.communicator)
+    N = 64
+    if snapshot.communicator.rank == 0:
+        snapshot.configuration.box = [30, 30, 30, 0, 0, 0]
+        snapshot.particles.N = N
+        snapshot.particles.types = ['A']
+        t = numpy.arange(N) * 1.3
+        snapshot.particles.position[:] = numpy.stack(
+            [numpy.cos(t), numpy.sin(t), 0.3 * numpy.arange(N) - 9.5], axis=1)
+
+        snapshot.dihedrals.N = N - 3
+        snapshot.dihedrals.types = ['A-A-A-A']
+        snapshot.dihedrals.typeid[:] = 0
+        snapshot.dihedrals.group[:] = [
+            (i, i + 1, i + 2, i + 3) for i in range(N - 3)
+        ]
+
+    sim = simulation_factory(snapshot)
+    potential = dihedral_cls(**dihedral_args)
+    potential.params['A-A-A-A'] = params
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005,
+                                                    forces=[potential])
+    sim.always_compute_pressure = True
+
+    device.num_cpu_threads = 1
+    sim.run(0)
+    serial_forces = potential.forces
+    serial_energies = potential.energies
+    serial_virials = potential.virials
+
+    device.num_cpu_threads = 4
+    sim.operations._unschedule()
+    sim.run(0)
+    threaded_forces = potential.forces
+    threaded_energies = potential.energies
+    threaded_virials = potential.virials
+
+    if sim.device.communicator.rank == 0:
+        numpy.testing.assert_allclose(threaded_forces,
+                                      serial_forces,
+                                      rtol=1e-5,
+                                      atol=1e-6)
+        numpy.testing.assert_allclose(threaded_energies,
+                                      serial_energies,
+                                      rtol=1e-5,
+                                      atol=1e-6)
+        numpy.testing.assert_allclose(threaded_virials,
+                                      serial_virials,
+                                      rtol=1e-5,
+                                      atol=1e-6)
+
+
 # Test Logging
 @pytest.mark.parametrize(
     'cls, expected_namespace, expected_loggables',
@@ -223,3 +285,72 @@ def test_pickling(simulation_factory, dihedral_snapshot_factory, dihedral_cls,
     sim.operations.integrator = integrator
     sim.run(0)
     pickling_check(potential)
+
+
+@pytest.mark.cpu
+def test_opls_special_pair(dihedral_snapshot_factory, simulation_factory):
+    """Test that OPLS 1-4 pairs match special_pair.LJ plus Coulomb."""
+    snapshot = dihedral_snapshot_factory(phi_deg=45)
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.charge[:] = [0.5, -0.25, 0.75, -1.0]
+        snapshot.pairs.N = 1
+        snapshot.pairs.types = ['A-A']
+        snapshot.pairs.typeid[0] = 0
+        snapshot.pairs.group[0] = (0, 3)
+    sim = simulation_factory(snapshot)
+
+    dihedral_params = dict(k1=1.0, k2=1.5, k3=0.5, k4=0.75)
+    opls = md.dihedral.OPLS()
+    opls.params['A-A-A-A'] = dihedral_params
+    opls.special_pair['A-A-A-A'] = dict(epsilon=0.5,
+                                         sigma=0.9,
+                                         alpha=0.5,
+                                         r_cut=3.0)
+
+    reference = md.dihedral.OPLS()
+    reference.params['A-A-A-A'] = dihedral_params
+    lj = md.special_pair.LJ()
+    lj.params['A-A'] = dict(epsilon=0.5, sigma=0.9)
+    lj.r_cut['A-A'] = 3.0
+    coulomb = md.special_pair.Coulomb()
+    coulomb.params['A-A'] = dict(alpha=0.5)
+    coulomb.r_cut['A-A'] = 3.0
+
+    sim.operations.integrator = hoomd.md.Integrator(
+        dt=0.005, forces=[opls, reference, lj, coulomb])
+    sim.always_compute_pressure = True
+    sim.run(0)
+
+    assert opls.special_pair['A-A-A-A']['sigma'] == pytest.approx(0.9)
+
+    forces = reference.forces + lj.forces + coulomb.forces
+    energies = reference.energies + lj.energies + coulomb.energies
+    virials = reference.virials + lj.virials + coulomb.virials
+    opls_forces = opls.forces
+    opls_energies = opls.energies
+    opls_virials = opls.virials
+
+    if sim.device.communicator.rank == 0:
+        numpy.testing.assert_allclose(opls_forces,
+                                      forces,
+                                      rtol=1e-5,
+                                      atol=1e-6)
+        numpy.testing.assert_allclose(opls_energies,
+                                      energies,
+                                      rtol=1e-5,
+                                      atol=1e-6)
+        numpy.testing.assert_allclose(opls_virials,
+                                      virials,
+                                      rtol=1e-5,
+                                      atol=1e-6)
+
+    # pairs beyond r_cut do not interact
+    opls.special_pair['A-A-A-A'] = dict(epsilon=0.5, sigma=0.9, r_cut=0.5)
+    sim.run(0)
+    opls_energies = opls.energies
+    reference_energies = reference.energies
+    if sim.device.communicator.rank == 0:
+        numpy.testing.assert_allclose(opls_energies,
+                                      reference_energies,
+                                      rtol=1e-5,
+                                      atol=1e-6)
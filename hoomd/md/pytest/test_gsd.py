@@ -213,6 +213,122 @@ def test_write_gsd_filter(create_md_sim, tmp_path):
                 assert frame.particles.N == 0
 
 
+def test_write_gsd_async(create_md_sim, tmp_path):
+
+    filename = tmp_path / "temporary_test_file.gsd"
+
+    sim = create_md_sim
+    gsd_writer = hoomd.write.GSD(filename=filename,
+                                 trigger=hoomd.trigger.Periodic(1),
+                                 mode='wb',
+                                 dynamic=['property', 'momentum'])
+    gsd_writer.maximum_frames_in_flight = 2
+    sim.operations.writers.append(gsd_writer)
+    assert gsd_writer.maximum_frames_in_flight == 2
+
+    snap_list = []
+    for _ in range(5):
+        sim.run(1)
+        snap = sim.state.get_snapshot()
+        if snap.communicator.rank == 0:
+            snap_list.append(snap)
+
+    gsd_writer.flush()
+
+    if sim.device.communicator.rank == 0:
+        with gsd.hoomd.open(name=filename, mode='r') as traj:
+            assert len(traj) == 5
+            for gsd_snap, hoomd_snap in zip(traj, snap_list):
+                assert_equivalent_snapshots(gsd_snap, hoomd_snap)
+
+    # switch back to synchronous writes after the pending frames
+    gsd_writer.maximum_frames_in_flight = 0
+    sim.run(1)
+    gsd_writer.flush()
+
+    if sim.device.communicator.rank == 0:
+        with gsd.hoomd.open(name=filename, mode='r') as traj:
+            assert len(traj) == 6
+            assert traj[5].configuration.step == sim.timestep
+
+
+def test_write_gsd_collective(create_md_sim, tmp_path):
+
+    filename = tmp_path / "temporary_test_file.gsd"
+
+    sim = create_md_sim
+    gsd_writer = hoomd.write.GSD(filename=filename,
+                                 trigger=hoomd.trigger.Periodic(1),
+                                 mode='wb',
+                                 dynamic=['property', 'momentum', 'attribute'])
+    gsd_writer.collective_write = True
+    sim.operations.writers.append(gsd_writer)
+    assert gsd_writer.collective_write
+
+    snap_list = []
+    for _ in range(5):
+        sim.run(1)
+        snap = sim.state.get_snapshot()
+        if snap.communicator.rank == 0:
+            snap_list.append(snap)
+
+    gsd_writer.flush()
+
+    if sim.device.communicator.rank == 0:
+        with gsd.hoomd.open(name=filename, mode='r') as traj:
+            assert len(traj) == 5
+            for gsd_snap, hoomd_snap in zip(traj, snap_list):
+                assert_equivalent_snapshots(gsd_snap, hoomd_snap)
+
+
+@pytest.mark.parametrize("frames_in_flight", [0, 2])
+def test_write_gsd_quantized_positions(simulation_factory, create_md_sim,
+                                       tmp_path, frames_in_flight):
+
+    filename = tmp_path / "temporary_test_file.gsd"
+
+    sim = create_md_sim
+    gsd_writer = hoomd.write.GSD(filename=filename,
+                                 trigger=hoomd.trigger.Periodic(1),
+                                 mode='wb')
+    gsd_writer.position_precision = 1e-5
+    gsd_writer.position_keyframe_interval = 3
+    gsd_writer.maximum_frames_in_flight = frames_in_flight
+    sim.operations.writers.append(gsd_writer)
+    assert gsd_writer.position_precision == 1e-5
+
+    position_list = []
+    for _ in range(5):
+        sim.run(1)
+        snap = sim.state.get_snapshot()
+        if snap.communicator.rank == 0:
+            position_list.append(snap.particles.position.copy())
+
+    gsd_writer.flush()
+    L = max(sim.state.box.L)
+
+    if sim.device.communicator.rank == 0:
+        with gsd.fl.open(name=filename, mode='r') as f:
+            for frame in range(5):
+                assert not f.chunk_exists(frame=frame,
+                                          name='particles/position')
+            assert f.chunk_exists(frame=0, name='hoomd/quantized_position/key')
+            assert f.chunk_exists(frame=1,
+                                  name='hoomd/quantized_position/delta')
+            assert f.chunk_exists(frame=3, name='hoomd/quantized_position/key')
+            delta = f.read_chunk(frame=1, name='hoomd/quantized_position/delta')
+            assert delta.dtype.itemsize < 4
+
+    for frame in range(5):
+        new_sim = simulation_factory()
+        new_sim.create_state_from_gsd(filename, frame=frame)
+        snap = new_sim.state.get_snapshot()
+        if snap.communicator.rank == 0:
+            np.testing.assert_allclose(snap.particles.position,
+                                       position_list[frame],
+                                       atol=L * 1e-5)
+
+
 def test_write_gsd_truncate(create_md_sim, tmp_path):
 
     filename = tmp_path / "temporary_test_file.gsd"
@@ -541,3 +657,42 @@ def test_write_gsd_no_dynamic(simulation_factory, hoomd_snapshot, tmp_path):
             assert not f.chunk_exists(frame=1, name='configuration/box')
             assert not f.chunk_exists(frame=1, name='particles/N')
             assert not f.chunk_exists(frame=1, name='particles/position')
+
+
+def test_write_gsd_log_block(simulation_factory, hoomd_snapshot, tmp_path):
+    """Ensure that GSDLog writes every frame of the partial blocks."""
+    filename = tmp_path / "test_gsd_log.gsd"
+
+    sim = simulation_factory(hoomd_snapshot)
+
+    logger = hoomd.logging.Logger(categories=['scalar'])
+    logger.add(sim, quantities=['timestep'])
+    gsd_log = hoomd.write.GSDLog(trigger=hoomd.trigger.Periodic(1),
+                                 filename=filename,
+                                 logger=logger,
+                                 mode='wb',
+                                 block_size=3)
+    sim.operations.writers.append(gsd_log)
+    assert gsd_log.block_size == 3
+
+    sim.run(7)
+    gsd_log.flush()
+
+    if sim.device.communicator.rank == 0:
+        with gsd.fl.open(name=filename, mode='r') as f:
+            assert f.nframes == 7
+            for frame in range(7):
+                step = f.read_chunk(frame=frame, name='configuration/step')
+                timestep = f.read_chunk(frame=frame,
+                                        name='log/Simulation/timestep')
+                assert step[0] == frame + 1
+                assert timestep[0] == frame + 1
+                assert not f.chunk_exists(frame=frame, name='particles/N')
+
+    gsd_log.block_size = 2
+    sim.run(1)
+    gsd_log.flush()
+
+    if sim.device.communicator.rank == 0:
+        with gsd.fl.open(name=filename, mode='r') as f:
+            assert f.nframes == 8
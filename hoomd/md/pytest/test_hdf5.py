@@ -181,3 +181,55 @@ def test_type_handling(tmp_path, create_md_sim):
             for key in loggables:
                 type_ = key if key not in (float, int, bool) else np.dtype(key)
                 assert fh[f"hoomd-data/{str(key)}"].dtype == type_
+
+
+@pytest.mark.skipif(not hoomd.version.hdf5_enabled,
+                    reason="HDF5BlockLog requires ENABLE_HDF5=on.")
+@pytest.mark.parametrize("compression", [None, "gzip"])
+def test_block_log(create_md_sim, tmp_path, compression):
+    filename = tmp_path / "block.h5"
+
+    sim = create_md_sim
+    thermo = hoomd.md.compute.ThermodynamicQuantities(filter=hoomd.filter.All())
+    sim.operations.computes.append(thermo)
+
+    logger = hoomd.logging.Logger(["scalar", "particle", "sequence"])
+    logger.add(thermo)
+    logger[("foo", "flag")] = (lambda: True, "scalar")
+
+    hdf5_writer = hoomd.write.HDF5BlockLog(filename=filename,
+                                           trigger=hoomd.trigger.Periodic(1),
+                                           mode='w',
+                                           logger=logger,
+                                           block_size=3,
+                                           compression=compression)
+    sim.operations.writers.append(hdf5_writer)
+
+    kinetic_energy_list = []
+    for _ in range(5):
+        sim.run(1)
+        kinetic_energy_list.append(thermo.kinetic_energy)
+
+    assert hdf5_writer.compression == compression
+    sim.operations.writers.clear()
+    del hdf5_writer
+
+    key = 'hoomd-data/md/compute/ThermodynamicQuantities/kinetic_energy'
+    if sim.device.communicator.rank == 0:
+        with h5py.File(filename, mode='r') as fh:
+            assert list(fh["hoomd-data"].attrs["hoomd-schema"]) == [0, 1]
+            assert fh["hoomd-data"].attrs["frames"] == 5
+            assert np.allclose(fh[key], kinetic_energy_list)
+            assert fh[key].compression == compression
+            assert fh["hoomd-data/foo/flag"].dtype == np.dtype(bool)
+            assert fh["hoomd-data/foo/flag"][:].all()
+
+    # HDF5Log appends to the file written by HDF5BlockLog.
+    hdf5_writer = hoomd.write.HDF5Log(1, filename, logger, mode="a")
+    sim.operations.writers.append(hdf5_writer)
+    sim.run(1)
+    sim.operations.writers.clear()
+    del hdf5_writer
+    if sim.device.communicator.rank == 0:
+        with h5py.File(filename, mode='r') as fh:
+            assert len(fh[key]) == 6
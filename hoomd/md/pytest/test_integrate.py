@@ -152,6 +152,193 @@ def test_linear_momentum(simulation_factory, lattice_snapshot_factory):
         numpy.testing.assert_allclose(linear_momentum, reference)
 
 
+def test_persistent_ghost_updates(simulation_factory,
+                                  lattice_snapshot_factory):
+    snapshot = lattice_snapshot_factory(n=10, a=1.2, r=0.1)
+
+    def run(persistent):
+        sim = simulation_factory(snapshot)
+        nlist = md.nlist.Cell(buffer=0.4)
+        lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+        lj.params[("A", "A")] = {"epsilon": 1.0, "sigma": 1.0}
+        sim.operations.integrator = hoomd.md.Integrator(
+            dt=0.005,
+            methods=[md.methods.ConstantVolume(hoomd.filter.All())],
+            forces=[lj])
+        sim.run(0)
+        sim.persistent_ghost_updates = persistent
+        sim.run(50)
+        return sim.state.get_snapshot()
+
+    reference = run(False)
+    result = run(True)
+
+    if reference.communicator.rank == 0:
+        numpy.testing.assert_allclose(result.particles.position,
+                                      reference.particles.position)
+
+
+def test_shared_memory_ghost_updates(simulation_factory,
+                                     lattice_snapshot_factory):
+    snapshot = lattice_snapshot_factory(n=10, a=1.2, r=0.1)
+
+    def run(shared_memory):
+        sim = simulation_factory(snapshot)
+        nlist = md.nlist.Cell(buffer=0.4)
+        lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+        lj.params[("A", "A")] = {"epsilon": 1.0, "sigma": 1.0}
+        sim.operations.integrator = hoomd.md.Integrator(
+            dt=0.005,
+            methods=[md.methods.ConstantVolume(hoomd.filter.All())],
+            forces=[lj])
+        sim.run(0)
+        sim.persistent_ghost_updates = True
+        sim.shared_memory_ghost_updates = shared_memory
+        sim.run(50)
+        return sim.state.get_snapshot()
+
+    reference = run(False)
+    result = run(True)
+
+    if reference.communicator.rank == 0:
+        numpy.testing.assert_allclose(result.particles.position,
+                                      reference.particles.position)
+
+
+@pytest.mark.parametrize("bits, tolerance", [(32, 1e-6), (16, 1e-3)])
+def test_ghost_position_bits(simulation_factory, lattice_snapshot_factory,
+                             bits, tolerance):
+    snapshot = lattice_snapshot_factory(n=10, a=1.2, r=0.1)
+
+    def run(bits):
+        sim = simulation_factory(snapshot)
+        nlist = md.nlist.Cell(buffer=0.4)
+        lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+        lj.params[("A", "A")] = {"epsilon": 1.0, "sigma": 1.0}
+        sim.operations.integrator = hoomd.md.Integrator(
+            dt=0.005,
+            methods=[md.methods.ConstantVolume(hoomd.filter.All())],
+            forces=[lj])
+        sim.run(0)
+        sim.ghost_position_bits = bits
+        if sim.device.communicator.num_ranks > 1:
+            assert sim.ghost_position_bits == bits
+        sim.run(50)
+        return sim.state.get_snapshot()
+
+    reference = run(0)
+    result = run(bits)
+
+    if reference.communicator.rank == 0:
+        numpy.testing.assert_allclose(result.particles.position,
+                                      reference.particles.position,
+                                      rtol=tolerance,
+                                      atol=tolerance)
+
+
+def test_skip_unchanged_ghost_fields(simulation_factory,
+                                     lattice_snapshot_factory):
+    snapshot = lattice_snapshot_factory(n=10, a=1.2, r=0.1)
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.moment_inertia[:] = [1, 1, 1]
+
+    def run(skip, integrate_rotational_dof):
+        sim = simulation_factory(snapshot)
+        nlist = md.nlist.Cell(buffer=0.4)
+        gay_berne = md.pair.aniso.GayBerne(nlist=nlist, default_r_cut=2.5)
+        gay_berne.params[("A", "A")] = dict(epsilon=1.0, lperp=0.45, lpar=0.5)
+        sim.operations.integrator = hoomd.md.Integrator(
+            dt=0.005,
+            methods=[md.methods.ConstantVolume(hoomd.filter.All())],
+            forces=[gay_berne],
+            integrate_rotational_dof=integrate_rotational_dof)
+        sim.run(0)
+        sim.skip_unchanged_ghost_fields = skip
+        if sim.device.communicator.num_ranks > 1:
+            assert sim.skip_unchanged_ghost_fields == skip
+        sim.run(50)
+        return sim.state.get_snapshot()
+
+    for integrate_rotational_dof in (False, True):
+        reference = run(False, integrate_rotational_dof)
+        result = run(True, integrate_rotational_dof)
+
+        if reference.communicator.rank == 0:
+            numpy.testing.assert_allclose(result.particles.position,
+                                          reference.particles.position)
+            numpy.testing.assert_allclose(result.particles.orientation,
+                                          reference.particles.orientation)
+
+
+def test_overlap_ghost_updates(simulation_factory, lattice_snapshot_factory):
+    # the ghost layer (r_cut + buffer) spans a large part of each domain, so
+    # every rank has both interior and boundary particles
+    snapshot = lattice_snapshot_factory(n=12, a=1.2, r=0.1)
+
+    def run(overlap):
+        sim = simulation_factory(snapshot)
+        nlist = md.nlist.Cell(buffer=0.4)
+        lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+        lj.params[("A", "A")] = {"epsilon": 1.0, "sigma": 1.0}
+        sim.operations.integrator = hoomd.md.Integrator(
+            dt=0.005,
+            methods=[md.methods.ConstantVolume(hoomd.filter.All())],
+            forces=[lj])
+        sim.always_compute_pressure = True
+        sim.run(0)
+        sim.overlap_ghost_updates = overlap
+        if sim.device.communicator.num_ranks > 1:
+            assert sim.overlap_ghost_updates == overlap
+
+        # the forces of each step are computed after the ghost update, most
+        # steps update the ghosts without a migration
+        result = []
+        for i in range(5):
+            sim.run(1)
+            result.append((lj.forces, lj.energies, lj.virials))
+        return result
+
+    reference = run(False)
+    result = run(True)
+
+    if snapshot.communicator.rank == 0:
+        for step_result, step_reference in zip(result, reference):
+            for value, reference_value in zip(step_result, step_reference):
+                numpy.testing.assert_allclose(value,
+                                              reference_value,
+                                              rtol=1e-5,
+                                              atol=1e-5)
+
+
+def test_migration_margin(simulation_factory, lattice_snapshot_factory):
+    snapshot = lattice_snapshot_factory(n=10, a=1.2, r=0.1)
+
+    def run(margin):
+        sim = simulation_factory(snapshot)
+        nlist = md.nlist.Cell(buffer=0.4)
+        lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+        lj.params[("A", "A")] = {"epsilon": 1.0, "sigma": 1.0}
+        sim.operations.integrator = hoomd.md.Integrator(
+            dt=0.005,
+            methods=[md.methods.ConstantVolume(hoomd.filter.All())],
+            forces=[lj])
+        sim.run(0)
+        sim.migration_margin = margin
+        if sim.device.communicator.num_ranks > 1:
+            assert sim.migration_margin == margin
+        sim.run(50)
+        return sim.state.get_snapshot()
+
+    reference = run(0.0)
+    result = run(0.6)
+
+    if reference.communicator.rank == 0:
+        numpy.testing.assert_allclose(result.particles.position,
+                                      reference.particles.position,
+                                      rtol=1e-5,
+                                      atol=1e-5)
+
+
 def test_pickling(make_simulation, integrator_elements):
     sim = make_simulation()
     integrator = hoomd.md.Integrator(0.005, **integrator_elements)
@@ -162,5 +349,154 @@ def test_logging():
     hoomd.conftest.logging_check(hoomd.md.Integrator, ("md",), {
         "linear_momentum": {
             "category": hoomd.logging.LoggerCategories.sequence
+        },
+        "step_dt": {
+            "category": hoomd.logging.LoggerCategories.scalar,
+            "default": True
+        },
+        "time": {
+            "category": hoomd.logging.LoggerCategories.scalar,
+            "default": True
         }
     })
+
+
+def test_adaptive_dt(simulation_factory, lattice_snapshot_factory):
+    snapshot = lattice_snapshot_factory(n=6, a=1.1, r=0.1)
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.velocity[:] = numpy.random.default_rng(1).normal(
+            size=(snapshot.particles.N, 3))
+
+    sim = simulation_factory(snapshot)
+    nlist = md.nlist.Cell(buffer=0.4)
+    lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[("A", "A")] = {"epsilon": 1.0, "sigma": 1.0}
+    integrator = hoomd.md.Integrator(
+        dt=0.005,
+        methods=[md.methods.ConstantVolume(hoomd.filter.All())],
+        forces=[lj])
+    assert integrator.max_displacement is None
+    sim.operations.integrator = integrator
+
+    sim.run(10)
+    assert integrator.step_dt == pytest.approx(0.005)
+    assert integrator.time == pytest.approx(10 * 0.005)
+
+    integrator.max_displacement = 0.001
+    assert integrator.max_displacement == pytest.approx(0.001)
+
+    time = integrator.time
+    steps = []
+    for i in range(10):
+        sim.run(1)
+        steps.append(integrator.step_dt)
+        assert 0 < integrator.step_dt <= 0.005
+    assert integrator.time == pytest.approx(time + sum(steps))
+    assert min(steps) < 0.005
+
+    integrator.max_displacement = None
+    sim.run(1)
+    assert integrator.step_dt == pytest.approx(0.005)
+
+    with pytest.raises(ValueError):
+        integrator.max_displacement = -1.0
+
+
+def test_slow_forces(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory(two_particle_snapshot_factory(d=1.2))
+    nlist = md.nlist.Cell(buffer=0.4)
+    lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[("A", "A")] = {"epsilon": 1.0, "sigma": 1.0}
+    integrator = hoomd.md.Integrator(
+        dt=0.005,
+        methods=[md.methods.ConstantVolume(hoomd.filter.All())],
+        slow_forces=[lj],
+        slow_force_interval=4)
+    sim.operations.integrator = integrator
+    assert integrator.slow_forces[0] is lj
+    assert integrator.slow_force_interval == 4
+
+    sim.run(0)
+    assert integrator._slow_forces._synced
+    assert integrator.slow_force_interval == 4
+
+    def get_net_force():
+        """Get the net force on the local particles in tag order."""
+        with sim.state.cpu_local_snapshot as snap:
+            net_force = numpy.array(snap.particles.net_force)
+            net_force[numpy.array(snap.particles.tag)] = net_force.copy()
+            return net_force
+
+    # step 0 is a multiple of the interval, the impulse is 4 times the force
+    lj_forces = lj.forces
+    net_force = get_net_force()
+    if sim.device.communicator.num_ranks == 1:
+        numpy.testing.assert_allclose(net_force,
+                                      4 * lj_forces,
+                                      rtol=1e-5,
+                                      atol=1e-6)
+
+    # the slow forces do not contribute on the other steps
+    sim.run(1)
+    numpy.testing.assert_array_equal(get_net_force(), 0)
+
+    sim.run(3)
+    lj_forces = lj.forces
+    net_force = get_net_force()
+    if sim.device.communicator.num_ranks == 1:
+        numpy.testing.assert_allclose(net_force,
+                                      4 * lj_forces,
+                                      rtol=1e-5,
+                                      atol=1e-6)
+
+    with pytest.raises(ValueError):
+        integrator.slow_force_interval = 0
+
+
+def test_concurrent_forces(simulation_factory, two_particle_snapshot_factory):
+
+    def make_simulation(concurrent_forces):
+        snapshot = two_particle_snapshot_factory(d=1.2)
+        if snapshot.communicator.rank == 0:
+            snapshot.bonds.N = 1
+            snapshot.bonds.types = ['A-A']
+            snapshot.bonds.group[0] = [0, 1]
+        sim = simulation_factory(snapshot)
+
+        harmonic = md.bond.Harmonic()
+        harmonic.params['A-A'] = dict(k=10.0, r0=1.0)
+        periodic = md.external.field.Periodic()
+        periodic.params['A'] = dict(A=1.0, i=0, w=0.1, p=2)
+        nlist = md.nlist.Cell(buffer=0.4)
+        lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+        lj.params[("A", "A")] = {"epsilon": 1.0, "sigma": 1.0}
+
+        integrator = hoomd.md.Integrator(
+            dt=0.005,
+            methods=[md.methods.ConstantVolume(hoomd.filter.All())],
+            forces=[harmonic, periodic, lj],
+            concurrent_forces=concurrent_forces)
+        sim.operations.integrator = integrator
+        return sim
+
+    serial = make_simulation(False)
+    concurrent = make_simulation(True)
+    assert concurrent.operations.integrator.concurrent_forces
+    assert concurrent.operations.integrator.force_streams == []
+
+    serial.run(10)
+    concurrent.run(10)
+
+    if isinstance(concurrent.device, hoomd.device.GPU):
+        assert serial.operations.integrator.force_streams == [0, 0, 0]
+        assert concurrent.operations.integrator.force_streams == [1, 2, 0]
+    else:
+        assert concurrent.operations.integrator.force_streams == []
+
+    serial_snapshot = serial.state.get_snapshot()
+    concurrent_snapshot = concurrent.state.get_snapshot()
+    if serial_snapshot.communicator.rank == 0:
+        numpy.testing.assert_allclose(concurrent_snapshot.particles.position,
+                                      serial_snapshot.particles.position,
+                                      rtol=1e-6,
+                                      atol=1e-6)
@@ -385,6 +385,26 @@ class TestMethods:
         autotuned_kernel_parameter_check(instance=method,
                                          activate=lambda: sim.run(1))
 
+    @pytest.mark.gpu
+    def test_kernel_telemetry(self, simulation_factory,
+                              lattice_snapshot_factory):
+        sim = simulation_factory(lattice_snapshot_factory(n=10, a=1.5))
+        method = hoomd.md.methods.ConstantVolume(filter=hoomd.filter.All())
+        integrator = hoomd.md.Integrator(0.005, methods=[method])
+        sim.operations.integrator = integrator
+        sim.run(0)
+        while not method.is_tuning_complete:
+            sim.run(100)
+        sim.run(100)
+
+        telemetry = method.kernel_telemetry
+        assert telemetry.keys() == method.kernel_parameters.keys()
+        for kernel_telemetry in telemetry.values():
+            assert kernel_telemetry['calls'] > 0
+            assert kernel_telemetry['mean_time'] > 0
+            assert kernel_telemetry['bytes_per_call'] > 0
+            assert kernel_telemetry['bandwidth'] > 0
+
     def test_pickling(self, method_definition, simulation_factory,
                       two_particle_snapshot_factory):
         constructor_args = method_definition.generate_init_args()
@@ -546,3 +566,42 @@ class TestRattle:
             hoomd.md.methods.rattle.NVE(filter=all_,
                                         manifold_constraint=manifold))
         assert len(sim.operations.integrator.methods) == 1
+
+
+@pytest.mark.parametrize("method_cls, kwargs", [
+    (hoomd.md.methods.ConstantVolume, {}),
+    (hoomd.md.methods.Langevin, dict(kT=1.5)),
+    (hoomd.md.methods.Brownian, dict(kT=1.5)),
+])
+def test_contiguous_group(simulation_factory, lattice_snapshot_factory,
+                          method_cls, kwargs):
+    """Groups of all particles take the same steps as interleaved groups."""
+    positions = []
+    for filters in ([hoomd.filter.All()],
+                    [hoomd.filter.Type(['A']),
+                     hoomd.filter.Type(['B'])]):
+        snapshot = lattice_snapshot_factory(particle_types=['A', 'B'],
+                                            n=4,
+                                            a=1.5)
+        if snapshot.communicator.rank == 0:
+            N = snapshot.particles.N
+            snapshot.particles.typeid[:] = np.arange(N) % 2
+            rng = np.random.default_rng(1)
+            snapshot.particles.velocity[:] = rng.uniform(-1, 1, (N, 3))
+        sim = simulation_factory(snapshot)
+
+        lj = hoomd.md.pair.LJ(hoomd.md.nlist.Cell(buffer=0.4),
+                              default_r_cut=2.5)
+        lj.params[(['A', 'B'], ['A', 'B'])] = dict(epsilon=1, sigma=1)
+        methods = [method_cls(filter=f, **kwargs) for f in filters]
+        sim.operations.integrator = hoomd.md.Integrator(0.005,
+                                                        methods=methods,
+                                                        forces=[lj])
+        sim.run(10)
+
+        snapshot = sim.state.get_snapshot()
+        if snapshot.communicator.rank == 0:
+            positions.append(snapshot.particles.position)
+
+    if len(positions) > 0:
+        np.testing.assert_allclose(positions[0], positions[1], atol=1e-6)
@@ -29,7 +29,8 @@ def _make_random_params():
         'force_tol': np.random.rand(),
         'angmom_tol': np.random.rand(),
         'energy_tol': np.random.rand(),
-        'min_steps_conv': np.random.randint(1, 15)
+        'min_steps_conv': np.random.randint(1, 15),
+        'check_interval': np.random.randint(1, 15)
     }
     return params
 
@@ -55,6 +56,9 @@ def _assert_error_if_nonpositive(fire):
     with pytest.raises(ValueError):
         fire.min_steps_conv = negative_value
 
+    with pytest.raises(ValueError):
+        fire.check_interval = negative_value
+
 
 def test_constructor_validation():
     """Make sure constructor validates arguments."""
@@ -89,7 +93,8 @@ def test_get_set_params(simulation_factory, two_particle_snapshot_factory):
         'force_tol': 0.1,
         'angmom_tol': 0.1,
         'energy_tol': 1e-5,
-        'min_steps_conv': 10
+        'min_steps_conv': 10,
+        'check_interval': 1
     }
     _assert_correct_params(fire, default_params)
 
@@ -145,6 +150,37 @@ def test_run_minimization(lattice_snapshot_factory, simulation_factory):
     fire.reset()
 
 
+def test_check_interval(lattice_snapshot_factory, simulation_factory):
+    """Check for convergence only every check_interval steps."""
+    snap = lattice_snapshot_factory(a=1.5, n=8)
+    sim = simulation_factory(snap)
+
+    lj = md.pair.LJ(default_r_cut=2.5, nlist=md.nlist.Cell(buffer=0.4))
+    lj.params[('A', 'A')] = dict(sigma=1.0, epsilon=1.0)
+    nve = md.methods.ConstantVolume(hoomd.filter.All())
+
+    fire = md.minimize.FIRE(dt=0.0025,
+                            force_tol=1e-1,
+                            angmom_tol=1e-1,
+                            energy_tol=1e-5,
+                            methods=[nve],
+                            forces=[lj],
+                            min_steps_conv=3,
+                            check_interval=4)
+
+    sim.operations.integrator = fire
+    sim.run(0)
+
+    initial_energy = fire.energy
+    steps_to_converge = 0
+    while not fire.converged:
+        sim.run(1)
+        steps_to_converge += 1
+
+    assert initial_energy >= fire.energy
+    assert steps_to_converge % fire.check_interval == 0
+
+
 def test_pickling(lattice_snapshot_factory, simulation_factory):
     """Assert the minimizer can be pickled when attached/unattached."""
     snap = lattice_snapshot_factory(a=1.5, n=5)
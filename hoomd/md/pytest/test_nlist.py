@@ -10,7 +10,7 @@ import json
 import random
 import collections
 from pathlib import Path
-from hoomd.md.nlist import Cell, Stencil, Tree
+from hoomd.md.nlist import Cell, MultiLevel, Stencil, Tree
 from hoomd.conftest import (logging_check, pickling_check,
                             autotuned_kernel_parameter_check)
 
@@ -33,6 +33,7 @@ def _nlist_params():
     nlists.append((Cell, {}))
     nlists.append((Tree, {}))
     nlists.append((Stencil, dict(cell_width=0.5)))
+    nlists.append((MultiLevel, {}))
     return nlists
 
 
@@ -84,9 +85,25 @@ def test_common_params(nlist_params):
 
 def test_cell_specific_params():
     nlist = Cell(buffer=0.4)
-    _assert_nlist_params(nlist, dict(deterministic=False))
+    _assert_nlist_params(
+        nlist,
+        dict(deterministic=False,
+             partial_update_fraction=0,
+             compressed=False,
+             image_shifts=False,
+             sort_neighbors=False))
     nlist.deterministic = True
-    _assert_nlist_params(nlist, dict(deterministic=True))
+    nlist.partial_update_fraction = 0.1
+    nlist.compressed = True
+    nlist.image_shifts = True
+    nlist.sort_neighbors = True
+    _assert_nlist_params(
+        nlist,
+        dict(deterministic=True,
+             partial_update_fraction=0.1,
+             compressed=True,
+             image_shifts=True,
+             sort_neighbors=True))
 
 
 def test_stencil_specific_params():
@@ -100,6 +117,13 @@ def test_stencil_specific_params():
     _assert_nlist_params(nlist, dict(deterministic=True, cell_width=x))
 
 
+def test_multi_level_specific_params():
+    nlist = MultiLevel(buffer=0.4)
+    _assert_nlist_params(nlist, dict(deterministic=False))
+    nlist.deterministic = True
+    _assert_nlist_params(nlist, dict(deterministic=True))
+
+
 def test_simple_simulation(nlist_params, simulation_factory,
                            lattice_snapshot_factory):
     nlist_cls, required_args = nlist_params
@@ -185,12 +209,326 @@ def test_cell_properties(simulation_factory, lattice_snapshot_factory):
 
     assert nlist.num_builds == 10
     assert nlist.shortest_rebuild == 1
+    assert nlist.build_time > 0
     dim = nlist.dimensions
     assert len(dim) == 3
     assert dim >= (1, 1, 1)
     assert nlist.allocated_particles_per_cell >= 1
 
 
+def test_quality_metrics(simulation_factory, lattice_snapshot_factory):
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    lj.params[('A', 'B')] = dict(epsilon=1, sigma=1)
+    lj.params[('B', 'B')] = dict(epsilon=1, sigma=1)
+    integrator = hoomd.md.Integrator(0.005)
+    integrator.forces.append(lj)
+    integrator.methods.append(
+        hoomd.md.methods.Langevin(hoomd.filter.All(), kT=1))
+
+    sim = simulation_factory(
+        lattice_snapshot_factory(particle_types=['A', 'B'], n=10, a=1.2))
+    sim.operations.integrator = integrator
+
+    sim.run(200)
+
+    assert nlist.mean_neighbors > 0
+    assert nlist.max_neighbors >= nlist.mean_neighbors
+    assert 0 < nlist.list_efficiency <= 1
+    assert 0 <= nlist.unused_storage_fraction < 1
+
+    trigger_types = nlist.rebuild_trigger_types
+    assert len(trigger_types) == 2
+    # with domain decomposition, every rank that triggers a build counts it
+    if sim.device.communicator.num_ranks == 1:
+        assert sum(trigger_types) <= nlist.num_builds
+
+
+@pytest.mark.cpu
+@pytest.mark.serial
+def test_partial_updates(simulation_factory, lattice_snapshot_factory):
+    r_cut = 1.1
+    nlist = hoomd.md.nlist.Cell(buffer=0.4, partial_update_fraction=1.0)
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=r_cut)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    lj.params[('A', 'B')] = dict(epsilon=1, sigma=1)
+    lj.params[('B', 'B')] = dict(epsilon=1, sigma=1)
+    integrator = hoomd.md.Integrator(0.005, forces=[lj])
+    integrator.methods.append(
+        hoomd.md.methods.Langevin(hoomd.filter.All(), kT=1.5))
+
+    sim = simulation_factory(lattice_snapshot_factory(n=8, a=1.2))
+    sim.operations.integrator = integrator
+
+    for _ in range(10):
+        sim.run(20)
+
+        # every pair within r_cut must be in the neighbor list exactly once
+        snapshot = sim.state.get_snapshot()
+        box = sim.state.box
+        position = snapshot.particles.position
+        delta = position[:, np.newaxis, :] - position[np.newaxis, :, :]
+        L = np.array([box.Lx, box.Ly, box.Lz])
+        delta -= L * np.round(delta / L)
+        distance = np.linalg.norm(delta, axis=-1)
+        i, j = np.nonzero(np.triu(distance < r_cut, k=1))
+        pairs = nlist.pair_list
+        pair_set = set([frozenset(pair) for pair in pairs])
+
+        assert len(pair_set) == len(pairs)
+        assert set(frozenset(pair) for pair in zip(i, j)) <= pair_set
+
+    assert nlist.num_partial_builds > 0
+
+
+@pytest.mark.cpu
+@pytest.mark.parametrize("exclusions", [(), ('bond',)])
+def test_compressed(simulation_factory, lattice_snapshot_factory, exclusions):
+    snapshot = lattice_snapshot_factory(n=8, a=1.1, r=0.1)
+    if snapshot.communicator.rank == 0:
+        snapshot.bonds.types = ['b']
+        snapshot.bonds.N = 100
+        snapshot.bonds.group[:] = [[2 * i, 2 * i + 1] for i in range(100)]
+    sim = simulation_factory(snapshot)
+
+    energies = []
+    pair_lists = []
+    for compressed in (False, True):
+        nlist = hoomd.md.nlist.Cell(buffer=0.4,
+                                    exclusions=exclusions,
+                                    compressed=compressed)
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        sim.operations.computes.append(lj)
+        sim.run(0)
+        energies.append(lj.energy)
+        pair_lists.append(nlist.pair_list)
+        sim.operations.computes.remove(lj)
+
+    np.testing.assert_allclose(energies[0], energies[1], rtol=1e-6)
+    if sim.device.communicator.rank == 0:
+        assert set(frozenset(pair) for pair in pair_lists[0]) == set(
+            frozenset(pair) for pair in pair_lists[1])
+
+
+@pytest.mark.cpu
+@pytest.mark.parametrize("image_shifts", [False, True])
+def test_build_exclusions(simulation_factory, lattice_snapshot_factory,
+                          image_shifts):
+    snapshot = lattice_snapshot_factory(n=8, a=1.1, r=0.1)
+    if snapshot.communicator.rank == 0:
+        # chains of 8 beads along the lattice rows
+        n_chains = snapshot.particles.N // 8
+        snapshot.bonds.types = ['b']
+        snapshot.bonds.N = n_chains * 7
+        snapshot.bonds.group[:] = [[8 * c + k, 8 * c + k + 1]
+                                   for c in range(n_chains)
+                                   for k in range(7)]
+    sim = simulation_factory(snapshot)
+
+    exclusions = ('bond', '1-3', '1-4')
+    energies = []
+    pair_lists = []
+    for nlist in (hoomd.md.nlist.Cell(buffer=0.4,
+                                      exclusions=exclusions,
+                                      image_shifts=image_shifts),
+                  hoomd.md.nlist.Tree(buffer=0.4, exclusions=exclusions)):
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        sim.operations.computes.append(lj)
+        sim.run(0)
+        energies.append(lj.energy)
+        pair_lists.append(nlist.pair_list)
+        sim.operations.computes.remove(lj)
+
+    np.testing.assert_allclose(energies[0], energies[1], rtol=1e-6)
+    if sim.device.communicator.rank == 0:
+        pairs = set(frozenset(pair) for pair in pair_lists[0])
+        assert pairs == set(frozenset(pair) for pair in pair_lists[1])
+        assert frozenset((0, 1)) not in pairs
+        assert frozenset((0, 2)) not in pairs
+
+
+@pytest.mark.cpu
+@pytest.mark.parametrize("image_shifts", [False, True])
+def test_sort_neighbors(simulation_factory, lattice_snapshot_factory,
+                        image_shifts):
+    snapshot = lattice_snapshot_factory(n=8, a=1.1, r=0.1)
+    if snapshot.communicator.rank == 0:
+        snapshot.bonds.types = ['b']
+        snapshot.bonds.N = 100
+        snapshot.bonds.group[:] = [[2 * i, 2 * i + 1] for i in range(100)]
+    sim = simulation_factory(snapshot)
+
+    energies = []
+    pair_lists = []
+    for sort_neighbors in (False, True):
+        nlist = hoomd.md.nlist.Cell(buffer=0.4,
+                                    image_shifts=image_shifts,
+                                    sort_neighbors=sort_neighbors)
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        sim.operations.computes.append(lj)
+        sim.run(0)
+        energies.append(lj.energy)
+        pair_lists.append(nlist.pair_list)
+        local_pair_list = nlist.local_pair_list
+        sim.operations.computes.remove(lj)
+
+    np.testing.assert_allclose(energies[0], energies[1], rtol=1e-6)
+    if sim.device.communicator.rank == 0:
+        assert set(frozenset(pair) for pair in pair_lists[0]) == set(
+            frozenset(pair) for pair in pair_lists[1])
+
+    # the local pair list lists the sorted rows in order
+    i, j = local_pair_list[:, 0], local_pair_list[:, 1]
+    same_row = i[1:] == i[:-1]
+    assert np.all(j[1:][same_row] > j[:-1][same_row])
+
+
+@pytest.mark.cpu
+@pytest.mark.parametrize("nlist_cls",
+                         [hoomd.md.nlist.Cell, hoomd.md.nlist.Tree])
+def test_image_shifts(simulation_factory, lattice_snapshot_factory, nlist_cls):
+    snapshot = lattice_snapshot_factory(n=6, a=1.2, r=0.1)
+    sim = simulation_factory(snapshot)
+    sim.state.thermalize_particle_momenta(hoomd.filter.All(), kT=1.5)
+
+    nlist = nlist_cls(buffer=0.4, image_shifts=True)
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    integrator = hoomd.md.Integrator(0.005, forces=[lj])
+    integrator.methods.append(
+        hoomd.md.methods.ConstantVolume(hoomd.filter.All()))
+    sim.operations.integrator = integrator
+
+    # particles cross the boundaries between the neighbor list builds
+    sim.run(100)
+
+    reference = hoomd.md.pair.LJ(hoomd.md.nlist.Cell(buffer=0.4),
+                                 default_r_cut=2.5)
+    reference.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    sim.operations.computes.append(reference)
+    sim.run(0)
+
+    np.testing.assert_allclose(lj.energy, reference.energy, rtol=1e-5)
+    forces = lj.forces
+    reference_forces = reference.forces
+    if sim.device.communicator.rank == 0:
+        np.testing.assert_allclose(forces, reference_forces, atol=1e-4)
+
+
+@pytest.mark.cpu
+@pytest.mark.parametrize("nlist_cls",
+                         [hoomd.md.nlist.Cell, hoomd.md.nlist.Stencil])
+def test_body_exclusions(simulation_factory, lattice_snapshot_factory,
+                         nlist_cls):
+    snapshot = lattice_snapshot_factory(n=8, a=1.1, r=0.1)
+    if snapshot.communicator.rank == 0:
+        # neighboring particles in bodies of four, interleaved with free
+        # particles
+        body = np.arange(snapshot.particles.N) // 4
+        body[body % 3 == 2] = -1
+        snapshot.particles.body[:] = body
+    sim = simulation_factory(snapshot)
+
+    kwargs = dict(cell_width=1.0) if nlist_cls is hoomd.md.nlist.Stencil \
+        else {}
+    nlist = nlist_cls(buffer=0.4, exclusions=('body',), **kwargs)
+    reference = hoomd.md.nlist.Tree(buffer=0.4, exclusions=('body',))
+    for n in (nlist, reference):
+        n.r_cut[('A', 'A')] = 1.5
+        sim.operations.computes.append(n)
+    sim.run(0)
+
+    pair_list = nlist.pair_list
+    reference_pair_list = reference.pair_list
+    if sim.device.communicator.rank == 0:
+        assert len(pair_list) == len(reference_pair_list)
+        assert set(frozenset(pair) for pair in pair_list) == set(
+            frozenset(pair) for pair in reference_pair_list)
+
+
+@pytest.mark.parametrize("exclusions", [(), ('body',)])
+def test_multi_level(simulation_factory, lattice_snapshot_factory,
+                     exclusions):
+    snapshot = lattice_snapshot_factory(particle_types=['A', 'B'],
+                                        n=10,
+                                        a=1.1,
+                                        r=0.1)
+    if snapshot.communicator.rank == 0:
+        # a few large particles among many small ones, some small particles
+        # in bodies
+        snapshot.particles.typeid[:] = 0
+        snapshot.particles.typeid[::9] = 1
+        body = np.arange(snapshot.particles.N) // 4
+        body[body % 3 == 2] = -1
+        snapshot.particles.body[:] = body
+    sim = simulation_factory(snapshot)
+
+    nlist = MultiLevel(buffer=0.4, exclusions=exclusions)
+    reference = Tree(buffer=0.4, exclusions=exclusions)
+    for n in (nlist, reference):
+        n.r_cut[('A', 'A')] = 1.2
+        n.r_cut[('A', 'B')] = 2.6
+        n.r_cut[('B', 'B')] = 4.0
+        sim.operations.computes.append(n)
+    sim.run(0)
+
+    assert nlist.num_levels == 2
+    np.testing.assert_allclose(nlist.level_widths, (1.6, 4.4), rtol=1e-6)
+
+    pair_list = nlist.pair_list
+    reference_pair_list = reference.pair_list
+    if sim.device.communicator.rank == 0:
+        assert len(pair_list) == len(reference_pair_list)
+        assert set(frozenset(pair) for pair in pair_list) == set(
+            frozenset(pair) for pair in reference_pair_list)
+
+
+@pytest.mark.parametrize("exclusions", [(), ('bond',)])
+def test_auto(simulation_factory, lattice_snapshot_factory, exclusions):
+    snapshot = lattice_snapshot_factory(n=8, a=1.1, r=0.1)
+    if snapshot.communicator.rank == 0:
+        snapshot.bonds.types = ['b']
+        snapshot.bonds.N = 100
+        snapshot.bonds.group[:] = [[2 * i, 2 * i + 1] for i in range(100)]
+    sim = simulation_factory(snapshot)
+
+    energies = []
+    pair_lists = []
+    for nlist in (hoomd.md.nlist.Cell(buffer=0.4, exclusions=exclusions),
+                  hoomd.md.nlist.Auto(buffer=0.4,
+                                      exclusions=exclusions,
+                                      selection_period=10)):
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        sim.operations.computes.append(lj)
+        sim.run(0)
+        energies.append(lj.energy)
+        pair_lists.append(nlist.pair_list)
+
+    np.testing.assert_allclose(energies[0], energies[1], rtol=1e-6)
+    if sim.device.communicator.rank == 0:
+        assert set(frozenset(pair) for pair in pair_lists[0]) == set(
+            frozenset(pair) for pair in pair_lists[1])
+
+    assert nlist.selection_period == 10
+    assert nlist.box_tolerance == 0.1
+    assert nlist.algorithm in ('Cell', 'Stencil', 'Tree')
+    assert len(nlist.algorithm_build_times) == 3
+    assert all(t > 0 for t in nlist.algorithm_build_times)
+
+    # a new cutoff triggers a new selection, the list must stay consistent
+    lj.r_cut[('A', 'A')] = 1.5
+    sim.operations.computes[0].r_cut[('A', 'A')] = 1.5
+    sim.run(20)
+    np.testing.assert_allclose(sim.operations.computes[0].energy,
+                               lj.energy,
+                               rtol=1e-6)
+
+
 def test_logging():
     base_loggables = {
         'shortest_rebuild': {
@@ -200,6 +538,30 @@ def test_logging():
         'num_builds': {
             'category': LoggerCategories.scalar,
             'default': False
+        },
+        'build_time': {
+            'category': LoggerCategories.scalar,
+            'default': False
+        },
+        'mean_neighbors': {
+            'category': LoggerCategories.scalar,
+            'default': False
+        },
+        'max_neighbors': {
+            'category': LoggerCategories.scalar,
+            'default': False
+        },
+        'list_efficiency': {
+            'category': LoggerCategories.scalar,
+            'default': False
+        },
+        'unused_storage_fraction': {
+            'category': LoggerCategories.scalar,
+            'default': False
+        },
+        'rebuild_trigger_types': {
+            'category': LoggerCategories.sequence,
+            'default': False
         }
     }
     logging_check(hoomd.md.nlist.NeighborList, ('md', 'nlist'), base_loggables)
@@ -215,6 +577,36 @@ def test_logging():
                 'category': LoggerCategories.scalar,
                 'default': False
             },
+            'num_partial_builds': {
+                'category': LoggerCategories.scalar,
+                'default': False
+            },
+        })
+
+    logging_check(
+        hoomd.md.nlist.MultiLevel, ('md', 'nlist'), {
+            **base_loggables,
+            'num_levels': {
+                'category': LoggerCategories.scalar,
+                'default': False
+            },
+            'level_widths': {
+                'category': LoggerCategories.sequence,
+                'default': False
+            },
+        })
+
+    logging_check(
+        hoomd.md.nlist.Auto, ('md', 'nlist'), {
+            **base_loggables,
+            'algorithm': {
+                'category': LoggerCategories.string,
+                'default': True
+            },
+            'algorithm_build_times': {
+                'category': LoggerCategories.sequence,
+                'default': False
+            },
         })
 
 
@@ -372,6 +764,22 @@ def test_global_pair_list(simulation_factory, lattice_snapshot_factory, setup):
     _check_pair_set(sim, nlist, truth_set)
 
 
+@pytest.mark.cpu
+@pytest.mark.skipif(not hoomd.version.tbb_enabled,
+                    reason="TBB threads not available.")
+@pytest.mark.parametrize("nlist_cls",
+                         [hoomd.md.nlist.Cell, hoomd.md.nlist.Tree])
+def test_threaded_pair_list(device, simulation_factory,
+                            lattice_snapshot_factory, nlist_cls):
+    device.num_cpu_threads = 4
+    nlist = nlist_cls(buffer=0.0, default_r_cut=1.1)
+    sim = simulation_factory(lattice_snapshot_factory())
+    sim.operations.computes.append(nlist)
+    sim.run(0)
+
+    _check_pair_set(sim, nlist, TRUE_PAIR_LIST)
+
+
 def _check_local_pairs_with_mpi(tag_pair_list, broadcast=False):
 
     tag_pair_list = np.array(tag_pair_list, dtype=np.int32)
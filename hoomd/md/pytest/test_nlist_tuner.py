@@ -124,3 +124,59 @@ class TestMoveSize:
 
     def test_pickling(self, nlist_tuner, simulation):
         operation_pickling_check(nlist_tuner, simulation)
+
+
+class TestNeighborListBufferOnline:
+
+    def test_valid_construction(self, nlist):
+        tuner = md.tune.NeighborListBufferOnline(trigger=5,
+                                                 nlist=nlist,
+                                                 maximum_buffer=1.0)
+        assert tuner.trigger.period == 5
+        assert tuner.nlist is nlist
+        assert tuner.maximum_buffer == 1.0
+        assert tuner.minimum_buffer == 0.0
+        assert tuner.min_step_fraction == 0.02
+        assert tuner.tune_check_delay
+
+    def test_act(self, nlist, simulation):
+        tuner = md.tune.NeighborListBufferOnline(trigger=10,
+                                                 nlist=nlist,
+                                                 maximum_buffer=1.0,
+                                                 minimum_buffer=0.1)
+        simulation.operations.tuners.append(tuner)
+        simulation.run(0)
+        assert tuner.min_step_fraction == 0.02
+
+        buffers = set()
+        for _ in range(5):
+            simulation.run(20)
+            buffers.add(nlist.buffer)
+            assert 0.1 <= nlist.buffer <= 1.0
+            assert nlist.rebuild_check_delay >= 1
+
+        # the tuner never stops moving the buffer
+        assert len(buffers) > 1
+        assert tuner.time_per_step > 0
+        assert 0 <= tuner.build_fraction <= 1
+
+        tuner.tune_check_delay = False
+        delay = nlist.rebuild_check_delay
+        simulation.run(20)
+        assert nlist.rebuild_check_delay == delay
+
+    def test_detach(self, nlist, simulation):
+        tuner = md.tune.NeighborListBufferOnline(trigger=10,
+                                                 nlist=nlist,
+                                                 maximum_buffer=1.0)
+        simulation.operations.tuners.append(tuner)
+        simulation.run(0)
+        assert tuner._attached
+        simulation.operations -= tuner
+        assert not tuner._attached
+
+    def test_pickling(self, nlist, simulation):
+        tuner = md.tune.NeighborListBufferOnline(trigger=10,
+                                                 nlist=nlist,
+                                                 maximum_buffer=1.0)
+        operation_pickling_check(tuner, simulation)
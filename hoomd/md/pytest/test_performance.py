@@ -0,0 +1,32 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+import hoomd
+from hoomd import md
+import pytest
+
+
+@pytest.mark.performance
+@pytest.mark.parametrize("mode", ['none', 'shift'])
+def test_lj(simulation_factory, lattice_snapshot_factory, performance, mode):
+    """Measure a Lennard-Jones liquid.
+
+    Executed with MPI, the profile includes the time spent in the Communicator.
+    """
+    snap = lattice_snapshot_factory(n=30, a=1.2, r=0.01)
+    sim = simulation_factory(snap)
+    sim.state.thermalize_particle_momenta(hoomd.filter.All(), kT=1.0)
+
+    lj = md.pair.LJ(nlist=md.nlist.Cell(buffer=0.4), mode=mode)
+    lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+    lj.r_cut[('A', 'A')] = 2.5
+
+    nvt = md.methods.ConstantVolume(
+        filter=hoomd.filter.All(),
+        thermostat=md.methods.thermostats.Bussi(kT=1.0))
+    sim.operations.integrator = md.Integrator(dt=0.005,
+                                              methods=[nvt],
+                                              forces=[lj])
+
+    result = performance.measure(sim, steps=2000, warmup=1000)
+    assert result['tps'] > 0
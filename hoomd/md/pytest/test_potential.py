@@ -436,6 +436,18 @@ def _valid_params(particle_types=['A', 'B']):
         paramtuple(md.pair.Ewald, dict(zip(combos, ewald_valid_param_dicts)),
                    {}))
 
+    ewald_table_arg_dict = {
+        "alpha": [0.025, 0.05, 0.075],
+        "kappa": [0.5, 1.0, 1.5],
+        "r_min": [0.25, 0.5, 0.75],
+        "width": [256, 512, 1024]
+    }
+    ewald_table_valid_param_dicts = _make_valid_param_dicts(
+        ewald_table_arg_dict)
+    valid_params_list.append(
+        paramtuple(md.pair.EwaldTable,
+                   dict(zip(combos, ewald_table_valid_param_dicts)), {}))
+
     morse_arg_dict = {
         "D0": [0.025, 0.05, 0.075],
         "alpha": [0.5, 1.0, 1.5],
@@ -664,6 +676,18 @@ def _valid_params(particle_types=['A', 'B']):
     valid_params_list.append(
         paramtuple(hoomd.md.pair.Table,
                    dict(zip(combos, table_valid_param_dicts)), {}))
+
+    spline_rs = [0.5 + 2 * np.linspace(0, 1, n)**2 for n in (10, 20, 30)]
+    table_spline_arg_dict = {
+        'r': spline_rs,
+        'U': [4 * (r**-12 - r**-6) for r in spline_rs],
+        'F': [4 * (12 * r**-13 - 6 * r**-7) for r in spline_rs]
+    }
+    table_spline_valid_param_dicts = _make_valid_param_dicts(
+        table_spline_arg_dict)
+    valid_params_list.append(
+        paramtuple(hoomd.md.pair.TableSpline,
+                   dict(zip(combos, table_spline_valid_param_dicts)), {}))
     return valid_params_list
 
 
@@ -1377,3 +1401,206 @@ def test_shift(simulation_factory, two_particle_snapshot_factory,
     # is much closer to 0 than V.
     tolerance = max(math.fabs(V / 1e4), 1e-8)
     assert V_shifted == pytest.approx(expected=0, abs=tolerance)
+
+
+@pytest.mark.cpu
+@pytest.mark.skipif(not hoomd.version.tbb_enabled,
+                    reason="TBB threads not available.")
+def test_threaded_forces(device, simulation_factory, lattice_snapshot_factory):
+    """Test that threaded CPU pair forces match serial forces."""
+    sim = simulation_factory(lattice_snapshot_factory(a=1.1, n=6, r=0.1))
+    lj = md.pair.LJ(nlist=md.nlist.Cell(buffer=0.4), default_r_cut=2.5)
+    lj.params[('A', 'A')] = {'sigma': 1.0, 'epsilon': 1.0}
+    sim.operations.integrator = md.Integrator(dt=0.005, forces=[lj])
+    sim.always_compute_pressure = True
+
+    device.num_cpu_threads = 1
+    sim.run(0)
+    serial_forces = lj.forces
+    serial_energies = lj.energies
+    serial_virials = lj.virials
+
+    device.num_cpu_threads = 4
+    sim.operations._unschedule()
+    sim.run(0)
+    threaded_forces = lj.forces
+    threaded_energies = lj.energies
+    threaded_virials = lj.virials
+
+    if sim.device.communicator.rank == 0:
+        np.testing.assert_allclose(threaded_forces,
+                                   serial_forces,
+                                   rtol=1e-5,
+                                   atol=1e-6)
+        np.testing.assert_allclose(threaded_energies,
+                                   serial_energies,
+                                   rtol=1e-5,
+                                   atol=1e-6)
+        np.testing.assert_allclose(threaded_virials,
+                                   serial_virials,
+                                   rtol=1e-5,
+                                   atol=1e-6)
+
+
+@pytest.mark.parametrize('mode', ['none', 'shift', 'xplor'])
+def test_mixed_precision(device, simulation_factory, lattice_snapshot_factory,
+                         mode):
+    """Test that mixed precision pair forces match double precision forces."""
+    sim = simulation_factory(lattice_snapshot_factory(a=1.1, n=6, r=0.1))
+    lj = md.pair.LJ(nlist=md.nlist.Cell(buffer=0.4),
+                    default_r_cut=2.5,
+                    default_r_on=2.0,
+                    mode=mode)
+    lj.params[('A', 'A')] = {'sigma': 1.0, 'epsilon': 1.0}
+    assert not lj.mixed_precision
+    sim.operations.integrator = md.Integrator(dt=0.005, forces=[lj])
+    sim.always_compute_pressure = True
+
+    sim.run(0)
+    assert not lj.mixed_precision
+    forces = lj.forces
+    energies = lj.energies
+    virials = lj.virials
+
+    lj.mixed_precision = True
+    sim.operations._unschedule()
+    sim.run(0)
+    assert lj.mixed_precision
+
+    if sim.device.communicator.rank == 0:
+        np.testing.assert_allclose(lj.forces, forces, rtol=1e-4, atol=1e-3)
+        np.testing.assert_allclose(lj.energies, energies, rtol=1e-4, atol=1e-3)
+        np.testing.assert_allclose(lj.virials, virials, rtol=1e-4, atol=1e-3)
+
+
+def test_mixed_precision_support():
+    """Test that only pair forces with batched evaluation have the option."""
+    assert md.pair.LJ(nlist=md.nlist.Cell(buffer=0.4)).mixed_precision is False
+    with pytest.raises(AttributeError):
+        md.pair.Mie(nlist=md.nlist.Cell(buffer=0.4)).mixed_precision
+
+
+@pytest.mark.serial
+@pytest.mark.cpu
+@pytest.mark.parametrize('mode', ['none', 'shift', 'xplor'])
+def test_use_cell_list(device, simulation_factory, lattice_snapshot_factory,
+                       mode):
+    """Test that pair forces found in a cell list match neighbor list forces."""
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'],
+                                    a=1.1,
+                                    n=6,
+                                    r=0.1)
+    if snap.communicator.rank == 0:
+        snap.particles.typeid[::3] = 1
+    sim = simulation_factory(snap)
+    lj = md.pair.LJ(nlist=md.nlist.Cell(buffer=0.4),
+                    default_r_cut=2.5,
+                    default_r_on=2.0,
+                    mode=mode)
+    lj.params[('A', 'A')] = {'sigma': 1.0, 'epsilon': 1.0}
+    lj.params[('A', 'B')] = {'sigma': 1.1, 'epsilon': 0.5}
+    lj.params[('B', 'B')] = {'sigma': 0.9, 'epsilon': 1.5}
+    lj.r_cut[('A', 'B')] = 2.0
+    lj.r_cut[('B', 'B')] = 0.0
+    assert not lj.use_cell_list
+    sim.operations.integrator = md.Integrator(dt=0.005, forces=[lj])
+    sim.always_compute_pressure = True
+
+    sim.run(0)
+    assert not lj.use_cell_list
+    forces = lj.forces
+    energies = lj.energies
+    virials = lj.virials
+
+    lj.use_cell_list = True
+    sim.operations._unschedule()
+    sim.run(0)
+    assert lj.use_cell_list
+
+    np.testing.assert_allclose(lj.forces, forces, rtol=1e-6, atol=1e-6)
+    np.testing.assert_allclose(lj.energies, energies, rtol=1e-6, atol=1e-6)
+    np.testing.assert_allclose(lj.virials, virials, rtol=1e-6, atol=1e-6)
+
+
+def test_use_cell_list_support():
+    """Test that pair forces which override the computation lack the option."""
+    assert md.pair.LJ(nlist=md.nlist.Cell(buffer=0.4)).use_cell_list is False
+    with pytest.raises(AttributeError):
+        md.pair.DPD(nlist=md.nlist.Cell(buffer=0.4), kT=1.0).use_cell_list
+
+
+@pytest.mark.parametrize('mode', ['none', 'shift', 'xplor'])
+@pytest.mark.parametrize('n', [6, 11])
+def test_compute_energy_matrix(simulation_factory, lattice_snapshot_factory,
+                               mode, n):
+    """Test the energies between sets of particles against the total energy."""
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'],
+                                    a=1.1,
+                                    n=n,
+                                    r=0.1)
+    if snap.communicator.rank == 0:
+        snap.particles.typeid[::3] = 1
+    sim = simulation_factory(snap)
+    lj = md.pair.LJ(nlist=md.nlist.Cell(buffer=0.4),
+                    default_r_cut=2.5,
+                    default_r_on=2.0,
+                    mode=mode)
+    lj.params[('A', 'A')] = {'sigma': 1.0, 'epsilon': 1.0}
+    lj.params[('A', 'B')] = {'sigma': 1.1, 'epsilon': 0.5}
+    lj.params[('B', 'B')] = {'sigma': 0.9, 'epsilon': 1.5}
+    lj.r_cut[('A', 'B')] = 2.0
+    sim.operations.integrator = md.Integrator(dt=0.005, forces=[lj])
+    sim.run(0)
+
+    n_sets = 4
+    tags = np.arange(n**3, dtype=np.uint32)
+    sets = tags % n_sets
+    matrix = lj.compute_energy_matrix(tags=tags, sets=sets)
+    assert matrix.shape == (n_sets, n_sets)
+    np.testing.assert_allclose(matrix, matrix.T, rtol=1e-6, atol=1e-6)
+
+    # every pair belongs to one element of the upper triangle
+    np.testing.assert_allclose(np.sum(np.triu(matrix)),
+                               lj.energy,
+                               rtol=1e-5,
+                               atol=1e-5)
+
+    energy_01 = lj.compute_energy(tags1=tags[sets == 0].astype(np.int32),
+                                  tags2=tags[sets == 1].astype(np.int32))
+    np.testing.assert_allclose(energy_01, matrix[0, 1], rtol=1e-6, atol=1e-6)
+
+    with pytest.raises(ValueError):
+        lj.compute_energy_matrix(tags=tags, sets=sets[:-1])
+
+
+def test_deferred_virials(simulation_factory, lattice_snapshot_factory):
+    """Test pair virials computed after the first run without the pressure."""
+
+    def make_simulation():
+        snap = lattice_snapshot_factory(a=1.1, n=5, r=0.1)
+        sim = simulation_factory(snap)
+        lj = md.pair.LJ(nlist=md.nlist.Cell(buffer=0.4), default_r_cut=2.5)
+        lj.params[('A', 'A')] = {'sigma': 1.0, 'epsilon': 1.0}
+        sim.operations.integrator = md.Integrator(dt=0.005, forces=[lj])
+        return sim, lj
+
+    reference_sim, reference_lj = make_simulation()
+    reference_sim.always_compute_pressure = True
+    reference_sim.run(0)
+    reference_virials = reference_lj.virials
+
+    sim, lj = make_simulation()
+    sim.run(0)
+    assert lj.virials is None
+    np.testing.assert_allclose(lj.energy,
+                               reference_lj.energy,
+                               rtol=1e-6,
+                               atol=1e-6)
+
+    sim.always_compute_pressure = True
+    sim.run(0)
+    if sim.device.communicator.rank == 0:
+        np.testing.assert_allclose(lj.virials,
+                                   reference_virials,
+                                   rtol=1e-5,
+                                   atol=1e-5)
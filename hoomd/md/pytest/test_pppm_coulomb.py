@@ -163,3 +163,200 @@ def test_pppm_energy(simulation_factory, two_charged_particle_snapshot_factory):
     # The reference energy is from a LAMMPS simulation. The tolerance is large
     # as the PPPM parameters do not directly map between the two codes
     numpy.testing.assert_allclose(energy, -1.0021254, rtol=1e-2)
+
+
+def test_pppm_ad_differentiation(simulation_factory,
+                                 two_charged_particle_snapshot_factory):
+    """Test that the ad scheme agrees with the ik scheme."""
+    forces = {}
+    energies = {}
+    for differentiation in ('ik', 'ad'):
+        nlist = hoomd.md.nlist.Cell(buffer=0.4)
+        ewald, coulomb = hoomd.md.long_range.pppm.make_pppm_coulomb_forces(
+            nlist=nlist,
+            resolution=(64, 64, 64),
+            order=6,
+            r_cut=3.0,
+            alpha=0,
+            differentiation=differentiation)
+        assert coulomb.differentiation == differentiation
+
+        sim = simulation_factory(two_charged_particle_snapshot_factory())
+        if (differentiation == 'ad'
+                and isinstance(sim.device, hoomd.device.GPU)):
+            pytest.skip("differentiation='ad' is only implemented on the CPU")
+
+        integrator = hoomd.md.Integrator(dt=0.005)
+        nve = hoomd.md.methods.ConstantVolume(filter=hoomd.filter.All())
+        integrator.methods.append(nve)
+        integrator.forces.extend([ewald, coulomb])
+        sim.operations.integrator = integrator
+
+        sim.run(0)
+        assert coulomb.differentiation == differentiation
+
+        energies[differentiation] = ewald.energy + coulomb.energy
+        ewald_forces = ewald.forces
+        coulomb_forces = coulomb.forces
+        if sim.device.communicator.rank == 0:
+            forces[differentiation] = ewald_forces + coulomb_forces
+
+    numpy.testing.assert_allclose(energies['ad'], -1.0021254, rtol=1e-2)
+    if 'ad' in forces:
+        numpy.testing.assert_allclose(forces['ad'],
+                                      forces['ik'],
+                                      rtol=1e-2,
+                                      atol=1e-3)
+
+
+@pytest.mark.parametrize("slab_correction", ['dipole', 'elc'])
+def test_pppm_slab_correction(simulation_factory, device, slab_correction):
+    """Test that the slab corrections remove the image layer interactions.
+
+    The energy of a dipole in a slab with a large gap and the dipole
+    correction should match the energy computed with ELC and a small gap.
+    """
+
+    def make_snapshot(L_z):
+        snapshot = hoomd.Snapshot(device.communicator)
+        if snapshot.communicator.rank == 0:
+            snapshot.configuration.box = [12, 12, L_z, 0, 0, 0]
+            snapshot.particles.N = 2
+            snapshot.particles.types = ['A']
+            snapshot.particles.position[:] = [[0.1, 0.2, -0.6],
+                                              [-0.2, 0.1, 0.6]]
+            snapshot.particles.charge[:] = [1, -1]
+        return snapshot
+
+    def compute_energy(L_z, resolution, slab_correction):
+        nlist = hoomd.md.nlist.Cell(buffer=0.4)
+        ewald, coulomb = hoomd.md.long_range.pppm.make_pppm_coulomb_forces(
+            nlist=nlist,
+            resolution=resolution,
+            order=6,
+            r_cut=2.5,
+            alpha=0,
+            slab_correction=slab_correction)
+        assert coulomb.slab_correction == slab_correction
+
+        sim = simulation_factory(make_snapshot(L_z))
+        integrator = hoomd.md.Integrator(dt=0.005)
+        integrator.forces.extend([ewald, coulomb])
+        sim.operations.integrator = integrator
+
+        sim.run(0)
+        assert coulomb.slab_correction == slab_correction
+        return ewald.energy + coulomb.energy
+
+    reference = compute_energy(48, (32, 32, 128), 'dipole')
+    if slab_correction == 'dipole':
+        # without the correction, the images of the dipole change the energy
+        uncorrected = compute_energy(48, (32, 32, 128), 'none')
+        assert abs(uncorrected - reference) > 1e-4
+    else:
+        energy = compute_energy(8, (32, 32, 32), 'elc')
+        numpy.testing.assert_allclose(energy, reference, rtol=1e-2)
+
+
+@pytest.mark.cpu
+def test_pppm_influence_rescaling(simulation_factory,
+                                  two_charged_particle_snapshot_factory):
+    """Test that the rescaled influence function matches the exact one."""
+    energies = {}
+    for influence_tolerance in (0.0, 1e-2):
+        nlist = hoomd.md.nlist.Cell(buffer=0.4)
+        ewald, coulomb = hoomd.md.long_range.pppm.make_pppm_coulomb_forces(
+            nlist=nlist, resolution=(32, 32, 32), order=5, r_cut=3.0, alpha=0)
+        coulomb.influence_tolerance = influence_tolerance
+
+        sim = simulation_factory(two_charged_particle_snapshot_factory())
+        integrator = hoomd.md.Integrator(dt=0.005)
+        integrator.forces.extend([ewald, coulomb])
+        sim.operations.integrator = integrator
+
+        sim.run(0)
+        assert coulomb.influence_tolerance == influence_tolerance
+        assert coulomb.influence_recompute_period == 100
+
+        box = sim.state.box
+        sim.state.set_box(
+            hoomd.Box(Lx=box.Lx * 1.005, Ly=box.Ly * 1.002, Lz=box.Lz))
+        sim.run(1)
+        energies[influence_tolerance] = coulomb.energy
+
+    numpy.testing.assert_allclose(energies[1e-2], energies[0.0], rtol=1e-3)
+
+
+def test_pppm_tabulate(simulation_factory,
+                       two_charged_particle_snapshot_factory):
+    """Test that the tabulated real space term matches md.pair.Ewald."""
+    forces = {}
+    energies = {}
+    for tabulate in (False, True):
+        nlist = hoomd.md.nlist.Cell(buffer=0.4)
+        ewald, coulomb = hoomd.md.long_range.pppm.make_pppm_coulomb_forces(
+            nlist=nlist,
+            resolution=(32, 32, 32),
+            order=5,
+            r_cut=3.0,
+            alpha=0,
+            tabulate=tabulate)
+        assert isinstance(ewald, hoomd.md.pair.EwaldTable) == tabulate
+
+        sim = simulation_factory(two_charged_particle_snapshot_factory(d=0.9))
+        integrator = hoomd.md.Integrator(dt=0.005)
+        integrator.forces.extend([ewald, coulomb])
+        sim.operations.integrator = integrator
+
+        sim.run(0)
+        energies[tabulate] = ewald.energy
+        ewald_forces = ewald.forces
+        if sim.device.communicator.rank == 0:
+            forces[tabulate] = ewald_forces
+
+    numpy.testing.assert_allclose(energies[True], energies[False], rtol=1e-5)
+    if True in forces:
+        numpy.testing.assert_allclose(forces[True], forces[False], rtol=1e-5)
+
+
+@pytest.mark.cpu
+def test_pppm_exclusion_correction(simulation_factory,
+                                   two_charged_particle_snapshot_factory):
+    """Test that the exclusion correction in the pair loop matches Coulomb."""
+    snapshot = two_charged_particle_snapshot_factory(d=0.9)
+    if snapshot.communicator.rank == 0:
+        snapshot.bonds.types = ['A-A']
+        snapshot.bonds.N = 1
+        snapshot.bonds.group[0] = [0, 1]
+
+    energies = {}
+    forces = {}
+    for exclusion_correction in (False, True):
+        nlist = hoomd.md.nlist.Cell(buffer=0.4, exclusions=('bond',))
+        ewald, coulomb = hoomd.md.long_range.pppm.make_pppm_coulomb_forces(
+            nlist=nlist,
+            resolution=(32, 32, 32),
+            order=5,
+            r_cut=3.0,
+            alpha=0,
+            exclusion_correction=exclusion_correction)
+
+        sim = simulation_factory(snapshot)
+        integrator = hoomd.md.Integrator(dt=0.005)
+        integrator.forces.extend([ewald, coulomb])
+        sim.operations.integrator = integrator
+
+        sim.run(0)
+        assert ewald.exclusion_correction == exclusion_correction
+        energies[exclusion_correction] = ewald.energy + coulomb.energy
+        ewald_forces = ewald.forces
+        coulomb_forces = coulomb.forces
+        if sim.device.communicator.rank == 0:
+            forces[exclusion_correction] = ewald_forces + coulomb_forces
+
+    numpy.testing.assert_allclose(energies[True], energies[False], rtol=1e-6)
+    if True in forces:
+        numpy.testing.assert_allclose(forces[True],
+                                      forces[False],
+                                      rtol=1e-6,
+                                      atol=1e-8)
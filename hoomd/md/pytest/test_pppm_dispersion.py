@@ -0,0 +1,145 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+import hoomd
+import itertools
+import math
+import pytest
+import numpy
+
+
+def _lj_lattice_sum(d, L, epsilon=1.0, sigma=1.0, n_images=3):
+    """Energy and force on particle 1 of two LJ particles in a periodic box."""
+
+    def u(r):
+        return 4 * epsilon * ((sigma / r)**12 - (sigma / r)**6)
+
+    def f_divr(r):
+        return 24 * epsilon * (2 * (sigma / r)**12 - (sigma / r)**6) / r**2
+
+    energy = 0.0
+    force = 0.0
+    for n in itertools.product(range(-n_images, n_images + 1), repeat=3):
+        if n != (0, 0, 0):
+            # interaction of each particle with its own images
+            energy += u(L * math.sqrt(n[0]**2 + n[1]**2 + n[2]**2))
+
+        dx = d + n[0] * L
+        r = math.sqrt(dx**2 + (n[1] * L)**2 + (n[2] * L)**2)
+        energy += u(r)
+        force += dx * f_divr(r)
+
+    return energy, force
+
+
+def _make_simulation(simulation_factory, snapshot, forces):
+    sim = simulation_factory(snapshot)
+    integrator = hoomd.md.Integrator(dt=0.005)
+    integrator.forces.extend(forces)
+    sim.operations.integrator = integrator
+    return sim
+
+
+def test_attach_detach(simulation_factory, two_particle_snapshot_factory):
+    """Ensure that md.long_range.pppm.Dispersion can be attached."""
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    lj, dispersion = hoomd.md.long_range.pppm.make_pppm_dispersion_forces(
+        nlist=nlist, resolution=(32, 32, 32), order=6, r_cut=3.0)
+    lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+
+    assert lj.nlist is nlist
+    assert dispersion.nlist is nlist
+    assert dispersion.resolution == (32, 32, 32)
+    assert dispersion.order == 6
+    assert dispersion.r_cut == 3.0
+    assert dispersion.tolerance == 1e-3
+
+    sim = _make_simulation(simulation_factory,
+                           two_particle_snapshot_factory(d=1.2, L=10),
+                           [lj, dispersion])
+
+    if isinstance(sim.device, hoomd.device.GPU):
+        with pytest.raises(RuntimeError):
+            sim.run(0)
+        return
+
+    sim.run(0)
+    assert lj._attached
+    assert dispersion._attached
+    assert dispersion._cpp_obj.dispersion
+    assert lj.params[('A', 'A')]['c6_mesh'] == pytest.approx(4.0)
+    assert lj.params[('A', 'A')]['kappa'] > 0
+
+    with pytest.raises(AttributeError):
+        dispersion.resolution = (16, 16, 16)
+
+
+def test_pppm_dispersion_energy(simulation_factory,
+                                two_particle_snapshot_factory):
+    """Test that the PPPM dispersion forces match the untruncated LJ sum."""
+    d = 1.2
+    L = 10
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    lj, dispersion = hoomd.md.long_range.pppm.make_pppm_dispersion_forces(
+        nlist=nlist,
+        resolution=(32, 32, 32),
+        order=6,
+        r_cut=3.0,
+        tolerance=1e-4)
+    lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+
+    sim = _make_simulation(simulation_factory,
+                           two_particle_snapshot_factory(d=d, L=L),
+                           [lj, dispersion])
+    if isinstance(sim.device, hoomd.device.GPU):
+        pytest.skip("Dispersion PPPM is only implemented on the CPU")
+
+    sim.run(0)
+
+    energy_ref, force_ref = _lj_lattice_sum(d, L)
+    numpy.testing.assert_allclose(lj.energy + dispersion.energy,
+                                  energy_ref,
+                                  rtol=1e-2)
+
+    lj_forces = lj.forces
+    dispersion_forces = dispersion.forces
+    if sim.device.communicator.rank == 0:
+        forces = lj_forces + dispersion_forces
+        numpy.testing.assert_allclose(forces,
+                                      [[-force_ref, 0, 0], [force_ref, 0, 0]],
+                                      rtol=1e-2,
+                                      atol=1e-3)
+
+
+def test_pppm_dispersion_exclusions(simulation_factory,
+                                    two_particle_snapshot_factory):
+    """Test that excluded pairs do not interact through the mesh."""
+    snapshot = two_particle_snapshot_factory(d=1.2, L=10)
+    if snapshot.communicator.rank == 0:
+        snapshot.bonds.types = ['A-A']
+        snapshot.bonds.N = 1
+        snapshot.bonds.group[0] = [0, 1]
+
+    energies = {}
+    for exclusion_correction in (False, True):
+        nlist = hoomd.md.nlist.Cell(buffer=0.4, exclusions=('bond',))
+        lj, dispersion = hoomd.md.long_range.pppm.make_pppm_dispersion_forces(
+            nlist=nlist,
+            resolution=(32, 32, 32),
+            order=6,
+            r_cut=3.0,
+            tolerance=1e-4,
+            exclusion_correction=exclusion_correction)
+        lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+
+        sim = _make_simulation(simulation_factory, snapshot, [lj, dispersion])
+        if isinstance(sim.device, hoomd.device.GPU):
+            pytest.skip("Dispersion PPPM is only implemented on the CPU")
+
+        sim.run(0)
+        energies[exclusion_correction] = lj.energy + dispersion.energy
+
+    # only the interactions with the periodic images remain
+    energy_ref = _lj_lattice_sum(1.2, 10)[0] - 4 * (1.2**-12 - 1.2**-6)
+    numpy.testing.assert_allclose(energies[True], energies[False], rtol=1e-6)
+    numpy.testing.assert_allclose(energies[False], energy_ref, atol=5e-3)
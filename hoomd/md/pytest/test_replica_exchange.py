@@ -0,0 +1,87 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+import hoomd
+import pytest
+
+
+def _lj_simulation(sim, replica_exchange):
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    langevin = hoomd.md.methods.Langevin(filter=hoomd.filter.All(),
+                                         kT=replica_exchange.kT)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005,
+                                                    methods=[langevin],
+                                                    forces=[lj])
+    sim.operations.updaters.append(replica_exchange)
+    return sim
+
+
+def test_attributes():
+    replica_exchange = hoomd.md.update.ReplicaExchange(
+        trigger=hoomd.trigger.Periodic(10), kT=[1.0, 2])
+    assert replica_exchange.kT_ladder == (1.0, 2.0)
+    assert isinstance(replica_exchange.kT, hoomd.variant.Constant)
+    assert replica_exchange.trigger == hoomd.trigger.Periodic(10)
+
+    with pytest.raises(ValueError):
+        hoomd.md.update.ReplicaExchange(trigger=10, kT=[])
+
+
+def test_single_partition(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory(n=6, a=1.5))
+    replica_exchange = hoomd.md.update.ReplicaExchange(trigger=5, kT=[1.5])
+    _lj_simulation(sim, replica_exchange)
+    sim.run(20)
+
+    assert replica_exchange.kT.value == 1.5
+    assert replica_exchange.ladder_index == 0
+    assert replica_exchange.num_attempted == []
+    assert replica_exchange.acceptance_ratio == []
+
+
+def test_wrong_ladder_size(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory(n=6, a=1.5))
+    replica_exchange = hoomd.md.update.ReplicaExchange(trigger=5,
+                                                       kT=[1.0, 1.5, 2.0])
+    _lj_simulation(sim, replica_exchange)
+
+    with pytest.raises(RuntimeError):
+        sim.run(0)
+
+
+@pytest.mark.skipif(not hoomd.version.mpi_enabled,
+                    reason='This test requires MPI')
+def test_exchange(lattice_snapshot_factory):
+    world_communicator = hoomd.communicator.Communicator()
+    if world_communicator.num_ranks != 2:
+        pytest.skip("This test requires 2 ranks")
+
+    communicator = hoomd.communicator.Communicator(ranks_per_partition=1)
+    device = hoomd.device.CPU(communicator=communicator)
+    sim = hoomd.Simulation(device=device, seed=1)
+    snapshot = hoomd.Snapshot(communicator)
+    if communicator.rank == 0:
+        reference = lattice_snapshot_factory(n=6, a=1.5)
+        snapshot.configuration.box = reference.configuration.box
+        snapshot.particles.N = reference.particles.N
+        snapshot.particles.types = reference.particles.types
+        snapshot.particles.position[:] = reference.particles.position
+    sim.create_state_from_snapshot(snapshot)
+
+    kT = [1.0, 1.1]
+    replica_exchange = hoomd.md.update.ReplicaExchange(trigger=10, kT=kT)
+    _lj_simulation(sim, replica_exchange)
+    sim.run(0)
+    assert replica_exchange.kT.value == kT[communicator.partition]
+
+    sim.run(200)
+    assert replica_exchange.num_attempted == [10]
+    assert 0 <= replica_exchange.num_accepted[0] <= 10
+    assert replica_exchange.kT.value == kT[replica_exchange.ladder_index]
+
+    # the two replicas hold different ladder positions
+    indices = replica_exchange._cpp_obj.ladder_indices
+    assert sorted(indices) == [0, 1]
+    assert indices[communicator.partition] == replica_exchange.ladder_index
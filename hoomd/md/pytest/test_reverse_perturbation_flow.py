@@ -98,3 +98,32 @@ def test_logging():
                 'default': True
             }
         })
+
+
+def test_momentum_conservation(simulation_factory, lattice_snapshot_factory):
+    snapshot = lattice_snapshot_factory(n=6, a=2.0)
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.mass[:] = 2.0
+    sim = simulation_factory(snapshot)
+    sim.state.thermalize_particle_momenta(hoomd.filter.All(), kT=1.0)
+
+    # the target requires several swaps in one update
+    mpf = hoomd.md.update.ReversePerturbationFlow(hoomd.filter.All(),
+                                                  hoomd.variant.Constant(0.05),
+                                                  'z',
+                                                  'x',
+                                                  n_slabs=6)
+    sim.operations.add(mpf)
+    snapshot = sim.state.get_snapshot()
+    if snapshot.communicator.rank == 0:
+        momentum = (snapshot.particles.mass
+                    * snapshot.particles.velocity[:, 0]).sum()
+
+    sim.run(1)
+
+    assert mpf.summed_exchanged_momentum > 0
+    snapshot = sim.state.get_snapshot()
+    if snapshot.communicator.rank == 0:
+        new_momentum = (snapshot.particles.mass
+                        * snapshot.particles.velocity[:, 0]).sum()
+        assert new_momentum == pytest.approx(momentum, abs=1e-5)
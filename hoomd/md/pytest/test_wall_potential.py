@@ -262,6 +262,41 @@ def test_r_extrap(simulation, cls, params):
         assert np.all(np.any(forces != 0, axis=1))
 
 
+def test_many_walls(simulation_factory, lattice_snapshot_factory):
+    """Test the energy of many walls, most of which are out of range."""
+    sim = simulation_factory(lattice_snapshot_factory(n=10, a=1.0, r=0.1))
+    r_cut = 2.0
+    walls = []
+    for i in range(10):
+        walls.append(
+            hoomd.wall.Plane(origin=(i - 4.75, 0, 0), normal=(1, 0, 0)))
+        walls.append(
+            hoomd.wall.Plane(origin=(0, i - 4.25, 0), normal=(0, -1, 0)))
+    walls.append(hoomd.wall.Sphere(radius=3.1, origin=(0, 0, 0)))
+    walls.append(
+        hoomd.wall.Cylinder(radius=1.6, origin=(0, 0, 0), axis=(0, 0, 1)))
+    wall_pot = md.external.wall.Gaussian(walls)
+    wall_pot.params["A"] = {"epsilon": 1.0, "sigma": 1.0, "r_cut": r_cut}
+    sim.operations.integrator = md.Integrator(0.005, forces=[wall_pot])
+    sim.run(0)
+
+    snap = sim.state.get_snapshot()
+    energies = wall_pot.energies
+    if sim.device.communicator.rank == 0:
+        pos = snap.particles.position
+        distances = []
+        for i in range(10):
+            distances.append(pos[:, 0] - (i - 4.75))
+            distances.append((i - 4.25) - pos[:, 1])
+        distances.append(3.1 - np.linalg.norm(pos, axis=1))
+        distances.append(1.6 - np.linalg.norm(pos[:, :2], axis=1))
+        d = np.stack(distances)
+        in_range = np.logical_and(d >= 0, d < r_cut)
+        u = np.exp(-d**2 / 2) - np.exp(-r_cut**2 / 2)
+        expected = np.sum(np.where(in_range, u, 0), axis=0)
+        np.testing.assert_allclose(energies, expected, rtol=1e-5, atol=1e-6)
+
+
 # Test Logging
 @pytest.mark.parametrize(
     'cls, expected_namespace, expected_loggables',
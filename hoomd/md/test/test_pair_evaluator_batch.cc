@@ -0,0 +1,259 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "hoomd/md/EvaluatorPairEwald.h"
+#include "hoomd/md/EvaluatorPairGauss.h"
+#include "hoomd/md/EvaluatorPairLJ.h"
+#include "hoomd/md/EvaluatorPairMorse.h"
+#include "hoomd/md/EvaluatorPairTable.h"
+#include "hoomd/md/EvaluatorPairYukawa.h"
+#include "hoomd/md/PairEvaluatorBatch.h"
+
+using namespace std;
+using namespace hoomd;
+using namespace hoomd::md;
+
+/*! \file test_pair_evaluator_batch.cc
+    \brief Compares the batched pair evaluators to the scalar evaluators lane by lane
+    \ingroup unit_tests
+*/
+
+#include "hoomd/test/upp11_config.h"
+HOOMD_UP_MAIN();
+
+//! Energy shift modes of PotentialPair
+enum class ShiftMode
+    {
+    no_shift,
+    shift,
+    xplor
+    };
+
+//! Check a lane of the batch against the scalar result
+/*! \param batch_value Value of the batched evaluation
+    \param scalar_value Value of the scalar evaluation
+    \param tolerance Relative tolerance, and absolute tolerance for values near zero
+*/
+void check_lane(Scalar batch_value, Scalar scalar_value, Scalar tolerance)
+    {
+    if (std::abs(scalar_value) < tolerance)
+        {
+        MY_CHECK_SMALL(batch_value, tolerance);
+        }
+    else
+        {
+        MY_CHECK_CLOSE(batch_value, scalar_value, tolerance);
+        }
+    }
+
+//! Compare evalForceAndEnergyBatch() to evalForceAndEnergy() for every lane
+/*! \param params Parameters of the type pairs, the lanes cycle through them
+    \param mode Energy shift mode
+    \param rcut Cutoff radius of all pairs
+    \param tolerance Relative tolerance of the comparison
+
+    The batches are packed the same way PotentialPair packs them: the energy_shift flag of each
+    lane follows the shift mode, and the lanes after the last pair of a partial batch are filled
+    with rsq = 1 and rcutsq = 0. The xplor smoothing is applied by PotentialPair after the
+    evaluation, so for the evaluators xplor differs from no_shift only in the type pairs with
+    r_on > r_cut, which shift the energy. The first type pair uses r_on < r_cut and the others
+    r_on > r_cut.
+
+    Every batch size from 1 to width is tested. The distances include pairs below the minimum
+    radius of the tables, pairs at the cutoff, and pairs beyond the cutoff.
+*/
+template<class evaluator, class Real>
+void check_batch(const std::vector<typename evaluator::param_type>& params,
+                 ShiftMode mode,
+                 Scalar rcut,
+                 Scalar tolerance)
+    {
+    typedef hoomd::md::detail::PairEvaluatorBatch<typename evaluator::param_type, Real> batch_type;
+    constexpr unsigned int width = batch_type::width;
+    static_assert(hoomd::md::detail::HasBatchEvaluation<evaluator>::value,
+                  "The evaluator does not implement evalForceAndEnergyBatch()");
+
+    const std::vector<Scalar> distances = {Scalar(0.6),
+                                           Scalar(0.85),
+                                           Scalar(0.95),
+                                           Scalar(1.0),
+                                           Scalar(1.12),
+                                           rcut,
+                                           Scalar(1.3),
+                                           Scalar(1.6),
+                                           rcut * Scalar(1.1),
+                                           Scalar(2.0),
+                                           Scalar(2.4),
+                                           rcut * Scalar(1.5)};
+    const Scalar rcutsq = rcut * rcut;
+
+    unsigned int pair = 0;
+    for (unsigned int n_lanes = 1; n_lanes <= width; n_lanes++)
+        {
+        batch_type batch;
+        batch.params = params.data();
+
+        for (unsigned int lane = 0; lane < n_lanes; lane++, pair++)
+            {
+            const Scalar r = distances[pair % distances.size()];
+            const unsigned int param_idx = pair % static_cast<unsigned int>(params.size());
+            const Scalar ron = param_idx == 0 ? Scalar(0.8) * rcut : Scalar(1.2) * rcut;
+
+            batch.rsq[lane] = Real(r * r);
+            batch.rcutsq[lane] = Real(rcutsq);
+            batch.qiqj[lane] = Real(0.7) * Real(int(pair % 3) - 1);
+            batch.energy_shift[lane]
+                = mode == ShiftMode::shift || (mode == ShiftMode::xplor && ron > rcut) ? Real(1.0)
+                                                                                        : Real(0.0);
+            batch.param_idx[lane] = param_idx;
+            }
+
+        for (unsigned int lane = n_lanes; lane < width; lane++)
+            {
+            batch.rsq[lane] = Real(1.0);
+            batch.rcutsq[lane] = Real(0.0);
+            batch.qiqj[lane] = Real(0.0);
+            batch.energy_shift[lane] = Real(0.0);
+            batch.param_idx[lane] = 0;
+            }
+
+        // the evaluator must write every lane
+        for (unsigned int lane = 0; lane < width; lane++)
+            {
+            batch.force_divr[lane] = Real(-1.0);
+            batch.pair_eng[lane] = Real(-1.0);
+            }
+
+        evaluator::evalForceAndEnergyBatch(batch);
+
+        for (unsigned int lane = 0; lane < n_lanes; lane++)
+            {
+            evaluator eval(Scalar(batch.rsq[lane]),
+                           Scalar(batch.rcutsq[lane]),
+                           params[batch.param_idx[lane]]);
+            if (evaluator::needsCharge())
+                eval.setCharge(Scalar(batch.qiqj[lane]), Scalar(1.0));
+
+            Scalar force_divr = Scalar(0.0);
+            Scalar pair_eng = Scalar(0.0);
+            bool evaluated
+                = eval.evalForceAndEnergy(force_divr, pair_eng, batch.energy_shift[lane] != 0);
+
+            if (evaluated)
+                {
+                check_lane(Scalar(batch.force_divr[lane]), force_divr, tolerance);
+                check_lane(Scalar(batch.pair_eng[lane]), pair_eng, tolerance);
+                }
+            else
+                {
+                // PotentialPair skips the lanes that the scalar evaluator does not evaluate
+                MY_CHECK_SMALL(Scalar(batch.force_divr[lane]), tolerance);
+                MY_CHECK_SMALL(Scalar(batch.pair_eng[lane]), tolerance);
+                }
+
+            if (batch.rsq[lane] >= batch.rcutsq[lane])
+                {
+                UP_ASSERT(batch.force_divr[lane] == Real(0.0));
+                UP_ASSERT(batch.pair_eng[lane] == Real(0.0));
+                }
+            }
+
+        // the filler lanes must contribute exactly zero
+        for (unsigned int lane = n_lanes; lane < width; lane++)
+            {
+            UP_ASSERT(batch.force_divr[lane] == Real(0.0));
+            UP_ASSERT(batch.pair_eng[lane] == Real(0.0));
+            }
+        }
+    }
+
+//! Run check_batch() for all shift modes in full and in mixed precision
+template<class evaluator>
+void check_batch_all_modes(const std::vector<typename evaluator::param_type>& params,
+                           Scalar rcut)
+    {
+    for (ShiftMode mode : {ShiftMode::no_shift, ShiftMode::shift, ShiftMode::xplor})
+        {
+        check_batch<evaluator, Scalar>(params, mode, rcut, Scalar(1e-5));
+        check_batch<evaluator, float>(params, mode, rcut, tol_small);
+        }
+    }
+
+//! LJ batch evaluation matches the scalar evaluation
+UP_TEST(pair_batch_lj)
+    {
+    std::vector<EvaluatorPairLJ::param_type> params;
+    params.push_back(EvaluatorPairLJ::param_type(Scalar(1.0), Scalar(1.0)));
+    params.push_back(EvaluatorPairLJ::param_type(Scalar(0.9), Scalar(1.5)));
+    check_batch_all_modes<EvaluatorPairLJ>(params, Scalar(2.5));
+    }
+
+//! Yukawa batch evaluation matches the scalar evaluation
+UP_TEST(pair_batch_yukawa)
+    {
+    std::vector<EvaluatorPairYukawa::param_type> params;
+    params.push_back(EvaluatorPairYukawa::param_type(Scalar(1.0), Scalar(0.5)));
+    params.push_back(EvaluatorPairYukawa::param_type(Scalar(2.0), Scalar(1.5)));
+    check_batch_all_modes<EvaluatorPairYukawa>(params, Scalar(2.5));
+    }
+
+//! Morse batch evaluation matches the scalar evaluation
+UP_TEST(pair_batch_morse)
+    {
+    std::vector<EvaluatorPairMorse::param_type> params;
+    params.push_back(EvaluatorPairMorse::param_type(Scalar(1.0), Scalar(3.0), Scalar(1.1)));
+    params.push_back(EvaluatorPairMorse::param_type(Scalar(0.5), Scalar(2.0), Scalar(1.3)));
+    check_batch_all_modes<EvaluatorPairMorse>(params, Scalar(2.5));
+    }
+
+//! Gauss batch evaluation matches the scalar evaluation
+UP_TEST(pair_batch_gauss)
+    {
+    std::vector<EvaluatorPairGauss::param_type> params;
+    params.push_back(EvaluatorPairGauss::param_type(Scalar(1.0), Scalar(0.5)));
+    params.push_back(EvaluatorPairGauss::param_type(Scalar(2.0), Scalar(1.0)));
+    check_batch_all_modes<EvaluatorPairGauss>(params, Scalar(2.5));
+    }
+
+//! Ewald batch evaluation matches the scalar evaluation
+UP_TEST(pair_batch_ewald)
+    {
+    std::vector<EvaluatorPairEwald::param_type> params(2);
+    params[0].kappa = Scalar(1.0);
+    params[0].alpha = Scalar(0.0);
+    params[1].kappa = Scalar(1.5);
+    params[1].alpha = Scalar(0.5);
+    check_batch_all_modes<EvaluatorPairEwald>(params, Scalar(2.5));
+    }
+
+//! Table batch evaluation matches the scalar evaluation
+/*! The tables start at r_min = 0.8, so the pairs at r = 0.6 are below r_min.
+ */
+UP_TEST(pair_batch_table)
+    {
+    const unsigned int table_width = 20;
+    const Scalar rmin = Scalar(0.8);
+    const Scalar rcut = Scalar(2.5);
+
+    std::vector<EvaluatorPairTable::param_type> params(2);
+    for (unsigned int i = 0; i < params.size(); i++)
+        {
+        params[i].rmin = rmin;
+        params[i].V_table = ManagedArray<Scalar>(table_width, false);
+        params[i].F_table = ManagedArray<Scalar>(table_width, false);
+        for (unsigned int j = 0; j < table_width; j++)
+            {
+            const Scalar r = rmin + (rcut - rmin) / Scalar(table_width) * Scalar(j);
+            params[i].V_table[j] = Scalar(i + 1) * (rcut - r) * (rcut - r);
+            params[i].F_table[j] = Scalar(2.0 * (i + 1)) * (rcut - r);
+            }
+        }
+    check_batch_all_modes<EvaluatorPairTable>(params, rcut);
+    }
@@ -0,0 +1,204 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <memory>
+
+#include "hoomd/md/NeighborListTree.h"
+#include "hoomd/md/PluginForceCompute.h"
+
+using namespace std;
+using namespace hoomd;
+using namespace hoomd::md;
+
+/*! \file test_plugin_force.cc
+    \brief Implements unit tests for PluginForceCompute
+    \ingroup unit_tests
+*/
+
+#include "hoomd/test/upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+//! Plugin that applies the same force to every particle
+class ConstantPlugin : public ForcePlugin
+    {
+    public:
+    void compute(const ForcePluginArgs& args)
+        {
+        n_calls++;
+        for (unsigned int i = 0; i < args.N; i++)
+            {
+            args.force[i] = make_scalar4(1.0, 2.0, 3.0, 0.5);
+            }
+        }
+
+    unsigned int n_calls = 0;
+    };
+
+//! Plugin that computes the harmonic repulsion U = k/2 (r_cut - r)^2 with the neighbor list
+class HarmonicPlugin : public ForcePlugin
+    {
+    public:
+    void compute(const ForcePluginArgs& args)
+        {
+        full_nlist = args.full_nlist;
+        for (unsigned int i = 0; i < args.N; i++)
+            {
+            Scalar3 pi = make_scalar3(args.pos[i].x, args.pos[i].y, args.pos[i].z);
+            for (unsigned int k = 0; k < args.n_neigh[i]; k++)
+                {
+                unsigned int j = args.nlist[args.head_list[i] + k];
+                Scalar3 dx = pi - make_scalar3(args.pos[j].x, args.pos[j].y, args.pos[j].z);
+                dx = args.box.minImage(dx);
+                Scalar r = sqrt(dot(dx, dx));
+                if (r >= r_cut)
+                    continue;
+
+                Scalar f = k_spring * (r_cut - r) / r;
+                args.force[i].x += f * dx.x;
+                args.force[i].y += f * dx.y;
+                args.force[i].z += f * dx.z;
+                args.force[i].w += Scalar(0.25) * k_spring * (r_cut - r) * (r_cut - r);
+                if (args.virial)
+                    {
+                    args.virial[0 * args.virial_pitch + i] += Scalar(0.5) * f * dx.x * dx.x;
+                    }
+                }
+            }
+        }
+
+    Scalar getRCut() const
+        {
+        return r_cut;
+        }
+
+    Scalar r_cut = 1.0;
+    Scalar k_spring = 2.0;
+    bool full_nlist = false;
+    };
+
+//! Test that the plugin writes the forces of all particles
+void plugin_force_constant_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SystemDefinition> sysdef(
+        new SystemDefinition(3, BoxDim(5.0), 1, 0, 0, 0, 0, exec_conf));
+
+    auto plugin = std::make_shared<ConstantPlugin>();
+    auto force = std::make_shared<PluginForceCompute>(sysdef,
+                                                      plugin,
+                                                      std::shared_ptr<NeighborList>());
+    force->compute(0);
+    UP_ASSERT_EQUAL(plugin->n_calls, 1u);
+
+    ArrayHandle<Scalar4> h_force(force->getForceArray(), access_location::host, access_mode::read);
+    for (unsigned int i = 0; i < 3; i++)
+        {
+        MY_CHECK_CLOSE(h_force.data[i].x, 1.0, tol);
+        MY_CHECK_CLOSE(h_force.data[i].y, 2.0, tol);
+        MY_CHECK_CLOSE(h_force.data[i].z, 3.0, tol);
+        MY_CHECK_CLOSE(h_force.data[i].w, 0.5, tol);
+        }
+    }
+
+//! Test that the plugin receives the neighbor list with the plugin's cutoff
+void plugin_force_nlist_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // particles 0 and 1 interact, particle 2 is beyond the cutoff
+    std::shared_ptr<SystemDefinition> sysdef(
+        new SystemDefinition(3, BoxDim(10.0), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+    pdata->setPosition(0, make_scalar3(0.0, 0.0, 0.0));
+    pdata->setPosition(1, make_scalar3(0.5, 0.0, 0.0));
+    pdata->setPosition(2, make_scalar3(3.0, 0.0, 0.0));
+
+    std::shared_ptr<NeighborListTree> nlist(new NeighborListTree(sysdef, Scalar(0.3)));
+    auto plugin = std::make_shared<HarmonicPlugin>();
+    auto force = std::make_shared<PluginForceCompute>(sysdef, plugin, nlist);
+
+    // the plugin requests a full neighbor list by default
+    UP_ASSERT(nlist->getStorageMode() == NeighborList::full);
+
+    force->compute(0);
+    UP_ASSERT(plugin->full_nlist);
+
+        {
+        ArrayHandle<Scalar4> h_force(force->getForceArray(),
+                                     access_location::host,
+                                     access_mode::read);
+        ArrayHandle<Scalar> h_virial(force->getVirialArray(),
+                                     access_location::host,
+                                     access_mode::read);
+        size_t pitch = force->getVirialArray().getPitch();
+
+        MY_CHECK_CLOSE(h_force.data[0].x, -1.0, tol);
+        MY_CHECK_SMALL(h_force.data[0].y, tol_small);
+        MY_CHECK_CLOSE(h_force.data[0].w, 0.125, tol);
+        MY_CHECK_CLOSE(h_virial.data[0 * pitch + 0], 0.25, tol);
+
+        MY_CHECK_CLOSE(h_force.data[1].x, 1.0, tol);
+        MY_CHECK_CLOSE(h_force.data[1].w, 0.125, tol);
+
+        MY_CHECK_SMALL(h_force.data[2].x, tol_small);
+        MY_CHECK_SMALL(h_force.data[2].w, tol_small);
+        }
+
+    // with a larger cutoff, particle 2 interacts with particle 1
+    plugin->r_cut = 3.0;
+    force->compute(1);
+
+        {
+        ArrayHandle<Scalar4> h_force(force->getForceArray(),
+                                     access_location::host,
+                                     access_mode::read);
+        MY_CHECK_CLOSE(h_force.data[2].x, 1.0, tol);
+        }
+    }
+
+//! Test that plugins with a cutoff require a neighbor list
+void plugin_force_requires_nlist_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SystemDefinition> sysdef(
+        new SystemDefinition(3, BoxDim(5.0), 1, 0, 0, 0, 0, exec_conf));
+
+    UP_ASSERT_EXCEPTION(std::runtime_error,
+                        [&]
+                        {
+                            PluginForceCompute force(sysdef,
+                                                     std::make_shared<HarmonicPlugin>(),
+                                                     std::shared_ptr<NeighborList>());
+                        });
+    }
+
+//! test case for a plugin without a neighbor list
+UP_TEST(PluginForceCompute_constant)
+    {
+    plugin_force_constant_test(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for a plugin with a neighbor list
+UP_TEST(PluginForceCompute_nlist)
+    {
+    plugin_force_nlist_test(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for the neighbor list check
+UP_TEST(PluginForceCompute_requires_nlist)
+    {
+    plugin_force_requires_nlist_test(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+#ifdef ENABLE_HIP
+//! test case for a host plugin on the GPU
+UP_TEST(PluginForceCompute_nlist_GPU)
+    {
+    plugin_force_nlist_test(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+#endif
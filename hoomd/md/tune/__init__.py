@@ -3,4 +3,4 @@
 
 """Tuners for the MD subpackage."""
 
-from .nlist_buffer import NeighborListBuffer
+from .nlist_buffer import NeighborListBuffer, NeighborListBufferOnline
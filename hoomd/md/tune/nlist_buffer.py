@@ -14,7 +14,10 @@ from hoomd.data.typeconverter import OnlyTypes, SetOnce
 import hoomd.logging
 import hoomd.tune
 import hoomd.trigger
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.md import _md
 from hoomd.md.nlist import NeighborList
+from hoomd.operation import Tuner
 
 
 class _IntervalTPS:
@@ -233,6 +236,10 @@ class NeighborListBuffer(hoomd.tune.custom_tuner._InternalCustomTuner):
         `NeighborListBuffer.with_grid` generally performs better than
         `NeighborListBuffer.with_gradient_descent` due to the stocastic nature
         of TPS.
+
+    See Also:
+        `NeighborListBufferOnline` keeps tuning the buffer during production
+        runs.
     """
 
     _internal_class = _NeighborListBufferInternal
@@ -338,3 +345,108 @@ class NeighborListBuffer(hoomd.tune.custom_tuner._InternalCustomTuner):
             hoomd.tune.GridOptimizer(n_bins, n_rounds, True),
             maximum_buffer=maximum_buffer,
         )
+
+
+class NeighborListBufferOnline(Tuner):
+    """Continuously tune the neighbor list buffer and rebuild check delay.
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps that end a
+            measurement interval.
+        nlist (hoomd.md.nlist.NeighborList): Neighbor list instance to tune.
+        maximum_buffer (float): The largest buffer value to allow
+            :math:`[\\mathrm{length}]`.
+        minimum_buffer (float): The smallest buffer value to allow
+            :math:`[\\mathrm{length}]`.
+        min_step_fraction (float): The smallest change of the buffer, as a
+            fraction of the range from ``minimum_buffer`` to
+            ``maximum_buffer``.
+        tune_check_delay (bool): When `True`, also set
+            `nlist.rebuild_check_delay <hoomd.md.nlist.NeighborList>`.
+
+    Unlike `NeighborListBuffer`, `NeighborListBufferOnline` never finishes
+    tuning. On each triggered step, it measures the wall clock time per step
+    since the last triggered step (which includes the neighbor list builds and
+    the pair force evaluations) and moves the buffer in the direction that
+    reduced the time per step. The buffer change grows while the
+    time per step decreases and shrinks, down to ``min_step_fraction``, each
+    time the direction reverses. Because it continues to search, the tuner
+    follows the optimal buffer as the system changes, for example during
+    compression with a `hoomd.md.methods.ConstantPressure` integration method.
+
+    When ``tune_check_delay`` is `True`, the tuner sets
+    ``nlist.rebuild_check_delay`` to a quarter of the mean number of steps
+    between neighbor list builds in the last interval, and halves it after any
+    dangerous build.
+
+    `NeighborListBufferOnline` ignores the first interval of each
+    `Simulation.run` as it includes the time spent between runs.
+
+    Tip:
+        Choose a trigger period that spans many neighbor list builds (1000 steps
+        or more) to reduce the noise in the time per step measurements. Each
+        buffer change forces a neighbor list build.
+
+    Example::
+
+        tuner = hoomd.md.tune.NeighborListBufferOnline(
+            trigger=hoomd.trigger.Periodic(2000),
+            nlist=nlist,
+            maximum_buffer=1.0)
+        simulation.operations.tuners.append(tuner)
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps that end a
+            measurement interval.
+        nlist (hoomd.md.nlist.NeighborList): Neighbor list instance to tune.
+        maximum_buffer (float): The largest buffer value to allow
+            :math:`[\\mathrm{length}]`.
+        minimum_buffer (float): The smallest buffer value to allow
+            :math:`[\\mathrm{length}]`.
+        min_step_fraction (float): The smallest change of the buffer, as a
+            fraction of the range from ``minimum_buffer`` to
+            ``maximum_buffer``.
+        tune_check_delay (bool): When `True`, also set
+            ``nlist.rebuild_check_delay``.
+    """
+
+    def __init__(self,
+                 trigger,
+                 nlist,
+                 maximum_buffer,
+                 minimum_buffer=0.0,
+                 min_step_fraction=0.02,
+                 tune_check_delay=True):
+        super().__init__(trigger)
+        params = ParameterDict(nlist=SetOnce(NeighborList),
+                               maximum_buffer=float,
+                               minimum_buffer=float,
+                               min_step_fraction=float,
+                               tune_check_delay=bool)
+        params.update(
+            dict(nlist=nlist,
+                 maximum_buffer=maximum_buffer,
+                 minimum_buffer=minimum_buffer,
+                 min_step_fraction=min_step_fraction,
+                 tune_check_delay=tune_check_delay))
+        self._param_dict.update(params)
+
+    def _attach_hook(self):
+        self.nlist._attach(self._simulation)
+        self._cpp_obj = _md.NeighborListBufferTuner(
+            self._simulation.state._cpp_sys_def, self.trigger,
+            self.nlist._cpp_obj, self.minimum_buffer, self.maximum_buffer)
+
+    def _detach_hook(self):
+        self.nlist._detach()
+
+    @hoomd.logging.log(requires_run=True)
+    def time_per_step(self):
+        """float: Wall clock time per step in the last interval (in seconds)."""
+        return self._cpp_obj.time_per_step
+
+    @hoomd.logging.log(requires_run=True)
+    def build_fraction(self):
+        """float: Fraction of the last interval spent building the neighbor \
+        list."""
+        return self._cpp_obj.build_fraction
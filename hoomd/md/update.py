@@ -36,9 +36,6 @@ class ZeroMomentum(Updater):
     where the index :math:`i` includes only free and central particles (and
     excludes consitutent particles of rigid bodies).
 
-    Note:
-        `ZeroMomentum` executes on the CPU even when using a GPU device.
-
     Examples::
 
         zero_momentum = hoomd.md.update.ZeroMomentum(
@@ -51,8 +48,12 @@ class ZeroMomentum(Updater):
 
     def _attach_hook(self):
         # create the c++ mirror class
-        self._cpp_obj = _md.ZeroMomentumUpdater(
-            self._simulation.state._cpp_sys_def, self.trigger)
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            cpp_class = _md.ZeroMomentumUpdater
+        else:
+            cpp_class = _md.ZeroMomentumUpdaterGPU
+        self._cpp_obj = cpp_class(self._simulation.state._cpp_sys_def,
+                                  self.trigger)
 
 
 class ReversePerturbationFlow(Updater):
@@ -301,3 +302,113 @@ class ActiveRotationalDiffusion(Updater):
         if attr == "active_force":
             raise ValueError("active_force is not settable after construction.")
         super()._setattr_param(attr, value)
+
+
+class ReplicaExchange(Updater):
+    r"""Exchange temperatures between replicas in different partitions.
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps to attempt
+            exchanges.
+        kT (Sequence[float]): Temperature ladder, one temperature per partition
+            :math:`[\mathrm{energy}]`.
+
+    `ReplicaExchange` implements parallel tempering. Each partition of the
+    MPI communicator (see `hoomd.communicator.Communicator`) runs one replica
+    of the system and replica :math:`i` starts at position :math:`i` of the
+    ladder. When *trigger* is active, `ReplicaExchange` attempts to exchange the
+    temperatures of the replicas at neighboring ladder positions :math:`k` and
+    :math:`k+1`. Attempts alternate between the even (0-1, 2-3, ...) and odd
+    (1-2, 3-4, ...) pairs. The exchange is accepted with the probability:
+
+    .. math::
+
+        P = \min \left(1, \exp \left[ \left(\frac{1}{kT_k}
+            - \frac{1}{kT_{k+1}} \right) (U_i - U_j) \right] \right)
+
+    where :math:`U_i` is the potential energy of the replica at position
+    :math:`k` and :math:`U_j` that of the replica at position :math:`k+1`.
+
+    The replicas exchange temperatures, not configurations, so an exchange
+    only sends one message with the potential energy of each replica. Pass
+    `kT` to the thermostat of the integration method. After an exchange,
+    `ReplicaExchange` sets `kT` to the new temperature of the local replica and
+    rescales the velocities and angular momenta by :math:`\sqrt{kT_\mathrm{new}
+    / kT_\mathrm{old}}`.
+
+    Note:
+        `ReplicaExchange` does not change the internal state of thermostats,
+        such as the thermostat momentum of `hoomd.md.methods.thermostats.MTTK`.
+
+    Warning:
+        Every partition must attempt the exchanges on the same timesteps.
+
+    Example::
+
+        replica_exchange = hoomd.md.update.ReplicaExchange(
+            trigger=hoomd.trigger.Periodic(1000), kT=[1.0, 1.2, 1.5, 2.0])
+        langevin = hoomd.md.methods.Langevin(filter=hoomd.filter.All(),
+                                             kT=replica_exchange.kT)
+        simulation.operations.updaters.append(replica_exchange)
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to attempt
+            exchanges.
+        kT_ladder (tuple[float]): Temperature ladder :math:`[\mathrm{energy}]`
+            (*read only*).
+        kT (hoomd.variant.Constant): Temperature of the local replica
+            :math:`[\mathrm{energy}]` (*read only*).
+    """
+
+    def __init__(self, trigger, kT):
+        super().__init__(trigger)
+        self._kT_ladder = tuple(float(value) for value in kT)
+        if len(self._kT_ladder) == 0:
+            raise ValueError("kT must have at least one temperature.")
+        self._kT = hoomd.variant.Constant(self._kT_ladder[0])
+
+    @property
+    def kT_ladder(self):  # noqa: N802 - allow function name
+        return self._kT_ladder
+
+    @property
+    def kT(self):  # noqa: N802 - allow function name
+        return self._kT
+
+    def _attach_hook(self):
+        group = self._simulation.state._get_group(hoomd.filter.All())
+        sys_def = self._simulation.state._cpp_sys_def
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            thermo = _md.ComputeThermo(sys_def, group)
+        else:
+            thermo = _md.ComputeThermoGPU(sys_def, group)
+        self._cpp_obj = _md.ReplicaExchangeUpdater(sys_def, self.trigger,
+                                                   thermo, self._kT,
+                                                   list(self._kT_ladder))
+
+    @log(requires_run=True)
+    def ladder_index(self):
+        """int: Ladder position of the local replica."""
+        return self._cpp_obj.ladder_index
+
+    @log(category="sequence", requires_run=True)
+    def num_attempted(self):
+        """list[int]: Number of attempted exchanges between each pair of \
+        neighboring ladder positions."""
+        return self._cpp_obj.num_attempted
+
+    @log(category="sequence", requires_run=True)
+    def num_accepted(self):
+        """list[int]: Number of accepted exchanges between each pair of \
+        neighboring ladder positions."""
+        return self._cpp_obj.num_accepted
+
+    @log(category="sequence", requires_run=True)
+    def acceptance_ratio(self):
+        """list[float]: Fraction of accepted exchanges between each pair of \
+        neighboring ladder positions."""
+        return [
+            accepted / attempted if attempted > 0 else 0.0
+            for accepted, attempted in zip(self.num_accepted,
+                                           self.num_attempted)
+        ]
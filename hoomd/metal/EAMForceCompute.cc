@@ -3,6 +3,7 @@
 
 #include "EAMForceCompute.h"
 
+#include <algorithm>
 #include <vector>
 
 using namespace std;
@@ -142,25 +143,23 @@ void EAMForceCompute::loadFile(char* filename, int type_of_file)
     m_F.swap(t_F);
     ArrayHandle<Scalar4> h_F(m_F, access_location::host, access_mode::readwrite);
 
-    GPUArray<Scalar4> t_rho(nr * m_ntypes * m_ntypes, m_exec_conf);
-    m_rho.swap(t_rho);
-    ArrayHandle<Scalar4> h_rho(m_rho, access_location::host, access_mode::readwrite);
-
-    GPUArray<Scalar4> t_rphi((int)(0.5 * nr * (m_ntypes + 1) * m_ntypes), m_exec_conf);
-    m_rphi.swap(t_rphi);
-    ArrayHandle<Scalar4> h_rphi(m_rphi, access_location::host, access_mode::readwrite);
-
     GPUArray<Scalar4> t_dF(nrho * m_ntypes, m_exec_conf);
     m_dF.swap(t_dF);
     ArrayHandle<Scalar4> h_dF(m_dF, access_location::host, access_mode::readwrite);
 
+    // the functions of r are read and interpolated in temporary arrays, then packed into
+    // m_pair_table
+    GPUArray<Scalar4> t_rho(nr * m_ntypes * m_ntypes, m_exec_conf);
+    ArrayHandle<Scalar4> h_rho(t_rho, access_location::host, access_mode::readwrite);
+
+    GPUArray<Scalar4> t_rphi((int)(0.5 * nr * (m_ntypes + 1) * m_ntypes), m_exec_conf);
+    ArrayHandle<Scalar4> h_rphi(t_rphi, access_location::host, access_mode::readwrite);
+
     GPUArray<Scalar4> t_drho(nr * m_ntypes * m_ntypes, m_exec_conf);
-    m_drho.swap(t_drho);
-    ArrayHandle<Scalar4> h_drho(m_drho, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_drho(t_drho, access_location::host, access_mode::readwrite);
 
     GPUArray<Scalar4> t_drphi((int)(0.5 * nr * (m_ntypes + 1) * m_ntypes), m_exec_conf);
-    m_drphi.swap(t_drphi);
-    ArrayHandle<Scalar4> h_drphi(m_drphi, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_drphi(t_drphi, access_location::host, access_mode::readwrite);
 
     int res = 0;
     for (type = 0; type < m_ntypes; type++)
@@ -216,16 +215,18 @@ void EAMForceCompute::loadFile(char* filename, int type_of_file)
         throw runtime_error("Error loading file");
         }
 
-    // Read r*phi(r)'s arrays
+    // Read r*phi(r)'s arrays, stored at the index of the unordered pair of particle types
     for (k = 0; k < m_ntypes; k++)
         {
         for (j = 0; j <= k; j++)
             {
+            unsigned int type_max = std::max(types[k], types[j]);
+            unsigned int type_min = std::min(types[k], types[j]);
+            unsigned int offset = (type_max * (type_max + 1) / 2 + type_min) * nr;
             for (i = 0; i < nr; i++)
                 {
                 res = fscanf(fp, "%lg", &tmp);
-                h_rphi.data[(int)(0.5 * nr * (types[k] + 1) * types[k]) + types[j] * nr + i].w
-                    = (Scalar)tmp;
+                h_rphi.data[offset + i].w = (Scalar)tmp;
                 }
             }
         }
@@ -236,6 +237,39 @@ void EAMForceCompute::loadFile(char* filename, int type_of_file)
     interpolation(nrho * m_ntypes, nrho, drho, &h_F, &h_dF);
     interpolation(nr * m_ntypes * m_ntypes, nr, dr, &h_rho, &h_drho);
     interpolation((int)(0.5 * nr * (m_ntypes + 1) * m_ntypes), nr, dr, &h_rphi, &h_drphi);
+
+    packPairTable(h_rho, h_rphi);
+    }
+
+/*! \param rho Interpolated electron densities, indexed as in loadFile()
+    \param rphi Interpolated r * phi(r), indexed as in loadFile()
+ */
+void EAMForceCompute::packPairTable(const ArrayHandle<Scalar4>& rho,
+                                    const ArrayHandle<Scalar4>& rphi)
+    {
+    GPUArray<Scalar4> pair_table(eam_table_record_size * nr * m_ntypes * m_ntypes, m_exec_conf);
+    m_pair_table.swap(pair_table);
+    ArrayHandle<Scalar4> h_pair_table(m_pair_table, access_location::host, access_mode::overwrite);
+
+    for (unsigned int typei = 0; typei < m_ntypes; typei++)
+        {
+        for (unsigned int typej = 0; typej < m_ntypes; typej++)
+            {
+            // r * phi(r) is stored once for each unordered type pair
+            unsigned int type_max = std::max(typei, typej);
+            unsigned int type_min = std::min(typei, typej);
+            unsigned int shift = (type_max * (type_max + 1) / 2 + type_min) * nr;
+
+            for (unsigned int i = 0; i < nr; i++)
+                {
+                Scalar4* record = h_pair_table.data
+                                  + eam_table_record_size * (nr * (typei * m_ntypes + typej) + i);
+                record[0] = rho.data[i + nr * (typej * m_ntypes + typei)];
+                record[1] = rho.data[i + nr * (typei * m_ntypes + typej)];
+                record[2] = rphi.data[i + shift];
+                }
+            }
+        }
     }
 
 /*! compute cubic interpolation coefficients
@@ -288,9 +322,31 @@ void EAMForceCompute::interpolation(int num_all,
         }
     }
 
+//! Number of neighbors whose table lookups are evaluated together
+static constexpr unsigned int eam_batch_width = 64 / sizeof(Scalar);
+
+//! Evaluate the cubic w + z t + y t^2 + x t^3 of the interpolation coefficients
+static inline Scalar eam_spline(Scalar w, Scalar z, Scalar y, Scalar x, Scalar t)
+    {
+    return w + t * (z + t * (y + t * x));
+    }
+
+//! Evaluate the derivative of eam_spline() with respect to t
+static inline Scalar eam_spline_derivative(Scalar z, Scalar y, Scalar x, Scalar t)
+    {
+    return z + t * (Scalar(2.0) * y + Scalar(3.0) * t * x);
+    }
+
 /*! \post The EAM forces are computed for the given timestep. The neighborlist's
  compute method is called to ensure that it is up to date.
  \param timestep specifies the current time step of the simulation
+
+ The forces need the derivative of the embedding function of both particles of a pair, so the
+ neighbor list is traversed twice: once to sum the electron densities and once for the forces. The
+ neighbors within the cutoff are packed into batches. The table records of a batch are gathered
+ into per coefficient arrays first, so that the spline evaluations of all lanes vectorize. With a
+ full neighbor list, the electron density of a particle is complete after its own neighbors, and
+ the embedding function is evaluated in the same pass.
  */
 void EAMForceCompute::computeForces(uint64_t timestep)
     {
@@ -306,7 +362,8 @@ void EAMForceCompute::computeForces(uint64_t timestep)
     ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
                                         access_location::host,
                                         access_mode::read);
-    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
+    const bool compressed = m_nlist->isCompressed();
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListStorage(),
                                       access_location::host,
                                       access_mode::read);
     ArrayHandle<size_t> h_head_list(m_nlist->getHeadList(),
@@ -322,17 +379,7 @@ void EAMForceCompute::computeForces(uint64_t timestep)
     // access potential table
     ArrayHandle<Scalar4> h_F(m_F, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_dF(m_dF, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_rho(m_rho, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_drho(m_drho, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_rphi(m_rphi, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_drphi(m_drphi, access_location::host, access_mode::read);
-
-    // index and remainder
-    Scalar position;           // look up position, scalar
-    unsigned int int_position; // look up index for position, integer
-    unsigned int idxs;         // look up index in F, rho, rphi array, considering shift, integer
-    Scalar remainder;          // look up remainder in array, integer
-    Scalar4 v, dv;             // value, d(value)
+    ArrayHandle<Scalar4> h_pair_table(m_pair_table, access_location::host, access_mode::read);
 
     // there are enough other checks on the input data: but it doesn't hurt to be safe
     assert(h_force.data);
@@ -340,10 +387,7 @@ void EAMForceCompute::computeForces(uint64_t timestep)
     assert(h_pos.data);
     assert(h_F.data);
     assert(h_dF.data);
-    assert(h_rho.data);
-    assert(h_drho.data);
-    assert(h_rphi.data);
-    assert(h_drphi.data);
+    assert(h_pair_table.data);
 
     // Zero data for force calculation.
     memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
@@ -354,105 +398,156 @@ void EAMForceCompute::computeForces(uint64_t timestep)
 
     // create a temporary copy of r_cut squared
     Scalar r_cut_sq = m_r_cut * m_r_cut;
+    const unsigned int ntypes = m_pdata->getNTypes();
+    const unsigned int N = m_pdata->getN();
 
     // parameters for each particle
-    vector<Scalar> atomElectronDensity;
-    atomElectronDensity.resize(m_pdata->getN());
-    vector<Scalar> atomDerivativeEmbeddingFunction;
-    atomDerivativeEmbeddingFunction.resize(m_pdata->getN());
-    vector<Scalar> atomEmbeddingFunction;
-    atomEmbeddingFunction.resize(m_pdata->getN());
-    unsigned int ntypes = m_pdata->getNTypes();
-
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    m_electron_density.assign(N, Scalar(0.0));
+    if (m_dFdP.getNumElements() < N)
         {
+        GPUArray<Scalar> dFdP(N, m_exec_conf);
+        m_dFdP.swap(dFdP);
+        }
+    ArrayHandle<Scalar> h_dFdP(m_dFdP, access_location::host, access_mode::overwrite);
+
+    // compute dF / dP and the embedded energy F(P) of particle i
+    auto embed = [&](unsigned int i)
+    {
+        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+        // calculate position rho for F(rho)
+        Scalar position = m_electron_density[i] * rdrho;
+        unsigned int int_position = std::min((unsigned int)position, nrho - 1);
+        Scalar remainder = position - int_position;
+
+        unsigned int idxs = int_position + typei * nrho;
+        Scalar4 v = h_F.data[idxs];
+        Scalar4 dv = h_dF.data[idxs];
+        h_dFdP.data[i] = dv.z + dv.y * remainder + dv.x * remainder * remainder;
+        h_force.data[i].w += v.w + v.z * remainder + v.y * remainder * remainder
+                             + v.x * remainder * remainder * remainder;
+    };
+
+    // the neighbors within the cutoff of the current batch
+    unsigned int batch_k[eam_batch_width];
+    Scalar3 batch_dx[eam_batch_width];
+    Scalar batch_r[eam_batch_width];
+    Scalar batch_remainder[eam_batch_width];
+    const Scalar4* batch_record[eam_batch_width];
+
+    // pack the neighbors of particle i within the cutoff into batches and call evaluate(n_lanes)
+    // on each
+    auto for_each_batch = [&](unsigned int i, auto&& evaluate)
+    {
         // access the particle's position and type
         Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
         unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        const size_t head_i = h_head_list.data[i];
-
         // sanity check
         assert(typei < m_pdata->getNTypes());
 
         // loop over all of the neighbors of this particle
+        size_t offset = h_head_list.data[i];
         const unsigned int size = (unsigned int)h_n_neigh.data[i];
-
+        unsigned int k = 0;
+        unsigned int n_lanes = 0;
         for (unsigned int j = 0; j < size; j++)
             {
             // access the index of this neighbor
-            unsigned int k = h_nlist.data[head_i + j];
+            k = md::detail::nextNeighbor(h_nlist.data, compressed, offset, k);
             // sanity check
-            assert(k < m_pdata->getN());
+            assert(k < N);
 
-            // calculate dr
+            // calculate dr with periodic boundary conditions
             Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
-            Scalar3 dx = pi - pk;
+            Scalar3 dx = box.minImage(pi - pk);
+            Scalar rsq = dot(dx, dx);
+
+            // only compute the force if the particles are closer than the cut-off
+            if (rsq >= r_cut_sq)
+                continue;
 
             // access the type of the neighbor particle
-            unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+            unsigned int typek = __scalar_as_int(h_pos.data[k].w);
             // sanity check
-            assert(typej < m_pdata->getNTypes());
-
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
+            assert(typek < m_pdata->getNTypes());
 
-            // start computing the force
-            // calculate r squared
-            Scalar rsq = dot(dx, dx);
-            ;
-            // only compute the force if the particles are closer than the cut-off
-            if (rsq < r_cut_sq)
+            // calculate position r in the table
+            Scalar r = sqrt(rsq);
+            Scalar position = r * rdr;
+            unsigned int int_position = std::min((unsigned int)position, nr - 1);
+
+            batch_k[n_lanes] = k;
+            batch_dx[n_lanes] = dx;
+            batch_r[n_lanes] = r;
+            batch_remainder[n_lanes] = position - int_position;
+            batch_record[n_lanes]
+                = h_pair_table.data
+                  + eam_table_record_size * (nr * (typei * ntypes + typek) + int_position);
+            n_lanes++;
+
+            if (n_lanes == eam_batch_width)
                 {
-                // calculate position r for rho(r)
-                position = sqrt(rsq) * rdr;
-                int_position = (unsigned int)position;
-                int_position = min(int_position, nr - 1);
-                remainder = position - int_position;
-                // calculate P = sum{rho}
-                idxs = int_position + nr * (typej * ntypes + typei);
-                v = h_rho.data[idxs];
-                atomElectronDensity[i] += v.w + v.z * remainder + v.y * remainder * remainder
-                                          + v.x * remainder * remainder * remainder;
-                // if third_law, pair it
-                if (third_law)
-                    {
-                    idxs = int_position + nr * (typei * ntypes + typej);
-                    v = h_rho.data[idxs];
-                    atomElectronDensity[k] += v.w + v.z * remainder + v.y * remainder * remainder
-                                              + v.x * remainder * remainder * remainder;
-                    }
+                evaluate(n_lanes);
+                n_lanes = 0;
                 }
             }
-        }
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        if (n_lanes > 0)
+            evaluate(n_lanes);
+    };
+
+    // calculate P = sum{rho}
+    for (unsigned int i = 0; i < N; i++)
         {
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        // calculate position rho for F(rho)
-        position = atomElectronDensity[i] * rdrho;
-        int_position = (unsigned int)position;
-        int_position = min(int_position, nrho - 1);
-        remainder = position - int_position;
-
-        idxs = int_position + typei * nrho;
-        v = h_F.data[idxs];
-        dv = h_dF.data[idxs];
-        // compute dF / dP
-        atomDerivativeEmbeddingFunction[i] = dv.z + dv.y * remainder + dv.x * remainder * remainder;
-        // compute embedded energy F(P), sum up each particle
-        h_force.data[i].w += v.w + v.z * remainder + v.y * remainder * remainder
-                             + v.x * remainder * remainder * remainder;
+        for_each_batch(
+            i,
+            [&](unsigned int n_lanes)
+            {
+                // gather the coefficients (w, z, y, x) of the densities at i and at k
+                Scalar c[8][eam_batch_width];
+                for (unsigned int lane = 0; lane < n_lanes; lane++)
+                    {
+                    const Scalar4* record = batch_record[lane];
+                    c[0][lane] = record[0].w;
+                    c[1][lane] = record[0].z;
+                    c[2][lane] = record[0].y;
+                    c[3][lane] = record[0].x;
+                    c[4][lane] = record[1].w;
+                    c[5][lane] = record[1].z;
+                    c[6][lane] = record[1].y;
+                    c[7][lane] = record[1].x;
+                    }
+
+                Scalar density_i[eam_batch_width];
+                Scalar density_k[eam_batch_width];
+                for (unsigned int lane = 0; lane < n_lanes; lane++)
+                    {
+                    const Scalar t = batch_remainder[lane];
+                    density_i[lane] = eam_spline(c[0][lane], c[1][lane], c[2][lane], c[3][lane], t);
+                    density_k[lane] = eam_spline(c[4][lane], c[5][lane], c[6][lane], c[7][lane], t);
+                    }
+
+                for (unsigned int lane = 0; lane < n_lanes; lane++)
+                    {
+                    m_electron_density[i] += density_i[lane];
+                    // if third_law, pair it
+                    if (third_law)
+                        m_electron_density[batch_k[lane]] += density_k[lane];
+                    }
+            });
+
+        // with a full neighbor list, all contributions to the density of i are summed
+        if (!third_law)
+            embed(i);
         }
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    if (third_law)
         {
-        // access the particle's position and type
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        const size_t head_i = h_head_list.data[i];
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
+        for (unsigned int i = 0; i < N; i++)
+            embed(i);
+        }
 
+    for (unsigned int i = 0; i < N; i++)
+        {
         // initialize current particle force, potential energy, and virial to 0
         Scalar fxi = 0.0;
         Scalar fyi = 0.0;
@@ -462,88 +557,87 @@ void EAMForceCompute::computeForces(uint64_t timestep)
         for (int k = 0; k < 6; k++)
             viriali[k] = 0.0;
 
-        // loop over all of the neighbors of this particle
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        for (unsigned int j = 0; j < size; j++)
-            {
-            // access the index of this neighbor
-            unsigned int k = h_nlist.data[head_i + j];
-            // sanity check
-            assert(k < m_pdata->getN());
+        const Scalar dFdP_i = h_dFdP.data[i];
 
-            // calculate \Delta r
-            Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
-            Scalar3 dx = pi - pk;
-
-            // access the type of the neighbor particle
-            unsigned int typej = __scalar_as_int(h_pos.data[k].w);
-            // sanity check
-            assert(typej < m_pdata->getNTypes());
+        for_each_batch(
+            i,
+            [&](unsigned int n_lanes)
+            {
+                // gather the coefficients (w, z, y, x) of the densities at i and at k, and of
+                // r * phi(r)
+                Scalar c[12][eam_batch_width];
+                Scalar dFdP_k[eam_batch_width];
+                for (unsigned int lane = 0; lane < n_lanes; lane++)
+                    {
+                    const Scalar4* record = batch_record[lane];
+                    for (unsigned int m = 0; m < eam_table_record_size; m++)
+                        {
+                        c[4 * m][lane] = record[m].w;
+                        c[4 * m + 1][lane] = record[m].z;
+                        c[4 * m + 2][lane] = record[m].y;
+                        c[4 * m + 3][lane] = record[m].x;
+                        }
+                    dFdP_k[lane] = h_dFdP.data[batch_k[lane]];
+                    }
 
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
+                Scalar pair_eng[eam_batch_width];
+                Scalar pair_force[eam_batch_width];
+                for (unsigned int lane = 0; lane < n_lanes; lane++)
+                    {
+                    const Scalar t = batch_remainder[lane];
+                    const Scalar inverseR = Scalar(1.0) / batch_r[lane];
+
+                    // drho / dr of the densities at i and at k
+                    Scalar derivativeRhoJ
+                        = rdr * eam_spline_derivative(c[1][lane], c[2][lane], c[3][lane], t);
+                    Scalar derivativeRhoI
+                        = rdr * eam_spline_derivative(c[5][lane], c[6][lane], c[7][lane], t);
+                    // pair_eng = phi
+                    Scalar eng = eam_spline(c[8][lane], c[9][lane], c[10][lane], c[11][lane], t)
+                                 * inverseR;
+                    // derivative_pair_potential = phi + r * dphi / dr
+                    Scalar derivative_pair_potential
+                        = rdr * eam_spline_derivative(c[9][lane], c[10][lane], c[11][lane], t);
+                    // derivativePhi = (phi + r * dphi/dr - phi) * 1/r = dphi / dr
+                    Scalar derivativePhi = (derivative_pair_potential - eng) * inverseR;
+                    // fullDerivativePhi = dF/dP * drho / dr for j + dF/dP * drho / dr for j + phi
+                    Scalar fullDerivativePhi
+                        = dFdP_i * derivativeRhoJ + dFdP_k[lane] * derivativeRhoI + derivativePhi;
+                    pair_eng[lane] = eng;
+                    pair_force[lane] = -fullDerivativePhi * inverseR;
+                    }
 
-            // start computing the force
-            // calculate r squared
-            Scalar rsq = dot(dx, dx);
+                for (unsigned int lane = 0; lane < n_lanes; lane++)
+                    {
+                    const Scalar3 dx = batch_dx[lane];
+                    const Scalar pairForce = pair_force[lane];
+                    const Scalar pairForceover2 = Scalar(0.5) * pairForce;
+                    Scalar virial_pair[6] = {dx.x * dx.x * pairForceover2,
+                                             dx.x * dx.y * pairForceover2,
+                                             dx.x * dx.z * pairForceover2,
+                                             dx.y * dx.y * pairForceover2,
+                                             dx.y * dx.z * pairForceover2,
+                                             dx.z * dx.z * pairForceover2};
+                    for (int m = 0; m < 6; m++)
+                        viriali[m] += virial_pair[m];
+                    fxi += dx.x * pairForce;
+                    fyi += dx.y * pairForce;
+                    fzi += dx.z * pairForce;
+                    pei += pair_eng[lane] * 0.5;
+
+                    if (third_law)
+                        {
+                        unsigned int k = batch_k[lane];
+                        h_force.data[k].x -= dx.x * pairForce;
+                        h_force.data[k].y -= dx.y * pairForce;
+                        h_force.data[k].z -= dx.z * pairForce;
+                        h_force.data[k].w += pair_eng[lane] * 0.5;
+                        for (int m = 0; m < 6; m++)
+                            h_virial.data[m * virial_pitch + k] += virial_pair[m];
+                        }
+                    }
+            });
 
-            // calculate position r for phi(r)
-            if (rsq >= r_cut_sq)
-                continue;
-            Scalar r = sqrt(rsq);
-            Scalar inverseR = 1.0 / r;
-            position = r * rdr;
-            int_position = (unsigned int)position;
-            int_position = min(int_position, nr - 1);
-            remainder = position - int_position;
-            // calculate the shift position for type ij
-            int shift = (typei >= typej)
-                            ? (int)(0.5 * (2 * ntypes - typej - 1) * typej + typei) * nr
-                            : (int)(0.5 * (2 * ntypes - typei - 1) * typei + typej) * nr;
-
-            idxs = int_position + shift;
-            v = h_rphi.data[idxs];
-            dv = h_drphi.data[idxs];
-            // pair_eng = phi
-            Scalar pair_eng = (v.w + v.z * remainder + v.y * remainder * remainder
-                               + v.x * remainder * remainder * remainder)
-                              * inverseR;
-            // derivativePhi = (phi + r * dphi/dr - phi) * 1/r = dphi / dr
-            Scalar derivativePhi
-                = (dv.z + dv.y * remainder + dv.x * remainder * remainder - pair_eng) * inverseR;
-            // derivativeRhoI = drho / dr of i
-            idxs = int_position + typei * ntypes * nr + typej * nr;
-            dv = h_drho.data[idxs];
-            Scalar derivativeRhoI = dv.z + dv.y * remainder + dv.x * remainder * remainder;
-            // derivativeRhoJ = drho / dr of j
-            idxs = int_position + typej * ntypes * nr + typei * nr;
-            dv = h_drho.data[idxs];
-            Scalar derivativeRhoJ = dv.z + dv.y * remainder + dv.x * remainder * remainder;
-            // fullDerivativePhi = dF/dP * drho / dr for j + dF/dP * drho / dr for j + phi
-            Scalar fullDerivativePhi = atomDerivativeEmbeddingFunction[i] * derivativeRhoJ
-                                       + atomDerivativeEmbeddingFunction[k] * derivativeRhoI
-                                       + derivativePhi;
-            // compute forces
-            Scalar pairForce = -fullDerivativePhi * inverseR;
-            viriali[0] += dx.x * dx.x * pairForce;
-            viriali[1] += dx.x * dx.y * pairForce;
-            viriali[2] += dx.x * dx.z * pairForce;
-            viriali[3] += dx.y * dx.y * pairForce;
-            viriali[4] += dx.y * dx.z * pairForce;
-            viriali[5] += dx.z * dx.z * pairForce;
-            fxi += dx.x * pairForce;
-            fyi += dx.y * pairForce;
-            fzi += dx.z * pairForce;
-            pei += pair_eng * 0.5;
-
-            if (third_law)
-                {
-                h_force.data[k].x -= dx.x * pairForce;
-                h_force.data[k].y -= dx.y * pairForce;
-                h_force.data[k].z -= dx.z * pairForce;
-                h_force.data[k].w += pair_eng * 0.5;
-                }
-            }
         h_force.data[i].x += fxi;
         h_force.data[i].y += fyi;
         h_force.data[i].z += fzi;
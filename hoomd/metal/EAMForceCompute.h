@@ -1,6 +1,7 @@
 // Copyright (c) 2009-2024 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+#include "EAMTable.h"
 #include "hoomd/ForceCompute.h"
 #include "hoomd/md/NeighborList.h"
 
@@ -34,14 +35,20 @@ namespace metal
  coefficients.
 
  \b Potential memory layout
- The potential data and the coefficients are stored in six GPUArray<Scalar> arrays: the embedded
- potential function (m_F) and its derivative (m_dF), the electron density function (m_rho) and its
- derivative (m_drho), the pair potential function (m_rphi) and its derivative (m_drphi). The 3
- coefficients for a data point is stored continuously, for example, h_F.data[100].w is the embedded
- potential function's value read from the 100st position of the potential file,
- h_F.data[100].z, h_F.data[100].y, h_F.data[100*].x, are for interpolating embedded function,
- h_dF.data[100].z, h_dF.data[100].y, h_dF.data[100].x, are for interpolating derivative embedded
- function.
+ The embedded potential function and its derivative are stored in m_F and m_dF. The 3 coefficients
+ for a data point is stored continuously, for example, h_F.data[100].w is the embedded potential
+ function's value read from the 100st position of the potential file, h_F.data[100].z,
+ h_F.data[100].y, h_F.data[100*].x, are for interpolating embedded function, h_dF.data[100].z,
+ h_dF.data[100].y, h_dF.data[100].x, are for interpolating derivative embedded function.
+
+ The functions of the distance are packed into m_pair_table, which holds one record of
+ eam_table_record_size Scalar4 for each ordered type pair (typei, typej) and interval of r, at
+ eam_table_record_size * (nr * (typei * ntypes + typej) + interval):
+  - the electron density that a particle of typej contributes at a particle of typei
+  - the electron density that a particle of typei contributes at a particle of typej
+  - r * phi(r) of the pair
+ The same layout of coefficients applies to each Scalar4. The derivatives follow from the
+ coefficients, so each pair reads a single contiguous record in both passes over the neighbor list.
 
  \ingroup computes
  */
@@ -80,17 +87,19 @@ class EAMForceCompute : public ForceCompute
     std::vector<std::string> atomcomment; //!< atom comment
     std::vector<std::string> names;       //!< array names(type)
 
-    GPUArray<Scalar4> m_F;     //!< embedded function and its coefficients
-    GPUArray<Scalar4> m_rho;   //!< electron density and its coefficients
-    GPUArray<Scalar4> m_rphi;  //!< pair wise function and its coefficients
-    GPUArray<Scalar4> m_dF;    //!< derivative embedded function and its coefficients
-    GPUArray<Scalar4> m_drho;  //!< derivative electron density and its coefficients
-    GPUArray<Scalar4> m_drphi; //!< derivative pair wise function and its coefficients
-    GPUArray<Scalar> m_dFdP;   //!< derivative F / derivative P
+    GPUArray<Scalar4> m_F;          //!< embedded function and its coefficients
+    GPUArray<Scalar4> m_dF;         //!< derivative embedded function and its coefficients
+    GPUArray<Scalar4> m_pair_table; //!< electron densities and pair function per type pair
+    GPUArray<Scalar> m_dFdP;        //!< derivative F / derivative P
+
+    std::vector<Scalar> m_electron_density; //!< electron density of each particle
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
 
+    //! Pack the interpolated electron densities and pair functions into m_pair_table
+    void packPairTable(const ArrayHandle<Scalar4>& rho, const ArrayHandle<Scalar4>& rphi);
+
     //! cubic interpolation
     virtual void interpolation(int num_all,
                                int num_per,
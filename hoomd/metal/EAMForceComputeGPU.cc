@@ -96,17 +96,17 @@ void EAMForceComputeGPU::computeForces(uint64_t timestep)
     // access the potential data
     ArrayHandle<Scalar4> d_F(m_F, access_location::device, access_mode::read);
     ArrayHandle<Scalar4> d_dF(m_dF, access_location::device, access_mode::read);
-    ArrayHandle<Scalar4> d_rho(m_rho, access_location::device, access_mode::read);
-    ArrayHandle<Scalar4> d_drho(m_drho, access_location::device, access_mode::read);
-    ArrayHandle<Scalar4> d_rphi(m_rphi, access_location::device, access_mode::read);
-    ArrayHandle<Scalar4> d_drphi(m_drphi, access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_pair_table(m_pair_table, access_location::device, access_mode::read);
     ArrayHandle<kernel::EAMTexInterData> d_eam_data(m_eam_data,
                                                     access_location::device,
                                                     access_mode::read);
 
     // Derivative Embedding Function for each atom
-    GPUArray<Scalar> t_dFdP(m_pdata->getN(), m_exec_conf);
-    m_dFdP.swap(t_dFdP);
+    if (m_dFdP.getNumElements() < m_pdata->getN())
+        {
+        GPUArray<Scalar> t_dFdP(m_pdata->getN(), m_exec_conf);
+        m_dFdP.swap(t_dFdP);
+        }
     ArrayHandle<Scalar> d_dFdP(m_dFdP, access_location::device, access_mode::overwrite);
 
     // Compute energy and forces in GPU
@@ -124,11 +124,10 @@ void EAMForceComputeGPU::computeForces(uint64_t timestep)
                                              d_eam_data.data,
                                              d_dFdP.data,
                                              d_F.data,
-                                             d_rho.data,
-                                             d_rphi.data,
                                              d_dF.data,
-                                             d_drho.data,
-                                             d_drphi.data,
+                                             d_pair_table.data,
+                                             (unsigned int)m_pair_table.getNumElements(),
+                                             m_exec_conf->dev_prop,
                                              m_tuner->getParam()[0]);
 
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
@@ -24,8 +24,8 @@ namespace hoomd
 namespace metal
     {
 //! Computes EAM forces on each particle using the GPU
-/*! Calculates the same forces as EAMForceCompute, but on the GPU by using texture
- * memory(CUDAArray).
+/*! Calculates the same forces as EAMForceCompute, but on the GPU. The kernels read the pair table
+ * from shared memory when it fits.
  */
 class EAMForceComputeGPU : public EAMForceCompute
     {
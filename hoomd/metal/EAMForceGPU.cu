@@ -27,15 +27,14 @@ __global__ void gpu_kernel_1(Scalar4* d_force,
                              const unsigned int* d_nlist,
                              const size_t* d_head_list,
                              const Scalar4* d_F,
-                             const Scalar4* d_rho,
-                             const Scalar4* d_rphi,
                              const Scalar4* d_dF,
-                             const Scalar4* d_drho,
-                             const Scalar4* d_drphi,
+                             const Scalar4* d_pair_table,
+                             const unsigned int n_table_shared,
                              Scalar* d_dFdP,
                              const EAMTexInterData* d_eam_data)
     {
     __shared__ EAMTexInterData eam_data_ti;
+    extern __shared__ Scalar4 s_pair_table[];
 
     // copy over parameters one int per thread
     unsigned int tidx = threadIdx.x;
@@ -50,6 +49,18 @@ __global__ void gpu_kernel_1(Scalar4* d_force,
             }
         }
 
+    // stage the table in shared memory when it fits
+    const Scalar4* pair_table = d_pair_table;
+    if (n_table_shared > 0)
+        {
+        for (unsigned int cur_offset = tidx; cur_offset < n_table_shared; cur_offset += block_size)
+            {
+            s_pair_table[cur_offset] = __ldg(d_pair_table + cur_offset);
+            }
+        pair_table = s_pair_table;
+        }
+    __syncthreads();
+
     // start by identifying which particle we are to handle
     int idx = blockIdx.x * blockDim.x + threadIdx.x;
 
@@ -118,8 +129,8 @@ __global__ void gpu_kernel_1(Scalar4* d_force,
             int_position = min(int_position, nr - 1);
             remainder = position - int_position;
             // calculate P = sum{rho}
-            idxs = int_position + nr * (typej * ntypes + typei);
-            v = __ldg(d_rho + idxs);
+            idxs = eam_table_record_size * (nr * (typei * ntypes + typej) + int_position);
+            v = pair_table[idxs];
             atomElectronDensity += v.w + v.z * remainder + v.y * remainder * remainder
                                    + v.x * remainder * remainder * remainder;
             }
@@ -154,15 +165,14 @@ __global__ void gpu_kernel_2(Scalar4* d_force,
                              const unsigned int* d_nlist,
                              const size_t* d_head_list,
                              const Scalar4* d_F,
-                             const Scalar4* d_rho,
-                             const Scalar4* d_rphi,
                              const Scalar4* d_dF,
-                             const Scalar4* d_drho,
-                             const Scalar4* d_drphi,
+                             const Scalar4* d_pair_table,
+                             const unsigned int n_table_shared,
                              Scalar* d_dFdP,
                              const EAMTexInterData* d_eam_data)
     {
     __shared__ EAMTexInterData eam_data_ti;
+    extern __shared__ Scalar4 s_pair_table[];
 
     // copy over parameters one int per thread
     unsigned int tidx = threadIdx.x;
@@ -177,6 +187,18 @@ __global__ void gpu_kernel_2(Scalar4* d_force,
             }
         }
 
+    // stage the table in shared memory when it fits
+    const Scalar4* pair_table = d_pair_table;
+    if (n_table_shared > 0)
+        {
+        for (unsigned int cur_offset = tidx; cur_offset < n_table_shared; cur_offset += block_size)
+            {
+            s_pair_table[cur_offset] = __ldg(d_pair_table + cur_offset);
+            }
+        pair_table = s_pair_table;
+        }
+    __syncthreads();
+
     // start by identifying which particle we are to handle
     int idx = blockIdx.x * blockDim.x + threadIdx.x;
 
@@ -197,7 +219,7 @@ __global__ void gpu_kernel_2(Scalar4* d_force,
     unsigned int int_position; // look up index for position, integer
     unsigned int idxs;         // look up index in F, rho, rphi array, considering shift, integer
     Scalar remainder;          // look up remainder in array, integer
-    Scalar4 v, dv;             // value, d(value)
+    Scalar4 v;                 // value
 
     // prefetch neighbor index
     int cur_neigh = 0;
@@ -250,30 +272,30 @@ __global__ void gpu_kernel_2(Scalar4* d_force,
         int_position = (unsigned int)position;
         int_position = min(int_position, nr - 1);
         remainder = position - int_position;
-        // calculate the shift position for type ij
-        int shift = (typei >= typej) ? (int)(0.5 * (2 * ntypes - typej - 1) * typej + typei) * nr
-                                     : (int)(0.5 * (2 * ntypes - typei - 1) * typei + typej) * nr;
-
-        idxs = int_position + shift;
-        v = __ldg(d_rphi + idxs);
-        dv = __ldg(d_drphi + idxs);
+        // the record holds the densities at i and at j and r * phi(r) of the pair
+        idxs = eam_table_record_size * (nr * (typei * ntypes + typej) + int_position);
+        v = pair_table[idxs + 2];
         // aspair_potential = r * phi
         Scalar aspair_potential = v.w + v.z * remainder + v.y * remainder * remainder
                                   + v.x * remainder * remainder * remainder;
         // derivative_pair_potential = phi + r * dphi / dr
-        Scalar derivative_pair_potential = dv.z + dv.y * remainder + dv.x * remainder * remainder;
+        Scalar derivative_pair_potential
+            = (v.z + Scalar(2.0) * v.y * remainder + Scalar(3.0) * v.x * remainder * remainder)
+              * rdr;
         // pair_eng = phi
         Scalar pair_eng = aspair_potential * inverseR;
         // derivativePhi = (phi + r * dphi/dr - phi) * 1/r = dphi / dr
         Scalar derivativePhi = (derivative_pair_potential - pair_eng) * inverseR;
         // derivativeRhoI = drho / dr of i
-        idxs = int_position + typei * ntypes * nr + typej * nr;
-        dv = __ldg(d_drho + idxs);
-        Scalar derivativeRhoI = dv.z + dv.y * remainder + dv.x * remainder * remainder;
+        v = pair_table[idxs + 1];
+        Scalar derivativeRhoI
+            = (v.z + Scalar(2.0) * v.y * remainder + Scalar(3.0) * v.x * remainder * remainder)
+              * rdr;
         // derivativeRhoJ = drho / dr of j
-        idxs = int_position + typej * ntypes * nr + typei * nr;
-        dv = __ldg(d_drho + idxs);
-        Scalar derivativeRhoJ = dv.z + dv.y * remainder + dv.x * remainder * remainder;
+        v = pair_table[idxs];
+        Scalar derivativeRhoJ
+            = (v.z + Scalar(2.0) * v.y * remainder + Scalar(3.0) * v.x * remainder * remainder)
+              * rdr;
         // fullDerivativePhi = dF/dP * drho / dr for j + dF/dP * drho / dr for j + phi
         Scalar d_dFdPcur = __ldg(d_dFdP + cur_neigh);
         Scalar fullDerivativePhi
@@ -320,11 +342,10 @@ hipError_t gpu_compute_eam_tex_inter_forces(Scalar4* d_force,
                                             const EAMTexInterData* d_eam_data,
                                             Scalar* d_dFdP,
                                             const Scalar4* d_F,
-                                            const Scalar4* d_rho,
-                                            const Scalar4* d_rphi,
                                             const Scalar4* d_dF,
-                                            const Scalar4* d_drho,
-                                            const Scalar4* d_drphi,
+                                            const Scalar4* d_pair_table,
+                                            const unsigned int n_pair_table,
+                                            const hipDeviceProp_t& dev_prop,
                                             const unsigned int block_size)
     {
     unsigned int max_block_size_1;
@@ -342,6 +363,15 @@ hipError_t gpu_compute_eam_tex_inter_forces(Scalar4* d_force,
     unsigned int run_block_size_1 = min(block_size, max_block_size_1);
     unsigned int run_block_size_2 = min(block_size, max_block_size_2);
 
+    // the kernels read the table from shared memory when it fits
+    size_t table_bytes = sizeof(Scalar4) * n_pair_table;
+    unsigned int n_table_shared
+        = (table_bytes + max(attr1.sharedSizeBytes, attr2.sharedSizeBytes)
+           <= dev_prop.sharedMemPerBlock)
+              ? n_pair_table
+              : 0;
+    size_t shared_bytes = sizeof(Scalar4) * n_table_shared;
+
     // setup the grid to run the kernel
 
     dim3 grid_1((int)ceil((double)N / (double)run_block_size_1), 1, 1);
@@ -353,7 +383,7 @@ hipError_t gpu_compute_eam_tex_inter_forces(Scalar4* d_force,
     hipLaunchKernelGGL(gpu_kernel_1,
                        dim3(grid_1),
                        dim3(threads_1),
-                       0,
+                       shared_bytes,
                        0,
                        d_force,
                        d_virial,
@@ -365,17 +395,15 @@ hipError_t gpu_compute_eam_tex_inter_forces(Scalar4* d_force,
                        d_nlist,
                        d_head_list,
                        d_F,
-                       d_rho,
-                       d_rphi,
                        d_dF,
-                       d_drho,
-                       d_drphi,
+                       d_pair_table,
+                       n_table_shared,
                        d_dFdP,
                        d_eam_data);
     hipLaunchKernelGGL(gpu_kernel_2,
                        dim3(grid_2),
                        dim3(threads_2),
-                       0,
+                       shared_bytes,
                        0,
                        d_force,
                        d_virial,
@@ -387,11 +415,9 @@ hipError_t gpu_compute_eam_tex_inter_forces(Scalar4* d_force,
                        d_nlist,
                        d_head_list,
                        d_F,
-                       d_rho,
-                       d_rphi,
                        d_dF,
-                       d_drho,
-                       d_drphi,
+                       d_pair_table,
+                       n_table_shared,
                        d_dFdP,
                        d_eam_data);
 
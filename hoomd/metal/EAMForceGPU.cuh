@@ -1,6 +1,7 @@
 // Copyright (c) 2009-2024 The Regents of the University of Michigan.
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
+#include "EAMTable.h"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/Index1D.h"
 #include "hoomd/ParticleData.cuh"
@@ -46,11 +47,10 @@ hipError_t gpu_compute_eam_tex_inter_forces(Scalar4* d_force,
                                             const EAMTexInterData* d_eam_data,
                                             Scalar* d_dFdP,
                                             const Scalar4* d_F,
-                                            const Scalar4* d_rho,
-                                            const Scalar4* d_rphi,
                                             const Scalar4* d_dF,
-                                            const Scalar4* d_drho,
-                                            const Scalar4* d_drphi,
+                                            const Scalar4* d_pair_table,
+                                            const unsigned int n_pair_table,
+                                            const hipDeviceProp_t& dev_prop,
                                             const unsigned int block_size);
 
     } // end namespace kernel
@@ -0,0 +1,21 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*! \file EAMTable.h
+ \brief Declares the layout of the EAM pair table shared by the CPU and GPU implementations
+ */
+
+#ifndef __EAM_TABLE_H__
+#define __EAM_TABLE_H__
+
+namespace hoomd
+    {
+namespace metal
+    {
+//! Number of Scalar4 in each record of the pair table, see EAMForceCompute
+const unsigned int eam_table_record_size = 3;
+
+    } // end namespace metal
+    } // end namespace hoomd
+
+#endif
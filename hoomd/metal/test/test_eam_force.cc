@@ -0,0 +1,409 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "hoomd/metal/EAMForceCompute.h"
+#include "hoomd/md/NeighborListTree.h"
+
+#ifdef ENABLE_HIP
+#include "hoomd/md/NeighborListGPUTree.h"
+#include "hoomd/metal/EAMForceComputeGPU.h"
+#endif
+
+using namespace std;
+using namespace std::placeholders;
+using namespace hoomd;
+using namespace hoomd::md;
+using namespace hoomd::metal;
+
+/*! \file test_eam_force.cc
+    \brief Implements unit tests for EAMForceCompute and EAMForceComputeGPU
+    \ingroup unit_tests
+*/
+
+#include "hoomd/test/upp11_config.h"
+HOOMD_UP_MAIN();
+
+//! Typedef to make using the std::function factory easier
+typedef std::function<std::shared_ptr<EAMForceCompute>(std::shared_ptr<SystemDefinition> sysdef,
+                                                       std::string& filename,
+                                                       NeighborList::storageMode mode)>
+    eamforce_creator;
+
+//! Number of tabulated values of F(rho)
+const unsigned int eam_nrho = 500;
+//! Interval of rho in the table
+const double eam_drho = 1.0;
+//! Number of tabulated values of rho(r) and r * phi(r)
+const unsigned int eam_nr = 200;
+//! Interval of r in the table
+const double eam_dr = 0.025;
+//! Cutoff radius given in the file
+const double eam_r_cut = 4.0;
+//! The functions of r reach zero at this distance
+const double eam_r_zero = 5.0;
+
+//! Slope of the embedding function F(rho) = c rho of each type
+const double eam_c[3] = {-1.0, -1.5, -2.0};
+//! Slope of the electron density rho(r) = d (r_zero - r) that each type contributes
+const double eam_d[3] = {0.5, 0.7, 0.9};
+//! Prefactor of r phi(r) = e (r_zero - r) for each type pair, all distinct
+const double eam_e[3][3] = {{1.0, 2.0, 4.0}, {2.0, 3.0, 5.0}, {4.0, 5.0, 6.0}};
+
+//! Write a three type EAM/Alloy file
+/*! All functions are linear in their argument, so the cubic splines reproduce them exactly away
+    from the ends of the tables. The file lists the elements in the order B, A, C, so the test also
+    checks the mapping from the file to the particle types.
+*/
+void write_eam_alloy_file(const std::string& filename)
+    {
+    const unsigned int file_types[3] = {1, 0, 2};
+    const char* names[3] = {"A", "B", "C"};
+
+    std::ofstream f(filename.c_str());
+    f.precision(17);
+    f << "EAM/Alloy test potential" << endl;
+    f << "linear functions with distinct pair functions" << endl;
+    f << "for test_eam_force" << endl;
+    f << "3";
+    for (unsigned int k = 0; k < 3; k++)
+        f << " " << names[file_types[k]];
+    f << endl;
+    f << eam_nrho << " " << eam_drho << " " << eam_nr << " " << eam_dr << " " << eam_r_cut << endl;
+
+    for (unsigned int k = 0; k < 3; k++)
+        {
+        unsigned int t = file_types[k];
+        f << k + 1 << " 1.0 1.0 fcc" << endl;
+        for (unsigned int i = 0; i < eam_nrho; i++)
+            f << eam_c[t] * i * eam_drho << endl;
+        for (unsigned int i = 0; i < eam_nr; i++)
+            f << eam_d[t] * (eam_r_zero - i * eam_dr) << endl;
+        }
+
+    // r * phi(r) of each unordered pair of file elements
+    for (unsigned int k = 0; k < 3; k++)
+        {
+        for (unsigned int j = 0; j <= k; j++)
+            {
+            double e = eam_e[file_types[k]][file_types[j]];
+            for (unsigned int i = 0; i < eam_nr; i++)
+                f << e * (eam_r_zero - i * eam_dr) << endl;
+            }
+        }
+    }
+
+//! Check the EAM force on three particles of different types against the analytic functions
+void eam_force_three_type_test(eamforce_creator eam_creator,
+                               NeighborList::storageMode mode,
+                               std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::string filename = "test_eam_force.eam.alloy";
+    write_eam_alloy_file(filename);
+
+    // one particle of each type, all distances fall in the interior of the tables
+    std::shared_ptr<SystemDefinition> sysdef_3(
+        new SystemDefinition(3, BoxDim(20.0), 3, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata_3 = sysdef_3->getParticleData();
+    pdata_3->setFlags(~PDataFlags(0));
+
+    const Scalar3 pos[3] = {make_scalar3(0.0, 0.0, 0.0),
+                            make_scalar3(1.23, 0.0, 0.0),
+                            make_scalar3(0.4, 1.45, 0.3)};
+    for (unsigned int i = 0; i < 3; i++)
+        {
+        pdata_3->setPosition(i, pos[i]);
+        pdata_3->setType(i, i);
+        }
+
+    std::shared_ptr<EAMForceCompute> fc_3 = eam_creator(sysdef_3, filename, mode);
+    fc_3->compute(0);
+    std::remove(filename.c_str());
+
+    // compute the expected values from the functions written to the file
+    double rho[3] = {0.0, 0.0, 0.0};
+    for (unsigned int i = 0; i < 3; i++)
+        {
+        for (unsigned int j = 0; j < 3; j++)
+            {
+            if (i == j)
+                continue;
+            Scalar3 dx = pos[i] - pos[j];
+            double r = sqrt(dot(dx, dx));
+            rho[i] += eam_d[j] * (eam_r_zero - r);
+            }
+        }
+
+    double energy[3];
+    double force[3][3];
+    double virial[3][6];
+    for (unsigned int i = 0; i < 3; i++)
+        {
+        energy[i] = eam_c[i] * rho[i];
+        for (unsigned int m = 0; m < 3; m++)
+            force[i][m] = 0.0;
+        for (unsigned int m = 0; m < 6; m++)
+            virial[i][m] = 0.0;
+
+        for (unsigned int j = 0; j < 3; j++)
+            {
+            if (i == j)
+                continue;
+            Scalar3 dx = pos[i] - pos[j];
+            double dxs[3] = {dx.x, dx.y, dx.z};
+            double r = sqrt(dot(dx, dx));
+            double e = eam_e[i][j];
+            energy[i] += 0.5 * e * (eam_r_zero - r) / r;
+
+            // dU/dr = F_i'(rho_i) rho_j'(r) + F_j'(rho_j) rho_i'(r) + phi_ij'(r)
+            double dUdr = -eam_c[i] * eam_d[j] - eam_c[j] * eam_d[i] - e * eam_r_zero / (r * r);
+            double force_divr = -dUdr / r;
+            for (unsigned int m = 0; m < 3; m++)
+                force[i][m] += force_divr * dxs[m];
+
+            // each particle of the pair gets half of the pair virial
+            unsigned int m = 0;
+            for (unsigned int a = 0; a < 3; a++)
+                for (unsigned int b = a; b < 3; b++)
+                    virial[i][m++] += 0.5 * force_divr * dxs[a] * dxs[b];
+            }
+        }
+
+        {
+        const GlobalArray<Scalar4>& force_array = fc_3->getForceArray();
+        const GlobalArray<Scalar>& virial_array = fc_3->getVirialArray();
+        size_t pitch = virial_array.getPitch();
+        ArrayHandle<Scalar4> h_force(force_array, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_virial(virial_array, access_location::host, access_mode::read);
+
+        for (unsigned int i = 0; i < 3; i++)
+            {
+            MY_CHECK_CLOSE(h_force.data[i].x, force[i][0], tol);
+            MY_CHECK_CLOSE(h_force.data[i].y, force[i][1], tol);
+            MY_CHECK_CLOSE(h_force.data[i].z, force[i][2], tol);
+            MY_CHECK_CLOSE(h_force.data[i].w, energy[i], tol);
+            for (unsigned int m = 0; m < 6; m++)
+                {
+                if (std::abs(virial[i][m]) < tol_small)
+                    MY_CHECK_SMALL(h_virial.data[m * pitch + i], tol_small);
+                else
+                    MY_CHECK_CLOSE(h_virial.data[m * pitch + i], virial[i][m], tol);
+                }
+            }
+        }
+    }
+
+//! Compare the forces, energies, and virials of two EAM force computes on a dense system
+void eam_force_comparison_test(eamforce_creator eam_creator1,
+                               NeighborList::storageMode mode1,
+                               eamforce_creator eam_creator2,
+                               NeighborList::storageMode mode2,
+                               std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::string filename = "test_eam_force_compare.eam.alloy";
+    write_eam_alloy_file(filename);
+
+    // particles of all types on a perturbed simple cubic lattice
+    const unsigned int n = 8;
+    const Scalar a = 1.5;
+    const unsigned int N = n * n * n;
+    std::shared_ptr<SystemDefinition> sysdef(
+        new SystemDefinition(N, BoxDim(n * a), 3, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    std::mt19937 engine(12345);
+    std::uniform_real_distribution<double> perturbation(-0.2, 0.2);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        Scalar3 p = make_scalar3(((i % n) + Scalar(0.5)) * a - n * a / Scalar(2.0),
+                                 (((i / n) % n) + Scalar(0.5)) * a - n * a / Scalar(2.0),
+                                 ((i / (n * n)) + Scalar(0.5)) * a - n * a / Scalar(2.0));
+        p.x += perturbation(engine);
+        p.y += perturbation(engine);
+        p.z += perturbation(engine);
+        pdata->setPosition(i, p);
+        pdata->setType(i, i % 3);
+        }
+
+    std::shared_ptr<EAMForceCompute> fc1 = eam_creator1(sysdef, filename, mode1);
+    std::shared_ptr<EAMForceCompute> fc2 = eam_creator2(sysdef, filename, mode2);
+    std::remove(filename.c_str());
+
+    // compute the forces
+    fc1->compute(0);
+    fc2->compute(0);
+
+        // verify that the forces are identical (within roundoff errors)
+        {
+        const GlobalArray<Scalar4>& force_array_1 = fc1->getForceArray();
+        const GlobalArray<Scalar>& virial_array_1 = fc1->getVirialArray();
+        size_t pitch_1 = virial_array_1.getPitch();
+        ArrayHandle<Scalar4> h_force_1(force_array_1, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_virial_1(virial_array_1, access_location::host, access_mode::read);
+        const GlobalArray<Scalar4>& force_array_2 = fc2->getForceArray();
+        const GlobalArray<Scalar>& virial_array_2 = fc2->getVirialArray();
+        size_t pitch_2 = virial_array_2.getPitch();
+        ArrayHandle<Scalar4> h_force_2(force_array_2, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_virial_2(virial_array_2, access_location::host, access_mode::read);
+
+        // compare average deviation between the two computes
+        double deltaf2 = 0.0;
+        double deltape2 = 0.0;
+        double deltav2[6];
+        double virial_sum_1[6];
+        double virial_sum_2[6];
+        for (unsigned int j = 0; j < 6; j++)
+            {
+            deltav2[j] = 0.0;
+            virial_sum_1[j] = 0.0;
+            virial_sum_2[j] = 0.0;
+            }
+
+        for (unsigned int i = 0; i < N; i++)
+            {
+            deltaf2 += double(h_force_2.data[i].x - h_force_1.data[i].x)
+                       * double(h_force_2.data[i].x - h_force_1.data[i].x);
+            deltaf2 += double(h_force_2.data[i].y - h_force_1.data[i].y)
+                       * double(h_force_2.data[i].y - h_force_1.data[i].y);
+            deltaf2 += double(h_force_2.data[i].z - h_force_1.data[i].z)
+                       * double(h_force_2.data[i].z - h_force_1.data[i].z);
+            deltape2 += double(h_force_2.data[i].w - h_force_1.data[i].w)
+                        * double(h_force_2.data[i].w - h_force_1.data[i].w);
+            for (unsigned int j = 0; j < 6; j++)
+                {
+                double v1 = h_virial_1.data[j * pitch_1 + i];
+                double v2 = h_virial_2.data[j * pitch_2 + i];
+                deltav2[j] += (v2 - v1) * (v2 - v1);
+                virial_sum_1[j] += v1;
+                virial_sum_2[j] += v2;
+                }
+            }
+        deltaf2 /= double(N);
+        deltape2 /= double(N);
+        for (unsigned int j = 0; j < 6; j++)
+            deltav2[j] /= double(N);
+        CHECK_SMALL(deltaf2, double(tol_small));
+        CHECK_SMALL(deltape2, double(tol_small));
+        for (unsigned int j = 0; j < 6; j++)
+            CHECK_SMALL(deltav2[j], double(tol_small));
+
+        // the pressure follows from the diagonal of the total virial
+        for (unsigned int j : {0, 3, 5})
+            MY_CHECK_CLOSE(virial_sum_1[j], virial_sum_2[j], tol);
+        }
+    }
+
+//! EAMForceCompute creator for unit tests
+std::shared_ptr<EAMForceCompute> base_class_eam_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                                        std::string& filename,
+                                                        NeighborList::storageMode mode)
+    {
+    std::shared_ptr<EAMForceCompute> eam(new EAMForceCompute(sysdef, &filename[0], 0));
+
+    std::shared_ptr<NeighborList> nlist(new NeighborListTree(sysdef, Scalar(0.4)));
+    auto r_cut
+        = std::make_shared<GlobalArray<Scalar>>(nlist->getTypePairIndexer().getNumElements(),
+                                                sysdef->getParticleData()->getExecConf());
+        {
+        ArrayHandle<Scalar> h_r_cut(*r_cut, access_location::host, access_mode::overwrite);
+        for (unsigned int i = 0; i < r_cut->getNumElements(); i++)
+            h_r_cut.data[i] = eam->get_r_cut();
+        }
+    nlist->addRCutMatrix(r_cut);
+    nlist->setStorageMode(mode);
+    eam->set_neighbor_list(nlist);
+    return eam;
+    }
+
+#ifdef ENABLE_HIP
+//! EAMForceComputeGPU creator for unit tests
+std::shared_ptr<EAMForceCompute> gpu_eam_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                                 std::string& filename,
+                                                 NeighborList::storageMode mode)
+    {
+    std::shared_ptr<EAMForceCompute> eam(new EAMForceComputeGPU(sysdef, &filename[0], 0));
+
+    std::shared_ptr<NeighborList> nlist(new NeighborListGPUTree(sysdef, Scalar(0.4)));
+    auto r_cut
+        = std::make_shared<GlobalArray<Scalar>>(nlist->getTypePairIndexer().getNumElements(),
+                                                sysdef->getParticleData()->getExecConf());
+        {
+        ArrayHandle<Scalar> h_r_cut(*r_cut, access_location::host, access_mode::overwrite);
+        for (unsigned int i = 0; i < r_cut->getNumElements(); i++)
+            h_r_cut.data[i] = eam->get_r_cut();
+        }
+    nlist->addRCutMatrix(r_cut);
+    nlist->setStorageMode(mode);
+    eam->set_neighbor_list(nlist);
+    return eam;
+    }
+#endif
+
+//! test case for the three type potential with a half neighbor list on the CPU
+UP_TEST(EAMForceCompute_three_type_half)
+    {
+    eamforce_creator eam_creator = bind(base_class_eam_creator, _1, _2, _3);
+    eam_force_three_type_test(eam_creator,
+                              NeighborList::half,
+                              std::shared_ptr<ExecutionConfiguration>(
+                                  new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for the three type potential with a full neighbor list on the CPU
+UP_TEST(EAMForceCompute_three_type_full)
+    {
+    eamforce_creator eam_creator = bind(base_class_eam_creator, _1, _2, _3);
+    eam_force_three_type_test(eam_creator,
+                              NeighborList::full,
+                              std::shared_ptr<ExecutionConfiguration>(
+                                  new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for comparing half and full neighbor lists on the CPU
+UP_TEST(EAMForceCompute_half_full_compare)
+    {
+    eamforce_creator eam_creator = bind(base_class_eam_creator, _1, _2, _3);
+    eam_force_comparison_test(eam_creator,
+                              NeighborList::half,
+                              eam_creator,
+                              NeighborList::full,
+                              std::shared_ptr<ExecutionConfiguration>(
+                                  new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+#ifdef ENABLE_HIP
+//! test case for the three type potential on the GPU
+UP_TEST(EAMForceComputeGPU_three_type)
+    {
+    eamforce_creator eam_creator = bind(gpu_eam_creator, _1, _2, _3);
+    eam_force_three_type_test(eam_creator,
+                              NeighborList::full,
+                              std::shared_ptr<ExecutionConfiguration>(
+                                  new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+
+//! test case for comparing the GPU and CPU EAMForceComputes
+UP_TEST(EAMForceComputeGPU_compare)
+    {
+    eamforce_creator eam_creator_gpu = bind(gpu_eam_creator, _1, _2, _3);
+    eamforce_creator eam_creator = bind(base_class_eam_creator, _1, _2, _3);
+    eam_force_comparison_test(eam_creator,
+                              NeighborList::half,
+                              eam_creator_gpu,
+                              NeighborList::full,
+                              std::shared_ptr<ExecutionConfiguration>(
+                                  new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+#endif
@@ -2,11 +2,15 @@
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
 #include "Action.h"
+#include "ActionPlugin.h"
 #include "Analyzer.h"
+#include "AutotunerCache.h"
 #include "BondedGroupData.h"
 #include "BoxResizeUpdater.h"
 #include "CellList.h"
 #include "CellListStencil.h"
+#include "CheckpointReader.h"
+#include "CheckpointWriter.h"
 #include "ClockSource.h"
 #include "Compute.h"
 #include "DCDDumpWriter.h"
@@ -15,6 +19,10 @@
 #include "ForceConstraint.h"
 #include "GSDDequeWriter.h"
 #include "GSDDumpWriter.h"
+#include "GSDLogBlockWriter.h"
+#ifdef ENABLE_HDF5
+#include "HDF5LogWriter.h"
+#endif
 #include "GSDReader.h"
 #include "HOOMDMath.h"
 #include "Initializers.h"
@@ -33,6 +41,7 @@
 #include "SnapshotSystemData.h"
 #include "System.h"
 #include "SystemDefinition.h"
+#include "TraceWriter.h"
 #include "Trigger.h"
 #include "Tuner.h"
 #include "Updater.h"
@@ -55,6 +64,7 @@
 #include "CellListGPU.h"
 #include "LoadBalancerGPU.h"
 #include "SFCPackTunerGPU.h"
+#include "UpdaterRemoveDriftGPU.h"
 #include <hip/hip_runtime.h>
 #endif
 
@@ -212,6 +222,7 @@ PYBIND11_MODULE(_hoomd, m)
         .def_static("getCXXCompiler", BuildInfo::getCXXCompiler)
         .def_static("getEnableTBB", BuildInfo::getEnableTBB)
         .def_static("getEnableMPI", BuildInfo::getEnableMPI)
+        .def_static("getEnableHDF5", BuildInfo::getEnableHDF5)
         .def_static("getSourceDir", BuildInfo::getSourceDir)
         .def_static("getInstallDir", BuildInfo::getInstallDir)
         .def_static("getFloatingPointPrecision", BuildInfo::getFloatingPointPrecision);
@@ -287,9 +298,11 @@ PYBIND11_MODULE(_hoomd, m)
 
     // initializers
     export_GSDReader(m);
+    export_CheckpointReader(m);
 
     // computes
     export_Autotuned(m);
+    export_AutotunerCache(m);
     export_Action(m);
     export_Compute(m);
     export_CellList(m);
@@ -309,7 +322,13 @@ PYBIND11_MODULE(_hoomd, m)
     export_Analyzer(m);
     export_PythonAnalyzer(m);
     export_DCDDumpWriter(m);
+    export_CheckpointWriter(m);
+    export_TraceWriter(m);
     export_GSDDumpWriter(m);
+    export_GSDLogBlockWriter(m);
+#ifdef ENABLE_HDF5
+    export_HDF5LogWriter(m);
+#endif
     export_GSDDequeWriter(m);
 
     // updaters
@@ -320,6 +339,7 @@ PYBIND11_MODULE(_hoomd, m)
     export_UpdaterRemoveDrift(m);
 #ifdef ENABLE_HIP
     export_BoxResizeUpdaterGPU(m);
+    export_UpdaterRemoveDriftGPU(m);
 #endif
 
     // tuners
@@ -332,6 +352,9 @@ PYBIND11_MODULE(_hoomd, m)
     export_LoadBalancerGPU(m);
 #endif
 
+    // actions loaded from plugin libraries
+    export_ActionPlugin(m);
+
 #ifdef ENABLE_MPI
     export_Communicator(m);
     export_DomainDecomposition(m);
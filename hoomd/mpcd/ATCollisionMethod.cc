@@ -10,6 +10,11 @@
 #include "hoomd/RNGIdentifiers.h"
 #include "hoomd/RandomNumbers.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 namespace hoomd
     {
 mpcd::ATCollisionMethod::ATCollisionMethod(std::shared_ptr<SystemDefinition> sysdef,
@@ -87,43 +92,63 @@ void mpcd::ATCollisionMethod::drawVelocities(uint64_t timestep)
 
     // random velocities are drawn for each particle and stored into the "alternate" arrays
     const Scalar T = (*m_T)(timestep);
-    for (unsigned int idx = 0; idx < N_tot; ++idx)
-        {
-        unsigned int pidx;
-        unsigned int tag;
-        Scalar mass;
-        if (idx < N_mpcd)
-            {
-            pidx = idx;
-            mass = m_mpcd_pdata->getMass();
-            tag = h_tag.data[idx];
-            }
-        else
+    auto draw_range = [&](unsigned int begin, unsigned int end)
+    {
+        for (unsigned int idx = begin; idx < end; ++idx)
             {
-            pidx = h_embed_idx->data[idx - N_mpcd];
-            mass = h_vel_embed->data[pidx].w;
-            tag = h_tag_embed->data[pidx];
-            }
+            unsigned int pidx;
+            unsigned int tag;
+            Scalar mass;
+            if (idx < N_mpcd)
+                {
+                pidx = idx;
+                mass = m_mpcd_pdata->getMass();
+                tag = h_tag.data[idx];
+                }
+            else
+                {
+                pidx = h_embed_idx->data[idx - N_mpcd];
+                mass = h_vel_embed->data[pidx].w;
+                tag = h_tag_embed->data[pidx];
+                }
 
-        // draw random velocities from normal distribution
-        hoomd::RandomGenerator rng(
-            hoomd::Seed(hoomd::RNGIdentifier::ATCollisionMethod, timestep, seed),
-            hoomd::Counter(tag));
-        hoomd::NormalDistribution<Scalar> gen(fast::sqrt(T / mass), 0.0);
-        Scalar3 vel;
-        gen(vel.x, vel.y, rng);
-        vel.z = gen(rng);
+            // draw random velocities from normal distribution
+            hoomd::RandomGenerator rng(
+                hoomd::Seed(hoomd::RNGIdentifier::ATCollisionMethod, timestep, seed),
+                hoomd::Counter(tag));
+            hoomd::NormalDistribution<Scalar> gen(fast::sqrt(T / mass), 0.0);
+            Scalar3 vel;
+            gen(vel.x, vel.y, rng);
+            vel.z = gen(rng);
 
-        // save out velocities
-        if (idx < N_mpcd)
-            {
-            h_alt_vel.data[pidx]
-                = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(mpcd::detail::NO_CELL));
+            // save out velocities
+            if (idx < N_mpcd)
+                {
+                h_alt_vel.data[pidx]
+                    = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(mpcd::detail::NO_CELL));
+                }
+            else
+                {
+                h_alt_vel_embed->data[pidx] = make_scalar4(vel.x, vel.y, vel.z, mass);
+                }
             }
-        else
+    };
+
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        m_exec_conf->getTaskArena()->execute(
+            [&]
             {
-            h_alt_vel_embed->data[pidx] = make_scalar4(vel.x, vel.y, vel.z, mass);
-            }
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N_tot),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  { draw_range(r.begin(), r.end()); });
+            });
+        }
+    else
+#endif
+        {
+        draw_range(0, N_tot);
         }
     }
 
@@ -168,41 +193,62 @@ void mpcd::ATCollisionMethod::applyVelocities()
                                     access_location::host,
                                     access_mode::read);
 
-    for (unsigned int idx = 0; idx < N_tot; ++idx)
-        {
-        unsigned int cell, pidx;
-        Scalar4 vel_rand;
-        if (idx < N_mpcd)
-            {
-            pidx = idx;
-            const Scalar4 vel_cell = h_vel.data[idx];
-            cell = __scalar_as_int(vel_cell.w);
-            vel_rand = h_vel_alt.data[idx];
-            }
-        else
+    // each particle is updated independently using the properties of its cell
+    auto apply_range = [&](unsigned int begin, unsigned int end)
+    {
+        for (unsigned int idx = begin; idx < end; ++idx)
             {
-            pidx = h_embed_idx->data[idx - N_mpcd];
-            cell = h_embed_cell_ids->data[idx - N_mpcd];
-            vel_rand = h_vel_alt_embed->data[pidx];
-            }
+            unsigned int cell, pidx;
+            Scalar4 vel_rand;
+            if (idx < N_mpcd)
+                {
+                pidx = idx;
+                const Scalar4 vel_cell = h_vel.data[idx];
+                cell = __scalar_as_int(vel_cell.w);
+                vel_rand = h_vel_alt.data[idx];
+                }
+            else
+                {
+                pidx = h_embed_idx->data[idx - N_mpcd];
+                cell = h_embed_cell_ids->data[idx - N_mpcd];
+                vel_rand = h_vel_alt_embed->data[pidx];
+                }
 
-        // load cell data
-        const double4 v_c = h_cell_vel.data[cell];
-        const double4 vrand_c = h_rand_vel.data[cell];
+            // load cell data
+            const double4 v_c = h_cell_vel.data[cell];
+            const double4 vrand_c = h_rand_vel.data[cell];
 
-        // compute new velocity using the cell + the random draw
-        const Scalar3 vnew = make_scalar3(v_c.x - vrand_c.x + vel_rand.x,
-                                          v_c.y - vrand_c.y + vel_rand.y,
-                                          v_c.z - vrand_c.z + vel_rand.z);
+            // compute new velocity using the cell + the random draw
+            const Scalar3 vnew = make_scalar3(v_c.x - vrand_c.x + vel_rand.x,
+                                              v_c.y - vrand_c.y + vel_rand.y,
+                                              v_c.z - vrand_c.z + vel_rand.z);
 
-        if (idx < N_mpcd)
-            {
-            h_vel.data[pidx] = make_scalar4(vnew.x, vnew.y, vnew.z, __int_as_scalar(cell));
+            if (idx < N_mpcd)
+                {
+                h_vel.data[pidx] = make_scalar4(vnew.x, vnew.y, vnew.z, __int_as_scalar(cell));
+                }
+            else
+                {
+                h_vel_embed->data[pidx] = make_scalar4(vnew.x, vnew.y, vnew.z, vel_rand.w);
+                }
             }
-        else
+    };
+
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        m_exec_conf->getTaskArena()->execute(
+            [&]
             {
-            h_vel_embed->data[pidx] = make_scalar4(vnew.x, vnew.y, vnew.z, vel_rand.w);
-            }
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N_tot),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  { apply_range(r.begin(), r.end()); });
+            });
+        }
+    else
+#endif
+        {
+        apply_range(0, N_tot);
         }
     }
 
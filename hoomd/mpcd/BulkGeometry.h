@@ -62,6 +62,17 @@ class __attribute__((visibility("default"))) BulkGeometry
         return false;
         }
 
+    //! Check if a region lies entirely out of bounds
+    /*!
+     * \param lo Lower bound of the region
+     * \param hi Upper bound of the region
+     * \returns False because every region is in bounds in the bulk geometry.
+     */
+    HOSTDEVICE bool isCellOutside(const Scalar3& lo, const Scalar3& hi) const
+        {
+        return false;
+        }
+
     //! Validate the simulation box
     /*!
      * \returns True because the simulation box is always big enough to hold a bulk geometry.
@@ -0,0 +1,107 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+/*!
+ * \file mpcd/CellBinner.h
+ * \brief Definition of mpcd::detail::CellBinner
+ */
+
+#ifndef MPCD_CELL_BINNER_H_
+#define MPCD_CELL_BINNER_H_
+
+#include "ParticleDataUtilities.h"
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/Index1D.h"
+
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__ inline
+#else
+#define HOSTDEVICE inline __attribute__((always_inline))
+#endif // __HIPCC__
+
+namespace hoomd
+    {
+namespace mpcd
+    {
+namespace detail
+    {
+//! Bins positions into the local cells of an MPCD cell list
+/*!
+ * The binner is a copy of the cell list geometry, including the grid shift, at the time it was
+ * made by mpcd::CellList::getBinner(). It lets code outside the cell list (e.g., a streaming
+ * method) bin particles exactly like the cell list does on both the CPU and the GPU.
+ */
+struct CellBinner
+    {
+    uchar3 periodic;      //!< Flags if the local simulation box is periodic
+    int3 origin_idx;      //!< Global origin index for the local box
+    Scalar3 grid_shift;   //!< Random grid shift vector
+    Scalar3 global_lo;    //!< Lower bound of global orthorhombic simulation box
+    uint3 n_global_cells; //!< Global dimensions of the cell list, including padding
+    Scalar cell_size;     //!< Cell width
+    Index3D cell_indexer; //!< Indexer for the local cells
+
+    //! Bin a position into its local cell
+    /*!
+     * \param pos Particle position, which must not be NaN
+     * \returns Index of the local cell holding \a pos, or mpcd::detail::NO_CELL if \a pos lies
+     *          outside the local cells
+     */
+    HOSTDEVICE unsigned int operator()(const Scalar3& pos) const
+        {
+        // bin particle with grid shift assuming orthorhombic box (already validated)
+        const Scalar3 delta = (pos - grid_shift) - global_lo;
+        int3 global_bin = make_int3((int)slow::floor(delta.x / cell_size),
+                                    (int)slow::floor(delta.y / cell_size),
+                                    (int)slow::floor(delta.z / cell_size));
+
+        // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range)
+        // this is done using periodic from the "local" box, since this will be periodic
+        // only when there is one rank along the dimension
+        if (periodic.x)
+            {
+            if (global_bin.x == (int)n_global_cells.x)
+                global_bin.x = 0;
+            else if (global_bin.x == -1)
+                global_bin.x = n_global_cells.x - 1;
+            }
+        if (periodic.y)
+            {
+            if (global_bin.y == (int)n_global_cells.y)
+                global_bin.y = 0;
+            else if (global_bin.y == -1)
+                global_bin.y = n_global_cells.y - 1;
+            }
+        if (periodic.z)
+            {
+            if (global_bin.z == (int)n_global_cells.z)
+                global_bin.z = 0;
+            else if (global_bin.z == -1)
+                global_bin.z = n_global_cells.z - 1;
+            }
+
+        // compute the local cell
+        const int3 bin = make_int3(global_bin.x - origin_idx.x,
+                                   global_bin.y - origin_idx.y,
+                                   global_bin.z - origin_idx.z);
+
+        // validate and make sure no particles blew out of the box
+        if ((bin.x < 0 || bin.x >= (int)cell_indexer.getW())
+            || (bin.y < 0 || bin.y >= (int)cell_indexer.getH())
+            || (bin.z < 0 || bin.z >= (int)cell_indexer.getD()))
+            {
+            return mpcd::detail::NO_CELL;
+            }
+
+        return cell_indexer(bin.x, bin.y, bin.z);
+        }
+    };
+
+    } // end namespace detail
+    } // end namespace mpcd
+    } // end namespace hoomd
+
+#undef HOSTDEVICE
+
+#endif // MPCD_CELL_BINNER_H_
@@ -3,6 +3,15 @@
 
 #include "CellList.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <utility>
+#include <vector>
+#endif
+
 #ifdef ENABLE_MPI
 #include "Communicator.h"
 #include "hoomd/Communicator.h"
@@ -18,6 +27,7 @@ namespace hoomd
 mpcd::CellList::CellList(std::shared_ptr<SystemDefinition> sysdef)
     : Compute(sysdef), m_mpcd_pdata(m_sysdef->getMPCDParticleData()), m_cell_size(1.0),
       m_cell_np_max(4), m_cell_np(m_exec_conf), m_cell_list(m_exec_conf),
+      m_cell_slot(m_exec_conf), m_n_stored_cells(0), m_sparse(false),
       m_embed_cell_ids(m_exec_conf), m_conditions(m_exec_conf), m_needs_compute_dim(true),
       m_particles_sorted(false), m_virtual_change(false)
     {
@@ -125,12 +135,65 @@ void mpcd::CellList::compute(uint64_t timestep)
         }
     }
 
+/*!
+ * \param timestep Timestep the cell list was built for
+ *
+ * The streaming method has filled the cell list, the cell sizes, the stashed cell ids, and the
+ * condition flags from getConditions() for the particle positions at \a timestep. The cell list is
+ * marked as computed at \a timestep unless it overflowed. In that case, memory is reallocated and
+ * the next call to compute() rebuilds the cell list from scratch.
+ */
+void mpcd::CellList::finishStreamingBuild(uint64_t timestep)
+    {
+    if (checkConditions())
+        {
+        reallocate();
+        resetConditions();
+        return;
+        }
+
+    m_first_compute = false;
+    m_force_compute = false;
+    m_last_computed = timestep;
+
+    // signal to the ParticleData that the cell list cache is now valid
+    m_mpcd_pdata->validateCellCache();
+    }
+
+/*!
+ * \returns A binner for the current cell list dimensions and grid shift
+ */
+mpcd::detail::CellBinner mpcd::CellList::getBinner()
+    {
+    mpcd::detail::CellBinner binner;
+    binner.periodic = m_pdata->getBox().getPeriodic();
+    binner.origin_idx = m_origin_idx;
+    binner.grid_shift = m_grid_shift;
+    binner.global_lo = m_pdata->getGlobalBox().getLo();
+    binner.cell_size = m_cell_size;
+    binner.cell_indexer = m_cell_indexer;
+
+    // total effective number of cells in the global box, optionally padded by
+    // extra cells in MPI simulations
+    binner.n_global_cells = m_global_cell_dim;
+#ifdef ENABLE_MPI
+    if (isCommunicating(mpcd::detail::face::east))
+        binner.n_global_cells.x += 2 * m_num_extra;
+    if (isCommunicating(mpcd::detail::face::north))
+        binner.n_global_cells.y += 2 * m_num_extra;
+    if (isCommunicating(mpcd::detail::face::up))
+        binner.n_global_cells.z += 2 * m_num_extra;
+#endif // ENABLE_MPI
+
+    return binner;
+    }
+
 void mpcd::CellList::reallocate()
     {
     m_exec_conf->msg->notice(6) << "Allocating MPCD cell list, " << m_cell_np_max
-                                << " particles in " << m_cell_indexer.getNumElements() << " cells."
-                                << std::endl;
-    m_cell_list_indexer = Index2D(m_cell_np_max, m_cell_indexer.getNumElements());
+                                << " particles in " << m_n_stored_cells << " of "
+                                << m_cell_indexer.getNumElements() << " cells." << std::endl;
+    m_cell_list_indexer = Index2D(m_cell_np_max, m_n_stored_cells);
     m_cell_list.resize(m_cell_list_indexer.getNumElements());
     }
 
@@ -303,6 +366,7 @@ void mpcd::CellList::computeDimensions()
     m_global_cell_indexer = Index3D(m_global_cell_dim.x, m_global_cell_dim.y, m_global_cell_dim.z);
     m_cell_indexer = Index3D(m_cell_dim.x, m_cell_dim.y, m_cell_dim.z);
     m_cell_np.resize(m_cell_indexer.getNumElements());
+    updateCellSlots();
 
     // reallocate per-cell memory
     reallocate();
@@ -312,6 +376,72 @@ void mpcd::CellList::computeDimensions()
     notifySizeChange();
     }
 
+/*!
+ * Every cell is stored at its own index unless the cell list is sparse and has a mask. Then, the
+ * cells are stored in order, skipping the cells whose region cannot hold particles. The region of
+ * a cell is padded by one cell size, which covers the virtual particles that the fillers place
+ * beyond the walls, and by twice the maximum grid shift, so the mask holds for every grid shift.
+ * Cells whose padded region extends past a periodic boundary of the global box are always stored.
+ */
+void mpcd::CellList::updateCellSlots()
+    {
+    const unsigned int ncells = m_cell_indexer.getNumElements();
+    m_cell_slot.resize(ncells);
+    ArrayHandle<unsigned int> h_cell_slot(m_cell_slot,
+                                          access_location::host,
+                                          access_mode::overwrite);
+
+    if (!m_sparse || !m_cell_mask)
+        {
+        for (unsigned int idx = 0; idx < ncells; ++idx)
+            {
+            h_cell_slot.data[idx] = idx;
+            }
+        m_n_stored_cells = ncells;
+        return;
+        }
+
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const Scalar3 global_lo = global_box.getLo();
+    const Scalar3 global_hi = global_box.getHi();
+    const Scalar pad = m_cell_size + Scalar(2.0) * m_max_grid_shift;
+    const bool is_2d = (m_sysdef->getNDimensions() == 2);
+
+    m_n_stored_cells = 0;
+    for (unsigned int idx = 0; idx < ncells; ++idx)
+        {
+        const uint3 local = m_cell_indexer.getTriple(idx);
+        const int3 global = getGlobalCell(make_int3(local.x, local.y, local.z));
+
+        Scalar3 lo = global_lo
+                     + make_scalar3(global.x * m_cell_size - pad,
+                                    global.y * m_cell_size - pad,
+                                    global.z * m_cell_size - pad);
+        Scalar3 hi = lo + make_scalar3(m_cell_size + 2 * pad,
+                                       m_cell_size + 2 * pad,
+                                       m_cell_size + 2 * pad);
+        if (is_2d)
+            {
+            lo.z = global_lo.z;
+            hi.z = global_hi.z;
+            }
+
+        const bool in_box = (lo.x >= global_lo.x && hi.x <= global_hi.x && lo.y >= global_lo.y
+                             && hi.y <= global_hi.y && lo.z >= global_lo.z && hi.z <= global_hi.z);
+        if (in_box && m_cell_mask(lo, hi))
+            {
+            h_cell_slot.data[idx] = mpcd::detail::NO_CELL;
+            }
+        else
+            {
+            h_cell_slot.data[idx] = m_n_stored_cells++;
+            }
+        }
+
+    m_exec_conf->msg->notice(6) << "MPCD cell list stores " << m_n_stored_cells << " of " << ncells
+                                << " cells." << std::endl;
+    }
+
 #ifdef ENABLE_MPI
 void mpcd::CellList::checkDomainBoundaries()
     {
@@ -522,13 +652,11 @@ bool mpcd::CellList::isCommunicating(mpcd::detail::face dir)
  */
 void mpcd::CellList::buildCellList()
     {
-    const BoxDim& box = m_pdata->getBox();
-    const uchar3 periodic = box.getPeriodic();
-
     ArrayHandle<unsigned int> h_cell_list(m_cell_list,
                                           access_location::host,
                                           access_mode::overwrite);
     ArrayHandle<unsigned int> h_cell_np(m_cell_np, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_cell_slot(m_cell_slot, access_location::host, access_mode::read);
     // zero the cell counter
     memset(h_cell_np.data, 0, sizeof(unsigned int) * m_cell_indexer.getNumElements());
 
@@ -561,22 +689,12 @@ void mpcd::CellList::buildCellList()
         N_tot += m_embed_group->getNumMembers();
         }
 
-    // total effective number of cells in the global box, optionally padded by
-    // extra cells in MPI simulations
-    uint3 n_global_cells = m_global_cell_dim;
-#ifdef ENABLE_MPI
-    if (isCommunicating(mpcd::detail::face::east))
-        n_global_cells.x += 2 * m_num_extra;
-    if (isCommunicating(mpcd::detail::face::north))
-        n_global_cells.y += 2 * m_num_extra;
-    if (isCommunicating(mpcd::detail::face::up))
-        n_global_cells.z += 2 * m_num_extra;
-#endif // ENABLE_MPI
+    const mpcd::detail::CellBinner binner = getBinner();
 
-    const Scalar3 global_lo = m_pdata->getGlobalBox().getLo();
-
-    for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
-        {
+    // bins a particle into its local cell and stashes the cell index with the particle, returning
+    // NO_CELL and flagging the error in conditions when the particle cannot be binned
+    auto bin_particle = [&](unsigned int cur_p, uint3& conditions) -> unsigned int
+    {
         Scalar4 postype_i;
         if (cur_p < N_mpcd)
             {
@@ -590,64 +708,16 @@ void mpcd::CellList::buildCellList()
 
         if (std::isnan(pos_i.x) || std::isnan(pos_i.y) || std::isnan(pos_i.z))
             {
-            conditions.y = cur_p + 1;
-            continue;
+            conditions.y = std::max(conditions.y, cur_p + 1);
+            return mpcd::detail::NO_CELL;
             }
 
-        // bin particle assuming orthorhombic box (already validated)
-        const Scalar3 delta = (pos_i - m_grid_shift) - global_lo;
-        int3 global_bin = make_int3((int)std::floor(delta.x / m_cell_size),
-                                    (int)std::floor(delta.y / m_cell_size),
-                                    (int)std::floor(delta.z / m_cell_size));
-
-        // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range)
-        // this is done using periodic from the "local" box, since this will be periodic
-        // only when there is one rank along the dimension
-        if (periodic.x)
-            {
-            if (global_bin.x == (int)n_global_cells.x)
-                global_bin.x = 0;
-            else if (global_bin.x == -1)
-                global_bin.x = n_global_cells.x - 1;
-            }
-        if (periodic.y)
-            {
-            if (global_bin.y == (int)n_global_cells.y)
-                global_bin.y = 0;
-            else if (global_bin.y == -1)
-                global_bin.y = n_global_cells.y - 1;
-            }
-        if (periodic.z)
-            {
-            if (global_bin.z == (int)n_global_cells.z)
-                global_bin.z = 0;
-            else if (global_bin.z == -1)
-                global_bin.z = n_global_cells.z - 1;
-            }
-
-        // compute the local cell
-        int3 bin = make_int3(global_bin.x - m_origin_idx.x,
-                             global_bin.y - m_origin_idx.y,
-                             global_bin.z - m_origin_idx.z);
-
-        // validate and make sure no particles blew out of the box
-        if ((bin.x < 0 || bin.x >= (int)m_cell_dim.x) || (bin.y < 0 || bin.y >= (int)m_cell_dim.y)
-            || (bin.z < 0 || bin.z >= (int)m_cell_dim.z))
-            {
-            conditions.z = cur_p + 1;
-            continue;
-            }
-
-        unsigned int bin_idx = m_cell_indexer(bin.x, bin.y, bin.z);
-        unsigned int offset = h_cell_np.data[bin_idx];
-        if (offset < m_cell_np_max)
-            {
-            h_cell_list.data[m_cell_list_indexer(offset, bin_idx)] = cur_p;
-            }
-        else
+        // validate and make sure no particles blew out of the box or into a cell that is not stored
+        const unsigned int bin_idx = binner(pos_i);
+        if (bin_idx == mpcd::detail::NO_CELL || h_cell_slot.data[bin_idx] == mpcd::detail::NO_CELL)
             {
-            // overflow
-            conditions.x = std::max(conditions.x, offset + 1);
+            conditions.z = std::max(conditions.z, cur_p + 1);
+            return mpcd::detail::NO_CELL;
             }
 
         // stash the current particle bin into the velocity array
@@ -660,8 +730,100 @@ void mpcd::CellList::buildCellList()
             h_embed_cell_ids->data[cur_p - N_mpcd] = bin_idx;
             }
 
-        // increment the counter always
-        ++h_cell_np.data[bin_idx];
+        return bin_idx;
+    };
+
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                // bin the particles in parallel, keyed by (cell, particle)
+                std::vector<std::pair<unsigned int, unsigned int>> keys(N_tot);
+                tbb::enumerable_thread_specific<uint3> thread_conditions(make_uint3(0, 0, 0));
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N_tot),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  {
+                                      uint3& cond = thread_conditions.local();
+                                      for (unsigned int cur_p = r.begin(); cur_p != r.end();
+                                           ++cur_p)
+                                          {
+                                          keys[cur_p] = std::make_pair(bin_particle(cur_p, cond),
+                                                                       cur_p);
+                                          }
+                                  });
+
+                // group the members of each cell in increasing particle order, which is the order
+                // of the serial build. The keys are nearly sorted when the Sorter has placed the
+                // particles in cell order, so this is cheap.
+                tbb::parallel_sort(keys.begin(), keys.end());
+
+                // the first key of each cell owns the cell and writes all of its members, so no
+                // two threads write to the same cell
+                tbb::parallel_for(
+                    tbb::blocked_range<unsigned int>(0, N_tot),
+                    [&](const tbb::blocked_range<unsigned int>& r)
+                    {
+                        uint3& cond = thread_conditions.local();
+                        for (unsigned int i = r.begin(); i != r.end(); ++i)
+                            {
+                            const unsigned int bin_idx = keys[i].first;
+                            if (bin_idx == mpcd::detail::NO_CELL
+                                || (i > 0 && keys[i - 1].first == bin_idx))
+                                continue;
+
+                            unsigned int np = 0;
+                            for (unsigned int k = i; k < N_tot && keys[k].first == bin_idx; ++k)
+                                {
+                                if (np < m_cell_np_max)
+                                    {
+                                    h_cell_list.data[m_cell_list_indexer(
+                                        np,
+                                        h_cell_slot.data[bin_idx])]
+                                        = keys[k].second;
+                                    }
+                                ++np;
+                                }
+                            h_cell_np.data[bin_idx] = np;
+
+                            // overflow
+                            if (np > m_cell_np_max)
+                                cond.x = std::max(cond.x, np);
+                            }
+                    });
+
+                for (const uint3& cond : thread_conditions)
+                    {
+                    conditions.x = std::max(conditions.x, cond.x);
+                    conditions.y = std::max(conditions.y, cond.y);
+                    conditions.z = std::max(conditions.z, cond.z);
+                    }
+            });
+        }
+    else
+#endif
+        {
+        for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
+            {
+            const unsigned int bin_idx = bin_particle(cur_p, conditions);
+            if (bin_idx == mpcd::detail::NO_CELL)
+                continue;
+
+            unsigned int offset = h_cell_np.data[bin_idx];
+            if (offset < m_cell_np_max)
+                {
+                h_cell_list.data[m_cell_list_indexer(offset, h_cell_slot.data[bin_idx])] = cur_p;
+                }
+            else
+                {
+                // overflow
+                conditions.x = std::max(conditions.x, offset + 1);
+                }
+
+            // increment the counter always
+            ++h_cell_np.data[bin_idx];
+            }
         }
 
     // write out the conditions
@@ -693,6 +855,7 @@ void mpcd::CellList::sort(uint64_t timestep,
     // iterate through particles in cell list, and update their indexes using reverse mapping
     ArrayHandle<unsigned int> h_rorder(rorder, access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_cell_np(m_cell_np, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_cell_slot(m_cell_slot, access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_cell_list(m_cell_list,
                                           access_location::host,
                                           access_mode::readwrite);
@@ -703,7 +866,7 @@ void mpcd::CellList::sort(uint64_t timestep,
         const unsigned int np = h_cell_np.data[idx];
         for (unsigned int offset = 0; offset < np; ++offset)
             {
-            const unsigned int cl_idx = m_cell_list_indexer(offset, idx);
+            const unsigned int cl_idx = m_cell_list_indexer(offset, h_cell_slot.data[idx]);
             const unsigned int pid = h_cell_list.data[cl_idx];
             // only update indexes of MPCD particles, not virtual or embedded particles
             if (pid < N_mpcd)
@@ -796,18 +959,14 @@ bool mpcd::CellList::checkConditions()
         {
         unsigned int n = conditions.z - 1;
         Scalar4 pos_empty_i;
+        std::string kind;
         if (n < m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual())
             {
             ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(),
                                        access_location::host,
                                        access_mode::read);
             pos_empty_i = h_pos.data[n];
-            if (n < m_mpcd_pdata->getN())
-                m_exec_conf->msg->errorAllRanks()
-                    << "MPCD particle is no longer in the simulation box" << std::endl;
-            else
-                m_exec_conf->msg->errorAllRanks()
-                    << "MPCD virtual particle is no longer in the simulation box" << std::endl;
+            kind = (n < m_mpcd_pdata->getN()) ? "MPCD particle" : "MPCD virtual particle";
             }
         else
             {
@@ -821,11 +980,21 @@ bool mpcd::CellList::checkConditions()
                 = h_pos_embed
                       .data[h_embed_member_idx
                                 .data[n - (m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual())]];
-            m_exec_conf->msg->errorAllRanks()
-                << "Embedded particle is no longer in the simulation box" << std::endl;
+            kind = "Embedded particle";
             }
 
         Scalar3 pos = make_scalar3(pos_empty_i.x, pos_empty_i.y, pos_empty_i.z);
+        if (getBinner()(pos) != mpcd::detail::NO_CELL)
+            {
+            // the particle is in the box, so its cell is not stored by the sparse cell list
+            m_exec_conf->msg->errorAllRanks()
+                << kind << " lies in a cell that the sparse cell list does not store" << std::endl;
+            }
+        else
+            {
+            m_exec_conf->msg->errorAllRanks()
+                << kind << " is no longer in the simulation box" << std::endl;
+            }
         m_exec_conf->msg->errorAllRanks()
             << "Cartesian coordinates: " << std::endl
             << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl
@@ -932,6 +1101,7 @@ void mpcd::detail::export_CellList(pybind11::module& m)
     pybind11::class_<mpcd::CellList, Compute, std::shared_ptr<mpcd::CellList>>(m, "CellList")
         .def(pybind11::init<std::shared_ptr<SystemDefinition>>())
         .def_property("cell_size", &mpcd::CellList::getCellSize, &mpcd::CellList::setCellSize)
+        .def_property("sparse", &mpcd::CellList::isSparse, &mpcd::CellList::setSparse)
         .def("setEmbeddedGroup", &mpcd::CellList::setEmbeddedGroup)
         .def("removeEmbeddedGroup", &mpcd::CellList::removeEmbeddedGroup);
     }
@@ -13,6 +13,7 @@
 #error This header cannot be compiled by nvcc
 #endif
 
+#include "CellBinner.h"
 #include "CommunicatorUtilities.h"
 #include "ParticleData.h"
 
@@ -24,6 +25,7 @@
 #include <pybind11/pybind11.h>
 
 #include <array>
+#include <functional>
 
 namespace hoomd
     {
@@ -33,6 +35,14 @@ namespace mpcd
 class PYBIND11_EXPORT CellList : public Compute
     {
     public:
+    //! Function that tests if no particle can lie in a region of space
+    /*!
+     * The arguments are the lower and upper bounds of an orthorhombic region in the global box.
+     * The function returns true only if no MPCD, virtual, or embedded particle can lie in the
+     * region.
+     */
+    typedef std::function<bool(const Scalar3& lo, const Scalar3& hi)> CellMask;
+
     //! Constructor
     CellList(std::shared_ptr<SystemDefinition> sysdef);
 
@@ -76,11 +86,70 @@ class PYBIND11_EXPORT CellList : public Compute
         }
 
     //! Get the cell list indexer
+    /*!
+     * The second index of the cell list indexer is the slot of the cell, see getCellSlots().
+     */
     const Index2D& getCellListIndexer() const
         {
         return m_cell_list_indexer;
         }
 
+    //! Get the slot of each cell in the cell list
+    /*!
+     * The members of a cell are stored in the cell list at its slot. The slot of each cell is
+     * the cell index unless the cell list is sparse, and it is NO_CELL for cells that are not
+     * stored. These cells never hold particles.
+     */
+    const GPUArray<unsigned int>& getCellSlots() const
+        {
+        return m_cell_slot;
+        }
+
+    //! Get the number of cells that have storage in the cell list
+    unsigned int getNStoredCells() const
+        {
+        return m_n_stored_cells;
+        }
+
+    //! Set if only the cells that can hold particles are stored
+    /*!
+     * \param sparse If true, cells that the mask excludes are not stored
+     * \note Calling forces a resize of the cell list on the next update
+     */
+    virtual void setSparse(bool sparse)
+        {
+        if (sparse != m_sparse)
+            {
+            m_sparse = sparse;
+            m_needs_compute_dim = true;
+            }
+        }
+
+    //! Check if only the cells that can hold particles are stored
+    bool isSparse() const
+        {
+        return m_sparse;
+        }
+
+    //! Set the function that excludes cells from a sparse cell list
+    /*!
+     * \param mask Function that tests if no particle can lie in a region
+     *
+     * The streaming method sets the mask from its geometry.
+     */
+    void setCellMask(const CellMask& mask)
+        {
+        m_cell_mask = mask;
+        if (m_sparse)
+            m_needs_compute_dim = true;
+        }
+
+    //! Remove the function that excludes cells from a sparse cell list
+    void removeCellMask()
+        {
+        setCellMask(CellMask());
+        }
+
     //! Get the number of cells in each dimension
     const uint3& getDim() const
         {
@@ -198,6 +267,32 @@ class PYBIND11_EXPORT CellList : public Compute
         return m_grid_shift;
         }
 
+    //! Get a binner for the current cell list dimensions and grid shift
+    mpcd::detail::CellBinner getBinner();
+
+    //! Check if the cell list can be built by a streaming method for the next compute
+    /*!
+     * \returns True if the next compute() will rebuild the cell list from the MPCD particle
+     *          positions alone with the current dimensions.
+     *
+     * Embedded particles are not moved by the streaming method, and pending changes to the cell
+     * dimensions, virtual particles, or particle order are applied by compute().
+     */
+    bool canBuildWhileStreaming() const
+        {
+        return !m_embed_group && !m_needs_compute_dim && !m_virtual_change && !m_particles_sorted
+               && !m_first_compute;
+        }
+
+    //! Get the flags that report errors and overflows while building the cell list
+    GPUFlags<uint3>& getConditions()
+        {
+        return m_conditions;
+        }
+
+    //! Finish building a cell list that was filled by a streaming method
+    void finishStreamingBuild(uint64_t timestep);
+
     //! Calculate current cell occupancy statistics
     virtual void getCellStatistics() const;
 
@@ -258,6 +353,10 @@ class PYBIND11_EXPORT CellList : public Compute
     unsigned int m_cell_np_max;    //!< Maximum number of particles per cell
     GPUVector<unsigned int> m_cell_np;        //!< Number of particles per cell
     GPUVector<unsigned int> m_cell_list;      //!< Cell list of particles
+    GPUVector<unsigned int> m_cell_slot;      //!< Slot of each cell in the cell list
+    unsigned int m_n_stored_cells;            //!< Number of cells stored in the cell list
+    bool m_sparse;                            //!< If true, only store cells the mask allows
+    CellMask m_cell_mask;                     //!< Excludes cells from a sparse cell list
     GPUVector<unsigned int> m_embed_cell_ids; //!< Cell ids of the embedded particles
     GPUFlags<uint3> m_conditions; //!< Detect conditions that might fail building cell list
 
@@ -318,6 +417,9 @@ class PYBIND11_EXPORT CellList : public Compute
     //! Update global simulation box and check that cell list is compatible with it
     void updateGlobalBox();
 
+    //! Assign the slot of each cell in the cell list
+    void updateCellSlots();
+
 #ifdef ENABLE_MPI
     std::shared_ptr<DomainDecomposition> m_decomposition;
 
@@ -29,6 +29,19 @@ class PYBIND11_EXPORT CellListGPU : public mpcd::CellList
 
     virtual ~CellListGPU();
 
+    //! Set if only the cells that can hold particles are stored
+    /*!
+     * \param sparse If true, cells that the mask excludes are not stored
+     * \throws std::runtime_error if \a sparse is true, the GPU cell list is always dense
+     */
+    virtual void setSparse(bool sparse)
+        {
+        if (sparse)
+            {
+            throw std::runtime_error("The sparse MPCD cell list is not supported on the GPU.");
+            }
+        }
+
     protected:
     //! Compute the cell list of particles on the GPU
     virtual void buildCellList();
@@ -9,6 +9,11 @@
 #include "CellThermoCompute.h"
 #include "ReductionOperators.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 namespace hoomd
     {
 /*!
@@ -18,7 +23,7 @@ mpcd::CellThermoCompute::CellThermoCompute(std::shared_ptr<SystemDefinition> sys
                                            std::shared_ptr<mpcd::CellList> cl)
     : Compute(sysdef), m_mpcd_pdata(m_sysdef->getMPCDParticleData()), m_cl(cl),
       m_needs_net_reduce(true), m_cell_vel(m_exec_conf), m_cell_energy(m_exec_conf),
-      m_ncells_alloc(0)
+      m_ncells_alloc(0), m_has_streaming_sums(false), m_streaming_sums_timestep(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing MPCD CellThermoCompute" << std::endl;
 
@@ -95,9 +100,18 @@ void mpcd::CellThermoCompute::computeCellProperties(uint64_t timestep)
 
     /*
      * While communication is occurring on the outer cells, do the full calculation
-     * on the inner cells. In non-MPI simulations, only this part happens.
+     * on the inner cells. In non-MPI simulations, only this part happens. If a streaming
+     * method already summed the cells for this timestep, only the sums need to be finished.
      */
-    calcInnerCellProperties();
+    if (m_has_streaming_sums && m_streaming_sums_timestep == timestep)
+        {
+        finishStreamingCellProperties();
+        }
+    else
+        {
+        calcInnerCellProperties();
+        }
+    m_has_streaming_sums = false;
 
     /*
      * Execute any additional callbacks that can be overlapped with outer communication.
@@ -137,6 +151,7 @@ struct CellPropertySum
     /*!
      * \param cell_list_ Cell list
      * \param cell_np_ Number of particles per cell
+     * \param cell_slot_ Slot of each cell in the cell list
      * \param cli_ Cell list indexer
      * \param vel_ MPCD particle velocities
      * \param mass_ MPCD mass
@@ -146,13 +161,15 @@ struct CellPropertySum
      */
     CellPropertySum(const unsigned int* cell_list_,
                     const unsigned int* cell_np_,
+                    const unsigned int* cell_slot_,
                     const Index2D& cli_,
                     const Scalar4* vel_,
                     const Scalar mass_,
                     const Scalar4* embed_vel_,
                     const unsigned int* embed_idx_,
                     const unsigned int N_mpcd_)
-        : cell_list(cell_list_), cell_np(cell_np_), cli(cli_), vel(vel_), mass(mass_),
+        : cell_list(cell_list_), cell_np(cell_np_), cell_slot(cell_slot_), cli(cli_), vel(vel_),
+          mass(mass_),
           embed_vel(embed_vel_), embed_idx(embed_idx_), N_mpcd(N_mpcd_)
         {
         }
@@ -178,7 +195,7 @@ struct CellPropertySum
         for (unsigned int offset = 0; offset < np; ++offset)
             {
             // Load particle data
-            const unsigned int cur_p = cell_list[cli(offset, cell)];
+            const unsigned int cur_p = cell_list[cli(offset, cell_slot[cell])];
             double3 vel_i;
             double mass_i;
             if (cur_p < N_mpcd)
@@ -208,6 +225,7 @@ struct CellPropertySum
 
     const unsigned int* cell_list; //!< Cell list
     const unsigned int* cell_np;   //!< Number of particles per cell
+    const unsigned int* cell_slot; //!< Slot of each cell in the cell list
     const Index2D cli;             //!< Cell list indexer
 
     const Scalar4* vel;            //!< MPCD particle velocities
@@ -229,6 +247,9 @@ void mpcd::CellThermoCompute::beginOuterCellProperties()
     ArrayHandle<unsigned int> h_cell_np(m_cl->getCellSizeArray(),
                                         access_location::host,
                                         access_mode::read);
+    ArrayHandle<unsigned int> h_cell_slot(m_cl->getCellSlots(),
+                                          access_location::host,
+                                          access_mode::read);
     const Index2D& cli = m_cl->getCellListIndexer();
 
     // MPCD particle data
@@ -262,6 +283,7 @@ void mpcd::CellThermoCompute::beginOuterCellProperties()
                                       access_mode::read);
     mpcd::detail::CellPropertySum summer(h_cell_list.data,
                                          h_cell_np.data,
+                                         h_cell_slot.data,
                                          cli,
                                          h_vel.data,
                                          mpcd_mass,
@@ -348,6 +370,9 @@ void mpcd::CellThermoCompute::calcInnerCellProperties()
     ArrayHandle<unsigned int> h_cell_np(m_cl->getCellSizeArray(),
                                         access_location::host,
                                         access_mode::read);
+    ArrayHandle<unsigned int> h_cell_slot(m_cl->getCellSlots(),
+                                          access_location::host,
+                                          access_mode::read);
 
     // MPCD particle data
     const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
@@ -377,6 +402,7 @@ void mpcd::CellThermoCompute::calcInnerCellProperties()
                                        access_mode::readwrite);
     mpcd::detail::CellPropertySum summer(h_cell_list.data,
                                          h_cell_np.data,
+                                         h_cell_slot.data,
                                          cli,
                                          h_vel.data,
                                          mpcd_mass,
@@ -408,46 +434,64 @@ void mpcd::CellThermoCompute::calcInnerCellProperties()
         }
 
     // iterate over all of the inner cells and compute average velocity, energy, temperature
+    // each cell only reads its own members, so the cells are independent
     const bool need_energy = m_flags[mpcd::detail::thermo_options::energy];
-    for (unsigned int k = lo.z; k < hi.z; ++k)
-        {
-        for (unsigned int j = lo.y; j < hi.y; ++j)
+    const Index3D inner_ci(hi.x - lo.x, hi.y - lo.y, hi.z - lo.z);
+    auto compute_range = [&](unsigned int begin, unsigned int end)
+    {
+        for (unsigned int inner_idx = begin; inner_idx < end; ++inner_idx)
             {
-            for (unsigned int i = lo.x; i < hi.x; ++i)
+            const uint3 cell = inner_ci.getTriple(inner_idx);
+            const unsigned int cur_cell = ci(cell.x + lo.x, cell.y + lo.y, cell.z + lo.z);
+
+            // compute the cell properties
+            double4 momentum;
+            double ke(0.0);
+            unsigned int np(0);
+            summer.compute(momentum, ke, np, cur_cell, need_energy);
+
+            const double mass = momentum.w;
+            double3 vel_cm = make_double3(0.0, 0.0, 0.0);
+            if (mass > 0.)
                 {
-                const unsigned int cur_cell = ci(i, j, k);
-
-                // compute the cell properties
-                double4 momentum;
-                double ke(0.0);
-                unsigned int np(0);
-                summer.compute(momentum, ke, np, cur_cell, need_energy);
+                vel_cm.x = momentum.x / mass;
+                vel_cm.y = momentum.y / mass;
+                vel_cm.z = momentum.z / mass;
+                }
 
-                const double mass = momentum.w;
-                double3 vel_cm = make_double3(0.0, 0.0, 0.0);
-                if (mass > 0.)
+            h_cell_vel.data[cur_cell] = make_double4(vel_cm.x, vel_cm.y, vel_cm.z, mass);
+            if (need_energy)
+                {
+                double temp(0.0);
+                if (np > 1)
                     {
-                    vel_cm.x = momentum.x / mass;
-                    vel_cm.y = momentum.y / mass;
-                    vel_cm.z = momentum.z / mass;
+                    const double ke_cm
+                        = 0.5 * mass
+                          * (vel_cm.x * vel_cm.x + vel_cm.y * vel_cm.y + vel_cm.z * vel_cm.z);
+                    temp = 2. * (ke - ke_cm) / (m_sysdef->getNDimensions() * (np - 1));
                     }
+                h_cell_energy.data[cur_cell] = make_double3(ke, temp, __int_as_double(np));
+                }
+            }
+    };
 
-                h_cell_vel.data[cur_cell] = make_double4(vel_cm.x, vel_cm.y, vel_cm.z, mass);
-                if (need_energy)
-                    {
-                    double temp(0.0);
-                    if (np > 1)
-                        {
-                        const double ke_cm
-                            = 0.5 * mass
-                              * (vel_cm.x * vel_cm.x + vel_cm.y * vel_cm.y + vel_cm.z * vel_cm.z);
-                        temp = 2. * (ke - ke_cm) / (m_sysdef->getNDimensions() * (np - 1));
-                        }
-                    h_cell_energy.data[cur_cell] = make_double3(ke, temp, __int_as_double(np));
-                    }
-                } // i
-            }     // j
-        }         // k
+    const unsigned int n_inner = inner_ci.getNumElements();
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_inner),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  { compute_range(r.begin(), r.end()); });
+            });
+        }
+    else
+#endif
+        {
+        compute_range(0, n_inner);
+        }
     }
 
 void mpcd::CellThermoCompute::computeNetProperties()
@@ -566,6 +610,85 @@ void mpcd::CellThermoCompute::updateFlags()
 /*!
  * \param ncells Number of cells
  */
+/*!
+ * The cell property arrays are sized for the current cell list so that a streaming method can
+ * accumulate the total momentum, mass, and kinetic energy of each cell into them.
+ */
+void mpcd::CellThermoCompute::beginStreamingSums()
+    {
+    const unsigned int ncells = m_cl->getNCells();
+    if (ncells != m_ncells_alloc)
+        {
+        reallocate(ncells);
+        }
+    m_has_streaming_sums = false;
+    }
+
+/*!
+ * \param timestep Timestep the sums were accumulated for
+ *
+ * The streaming method has written the total momentum and mass of each cell into the cell
+ * velocities and the total kinetic energy into the cell energies. The sums are only used in
+ * simulations without communication, where all cells are inner cells.
+ */
+void mpcd::CellThermoCompute::finishStreamingSums(uint64_t timestep)
+    {
+#ifdef ENABLE_MPI
+    if (m_use_mpi)
+        return;
+#endif // ENABLE_MPI
+
+    m_has_streaming_sums = true;
+    m_streaming_sums_timestep = timestep;
+    }
+
+/*!
+ * The cell velocities hold the total momentum and mass of each cell, and the cell energies hold
+ * the total kinetic energy. The sums are normalized in place like calcInnerCellProperties(), taking
+ * the number of particles per cell from the cell list.
+ */
+void mpcd::CellThermoCompute::finishStreamingCellProperties()
+    {
+    ArrayHandle<unsigned int> h_cell_np(m_cl->getCellSizeArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<double4> h_cell_vel(m_cell_vel, access_location::host, access_mode::readwrite);
+    ArrayHandle<double3> h_cell_energy(m_cell_energy,
+                                       access_location::host,
+                                       access_mode::readwrite);
+
+    const bool need_energy = m_flags[mpcd::detail::thermo_options::energy];
+    const unsigned int n_dimensions = m_sysdef->getNDimensions();
+    for (unsigned int cur_cell = 0; cur_cell < m_cl->getNCells(); ++cur_cell)
+        {
+        const double4 momentum = h_cell_vel.data[cur_cell];
+        const double mass = momentum.w;
+        double3 vel_cm = make_double3(0.0, 0.0, 0.0);
+        if (mass > 0.)
+            {
+            vel_cm.x = momentum.x / mass;
+            vel_cm.y = momentum.y / mass;
+            vel_cm.z = momentum.z / mass;
+            }
+        h_cell_vel.data[cur_cell] = make_double4(vel_cm.x, vel_cm.y, vel_cm.z, mass);
+
+        if (need_energy)
+            {
+            const double ke = h_cell_energy.data[cur_cell].x;
+            const unsigned int np = h_cell_np.data[cur_cell];
+            double temp(0.0);
+            if (np > 1)
+                {
+                const double ke_cm = 0.5 * mass
+                                     * (vel_cm.x * vel_cm.x + vel_cm.y * vel_cm.y
+                                        + vel_cm.z * vel_cm.z);
+                temp = 2. * (ke - ke_cm) / (n_dimensions * (np - 1));
+                }
+            h_cell_energy.data[cur_cell] = make_double3(ke, temp, __int_as_double(np));
+            }
+        }
+    }
+
 void mpcd::CellThermoCompute::reallocate(unsigned int ncells)
     {
     // Grow arrays to match the size if necessary
@@ -573,6 +696,9 @@ void mpcd::CellThermoCompute::reallocate(unsigned int ncells)
     m_cell_energy.resize(ncells);
 
     m_ncells_alloc = ncells;
+
+    // any accumulated sums were sized for the old cells
+    m_has_streaming_sums = false;
     }
 
 /*!
@@ -47,6 +47,24 @@ class PYBIND11_EXPORT CellThermoCompute : public Compute
         return m_cl->getCellIndexer();
         }
 
+    //! Get the cell list the properties are computed for
+    std::shared_ptr<mpcd::CellList> getCellList() const
+        {
+        return m_cl;
+        }
+
+    //! Prepare for a streaming method to accumulate the cell sums
+    void beginStreamingSums();
+
+    //! Use the cell sums accumulated by a streaming method for the compute at a timestep
+    void finishStreamingSums(uint64_t timestep);
+
+    //! Discard any cell sums accumulated by a streaming method
+    void discardStreamingSums()
+        {
+        m_has_streaming_sums = false;
+        }
+
     //! Get the cell velocities from the last call to compute
     const GPUArray<double4>& getCellVelocities() const
         {
@@ -151,6 +169,9 @@ class PYBIND11_EXPORT CellThermoCompute : public Compute
     //! Calculate the inner cell properties
     virtual void calcInnerCellProperties();
 
+    //! Finish the cell properties from the sums accumulated by a streaming method
+    virtual void finishStreamingCellProperties();
+
     //! Compute the net properties from the cell properties
     virtual void computeNetProperties();
 
@@ -169,6 +190,9 @@ class PYBIND11_EXPORT CellThermoCompute : public Compute
     GPUVector<double3> m_cell_energy; //!< Kinetic energy, unscaled temperature, dof in each cell
     unsigned int m_ncells_alloc;      //!< Number of cells allocated for
 
+    bool m_has_streaming_sums;          //!< True if a streaming method accumulated the cell sums
+    uint64_t m_streaming_sums_timestep; //!< Timestep the streaming method accumulated sums for
+
     Nano::Signal<mpcd::detail::ThermoFlags()> m_flag_signal; //!< Signal for requested flags
     mpcd::detail::ThermoFlags m_flags;                       //!< Requested thermo flags
     //! Updates the requested optional flags
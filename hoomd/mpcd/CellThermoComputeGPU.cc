@@ -34,8 +34,13 @@ mpcd::CellThermoComputeGPU::CellThermoComputeGPU(std::shared_ptr<SystemDefinitio
                                          m_exec_conf,
                                          "mpcd_cell_thermo_stage"));
 
-    m_autotuners.insert(m_autotuners.end(),
-                        {m_begin_tuner, m_end_tuner, m_inner_tuner, m_stage_tuner});
+    m_streaming_tuner.reset(new Autotuner<1>({AutotunerBase::makeBlockSizeRange(m_exec_conf)},
+                                             m_exec_conf,
+                                             "mpcd_cell_thermo_streaming"));
+
+    m_autotuners.insert(
+        m_autotuners.end(),
+        {m_begin_tuner, m_end_tuner, m_inner_tuner, m_stage_tuner, m_streaming_tuner});
     }
 
 mpcd::CellThermoComputeGPU::~CellThermoComputeGPU() { }
@@ -242,6 +247,28 @@ void mpcd::CellThermoComputeGPU::calcInnerCellProperties()
         }
     }
 
+void mpcd::CellThermoComputeGPU::finishStreamingCellProperties()
+    {
+    ArrayHandle<unsigned int> d_cell_np(m_cl->getCellSizeArray(),
+                                        access_location::device,
+                                        access_mode::read);
+    ArrayHandle<double4> d_cell_vel(m_cell_vel, access_location::device, access_mode::readwrite);
+    ArrayHandle<double3> d_cell_energy(m_cell_energy,
+                                       access_location::device,
+                                       access_mode::readwrite);
+    m_streaming_tuner->begin();
+    gpu::finish_streaming_cell_thermo(d_cell_vel.data,
+                                      d_cell_energy.data,
+                                      d_cell_np.data,
+                                      m_cl->getNCells(),
+                                      m_sysdef->getNDimensions(),
+                                      m_flags[mpcd::detail::thermo_options::energy],
+                                      m_streaming_tuner->getParam()[0]);
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_streaming_tuner->end();
+    }
+
 void mpcd::CellThermoComputeGPU::computeNetProperties()
     {
         // first reduce the properties on the rank
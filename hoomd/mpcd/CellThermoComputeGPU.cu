@@ -184,6 +184,61 @@ __global__ void end_cell_thermo(double4* d_cell_vel,
         }
     }
 
+//! Finishes the cell thermo from sums accumulated while streaming
+/*!
+ * \param d_cell_vel Cell momentum and masses, normalized in place to cell velocity
+ * \param d_cell_energy Cell kinetic energy, completed in place with temperature and particles
+ * \param d_cell_np Number of particles per cell
+ * \param Ncell Number of cells
+ * \param n_dimensions Number of dimensions in system
+ *
+ * \tparam need_energy If true, compute the cell-level energy properties.
+ *
+ * \b Implementation details:
+ * Using one thread per cell, the properties are averaged by mass like
+ * mpcd::gpu::kernel::end_cell_thermo, but the number of particles in each cell is read from the
+ * cell list because the streaming method only sums the kinetic energy.
+ */
+template<bool need_energy>
+__global__ void finish_streaming_cell_thermo(double4* d_cell_vel,
+                                             double3* d_cell_energy,
+                                             const unsigned int* d_cell_np,
+                                             const unsigned int Ncell,
+                                             const unsigned int n_dimensions)
+    {
+    // one thread per cell
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= Ncell)
+        return;
+
+    // average cell properties if the cell has mass
+    const double4 cell_vel = d_cell_vel[idx];
+    double3 vel_cm = make_double3(0.0, 0.0, 0.0);
+    const double mass = cell_vel.w;
+    if (mass > 0.)
+        {
+        vel_cm.x = cell_vel.x / mass;
+        vel_cm.y = cell_vel.y / mass;
+        vel_cm.z = cell_vel.z / mass;
+        }
+    d_cell_vel[idx] = make_double4(vel_cm.x, vel_cm.y, vel_cm.z, mass);
+
+    if (need_energy)
+        {
+        const double ke = d_cell_energy[idx].x;
+        const unsigned int np = d_cell_np[idx];
+        double temp(0.0);
+        // temperature is only defined for 2 or more particles
+        if (np > 1)
+            {
+            const double ke_cm
+                = 0.5 * mass * (vel_cm.x * vel_cm.x + vel_cm.y * vel_cm.y + vel_cm.z * vel_cm.z);
+            temp = 2. * (ke - ke_cm) / (n_dimensions * (np - 1));
+            }
+        d_cell_energy[idx] = make_double3(ke, temp, __int_as_double(np));
+        }
+    }
+
 //! Computes the cell thermo for inner cells
 /*!
  * \param d_cell_vel Velocity and mass per cell (output)
@@ -550,6 +605,62 @@ cudaError_t end_cell_thermo(double4* d_cell_vel,
     return cudaSuccess;
     }
 
+/*!
+ * \param d_cell_vel Cell momentum and masses, normalized in place to cell velocity
+ * \param d_cell_energy Cell kinetic energy, completed in place with temperature and particles
+ * \param d_cell_np Number of particles per cell
+ * \param Ncell Number of cells
+ * \param n_dimensions Number of dimensions in system
+ * \param need_energy If true, compute the cell-level energy properties
+ * \param block_size Number of threads per block
+ *
+ * \returns cudaSuccess on completion
+ *
+ * \sa mpcd::gpu::kernel::finish_streaming_cell_thermo
+ */
+cudaError_t finish_streaming_cell_thermo(double4* d_cell_vel,
+                                         double3* d_cell_energy,
+                                         const unsigned int* d_cell_np,
+                                         const unsigned int Ncell,
+                                         const unsigned int n_dimensions,
+                                         const bool need_energy,
+                                         const unsigned int block_size)
+    {
+    if (Ncell == 0)
+        return cudaSuccess;
+
+    if (need_energy)
+        {
+        unsigned int max_block_size_energy;
+        cudaFuncAttributes attr;
+        cudaFuncGetAttributes(
+            &attr,
+            (const void*)mpcd::gpu::kernel::finish_streaming_cell_thermo<true>);
+        max_block_size_energy = attr.maxThreadsPerBlock;
+
+        unsigned int run_block_size = min(block_size, max_block_size_energy);
+        dim3 grid(Ncell / run_block_size + 1);
+        mpcd::gpu::kernel::finish_streaming_cell_thermo<true>
+            <<<grid, run_block_size>>>(d_cell_vel, d_cell_energy, d_cell_np, Ncell, n_dimensions);
+        }
+    else
+        {
+        unsigned int max_block_size_noenergy;
+        cudaFuncAttributes attr;
+        cudaFuncGetAttributes(
+            &attr,
+            (const void*)mpcd::gpu::kernel::finish_streaming_cell_thermo<false>);
+        max_block_size_noenergy = attr.maxThreadsPerBlock;
+
+        unsigned int run_block_size = min(block_size, max_block_size_noenergy);
+        dim3 grid(Ncell / run_block_size + 1);
+        mpcd::gpu::kernel::finish_streaming_cell_thermo<false>
+            <<<grid, run_block_size>>>(d_cell_vel, d_cell_energy, d_cell_np, Ncell, n_dimensions);
+        }
+
+    return cudaSuccess;
+    }
+
 //! Templated launcher for multiple threads-per-cell kernel for inner cells
 /*
  * \param args Common arguments to thermo kernels
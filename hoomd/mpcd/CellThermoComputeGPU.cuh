@@ -104,6 +104,15 @@ cudaError_t end_cell_thermo(double4* d_cell_vel,
                             const bool need_energy,
                             const unsigned int block_size);
 
+//! Kernel driver to finish cell thermo from sums accumulated while streaming
+cudaError_t finish_streaming_cell_thermo(double4* d_cell_vel,
+                                         double3* d_cell_energy,
+                                         const unsigned int* d_cell_np,
+                                         const unsigned int Ncell,
+                                         const unsigned int n_dimensions,
+                                         const bool need_energy,
+                                         const unsigned int block_size);
+
 //! Kernel driver to perform cell thermo compute for inner cells
 cudaError_t inner_cell_thermo(const mpcd::detail::thermo_args_t& args,
                               const Index3D& ci,
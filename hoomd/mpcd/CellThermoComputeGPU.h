@@ -48,14 +48,18 @@ class PYBIND11_EXPORT CellThermoComputeGPU : public mpcd::CellThermoCompute
     //! Calculate the inner cell properties on the GPU
     virtual void calcInnerCellProperties();
 
+    //! Finish the cell properties from the sums accumulated by a streaming method on the GPU
+    virtual void finishStreamingCellProperties();
+
     //! Compute the net properties from the cell properties
     virtual void computeNetProperties();
 
     private:
-    std::shared_ptr<Autotuner<2>> m_begin_tuner; //!< Tuner for cell begin kernel
-    std::shared_ptr<Autotuner<1>> m_end_tuner;   //!< Tuner for cell end kernel
-    std::shared_ptr<Autotuner<2>> m_inner_tuner; //!< Tuner for inner cell compute kernel
-    std::shared_ptr<Autotuner<1>> m_stage_tuner; //!< Tuner for staging net property compute
+    std::shared_ptr<Autotuner<2>> m_begin_tuner;     //!< Tuner for cell begin kernel
+    std::shared_ptr<Autotuner<1>> m_end_tuner;       //!< Tuner for cell end kernel
+    std::shared_ptr<Autotuner<2>> m_inner_tuner;     //!< Tuner for inner cell compute kernel
+    std::shared_ptr<Autotuner<1>> m_stage_tuner;     //!< Tuner for staging net property compute
+    std::shared_ptr<Autotuner<1>> m_streaming_tuner; //!< Tuner for finishing streaming sums
 
     GPUVector<mpcd::detail::cell_thermo_element>
         m_tmp_thermo; //!< Temporary array for holding cell data
@@ -14,6 +14,7 @@
 #endif
 
 #include "CellList.h"
+#include "CellThermoCompute.h"
 
 #include "hoomd/Autotuned.h"
 #include "hoomd/ParticleGroup.h"
@@ -103,6 +104,16 @@ class PYBIND11_EXPORT CollisionMethod : public Autotuned
             }
         }
 
+    //! Get the cell thermo compute used by the collision rule
+    /*!
+     * \returns The cell thermo compute whose cell properties the rule uses for the cell list, or a
+     *          null pointer if the rule does not use one.
+     */
+    virtual std::shared_ptr<mpcd::CellThermoCompute> getCellThermo() const
+        {
+        return std::shared_ptr<mpcd::CellThermoCompute>();
+        }
+
     protected:
     std::shared_ptr<SystemDefinition> m_sysdef;                //!< HOOMD system definition
     std::shared_ptr<hoomd::ParticleData> m_pdata;              //!< HOOMD particle data
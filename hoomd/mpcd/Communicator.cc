@@ -30,7 +30,10 @@ mpcd::Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef)
       m_mpcd_pdata(m_sysdef->getMPCDParticleData()), m_mpi_comm(m_exec_conf->getMPICommunicator()),
       m_decomposition(m_pdata->getDomainDecomposition()), m_is_communicating(false),
       m_check_decomposition(true), m_nneigh(0), m_n_unique_neigh(0), m_sendbuf(m_exec_conf),
-      m_recvbuf(m_exec_conf), m_force_migrate(false)
+      m_recvbuf(m_exec_conf), m_n_keep(0), m_n_send_right(0), m_n_send_left(0),
+      m_n_recv_right(0), m_n_recv_left(0), m_n_recv(0), m_stage_dim(0), m_n_count_reqs(0),
+      m_n_send_reqs(0), m_force_migrate(false), m_migrate_pending(false),
+      m_early_migrate(false), m_early_migrate_timestep(0)
     {
     // initialize array of neighbor processor ids
     assert(m_mpi_comm);
@@ -181,6 +184,9 @@ void mpcd::Communicator::initializeNeighborArrays()
 
 /*!
  * \param timestep Current timestep for communication
+ *
+ * A migration started for \a timestep by beginCommunicate() is not repeated by the next call
+ * unless migration is forced or the global box has changed since it was started.
  */
 void mpcd::Communicator::communicate(uint64_t timestep)
     {
@@ -196,6 +202,9 @@ void mpcd::Communicator::communicate(uint64_t timestep)
         return;
         }
 
+    // complete a migration left pending by beginCommunicate()
+    finishCommunicate();
+
     // Guard to prevent recursive triggering of migration
     m_is_communicating = true;
 
@@ -214,7 +223,15 @@ void mpcd::Communicator::communicate(uint64_t timestep)
     if (!migrate)
         {
         m_migrate_requests.emit_accumulate([&](bool r) { migrate = migrate || r; }, timestep);
+
+        // the particles have already been migrated for this timestep
+        if (migrate && m_early_migrate && m_early_migrate_timestep == timestep
+            && m_early_migrate_box == m_pdata->getGlobalBox())
+            {
+            migrate = false;
+            }
         }
+    m_early_migrate = false;
     if (migrate)
         {
         migrateParticles(timestep);
@@ -224,6 +241,61 @@ void mpcd::Communicator::communicate(uint64_t timestep)
     m_is_communicating = false;
     }
 
+/*!
+ * \param timestep Timestep that the particles are migrated for
+ *
+ * The particles are migrated as in communicate(), but the first messages are left in flight so
+ * that the caller can do other work before calling finishCommunicate(). The particles must not be
+ * accessed until finishCommunicate() returns. A later call to communicate() for \a timestep does
+ * not need to migrate the particles again.
+ */
+void mpcd::Communicator::beginCommunicate(uint64_t timestep)
+    {
+    if (!m_cl)
+        {
+        throw std::runtime_error("Cell list has not been set");
+        }
+
+    if (m_is_communicating || m_migrate_pending)
+        {
+        m_exec_conf->msg->warning()
+            << "MPCD communication currently underway, ignoring request" << std::endl;
+        return;
+        }
+
+    m_is_communicating = true;
+
+    m_cl->computeDimensions();
+    if (m_check_decomposition)
+        {
+        checkDecomposition();
+        m_check_decomposition = false;
+        }
+
+    beginMigrateParticles(timestep);
+    m_force_migrate = false;
+    m_migrate_pending = true;
+    m_early_migrate = true;
+    m_early_migrate_timestep = timestep;
+    m_early_migrate_box = m_pdata->getGlobalBox();
+
+    m_is_communicating = false;
+    }
+
+/*!
+ * Nothing is done if beginCommunicate() has not started a migration.
+ */
+void mpcd::Communicator::finishCommunicate()
+    {
+    if (!m_migrate_pending)
+        return;
+
+    m_is_communicating = true;
+    finishMigrateParticles(m_early_migrate_timestep);
+    m_migrate_pending = false;
+    m_is_communicating = false;
+    }
+
 namespace mpcd
     {
 namespace detail
@@ -254,7 +326,25 @@ class MigratePartitionOp
     } // namespace detail
     } // namespace mpcd
 
+/*!
+ * \param timestep Current timestep
+ *
+ * The migration is started with beginMigrateParticles() and immediately completed with
+ * finishMigrateParticles().
+ */
 void mpcd::Communicator::migrateParticles(uint64_t timestep)
+    {
+    beginMigrateParticles(timestep);
+    finishMigrateParticles(timestep);
+    }
+
+/*!
+ * \param timestep Current timestep
+ *
+ * The particles that have left the local domain are moved into the send buffer, and the messages
+ * for the first communicating dimension are posted without waiting for them to complete.
+ */
+void mpcd::Communicator::beginMigrateParticles(uint64_t timestep)
     {
     if (m_mpcd_pdata->getNVirtual() > 0)
         {
@@ -270,165 +360,48 @@ void mpcd::Communicator::migrateParticles(uint64_t timestep)
 
     // fill send buffer once
     m_mpcd_pdata->removeParticles(m_sendbuf, 0xffffffff, timestep);
+    m_n_recv = 0;
 
-    // fill the buffers and send in each direction
-    unsigned int n_recv = 0;
-    for (unsigned int dim = 0; dim < m_sysdef->getNDimensions(); ++dim)
+    // post the messages of the first stage
+    m_stage_dim = 0;
+    while (m_stage_dim < m_sysdef->getNDimensions()
+           && !isCommunicating(static_cast<mpcd::detail::face>(2 * m_stage_dim)))
+        {
+        ++m_stage_dim;
+        }
+    if (m_stage_dim < m_sysdef->getNDimensions())
+        {
+        postMigrateStage(m_stage_dim);
+        }
+    }
+
+/*!
+ * \param timestep Current timestep
+ *
+ * The stage posted by beginMigrateParticles() is completed, the remaining dimensions are
+ * communicated, and the received particles are added to the particle data.
+ */
+void mpcd::Communicator::finishMigrateParticles(uint64_t timestep)
+    {
+    for (unsigned int dim = m_stage_dim; dim < m_sysdef->getNDimensions(); ++dim)
         {
         if (!isCommunicating(static_cast<mpcd::detail::face>(2 * dim)))
             continue;
 
-        const unsigned int right_mask = 1 << (2 * dim);
-        const unsigned int left_mask = 1 << (2 * dim + 1);
-        const unsigned int stage_mask = right_mask | left_mask;
-
-        // neighbor ranks
-        const unsigned int right_neigh = m_decomposition->getNeighborRank(2 * dim);
-        const unsigned int left_neigh = m_decomposition->getNeighborRank(2 * dim + 1);
-
-        // partition the send buffer by destination, leaving unsent particles at the front
-        unsigned int n_keep, n_send_left, n_send_right;
+        if (dim != m_stage_dim)
             {
-            ArrayHandle<mpcd::detail::pdata_element> h_sendbuf(m_sendbuf,
-                                                               access_location::host,
-                                                               access_mode::readwrite);
-
-            // first, partition off particles that may be sent in either direction
-            mpcd::detail::MigratePartitionOp part_op(stage_mask);
-            auto bound = std::partition(h_sendbuf.data, h_sendbuf.data + m_sendbuf.size(), part_op);
-            n_keep = (unsigned int)(&(*bound) - h_sendbuf.data);
-
-            // then, partition the sent particles into the left and right ranks so that particles
-            // getting sent right come first
-            if (left_neigh != right_neigh)
-                {
-                // partition the remaining particles left and right
-                mpcd::detail::MigratePartitionOp sort_op(left_mask);
-                bound = std::partition(h_sendbuf.data + n_keep,
-                                       h_sendbuf.data + m_sendbuf.size(),
-                                       sort_op);
-                n_send_right = (unsigned int)(&(*bound) - (h_sendbuf.data + n_keep));
-                n_send_left = (unsigned int)(m_sendbuf.size() - n_keep - n_send_right);
-                }
-            else
-                {
-                n_send_right = (unsigned int)(m_sendbuf.size() - n_keep);
-                n_send_left = 0;
-                }
+            postMigrateStage(dim);
             }
-
-        // communicate size of the message that will contain the particle data
-        unsigned int n_recv_left, n_recv_right;
-        if (left_neigh != right_neigh)
-            {
-            m_reqs.resize(4);
-            MPI_Isend(&n_send_right, 1, MPI_UNSIGNED, right_neigh, 0, m_mpi_comm, &m_reqs[0]);
-            MPI_Irecv(&n_recv_right, 1, MPI_UNSIGNED, right_neigh, 0, m_mpi_comm, &m_reqs[1]);
-            MPI_Isend(&n_send_left, 1, MPI_UNSIGNED, left_neigh, 0, m_mpi_comm, &m_reqs[2]);
-            MPI_Irecv(&n_recv_left, 1, MPI_UNSIGNED, left_neigh, 0, m_mpi_comm, &m_reqs[3]);
-            MPI_Waitall(4, m_reqs.data(), MPI_STATUSES_IGNORE);
-            }
-        else
-            {
-            // send right, receive left (same thing, really) only if neighbors match
-            n_recv_right = 0;
-            m_reqs.resize(2);
-            MPI_Isend(&n_send_right, 1, MPI_UNSIGNED, right_neigh, 0, m_mpi_comm, &m_reqs[0]);
-            MPI_Irecv(&n_recv_left, 1, MPI_UNSIGNED, left_neigh, 0, m_mpi_comm, &m_reqs[1]);
-            MPI_Waitall(2, m_reqs.data(), MPI_STATUSES_IGNORE);
-            }
-
-        // exchange particle data
-        m_recvbuf.resize(n_recv + n_recv_left + n_recv_right);
-            {
-            ArrayHandle<mpcd::detail::pdata_element> h_sendbuf(m_sendbuf,
-                                                               access_location::host,
-                                                               access_mode::read);
-            ArrayHandle<mpcd::detail::pdata_element> h_recvbuf(m_recvbuf,
-                                                               access_location::host,
-                                                               access_mode::overwrite);
-            m_reqs.resize(4);
-            int nreq = 0;
-            if (n_send_right != 0)
-                {
-                MPI_Isend(h_sendbuf.data + n_keep,
-                          n_send_right,
-                          m_pdata_element,
-                          right_neigh,
-                          1,
-                          m_mpi_comm,
-                          &m_reqs[nreq++]);
-                }
-            if (n_send_left != 0)
-                {
-                MPI_Isend(h_sendbuf.data + n_keep + n_send_right,
-                          n_send_left,
-                          m_pdata_element,
-                          left_neigh,
-                          1,
-                          m_mpi_comm,
-                          &m_reqs[nreq++]);
-                }
-            if (n_recv_right != 0)
-                {
-                MPI_Irecv(h_recvbuf.data + n_recv,
-                          n_recv_right,
-                          m_pdata_element,
-                          right_neigh,
-                          1,
-                          m_mpi_comm,
-                          &m_reqs[nreq++]);
-                }
-            if (n_recv_left != 0)
-                {
-                MPI_Irecv(h_recvbuf.data + n_recv + n_recv_right,
-                          n_recv_left,
-                          m_pdata_element,
-                          left_neigh,
-                          1,
-                          m_mpi_comm,
-                          &m_reqs[nreq++]);
-                }
-            MPI_Waitall(nreq, m_reqs.data(), MPI_STATUSES_IGNORE);
-            }
-
-            // now we pass through and unpack the particles, either by holding onto them in the
-            // receive buffer or by passing them back into the send buffer for the next stage
-            {
-            // partition the receive buffer so that particles that need to be sent are at the end
-            ArrayHandle<mpcd::detail::pdata_element> h_recvbuf(m_recvbuf,
-                                                               access_location::host,
-                                                               access_mode::readwrite);
-            mpcd::detail::MigratePartitionOp part_op(~stage_mask);
-            auto bound = std::partition(h_recvbuf.data + n_recv,
-                                        h_recvbuf.data + m_recvbuf.size(),
-                                        part_op);
-            n_recv = (unsigned int)(&(*bound) - h_recvbuf.data);
-
-            // move particles to resend over to the send buffer and unset the bits from this stage
-            const unsigned int n_resend = (unsigned int)(m_recvbuf.size() - n_recv);
-            m_sendbuf.resize(n_keep + n_resend);
-            ArrayHandle<mpcd::detail::pdata_element> h_sendbuf(m_sendbuf,
-                                                               access_location::host,
-                                                               access_mode::readwrite);
-            std::copy(h_recvbuf.data + n_recv,
-                      h_recvbuf.data + m_recvbuf.size(),
-                      h_sendbuf.data + n_keep);
-            for (unsigned int idx = n_keep; idx < m_sendbuf.size(); ++idx)
-                {
-                h_sendbuf.data[idx].comm_flag &= ~stage_mask;
-                }
-            }
-        m_recvbuf.resize(n_recv); // free up memory from the end of the receive buffer
-        }                         // end dir loop
+        finishMigrateStage(dim);
+        }
 
         // fill particle data with wrapped, received particles
         {
         ArrayHandle<mpcd::detail::pdata_element> h_recvbuf(m_recvbuf,
                                                            access_location::host,
                                                            access_mode::readwrite);
-        const BoxDim wrap_box = getWrapBox(box);
-        for (unsigned int idx = 0; idx < n_recv; ++idx)
+        const BoxDim wrap_box = getWrapBox(m_cl->getCoverageBox());
+        for (unsigned int idx = 0; idx < m_n_recv; ++idx)
             {
             mpcd::detail::pdata_element& p = h_recvbuf.data[idx];
             Scalar4& postype = p.pos;
@@ -442,6 +415,212 @@ void mpcd::Communicator::migrateParticles(uint64_t timestep)
     m_mpcd_pdata->addParticles(m_recvbuf, 0xffffffff, timestep);
     }
 
+/*!
+ * \param dim Dimension to communicate along
+ *
+ * The send buffer is partitioned by destination, and the sizes and contents of the messages to
+ * the neighbors along \a dim are sent. The sizes of the messages from the neighbors are received
+ * into m_n_recv_right and m_n_recv_left. None of the requests are waited on, so the send buffer
+ * must not be modified until finishMigrateStage() is called.
+ */
+void mpcd::Communicator::postMigrateStage(unsigned int dim)
+    {
+    const unsigned int right_mask = 1 << (2 * dim);
+    const unsigned int left_mask = 1 << (2 * dim + 1);
+    const unsigned int stage_mask = right_mask | left_mask;
+
+    // neighbor ranks
+    const unsigned int right_neigh = m_decomposition->getNeighborRank(2 * dim);
+    const unsigned int left_neigh = m_decomposition->getNeighborRank(2 * dim + 1);
+
+    // partition the send buffer by destination, leaving unsent particles at the front
+    ArrayHandle<mpcd::detail::pdata_element> h_sendbuf(m_sendbuf,
+                                                       access_location::host,
+                                                       access_mode::readwrite);
+
+    // first, partition off particles that may be sent in either direction
+    mpcd::detail::MigratePartitionOp part_op(stage_mask);
+    auto bound = std::partition(h_sendbuf.data, h_sendbuf.data + m_sendbuf.size(), part_op);
+    m_n_keep = (unsigned int)(&(*bound) - h_sendbuf.data);
+
+    // then, partition the sent particles into the left and right ranks so that particles
+    // getting sent right come first
+    if (left_neigh != right_neigh)
+        {
+        // partition the remaining particles left and right
+        mpcd::detail::MigratePartitionOp sort_op(left_mask);
+        bound = std::partition(h_sendbuf.data + m_n_keep,
+                               h_sendbuf.data + m_sendbuf.size(),
+                               sort_op);
+        m_n_send_right = (unsigned int)(&(*bound) - (h_sendbuf.data + m_n_keep));
+        m_n_send_left = (unsigned int)(m_sendbuf.size() - m_n_keep - m_n_send_right);
+        }
+    else
+        {
+        m_n_send_right = (unsigned int)(m_sendbuf.size() - m_n_keep);
+        m_n_send_left = 0;
+        }
+
+    // communicate size of the message that will contain the particle data
+    m_reqs.resize(4);
+    m_n_count_reqs = 0;
+    if (left_neigh != right_neigh)
+        {
+        MPI_Isend(&m_n_send_right,
+                  1,
+                  MPI_UNSIGNED,
+                  right_neigh,
+                  migrate_count_tag,
+                  m_mpi_comm,
+                  &m_reqs[m_n_count_reqs++]);
+        MPI_Irecv(&m_n_recv_right,
+                  1,
+                  MPI_UNSIGNED,
+                  right_neigh,
+                  migrate_count_tag,
+                  m_mpi_comm,
+                  &m_reqs[m_n_count_reqs++]);
+        MPI_Isend(&m_n_send_left,
+                  1,
+                  MPI_UNSIGNED,
+                  left_neigh,
+                  migrate_count_tag,
+                  m_mpi_comm,
+                  &m_reqs[m_n_count_reqs++]);
+        MPI_Irecv(&m_n_recv_left,
+                  1,
+                  MPI_UNSIGNED,
+                  left_neigh,
+                  migrate_count_tag,
+                  m_mpi_comm,
+                  &m_reqs[m_n_count_reqs++]);
+        }
+    else
+        {
+        // send right, receive left (same thing, really) only if neighbors match
+        m_n_recv_right = 0;
+        MPI_Isend(&m_n_send_right,
+                  1,
+                  MPI_UNSIGNED,
+                  right_neigh,
+                  migrate_count_tag,
+                  m_mpi_comm,
+                  &m_reqs[m_n_count_reqs++]);
+        MPI_Irecv(&m_n_recv_left,
+                  1,
+                  MPI_UNSIGNED,
+                  left_neigh,
+                  migrate_count_tag,
+                  m_mpi_comm,
+                  &m_reqs[m_n_count_reqs++]);
+        }
+
+    // the particle data can be sent before the receivers know its size
+    m_send_reqs.resize(2);
+    m_n_send_reqs = 0;
+    if (m_n_send_right != 0)
+        {
+        MPI_Isend(h_sendbuf.data + m_n_keep,
+                  m_n_send_right,
+                  m_pdata_element,
+                  right_neigh,
+                  migrate_data_tag,
+                  m_mpi_comm,
+                  &m_send_reqs[m_n_send_reqs++]);
+        }
+    if (m_n_send_left != 0)
+        {
+        MPI_Isend(h_sendbuf.data + m_n_keep + m_n_send_right,
+                  m_n_send_left,
+                  m_pdata_element,
+                  left_neigh,
+                  migrate_data_tag,
+                  m_mpi_comm,
+                  &m_send_reqs[m_n_send_reqs++]);
+        }
+    }
+
+/*!
+ * \param dim Dimension to communicate along
+ *
+ * The messages posted by postMigrateStage() are completed. The received particles are either kept
+ * in the receive buffer or passed back into the send buffer for the next stage.
+ */
+void mpcd::Communicator::finishMigrateStage(unsigned int dim)
+    {
+    const unsigned int right_mask = 1 << (2 * dim);
+    const unsigned int left_mask = 1 << (2 * dim + 1);
+    const unsigned int stage_mask = right_mask | left_mask;
+
+    // neighbor ranks
+    const unsigned int right_neigh = m_decomposition->getNeighborRank(2 * dim);
+    const unsigned int left_neigh = m_decomposition->getNeighborRank(2 * dim + 1);
+
+    // sizes of the incoming messages
+    MPI_Waitall(m_n_count_reqs, m_reqs.data(), MPI_STATUSES_IGNORE);
+
+    // receive particle data
+    m_recvbuf.resize(m_n_recv + m_n_recv_left + m_n_recv_right);
+        {
+        ArrayHandle<mpcd::detail::pdata_element> h_recvbuf(m_recvbuf,
+                                                           access_location::host,
+                                                           access_mode::readwrite);
+        m_reqs.resize(2 + m_n_send_reqs);
+        int nreq = 0;
+        if (m_n_recv_right != 0)
+            {
+            MPI_Irecv(h_recvbuf.data + m_n_recv,
+                      m_n_recv_right,
+                      m_pdata_element,
+                      right_neigh,
+                      migrate_data_tag,
+                      m_mpi_comm,
+                      &m_reqs[nreq++]);
+            }
+        if (m_n_recv_left != 0)
+            {
+            MPI_Irecv(h_recvbuf.data + m_n_recv + m_n_recv_right,
+                      m_n_recv_left,
+                      m_pdata_element,
+                      left_neigh,
+                      migrate_data_tag,
+                      m_mpi_comm,
+                      &m_reqs[nreq++]);
+            }
+        std::copy(m_send_reqs.begin(), m_send_reqs.begin() + m_n_send_reqs, m_reqs.begin() + nreq);
+        nreq += m_n_send_reqs;
+        MPI_Waitall(nreq, m_reqs.data(), MPI_STATUSES_IGNORE);
+        }
+
+        // now we pass through and unpack the particles, either by holding onto them in the
+        // receive buffer or by passing them back into the send buffer for the next stage
+        {
+        // partition the receive buffer so that particles that need to be sent are at the end
+        ArrayHandle<mpcd::detail::pdata_element> h_recvbuf(m_recvbuf,
+                                                           access_location::host,
+                                                           access_mode::readwrite);
+        mpcd::detail::MigratePartitionOp part_op(~stage_mask);
+        auto bound
+            = std::partition(h_recvbuf.data + m_n_recv, h_recvbuf.data + m_recvbuf.size(), part_op);
+        m_n_recv = (unsigned int)(&(*bound) - h_recvbuf.data);
+
+        // move particles to resend over to the send buffer and unset the bits from this stage
+        const unsigned int n_resend = (unsigned int)(m_recvbuf.size() - m_n_recv);
+        m_sendbuf.resize(m_n_keep + n_resend);
+        ArrayHandle<mpcd::detail::pdata_element> h_sendbuf(m_sendbuf,
+                                                           access_location::host,
+                                                           access_mode::readwrite);
+        std::copy(h_recvbuf.data + m_n_recv,
+                  h_recvbuf.data + m_recvbuf.size(),
+                  h_sendbuf.data + m_n_keep);
+        for (unsigned int idx = m_n_keep; idx < m_sendbuf.size(); ++idx)
+            {
+            h_sendbuf.data[idx].comm_flag &= ~stage_mask;
+            }
+        }
+    m_recvbuf.resize(m_n_recv); // free up memory from the end of the receive buffer
+    }
+
 /*!
  * \param box Bounding box
  *
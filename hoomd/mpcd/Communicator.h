@@ -92,6 +92,18 @@ class PYBIND11_EXPORT Communicator : public Autotuned
      */
     void communicate(uint64_t timestep);
 
+    //! Start migrating the particles ahead of a call to communicate()
+    void beginCommunicate(uint64_t timestep);
+
+    //! Complete the migration started by beginCommunicate()
+    void finishCommunicate();
+
+    //! Check if a migration started by beginCommunicate() is in flight
+    bool isMigratePending() const
+        {
+        return m_migrate_pending;
+        }
+
     //! Migrate particle data to local domain
     /*!
      * This methods finds all the particles that are no longer inside the domain
@@ -150,6 +162,23 @@ class PYBIND11_EXPORT Communicator : public Autotuned
     //! Set the communication flags for the particle data
     virtual void setCommFlags(const BoxDim& box);
 
+    //! Start the particle migration, leaving the first messages in flight
+    virtual void beginMigrateParticles(uint64_t timestep);
+
+    //! Complete the particle migration started by beginMigrateParticles()
+    virtual void finishMigrateParticles(uint64_t timestep);
+
+    //! MPI tags of the migration messages
+    /*!
+     * The messages can still be in flight while the MD forces are computed, so their tags are
+     * distinct from the ones used by the MD communication.
+     */
+    enum migrate_tag
+        {
+        migrate_count_tag = 64,
+        migrate_data_tag
+        };
+
     //! Checks for overdecomposition
     void checkDecomposition();
 
@@ -203,6 +232,24 @@ class PYBIND11_EXPORT Communicator : public Autotuned
     GPUVector<mpcd::detail::pdata_element> m_recvbuf; //!< Buffer for particles that are received
     std::vector<MPI_Request> m_reqs;                  //!< MPI requests
 
+    /* State of the migration stage in flight */
+    unsigned int m_n_keep;                //!< Number of particles kept in the send buffer
+    unsigned int m_n_send_right;          //!< Number of particles sent to the right neighbor
+    unsigned int m_n_send_left;           //!< Number of particles sent to the left neighbor
+    unsigned int m_n_recv_right;          //!< Number of particles received from the right
+    unsigned int m_n_recv_left;           //!< Number of particles received from the left
+    unsigned int m_n_recv;                //!< Number of particles received and kept so far
+    unsigned int m_stage_dim;             //!< Dimension of the first posted stage
+    int m_n_count_reqs;                   //!< Number of requests for the message sizes
+    int m_n_send_reqs;                    //!< Number of requests for the sent particles
+    std::vector<MPI_Request> m_send_reqs; //!< MPI requests for the sent particles
+
+    //! Post the messages of one migration stage
+    void postMigrateStage(unsigned int dim);
+
+    //! Complete the messages of one migration stage
+    void finishMigrateStage(unsigned int dim);
+
     //! Attach callback signals
     void attachCallbacks();
 
@@ -216,8 +263,12 @@ class PYBIND11_EXPORT Communicator : public Autotuned
         m_check_decomposition = true;
         }
 
-    MigrateSignal m_migrate_requests; //!< Signal to request migration
-    bool m_force_migrate;             //!< If true, force particle migration
+    MigrateSignal m_migrate_requests;  //!< Signal to request migration
+    bool m_force_migrate;              //!< If true, force particle migration
+    bool m_migrate_pending;            //!< If true, a migration is in flight
+    bool m_early_migrate;              //!< If true, beginCommunicate() migrated the particles
+    uint64_t m_early_migrate_timestep; //!< Timestep of the migration by beginCommunicate()
+    BoxDim m_early_migrate_box;        //!< Global box of the migration by beginCommunicate()
     };
 
 namespace detail
@@ -159,7 +159,13 @@ void mpcd::CommunicatorGPU::initializeCommunicationStages()
                                 << " communication stage(s)." << std::endl;
     }
 
-void mpcd::CommunicatorGPU::migrateParticles(uint64_t timestep)
+/*!
+ * \param timestep Current timestep
+ *
+ * The communication flags are set, and the messages of the first stage are posted without
+ * waiting for them to complete.
+ */
+void mpcd::CommunicatorGPU::beginMigrateParticles(uint64_t timestep)
     {
     if (m_mpcd_pdata->getNVirtual() > 0)
         {
@@ -178,181 +184,220 @@ void mpcd::CommunicatorGPU::migrateParticles(uint64_t timestep)
     const BoxDim box = m_cl->getCoverageBox();
     setCommFlags(box);
 
+    postStage(0, timestep);
+    }
+
+/*!
+ * \param timestep Current timestep
+ *
+ * The stage posted by beginMigrateParticles() is completed, and the remaining stages are
+ * communicated.
+ */
+void mpcd::CommunicatorGPU::finishMigrateParticles(uint64_t timestep)
+    {
     for (unsigned int stage = 0; stage < m_num_stages; stage++)
         {
-        const unsigned int comm_mask = m_comm_mask[stage];
+        if (stage > 0)
+            {
+            postStage(stage, timestep);
+            }
+        finishStage(stage, timestep);
+        }
+    }
+
+/*!
+ * \param stage Communication stage
+ * \param timestep Current timestep
+ *
+ * The particles sent in \a stage are packed into the send buffer, and the sizes and contents of
+ * the messages to the neighbors are sent. None of the requests are waited on, so the send buffer
+ * must not be modified until finishStage() is called.
+ */
+void mpcd::CommunicatorGPU::postStage(unsigned int stage, uint64_t timestep)
+    {
+    const unsigned int comm_mask = m_comm_mask[stage];
 
-        // fill send buffer
-        m_mpcd_pdata->removeParticlesGPU(m_sendbuf, comm_mask, timestep);
+    // fill send buffer
+    m_mpcd_pdata->removeParticlesGPU(m_sendbuf, comm_mask, timestep);
 
-        // pack the buffers for each neighbor rank in this stage
-        std::fill(m_n_send_ptls.begin(), m_n_send_ptls.end(), 0);
-        if (m_sendbuf.size() > 0)
+    // pack the buffers for each neighbor rank in this stage
+    std::fill(m_n_send_ptls.begin(), m_n_send_ptls.end(), 0);
+    if (m_sendbuf.size() > 0)
+        {
+        m_tmp_keys.resize(m_sendbuf.size());
+
+        // sort the send buffer on the gpu
+        unsigned int num_send_neigh(0);
             {
-            m_tmp_keys.resize(m_sendbuf.size());
+            ArrayHandle<mpcd::detail::pdata_element> d_sendbuf(m_sendbuf,
+                                                               access_location::device,
+                                                               access_mode::readwrite);
+            ArrayHandle<unsigned int> d_neigh_send(m_neigh_send,
+                                                   access_location::device,
+                                                   access_mode::overwrite);
+            ArrayHandle<unsigned int> d_num_send(m_num_send,
+                                                 access_location::device,
+                                                 access_mode::overwrite);
+            ArrayHandle<unsigned int> d_tmp_keys(m_tmp_keys,
+                                                 access_location::device,
+                                                 access_mode::overwrite);
+            ArrayHandle<unsigned int> d_cart_ranks(m_decomposition->getCartRanks(),
+                                                   access_location::device,
+                                                   access_mode::read);
 
-            // sort the send buffer on the gpu
-            unsigned int num_send_neigh(0);
-                {
-                ArrayHandle<mpcd::detail::pdata_element> d_sendbuf(m_sendbuf,
-                                                                   access_location::device,
-                                                                   access_mode::readwrite);
-                ArrayHandle<unsigned int> d_neigh_send(m_neigh_send,
-                                                       access_location::device,
-                                                       access_mode::overwrite);
-                ArrayHandle<unsigned int> d_num_send(m_num_send,
-                                                     access_location::device,
-                                                     access_mode::overwrite);
-                ArrayHandle<unsigned int> d_tmp_keys(m_tmp_keys,
-                                                     access_location::device,
-                                                     access_mode::overwrite);
-                ArrayHandle<unsigned int> d_cart_ranks(m_decomposition->getCartRanks(),
-                                                       access_location::device,
-                                                       access_mode::read);
+            num_send_neigh = (unsigned int)mpcd::gpu::sort_comm_send_buffer(
+                d_sendbuf.data,
+                d_neigh_send.data,
+                d_num_send.data,
+                d_tmp_keys.data,
+                m_decomposition->getGridPos(),
+                m_decomposition->getDomainIndexer(),
+                m_comm_mask[stage],
+                d_cart_ranks.data,
+                (unsigned int)(m_sendbuf.size()));
+            }
 
-                num_send_neigh = (unsigned int)mpcd::gpu::sort_comm_send_buffer(
-                    d_sendbuf.data,
-                    d_neigh_send.data,
-                    d_num_send.data,
-                    d_tmp_keys.data,
-                    m_decomposition->getGridPos(),
-                    m_decomposition->getDomainIndexer(),
-                    m_comm_mask[stage],
-                    d_cart_ranks.data,
-                    (unsigned int)(m_sendbuf.size()));
-                }
+        // fill the number of particles to send for each neighbor
+        ArrayHandle<unsigned int> h_neigh_send(m_neigh_send,
+                                               access_location::host,
+                                               access_mode::read);
+        ArrayHandle<unsigned int> h_num_send(m_num_send, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
+                                                     access_location::host,
+                                                     access_mode::read);
+        for (unsigned int i = 0; i < num_send_neigh; ++i)
+            {
+            const unsigned int neigh = m_unique_neigh_map.find(h_neigh_send.data[i])->second;
+            m_n_send_ptls[neigh] = h_num_send.data[i];
+            }
+        }
 
-            // fill the number of particles to send for each neighbor
-            ArrayHandle<unsigned int> h_neigh_send(m_neigh_send,
-                                                   access_location::host,
-                                                   access_mode::read);
-            ArrayHandle<unsigned int> h_num_send(m_num_send,
+    ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
                                                  access_location::host,
                                                  access_mode::read);
-            ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
-            for (unsigned int i = 0; i < num_send_neigh; ++i)
-                {
-                const unsigned int neigh = m_unique_neigh_map.find(h_neigh_send.data[i])->second;
-                m_n_send_ptls[neigh] = h_num_send.data[i];
-                }
-            }
+    ArrayHandle<mpcd::detail::pdata_element> h_sendbuf(m_sendbuf,
+                                                       access_location::host,
+                                                       access_mode::read);
 
-        // communicate total number of particles being sent and received from neighbor ranks
-        unsigned int n_recv_tot = 0;
+    // communicate total number of particles being sent and received from neighbor ranks
+    m_reqs.resize(2 * m_n_unique_neigh);
+    m_n_count_reqs = 0;
+    for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ++ineigh)
+        {
+        if (m_stages[ineigh] != (int)stage)
             {
-            // loop over neighbors
-            ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
-            unsigned int nreq = 0;
-            m_reqs.resize(2 * m_n_unique_neigh);
-            for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ++ineigh)
-                {
-                if (m_stages[ineigh] != (int)stage)
-                    {
-                    // skip neighbor if not participating in this communication stage
-                    m_n_send_ptls[ineigh] = 0;
-                    m_n_recv_ptls[ineigh] = 0;
-                    continue;
-                    }
-
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
-                MPI_Isend(&m_n_send_ptls[ineigh],
-                          1,
-                          MPI_UNSIGNED,
-                          neighbor,
-                          0,
-                          m_mpi_comm,
-                          &m_reqs[nreq++]);
-                MPI_Irecv(&m_n_recv_ptls[ineigh],
-                          1,
-                          MPI_UNSIGNED,
-                          neighbor,
-                          0,
-                          m_mpi_comm,
-                          &m_reqs[nreq++]);
-                } // end neighbor loop
-            MPI_Waitall(nreq, m_reqs.data(), MPI_STATUSES_IGNORE);
+            // skip neighbor if not participating in this communication stage
+            m_n_send_ptls[ineigh] = 0;
+            m_n_recv_ptls[ineigh] = 0;
+            continue;
+            }
 
-            // sum up receive counts
-            for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ++ineigh)
-                {
-                m_offsets[ineigh] = n_recv_tot;
-                n_recv_tot += m_n_recv_ptls[ineigh];
-                }
+        // rank of neighbor processor
+        unsigned int neighbor = h_unique_neighbors.data[ineigh];
+
+        MPI_Isend(&m_n_send_ptls[ineigh],
+                  1,
+                  MPI_UNSIGNED,
+                  neighbor,
+                  migrate_count_tag,
+                  m_mpi_comm,
+                  &m_reqs[m_n_count_reqs++]);
+        MPI_Irecv(&m_n_recv_ptls[ineigh],
+                  1,
+                  MPI_UNSIGNED,
+                  neighbor,
+                  migrate_count_tag,
+                  m_mpi_comm,
+                  &m_reqs[m_n_count_reqs++]);
+        } // end neighbor loop
+
+    // the particle data can be sent before the receivers know its size
+    m_send_reqs.resize(m_n_unique_neigh);
+    m_n_send_reqs = 0;
+    unsigned int sendidx = 0;
+    for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ++ineigh)
+        {
+        if (m_n_send_ptls[ineigh])
+            {
+            MPI_Isend(h_sendbuf.data + sendidx,
+                      m_n_send_ptls[ineigh],
+                      m_pdata_element,
+                      h_unique_neighbors.data[ineigh],
+                      migrate_data_tag,
+                      m_mpi_comm,
+                      &m_send_reqs[m_n_send_reqs++]);
+
+            // increment the send index by the amount just transferred
+            sendidx += m_n_send_ptls[ineigh];
             }
+        }
+    }
 
-        // Resize particles from neighbor ranks
-        m_recvbuf.resize(n_recv_tot);
+/*!
+ * \param stage Communication stage
+ * \param timestep Current timestep
+ *
+ * The messages posted by postStage() are completed, and the received particles are added to the
+ * particle data.
+ */
+void mpcd::CommunicatorGPU::finishStage(unsigned int stage, uint64_t timestep)
+    {
+    // sizes of the incoming messages
+    MPI_Waitall(m_n_count_reqs, m_reqs.data(), MPI_STATUSES_IGNORE);
+
+    // sum up receive counts
+    unsigned int n_recv_tot = 0;
+    for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ++ineigh)
+        {
+        m_offsets[ineigh] = n_recv_tot;
+        n_recv_tot += m_n_recv_ptls[ineigh];
+        }
+
+    // Resize particles from neighbor ranks
+    m_recvbuf.resize(n_recv_tot);
+        {
+        ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
+                                                     access_location::host,
+                                                     access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_element> h_recvbuf(m_recvbuf,
+                                                           access_location::host,
+                                                           access_mode::overwrite);
+
+        // loop over neighbors
+        m_reqs.resize(m_n_unique_neigh + m_n_send_reqs);
+        int nreq = 0;
+        for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ++ineigh)
             {
-            ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
-            ArrayHandle<mpcd::detail::pdata_element> h_sendbuf(m_sendbuf,
-                                                               access_location::host,
-                                                               access_mode::read);
-            ArrayHandle<mpcd::detail::pdata_element> h_recvbuf(m_recvbuf,
-                                                               access_location::host,
-                                                               access_mode::overwrite);
-
-            // loop over neighbors
-            unsigned int nreq = 0;
-            m_reqs.resize(2 * m_n_unique_neigh);
-            unsigned int sendidx = 0;
-            for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ++ineigh)
+            if (m_n_recv_ptls[ineigh])
                 {
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
-                // exchange particle data
-                if (m_n_send_ptls[ineigh])
-                    {
-                    MPI_Isend(h_sendbuf.data + sendidx,
-                              m_n_send_ptls[ineigh],
-                              m_pdata_element,
-                              neighbor,
-                              1,
-                              m_mpi_comm,
-                              &m_reqs[nreq++]);
-
-                    // increment the send index by the amount just transferred
-                    sendidx += m_n_send_ptls[ineigh];
-                    }
-
-                if (m_n_recv_ptls[ineigh])
-                    {
-                    MPI_Irecv(h_recvbuf.data + m_offsets[ineigh],
-                              m_n_recv_ptls[ineigh],
-                              m_pdata_element,
-                              neighbor,
-                              1,
-                              m_mpi_comm,
-                              &m_reqs[nreq++]);
-                    }
+                MPI_Irecv(h_recvbuf.data + m_offsets[ineigh],
+                          m_n_recv_ptls[ineigh],
+                          m_pdata_element,
+                          h_unique_neighbors.data[ineigh],
+                          migrate_data_tag,
+                          m_mpi_comm,
+                          &m_reqs[nreq++]);
                 }
-
-            MPI_Waitall(nreq, m_reqs.data(), MPI_STATUSES_IGNORE);
             }
+        std::copy(m_send_reqs.begin(), m_send_reqs.begin() + m_n_send_reqs, m_reqs.begin() + nreq);
+        nreq += m_n_send_reqs;
 
-            // wrap received particles through the global boundary
-            {
-            ArrayHandle<mpcd::detail::pdata_element> d_recvbuf(m_recvbuf,
-                                                               access_location::device,
-                                                               access_mode::readwrite);
-            const BoxDim wrap_box = getWrapBox(box);
-            mpcd::gpu::wrap_particles(n_recv_tot, d_recvbuf.data, wrap_box);
-            if (m_exec_conf->isCUDAErrorCheckingEnabled())
-                CHECK_CUDA_ERROR();
-            }
+        MPI_Waitall(nreq, m_reqs.data(), MPI_STATUSES_IGNORE);
+        }
 
-        // fill particle data with received particles
-        m_mpcd_pdata->addParticlesGPU(m_recvbuf, comm_mask, timestep);
+        // wrap received particles through the global boundary
+        {
+        ArrayHandle<mpcd::detail::pdata_element> d_recvbuf(m_recvbuf,
+                                                           access_location::device,
+                                                           access_mode::readwrite);
+        const BoxDim wrap_box = getWrapBox(m_cl->getCoverageBox());
+        mpcd::gpu::wrap_particles(n_recv_tot, d_recvbuf.data, wrap_box);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
 
-        } // end communication stage
+    // fill particle data with received particles
+    m_mpcd_pdata->addParticlesGPU(m_recvbuf, m_comm_mask[stage], timestep);
     }
 
 /*!
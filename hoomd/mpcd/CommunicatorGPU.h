@@ -53,13 +53,6 @@ class PYBIND11_EXPORT CommunicatorGPU : public mpcd::Communicator
     //! Destructor
     virtual ~CommunicatorGPU();
 
-    //! \name communication methods
-    //@{
-
-    //! Migrate particle data to local domain
-    virtual void migrateParticles(uint64_t timestep);
-    //@}
-
     //! Set maximum number of communication stages
     /*! \param max_stages Maximum number of communication stages
      */
@@ -73,6 +66,12 @@ class PYBIND11_EXPORT CommunicatorGPU : public mpcd::Communicator
     //! Set the communication flags for the particle data on the GPU
     virtual void setCommFlags(const BoxDim& box);
 
+    //! Start the particle migration on the GPU, leaving the first messages in flight
+    virtual void beginMigrateParticles(uint64_t timestep);
+
+    //! Complete the particle migration on the GPU
+    virtual void finishMigrateParticles(uint64_t timestep);
+
     private:
     /* General communication */
     unsigned int m_max_stages;             //!< Maximum number of (dependent) communication stages
@@ -91,6 +90,12 @@ class PYBIND11_EXPORT CommunicatorGPU : public mpcd::Communicator
     //! Helper function to set up communication stages
     void initializeCommunicationStages();
 
+    //! Post the messages of one communication stage
+    void postStage(unsigned int stage, uint64_t timestep);
+
+    //! Complete the messages of one communication stage
+    void finishStage(unsigned int stage, uint64_t timestep);
+
     /* Autotuners */
     std::shared_ptr<Autotuner<1>> m_flags_tuner; //!< Tuner for marking communication flags
     };
@@ -16,6 +16,13 @@
 #include "StreamingMethod.h"
 #include <pybind11/pybind11.h>
 
+#include <vector>
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 namespace hoomd
     {
 namespace mpcd
@@ -32,11 +39,13 @@ namespace mpcd
  * boundary and its velocity is updated according to the boundary conditions. Streaming then
  * continues until the timestep is completed.
  *
- * To facilitate this, every Geometry must supply three methods:
+ * To facilitate this, every Geometry must supply four methods:
  *  1. detectCollision(): Determines when and where a collision occurs. If one does, this method
  * moves the particle back, reflects its velocity, and gives the time still remaining to integrate.
  *  2. isOutside(): Determines whether a particles lies outside the Geometry.
- *  3. validateBox(): Checks whether the global simulation box is consistent with the streaming
+ *  3. isCellOutside(): Determines whether a region lies entirely outside the Geometry. The sparse
+ * cell list does not store the cells in these regions.
+ *  4. validateBox(): Checks whether the global simulation box is consistent with the streaming
  * geometry.
  *
  */
@@ -65,6 +74,12 @@ class PYBIND11_EXPORT ConfinedStreamingMethod : public mpcd::StreamingMethod
     //! Implementation of the streaming rule
     virtual void stream(uint64_t timestep);
 
+    //! Stream the particles and bin them for the collision that follows
+    virtual void streamAndBin(uint64_t timestep,
+                              uint64_t bin_timestep,
+                              std::shared_ptr<mpcd::CellThermoCompute> thermo,
+                              std::shared_ptr<mpcd::Sorter> sorter);
+
     //! Get the streaming geometry
     std::shared_ptr<const Geometry> getGeometry() const
         {
@@ -76,6 +91,14 @@ class PYBIND11_EXPORT ConfinedStreamingMethod : public mpcd::StreamingMethod
         {
         m_validate_geom = true;
         m_geom = geom;
+        updateCellMask();
+        }
+
+    //! Set the cell list used for collisions
+    virtual void setCellList(std::shared_ptr<mpcd::CellList> cl)
+        {
+        mpcd::StreamingMethod::setCellList(cl);
+        updateCellMask();
         }
 
     protected:
@@ -85,8 +108,25 @@ class PYBIND11_EXPORT ConfinedStreamingMethod : public mpcd::StreamingMethod
     //! Validate the system with the streaming geometry
     void validate();
 
+    //! Give the cell list a mask that excludes the cells outside the geometry
+    void updateCellMask()
+        {
+        if (!m_cl || !m_geom)
+            return;
+
+        std::shared_ptr<const Geometry> geom = m_geom;
+        m_cl->setCellMask([geom](const Scalar3& lo, const Scalar3& hi)
+                          { return geom->isCellOutside(lo, hi); });
+        }
+
     //! Check that particles lie inside the geometry
     virtual bool validateParticles();
+
+    //! Stream one particle over the streaming time step
+    void streamParticle(Scalar3& pos,
+                        Scalar3& vel,
+                        const mpcd::ExternalField* field,
+                        const Scalar mass) const;
     };
 
 /*!
@@ -121,45 +161,313 @@ template<class Geometry> void ConfinedStreamingMethod<Geometry>::stream(uint64_t
     // acquire polymorphic pointer to the external field
     const mpcd::ExternalField* field = (m_field) ? m_field->get(access_location::host) : nullptr;
 
-    for (unsigned int cur_p = 0; cur_p < m_mpcd_pdata->getN(); ++cur_p)
+    // each particle is streamed independently
+    auto stream_range = [&](unsigned int begin, unsigned int end)
+    {
+        for (unsigned int cur_p = begin; cur_p < end; ++cur_p)
+            {
+            const Scalar4 postype = h_pos.data[cur_p];
+            Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+            const unsigned int type = __scalar_as_int(postype.w);
+
+            const Scalar4 vel_cell = h_vel.data[cur_p];
+            Scalar3 vel = make_scalar3(vel_cell.x, vel_cell.y, vel_cell.z);
+            streamParticle(pos, vel, field, mass);
+
+            // wrap and update the position
+            int3 image = make_int3(0, 0, 0);
+            box.wrap(pos, image);
+
+            h_pos.data[cur_p] = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(type));
+            h_vel.data[cur_p]
+                = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(mpcd::detail::NO_CELL));
+            }
+    };
+
+    const unsigned int N = m_mpcd_pdata->getN();
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  { stream_range(r.begin(), r.end()); });
+            });
+        }
+    else
+#endif
+        {
+        stream_range(0, N);
+        }
+
+    // particles have moved, so the cell cache is no longer valid
+    m_mpcd_pdata->invalidateCellCache();
+    }
+
+/*!
+ * \param timestep Current time to stream
+ * \param bin_timestep Timestep of the collision that follows the streaming step
+ * \param thermo Cell thermo compute used by the collision
+ * \param sorter Sorter that is due at \a bin_timestep, or a null pointer
+ *
+ * Each particle is streamed, binned into the cell list of \a thermo using the grid shift that has
+ * already been drawn for \a bin_timestep, and its momentum, mass, and kinetic energy are added to
+ * its cell in the same sweep. The cell list and \a thermo are then marked as computed for
+ * \a bin_timestep, so the collision only needs to normalize the cell sums before applying its
+ * rule.
+ *
+ * When \a sorter is set, the particles are also put into cell order. The first sweep streams the
+ * particles and counts the members of each cell. The second sweep scatters each particle into the
+ * alternate arrays at its sorted index, which is its cell list entry, and adds it to the cell sums.
+ * The sorter then swaps in the sorted arrays, so the particles are permuted once and the cell list
+ * is not rebuilt by the sorter.
+ *
+ * The particles are streamed without binning if \a thermo does not use the streaming cell list,
+ * if the cell list cannot be built from the streamed particles alone, or if TBB threads are in use
+ * (the threaded streaming and cell list passes do not write to shared cells).
+ */
+template<class Geometry>
+void ConfinedStreamingMethod<Geometry>::streamAndBin(
+    uint64_t timestep,
+    uint64_t bin_timestep,
+    std::shared_ptr<mpcd::CellThermoCompute> thermo,
+    std::shared_ptr<mpcd::Sorter> sorter)
+    {
+    bool can_bin = (m_cl && thermo->getCellList() == m_cl && m_cl->canBuildWhileStreaming());
+#ifdef ENABLE_TBB
+    can_bin = can_bin && m_exec_conf->getNumThreads() == 1;
+#endif
+    if (!can_bin)
         {
-        const Scalar4 postype = h_pos.data[cur_p];
-        Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
-        const unsigned int type = __scalar_as_int(postype.w);
+        stream(timestep);
+        return;
+        }
 
-        const Scalar4 vel_cell = h_vel.data[cur_p];
-        Scalar3 vel = make_scalar3(vel_cell.x, vel_cell.y, vel_cell.z);
-        // estimate next velocity based on current acceleration
-        if (field)
+    if (!shouldStream(timestep))
+        return;
+
+    if (m_validate_geom)
+        {
+        validate();
+        m_validate_geom = false;
+        }
+
+    const bool sort = (sorter && sorter->beginStreamingSort(bin_timestep));
+    bool sorted = false;
+
+    const BoxDim box = m_cl->getCoverageBox();
+    thermo->beginStreamingSums();
+        {
+        ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        const Scalar mass = m_mpcd_pdata->getMass();
+
+        // cell list and cell sums, which are accumulated from zero
+        ArrayHandle<unsigned int> h_cell_list(m_cl->getCellList(),
+                                              access_location::host,
+                                              access_mode::overwrite);
+        ArrayHandle<unsigned int> h_cell_np(m_cl->getCellSizeArray(),
+                                            access_location::host,
+                                            access_mode::overwrite);
+        ArrayHandle<unsigned int> h_cell_slot(m_cl->getCellSlots(),
+                                              access_location::host,
+                                              access_mode::read);
+        ArrayHandle<double4> h_cell_vel(thermo->getCellVelocities(),
+                                        access_location::host,
+                                        access_mode::overwrite);
+        ArrayHandle<double3> h_cell_energy(thermo->getCellEnergies(),
+                                           access_location::host,
+                                           access_mode::overwrite);
+        const unsigned int ncells = m_cl->getNCells();
+        memset(h_cell_np.data, 0, sizeof(unsigned int) * ncells);
+        memset(h_cell_vel.data, 0, sizeof(double4) * ncells);
+        memset(h_cell_energy.data, 0, sizeof(double3) * ncells);
+
+        const mpcd::detail::CellBinner binner = m_cl->getBinner();
+        const Index2D& cli = m_cl->getCellListIndexer();
+        const unsigned int cell_np_max = m_cl->getNmax();
+        uint3 conditions = make_uint3(0, 0, 0);
+
+        // adds the particle with cell list entry pid to its cell
+        auto add_to_cell = [&](unsigned int pid, unsigned int bin_idx, const Scalar4& vel_cell)
+        {
+            const unsigned int offset = h_cell_np.data[bin_idx];
+            if (offset < cell_np_max)
+                {
+                h_cell_list.data[cli(offset, h_cell_slot.data[bin_idx])] = pid;
+                }
+            else
+                {
+                // overflow
+                conditions.x = std::max(conditions.x, offset + 1);
+                }
+            ++h_cell_np.data[bin_idx];
+
+            // add momentum and kinetic energy to the cell
+            const double3 vel_i = make_double3(vel_cell.x, vel_cell.y, vel_cell.z);
+            double4& momentum = h_cell_vel.data[bin_idx];
+            momentum.x += mass * vel_i.x;
+            momentum.y += mass * vel_i.y;
+            momentum.z += mass * vel_i.z;
+            momentum.w += mass;
+            h_cell_energy.data[bin_idx].x
+                += 0.5 * mass * (vel_i.x * vel_i.x + vel_i.y * vel_i.y + vel_i.z * vel_i.z);
+        };
+
+        // number of members of each cell, and then the first sorted index of each cell
+        std::vector<unsigned int> cell_start(sort ? ncells : 0, 0);
+
+        const mpcd::ExternalField* field
+            = (m_field) ? m_field->get(access_location::host) : nullptr;
+
+        const unsigned int N = m_mpcd_pdata->getN();
+        for (unsigned int cur_p = 0; cur_p < N; ++cur_p)
             {
-            vel += Scalar(0.5) * m_mpcd_dt * field->evaluate(pos) / mass;
+            const Scalar4 postype = h_pos.data[cur_p];
+            Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+            const unsigned int type = __scalar_as_int(postype.w);
+
+            const Scalar4 vel_cell = h_vel.data[cur_p];
+            Scalar3 vel = make_scalar3(vel_cell.x, vel_cell.y, vel_cell.z);
+            streamParticle(pos, vel, field, mass);
+
+            // wrap and update the position
+            int3 image = make_int3(0, 0, 0);
+            box.wrap(pos, image);
+
+            // bin the particle, flagging errors for the cell list to report
+            unsigned int bin_idx = mpcd::detail::NO_CELL;
+            if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
+                {
+                conditions.y = std::max(conditions.y, cur_p + 1);
+                }
+            else
+                {
+                bin_idx = binner(pos);
+                if (bin_idx != mpcd::detail::NO_CELL
+                    && h_cell_slot.data[bin_idx] == mpcd::detail::NO_CELL)
+                    bin_idx = mpcd::detail::NO_CELL;
+                if (bin_idx == mpcd::detail::NO_CELL)
+                    conditions.z = std::max(conditions.z, cur_p + 1);
+                }
+
+            h_pos.data[cur_p] = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(type));
+            h_vel.data[cur_p] = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(bin_idx));
+            if (bin_idx == mpcd::detail::NO_CELL)
+                continue;
+
+            if (sort)
+                ++cell_start[bin_idx];
+            else
+                add_to_cell(cur_p, bin_idx, h_vel.data[cur_p]);
             }
 
-        // propagate the particle to its new position ballistically
-        Scalar dt_remain = m_mpcd_dt;
-        bool collide = true;
-        do
-            {
-            pos += dt_remain * vel;
-            collide = m_geom->detectCollision(pos, vel, dt_remain);
-            } while (dt_remain > 0 && collide);
-        // finalize velocity update
-        if (field)
+        // the cell list reports the errors, and the particles are left in place
+        sorted = (sort && !conditions.y && !conditions.z);
+        if (sorted)
             {
-            vel += Scalar(0.5) * m_mpcd_dt * field->evaluate(pos) / mass;
+            unsigned int n_sorted = 0;
+            for (unsigned int idx = 0; idx < ncells; ++idx)
+                {
+                const unsigned int np = cell_start[idx];
+                cell_start[idx] = n_sorted;
+                n_sorted += np;
+                }
+
+            ArrayHandle<unsigned int> h_tag(m_mpcd_pdata->getTags(),
+                                            access_location::host,
+                                            access_mode::read);
+            ArrayHandle<Scalar4> h_pos_alt(m_mpcd_pdata->getAltPositions(),
+                                           access_location::host,
+                                           access_mode::overwrite);
+            ArrayHandle<Scalar4> h_vel_alt(m_mpcd_pdata->getAltVelocities(),
+                                           access_location::host,
+                                           access_mode::overwrite);
+            ArrayHandle<unsigned int> h_tag_alt(m_mpcd_pdata->getAltTags(),
+                                                access_location::host,
+                                                access_mode::overwrite);
+            ArrayHandle<unsigned int> h_order(sorter->getOrder(),
+                                              access_location::host,
+                                              access_mode::overwrite);
+            ArrayHandle<unsigned int> h_rorder(sorter->getReverseOrder(),
+                                               access_location::host,
+                                               access_mode::overwrite);
+
+            // particles are visited in increasing index, so each cell keeps their order
+            for (unsigned int cur_p = 0; cur_p < N; ++cur_p)
+                {
+                const Scalar4 vel_cell = h_vel.data[cur_p];
+                const unsigned int bin_idx = __scalar_as_int(vel_cell.w);
+                const unsigned int new_p = cell_start[bin_idx]++;
+
+                h_order.data[new_p] = cur_p;
+                h_rorder.data[cur_p] = new_p;
+                h_pos_alt.data[new_p] = h_pos.data[cur_p];
+                h_vel_alt.data[new_p] = vel_cell;
+                h_tag_alt.data[new_p] = h_tag.data[cur_p];
+                add_to_cell(new_p, bin_idx, vel_cell);
+                }
+
+            // copy virtual particle data if it exists
+            const unsigned int Ntot = N + m_mpcd_pdata->getNVirtual();
+            std::copy(h_pos.data + N, h_pos.data + Ntot, h_pos_alt.data + N);
+            std::copy(h_vel.data + N, h_vel.data + Ntot, h_vel_alt.data + N);
+            std::copy(h_tag.data + N, h_tag.data + Ntot, h_tag_alt.data + N);
             }
 
-        // wrap and update the position
-        int3 image = make_int3(0, 0, 0);
-        box.wrap(pos, image);
+        m_cl->getConditions().resetFlags(conditions);
+        }
 
-        h_pos.data[cur_p] = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(type));
-        h_vel.data[cur_p]
-            = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(mpcd::detail::NO_CELL));
+    // the sorted arrays are swapped in before the cell list is marked as computed, so that it keeps
+    // the sorted indexes
+    if (sorted)
+        {
+        sorter->finishStreamingSort(bin_timestep);
         }
 
-    // particles have moved, so the cell cache is no longer valid
+    // particles have moved, and the cell list now holds their new positions
     m_mpcd_pdata->invalidateCellCache();
+    m_cl->finishStreamingBuild(bin_timestep);
+    thermo->finishStreamingSums(bin_timestep);
+    }
+
+/*!
+ * \param pos Particle position, updated in place
+ * \param vel Particle velocity, updated in place
+ * \param field External field acting on the particle, or nullptr
+ * \param mass Particle mass
+ */
+template<class Geometry>
+void ConfinedStreamingMethod<Geometry>::streamParticle(Scalar3& pos,
+                                                       Scalar3& vel,
+                                                       const mpcd::ExternalField* field,
+                                                       const Scalar mass) const
+    {
+    // estimate next velocity based on current acceleration
+    if (field)
+        {
+        vel += Scalar(0.5) * m_mpcd_dt * field->evaluate(pos) / mass;
+        }
+
+    // propagate the particle to its new position ballistically
+    Scalar dt_remain = m_mpcd_dt;
+    bool collide = true;
+    do
+        {
+        pos += dt_remain * vel;
+        collide = m_geom->detectCollision(pos, vel, dt_remain);
+        } while (dt_remain > 0 && collide);
+    // finalize velocity update
+    if (field)
+        {
+        vel += Scalar(0.5) * m_mpcd_dt * field->evaluate(pos) / mass;
+        }
     }
 
 template<class Geometry> void ConfinedStreamingMethod<Geometry>::validate()
@@ -9,10 +9,12 @@
  * \brief Declaration of CUDA kernels for mpcd::ConfinedStreamingMethodGPU
  */
 
+#include "CellBinner.h"
 #include "ExternalField.h"
 #include "ParticleDataUtilities.h"
 #include "hoomd/BoxDim.h"
 #include "hoomd/HOOMDMath.h"
+#include "hoomd/Index1D.h"
 
 namespace hoomd
     {
@@ -47,13 +49,87 @@ struct stream_args_t
     const unsigned int block_size;    //!< Number of threads per block
     };
 
+//! Arguments to bin particles and sum the cell properties while streaming
+struct stream_bin_args_t
+    {
+    //! Constructor
+    stream_bin_args_t(unsigned int* _d_cell_np,
+                      unsigned int* _d_cell_list,
+                      uint3* _d_conditions,
+                      double4* _d_cell_vel,
+                      double3* _d_cell_energy,
+                      const mpcd::detail::CellBinner& _binner,
+                      const Index2D& _cell_list_indexer,
+                      const unsigned int _cell_np_max)
+        : d_cell_np(_d_cell_np), d_cell_list(_d_cell_list), d_conditions(_d_conditions),
+          d_cell_vel(_d_cell_vel), d_cell_energy(_d_cell_energy), binner(_binner),
+          cell_list_indexer(_cell_list_indexer), cell_np_max(_cell_np_max)
+        {
+        }
+
+    unsigned int* d_cell_np;               //!< Number of particles per cell
+    unsigned int* d_cell_list;             //!< Cell list of particles
+    uint3* d_conditions;                   //!< Conditions flags for error reporting
+    double4* d_cell_vel;                   //!< Momentum and mass per cell
+    double3* d_cell_energy;                //!< Kinetic energy per cell
+    const mpcd::detail::CellBinner binner; //!< Binner for the cell list
+    const Index2D cell_list_indexer;       //!< Indexer into the cell list
+    const unsigned int cell_np_max;        //!< Maximum number of particles per cell
+    };
+
 //! Kernel driver to stream particles ballistically
 template<class Geometry>
 cudaError_t confined_stream(const stream_args_t& args, const Geometry& geom);
 
+//! Kernel driver to stream particles ballistically and bin them into cells
+template<class Geometry>
+cudaError_t confined_stream_bin(const stream_args_t& args,
+                                const stream_bin_args_t& bin_args,
+                                const Geometry& geom);
+
 #ifdef __HIPCC__
 namespace kernel
     {
+//! Stream one particle ballistically
+/*!
+ * \param pos Particle position, updated in place
+ * \param vel Particle velocity, updated in place
+ * \param mass Particle mass
+ * \param dt Timestep to stream
+ * \param field Applied external field
+ * \param geom Confined geometry
+ *
+ * \tparam Geometry type of the confined geometry \a geom
+ */
+template<class Geometry>
+__device__ inline void stream_particle(Scalar3& pos,
+                                       Scalar3& vel,
+                                       const Scalar mass,
+                                       const Scalar dt,
+                                       const mpcd::ExternalField* field,
+                                       const Geometry& geom)
+    {
+    // estimate next velocity based on current acceleration
+    if (field)
+        {
+        vel += Scalar(0.5) * dt * field->evaluate(pos) / mass;
+        }
+
+    // propagate the particle to its new position ballistically
+    Scalar dt_remain = dt;
+    bool collide = true;
+    do
+        {
+        pos += dt_remain * vel;
+        collide = geom.detectCollision(pos, vel, dt_remain);
+        } while (dt_remain > 0 && collide);
+    // finalize velocity update
+    if (field)
+        {
+        vel += Scalar(0.5) * dt * field->evaluate(pos) / mass;
+        }
+    }
+
 //! Kernel to stream particles ballistically
 /*!
  * \param d_pos Particle positions
@@ -100,25 +176,7 @@ __global__ void confined_stream(Scalar4* d_pos,
 
     const Scalar4 vel_cell = d_vel[idx];
     Scalar3 vel = make_scalar3(vel_cell.x, vel_cell.y, vel_cell.z);
-    // estimate next velocity based on current acceleration
-    if (field)
-        {
-        vel += Scalar(0.5) * dt * field->evaluate(pos) / mass;
-        }
-
-    // propagate the particle to its new position ballistically
-    Scalar dt_remain = dt;
-    bool collide = true;
-    do
-        {
-        pos += dt_remain * vel;
-        collide = geom.detectCollision(pos, vel, dt_remain);
-        } while (dt_remain > 0 && collide);
-    // finalize velocity update
-    if (field)
-        {
-        vel += Scalar(0.5) * dt * field->evaluate(pos) / mass;
-        }
+    stream_particle(pos, vel, mass, dt, field, geom);
 
     // wrap and update the position
     int3 image = make_int3(0, 0, 0);
@@ -128,6 +186,108 @@ __global__ void confined_stream(Scalar4* d_pos,
     d_vel[idx] = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(mpcd::detail::NO_CELL));
     }
 
+//! Kernel to stream particles ballistically and bin them into cells
+/*!
+ * \param d_pos Particle positions
+ * \param d_vel Particle velocities
+ * \param d_cell_np Number of particles per cell, zeroed by the driver
+ * \param d_cell_list Cell list of particles
+ * \param d_conditions Conditions flags for error reporting
+ * \param d_cell_vel Momentum and mass per cell, zeroed by the driver
+ * \param d_cell_energy Kinetic energy per cell, zeroed by the driver
+ * \param binner Binner for the cell list
+ * \param cell_list_indexer Indexer into the cell list
+ * \param cell_np_max Maximum number of particles per cell
+ * \param mass Particle mass
+ * \param box Simulation box
+ * \param dt Timestep to stream
+ * \param field Applied external field
+ * \param N Number of particles
+ * \param geom Confined geometry
+ *
+ * \tparam Geometry type of the confined geometry \a geom
+ *
+ * \b Implementation
+ * Using one thread per particle, the particle is streamed like
+ * mpcd::gpu::kernel::confined_stream. The streamed particle is then binned like
+ * mpcd::gpu::kernel::compute_cell_list, and its momentum, mass, and kinetic energy are atomically
+ * added to its cell.
+ */
+template<class Geometry>
+__global__ void confined_stream_bin(Scalar4* d_pos,
+                                    Scalar4* d_vel,
+                                    unsigned int* d_cell_np,
+                                    unsigned int* d_cell_list,
+                                    uint3* d_conditions,
+                                    double4* d_cell_vel,
+                                    double3* d_cell_energy,
+                                    const mpcd::detail::CellBinner binner,
+                                    const Index2D cell_list_indexer,
+                                    const unsigned int cell_np_max,
+                                    const Scalar mass,
+                                    const mpcd::ExternalField* field,
+                                    const BoxDim box,
+                                    const Scalar dt,
+                                    const unsigned int N,
+                                    const Geometry geom)
+    {
+    // one thread per particle
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    const Scalar4 postype = d_pos[idx];
+    Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+    const unsigned int type = __scalar_as_int(postype.w);
+
+    const Scalar4 vel_cell = d_vel[idx];
+    Scalar3 vel = make_scalar3(vel_cell.x, vel_cell.y, vel_cell.z);
+    stream_particle(pos, vel, mass, dt, field, geom);
+
+    // wrap and update the position
+    int3 image = make_int3(0, 0, 0);
+    box.wrap(pos, image);
+
+    // bin the particle, flagging errors for the cell list to report
+    unsigned int bin_idx = mpcd::detail::NO_CELL;
+    if (isnan(pos.x) || isnan(pos.y) || isnan(pos.z))
+        {
+        (*d_conditions).y = idx + 1;
+        }
+    else
+        {
+        bin_idx = binner(pos);
+        if (bin_idx == mpcd::detail::NO_CELL)
+            (*d_conditions).z = idx + 1;
+        }
+
+    d_pos[idx] = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(type));
+    d_vel[idx] = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(bin_idx));
+    if (bin_idx == mpcd::detail::NO_CELL)
+        return;
+
+    const unsigned int offset = atomicInc(&d_cell_np[bin_idx], 0xffffffff);
+    if (offset < cell_np_max)
+        {
+        d_cell_list[cell_list_indexer(offset, bin_idx)] = idx;
+        }
+    else
+        {
+        // overflow
+        atomicMax(&(*d_conditions).x, offset + 1);
+        }
+
+    // add momentum and kinetic energy to the cell
+    const double3 vel_i = make_double3(vel.x, vel.y, vel.z);
+    double4* momentum = &d_cell_vel[bin_idx];
+    atomicAdd(&momentum->x, mass * vel_i.x);
+    atomicAdd(&momentum->y, mass * vel_i.y);
+    atomicAdd(&momentum->z, mass * vel_i.z);
+    atomicAdd(&momentum->w, (double)mass);
+    atomicAdd(&d_cell_energy[bin_idx].x,
+              0.5 * mass * (vel_i.x * vel_i.x + vel_i.y * vel_i.y + vel_i.z * vel_i.z));
+    }
+
     } // end namespace kernel
 
 /*!
@@ -159,6 +319,60 @@ cudaError_t confined_stream(const stream_args_t& args, const Geometry& geom)
 
     return cudaSuccess;
     }
+
+/*!
+ * \param args Common arguments for a streaming kernel
+ * \param bin_args Arguments for binning the particles and summing the cell properties
+ * \param geom Confined geometry
+ *
+ * \tparam Geometry type of the confined geometry \a geom
+ *
+ * \sa mpcd::gpu::kernel::confined_stream_bin
+ */
+template<class Geometry>
+cudaError_t confined_stream_bin(const stream_args_t& args,
+                                const stream_bin_args_t& bin_args,
+                                const Geometry& geom)
+    {
+    // zero the cell counters and sums
+    const unsigned int ncells = bin_args.binner.cell_indexer.getNumElements();
+    cudaError_t error = cudaMemset(bin_args.d_cell_np, 0, sizeof(unsigned int) * ncells);
+    if (error != cudaSuccess)
+        return error;
+    error = cudaMemset(bin_args.d_cell_vel, 0, sizeof(double4) * ncells);
+    if (error != cudaSuccess)
+        return error;
+    error = cudaMemset(bin_args.d_cell_energy, 0, sizeof(double3) * ncells);
+    if (error != cudaSuccess)
+        return error;
+
+    unsigned int max_block_size;
+    cudaFuncAttributes attr;
+    cudaFuncGetAttributes(&attr, (const void*)mpcd::gpu::kernel::confined_stream_bin<Geometry>);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(args.block_size, max_block_size);
+    dim3 grid(args.N / run_block_size + 1);
+    mpcd::gpu::kernel::confined_stream_bin<Geometry>
+        <<<grid, run_block_size>>>(args.d_pos,
+                                   args.d_vel,
+                                   bin_args.d_cell_np,
+                                   bin_args.d_cell_list,
+                                   bin_args.d_conditions,
+                                   bin_args.d_cell_vel,
+                                   bin_args.d_cell_energy,
+                                   bin_args.binner,
+                                   bin_args.cell_list_indexer,
+                                   bin_args.cell_np_max,
+                                   args.mass,
+                                   args.field,
+                                   args.box,
+                                   args.dt,
+                                   args.N,
+                                   geom);
+
+    return cudaSuccess;
+    }
 #endif // __HIPCC__
 
     }  // end namespace gpu
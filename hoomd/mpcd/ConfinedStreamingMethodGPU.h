@@ -48,14 +48,25 @@ class PYBIND11_EXPORT ConfinedStreamingMethodGPU : public mpcd::ConfinedStreamin
         m_tuner.reset(new Autotuner<1>({AutotunerBase::makeBlockSizeRange(this->m_exec_conf)},
                                        this->m_exec_conf,
                                        "mpcd_stream"));
-        this->m_autotuners.push_back(m_tuner);
+        m_bin_tuner.reset(
+            new Autotuner<1>({AutotunerBase::makeBlockSizeRange(this->m_exec_conf)},
+                             this->m_exec_conf,
+                             "mpcd_stream_bin"));
+        this->m_autotuners.insert(this->m_autotuners.end(), {m_tuner, m_bin_tuner});
         }
 
     //! Implementation of the streaming rule
     virtual void stream(uint64_t timestep);
 
+    //! Stream the particles and bin them for the collision that follows on the GPU
+    virtual void streamAndBin(uint64_t timestep,
+                              uint64_t bin_timestep,
+                              std::shared_ptr<mpcd::CellThermoCompute> thermo,
+                              std::shared_ptr<mpcd::Sorter> sorter);
+
     protected:
     std::shared_ptr<Autotuner<1>> m_tuner;
+    std::shared_ptr<Autotuner<1>> m_bin_tuner;
     };
 
 /*!
@@ -100,6 +111,94 @@ template<class Geometry> void ConfinedStreamingMethodGPU<Geometry>::stream(uint6
     this->m_mpcd_pdata->invalidateCellCache();
     }
 
+/*!
+ * \param timestep Current time to stream
+ * \param bin_timestep Timestep of the collision that follows the streaming step
+ * \param thermo Cell thermo compute used by the collision
+ * \param sorter Sorter that is due at \a bin_timestep, or a null pointer
+ *
+ * The particles are not sorted on the GPU, so they are only streamed when \a sorter is set and the
+ * collision sorts them as usual.
+ *
+ * \sa mpcd::ConfinedStreamingMethod::streamAndBin
+ */
+template<class Geometry>
+void ConfinedStreamingMethodGPU<Geometry>::streamAndBin(
+    uint64_t timestep,
+    uint64_t bin_timestep,
+    std::shared_ptr<mpcd::CellThermoCompute> thermo,
+    std::shared_ptr<mpcd::Sorter> sorter)
+    {
+    auto cl = this->m_cl;
+    if (!cl || thermo->getCellList() != cl || !cl->canBuildWhileStreaming() || sorter)
+        {
+        stream(timestep);
+        return;
+        }
+
+    if (!this->shouldStream(timestep))
+        return;
+
+    // the validation step currently proceeds on the cpu because it is done infrequently.
+    // if it becomes a performance concern, it can be ported to the gpu
+    if (this->m_validate_geom)
+        {
+        this->validate();
+        this->m_validate_geom = false;
+        }
+
+    thermo->beginStreamingSums();
+    cl->getConditions().resetFlags(make_uint3(0, 0, 0));
+        {
+        ArrayHandle<Scalar4> d_pos(this->m_mpcd_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar4> d_vel(this->m_mpcd_pdata->getVelocities(),
+                                   access_location::device,
+                                   access_mode::readwrite);
+        ArrayHandle<unsigned int> d_cell_list(cl->getCellList(),
+                                              access_location::device,
+                                              access_mode::overwrite);
+        ArrayHandle<unsigned int> d_cell_np(cl->getCellSizeArray(),
+                                            access_location::device,
+                                            access_mode::overwrite);
+        ArrayHandle<double4> d_cell_vel(thermo->getCellVelocities(),
+                                        access_location::device,
+                                        access_mode::overwrite);
+        ArrayHandle<double3> d_cell_energy(thermo->getCellEnergies(),
+                                           access_location::device,
+                                           access_mode::overwrite);
+        mpcd::gpu::stream_args_t args(d_pos.data,
+                                      d_vel.data,
+                                      this->m_mpcd_pdata->getMass(),
+                                      (this->m_field) ? this->m_field->get(access_location::device)
+                                                      : nullptr,
+                                      cl->getCoverageBox(),
+                                      this->m_mpcd_dt,
+                                      this->m_mpcd_pdata->getN(),
+                                      m_bin_tuner->getParam()[0]);
+        mpcd::gpu::stream_bin_args_t bin_args(d_cell_np.data,
+                                              d_cell_list.data,
+                                              cl->getConditions().getDeviceFlags(),
+                                              d_cell_vel.data,
+                                              d_cell_energy.data,
+                                              cl->getBinner(),
+                                              cl->getCellListIndexer(),
+                                              cl->getNmax());
+
+        m_bin_tuner->begin();
+        mpcd::gpu::confined_stream_bin<Geometry>(args, bin_args, *(this->m_geom));
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_bin_tuner->end();
+        }
+
+    // particles have moved, and the cell list now holds their new positions
+    this->m_mpcd_pdata->invalidateCellCache();
+    cl->finishStreamingBuild(bin_timestep);
+    thermo->finishStreamingSums(bin_timestep);
+    }
+
 namespace detail
     {
 //! Export mpcd::StreamingMethodGPU to python
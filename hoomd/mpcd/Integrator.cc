@@ -19,7 +19,8 @@ namespace hoomd
  * \param deltaT Fundamental integration timestep
  */
 mpcd::Integrator::Integrator(std::shared_ptr<SystemDefinition> sysdef, Scalar deltaT)
-    : IntegratorTwoStep(sysdef, deltaT)
+    : IntegratorTwoStep(sysdef, deltaT), m_bin_while_streaming(false),
+      m_overlap_comm(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing MPCD Integrator" << std::endl;
     }
@@ -44,10 +45,12 @@ void mpcd::Integrator::update(uint64_t timestep)
     {
     IntegratorTwoStep::update(timestep);
 
-    // remove any leftover virtual particles
+    // remove any leftover virtual particles, unless the fillers keep them
+    const bool refill = checkCollide(timestep) && canRefillVirtualParticles();
     if (checkCollide(timestep))
         {
-        m_sysdef->getMPCDParticleData()->removeVirtualParticles();
+        if (!refill)
+            m_sysdef->getMPCDParticleData()->removeVirtualParticles();
         m_collide->drawGridShift(timestep);
         }
 
@@ -61,7 +64,10 @@ void mpcd::Integrator::update(uint64_t timestep)
         {
         for (auto filler = m_fillers.begin(); filler != m_fillers.end(); ++filler)
             {
-            (*filler)->fill(timestep);
+            if (refill)
+                (*filler)->refill(timestep);
+            else
+                (*filler)->fill(timestep);
             }
         }
 
@@ -103,8 +109,37 @@ void mpcd::Integrator::update(uint64_t timestep)
     // domains
     if (m_stream)
         {
-        m_stream->stream(timestep);
+        auto thermo = getStreamingCellThermo(timestep);
+        if (thermo)
+            {
+            // the grid shift of the next collision is drawn now so that the streamed particles can
+            // be binned into its cells, and drawing it again at the collision gives the same shift
+            m_collide->drawGridShift(timestep + 1);
+
+            // the streaming method may also sort the particles, and then the sorter skips the
+            // collision step
+            std::shared_ptr<mpcd::Sorter> sorter;
+            if (m_sorter && m_sorter->peekSort(timestep + 1))
+                sorter = m_sorter;
+            m_stream->streamAndBin(timestep, timestep + 1, thermo, sorter);
+            }
+        else
+            {
+            m_stream->stream(timestep);
+            }
+        }
+
+#ifdef ENABLE_MPI
+    // start migrating the MPCD particles for the next collision, which now only depends on the
+    // streamed positions, so that the messages are in flight while the MD forces are computed
+    const bool early_migrate = m_overlap_comm && m_mpcd_comm && checkCollide(timestep + 1);
+    if (early_migrate)
+        {
+        // any virtual particles would be removed before the next collision anyway
+        m_sysdef->getMPCDParticleData()->removeVirtualParticles();
+        m_mpcd_comm->beginCommunicate(timestep + 1);
         }
+#endif // ENABLE_MPI
 
     // compute the net force on the MD particles
 #ifdef ENABLE_HIP
@@ -117,6 +152,11 @@ void mpcd::Integrator::update(uint64_t timestep)
     // perform the second step of the MD integration
     for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
         (*method)->integrateStepTwo(timestep);
+
+#ifdef ENABLE_MPI
+    if (early_migrate)
+        m_mpcd_comm->finishCommunicate();
+#endif // ENABLE_MPI
     }
 
 /*!
@@ -143,6 +183,12 @@ void mpcd::Integrator::prepRun(uint64_t timestep)
     if (m_collide)
         {
         m_collide->drawGridShift(timestep);
+
+        // the particles may have changed since the last run, so cell sums accumulated while
+        // streaming cannot be reused
+        auto thermo = m_collide->getCellThermo();
+        if (thermo)
+            thermo->discardStreamingSums();
         }
 
 #ifdef ENABLE_MPI
@@ -154,6 +200,69 @@ void mpcd::Integrator::prepRun(uint64_t timestep)
 #endif // ENABLE_MPI
     }
 
+/*!
+ * \param timestep Current timestep
+ * \returns The cell thermo compute of the collision method if the streaming step at \a timestep
+ *          should bin the particles for a collision at \a timestep + 1, or a null pointer
+ *
+ * Binning while streaming is only possible when nothing else changes the MPCD particles between
+ * the streaming step and the collision: the simulation must not be domain decomposed, there can be
+ * no virtual particle fillers, and the particles can only be sorted at the collision if the
+ * streaming method can sort them while binning.
+ */
+std::shared_ptr<mpcd::CellThermoCompute>
+mpcd::Integrator::getStreamingCellThermo(uint64_t timestep)
+    {
+    if (!m_bin_while_streaming || !m_stream || !m_stream->peekStream(timestep)
+        || !checkCollide(timestep + 1))
+        {
+        return std::shared_ptr<mpcd::CellThermoCompute>();
+        }
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        return std::shared_ptr<mpcd::CellThermoCompute>();
+        }
+#endif // ENABLE_MPI
+
+    if (!m_fillers.empty() || m_sysdef->getMPCDParticleData()->getNVirtual() > 0
+        || (m_sorter && m_sorter->peekSort(timestep + 1) && !m_sorter->canSortWhileStreaming()))
+        {
+        return std::shared_ptr<mpcd::CellThermoCompute>();
+        }
+
+    return m_collide->getCellThermo();
+    }
+
+/*!
+ * \returns True if all virtual particle fillers can redraw the virtual particles from their last
+ *          fill in place
+ *
+ * The virtual particles can only be kept when they are exactly those added by the current fillers,
+ * and when the particles are not migrated (which removes the virtual particles).
+ */
+bool mpcd::Integrator::canRefillVirtualParticles()
+    {
+    if (m_fillers.empty())
+        return false;
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        return false;
+#endif // ENABLE_MPI
+
+    unsigned int N_virtual = 0;
+    for (auto filler = m_fillers.begin(); filler != m_fillers.end(); ++filler)
+        {
+        if (!(*filler)->canRefill())
+            return false;
+        N_virtual += (*filler)->getNumFill();
+        }
+
+    return N_virtual == m_sysdef->getMPCDParticleData()->getNVirtual();
+    }
+
 /*!
  * \param filler Virtual particle filler to add to the integrator
  *
@@ -191,6 +300,12 @@ void mpcd::detail::export_Integrator(pybind11::module& m)
         .def("removeSorter", &mpcd::Integrator::removeSorter)
         .def("addFiller", &mpcd::Integrator::addFiller)
         .def("removeAllFillers", &mpcd::Integrator::removeAllFillers)
+        .def_property("bin_while_streaming",
+                      &mpcd::Integrator::getBinWhileStreaming,
+                      &mpcd::Integrator::setBinWhileStreaming)
+        .def_property("overlap_communication",
+                      &mpcd::Integrator::getOverlapCommunication,
+                      &mpcd::Integrator::setOverlapCommunication)
 #ifdef ENABLE_MPI
         .def("setMPCDCommunicator", &mpcd::Integrator::setMPCDCommunicator)
 #endif // ENABLE_MPI
@@ -137,6 +137,38 @@ class PYBIND11_EXPORT Integrator : public hoomd::md::IntegratorTwoStep
         m_sorter.reset();
         }
 
+    //! Get if the streaming step bins the particles for the next collision
+    bool getBinWhileStreaming() const
+        {
+        return m_bin_while_streaming;
+        }
+
+    //! Set if the streaming step bins the particles for the next collision
+    /*!
+     * \param bin_while_streaming If true, the streaming step that precedes a collision also builds
+     *        its cell list and sums its cell properties when possible
+     */
+    void setBinWhileStreaming(bool bin_while_streaming)
+        {
+        m_bin_while_streaming = bin_while_streaming;
+        }
+
+    //! Get if the MPCD particle migration is overlapped with the MD force computation
+    bool getOverlapCommunication() const
+        {
+        return m_overlap_comm;
+        }
+
+    //! Set if the MPCD particle migration is overlapped with the MD force computation
+    /*!
+     * \param overlap_comm If true, the particles are migrated for the next collision right after
+     *        the streaming step, and the migration completes after the MD forces are computed
+     */
+    void setOverlapCommunication(bool overlap_comm)
+        {
+        m_overlap_comm = overlap_comm;
+        }
+
     //! Add a virtual particle filling method
     void addFiller(std::shared_ptr<mpcd::VirtualParticleFiller> filler);
 
@@ -157,12 +189,22 @@ class PYBIND11_EXPORT Integrator : public hoomd::md::IntegratorTwoStep
 
     std::vector<std::shared_ptr<mpcd::VirtualParticleFiller>>
         m_fillers; //!< MPCD virtual particle fillers
+
+    bool m_bin_while_streaming; //!< Bin the particles for the next collision while streaming
+    bool m_overlap_comm;        //!< Overlap the particle migration with the MD force computation
+
     private:
     //! Check if a collision will occur at the current timestep
     bool checkCollide(uint64_t timestep)
         {
         return (m_collide && m_collide->peekCollide(timestep));
         }
+
+    //! Get the cell thermo compute to sum while streaming at the current timestep
+    std::shared_ptr<mpcd::CellThermoCompute> getStreamingCellThermo(uint64_t timestep);
+
+    //! Check if the virtual particles from the last fill can be refilled in place
+    bool canRefillVirtualParticles();
     };
 
 namespace detail
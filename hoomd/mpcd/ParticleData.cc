@@ -45,7 +45,7 @@ mpcd::ParticleData::ParticleData(unsigned int N,
                                  std::shared_ptr<ExecutionConfiguration> exec_conf,
                                  std::shared_ptr<DomainDecomposition> decomposition)
     : m_N(0), m_N_virtual(0), m_N_global(0), m_N_max(0), m_exec_conf(exec_conf), m_mass(1.0),
-      m_valid_cell_cache(false)
+      m_compact_storage(false), m_valid_cell_cache(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing MPCD ParticleData" << endl;
 
@@ -75,7 +75,7 @@ mpcd::ParticleData::ParticleData(const mpcd::ParticleDataSnapshot& snapshot,
                                  std::shared_ptr<const ExecutionConfiguration> exec_conf,
                                  std::shared_ptr<DomainDecomposition> decomposition)
     : m_N(0), m_N_virtual(0), m_N_global(0), m_N_max(0), m_exec_conf(exec_conf), m_mass(1.0),
-      m_valid_cell_cache(false)
+      m_compact_storage(false), m_valid_cell_cache(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing MPCD ParticleData" << endl;
 
@@ -651,15 +651,22 @@ void mpcd::ParticleData::allocate(unsigned int N_max)
         }
 #endif // ENABLE_MPI
 
-    // Allocate the alternate data
-    GPUArray<Scalar4> pos_alt(N_max, m_exec_conf);
-    m_pos_alt.swap(pos_alt);
+    // Allocate the alternate data, unless it is allocated on demand
+    if (m_compact_storage)
+        {
+        releaseAlternates();
+        }
+    else
+        {
+        GPUArray<Scalar4> pos_alt(N_max, m_exec_conf);
+        m_pos_alt.swap(pos_alt);
 
-    GPUArray<Scalar4> vel_alt(N_max, m_exec_conf);
-    m_vel_alt.swap(vel_alt);
+        GPUArray<Scalar4> vel_alt(N_max, m_exec_conf);
+        m_vel_alt.swap(vel_alt);
 
-    GPUArray<unsigned int> tag_alt(N_max, m_exec_conf);
-    m_tag_alt.swap(tag_alt);
+        GPUArray<unsigned int> tag_alt(N_max, m_exec_conf);
+        m_tag_alt.swap(tag_alt);
+        }
 
 #ifdef ENABLE_MPI
     if (m_decomposition)
@@ -704,10 +711,17 @@ void mpcd::ParticleData::reallocate(unsigned int N_max)
         }
 #endif // ENABLE_MPI
 
-    // Reallocate the alternate data
-    m_pos_alt.resize(N_max);
-    m_vel_alt.resize(N_max);
-    m_tag_alt.resize(N_max);
+    // Reallocate the alternate data, which does not need to be preserved with compact storage
+    if (m_compact_storage)
+        {
+        releaseAlternates();
+        }
+    else
+        {
+        m_pos_alt.resize(N_max);
+        m_vel_alt.resize(N_max);
+        m_tag_alt.resize(N_max);
+        }
 #ifdef ENABLE_MPI
     if (m_decomposition)
         {
@@ -721,6 +735,50 @@ void mpcd::ParticleData::reallocate(unsigned int N_max)
 #endif // ENABLE_MPI
     }
 
+/*!
+ * With compact storage, the alternate position, velocity, and tag arrays are freed so that they
+ * do not take up memory between uses. They are allocated again the next time they are requested.
+ * Callers should only release the alternate arrays once their contents are no longer needed,
+ * e.g., after a sort has been applied. Nothing is done without compact storage.
+ */
+void mpcd::ParticleData::releaseAlternates()
+    {
+    if (!m_compact_storage)
+        return;
+
+    GPUArray<Scalar4> pos_alt;
+    m_pos_alt.swap(pos_alt);
+
+    GPUArray<Scalar4> vel_alt;
+    m_vel_alt.swap(vel_alt);
+
+    GPUArray<unsigned int> tag_alt;
+    m_tag_alt.swap(tag_alt);
+    }
+
+/*!
+ * \param compact_storage If true, only allocate the alternate arrays while they are used
+ *
+ * The alternate arrays are scratch space for reordering the particles (e.g., when sorting), and
+ * they hold as many bytes per particle as the positions, velocities, and tags. Compact storage
+ * roughly halves the memory that the particle data holds between sorts, at the cost of
+ * allocating the alternate arrays again whenever they are needed.
+ */
+void mpcd::ParticleData::setCompactStorage(bool compact_storage)
+    {
+    m_compact_storage = compact_storage;
+    if (m_compact_storage)
+        {
+        releaseAlternates();
+        }
+    else
+        {
+        allocateAlternate(m_pos_alt);
+        allocateAlternate(m_vel_alt);
+        allocateAlternate(m_tag_alt);
+        }
+    }
+
 /*!
  * \param N New number of particles held by the data
  *
@@ -1294,7 +1352,10 @@ void mpcd::detail::export_ParticleData(pybind11::module& m)
         .def_property_readonly("types", &mpcd::ParticleData::getTypeNames)
         .def("getNameByType", &mpcd::ParticleData::getNameByType)
         .def("getTypeByName", &mpcd::ParticleData::getTypeByName)
-        .def_property("mass", &mpcd::ParticleData::getMass, &mpcd::ParticleData::setMass);
+        .def_property("mass", &mpcd::ParticleData::getMass, &mpcd::ParticleData::setMass)
+        .def_property("compact_storage",
+                      &mpcd::ParticleData::getCompactStorage,
+                      &mpcd::ParticleData::setCompactStorage);
     }
 
     } // end namespace hoomd
@@ -214,8 +214,12 @@ class PYBIND11_EXPORT ParticleData : public Autotuned
     //! \name swap methods
     //@{
     //! Get alternate array of MPCD particle positions
-    const GPUArray<Scalar4>& getAltPositions() const
+    /*!
+     * With compact storage, the alternate arrays are only allocated when they are requested.
+     */
+    const GPUArray<Scalar4>& getAltPositions()
         {
+        allocateAlternate(m_pos_alt);
         return m_pos_alt;
         }
 
@@ -226,8 +230,9 @@ class PYBIND11_EXPORT ParticleData : public Autotuned
         }
 
     //! Get alternate array of MPCD particle velocities
-    const GPUArray<Scalar4>& getAltVelocities() const
+    const GPUArray<Scalar4>& getAltVelocities()
         {
+        allocateAlternate(m_vel_alt);
         return m_vel_alt;
         }
 
@@ -238,8 +243,9 @@ class PYBIND11_EXPORT ParticleData : public Autotuned
         }
 
     //! Get alternate array of MPCD particle tags
-    const GPUArray<unsigned int>& getAltTags() const
+    const GPUArray<unsigned int>& getAltTags()
         {
+        allocateAlternate(m_tag_alt);
         return m_tag_alt;
         }
 
@@ -248,6 +254,18 @@ class PYBIND11_EXPORT ParticleData : public Autotuned
         {
         m_tag.swap(m_tag_alt);
         }
+
+    //! Release the alternate arrays when using compact storage
+    void releaseAlternates();
+
+    //! Get if the alternate arrays are only allocated while they are used
+    bool getCompactStorage() const
+        {
+        return m_compact_storage;
+        }
+
+    //! Set if the alternate arrays are only allocated while they are used
+    void setCompactStorage(bool compact_storage);
     //@}
 
     //! \name signal methods
@@ -437,6 +455,7 @@ class PYBIND11_EXPORT ParticleData : public Autotuned
 #endif                                            // ENABLE_HIP
 #endif                                            // ENABLE_MPI
 
+    bool m_compact_storage;                //!< If true, alternate arrays are allocated on demand
     bool m_valid_cell_cache;               //!< Flag for validity of cell cache
     SortSignal m_sort_signal;              //!< Signal triggered when particles are sorted
     Nano::Signal<void()> m_virtual_signal; //!< Signal for number of virtual particles changing
@@ -456,6 +475,16 @@ class PYBIND11_EXPORT ParticleData : public Autotuned
     //! Reallocate data arrays
     void reallocate(unsigned int N_max);
 
+    //! Allocate an alternate array if it cannot hold all the particles
+    template<class T> void allocateAlternate(GPUArray<T>& alt)
+        {
+        if (alt.getNumElements() < m_N_max)
+            {
+            GPUArray<T> tmp(m_N_max, m_exec_conf);
+            alt.swap(tmp);
+            }
+        }
+
     const static float resize_factor; //!< Amortized growth factor the data arrays
     //! Resize the data
     void resize(unsigned int N);
@@ -37,6 +37,12 @@ class PYBIND11_EXPORT SRDCollisionMethod : public mpcd::CollisionMethod
 
     void setCellList(std::shared_ptr<mpcd::CellList> cl);
 
+    //! Get the cell thermo compute used by the collision rule
+    std::shared_ptr<mpcd::CellThermoCompute> getCellThermo() const
+        {
+        return m_thermo;
+        }
+
     //! Get the MPCD rotation angle
     double getRotationAngle() const
         {
@@ -77,6 +77,23 @@ void mpcd::SlitGeometryFiller::computeNumFill()
  * \param timestep Current timestep to draw particles
  */
 void mpcd::SlitGeometryFiller::drawParticles(uint64_t timestep)
+    {
+    draw(timestep, true);
+    }
+
+/*!
+ * \param timestep Current timestep to draw velocities
+ */
+void mpcd::SlitGeometryFiller::drawVelocities(uint64_t timestep)
+    {
+    draw(timestep, false);
+    }
+
+/*!
+ * \param timestep Current timestep to draw particles
+ * \param draw_positions If true, draw the positions and tags, otherwise keep them
+ */
+void mpcd::SlitGeometryFiller::draw(uint64_t timestep, bool draw_positions)
     {
     ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(),
                                access_location::host,
@@ -96,8 +113,6 @@ void mpcd::SlitGeometryFiller::drawParticles(uint64_t timestep)
 
     uint16_t seed = m_sysdef->getSeed();
 
-    // index to start filling from
-    const unsigned int first_idx = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual() - m_N_fill;
     for (unsigned int i = 0; i < m_N_fill; ++i)
         {
         const unsigned int tag = m_first_tag + i;
@@ -116,11 +131,15 @@ void mpcd::SlitGeometryFiller::drawParticles(uint64_t timestep)
             hi.z = m_z_max;
             }
 
-        const unsigned int pidx = first_idx + i;
-        h_pos.data[pidx] = make_scalar4(hoomd::UniformDistribution<Scalar>(lo.x, hi.x)(rng),
-                                        hoomd::UniformDistribution<Scalar>(lo.y, hi.y)(rng),
-                                        hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng),
-                                        __int_as_scalar(m_type));
+        const unsigned int pidx = m_first_idx + i;
+        if (draw_positions)
+            {
+            h_pos.data[pidx] = make_scalar4(hoomd::UniformDistribution<Scalar>(lo.x, hi.x)(rng),
+                                            hoomd::UniformDistribution<Scalar>(lo.y, hi.y)(rng),
+                                            hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng),
+                                            __int_as_scalar(m_type));
+            h_tag.data[pidx] = tag;
+            }
 
         hoomd::NormalDistribution<Scalar> gen(vel_factor, 0.0);
         Scalar3 vel;
@@ -132,7 +151,6 @@ void mpcd::SlitGeometryFiller::drawParticles(uint64_t timestep)
                                         vel.y,
                                         vel.z,
                                         __int_as_scalar(mpcd::detail::NO_CELL));
-        h_tag.data[pidx] = tag;
         }
     }
 
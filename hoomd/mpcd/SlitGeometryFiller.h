@@ -41,6 +41,7 @@ class PYBIND11_EXPORT SlitGeometryFiller : public mpcd::VirtualParticleFiller
     void setGeometry(std::shared_ptr<const mpcd::detail::SlitGeometry> geom)
         {
         m_geom = geom;
+        m_can_refill = false;
         }
 
     protected:
@@ -55,6 +56,13 @@ class PYBIND11_EXPORT SlitGeometryFiller : public mpcd::VirtualParticleFiller
 
     //! Draw particles within the fill volume
     virtual void drawParticles(uint64_t timestep);
+
+    //! Redraw the velocities of the filled particles
+    virtual void drawVelocities(uint64_t timestep);
+
+    private:
+    //! Draw the filled particles, optionally keeping their positions
+    void draw(uint64_t timestep, bool draw_positions);
     };
 
 namespace detail
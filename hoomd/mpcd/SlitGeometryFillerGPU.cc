@@ -29,6 +29,23 @@ mpcd::SlitGeometryFillerGPU::SlitGeometryFillerGPU(
  * \param timestep Current timestep
  */
 void mpcd::SlitGeometryFillerGPU::drawParticles(uint64_t timestep)
+    {
+    draw(timestep, true);
+    }
+
+/*!
+ * \param timestep Current timestep
+ */
+void mpcd::SlitGeometryFillerGPU::drawVelocities(uint64_t timestep)
+    {
+    draw(timestep, false);
+    }
+
+/*!
+ * \param timestep Current timestep
+ * \param draw_positions If true, draw the positions and tags, otherwise keep them
+ */
+void mpcd::SlitGeometryFillerGPU::draw(uint64_t timestep, bool draw_positions)
     {
     ArrayHandle<Scalar4> d_pos(m_mpcd_pdata->getPositions(),
                                access_location::device,
@@ -40,8 +57,6 @@ void mpcd::SlitGeometryFillerGPU::drawParticles(uint64_t timestep)
                                     access_location::device,
                                     access_mode::readwrite);
 
-    const unsigned int first_idx = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual() - m_N_fill;
-
     uint16_t seed = m_sysdef->getSeed();
 
     m_tuner->begin();
@@ -57,7 +72,8 @@ void mpcd::SlitGeometryFillerGPU::drawParticles(uint64_t timestep)
                                    m_N_lo,
                                    m_N_hi,
                                    m_first_tag,
-                                   first_idx,
+                                   m_first_idx,
+                                   draw_positions,
                                    (*m_T)(timestep),
                                    timestep,
                                    seed,
@@ -32,6 +32,7 @@ namespace kernel
  * \param N_hi Number of particles to fill in upper region
  * \param first_tag First tag of filled particles
  * \param first_idx First (local) particle index of filled particles
+ * \param draw_positions If true, draw the positions and tags, otherwise keep them
  * \param vel_factor Scale factor for uniform normal velocities consistent with particle mass /
  * temperature \param timestep Current timestep \param seed User seed to PRNG for drawing velocities
  *
@@ -40,7 +41,8 @@ namespace kernel
  * Using one thread per particle (in both slabs), the thread is assigned to fill either the lower
  * or upper region. This defines a local cuboid of volume to fill. The thread index is translated
  * into a particle tag and local particle index. A random position is drawn within the cuboid. A
- * random velocity is drawn consistent with the speed of the moving wall.
+ * random velocity is drawn consistent with the speed of the moving wall. The position and tag are
+ * left unchanged if \a draw_positions is false.
  */
 __global__ void slit_draw_particles(Scalar4* d_pos,
                                     Scalar4* d_vel,
@@ -54,6 +56,7 @@ __global__ void slit_draw_particles(Scalar4* d_pos,
                                     const unsigned int N_tot,
                                     const unsigned int first_tag,
                                     const unsigned int first_idx,
+                                    const bool draw_positions,
                                     const Scalar vel_factor,
                                     const uint64_t timestep,
                                     const uint16_t seed)
@@ -81,16 +84,19 @@ __global__ void slit_draw_particles(Scalar4* d_pos,
     // particle tag and index
     const unsigned int tag = first_tag + idx;
     const unsigned int pidx = first_idx + idx;
-    d_tag[pidx] = tag;
 
     // initialize random number generator for positions and velocity
     hoomd::RandomGenerator rng(
         hoomd::Seed(hoomd::RNGIdentifier::SlitGeometryFiller, timestep, seed),
         hoomd::Counter(tag));
-    d_pos[pidx] = make_scalar4(hoomd::UniformDistribution<Scalar>(lo.x, hi.x)(rng),
-                               hoomd::UniformDistribution<Scalar>(lo.y, hi.y)(rng),
-                               hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng),
-                               __int_as_scalar(type));
+    if (draw_positions)
+        {
+        d_tag[pidx] = tag;
+        d_pos[pidx] = make_scalar4(hoomd::UniformDistribution<Scalar>(lo.x, hi.x)(rng),
+                                   hoomd::UniformDistribution<Scalar>(lo.y, hi.y)(rng),
+                                   hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng),
+                                   __int_as_scalar(type));
+        }
 
     hoomd::NormalDistribution<Scalar> gen(vel_factor, 0.0);
     Scalar3 vel;
@@ -119,6 +125,7 @@ __global__ void slit_draw_particles(Scalar4* d_pos,
  * \param N_hi Number of particles to fill in upper region
  * \param first_tag First tag of filled particles
  * \param first_idx First (local) particle index of filled particles
+ * \param draw_positions If true, draw the positions and tags, otherwise keep them
  * \param kT Temperature for fill particles
  * \param timestep Current timestep
  * \param seed User seed to PRNG for drawing velocities
@@ -139,6 +146,7 @@ cudaError_t slit_draw_particles(Scalar4* d_pos,
                                 const unsigned int N_hi,
                                 const unsigned int first_tag,
                                 const unsigned int first_idx,
+                                const bool draw_positions,
                                 const Scalar kT,
                                 const uint64_t timestep,
                                 const uint16_t seed,
@@ -170,6 +178,7 @@ cudaError_t slit_draw_particles(Scalar4* d_pos,
                                                           N_tot,
                                                           first_tag,
                                                           first_idx,
+                                                          draw_positions,
                                                           vel_factor,
                                                           timestep,
                                                           seed);
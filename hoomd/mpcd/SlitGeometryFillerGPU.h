@@ -36,7 +36,13 @@ class PYBIND11_EXPORT SlitGeometryFillerGPU : public mpcd::SlitGeometryFiller
     //! Draw particles within the fill volume on the GPU
     virtual void drawParticles(uint64_t timestep);
 
+    //! Redraw the velocities of the filled particles on the GPU
+    virtual void drawVelocities(uint64_t timestep);
+
     private:
+    //! Draw the filled particles on the GPU, optionally keeping their positions
+    void draw(uint64_t timestep, bool draw_positions);
+
     std::shared_ptr<hoomd::Autotuner<1>> m_tuner; //!< Autotuner for drawing particles
     };
 
@@ -168,6 +168,17 @@ class __attribute__((visibility("default"))) SlitPoreGeometry
         return ((pos.x > -m_L && pos.x < m_L) && (pos.z > m_H || pos.z < -m_H));
         }
 
+    //! Check if a region lies entirely out of bounds
+    /*!
+     * \param lo Lower bound of the region
+     * \param hi Upper bound of the region
+     * \returns True if every point of the region is out of bounds, and false otherwise
+     */
+    HOSTDEVICE bool isCellOutside(const Scalar3& lo, const Scalar3& hi) const
+        {
+        return ((lo.x > -m_L && hi.x < m_L) && (lo.z > m_H || hi.z < -m_H));
+        }
+
     //! Validate that the simulation box is large enough for the geometry
     /*!
      * \param box Global simulation box
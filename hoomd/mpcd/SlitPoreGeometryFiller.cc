@@ -145,6 +145,23 @@ void mpcd::SlitPoreGeometryFiller::computeNumFill()
  * \param timestep Current timestep to draw particles
  */
 void mpcd::SlitPoreGeometryFiller::drawParticles(uint64_t timestep)
+    {
+    draw(timestep, true);
+    }
+
+/*!
+ * \param timestep Current timestep to draw velocities
+ */
+void mpcd::SlitPoreGeometryFiller::drawVelocities(uint64_t timestep)
+    {
+    draw(timestep, false);
+    }
+
+/*!
+ * \param timestep Current timestep to draw particles
+ * \param draw_positions If true, draw the positions and tags, otherwise keep them
+ */
+void mpcd::SlitPoreGeometryFiller::draw(uint64_t timestep, bool draw_positions)
     {
     // quit early if not filling to ensure we don't access any memory that hasn't been set
     if (m_N_fill == 0)
@@ -174,8 +191,6 @@ void mpcd::SlitPoreGeometryFiller::drawParticles(uint64_t timestep)
 
     uint16_t seed = m_sysdef->getSeed();
 
-    // index to start filling from
-    const unsigned int first_idx = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual() - m_N_fill;
     for (unsigned int i = 0; i < m_N_fill; ++i)
         {
         const unsigned int tag = m_first_tag + i;
@@ -195,11 +210,15 @@ void mpcd::SlitPoreGeometryFiller::drawParticles(uint64_t timestep)
             hi.z = fillbox.w;
             }
 
-        const unsigned int pidx = first_idx + i;
-        h_pos.data[pidx] = make_scalar4(hoomd::UniformDistribution<Scalar>(lo.x, hi.x)(rng),
-                                        hoomd::UniformDistribution<Scalar>(lo.y, hi.y)(rng),
-                                        hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng),
-                                        __int_as_scalar(m_type));
+        const unsigned int pidx = m_first_idx + i;
+        if (draw_positions)
+            {
+            h_pos.data[pidx] = make_scalar4(hoomd::UniformDistribution<Scalar>(lo.x, hi.x)(rng),
+                                            hoomd::UniformDistribution<Scalar>(lo.y, hi.y)(rng),
+                                            hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng),
+                                            __int_as_scalar(m_type));
+            h_tag.data[pidx] = tag;
+            }
 
         hoomd::NormalDistribution<Scalar> gen(vel_factor, 0.0);
         Scalar3 vel;
@@ -209,7 +228,6 @@ void mpcd::SlitPoreGeometryFiller::drawParticles(uint64_t timestep)
         // reference?)
         h_vel.data[pidx]
             = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(mpcd::detail::NO_CELL));
-        h_tag.data[pidx] = tag;
         }
     }
 
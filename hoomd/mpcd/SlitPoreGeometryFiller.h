@@ -42,6 +42,7 @@ class PYBIND11_EXPORT SlitPoreGeometryFiller : public mpcd::VirtualParticleFille
     void setGeometry(std::shared_ptr<const mpcd::detail::SlitPoreGeometry> geom)
         {
         m_geom = geom;
+        m_can_refill = false;
         notifyRecompute();
         }
 
@@ -59,7 +60,13 @@ class PYBIND11_EXPORT SlitPoreGeometryFiller : public mpcd::VirtualParticleFille
     //! Draw particles within the fill volume
     virtual void drawParticles(uint64_t timestep);
 
+    //! Redraw the velocities of the filled particles
+    virtual void drawVelocities(uint64_t timestep);
+
     private:
+    //! Draw the filled particles, optionally keeping their positions
+    void draw(uint64_t timestep, bool draw_positions);
+
     bool m_needs_recompute;
     Scalar3 m_recompute_cache;
     void notifyRecompute()
@@ -30,6 +30,23 @@ mpcd::SlitPoreGeometryFillerGPU::SlitPoreGeometryFillerGPU(
  * \param timestep Current timestep
  */
 void mpcd::SlitPoreGeometryFillerGPU::drawParticles(uint64_t timestep)
+    {
+    draw(timestep, true);
+    }
+
+/*!
+ * \param timestep Current timestep
+ */
+void mpcd::SlitPoreGeometryFillerGPU::drawVelocities(uint64_t timestep)
+    {
+    draw(timestep, false);
+    }
+
+/*!
+ * \param timestep Current timestep
+ * \param draw_positions If true, draw the positions and tags, otherwise keep them
+ */
+void mpcd::SlitPoreGeometryFillerGPU::draw(uint64_t timestep, bool draw_positions)
     {
     ArrayHandle<Scalar4> d_pos(m_mpcd_pdata->getPositions(),
                                access_location::device,
@@ -45,8 +62,6 @@ void mpcd::SlitPoreGeometryFillerGPU::drawParticles(uint64_t timestep)
     ArrayHandle<Scalar4> d_boxes(m_boxes, access_location::device, access_mode::read);
     ArrayHandle<uint2> d_ranges(m_ranges, access_location::device, access_mode::read);
 
-    const unsigned int first_idx = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual() - m_N_fill;
-
     uint16_t seed = m_sysdef->getSeed();
 
     m_tuner->begin();
@@ -61,7 +76,8 @@ void mpcd::SlitPoreGeometryFillerGPU::drawParticles(uint64_t timestep)
                                         m_mpcd_pdata->getMass(),
                                         m_type,
                                         m_first_tag,
-                                        first_idx,
+                                        m_first_idx,
+                                        draw_positions,
                                         (*m_T)(timestep),
                                         timestep,
                                         seed,
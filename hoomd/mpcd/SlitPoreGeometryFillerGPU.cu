@@ -31,6 +31,7 @@ namespace kernel
  * \param type Type of fill particles
  * \param first_tag First tag of filled particles
  * \param first_idx First (local) particle index of filled particles
+ * \param draw_positions If true, draw the positions and tags, otherwise keep them
  * \param vel_factor Scale factor for uniform normal velocities consistent with particle mass /
  * temperature \param timestep Current timestep \param seed User seed to PRNG for drawing velocities
  *
@@ -39,7 +40,8 @@ namespace kernel
  * Using one thread per particle, the thread is assigned to a fill range matching a 2d bounding box,
  * which defines a cuboid of volume to fill. The thread index is translated into a particle tag
  * and local particle index. A random position is drawn within the cuboid. A random velocity
- * is drawn consistent with the speed of the moving wall.
+ * is drawn consistent with the speed of the moving wall. The position and tag are left unchanged
+ * if \a draw_positions is false.
  */
 __global__ void slit_pore_draw_particles(Scalar4* d_pos,
                                          Scalar4* d_vel,
@@ -52,6 +54,7 @@ __global__ void slit_pore_draw_particles(Scalar4* d_pos,
                                          const unsigned int type,
                                          const unsigned int first_tag,
                                          const unsigned int first_idx,
+                                         const bool draw_positions,
                                          const Scalar vel_factor,
                                          const uint64_t timestep,
                                          const uint16_t seed)
@@ -96,16 +99,19 @@ __global__ void slit_pore_draw_particles(Scalar4* d_pos,
     // particle tag and index
     const unsigned int tag = first_tag + idx;
     const unsigned int pidx = first_idx + idx;
-    d_tag[pidx] = tag;
 
     // initialize random number generator for positions and velocity
     hoomd::RandomGenerator rng(
         hoomd::Seed(hoomd::RNGIdentifier::SlitPoreGeometryFiller, timestep, seed),
         hoomd::Counter(tag));
-    d_pos[pidx] = make_scalar4(hoomd::UniformDistribution<Scalar>(lo.x, hi.x)(rng),
-                               hoomd::UniformDistribution<Scalar>(lo.y, hi.y)(rng),
-                               hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng),
-                               __int_as_scalar(type));
+    if (draw_positions)
+        {
+        d_tag[pidx] = tag;
+        d_pos[pidx] = make_scalar4(hoomd::UniformDistribution<Scalar>(lo.x, hi.x)(rng),
+                                   hoomd::UniformDistribution<Scalar>(lo.y, hi.y)(rng),
+                                   hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng),
+                                   __int_as_scalar(type));
+        }
 
     hoomd::NormalDistribution<Scalar> gen(vel_factor, 0.0);
     Scalar3 vel;
@@ -130,6 +136,7 @@ __global__ void slit_pore_draw_particles(Scalar4* d_pos,
  * \param type Type of fill particles
  * \param first_tag First tag of filled particles
  * \param first_idx First (local) particle index of filled particles
+ * \param draw_positions If true, draw the positions and tags, otherwise keep them
  * \param kT Temperature for fill particles
  * \param timestep Current timestep
  * \param seed User seed to PRNG for drawing velocities
@@ -149,6 +156,7 @@ cudaError_t slit_pore_draw_particles(Scalar4* d_pos,
                                      const unsigned int type,
                                      const unsigned int first_tag,
                                      const unsigned int first_idx,
+                                     const bool draw_positions,
                                      const Scalar kT,
                                      const uint64_t timestep,
                                      const uint16_t seed,
@@ -179,6 +187,7 @@ cudaError_t slit_pore_draw_particles(Scalar4* d_pos,
                                                                              type,
                                                                              first_tag,
                                                                              first_idx,
+                                                                             draw_positions,
                                                                              vel_factor,
                                                                              timestep,
                                                                              seed);
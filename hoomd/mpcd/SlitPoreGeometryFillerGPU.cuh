@@ -34,6 +34,7 @@ cudaError_t slit_pore_draw_particles(Scalar4* d_pos,
                                      const unsigned int type,
                                      const unsigned int first_tag,
                                      const unsigned int first_idx,
+                                     const bool draw_positions,
                                      const Scalar kT,
                                      const uint64_t timestep,
                                      const uint16_t seed,
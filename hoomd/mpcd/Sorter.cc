@@ -75,6 +75,9 @@ void mpcd::Sorter::computeOrder(uint64_t timestep)
     ArrayHandle<unsigned int> h_cell_np(m_cl->getCellSizeArray(),
                                         access_location::host,
                                         access_mode::read);
+    ArrayHandle<unsigned int> h_cell_slot(m_cl->getCellSlots(),
+                                          access_location::host,
+                                          access_mode::read);
     const Index2D& cli = m_cl->getCellListIndexer();
 
     // loop through the cell list to generate the sorting order for MPCD particles
@@ -87,7 +90,7 @@ void mpcd::Sorter::computeOrder(uint64_t timestep)
         const unsigned int np = h_cell_np.data[idx];
         for (unsigned int offset = 0; offset < np; ++offset)
             {
-            const unsigned int pid = h_cell_list.data[cli(offset, idx)];
+            const unsigned int pid = h_cell_list.data[cli(offset, h_cell_slot.data[idx])];
             // only count MPCD particles, and skip embedded particles
             if (pid < N_mpcd)
                 {
@@ -99,14 +102,53 @@ void mpcd::Sorter::computeOrder(uint64_t timestep)
         }
     }
 
+/*!
+ * \param timestep Timestep of the collision that follows the streaming step
+ * \returns True if the particles should be sorted at \a timestep
+ *
+ * When the particles are due to be sorted at \a timestep, the sort is marked as done so that
+ * update() does not sort again, and the order arrays are sized for the streaming method to fill.
+ * The streaming method must put the particles into the same order as computeOrder(): cell by cell
+ * in the order of the cell indexes, and in increasing particle index within each cell. It writes
+ * the sorted particle data into the alternate arrays of the mpcd::ParticleData and then calls
+ * finishStreamingSort().
+ */
+bool mpcd::Sorter::beginStreamingSort(uint64_t timestep)
+    {
+    if (!shouldSort(timestep))
+        return false;
+
+    m_order.resize(m_mpcd_pdata->getN());
+    m_rorder.resize(m_mpcd_pdata->getN());
+    return true;
+    }
+
+/*!
+ * \param timestep Timestep of the collision that follows the streaming step
+ *
+ * The alternate arrays are swapped in, and subscribers are notified of the sort. The cell list
+ * that the streaming method built already holds the sorted indexes, and it has not been marked as
+ * computed yet, so it does not remap them.
+ */
+void mpcd::Sorter::finishStreamingSort(uint64_t timestep)
+    {
+    m_mpcd_pdata->swapPositions();
+    m_mpcd_pdata->swapVelocities();
+    m_mpcd_pdata->swapTags();
+    m_mpcd_pdata->releaseAlternates();
+
+    m_mpcd_pdata->notifySort(timestep, m_order, m_rorder);
+    }
+
 /*!
  * Loop through the ordered set of particles, and apply the sorted order. This is
  * intentionally broken out from computeOrder() so that other sorting rules could
  * be implemented without having to duplicate the application of the sort.
  *
  * The sorted order is applied by swapping out the alternate per-particle data
- * arrays. The communication flags are \b not sorted in MPI because by design,
- * the caller is responsible for clearing out any old flags before using them.
+ * arrays, which are released afterwards when the particle data uses compact storage.
+ * The communication flags are \b not sorted in MPI because by design, the caller is
+ * responsible for clearing out any old flags before using them.
  */
 void mpcd::Sorter::applyOrder() const
     {
@@ -157,6 +199,7 @@ void mpcd::Sorter::applyOrder() const
     m_mpcd_pdata->swapPositions();
     m_mpcd_pdata->swapVelocities();
     m_mpcd_pdata->swapTags();
+    m_mpcd_pdata->releaseAlternates();
     }
 
 bool mpcd::Sorter::peekSort(uint64_t timestep) const
@@ -62,6 +62,33 @@ class PYBIND11_EXPORT Sorter : public Autotuned
         m_next_timestep = multiple * m_period;
         }
 
+    //! Check if a streaming method can apply the sort while it bins the particles
+    /*!
+     * \returns True if the streaming method can sort with the order of computeOrder()
+     */
+    virtual bool canSortWhileStreaming() const
+        {
+        return true;
+        }
+
+    //! Begin a sort that a streaming method applies while it bins the particles
+    bool beginStreamingSort(uint64_t timestep);
+
+    //! Finish a sort that a streaming method applied while it binned the particles
+    void finishStreamingSort(uint64_t timestep);
+
+    //! Get the map from new sorted indexes onto old particle indexes
+    GPUVector<unsigned int>& getOrder()
+        {
+        return m_order;
+        }
+
+    //! Get the map from old particle indexes onto new sorted indexes
+    GPUVector<unsigned int>& getReverseOrder()
+        {
+        return m_rorder;
+        }
+
     //! Set the cell list used for sorting
     virtual void setCellList(std::shared_ptr<mpcd::CellList> cl)
         {
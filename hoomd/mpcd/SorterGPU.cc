@@ -103,8 +103,9 @@ void mpcd::SorterGPU::computeOrder(uint64_t timestep)
 
 /*!
  * The sorted order is applied by swapping out the alternate per-particle data
- * arrays. The communication flags are \b not sorted in MPI because by design,
- * the caller is responsible for clearing out any old flags before using them.
+ * arrays, which are released afterwards when the particle data uses compact storage.
+ * The communication flags are \b not sorted in MPI because by design, the caller is
+ * responsible for clearing out any old flags before using them.
  */
 void mpcd::SorterGPU::applyOrder() const
     {
@@ -171,6 +172,7 @@ void mpcd::SorterGPU::applyOrder() const
     m_mpcd_pdata->swapPositions();
     m_mpcd_pdata->swapVelocities();
     m_mpcd_pdata->swapTags();
+    m_mpcd_pdata->releaseAlternates();
     }
 
 /*!
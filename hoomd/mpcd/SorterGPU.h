@@ -33,6 +33,12 @@ class PYBIND11_EXPORT SorterGPU : public mpcd::Sorter
               unsigned int cur_timestep,
               unsigned int period);
 
+    //! The streaming methods do not sort on the GPU
+    virtual bool canSortWhileStreaming() const
+        {
+        return false;
+        }
+
     protected:
     /// Kernel tuner for filling sentinels in cell list.
     std::shared_ptr<Autotuner<1>> m_sentinel_tuner;
@@ -14,7 +14,9 @@
 #endif
 
 #include "CellList.h"
+#include "CellThermoCompute.h"
 #include "ExternalField.h"
+#include "Sorter.h"
 #include "hoomd/Autotuned.h"
 #include "hoomd/GPUPolymorph.h"
 #include "hoomd/SystemDefinition.h"
@@ -44,6 +46,27 @@ class PYBIND11_EXPORT StreamingMethod : public Autotuned
     //! Implementation of the streaming rule
     virtual void stream(uint64_t timestep) { }
 
+    //! Stream the particles and bin them for the collision that follows
+    /*!
+     * \param timestep Current time to stream
+     * \param bin_timestep Timestep of the collision that follows the streaming step
+     * \param thermo Cell thermo compute used by the collision
+     * \param sorter Sorter that is due at \a bin_timestep, or a null pointer
+     *
+     * Streaming methods that can bin the streamed particles into the cell list and sum the cell
+     * properties of \a thermo in the same sweep override this method. They may also sort the
+     * particles with \a sorter as they bin them, see mpcd::Sorter::beginStreamingSort(). The
+     * default implementation only streams, and the collision then computes the cell list and
+     * properties and sorts the particles itself.
+     */
+    virtual void streamAndBin(uint64_t timestep,
+                              uint64_t bin_timestep,
+                              std::shared_ptr<mpcd::CellThermoCompute> thermo,
+                              std::shared_ptr<mpcd::Sorter> sorter)
+        {
+        stream(timestep);
+        }
+
     //! Peek if the next step requires streaming
     virtual bool peekStream(uint64_t timestep) const;
 
@@ -81,6 +104,12 @@ class PYBIND11_EXPORT StreamingMethod : public Autotuned
     //! Set the period of the streaming method
     void setPeriod(unsigned int cur_timestep, unsigned int period);
 
+    //! Get the cell list used for collisions
+    std::shared_ptr<mpcd::CellList> getCellList() const
+        {
+        return m_cl;
+        }
+
     //! Set the cell list used for collisions
     virtual void setCellList(std::shared_ptr<mpcd::CellList> cl)
         {
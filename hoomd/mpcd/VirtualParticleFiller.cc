@@ -16,7 +16,8 @@ mpcd::VirtualParticleFiller::VirtualParticleFiller(std::shared_ptr<SystemDefinit
                                                    std::shared_ptr<Variant> T)
     : m_sysdef(sysdef), m_pdata(m_sysdef->getParticleData()), m_exec_conf(m_pdata->getExecConf()),
       m_mpcd_pdata(m_sysdef->getMPCDParticleData()), m_density(density), m_type(type), m_T(T),
-      m_N_fill(0), m_first_tag(0)
+      m_N_fill(0), m_first_tag(0), m_first_idx(0), m_persistent(false), m_can_refill(false),
+      m_refill_N(0), m_refill_cell(0), m_refill_shift(0)
     {
     }
 
@@ -50,11 +51,46 @@ void mpcd::VirtualParticleFiller::fill(uint64_t timestep)
 
     // add the new virtual particles locally
     m_mpcd_pdata->addVirtualParticles(m_N_fill);
+    m_first_idx = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual() - m_N_fill;
 
     // draw the particles consistent with those tags
     drawParticles(timestep);
 
     m_mpcd_pdata->invalidateCellCache();
+
+    // remember what the fill depended on so that it can be reused
+    m_can_refill = m_persistent;
+    m_refill_N = m_mpcd_pdata->getN();
+    m_refill_box = m_pdata->getBox();
+    m_refill_cell = m_cl->getCellSize();
+    m_refill_shift = m_cl->getMaxGridShift();
+    }
+
+/*!
+ * \param timestep Current timestep
+ *
+ * The virtual particles added by the last fill() are kept at their positions, and only their
+ * velocities are redrawn. The caller must check canRefill() first.
+ */
+void mpcd::VirtualParticleFiller::refill(uint64_t timestep)
+    {
+    drawVelocities(timestep);
+    m_mpcd_pdata->invalidateCellCache();
+    }
+
+/*!
+ * \returns True if the filler is persistent and the particles added by the last fill() are still
+ *          valid for the current box, cell list, and fill parameters
+ *
+ * The caller is responsible for making sure that the virtual particles have not been removed since
+ * the last fill().
+ */
+bool mpcd::VirtualParticleFiller::canRefill() const
+    {
+    return m_persistent && m_can_refill && m_cl && m_mpcd_pdata->getN() == m_refill_N
+           && m_first_idx + m_N_fill <= m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual()
+           && m_pdata->getBox() == m_refill_box && m_cl->getCellSize() == m_refill_cell
+           && m_cl->getMaxGridShift() == m_refill_shift;
     }
 
 void mpcd::VirtualParticleFiller::setDensity(Scalar density)
@@ -65,6 +101,7 @@ void mpcd::VirtualParticleFiller::setDensity(Scalar density)
         throw std::runtime_error("Invalid virtual particle density");
         }
     m_density = density;
+    m_can_refill = false;
     }
 
 void mpcd::VirtualParticleFiller::setType(unsigned int type)
@@ -76,6 +113,7 @@ void mpcd::VirtualParticleFiller::setType(unsigned int type)
         throw std::runtime_error("Invalid type id");
         }
     m_type = type;
+    m_can_refill = false;
     }
 
 /*!
@@ -92,7 +130,9 @@ void mpcd::detail::export_VirtualParticleFiller(pybind11::module& m)
                             std::shared_ptr<Variant>>())
         .def("setDensity", &mpcd::VirtualParticleFiller::setDensity)
         .def("setType", &mpcd::VirtualParticleFiller::setType)
-        .def("setTemperature", &mpcd::VirtualParticleFiller::setTemperature);
+        .def("setTemperature", &mpcd::VirtualParticleFiller::setTemperature)
+        .def("setPersistent", &mpcd::VirtualParticleFiller::setPersistent)
+        .def("getPersistent", &mpcd::VirtualParticleFiller::getPersistent);
     }
 
     } // end namespace hoomd
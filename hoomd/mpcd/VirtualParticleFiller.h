@@ -33,6 +33,13 @@ namespace mpcd
  * class must then implement two methods:
  *  1. computeNumFill(), which is the number of virtual particles to add.
  *  2. drawParticles(), which is the rule to determine where to put the particles.
+ *
+ * For static geometries, the filler can be made persistent. The particles added by the last fill()
+ * are then kept, and refill() only redraws their velocities in place, avoiding the reallocation,
+ * removal, and position sampling on every collision. A deriving class can implement
+ * drawVelocities() for this; the default redraws the particles completely in place. The kept
+ * particles are only valid while canRefill() is true, i.e., while the box, cell list, fill
+ * parameters, and number of MPCD particles are unchanged since the last fill().
  */
 class PYBIND11_EXPORT VirtualParticleFiller : public Autotuned
     {
@@ -47,6 +54,31 @@ class PYBIND11_EXPORT VirtualParticleFiller : public Autotuned
     //! Fill up virtual particles
     void fill(uint64_t timestep);
 
+    //! Redraw the velocities of the virtual particles kept from the last fill
+    void refill(uint64_t timestep);
+
+    //! Check if the virtual particles from the last fill can be refilled in place
+    bool canRefill() const;
+
+    //! Get the number of virtual particles added locally by the last fill
+    unsigned int getNumFill() const
+        {
+        return m_N_fill;
+        }
+
+    //! Get whether the virtual particles are kept between fills
+    bool getPersistent() const
+        {
+        return m_persistent;
+        }
+
+    //! Set whether the virtual particles are kept between fills
+    void setPersistent(bool persistent)
+        {
+        m_persistent = persistent;
+        m_can_refill = false;
+        }
+
     //! Set the fill particle density
     void setDensity(Scalar density);
 
@@ -63,6 +95,7 @@ class PYBIND11_EXPORT VirtualParticleFiller : public Autotuned
     virtual void setCellList(std::shared_ptr<mpcd::CellList> cl)
         {
         m_cl = cl;
+        m_can_refill = false;
         }
 
     protected:
@@ -78,12 +111,31 @@ class PYBIND11_EXPORT VirtualParticleFiller : public Autotuned
 
     unsigned int m_N_fill;    //!< Number of particles to fill locally
     unsigned int m_first_tag; //!< First tag of locally held particles
+    unsigned int m_first_idx; //!< First local index of the filled particles
+
+    bool m_persistent;       //!< If true, keep the filled particles between fills
+    bool m_can_refill;       //!< If true, the last fill has not been invalidated
+    unsigned int m_refill_N; //!< Number of MPCD particles at the last fill
+    BoxDim m_refill_box;     //!< Local box at the last fill
+    Scalar m_refill_cell;    //!< Cell size at the last fill
+    Scalar m_refill_shift;   //!< Maximum grid shift at the last fill
 
     //! Compute the total number of particles to fill
     virtual void computeNumFill() { }
 
     //! Draw particles within the fill volume
     virtual void drawParticles(uint64_t timestep) { }
+
+    //! Redraw the velocities of the filled particles
+    /*!
+     * \param timestep Current timestep
+     *
+     * The default implementation redraws the filled particles completely.
+     */
+    virtual void drawVelocities(uint64_t timestep)
+        {
+        drawParticles(timestep);
+        }
     };
 
 namespace detail
@@ -111,6 +111,12 @@ class integrator():
                     advance the real time of the system forward by *dt* (in time units).
         aniso (bool): Whether to integrate rotational degrees of freedom (bool),
                       default None (autodetect).
+        bin_while_streaming (bool): Whether the streaming step that precedes a
+                      collision also bins the MPCD particles into cells (bool),
+                      default False.
+        overlap_communication (bool): Whether the MPCD particles are migrated
+                      between ranks while the MD forces are computed (bool),
+                      default False.
 
     The MPCD integrator enables the MPCD algorithm concurrently with standard
     MD :py:mod:`~hoomd.md.methods` methods. An integrator must be created
@@ -135,14 +141,35 @@ class integrator():
     The MD particles can be read at any time step because their positions
     are updated every step.
 
+    When *bin_while_streaming* is True, the streaming step before a collision
+    builds the cell list and sums the cell momentum and energy while it moves
+    the particles, so the collision only makes one more pass over the particles.
+    On the CPU, the particles are also sorted into cell order in this pass on the
+    collision steps where the sorter is due, so the sorter does not rebuild the
+    cell list. The separate passes are used instead for domain decomposed
+    simulations, with virtual particle fillers or embedded particles, on the GPU
+    on collision steps where the particles are sorted, and on the CPU with more
+    than one thread.
+
+    When *overlap_communication* is True in domain decomposed simulations, the
+    MPCD particles are migrated for a collision right after the streaming step
+    that precedes it. The messages are in flight while the MD forces are
+    computed instead of delaying the collision.
+
     Examples::
 
         mpcd.integrator(dt=0.1)
         mpcd.integrator(dt=0.01, aniso=True)
+        mpcd.integrator(dt=0.1, bin_while_streaming=True)
+        mpcd.integrator(dt=0.1, overlap_communication=True)
 
     """
 
-    def __init__(self, dt, aniso=None):
+    def __init__(self,
+                 dt,
+                 aniso=None,
+                 bin_while_streaming=False,
+                 overlap_communication=False):
         # check system is initialized
         if hoomd.context.current.mpcd is None:
             hoomd.context.current.device.cpp_msg.error(
@@ -155,7 +182,11 @@ class integrator():
         self.supports_methods = True
         self.dt = dt
         self.aniso = aniso
-        self.metadata_fields = ['dt', 'aniso']
+        self.bin_while_streaming = bin_while_streaming
+        self.overlap_communication = overlap_communication
+        self.metadata_fields = [
+            'dt', 'aniso', 'bin_while_streaming', 'overlap_communication'
+        ]
 
         # configure C++ integrator
         self.cpp_integrator = _mpcd.Integrator(hoomd.context.current.mpcd.data,
@@ -164,23 +195,33 @@ class integrator():
             self.cpp_integrator.setMPCDCommunicator(
                 hoomd.context.current.mpcd.comm)
         hoomd.context.current.system.setIntegrator(self.cpp_integrator)
+        self.cpp_integrator.bin_while_streaming = self.bin_while_streaming
+        self.cpp_integrator.overlap_communication = self.overlap_communication
 
         if self.aniso is not None:
             self.set_params(aniso=aniso)
 
     _aniso_modes = {}
 
-    def set_params(self, dt=None, aniso=None):
+    def set_params(self,
+                   dt=None,
+                   aniso=None,
+                   bin_while_streaming=None,
+                   overlap_communication=None):
         """ Changes parameters of an existing integration mode.
 
         Args:
             dt (float): New time step delta (if set) (in time units).
             aniso (bool): Anisotropic integration mode (bool), default None (autodetect).
+            bin_while_streaming (bool): Bin the particles while streaming (if set).
+            overlap_communication (bool): Overlap the MPCD particle migration
+                with the MD force computation (if set).
 
         Examples::
 
             integrator.set_params(dt=0.007)
             integrator.set_params(dt=0.005, aniso=False)
+            integrator.set_params(bin_while_streaming=True)
 
         """
         self.check_initialization()
@@ -202,6 +243,14 @@ class integrator():
             self.aniso = aniso
             self.cpp_integrator.setAnisotropicMode(anisoMode)
 
+        if bin_while_streaming is not None:
+            self.bin_while_streaming = bin_while_streaming
+            self.cpp_integrator.bin_while_streaming = bin_while_streaming
+
+        if overlap_communication is not None:
+            self.overlap_communication = overlap_communication
+            self.cpp_integrator.overlap_communication = overlap_communication
+
     def update_methods(self):
         self.check_initialization()
 
@@ -324,7 +324,7 @@ class slit(_streaming_method):
             _mpcd.SlitGeometry(H, V, bc),
         )
 
-    def set_filler(self, density, kT, seed, type="A"):
+    def set_filler(self, density, kT, seed, type="A", persistent=False):
         r"""Add virtual particles to slit channel.
 
         Args:
@@ -332,6 +332,7 @@ class slit(_streaming_method):
             kT (float): Temperature of virtual particles.
             seed (int): Seed to pseudo-random number generator for virtual particles.
             type (str): Type of the MPCD particles to fill with.
+            persistent (bool): If True, keep the virtual particles between collisions.
 
         The virtual particle filler draws particles within the volume *outside* the
         slit walls that could be overlapped by any cell that is partially *inside*
@@ -344,6 +345,13 @@ class slit(_streaming_method):
         The virtual particles will act as a weak thermostat on the fluid, and so energy
         is no longer conserved. Momentum will also be sunk into the walls.
 
+        By default, new virtual particles are drawn for every collision. If *persistent*
+        is True, the virtual particles are kept at their positions, and only their
+        velocities are redrawn for each collision. This avoids regenerating the
+        virtual particles in static geometries. The virtual particles are still
+        regenerated when the box, cells, filler, or geometry change, and on every
+        collision in simulations that are domain decomposed.
+
         Example::
 
             slit.set_filler(density=5.0, kT=1.0, seed=42)
@@ -373,6 +381,7 @@ class slit(_streaming_method):
             self._filler.setType(type_id)
             self._filler.setTemperature(T.cpp_variant)
             self._filler.setSeed(seed)
+        self._filler.setPersistent(persistent)
 
     def remove_filler(self):
         """Remove the virtual particle filler.
@@ -478,7 +487,7 @@ class slit_pore(_streaming_method):
             _mpcd.SlitPoreGeometry(H, L, bc),
         )
 
-    def set_filler(self, density, kT, seed, type="A"):
+    def set_filler(self, density, kT, seed, type="A", persistent=False):
         r"""Add virtual particles to slit pore.
 
         Args:
@@ -486,6 +495,7 @@ class slit_pore(_streaming_method):
             kT (float): Temperature of virtual particles.
             seed (int): Seed to pseudo-random number generator for virtual particles.
             type (str): Type of the MPCD particles to fill with.
+            persistent (bool): If True, keep the virtual particles between collisions.
 
         The virtual particle filler draws particles within the volume *outside* the
         slit pore boundaries that could be overlapped by any cell that is partially *inside*
@@ -497,6 +507,13 @@ class slit_pore(_streaming_method):
         The virtual particles will act as a weak thermostat on the fluid, and so energy
         is no longer conserved. Momentum will also be sunk into the walls.
 
+        By default, new virtual particles are drawn for every collision. If *persistent*
+        is True, the virtual particles are kept at their positions, and only their
+        velocities are redrawn for each collision. This avoids regenerating the
+        virtual particles in static geometries. The virtual particles are still
+        regenerated when the box, cells, filler, or geometry change, and on every
+        collision in simulations that are domain decomposed.
+
         Example::
 
             slit_pore.set_filler(density=5.0, kT=1.0, seed=42)
@@ -523,6 +540,7 @@ class slit_pore(_streaming_method):
             self._filler.setType(type_id)
             self._filler.setTemperature(T.cpp_variant)
             self._filler.setSeed(seed)
+        self._filler.setPersistent(persistent)
 
     def remove_filler(self):
         """Remove the virtual particle filler.
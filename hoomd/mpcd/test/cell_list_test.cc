@@ -2,6 +2,7 @@
 // Part of HOOMD-blue, released under the BSD 3-Clause License.
 
 #include "hoomd/mpcd/CellList.h"
+#include "hoomd/mpcd/SlitGeometry.h"
 #ifdef ENABLE_HIP
 #include "hoomd/mpcd/CellListGPU.h"
 #endif // ENABLE_HIP
@@ -651,6 +652,96 @@ template<class CL> void celllist_embed_test(std::shared_ptr<ExecutionConfigurati
         }
     }
 
+//! Test that the sparse cell list only stores the cells inside a slit
+void celllist_sparse_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = std::make_shared<BoxDim>(4.0, 4.0, 20.0);
+    snap->particle_data.type_mapping.push_back("A");
+    snap->mpcd_data.resize(4);
+    snap->mpcd_data.type_mapping.push_back("A");
+    snap->mpcd_data.position[0] = vec3<Scalar>(-1.5, -1.5, -1.5);
+    snap->mpcd_data.position[1] = vec3<Scalar>(0.5, 1.5, 1.5);
+    snap->mpcd_data.position[2] = vec3<Scalar>(-1.5, -1.5, -1.5);
+    snap->mpcd_data.position[3] = vec3<Scalar>(1.5, 0.5, 0.5);
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    auto slit = std::make_shared<const mpcd::detail::SlitGeometry>(2.0,
+                                                                   0.0,
+                                                                   mpcd::detail::boundary::no_slip);
+    std::shared_ptr<mpcd::CellList> cl(new mpcd::CellList(sysdef));
+    cl->setCellMask([slit](const Scalar3& lo, const Scalar3& hi)
+                    { return slit->isCellOutside(lo, hi); });
+
+    // the mask is ignored until the cell list is sparse
+    UP_ASSERT(!cl->isSparse());
+    cl->compute(0);
+    CHECK_EQUAL_UINT(cl->getNStoredCells(), 4 * 4 * 20);
+
+    // the padded region of the cells covers 2 cells to each side, so the 3 layers of cells that lie
+    // at least 3 cells beyond each wall are dropped (cells at the box edge are kept)
+    cl->setSparse(true);
+    cl->compute(1);
+    CHECK_EQUAL_UINT(cl->getNStoredCells(), 4 * 4 * 14);
+    CHECK_EQUAL_UINT(cl->getCellListIndexer().getNumElements(), 4 * 4 * 14 * cl->getNmax());
+        {
+        ArrayHandle<unsigned int> h_cell_slot(cl->getCellSlots(),
+                                              access_location::host,
+                                              access_mode::read);
+        ArrayHandle<unsigned int> h_cell_np(cl->getCellSizeArray(),
+                                            access_location::host,
+                                            access_mode::read);
+        ArrayHandle<unsigned int> h_cell_list(cl->getCellList(),
+                                              access_location::host,
+                                              access_mode::read);
+        Index3D ci = cl->getCellIndexer();
+        Index2D cli = cl->getCellListIndexer();
+
+        // cells are stored in order, skipping the dropped layers
+        unsigned int n_stored = 0;
+        for (unsigned int k = 0; k < 20; ++k)
+            {
+            const bool dropped = ((k >= 2 && k <= 4) || (k >= 15 && k <= 17));
+            for (unsigned int j = 0; j < 4; ++j)
+                {
+                for (unsigned int i = 0; i < 4; ++i)
+                    {
+                    const unsigned int slot = h_cell_slot.data[ci(i, j, k)];
+                    if (dropped)
+                        {
+                        CHECK_EQUAL_UINT(slot, mpcd::detail::NO_CELL);
+                        }
+                    else
+                        {
+                        UP_ASSERT(slot != mpcd::detail::NO_CELL);
+                        UP_ASSERT(slot < cl->getNStoredCells());
+                        ++n_stored;
+                        }
+                    }
+                }
+            }
+        CHECK_EQUAL_UINT(n_stored, cl->getNStoredCells());
+
+        // the members are found through the cell slots
+        CHECK_EQUAL_UINT(h_cell_np.data[ci(0, 0, 8)], 2);
+        CHECK_EQUAL_UINT(h_cell_list.data[cli(0, h_cell_slot.data[ci(0, 0, 8)])], 0);
+        CHECK_EQUAL_UINT(h_cell_list.data[cli(1, h_cell_slot.data[ci(0, 0, 8)])], 2);
+        CHECK_EQUAL_UINT(h_cell_np.data[ci(2, 3, 11)], 1);
+        CHECK_EQUAL_UINT(h_cell_list.data[cli(0, h_cell_slot.data[ci(2, 3, 11)])], 1);
+        CHECK_EQUAL_UINT(h_cell_np.data[ci(3, 2, 10)], 1);
+        CHECK_EQUAL_UINT(h_cell_list.data[cli(0, h_cell_slot.data[ci(3, 2, 10)])], 3);
+        }
+
+        // a particle in a cell that is not stored is an error
+        {
+        ArrayHandle<Scalar4> h_pos(sysdef->getMPCDParticleData()->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        h_pos.data[1] = make_scalar4(0.5, 1.5, 6.5, __int_as_scalar(0));
+        }
+    UP_ASSERT_EXCEPTION(std::runtime_error, [&] { cl->compute(2); });
+    }
+
 //! dimension test case for MPCD CellList class
 UP_TEST(mpcd_cell_list_dimensions)
     {
@@ -679,6 +770,31 @@ UP_TEST(mpcd_cell_list_embed_test)
         new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! sparse cell list test case for MPCD CellList class
+UP_TEST(mpcd_cell_list_sparse_test)
+    {
+    celllist_sparse_test(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+#ifdef ENABLE_TBB
+//! small system test case for MPCD CellList class built with multiple threads
+UP_TEST(mpcd_cell_list_small_test_threads)
+    {
+    auto exec_conf = std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU);
+    exec_conf->setNumThreads(4);
+    celllist_small_test<mpcd::CellList>(exec_conf);
+    }
+
+//! embedded particle test case for MPCD CellList class built with multiple threads
+UP_TEST(mpcd_cell_list_embed_test_threads)
+    {
+    auto exec_conf = std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU);
+    exec_conf->setNumThreads(4);
+    celllist_embed_test<mpcd::CellList>(exec_conf);
+    }
+#endif // ENABLE_TBB
+
 #ifdef ENABLE_HIP
 //! dimension test case for MPCD CellListGPU class
 UP_TEST(mpcd_cell_list_gpu_dimensions)
@@ -336,6 +336,21 @@ UP_TEST(mpcd_cell_thermo_embed)
         new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+#ifdef ENABLE_TBB
+UP_TEST(mpcd_cell_thermo_basic_threads)
+    {
+    auto exec_conf = std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU);
+    exec_conf->setNumThreads(4);
+    cell_thermo_basic_test<mpcd::CellThermoCompute>(exec_conf);
+    }
+UP_TEST(mpcd_cell_thermo_embed_threads)
+    {
+    auto exec_conf = std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU);
+    exec_conf->setNumThreads(4);
+    cell_thermo_embed_test<mpcd::CellThermoCompute>(exec_conf);
+    }
+#endif // ENABLE_TBB
+
 #ifdef ENABLE_HIP
 UP_TEST(mpcd_cell_thermo_basic_gpu)
     {
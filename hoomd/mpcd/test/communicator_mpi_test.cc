@@ -895,6 +895,59 @@ void test_communicator_migrate_ortho(communicator_creator comm_creator,
         {
         UP_ASSERT_EQUAL(pdata->getN(), 0);
         }
+
+    // move the particles on the neighbors of rank 5 onto it, overlapping the migration
+    if (rank == 0 || rank == 4 || rank == 6)
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        h_pos.data[0].x = Scalar(-0.5);
+        h_pos.data[0].y = Scalar(0.5);
+        h_pos.data[0].z = Scalar(0.0);
+        }
+    comm->beginCommunicate(4);
+    UP_ASSERT(comm->isMigratePending());
+    comm->finishCommunicate();
+    UP_ASSERT(!comm->isMigratePending());
+    if (rank == 5)
+        {
+        UP_ASSERT_EQUAL(pdata->getN(), 6);
+        }
+    else if (rank == 3 || rank == 7)
+        {
+        UP_ASSERT_EQUAL(pdata->getN(), 1);
+        }
+    else
+        {
+        UP_ASSERT_EQUAL(pdata->getN(), 0);
+        }
+
+    // the particles were already migrated for this step, so they are not migrated again
+    if (rank == 5)
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        h_pos.data[0].x = Scalar(0.5);
+        }
+    comm->communicate(4);
+    if (rank == 5)
+        {
+        UP_ASSERT_EQUAL(pdata->getN(), 6);
+        }
+
+    // unless the migration is forced
+    comm->forceMigrate();
+    comm->communicate(4);
+    if (rank == 5)
+        {
+        UP_ASSERT_EQUAL(pdata->getN(), 5);
+        }
+    else if (rank == 6)
+        {
+        UP_ASSERT_EQUAL(pdata->getN(), 1);
+        }
     }
 
 //! Test particle migration of Communicator
@@ -9,6 +9,8 @@
 #include "hoomd/SnapshotSystemData.h"
 #include "hoomd/test/upp11_config.h"
 
+#include <vector>
+
 HOOMD_UP_MAIN()
 
 using namespace hoomd;
@@ -185,6 +187,162 @@ template<class F> void slit_fill_basic_test(std::shared_ptr<ExecutionConfigurati
     CHECK_CLOSE(T_avg, 1.5, tol);
     }
 
+//! Test that a persistent filler keeps its particles and redraws only their velocities
+template<class F> void slit_fill_persistent_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = std::make_shared<BoxDim>(20.0);
+    snap->particle_data.type_mapping.push_back("A");
+    snap->mpcd_data.resize(1);
+    snap->mpcd_data.type_mapping.push_back("A");
+    snap->mpcd_data.position[0] = vec3<Scalar>(1, -2, 3);
+    snap->mpcd_data.velocity[0] = vec3<Scalar>(123, 456, 789);
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    auto pdata = sysdef->getMPCDParticleData();
+    auto cl = std::make_shared<mpcd::CellList>(sysdef);
+    cl->setCellSize(2.0);
+
+    auto slit = std::make_shared<const mpcd::detail::SlitGeometry>(5.0,
+                                                                   1.0,
+                                                                   mpcd::detail::boundary::no_slip);
+    std::shared_ptr<Variant> kT = std::make_shared<VariantConstant>(1.5);
+    std::shared_ptr<mpcd::SlitGeometryFiller> filler
+        = std::make_shared<F>(sysdef, 2.0, 1, kT, slit);
+    filler->setCellList(cl);
+
+    // nothing can be refilled before the first fill or if the filler is not persistent
+    UP_ASSERT(!filler->getPersistent());
+    filler->fill(0);
+    UP_ASSERT(!filler->canRefill());
+    pdata->removeVirtualParticles();
+    filler->setPersistent(true);
+    UP_ASSERT(filler->getPersistent());
+    UP_ASSERT(!filler->canRefill());
+
+    filler->fill(0);
+    const unsigned int N_virtual = 2 * (2 * 20 * 20) * 2;
+    UP_ASSERT_EQUAL(pdata->getNVirtual(), N_virtual);
+    UP_ASSERT_EQUAL(filler->getNumFill(), N_virtual);
+    UP_ASSERT(filler->canRefill());
+
+    // save the filled particles
+    std::vector<Scalar4> pos(N_virtual), vel(N_virtual);
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        for (unsigned int i = 0; i < N_virtual; ++i)
+            {
+            pos[i] = h_pos.data[pdata->getN() + i];
+            vel[i] = h_vel.data[pdata->getN() + i];
+            }
+        }
+
+    /*
+     * Refilling keeps the particles in place but redraws their velocities, and the average
+     * properties should still be right.
+     */
+    unsigned int N_lo(0), N_hi(0);
+    Scalar3 v_lo = make_scalar3(0, 0, 0);
+    Scalar3 v_hi = make_scalar3(0, 0, 0);
+    Scalar T_avg(0);
+    for (unsigned int t = 0; t < 500; ++t)
+        {
+        UP_ASSERT(filler->canRefill());
+        filler->refill(1 + t);
+        UP_ASSERT_EQUAL(pdata->getNVirtual(), N_virtual);
+
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+
+        // the real particle is untouched
+        CHECK_CLOSE(h_vel.data[0].x, 123, tol_small);
+        CHECK_CLOSE(h_vel.data[0].y, 456, tol_small);
+        CHECK_CLOSE(h_vel.data[0].z, 789, tol_small);
+
+        unsigned int N_changed(0);
+        for (unsigned int i = 0; i < N_virtual; ++i)
+            {
+            const unsigned int pidx = pdata->getN() + i;
+            UP_ASSERT_EQUAL(h_tag.data[pidx], pidx);
+            UP_ASSERT_EQUAL(h_pos.data[pidx].x, pos[i].x);
+            UP_ASSERT_EQUAL(h_pos.data[pidx].y, pos[i].y);
+            UP_ASSERT_EQUAL(h_pos.data[pidx].z, pos[i].z);
+            UP_ASSERT_EQUAL(__scalar_as_int(h_pos.data[pidx].w), 1);
+            UP_ASSERT_EQUAL(__scalar_as_int(h_vel.data[pidx].w), mpcd::detail::NO_CELL);
+
+            const Scalar4 vel_cell = h_vel.data[pidx];
+            if (vel_cell.x != vel[i].x)
+                ++N_changed;
+            vel[i] = vel_cell;
+
+            const Scalar z = h_pos.data[pidx].z;
+            const Scalar3 v = make_scalar3(vel_cell.x, vel_cell.y, vel_cell.z);
+            if (z < Scalar(-5.0))
+                {
+                v_lo += v;
+                T_avg += dot(v - make_scalar3(-1.0, 0, 0), v - make_scalar3(-1.0, 0, 0));
+                ++N_lo;
+                }
+            else if (z >= Scalar(5.0))
+                {
+                v_hi += v;
+                T_avg += dot(v - make_scalar3(1.0, 0, 0), v - make_scalar3(1.0, 0, 0));
+                ++N_hi;
+                }
+            }
+        UP_ASSERT(N_changed > N_virtual / 2);
+        }
+    UP_ASSERT_EQUAL(N_lo, 500 * 2 * (2 * 20 * 20));
+    UP_ASSERT_EQUAL(N_hi, 500 * 2 * (2 * 20 * 20));
+    v_lo /= N_lo;
+    v_hi /= N_hi;
+    T_avg /= (3 * (N_lo + N_hi - 1));
+
+    CHECK_CLOSE(v_lo.x, -1.0, tol);
+    CHECK_SMALL(v_lo.y, tol);
+    CHECK_SMALL(v_lo.z, tol);
+    CHECK_CLOSE(v_hi.x, 1.0, tol);
+    CHECK_SMALL(v_hi.y, tol);
+    CHECK_SMALL(v_hi.z, tol);
+    CHECK_CLOSE(T_avg, 1.5, tol);
+
+    /*
+     * Changing anything the fill depends on prevents a refill until the next fill.
+     */
+    filler->setDensity(2.0);
+    UP_ASSERT(!filler->canRefill());
+    pdata->removeVirtualParticles();
+    filler->fill(501);
+    UP_ASSERT(filler->canRefill());
+
+    filler->setGeometry(slit);
+    UP_ASSERT(!filler->canRefill());
+    pdata->removeVirtualParticles();
+    filler->fill(502);
+    UP_ASSERT(filler->canRefill());
+
+    cl->setCellSize(1.0);
+    UP_ASSERT(!filler->canRefill());
+    pdata->removeVirtualParticles();
+    filler->fill(503);
+    UP_ASSERT(filler->canRefill());
+
+    // removing the virtual particles also prevents a refill
+    pdata->removeVirtualParticles();
+    UP_ASSERT(!filler->canRefill());
+    filler->fill(504);
+    UP_ASSERT(filler->canRefill());
+
+    filler->setPersistent(false);
+    UP_ASSERT(!filler->canRefill());
+    }
+
 UP_TEST(slit_fill_basic)
     {
     slit_fill_basic_test<mpcd::SlitGeometryFiller>(
@@ -197,3 +355,16 @@ UP_TEST(slit_fill_basic_gpu)
         std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::GPU));
     }
 #endif // ENABLE_HIP
+
+UP_TEST(slit_fill_persistent)
+    {
+    slit_fill_persistent_test<mpcd::SlitGeometryFiller>(
+        std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU));
+    }
+#ifdef ENABLE_HIP
+UP_TEST(slit_fill_persistent_gpu)
+    {
+    slit_fill_persistent_test<mpcd::SlitGeometryFillerGPU>(
+        std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::GPU));
+    }
+#endif // ENABLE_HIP
@@ -15,7 +15,8 @@ HOOMD_UP_MAIN()
 using namespace hoomd;
 
 //! Test for basic MPCD sort functions
-template<class T> void sorter_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+template<class T>
+void sorter_test(std::shared_ptr<ExecutionConfiguration> exec_conf, bool compact_storage = false)
     {
     // default initialize an empty snapshot in the reference box
     std::shared_ptr<SnapshotSystemData<Scalar>> snap(new SnapshotSystemData<Scalar>());
@@ -75,6 +76,7 @@ template<class T> void sorter_test(std::shared_ptr<ExecutionConfiguration> exec_
     cl->setEmbeddedGroup(group);
 
     // run the sorter
+    sysdef->getMPCDParticleData()->setCompactStorage(compact_storage);
     std::shared_ptr<T> sorter = std::make_shared<T>(sysdef, 0, 1);
     sorter->setCellList(cl);
     sorter->update(0);
@@ -83,6 +85,15 @@ template<class T> void sorter_test(std::shared_ptr<ExecutionConfiguration> exec_
         {
         std::shared_ptr<mpcd::ParticleData> pdata = sysdef->getMPCDParticleData();
 
+        // compact storage releases the alternate arrays, but they can be requested again
+        if (compact_storage)
+            {
+            UP_ASSERT(pdata->getCompactStorage());
+            UP_ASSERT(pdata->getAltPositions().getNumElements() >= 8);
+            UP_ASSERT(pdata->getAltVelocities().getNumElements() >= 8);
+            UP_ASSERT(pdata->getAltTags().getNumElements() >= 8);
+            }
+
         // tag order should be reversed
         ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
         UP_ASSERT_EQUAL(h_tag.data[0], 7);
@@ -414,6 +425,13 @@ UP_TEST(mpcd_sorter_virtual_test)
     sorter_virtual_test<mpcd::Sorter>(std::shared_ptr<ExecutionConfiguration>(
         new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! test case for MPCD sorter with compact particle storage
+UP_TEST(mpcd_sorter_compact_test)
+    {
+    sorter_test<mpcd::Sorter>(std::shared_ptr<ExecutionConfiguration>(
+                                  new ExecutionConfiguration(ExecutionConfiguration::CPU)),
+                              true);
+    }
 #ifdef ENABLE_HIP
 UP_TEST(mpcd_sorter_test_gpu)
     {
@@ -425,4 +443,10 @@ UP_TEST(mpcd_sorter_virtual_test_gpu)
     sorter_virtual_test<mpcd::SorterGPU>(std::shared_ptr<ExecutionConfiguration>(
         new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
+UP_TEST(mpcd_sorter_compact_test_gpu)
+    {
+    sorter_test<mpcd::SorterGPU>(std::shared_ptr<ExecutionConfiguration>(
+                                     new ExecutionConfiguration(ExecutionConfiguration::GPU)),
+                                 true);
+    }
 #endif // ENABLE_HIP
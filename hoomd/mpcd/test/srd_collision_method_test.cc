@@ -403,6 +403,23 @@ UP_TEST(srd_collision_method_thermostat)
     srd_collision_method_thermostat_test<mpcd::SRDCollisionMethod>(
         std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU));
     }
+#ifdef ENABLE_TBB
+//! basic test case for the MPCD SRDCollisionMethod class with multiple threads
+UP_TEST(srd_collision_method_basic_threads)
+    {
+    auto exec_conf = std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU);
+    exec_conf->setNumThreads(4);
+    srd_collision_method_basic_test<mpcd::SRDCollisionMethod>(exec_conf);
+    }
+//! test embedding of particles into the MPCD SRDCollisionMethod class with multiple threads
+UP_TEST(srd_collision_method_embed_threads)
+    {
+    auto exec_conf = std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU);
+    exec_conf->setNumThreads(4);
+    srd_collision_method_embed_test<mpcd::SRDCollisionMethod>(exec_conf);
+    }
+#endif // ENABLE_TBB
+
 #ifdef ENABLE_HIP
 //! basic test case for MPCD SRDCollisionMethodGPU class
 UP_TEST(srd_collision_method_basic_gpu)
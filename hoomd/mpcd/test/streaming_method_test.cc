@@ -3,10 +3,16 @@
 
 #include "hoomd/mpcd/ConfinedStreamingMethod.h"
 #include "hoomd/mpcd/StreamingGeometry.h"
+#include "utils.h"
 #ifdef ENABLE_HIP
+#include "hoomd/mpcd/CellListGPU.h"
+#include "hoomd/mpcd/CellThermoComputeGPU.h"
 #include "hoomd/mpcd/ConfinedStreamingMethodGPU.h"
 #endif // ENABLE_HIP
 
+#include <algorithm>
+#include <vector>
+
 #include "hoomd/SnapshotSystemData.h"
 #include "hoomd/test/upp11_config.h"
 
@@ -110,6 +116,290 @@ void streaming_method_basic_test(std::shared_ptr<ExecutionConfiguration> exec_co
         }
     }
 
+//! Test that binning while streaming gives the same cells as streaming and then binning
+template<class SM, class CL, class CT>
+void streaming_method_bin_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = std::make_shared<BoxDim>(4.0);
+    snap->particle_data.type_mapping.push_back("A");
+
+    // 6 particles, with some sharing a cell after streaming and one crossing the boundary
+    snap->mpcd_data.resize(6);
+    snap->mpcd_data.type_mapping.push_back("A");
+    snap->mpcd_data.position[0] = vec3<Scalar>(-1.5, -1.5, -1.5);
+    snap->mpcd_data.position[1] = vec3<Scalar>(-1.4, -1.6, -1.5);
+    snap->mpcd_data.position[2] = vec3<Scalar>(0.5, 0.5, 0.5);
+    snap->mpcd_data.position[3] = vec3<Scalar>(0.6, 0.4, 0.5);
+    snap->mpcd_data.position[4] = vec3<Scalar>(0.4, 0.6, 0.4);
+    snap->mpcd_data.position[5] = vec3<Scalar>(1.95, -0.5, 1.0);
+
+    snap->mpcd_data.velocity[0] = vec3<Scalar>(2.0, 0.0, 0.0);
+    snap->mpcd_data.velocity[1] = vec3<Scalar>(1.0, 0.0, -1.0);
+    snap->mpcd_data.velocity[2] = vec3<Scalar>(0.0, -3.0, 0.0);
+    snap->mpcd_data.velocity[3] = vec3<Scalar>(0.0, 0.0, -5.0);
+    snap->mpcd_data.velocity[4] = vec3<Scalar>(1.0, -1.0, 4.0);
+    snap->mpcd_data.velocity[5] = vec3<Scalar>(1.0, 0.5, -0.5);
+
+    // the same system is streamed with and without binning
+    const Scalar3 shift = make_scalar3(0.1, -0.2, 0.3);
+    auto geom = std::make_shared<const mpcd::detail::BulkGeometry>();
+    std::shared_ptr<mpcd::ParticleData> pdata[2];
+    std::shared_ptr<mpcd::CellList> cl[2];
+    std::shared_ptr<mpcd::CellThermoCompute> thermo[2];
+    for (unsigned int i = 0; i < 2; ++i)
+        {
+        std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+        pdata[i] = sysdef->getMPCDParticleData();
+        cl[i] = std::make_shared<CL>(sysdef);
+        thermo[i] = std::make_shared<CT>(sysdef, cl[i]);
+        AllThermoRequest thermo_req(thermo[i]);
+
+        auto stream = std::make_shared<SM>(sysdef, 0, 1, -1, geom);
+        stream->setCellList(cl[i]);
+        stream->setDeltaT(0.1);
+
+        // build the cell list once, and then shift the grid for the next collision
+        cl[i]->compute(0);
+        cl[i]->setGridShift(shift);
+        if (i == 0)
+            {
+            stream->stream(0);
+            }
+        else
+            {
+            UP_ASSERT(cl[i]->canBuildWhileStreaming());
+            stream->streamAndBin(0, 1, thermo[i], std::shared_ptr<mpcd::Sorter>());
+            }
+        thermo[i]->compute(1);
+        }
+
+    // particles should have been streamed the same way, and stashed into the same cells
+        {
+        ArrayHandle<Scalar4> h_pos_0(pdata[0]->getPositions(),
+                                     access_location::host,
+                                     access_mode::read);
+        ArrayHandle<Scalar4> h_vel_0(pdata[0]->getVelocities(),
+                                     access_location::host,
+                                     access_mode::read);
+        ArrayHandle<Scalar4> h_pos_1(pdata[1]->getPositions(),
+                                     access_location::host,
+                                     access_mode::read);
+        ArrayHandle<Scalar4> h_vel_1(pdata[1]->getVelocities(),
+                                     access_location::host,
+                                     access_mode::read);
+        for (unsigned int i = 0; i < 6; ++i)
+            {
+            CHECK_CLOSE(h_pos_1.data[i].x, h_pos_0.data[i].x, tol);
+            CHECK_CLOSE(h_pos_1.data[i].y, h_pos_0.data[i].y, tol);
+            CHECK_CLOSE(h_pos_1.data[i].z, h_pos_0.data[i].z, tol);
+            CHECK_CLOSE(h_vel_1.data[i].x, h_vel_0.data[i].x, tol);
+            CHECK_CLOSE(h_vel_1.data[i].y, h_vel_0.data[i].y, tol);
+            CHECK_CLOSE(h_vel_1.data[i].z, h_vel_0.data[i].z, tol);
+            UP_ASSERT_EQUAL(__scalar_as_int(h_vel_1.data[i].w), __scalar_as_int(h_vel_0.data[i].w));
+            }
+        }
+
+    // cells should have the same members and properties
+    UP_ASSERT_EQUAL(cl[1]->getNCells(), cl[0]->getNCells());
+        {
+        ArrayHandle<unsigned int> h_cell_np_0(cl[0]->getCellSizeArray(),
+                                              access_location::host,
+                                              access_mode::read);
+        ArrayHandle<unsigned int> h_cell_list_0(cl[0]->getCellList(),
+                                                access_location::host,
+                                                access_mode::read);
+        ArrayHandle<unsigned int> h_cell_np_1(cl[1]->getCellSizeArray(),
+                                              access_location::host,
+                                              access_mode::read);
+        ArrayHandle<unsigned int> h_cell_list_1(cl[1]->getCellList(),
+                                                access_location::host,
+                                                access_mode::read);
+        ArrayHandle<double4> h_cell_vel_0(thermo[0]->getCellVelocities(),
+                                          access_location::host,
+                                          access_mode::read);
+        ArrayHandle<double3> h_cell_energy_0(thermo[0]->getCellEnergies(),
+                                             access_location::host,
+                                             access_mode::read);
+        ArrayHandle<double4> h_cell_vel_1(thermo[1]->getCellVelocities(),
+                                          access_location::host,
+                                          access_mode::read);
+        ArrayHandle<double3> h_cell_energy_1(thermo[1]->getCellEnergies(),
+                                             access_location::host,
+                                             access_mode::read);
+        const Index2D& cli_0 = cl[0]->getCellListIndexer();
+        const Index2D& cli_1 = cl[1]->getCellListIndexer();
+        unsigned int n_binned = 0;
+        for (unsigned int cell = 0; cell < cl[0]->getNCells(); ++cell)
+            {
+            const unsigned int np = h_cell_np_0.data[cell];
+            UP_ASSERT_EQUAL(h_cell_np_1.data[cell], np);
+            n_binned += np;
+
+            // the order of the members within a cell is not guaranteed on the GPU
+            std::vector<unsigned int> members_0, members_1;
+            for (unsigned int offset = 0; offset < np; ++offset)
+                {
+                members_0.push_back(h_cell_list_0.data[cli_0(offset, cell)]);
+                members_1.push_back(h_cell_list_1.data[cli_1(offset, cell)]);
+                }
+            std::sort(members_0.begin(), members_0.end());
+            std::sort(members_1.begin(), members_1.end());
+            UP_ASSERT(members_1 == members_0);
+
+            CHECK_CLOSE(h_cell_vel_1.data[cell].x, h_cell_vel_0.data[cell].x, tol);
+            CHECK_CLOSE(h_cell_vel_1.data[cell].y, h_cell_vel_0.data[cell].y, tol);
+            CHECK_CLOSE(h_cell_vel_1.data[cell].z, h_cell_vel_0.data[cell].z, tol);
+            CHECK_CLOSE(h_cell_vel_1.data[cell].w, h_cell_vel_0.data[cell].w, tol);
+            if (np > 0)
+                {
+                CHECK_CLOSE(h_cell_energy_1.data[cell].x, h_cell_energy_0.data[cell].x, tol);
+                CHECK_CLOSE(h_cell_energy_1.data[cell].y, h_cell_energy_0.data[cell].y, tol);
+                UP_ASSERT_EQUAL(__double_as_int(h_cell_energy_1.data[cell].z), np);
+                }
+            }
+        UP_ASSERT_EQUAL(n_binned, 6);
+        }
+    }
+
+//! Test that sorting while binning gives the same order as streaming and then sorting
+void streaming_method_sort_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = std::make_shared<BoxDim>(4.0);
+    snap->particle_data.type_mapping.push_back("A");
+
+    // 5 particles, out of cell order and with two sharing a cell after streaming
+    snap->mpcd_data.resize(5);
+    snap->mpcd_data.type_mapping.push_back("A");
+    snap->mpcd_data.position[0] = vec3<Scalar>(1.5, 1.5, 1.5);
+    snap->mpcd_data.position[1] = vec3<Scalar>(-1.5, -1.5, -1.5);
+    snap->mpcd_data.position[2] = vec3<Scalar>(0.5, 0.5, 0.5);
+    snap->mpcd_data.position[3] = vec3<Scalar>(-1.4, -1.6, -1.5);
+    snap->mpcd_data.position[4] = vec3<Scalar>(1.95, -0.5, 1.0);
+    snap->mpcd_data.velocity[0] = vec3<Scalar>(0.0, 0.0, 1.0);
+    snap->mpcd_data.velocity[1] = vec3<Scalar>(1.0, 0.0, 0.0);
+    snap->mpcd_data.velocity[2] = vec3<Scalar>(0.0, -3.0, 0.0);
+    snap->mpcd_data.velocity[3] = vec3<Scalar>(0.0, 1.0, -1.0);
+    snap->mpcd_data.velocity[4] = vec3<Scalar>(1.0, 0.5, -0.5);
+
+    // the same system is streamed and then sorted, and sorted while binning
+    auto geom = std::make_shared<const mpcd::detail::BulkGeometry>();
+    std::shared_ptr<mpcd::ParticleData> pdata[2];
+    std::shared_ptr<mpcd::CellList> cl[2];
+    std::shared_ptr<mpcd::CellThermoCompute> thermo[2];
+    for (unsigned int i = 0; i < 2; ++i)
+        {
+        std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+        pdata[i] = sysdef->getMPCDParticleData();
+        cl[i] = std::make_shared<mpcd::CellList>(sysdef);
+        thermo[i] = std::make_shared<mpcd::CellThermoCompute>(sysdef, cl[i]);
+        AllThermoRequest thermo_req(thermo[i]);
+
+        auto stream
+            = std::make_shared<mpcd::ConfinedStreamingMethod<mpcd::detail::BulkGeometry>>(sysdef,
+                                                                                         0,
+                                                                                         1,
+                                                                                         -1,
+                                                                                         geom);
+        stream->setCellList(cl[i]);
+        stream->setDeltaT(0.1);
+        auto sorter = std::make_shared<mpcd::Sorter>(sysdef, 0, 1);
+        sorter->setCellList(cl[i]);
+
+        cl[i]->compute(0);
+        if (i == 0)
+            {
+            stream->stream(0);
+            }
+        else
+            {
+            stream->streamAndBin(0, 1, thermo[i], sorter);
+            UP_ASSERT(!sorter->peekSort(1));
+            }
+        sorter->update(1);
+        thermo[i]->compute(1);
+        }
+
+    // particles should be in the same order
+        {
+        ArrayHandle<Scalar4> h_pos_0(pdata[0]->getPositions(),
+                                     access_location::host,
+                                     access_mode::read);
+        ArrayHandle<Scalar4> h_vel_0(pdata[0]->getVelocities(),
+                                     access_location::host,
+                                     access_mode::read);
+        ArrayHandle<unsigned int> h_tag_0(pdata[0]->getTags(),
+                                          access_location::host,
+                                          access_mode::read);
+        ArrayHandle<Scalar4> h_pos_1(pdata[1]->getPositions(),
+                                     access_location::host,
+                                     access_mode::read);
+        ArrayHandle<Scalar4> h_vel_1(pdata[1]->getVelocities(),
+                                     access_location::host,
+                                     access_mode::read);
+        ArrayHandle<unsigned int> h_tag_1(pdata[1]->getTags(),
+                                          access_location::host,
+                                          access_mode::read);
+        for (unsigned int i = 0; i < 5; ++i)
+            {
+            UP_ASSERT_EQUAL(h_tag_1.data[i], h_tag_0.data[i]);
+            CHECK_CLOSE(h_pos_1.data[i].x, h_pos_0.data[i].x, tol);
+            CHECK_CLOSE(h_pos_1.data[i].y, h_pos_0.data[i].y, tol);
+            CHECK_CLOSE(h_pos_1.data[i].z, h_pos_0.data[i].z, tol);
+            CHECK_CLOSE(h_vel_1.data[i].x, h_vel_0.data[i].x, tol);
+            CHECK_CLOSE(h_vel_1.data[i].y, h_vel_0.data[i].y, tol);
+            CHECK_CLOSE(h_vel_1.data[i].z, h_vel_0.data[i].z, tol);
+            UP_ASSERT_EQUAL(__scalar_as_int(h_vel_1.data[i].w), __scalar_as_int(h_vel_0.data[i].w));
+            }
+
+        // the order is not the order of the tags
+        UP_ASSERT_EQUAL(h_tag_1.data[0], 1);
+        UP_ASSERT_EQUAL(h_tag_1.data[1], 3);
+        }
+
+    // cells should have the same members in the same order, and the same properties
+        {
+        ArrayHandle<unsigned int> h_cell_np_0(cl[0]->getCellSizeArray(),
+                                              access_location::host,
+                                              access_mode::read);
+        ArrayHandle<unsigned int> h_cell_list_0(cl[0]->getCellList(),
+                                                access_location::host,
+                                                access_mode::read);
+        ArrayHandle<unsigned int> h_cell_np_1(cl[1]->getCellSizeArray(),
+                                              access_location::host,
+                                              access_mode::read);
+        ArrayHandle<unsigned int> h_cell_list_1(cl[1]->getCellList(),
+                                                access_location::host,
+                                                access_mode::read);
+        ArrayHandle<double4> h_cell_vel_0(thermo[0]->getCellVelocities(),
+                                          access_location::host,
+                                          access_mode::read);
+        ArrayHandle<double4> h_cell_vel_1(thermo[1]->getCellVelocities(),
+                                          access_location::host,
+                                          access_mode::read);
+        const Index2D& cli = cl[0]->getCellListIndexer();
+        unsigned int n_binned = 0;
+        for (unsigned int cell = 0; cell < cl[0]->getNCells(); ++cell)
+            {
+            const unsigned int np = h_cell_np_0.data[cell];
+            UP_ASSERT_EQUAL(h_cell_np_1.data[cell], np);
+            for (unsigned int offset = 0; offset < np; ++offset)
+                {
+                UP_ASSERT_EQUAL(h_cell_list_1.data[cli(offset, cell)],
+                                h_cell_list_0.data[cli(offset, cell)]);
+                }
+            n_binned += np;
+
+            CHECK_CLOSE(h_cell_vel_1.data[cell].x, h_cell_vel_0.data[cell].x, tol);
+            CHECK_CLOSE(h_cell_vel_1.data[cell].y, h_cell_vel_0.data[cell].y, tol);
+            CHECK_CLOSE(h_cell_vel_1.data[cell].z, h_cell_vel_0.data[cell].z, tol);
+            CHECK_CLOSE(h_cell_vel_1.data[cell].w, h_cell_vel_0.data[cell].w, tol);
+            }
+        UP_ASSERT_EQUAL(n_binned, 5);
+        }
+    }
+
 //! basic test case for MPCD StreamingMethod class
 UP_TEST(mpcd_streaming_method_basic)
     {
@@ -117,6 +407,21 @@ UP_TEST(mpcd_streaming_method_basic)
     streaming_method_basic_test<method>(
         std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU));
     }
+
+//! test case for binning while streaming with the MPCD StreamingMethod class
+UP_TEST(mpcd_streaming_method_bin)
+    {
+    typedef mpcd::ConfinedStreamingMethod<mpcd::detail::BulkGeometry> method;
+    streaming_method_bin_test<method, mpcd::CellList, mpcd::CellThermoCompute>(
+        std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU));
+    }
+//! test case for sorting while binning with the MPCD StreamingMethod class
+UP_TEST(mpcd_streaming_method_sort)
+    {
+    streaming_method_sort_test(
+        std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU));
+    }
+
 #ifdef ENABLE_HIP
 //! basic test case for MPCD StreamingMethod class
 UP_TEST(mpcd_streaming_method_setup)
@@ -125,4 +430,12 @@ UP_TEST(mpcd_streaming_method_setup)
     streaming_method_basic_test<method>(
         std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::GPU));
     }
+
+//! test case for binning while streaming with the MPCD StreamingMethodGPU class
+UP_TEST(mpcd_streaming_method_bin_gpu)
+    {
+    typedef mpcd::ConfinedStreamingMethodGPU<mpcd::detail::BulkGeometry> method;
+    streaming_method_bin_test<method, mpcd::CellListGPU, mpcd::CellThermoComputeGPU>(
+        std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::GPU));
+    }
 #endif // ENABLE_HIP
@@ -25,8 +25,9 @@ import itertools
 import weakref
 
 import hoomd
-from hoomd.logging import Loggable
+from hoomd.logging import Loggable, log
 from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeparam import TypeParameter
 
 
 class _HOOMDGetSetAttrBase:
@@ -227,6 +228,8 @@ class _HOOMDBaseObject(_HOOMDGetSetAttrBase,
     # _use_count must be included or attaching and detaching won't work as
     # expected as _use_count may not equal 0.
     _remove_for_pickling = ('_simulation_', '_cpp_obj', "_use_count")
+    # Parameters that change as the simulation runs, saved in checkpoints.
+    _checkpoint_params = ()
 
     def _detach(self, force=False):
         """Decrement attach count and destroy C++ object if count == 0.
@@ -381,6 +384,44 @@ class _HOOMDBaseObject(_HOOMDGetSetAttrBase,
         """
         return []
 
+    @property
+    def _checkpoint_children(self):
+        """list: Child objects with their own checkpoint state, in order."""
+        return []
+
+    def _get_checkpoint_state(self):
+        """Get the rank local state that changes as the simulation runs.
+
+        `hoomd.write.Checkpoint` stores the state of every operation and restores
+        it with `_set_checkpoint_state` after the operations attach to a
+        simulation created by `Simulation.create_state_from_checkpoint`.
+        """
+        params = {}
+        for name in self._checkpoint_params:
+            value = getattr(self, name)
+            if isinstance(value, TypeParameter):
+                value = value.to_base()
+            params[name] = value
+        children = [
+            child._get_checkpoint_state() for child in self._checkpoint_children
+        ]
+        return dict(params=params, children=children)
+
+    def _set_checkpoint_state(self, state):
+        """Restore the state returned by `_get_checkpoint_state`."""
+        for name, value in state['params'].items():
+            attr = getattr(self, name)
+            if isinstance(attr, TypeParameter):
+                attr.update(value)
+            else:
+                setattr(self, name, value)
+
+        children = self._checkpoint_children
+        if len(children) != len(state['children']):
+            raise RuntimeError("The operations do not match the checkpoint.")
+        for child, child_state in zip(children, state['children']):
+            child._set_checkpoint_state(child_state)
+
     def __getstate__(self):
         state = copy(self.__dict__)
         for attr in self._remove_for_pickling:
@@ -466,6 +507,39 @@ class AutotunedObject(_HOOMDBaseObject):
             raise hoomd.error.DataAccessError("kernel_parameters")
         return self._cpp_obj.setAutotunerParameters(parameters)
 
+    @log(category='object', default=False, requires_run=True)
+    def kernel_telemetry(self):
+        """dict[str, dict]: Performance of each autotuned kernel.
+
+        The dictionary maps GPU kernel names to dictionaries with the keys:
+
+        * ``'parameter'``: The current kernel parameters (`tuple` [`int`]).
+        * ``'calls'``: The number of timed kernel launches with the current
+          parameters (`int`).
+        * ``'mean_time'``: The mean time per timed launch in milliseconds
+          (`float`).
+        * ``'bytes_per_call'``: The estimated number of bytes that each launch
+          reads and writes (`int`).
+        * ``'bandwidth'``: The achieved memory bandwidth in GB/s (`float`).
+        * ``'peak_fraction'``: The ratio of the achieved bandwidth to the
+          theoretical peak bandwidth of the GPU (`float`).
+
+        After a kernel completes tuning, `AutotunedObject` times the kernel
+        launches that start after the previous timing completes, without
+        synchronizing the GPU. Values that are not available are `None`,
+        including the bandwidth of kernels that do not estimate the number of
+        bytes they move. Tuning new kernel parameters resets the statistics.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            kernel_telemetry = operation.kernel_telemetry
+        """
+        if not self._attached:
+            raise hoomd.error.DataAccessError("kernel_telemetry")
+        return self._cpp_obj.getAutotunerTelemetry()
+
     @property
     def is_tuning_complete(self):
         """bool: Check if kernel parameter tuning is complete.
@@ -503,6 +577,15 @@ class AutotunedObject(_HOOMDBaseObject):
                                "tune_kernel_parameters.")
         self._cpp_obj.startAutotuning()
 
+    def _get_checkpoint_state(self):
+        state = super()._get_checkpoint_state()
+        state['kernel_parameters'] = self.kernel_parameters
+        return state
+
+    def _set_checkpoint_state(self, state):
+        super()._set_checkpoint_state(state)
+        self.kernel_parameters = state['kernel_parameters']
+
 
 class Operation(AutotunedObject):
     """Represents an operation.
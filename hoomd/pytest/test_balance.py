@@ -37,6 +37,16 @@ def test_balance_properties():
     balance.max_iterations = 5
     assert balance.max_iterations == 5
 
+    assert balance.weight == 'particles'
+    balance.weight = 'time'
+    assert balance.weight == 'time'
+    with pytest.raises(ValueError):
+        balance.weight = 'neighbors'
+
+    assert balance.hysteresis == 0.0
+    balance.hysteresis = 0.1
+    assert balance.hysteresis == 0.1
+
 
 def test_attach_detach(simulation_factory, lattice_snapshot_factory):
     snapshot = lattice_snapshot_factory()
@@ -114,3 +124,36 @@ def test_balance_action(device, simulation_factory, lattice_snapshot_factory):
 
     # the load balance should move the split place down toward the particles
     assert sim.state.domain_decomposition_split_fractions[2][0] < 0.5
+
+
+def test_balance_time(device, simulation_factory, lattice_snapshot_factory):
+    """Test that balancing by time moves the split plane toward the cost."""
+    if device.communicator.num_ranks != 2:
+        pytest.skip("Test supports only 2 ranks")
+    if isinstance(device, hoomd.device.GPU):
+        pytest.skip("Time weighting is not supported on the GPU")
+
+    snapshot = lattice_snapshot_factory(n=10)
+
+    # compress the particles into the lower MPI domain
+    box = list(snapshot.configuration.box)
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.position[:, 2] -= box[2] / 2
+    box[2] *= 2
+    snapshot.configuration.box = box
+    sim = simulation_factory(snapshot, domain_decomposition=(1, 1, 2))
+
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    lj = hoomd.md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005, forces=[lj])
+    sim.run(10)
+
+    balance = hoomd.tune.LoadBalancer(trigger=hoomd.trigger.Periodic(5),
+                                      weight="time",
+                                      hysteresis=0.05)
+    sim.operations.tuners.append(balance)
+    sim.run(10)
+
+    # all of the force compute time is in the lower domain
+    assert sim.state.domain_decomposition_split_fractions[2][0] < 0.5
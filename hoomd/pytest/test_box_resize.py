@@ -316,3 +316,61 @@ def test_invalid_api(variant, trigger):
         box_resize.box2 = box2
     with pytest.raises(RuntimeError):
         box_resize.variant = variant
+
+
+def test_small_deformation(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory(two_particle_snapshot_factory())
+    box_resize = hoomd.update.BoxResize(trigger=hoomd.trigger.Periodic(1),
+                                        box=hoomd.variant.box.Constant(
+                                            hoomd.Box.cube(10)))
+    assert not box_resize.small_deformation
+    box_resize.small_deformation = True
+    sim.operations.updaters.append(box_resize)
+    sim.run(0)
+    assert box_resize.small_deformation
+
+    box_resize.small_deformation = False
+    assert not box_resize.small_deformation
+
+
+@pytest.mark.skipif(not hoomd.version.md_built, reason="BUILD_MD=on required")
+def test_small_deformation_trajectory(simulation_factory,
+                                      lattice_snapshot_factory):
+    """Small deformations reuse the cell grid without changing the forces."""
+    initial_snapshot = lattice_snapshot_factory(dimensions=2,
+                                                n=25,
+                                                a=1.2,
+                                                r=0.1)
+    final_positions = []
+    for small_deformation in [False, True]:
+        sim = simulation_factory(initial_snapshot)
+
+        lj = hoomd.md.pair.LJ(nlist=hoomd.md.nlist.Cell(buffer=0.4))
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        lj.r_cut[('A', 'A')] = 2.5
+        nve = hoomd.md.methods.ConstantVolume(filter=hoomd.filter.All())
+        sim.operations.integrator = hoomd.md.Integrator(dt=0.001,
+                                                        methods=[nve],
+                                                        forces=[lj])
+
+        initial_box = sim.state.box
+        final_box = hoomd.Box.square(initial_box.Lx * 1.07)
+        box = hoomd.variant.box.Interpolate(initial_box=initial_box,
+                                            final_box=final_box,
+                                            variant=hoomd.variant.Ramp(
+                                                0, 1, 0, 20))
+        sim.operations.updaters.append(
+            hoomd.update.BoxResize(trigger=hoomd.trigger.Periodic(1),
+                                   box=box,
+                                   small_deformation=small_deformation))
+        sim.run(20)
+
+        snapshot = sim.state.get_snapshot()
+        if snapshot.communicator.rank == 0:
+            final_positions.append(snapshot.particles.position.copy())
+
+    if len(final_positions) == 2:
+        npt.assert_allclose(final_positions[0],
+                            final_positions[1],
+                            rtol=1e-5,
+                            atol=1e-5)
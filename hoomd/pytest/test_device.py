@@ -51,6 +51,23 @@ def test_common_properties(device, tmp_path):
                               num_cpu_threads=10)
 
 
+def test_pin_cpu_threads(device):
+    assert not device.pin_cpu_threads
+
+    device.pin_cpu_threads = True
+    if hoomd.version.tbb_enabled:
+        assert device.pin_cpu_threads
+
+        # the setting persists when the arena is recreated
+        device.num_cpu_threads = 2
+        assert device.pin_cpu_threads
+    else:
+        assert not device.pin_cpu_threads
+
+    device.pin_cpu_threads = False
+    assert not device.pin_cpu_threads
+
+
 @pytest.mark.gpu
 def test_gpu_specific_properties(device):
     # assert the defaults are right
@@ -71,6 +88,97 @@ def test_gpu_specific_properties(device):
     assert c[1] >= 0
 
 
+@pytest.mark.gpu
+def test_gpu_memory_pool(device):
+    assert not device.memory_pool
+
+    device.memory_pool = True
+    assert device.memory_pool
+
+    stats = device.memory_pool_stats
+    assert len(stats['device']) == len(device.devices)
+    for key in ('allocations', 'hits', 'system_allocations', 'bytes_in_use',
+                'bytes_cached', 'peak_bytes_in_use'):
+        assert key in stats['host']
+        assert key in stats['managed']
+
+    device.memory_pool = False
+    assert not device.memory_pool
+    assert device.memory_pool_stats['host']['bytes_cached'] == 0
+
+
+@pytest.mark.gpu
+@pytest.mark.serial
+@pytest.mark.skipif(not hoomd.version.md_built, reason="BUILD_MD=on required")
+def test_gpu_autotuner_cache(device, simulation_factory,
+                             lattice_snapshot_factory, tmp_path):
+    filename = tmp_path / 'autotuner_cache.txt'
+    assert device.autotuner_cache is None
+    device.autotuner_cache = filename
+    assert device.autotuner_cache == str(filename)
+
+    def make_simulation():
+        sim = simulation_factory(lattice_snapshot_factory(n=10, a=1.5))
+        lj = hoomd.md.pair.LJ(nlist=hoomd.md.nlist.Cell(buffer=0.4))
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        lj.r_cut[('A', 'A')] = 2.5
+        integrator = hoomd.md.Integrator(dt=0.001, forces=[lj])
+        integrator.methods.append(
+            hoomd.md.methods.ConstantVolume(filter=hoomd.filter.All()))
+        sim.operations.integrator = integrator
+        return sim, lj
+
+    sim, lj = make_simulation()
+    sim.run(0)
+    while not lj.is_tuning_complete:
+        sim.run(100)
+
+    assert filename.exists()
+    assert len(filename.read_text().splitlines()) > 0
+    kernel_parameters = lj.kernel_parameters
+
+    # a new simulation starts with the stored parameters
+    sim, lj = make_simulation()
+    sim.run(1)
+    assert lj.is_tuning_complete
+    assert lj.kernel_parameters == kernel_parameters
+
+    device.autotuner_cache = None
+    assert device.autotuner_cache is None
+
+
+@pytest.mark.gpu
+@pytest.mark.skipif(not hoomd.version.md_built, reason="BUILD_MD=on required")
+def test_gpu_autotuner_successive_halving(device, simulation_factory,
+                                         lattice_snapshot_factory):
+    assert not device.autotuner_successive_halving
+    assert device.autotuner_stop_threshold == 0
+    device.autotuner_successive_halving = True
+    device.autotuner_stop_threshold = 0.05
+    assert device.autotuner_successive_halving
+    assert device.autotuner_stop_threshold == pytest.approx(0.05)
+
+    with pytest.raises(ValueError):
+        device.autotuner_stop_threshold = -1
+
+    sim = simulation_factory(lattice_snapshot_factory(n=10, a=1.5))
+    lj = hoomd.md.pair.LJ(nlist=hoomd.md.nlist.Cell(buffer=0.4))
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    lj.r_cut[('A', 'A')] = 2.5
+    integrator = hoomd.md.Integrator(dt=0.001, forces=[lj])
+    integrator.methods.append(
+        hoomd.md.methods.ConstantVolume(filter=hoomd.filter.All()))
+    sim.operations.integrator = integrator
+
+    sim.run(0)
+    while not lj.is_tuning_complete:
+        sim.run(10)
+    assert lj.kernel_parameters
+
+    device.autotuner_successive_halving = False
+    device.autotuner_stop_threshold = 0
+
+
 @pytest.mark.gpu
 def test_other_gpu_specifics(device):
     # make sure GPU is available and auto-select gives a GPU
@@ -210,6 +210,29 @@ def test_difference(make_filter_snapshot, simulation_factory, set_indices):
         assert difference_filter(sim.state) == combo_filter(sim.state)
 
 
+def test_nested_set_operations(make_filter_snapshot, simulation_factory):
+    particle_types = ['A', 'B', 'C']
+    N = 150
+    filter_snapshot = make_filter_snapshot(n=N, particle_types=particle_types)
+    if filter_snapshot.communicator.rank == 0:
+        filter_snapshot.particles.typeid[:] = np.arange(N) % 3
+    sim = simulation_factory(filter_snapshot)
+
+    A = set(range(0, N, 3))
+    B = set(range(1, N, 3))
+    tags = set(range(10, 130, 7))
+    filter_ = Union(SetDifference(Union(Type(['A']), Tags(list(tags))),
+                                  Type(['B'])),
+                    Intersection(Type(['B']), Tags(list(range(100, 150)))))
+    expected = ((A | tags) - B) | (B & set(range(100, 150)))
+
+    selected = filter_(sim.state)
+    snapshot = sim.state.get_snapshot()
+    if snapshot.communicator.num_ranks == 1:
+        assert selected == sorted(expected)
+    assert sim.state._get_group(filter_).getNumMembersGlobal() == len(expected)
+
+
 _filter_classes = [
     All,
     Tags,
@@ -240,3 +263,30 @@ def test_pickling(constructor, args):
     pickled_filter = pickle.loads(pickle.dumps(filter_))
     assert pickled_filter == filter_
     assert hash(pickled_filter) == hash(filter_)
+
+
+@pytest.mark.serial
+def test_incremental_group_update(make_filter_snapshot, simulation_factory):
+    particle_types = ['A', 'B']
+    filter_snapshot = make_filter_snapshot(n=10, particle_types=particle_types)
+    sim = simulation_factory(filter_snapshot)
+    filters = [
+        All(),
+        Type(['B']),
+        Union(Type(['B']), Tags([0, 1])),
+        SetDifference(All(), Type(['B'])),
+    ]
+    groups = [sim.state._get_group(filter_) for filter_ in filters]
+
+    pdata = sim.state._cpp_sys_def.getParticleData()
+    pdata.setType(3, 1)
+    pdata.setType(7, 1)
+    pdata.setType(3, 0)
+    tag = pdata.addParticle(1)
+    pdata.removeParticle(0)
+
+    assert tag == 10
+    for filter_, group in zip(filters, groups):
+        expected_tags = sorted(filter_(sim.state))
+        assert group.getNumMembersGlobal() == len(expected_tags)
+        assert list(group.member_tags) == expected_tags
@@ -529,3 +529,28 @@ class TestLocalSnapshots:
         else:
             yield 'cpu_local_snapshot'
             yield 'gpu_local_snapshot'
+
+    def test_dlpack(self, base_simulation):
+        sim = base_simulation()
+        if not hasattr(np, 'from_dlpack'):
+            pytest.skip("NumPy does not support DLPack.")
+
+        with sim.state.cpu_local_snapshot as data:
+            position = data.particles.position
+            assert position.__dlpack_device__() == (1, 0)
+
+            # the tensor shares the memory of the local snapshot
+            tensor = np.from_dlpack(position)
+            np.testing.assert_array_equal(tensor, position)
+            tensor[:, 2] += 0.25
+            np.testing.assert_array_equal(tensor, position)
+
+            # integer buffers export with their own data type
+            typeid = data.particles.typeid
+            np.testing.assert_array_equal(np.from_dlpack(typeid), typeid)
+
+            with pytest.raises(BufferError):
+                position.__dlpack__(copy=True)
+
+        with pytest.raises(hoomd.data.array.HOOMDArrayError):
+            position.__dlpack__()
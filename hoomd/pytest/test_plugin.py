@@ -0,0 +1,57 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+import hoomd
+import pytest
+
+operations = [(hoomd.update.Plugin, 'updaters'),
+              (hoomd.write.Plugin, 'writers'), (hoomd.tune.Plugin, 'tuners')]
+
+
+@pytest.mark.parametrize("operation, operation_list", operations)
+def test_attributes(operation, operation_list):
+    parameters = dict(factor=0.5)
+    plugin = operation(trigger=hoomd.trigger.Periodic(10),
+                       library='libactions.so',
+                       name='Example',
+                       parameters=parameters)
+    assert plugin.trigger.period == 10
+    assert plugin.library == 'libactions.so'
+    assert plugin.name == 'Example'
+    assert plugin.parameters == parameters
+
+    # the operation keeps its own copy of the parameters
+    parameters['factor'] = 1.0
+    assert plugin.parameters == dict(factor=0.5)
+
+    with pytest.raises(AttributeError):
+        plugin.library = 'other.so'
+
+    assert operation(trigger=1, library='libactions.so',
+                     name='Example').parameters == {}
+
+
+@pytest.mark.parametrize("operation, operation_list", operations)
+def test_missing_library(simulation_factory, two_particle_snapshot_factory,
+                         tmp_path, operation, operation_list):
+    sim = simulation_factory(two_particle_snapshot_factory())
+    plugin = operation(trigger=1,
+                       library=str(tmp_path / 'missing.so'),
+                       name='Example')
+    getattr(sim.operations, operation_list).append(plugin)
+
+    with pytest.raises(RuntimeError):
+        sim.run(0)
+
+
+def test_not_a_plugin(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory(two_particle_snapshot_factory())
+
+    # the HOOMD library itself defines no plugin entry points
+    plugin = hoomd.update.Plugin(trigger=1,
+                                 library=hoomd._hoomd.__file__,
+                                 name='Example')
+    sim.operations.updaters.append(plugin)
+
+    with pytest.raises(RuntimeError):
+        sim.run(0)
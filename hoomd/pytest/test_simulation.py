@@ -161,6 +161,52 @@ def test_walltime(simulation_factory, two_particle_snapshot_factory):
     assert all(a >= b for a, b in zip(walltime[1:], walltime[:-1]))
 
 
+def test_profile(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory()
+    assert not sim.profiling
+    with pytest.raises(RuntimeError):
+        sim.profiling = True
+
+    sim = simulation_factory(two_particle_snapshot_factory())
+    sim.operations += SleepUpdater.wrapped()
+    sim.run(10)
+    assert sim.profile == {}
+
+    sim.profiling = True
+    assert sim.profiling
+    sim.run(10)
+    profile = sim.profile
+    assert 'hoomd::PythonUpdater' in profile
+    updater = profile['hoomd::PythonUpdater']
+    assert updater['count'] == 10
+    assert updater['total_time'] > 0
+    assert sum(updater['histogram']) == 10
+
+    # the profile resets at the start of each run
+    sim.run(5)
+    assert sim.profile['hoomd::PythonUpdater']['count'] == 5
+
+
+def test_memory_usage(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory(two_particle_snapshot_factory())
+
+    usage = {(entry['owner'], entry['tag']): entry for entry in sim.memory_usage}
+    pos = usage[('hoomd::ParticleData', 'm_pos')]
+    assert pos['allocations'] >= 1
+    total_bytes = (pos['host_bytes'] + pos['device_bytes']
+                   + pos['managed_bytes'])
+    assert total_bytes >= 2 * 32
+
+    memory_bytes = sim.memory_bytes
+    assert len(memory_bytes) == 3
+    assert sum(memory_bytes) >= total_bytes
+
+    sim.reset_peak_memory_bytes()
+    memory_bytes = sim.memory_bytes
+    peak_memory_bytes = sim.peak_memory_bytes
+    assert all(p >= b for p, b in zip(peak_memory_bytes, memory_bytes))
+
+
 def test_timestep(simulation_factory, lattice_snapshot_factory):
     sim = simulation_factory()
     assert sim.timestep is None
@@ -242,6 +288,112 @@ def test_state_from_gsd(device, simulation_factory, lattice_snapshot_factory,
         assert_equivalent_snapshots(snap, sim.state.get_snapshot())
 
 
+@skip_gsd
+def test_state_from_gsd_distributed(device, simulation_factory,
+                                    lattice_snapshot_factory, tmp_path):
+    filename = tmp_path / "temporary_test_file.gsd"
+
+    sim = simulation_factory(
+        lattice_snapshot_factory(n=10, particle_types=["A", "B"]))
+    snap = update_positions(sim.state.get_snapshot())
+    set_types(snap, random_inds(10), ["A", "B"], "B")
+    if device.communicator.rank == 0:
+        snap.particles.velocity[:] = np.random.random((snap.particles.N, 3))
+        snap.particles.image[:] = np.random.randint(-10, 10,
+                                                   (snap.particles.N, 3))
+        snap.particles.charge[:] = np.random.random(snap.particles.N)
+        snap.bonds.N = 2
+        snap.bonds.types = ["bond"]
+        snap.bonds.group[:] = [[0, 1], [2, 3]]
+
+        with gsd.hoomd.open(name=filename, mode='w') as f:
+            f.append(make_gsd_frame(snap))
+
+    sim = simulation_factory()
+    sim.create_state_from_gsd(filename, distributed=True)
+    assert sim.state.N_particles == 10**3
+
+    read_snap = sim.state.get_snapshot()
+    assert_equivalent_snapshots(snap, read_snap)
+    if device.communicator.rank == 0:
+        assert read_snap.bonds.N == 2
+        np.testing.assert_array_equal(read_snap.bonds.group, [[0, 1], [2, 3]])
+
+
+@skip_gsd
+@pytest.mark.parametrize("distributed", [False, True])
+def test_state_from_gsd_fields(device, simulation_factory,
+                               lattice_snapshot_factory, tmp_path, distributed):
+    filename = tmp_path / "temporary_test_file.gsd"
+
+    sim = simulation_factory(lattice_snapshot_factory(n=4))
+    snap = update_positions(sim.state.get_snapshot())
+    if device.communicator.rank == 0:
+        snap.particles.velocity[:] = 1.5
+        snap.particles.mass[:] = 2.0
+        snap.bonds.N = 1
+        snap.bonds.types = ["bond"]
+        snap.bonds.group[:] = [[0, 1]]
+
+        with gsd.hoomd.open(name=filename, mode='w') as f:
+            f.append(make_gsd_frame(snap))
+
+    sim = simulation_factory()
+    sim.create_state_from_gsd(filename,
+                              distributed=distributed,
+                              fields=['particles/position'])
+    read_snap = sim.state.get_snapshot()
+    if device.communicator.rank == 0:
+        np.testing.assert_allclose(read_snap.particles.position,
+                                   snap.particles.position)
+        np.testing.assert_array_equal(read_snap.particles.velocity, 0)
+        np.testing.assert_array_equal(read_snap.particles.mass, 1)
+        assert read_snap.bonds.N == 0
+
+    with pytest.raises(RuntimeError):
+        simulation_factory().create_state_from_gsd(filename,
+                                                   fields=['particles/x'])
+
+
+@skip_gsd
+def test_snapshot_read_gsd(device, simulation_factory, lattice_snapshot_factory,
+                           tmp_path):
+    filename = tmp_path / "temporary_test_file.gsd"
+
+    sim = simulation_factory(lattice_snapshot_factory(n=4))
+    snapshots = []
+    for step in range(5):
+        snap = update_positions(sim.state.get_snapshot())
+        snapshots.append(snap)
+        if device.communicator.rank == 0:
+            snap.particles.velocity[:] = step
+            frame = make_gsd_frame(snap)
+            frame.configuration.step = step * 10
+            if step == 0:
+                f = gsd.hoomd.open(name=filename, mode='w')
+            f.append(frame)
+    if device.communicator.rank == 0:
+        f.close()
+
+    frames = list(
+        hoomd.Snapshot.read_gsd(filename,
+                                device,
+                                frames=slice(None, None, 2),
+                                fields=['particles/position']))
+    assert [step for step, _ in frames] == [0, 20, 40]
+    for i, (_, read_snap) in enumerate(frames):
+        if device.communicator.rank == 0:
+            np.testing.assert_allclose(read_snap.particles.position,
+                                       snapshots[i * 2].particles.position)
+            np.testing.assert_array_equal(read_snap.particles.velocity, 0)
+
+    step, read_snap = next(
+        hoomd.Snapshot.read_gsd(filename, device, frames=[-1]))
+    assert step == 40
+    if device.communicator.rank == 0:
+        np.testing.assert_array_equal(read_snap.particles.velocity, 4)
+
+
 @skip_gsd
 def test_state_from_gsd_box_dims(device, simulation_factory,
                                  lattice_snapshot_factory, tmp_path):
@@ -369,6 +521,51 @@ def test_writer_order_initial(simulation_factory,
     ]
 
 
+
+def test_idle_steps(simulation_factory, two_particle_snapshot_factory):
+    """Ensure that operations run on their steps around blocks of idle steps."""
+
+    class StepRecorder(hoomd.custom.Action):
+
+        def __init__(self):
+            self.steps = []
+
+        def act(self, timestep):
+            self.steps.append(timestep)
+
+    triggers = [
+        hoomd.trigger.Periodic(period=70, phase=3),
+        hoomd.trigger.On(timestep=151),
+        hoomd.trigger.And(
+            [hoomd.trigger.Periodic(period=50),
+             hoomd.trigger.After(200)]),
+    ]
+    updater_records = [StepRecorder() for _ in triggers]
+    writer_records = [StepRecorder() for _ in triggers]
+
+    sim = simulation_factory(two_particle_snapshot_factory())
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005)
+    for trigger, updater_record, writer_record in zip(triggers,
+                                                      updater_records,
+                                                      writer_records):
+        sim.operations.updaters.append(
+            hoomd.update.CustomUpdater(action=updater_record,
+                                       trigger=trigger))
+        sim.operations.writers.append(
+            hoomd.write.CustomWriter(action=writer_record, trigger=trigger))
+
+    sim.run(400)
+    assert sim.timestep == 400
+
+    for trigger, updater_record, writer_record in zip(triggers,
+                                                      updater_records,
+                                                      writer_records):
+        assert updater_record.steps == [t for t in range(400) if trigger(t)]
+        assert writer_record.steps == [
+            t for t in range(1, 401) if trigger(t)
+        ]
+
+
 def test_large_timestep(simulation_factory, lattice_snapshot_factory):
     """Test that simluations suport large timestep values."""
     sim = simulation_factory()
@@ -501,6 +698,22 @@ def test_mutability_error(simulation_factory, two_particle_snapshot_factory,
 def test_logging():
     logging_check(
         hoomd.Simulation, (), {
+            'memory_bytes': {
+                'category': LoggerCategories.sequence,
+                'default': True
+            },
+            'memory_usage': {
+                'category': LoggerCategories.object,
+                'default': True
+            },
+            'peak_memory_bytes': {
+                'category': LoggerCategories.sequence,
+                'default': True
+            },
+            'profile': {
+                'category': LoggerCategories.object,
+                'default': True
+            },
             'final_timestep': {
                 'category': LoggerCategories.scalar,
                 'default': True
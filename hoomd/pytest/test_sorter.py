@@ -5,6 +5,7 @@
 
 from hoomd.conftest import operation_pickling_check
 import hoomd
+import numpy
 
 
 def test_attributes():
@@ -44,3 +45,35 @@ def test_pickling(simulation_factory, two_particle_snapshot_factory):
     # simulation
     sorter = sim.operations.tuners.pop()
     operation_pickling_check(sorter, sim)
+
+
+def test_sort_bonds(simulation_factory, lattice_snapshot_factory):
+    """Test that sorting keeps the bonds and their types."""
+    snap = lattice_snapshot_factory(n=6, a=1.5, r=0.2)
+    if snap.communicator.rank == 0:
+        n = snap.particles.N
+        snap.bonds.types = ['A', 'B']
+        snap.bonds.N = n - 1
+        # shuffle the bond table so that it does not follow the particles
+        order = numpy.random.default_rng(1).permutation(n - 1)
+        snap.bonds.group[:] = numpy.stack((order, order + 1), axis=1)
+        snap.bonds.typeid[:] = order % 2
+        snap.angles.types = ['A']
+        snap.angles.N = n - 2
+        snap.angles.group[:] = numpy.stack(
+            (order[order < n - 2], order[order < n - 2] + 1,
+             order[order < n - 2] + 2),
+            axis=1)
+        bonds = snap.bonds.group.copy()
+        bond_types = snap.bonds.typeid.copy()
+        angles = snap.angles.group.copy()
+
+    sim = simulation_factory(snap)
+    sim.operations.tuners[0].trigger = hoomd.trigger.Periodic(1)
+    sim.run(2)
+
+    snap = sim.state.get_snapshot()
+    if snap.communicator.rank == 0:
+        numpy.testing.assert_array_equal(snap.bonds.group, bonds)
+        numpy.testing.assert_array_equal(snap.bonds.typeid, bond_types)
+        numpy.testing.assert_array_equal(snap.angles.group, angles)
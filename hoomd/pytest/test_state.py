@@ -271,6 +271,24 @@ def test_replicate(simulation_factory, lattice_snapshot_factory):
     assert_snapshots_equal(initial_snapshot, new_snapshot)
 
 
+def test_replicate_topology(simulation_factory, snap):
+    sim = simulation_factory(snap)
+    sim.state.replicate(2, 1, 3)
+
+    snap.replicate(2, 1, 3)
+    assert_snapshots_equal(snap, sim.state.get_snapshot())
+    assert sim.state.N_particles == 6000
+
+
+def test_create_state_replicated(device, snap):
+    sim = hoomd.Simulation(device)
+    sim.create_state_from_snapshot(snap, replicate=(3, 2, 2))
+
+    snap.replicate(3, 2, 2)
+    assert_snapshots_equal(snap, sim.state.get_snapshot())
+    assert sim.state.N_particles == 12000
+
+
 def test_domain_decomposition(device, simulation_factory,
                               lattice_snapshot_factory):
     snapshot = lattice_snapshot_factory()
@@ -308,3 +326,117 @@ def test_domain_decomposition(device, simulation_factory,
                                                                   [0.25])
     else:
         raise RuntimeError("Test only supports 1 and 2 ranks")
+
+
+def test_memory_shrink_fraction(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory())
+    N = sim.state.N_particles
+    assert sim.state.memory_shrink_fraction == 0
+
+    sim.state.memory_shrink_fraction = 0.5
+    assert sim.state.memory_shrink_fraction == 0.5
+
+    with pytest.raises(RuntimeError):
+        sim.state.memory_shrink_fraction = 0.9
+    with pytest.raises(RuntimeError):
+        sim.state.memory_shrink_fraction = -0.1
+    assert sim.state.memory_shrink_fraction == 0.5
+
+    # the simulation runs and keeps all particles while the arrays shrink
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005)
+    sim.run(10)
+    assert sim.state.N_particles == N
+
+
+def test_distributed_snapshot(simulation_factory, lattice_snapshot_factory):
+    snapshot = lattice_snapshot_factory(particle_types=['A', 'B'], n=6)
+    sim = simulation_factory(snapshot)
+    communicator = sim.device.communicator
+
+    distributed = sim.state.get_distributed_snapshot()
+    assert distributed.N == sim.state.N_particles
+    assert distributed.box == sim.state.box
+    assert distributed.particles.types == sim.state.particle_types
+
+    # the slices cover all particles in rank order
+    n_local = distributed.particles.N
+    assert distributed.reduce(n_local)[()] == distributed.N
+    offsets = numpy.zeros(communicator.num_ranks)
+    offsets[communicator.rank] = distributed.offset
+    sizes = numpy.zeros(communicator.num_ranks)
+    sizes[communicator.rank] = n_local
+    offsets = distributed.reduce(offsets)
+    sizes = distributed.reduce(sizes)
+    numpy.testing.assert_array_equal(offsets[1:], numpy.cumsum(sizes)[:-1])
+
+    # the slices match the gathered snapshot
+    position = numpy.zeros((distributed.N, 3))
+    position[distributed.offset:distributed.offset
+             + n_local] = distributed.particles.position
+    position = distributed.reduce(position)
+    gathered = sim.state.get_snapshot()
+    if communicator.rank == 0:
+        numpy.testing.assert_allclose(position, gathered.particles.position)
+
+    assert distributed.reduce(distributed.particles.mass.max(initial=0),
+                              op='max')[()] == 1.0
+    with pytest.raises(RuntimeError):
+        distributed.reduce(0, op='product')
+
+    # restore the particles from the modified slices
+    distributed.particles.typeid[:] = 1
+    distributed.particles.velocity[:] = [1, 2, 3]
+    sim.state.set_distributed_snapshot(distributed)
+    assert sim.state.N_particles == distributed.N
+
+    gathered = sim.state.get_snapshot()
+    if communicator.rank == 0:
+        numpy.testing.assert_allclose(gathered.particles.position,
+                                      snapshot.particles.position)
+        numpy.testing.assert_array_equal(gathered.particles.typeid, 1)
+        numpy.testing.assert_allclose(gathered.particles.velocity,
+                                      [[1, 2, 3]] * distributed.N)
+
+
+def test_update_particles(simulation_factory, lattice_snapshot_factory):
+    snapshot = lattice_snapshot_factory(particle_types=['A', 'B'], n=6)
+    sim = simulation_factory(snapshot)
+    N = sim.state.N_particles
+    group_b = sim.state._get_group(hoomd.filter.Type(['B']))
+    assert group_b.getNumMembersGlobal() == 0
+
+    tags = numpy.arange(0, N, 10, dtype=numpy.uint32)
+    sim.state.update_particles(tags,
+                               typeid=numpy.ones(len(tags)),
+                               charge=numpy.full(len(tags), -1.0),
+                               velocity=[[1, 2, 3]] * len(tags),
+                               orientation=[[0, 1, 0, 0]] * len(tags))
+    assert sim.state.N_particles == N
+    assert group_b.getNumMembersGlobal() == len(tags)
+
+    gathered = sim.state.get_snapshot()
+    if sim.device.communicator.rank == 0:
+        changed = numpy.zeros(N, dtype=bool)
+        changed[tags] = True
+        numpy.testing.assert_array_equal(gathered.particles.typeid,
+                                         changed.astype(numpy.uint32))
+        numpy.testing.assert_allclose(gathered.particles.charge[changed], -1)
+        numpy.testing.assert_allclose(gathered.particles.charge[~changed], 0)
+        numpy.testing.assert_allclose(gathered.particles.velocity[changed],
+                                      [[1, 2, 3]] * len(tags))
+        numpy.testing.assert_allclose(gathered.particles.orientation[changed],
+                                      [[0, 1, 0, 0]] * len(tags))
+        numpy.testing.assert_allclose(gathered.particles.position,
+                                      snapshot.particles.position)
+
+    with pytest.raises(ValueError):
+        sim.state.update_particles([N], mass=[2.0])
+    with pytest.raises(ValueError):
+        sim.state.update_particles([0], typeid=[2])
+    with pytest.raises(ValueError):
+        sim.state.update_particles([0, 1], velocity=[[1, 2, 3]])
+
+    # the simulation runs with the new types
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005)
+    sim.run(2)
+    assert group_b.getNumMembersGlobal() == len(tags)
@@ -136,3 +136,51 @@ def test_custom():
     # test that the custom trigger can be called from c++
     assert hoomd._hoomd._test_trigger_call(c, 0)
     assert not hoomd._hoomd._test_trigger_call(c, 250000000001)
+
+
+@pytest.mark.parametrize('trigger, eval_func',
+                         zip(triggers(), _eval_funcs),
+                         ids=_test_name)
+def test_next_active(trigger, eval_func):
+    never = 2**64 - 1
+    for i in range(300):
+        next_active = trigger.next_active(i)
+        assert next_active >= i
+        end = min(next_active, 1000)
+        assert not any(eval_func(t) for t in range(i, end))
+
+        # the simple triggers find the exact next active step
+        if (isinstance(trigger, (hoomd.trigger.Periodic, hoomd.trigger.Before,
+                                 hoomd.trigger.After, hoomd.trigger.On))
+                and next_active != never):
+            assert eval_func(next_active)
+
+
+class CountingTrigger(hoomd.trigger.Trigger):
+
+    def __init__(self, skip):
+        hoomd.trigger.Trigger.__init__(self)
+        self.skip = skip
+        self.calls = 0
+
+    def compute(self, timestep):
+        self.calls += 1
+        return timestep % 100 == 0
+
+    def next_active(self, timestep):
+        if not self.skip:
+            return timestep
+        return -(-timestep // 100) * 100
+
+
+@pytest.mark.parametrize('skip', [False, True])
+def test_custom_next_active(skip):
+    trigger = CountingTrigger(skip)
+    for i in range(1000):
+        assert hoomd._hoomd._test_trigger_call(trigger, i) == (i % 100 == 0)
+
+    if skip:
+        # one call on the active step and one on the step after it
+        assert trigger.calls == 20
+    else:
+        assert trigger.calls == 1000
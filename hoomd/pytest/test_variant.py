@@ -231,3 +231,27 @@ def test_custom():
     for i in range(0, 10000, 100):
         assert (hoomd._hoomd._test_variant_call(pkled_variant,
                                                 i) == float(i)**(1 / 2))
+
+
+class CountingVariant(CustomVariant):
+
+    def __init__(self):
+        super().__init__()
+        self.calls = 0
+
+    def __call__(self, timestep):
+        self.calls += 1
+        return float(timestep)
+
+
+def test_custom_cached():
+    c = CountingVariant()
+
+    # repeated queries on the same step call the python method once
+    for _ in range(3):
+        assert hoomd._hoomd._test_variant_call(c, 10) == 10.0
+    assert c.calls == 1
+
+    assert hoomd._hoomd._test_variant_call(c, 11) == 11.0
+    assert hoomd._hoomd._test_variant_call(c, 10) == 10.0
+    assert c.calls == 3
@@ -0,0 +1,125 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+import hoomd
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.skipif(not hoomd.version.md_built,
+                                reason="BUILD_MD=on required")
+
+
+def _langevin_integrator():
+    langevin = hoomd.md.methods.Langevin(filter=hoomd.filter.All(), kT=1.5)
+    return hoomd.md.Integrator(dt=0.005, methods=[langevin])
+
+
+def _checkpoint(tmp_path, name):
+    return hoomd.write.Checkpoint(trigger=hoomd.trigger.Periodic(1000),
+                                  filename=str(tmp_path / name))
+
+
+def _assert_equal_snapshots(a, b):
+    if a.communicator.rank == 0:
+        assert a.particles.N == b.particles.N
+        np.testing.assert_array_equal(a.particles.position,
+                                      b.particles.position)
+        np.testing.assert_array_equal(a.particles.velocity,
+                                      b.particles.velocity)
+        np.testing.assert_array_equal(a.particles.image, b.particles.image)
+        np.testing.assert_array_equal(a.particles.typeid, b.particles.typeid)
+        assert a.particles.types == b.particles.types
+        assert a.configuration.box == b.configuration.box
+
+
+@pytest.mark.parametrize("asynchronous", [False, True])
+def test_restart(simulation_factory, lattice_snapshot_factory, device,
+                 tmp_path, asynchronous):
+    filename = str(tmp_path / "checkpoint.bin")
+    sim = simulation_factory(lattice_snapshot_factory(n=6, a=1.5))
+    sim.operations.integrator = _langevin_integrator()
+    checkpoint = hoomd.write.Checkpoint(trigger=hoomd.trigger.On(10),
+                                        filename=filename,
+                                        asynchronous=asynchronous)
+    sim.operations.writers.append(checkpoint)
+    sim.run(20)
+    checkpoint.flush()
+
+    restart = hoomd.Simulation(device=device)
+    restart.create_state_from_checkpoint(filename)
+    assert restart.timestep == 10
+    assert restart.seed == sim.seed
+    restart.operations.integrator = _langevin_integrator()
+    restart.operations.writers.append(_checkpoint(tmp_path, "restart.bin"))
+    restart.run(10)
+
+    # the restarted simulation follows the same stochastic trajectory
+    _assert_equal_snapshots(sim.state.get_snapshot(),
+                            restart.state.get_snapshot())
+
+
+def test_operation_state(simulation_factory, lattice_snapshot_factory,
+                         device, tmp_path):
+    filename = str(tmp_path / "checkpoint.bin")
+
+    def make_integrator():
+        mttk = hoomd.md.methods.thermostats.MTTK(kT=1.0, tau=0.5)
+        nvt = hoomd.md.methods.ConstantVolume(filter=hoomd.filter.All(),
+                                              thermostat=mttk)
+        return hoomd.md.Integrator(dt=0.005, methods=[nvt]), mttk
+
+    snapshot = lattice_snapshot_factory(n=6, a=1.5)
+    if snapshot.communicator.rank == 0:
+        velocity = np.linspace(-1, 1, 3 * snapshot.particles.N)
+        snapshot.particles.velocity[:] = velocity.reshape((-1, 3))
+    sim = simulation_factory(snapshot)
+    sim.operations.integrator, mttk = make_integrator()
+    checkpoint = hoomd.write.Checkpoint(trigger=hoomd.trigger.Periodic(5),
+                                        filename=filename)
+    sim.operations.writers.append(checkpoint)
+    sim.run(5)
+
+    restart = hoomd.Simulation(device=device)
+    restart.create_state_from_checkpoint(filename)
+    restart.operations.integrator, restart_mttk = make_integrator()
+    restart.operations.writers.append(_checkpoint(tmp_path, "restart.bin"))
+    restart.run(0)
+
+    assert restart_mttk.translational_dof == mttk.translational_dof
+    assert (restart.operations.integrator._cpp_obj.time ==
+            sim.operations.integrator._cpp_obj.time)
+
+    sim.operations.writers.clear()
+    sim.run(5)
+    restart.run(5)
+    _assert_equal_snapshots(sim.state.get_snapshot(),
+                            restart.state.get_snapshot())
+
+
+def test_mismatched_operations(simulation_factory, lattice_snapshot_factory,
+                               device, tmp_path):
+    filename = str(tmp_path / "checkpoint.bin")
+    sim = simulation_factory(lattice_snapshot_factory())
+    sim.operations.writers.append(
+        hoomd.write.Checkpoint(trigger=hoomd.trigger.Periodic(1),
+                               filename=filename))
+    sim.run(1)
+
+    restart = hoomd.Simulation(device=device)
+    restart.create_state_from_checkpoint(filename)
+    restart.operations.integrator = _langevin_integrator()
+    restart.operations.writers.append(_checkpoint(tmp_path, "restart.bin"))
+    with pytest.raises(RuntimeError):
+        restart.run(1)
+
+
+def test_invalid_file(device, tmp_path):
+    filename = str(tmp_path / "checkpoint.bin")
+    if device.communicator.rank == 0:
+        with open(filename, 'wb') as f:
+            f.write(b'not a checkpoint file')
+    device.communicator.barrier_all()
+
+    sim = hoomd.Simulation(device=device)
+    with pytest.raises(RuntimeError):
+        sim.create_state_from_checkpoint(filename)
@@ -0,0 +1,89 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+import json
+
+import hoomd
+import pytest
+
+pytestmark = pytest.mark.skipif(not hoomd.version.md_built,
+                                reason="BUILD_MD=on required")
+
+
+def _lj_simulation(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory(n=6, a=1.5))
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    langevin = hoomd.md.methods.Langevin(filter=hoomd.filter.All(), kT=1.5)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005,
+                                                    methods=[langevin],
+                                                    forces=[lj])
+    return sim
+
+
+def test_attributes(simulation_factory, lattice_snapshot_factory, tmp_path):
+    filename = str(tmp_path / "trace.json")
+    trace = hoomd.write.Trace(trigger=hoomd.trigger.On(5),
+                              filename=filename,
+                              steps=4)
+    assert trace.filename == filename
+    assert trace.steps == 4
+    assert not trace.recording
+
+    sim = _lj_simulation(simulation_factory, lattice_snapshot_factory)
+    sim.operations.writers.append(trace)
+    sim.run(0)
+    assert trace.steps == 4
+    trace.steps = 2
+    assert trace.steps == 2
+
+
+def test_write(simulation_factory, lattice_snapshot_factory, tmp_path):
+    filename = str(tmp_path / "trace.json")
+    trace = hoomd.write.Trace(trigger=hoomd.trigger.On(5),
+                              filename=filename,
+                              steps=4)
+    sim = _lj_simulation(simulation_factory, lattice_snapshot_factory)
+    sim.operations.writers.append(trace)
+
+    sim.run(7)
+    assert trace.recording
+    sim.run(3)
+    assert not trace.recording
+
+    # tracing does not enable profiling
+    assert not sim.profiling
+
+    if sim.device.communicator.rank == 0:
+        with open(filename) as f:
+            data = json.load(f)
+
+        assert data['otherData']['timestep'] == 5
+        assert data['otherData']['steps'] == 4
+        events = data['traceEvents']
+
+        steps = [e['name'] for e in events if e.get('cat') == 'step']
+        assert steps == [f'Step {t}' for t in range(5, 9)] * (
+            sim.device.communicator.num_ranks)
+
+        regions = [e for e in events if e['ph'] == 'X']
+        assert len(regions) > 0
+        assert all(5 <= e['args']['timestep'] <= 8 for e in regions)
+        assert all(e['dur'] >= 0 for e in regions)
+        pids = set(e['pid'] for e in events)
+        assert pids == set(range(sim.device.communicator.num_ranks))
+
+
+def test_timestep_filename(simulation_factory, lattice_snapshot_factory,
+                           tmp_path):
+    trace = hoomd.write.Trace(trigger=hoomd.trigger.Periodic(5),
+                              filename=str(tmp_path / "trace-{timestep}.json"),
+                              steps=2)
+    sim = _lj_simulation(simulation_factory, lattice_snapshot_factory)
+    sim.operations.writers.append(trace)
+    sim.run(13)
+
+    if sim.device.communicator.rank == 0:
+        assert (tmp_path / "trace-5.json").exists()
+        assert (tmp_path / "trace-10.json").exists()
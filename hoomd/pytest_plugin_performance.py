@@ -0,0 +1,200 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+"""Performance regression tests for pytest.
+
+Tests marked with ``performance`` measure the performance of a simulation with
+the `performance` fixture and compare it to a stored baseline.
+"""
+
+import json
+import os
+
+import pytest
+
+
+def pytest_addoption(parser):
+    """Add HOOMD specific options to the pytest command line.
+
+    * performance - run performance tests
+    * performance-baseline - file with the baseline measurements
+    * performance-tolerance - allowed relative slowdown
+    * performance-update-baseline - store the measurements as the baseline
+    """
+    parser.addoption(
+        "--performance",
+        action="store_true",
+        default=False,
+        help="Enable performance regression tests.",
+    )
+    parser.addoption(
+        "--performance-baseline",
+        action="store",
+        default="hoomd-performance-baseline.json",
+        help="JSON file with the baseline performance measurements.",
+    )
+    parser.addoption(
+        "--performance-tolerance",
+        action="store",
+        type=float,
+        default=0.2,
+        help="Allowed relative slowdown compared to the baseline.",
+    )
+    parser.addoption(
+        "--performance-update-baseline",
+        action="store_true",
+        default=False,
+        help="Store the measurements in the baseline file instead of "
+        "comparing to it.",
+    )
+
+
+@pytest.fixture(autouse=True)
+def skip_performance(request):
+    """Skip performance tests by default.
+
+    Pass the command line option --performance to enable these tests.
+    """
+    if request.node.get_closest_marker('performance'):
+        if not request.config.getoption("performance"):
+            pytest.skip('Performance tests not requested.')
+
+
+def pytest_configure(config):
+    """Define the ``performance`` marker and load the baseline."""
+    config.addinivalue_line(
+        "markers", "performance(tolerance=None): Tests that measure "
+        "performance and compare it to a baseline.")
+
+    config._hoomd_performance_baseline = {}
+    config._hoomd_performance_results = {}
+
+    filename = config.getoption("performance_baseline")
+    if config.getoption("performance") and os.path.exists(filename):
+        with open(filename) as f:
+            config._hoomd_performance_baseline = json.load(f)
+
+
+class Performance:
+    """Measure the performance of a simulation and compare to the baseline.
+
+    Each measurement records the `hoomd.Simulation.tps` and the time per step
+    spent in each operation reported by `hoomd.Simulation.profile`. The
+    measurement fails the test when the TPS is lower than the baseline, or an
+    operation takes longer than the baseline, by more than the tolerance.
+    Measurements without a baseline always pass.
+
+    The baseline stores one entry for each test and measurement name. Record
+    the baseline on the machine that runs the tests with
+    ``--performance-update-baseline``.
+    """
+
+    def __init__(self, request):
+        self._request = request
+        self._config = request.config
+
+        marker = request.node.get_closest_marker('performance')
+        tolerance = None
+        if marker is not None:
+            tolerance = marker.kwargs.get('tolerance')
+        if tolerance is None:
+            tolerance = self._config.getoption("performance_tolerance")
+        self.tolerance = tolerance
+
+    def measure(self, simulation, steps, warmup=0, name=None):
+        """Run the simulation and compare the performance to the baseline.
+
+        Args:
+            simulation (hoomd.Simulation): Simulation to run.
+            steps (int): Number of steps to measure.
+            warmup (int): Number of steps to run before measuring. The warmup
+                steps allow the autotuners to complete.
+            name (str): Name of the measurement, required when a test makes
+                more than one measurement.
+
+        Returns:
+            dict: The measurement with the keys ``tps`` and ``operations``.
+        """
+        if warmup > 0:
+            simulation.run(warmup)
+
+        profiling = simulation.profiling
+        simulation.profiling = True
+        simulation.run(steps)
+        simulation.profiling = profiling
+
+        result = dict(tps=simulation.tps,
+                      operations={
+                          op: values['total_time'] / steps
+                          for op, values in simulation.profile.items()
+                      })
+
+        key = self._request.node.nodeid
+        if name is not None:
+            key += '::' + name
+
+        # rank 0 reports and stores the measurements of all ranks
+        if simulation.device.communicator.rank == 0:
+            self._config._hoomd_performance_results[key] = result
+
+        baseline = self._config._hoomd_performance_baseline.get(key)
+        if (baseline is not None
+                and not self._config.getoption("performance_update_baseline")):
+            self._compare(result, baseline)
+
+        return result
+
+    def _compare(self, result, baseline):
+        """Fail when the result is slower than the baseline."""
+        slow = []
+        if result['tps'] < baseline['tps'] * (1 - self.tolerance):
+            slow.append(f"TPS {result['tps']:.6g} is below the baseline "
+                        f"{baseline['tps']:.6g}")
+
+        for op, time in baseline['operations'].items():
+            measured = result['operations'].get(op)
+            if measured is not None and measured > time * (1 + self.tolerance):
+                slow.append(f"{op} takes {measured:.6g} s per step, the "
+                            f"baseline is {time:.6g} s")
+
+        if len(slow) > 0:
+            pytest.fail(f"Performance regression (tolerance {self.tolerance}): "
+                        + "; ".join(slow))
+
+
+@pytest.fixture
+def performance(request):
+    """Measure the performance of a simulation.
+
+    See `Performance` for details.
+    """
+    return Performance(request)
+
+
+def pytest_sessionfinish(session):
+    """Store the measurements when requested."""
+    config = session.config
+    results = config._hoomd_performance_results
+    if not config.getoption("performance_update_baseline") or len(
+            results) == 0:
+        return
+
+    baseline = dict(config._hoomd_performance_baseline)
+    baseline.update(results)
+    with open(config.getoption("performance_baseline"), 'w') as f:
+        json.dump(baseline, f, indent=2, sort_keys=True)
+
+
+def pytest_terminal_summary(terminalreporter, config):
+    """Report the measurements."""
+    results = config._hoomd_performance_results
+    if len(results) == 0:
+        return
+
+    baseline = config._hoomd_performance_baseline
+    terminalreporter.section("HOOMD performance")
+    for key, result in sorted(results.items()):
+        line = f"{key}: {result['tps']:.6g} TPS"
+        if key in baseline:
+            line += f" (baseline {baseline[key]['tps']:.6g})"
+        terminalreporter.write_line(line)
@@ -18,6 +18,7 @@
     logger = hoomd.logging.Logger()
 """
 import inspect
+import pickle
 
 import hoomd._hoomd as _hoomd
 from hoomd.logging import log, Loggable
@@ -45,8 +46,8 @@ class Simulation(metaclass=Loggable):
     added to this `Simulation`.
 
     Newly initialized `Simulation` objects have no state. Call
-    `create_state_from_gsd` or `create_state_from_snapshot` to initialize the
-    simulation's `state`.
+    `create_state_from_gsd`, `create_state_from_snapshot`, or
+    `create_state_from_checkpoint` to initialize the simulation's `state`.
 
     .. rubric:: Example:
 
@@ -62,6 +63,7 @@ class Simulation(metaclass=Loggable):
         self._operations._simulation = self
         self._timestep = None
         self._seed = None
+        self._checkpoint_operation_state = None
         if seed is not None:
             self.seed = seed
 
@@ -188,7 +190,9 @@ class Simulation(metaclass=Loggable):
     def create_state_from_gsd(self,
                               filename,
                               frame=-1,
-                              domain_decomposition=(None, None, None)):
+                              domain_decomposition=(None, None, None),
+                              distributed=False,
+                              fields=None):
         """Create the simulation state from a GSD file.
 
         Args:
@@ -205,9 +209,26 @@ class Simulation(metaclass=Loggable):
                 to include in each domain. The sum of each list of floats must
                 be 1.0 (e.g. ``([0.25, 0.75], [0.2, 0.8], [1.0])``).
 
+            distributed (bool): When `True` in MPI simulations, every rank
+                reads a part of the particle data from the file and sends
+                the particles directly to the ranks that own them.
+
+            fields (Sequence[str]): Names of the particle chunks (e.g.
+                ``'particles/position'``) and topology sections (e.g.
+                ``'bonds'``) to read. The other fields keep their default
+                values. Defaults to all fields, see `Snapshot.read_gsd`.
+
         When `timestep` is `None` before calling, `create_state_from_gsd`
         sets `timestep` to the value in the selected GSD frame in the file.
 
+        Note:
+            By default, the root rank reads all particles in the frame and
+            then distributes them to the other ranks. Set
+            ``distributed=True`` to restart systems that are too large to fit
+            in the memory of a single rank. All ranks must be able to read
+            ``filename``. `create_state_from_gsd` ignores ``distributed``
+            when there is only one rank.
+
         Note:
             Set any or all of the ``domain_decomposition`` tuple elements to
             `None` and `create_state_from_gsd` will select a value that
@@ -215,7 +236,8 @@ class Simulation(metaclass=Loggable):
             ``(2,None,None)``). The domains are spaced evenly along each
             automatically selected direction. The default value of ``(None,
             None, None)`` will automatically select the number of domains in all
-            directions.
+            directions and assign a contiguous block of domains to the ranks
+            on each node when every node runs the same number of ranks.
 
         .. rubric:: Example:
 
@@ -226,22 +248,99 @@ class Simulation(metaclass=Loggable):
         if self._state is not None:
             raise RuntimeError("Cannot initialize more than once\n")
         filename = _hoomd.mpi_bcast_str(filename, self.device._cpp_exec_conf)
+        distributed = distributed and self.device.communicator.num_ranks > 1
         # Grab snapshot and timestep
+        fields = [] if fields is None else [str(field) for field in fields]
         reader = _hoomd.GSDReader(self.device._cpp_exec_conf, filename,
-                                  abs(frame), frame < 0)
+                                  abs(frame), frame < 0, distributed, fields)
         snapshot = Snapshot._from_cpp_snapshot(reader.getSnapshot(),
                                                self.device.communicator)
 
         step = reader.getTimeStep() if self.timestep is None else self.timestep
         self._state = State(self, snapshot, domain_decomposition)
 
+        if distributed:
+            reader.readParticlesDistributed(self._state._cpp_sys_def)
+
         reader.clearSnapshot()
 
         self._init_system(step)
 
+    def create_state_from_checkpoint(self, filename):
+        """Create the simulation state from a checkpoint file.
+
+        Args:
+            filename (str): Checkpoint file to read.
+
+        `create_state_from_checkpoint` restores the state written by
+        `hoomd.write.Checkpoint` bit for bit: the particles and bonded groups
+        on every rank, the domain decomposition with the current cut planes,
+        and the timestep. When `seed` is `None` before calling,
+        `create_state_from_checkpoint` sets `seed` to the value in the
+        checkpoint. When `timestep` is `None` before calling,
+        `create_state_from_checkpoint` sets `timestep` to the value in the
+        checkpoint.
+
+        Add the same operations in the same order as in the simulation that
+        wrote the checkpoint. The first call to `run` restores their state
+        (such as thermostat degrees of freedom, HPMC move sizes, and kernel
+        launch parameters).
+
+        Note:
+            Restore the checkpoint with the same number of MPI ranks that
+            wrote it. Each rank reads only its own part of the file.
+
+        .. rubric:: Example:
+
+        .. invisible-code-block: python
+
+            checkpoint_file = path / 'checkpoint.bin'
+            checkpoint = hoomd.write.Checkpoint(
+                trigger=hoomd.trigger.Periodic(1), filename=checkpoint_file)
+            simulation.operations.writers.append(checkpoint)
+            simulation.run(0, write_at_start=True)
+            simulation = hoomd.Simulation(device=hoomd.device.CPU())
+
+        .. code-block:: python
+
+            simulation.create_state_from_checkpoint(filename=checkpoint_file)
+        """
+        if self._state is not None:
+            raise RuntimeError("Cannot initialize more than once\n")
+        filename = _hoomd.mpi_bcast_str(filename, self.device._cpp_exec_conf)
+        reader = _hoomd.CheckpointReader(self.device._cpp_exec_conf, filename)
+        snapshot = Snapshot._from_cpp_snapshot(reader.getSnapshot(),
+                                               self.device.communicator)
+
+        step = reader.getTimeStep() if self.timestep is None else self.timestep
+        if self._seed is None:
+            self._seed = reader.getSeed()
+        self._state = State(self, snapshot, reader.getDomainDecomposition())
+        reader.restore(self._state._cpp_sys_def)
+
+        self._init_system(step)
+        self._checkpoint_operation_state = reader.getOperationState()
+
+    def _get_checkpoint_operation_state(self):
+        """Get the rank local state of the operations as bytes."""
+        return pickle.dumps(
+            [op._get_checkpoint_state() for op in self.operations])
+
+    def _restore_checkpoint_operation_state(self):
+        """Restore the operation state read by create_state_from_checkpoint."""
+        states = pickle.loads(self._checkpoint_operation_state)
+        self._checkpoint_operation_state = None
+
+        operations = list(self.operations)
+        if len(operations) != len(states):
+            raise RuntimeError("The operations do not match the checkpoint.")
+        for op, state in zip(operations, states):
+            op._set_checkpoint_state(state)
+
     def create_state_from_snapshot(self,
                                    snapshot,
-                                   domain_decomposition=(None, None, None)):
+                                   domain_decomposition=(None, None, None),
+                                   replicate=(1, 1, 1)):
         """Create the simulation state from a `Snapshot`.
 
         Args:
@@ -257,9 +356,21 @@ class Simulation(metaclass=Loggable):
                 to include in each domain. The sum of each list of floats must
                 be 1.0 (e.g. ``([0.25, 0.75], [0.2, 0.8], [1.0])``).
 
+            replicate (tuple[int, int, int]): Number of copies of
+                ``snapshot`` along the first, second, and third box vectors.
+
         When `timestep` is `None` before calling, `create_state_from_snapshot`
         sets `timestep` to 0.
 
+        With ``replicate``, `create_state_from_snapshot` creates the same state
+        as `Snapshot.replicate` followed by `create_state_from_snapshot`, but
+        never builds the replicated snapshot. Each rank places the copies of the
+        ``snapshot`` particles and their bonds, angles, dihedrals, impropers,
+        constraints, and pairs that belong to its domain, so the memory and
+        time needed are proportional to :math:`N_{particles} / N_{ranks}`. Use
+        it to initialize systems that are too large to fit in the memory of a
+        single rank.
+
         Note:
             Set any or all of the ``domain_decomposition`` tuple elements to
             `None` and `create_state_from_snapshot` will select a value that
@@ -267,7 +378,8 @@ class Simulation(metaclass=Loggable):
             ``(2,None,None)``). The domains are spaced evenly along each
             automatically selected direction. The default value of ``(None,
             None, None)`` will automatically select the number of domains in all
-            directions.
+            directions and assign a contiguous block of domains to the ranks
+            on each node when every node runs the same number of ranks.
 
         See Also:
             `State.get_snapshot`
@@ -289,22 +401,30 @@ class Simulation(metaclass=Loggable):
 
         if isinstance(snapshot, Snapshot):
             # snapshot is hoomd.Snapshot
-            self._state = State(self, snapshot, domain_decomposition)
+            pass
         elif _match_class_path(snapshot, 'gsd.hoomd.Frame'):
             # snapshot is gsd.hoomd.Frame (gsd 2.8+, 3.x)
             snapshot = Snapshot.from_gsd_frame(snapshot,
                                                self._device.communicator)
-            self._state = State(self, snapshot, domain_decomposition)
         elif _match_class_path(snapshot, 'gsd.hoomd.Snapshot'):
             # snapshot is gsd.hoomd.Snapshot (gsd 2.x)
             snapshot = Snapshot.from_gsd_snapshot(snapshot,
                                                   self._device.communicator)
-            self._state = State(self, snapshot, domain_decomposition)
         else:
             raise TypeError(
                 "Snapshot must be a hoomd.Snapshot, gsd.hoomd.Snapshot, "
                 "or gsd.hoomd.Frame")
 
+        nx, ny, nz = (int(n) for n in replicate)
+        if (nx, ny, nz) == (1, 1, 1):
+            self._state = State(self, snapshot, domain_decomposition)
+        else:
+            # decompose the replicated box, then fill each domain in place
+            self._state = State(self, snapshot._replicated_box(nx, ny, nz),
+                                domain_decomposition)
+            self._state._cpp_sys_def.initializeReplicated(
+                snapshot._cpp_obj, nx, ny, nz)
+
         step = 0
         if self.timestep is not None:
             step = self.timestep
@@ -482,6 +602,342 @@ class Simulation(metaclass=Loggable):
             if value:
                 self._state._cpp_sys_def.getParticleData().setPressureFlag()
 
+    @property
+    def profiling(self):
+        """bool: Time each operation in `run` (defaults to ``False``).
+
+        Set `profiling` to `True` to record the time spent in each operation
+        during `run`. Read the results from `profile`.
+
+        Note:
+            When executing on a GPU, the recorded times measure the time the
+            operation spends executing on the device.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            simulation.profiling = True
+        """
+        if not hasattr(self, '_cpp_sys'):
+            return False
+        else:
+            return self._cpp_sys.getProfilingEnabled()
+
+    @profiling.setter
+    def profiling(self, value):
+        if not hasattr(self, '_cpp_sys'):
+            raise RuntimeError('Cannot set flag without state')
+        else:
+            self._cpp_sys.setProfilingEnabled(value)
+
+    @property
+    def persistent_ghost_updates(self):
+        """bool: Reuse MPI requests for ghost updates (defaults to ``False``).
+
+        When executing with domain decomposition on the CPU, the ghost particle
+        positions (and velocities and orientations when needed) are sent to
+        neighboring ranks every time step. Set `persistent_ghost_updates` to
+        `True` to create persistent MPI requests for these messages after each
+        ghost exchange and reuse them until the next one. This reduces the
+        latency of each message on some MPI implementations and networks.
+
+        `persistent_ghost_updates` has no effect in serial simulations or on
+        the GPU.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            simulation.persistent_ghost_updates = True
+        """
+        if getattr(self, '_system_communicator', None) is None:
+            return False
+        else:
+            return self._system_communicator.getPersistentGhostUpdates()
+
+    @persistent_ghost_updates.setter
+    def persistent_ghost_updates(self, value):
+        if not hasattr(self, '_cpp_sys'):
+            raise RuntimeError('Cannot set flag without state')
+        elif self._system_communicator is not None:
+            self._system_communicator.setPersistentGhostUpdates(value)
+
+    @property
+    def shared_memory_ghost_updates(self):
+        """bool: Update ghosts on the same node in shared memory (defaults to \
+        ``False``).
+
+        Set `shared_memory_ghost_updates` to `True` together with
+        `persistent_ghost_updates` to send the ghost particle updates between
+        ranks on the same node through an MPI shared memory window. Each rank
+        writes the ghosts for its neighbors into the window and the neighbors
+        copy them directly into their particle data. Ghost updates for ranks on
+        other nodes use the persistent MPI requests.
+
+        `shared_memory_ghost_updates` has no effect in serial simulations, on
+        the GPU, or when `persistent_ghost_updates` is `False`.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            simulation.persistent_ghost_updates = True
+            simulation.shared_memory_ghost_updates = True
+        """
+        if getattr(self, '_system_communicator', None) is None:
+            return False
+        else:
+            return self._system_communicator.getSharedMemoryGhostUpdates()
+
+    @shared_memory_ghost_updates.setter
+    def shared_memory_ghost_updates(self, value):
+        if not hasattr(self, '_cpp_sys'):
+            raise RuntimeError('Cannot set flag without state')
+        elif self._system_communicator is not None:
+            self._system_communicator.setSharedMemoryGhostUpdates(value)
+
+    @property
+    def ghost_position_bits(self):
+        """int: Bits per coordinate of the ghost position updates (defaults to \
+        0).
+
+        Between ghost exchanges, ranks send the positions of the ghost
+        particles to their neighbors every time step. Set `ghost_position_bits`
+        to 16 or 32 to send each position as a fixed point offset from the
+        position sent in the last ghost exchange. This reduces the size of the
+        messages by a factor of up to 5 (16 bits) or 2.6 (32 bits) in double
+        precision builds. The ghost positions are then accurate to the largest
+        offset in each message divided by :math:`2^{15}` (16 bits) or
+        :math:`2^{31}` (32 bits). Set `ghost_position_bits` to 0 to send the
+        full positions.
+
+        `ghost_position_bits` has no effect in serial simulations, on the GPU,
+        or when `persistent_ghost_updates` is `True`.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            simulation.ghost_position_bits = 32
+        """
+        if getattr(self, '_system_communicator', None) is None:
+            return 0
+        else:
+            return self._system_communicator.getGhostPositionBits()
+
+    @ghost_position_bits.setter
+    def ghost_position_bits(self, value):
+        if not hasattr(self, '_cpp_sys'):
+            raise RuntimeError('Cannot set flag without state')
+        elif self._system_communicator is not None:
+            self._system_communicator.setGhostPositionBits(value)
+
+    @property
+    def skip_unchanged_ghost_fields(self):
+        """bool: Send only the ghost fields that changed (defaults to \
+        ``False``).
+
+        Between ghost exchanges, ranks send the positions of the ghost
+        particles to their neighbors every time step, and the velocities and
+        orientations when an operation needs them. Set
+        `skip_unchanged_ghost_fields` to `True` to send the velocities and
+        orientations only on steps where some rank modified them since the
+        ghosts last received them, for example when particles with
+        anisotropic interactions do not rotate. The ranks agree on the fields
+        to send with one collective reduction per ghost update.
+
+        `skip_unchanged_ghost_fields` has no effect in serial simulations, on
+        the GPU, or when `persistent_ghost_updates` is `True`.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            simulation.skip_unchanged_ghost_fields = True
+        """
+        if getattr(self, '_system_communicator', None) is None:
+            return False
+        else:
+            return self._system_communicator.getSkipUnchangedGhostFields()
+
+    @skip_unchanged_ghost_fields.setter
+    def skip_unchanged_ghost_fields(self, value):
+        if not hasattr(self, '_cpp_sys'):
+            raise RuntimeError('Cannot set flag without state')
+        elif self._system_communicator is not None:
+            self._system_communicator.setSkipUnchangedGhostFields(value)
+
+    @property
+    def overlap_ghost_updates(self):
+        """bool: Compute pair forces while the ghosts update (defaults to \
+        ``True``).
+
+        When executing with domain decomposition on the CPU, the integrator
+        starts the ghost position update and the pair potentials compute the
+        forces on the particles with no ghost neighbors while the messages are
+        in flight. The pair potentials then wait for the update and compute
+        the forces on the remaining particles. Set `overlap_ghost_updates` to
+        `False` to complete the ghost update before computing any forces.
+
+        `overlap_ghost_updates` has no effect in serial simulations or on the
+        GPU.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            simulation.overlap_ghost_updates = False
+        """
+        if getattr(self, '_system_communicator', None) is None:
+            return True
+        else:
+            return self._system_communicator.getOverlapGhostUpdates()
+
+    @overlap_ghost_updates.setter
+    def overlap_ghost_updates(self, value):
+        if not hasattr(self, '_cpp_sys'):
+            raise RuntimeError('Cannot set flag without state')
+        elif self._system_communicator is not None:
+            self._system_communicator.setOverlapGhostUpdates(value)
+
+    @property
+    def migration_margin(self):
+        """float: Ghost layer margin that defers migration (defaults to 0) \
+        :math:`[\\mathrm{length}]`.
+
+        With domain decomposition, particles migrate to the rank of the domain
+        that contains them every time the neighbor list is rebuilt. Set
+        `migration_margin` to a positive value to extend the ghost layer by
+        `migration_margin` and skip the migrations while no particle has moved
+        farther than ``migration_margin / 2`` since the last migration. This
+        trades memory and ghost communication for fewer migrations in slowly
+        diffusing systems.
+
+        `migration_margin` has no effect in serial simulations.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            simulation.migration_margin = 0.5
+        """
+        if getattr(self, '_system_communicator', None) is None:
+            return 0.0
+        else:
+            return self._system_communicator.getMigrationMargin()
+
+    @migration_margin.setter
+    def migration_margin(self, value):
+        if not hasattr(self, '_cpp_sys'):
+            raise RuntimeError('Cannot set migration margin without state')
+        elif self._system_communicator is not None:
+            self._system_communicator.setMigrationMargin(float(value))
+
+    @log(category='object', requires_run=True)
+    def profile(self):
+        """dict: The time spent in each operation during the last `run`.
+
+        `profile` maps the name of each timed operation to a dictionary with
+        the keys:
+
+        * ``total_time`` (`float`): Total time spent in the operation
+          :math:`[\\mathrm{s}]`.
+        * ``count`` (`int`): Number of times the operation executed.
+        * ``histogram`` (`list` [`int`]): Histogram of the time per call. Bin
+          :math:`k` counts calls that take :math:`[2^{k-1}, 2^k)` microseconds
+          and bin 0 counts calls that take less than a microsecond.
+
+        The time of each operation includes the time of the operations it
+        calls (for example, the integrator includes the force computes). The
+        values are local to each MPI rank.
+
+        Note:
+            `profile` resets at the beginning of each call to `run` and is
+            empty unless `profiling` is `True`.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            simulation.profiling = True
+            simulation.run(100)
+            profile = simulation.profile
+        """
+        return self._cpp_sys.getProfile()
+
+    @log(category='object')
+    def memory_usage(self):
+        """list[dict]: The memory held by each array.
+
+        `memory_usage` lists the live array allocations grouped by their tag,
+        owner, and element type. Each entry is a dictionary with the keys:
+
+        * ``tag`` (`str`): Name of the array, or ``''`` when the array has no
+          tag.
+        * ``owner`` (`str`): C++ class that holds the array, or ``''`` when
+          unknown.
+        * ``type`` (`str`): C++ type of the array elements.
+        * ``allocations`` (`int`): Number of allocations in the group.
+        * ``host_bytes`` (`int`): Bytes held in host memory.
+        * ``device_bytes`` (`int`): Bytes held in GPU device memory.
+        * ``managed_bytes`` (`int`): Bytes held in managed memory.
+
+        The values are local to each MPI rank and include all arrays in the
+        process.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            largest = max(simulation.memory_usage,
+                          key=lambda entry: entry['device_bytes'])
+        """
+        return self._device._cpp_exec_conf.getMemoryUsage()
+
+    @log(category='sequence')
+    def memory_bytes(self):
+        """tuple[int, int, int]: Bytes held by all arrays.
+
+        `memory_bytes` is the total number of bytes held by the live arrays in
+        host, device, and managed memory: ``(host, device, managed)``. The
+        values are local to each MPI rank.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            logger.add(obj=simulation, quantities=['memory_bytes'])
+        """
+        return self._device._cpp_exec_conf.getMemoryBytes()
+
+    @log(category='sequence')
+    def peak_memory_bytes(self):
+        """tuple[int, int, int]: Largest `memory_bytes` held at one time.
+
+        `peak_memory_bytes` includes every allocation, not only those present
+        when the value is logged. Call `reset_peak_memory_bytes` to restart the
+        peak from the current `memory_bytes`.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            logger.add(obj=simulation, quantities=['peak_memory_bytes'])
+        """
+        return self._device._cpp_exec_conf.getPeakMemoryBytes()
+
+    def reset_peak_memory_bytes(self):
+        """Restart `peak_memory_bytes` from the current `memory_bytes`.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            simulation.reset_peak_memory_bytes()
+        """
+        self._device._cpp_exec_conf.resetPeakMemoryBytes()
+
     def run(self, steps, write_at_start=False):
         """Advance the simulation a number of steps.
 
@@ -553,6 +1009,8 @@ class Simulation(metaclass=Loggable):
                 "Cannot call run inside of a local snapshot context manager.")
         if not self.operations._scheduled:
             self.operations._schedule()
+        if self._checkpoint_operation_state is not None:
+            self._restore_checkpoint_operation_state()
 
         steps_int = int(steps)
         if steps_int < 0 or steps_int > TIMESTEP_MAX - 1:
@@ -9,10 +9,15 @@
     simulation = hoomd.util.make_example_simulation()
 
     snapshot = simulation.state.get_snapshot()
+    gsd_filename = tmp_path / 'file.gsd'
+    hoomd.write.GSD.write(state=simulation.state,
+                          filename=gsd_filename,
+                          filter=hoomd.filter.All())
 """
 
 import hoomd
 from hoomd import _hoomd
+import numpy
 import warnings
 
 
@@ -461,6 +466,22 @@ class Snapshot:
     def _broadcast_box(self):
         self._cpp_obj._broadcast_box(self.communicator.cpp_mpi_conf)
 
+    def _replicated_box(self, nx, ny, nz):
+        """Make a snapshot with the replicated box and types, no particles."""
+        snapshot = Snapshot(self.communicator)
+        if self.communicator.rank == 0:
+            box = self.configuration.box
+            snapshot.configuration.box = [
+                box[0] * nx, box[1] * ny, box[2] * nz, box[3], box[4], box[5]
+            ]
+            snapshot.particles.types = self.particles.types
+            snapshot.bonds.types = self.bonds.types
+            snapshot.angles.types = self.angles.types
+            snapshot.dihedrals.types = self.dihedrals.types
+            snapshot.impropers.types = self.impropers.types
+            snapshot.pairs.types = self.pairs.types
+        return snapshot
+
     @classmethod
     def from_gsd_frame(cls, gsd_snap, communicator):
         """Constructs a `hoomd.Snapshot` from a `gsd.hoomd.Frame` object.
@@ -523,6 +544,66 @@ class Snapshot:
         snap._broadcast_box()
         return snap
 
+    @classmethod
+    def read_gsd(cls, filename, device, frames=None, fields=None):
+        """Read frames from a GSD file.
+
+        Args:
+            filename (str): GSD file to read.
+            device (hoomd.device.Device): Device that reads the file.
+            frames (slice or Sequence[int]): Indices of the frames to read.
+                Negative values index back from the last frame in the file.
+                Defaults to all frames.
+            fields (Sequence[str]): Names of the particle chunks (e.g.
+                ``'particles/position'``) and topology sections (e.g.
+                ``'bonds'``) to read. ``'particles'`` selects all particle
+                chunks. Defaults to all fields.
+
+        `read_gsd` yields a ``(step, snapshot)`` tuple for each selected frame.
+        The configuration (box and dimensions), the number of particles, and
+        the particle types are always read. The fields that `read_gsd` does
+        not read keep their default values. Use *fields* to read only the
+        data that an analysis needs and *frames* to decimate the trajectory
+        (e.g. ``frames=slice(None, None, 10)``). `read_gsd` keeps the file
+        open and reads only the chunks of the selected frames.
+
+        Note:
+            In MPI simulations, the root rank reads the file and the snapshots
+            hold the data only on the root rank.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            for step, snapshot in hoomd.Snapshot.read_gsd(
+                    filename=gsd_filename,
+                    device=simulation.device,
+                    fields=['particles/position']):
+                pass
+        """
+        filename = _hoomd.mpi_bcast_str(str(filename), device._cpp_exec_conf)
+        fields = [] if fields is None else [str(field) for field in fields]
+        reader = _hoomd.GSDReader(device._cpp_exec_conf, filename, 0, False,
+                                  False, fields)
+        n_frames = reader.getNFrames()
+
+        if frames is None:
+            frames = range(n_frames)
+        elif isinstance(frames, slice):
+            frames = range(*frames.indices(n_frames))
+
+        for frame in frames:
+            frame = int(frame)
+            if frame < 0:
+                frame += n_frames
+            if frame < 0:
+                raise IndexError(f"Cannot read frame {frame - n_frames}.")
+            reader.readFrame(frame)
+            snapshot = cls._from_cpp_snapshot(reader.getSnapshot(),
+                                              device.communicator)
+            snapshot._broadcast_box()
+            yield reader.getTimeStep(), snapshot
+
     @classmethod
     def from_gsd_snapshot(cls, gsd_snap, communicator):
         """Constructs a `hoomd.Snapshot` from a ``gsd.hoomd.Snapshot`` object.
@@ -534,3 +615,96 @@ class Snapshot:
         warnings.warn("gsd.hoomd.Snapshot is deprecated, use gsd.hoomd.Frame",
                       FutureWarning)
         return cls.from_gsd_frame(gsd_snap, communicator)
+
+
+class DistributedSnapshot:
+    """Copy of the particles in the simulation `State`, split over the ranks.
+
+    `State.get_snapshot` gathers every particle on the root rank. In large MPI
+    simulations, the root rank may not have the memory to hold them all.
+    `DistributedSnapshot` instead splits the particles in tag order into
+    contiguous slices, one per rank, so that each rank holds only about
+    :math:`N_{particles} / N_{ranks}` particles:
+
+    * The particles on each rank are sorted by tag.
+    * The slices are in rank order: the slice on rank :math:`r` starts at
+      index `offset` of the tag-ordered list of all particles.
+
+    Use `reduce` to combine values computed from the local slices. Use
+    `offset` to write each slice to its rows of a shared file, or write each
+    slice to its own file. Neither requires a global gather.
+
+    `DistributedSnapshot` holds only the particle data. See `State.get_snapshot`
+    for the bonds, angles, and other topology.
+
+    See Also:
+        `State.get_distributed_snapshot`
+
+        `State.set_distributed_snapshot`
+
+    .. rubric:: Example:
+
+    .. code-block:: python
+
+        distributed_snapshot = simulation.state.get_distributed_snapshot()
+
+    Attributes:
+        communicator (Communicator): MPI communicator.
+
+        box (Box): Copy of the simulation box.
+
+        N (int): Number of particles on all ranks.
+
+        offset (int): Index of the first local particle in the tag-ordered list
+            of all particles.
+    """
+
+    def __init__(self, cpp_obj, offset, N, box, communicator):
+        self._cpp_obj = cpp_obj
+        self.offset = offset
+        self.N = N
+        self.box = box
+        self.communicator = communicator
+
+    @property
+    def particles(self):
+        """Particles on this rank.
+
+        ``particles`` has the same attributes as `Snapshot.particles`. The
+        arrays hold the particles on this rank, and ``particles.N`` is the
+        number of particles on this rank. Data is present on all ranks.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            local_position = distributed_snapshot.particles.position
+        """
+        return self._cpp_obj
+
+    def reduce(self, values, op='sum'):
+        """Reduce values element-wise over all ranks.
+
+        Args:
+            values (float or (...) `numpy.ndarray` of `float`): Values computed
+                on this rank. Provide values of the same shape on all ranks.
+            op (str): Reduction operation: ``'sum'``, ``'min'``, or ``'max'``.
+
+        Returns:
+            `numpy.ndarray` of `float`: The reduced values, on all ranks.
+
+        Note:
+            Call `reduce` on all ranks.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            particles = distributed_snapshot.particles
+            total_mass = distributed_snapshot.reduce(particles.mass.sum())
+            max_speed = distributed_snapshot.reduce(
+                numpy.linalg.norm(particles.velocity, axis=1).max(initial=0),
+                op='max')
+        """
+        values = numpy.asarray(values, dtype=numpy.float64)
+        return self.communicator.cpp_mpi_conf.allReduce(values, op)
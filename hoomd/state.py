@@ -15,7 +15,7 @@ from collections import defaultdict
 
 from . import _hoomd
 from hoomd.box import Box
-from hoomd.snapshot import Snapshot
+from hoomd.snapshot import Snapshot, DistributedSnapshot
 from hoomd.data import LocalSnapshot, LocalSnapshotGPU
 import hoomd
 import math
@@ -69,7 +69,7 @@ def _create_domain_decomposition(device, box, domain_decomposition):
     else:
         grid = [v if v is not None else 0 for v in domain_decomposition]
         result = _hoomd.DomainDecomposition(device._cpp_exec_conf, box.getL(),
-                                            *grid, False)
+                                            *grid, True)
 
     return result
 
@@ -273,6 +273,10 @@ class State:
         # implemented __hash__ and __eq__ from causing cache errors.
         self._groups = defaultdict(dict)
 
+        # self._cell_lists shares C++ cell lists between operations of the
+        # form: {key: [C++ cell list, number of operations using it]}
+        self._cell_lists = {}
+
     def get_snapshot(self):
         """Make a copy of the simulation current state.
 
@@ -361,6 +365,146 @@ class State:
         self._cpp_sys_def.initializeFromSnapshot(snapshot._cpp_obj)
         self.update_group_dof()
 
+    def get_distributed_snapshot(self):
+        """Make a copy of the particles, split over the MPI ranks.
+
+        Unlike `get_snapshot`, `get_distributed_snapshot` never gathers the
+        particles on one rank. Each rank sends its particles directly to the
+        rank that holds their slice of the tag order, so that the memory needed
+        on each rank is proportional to :math:`N_{particles} / N_{ranks}`.
+        Without MPI, the snapshot holds all particles.
+
+        Note:
+            Call `get_distributed_snapshot` on all ranks.
+
+        See Also:
+            `set_distributed_snapshot`
+
+        Returns:
+            DistributedSnapshot: The current particles.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            distributed_snapshot = simulation.state.get_distributed_snapshot()
+        """
+        particle_data = self._cpp_sys_def.getParticleData()
+        cpp_snapshot, offset = particle_data.takeDistributedSnapshot_double()
+        return DistributedSnapshot(cpp_snapshot, offset,
+                                   particle_data.getNGlobal(), self.box,
+                                   self._simulation.device.communicator)
+
+    def set_distributed_snapshot(self, snapshot):
+        """Restore the particles from a distributed snapshot.
+
+        Each rank sends the particles in its slice directly to the rank whose
+        domain holds them. No rank holds all particles. The particles in the
+        slices take the tags ``offset + index`` in rank order, where
+        ``offset`` is the total number of particles in the slices on the lower
+        ranks, so a slice may change its number of particles. Also calls
+        `update_group_dof`.
+
+        Args:
+            snapshot (DistributedSnapshot): Particles from
+              `get_distributed_snapshot`.
+
+        Warning:
+            `set_distributed_snapshot` replaces only the particles. It keeps
+            the box and the bonds, angles, and other topology of the current
+            state, which refer to particles by tag. Change the number of
+            particles only in systems without topology.
+
+        Note:
+            Call `set_distributed_snapshot` on all ranks.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            simulation.state.set_distributed_snapshot(distributed_snapshot)
+        """
+        if self._in_context_manager:
+            raise RuntimeError(
+                "Cannot set state to new snapshot inside local snapshot.")
+        if snapshot.particles.types != self.particle_types:
+            raise RuntimeError("Particle types must remain the same")
+
+        particle_data = self._cpp_sys_def.getParticleData()
+        particle_data.initializeFromDistributedSnapshot(snapshot._cpp_obj)
+        self.update_group_dof()
+
+    def update_particles(self,
+                         tags,
+                         typeid=None,
+                         charge=None,
+                         mass=None,
+                         diameter=None,
+                         velocity=None,
+                         orientation=None,
+                         angmom=None,
+                         moment_inertia=None):
+        """Change the properties of some particles in place.
+
+        Args:
+            tags ((*N*,) `numpy.ndarray` of ``uint32``): Tags of the particles
+              to change.
+            typeid ((*N*,) `numpy.ndarray` of ``uint32``): New type ids.
+            charge ((*N*,) `numpy.ndarray` of ``float``): New charges
+              :math:`[\\mathrm{charge}]`.
+            mass ((*N*,) `numpy.ndarray` of ``float``): New masses
+              :math:`[\\mathrm{mass}]`.
+            diameter ((*N*,) `numpy.ndarray` of ``float``): New diameters
+              :math:`[\\mathrm{length}]`.
+            velocity ((*N*, 3) `numpy.ndarray` of ``float``): New velocities
+              :math:`[\\mathrm{velocity}]`.
+            orientation ((*N*, 4) `numpy.ndarray` of ``float``): New
+              orientations :math:`[\\mathrm{dimensionless}]`.
+            angmom ((*N*, 4) `numpy.ndarray` of ``float``): New angular momenta
+              :math:`[\\mathrm{mass} \\cdot \\mathrm{length}^2 /
+              \\mathrm{time}]`.
+            moment_inertia ((*N*, 3) `numpy.ndarray` of ``float``): New
+              moments of inertia :math:`[\\mathrm{mass} \\cdot
+              \\mathrm{length}^2]`.
+
+        `update_particles` sets the given properties of the particles with
+        the given tags and leaves all other particles and properties unchanged.
+        Each rank changes the particles it owns in place. Unlike `set_snapshot`,
+        `update_particles` does not gather or redistribute the particles and
+        does not reallocate the particle arrays, so its cost is proportional
+        to the number of changed particles. Changes to ``typeid``, ``charge``,
+        or ``diameter`` cause a new neighbor list build and ghost exchange at
+        the next step, like a particle sort. Groups that select particles by
+        type update the membership of the retyped particles only. Also calls
+        `update_group_dof`.
+
+        Note:
+            Call `update_particles` with the same arguments on all ranks.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            simulation.state.update_particles(tags=[0, 1], typeid=[0, 0])
+        """
+        if self._in_context_manager:
+            raise RuntimeError("Cannot update particles inside local snapshot.")
+
+        particle_data = self._cpp_sys_def.getParticleData()
+        quantities = dict(typeid=typeid,
+                          charge=charge,
+                          mass=mass,
+                          diameter=diameter,
+                          velocity=velocity,
+                          orientation=orientation,
+                          angmom=angmom,
+                          moment_inertia=moment_inertia)
+        for name, values in quantities.items():
+            if values is not None:
+                particle_data.updateParticles(name, tags, values)
+
+        self.update_group_dof()
+
     @property
     def particle_types(self):
         """list[str]: List of all particle types in the simulation state.
@@ -598,15 +742,21 @@ class State:
         second, and third box lattice vectors respectively and adjusts the
         particle positions to center them in the new box.
 
+        Only the current state is gathered on the root rank. Each rank places
+        the copies that belong to its domain.
+
         .. rubric:: Example:
 
         .. code-block:: python
 
             simulation.state.replicate(nx=2, ny=2, nz=2)
         """
+        if self._in_context_manager:
+            raise RuntimeError(
+                "Cannot replicate the state inside local snapshot.")
         snap = self.get_snapshot()
-        snap.replicate(nx, ny, nz)
-        self.set_snapshot(snap)
+        self._cpp_sys_def.initializeReplicated(snap._cpp_obj, nx, ny, nz)
+        self.update_group_dof()
 
     def _get_group(self, filter_):
         cls = filter_.__class__
@@ -629,6 +779,30 @@ class State:
 
             return group
 
+    def _get_cell_list(self, key, factory):
+        """Get the cell list shared by the operations that use ``key``.
+
+        The operations that share a key must configure the cell list in the
+        same way. The first call for a key creates the cell list with
+        ``factory(self._cpp_sys_def)``. Every call must be matched by a call to
+        `_release_cell_list` when the operation detaches.
+        """
+        if key not in self._cell_lists:
+            self._cell_lists[key] = [factory(self._cpp_sys_def), 0]
+        entry = self._cell_lists[key]
+        entry[1] += 1
+        return entry[0]
+
+    def _release_cell_list(self, key):
+        """Stop using the cell list shared by the operations that use ``key``.
+
+        The cache drops the cell list when no operation uses it.
+        """
+        entry = self._cell_lists[key]
+        entry[1] -= 1
+        if entry[1] == 0:
+            del self._cell_lists[key]
+
     def update_group_dof(self):
         """Schedule an update to the number of degrees of freedom in each group.
 
@@ -641,7 +815,7 @@ class State:
 
         * An Integrator is assigned to the `Simulation`'s operations.
         * The `hoomd.md.Integrator.integrate_rotational_dof` parameter is set.
-        * `set_snapshot` is called.
+        * `set_snapshot` or `update_particles` is called.
         * On timesteps where a `hoomd.update.FilterUpdater` triggers.
 
         Call `update_group_dof` manually to force an update, such as when
@@ -829,6 +1003,38 @@ class State:
                 dir)) - 1 for dir in range(3)
         ])
 
+    @property
+    def memory_shrink_fraction(self):
+        """float: Fraction of the allocated memory below which the per-particle \
+        and per-group arrays shrink.
+
+        HOOMD-blue grows the arrays that hold the local particles, ghost
+        particles, bonded groups, communication buffers, and neighbor list
+        when they need more room, but by default it never releases that memory.
+        When `memory_shrink_fraction` is larger than 0, HOOMD-blue reallocates
+        an array with room for 9/8 times its current contents when those
+        contents fill less than `memory_shrink_fraction` of the array. The
+        particle, group, and communication arrays are checked after each
+        particle migration and the neighbor list is checked on each build. Set
+        `memory_shrink_fraction` to a value well below 8/9 so that arrays do
+        not shrink and grow again on consecutive steps. When particles
+        concentrate in a few domains, shrinking releases the memory of the
+        emptied domains.
+
+        Set `memory_shrink_fraction` to 0 (the default) to disable shrinking.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            simulation.state.memory_shrink_fraction = 0.5
+        """
+        return self._cpp_sys_def.getParticleData().getShrinkFraction()
+
+    @memory_shrink_fraction.setter
+    def memory_shrink_fraction(self, value):
+        self._cpp_sys_def.getParticleData().setShrinkFraction(float(value))
+
     @property
     def _simulation(self):
         sim = self._simulation_
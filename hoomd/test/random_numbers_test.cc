@@ -527,6 +527,104 @@ UP_TEST(rng_seeding)
     UP_ASSERT_EQUAL(g.getCounter()[3], 0x9876);
     }
 
+//! Test that RandomGeneratorBatch reproduces the streams of RandomGenerator
+UP_TEST(rng_batch)
+    {
+    auto s = hoomd::Seed(hoomd::RNGIdentifier::EvaluatorPairDPDThermo, 0xabcdef1234567890, 0x5eed);
+    const unsigned int batch_size = 8;
+
+    hoomd::RandomGeneratorBatch<batch_size> batch(s);
+    for (unsigned int k = 0; k < batch_size; k++)
+        batch.setCounter(k, hoomd::Counter(k * 0x1234, 0xffffffff - k, k));
+
+    for (unsigned int step = 0; step < 3; step++)
+        {
+        uint32_t u[4][batch_size];
+        batch(u);
+
+        for (unsigned int k = 0; k < batch_size; k++)
+            {
+            hoomd::RandomGenerator g(s, hoomd::Counter(k * 0x1234, 0xffffffff - k, k));
+            r123::Philox4x32::ctr_type v;
+            for (unsigned int n = 0; n <= step; n++)
+                v = g();
+
+            for (unsigned int w = 0; w < 4; w++)
+                UP_ASSERT_EQUAL(u[w][k], v[w]);
+            }
+        }
+
+    // distributions draw the same values from a batch and from the individual streams
+    hoomd::RandomGeneratorBatch<batch_size> uniform_batch(s);
+    for (unsigned int k = 0; k < batch_size; k++)
+        uniform_batch.setCounter(k, hoomd::Counter(k, 2 * k));
+
+    double values[batch_size];
+    hoomd::UniformDistribution<double>(-1, 1)(uniform_batch, values);
+
+    for (unsigned int k = 0; k < batch_size; k++)
+        {
+        hoomd::RandomGenerator g(s, hoomd::Counter(k, 2 * k));
+        UP_ASSERT_EQUAL(values[k], hoomd::UniformDistribution<double>(-1, 1)(g));
+        }
+
+    hoomd::RandomGeneratorBatch<batch_size> normal_batch(s);
+    for (unsigned int k = 0; k < batch_size; k++)
+        normal_batch.setCounter(k, hoomd::Counter(k, 2 * k));
+
+    hoomd::NormalDistribution<double>(2.0, 1.0)(normal_batch, values);
+
+    for (unsigned int k = 0; k < batch_size; k++)
+        {
+        hoomd::RandomGenerator g(s, hoomd::Counter(k, 2 * k));
+        UP_ASSERT_EQUAL(values[k], hoomd::NormalDistribution<double>(2.0, 1.0)(g));
+        }
+    }
+
+//! Test that the streams of RandomBatchDraws replay the streams of RandomGenerator
+UP_TEST(rng_batch_draws)
+    {
+    auto s = hoomd::Seed(hoomd::RNGIdentifier::TwoStepLangevin, 0x1234, 0x5eed);
+    const unsigned int batch_size = 4;
+
+    hoomd::RandomGeneratorBatch<batch_size> batch(s);
+    for (unsigned int k = 0; k < batch_size; k++)
+        batch.setCounter(k, hoomd::Counter(100 + k));
+
+    hoomd::RandomBatchDraws<batch_size, 4> draws;
+    draws.generate(batch, 3);
+
+    for (unsigned int k = 0; k < batch_size; k++)
+        {
+        auto stream = draws.getStream(k);
+        hoomd::RandomGenerator g(s, hoomd::Counter(100 + k));
+
+        // the 4th and later values are computed one at a time
+        for (unsigned int n = 0; n < 6; n++)
+            {
+            auto u = stream();
+            auto v = g();
+            for (unsigned int w = 0; w < 4; w++)
+                UP_ASSERT_EQUAL(u[w], v[w]);
+            }
+        }
+
+    // generate() advances the batch
+    draws.generate(batch, 1);
+    for (unsigned int k = 0; k < batch_size; k++)
+        {
+        auto stream = draws.getStream(k);
+        hoomd::RandomGenerator g(s, hoomd::Counter(100 + k));
+        for (unsigned int n = 0; n < 3; n++)
+            g();
+
+        UP_ASSERT_EQUAL(hoomd::UniformDistribution<double>()(stream),
+                        hoomd::UniformDistribution<double>()(g));
+        UP_ASSERT_EQUAL(hoomd::NormalDistribution<double>()(stream),
+                        hoomd::NormalDistribution<double>()(g));
+        }
+    }
+
 // //! Find performance crossover
 // /*! Note: this code was written for a one time use to find the empirical crossover. It requires
 // that the private:
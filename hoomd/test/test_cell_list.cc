@@ -583,3 +583,83 @@ UP_TEST(CellListGPU_large)
         new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
 #endif
+
+//! Test that CellList groups the members of each cell by type
+UP_TEST(CellList_sort_by_type)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    unsigned int N = 1000;
+    unsigned int n_types = 4;
+    std::shared_ptr<SystemDefinition> sysdef(
+        new SystemDefinition(N, BoxDim(10.0), n_types, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    // place the particles on a lattice with the types interleaved
+    for (unsigned int p = 0; p < N; p++)
+        {
+        pdata->setPosition(p,
+                           make_scalar3(Scalar(p % 10) - 4.5,
+                                        Scalar((p / 10) % 10) - 4.5,
+                                        Scalar(p / 100) - 4.5));
+        pdata->setType(p, (p * 7) % n_types);
+        }
+
+    std::shared_ptr<CellList> cl(new CellList(sysdef));
+    cl->setNominalWidth(Scalar(2.5));
+    cl->setFlagIndex();
+    cl->setComputeTypeBody(true);
+    cl->setSortByType(true);
+    cl->compute(0);
+
+    UP_ASSERT_EQUAL(cl->getNmax() % CellList::cell_padding, 0);
+
+    ArrayHandle<unsigned int> h_cell_size(cl->getCellSizeArray(),
+                                          access_location::host,
+                                          access_mode::read);
+    ArrayHandle<Scalar4> h_xyzf(cl->getXYZFArray(), access_location::host, access_mode::read);
+    ArrayHandle<uint2> h_type_body(cl->getTypeBodyArray(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<unsigned int> h_idx(cl->getIndexArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_type_offsets(cl->getTypeOffsetArray(),
+                                             access_location::host,
+                                             access_mode::read);
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+    Index2D cli = cl->getCellListIndexer();
+    Index2D cti = cl->getTypeOffsetIndexer();
+
+    vector<bool> present(N, false);
+    for (unsigned int cell = 0; cell < cl->getCellIndexer().getNumElements(); cell++)
+        {
+        unsigned int size = h_cell_size.data[cell];
+        UP_ASSERT_EQUAL(h_type_offsets.data[cti(0, cell)], 0);
+        UP_ASSERT_EQUAL(h_type_offsets.data[cti(n_types, cell)], size);
+
+        for (unsigned int type = 0; type < n_types; type++)
+            {
+            unsigned int begin = h_type_offsets.data[cti(type, cell)];
+            unsigned int end = h_type_offsets.data[cti(type + 1, cell)];
+            UP_ASSERT(begin <= end);
+
+            for (unsigned int offset = begin; offset < end; offset++)
+                {
+                // all arrays are permuted together
+                unsigned int p = __scalar_as_int(h_xyzf.data[cli(offset, cell)].w);
+                UP_ASSERT_EQUAL(h_idx.data[cli(offset, cell)], p);
+                UP_ASSERT_EQUAL(h_type_body.data[cli(offset, cell)].x, type);
+                UP_ASSERT_EQUAL(__scalar_as_int(h_pos.data[p].w), type);
+                MY_CHECK_CLOSE(h_xyzf.data[cli(offset, cell)].x, h_pos.data[p].x, tol);
+                present[p] = true;
+                }
+            }
+
+        // the padding entries have NaN coordinates
+        for (unsigned int offset = size; offset % CellList::cell_padding != 0; offset++)
+            UP_ASSERT(std::isnan(h_xyzf.data[cli(offset, cell)].x));
+        }
+
+    for (unsigned int p = 0; p < N; p++)
+        UP_ASSERT(present[p]);
+    }
@@ -10,6 +10,7 @@
 
 #include "hoomd/GPUVector.h"
 #include "hoomd/GlobalArray.h"
+#include "hoomd/MemoryTracker.h"
 
 #ifdef ENABLE_HIP
 #include "test_global_array.cuh"
@@ -286,6 +287,61 @@ UP_TEST(GlobalArray_resize_tests)
         }
     }
 
+//! Find the memory tracker entry of a tag
+static detail::MemoryTracker::Usage findUsage(const std::string& tag)
+    {
+    for (const auto& usage : detail::MemoryTracker::getUsage())
+        {
+        if (usage.tag == tag)
+            return usage;
+        }
+    return detail::MemoryTracker::Usage();
+    }
+
+//! Tests that the memory tracker accounts for the array allocations
+UP_TEST(GlobalArray_memory_tracking_tests)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    const size_t host_bytes = detail::MemoryTracker::getBytes(detail::MemoryTracker::host);
+
+        {
+        GlobalArray<unsigned int> a(100, exec_conf);
+        UP_ASSERT_EQUAL(detail::MemoryTracker::getBytes(detail::MemoryTracker::host),
+                        host_bytes + 100 * sizeof(unsigned int));
+
+        // tagged allocations are reported with their owner and type
+        a.setTag("tracked_array", "owner");
+        detail::MemoryTracker::Usage usage = findUsage("tracked_array");
+        UP_ASSERT_EQUAL(usage.owner, std::string("owner"));
+        UP_ASSERT_EQUAL(usage.type, std::string("unsigned int"));
+        UP_ASSERT_EQUAL(usage.n_allocations, (size_t)1);
+        UP_ASSERT_EQUAL(usage.bytes[detail::MemoryTracker::host], 100 * sizeof(unsigned int));
+        UP_ASSERT_EQUAL(usage.bytes[detail::MemoryTracker::device], (size_t)0);
+
+        // the tag is kept when the array is resized
+        a.resize(200);
+        usage = findUsage("tracked_array");
+        UP_ASSERT_EQUAL(usage.n_allocations, (size_t)1);
+        UP_ASSERT_EQUAL(usage.bytes[detail::MemoryTracker::host], 200 * sizeof(unsigned int));
+        UP_ASSERT(detail::MemoryTracker::getPeakBytes(detail::MemoryTracker::host)
+                  >= host_bytes + 200 * sizeof(unsigned int));
+
+        // and it follows the data when arrays are swapped
+        GlobalArray<unsigned int> b(10, exec_conf);
+        b.swap(a);
+        usage = findUsage("tracked_array");
+        UP_ASSERT_EQUAL(usage.bytes[detail::MemoryTracker::host], 200 * sizeof(unsigned int));
+        }
+
+    // freed allocations are no longer reported
+    UP_ASSERT_EQUAL(detail::MemoryTracker::getBytes(detail::MemoryTracker::host), host_bytes);
+    UP_ASSERT_EQUAL(findUsage("tracked_array").n_allocations, (size_t)0);
+
+    detail::MemoryTracker::resetPeakBytes();
+    UP_ASSERT_EQUAL(detail::MemoryTracker::getPeakBytes(detail::MemoryTracker::host), host_bytes);
+    }
+
 //! Tests GPUVector
 UP_TEST(GPUVector_basic_tests)
     {
@@ -0,0 +1,147 @@
+// Copyright (c) 2009-2024 The Regents of the University of Michigan.
+// Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+#include "hoomd/MemoryPool.h"
+
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <stdlib.h>
+
+/*! \file test_memory_pool.cc
+    \brief Unit tests for MemoryPool
+    \ingroup unit_tests
+*/
+
+#include "upp11_config.h"
+
+using namespace hoomd;
+
+HOOMD_UP_MAIN();
+
+namespace
+    {
+//! Number of blocks currently allocated from the system by the test pools
+int num_system_blocks = 0;
+
+//! Make a pool that allocates host memory from the system and counts the blocks
+detail::MemoryPool* makePool()
+    {
+    return new detail::MemoryPool(
+        [](size_t num_bytes)
+        {
+            void* ptr = malloc(num_bytes);
+            if (!ptr)
+                throw std::bad_alloc();
+            ++num_system_blocks;
+            return ptr;
+        },
+        [](void* ptr)
+        {
+            --num_system_blocks;
+            free(ptr);
+        });
+    }
+    } // end anonymous namespace
+
+//! Test that requests are rounded up to the size classes
+UP_TEST(memory_pool_block_size)
+    {
+    const size_t min_bytes = detail::MemoryPool::min_block_bytes;
+    UP_ASSERT_EQUAL(detail::MemoryPool::getBlockSize(1), min_bytes);
+    UP_ASSERT_EQUAL(detail::MemoryPool::getBlockSize(min_bytes), min_bytes);
+    UP_ASSERT_EQUAL(detail::MemoryPool::getBlockSize(min_bytes + 1), min_bytes + min_bytes / 4);
+    UP_ASSERT_EQUAL(detail::MemoryPool::getBlockSize(1024), (size_t)1024);
+    UP_ASSERT_EQUAL(detail::MemoryPool::getBlockSize(1025), (size_t)1280);
+    UP_ASSERT_EQUAL(detail::MemoryPool::getBlockSize(1500), (size_t)1536);
+    UP_ASSERT_EQUAL(detail::MemoryPool::getBlockSize(2000), (size_t)2048);
+
+    // no more than a quarter of a block is unused
+    for (size_t num_bytes = min_bytes; num_bytes < 100000; num_bytes += 97)
+        {
+        const size_t block_bytes = detail::MemoryPool::getBlockSize(num_bytes);
+        UP_ASSERT(block_bytes >= num_bytes);
+        UP_ASSERT(4 * (block_bytes - num_bytes) < block_bytes);
+        }
+    }
+
+//! Test that returned blocks are reused and counted
+UP_TEST(memory_pool_reuse)
+    {
+    num_system_blocks = 0;
+    std::unique_ptr<detail::MemoryPool> pool(makePool());
+
+    void* a = pool->allocate(1000);
+    void* b = pool->allocate(3000);
+    UP_ASSERT_EQUAL(num_system_blocks, 2);
+    detail::MemoryPool::Stats stats = pool->getStats();
+    UP_ASSERT_EQUAL(stats.n_allocations, (size_t)2);
+    UP_ASSERT_EQUAL(stats.n_hits, (size_t)0);
+    UP_ASSERT_EQUAL(stats.n_system_allocations, (size_t)2);
+    UP_ASSERT_EQUAL(stats.bytes_in_use, (size_t)(1024 + 3072));
+    UP_ASSERT_EQUAL(stats.bytes_cached, (size_t)0);
+
+    // returned blocks stay allocated
+    pool->deallocate(a);
+    UP_ASSERT_EQUAL(num_system_blocks, 2);
+    stats = pool->getStats();
+    UP_ASSERT_EQUAL(stats.bytes_in_use, (size_t)3072);
+    UP_ASSERT_EQUAL(stats.bytes_cached, (size_t)1024);
+
+    // a request in the same size class gets the cached block
+    void* c = pool->allocate(900);
+    UP_ASSERT_EQUAL(c, a);
+    UP_ASSERT_EQUAL(num_system_blocks, 2);
+    stats = pool->getStats();
+    UP_ASSERT_EQUAL(stats.n_hits, (size_t)1);
+    UP_ASSERT_EQUAL(stats.bytes_cached, (size_t)0);
+
+    // but a request in a different size class does not
+    pool->deallocate(c);
+    void* d = pool->allocate(2000);
+    UP_ASSERT(d != a);
+    UP_ASSERT_EQUAL(num_system_blocks, 3);
+    stats = pool->getStats();
+    UP_ASSERT_EQUAL(stats.n_allocations, (size_t)4);
+    UP_ASSERT_EQUAL(stats.n_system_allocations, (size_t)3);
+    UP_ASSERT_EQUAL(stats.peak_bytes_in_use, (size_t)(2048 + 3072));
+
+    // release only frees the cached blocks
+    pool->release();
+    UP_ASSERT_EQUAL(num_system_blocks, 2);
+    UP_ASSERT_EQUAL(pool->getStats().bytes_cached, (size_t)0);
+
+    pool->deallocate(b);
+    pool->deallocate(d);
+    UP_ASSERT_EQUAL(num_system_blocks, 2);
+
+    // the destructor frees all cached blocks
+    pool.reset();
+    UP_ASSERT_EQUAL(num_system_blocks, 0);
+    }
+
+//! Test that a disabled pool does not cache blocks
+UP_TEST(memory_pool_disabled)
+    {
+    num_system_blocks = 0;
+    std::unique_ptr<detail::MemoryPool> pool(makePool());
+
+    void* a = pool->allocate(1000);
+    void* b = pool->allocate(1000);
+    pool->deallocate(a);
+    UP_ASSERT_EQUAL(num_system_blocks, 2);
+
+    // disabling frees the cached blocks
+    pool->setEnabled(false);
+    UP_ASSERT(!pool->getEnabled());
+    UP_ASSERT_EQUAL(num_system_blocks, 1);
+
+    // and blocks returned later are freed immediately
+    pool->deallocate(b);
+    UP_ASSERT_EQUAL(num_system_blocks, 0);
+    UP_ASSERT_EQUAL(pool->getStats().bytes_cached, (size_t)0);
+
+    // blocks that the pool did not allocate are an error
+    int x;
+    UP_ASSERT_EXCEPTION(std::runtime_error, [&] { pool->deallocate(&x); });
+    }
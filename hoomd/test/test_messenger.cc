@@ -8,6 +8,7 @@
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <thread>
 
 #include "hoomd/Messenger.h"
 
@@ -120,6 +121,43 @@ UP_TEST(Messenger_prefix)
     UP_ASSERT_EQUAL(strm.str(), string("err: 1\nwarn: 2\n3\nnote(5): 4\n"));
     }
 
+UP_TEST(Messenger_lazy)
+    {
+    Messenger msg;
+    ostringstream strm;
+    msg.setWarningStream(strm);
+    msg.setNoticeStream(strm);
+    msg.setWarningPrefix("warn");
+    msg.setNoticePrefix("note");
+    msg.setNoticeLevel(5);
+
+    // suppressed messages are not formatted
+    unsigned int n_formatted = 0;
+    msg.notice(1, [&](std::ostream& out) { out << "1" << endl; n_formatted++; });
+    msg.notice(5, [&](std::ostream& out) { out << "2" << endl; n_formatted++; });
+    msg.notice(6, [&](std::ostream& out) { out << "3" << endl; n_formatted++; });
+    msg.warning([&](std::ostream& out) { out << "4" << endl; n_formatted++; });
+    UP_ASSERT_EQUAL(n_formatted, (unsigned int)3);
+    UP_ASSERT(msg.isNoticeEnabled(5));
+    UP_ASSERT(!msg.isNoticeEnabled(6));
+    UP_ASSERT_EQUAL(strm.str(), string("1\nnote(5): 2\nwarn: 4\n"));
+
+    // messages from other threads are printed by the creating thread
+    strm.str("");
+    std::thread worker(
+        [&]
+        {
+            msg.notice(1, [](std::ostream& out) { out << "5" << endl; });
+            msg.warning([](std::ostream& out) { out << "6" << endl; });
+        });
+    worker.join();
+#ifdef ENABLE_TBB
+    UP_ASSERT_EQUAL(strm.str(), string(""));
+#endif
+    msg.flushDeferred();
+    UP_ASSERT_EQUAL(strm.str(), string("5\nwarn: 6\n"));
+    }
+
 UP_TEST(Messenger_file)
     {
         // scope the messengers so that the file is closed and written
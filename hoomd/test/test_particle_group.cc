@@ -261,6 +261,48 @@ UP_TEST(ParticleGroup_sort_test)
         }
     }
 
+//! Checks that ParticleGroup keeps its members through sorts that only permute the particles
+UP_TEST(ParticleGroup_permutation_sort_test)
+    {
+    std::shared_ptr<SystemDefinition> sysdef = create_sysdef();
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    std::shared_ptr<ParticleFilter> selector04(
+        new ParticleFilterTags(std::vector<unsigned int>({0, 1, 2, 3, 4})));
+    ParticleGroup tags04(sysdef, selector04);
+    CHECK_EQUAL_UINT(tags04.getNumMembers(), 5);
+
+    // reverse the particle order twice, rebuilding the group after each sort
+    for (unsigned int pass = 0; pass < 2; pass++)
+        {
+            {
+            ArrayHandle<unsigned int> h_tag(pdata->getTags(),
+                                            access_location::host,
+                                            access_mode::readwrite);
+            ArrayHandle<unsigned int> h_rtag(pdata->getRTags(),
+                                             access_location::host,
+                                             access_mode::readwrite);
+            for (unsigned int i = 0; i < pdata->getN(); i++)
+                {
+                unsigned int tag = pass == 0 ? pdata->getN() - 1 - i : i;
+                h_tag.data[i] = tag;
+                h_rtag.data[tag] = i;
+                }
+            }
+
+        pdata->notifyParticleSort(true);
+        UP_ASSERT(!pdata->isSortPermutation());
+
+        CHECK_EQUAL_UINT(tags04.getNumMembers(), 5);
+        for (unsigned int i = 0; i < 5; i++)
+            {
+            CHECK_EQUAL_UINT(tags04.getMemberTag(i), i);
+            unsigned int idx = pass == 0 ? i + 5 : i;
+            UP_ASSERT(tags04.isMember(idx));
+            }
+        }
+    }
+
 //! Checks that ParticleGroup can initialize by particle type
 UP_TEST(ParticleGroup_type_test)
     {
@@ -615,6 +615,89 @@ UP_TEST(ParticleData_test)
         }
     }
 
+//! Test that the structure-of-arrays mirrors follow changes to the particle data
+UP_TEST(ParticleData_SoA_test)
+    {
+    auto box = std::make_shared<BoxDim>(10.0);
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    ParticleData pdata(5, box, 1, exec_conf);
+
+    Scalar tol = Scalar(1e-6);
+
+        {
+        ArrayHandle<Scalar4> h_pos(pdata.getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar4> h_vel(pdata.getVelocities(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        for (unsigned int i = 0; i < 5; i++)
+            {
+            h_pos.data[i] = make_scalar4(Scalar(i), Scalar(i) + 0.5, -Scalar(i), 0.0);
+            h_vel.data[i] = make_scalar4(Scalar(2 * i), Scalar(3 * i), Scalar(4 * i), 1.0);
+            }
+        }
+
+    // the mirrors are filled on the first request
+        {
+        const GlobalArray<Scalar>& pos_soa = pdata.getPositionsSoA();
+        const GlobalArray<Scalar>& vel_soa = pdata.getVelocitiesSoA();
+        ArrayHandle<Scalar> h_pos_soa(pos_soa, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_vel_soa(vel_soa, access_location::host, access_mode::read);
+        const size_t pos_pitch = pos_soa.getPitch();
+        const size_t vel_pitch = vel_soa.getPitch();
+        for (unsigned int i = 0; i < 5; i++)
+            {
+            MY_CHECK_CLOSE(h_pos_soa.data[i], Scalar(i), tol);
+            MY_CHECK_CLOSE(h_pos_soa.data[pos_pitch + i], Scalar(i) + 0.5, tol);
+            MY_CHECK_CLOSE(h_pos_soa.data[2 * pos_pitch + i], -Scalar(i), tol);
+            MY_CHECK_CLOSE(h_vel_soa.data[i], Scalar(2 * i), tol);
+            MY_CHECK_CLOSE(h_vel_soa.data[vel_pitch + i], Scalar(3 * i), tol);
+            MY_CHECK_CLOSE(h_vel_soa.data[2 * vel_pitch + i], Scalar(4 * i), tol);
+            }
+        }
+
+    // writes through an ArrayHandle are picked up
+        {
+        ArrayHandle<Scalar4> h_pos(pdata.getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        h_pos.data[3].y = Scalar(4.25);
+        }
+
+        {
+        const GlobalArray<Scalar>& pos_soa = pdata.getPositionsSoA();
+        ArrayHandle<Scalar> h_pos_soa(pos_soa, access_location::host, access_mode::read);
+        MY_CHECK_CLOSE(h_pos_soa.data[pos_soa.getPitch() + 3], 4.25, tol);
+        }
+
+    // swapped in arrays are picked up
+        {
+        ArrayHandle<Scalar4> h_pos(pdata.getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_pos_alt(pdata.getAltPositions(),
+                                       access_location::host,
+                                       access_mode::overwrite);
+        for (unsigned int i = 0; i < 5; i++)
+            h_pos_alt.data[i] = h_pos.data[4 - i];
+        }
+    pdata.swapPositions();
+    pdata.notifyParticleSort();
+
+        {
+        const GlobalArray<Scalar>& pos_soa = pdata.getPositionsSoA();
+        ArrayHandle<Scalar> h_pos_soa(pos_soa, access_location::host, access_mode::read);
+        const size_t pitch = pos_soa.getPitch();
+        for (unsigned int i = 0; i < 5; i++)
+            {
+            Scalar y = (i == 1) ? Scalar(4.25) : Scalar(4 - i) + 0.5;
+            MY_CHECK_CLOSE(h_pos_soa.data[i], Scalar(4 - i), tol);
+            MY_CHECK_CLOSE(h_pos_soa.data[pitch + i], y, tol);
+            MY_CHECK_CLOSE(h_pos_soa.data[2 * pitch + i], -Scalar(4 - i), tol);
+            }
+        }
+    }
+
 //! Tests the RandomParticleInitializer class
 UP_TEST(Random_test)
     {
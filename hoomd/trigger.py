@@ -81,6 +81,40 @@ class Trigger(_hoomd.Trigger):
 
             Returns:
                 bool: `True` when the trigger is active, `False` when it is not.
+
+        next_active(timestep):
+            Find the earliest timestep on which the trigger may be active.
+
+            Args:
+                timestep (int): The first timestep to consider.
+
+            Returns:
+                int: A timestep ``next >= timestep`` such that `compute` is
+                `False` on all timesteps in ``[timestep, next)``.
+
+            When `compute` returns `False`, `__call__` skips `compute` on the
+            following timesteps before `next_active`. The provided triggers
+            implement `next_active`, so operations with such triggers cost
+            little on the timesteps where they are idle. The base class
+            implementation returns *timestep*, so `compute` is called on every
+            timestep. User-defined triggers may override `next_active` to
+            avoid calling into Python on every timestep:
+
+            .. code-block:: python
+
+                class CustomTrigger(hoomd.trigger.Trigger):
+
+                    def __init__(self):
+                        hoomd.trigger.Trigger.__init__(self)
+
+                    def compute(self, timestep):
+                        return (timestep**(1 / 2)).is_integer()
+
+                    def next_active(self, timestep):
+                        root = math.isqrt(timestep)
+                        if root * root == timestep:
+                            return timestep
+                        return (root + 1)**2
     """
 
     def __getstate__(self):
@@ -46,5 +46,6 @@ from hoomd.tune.sorter import ParticleSorter
 from hoomd.tune.balance import LoadBalancer
 from hoomd.tune.custom_tuner import CustomTuner, _InternalCustomTuner
 from hoomd.tune.attr_tuner import ManualTuneDefinition
+from hoomd.tune.plugin import Plugin
 from hoomd.tune.solve import (GridOptimizer, GradientDescent, Optimizer,
                               RootSolver, ScaleSolver, SecantSolver, SolverStep)
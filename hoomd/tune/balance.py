@@ -4,6 +4,7 @@
 """Define LoadBalancer."""
 
 from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import OnlyFrom
 from hoomd.operation import Tuner
 from hoomd import _hoomd
 import hoomd
@@ -21,6 +22,10 @@ class LoadBalancer(Tuner):
         tolerance (float): Load imbalance tolerance.
         max_iterations (int): Maximum number of iterations to
             attempt in a single step.
+        weight (str): Quantity that measures the load of a rank:
+            ``'particles'`` or ``'time'``.
+        hysteresis (float): Imbalance above *tolerance* required to begin
+            balancing.
 
     `LoadBalancer` adjusts the boundaries of the MPI domains to distribute
     the particle load close to evenly between them. The load imbalance is
@@ -56,6 +61,22 @@ class LoadBalancer(Tuner):
     to *maxiter* attempts can be made. The optimal values of update and
     *maxiter* will depend on your simulation.
 
+    Set *weight* to ``'time'`` to balance the measured cost instead of the
+    number of particles. With this weighting, the load :math:`N_i` of each rank
+    is the time it spent computing forces since the previous load balancing
+    update (excluding time spent waiting for ghost communication). Each
+    particle is assigned the average cost of the particles on its rank. Use
+    this weighting when the cost per particle varies through the system, for
+    example in dense droplets surrounded by vapor. When there are no force
+    computes, ``'time'`` behaves as ``'particles'``. ``'time'`` is not
+    supported on the GPU.
+
+    Measured times fluctuate, which may cause the domain boundaries to
+    oscillate. To prevent this, set *hysteresis* to a positive value.
+    `LoadBalancer` then begins balancing only after the maximum imbalance
+    exceeds ``tolerance + hysteresis``, and continues to balance on subsequent
+    updates until the imbalance drops below *tolerance*.
+
     Load balancing can be performed independently and sequentially for each
     dimension of the simulation box. A small performance increase may be
     obtained by disabling load balancing along dimensions that are known to be
@@ -83,6 +104,10 @@ class LoadBalancer(Tuner):
         tolerance (float): Load imbalance tolerance.
         max_iterations (int): Maximum number of iterations to
             attempt in a single step.
+        weight (str): Quantity that measures the load of a rank:
+            ``'particles'`` or ``'time'``.
+        hysteresis (float): Imbalance above *tolerance* required to begin
+            balancing.
     """
 
     def __init__(self,
@@ -91,19 +116,26 @@ class LoadBalancer(Tuner):
                  y=True,
                  z=True,
                  tolerance=1.02,
-                 max_iterations=1):
+                 max_iterations=1,
+                 weight='particles',
+                 hysteresis=0.0):
         super().__init__(trigger)
 
         defaults = dict(x=x,
                         y=y,
                         z=z,
                         tolerance=tolerance,
-                        max_iterations=max_iterations)
+                        max_iterations=max_iterations,
+                        weight=weight,
+                        hysteresis=hysteresis)
         load_balancer_params = ParameterDict(x=bool,
                                              y=bool,
                                              z=bool,
                                              max_iterations=int,
-                                             tolerance=float)
+                                             tolerance=float,
+                                             weight=OnlyFrom(
+                                                 ['particles', 'time']),
+                                             hysteresis=float)
         self._param_dict.update(load_balancer_params)
         self._param_dict.update(defaults)
 
@@ -0,0 +1,48 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+"""Implement hoomd.tune.Plugin.
+
+.. invisible-code-block: python
+
+    simulation = hoomd.util.make_example_simulation()
+"""
+
+from hoomd.custom.plugin_operation import PluginOperation
+from hoomd.operation import Tuner
+
+
+class Plugin(PluginOperation, Tuner):
+    """Tuner implemented in a C++ action plugin library.
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps to call the
+            tuner.
+        library (str): Path to the plugin library.
+        name (str): Name of the tuner in the plugin library.
+        parameters (dict): Parameters passed to the constructor of the
+            tuner.
+
+    `Plugin` is a `hoomd.operation.Tuner` that loads a C++ ``Tuner`` from an
+    action plugin library when it attaches. Tuners change the parameters of
+    other operations without changing the correctness of the simulation.
+
+    .. rubric:: Example:
+
+    .. skip: next
+
+    .. code-block:: python
+
+        plugin_tuner = hoomd.tune.Plugin(
+            trigger=hoomd.trigger.Periodic(1000),
+            library='/path/to/libactions.so',
+            name='MyTuner')
+        simulation.operations.tuners.append(plugin_tuner)
+
+    See Also:
+        The base class `hoomd.custom.PluginOperation`.
+
+        `hoomd.tune.CustomTuner`
+    """
+
+    _cpp_create_method = 'createTuner'
@@ -17,3 +17,4 @@ from hoomd.update.box_resize import BoxResize
 from hoomd.update.remove_drift import RemoveDrift
 from hoomd.update.custom_updater import CustomUpdater
 from hoomd.update.particle_filter import FilterUpdater
+from hoomd.update.plugin import Plugin
@@ -40,6 +40,8 @@ class BoxResize(Updater):
         filter (hoomd.filter.filter_like): The subset of particle positions
             to update (defaults to `hoomd.filter.All`).
         box (hoomd.variant.box.BoxVariant): Box as a function of time.
+        small_deformation (bool): When True, notify other operations that the
+            box changes are small deformations (defaults to False).
 
     `BoxResize` resizes the simulation box as a function of time. For each
     particle :math:`i` matched by `filter`, `BoxResize` scales the particle to
@@ -77,6 +79,12 @@ class BoxResize(Updater):
                                                 final_box=box2,
                                                 variant=variant)
 
+    Set ``small_deformation=True`` when `BoxResize` changes the box by a
+    small amount each time it triggers, such as during a slow compression.
+    Cell lists then keep their cell grid when the cells remain wide enough and
+    at most 10% wider than needed, instead of reallocating the grid each time
+    the number of cells that fit in the box changes.
+
     Warning:
         Rescaling particles in HPMC simulations with hard particles may
         introduce overlaps.
@@ -117,6 +125,15 @@ class BoxResize(Updater):
             .. code-block:: python
 
                 filter_ = box_resize.filter
+
+        small_deformation (bool): When True, notify other operations that the
+            box changes are small deformations.
+
+            .. rubric:: Example:
+
+            .. code-block:: python
+
+                box_resize.small_deformation = True
     """
 
     def __init__(
@@ -127,9 +144,11 @@ class BoxResize(Updater):
             variant=None,
             filter=All(),
             box=None,
+            small_deformation=False,
     ):
         params = ParameterDict(box=hoomd.variant.box.BoxVariant,
-                               filter=ParticleFilter)
+                               filter=ParticleFilter,
+                               small_deformation=bool(small_deformation))
 
         if box is not None and (box1 is not None or box2 is not None
                                 or variant is not None):
@@ -0,0 +1,49 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+"""Implement hoomd.update.Plugin.
+
+.. invisible-code-block: python
+
+    simulation = hoomd.util.make_example_simulation()
+"""
+
+from hoomd.custom.plugin_operation import PluginOperation
+from hoomd.operation import Updater
+
+
+class Plugin(PluginOperation, Updater):
+    """Updater implemented in a C++ action plugin library.
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps to call the
+            updater.
+        library (str): Path to the plugin library.
+        name (str): Name of the updater in the plugin library.
+        parameters (dict): Parameters passed to the constructor of the
+            updater.
+
+    `Plugin` is a `hoomd.operation.Updater` that loads a C++ ``Updater`` from
+    an action plugin library when it attaches. Updaters modify the system
+    state.
+
+    .. rubric:: Example:
+
+    .. skip: next
+
+    .. code-block:: python
+
+        plugin_updater = hoomd.update.Plugin(
+            trigger=hoomd.trigger.Periodic(1000),
+            library='/path/to/libactions.so',
+            name='ScaleVelocities',
+            parameters=dict(factor=0.5))
+        simulation.operations.updaters.append(plugin_updater)
+
+    See Also:
+        The base class `hoomd.custom.PluginOperation`.
+
+        `hoomd.update.CustomUpdater`
+    """
+
+    _cpp_create_method = 'createUpdater'
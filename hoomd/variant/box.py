@@ -28,6 +28,12 @@ class BoxVariant(_hoomd.VectorVariantBox):
             def __call__(self, timestep):
                 return [10 + timestep/1e6, 10, 10, 0, 0, 0]
 
+    Note:
+        Operations evaluate the variant once per time step. When several
+        operations query the variant on the same *timestep*, HOOMD-blue calls
+        ``__call__`` on the first query, caches the value, and returns that
+        cached value to the other operations.
+
     .. py:method:: __call__(timestep)
 
         Evaluate the function.
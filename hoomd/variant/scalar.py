@@ -36,6 +36,12 @@ class Variant(_hoomd.Variant):
         Provide the minimum and maximum values in the ``_min`` and ``_max``
         methods respectively.
 
+    Note:
+        Operations evaluate the variant once per time step. When several
+        operations query the variant on the same *timestep*, HOOMD-blue calls
+        ``__call__`` on the first query, caches the value, and returns that
+        cached value to the other operations.
+
     .. py:method:: __call__(timestep)
 
         Evaluate the function.
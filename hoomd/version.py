@@ -40,6 +40,9 @@ Attributes:
     gpu_platform (str): Name of the GPU platform this build was compiled
         against.
 
+    hdf5_enabled (bool): ``True`` when this build supports the native HDF5
+        log writer `hoomd.write.HDF5BlockLog`.
+
     hpmc_built (bool): ``True`` when the ``hpmc`` component is built.
 
     install_dir (str): The installation directory.
@@ -85,6 +88,7 @@ gpu_platform = _hoomd.BuildInfo.getGPUPlatform()
 cxx_compiler = _hoomd.BuildInfo.getCXXCompiler()
 tbb_enabled = _hoomd.BuildInfo.getEnableTBB()
 mpi_enabled = _hoomd.BuildInfo.getEnableMPI()
+hdf5_enabled = _hoomd.BuildInfo.getEnableHDF5()
 source_dir = _hoomd.BuildInfo.getSourceDir()
 install_dir = _hoomd.BuildInfo.getInstallDir()
 floating_point_precision = _hoomd.BuildInfo.getFloatingPointPrecision()
@@ -11,7 +11,12 @@ results to output files or streams:
   `Burst.dump` for use in selective high frequency trajectory data.
 * Combine `GSD` with a `hoomd.logging.Logger` to save system properties or
   per-particle calculated results.
+* Use `GSDLog` to store logged data at a high frequency in GSD files.
 * Use `HDF5Log` to store logged data in HDF5 resizable datasets.
+* Use `HDF5BlockLog` to store logged data in compressed HDF5 datasets at a high
+  frequency.
+* Use `Checkpoint` to restart a simulation exactly where it stopped.
+* Use `Trace` to write event traces of the time step loop.
 * Use `Table` to display the status of the simulation periodically to standard
   out.
 * Implement custom output formats with `CustomWriter`.
@@ -31,6 +36,11 @@ See Also:
 from hoomd.write.custom_writer import CustomWriter
 from hoomd.write.gsd import GSD
 from hoomd.write.gsd_burst import Burst
+from hoomd.write.gsd_log import GSDLog
 from hoomd.write.dcd import DCD
+from hoomd.write.checkpoint import Checkpoint
 from hoomd.write.table import Table
 from hoomd.write.hdf5 import HDF5Log
+from hoomd.write.hdf5_block import HDF5BlockLog
+from hoomd.write.trace import Trace
+from hoomd.write.plugin import Plugin
@@ -0,0 +1,112 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+"""Implement Checkpoint.
+
+.. invisible-code-block: python
+
+    simulation = hoomd.util.make_example_simulation()
+    checkpoint_filename = tmp_path / 'checkpoint.bin'
+"""
+
+from hoomd import _hoomd
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.operation import Writer
+
+
+class Checkpoint(Writer):
+    """Write checkpoints to restart the simulation exactly.
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps to write.
+        filename (str): File name to write.
+        asynchronous (bool): When True, write the file in a background thread.
+            Defaults to False.
+
+    `Checkpoint` writes the complete state of the simulation to a binary file.
+    Every MPI rank writes its own local particles and bonded groups directly to
+    its own part of the file, without gathering the system on the root rank.
+    The checkpoint also stores the timestep, the seed, the domain decomposition
+    with the current cut planes (including those set by
+    `hoomd.tune.LoadBalancer`), and the rank local state of the operations,
+    such as thermostat degrees of freedom, HPMC move sizes and counters, and
+    kernel launch parameters. Call
+    `hoomd.Simulation.create_state_from_checkpoint` to continue the simulation
+    from the checkpoint. Restarting from a checkpoint produces the same
+    trajectory as the uninterrupted simulation.
+
+    `Checkpoint` writes to a temporary file ``filename + '.tmp'`` and replaces
+    *filename* after all ranks complete their part. An error while writing
+    leaves the previous checkpoint intact.
+
+    When *asynchronous* is True, `Checkpoint` copies the state to memory and
+    returns while a background thread writes the file. The next write or
+    `flush` waits for the background write to complete.
+
+    Important:
+        Checkpoint files depend on the build and the number of MPI ranks.
+        Restore them with the same version of HOOMD-blue, with the same
+        floating point precision, and with the same number of ranks. Use
+        `hoomd.write.GSD` for portable output.
+
+    Note:
+        `Checkpoint` does not support MPCD particles.
+
+    .. rubric:: Example:
+
+    .. code-block:: python
+
+        checkpoint = hoomd.write.Checkpoint(
+            trigger=hoomd.trigger.Periodic(1_000_000),
+            filename=checkpoint_filename)
+        simulation.operations.writers.append(checkpoint)
+
+    Attributes:
+        filename (str): File name to write (*read only*).
+
+            .. rubric:: Example:
+
+            .. code-block:: python
+
+                filename = checkpoint.filename
+
+        asynchronous (bool): When True, write the file in a background thread.
+
+            .. rubric:: Example:
+
+            .. code-block:: python
+
+                checkpoint.asynchronous = True
+    """
+
+    def __init__(self, trigger, filename, asynchronous=False):
+
+        # initialize base class
+        super().__init__(trigger)
+        self._param_dict.update(
+            ParameterDict(filename=str(filename),
+                          asynchronous=bool(asynchronous)))
+
+    def _attach_hook(self):
+        # all ranks write to the file named on the root rank
+        filename = _hoomd.mpi_bcast_str(self.filename,
+                                        self._simulation.device._cpp_exec_conf)
+        self._cpp_obj = _hoomd.CheckpointWriter(
+            self._simulation.state._cpp_sys_def, self.trigger, filename,
+            self.asynchronous)
+        self._cpp_obj.setOperationStateCallback(
+            self._simulation._get_checkpoint_operation_state)
+
+    def flush(self):
+        """Wait for a background write to complete.
+
+        After `flush` returns, *filename* holds the most recent checkpoint.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            checkpoint.flush()
+        """
+        if self._attached:
+            self._cpp_obj.flush()
@@ -251,6 +251,74 @@ class GSD(Writer):
             .. code-block:: python
 
                 gsd.maximum_write_buffer_size = 128 * 1024**2
+
+        maximum_frames_in_flight (int): Number of frames to hand off to a
+            background I/O thread before `GSD` waits for the thread to write
+            them. Set to 0 to write frames on the simulation thread. Defaults
+            to 0.
+
+            When `maximum_frames_in_flight` is non-zero, `GSD` gathers each
+            frame, copies it into a buffer, and continues the simulation while
+            the I/O thread writes the buffer to the file. `flush` waits for
+            the I/O thread to write all frames before flushing the file.
+
+            .. rubric:: Example:
+
+            .. code-block:: python
+
+                gsd.maximum_frames_in_flight = 2
+
+        collective_write (bool): When `True` and the simulation is domain
+            decomposed, each MPI rank writes its own particles to the file
+            with collective MPI-IO instead of gathering the whole frame on
+            rank 0. Defaults to `False`.
+
+            Rank 0 still writes the frame header, log quantities, and
+            topology. Frames written collectively are written synchronously,
+            regardless of `maximum_frames_in_flight`. The file system must
+            support MPI-IO writes to the file from all ranks.
+
+            .. rubric:: Example:
+
+            .. code-block:: python
+
+                gsd.collective_write = True
+
+        position_precision (float): When non-zero, quantize the particle
+            positions to bins of this width, given as a fraction of the box
+            length along each box vector. Set to 0 to write the positions as
+            floats. Defaults to 0.
+
+            Quantized positions are accurate to half of the bin width. `GSD`
+            writes the bin indices of every particle in keyframes and the
+            change since the previous frame in the other frames. When
+            particles move only a few bins from one frame to the next, the
+            changes take 1 or 2 bytes per coordinate instead of the 4 bytes of
+            a float. When `maximum_frames_in_flight` is non-zero, the I/O
+            thread quantizes the positions.
+
+            Quantized positions are stored in the ``hoomd/quantized_position``
+            chunks in place of ``particles/position``, and only
+            `hoomd.Simulation.create_state_from_gsd` reads them. Other GSD
+            readers do not. `collective_write` has no effect when
+            `position_precision` is non-zero.
+
+            .. rubric:: Example:
+
+            .. code-block:: python
+
+                gsd.position_precision = 1e-5
+
+        position_keyframe_interval (int): Number of frames between keyframes
+            of the quantized positions. Readers apply the changes in all the
+            frames since the last keyframe, so smaller intervals read faster
+            and larger intervals write smaller files. Defaults to 100.
+
+            .. rubric:: Example:
+
+            .. code-block:: python
+
+                gsd.position_keyframe_interval = 50
     """
 
     def __init__(self,
@@ -295,6 +363,10 @@ class GSD(Writer):
                           dynamic=[dynamic_validation],
                           write_diameter=False,
                           maximum_write_buffer_size=64 * 1024 * 1024,
+                          maximum_frames_in_flight=0,
+                          collective_write=False,
+                          position_precision=0.0,
+                          position_keyframe_interval=100,
                           _defaults=dict(filter=filter, dynamic=dynamic)))
 
         self._logger = None if logger is None else _GSDLogWriter(logger)
@@ -39,6 +39,17 @@ class Burst(GSD):
         write_at_start (bool): When ``True`` **and** the file does not exist or
             has 0 frames: write one frame with the current state of the system
             when `hoomd.Simulation.run` is called. Defaults to ``False``.
+        max_burst_bytes (int): The size of the buffer that stores the frames in
+            bytes. 0 stores full frames in host memory. Defaults to 0.
+
+    When `max_burst_bytes` is 0, `Burst` copies each stored frame to host
+    memory. When `max_burst_bytes` is positive, `Burst` allocates a buffer of
+    `max_burst_bytes` bytes once and stores only the per-particle arrays that
+    hold the `dynamic` fields in it. On the GPU, the buffer resides in device
+    memory: `Burst` copies the arrays on the device asynchronously, and it
+    copies the buffer to the host only in `dump`. When the next frame does not
+    fit in the buffer, `Burst` removes the oldest frames. `max_burst_size`
+    also limits the number of frames in the buffer.
 
     Warning:
         `Burst` errors when attempting to create a file or writing to one with
@@ -80,6 +91,15 @@ class Burst(GSD):
             .. code-block:: python
 
                 write_at_start = burst.write_at_start
+
+        max_burst_bytes (int): The size of the buffer that stores the frames in
+            bytes. 0 stores full frames in host memory (*read only*).
+
+            .. rubric:: Example:
+
+            .. code-block:: python
+
+                max_burst_bytes = burst.max_burst_bytes
     """
 
     def __init__(self,
@@ -90,7 +110,8 @@ class Burst(GSD):
                  dynamic=None,
                  logger=None,
                  max_burst_size=-1,
-                 write_at_start=False):
+                 write_at_start=False,
+                 max_burst_bytes=0):
         super().__init__(trigger=trigger,
                          filename=filename,
                          filter=filter,
@@ -99,10 +120,13 @@ class Burst(GSD):
                          logger=logger)
         self._param_dict.pop("truncate")
         self._param_dict.update(
-            ParameterDict(max_burst_size=int, write_at_start=bool))
+            ParameterDict(max_burst_size=int,
+                          write_at_start=bool,
+                          max_burst_bytes=int))
         self._param_dict.update({
             "max_burst_size": max_burst_size,
-            "write_at_start": write_at_start
+            "write_at_start": write_at_start,
+            "max_burst_bytes": max_burst_bytes
         })
 
     def _attach_hook(self):
@@ -112,7 +136,8 @@ class Burst(GSD):
                                               sim.state._get_group(self.filter),
                                               self.logger, self.max_burst_size,
                                               self.mode, self.write_at_start,
-                                              sim.timestep)
+                                              sim.timestep,
+                                              self.max_burst_bytes)
 
     def dump(self):
         """Write all currently stored frames to the file and empties the buffer.
@@ -0,0 +1,125 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+"""Write logged quantities to GSD files in blocks of frames.
+
+.. invisible-code-block: python
+
+    simulation = hoomd.util.make_example_simulation()
+    log_filename = tmp_path / 'log.gsd'
+"""
+
+import weakref
+
+from hoomd import _hoomd
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.logging import Logger
+from hoomd.operation import Writer
+from hoomd.write.gsd import _GSDLogWriter, _open_gsd_writers, _finalize_gsd
+
+
+class GSDLog(Writer):
+    """Write logged quantities to a GSD file in blocks of frames.
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps to log.
+        filename (str): File name to write.
+        logger (hoomd.logging.Logger): Provide log quantities to write.
+        mode (str): The file open mode. Defaults to ``'ab'``.
+        block_size (int): Number of frames to store before writing them to the
+            file. Defaults to 100.
+
+    `GSDLog` writes the quantities provided by `logger` in the same format as
+    `GSD` does, without any particle data. Read the values with
+    ``gsd.hoomd.read_log``. Use `GSDLog` in place of `Table` to log quantities
+    at a high frequency: `GSDLog` stores the values in binary form, and it does
+    not format them as text.
+
+    `GSDLog` copies the values of each quantity into a contiguous buffer that
+    holds `block_size` frames. When the buffers are full, a background thread
+    writes the block to the file while the simulation continues. `flush` writes
+    the stored frames immediately.
+
+    The mode argument opens the file in the following ways:
+
+    * ``'wb'`` - Open the file for writing. Create the file if needed, or
+      overwrite an existing file.
+    * ``'xb'`` - Create the file for writing. Raise an exception when the file
+      exists.
+    * ``'ab'`` - Create the file if needed, or append to an existing file.
+
+    Note:
+        When the logged quantities change, such as when the number of particles
+        changes a per-particle quantity, `GSDLog` writes the block early and
+        begins a new one.
+
+    .. rubric:: Example:
+
+    .. code-block:: python
+
+        logger = hoomd.logging.Logger(categories=['scalar', 'sequence'])
+        logger.add(simulation, quantities=['timestep', 'tps'])
+        gsd_log = hoomd.write.GSDLog(trigger=hoomd.trigger.Periodic(10),
+                                     filename=log_filename,
+                                     logger=logger,
+                                     block_size=1000)
+        simulation.operations.writers.append(gsd_log)
+
+    Attributes:
+        filename (str): File name to write (*read only*).
+
+        mode (str): The file open mode (*read only*).
+
+        block_size (int): Number of frames to store before writing them to the
+            file.
+
+            .. rubric:: Example:
+
+            .. code-block:: python
+
+                gsd_log.block_size = 10_000
+    """
+
+    def __init__(self, trigger, filename, logger, mode='ab', block_size=100):
+        super().__init__(trigger)
+        if not isinstance(logger, Logger):
+            raise TypeError("GSDLog.logger must be a hoomd.logging.Logger.")
+        self._param_dict.update(
+            ParameterDict(filename=str(filename),
+                          mode=str(mode),
+                          block_size=int(block_size)))
+        self._logger = logger
+
+    @property
+    def logger(self):
+        """hoomd.logging.Logger: Provide log quantities to write (*read only*).
+        """
+        return self._logger
+
+    def _attach_hook(self):
+        self._cpp_obj = _hoomd.GSDLogBlockWriter(
+            self._simulation.state._cpp_sys_def, self.trigger, self.filename,
+            self.mode, self.block_size)
+        self._cpp_obj.log_writer = _GSDLogWriter(self._logger)
+
+        # Write the stored frames at exit
+        weak_writer = weakref.ref(self)
+        _open_gsd_writers.append(weak_writer)
+        self._finalizer = weakref.finalize(self, _finalize_gsd, weak_writer,
+                                           self._cpp_obj)
+
+    def flush(self):
+        """Write the stored frames to the file and flush it.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            simulation.run(0)
+            gsd_log.flush()
+        """
+        if not self._attached:
+            raise RuntimeError("The GSD file is unavailable until the "
+                               "simulation runs for 0 or more steps.")
+
+        self._cpp_obj.flush()
@@ -0,0 +1,213 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+"""Write logged quantities to HDF5 files in blocks of frames.
+
+.. invisible-code-block: python
+
+    import hoomd
+
+    hdf5_not_enabled = not hoomd.version.hdf5_enabled
+
+    if not hdf5_not_enabled:
+        simulation = hoomd.util.make_example_simulation()
+        hdf5_filename = tmp_path / "simulation_log.h5"
+
+.. skip: start if(hdf5_not_enabled)
+"""
+
+import weakref
+
+import numpy as np
+
+from hoomd import _hoomd
+import hoomd.version
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import OnlyFrom
+from hoomd.logging import Logger, LoggerCategories
+from hoomd.operation import Writer
+from hoomd.util import _dict_flatten
+from hoomd.write.gsd import _open_gsd_writers, _finalize_gsd
+from hoomd.write.hdf5 import _HDF5LogInternal
+
+
+class _HDF5LogWriter:
+    """Helper class to provide `hoomd.logging.Logger` log data to HDF5 files.
+
+    `log` returns the values keyed by the dataset path that `HDF5Log` uses.
+    """
+
+    def __init__(self, logger):
+        self.logger = logger
+
+    def log(self):
+        """Get the flattened dictionary of arrays for the C++ writer."""
+        log = dict()
+        for key, (value, category) in _dict_flatten(self.logger.log()).items():
+            if (LoggerCategories[category]
+                    in _HDF5LogInternal._reject_categories):
+                continue
+            if value is None:
+                continue
+            log["/".join(("hoomd-data",) + key)] = np.asarray(value)
+        return log
+
+
+class HDF5BlockLog(Writer):
+    """Write logged quantities to a HDF5 file in blocks of frames.
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps to log.
+        filename (str): File name to write.
+        logger (hoomd.logging.Logger): Provide log quantities to write.
+        mode (str): The file open mode. Defaults to ``'a'``.
+        block_size (int): Number of frames to store before writing them to the
+            file. Defaults to 100.
+        compression (str): The compression filter: ``'gzip'``, ``'zstd'``, or
+            `None`. Defaults to `None`.
+        compression_level (int): The compression level. Defaults to 4.
+
+    `HDF5BlockLog` writes the quantities provided by `logger` with the HDF5 C
+    library in the same layout as `HDF5Log` does, so that the two writers may
+    append to the same file. `HDF5BlockLog` does not require ``h5py``, but
+    HOOMD-blue must be built with ``ENABLE_HDF5=on`` (see
+    `hoomd.version.hdf5_enabled`).
+
+    `HDF5BlockLog` copies the values of each quantity into a contiguous buffer
+    that holds `block_size` frames. When the buffers are full, it extends each
+    dataset once and writes all the buffered frames. `flush` writes the
+    buffered frames immediately.
+
+    The datasets are chunked along the frame axis. Set `compression` to
+    ``'gzip'`` to compress them with the deflate filter, or to ``'zstd'`` to
+    compress them with the zstd filter. The zstd filter requires the HDF5 zstd
+    filter plugin: set the environment variable ``HDF5_PLUGIN_PATH`` to the
+    directory that holds it (for example, the ``hdf5plugin`` package).
+
+    The mode argument opens the file in the following ways:
+
+    * ``'w'`` - Create the file if needed, or overwrite an existing file.
+    * ``'x'`` or ``'w-'`` - Create the file. Raise an exception when the file
+      exists.
+    * ``'a'`` - Create the file if needed, or append to an existing file.
+    * ``'r+'`` - Append to an existing file.
+
+    Warning:
+        `HDF5BlockLog` cannot write string, strings, or object loggables.
+
+    Note:
+        The logged quantities and their shapes cannot change within a file.
+
+    .. rubric:: Example:
+
+    .. code-block:: python
+
+        logger = hoomd.logging.Logger(
+            hoomd.write.HDF5BlockLog.accepted_categories)
+        logger.add(simulation, quantities=['timestep', 'tps'])
+        hdf5_log = hoomd.write.HDF5BlockLog(
+            trigger=hoomd.trigger.Periodic(10),
+            filename=hdf5_filename,
+            logger=logger,
+            block_size=1000,
+            compression='gzip')
+        simulation.operations.writers.append(hdf5_log)
+
+    Attributes:
+        accepted_categories (hoomd.logging.LoggerCategories): The enum value
+            for all accepted categories for `HDF5BlockLog` instances which is
+            all categories other than "string", "strings", and "object" (see
+            `hoomd.logging.LoggerCategories`).
+
+        filename (str): File name to write (*read only*).
+
+        mode (str): The file open mode (*read only*).
+
+        block_size (int): Number of frames to store before writing them to the
+            file.
+
+            .. rubric:: Example:
+
+            .. code-block:: python
+
+                hdf5_log.block_size = 10_000
+
+        compression (str): The compression filter (*read only*).
+
+        compression_level (int): The compression level (*read only*).
+    """
+
+    accepted_categories = _HDF5LogInternal.accepted_categories
+
+    def __init__(self,
+                 trigger,
+                 filename,
+                 logger,
+                 mode='a',
+                 block_size=100,
+                 compression=None,
+                 compression_level=4):
+        super().__init__(trigger)
+        if not isinstance(logger, Logger):
+            raise TypeError("HDF5BlockLog.logger must be a "
+                            "hoomd.logging.Logger.")
+        rejects = _HDF5LogInternal._reject_categories & logger.categories
+        if rejects != LoggerCategories["NONE"]:
+            reject_str = LoggerCategories._get_string_list(rejects)
+            raise ValueError(f"Cannot have {reject_str} in logger categories.")
+
+        self._param_dict.update(
+            ParameterDict(filename=str,
+                          mode=str,
+                          block_size=int,
+                          compression=OnlyFrom(('gzip', 'zstd'),
+                                               allow_none=True),
+                          compression_level=int))
+        self._param_dict.update(
+            dict(filename=str(filename),
+                 mode=mode,
+                 block_size=block_size,
+                 compression=compression,
+                 compression_level=compression_level))
+        self._logger = logger
+
+    @property
+    def logger(self):
+        """hoomd.logging.Logger: Provide log quantities to write (*read only*).
+        """
+        return self._logger
+
+    def _attach_hook(self):
+        if not hoomd.version.hdf5_enabled:
+            raise RuntimeError("HDF5BlockLog requires a build with "
+                               "ENABLE_HDF5=on.")
+
+        compression = self.compression
+        if compression is None:
+            compression = 'none'
+        self._cpp_obj = _hoomd.HDF5LogWriter(
+            self._simulation.state._cpp_sys_def, self.trigger, self.filename,
+            self.mode, self.block_size, compression, self.compression_level)
+        self._cpp_obj.log_writer = _HDF5LogWriter(self._logger)
+
+        # Write the stored frames at exit
+        weak_writer = weakref.ref(self)
+        _open_gsd_writers.append(weak_writer)
+        self._finalizer = weakref.finalize(self, _finalize_gsd, weak_writer,
+                                           self._cpp_obj)
+
+    def flush(self):
+        """Write the stored frames to the file and flush it.
+
+        .. rubric:: Example:
+
+        .. code-block:: python
+
+            simulation.run(0)
+            hdf5_log.flush()
+        """
+        if not self._attached:
+            raise RuntimeError("The HDF5 file is unavailable until the "
+                               "simulation runs for 0 or more steps.")
+
+        self._cpp_obj.flush()
@@ -0,0 +1,48 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+"""Implement hoomd.write.Plugin.
+
+.. invisible-code-block: python
+
+    simulation = hoomd.util.make_example_simulation()
+"""
+
+from hoomd.custom.plugin_operation import PluginOperation
+from hoomd.operation import Writer
+
+
+class Plugin(PluginOperation, Writer):
+    """Writer implemented in a C++ action plugin library.
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps to call the
+            writer.
+        library (str): Path to the plugin library.
+        name (str): Name of the analyzer in the plugin library.
+        parameters (dict): Parameters passed to the constructor of the
+            analyzer.
+
+    `Plugin` is a `hoomd.operation.Writer` that loads a C++ ``Analyzer`` from
+    an action plugin library when it attaches. The plugin registers the
+    analyzer with ``addAnalyzer``. Writers do not modify the system state.
+
+    .. rubric:: Example:
+
+    .. skip: next
+
+    .. code-block:: python
+
+        plugin_writer = hoomd.write.Plugin(
+            trigger=hoomd.trigger.Periodic(1000),
+            library='/path/to/libactions.so',
+            name='MyWriter')
+        simulation.operations.writers.append(plugin_writer)
+
+    See Also:
+        The base class `hoomd.custom.PluginOperation`.
+
+        `hoomd.write.CustomWriter`
+    """
+
+    _cpp_create_method = 'createAnalyzer'
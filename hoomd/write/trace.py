@@ -0,0 +1,102 @@
+# Copyright (c) 2009-2024 The Regents of the University of Michigan.
+# Part of HOOMD-blue, released under the BSD 3-Clause License.
+
+"""Implement Trace.
+
+.. invisible-code-block: python
+
+    simulation = hoomd.util.make_example_simulation()
+    trace_filename = tmp_path / 'trace.json'
+"""
+
+from hoomd import _hoomd
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.operation import Writer
+
+
+class Trace(Writer):
+    """Write event traces of the time step loop.
+
+    Args:
+        trigger (hoomd.trigger.trigger_like): Select the timesteps that start
+            a trace window.
+        filename (str): File name to write.
+        steps (int): Number of steps in each window. Defaults to 10.
+
+    On each step where *trigger* is active, `Trace` records an event trace of
+    the next *steps* steps and then writes it to *filename* in the Chrome trace
+    JSON format. View the file with https://ui.perfetto.dev or
+    ``chrome://tracing``. The trace includes a marker at the start of every step
+    and one entry for:
+
+    * every call to an operation (computes, updaters, writers, tuners, and the
+      integrator),
+    * every force and neighbor list computation,
+    * every MPI communication phase,
+    * and, on the GPU, every kernel launch that has an autotuner. The category
+      of launches made while the autotuner scans is ``autotuner scan``.
+
+    With MPI, the ranks synchronize at the start of the window and the root
+    rank writes the traces of all ranks to the same file, each rank as a
+    separate process. Compare the ranks to find load imbalance and
+    synchronization points.
+
+    *filename* may contain ``{timestep}``, which is replaced by the first step
+    of the window. Otherwise, each window replaces the file.
+
+    Note:
+        On the GPU, the entries show the execution on the device and the step
+        markers show when the host started the step.
+
+    Note:
+        The steps in a window are never run as idle steps, see
+        `hoomd.Simulation.run`.
+
+    .. rubric:: Example:
+
+    .. code-block:: python
+
+        trace = hoomd.write.Trace(trigger=hoomd.trigger.On(1000),
+                                  filename=trace_filename,
+                                  steps=20)
+        simulation.operations.writers.append(trace)
+
+    Attributes:
+        filename (str): File name to write (*read only*).
+
+            .. rubric:: Example:
+
+            .. code-block:: python
+
+                filename = trace.filename
+
+        steps (int): Number of steps in each window.
+
+            .. rubric:: Example:
+
+            .. code-block:: python
+
+                trace.steps = 100
+    """
+
+    def __init__(self, trigger, filename, steps=10):
+
+        # initialize base class
+        super().__init__(trigger)
+        self._param_dict.update(
+            ParameterDict(filename=str(filename), steps=int(steps)))
+
+    def _attach_hook(self):
+        # the root rank writes the file named on the root rank
+        filename = _hoomd.mpi_bcast_str(self.filename,
+                                        self._simulation.device._cpp_exec_conf)
+        self._cpp_obj = _hoomd.TraceWriter(
+            self._simulation.state._cpp_sys_def, self.trigger, filename,
+            self.steps)
+
+    @property
+    def recording(self):
+        """bool: True while a trace window is recorded."""
+        if not self._attached:
+            return False
+        return self._cpp_obj.recording
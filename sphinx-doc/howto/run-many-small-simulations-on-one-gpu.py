@@ -0,0 +1,35 @@
+import hoomd
+
+# Assign one state point to each partition.
+kT_values = [0.8, 1.0, 1.2, 1.4]
+
+# Place each MPI rank in its own partition and select the same GPU on all ranks.
+communicator = hoomd.communicator.Communicator(ranks_per_partition=1)
+device = hoomd.device.GPU(communicator=communicator, gpu_id=0)
+kT = kT_values[communicator.partition]
+
+# Create a WCA MD simulation for this state point.
+simulation = hoomd.Simulation(device=device, seed=communicator.partition)
+simulation.create_state_from_gsd(filename='spheres.gsd')
+simulation.state.thermalize_particle_momenta(filter=hoomd.filter.All(), kT=kT)
+
+cell = hoomd.md.nlist.Cell(buffer=0.2)
+lj = hoomd.md.pair.LJ(nlist=cell)
+lj.params[('A', 'A')] = dict(sigma=1, epsilon=1)
+lj.r_cut[('A', 'A')] = 2**(1 / 6)
+
+constant_volume = hoomd.md.methods.ConstantVolume(
+    filter=hoomd.filter.All(),
+    thermostat=hoomd.md.methods.thermostats.Bussi(kT=kT))
+
+simulation.operations.integrator = hoomd.md.Integrator(
+    dt=0.001, methods=[constant_volume], forces=[lj])
+
+# Write a separate output file for each partition.
+gsd_writer = hoomd.write.GSD(filename=f'trajectory-kT{kT}.gsd',
+                             trigger=hoomd.trigger.Periodic(10_000),
+                             mode='xb')
+simulation.operations.writers.append(gsd_writer)
+
+simulation.run(100_000)
+device.notice(f'kT={kT}: TPS={simulation.tps:0.5g}')